@@ -0,0 +1,3 @@
+# A very simple script to issue an error if the mlpack_benchmarks target is not
+# defined.
+message(FATAL_ERROR "To build the mlpack_benchmarks target, reconfigure CMake with the BUILD_BENCHMARKS option set to ON!  (i.e. `cmake -DBUILD_BENCHMARKS=ON ../`)")
@@ -84,6 +84,14 @@
 // Now include Armadillo and traits that we use for it.
 #include <armadillo>
 #include <mlpack/core/util/arma_traits.hpp>
+
+// Bandicoot (GPU) matrix types can be used where the matrix type is a template
+// parameter if MLPACK_HAS_COOT is defined.
+#ifdef MLPACK_HAS_COOT
+  #include <bandicoot>
+  #include <mlpack/core/util/coot_traits.hpp>
+#endif
+
 #include <mlpack/core/util/omp_reductions.hpp>
 
 // On Visual Studio, disable C4519 (default arguments for function templates)
@@ -0,0 +1,113 @@
+/**
+ * @file benchmarks/ann_benchmarks.cpp
+ *
+ * Benchmarks for the forward and backward passes of individual neural network
+ * layers, and for the forward pass of a whole network.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+#include "datasets.hpp"
+#include "../tests/catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmarks;
+
+/**
+ * Benchmark the forward pass, the backward pass and (for layers with weights)
+ * the gradient computation of the given layer, on a batch of the given size of
+ * inputs with the given dimensions.
+ */
+template<typename LayerType>
+void BenchmarkLayer(const std::string& name,
+                    LayerType& layer,
+                    const std::vector<size_t>& inputDimensions,
+                    const size_t batchSize)
+{
+  // The backward pass needs the results of a forward pass in training mode.
+  layer.Training() = true;
+  layer.InputDimensions() = inputDimensions;
+  layer.ComputeOutputDimensions();
+
+  arma::mat weights = UniformDataset(layer.WeightSize(), 1, 0);
+  layer.SetWeights(weights);
+
+  size_t inputSize = 1;
+  for (size_t i = 0; i < inputDimensions.size(); ++i)
+    inputSize *= inputDimensions[i];
+
+  const arma::mat input = UniformDataset(inputSize, batchSize, 1);
+  arma::mat output(layer.OutputSize(), batchSize);
+  BENCHMARK(name + " Forward()")
+  {
+    layer.Forward(input, output);
+    return output(0, 0);
+  };
+
+  const arma::mat gy = UniformDataset(layer.OutputSize(), batchSize, 2);
+  arma::mat g(inputSize, batchSize);
+  BENCHMARK(name + " Backward()")
+  {
+    layer.Backward(input, output, gy, g);
+    return g(0, 0);
+  };
+
+  if (layer.WeightSize() > 0)
+  {
+    arma::mat gradient(layer.WeightSize(), 1);
+    BENCHMARK(name + " Gradient()")
+    {
+      layer.Gradient(input, gy, gradient);
+      return gradient(0, 0);
+    };
+  }
+}
+
+TEST_CASE("LayerBenchmark", "[ANNBenchmark]")
+{
+  Linear linear(256);
+  BenchmarkLayer("Linear", linear, { 512 }, 64);
+
+  Convolution convolution(16, 3, 3);
+  BenchmarkLayer("Convolution", convolution, { 28, 28, 3 }, 64);
+
+  MaxPooling maxPooling(2, 2, 2, 2);
+  BenchmarkLayer("MaxPooling", maxPooling, { 28, 28, 16 }, 64);
+
+  BatchNorm batchNorm;
+  BenchmarkLayer("BatchNorm", batchNorm, { 512 }, 64);
+
+  LayerNorm layerNorm;
+  BenchmarkLayer("LayerNorm", layerNorm, { 512 }, 64);
+
+  ReLU relu;
+  BenchmarkLayer("ReLU", relu, { 4096 }, 64);
+
+  Sigmoid sigmoid;
+  BenchmarkLayer("Sigmoid", sigmoid, { 4096 }, 64);
+}
+
+TEST_CASE("FFNForwardBenchmark", "[ANNBenchmark]")
+{
+  arma::Row<size_t> labels;
+  const arma::mat dataset = GaussianClusters(100, 1024, 10, labels, 0);
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(256);
+  model.Add<ReLU>();
+  model.Add<Linear>(256);
+  model.Add<ReLU>();
+  model.Add<Linear>(10);
+  model.Add<LogSoftMax>();
+
+  arma::mat predictions;
+  BENCHMARK("FFN Predict() (3 linear layers)")
+  {
+    model.Predict(dataset, predictions);
+    return predictions(0, 0);
+  };
+}
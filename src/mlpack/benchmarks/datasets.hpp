@@ -0,0 +1,95 @@
+/**
+ * @file benchmarks/datasets.hpp
+ *
+ * Generators of the synthetic datasets used by the benchmarks.  Each dataset
+ * only depends on its size and seed, so results can be compared between runs
+ * and between versions of mlpack.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCHMARKS_DATASETS_HPP
+#define MLPACK_BENCHMARKS_DATASETS_HPP
+
+#include <mlpack/core.hpp>
+
+#include <random>
+
+namespace mlpack {
+namespace benchmarks {
+
+/**
+ * Return a dataset of points drawn uniformly from the unit hypercube.
+ *
+ * @param dimensionality Dimensionality of the points.
+ * @param points Number of points.
+ * @param seed Seed of the dataset.
+ */
+inline arma::mat UniformDataset(const size_t dimensionality,
+                                const size_t points,
+                                const size_t seed = 0)
+{
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<> dist(0.0, 1.0);
+
+  arma::mat dataset(dimensionality, points);
+  dataset.imbue([&]() { return dist(rng); });
+  return dataset;
+}
+
+/**
+ * Return a dataset of points drawn from isotropic Gaussians (with unit
+ * variance) whose centers are drawn uniformly from [0, 10) in each dimension.
+ * The label of each point is the index of its Gaussian, so the dataset can be
+ * used for clustering as well as classification.
+ *
+ * @param dimensionality Dimensionality of the points.
+ * @param points Number of points.
+ * @param clusters Number of Gaussians.
+ * @param labels Vector to store the label of each point in.
+ * @param seed Seed of the dataset.
+ */
+inline arma::mat GaussianClusters(const size_t dimensionality,
+                                  const size_t points,
+                                  const size_t clusters,
+                                  arma::Row<size_t>& labels,
+                                  const size_t seed = 0)
+{
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<> centerDist(0.0, 10.0);
+  std::normal_distribution<> noiseDist(0.0, 1.0);
+
+  arma::mat centers(dimensionality, clusters);
+  centers.imbue([&]() { return centerDist(rng); });
+
+  arma::mat dataset(dimensionality, points);
+  labels.set_size(points);
+  for (size_t i = 0; i < points; ++i)
+  {
+    labels[i] = i % clusters;
+    for (size_t d = 0; d < dimensionality; ++d)
+      dataset(d, i) = centers(d, labels[i]) + noiseDist(rng);
+  }
+
+  return dataset;
+}
+
+/**
+ * Return a dataset of points drawn from isotropic Gaussians, as above, without
+ * the labels.
+ */
+inline arma::mat GaussianClusters(const size_t dimensionality,
+                                  const size_t points,
+                                  const size_t clusters,
+                                  const size_t seed = 0)
+{
+  arma::Row<size_t> labels;
+  return GaussianClusters(dimensionality, points, clusters, labels, seed);
+}
+
+} // namespace benchmarks
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,68 @@
+/**
+ * @file benchmarks/decision_tree_benchmarks.cpp
+ *
+ * Benchmarks for split finding in decision trees, and for the training of
+ * decision trees and random forests.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/decision_tree.hpp>
+#include <mlpack/methods/random_forest.hpp>
+#include "datasets.hpp"
+#include "../tests/catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmarks;
+
+/**
+ * Benchmark the search of the best split of one dimension with the given
+ * numeric split type.
+ */
+template<typename SplitType>
+void BenchmarkSplit(const std::string& name,
+                    const arma::mat& dataset,
+                    const arma::Row<size_t>& labels,
+                    const size_t numClasses)
+{
+  const arma::rowvec weights;
+  arma::vec splitInfo;
+  typename SplitType::AuxiliarySplitInfo aux;
+  BENCHMARK(name + " SplitIfBetter()")
+  {
+    return SplitType::template SplitIfBetter<false>(-DBL_MAX, dataset.row(0),
+        labels, numClasses, weights, 10, 1e-7, splitInfo, aux);
+  };
+}
+
+TEST_CASE("DecisionTreeSplitBenchmark", "[DecisionTreeBenchmark]")
+{
+  arma::Row<size_t> labels;
+  const arma::mat dataset = GaussianClusters(10, 100000, 5, labels, 0);
+
+  BenchmarkSplit<BestBinaryNumericSplit<GiniGain>>("BestBinaryNumericSplit",
+      dataset, labels, 5);
+  BenchmarkSplit<HistogramNumericSplit<GiniGain>>("HistogramNumericSplit",
+      dataset, labels, 5);
+}
+
+TEST_CASE("DecisionTreeTrainBenchmark", "[DecisionTreeBenchmark]")
+{
+  arma::Row<size_t> labels;
+  const arma::mat dataset = GaussianClusters(10, 20000, 5, labels, 0);
+
+  BENCHMARK("DecisionTree Train()")
+  {
+    DecisionTree<> tree(dataset, labels, 5);
+    return tree.NumChildren();
+  };
+
+  BENCHMARK("RandomForest Train() (10 trees)")
+  {
+    RandomForest<> rf(dataset, labels, 5, 10);
+    return rf.NumTrees();
+  };
+}
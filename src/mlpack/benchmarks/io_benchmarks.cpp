@@ -0,0 +1,86 @@
+/**
+ * @file benchmarks/io_benchmarks.cpp
+ *
+ * Benchmarks for loading and saving datasets, and for model serialization.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/decision_tree.hpp>
+#include <mlpack/methods/neighbor_search.hpp>
+#include "datasets.hpp"
+#include "../tests/catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmarks;
+
+/**
+ * Benchmark saving and loading the given matrix to and from the given file,
+ * whose extension gives the format.
+ */
+void BenchmarkMatrixIO(const std::string& name,
+                       const std::string& filename,
+                       const arma::mat& dataset)
+{
+  BENCHMARK(name + " save")
+  {
+    return data::Save(filename, dataset, true);
+  };
+
+  arma::mat loaded;
+  BENCHMARK(name + " load")
+  {
+    data::Load(filename, loaded, true);
+    return loaded.n_elem;
+  };
+
+  remove(filename.c_str());
+}
+
+TEST_CASE("MatrixIOBenchmark", "[IOBenchmark]")
+{
+  const arma::mat dataset = UniformDataset(20, 50000, 0);
+
+  BenchmarkMatrixIO("CSV", "benchmark_dataset.csv", dataset);
+  BenchmarkMatrixIO("Armadillo binary", "benchmark_dataset.bin", dataset);
+}
+
+/**
+ * Benchmark serializing and deserializing the given model to and from the given
+ * file, whose extension gives the format.
+ */
+template<typename ModelType>
+void BenchmarkModelIO(const std::string& name,
+                      const std::string& filename,
+                      ModelType& model)
+{
+  BENCHMARK(name + " serialize")
+  {
+    return data::Save(filename, "model", model, true);
+  };
+
+  ModelType loaded;
+  BENCHMARK(name + " deserialize")
+  {
+    return data::Load(filename, "model", loaded, true);
+  };
+
+  remove(filename.c_str());
+}
+
+TEST_CASE("SerializationBenchmark", "[IOBenchmark]")
+{
+  arma::Row<size_t> labels;
+  const arma::mat dataset = GaussianClusters(10, 20000, 5, labels, 0);
+
+  KNN knn(dataset);
+  BenchmarkModelIO("KNN binary", "benchmark_knn.bin", knn);
+  BenchmarkModelIO("KNN XML", "benchmark_knn.xml", knn);
+
+  DecisionTree<> tree(dataset, labels, 5);
+  BenchmarkModelIO("DecisionTree binary", "benchmark_tree.bin", tree);
+  BenchmarkModelIO("DecisionTree XML", "benchmark_tree.xml", tree);
+}
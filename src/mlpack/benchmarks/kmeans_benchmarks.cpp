@@ -0,0 +1,71 @@
+/**
+ * @file benchmarks/kmeans_benchmarks.cpp
+ *
+ * Benchmarks for each Lloyd step type of k-means.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/kmeans.hpp>
+#include "datasets.hpp"
+#include "../tests/catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmarks;
+
+/**
+ * Benchmark ten iterations of k-means with the given Lloyd step type, from the
+ * given initial centroids.
+ */
+template<template<class, class> class LloydStepType>
+void BenchmarkKMeans(const std::string& name,
+                     const arma::mat& dataset,
+                     const arma::mat& initialCentroids)
+{
+  KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      LloydStepType> kmeans(10);
+
+  arma::mat centroids;
+  BENCHMARK(name + " 10 iterations")
+  {
+    centroids = initialCentroids;
+    kmeans.Cluster(dataset, centroids.n_cols, centroids, true);
+    return centroids(0, 0);
+  };
+}
+
+TEST_CASE("KMeansBenchmark", "[KMeansBenchmark]")
+{
+  const arma::mat dataset = GaussianClusters(5, 50000, 20, 0);
+  const arma::mat initialCentroids = dataset.cols(0, 19);
+
+  BenchmarkKMeans<NaiveKMeans>("NaiveKMeans", dataset, initialCentroids);
+  BenchmarkKMeans<ElkanKMeans>("ElkanKMeans", dataset, initialCentroids);
+  BenchmarkKMeans<HamerlyKMeans>("HamerlyKMeans", dataset, initialCentroids);
+  BenchmarkKMeans<PellegMooreKMeans>("PellegMooreKMeans", dataset,
+      initialCentroids);
+  BenchmarkKMeans<DefaultDualTreeKMeans>("DualTreeKMeans", dataset,
+      initialCentroids);
+}
+
+/**
+ * Benchmark a single step of the naive Lloyd algorithm, which is also the
+ * step that the other algorithms are compared against.
+ */
+TEST_CASE("NaiveKMeansIterateBenchmark", "[KMeansBenchmark]")
+{
+  const arma::mat dataset = GaussianClusters(5, 50000, 20, 0);
+  const arma::mat centroids = dataset.cols(0, 19);
+
+  EuclideanDistance distance;
+  NaiveKMeans<EuclideanDistance, arma::mat> lloyd(dataset, distance);
+  arma::mat newCentroids;
+  arma::Col<size_t> counts;
+  BENCHMARK("NaiveKMeans Iterate()")
+  {
+    return lloyd.Iterate(centroids, newCentroids, counts);
+  };
+}
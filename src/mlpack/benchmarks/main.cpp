@@ -0,0 +1,38 @@
+/**
+ * @file benchmarks/main.cpp
+ *
+ * Main file for the mlpack benchmarks.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#define CATCH_CONFIG_RUNNER  // we will define main()
+#include "../tests/catch.hpp"
+
+int main(int argc, char** argv)
+{
+  Catch::Session session;
+  const int returnCode = session.applyCommandLine(argc, argv);
+  // Check for a command line error.
+  if (returnCode != 0)
+    return returnCode;
+
+  // The results are printed to stdout in the format of the chosen reporter, so
+  // that they can be parsed (e.g. with `-r xml`); anything else goes to
+  // stderr.
+  std::cerr << "mlpack version: " << mlpack::util::GetVersion() << std::endl;
+  std::cerr << "armadillo version: " << arma::arma_version::as_string()
+      << std::endl;
+
+  // The synthetic datasets have their own seeds; this seed is used by the
+  // algorithms themselves.
+  const size_t seed = session.config().rngSeed();
+  std::cerr << "random seed: " << seed << std::endl;
+  mlpack::RandomSeed(seed);
+
+  return session.run();
+}
@@ -0,0 +1,102 @@
+/**
+ * @file benchmarks/tree_benchmarks.cpp
+ *
+ * Benchmarks for the construction of each type of tree, and for k-nearest
+ * neighbor search with each of them.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/neighbor_search.hpp>
+#include "datasets.hpp"
+#include "../tests/catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmarks;
+
+/**
+ * Benchmark the construction of a tree of the given type on the reference set,
+ * and dual-tree and single-tree 5-nearest neighbor search of the query set with
+ * that type of tree.
+ */
+template<template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void BenchmarkTree(const std::string& name,
+                   const arma::mat& referenceSet,
+                   const arma::mat& querySet)
+{
+  BENCHMARK(name + " build")
+  {
+    TreeType<EuclideanDistance, EmptyStatistic, arma::mat> tree(referenceSet);
+    return tree.NumDescendants();
+  };
+
+  using KNNType = NeighborSearch<NearestNeighborSort, EuclideanDistance,
+      arma::mat, TreeType>;
+  KNNType knn(referenceSet);
+  // Make sure that the trees are used.
+  knn.BruteForceDimensionality() = 0;
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  BENCHMARK(name + " dual-tree 5-NN search")
+  {
+    knn.Search(querySet, 5, neighbors, distances);
+    return distances(0, 0);
+  };
+
+  knn.SearchMode() = SINGLE_TREE_MODE;
+  BENCHMARK(name + " single-tree 5-NN search")
+  {
+    knn.Search(querySet, 5, neighbors, distances);
+    return distances(0, 0);
+  };
+}
+
+TEST_CASE("BinarySpaceTreeBenchmark", "[TreeBenchmark]")
+{
+  const arma::mat referenceSet = UniformDataset(3, 20000, 0);
+  const arma::mat querySet = UniformDataset(3, 5000, 1);
+
+  BenchmarkTree<KDTree>("KDTree", referenceSet, querySet);
+  BenchmarkTree<BallTree>("BallTree", referenceSet, querySet);
+  BenchmarkTree<VPTree>("VPTree", referenceSet, querySet);
+  BenchmarkTree<RPTree>("RPTree", referenceSet, querySet);
+  BenchmarkTree<MaxRPTree>("MaxRPTree", referenceSet, querySet);
+  BenchmarkTree<UBTree>("UBTree", referenceSet, querySet);
+}
+
+TEST_CASE("OctreeBenchmark", "[TreeBenchmark]")
+{
+  const arma::mat referenceSet = UniformDataset(3, 20000, 0);
+  const arma::mat querySet = UniformDataset(3, 5000, 1);
+
+  BenchmarkTree<Octree>("Octree", referenceSet, querySet);
+}
+
+TEST_CASE("CoverTreeBenchmark", "[TreeBenchmark]")
+{
+  const arma::mat referenceSet = UniformDataset(3, 20000, 0);
+  const arma::mat querySet = UniformDataset(3, 5000, 1);
+
+  BenchmarkTree<StandardCoverTree>("CoverTree", referenceSet, querySet);
+}
+
+TEST_CASE("RectangleTreeBenchmark", "[TreeBenchmark]")
+{
+  // Rectangle trees are built by inserting each point, so they are benchmarked
+  // on smaller datasets.
+  const arma::mat referenceSet = UniformDataset(3, 5000, 0);
+  const arma::mat querySet = UniformDataset(3, 1000, 1);
+
+  BenchmarkTree<RTree>("RTree", referenceSet, querySet);
+  BenchmarkTree<RStarTree>("RStarTree", referenceSet, querySet);
+  BenchmarkTree<XTree>("XTree", referenceSet, querySet);
+  BenchmarkTree<HilbertRTree>("HilbertRTree", referenceSet, querySet);
+  BenchmarkTree<RPlusTree>("RPlusTree", referenceSet, querySet);
+  BenchmarkTree<RPlusPlusTree>("RPlusPlusTree", referenceSet, querySet);
+}
@@ -16,6 +16,24 @@
 using namespace mlpack;
 using namespace Rcpp;
 
+// Return whether the memory of the given R object can be used directly as the
+// memory of an Armadillo matrix of doubles, without a conversion.
+bool inline is_shareable(SEXP x)
+{
+  return (TYPEOF(x) == REALSXP);
+}
+
+// Transpose the given matrix directly into a new R matrix, and free the memory
+// of the original, so that the result is not also held in a temporary.
+NumericMatrix inline transpose_to_r(arma::mat& X)
+{
+  NumericMatrix result(X.n_cols, X.n_rows);
+  arma::mat alias(result.begin(), X.n_cols, X.n_rows, false, true);
+  alias = X.t();
+  X.reset();
+  return result;
+}
+
 template<typename eT>
 bool inline inplace_transpose(arma::Mat<eT>& X)
 {
@@ -108,15 +126,26 @@ void SetParamVecInt(SEXP params,
   p.SetPassed(paramName);
 }
 
-// Call params.Get<arma::mat>() to set the value of a parameter.
+// Call params.Get<arma::mat>() to set the value of a parameter.  If the matrix
+// is not transposed and is already a matrix of doubles, the parameter uses the
+// memory of the R matrix (as a strict alias, so that it cannot be resized or
+// taken over by a model); the caller must keep the R matrix alive until the
+// binding has run.
 // [[Rcpp::export]]
 void SetParamMat(SEXP params,
                  const std::string& paramName,
-                 const arma::mat& paramValue,
+                 SEXP paramValue,
                  bool transpose)
 {
   util::Params& p = *Rcpp::as<Rcpp::XPtr<util::Params>>(params);
-  p.Get<arma::mat>(paramName) = (transpose ? paramValue.t() : paramValue);
+  NumericMatrix m(paramValue);
+  arma::mat alias(m.begin(), m.nrow(), m.ncol(), false, true);
+  if (transpose)
+    p.Get<arma::mat>(paramName) = alias.t();
+  else if (is_shareable(paramValue))
+    p.Get<arma::mat>(paramName) = std::move(alias);
+  else
+    p.Get<arma::mat>(paramName) = alias;
   p.SetPassed(paramName);
 }
 
@@ -131,14 +160,20 @@ void SetParamUMat(SEXP params,
   p.SetPassed(paramName);
 }
 
-// Call params.Get<arma::rowvec>() to set the value of a parameter.
+// Call params.Get<arma::rowvec>() to set the value of a parameter.  As for
+// SetParamMat(), a vector of doubles is used without a copy.
 // [[Rcpp::export]]
 void SetParamRow(SEXP params,
                  const std::string& paramName,
-                 const arma::rowvec& paramValue)
+                 SEXP paramValue)
 {
   util::Params& p = *Rcpp::as<Rcpp::XPtr<util::Params>>(params);
-  p.Get<arma::rowvec>(paramName) = std::move(paramValue);
+  NumericVector v(paramValue);
+  arma::rowvec alias(v.begin(), v.size(), false, true);
+  if (is_shareable(paramValue))
+    p.Get<arma::rowvec>(paramName) = std::move(alias);
+  else
+    p.Get<arma::rowvec>(paramName) = alias;
   p.SetPassed(paramName);
 }
 
@@ -162,14 +197,20 @@ void SetParamURow(SEXP params,
   p.SetPassed(paramName);
 }
 
-// Call params.Get<arma::vec>() to set the value of a parameter.
+// Call params.Get<arma::vec>() to set the value of a parameter.  As for
+// SetParamMat(), a vector of doubles is used without a copy.
 // [[Rcpp::export]]
 void SetParamCol(SEXP params,
                  const std::string& paramName,
-                 const arma::vec& paramValue)
+                 SEXP paramValue)
 {
   util::Params& p = *Rcpp::as<Rcpp::XPtr<util::Params>>(params);
-  p.Get<arma::vec>(paramName) = std::move(paramValue);
+  NumericVector v(paramValue);
+  arma::vec alias(v.begin(), v.size(), false, true);
+  if (is_shareable(paramValue))
+    p.Get<arma::vec>(paramName) = std::move(alias);
+  else
+    p.Get<arma::vec>(paramName) = alias;
   p.SetPassed(paramName);
 }
 
@@ -217,7 +258,7 @@ void SetParamMatWithInfo(SEXP params,
   // Do we need to find how many categories we have?
   if (hasCategoricals)
   {
-    arma::vec maxs = arma::max(paramValue, 1) + 1;
+    arma::vec maxs = arma::max(m, 1) + 1;
 
     for (size_t i = 0; i < d.Dimensionality(); ++i)
     {
@@ -292,13 +333,13 @@ const std::vector<int>& GetParamVecInt(SEXP params,
   return std::move(p.Get<std::vector<int>>(paramName));
 }
 
-// Call p.Get<arma::mat>().
+// Call p.Get<arma::mat>().  The parameter is transposed directly into the
+// returned R matrix, and its memory is released.
 // [[Rcpp::export]]
-const arma::mat& GetParamMat(SEXP params, const std::string& paramName)
+NumericMatrix GetParamMat(SEXP params, const std::string& paramName)
 {
   util::Params& p = *Rcpp::as<Rcpp::XPtr<util::Params>>(params);
-  inplace_transpose(p.Get<arma::mat>(paramName));
-  return std::move(p.Get<arma::mat>(paramName));
+  return transpose_to_r(p.Get<arma::mat>(paramName));
 }
 
 // Call p.Get<arma::Mat<size_t>>().
@@ -352,8 +393,8 @@ List IO_GetParamMatWithInfo(SEXP params, const std::string& paramName)
   util::Params& p = *Rcpp::as<Rcpp::XPtr<util::Params>>(params);
   const data::DatasetInfo& d = std::get<0>(
       p.Get<std::tuple<data::DatasetInfo, arma::mat>>(paramName));
-  const arma::mat& m = std::get<1>(
-      p.Get<std::tuple<data::DatasetInfo, arma::mat>>(paramName)).t();
+  NumericMatrix m = transpose_to_r(std::get<1>(
+      p.Get<std::tuple<data::DatasetInfo, arma::mat>>(paramName)));
 
   LogicalVector dims(d.Dimensionality());
   for (size_t i = 0; i < d.Dimensionality(); ++i)
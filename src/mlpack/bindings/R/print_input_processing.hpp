@@ -83,19 +83,23 @@ void PrintInputProcessing(
       extraTransStr = ", TRUE";
   }
 
+  // The converted matrix is stored in the argument itself, so that it stays
+  // alive until the binding has run: SetParamMat() may use its memory directly.
   if (!d.required)
   {
     /**
      * This gives us code like:
      *
      *     if (!identical(<param_name>, NA)) {
-     *        SetParam<type>(p, "<param_name>", to_matrix(<param_name>))
+     *        <param_name> <- to_matrix(<param_name>)
+     *        SetParam<type>(p, "<param_name>", <param_name>)
      *     }
      *
      * and if the parameter is an arma::mat, we will get code like
      *
      *     if (!identical(<param_name>, NA)) {
-     *        SetParam<type>(p, "<param_name>", to_matrix(<param_name>), TRUE)
+     *        <param_name> <- to_matrix(<param_name>)
+     *        SetParam<type>(p, "<param_name>", <param_name>, TRUE)
      *     }
      *
      * where the final boolean specifies whether the matrix should be
@@ -103,9 +107,10 @@ void PrintInputProcessing(
      */
     MLPACK_COUT_STREAM << "  if (!identical(" << d.name << ", NA)) {"
         << std::endl;
-    MLPACK_COUT_STREAM << "    SetParam" << GetType<T>(d) << "(p, \""
-        << d.name << "\", to_matrix(" << d.name << ")" << extraTransStr << ")"
+    MLPACK_COUT_STREAM << "    " << d.name << " <- to_matrix(" << d.name << ")"
         << std::endl;
+    MLPACK_COUT_STREAM << "    SetParam" << GetType<T>(d) << "(p, ""
+        << d.name << "", " << d.name << extraTransStr << ")" << std::endl;
     MLPACK_COUT_STREAM << "  }" << std::endl; // Closing brace.
   }
   else
@@ -113,18 +118,21 @@ void PrintInputProcessing(
     /**
      * This gives us code like:
      *
-     *     SetParam<type>(p, "<param_name>", to_matrix(<param_name>))
+     *     <param_name> <- to_matrix(<param_name>)
+     *     SetParam<type>(p, "<param_name>", <param_name>)
      *
      * and if the parameter is an arma::mat, we will get code like
      *
-     *     SetParam<type>(p, "<param_name>", to_matrix(<param_name>), TRUE)
+     *     <param_name> <- to_matrix(<param_name>)
+     *     SetParam<type>(p, "<param_name>", <param_name>, TRUE)
      *
      * where the final boolean specifies whether the matrix should be
      * transposed.
      */
-    MLPACK_COUT_STREAM << "  SetParam" << GetType<T>(d) << "(p, \""
-        << d.name << "\", to_matrix(" << d.name << ")" << extraTransStr << ")"
+    MLPACK_COUT_STREAM << "  " << d.name << " <- to_matrix(" << d.name << ")"
         << std::endl;
+    MLPACK_COUT_STREAM << "  SetParam" << GetType<T>(d) << "(p, ""
+        << d.name << "", " << d.name << extraTransStr << ")" << std::endl;
   }
   MLPACK_COUT_STREAM << std::endl; // Extra line is to clear up the code a bit.
 }
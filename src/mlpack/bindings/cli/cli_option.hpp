@@ -31,6 +31,7 @@
 #include "get_allocated_memory.hpp"
 #include "delete_allocated_memory.hpp"
 #include "in_place_copy.hpp"
+#include "stream_param.hpp"
 
 namespace mlpack {
 namespace bindings {
@@ -123,6 +124,8 @@ class CLIOption
     IO::AddFunction(tname, "GetAllocatedMemory", &GetAllocatedMemory<N>);
     IO::AddFunction(tname, "DeleteAllocatedMemory", &DeleteAllocatedMemory<N>);
     IO::AddFunction(tname, "InPlaceCopy", &InPlaceCopy<N>);
+    IO::AddFunction(tname, "ReadStreamParam", &ReadStreamParam<N>);
+    IO::AddFunction(tname, "WriteStreamParam", &WriteStreamParam<N>);
 
     IO::AddParameter(bindingName, std::move(data));
   }
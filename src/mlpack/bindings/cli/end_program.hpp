@@ -22,8 +22,12 @@ namespace cli {
 /**
  * Handle command-line program termination.  If --help or --info was passed, we
  * won't make it here, so we don't have to write any contingencies for that.
+ * If outputParams is false, the output options are not printed or saved
+ * (because they were already, e.g. for each chunk with --stream).
  */
-inline void EndProgram(util::Params& params, util::Timers& timers)
+inline void EndProgram(util::Params& params,
+                       util::Timers& timers,
+                       const bool outputParams = true)
 {
   // Stop the timers.
   timers.StopAllTimers();
@@ -33,7 +37,7 @@ inline void EndProgram(util::Params& params, util::Timers& timers)
   for (auto& it : parameters)
   {
     util::ParamData& d = it.second;
-    if (!d.input)
+    if (!d.input && outputParams)
       params.functionMap[d.tname]["OutputParam"](d, NULL, NULL);
   }
 
@@ -77,6 +81,15 @@ inline void EndProgram(util::Params& params, util::Timers& timers)
     {
       Log::Info << "  " << it2.first << ": " << timers.Print(it2.second);
     }
+
+    // The peak resident memory is reported with the timers, if the platform
+    // gives it.
+    const size_t peakMemory = PeakResidentMemory();
+    if (peakMemory > 0)
+    {
+      Log::Info << "Peak resident memory: "
+          << MemoryReport::PrintBytes(peakMemory) << std::endl;
+    }
   }
 
   // Lastly clean up any memory.  If we are holding any pointers, then we "own"
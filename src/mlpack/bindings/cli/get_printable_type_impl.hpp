@@ -71,6 +71,8 @@ std::string GetPrintableType(
     return "2-d matrix file";
   else if (std::is_same_v<T, arma::Mat<size_t>>)
     return "2-d index matrix file";
+  else if (std::is_same_v<T, arma::fmat>)
+    return "2-d single-precision matrix file";
   else if (std::is_same_v<T, arma::rowvec>)
     return "1-d matrix file";
   else if (std::is_same_v<T, arma::Row<size_t>>)
@@ -88,6 +88,8 @@ using Option = mlpack::bindings::cli::CLIOption<T>;
 #include <mlpack/core/util/io.hpp>
 #include <mlpack/bindings/cli/parse_command_line.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
+#include <mlpack/bindings/cli/run_server.hpp>
+#include <mlpack/bindings/cli/run_stream.hpp>
 
 // Forward definition of the binding function.
 void BINDING_FUNCTION(mlpack::util::Params&, mlpack::util::Timers&);
@@ -105,12 +107,27 @@ int main(int argc, char** argv)
 
   // A "total_time" timer is run by default for each mlpack program.
   timers.Start("total_time");
-  BINDING_FUNCTION(params, timers);
+  if (params.Has("stream"))
+  {
+    // Run the binding once per chunk of points read from standard input; the
+    // outputs of each chunk are written before the next chunk is read.
+    mlpack::bindings::cli::RunStream(params, BINDING_FUNCTION);
+  }
+  else if (params.Has("server"))
+  {
+    // Answer requests until the end of the input; the inputs given on the
+    // command line are only loaded once.
+    mlpack::bindings::cli::RunServer(params, BINDING_FUNCTION);
+  }
+  else
+  {
+    BINDING_FUNCTION(params, timers);
+  }
   timers.Stop("total_time");
 
   // Print output options, print verbose information, save model parameters,
-  // clean up, and so forth.
-  mlpack::bindings::cli::EndProgram(params, timers);
+  // clean up, and so forth.  With --stream, the outputs were already written.
+  mlpack::bindings::cli::EndProgram(params, timers, !params.Has("stream"));
 }
 
 // Add default parameters that are included in every program.
@@ -123,5 +140,18 @@ PARAM_GLOBAL(bool, "verbose", "Display informational messages and the full "
     false, true, false, false);
 PARAM_GLOBAL(bool, "version", "Display the version of mlpack.", "V", "bool",
     false, true, false, false);
+PARAM_GLOBAL(bool, "server", "Run as a server: load the input models and "
+    "matrices given on the command line once, then run the program once for "
+    "each line of standard input, with the options on that line added to the "
+    "ones on the command line; 'ok' or 'error: <message>' is printed after each "
+    "line.", "", "bool", false, true, false, false);
+PARAM_GLOBAL(std::string, "stream", "Stream the given matrix input option "
+    "(e.g. 'query' or 'test_file') from standard input: read it in chunks of "
+    "--stream_chunk_size points, one point per line, run the program once for "
+    "each chunk, and append the matrix outputs of each chunk to their files "
+    "('-' for standard output) as CSV.", "", "std::string", false, true, false,
+    "");
+PARAM_GLOBAL(int, "stream_chunk_size", "Number of points in each chunk read "
+    "with --stream.", "", "int", false, true, false, 1000);
 
 #endif
@@ -102,6 +102,13 @@ std::string PrintTypeDoc(
         "is found, the first row will be loaded as a data point.  All values of"
         " the matrix will be loaded as double-precision floating point data.";
   }
+  else if (std::is_same_v<T, arma::fmat>)
+  {
+    return "A data matrix filename.  The file can take the same formats as the "
+        "double-precision data matrix filenames, and is stored in the same way "
+        "(one row per point).  All values of the matrix will be loaded as "
+        "single-precision floating point data.";
+  }
   else if (std::is_same_v<T, arma::Mat<size_t>>)
   {
     return "A data matrix filename, where the matrix holds only non-negative "
@@ -0,0 +1,151 @@
+/**
+ * @file bindings/cli/run_server.hpp
+ *
+ * Run a command-line binding as a long-running server that answers requests
+ * read from standard input, keeping its input models loaded.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_RUN_SERVER_HPP
+#define MLPACK_BINDINGS_CLI_RUN_SERVER_HPP
+
+#include <mlpack/core/util/io.hpp>
+#include <mlpack/core/data/string_algorithms.hpp>
+
+#include "third_party/CLI/CLI11.hpp"
+
+#include <unordered_set>
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * Run the binding once per line of the given input stream, with the options
+ * given on the command line plus the options given on the line (in the same
+ * syntax as on the command line, e.g. `--test_file test.csv
+ * --predictions_file predictions.csv`).
+ *
+ * Every input option given on the command line (models and matrices) is
+ * loaded once, before the first request, and stays in memory until the
+ * server stops; these options cannot be given again in a request.  The
+ * options of each request only apply to that request.  After each request, a
+ * line that is either "ok" or "error: " followed by the error message is
+ * written to the output stream, so that a client can wait for the outputs of
+ * its request.  The server stops at the end of the input stream, or at a line
+ * with only "quit".
+ *
+ * @param params Options given on the command line.
+ * @param binding The binding function.
+ * @param in Stream to read requests from.
+ * @param out Stream to write the status of each request to.
+ */
+template<typename BindingFunctionType>
+void RunServer(util::Params& params,
+               const BindingFunctionType& binding,
+               std::istream& in = std::cin,
+               std::ostream& out = std::cout)
+{
+  std::map<std::string, util::ParamData>& parameters = params.Parameters();
+
+  // Load the inputs given on the command line, and remember which memory they
+  // own, so that it is kept across requests.
+  std::unordered_set<void*> resident;
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+    if (!d.input || !d.wasPassed)
+      continue;
+
+    void* result;
+    params.functionMap[d.tname]["GetParam"](d, NULL, (void*) &result);
+    params.functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+        (void*) &result);
+    if (result != NULL)
+      resident.insert(result);
+  }
+
+  std::string line;
+  while (std::getline(in, line))
+  {
+    std::string request = line;
+    data::Trim(request);
+    if (request.empty())
+      continue;
+    if (request == "quit")
+      break;
+
+    util::Params requestParams = params;
+    std::map<std::string, util::ParamData>& requestParameters =
+        requestParams.Parameters();
+    try
+    {
+      // Options that are already loaded cannot be changed.
+      CLI::App app;
+      app.set_help_flag();
+      for (auto& it : requestParameters)
+      {
+        util::ParamData& d = it.second;
+        if (!d.loaded)
+          requestParams.functionMap[d.tname]["AddToCLI11"](d, NULL,
+              (void*) &app);
+      }
+
+      try
+      {
+        app.parse(request, false);
+      }
+      catch (const CLI::ParseError& pe)
+      {
+        throw std::invalid_argument(pe.what());
+      }
+
+      util::Timers timers;
+      binding(requestParams, timers);
+
+      for (auto& it : requestParameters)
+      {
+        util::ParamData& d = it.second;
+        if (!d.input)
+          requestParams.functionMap[d.tname]["OutputParam"](d, NULL, NULL);
+      }
+
+      out << "ok" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+      std::string message = e.what();
+      data::Trim(message);
+      std::replace(message.begin(), message.end(), '\n', ' ');
+      out << "error: " << message << std::endl;
+    }
+
+    // Free the models created by the request; the resident ones are kept, even
+    // if the request outputs them.
+    std::unordered_set<void*> freed;
+    for (auto& it : requestParameters)
+    {
+      util::ParamData& d = it.second;
+
+      void* result;
+      requestParams.functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+          (void*) &result);
+      if (result != NULL && resident.count(result) == 0 &&
+          freed.count(result) == 0)
+      {
+        freed.insert(result);
+        requestParams.functionMap[d.tname]["DeleteAllocatedMemory"](d, NULL,
+            NULL);
+      }
+    }
+  }
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,161 @@
+/**
+ * @file bindings/cli/run_stream.hpp
+ *
+ * Run a command-line binding on a matrix input that is streamed from standard
+ * input in chunks, writing the outputs of each chunk before reading the next.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_RUN_STREAM_HPP
+#define MLPACK_BINDINGS_CLI_RUN_STREAM_HPP
+
+#include <mlpack/core/util/io.hpp>
+
+#include <unordered_set>
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * Run the binding once per chunk of points of the matrix input option given
+ * to --stream (by its name, like "query", or its command-line name, like
+ * "query_file"), read from the given input stream with at most
+ * --stream_chunk_size points per chunk (see ReadStreamParam()).
+ *
+ * Every other input option given on the command line (models and matrices) is
+ * loaded once, before the first chunk, and stays in memory until the end of
+ * the stream; so, for instance, `mlpack_knn --input_model_file model.bin
+ * --stream query --neighbors_file -` answers an unbounded stream of queries
+ * with the memory of one chunk.  After each chunk, the matrix outputs are
+ * appended to their files in CSV format, one point per line (the file "-" is
+ * standard output), and the other outputs are output as for a normal run.  The
+ * stream ends at the end of the input.
+ *
+ * @param params Options given on the command line.
+ * @param binding The binding function.
+ * @param in Stream to read the points from.
+ */
+template<typename BindingFunctionType>
+void RunStream(util::Params& params,
+               const BindingFunctionType& binding,
+               std::istream& in = std::cin)
+{
+  std::map<std::string, util::ParamData>& parameters = params.Parameters();
+
+  if (params.Has("server"))
+    Log::Fatal << "Cannot give both --server and --stream!" << std::endl;
+
+  const int chunkSize = params.Get<int>("stream_chunk_size");
+  if (chunkSize <= 0)
+  {
+    Log::Fatal << "--stream_chunk_size must be positive (" << chunkSize
+        << " given)!" << std::endl;
+  }
+
+  // Find the option to stream.
+  const std::string streamName = params.Get<std::string>("stream");
+  std::string streamOption;
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+    std::string cliName;
+    params.functionMap[d.tname]["MapParameterName"](d, NULL, (void*) &cliName);
+    if (d.input && (d.name == streamName || cliName == streamName))
+      streamOption = it.first;
+  }
+
+  if (streamOption == "")
+  {
+    Log::Fatal << "Unknown input option '" << streamName << "' given to "
+        << "--stream!" << std::endl;
+  }
+  if (parameters.at(streamOption).wasPassed)
+  {
+    Log::Fatal << "Option '" << streamName << "' is read from standard input "
+        << "with --stream, so it cannot be given on the command line!"
+        << std::endl;
+  }
+
+  // Load the inputs given on the command line, and remember which memory they
+  // own, so that it is kept across chunks.
+  std::unordered_set<void*> resident;
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+    if (!d.input || !d.wasPassed)
+      continue;
+
+    void* result;
+    params.functionMap[d.tname]["GetParam"](d, NULL, (void*) &result);
+    params.functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+        (void*) &result);
+    if (result != NULL)
+      resident.insert(result);
+  }
+
+  bool first = true;
+  while (true)
+  {
+    util::Params chunkParams = params;
+    std::map<std::string, util::ParamData>& chunkParameters =
+        chunkParams.Parameters();
+
+    util::ParamData& streamData = chunkParameters.at(streamOption);
+    const std::tuple<std::istream*, size_t> streamInput =
+        std::make_tuple(&in, (size_t) chunkSize);
+    size_t numPoints;
+    chunkParams.functionMap[streamData.tname]["ReadStreamParam"](streamData,
+        (const void*) &streamInput, (void*) &numPoints);
+    if (numPoints == 0)
+      break;
+
+    Log::Info << "Processing a chunk of " << numPoints << " points from "
+        << "standard input." << std::endl;
+
+    util::Timers timers;
+    binding(chunkParams, timers);
+
+    for (auto& it : chunkParameters)
+    {
+      util::ParamData& d = it.second;
+      if (d.input)
+        continue;
+
+      bool written;
+      chunkParams.functionMap[d.tname]["WriteStreamParam"](d,
+          (const void*) &first, (void*) &written);
+      if (!written)
+        chunkParams.functionMap[d.tname]["OutputParam"](d, NULL, NULL);
+    }
+    first = false;
+
+    // Free the models created for the chunk; the resident ones are kept, even
+    // if the chunk outputs them.
+    std::unordered_set<void*> freed;
+    for (auto& it : chunkParameters)
+    {
+      util::ParamData& d = it.second;
+
+      void* result;
+      chunkParams.functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+          (void*) &result);
+      if (result != NULL && resident.count(result) == 0 &&
+          freed.count(result) == 0)
+      {
+        freed.insert(result);
+        chunkParams.functionMap[d.tname]["DeleteAllocatedMemory"](d, NULL,
+            NULL);
+      }
+    }
+  }
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
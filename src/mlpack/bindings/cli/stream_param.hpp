@@ -0,0 +1,233 @@
+/**
+ * @file bindings/cli/stream_param.hpp
+ *
+ * Read a chunk of points of a matrix option from a stream, and append the
+ * points of a matrix output to its file, for the --stream mode of the
+ * command-line bindings.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_STREAM_PARAM_HPP
+#define MLPACK_BINDINGS_CLI_STREAM_PARAM_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/param_data.hpp>
+#include "parameter_type.hpp"
+
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * Read the next chunk of at most chunkSize points of a matrix option from the
+ * given stream, and make it the value of the option.  Each non-empty line is
+ * one point (one element, for row and column vectors), with values separated
+ * by commas, tabs or spaces; the chunk is transposed like a loaded file
+ * (unless the option is not transposed).  Return the number of points read.
+ */
+template<typename T>
+size_t ReadStreamParam(
+    util::ParamData& d,
+    std::istream& in,
+    const size_t chunkSize,
+    const std::enable_if_t<arma::is_arma_type<T>::value>* = 0)
+{
+  using ElemType = typename T::elem_type;
+  using TupleType = std::tuple<T, typename ParameterType<T>::type>;
+  TupleType& tuple = *std::any_cast<TupleType>(&d.value);
+  T& matrix = std::get<0>(tuple);
+
+  std::vector<ElemType> values;
+  size_t numPoints = 0;
+  size_t dimensionality = 0;
+  std::string line;
+  while (numPoints < chunkSize && std::getline(in, line))
+  {
+    std::replace(line.begin(), line.end(), ',', ' ');
+    std::replace(line.begin(), line.end(), '\t', ' ');
+    std::istringstream lineStream(line);
+
+    size_t numValues = 0;
+    ElemType value;
+    while (lineStream >> value)
+    {
+      values.push_back(value);
+      ++numValues;
+    }
+
+    if (!lineStream.eof())
+    {
+      throw std::invalid_argument("cannot parse streamed line '" + line +
+          "' for option '" + d.name + "'!");
+    }
+
+    if (numValues == 0)
+      continue;
+
+    if (numPoints == 0)
+      dimensionality = numValues;
+    if (numValues != dimensionality)
+    {
+      std::ostringstream oss;
+      oss << "streamed line '" << line << "' for option '" << d.name << "' has "
+          << numValues << " values, but the previous lines have "
+          << dimensionality << "!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    ++numPoints;
+  }
+
+  if (arma::is_Row<T>::value || arma::is_Col<T>::value)
+  {
+    if (numPoints > 0 && dimensionality != 1)
+    {
+      throw std::invalid_argument("streamed lines for option '" + d.name +
+          "' must have only one value each!");
+    }
+
+    matrix = arma::conv_to<T>::from(values);
+  }
+  else
+  {
+    const arma::Mat<ElemType> points(values.data(), dimensionality, numPoints);
+    if (d.noTranspose)
+      matrix = points.t();
+    else
+      matrix = points;
+  }
+
+  std::get<1>(std::get<1>(tuple)) = matrix.n_rows;
+  std::get<2>(std::get<1>(tuple)) = matrix.n_cols;
+  d.wasPassed = true;
+  d.loaded = true;
+
+  return numPoints;
+}
+
+/**
+ * Only matrix options can be streamed.
+ */
+template<typename T>
+size_t ReadStreamParam(
+    util::ParamData& d,
+    std::istream& /* in */,
+    const size_t /* chunkSize */,
+    const std::enable_if_t<!arma::is_arma_type<T>::value>* = 0)
+{
+  throw std::invalid_argument("option '" + d.name + "' cannot be streamed; "
+      "only matrix options can be!");
+}
+
+/**
+ * Read the next chunk of points of a matrix option.  The input should be a
+ * std::tuple<std::istream*, size_t> holding the stream and the maximum number
+ * of points of the chunk, and the output a size_t that is set to the number
+ * of points read.
+ */
+template<typename T>
+void ReadStreamParam(util::ParamData& d,
+                     const void* input,
+                     void* output)
+{
+  const std::tuple<std::istream*, size_t>& t =
+      *((const std::tuple<std::istream*, size_t>*) input);
+  *((size_t*) output) = ReadStreamParam<std::remove_pointer_t<T>>(d,
+      *std::get<0>(t), std::get<1>(t));
+}
+
+/**
+ * Append the points of a matrix output to its file (or to standard output, if
+ * the file is "-"), with the same layout as ReadStreamParam(), in CSV format.
+ * The file is truncated for the first chunk.  Return true, since the output
+ * is handled.
+ */
+template<typename T>
+bool WriteStreamParam(
+    util::ParamData& d,
+    const bool first,
+    const std::enable_if_t<arma::is_arma_type<T>::value>* = 0)
+{
+  using TupleType = std::tuple<T, std::tuple<std::string, size_t, size_t>>;
+  const TupleType& tuple = *std::any_cast<TupleType>(&d.value);
+  const T& matrix = std::get<0>(tuple);
+  const std::string& filename = std::get<0>(std::get<1>(tuple));
+  if (filename == "")
+    return true;
+
+  std::ofstream file;
+  if (filename != "-")
+  {
+    file.open(filename, first ? std::ios::trunc : std::ios::app);
+    if (!file.is_open())
+    {
+      throw std::runtime_error("cannot open file '" + filename + "' to write "
+          "option '" + d.name + "'!");
+    }
+  }
+
+  std::ostream& out = (filename == "-") ? std::cout : file;
+  const std::streamsize oldPrecision = out.precision(
+      std::numeric_limits<typename T::elem_type>::max_digits10);
+
+  // Matrices are written one column per line, unless they are not transposed.
+  const bool vector = arma::is_Row<T>::value || arma::is_Col<T>::value;
+  const bool byColumn = !vector && !d.noTranspose;
+  const size_t numLines = vector ? matrix.n_elem :
+      (byColumn ? matrix.n_cols : matrix.n_rows);
+  const size_t lineSize = vector ? 1 :
+      (byColumn ? matrix.n_rows : matrix.n_cols);
+  for (size_t i = 0; i < numLines; ++i)
+  {
+    for (size_t j = 0; j < lineSize; ++j)
+    {
+      if (j > 0)
+        out << ",";
+      out << (vector ? matrix[i] : (byColumn ? matrix(j, i) : matrix(i, j)));
+    }
+    out << "\n";
+  }
+
+  out.precision(oldPrecision);
+  out.flush();
+  return true;
+}
+
+/**
+ * Other outputs are not streamed; return false.
+ */
+template<typename T>
+bool WriteStreamParam(
+    util::ParamData& /* d */,
+    const bool /* first */,
+    const std::enable_if_t<!arma::is_arma_type<T>::value>* = 0)
+{
+  return false;
+}
+
+/**
+ * Append the points of a matrix output to its file.  The input should be a
+ * bool that is true for the first chunk, and the output a bool that is set to
+ * whether the option is a matrix (and so was written).
+ */
+template<typename T>
+void WriteStreamParam(util::ParamData& d,
+                      const void* input,
+                      void* output)
+{
+  *((bool*) output) = WriteStreamParam<std::remove_pointer_t<T>>(d,
+      *((const bool*) input));
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -391,6 +391,148 @@ func (m *mlpackArma) armaToGonumUcol(p *params,
   return mat.NewDense(1, 1, nil)
 }
 
+// Returns whether the given Gonum matrix can hold an output of r rows and c
+// columns: it must have that shape, and its rows must be contiguous.
+func fitsBuffer(buffer *mat.Dense, r int, c int) bool {
+  if buffer == nil || r == 0 || c == 0 {
+    return false
+  }
+  br, bc := buffer.Dims()
+  return br == r && bc == c && buffer.RawMatrix().Stride == c
+}
+
+// Copies a matrix output into the given Gonum matrix and returns it, if it
+// has the right shape; otherwise the output is returned as a new Gonum matrix,
+// as with armaToGonumMat().
+func (m *mlpackArma) armaToGonumMatBuffer(p *params,
+                                          identifier string,
+                                          buffer *mat.Dense) *mat.Dense {
+  cIdentifier := C.CString(identifier)
+  defer C.free(unsafe.Pointer(cIdentifier))
+
+  c := int(C.mlpackNumRowMat(p.mem, cIdentifier))
+  r := int(C.mlpackNumColMat(p.mem, cIdentifier))
+  if fitsBuffer(buffer, r, c) {
+    data := buffer.RawMatrix().Data
+    ptr := unsafe.Pointer(&data[0])
+    if bool(C.mlpackArmaCopyMat(p.mem, cIdentifier, (*C.double)(ptr),
+        C.size_t(r * c))) {
+      return buffer
+    }
+  }
+  return m.armaToGonumMat(p, identifier)
+}
+
+// Copies a matrix output into the given Gonum matrix and returns it, if it
+// has the right shape; otherwise the output is returned as a new Gonum matrix,
+// as with armaToGonumUmat().
+func (m *mlpackArma) armaToGonumUmatBuffer(p *params,
+                                           identifier string,
+                                           buffer *mat.Dense) *mat.Dense {
+  cIdentifier := C.CString(identifier)
+  defer C.free(unsafe.Pointer(cIdentifier))
+
+  c := int(C.mlpackNumRowUmat(p.mem, cIdentifier))
+  r := int(C.mlpackNumColUmat(p.mem, cIdentifier))
+  if fitsBuffer(buffer, r, c) {
+    data := buffer.RawMatrix().Data
+    ptr := unsafe.Pointer(&data[0])
+    if bool(C.mlpackArmaCopyUmat(p.mem, cIdentifier, (*C.double)(ptr),
+        C.size_t(r * c))) {
+      return buffer
+    }
+  }
+  return m.armaToGonumUmat(p, identifier)
+}
+
+// Copies a vector output into the given Gonum matrix and returns it, if it
+// has the right shape; otherwise the output is returned as a new Gonum matrix,
+// as with armaToGonumRow().
+func (m *mlpackArma) armaToGonumRowBuffer(p *params,
+                                          identifier string,
+                                          buffer *mat.Dense) *mat.Dense {
+  cIdentifier := C.CString(identifier)
+  defer C.free(unsafe.Pointer(cIdentifier))
+
+  r := int(C.mlpackNumElemRow(p.mem, cIdentifier))
+  c := 1
+  if fitsBuffer(buffer, r, c) {
+    data := buffer.RawMatrix().Data
+    ptr := unsafe.Pointer(&data[0])
+    if bool(C.mlpackArmaCopyRow(p.mem, cIdentifier, (*C.double)(ptr),
+        C.size_t(r * c))) {
+      return buffer
+    }
+  }
+  return m.armaToGonumRow(p, identifier)
+}
+
+// Copies a vector output into the given Gonum matrix and returns it, if it
+// has the right shape; otherwise the output is returned as a new Gonum matrix,
+// as with armaToGonumUrow().
+func (m *mlpackArma) armaToGonumUrowBuffer(p *params,
+                                           identifier string,
+                                           buffer *mat.Dense) *mat.Dense {
+  cIdentifier := C.CString(identifier)
+  defer C.free(unsafe.Pointer(cIdentifier))
+
+  r := int(C.mlpackNumElemUrow(p.mem, cIdentifier))
+  c := 1
+  if fitsBuffer(buffer, r, c) {
+    data := buffer.RawMatrix().Data
+    ptr := unsafe.Pointer(&data[0])
+    if bool(C.mlpackArmaCopyUrow(p.mem, cIdentifier, (*C.double)(ptr),
+        C.size_t(r * c))) {
+      return buffer
+    }
+  }
+  return m.armaToGonumUrow(p, identifier)
+}
+
+// Copies a vector output into the given Gonum matrix and returns it, if it
+// has the right shape; otherwise the output is returned as a new Gonum matrix,
+// as with armaToGonumCol().
+func (m *mlpackArma) armaToGonumColBuffer(p *params,
+                                          identifier string,
+                                          buffer *mat.Dense) *mat.Dense {
+  cIdentifier := C.CString(identifier)
+  defer C.free(unsafe.Pointer(cIdentifier))
+
+  r := 1
+  c := int(C.mlpackNumElemCol(p.mem, cIdentifier))
+  if fitsBuffer(buffer, r, c) {
+    data := buffer.RawMatrix().Data
+    ptr := unsafe.Pointer(&data[0])
+    if bool(C.mlpackArmaCopyCol(p.mem, cIdentifier, (*C.double)(ptr),
+        C.size_t(r * c))) {
+      return buffer
+    }
+  }
+  return m.armaToGonumCol(p, identifier)
+}
+
+// Copies a vector output into the given Gonum matrix and returns it, if it
+// has the right shape; otherwise the output is returned as a new Gonum matrix,
+// as with armaToGonumUcol().
+func (m *mlpackArma) armaToGonumUcolBuffer(p *params,
+                                           identifier string,
+                                           buffer *mat.Dense) *mat.Dense {
+  cIdentifier := C.CString(identifier)
+  defer C.free(unsafe.Pointer(cIdentifier))
+
+  r := 1
+  c := int(C.mlpackNumElemUcol(p.mem, cIdentifier))
+  if fitsBuffer(buffer, r, c) {
+    data := buffer.RawMatrix().Data
+    ptr := unsafe.Pointer(&data[0])
+    if bool(C.mlpackArmaCopyUcol(p.mem, cIdentifier, (*C.double)(ptr),
+        C.size_t(r * c))) {
+      return buffer
+    }
+  }
+  return m.armaToGonumUcol(p, identifier)
+}
+
 // Passes a Gonum matrix to C by using the underlying data from the Gonum
 // matrix.
 func (m *mlpackArma) armaToGonumMatWithInfo(p *params,
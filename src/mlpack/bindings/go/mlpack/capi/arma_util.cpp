@@ -231,6 +231,78 @@ void* mlpackArmaPtrUcol(void* params, const char* identifier)
   return ptr;
 }
 
+/**
+ * Copy an Armadillo mat object into the given buffer.
+ */
+bool mlpackArmaCopyMat(void* params,
+                       const char* identifier,
+                       double* buffer,
+                       const size_t elem)
+{
+  util::Params& p = *((util::Params*) params);
+  return CopyToBuffer(p.Get<arma::mat>(identifier), buffer, elem);
+}
+
+/**
+ * Copy an Armadillo umat object into the given buffer.
+ */
+bool mlpackArmaCopyUmat(void* params,
+                        const char* identifier,
+                        double* buffer,
+                        const size_t elem)
+{
+  util::Params& p = *((util::Params*) params);
+  return CopyToBuffer(p.Get<arma::Mat<size_t>>(identifier), buffer, elem);
+}
+
+/**
+ * Copy an Armadillo row object into the given buffer.
+ */
+bool mlpackArmaCopyRow(void* params,
+                       const char* identifier,
+                       double* buffer,
+                       const size_t elem)
+{
+  util::Params& p = *((util::Params*) params);
+  return CopyToBuffer(p.Get<arma::Row<double>>(identifier), buffer, elem);
+}
+
+/**
+ * Copy an Armadillo urow object into the given buffer.
+ */
+bool mlpackArmaCopyUrow(void* params,
+                        const char* identifier,
+                        double* buffer,
+                        const size_t elem)
+{
+  util::Params& p = *((util::Params*) params);
+  return CopyToBuffer(p.Get<arma::Row<size_t>>(identifier), buffer, elem);
+}
+
+/**
+ * Copy an Armadillo col object into the given buffer.
+ */
+bool mlpackArmaCopyCol(void* params,
+                       const char* identifier,
+                       double* buffer,
+                       const size_t elem)
+{
+  util::Params& p = *((util::Params*) params);
+  return CopyToBuffer(p.Get<arma::Col<double>>(identifier), buffer, elem);
+}
+
+/**
+ * Copy an Armadillo ucol object into the given buffer.
+ */
+bool mlpackArmaCopyUcol(void* params,
+                        const char* identifier,
+                        double* buffer,
+                        const size_t elem)
+{
+  util::Params& p = *((util::Params*) params);
+  return CopyToBuffer(p.Get<arma::Col<size_t>>(identifier), buffer, elem);
+}
+
 /**
  * Return the number of rows in a Armadillo mat.
  */
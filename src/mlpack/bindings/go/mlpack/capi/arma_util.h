@@ -102,6 +102,60 @@ void* mlpackArmaPtrCol(void* params, const char* identifier);
  */
 void* mlpackArmaPtrUcol(void* params, const char* identifier);
 
+/**
+ * Copy an Armadillo mat object into the given buffer, if it has the same
+ * number of elements; return whether it was copied.
+ */
+bool mlpackArmaCopyMat(void* params,
+                       const char* identifier,
+                       double* buffer,
+                       const size_t elem);
+
+/**
+ * Copy an Armadillo umat object into the given buffer, if it has the same
+ * number of elements; return whether it was copied.
+ */
+bool mlpackArmaCopyUmat(void* params,
+                        const char* identifier,
+                        double* buffer,
+                        const size_t elem);
+
+/**
+ * Copy an Armadillo row object into the given buffer, if it has the same
+ * number of elements; return whether it was copied.
+ */
+bool mlpackArmaCopyRow(void* params,
+                       const char* identifier,
+                       double* buffer,
+                       const size_t elem);
+
+/**
+ * Copy an Armadillo urow object into the given buffer, if it has the same
+ * number of elements; return whether it was copied.
+ */
+bool mlpackArmaCopyUrow(void* params,
+                        const char* identifier,
+                        double* buffer,
+                        const size_t elem);
+
+/**
+ * Copy an Armadillo col object into the given buffer, if it has the same
+ * number of elements; return whether it was copied.
+ */
+bool mlpackArmaCopyCol(void* params,
+                       const char* identifier,
+                       double* buffer,
+                       const size_t elem);
+
+/**
+ * Copy an Armadillo ucol object into the given buffer, if it has the same
+ * number of elements; return whether it was copied.
+ */
+bool mlpackArmaCopyUcol(void* params,
+                        const char* identifier,
+                        double* buffer,
+                        const size_t elem);
+
 /**
  * Return the number of rows in a Armadillo mat.
  */
@@ -44,6 +44,23 @@ inline typename T::elem_type* GetMemory(T& m)
   }
 }
 
+/**
+ * Copy the elements of the given matrix into the given buffer (converted to
+ * double), if the buffer holds the same number of elements.  The matrix keeps
+ * its memory, which is freed with the parameters.
+ *
+ * @return Whether the elements were copied.
+ */
+template<typename T>
+inline bool CopyToBuffer(const T& m, double* buffer, const size_t elem)
+{
+  if (buffer == NULL || m.n_elem != elem)
+    return false;
+
+  std::copy(m.begin(), m.end(), buffer);
+  return true;
+}
+
 } // namespace mlpack
 
 #endif
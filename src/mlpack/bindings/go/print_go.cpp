@@ -108,6 +108,18 @@ void PrintGo(util::Params& params,
     size_t indent = 4;
     params.functionMap[d.tname]["PrintMethodConfig"](d, (void*) &indent, NULL);
   }
+
+  // Matrix outputs can be written into preallocated Gonum matrices, so that
+  // repeated calls do not allocate them again.
+  for (size_t i = 0; i < outputOptions.size(); ++i)
+  {
+    util::ParamData& d = parameters.at(outputOptions[i]);
+    if ((d.cppType).compare(0, 6, "arma::") == 0)
+    {
+      cout << "    " << util::CamelCase(d.name, false) << "Buffer *mat.Dense"
+          << endl;
+    }
+  }
   cout << "}" << endl;
   cout << endl;
 
@@ -66,16 +66,19 @@ void PrintOutputProcessing(
    * This gives us code like:
    *
    *  var \<paramName\>Ptr mlpackArma
-   *  \<paramName\> := \<paramName\>_ptr.ArmaToGonum_\<Type\>(params,
-   *      "paramName")
+   *  \<paramName\> := \<paramName\>Ptr.armaToGonum\<Type\>Buffer(params,
+   *      "paramName", param.\<ParamName\>Buffer)
    *
+   * which writes the output into the preallocated Gonum matrix given in the
+   * optional parameters, if it has the right shape.
    */
   std::string name = d.name;
   name = util::CamelCase(name, true);
   std::cout << prefix << "var " << name << "Ptr mlpackArma" << std::endl;
   std::cout << prefix << name << " := " << name
             << "Ptr.armaToGonum" << GetType<T>(d)
-            << "(params, \""  << d.name << "\")" << std::endl;
+            << "Buffer(params, \""  << d.name << "\", param."
+            << util::CamelCase(d.name, false) << "Buffer)" << std::endl;
 }
 /**
  * Print output processing for a matrix with info type.
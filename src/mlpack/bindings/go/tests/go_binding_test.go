@@ -158,6 +158,53 @@ func TestGonumMatrix(t *testing.T) {
   }
 }
 
+func TestGonumMatrixBuffer(t *testing.T) {
+  t.Log("Test that a matrix output is written into a preallocated buffer of",
+        "the right shape, and that a buffer of the wrong shape is ignored.")
+  x := mat.NewDense(3, 5, []float64{
+    1, 2, 3, 4, 5,
+    6, 7, 8, 9, 10,
+    11, 12, 13, 14, 15,
+  })
+
+  y := mat.NewDense(3, 4, []float64{
+    1, 2, 6, 4,
+    6, 7, 16, 9,
+    11, 12, 26, 14,
+  })
+
+  buffer := mat.NewDense(3, 4, nil)
+  param := mlpack.TestGoBindingOptions()
+  param.MatrixIn = x
+  param.MatrixOutBuffer = buffer
+  d := 4.0
+  i := 12
+  s := "hello"
+  _, _, _, _, MatrixOut, _, _, _, _, _, _, _, _, _ :=
+      mlpack.TestGoBinding(d, i, s, param)
+
+  if MatrixOut != buffer {
+    t.Errorf("Error. The output was not written into the buffer.")
+  }
+  if !mat.Equal(buffer, y) {
+    t.Errorf("Error. Wrong values in the buffer.")
+  }
+
+  wrongBuffer := mat.NewDense(4, 3, nil)
+  param = mlpack.TestGoBindingOptions()
+  param.MatrixIn = x
+  param.MatrixOutBuffer = wrongBuffer
+  _, _, _, _, MatrixOut, _, _, _, _, _, _, _, _, _ =
+      mlpack.TestGoBinding(d, i, s, param)
+
+  if MatrixOut == wrongBuffer {
+    t.Errorf("Error. A buffer of the wrong shape was used.")
+  }
+  if !mat.Equal(MatrixOut, y) {
+    t.Errorf("Error. Wrong values in the output.")
+  }
+}
+
 func TestGonumUMatrix(t *testing.T) {
   t.Log("Test that the umatrix we get back should be the umatrix we pass",
         "in with the third dimension doubled and the fifth forgotten.")
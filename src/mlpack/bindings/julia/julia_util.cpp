@@ -266,8 +266,16 @@ void SetParamMatWithInfo(void* params,
       hasCategoricals = true;
   }
 
+  // The matrix is only copied if it has to be transposed, or if categorical
+  // values have to be shifted (which must not modify the Julia array).
   arma::mat alias(memptr, arma::uword(rows), arma::uword(cols), false, false);
-  arma::mat m = pointsAreRows ? alias.t() : alias;
+  arma::mat m;
+  if (pointsAreRows)
+    m = alias.t();
+  else if (hasCategoricals)
+    m = alias;
+  else
+    m = std::move(alias);
 
   // Do we need to find how many categories we have?
   if (hasCategoricals)
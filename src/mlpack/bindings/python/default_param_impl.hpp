@@ -121,6 +121,10 @@ std::string DefaultParamImpl(
   {
     return "np.empty([0, 0], dtype=np.uint64)";
   }
+  else if (std::is_same_v<T, arma::fmat>)
+  {
+    return "np.empty([0, 0], dtype=np.float32)";
+  }
   else
   {
     return "np.empty([0, 0])";
@@ -50,6 +50,16 @@ inline std::string GetCythonType<double>(
   return "double";
 }
 
+template<>
+inline std::string GetCythonType<float>(
+    util::ParamData& /* d */,
+    const std::enable_if_t<!util::IsStdVector<float>::value>*,
+    const std::enable_if_t<!data::HasSerialize<float>::value>*,
+    const std::enable_if_t<!arma::is_arma_type<float>::value>*)
+{
+  return "float";
+}
+
 template<>
 inline std::string GetCythonType<std::string>(
     util::ParamData& /* d */,
@@ -30,6 +30,12 @@ inline std::string GetNumpyType<double>()
   return "np.double";
 }
 
+template<>
+inline std::string GetNumpyType<float>()
+{
+  return "np.float32";
+}
+
 template<>
 inline std::string GetNumpyType<size_t>()
 {
@@ -63,6 +63,13 @@ inline std::string GetNumpyTypeChar<arma::rowvec>()
   return "d";
 }
 
+// float = f.
+template<>
+inline std::string GetNumpyTypeChar<arma::fmat>()
+{
+  return "f";
+}
+
 } // namespace python
 } // namespace bindings
 } // namespace mlpack
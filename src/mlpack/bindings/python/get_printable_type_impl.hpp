@@ -120,6 +120,10 @@ inline std::string GetPrintableType(
     if (T::is_row || T::is_col)
       type = "int vector";
   }
+  else if (std::is_same_v<typename T::elem_type, float>)
+  {
+    type = "float32 matrix";
+  }
 
   return type;
 }
@@ -28,6 +28,8 @@ cdef Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X, \
                                  bool takeOwnership) except +
 cdef Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X, \
                                  bool takeOwnership) except +
+cdef Mat[float]* numpy_to_mat_f(numpy.ndarray[numpy.float32_t, ndim=2] X, \
+                                bool takeOwnership) except +
 
 """
 Convert an Armadillo object to a numpy ndarray of the given type.
@@ -36,6 +38,8 @@ cdef numpy.ndarray[numpy.double_t, ndim=2] mat_to_numpy_d(Mat[double]& X) \
     except +
 cdef numpy.ndarray[numpy.npy_intp, ndim=2] mat_to_numpy_s(Mat[size_t]& X) \
     except +
+cdef numpy.ndarray[numpy.float32_t, ndim=2] mat_to_numpy_f(Mat[float]& X) \
+    except +
 
 """
 Convert a numpy one-dimensional ndarray to a row of the given type.
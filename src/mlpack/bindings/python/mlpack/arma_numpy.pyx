@@ -45,6 +45,7 @@ cdef extern from "<mlpack/bindings/python/mlpack/arma_util.hpp>":
   size_t* GetMemory(Mat[size_t]& m)
   size_t* GetMemory(Col[size_t]& m)
   size_t* GetMemory(Row[size_t]& m)
+  float* GetMemory(Mat[float]& m)
 
 cdef Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X, \
                                  bool takeOwnership) except +:
@@ -53,13 +54,16 @@ cdef Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # Only copy if the memory cannot be used as-is.  Contiguous arrays that we
+    # do not need to own (including views and memory-mapped arrays) are used
+    # directly, without copying; each row of the array is a column of the
+    # matrix, so no transposition is needed.
     X = X.copy(order="C")
     takeOwnership = True
 
   cdef Mat[double]* m = new Mat[double](<double*> PyArray_DATA(X),
-      PyArray_SHAPE(X)[1], PyArray_SHAPE(X)[0], isWin, False)
+      PyArray_SHAPE(X)[1], PyArray_SHAPE(X)[0], isWin and takeOwnership, False)
 
   # Take ownership of the memory, if we need to and we are not on Windows.
   if takeOwnership and not isWin:
@@ -75,14 +79,16 @@ cdef Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # Only copy if the memory cannot be used as-is.  Contiguous arrays that we
+    # do not need to own (including views and memory-mapped arrays) are used
+    # directly, without copying; each row of the array is a column of the
+    # matrix, so no transposition is needed.
     X = X.copy(order="C")
     takeOwnership = True
 
   cdef Mat[size_t]* m = new Mat[size_t](<size_t*> PyArray_DATA(X),
-      PyArray_SHAPE(X)[1], PyArray_SHAPE(X)[0], isWin, False)
+      PyArray_SHAPE(X)[1], PyArray_SHAPE(X)[0], isWin and takeOwnership, False)
 
   # Take ownership of the memory, if we need to.
   if takeOwnership and not isWin:
@@ -133,6 +139,51 @@ cdef numpy.ndarray[numpy.npy_intp, ndim=2] mat_to_numpy_s(Mat[size_t]& X) \
 
   return output
 
+cdef Mat[float]* numpy_to_mat_f(numpy.ndarray[numpy.float32_t, ndim=2] X, \
+                                bool takeOwnership) except +:
+  """
+  Convert a numpy ndarray to a single-precision matrix.  The memory will still
+  be owned by numpy.
+  """
+  cdef int flags = PyArray_FLAGS(X)
+  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # Only copy if the memory cannot be used as-is; see numpy_to_mat_d().
+    X = X.copy(order="C")
+    takeOwnership = True
+
+  cdef Mat[float]* m = new Mat[float](<float*> PyArray_DATA(X),
+      PyArray_SHAPE(X)[1], PyArray_SHAPE(X)[0], isWin and takeOwnership, False)
+
+  # Take ownership of the memory, if we need to.
+  if takeOwnership and not isWin:
+    PyArray_CLEARFLAGS(X, numpy.NPY_ARRAY_OWNDATA)
+    SetMemState[Mat[float]](m[0], 0)
+
+  return m
+
+cdef numpy.ndarray[numpy.float32_t, ndim=2] mat_to_numpy_f(Mat[float]& X) \
+    except +:
+  """
+  Convert a single-precision Armadillo object to a numpy ndarray.
+  """
+  # Extract dimensions.
+  cdef numpy.npy_intp dims[2]
+  dims[0] = <numpy.npy_intp> X.n_cols
+  dims[1] = <numpy.npy_intp> X.n_rows
+  cdef numpy.ndarray[numpy.float32_t, ndim=2] output = \
+      numpy.PyArray_SimpleNewFromData(2, &dims[0], numpy.NPY_FLOAT32,
+                                      GetMemory(X))
+  if isWin:
+    output = output.copy(order="C")
+
+  # Transfer memory ownership, if needed.
+  if GetMemState[Mat[float]](X) == 0 and not isWin:
+    SetMemState[Mat[float]](X, 1)
+    PyArray_ENABLEFLAGS(output, numpy.NPY_ARRAY_OWNDATA)
+
+  return output
+
 cdef Row[double]* numpy_to_row_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
                                  bool takeOwnership) except +:
   """
@@ -141,14 +192,16 @@ cdef Row[double]* numpy_to_row_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # Only copy if the memory cannot be used as-is.  Contiguous arrays that we
+    # do not need to own (including views and memory-mapped arrays) are used
+    # directly, without copying; each row of the array is a column of the
+    # matrix, so no transposition is needed.
     X = X.copy(order="C")
     takeOwnership = True
 
   cdef Row[double]* m = new Row[double](<double*> PyArray_DATA(X),
-    PyArray_SHAPE(X)[0], isWin, False)
+    PyArray_SHAPE(X)[0], isWin and takeOwnership, False)
 
   # Transfer memory ownership, if needed.
   if takeOwnership and not isWin:
@@ -165,14 +218,16 @@ cdef Row[size_t]* numpy_to_row_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # Only copy if the memory cannot be used as-is.  Contiguous arrays that we
+    # do not need to own (including views and memory-mapped arrays) are used
+    # directly, without copying; each row of the array is a column of the
+    # matrix, so no transposition is needed.
     X = X.copy(order="C")
     takeOwnership = True
 
   cdef Row[size_t]* m = new Row[size_t](<size_t*> PyArray_DATA(X),
-      PyArray_SHAPE(X)[0], isWin, False)
+      PyArray_SHAPE(X)[0], isWin and takeOwnership, False)
 
   # Transfer memory ownership, if needed.
   if takeOwnership and not isWin:
@@ -228,14 +283,16 @@ cdef Col[double]* numpy_to_col_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # Only copy if the memory cannot be used as-is.  Contiguous arrays that we
+    # do not need to own (including views and memory-mapped arrays) are used
+    # directly, without copying; each row of the array is a column of the
+    # matrix, so no transposition is needed.
     X = X.copy(order="C")
     takeOwnership = True
 
   cdef Col[double]* m = new Col[double](<double*> PyArray_DATA(X),
-      PyArray_SHAPE(X)[0], isWin, False)
+      PyArray_SHAPE(X)[0], isWin and takeOwnership, False)
 
   # Transfer memory ownership, if needed.
   if takeOwnership and not isWin:
@@ -252,14 +309,16 @@ cdef Col[size_t]* numpy_to_col_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   """
   cdef int flags = PyArray_FLAGS(X)
   if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+    (takeOwnership and not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+    # Only copy if the memory cannot be used as-is.  Contiguous arrays that we
+    # do not need to own (including views and memory-mapped arrays) are used
+    # directly, without copying; each row of the array is a column of the
+    # matrix, so no transposition is needed.
     X = X.copy(order="C")
     takeOwnership = True
 
   cdef Col[size_t]* m = new Col[size_t](<size_t*> PyArray_DATA(X), 
-      PyArray_SHAPE(X)[0], isWin, False)
+      PyArray_SHAPE(X)[0], isWin and takeOwnership, False)
 
   # Transfer memory ownership, if needed.
   if takeOwnership and not isWin:
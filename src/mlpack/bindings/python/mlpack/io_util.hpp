@@ -39,6 +39,16 @@ inline void TransposeIfNeeded(
   }
 }
 
+inline void TransposeIfNeeded(
+    arma::fmat& value,
+    bool transpose)
+{
+  if (transpose)
+  {
+    arma::inplace_trans(value);
+  }
+}
+
 /**
  * Set the parameter to the given value.
  *
@@ -77,7 +77,8 @@ void PrintPYX(const util::BindingDetails& doc,
   cout << "from .arma_numpy cimport numpy_to_mat_d, numpy_to_mat_s, "
       << "mat_to_numpy_d, mat_to_numpy_s, numpy_to_row_d, numpy_to_row_s, "
       << "row_to_numpy_d, row_to_numpy_s, numpy_to_col_d, numpy_to_col_s, "
-      << "col_to_numpy_d, col_to_numpy_s" << endl;
+      << "col_to_numpy_d, col_to_numpy_s, numpy_to_mat_f, mat_to_numpy_f"
+      << endl;
   cout << "from .io cimport IO" << endl;
   cout << "from .params cimport Params" << endl;
   cout << "from .timers cimport Timers" << endl;
@@ -249,9 +250,14 @@ void PrintPYX(const util::BindingDetails& doc,
   cout << "  if check_input_matrices:" << endl;
   cout << "    p.CheckInputMatrices()" << endl;
 
-  // Call the method.
-  cout << "  # Call the mlpack program." << endl;
-  cout << "  mlpack_" << bindingName << "(p, t)" << endl;
+  // Call the method.  The Params and Timers objects belong to this call, and
+  // the inputs held by p are kept alive by the Python locals, so the GIL can
+  // be released while the C++ computation runs; other Python threads (and
+  // other bindings) can then run at the same time.  If an exception is thrown,
+  // Cython takes the GIL back before raising it.
+  cout << "  # Call the mlpack program, without holding the GIL." << endl;
+  cout << "  with nogil:" << endl;
+  cout << "    mlpack_" << bindingName << "(p, t)" << endl;
 
   // Do any output processing and return.
   cout << "  # Initialize result dictionary." << endl;
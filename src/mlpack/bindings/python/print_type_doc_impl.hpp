@@ -119,6 +119,12 @@ std::string PrintTypeDoc(
           "dtype is not already uint64, it will be converted.";
     }
   }
+  else if (std::is_same_v<typename T::elem_type, float>)
+  {
+    return "A 2-d arraylike containing data with a float32 dtype.  This can be "
+        "a list of lists, a numpy ndarray, or a pandas DataFrame.  If the dtype "
+        "is not already float32, it will be converted.";
+  }
   else
   {
     throw std::invalid_argument("unknown matrix type " + data.cppType);
@@ -13,6 +13,7 @@ import unittest
 import pandas as pd
 import numpy as np
 import copy
+import threading
 
 from mlpack.test_python_binding import test_python_binding
 
@@ -157,6 +158,57 @@ class TestPythonBinding(unittest.TestCase):
       self.assertEqual(2 * x[j, 2], output['matrix_out'][j, 2])
 
 
+  def testNumpyMatrixView(self):
+    """
+    A contiguous view of a larger matrix (which does not own its memory) should
+    be usable without a copy, and give the same results.
+    """
+    x = np.random.rand(120, 5);
+    z = copy.deepcopy(x)[10:110]
+    self.assertFalse(z.flags.owndata)
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 matrix_in=z)
+
+    self.assertEqual(output['matrix_out'].shape[0], 100)
+    self.assertEqual(output['matrix_out'].shape[1], 4)
+    self.assertEqual(output['matrix_out'].dtype, np.double)
+    for i in [0, 1, 3]:
+      for j in range(100):
+        self.assertEqual(x[j + 10, i], output['matrix_out'][j, i])
+
+    for j in range(100):
+      self.assertEqual(2 * x[j + 10, 2], output['matrix_out'][j, 2])
+
+  def testNumpyFloatMatrix(self):
+    """
+    A float32 matrix should be passed as-is, and we should get back a float32
+    matrix with the third dimension doubled and the fifth dimension dropped.
+    """
+    x = np.random.rand(100, 5).astype(np.float32)
+    z = copy.deepcopy(x)
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 fmatrix_in=z)
+
+    self.assertEqual(output['fmatrix_out'].shape[0], 100)
+    self.assertEqual(output['fmatrix_out'].shape[1], 4)
+    self.assertEqual(output['fmatrix_out'].dtype, np.float32)
+    for i in [0, 1, 3]:
+      for j in range(100):
+        self.assertEqual(x[j, i], output['fmatrix_out'][j, i])
+
+    for j in range(100):
+      self.assertEqual(2 * x[j, 2], output['fmatrix_out'][j, 2])
+
   def testNumpyFContiguousMatrix(self):
     """
     The matrix with F_CONTIGUOUS set we pass in, we should get back with the third
@@ -1461,5 +1513,38 @@ class TestPythonBinding(unittest.TestCase):
                                                    matrix_and_info_in=x,
                                                    check_input_matrices=True))
 
+  def testConcurrentCalls(self):
+    """
+    Each call has its own parameters, so calls from several threads at once
+    must each get their own results.
+    """
+    inputs = [np.random.rand(100, 5) for i in range(8)]
+    outputs = [None] * len(inputs)
+
+    def run(i):
+      outputs[i] = test_python_binding(string_in='hello',
+                                       int_in=12,
+                                       double_in=4.0,
+                                       mat_req_in=[[1.0]],
+                                       col_req_in=[1.0],
+                                       matrix_in=inputs[i],
+                                       flag1=True,
+                                       copy_all_inputs=True)
+
+    threads = [threading.Thread(target=run, args=(i,))
+        for i in range(len(inputs))]
+    for thread in threads:
+      thread.start()
+    for thread in threads:
+      thread.join()
+
+    for i in range(len(inputs)):
+      self.assertEqual(outputs[i]['string_out'], 'hello2')
+      self.assertEqual(outputs[i]['int_out'], 13)
+      self.assertEqual(outputs[i]['matrix_out'].shape[0], 100)
+      self.assertEqual(outputs[i]['matrix_out'].shape[1], 4)
+      for j in range(100):
+        self.assertEqual(2 * inputs[i][j, 2], outputs[i]['matrix_out'][j, 2])
+
 if __name__ == '__main__':
   unittest.main()
@@ -46,6 +46,7 @@ PARAM_FLAG("flag2", "Input flag, must not be specified.", "F");
 PARAM_MATRIX_IN("matrix_in", "Input matrix.", "m");
 PARAM_MATRIX_IN("smatrix_in", "Input matrix.", "");
 PARAM_UMATRIX_IN("umatrix_in", "Input unsigned matrix.", "u");
+PARAM_FMATRIX_IN("fmatrix_in", "Input single-precision matrix.", "");
 PARAM_TMATRIX_IN("tmatrix_in", "Input transposed matrix.", "");
 PARAM_COL_IN("col_in", "Input column.", "c");
 PARAM_UCOL_IN("ucol_in", "Input unsigned column.", "");
@@ -63,6 +64,7 @@ PARAM_INT_OUT("int_out", "Output int, will be 13.");
 PARAM_DOUBLE_OUT("double_out", "Output double, will be 5.0.");
 PARAM_MATRIX_OUT("matrix_out", "Output matrix.", "M");
 PARAM_UMATRIX_OUT("umatrix_out", "Output unsigned matrix.", "U");
+PARAM_FMATRIX_OUT("fmatrix_out", "Output single-precision matrix.", "");
 PARAM_COL_OUT("col_out", "Output column. 2x input column", "");
 PARAM_UCOL_OUT("ucol_out", "Output unsigned column. 2x input column.", "");
 PARAM_ROW_OUT("row_out", "Output row.  2x input row.", "");
@@ -161,6 +163,17 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timer */)
     params.Get<arma::Mat<size_t>>("umatrix_out") = std::move(out);
   }
 
+  // Input matrices should be at least 5 rows; the 5th row will be dropped and
+  // the 3rd row will be multiplied by two.
+  if (params.Has("fmatrix_in"))
+  {
+    arma::fmat out = std::move(params.Get<arma::fmat>("fmatrix_in"));
+    out.shed_row(4);
+    out.row(2) *= 2.0f;
+
+    params.Get<arma::fmat>("fmatrix_out") = std::move(out);
+  }
+
   // An input matrix (pandas.Series) should have all elements multiplied by two.
   if (params.Has("smatrix_in"))
   {
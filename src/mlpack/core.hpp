@@ -40,8 +40,11 @@
 #include <mlpack/core/util/first_element_is_arma.hpp>
 #include <mlpack/core/util/using.hpp>
 #include <mlpack/core/util/conv_to.hpp>
+#include <mlpack/core/util/parallel.hpp>
+#include <mlpack/core/util/batch_scheduler.hpp>
 #include <mlpack/core/util/log.hpp>
 #include <mlpack/core/util/io.hpp>
+#include <mlpack/core/util/profiler.hpp>
 #include <mlpack/core/data/data.hpp>
 #include <mlpack/core/math/math.hpp>
 
@@ -60,6 +63,12 @@
 #include <mlpack/core/cv/cv.hpp>
 #include <mlpack/core/hpt/hpt.hpp>
 
+// Include wrappers for training across several processes.
+#include <mlpack/core/distributed/distributed.hpp>
+
+// Include the optimizers implemented in mlpack.
+#include <mlpack/core/optimizers/optimizers.hpp>
+
 // Use OpenMP if available.
 #ifdef MLPACK_USE_OPENMP
   #include <omp.h>
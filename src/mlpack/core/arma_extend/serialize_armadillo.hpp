@@ -20,10 +20,36 @@
 
 #include <armadillo>
 
+namespace cereal {
+
+/**
+ * Serialize the given array of n elements.  Binary archives read or write the
+ * whole array in one call (which gives exactly the same bytes as serializing
+ * the elements one by one, so files written either way can be read either
+ * way); text archives store one named value per element.
+ */
+template<typename Archive, typename eT>
+void SerializeArmaArray(Archive& ar,
+                        eT* mem,
+                        const size_t n,
+                        const char* name)
+{
+  if constexpr (std::is_arithmetic<eT>::value &&
+      !cereal::traits::is_text_archive<Archive>::value)
+  {
+    if (n > 0)
+      ar(cereal::binary_data(mem, n * sizeof(eT)));
+  }
+  else
+  {
+    for (size_t i = 0; i < n; ++i)
+      ar(cereal::make_nvp(name, mem[i]));
+  }
+}
+
 /**
  * Add an external serialization function for SpMat.
  */
-namespace cereal {
 
 template<typename Archive, typename eT>
 void serialize(Archive& ar, arma::SpMat<eT>& mat)
@@ -51,12 +77,11 @@ void serialize(Archive& ar, arma::SpMat<eT>& mat)
   }
 
   // Serialize the values held in the sparse matrix.
-  for (size_t i = 0; i < mat.n_nonzero; ++i)
-    ar(cereal::make_nvp("value", arma::access::rw(mat.values[i])));
-  for (size_t i = 0; i < mat.n_nonzero; ++i)
-    ar(cereal::make_nvp("row_index", arma::access::rw(mat.row_indices[i])));
-  for (size_t i = 0; i < mat.n_cols + 1; ++i)
-    ar(cereal::make_nvp("col_ptr", arma::access::rw(mat.col_ptrs[i])));
+  SerializeArmaArray(ar, const_cast<eT*>(mat.values), mat.n_nonzero, "value");
+  SerializeArmaArray(ar, const_cast<arma::uword*>(mat.row_indices),
+      mat.n_nonzero, "row_index");
+  SerializeArmaArray(ar, const_cast<arma::uword*>(mat.col_ptrs),
+      mat.n_cols + 1, "col_ptr");
 }
 
 // Add an external serialization function for Mat.
@@ -79,8 +104,7 @@ void serialize(Archive& ar, arma::Mat<eT>& mat)
   }
 
   // Directly serialize the contents of the matrix's memory.
-  for (size_t i = 0; i < mat.n_elem; ++i)
-    ar(cereal::make_nvp("elem", arma::access::rw(mat.mem[i])));
+  SerializeArmaArray(ar, mat.memptr(), mat.n_elem, "elem");
 }
 
 // Add a serialization function for armadillo Cube
@@ -100,8 +124,7 @@ void serialize(Archive& ar, arma::Cube<eT>& cube)
     cube.set_size(n_rows, n_cols, n_slices);
 
   // Directly serialize the contents of the cube's memory.
-  for (size_t i = 0; i < cube.n_elem; ++i)
-    ar(cereal::make_nvp("elem", arma::access::rw(cube.mem[i])));
+  SerializeArmaArray(ar, cube.memptr(), cube.n_elem, "elem");
 }
 
 } // end namespace cereal
@@ -176,9 +176,44 @@ class KFoldCV
   template<typename... MLAlgorithmArgs>
   double Evaluate(const MLAlgorithmArgs& ...args);
 
+  /**
+   * Run k-fold cross-validation, training each fold on only the first
+   * `trainingFraction` of its training subset (a view of the data, which is
+   * not copied), and evaluating it on its whole validation subset.  The model
+   * of the last fold is stored in `model` instead of in this object.  Since the
+   * object is not modified, this can be called from several threads at the
+   * same time; HyperParameterTuner uses it to evaluate several sets of
+   * hyper-parameters in parallel, and to evaluate them on growing training
+   * sets.  A std::invalid_argument is thrown if `trainingFraction` is not in
+   * (0, 1].
+   *
+   * @param trainingFraction Fraction of the training subsets to train on.
+   * @param model Pointer to store the model of the last fold in.
+   * @param args Arguments for MLAlgorithm (in addition to the passed
+   *     ones in the constructor).
+   */
+  template<typename... MLAlgorithmArgs>
+  double EvaluateSubset(const double trainingFraction,
+                        std::unique_ptr<MLAlgorithm>& model,
+                        const MLAlgorithmArgs& ...args);
+
   //! Access and modify a model from the last run of k-fold cross-validation.
   MLAlgorithm& Model();
 
+  //! Get the maximum number of folds that are trained at the same time.
+  size_t ConcurrentFolds() const { return concurrentFolds; }
+  /**
+   * Modify the maximum number of folds that are trained at the same time; the
+   * default, 1, trains the folds one after another.  With OpenMP, up to this
+   * many folds are trained and evaluated in parallel.  The training and
+   * validation subsets are views of the data (which is permuted into
+   * contiguous bins once, at construction and by Shuffle()), so each concurrent
+   * fold only adds the memory of one model.  Randomized algorithms use a
+   * different random number generator in each thread, so their results may
+   * differ from sequential evaluation.
+   */
+  size_t& ConcurrentFolds() { return concurrentFolds; }
+
  private:
   //! A short alias for CVBase.
   using Base = CVBase<MLAlgorithm, MatType, PredictionsType, WeightsType>;
@@ -224,6 +259,9 @@ class KFoldCV
   //! A pointer to a model from the last run of k-fold cross-validation.
   std::unique_ptr<MLAlgorithm> modelPtr;
 
+  //! The maximum number of folds that are trained at the same time.
+  size_t concurrentFolds;
+
   /**
    * Assert the k parameter and data consistency and initialize fields required
    * for running k-fold cross-validation.
@@ -258,7 +296,9 @@ class KFoldCV
   template<typename... MLAlgorithmArgs,
            bool Enabled = !Base::MIE::SupportsWeights,
            typename = std::enable_if_t<Enabled>>
-  double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
+  double TrainAndEvaluate(const double trainingFraction,
+                          std::unique_ptr<MLAlgorithm>& lastModel,
+                          const MLAlgorithmArgs& ...mlAlgorithmArgs);
 
   /**
    * Train and run evaluation in the case of supporting weighted learning.
@@ -267,7 +307,9 @@ class KFoldCV
            bool Enabled = Base::MIE::SupportsWeights,
            typename = std::enable_if_t<Enabled>,
            typename = void>
-  double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
+  double TrainAndEvaluate(const double trainingFraction,
+                          std::unique_ptr<MLAlgorithm>& lastModel,
+                          const MLAlgorithmArgs& ...mlAlgorithmArgs);
 
   /**
    * Calculate the index of the first column of the ith validation subset.
@@ -278,18 +320,31 @@ class KFoldCV
   inline size_t ValidationSubsetFirstCol(const size_t i);
 
   /**
-   * Get the ith training subset from a variable of a matrix type.
+   * Get the number of points of the ith training subset that are used when
+   * training on the given fraction of it (at least one).
+   */
+  inline size_t TrainingSubsetSize(const size_t i,
+                                   const double trainingFraction) const;
+
+  /**
+   * Get the first points of the ith training subset from a variable of a
+   * matrix type.
    */
   template<typename ElementType>
-  inline arma::Mat<ElementType> GetTrainingSubset(arma::Mat<ElementType>& m,
-                                                  const size_t i);
+  inline arma::Mat<ElementType> GetTrainingSubset(
+      arma::Mat<ElementType>& m,
+      const size_t i,
+      const double trainingFraction = 1.0);
 
   /**
-   * Get the ith training subset from a variable of a row type.
+   * Get the first points of the ith training subset from a variable of a row
+   * type.
    */
   template<typename ElementType>
-  inline arma::Row<ElementType> GetTrainingSubset(arma::Row<ElementType>& r,
-                                                  const size_t i);
+  inline arma::Row<ElementType> GetTrainingSubset(
+      arma::Row<ElementType>& r,
+      const size_t i,
+      const double trainingFraction = 1.0);
 
   /**
    * Get the ith validation subset from a variable of a matrix type.
@@ -12,6 +12,8 @@
 #ifndef MLPACK_CORE_CV_K_FOLD_CV_IMPL_HPP
 #define MLPACK_CORE_CV_K_FOLD_CV_IMPL_HPP
 
+#include <exception>
+
 namespace mlpack {
 
 template<typename MLAlgorithm,
@@ -134,7 +136,8 @@ KFoldCV<MLAlgorithm,
                               const PredictionsType& ys,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    concurrentFolds(1)
 {
   if (k < 2)
     throw std::invalid_argument("KFoldCV: k should not be less than 2");
@@ -165,7 +168,8 @@ KFoldCV<MLAlgorithm,
                               const WeightsType& weights,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    concurrentFolds(1)
 {
   Base::AssertWeightsConsistency(xs, weights);
 
@@ -190,7 +194,29 @@ double KFoldCV<MLAlgorithm,
                PredictionsType,
                WeightsType>::Evaluate(const MLAlgorithmArgs&... args)
 {
-  return TrainAndEvaluate(args...);
+  return TrainAndEvaluate(1.0, modelPtr, args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+double KFoldCV<MLAlgorithm,
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::EvaluateSubset(
+    const double trainingFraction,
+    std::unique_ptr<MLAlgorithm>& model,
+    const MLAlgorithmArgs&... args)
+{
+  if (!(trainingFraction > 0.0 && trainingFraction <= 1.0))
+    throw std::invalid_argument("KFoldCV::EvaluateSubset(): the training "
+        "fraction should be in (0, 1]");
+
+  return TrainAndEvaluate(trainingFraction, model, args...);
 }
 
 template<typename MLAlgorithm,
@@ -241,17 +267,46 @@ double KFoldCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    const double trainingFraction,
+    std::unique_ptr<MLAlgorithm>& lastModel,
+    const MLAlgorithmArgs&... args)
 {
   arma::vec evaluations(k);
 
+  // An exception cannot leave an OpenMP loop, so the first one is rethrown
+  // after the loop.
+  std::exception_ptr exception;
+
+  #pragma omp parallel for schedule(dynamic) \
+      num_threads(std::max(concurrentFolds, (size_t) 1))
+  for (size_t i = 0; i < k; ++i)
+  {
+    try
+    {
+      MLAlgorithm model = base.Train(GetTrainingSubset(xs, i, trainingFraction),
+          GetTrainingSubset(ys, i, trainingFraction), args...);
+      evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
+          GetValidationSubset(ys, i));
+      if (i == k - 1)
+        lastModel.reset(new MLAlgorithm(std::move(model)));
+    }
+    catch (...)
+    {
+      #pragma omp critical
+      {
+        if (!exception)
+          exception = std::current_exception();
+      }
+    }
+  }
+
+  if (exception)
+    std::rethrow_exception(exception);
+
   size_t numInvalidScores = 0;
   for (size_t i = 0; i < k; ++i)
   {
-    MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
-        GetTrainingSubset(ys, i), args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
     if (std::isnan(evaluations(i)) || std::isinf(evaluations(i)))
     {
       ++numInvalidScores;
@@ -259,8 +314,6 @@ double KFoldCV<MLAlgorithm,
           << "a score of " << evaluations(i) << "; ignoring when computing "
           << "the average score." << std::endl;
     }
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
   if (numInvalidScores == k)
@@ -283,23 +336,47 @@ double KFoldCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    const double trainingFraction,
+    std::unique_ptr<MLAlgorithm>& lastModel,
+    const MLAlgorithmArgs&... args)
 {
   arma::vec evaluations(k);
 
+  // An exception cannot leave an OpenMP loop, so the first one is rethrown
+  // after the loop.
+  std::exception_ptr exception;
+
+  #pragma omp parallel for schedule(dynamic) \
+      num_threads(std::max(concurrentFolds, (size_t) 1))
   for (size_t i = 0; i < k; ++i)
   {
-    MLAlgorithm&& model = (weights.n_elem > 0) ?
-        base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
-            GetTrainingSubset(weights, i), args...) :
-        base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
-            args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
+    try
+    {
+      MLAlgorithm model = (weights.n_elem > 0) ?
+          base.Train(GetTrainingSubset(xs, i, trainingFraction),
+              GetTrainingSubset(ys, i, trainingFraction),
+              GetTrainingSubset(weights, i, trainingFraction), args...) :
+          base.Train(GetTrainingSubset(xs, i, trainingFraction),
+              GetTrainingSubset(ys, i, trainingFraction), args...);
+      evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
+          GetValidationSubset(ys, i));
+      if (i == k - 1)
+        lastModel.reset(new MLAlgorithm(std::move(model)));
+    }
+    catch (...)
+    {
+      #pragma omp critical
+      {
+        if (!exception)
+          exception = std::current_exception();
+      }
+    }
   }
 
+  if (exception)
+    std::rethrow_exception(exception);
+
   return arma::mean(evaluations);
 }
 
@@ -370,6 +447,32 @@ size_t KFoldCV<MLAlgorithm,
   return (i == 0) ? binSize * (k - 1) : binSize * (i - 1);
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+size_t KFoldCV<MLAlgorithm,
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::TrainingSubsetSize(
+    const size_t i,
+    const double trainingFraction) const
+{
+  // If this is not the first fold, we have to handle it a little bit
+  // differently, since the last fold may contain slightly more than 'binSize'
+  // points.
+  const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
+      (k - 1) * binSize;
+
+  if (trainingFraction == 1.0)
+    return subsetSize;
+
+  return std::max((size_t) 1,
+      (size_t) std::round(trainingFraction * subsetSize));
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -382,16 +485,11 @@ arma::Mat<ElementType> KFoldCV<MLAlgorithm,
                                PredictionsType,
                                WeightsType>::GetTrainingSubset(
     arma::Mat<ElementType>& m,
-    const size_t i)
+    const size_t i,
+    const double trainingFraction)
 {
-  // If this is not the first fold, we have to handle it a little bit
-  // differently, since the last fold may contain slightly more than 'binSize'
-  // points.
-  const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
-      (k - 1) * binSize;
-
-  return arma::Mat<ElementType>(m.colptr(binSize * i), m.n_rows, subsetSize,
-      false, true);
+  return arma::Mat<ElementType>(m.colptr(binSize * i), m.n_rows,
+      TrainingSubsetSize(i, trainingFraction), false, true);
 }
 
 template<typename MLAlgorithm,
@@ -406,15 +504,11 @@ arma::Row<ElementType> KFoldCV<MLAlgorithm,
                                PredictionsType,
                                WeightsType>::GetTrainingSubset(
     arma::Row<ElementType>& r,
-    const size_t i)
+    const size_t i,
+    const double trainingFraction)
 {
-  // If this is not the first fold, we have to handle it a little bit
-  // differently, since the last fold may contain slightly more than 'binSize'
-  // points.
-  const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
-      (k - 1) * binSize;
-
-  return arma::Row<ElementType>(r.colptr(binSize * i), subsetSize, false, true);
+  return arma::Row<ElementType>(r.colptr(binSize * i),
+      TrainingSubsetSize(i, trainingFraction), false, true);
 }
 
 template<typename MLAlgorithm,
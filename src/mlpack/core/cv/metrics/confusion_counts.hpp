@@ -0,0 +1,150 @@
+/**
+ * @file core/cv/metrics/confusion_counts.hpp
+ *
+ * ConfusionCounts, a mergeable accumulator of the confusion matrix of a
+ * classifier, from which accuracy, precision, recall and F1 can be computed.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_CONFUSION_COUNTS_HPP
+#define MLPACK_CORE_CV_METRICS_CONFUSION_COUNTS_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/core/cv/metrics/average_strategy.hpp>
+
+namespace mlpack {
+
+/**
+ * ConfusionCounts accumulates the confusion matrix of a classifier over
+ * batches of predictions, so that classification metrics can be computed
+ * without holding all the predictions in memory.  Each call to Add() counts a
+ * batch of predictions (in parallel), and accumulators built independently
+ * (for instance by different threads, processes or machines, on different
+ * parts of the data) can be combined with Merge().  The accumulator can be
+ * serialized, and the metrics can be evaluated at any time.
+ *
+ * The metrics are the same as the ones computed by Accuracy, Precision, Recall
+ * and F1 on all the predictions at once.  Like for those metrics, the
+ * macroaveraged metrics assume that there are instances of every label from 0
+ * to the maximum label.
+ *
+ * Example usage:
+ *
+ * ```
+ * ConfusionCounts counts;
+ * for (size_t i = 0; i < numBatches; ++i)
+ * {
+ *   model.Classify(batches[i], predictions);
+ *   counts.Add(batchLabels[i], predictions);
+ * }
+ *
+ * const double f1 = counts.F1(Macro);
+ * ```
+ */
+class ConfusionCounts
+{
+ public:
+  /**
+   * Create an empty accumulator.  The number of classes is increased as
+   * needed when predictions are added.
+   *
+   * @param numClasses Initial number of classes.
+   */
+  ConfusionCounts(const size_t numClasses = 0);
+
+  /**
+   * Count the given predictions.  The batch is counted in parallel.
+   *
+   * @param labels Ground truth (correct) labels.
+   * @param predictions Predicted labels.
+   */
+  void Add(const arma::Row<size_t>& labels,
+           const arma::Row<size_t>& predictions);
+
+  /**
+   * Add the counts of another accumulator to this one.
+   *
+   * @param other Accumulator to merge.
+   */
+  void Merge(const ConfusionCounts& other);
+
+  //! Remove all counts.
+  void Reset();
+
+  /**
+   * Compute the accuracy of the predictions counted so far (the same as
+   * microaveraged precision, recall and F1).
+   */
+  double Accuracy() const;
+
+  /**
+   * Compute the precision of the predictions counted so far.
+   *
+   * @param strategy Average strategy.
+   * @param positiveClass For the Binary strategy, the positive class.
+   */
+  double Precision(const AverageStrategy strategy = Binary,
+                   const size_t positiveClass = 1) const;
+
+  /**
+   * Compute the recall of the predictions counted so far.
+   *
+   * @param strategy Average strategy.
+   * @param positiveClass For the Binary strategy, the positive class.
+   */
+  double Recall(const AverageStrategy strategy = Binary,
+                const size_t positiveClass = 1) const;
+
+  /**
+   * Compute the F1 score of the predictions counted so far.  The F1 score of a
+   * class is zero if both its precision and recall are zero.
+   *
+   * @param strategy Average strategy.
+   * @param positiveClass For the Binary strategy, the positive class.
+   */
+  double F1(const AverageStrategy strategy = Binary,
+            const size_t positiveClass = 1) const;
+
+  /**
+   * Get the confusion matrix.  As for data::ConfusionMatrix(), the row index is
+   * the predicted class, and the column index is the actual class.
+   */
+  const arma::Mat<size_t>& Counts() const { return counts; }
+
+  //! Get the number of classes.
+  size_t NumClasses() const { return counts.n_rows; }
+  //! Get the number of predictions counted so far.
+  size_t NumPoints() const { return numPoints; }
+
+  //! Serialize the accumulator.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Increase the number of classes to the given number, keeping the counts.
+  void Grow(const size_t newNumClasses);
+
+  //! Compute the precision of class c.
+  double ClassPrecision(const size_t c) const;
+  //! Compute the recall of class c.
+  double ClassRecall(const size_t c) const;
+  //! Compute the F1 score of class c.
+  double ClassF1(const size_t c) const;
+  //! Get the number of classes that macroaveraged metrics average over.
+  size_t NumLabelClasses() const;
+
+  //! The confusion matrix (predicted class x actual class).
+  arma::Mat<size_t> counts;
+  //! The number of predictions counted.
+  size_t numPoints;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "confusion_counts_impl.hpp"
+
+#endif
@@ -0,0 +1,175 @@
+/**
+ * @file core/cv/metrics/confusion_counts_impl.hpp
+ *
+ * Implementation of ConfusionCounts.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_CONFUSION_COUNTS_IMPL_HPP
+#define MLPACK_CORE_CV_METRICS_CONFUSION_COUNTS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "confusion_counts.hpp"
+
+namespace mlpack {
+
+inline ConfusionCounts::ConfusionCounts(const size_t numClasses) :
+    counts(numClasses, numClasses, arma::fill::zeros),
+    numPoints(0)
+{
+  // Nothing to do.
+}
+
+inline void ConfusionCounts::Add(const arma::Row<size_t>& labels,
+                                 const arma::Row<size_t>& predictions)
+{
+  util::CheckSameSizes(labels, predictions, "ConfusionCounts::Add()");
+  if (labels.n_elem == 0)
+    return;
+
+  Grow(std::max(labels.max(), predictions.max()) + 1);
+
+  const size_t numClasses = counts.n_rows;
+  #pragma omp parallel
+  {
+    // Each thread counts its part of the batch separately.
+    arma::Mat<size_t> localCounts(numClasses, numClasses, arma::fill::zeros);
+
+    #pragma omp for schedule(static)
+    for (size_t i = 0; i < labels.n_elem; ++i)
+      ++localCounts(predictions[i], labels[i]);
+
+    #pragma omp critical
+    counts += localCounts;
+  }
+
+  numPoints += labels.n_elem;
+}
+
+inline void ConfusionCounts::Merge(const ConfusionCounts& other)
+{
+  if (other.NumClasses() == 0)
+    return;
+
+  Grow(other.NumClasses());
+  counts.submat(0, 0, other.NumClasses() - 1, other.NumClasses() - 1) +=
+      other.Counts();
+  numPoints += other.NumPoints();
+}
+
+inline void ConfusionCounts::Reset()
+{
+  counts.reset();
+  numPoints = 0;
+}
+
+inline double ConfusionCounts::Accuracy() const
+{
+  return double(arma::trace(counts)) / numPoints;
+}
+
+inline double ConfusionCounts::Precision(const AverageStrategy strategy,
+                                         const size_t positiveClass) const
+{
+  if (strategy == Binary)
+    return ClassPrecision(positiveClass);
+  else if (strategy == Micro)
+    return Accuracy();
+
+  const size_t numLabelClasses = NumLabelClasses();
+  double sum = 0.0;
+  for (size_t c = 0; c < numLabelClasses; ++c)
+    sum += ClassPrecision(c);
+  return sum / numLabelClasses;
+}
+
+inline double ConfusionCounts::Recall(const AverageStrategy strategy,
+                                      const size_t positiveClass) const
+{
+  if (strategy == Binary)
+    return ClassRecall(positiveClass);
+  else if (strategy == Micro)
+    return Accuracy();
+
+  const size_t numLabelClasses = NumLabelClasses();
+  double sum = 0.0;
+  for (size_t c = 0; c < numLabelClasses; ++c)
+    sum += ClassRecall(c);
+  return sum / numLabelClasses;
+}
+
+inline double ConfusionCounts::F1(const AverageStrategy strategy,
+                                  const size_t positiveClass) const
+{
+  if (strategy == Binary)
+    return ClassF1(positiveClass);
+  else if (strategy == Micro)
+    return Accuracy();
+
+  const size_t numLabelClasses = NumLabelClasses();
+  double sum = 0.0;
+  for (size_t c = 0; c < numLabelClasses; ++c)
+    sum += ClassF1(c);
+  return sum / numLabelClasses;
+}
+
+template<typename Archive>
+void ConfusionCounts::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(counts));
+  ar(CEREAL_NVP(numPoints));
+}
+
+inline void ConfusionCounts::Grow(const size_t newNumClasses)
+{
+  if (newNumClasses <= counts.n_rows)
+    return;
+
+  const size_t oldNumClasses = counts.n_rows;
+  arma::Mat<size_t> newCounts(newNumClasses, newNumClasses, arma::fill::zeros);
+  if (oldNumClasses > 0)
+    newCounts.submat(0, 0, oldNumClasses - 1, oldNumClasses - 1) = counts;
+  counts = std::move(newCounts);
+}
+
+inline double ConfusionCounts::ClassPrecision(const size_t c) const
+{
+  // Like Precision, this is NaN if class c was never predicted.
+  if (c >= counts.n_rows)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  return double(counts(c, c)) / arma::accu(counts.row(c));
+}
+
+inline double ConfusionCounts::ClassRecall(const size_t c) const
+{
+  if (c >= counts.n_rows)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  return double(counts(c, c)) / arma::accu(counts.col(c));
+}
+
+inline double ConfusionCounts::ClassF1(const size_t c) const
+{
+  const double precision = ClassPrecision(c);
+  const double recall = ClassRecall(c);
+  return (precision + recall == 0.0) ? 0.0 :
+      2.0 * precision * recall / (precision + recall);
+}
+
+inline size_t ConfusionCounts::NumLabelClasses() const
+{
+  // This is the maximum label plus one.
+  size_t numLabelClasses = counts.n_cols;
+  while (numLabelClasses > 0 &&
+         arma::accu(counts.col(numLabelClasses - 1)) == 0)
+    --numLabelClasses;
+  return numLabelClasses;
+}
+
+} // namespace mlpack
+
+#endif
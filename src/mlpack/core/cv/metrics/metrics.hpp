@@ -15,11 +15,13 @@
 #include "facilities.hpp"
 #include "accuracy.hpp"
 #include "average_strategy.hpp"
+#include "confusion_counts.hpp"
 #include "f1.hpp"
 #include "mse.hpp"
 #include "precision.hpp"
 #include "r2_score.hpp"
 #include "recall.hpp"
+#include "roc_auc_accumulator.hpp"
 #include "roc_auc_score.hpp"
 #include "silhouette_score.hpp"
 
@@ -0,0 +1,115 @@
+/**
+ * @file core/cv/metrics/roc_auc_accumulator.hpp
+ *
+ * ROCAUCAccumulator, a mergeable accumulator that approximates the area under
+ * the ROC curve with histograms of the scores.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_ROC_AUC_ACCUMULATOR_HPP
+#define MLPACK_CORE_CV_METRICS_ROC_AUC_ACCUMULATOR_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * ROCAUCAccumulator approximates the area under the ROC curve (see
+ * ROCAUCScore) from histograms of the scores of the positive and negative
+ * points, so that the AUC of a very large set of predictions can be computed
+ * without holding or sorting all the scores.  The range of scores is split
+ * into `numBins` bins of equal width; each call to Add() counts the scores of a
+ * batch (in parallel), and accumulators with the same bins can be combined
+ * with Merge().  Scores outside of the range are counted in the first or last
+ * bin.
+ *
+ * Evaluate() computes the AUC of the histograms, treating all scores in the
+ * same bin as ties.  This is the exact AUC if no bin holds both positive and
+ * negative scores; otherwise the error is at most the fraction of
+ * (positive, negative) pairs whose scores fall in the same bin, divided by
+ * two.
+ *
+ * @tparam PositiveClass Positives are assumed to have labels equal to this
+ *     value. Defaults to 1.
+ */
+template<size_t PositiveClass = 1>
+class ROCAUCAccumulator
+{
+ public:
+  /**
+   * Create an empty accumulator.
+   *
+   * @param numBins Number of bins of the histograms.
+   * @param minScore Lower end of the range of scores.
+   * @param maxScore Upper end of the range of scores.
+   */
+  ROCAUCAccumulator(const size_t numBins = 10000,
+                    const double minScore = 0.0,
+                    const double maxScore = 1.0);
+
+  /**
+   * Count the scores of the given points.  The batch is counted in parallel.
+   *
+   * @param labels Ground truth (correct) labels.
+   * @param scores Probability scores of positive class.
+   */
+  void Add(const arma::Row<size_t>& labels, const arma::rowvec& scores);
+
+  /**
+   * Add the counts of another accumulator to this one.  A
+   * std::invalid_argument is thrown if the bins of the accumulators differ.
+   *
+   * @param other Accumulator to merge.
+   */
+  void Merge(const ROCAUCAccumulator& other);
+
+  //! Remove all counts.
+  void Reset();
+
+  /**
+   * Compute the approximate area under the ROC curve of the scores counted so
+   * far.  A std::invalid_argument is thrown if only one class was seen.
+   */
+  double Evaluate() const;
+
+  //! Get the number of bins.
+  size_t NumBins() const { return positiveCounts.n_elem; }
+  //! Get the lower end of the range of scores.
+  double MinScore() const { return minScore; }
+  //! Get the upper end of the range of scores.
+  double MaxScore() const { return maxScore; }
+  //! Get the number of positive scores in each bin.
+  const arma::Col<size_t>& PositiveCounts() const { return positiveCounts; }
+  //! Get the number of negative scores in each bin.
+  const arma::Col<size_t>& NegativeCounts() const { return negativeCounts; }
+
+  //! Serialize the accumulator.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+  /**
+   * Information for hyper-parameter tuning code. It indicates that we want
+   * to maximize the metric.
+   */
+  static const bool NeedsMinimization = false;
+
+ private:
+  //! Lower end of the range of scores.
+  double minScore;
+  //! Upper end of the range of scores.
+  double maxScore;
+  //! Number of positive scores in each bin.
+  arma::Col<size_t> positiveCounts;
+  //! Number of negative scores in each bin.
+  arma::Col<size_t> negativeCounts;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "roc_auc_accumulator_impl.hpp"
+
+#endif
@@ -0,0 +1,142 @@
+/**
+ * @file core/cv/metrics/roc_auc_accumulator_impl.hpp
+ *
+ * Implementation of ROCAUCAccumulator.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_ROC_AUC_ACCUMULATOR_IMPL_HPP
+#define MLPACK_CORE_CV_METRICS_ROC_AUC_ACCUMULATOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "roc_auc_accumulator.hpp"
+
+namespace mlpack {
+
+template<size_t PositiveClass>
+ROCAUCAccumulator<PositiveClass>::ROCAUCAccumulator(const size_t numBins,
+                                                    const double minScore,
+                                                    const double maxScore) :
+    minScore(minScore),
+    maxScore(maxScore),
+    positiveCounts(numBins, arma::fill::zeros),
+    negativeCounts(numBins, arma::fill::zeros)
+{
+  if (numBins == 0)
+  {
+    throw std::invalid_argument("ROCAUCAccumulator::ROCAUCAccumulator(): "
+        "number of bins must be positive!");
+  }
+
+  if (!(maxScore > minScore))
+  {
+    throw std::invalid_argument("ROCAUCAccumulator::ROCAUCAccumulator(): "
+        "maxScore must be greater than minScore!");
+  }
+}
+
+template<size_t PositiveClass>
+void ROCAUCAccumulator<PositiveClass>::Add(const arma::Row<size_t>& labels,
+                                           const arma::rowvec& scores)
+{
+  util::CheckSameSizes(labels, scores, "ROCAUCAccumulator::Add()");
+
+  const size_t numBins = positiveCounts.n_elem;
+  const double scale = numBins / (maxScore - minScore);
+  #pragma omp parallel
+  {
+    // Each thread counts its part of the batch separately.
+    arma::Col<size_t> localPositives(numBins, arma::fill::zeros);
+    arma::Col<size_t> localNegatives(numBins, arma::fill::zeros);
+
+    #pragma omp for schedule(static)
+    for (size_t i = 0; i < scores.n_elem; ++i)
+    {
+      // Scores out of the range (and NaNs) go in the first or last bin.
+      const double position = (scores[i] - minScore) * scale;
+      size_t bin = 0;
+      if (position >= numBins)
+        bin = numBins - 1;
+      else if (position > 0.0)
+        bin = (size_t) position;
+      if (labels[i] == PositiveClass)
+        ++localPositives[bin];
+      else
+        ++localNegatives[bin];
+    }
+
+    #pragma omp critical
+    {
+      positiveCounts += localPositives;
+      negativeCounts += localNegatives;
+    }
+  }
+}
+
+template<size_t PositiveClass>
+void ROCAUCAccumulator<PositiveClass>::Merge(const ROCAUCAccumulator& other)
+{
+  if (other.NumBins() != NumBins() || other.MinScore() != minScore ||
+      other.MaxScore() != maxScore)
+  {
+    throw std::invalid_argument("ROCAUCAccumulator::Merge(): accumulators "
+        "have different bins!");
+  }
+
+  positiveCounts += other.PositiveCounts();
+  negativeCounts += other.NegativeCounts();
+}
+
+template<size_t PositiveClass>
+void ROCAUCAccumulator<PositiveClass>::Reset()
+{
+  positiveCounts.zeros();
+  negativeCounts.zeros();
+}
+
+template<size_t PositiveClass>
+double ROCAUCAccumulator<PositiveClass>::Evaluate() const
+{
+  const double numberOfTrueLabels = arma::accu(positiveCounts);
+  const double numberOfFalseLabels = arma::accu(negativeCounts);
+
+  // Check if only one class is given in labels.
+  if (numberOfTrueLabels == 0 || numberOfFalseLabels == 0)
+  {
+    throw std::invalid_argument(
+        "ROCAUCAccumulator::Evaluate(): "
+        "only one class is given in labels, ROC AUC is undefined");
+  }
+
+  // The AUC is the probability that a positive point has a higher score than
+  // a negative point, counting ties as one half.  The scores of a bin are
+  // ties.
+  double area = 0.0;
+  double positivesAbove = 0.0;
+  for (size_t b = positiveCounts.n_elem; b > 0; --b)
+  {
+    area += negativeCounts[b - 1] * (positivesAbove +
+        0.5 * positiveCounts[b - 1]);
+    positivesAbove += positiveCounts[b - 1];
+  }
+
+  return area / (numberOfTrueLabels * numberOfFalseLabels);
+}
+
+template<size_t PositiveClass>
+template<typename Archive>
+void ROCAUCAccumulator<PositiveClass>::serialize(Archive& ar,
+                                                 const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(minScore));
+  ar(CEREAL_NVP(maxScore));
+  ar(CEREAL_NVP(positiveCounts));
+  ar(CEREAL_NVP(negativeCounts));
+}
+
+} // namespace mlpack
+
+#endif
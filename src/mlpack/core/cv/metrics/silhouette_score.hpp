@@ -35,6 +35,15 @@ namespace mlpack {
  * @f}
  *
  * The Overall Silhouette Score is the mean of individual silhoutte scores.
+ *
+ * When the distances are not precomputed, the scores are computed in parallel
+ * over blocks of points, and only the sums of distances from each point to
+ * each cluster are stored, so memory use is O(k) per point instead of the
+ * O(n^2) of a full distance matrix.  The computation still takes O(n^2)
+ * distance evaluations; for large datasets, SampledOverall() estimates the
+ * overall score from a random sample of points in O(s n) evaluations, and
+ * SimplifiedOverall() computes the simplified (centroid-based) silhouette in
+ * O(n k) evaluations.
  */
 class SilhouetteScore
 {
@@ -52,6 +61,42 @@ class SilhouetteScore
                         const arma::Row<size_t>& labels,
                         const Metric& metric);
 
+  /**
+   * Estimate the overall silhouette score from the exact silhouette scores of
+   * `numSamples` points sampled uniformly at random (without replacement).
+   * This takes O(numSamples * n) distance evaluations, and the estimate is
+   * unbiased.  If `numSamples` is at least the number of points, this is the
+   * same as Overall().
+   *
+   * @param X Column-major data used for clustering.
+   * @param labels Labels assigned to data by clustering.
+   * @param metric Metric to be used to calculate dissimilarity.
+   * @param numSamples Number of points to compute the score of.
+   * @return (double) estimated silhouette score.
+   */
+  template<typename DataType, typename Metric>
+  static double SampledOverall(const DataType& X,
+                               const arma::Row<size_t>& labels,
+                               const Metric& metric,
+                               const size_t numSamples);
+
+  /**
+   * Find the overall simplified silhouette score, where a(i) is the distance
+   * from element i to the centroid of its cluster, and b(i) is the minimum
+   * distance to the centroid of another cluster.  This takes O(n k) distance
+   * evaluations.  As for the exact score, the score of an element that is the
+   * only element of its cluster is 0.
+   *
+   * @param X Column-major data used for clustering.
+   * @param labels Labels assigned to data by clustering.
+   * @param metric Metric to be used to calculate dissimilarity.
+   * @return (double) simplified silhouette score.
+   */
+  template<typename DataType, typename Metric>
+  static double SimplifiedOverall(const DataType& X,
+                                  const arma::Row<size_t>& labels,
+                                  const Metric& metric);
+
   /**
    * Find the individual silhouette scores for precomputted dissimilarites.
    *
@@ -96,6 +141,33 @@ class SilhouetteScore
    * to maximize the metric.
    */
   static const bool NeedsMinimization = false;
+
+ private:
+  /**
+   * Map the labels to cluster indices in [0, k), and count the elements of
+   * each cluster.
+   */
+  static void ClusterIndices(const arma::Row<size_t>& labels,
+                             arma::uvec& clusters,
+                             arma::uvec& clusterSizes);
+
+  /**
+   * Compute the silhouette scores of the given points, in parallel over blocks
+   * of points, without storing the distances.
+   */
+  template<typename DataType, typename Metric>
+  static arma::rowvec PointsScore(const DataType& X,
+                                  const arma::uvec& clusters,
+                                  const arma::uvec& clusterSizes,
+                                  const arma::uvec& points,
+                                  const Metric& metric);
+
+  /**
+   * Compute the silhouette score of an element from its mean distance to its
+   * own cluster and its minimum mean distance to another cluster.
+   */
+  static double Score(const double intraClusterDistance,
+                      const double minInterClusterDistance);
 };
 
 } // namespace mlpack
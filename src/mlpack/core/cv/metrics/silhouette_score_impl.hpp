@@ -25,6 +25,75 @@ double SilhouetteScore::Overall(const DataType& X,
   return arma::mean(SamplesScore(X, labels, metric));
 }
 
+template<typename DataType, typename Metric>
+double SilhouetteScore::SampledOverall(const DataType& X,
+                                       const arma::Row<size_t>& labels,
+                                       const Metric& metric,
+                                       const size_t numSamples)
+{
+  util::CheckSameSizes(X, labels, "SilhouetteScore::SampledOverall()");
+  if (numSamples == 0)
+  {
+    throw std::invalid_argument("SilhouetteScore::SampledOverall(): number of "
+        "samples must be positive!");
+  }
+
+  arma::uvec clusters, clusterSizes;
+  ClusterIndices(labels, clusters, clusterSizes);
+
+  arma::uvec points = arma::linspace<arma::uvec>(0, X.n_cols - 1, X.n_cols);
+  if (numSamples < X.n_cols)
+  {
+    const arma::uvec shuffled = arma::shuffle(points);
+    points = shuffled.head(numSamples);
+  }
+
+  return arma::mean(PointsScore(X, clusters, clusterSizes, points, metric));
+}
+
+template<typename DataType, typename Metric>
+double SilhouetteScore::SimplifiedOverall(const DataType& X,
+                                          const arma::Row<size_t>& labels,
+                                          const Metric& metric)
+{
+  util::CheckSameSizes(X, labels, "SilhouetteScore::SimplifiedOverall()");
+
+  arma::uvec clusters, clusterSizes;
+  ClusterIndices(labels, clusters, clusterSizes);
+  const size_t numClusters = clusterSizes.n_elem;
+
+  arma::mat centroids(X.n_rows, numClusters, arma::fill::zeros);
+  for (size_t i = 0; i < X.n_cols; ++i)
+    centroids.col(clusters[i]) += X.col(i);
+  centroids.each_row() /= arma::conv_to<arma::rowvec>::from(clusterSizes);
+
+  double total = 0.0;
+  #pragma omp parallel for reduction(+:total) schedule(static)
+  for (size_t i = 0; i < X.n_cols; ++i)
+  {
+    const size_t cluster = clusters[i];
+    if (clusterSizes[cluster] == 1)
+      continue;
+
+    const arma::vec point(X.col(i));
+    const double intraClusterDistance = metric.Evaluate(point,
+        centroids.col(cluster));
+    double minInterClusterDistance = DBL_MAX;
+    for (size_t k = 0; k < numClusters; ++k)
+    {
+      if (k != cluster)
+      {
+        minInterClusterDistance = std::min(minInterClusterDistance,
+            metric.Evaluate(point, centroids.col(k)));
+      }
+    }
+
+    total += Score(intraClusterDistance, minInterClusterDistance);
+  }
+
+  return total / X.n_cols;
+}
+
 template<typename DataType>
 arma::rowvec SilhouetteScore::SamplesScore(const DataType& distances,
                                            const arma::Row<size_t>& labels)
@@ -76,8 +145,97 @@ arma::rowvec SilhouetteScore::SamplesScore(const DataType& X,
                                            const Metric& metric)
 {
   util::CheckSameSizes(X, labels, "SilhouetteScore::SamplesScore()");
-  DataType distances = PairwiseDistances(X, metric);
-  return SamplesScore(distances, labels);
+
+  arma::uvec clusters, clusterSizes;
+  ClusterIndices(labels, clusters, clusterSizes);
+  const arma::uvec points = arma::linspace<arma::uvec>(0, X.n_cols - 1,
+      X.n_cols);
+  return PointsScore(X, clusters, clusterSizes, points, metric);
+}
+
+inline void SilhouetteScore::ClusterIndices(const arma::Row<size_t>& labels,
+                                            arma::uvec& clusters,
+                                            arma::uvec& clusterSizes)
+{
+  const arma::Row<size_t> uniqueLabels = arma::unique(labels);
+  clusters.set_size(labels.n_elem);
+  clusterSizes.zeros(uniqueLabels.n_elem);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    clusters[i] = std::lower_bound(uniqueLabels.begin(), uniqueLabels.end(),
+        labels[i]) - uniqueLabels.begin();
+    ++clusterSizes[clusters[i]];
+  }
+}
+
+template<typename DataType, typename Metric>
+arma::rowvec SilhouetteScore::PointsScore(const DataType& X,
+                                          const arma::uvec& clusters,
+                                          const arma::uvec& clusterSizes,
+                                          const arma::uvec& points,
+                                          const Metric& metric)
+{
+  const size_t numClusters = clusterSizes.n_elem;
+  arma::rowvec scores(points.n_elem);
+
+  // Each block of points is compared against every point of the dataset, so
+  // that each point of the dataset is loaded once per block.
+  const size_t blockSize = 64;
+  const size_t numBlocks = (points.n_elem + blockSize - 1) / blockSize;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) points.n_elem);
+
+    // Sums of the distances from each point of the block to each cluster.
+    arma::mat sums(numClusters, end - begin, arma::fill::zeros);
+    for (size_t j = 0; j < X.n_cols; ++j)
+    {
+      const size_t cluster = clusters[j];
+      for (size_t i = begin; i < end; ++i)
+        sums(cluster, i - begin) += metric.Evaluate(X.col(points[i]), X.col(j));
+    }
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      const size_t cluster = clusters[points[i]];
+      if (clusterSizes[cluster] == 1)
+      {
+        // i is the only element in the cluster.
+        scores[i] = 0.0;
+        continue;
+      }
+
+      // The distance from i to itself is 0, so it is part of the sum.
+      const double intraClusterDistance = sums(cluster, i - begin) /
+          (clusterSizes[cluster] - 1);
+      double minInterClusterDistance = DBL_MAX;
+      for (size_t k = 0; k < numClusters; ++k)
+      {
+        if (k != cluster)
+        {
+          minInterClusterDistance = std::min(minInterClusterDistance,
+              sums(k, i - begin) / clusterSizes[k]);
+        }
+      }
+
+      scores[i] = Score(intraClusterDistance, minInterClusterDistance);
+    }
+  }
+
+  return scores;
+}
+
+inline double SilhouetteScore::Score(const double intraClusterDistance,
+                                     const double minInterClusterDistance)
+{
+  // s(i) = 0 if there is no dissimilarity within the cluster.
+  if (intraClusterDistance == 0)
+    return 0.0;
+
+  return (minInterClusterDistance - intraClusterDistance) /
+      std::max(intraClusterDistance, minInterClusterDistance);
 }
 
 inline double SilhouetteScore::MeanDistanceFromCluster(
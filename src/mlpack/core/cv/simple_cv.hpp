@@ -207,6 +207,26 @@ class SimpleCV
   template<typename... MLAlgorithmArgs>
   double Evaluate(const MLAlgorithmArgs&... args);
 
+  /**
+   * Train on only the first `trainingFraction` of the training set (a view of
+   * the data, which is not copied), assess performance on the whole validation
+   * set, and store the trained model in `model` instead of in this object.
+   * Since the object is not modified, this can be called from several threads
+   * at the same time; HyperParameterTuner uses it to evaluate several sets of
+   * hyper-parameters in parallel, and to evaluate them on growing training
+   * sets.  A std::invalid_argument is thrown if `trainingFraction` is not in
+   * (0, 1].
+   *
+   * @param trainingFraction Fraction of the training set to train on.
+   * @param model Pointer to store the trained model in.
+   * @param args Arguments for the given MLAlgorithm taken by its constructor
+   *     (in addition to the passed ones in the SimpleCV constructor).
+   */
+  template<typename... MLAlgorithmArgs>
+  double EvaluateSubset(const double trainingFraction,
+                        std::unique_ptr<MLAlgorithm>& model,
+                        const MLAlgorithmArgs&... args);
+
   //! Access and modify the last trained model.
   MLAlgorithm& Model();
 
@@ -290,7 +310,9 @@ class SimpleCV
   template<typename... MLAlgorithmArgs,
            bool Enabled = !Base::MIE::SupportsWeights,
            typename = std::enable_if_t<Enabled>>
-  double TrainAndEvaluate(const MLAlgorithmArgs&... args);
+  double TrainAndEvaluate(const double trainingFraction,
+                          std::unique_ptr<MLAlgorithm>& model,
+                          const MLAlgorithmArgs&... args);
 
   /**
    * Train and run evaluation in the case of supporting weighted learning.
@@ -299,7 +321,9 @@ class SimpleCV
            bool Enabled = Base::MIE::SupportsWeights,
            typename = std::enable_if_t<Enabled>,
            typename = void>
-  double TrainAndEvaluate(const MLAlgorithmArgs&... args);
+  double TrainAndEvaluate(const double trainingFraction,
+                          std::unique_ptr<MLAlgorithm>& model,
+                          const MLAlgorithmArgs&... args);
 };
 
 } // namespace mlpack
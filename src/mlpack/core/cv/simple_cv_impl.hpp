@@ -193,7 +193,29 @@ double SimpleCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::Evaluate(const MLAlgorithmArgs&... args)
 {
-  return TrainAndEvaluate(args...);
+  return TrainAndEvaluate(1.0, modelPtr, args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+double SimpleCV<MLAlgorithm,
+                Metric,
+                MatType,
+                PredictionsType,
+                WeightsType>::EvaluateSubset(
+    const double trainingFraction,
+    std::unique_ptr<MLAlgorithm>& model,
+    const MLAlgorithmArgs&... args)
+{
+  if (!(trainingFraction > 0.0 && trainingFraction <= 1.0))
+    throw std::invalid_argument("SimpleCV::EvaluateSubset(): the training "
+        "fraction should be in (0, 1]");
+
+  return TrainAndEvaluate(trainingFraction, model, args...);
 }
 
 template<typename MLAlgorithm,
@@ -290,11 +312,24 @@ double SimpleCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    const double trainingFraction,
+    std::unique_ptr<MLAlgorithm>& model,
+    const MLAlgorithmArgs&... args)
 {
-  modelPtr.reset(new MLAlgorithm(base.Train(trainingXs, trainingYs, args...)));
+  if (trainingFraction == 1.0)
+  {
+    model.reset(new MLAlgorithm(base.Train(trainingXs, trainingYs, args...)));
+  }
+  else
+  {
+    const size_t n = std::max((size_t) 1,
+        (size_t) std::round(trainingFraction * trainingXs.n_cols));
+    model.reset(new MLAlgorithm(base.Train(GetSubset(trainingXs, 0, n - 1),
+        GetSubset(trainingYs, 0, n - 1), args...)));
+  }
 
-  return Metric::Evaluate(*modelPtr, validationXs, validationYs);
+  return Metric::Evaluate(*model, validationXs, validationYs);
 }
 
 template<typename MLAlgorithm,
@@ -307,16 +342,24 @@ double SimpleCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    const double trainingFraction,
+    std::unique_ptr<MLAlgorithm>& model,
+    const MLAlgorithmArgs&... args)
 {
+  const size_t n = (trainingFraction == 1.0) ? trainingXs.n_cols :
+      std::max((size_t) 1,
+          (size_t) std::round(trainingFraction * trainingXs.n_cols));
+
   if (trainingWeights.n_elem > 0)
-    modelPtr.reset(new MLAlgorithm(
-        base.Train(trainingXs, trainingYs, trainingWeights, args...)));
+    model.reset(new MLAlgorithm(base.Train(GetSubset(trainingXs, 0, n - 1),
+        GetSubset(trainingYs, 0, n - 1), GetSubset(trainingWeights, 0, n - 1),
+        args...)));
   else
-    modelPtr.reset(new MLAlgorithm(
-        base.Train(trainingXs, trainingYs, args...)));
+    model.reset(new MLAlgorithm(base.Train(GetSubset(trainingXs, 0, n - 1),
+        GetSubset(trainingYs, 0, n - 1), args...)));
 
-  return Metric::Evaluate(*modelPtr, validationXs, validationYs);
+  return Metric::Evaluate(*model, validationXs, validationYs);
 }
 
 } // namespace mlpack
@@ -0,0 +1,227 @@
+/**
+ * @file core/data/batch_prefetcher.hpp
+ *
+ * Definition of the BatchPrefetcher class, which assembles, shuffles and
+ * transforms batches of a dataset in a background thread, ahead of their use.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_BATCH_PREFETCHER_HPP
+#define MLPACK_CORE_DATA_BATCH_PREFETCHER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "chunked_source.hpp"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A BatchPrefetcher splits a dataset (predictors and responses) into batches
+ * of points, and assembles each batch in a background thread while the
+ * previous one is used (e.g. for training).  The prefetcher is double-buffered:
+ * at most one batch is assembled ahead of the consumer, and the memory of the
+ * batches given back by Next() is reused for the next ones.
+ *
+ * The dataset can be held in memory (as matrices, with one point per column,
+ * or as cubes, with one sequence per column and one time step per slice, like
+ * for the RNN class), or read from disk by a pair of ChunkedSource objects.
+ *
+ *  - For data held in memory, the points are shuffled at the start of each
+ *    epoch if `shuffle` is true, by gathering the points of each batch in the
+ *    order of a random permutation; the dataset itself is never copied or
+ *    modified, and must not be modified or destroyed while the prefetcher is
+ *    used.
+ *  - For chunked sources, the chunks are read in order, and the points of each
+ *    chunk are shuffled if `shuffle` is true.  A batch never spans two chunks,
+ *    so the last batch of each chunk may be smaller than the batch size.
+ *    Only the current chunk and the batches are held in memory.
+ *
+ * An optional transformation (see Transform()) is applied to each batch (e.g.
+ * for normalization or augmentation) by the background thread, after it is
+ * assembled.  The shuffles only depend on the mlpack random seed.
+ *
+ * @code
+ * data::BatchPrefetcher<arma::mat> prefetcher(predictors, responses, 4096);
+ * prefetcher.Transform() = [](arma::mat& x, arma::mat& y) { x *= 2.0; };
+ *
+ * arma::mat predictorsBatch, responsesBatch;
+ * while (prefetcher.Next(predictorsBatch, responsesBatch))
+ * {
+ *   // Use the batch.
+ * }
+ * @endcode
+ *
+ * FFN and RNN provide Train() overloads that take a BatchPrefetcher directly.
+ *
+ * @tparam MatType Type of the dataset and of the batches (a matrix or a cube).
+ */
+template<typename MatType = arma::mat>
+class BatchPrefetcher
+{
+ public:
+  //! The element type of the dataset.
+  using ElemType = typename MatType::elem_type;
+  //! The type of the transformation applied to each batch.
+  using TransformType = std::function<void(MatType&, MatType&)>;
+
+  /**
+   * Create a prefetcher for a dataset held in memory.  The dataset is not
+   * copied, so it must outlive the prefetcher.  A std::invalid_argument is
+   * thrown if the number of points of `predictors` and `responses` differ, or
+   * if the batch size is 0.
+   *
+   * @param predictors Predictors of the dataset (one point per column).
+   * @param responses Responses of the dataset (one point per column).
+   * @param batchSize Number of points in each batch.
+   * @param shuffle If true, the points are shuffled at each epoch.
+   */
+  BatchPrefetcher(const MatType& predictors,
+                  const MatType& responses,
+                  const size_t batchSize = 1024,
+                  const bool shuffle = true);
+
+  /**
+   * Create a prefetcher for a dataset that is read from disk in chunks (only
+   * if MatType is a matrix).  The sources are reset at the start of each
+   * epoch, and must outlive the prefetcher.  A std::invalid_argument is thrown
+   * if the sources do not have the same number of points and chunk size, or if
+   * the batch size is 0.
+   *
+   * @param predictors Source of the predictors.
+   * @param responses Source of the responses.
+   * @param batchSize Number of points in each batch.
+   * @param shuffle If true, the points of each chunk are shuffled.
+   */
+  BatchPrefetcher(ChunkedSource<ElemType>& predictors,
+                  ChunkedSource<ElemType>& responses,
+                  const size_t batchSize = 1024,
+                  const bool shuffle = true);
+
+  //! The background thread cannot be shared between prefetchers.
+  BatchPrefetcher(const BatchPrefetcher& other) = delete;
+  //! The background thread cannot be shared between prefetchers.
+  BatchPrefetcher& operator=(const BatchPrefetcher& other) = delete;
+
+  //! Stop the background thread.
+  ~BatchPrefetcher();
+
+  /**
+   * Get the next batch of the current epoch, waiting for it to be assembled if
+   * necessary.  The previous contents of `predictors` and `responses` are
+   * reused to assemble later batches.  When all the batches of the epoch have
+   * been returned, `predictors` and `responses` are emptied and false is
+   * returned; call Reset() to start a new epoch.  Any exception thrown while
+   * assembling the batch (by a ChunkedSource or by the transformation) is
+   * rethrown here.
+   *
+   * @param predictors Matrix to store the predictors of the batch in.
+   * @param responses Matrix to store the responses of the batch in.
+   * @return false if the end of the epoch was reached.
+   */
+  bool Next(MatType& predictors, MatType& responses);
+
+  //! Start a new epoch: the assembled batch is dropped, and the points are
+  //! shuffled again if needed.
+  void Reset();
+
+  //! Get the number of points in the dataset.
+  size_t NumPoints() const { return numPoints; }
+  //! Get the number of batches in an epoch.
+  size_t NumBatches() const;
+  //! Get the maximum number of points in each batch.
+  size_t BatchSize() const { return batchSize; }
+  //! Get whether the points are shuffled at each epoch.
+  bool Shuffle() const { return shuffle; }
+
+  //! Get the transformation applied to each batch.
+  const TransformType& Transform() const { return transform; }
+  //! Modify the transformation applied to each batch (it is called by the
+  //! background thread).  Changes take effect at the next epoch.
+  TransformType& Transform() { return transform; }
+
+ private:
+  //! An assembled batch.
+  struct Batch
+  {
+    MatType predictors;
+    MatType responses;
+  };
+
+  //! Start the background thread for the current epoch.
+  void Start();
+  //! Stop and join the background thread.
+  void Stop();
+  //! Assemble batches (and transform them with `epochTransform`) until the
+  //! epoch is over or the prefetcher is stopped.
+  void Worker(TransformType epochTransform);
+  //! Assemble the next batch of the epoch; return false at the end.
+  bool Assemble(Batch& batch);
+
+  //! The predictors, for data held in memory.
+  const MatType* predictors;
+  //! The responses, for data held in memory.
+  const MatType* responses;
+  //! The source of the predictors, for chunked data.
+  ChunkedSource<ElemType>* predictorsSource;
+  //! The source of the responses, for chunked data.
+  ChunkedSource<ElemType>* responsesSource;
+
+  //! Number of points in the dataset.
+  size_t numPoints;
+  //! Number of points in each batch.
+  size_t batchSize;
+  //! Whether the points are shuffled.
+  bool shuffle;
+  //! The transformation applied to each batch.
+  TransformType transform;
+
+  //! Order of the points (of the dataset or of the chunk) in the epoch.
+  arma::uvec order;
+  //! Index (in `order`) of the first point of the next batch.
+  size_t position;
+  //! Random number generator for the shuffles of the chunks.
+  std::mt19937 rng;
+  //! The current chunk of predictors, for chunked data.
+  arma::Mat<ElemType> chunkPredictors;
+  //! The current chunk of responses, for chunked data.
+  arma::Mat<ElemType> chunkResponses;
+
+  //! The background thread.
+  std::thread worker;
+  //! Whether the background thread was started for the current epoch.
+  bool started;
+  //! Lock for all the members below.
+  std::mutex mutex;
+  //! Signaled when a batch is ready or the epoch is over.
+  std::condition_variable batchReady;
+  //! Signaled when a batch is consumed, or when the thread must stop.
+  std::condition_variable spaceAvailable;
+  //! Whether the background thread must stop.
+  bool stopping;
+  //! Whether all the batches of the epoch were assembled.
+  bool finished;
+  //! Whether `ready` holds a batch that was not returned yet.
+  bool hasReady;
+  //! The batch assembled ahead of the consumer.
+  Batch ready;
+  //! The exception thrown while assembling a batch, if any.
+  std::exception_ptr error;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "batch_prefetcher_impl.hpp"
+
+#endif
@@ -0,0 +1,354 @@
+/**
+ * @file core/data/batch_prefetcher_impl.hpp
+ *
+ * Implementation of the BatchPrefetcher class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_BATCH_PREFETCHER_IMPL_HPP
+#define MLPACK_CORE_DATA_BATCH_PREFETCHER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "batch_prefetcher.hpp"
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+/**
+ * Copy the columns `indices[0]`, ..., `indices[count - 1]` of `input` into
+ * `output`, reusing the memory of `output` if it has the right size.
+ */
+template<typename eT>
+void GatherColumns(const arma::Mat<eT>& input,
+                   const arma::uword* indices,
+                   const size_t count,
+                   arma::Mat<eT>& output)
+{
+  output.set_size(input.n_rows, count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const eT* column = input.colptr(indices[i]);
+    std::copy(column, column + input.n_rows, output.colptr(i));
+  }
+}
+
+/**
+ * Copy the columns `indices[0]`, ..., `indices[count - 1]` of every slice of
+ * `input` into `output`, reusing the memory of `output` if it has the right
+ * size.
+ */
+template<typename eT>
+void GatherColumns(const arma::Cube<eT>& input,
+                   const arma::uword* indices,
+                   const size_t count,
+                   arma::Cube<eT>& output)
+{
+  output.set_size(input.n_rows, count, input.n_slices);
+  for (size_t s = 0; s < input.n_slices; ++s)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      const eT* column = input.slice_colptr(s, indices[i]);
+      std::copy(column, column + input.n_rows, output.slice_colptr(s, i));
+    }
+  }
+}
+
+} // namespace details
+
+template<typename MatType>
+BatchPrefetcher<MatType>::BatchPrefetcher(const MatType& predictors,
+                                          const MatType& responses,
+                                          const size_t batchSize,
+                                          const bool shuffle) :
+    predictors(&predictors),
+    responses(&responses),
+    predictorsSource(nullptr),
+    responsesSource(nullptr),
+    numPoints(predictors.n_cols),
+    batchSize(batchSize),
+    shuffle(shuffle),
+    position(0),
+    started(false),
+    stopping(false),
+    finished(false),
+    hasReady(false)
+{
+  if (responses.n_cols != predictors.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "BatchPrefetcher: number of responses (" << responses.n_cols
+        << ") does not match number of points (" << predictors.n_cols << ")";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("BatchPrefetcher: the batch size must be "
+        "positive");
+  }
+
+  Reset();
+}
+
+template<typename MatType>
+BatchPrefetcher<MatType>::BatchPrefetcher(
+    ChunkedSource<ElemType>& predictors,
+    ChunkedSource<ElemType>& responses,
+    const size_t batchSize,
+    const bool shuffle) :
+    predictors(nullptr),
+    responses(nullptr),
+    predictorsSource(&predictors),
+    responsesSource(&responses),
+    numPoints(predictors.NumPoints()),
+    batchSize(batchSize),
+    shuffle(shuffle),
+    position(0),
+    started(false),
+    stopping(false),
+    finished(false),
+    hasReady(false)
+{
+  static_assert(arma::is_Mat<MatType>::value, "BatchPrefetcher: chunked "
+      "sources can only be used when MatType is a matrix type");
+
+  if (responses.NumPoints() != predictors.NumPoints())
+  {
+    std::ostringstream oss;
+    oss << "BatchPrefetcher: number of responses (" << responses.NumPoints()
+        << ") does not match number of points (" << predictors.NumPoints()
+        << ")";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (responses.ChunkSize() != predictors.ChunkSize())
+  {
+    throw std::invalid_argument("BatchPrefetcher: the chunk sizes of the "
+        "predictors and responses sources must be the same");
+  }
+
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("BatchPrefetcher: the batch size must be "
+        "positive");
+  }
+
+  Reset();
+}
+
+template<typename MatType>
+BatchPrefetcher<MatType>::~BatchPrefetcher()
+{
+  Stop();
+}
+
+template<typename MatType>
+bool BatchPrefetcher<MatType>::Next(MatType& predictorsBatch,
+                                    MatType& responsesBatch)
+{
+  if (!started)
+    Start();
+
+  std::unique_lock<std::mutex> lock(mutex);
+  batchReady.wait(lock, [this]() { return hasReady || finished; });
+  if (hasReady)
+  {
+    // The previous batch of the caller is given to the background thread.
+    predictorsBatch.swap(ready.predictors);
+    responsesBatch.swap(ready.responses);
+    hasReady = false;
+    lock.unlock();
+
+    spaceAvailable.notify_all();
+    return true;
+  }
+
+  // The epoch is over, possibly because of an error.
+  std::exception_ptr e = error;
+  error = nullptr;
+  lock.unlock();
+
+  if (e)
+    std::rethrow_exception(e);
+
+  predictorsBatch.clear();
+  responsesBatch.clear();
+  return false;
+}
+
+template<typename MatType>
+void BatchPrefetcher<MatType>::Reset()
+{
+  Stop();
+
+  if (predictors != nullptr)
+  {
+    if (numPoints == 0)
+      order.clear();
+    else if (shuffle)
+      order = arma::randperm<arma::uvec>(numPoints);
+    else
+      order = arma::regspace<arma::uvec>(0, numPoints - 1);
+  }
+  else
+  {
+    predictorsSource->Reset();
+    responsesSource->Reset();
+    chunkPredictors.clear();
+    chunkResponses.clear();
+    order.clear();
+  }
+
+  position = 0;
+  rng.seed((size_t) RandInt(std::numeric_limits<int>::max()));
+
+  hasReady = false;
+  finished = false;
+  error = nullptr;
+  stopping = false;
+  started = false;
+}
+
+template<typename MatType>
+size_t BatchPrefetcher<MatType>::NumBatches() const
+{
+  if (predictors != nullptr)
+    return (numPoints + batchSize - 1) / batchSize;
+
+  // Batches do not span chunks.
+  const size_t chunkSize = predictorsSource->ChunkSize();
+  const size_t batchesPerChunk = (chunkSize + batchSize - 1) / batchSize;
+  const size_t lastChunkSize = numPoints % chunkSize;
+  return (numPoints / chunkSize) * batchesPerChunk +
+      (lastChunkSize + batchSize - 1) / batchSize;
+}
+
+template<typename MatType>
+void BatchPrefetcher<MatType>::Start()
+{
+  started = true;
+  worker = std::thread(&BatchPrefetcher::Worker, this, transform);
+}
+
+template<typename MatType>
+void BatchPrefetcher<MatType>::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  spaceAvailable.notify_all();
+
+  if (worker.joinable())
+    worker.join();
+}
+
+template<typename MatType>
+void BatchPrefetcher<MatType>::Worker(TransformType epochTransform)
+{
+  // The batch being assembled; its memory comes from the batches returned by
+  // Next().
+  Batch batch;
+  while (true)
+  {
+    bool assembled;
+    try
+    {
+      assembled = Assemble(batch);
+      if (assembled && epochTransform)
+        epochTransform(batch.predictors, batch.responses);
+    }
+    catch (...)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        error = std::current_exception();
+        finished = true;
+      }
+      batchReady.notify_all();
+      return;
+    }
+
+    if (!assembled)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+      }
+      batchReady.notify_all();
+      return;
+    }
+
+    // Wait until the previous batch has been consumed.
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      spaceAvailable.wait(lock, [this]() { return stopping || !hasReady; });
+      if (stopping)
+        return;
+
+      ready.predictors.swap(batch.predictors);
+      ready.responses.swap(batch.responses);
+      hasReady = true;
+    }
+    batchReady.notify_all();
+  }
+}
+
+template<typename MatType>
+bool BatchPrefetcher<MatType>::Assemble(Batch& batch)
+{
+  if (predictors != nullptr)
+  {
+    if (position == numPoints)
+      return false;
+
+    const size_t count = std::min(batchSize, numPoints - position);
+    details::GatherColumns(*predictors, order.memptr() + position, count,
+        batch.predictors);
+    details::GatherColumns(*responses, order.memptr() + position, count,
+        batch.responses);
+    position += count;
+    return true;
+  }
+
+  if (position == chunkPredictors.n_cols)
+  {
+    // Read the next chunks.
+    const bool morePredictors = predictorsSource->Next(chunkPredictors);
+    const bool moreResponses = responsesSource->Next(chunkResponses);
+    if (!morePredictors || !moreResponses)
+      return false;
+
+    if (chunkPredictors.n_cols != chunkResponses.n_cols)
+    {
+      throw std::runtime_error("BatchPrefetcher::Next(): the chunks of the "
+          "predictors and responses sources have a different number of "
+          "points");
+    }
+
+    order = arma::regspace<arma::uvec>(0, chunkPredictors.n_cols - 1);
+    if (shuffle)
+      std::shuffle(order.begin(), order.end(), rng);
+    position = 0;
+  }
+
+  const size_t count = std::min(batchSize,
+      (size_t) chunkPredictors.n_cols - position);
+  details::GatherColumns(chunkPredictors, order.memptr() + position, count,
+      batch.predictors);
+  details::GatherColumns(chunkResponses, order.memptr() + position, count,
+      batch.responses);
+  position += count;
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,225 @@
+/**
+ * @file core/data/chunked_source.hpp
+ *
+ * Defines ChunkedSource, which reads a dataset from disk in chunks of points,
+ * so that datasets that do not fit in memory can be used for training
+ * iterative learners.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNKED_SOURCE_HPP
+#define MLPACK_CORE_DATA_CHUNKED_SOURCE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "types.hpp"
+#include "detect_file_type.hpp"
+#include "load_csv.hpp"
+#include "hdf5_io.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A ChunkedSource reads a dense dataset from a file a chunk of points at a
+ * time, instead of loading the whole dataset into memory like data::Load().
+ * Each call to Next() returns the next (at most) `chunkSize` points of the
+ * dataset, one point per column, exactly as they would appear in the matrix
+ * returned by data::Load() with the same `transpose` setting.  Only one chunk
+ * is held in memory at a time.
+ *
+ * The following formats are supported:
+ *
+ *  - CSV (FileType::CSVASCII), only with `transpose = true` (one point per
+ *    line).  A header row is skipped if it is detected, like for data::Load().
+ *  - Armadillo binary (FileType::ArmaBinary), for any non-complex element
+ *    type.
+ *  - HDF5 (FileType::HDF5Binary), if Armadillo was compiled with HDF5 support.
+ *    The matrix must be stored in the dataset named "dataset" (the default
+ *    when saving with Armadillo or mlpack, and for HDF5Writer).  Each chunk is
+ *    read with a single hyperslab, and a subset of the points can be selected
+ *    with SetPoints() (see also the ChunkedSource overload of data::Split()).
+ *
+ * Example usage:
+ *
+ * ```
+ * data::ChunkedSource<double> source("dataset.csv", 50000);
+ * arma::mat chunk;
+ * while (source.Next(chunk))
+ * {
+ *   // Do something with the points in `chunk`.
+ * }
+ * ```
+ *
+ * Iterative learners such as LogisticRegression, SoftmaxRegression, LinearSVM
+ * and FFN provide Train() overloads that take ChunkedSource objects directly;
+ * see ForEachChunk().
+ *
+ * @tparam eT Element type of the chunks.
+ */
+template<typename eT = double>
+class ChunkedSource
+{
+ public:
+  /**
+   * Open the given file for reading in chunks.  The size of the dataset is
+   * determined when the file is opened.  A std::runtime_error is thrown if the
+   * file cannot be opened or parsed, and a std::invalid_argument is thrown if
+   * the file type is not supported.
+   *
+   * @param filename Name of the file to read.
+   * @param chunkSize Maximum number of points in each chunk.
+   * @param transpose If true, each row of the stored matrix is a point (like
+   *     the default for data::Load()).
+   * @param inputLoadType Type of the file; by default, it is detected
+   *     automatically.
+   */
+  ChunkedSource(const std::string& filename,
+                const size_t chunkSize = 10000,
+                const bool transpose = true,
+                const FileType inputLoadType = FileType::AutoDetect);
+
+  /**
+   * Read the next chunk of points into `chunk`.  If there are no more points
+   * in the dataset, `chunk` is emptied and false is returned.
+   *
+   * @param chunk Matrix to store the next chunk in.
+   * @return false if the end of the dataset was reached.
+   */
+  bool Next(arma::Mat<eT>& chunk);
+
+  //! Restart reading from the first point in the dataset.
+  void Reset();
+
+  /**
+   * Only read the given points of the dataset, in the given order; Next() will
+   * then return the points indices[0], indices[1], ..., and NumPoints() will
+   * return the number of indices.  Only the selected points are read from the
+   * file.  This is only supported for HDF5 files; a std::invalid_argument is
+   * thrown for other file types, or if an index is out of bounds.  Reading
+   * restarts from the first selected point.
+   *
+   * @param indices Indices of the points to read.
+   */
+  void SetPoints(const arma::uvec& indices);
+
+  //! Read all the points of the dataset again, from the first point.
+  void ClearPoints();
+
+  //! Get the dimensionality of each point.
+  size_t Dimensionality() const { return dimensionality; }
+  //! Get the total number of points in the dataset (or the number of selected
+  //! points, if SetPoints() was called).
+  size_t NumPoints() const { return numPoints; }
+  //! Get the index of the first point that will be returned by Next().
+  size_t Position() const { return position; }
+
+  //! Get the maximum number of points in each chunk.
+  size_t ChunkSize() const { return chunkSize; }
+  //! Modify the maximum number of points in each chunk.
+  size_t& ChunkSize() { return chunkSize; }
+
+  //! Get the name of the file being read.
+  const std::string& Filename() const { return filename; }
+  //! Get the type of the file being read.
+  FileType Type() const { return type; }
+
+ private:
+  //! Read the header of an Armadillo binary file.
+  void ReadArmaBinaryHeader();
+  //! Determine the size of an HDF5 dataset.
+  void ReadHDF5Size();
+
+  //! Read `n` points from a CSV file.
+  void NextCSV(arma::Mat<eT>& chunk, const size_t n);
+  //! Read `n` points from an Armadillo binary file.
+  void NextArmaBinary(arma::Mat<eT>& chunk, const size_t n);
+  //! Read `n` points from an HDF5 file.
+  void NextHDF5(arma::Mat<eT>& chunk, const size_t n);
+
+  /**
+   * Read `count` contiguous stored elements, starting at stored element
+   * `offset`, converting them from the element type of the file to eT.
+   */
+  void ReadArmaBinaryElements(const size_t offset,
+                              const size_t count,
+                              eT* out);
+
+  //! Convert `count` elements of type FileElemType into `out`.
+  template<typename FileElemType>
+  static void ConvertElements(const char* in, const size_t count, eT* out);
+
+  //! Name of the file.
+  std::string filename;
+  //! Type of the file.
+  FileType type;
+  //! Maximum number of points in each chunk.
+  size_t chunkSize;
+  //! Whether each stored row is a point.
+  bool transpose;
+
+  //! Open stream for the file (unused for HDF5).
+  std::fstream stream;
+  //! Position of the first data element (or line) in the stream.
+  std::fstream::pos_type dataStart;
+
+  //! Number of rows of the stored matrix.
+  size_t storedRows;
+  //! Number of columns of the stored matrix.
+  size_t storedCols;
+  //! Dimensionality of each point.
+  size_t dimensionality;
+  //! Number of points in the dataset.
+  size_t numPoints;
+  //! Index of the next point to read.
+  size_t position;
+
+  //! Whether only the points in `points` are read.
+  bool selected;
+  //! Indices of the selected points, if `selected` is true.
+  arma::uvec points;
+
+  //! For Armadillo binary files, the Armadillo type code of the elements (e.g.
+  //! "FN008").
+  std::string elemCode;
+  //! For Armadillo binary files, the size of each element in bytes.
+  size_t elemSize;
+
+  //! Buffer used to read elements from the file.
+  std::vector<char> buffer;
+  //! Buffer used to read a line from a CSV file.
+  std::string line;
+};
+
+/**
+ * Iterate over the chunks of `predictors` and `responses` in lockstep,
+ * calling `f(predictorsChunk, responsesChunk)` for each pair of chunks.  Both
+ * sources are reset first, and they must contain the same number of points.
+ * This is the building block for the Train() overloads of iterative learners
+ * that take ChunkedSource objects; `f` will usually train the model on the
+ * given chunk, continuing from the current model parameters.
+ *
+ * A std::invalid_argument is thrown if the sources have a different number of
+ * points.
+ *
+ * @param predictors Source of predictors.
+ * @param responses Source of responses.
+ * @param f Function to call for each pair of chunks.
+ */
+template<typename PredictorsElemType,
+         typename ResponsesElemType,
+         typename FunctionType>
+void ForEachChunk(ChunkedSource<PredictorsElemType>& predictors,
+                  ChunkedSource<ResponsesElemType>& responses,
+                  FunctionType&& f);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "chunked_source_impl.hpp"
+
+#endif
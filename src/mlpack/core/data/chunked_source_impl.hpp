@@ -0,0 +1,388 @@
+/**
+ * @file core/data/chunked_source_impl.hpp
+ *
+ * Implementation of ChunkedSource.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNKED_SOURCE_IMPL_HPP
+#define MLPACK_CORE_DATA_CHUNKED_SOURCE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "chunked_source.hpp"
+
+#include <cstring>
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+ChunkedSource<eT>::ChunkedSource(const std::string& filename,
+                                 const size_t chunkSize,
+                                 const bool transpose,
+                                 const FileType inputLoadType) :
+    filename(filename),
+    type(inputLoadType),
+    chunkSize(chunkSize),
+    transpose(transpose),
+    storedRows(0),
+    storedCols(0),
+    dimensionality(0),
+    numPoints(0),
+    position(0),
+    selected(false),
+    elemSize(0)
+{
+  if (chunkSize == 0)
+  {
+    throw std::invalid_argument("ChunkedSource::ChunkedSource(): chunkSize "
+        "must be greater than 0!");
+  }
+
+  stream.open(filename.c_str(), std::fstream::in | std::fstream::binary);
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("ChunkedSource::ChunkedSource(): cannot open file "
+        "'" + filename + "'.");
+  }
+
+  // If the type is CSV, this will also skip any header line.
+  if (type == FileType::AutoDetect)
+    type = AutoDetect(stream, filename);
+
+  if (type == FileType::CSVASCII)
+  {
+    if (!transpose)
+    {
+      throw std::invalid_argument("ChunkedSource::ChunkedSource(): CSV files "
+          "can only be read with one point per line (transpose = true).");
+    }
+
+    dataStart = stream.tellg();
+
+    LoadCSV loader;
+    loader.NumericCSVSize(stream, storedRows, storedCols);
+    stream.clear();
+    stream.seekg(dataStart);
+  }
+  else if (type == FileType::ArmaBinary)
+  {
+    ReadArmaBinaryHeader();
+  }
+  else if (type == FileType::HDF5Binary)
+  {
+    stream.close();
+    ReadHDF5Size();
+  }
+  else
+  {
+    throw std::invalid_argument("ChunkedSource::ChunkedSource(): file '" +
+        filename + "' has unsupported type " + GetStringType(type) + "; only "
+        "CSV, Armadillo binary and HDF5 files can be read in chunks.");
+  }
+
+  dimensionality = transpose ? storedCols : storedRows;
+  numPoints = transpose ? storedRows : storedCols;
+
+  Log::Info << "Reading '" << filename << "' (" << dimensionality << " x "
+      << numPoints << ") as " << GetStringType(type) << " in chunks of "
+      << chunkSize << " points." << std::endl;
+}
+
+template<typename eT>
+bool ChunkedSource<eT>::Next(arma::Mat<eT>& chunk)
+{
+  if (position >= numPoints)
+  {
+    chunk.clear();
+    return false;
+  }
+
+  const size_t n = std::min(chunkSize, numPoints - position);
+  if (type == FileType::CSVASCII)
+    NextCSV(chunk, n);
+  else if (type == FileType::ArmaBinary)
+    NextArmaBinary(chunk, n);
+  else
+    NextHDF5(chunk, n);
+
+  position += n;
+  return true;
+}
+
+template<typename eT>
+void ChunkedSource<eT>::Reset()
+{
+  position = 0;
+  if (stream.is_open())
+  {
+    stream.clear();
+    stream.seekg(dataStart);
+  }
+}
+
+template<typename eT>
+void ChunkedSource<eT>::SetPoints(const arma::uvec& indices)
+{
+  if (type != FileType::HDF5Binary)
+  {
+    throw std::invalid_argument("ChunkedSource::SetPoints(): points can only "
+        "be selected in HDF5 files.");
+  }
+
+  const size_t totalPoints = transpose ? storedRows : storedCols;
+  if (indices.n_elem > 0 && indices.max() >= totalPoints)
+  {
+    std::ostringstream oss;
+    oss << "ChunkedSource::SetPoints(): point index " << indices.max()
+        << " is out of bounds for a dataset of " << totalPoints << " points!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  points = indices;
+  selected = true;
+  numPoints = indices.n_elem;
+  position = 0;
+}
+
+template<typename eT>
+void ChunkedSource<eT>::ClearPoints()
+{
+  points.clear();
+  selected = false;
+  numPoints = transpose ? storedRows : storedCols;
+  position = 0;
+}
+
+template<typename eT>
+void ChunkedSource<eT>::ReadArmaBinaryHeader()
+{
+  // The header is, e.g., "ARMA_MAT_BIN_FN008\n<rows> <cols>\n".
+  std::string header;
+  std::getline(stream, header);
+  const std::string prefix = "ARMA_MAT_BIN_";
+  if (header.substr(0, prefix.length()) != prefix)
+  {
+    throw std::runtime_error("ChunkedSource::ChunkedSource(): '" + filename +
+        "' is not a dense Armadillo binary file.");
+  }
+
+  elemCode = header.substr(prefix.length());
+  if (elemCode == "IU001" || elemCode == "IS001")
+    elemSize = 1;
+  else if (elemCode == "IU002" || elemCode == "IS002")
+    elemSize = 2;
+  else if (elemCode == "IU004" || elemCode == "IS004" || elemCode == "FN004")
+    elemSize = 4;
+  else if (elemCode == "IU008" || elemCode == "IS008" || elemCode == "FN008")
+    elemSize = 8;
+  else
+  {
+    throw std::runtime_error("ChunkedSource::ChunkedSource(): unsupported "
+        "element type '" + elemCode + "' in '" + filename + "'.");
+  }
+
+  stream >> storedRows >> storedCols;
+  stream.get(); // Skip the newline after the header.
+  if (!stream.good())
+  {
+    throw std::runtime_error("ChunkedSource::ChunkedSource(): could not read "
+        "header of '" + filename + "'.");
+  }
+
+  dataStart = stream.tellg();
+}
+
+template<typename eT>
+void ChunkedSource<eT>::ReadHDF5Size()
+{
+  HDF5Size(filename, storedRows, storedCols);
+}
+
+template<typename eT>
+void ChunkedSource<eT>::NextCSV(arma::Mat<eT>& chunk, const size_t n)
+{
+  chunk.zeros(dimensionality, n);
+  LoadCSV loader;
+  for (size_t i = 0; i < n; ++i)
+  {
+    std::getline(stream, line);
+
+    // Parse each token in the line.
+    const char* tokenStart = line.c_str();
+    const char* lineEnd = line.c_str() + line.length();
+    size_t d = 0;
+    while (d < dimensionality)
+    {
+      const char* tokenEnd = (const char*) std::memchr(tokenStart, ',',
+          lineEnd - tokenStart);
+      if (tokenEnd == NULL)
+        tokenEnd = lineEnd;
+
+      if (!loader.ConvertToken<eT>(chunk(d, i), tokenStart, tokenEnd))
+      {
+        std::ostringstream oss;
+        oss << "ChunkedSource::Next(): failed to convert token '"
+            << std::string(tokenStart, tokenEnd) << "' at row "
+            << (position + i) << ", column " << d << " of '" << filename
+            << "'.";
+        throw std::runtime_error(oss.str());
+      }
+
+      ++d;
+      if (tokenEnd == lineEnd)
+        break;
+      tokenStart = tokenEnd + 1;
+    }
+  }
+}
+
+template<typename eT>
+void ChunkedSource<eT>::NextArmaBinary(arma::Mat<eT>& chunk, const size_t n)
+{
+  chunk.set_size(dimensionality, n);
+  if (!transpose)
+  {
+    // Each point is a contiguous column of the stored matrix.
+    ReadArmaBinaryElements(position * storedRows, n * storedRows,
+        chunk.memptr());
+  }
+  else
+  {
+    // Each point is a row of the stored matrix, so we read a contiguous block
+    // of each stored column.
+    arma::Col<eT> column(n);
+    for (size_t d = 0; d < storedCols; ++d)
+    {
+      ReadArmaBinaryElements(d * storedRows + position, n, column.memptr());
+      chunk.row(d) = column.t();
+    }
+  }
+}
+
+template<typename eT>
+void ChunkedSource<eT>::NextHDF5(arma::Mat<eT>& chunk, const size_t n)
+{
+  // Only the stored columns (if each point is a column) or stored rows (if
+  // each point is a row) that hold the next points are read from the file.
+  if (selected)
+  {
+    const arma::uvec indices = points.subvec(position, position + n - 1);
+    if (transpose)
+      LoadHDF5Rows(filename, chunk, indices);
+    else
+      LoadHDF5Columns(filename, chunk, indices);
+  }
+  else if (transpose)
+  {
+    LoadHDF5Rows(filename, chunk, position, n);
+  }
+  else
+  {
+    LoadHDF5Columns(filename, chunk, position, n);
+  }
+
+  if (transpose)
+    arma::inplace_trans(chunk);
+}
+
+template<typename eT>
+void ChunkedSource<eT>::ReadArmaBinaryElements(const size_t offset,
+                                               const size_t count,
+                                               eT* out)
+{
+  buffer.resize(count * elemSize);
+  stream.clear();
+  stream.seekg(dataStart + std::streamoff(offset * elemSize));
+  stream.read(buffer.data(), std::streamsize(count * elemSize));
+  if (size_t(stream.gcount()) != count * elemSize)
+  {
+    throw std::runtime_error("ChunkedSource::Next(): unexpected end of file "
+        "in '" + filename + "'.");
+  }
+
+  const char* in = buffer.data();
+  if (elemCode == "FN008")
+    ConvertElements<double>(in, count, out);
+  else if (elemCode == "FN004")
+    ConvertElements<float>(in, count, out);
+  else if (elemCode == "IU008")
+    ConvertElements<uint64_t>(in, count, out);
+  else if (elemCode == "IS008")
+    ConvertElements<int64_t>(in, count, out);
+  else if (elemCode == "IU004")
+    ConvertElements<uint32_t>(in, count, out);
+  else if (elemCode == "IS004")
+    ConvertElements<int32_t>(in, count, out);
+  else if (elemCode == "IU002")
+    ConvertElements<uint16_t>(in, count, out);
+  else if (elemCode == "IS002")
+    ConvertElements<int16_t>(in, count, out);
+  else if (elemCode == "IU001")
+    ConvertElements<uint8_t>(in, count, out);
+  else
+    ConvertElements<int8_t>(in, count, out);
+}
+
+template<typename eT>
+template<typename FileElemType>
+void ChunkedSource<eT>::ConvertElements(const char* in,
+                                        const size_t count,
+                                        eT* out)
+{
+  if constexpr (std::is_same_v<FileElemType, eT>)
+  {
+    std::memcpy(out, in, count * sizeof(eT));
+  }
+  else
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      FileElemType value;
+      std::memcpy(&value, in + i * sizeof(FileElemType), sizeof(FileElemType));
+      out[i] = eT(value);
+    }
+  }
+}
+
+template<typename PredictorsElemType,
+         typename ResponsesElemType,
+         typename FunctionType>
+void ForEachChunk(ChunkedSource<PredictorsElemType>& predictors,
+                  ChunkedSource<ResponsesElemType>& responses,
+                  FunctionType&& f)
+{
+  if (predictors.NumPoints() != responses.NumPoints())
+  {
+    std::ostringstream oss;
+    oss << "ForEachChunk(): number of points in predictors ("
+        << predictors.NumPoints() << ") does not match number of points in "
+        << "responses (" << responses.NumPoints() << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  predictors.Reset();
+  responses.Reset();
+
+  // Both sources must return chunks of the same size.
+  const size_t oldChunkSize = responses.ChunkSize();
+  responses.ChunkSize() = predictors.ChunkSize();
+
+  arma::Mat<PredictorsElemType> predictorsChunk;
+  arma::Mat<ResponsesElemType> responsesChunk;
+  while (predictors.Next(predictorsChunk))
+  {
+    responses.Next(responsesChunk);
+    f(predictorsChunk, responsesChunk);
+  }
+
+  responses.ChunkSize() = oldChunkSize;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
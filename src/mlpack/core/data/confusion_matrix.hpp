@@ -51,8 +51,8 @@ namespace data {
  * @param numClasses Number of classes.
  */
 template<typename eT>
-void ConfusionMatrix(const arma::Row<size_t> predictors,
-                     const arma::Row<size_t> responses,
+void ConfusionMatrix(const arma::Row<size_t>& predictors,
+                     const arma::Row<size_t>& responses,
                      arma::Mat<eT>& output,
                      const size_t numClasses);
 
@@ -26,14 +26,21 @@
 #include "string_encoding_policies/string_encoding_policies.hpp"
 #include "tokenizers/tokenizers.hpp"
 
+#include "batch_prefetcher.hpp"
 #include "binarize.hpp"
 #include "check_categorical_param.hpp"
+#include "chunked_source.hpp"
 #include "confusion_matrix.hpp"
 #include "dataset_mapper.hpp"
+#include "first_touch.hpp"
+#include "hdf5_io.hpp"
+#include "image_batch_loader.hpp"
 #include "image_info.hpp"
 #include "imputer.hpp"
 #include "is_naninf.hpp"
+#include "mapped_matrix.hpp"
 #include "normalize_labels.hpp"
+#include "one_hot_encoder.hpp"
 #include "one_hot_encoding.hpp"
 #include "split_data.hpp"
 #include "string_algorithms.hpp"
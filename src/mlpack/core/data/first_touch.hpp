@@ -0,0 +1,65 @@
+/**
+ * @file core/data/first_touch.hpp
+ *
+ * FirstTouch(), which moves a matrix to new memory that is first written by
+ * the threads that process each range of its columns, so that on NUMA systems
+ * the memory of each range is placed on the node of its thread.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_FIRST_TOUCH_HPP
+#define MLPACK_CORE_DATA_FIRST_TOUCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/parallel.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Copy `matrix` to newly allocated memory, with each column written by the
+ * thread that an OpenMP `schedule(static)` loop over the columns assigns it to.
+ * Operating systems place a page on the NUMA node of the thread that first
+ * writes it, so after this call the columns that each thread processes in the
+ * static loops of NaiveKMeans, ElkanKMeans, HamerlyKMeans, or
+ * RandomForest::Classify() are in its local memory.  A matrix loaded by a
+ * single thread (as with data::Load()) otherwise sits on the node of that
+ * thread, and all the other nodes read it remotely.
+ *
+ * This only helps if the threads stay on the same cores between loops; set
+ * `OMP_PROC_BIND=spread` (or `close`) and `OMP_PLACES=cores` in the
+ * environment to bind them, and use the same number of threads for this call
+ * and for the computation.
+ *
+ * Nothing is done if mlpack is compiled without OpenMP, if ThreadBudget() is 1,
+ * or if `matrix` is empty.
+ *
+ * @param matrix Matrix to move to thread-local memory.
+ */
+template<typename eT>
+void FirstTouch(arma::Mat<eT>& matrix)
+{
+  if (matrix.n_elem == 0 || ThreadBudget() == 1)
+    return;
+
+  // The memory of a large allocation is not touched by Armadillo when it is
+  // not initialized.
+  arma::Mat<eT> placed(matrix.n_rows, matrix.n_cols, arma::fill::none);
+
+  #pragma omp parallel for schedule(static) num_threads(ThreadBudget())
+  for (size_t i = 0; i < (size_t) matrix.n_cols; ++i)
+  {
+    std::copy(matrix.colptr(i), matrix.colptr(i) + matrix.n_rows,
+        placed.colptr(i));
+  }
+
+  matrix = std::move(placed);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
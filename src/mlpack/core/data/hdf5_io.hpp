@@ -0,0 +1,204 @@
+/**
+ * @file core/data/hdf5_io.hpp
+ *
+ * Functions to read parts of a matrix stored in an HDF5 file, and HDF5Writer,
+ * which writes a matrix to an HDF5 file a block of points at a time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_HDF5_IO_HPP
+#define MLPACK_CORE_DATA_HDF5_IO_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Get the size of the matrix stored in the given dataset of an HDF5 file, in
+ * the layout used by Armadillo (and by data::Save() and HDF5Writer).  A
+ * std::runtime_error is thrown if the file cannot be read, if the dataset is
+ * not a matrix, or if Armadillo was compiled without HDF5 support.
+ *
+ * @param filename Name of the HDF5 file.
+ * @param rows Will be set to the number of rows of the stored matrix.
+ * @param cols Will be set to the number of columns of the stored matrix.
+ * @param datasetName Name of the dataset in the file.
+ */
+inline void HDF5Size(const std::string& filename,
+                     size_t& rows,
+                     size_t& cols,
+                     const std::string& datasetName = "dataset");
+
+/**
+ * Read the columns [firstCol, firstCol + numCols) of the matrix stored in an
+ * HDF5 file, without reading the rest of the matrix.  Since Armadillo stores
+ * each column contiguously, this is a single contiguous hyperslab of the HDF5
+ * dataset, and only the HDF5 chunks that hold these columns are read.  The
+ * stored elements are converted to eT by HDF5.
+ *
+ * Note that data::Save() transposes matrices by default, so that each column
+ * of the stored matrix is a dimension; see LoadHDF5Rows() to read points in
+ * that case.
+ *
+ * A std::runtime_error is thrown if the file cannot be read, and a
+ * std::invalid_argument if the columns are out of bounds.
+ *
+ * @param filename Name of the HDF5 file.
+ * @param matrix Will hold the columns that were read.
+ * @param firstCol Index of the first column to read.
+ * @param numCols Number of columns to read.
+ * @param datasetName Name of the dataset in the file.
+ */
+template<typename eT>
+void LoadHDF5Columns(const std::string& filename,
+                     arma::Mat<eT>& matrix,
+                     const size_t firstCol,
+                     const size_t numCols,
+                     const std::string& datasetName = "dataset");
+
+/**
+ * Read the given columns of the matrix stored in an HDF5 file, in the given
+ * order, without reading the other columns.  Runs of consecutive indices are
+ * selected as single hyperslabs.  Indices may be repeated.
+ *
+ * @param filename Name of the HDF5 file.
+ * @param matrix Will hold the columns that were read.
+ * @param cols Indices of the columns to read.
+ * @param datasetName Name of the dataset in the file.
+ */
+template<typename eT>
+void LoadHDF5Columns(const std::string& filename,
+                     arma::Mat<eT>& matrix,
+                     const arma::uvec& cols,
+                     const std::string& datasetName = "dataset");
+
+/**
+ * Read the rows [firstRow, firstRow + numRows) of the matrix stored in an HDF5
+ * file, without reading the rest of the matrix.  For a matrix saved with
+ * data::Save() (which transposes by default), these are the points
+ * [firstRow, firstRow + numRows), one per row of `matrix`.
+ *
+ * @param filename Name of the HDF5 file.
+ * @param matrix Will hold the rows that were read.
+ * @param firstRow Index of the first row to read.
+ * @param numRows Number of rows to read.
+ * @param datasetName Name of the dataset in the file.
+ */
+template<typename eT>
+void LoadHDF5Rows(const std::string& filename,
+                  arma::Mat<eT>& matrix,
+                  const size_t firstRow,
+                  const size_t numRows,
+                  const std::string& datasetName = "dataset");
+
+/**
+ * Read the given rows of the matrix stored in an HDF5 file, in the given order,
+ * without reading the other rows.  Indices may be repeated.
+ *
+ * @param filename Name of the HDF5 file.
+ * @param matrix Will hold the rows that were read.
+ * @param rows Indices of the rows to read.
+ * @param datasetName Name of the dataset in the file.
+ */
+template<typename eT>
+void LoadHDF5Rows(const std::string& filename,
+                  arma::Mat<eT>& matrix,
+                  const arma::uvec& rows,
+                  const std::string& datasetName = "dataset");
+
+/**
+ * HDF5Writer writes a dataset to an HDF5 file a block of points at a time, so
+ * that datasets that do not fit in memory can be saved.  The HDF5 dataset is
+ * chunked and extensible, and each call to Append() extends it and writes the
+ * new points only.  The file can be read with data::Load() or ChunkedSource,
+ * with the same `transpose` setting.
+ *
+ * Example usage:
+ *
+ * ```
+ * data::HDF5Writer<double> writer("dataset.h5", 10);
+ * for (size_t i = 0; i < 100; ++i)
+ *   writer.Append(arma::randu<arma::mat>(10, 10000));
+ * writer.Close();
+ *
+ * arma::mat data;
+ * data::Load("dataset.h5", data); // data is 10 x 1000000.
+ * ```
+ *
+ * @tparam eT Element type of the dataset.
+ */
+template<typename eT = double>
+class HDF5Writer
+{
+ public:
+  /**
+   * Create (or overwrite) the given HDF5 file, with an empty dataset of points
+   * of the given dimensionality.  A std::runtime_error is thrown if the file
+   * cannot be created or if Armadillo was compiled without HDF5 support.
+   *
+   * @param filename Name of the file to create.
+   * @param dimensionality Dimensionality of each point.
+   * @param transpose If true, each point is stored as a row of the matrix
+   *     (like the default for data::Save()).
+   * @param chunkSize Number of points in each HDF5 chunk.
+   * @param datasetName Name of the dataset in the file.
+   */
+  HDF5Writer(const std::string& filename,
+             const size_t dimensionality,
+             const bool transpose = true,
+             const size_t chunkSize = 1024,
+             const std::string& datasetName = "dataset");
+
+  //! Close the file, if it is still open.
+  ~HDF5Writer();
+
+  // An open file cannot be shared.
+  HDF5Writer(const HDF5Writer&) = delete;
+  HDF5Writer& operator=(const HDF5Writer&) = delete;
+
+  /**
+   * Append the given points (one per column) to the dataset.  A
+   * std::invalid_argument is thrown if their dimensionality is wrong, and a
+   * std::runtime_error if the file was closed or cannot be written.
+   *
+   * @param points Points to append.
+   */
+  void Append(const arma::Mat<eT>& points);
+
+  //! Close the file; no more points can be appended.
+  void Close();
+
+  //! Get the dimensionality of each point.
+  size_t Dimensionality() const { return dimensionality; }
+  //! Get the number of points written so far.
+  size_t NumPoints() const { return numPoints; }
+
+ private:
+  //! Name of the file.
+  std::string filename;
+  //! Dimensionality of each point.
+  size_t dimensionality;
+  //! Whether each point is stored as a row.
+  bool transpose;
+  //! Number of points written so far.
+  size_t numPoints;
+
+#ifdef ARMA_USE_HDF5
+  //! The open file, or a negative value.
+  hid_t file;
+  //! The open dataset, or a negative value.
+  hid_t dataset;
+#endif
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "hdf5_io_impl.hpp"
+
+#endif
@@ -0,0 +1,457 @@
+/**
+ * @file core/data/hdf5_io_impl.hpp
+ *
+ * Implementation of the partial HDF5 reads and of HDF5Writer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_HDF5_IO_IMPL_HPP
+#define MLPACK_CORE_DATA_HDF5_IO_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hdf5_io.hpp"
+
+namespace mlpack {
+namespace data {
+
+#ifdef ARMA_USE_HDF5
+
+/**
+ * Get the native HDF5 type that corresponds to eT.
+ */
+template<typename eT>
+hid_t HDF5NativeType()
+{
+  static_assert(std::is_arithmetic_v<eT>, "HDF5 datasets can only be read or "
+      "written with arithmetic element types");
+
+  if constexpr (std::is_same_v<eT, double>)
+    return H5T_NATIVE_DOUBLE;
+  else if constexpr (std::is_same_v<eT, float>)
+    return H5T_NATIVE_FLOAT;
+  else if constexpr (std::is_floating_point_v<eT>)
+    return H5T_NATIVE_LDOUBLE;
+  else if constexpr (std::is_signed_v<eT>)
+  {
+    if constexpr (sizeof(eT) == 1)
+      return H5T_NATIVE_INT8;
+    else if constexpr (sizeof(eT) == 2)
+      return H5T_NATIVE_INT16;
+    else if constexpr (sizeof(eT) == 4)
+      return H5T_NATIVE_INT32;
+    else
+      return H5T_NATIVE_INT64;
+  }
+  else
+  {
+    if constexpr (sizeof(eT) == 1)
+      return H5T_NATIVE_UINT8;
+    else if constexpr (sizeof(eT) == 2)
+      return H5T_NATIVE_UINT16;
+    else if constexpr (sizeof(eT) == 4)
+      return H5T_NATIVE_UINT32;
+    else
+      return H5T_NATIVE_UINT64;
+  }
+}
+
+/**
+ * Read the given runs of stored columns (if `byRow` is false) or stored rows
+ * (if `byRow` is true) of the matrix stored in an HDF5 file into `block`, in
+ * increasing order.  Armadillo stores the matrix with the dimensions reversed,
+ * so that the stored columns are the rows of the HDF5 dataset.  The runs are
+ * (first index, number of indices) pairs, and must be sorted and disjoint.
+ */
+template<typename eT>
+void ReadHDF5Runs(const std::string& filename,
+                  const std::string& datasetName,
+                  const bool byRow,
+                  const std::vector<std::pair<size_t, size_t>>& runs,
+                  arma::Mat<eT>& block)
+{
+  hid_t file = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  if (file < 0)
+    throw std::runtime_error("cannot open HDF5 file '" + filename + "'");
+
+  hid_t dataset = H5Dopen(file, datasetName.c_str(), H5P_DEFAULT);
+  if (dataset < 0)
+  {
+    H5Fclose(file);
+    throw std::runtime_error("HDF5 file '" + filename + "' has no dataset "
+        "named '" + datasetName + "'");
+  }
+
+  hid_t fileSpace = H5Dget_space(dataset);
+  hsize_t dims[2] = { 0, 0 };
+  const int numDims = H5Sget_simple_extent_ndims(fileSpace);
+  if (numDims == 2)
+    H5Sget_simple_extent_dims(fileSpace, dims, NULL);
+
+  // The HDF5 dimension that is selected.
+  const size_t dim = byRow ? 1 : 0;
+  size_t total = 0;
+  bool outOfBounds = false;
+  for (const std::pair<size_t, size_t>& run : runs)
+  {
+    total += run.second;
+    if (run.first + run.second > dims[dim])
+      outOfBounds = true;
+  }
+
+  if (numDims != 2 || outOfBounds)
+  {
+    H5Sclose(fileSpace);
+    H5Dclose(dataset);
+    H5Fclose(file);
+
+    if (numDims != 2)
+    {
+      throw std::runtime_error("HDF5 dataset '" + datasetName + "' in '" +
+          filename + "' is not a matrix");
+    }
+
+    std::ostringstream oss;
+    oss << "cannot read " << (byRow ? "rows" : "columns") << " of HDF5 matrix "
+        << "in '" << filename << "' of size " << dims[1] << " x " << dims[0]
+        << ": index out of bounds";
+    throw std::invalid_argument(oss.str());
+  }
+
+  hsize_t count[2] = { dims[0], dims[1] };
+  count[dim] = total;
+  if (byRow)
+    block.set_size(total, dims[0]);
+  else
+    block.set_size(dims[1], total);
+
+  herr_t status = 0;
+  if (total > 0)
+  {
+    bool first = true;
+    for (const std::pair<size_t, size_t>& run : runs)
+    {
+      if (run.second == 0)
+        continue;
+
+      hsize_t offset[2] = { 0, 0 };
+      hsize_t runCount[2] = { dims[0], dims[1] };
+      offset[dim] = run.first;
+      runCount[dim] = run.second;
+      H5Sselect_hyperslab(fileSpace, first ? H5S_SELECT_SET : H5S_SELECT_OR,
+          offset, NULL, runCount, NULL);
+      first = false;
+    }
+
+    // The selected elements are read in the order of the file, which is the
+    // column-major order of `block`.
+    hid_t memSpace = H5Screate_simple(2, count, NULL);
+    status = H5Dread(dataset, HDF5NativeType<eT>(), memSpace, fileSpace,
+        H5P_DEFAULT, block.memptr());
+    H5Sclose(memSpace);
+  }
+
+  H5Sclose(fileSpace);
+  H5Dclose(dataset);
+  H5Fclose(file);
+
+  if (status < 0)
+    throw std::runtime_error("failed to read from HDF5 file '" + filename + "'");
+}
+
+/**
+ * Read the given stored columns or rows (see ReadHDF5Runs()) in the given
+ * order.  Each run of consecutive indices is read as a single hyperslab.
+ */
+template<typename eT>
+void ReadHDF5Indices(const std::string& filename,
+                     const std::string& datasetName,
+                     const bool byRow,
+                     const arma::uvec& indices,
+                     arma::Mat<eT>& matrix)
+{
+  const arma::uvec sorted = arma::unique(indices);
+  std::vector<std::pair<size_t, size_t>> runs;
+  for (size_t i = 0; i < sorted.n_elem; ++i)
+  {
+    if (!runs.empty() && runs.back().first + runs.back().second == sorted[i])
+      ++runs.back().second;
+    else
+      runs.emplace_back(sorted[i], 1);
+  }
+
+  // If the indices are already sorted and unique, no reordering is needed.
+  if (sorted.n_elem == indices.n_elem &&
+      std::equal(sorted.begin(), sorted.end(), indices.begin()))
+  {
+    ReadHDF5Runs(filename, datasetName, byRow, runs, matrix);
+    return;
+  }
+
+  arma::Mat<eT> block;
+  ReadHDF5Runs(filename, datasetName, byRow, runs, block);
+  if (byRow)
+    matrix.set_size(indices.n_elem, block.n_cols);
+  else
+    matrix.set_size(block.n_rows, indices.n_elem);
+
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    const size_t position = std::lower_bound(sorted.begin(), sorted.end(),
+        indices[i]) - sorted.begin();
+    if (byRow)
+      matrix.row(i) = block.row(position);
+    else
+      matrix.col(i) = block.col(position);
+  }
+}
+
+#endif
+
+inline void HDF5Size(const std::string& filename,
+                     size_t& rows,
+                     size_t& cols,
+                     const std::string& datasetName)
+{
+#ifdef ARMA_USE_HDF5
+  // Selecting no rows (or no columns) reads nothing, but gives the number of
+  // columns (or rows) of the matrix.
+  const std::vector<std::pair<size_t, size_t>> none;
+  arma::mat block;
+  ReadHDF5Runs(filename, datasetName, false, none, block);
+  rows = block.n_rows;
+  ReadHDF5Runs(filename, datasetName, true, none, block);
+  cols = block.n_cols;
+#else
+  (void) rows;
+  (void) cols;
+  (void) datasetName;
+  throw std::runtime_error("HDF5Size(): attempted to read '" + filename +
+      "' as HDF5 data, but Armadillo was compiled without HDF5 support.");
+#endif
+}
+
+template<typename eT>
+void LoadHDF5Columns(const std::string& filename,
+                     arma::Mat<eT>& matrix,
+                     const size_t firstCol,
+                     const size_t numCols,
+                     const std::string& datasetName)
+{
+#ifdef ARMA_USE_HDF5
+  ReadHDF5Runs(filename, datasetName, false, { { firstCol, numCols } },
+      matrix);
+#else
+  (void) matrix;
+  (void) firstCol;
+  (void) numCols;
+  (void) datasetName;
+  throw std::runtime_error("LoadHDF5Columns(): attempted to read '" + filename
+      + "' as HDF5 data, but Armadillo was compiled without HDF5 support.");
+#endif
+}
+
+template<typename eT>
+void LoadHDF5Columns(const std::string& filename,
+                     arma::Mat<eT>& matrix,
+                     const arma::uvec& cols,
+                     const std::string& datasetName)
+{
+#ifdef ARMA_USE_HDF5
+  ReadHDF5Indices(filename, datasetName, false, cols, matrix);
+#else
+  (void) matrix;
+  (void) cols;
+  (void) datasetName;
+  throw std::runtime_error("LoadHDF5Columns(): attempted to read '" + filename
+      + "' as HDF5 data, but Armadillo was compiled without HDF5 support.");
+#endif
+}
+
+template<typename eT>
+void LoadHDF5Rows(const std::string& filename,
+                  arma::Mat<eT>& matrix,
+                  const size_t firstRow,
+                  const size_t numRows,
+                  const std::string& datasetName)
+{
+#ifdef ARMA_USE_HDF5
+  ReadHDF5Runs(filename, datasetName, true, { { firstRow, numRows } },
+      matrix);
+#else
+  (void) matrix;
+  (void) firstRow;
+  (void) numRows;
+  (void) datasetName;
+  throw std::runtime_error("LoadHDF5Rows(): attempted to read '" + filename +
+      "' as HDF5 data, but Armadillo was compiled without HDF5 support.");
+#endif
+}
+
+template<typename eT>
+void LoadHDF5Rows(const std::string& filename,
+                  arma::Mat<eT>& matrix,
+                  const arma::uvec& rows,
+                  const std::string& datasetName)
+{
+#ifdef ARMA_USE_HDF5
+  ReadHDF5Indices(filename, datasetName, true, rows, matrix);
+#else
+  (void) matrix;
+  (void) rows;
+  (void) datasetName;
+  throw std::runtime_error("LoadHDF5Rows(): attempted to read '" + filename +
+      "' as HDF5 data, but Armadillo was compiled without HDF5 support.");
+#endif
+}
+
+template<typename eT>
+HDF5Writer<eT>::HDF5Writer(const std::string& filename,
+                           const size_t dimensionality,
+                           const bool transpose,
+                           const size_t chunkSize,
+                           const std::string& datasetName) :
+    filename(filename),
+    dimensionality(dimensionality),
+    transpose(transpose),
+    numPoints(0)
+{
+#ifdef ARMA_USE_HDF5
+  if (dimensionality == 0 || chunkSize == 0)
+  {
+    throw std::invalid_argument("HDF5Writer::HDF5Writer(): dimensionality and "
+        "chunkSize must be greater than 0!");
+  }
+
+  file = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  if (file < 0)
+  {
+    throw std::runtime_error("HDF5Writer::HDF5Writer(): cannot create HDF5 "
+        "file '" + filename + "'.");
+  }
+
+  // Armadillo stores the matrix with the dimensions reversed; the points are
+  // the stored rows (HDF5 dimension 1) if `transpose` is true, and the stored
+  // columns (HDF5 dimension 0) otherwise.  That dimension is unlimited.
+  const size_t pointDim = transpose ? 1 : 0;
+  hsize_t dims[2] = { dimensionality, dimensionality };
+  hsize_t maxDims[2] = { dimensionality, dimensionality };
+  hsize_t chunkDims[2] = { dimensionality, dimensionality };
+  dims[pointDim] = 0;
+  maxDims[pointDim] = H5S_UNLIMITED;
+  chunkDims[pointDim] = chunkSize;
+
+  hid_t space = H5Screate_simple(2, dims, maxDims);
+  hid_t properties = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(properties, 2, chunkDims);
+  dataset = H5Dcreate(file, datasetName.c_str(), HDF5NativeType<eT>(), space,
+      H5P_DEFAULT, properties, H5P_DEFAULT);
+  H5Pclose(properties);
+  H5Sclose(space);
+
+  if (dataset < 0)
+  {
+    H5Fclose(file);
+    file = -1;
+    throw std::runtime_error("HDF5Writer::HDF5Writer(): cannot create dataset "
+        "'" + datasetName + "' in HDF5 file '" + filename + "'.");
+  }
+#else
+  (void) chunkSize;
+  (void) datasetName;
+  throw std::runtime_error("HDF5Writer::HDF5Writer(): attempted to write '" +
+      filename + "' as HDF5 data, but Armadillo was compiled without HDF5 "
+      "support.");
+#endif
+}
+
+template<typename eT>
+HDF5Writer<eT>::~HDF5Writer()
+{
+  Close();
+}
+
+template<typename eT>
+void HDF5Writer<eT>::Append(const arma::Mat<eT>& points)
+{
+  if (points.n_rows != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "HDF5Writer::Append(): points have dimensionality " << points.n_rows
+        << ", but the dataset has dimensionality " << dimensionality << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+#ifdef ARMA_USE_HDF5
+  if (dataset < 0)
+  {
+    throw std::runtime_error("HDF5Writer::Append(): HDF5 file '" + filename +
+        "' is closed.");
+  }
+
+  if (points.n_cols == 0)
+    return;
+
+  // Extend the dataset, and select the new points.
+  const size_t pointDim = transpose ? 1 : 0;
+  hsize_t dims[2] = { dimensionality, dimensionality };
+  hsize_t offset[2] = { 0, 0 };
+  hsize_t count[2] = { dimensionality, dimensionality };
+  dims[pointDim] = numPoints + points.n_cols;
+  offset[pointDim] = numPoints;
+  count[pointDim] = points.n_cols;
+
+  herr_t status = H5Dset_extent(dataset, dims);
+  hid_t fileSpace = H5Dget_space(dataset);
+  H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, offset, NULL, count, NULL);
+  hid_t memSpace = H5Screate_simple(2, count, NULL);
+
+  // The selection is written in the order of the file; if each point is a
+  // stored row, that is the order of the transposed points.
+  if (status >= 0)
+  {
+    if (transpose)
+    {
+      const arma::Mat<eT> pointsT = points.t();
+      status = H5Dwrite(dataset, HDF5NativeType<eT>(), memSpace, fileSpace,
+          H5P_DEFAULT, pointsT.memptr());
+    }
+    else
+    {
+      status = H5Dwrite(dataset, HDF5NativeType<eT>(), memSpace, fileSpace,
+          H5P_DEFAULT, points.memptr());
+    }
+  }
+
+  H5Sclose(memSpace);
+  H5Sclose(fileSpace);
+
+  if (status < 0)
+  {
+    throw std::runtime_error("HDF5Writer::Append(): failed to write to HDF5 "
+        "file '" + filename + "'.");
+  }
+
+  numPoints += points.n_cols;
+#endif
+}
+
+template<typename eT>
+void HDF5Writer<eT>::Close()
+{
+#ifdef ARMA_USE_HDF5
+  if (dataset >= 0)
+    H5Dclose(dataset);
+  if (file >= 0)
+    H5Fclose(file);
+  dataset = -1;
+  file = -1;
+#endif
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
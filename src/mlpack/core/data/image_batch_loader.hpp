@@ -0,0 +1,230 @@
+/**
+ * @file core/data/image_batch_loader.hpp
+ *
+ * Definition of the ImageBatchLoader class, which decodes batches of images in
+ * a pool of threads, ahead of their use.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_IMAGE_BATCH_LOADER_HPP
+#define MLPACK_CORE_DATA_IMAGE_BATCH_LOADER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "image_info.hpp"
+#include "load_image.hpp"
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * An ImageBatchLoader reads a set of image files (and the responses that go
+ * with them) a batch of images at a time.  Images are decoded by a pool of
+ * worker threads, which keep up to a fixed number of batches ready ahead of the
+ * consumer, so that decoding overlaps with the use of the previous batches
+ * (e.g. training), and only a bounded number of decoded images are in memory.
+ *
+ * Each image is resized to the size given by the ImageInfo (bilinear
+ * interpolation; images that already have that size are copied), then,
+ * optionally, a random crop of size CropWidth() x CropHeight() is taken and the
+ * image is flipped horizontally with probability FlipProbability().  All these
+ * steps are done in a single pass by the worker that decodes the image.  Each
+ * point of a batch has the same layout as the matrices given by data::Load()
+ * for images.
+ *
+ * Batches are returned in order by Next(); the order of the images is shuffled
+ * at the start of each epoch if `shuffle` is true.  The random crops, flips and
+ * shuffles only depend on the mlpack random seed.
+ *
+ * @code
+ * data::ImageBatchLoader<double> loader(files, labels, data::ImageInfo(64, 64),
+ *     1024);
+ * loader.CropWidth() = 56;
+ * loader.CropHeight() = 56;
+ * loader.FlipProbability() = 0.5;
+ *
+ * arma::mat predictors, responses;
+ * while (loader.Next(predictors, responses))
+ * {
+ *   // Use the batch.
+ * }
+ * @endcode
+ *
+ * FFN provides a Train() overload that takes an ImageBatchLoader directly.
+ *
+ * @tparam eT Element type of the batches.
+ */
+template<typename eT = double>
+class ImageBatchLoader
+{
+ public:
+  /**
+   * Create the loader.  No image is decoded before the first call to Next(),
+   * except the first image if the size of the images is not given.  A
+   * std::invalid_argument is thrown if there are no files or if the number of
+   * responses does not match, and a std::runtime_error is thrown if the first
+   * image has to be decoded and cannot be.
+   *
+   * @param files Image files to load.
+   * @param responses Responses of the images (one column per image).
+   * @param info Size of the images after resizing, and number of channels (1
+   *     for grayscale, 3 for RGB).  If the width or height is 0, the size of
+   *     the first image is used.
+   * @param batchSize Number of images in each batch.
+   * @param shuffle If true, the images are shuffled at each epoch.
+   * @param numThreads Number of decoding threads (0 to use one per core).
+   * @param prefetchBatches Maximum number of batches decoded ahead.
+   */
+  ImageBatchLoader(const std::vector<std::string>& files,
+                   const arma::Mat<eT>& responses,
+                   const ImageInfo& info = ImageInfo(),
+                   const size_t batchSize = 256,
+                   const bool shuffle = true,
+                   const size_t numThreads = 0,
+                   const size_t prefetchBatches = 4);
+
+  //! The worker threads cannot be shared between loaders.
+  ImageBatchLoader(const ImageBatchLoader& other) = delete;
+  //! The worker threads cannot be shared between loaders.
+  ImageBatchLoader& operator=(const ImageBatchLoader& other) = delete;
+
+  //! Stop the worker threads.
+  ~ImageBatchLoader();
+
+  /**
+   * Get the next batch of the current epoch, waiting for it to be decoded if
+   * necessary.  When all the batches of the epoch have been returned,
+   * `predictors` and `responses` are emptied and false is returned; call
+   * Reset() to start a new epoch.  A std::runtime_error is thrown if an image
+   * of the batch cannot be decoded.
+   *
+   * @param predictors Matrix to store the images of the batch in.
+   * @param responses Matrix to store the responses of the batch in.
+   * @return false if the end of the epoch was reached.
+   */
+  bool Next(arma::Mat<eT>& predictors, arma::Mat<eT>& responses);
+
+  //! Start a new epoch: the decoded batches are dropped, and the images are
+  //! shuffled again if needed.
+  void Reset();
+
+  //! Get the number of images.
+  size_t NumImages() const { return files.size(); }
+  //! Get the number of batches in an epoch.
+  size_t NumBatches() const { return numBatches; }
+  //! Get the number of images in each batch.
+  size_t BatchSize() const { return batchSize; }
+  //! Get the dimensionality of each point of a batch.
+  size_t Dimensionality() const;
+  //! Get the size of the images in the batches (after cropping).
+  ImageInfo OutputInfo() const;
+
+  //! Get the width of the random crops (0 for no cropping).
+  size_t CropWidth() const { return cropWidth; }
+  //! Modify the width of the random crops (0 for no cropping).  Changes take
+  //! effect at the next epoch.
+  size_t& CropWidth() { return cropWidth; }
+  //! Get the height of the random crops (0 for no cropping).
+  size_t CropHeight() const { return cropHeight; }
+  //! Modify the height of the random crops (0 for no cropping).  Changes take
+  //! effect at the next epoch.
+  size_t& CropHeight() { return cropHeight; }
+  //! Get the probability of flipping each image horizontally.
+  double FlipProbability() const { return flipProbability; }
+  //! Modify the probability of flipping each image horizontally.  Changes take
+  //! effect at the next epoch.
+  double& FlipProbability() { return flipProbability; }
+  //! Get the factor that the pixel values are multiplied by.
+  double Scale() const { return scale; }
+  //! Modify the factor that the pixel values are multiplied by (e.g. 1 / 255.0
+  //! to get values in [0, 1]).  Changes take effect at the next epoch.
+  double& Scale() { return scale; }
+
+ private:
+  //! A decoded batch.
+  struct Batch
+  {
+    arma::Mat<eT> predictors;
+    arma::Mat<eT> responses;
+    //! Empty unless an image could not be decoded.
+    std::string error;
+  };
+
+  //! Start the worker threads for the current epoch.
+  void Start();
+  //! Stop and join the worker threads.
+  void Stop();
+  //! Decode batches until the epoch is over or the loader is stopped.
+  void Worker();
+  //! Decode the batch with the given index.
+  void DecodeBatch(const size_t index, Batch& batch) const;
+
+  //! The image files.
+  std::vector<std::string> files;
+  //! The responses of the images.
+  arma::Mat<eT> responses;
+  //! Width of the images after resizing.
+  size_t width;
+  //! Height of the images after resizing.
+  size_t height;
+  //! Number of channels of the images.
+  size_t channels;
+  //! Number of images in each batch.
+  size_t batchSize;
+  //! Number of batches in an epoch.
+  size_t numBatches;
+  //! Whether the images are shuffled at each epoch.
+  bool shuffle;
+  //! Number of worker threads.
+  size_t numThreads;
+  //! Maximum number of batches decoded ahead.
+  size_t prefetchBatches;
+
+  //! Width of the crops.
+  size_t cropWidth;
+  //! Height of the crops.
+  size_t cropHeight;
+  //! Probability of flipping an image.
+  double flipProbability;
+  //! Factor applied to the pixel values.
+  double scale;
+
+  //! Order of the images in the current epoch.
+  arma::uvec order;
+  //! Seed of the random augmentations of the current epoch.
+  size_t epochSeed;
+
+  //! The worker threads.
+  std::vector<std::thread> workers;
+  //! Whether the workers were started for the current epoch.
+  bool started;
+  //! Lock for all the members below.
+  std::mutex mutex;
+  //! Signaled when a batch is ready.
+  std::condition_variable batchReady;
+  //! Signaled when a batch is consumed, or when the workers must stop.
+  std::condition_variable spaceAvailable;
+  //! Whether the workers must stop.
+  bool stopping;
+  //! Index of the next batch to decode.
+  size_t nextBatch;
+  //! Index of the next batch to return.
+  size_t nextConsumed;
+  //! Decoded batches that were not returned yet.
+  std::map<size_t, Batch> ready;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "image_batch_loader_impl.hpp"
+
+#endif
@@ -0,0 +1,331 @@
+/**
+ * @file core/data/image_batch_loader_impl.hpp
+ *
+ * Implementation of the ImageBatchLoader class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_IMAGE_BATCH_LOADER_IMPL_HPP
+#define MLPACK_CORE_DATA_IMAGE_BATCH_LOADER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "image_batch_loader.hpp"
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+/**
+ * Compute the pixels of an outWidth x outHeight region of an image, whose
+ * top-left corner is (x0, y0), after the image is resized from srcWidth x
+ * srcHeight to width x height with bilinear interpolation, and optionally
+ * flipped horizontally.  The pixels are multiplied by `scale`.  The input and
+ * output use the layout of stb (rows of pixels, with interleaved channels).
+ */
+template<typename eT>
+void SampleImage(const unsigned char* image,
+                 const size_t srcWidth,
+                 const size_t srcHeight,
+                 const size_t channels,
+                 const size_t width,
+                 const size_t height,
+                 const size_t x0,
+                 const size_t y0,
+                 const size_t outWidth,
+                 const size_t outHeight,
+                 const bool flip,
+                 const double scale,
+                 eT* out)
+{
+  const double xRatio = double(srcWidth) / width;
+  const double yRatio = double(srcHeight) / height;
+  for (size_t y = 0; y < outHeight; ++y)
+  {
+    // The centers of the pixels of both images are aligned, so an image that
+    // is not resized is copied exactly.
+    const double sy = std::min(std::max((y0 + y + 0.5) * yRatio - 0.5, 0.0),
+        double(srcHeight - 1));
+    const size_t iy = (size_t) sy;
+    const size_t iy1 = std::min(iy + 1, srcHeight - 1);
+    const double fy = sy - iy;
+
+    for (size_t x = 0; x < outWidth; ++x)
+    {
+      const size_t rx = x0 + (flip ? (outWidth - 1 - x) : x);
+      const double sx = std::min(std::max((rx + 0.5) * xRatio - 0.5, 0.0),
+          double(srcWidth - 1));
+      const size_t ix = (size_t) sx;
+      const size_t ix1 = std::min(ix + 1, srcWidth - 1);
+      const double fx = sx - ix;
+
+      const unsigned char* p00 = image + (iy * srcWidth + ix) * channels;
+      const unsigned char* p01 = image + (iy * srcWidth + ix1) * channels;
+      const unsigned char* p10 = image + (iy1 * srcWidth + ix) * channels;
+      const unsigned char* p11 = image + (iy1 * srcWidth + ix1) * channels;
+      eT* o = out + (y * outWidth + x) * channels;
+      for (size_t c = 0; c < channels; ++c)
+      {
+        double value = (1.0 - fy) * ((1.0 - fx) * p00[c] + fx * p01[c]) +
+            fy * ((1.0 - fx) * p10[c] + fx * p11[c]);
+        value *= scale;
+        if constexpr (std::is_integral<eT>::value)
+          value = std::round(value);
+        o[c] = eT(value);
+      }
+    }
+  }
+}
+
+} // namespace details
+
+template<typename eT>
+ImageBatchLoader<eT>::ImageBatchLoader(const std::vector<std::string>& files,
+                                       const arma::Mat<eT>& responses,
+                                       const ImageInfo& info,
+                                       const size_t batchSize,
+                                       const bool shuffle,
+                                       const size_t numThreads,
+                                       const size_t prefetchBatches) :
+    files(files),
+    responses(responses),
+    width(info.Width()),
+    height(info.Height()),
+    channels((info.Channels() == 1) ? 1 : 3),
+    batchSize(batchSize),
+    numBatches(0),
+    shuffle(shuffle),
+    numThreads((numThreads == 0) ?
+        std::max((size_t) std::thread::hardware_concurrency(), (size_t) 1) :
+        numThreads),
+    prefetchBatches(std::max(prefetchBatches, (size_t) 1)),
+    cropWidth(0),
+    cropHeight(0),
+    flipProbability(0.0),
+    scale(1.0),
+    epochSeed(0),
+    started(false),
+    stopping(false),
+    nextBatch(0),
+    nextConsumed(0)
+{
+  if (files.empty())
+    throw std::invalid_argument("ImageBatchLoader: no image files given");
+
+  if (responses.n_cols != files.size())
+  {
+    std::ostringstream oss;
+    oss << "ImageBatchLoader: number of responses (" << responses.n_cols
+        << ") does not match number of images (" << files.size() << ")";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("ImageBatchLoader: the batch size must be "
+        "positive");
+  }
+
+  // If the size of the images is not given, use the size of the first one.
+  if (width == 0 || height == 0)
+  {
+    arma::Mat<unsigned char> image;
+    ImageInfo firstInfo(0, 0, channels);
+    if (!LoadImage(files[0], image, firstInfo, false))
+    {
+      throw std::runtime_error("ImageBatchLoader: cannot decode image '" +
+          files[0] + "'");
+    }
+
+    width = firstInfo.Width();
+    height = firstInfo.Height();
+  }
+
+  numBatches = (files.size() + batchSize - 1) / batchSize;
+  Reset();
+}
+
+template<typename eT>
+ImageBatchLoader<eT>::~ImageBatchLoader()
+{
+  Stop();
+}
+
+template<typename eT>
+bool ImageBatchLoader<eT>::Next(arma::Mat<eT>& predictors,
+                                arma::Mat<eT>& responses)
+{
+  if (!started)
+    Start();
+
+  std::unique_lock<std::mutex> lock(mutex);
+  if (nextConsumed == numBatches)
+  {
+    lock.unlock();
+    predictors.clear();
+    responses.clear();
+    return false;
+  }
+
+  batchReady.wait(lock, [this]() { return ready.count(nextConsumed) > 0; });
+  typename std::map<size_t, Batch>::iterator it = ready.find(nextConsumed);
+  Batch batch = std::move(it->second);
+  ready.erase(it);
+  ++nextConsumed;
+  lock.unlock();
+
+  // There is room for another batch.
+  spaceAvailable.notify_all();
+
+  if (!batch.error.empty())
+    throw std::runtime_error(batch.error);
+
+  predictors = std::move(batch.predictors);
+  responses = std::move(batch.responses);
+  return true;
+}
+
+template<typename eT>
+void ImageBatchLoader<eT>::Reset()
+{
+  Stop();
+
+  if (shuffle)
+    order = arma::randperm<arma::uvec>(files.size());
+  else
+    order = arma::regspace<arma::uvec>(0, files.size() - 1);
+  epochSeed = (size_t) RandInt(std::numeric_limits<int>::max());
+
+  ready.clear();
+  nextBatch = 0;
+  nextConsumed = 0;
+  stopping = false;
+  started = false;
+}
+
+template<typename eT>
+size_t ImageBatchLoader<eT>::Dimensionality() const
+{
+  const ImageInfo info = OutputInfo();
+  return info.Width() * info.Height() * info.Channels();
+}
+
+template<typename eT>
+ImageInfo ImageBatchLoader<eT>::OutputInfo() const
+{
+  return ImageInfo((cropWidth == 0) ? width : cropWidth,
+      (cropHeight == 0) ? height : cropHeight, channels);
+}
+
+template<typename eT>
+void ImageBatchLoader<eT>::Start()
+{
+  if (cropWidth > width || cropHeight > height)
+  {
+    std::ostringstream oss;
+    oss << "ImageBatchLoader::Next(): crops of size " << cropWidth << " x "
+        << cropHeight << " do not fit in images of size " << width << " x "
+        << height;
+    throw std::invalid_argument(oss.str());
+  }
+
+  started = true;
+  const size_t threads = std::min(numThreads, numBatches);
+  for (size_t i = 0; i < threads; ++i)
+    workers.emplace_back(&ImageBatchLoader::Worker, this);
+}
+
+template<typename eT>
+void ImageBatchLoader<eT>::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  spaceAvailable.notify_all();
+
+  for (size_t i = 0; i < workers.size(); ++i)
+    workers[i].join();
+  workers.clear();
+}
+
+template<typename eT>
+void ImageBatchLoader<eT>::Worker()
+{
+  while (true)
+  {
+    // Wait until a batch is left to decode, and there is room for it.
+    size_t index;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      spaceAvailable.wait(lock, [this]()
+      {
+        return stopping || nextBatch == numBatches ||
+            nextBatch < nextConsumed + prefetchBatches;
+      });
+
+      if (stopping || nextBatch == numBatches)
+        return;
+
+      index = nextBatch++;
+    }
+
+    Batch batch;
+    DecodeBatch(index, batch);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ready.emplace(index, std::move(batch));
+    }
+    batchReady.notify_all();
+  }
+}
+
+template<typename eT>
+void ImageBatchLoader<eT>::DecodeBatch(const size_t index, Batch& batch) const
+{
+  const size_t first = index * batchSize;
+  const size_t count = std::min(batchSize, files.size() - first);
+  const ImageInfo outInfo = OutputInfo();
+
+  batch.predictors.set_size(Dimensionality(), count);
+  batch.responses.set_size(responses.n_rows, count);
+
+  // Each batch has its own generator, so the augmentations do not depend on
+  // which worker decodes which batch.
+  std::mt19937 rng(epochSeed + index);
+  std::uniform_int_distribution<size_t> xDist(0, width - outInfo.Width());
+  std::uniform_int_distribution<size_t> yDist(0, height - outInfo.Height());
+  std::uniform_real_distribution<> flipDist;
+
+  arma::Mat<unsigned char> image;
+  for (size_t i = 0; i < count; ++i)
+  {
+    const size_t point = order[first + i];
+    batch.responses.col(i) = responses.col(point);
+
+    ImageInfo imageInfo(0, 0, channels);
+    if (!LoadImage(files[point], image, imageInfo, false) ||
+        image.n_elem != imageInfo.Width() * imageInfo.Height() * channels)
+    {
+      batch.error = "ImageBatchLoader::Next(): cannot decode image '" +
+          files[point] + "'";
+      return;
+    }
+
+    const size_t x0 = xDist(rng);
+    const size_t y0 = yDist(rng);
+    const bool flip = (flipDist(rng) < flipProbability);
+    details::SampleImage(image.memptr(), imageInfo.Width(), imageInfo.Height(),
+        channels, width, height, x0, y0, outInfo.Width(), outInfo.Height(),
+        flip, scale, batch.predictors.colptr(i));
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_IMPUTE_STRATEGIES_CUSTOM_IMPUTATION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "missing_values.hpp"
 
 namespace mlpack {
 namespace data {
@@ -71,6 +72,32 @@ class CustomImputation
     }
   }
 
+  /**
+   * Impute several dimensions at once: the missing values of all the given
+   * dimensions are found in a single pass over the input (in parallel), and
+   * replaced in place with the custom value.  The result is the same as
+   * calling Impute() for each dimension.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value that the user wants to get rid of, for each
+   *     dimension.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    std::vector<std::vector<size_t>> missing;
+    FindMissingValues(input, mappedValues, dimensions, columnMajor, missing);
+
+    arma::vec replacements(dimensions.size());
+    replacements.fill((double) customValue);
+    ReplaceMissingValues(input, dimensions, missing, replacements,
+        columnMajor);
+  }
+
  private:
   //! A user-defined value that the user wants to replace missing values with.
   T customValue;
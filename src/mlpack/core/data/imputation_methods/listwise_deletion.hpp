@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_IMPUTE_STRATEGIES_LISTWISE_DELETION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "missing_values.hpp"
 
 namespace mlpack {
 namespace data {
@@ -66,6 +67,43 @@ class ListwiseDeletion
       input = input.rows(arma::uvec(colsToKeep));
     }
   }
+
+  /**
+   * Remove every point that has a missing value in any of the given
+   * dimensions; the missing values are found in a single pass over the input
+   * (in parallel).  The result is the same as calling Impute() for each
+   * dimension.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value that the user wants to get rid of, for each
+   *     dimension.
+   * @param dimensions Indices of the dimensions to check.
+   * @param columnMajor State of whether the input matrix is columnMajor or not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    std::vector<std::vector<size_t>> missing;
+    FindMissingValues(input, mappedValues, dimensions, columnMajor, missing);
+
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+    std::vector<char> toDelete(numPoints, 0);
+    for (size_t k = 0; k < dimensions.size(); ++k)
+      for (const size_t i : missing[k])
+        toDelete[i] = 1;
+
+    std::vector<arma::uword> colsToKeep;
+    for (size_t i = 0; i < numPoints; ++i)
+      if (!toDelete[i])
+        colsToKeep.push_back(i);
+
+    if (columnMajor)
+      input = input.cols(arma::uvec(colsToKeep));
+    else
+      input = input.rows(arma::uvec(colsToKeep));
+  }
 }; // class ListwiseDeletion
 
 } // namespace data
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_IMPUTE_STRATEGIES_MEAN_IMPUTATION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "missing_values.hpp"
 
 namespace mlpack {
 namespace data {
@@ -96,6 +97,43 @@ class MeanImputation
       input(target.first, target.second) = mean;
     }
   }
+
+  /**
+   * Impute several dimensions at once: the missing values of all the given
+   * dimensions and the sums of their other values are found in a single pass
+   * over the input (in parallel), and the missing values are then replaced
+   * in place with the mean of their dimension.  The result is the same as
+   * calling Impute() for each dimension.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value that the user wants to get rid of, for each
+   *     dimension.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    std::vector<std::vector<size_t>> missing;
+    arma::vec means;
+    FindMissingValues(input, mappedValues, dimensions, columnMajor, missing,
+        &means);
+
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+    for (size_t k = 0; k < dimensions.size(); ++k)
+    {
+      const size_t elems = numPoints - missing[k].size();
+      if (elems == 0)
+        Log::Fatal << "it is impossible to calculate mean; no valid elements "
+            << "in the dimension" << std::endl;
+
+      means[k] /= elems;
+    }
+
+    ReplaceMissingValues(input, dimensions, missing, means, columnMajor);
+  }
 }; // class MeanImputation
 
 } // namespace data
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_IMPUTE_STRATEGIES_MEDIAN_IMPUTATION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "missing_values.hpp"
 
 namespace mlpack {
 namespace data {
@@ -85,6 +86,83 @@ class MedianImputation
        input(target.first, target.second) = median;
     }
   }
+
+  /**
+   * Impute several dimensions at once: the missing values of all the given
+   * dimensions are found in a single pass over the input, then the medians of
+   * the dimensions are computed in parallel with a selection algorithm (each
+   * thread reuses a single buffer), and the missing values are replaced in
+   * place.  The result is the same as calling Impute() for each dimension.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value that the user wants to get rid of, for each
+   *     dimension.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    std::vector<std::vector<size_t>> missing;
+    FindMissingValues(input, mappedValues, dimensions, columnMajor, missing);
+
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+    const size_t numDims = dimensions.size();
+    arma::vec medians(numDims);
+    bool noValidElements = false;
+
+    #pragma omp parallel
+    {
+      std::vector<double> elemsToKeep;
+
+      #pragma omp for schedule(dynamic)
+      for (size_t k = 0; k < numDims; ++k)
+      {
+        // The indices of the missing points are sorted.
+        elemsToKeep.clear();
+        size_t nextMissing = 0;
+        for (size_t i = 0; i < numPoints; ++i)
+        {
+          if (nextMissing < missing[k].size() && missing[k][nextMissing] == i)
+          {
+            ++nextMissing;
+            continue;
+          }
+
+          elemsToKeep.push_back(columnMajor ? input(dimensions[k], i) :
+              input(i, dimensions[k]));
+        }
+
+        if (elemsToKeep.empty())
+        {
+          #pragma omp atomic write
+          noValidElements = true;
+          continue;
+        }
+
+        // With an even number of elements, the median is the average of the
+        // two middle elements, like arma::median().
+        const size_t middle = elemsToKeep.size() / 2;
+        std::nth_element(elemsToKeep.begin(), elemsToKeep.begin() + middle,
+            elemsToKeep.end());
+        medians[k] = elemsToKeep[middle];
+        if (elemsToKeep.size() % 2 == 0)
+        {
+          const double lower = *std::max_element(elemsToKeep.begin(),
+              elemsToKeep.begin() + middle);
+          medians[k] = (lower + medians[k]) / 2.0;
+        }
+      }
+    }
+
+    if (noValidElements)
+      Log::Fatal << "it is impossible to calculate median; no valid elements "
+          << "in the dimension" << std::endl;
+
+    ReplaceMissingValues(input, dimensions, missing, medians, columnMajor);
+  }
 }; // class MedianImputation
 
 } // namespace data
@@ -0,0 +1,168 @@
+/**
+ * @file core/data/imputation_methods/missing_values.hpp
+ *
+ * Utility functions to find and replace the missing values of several
+ * dimensions of a dataset at once, used by the imputation methods.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_IMPUTATION_METHODS_MISSING_VALUES_HPP
+#define MLPACK_CORE_DATA_IMPUTATION_METHODS_MISSING_VALUES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Find the missing values (those equal to the mapped value of their dimension,
+ * or NaN) of the given dimensions of a dataset, in a single pass over the
+ * dataset.  If the dataset is column major (one point per column), blocks of
+ * points are scanned in parallel; otherwise each dimension is a contiguous
+ * column, and the dimensions are scanned in parallel.  The results do not
+ * depend on the number of threads.
+ *
+ * A std::invalid_argument is thrown if the number of mapped values and
+ * dimensions differ, or if a dimension is out of bounds.
+ *
+ * @param input Dataset to search.
+ * @param mappedValues Mapped missing value of each dimension.
+ * @param dimensions Dimensions to search.
+ * @param columnMajor Whether the input matrix is column major.
+ * @param missing Will hold, for each dimension, the sorted indices of the
+ *     points where it is missing.
+ * @param sums If not NULL, will hold the sum of the values of each dimension
+ *     that are not missing.
+ */
+template<typename T>
+void FindMissingValues(const arma::Mat<T>& input,
+                       const std::vector<T>& mappedValues,
+                       const std::vector<size_t>& dimensions,
+                       const bool columnMajor,
+                       std::vector<std::vector<size_t>>& missing,
+                       arma::vec* sums = NULL)
+{
+  if (mappedValues.size() != dimensions.size())
+  {
+    std::ostringstream oss;
+    oss << "FindMissingValues(): number of mapped values ("
+        << mappedValues.size() << ") does not match number of dimensions ("
+        << dimensions.size() << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const size_t dimensionality = columnMajor ? input.n_rows : input.n_cols;
+  for (size_t k = 0; k < dimensions.size(); ++k)
+  {
+    if (dimensions[k] >= dimensionality)
+    {
+      std::ostringstream oss;
+      oss << "FindMissingValues(): dimension " << dimensions[k] << " is out "
+          << "of bounds for a dataset of dimensionality " << dimensionality
+          << "!";
+      throw std::invalid_argument(oss.str());
+    }
+  }
+
+  const size_t numDims = dimensions.size();
+  missing.assign(numDims, std::vector<size_t>());
+  if (sums)
+    sums->zeros(numDims);
+
+  if (!columnMajor)
+  {
+    // Each dimension is a contiguous column.
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t k = 0; k < numDims; ++k)
+    {
+      const T* values = input.colptr(dimensions[k]);
+      double sum = 0.0;
+      for (size_t i = 0; i < input.n_rows; ++i)
+      {
+        if (values[i] == mappedValues[k] || std::isnan(values[i]))
+          missing[k].push_back(i);
+        else
+          sum += values[i];
+      }
+
+      if (sums)
+        (*sums)[k] = sum;
+    }
+
+    return;
+  }
+
+  // Scan blocks of points in parallel, then merge the results of the blocks in
+  // order.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (input.n_cols + blockSize - 1) / blockSize;
+  std::vector<std::vector<std::pair<size_t, size_t>>> blockMissing(numBlocks);
+  arma::mat blockSums;
+  if (sums)
+    blockSums.zeros(numDims, numBlocks);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t end = std::min((b + 1) * blockSize, (size_t) input.n_cols);
+    for (size_t i = b * blockSize; i < end; ++i)
+    {
+      const T* point = input.colptr(i);
+      for (size_t k = 0; k < numDims; ++k)
+      {
+        const T value = point[dimensions[k]];
+        if (value == mappedValues[k] || std::isnan(value))
+          blockMissing[b].emplace_back(k, i);
+        else if (sums)
+          blockSums(k, b) += value;
+      }
+    }
+  }
+
+  for (size_t b = 0; b < numBlocks; ++b)
+    for (const std::pair<size_t, size_t>& position : blockMissing[b])
+      missing[position.first].push_back(position.second);
+
+  if (sums)
+    *sums = arma::sum(blockSums, 1);
+}
+
+/**
+ * Replace the missing values found by FindMissingValues() with the given
+ * value for each dimension, in parallel over the dimensions.
+ *
+ * @param input Dataset to modify.
+ * @param dimensions Dimensions that were searched.
+ * @param missing Indices of the points where each dimension is missing.
+ * @param replacements Value to replace the missing values of each dimension
+ *     with.
+ * @param columnMajor Whether the input matrix is column major.
+ */
+template<typename T>
+void ReplaceMissingValues(arma::Mat<T>& input,
+                          const std::vector<size_t>& dimensions,
+                          const std::vector<std::vector<size_t>>& missing,
+                          const arma::vec& replacements,
+                          const bool columnMajor)
+{
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t k = 0; k < dimensions.size(); ++k)
+  {
+    const T replacement = (T) replacements[k];
+    for (const size_t i : missing[k])
+    {
+      if (columnMajor)
+        input(dimensions[k], i) = replacement;
+      else
+        input(i, dimensions[k]) = replacement;
+    }
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
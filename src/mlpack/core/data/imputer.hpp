@@ -65,6 +65,32 @@ class Imputer
     strategy.Impute(input, mappedValue, dimension, columnMajor);
   }
 
+  /**
+  * Given an input dataset, replace missing values of several dimensions with
+  * given imputation strategy.  The result is the same as calling Impute() for
+  * each dimension, but the strategy handles all the dimensions at once (the
+  * built-in strategies find all the missing values in a single pass over the
+  * input, in parallel).  The strategy must provide an
+  * `Impute(input, mappedValues, dimensions, columnMajor)` function.
+  *
+  * @param input Input dataset to apply imputation.
+  * @param missingValue User defined missing value; it can be anything.
+  * @param dimensions Dimensions to apply the imputation.
+  */
+  void Impute(arma::Mat<T>& input,
+              const std::string& missingValue,
+              const std::vector<size_t>& dimensions)
+  {
+    std::vector<T> mappedValues(dimensions.size());
+    for (size_t i = 0; i < dimensions.size(); ++i)
+    {
+      mappedValues[i] = static_cast<T>(mapper.UnmapValue(missingValue,
+          dimensions[i]));
+    }
+
+    strategy.Impute(input, mappedValues, dimensions, columnMajor);
+  }
+
   //! Get the strategy.
   const StrategyType& Strategy() const { return strategy; }
 
@@ -16,6 +16,7 @@
 #include "load_arff.hpp"
 #include "string_algorithms.hpp"
 #include "is_naninf.hpp"
+#include "map_tokens.hpp"
 
 namespace mlpack {
 namespace data {
@@ -171,89 +172,107 @@ void LoadARFF(const std::string& filename,
     }
   }
 
-  // We need to find out how many lines of data are in the file.
-  std::streampos pos = ifs.tellg();
-  size_t row = 0;
-  while (ifs.good())
+  // Read the @data section into a single buffer; the tokens are views into it.
+  // Empty lines and comments are skipped.
+  const std::string buffer((std::istreambuf_iterator<char>(ifs)),
+      std::istreambuf_iterator<char>());
+  std::vector<std::string_view> lines;
+  std::vector<size_t> lineNumbers;
+  size_t lineStart = 0;
+  size_t lineNumber = headerLines + 1;
+  while (lineStart < buffer.size())
   {
-    std::getline(ifs, line, '\n');
-    ++row;
-  }
-  // Uncount the EOF row.
-  --row;
+    size_t lineEnd = buffer.find('\n', lineStart);
+    if (lineEnd == std::string::npos)
+      lineEnd = buffer.size();
 
-  // Since we've hit the EOF, we have to call clear() so we can seek again.
-  ifs.clear();
-  ifs.seekg(pos);
+    const std::string_view dataLine = TrimView(std::string_view(buffer).substr(
+        lineStart, lineEnd - lineStart));
+    if (!dataLine.empty() && dataLine[0] != '%')
+    {
+      lines.push_back(dataLine);
+      lineNumbers.push_back(lineNumber);
+    }
+
+    lineStart = lineEnd + 1;
+    ++lineNumber;
+  }
 
   // Now, set the size of the matrix.
-  matrix.set_size(dimensionality, row);
+  matrix.set_size(dimensionality, lines.size());
 
-  // Now we are looking at the @data section.
-  row = 0;
-  while (ifs.good())
+  std::vector<size_t> categoricalDims;
+  for (size_t i = 0; i < types.size(); ++i)
+    if (types[i])
+      categoricalDims.push_back(i);
+
+  // Tokenize the lines in parallel.  Each line of the @data section must be a
+  // CSV (except sparse data, which we will handle later).  Numeric values are
+  // parsed directly; categorical values are kept as views of their tokens and
+  // mapped afterwards.  The '?' representing a missing value is not allowed, so
+  // if that occurs we throw an exception.  We also throw an exception if any
+  // piece of data does not match its type (categorical or numeric).  If there
+  // are several errors, the one on the first line is reported.
+  std::vector<std::string_view> tokens(categoricalDims.empty() ? 0 :
+      dimensionality * lines.size());
+  // Lines with escaped characters are tokenized with copies.
+  std::vector<std::vector<std::string>> escapedTokens(lines.size());
+  size_t failedRow = SIZE_MAX;
+  std::string failedMessage;
+
+  #pragma omp parallel
   {
-    std::getline(ifs, line, '\n');
-    Trim(line);
-    // Each line of the @data section must be a CSV (except sparse data, which
-    // we will handle later).  So now we can tokenize the
-    // CSV and parse it.  The '?' representing a missing value is not allowed,
-    // so if that occurs we throw an exception.  We also throw an exception if
-    // any piece of data does not match its type (categorical or numeric).
-
-    // If the first character is {, it is sparse data, and we can just say this
-    // is not handled for now...
-    if (line[0] == '{')
-      throw std::runtime_error("cannot yet parse sparse ARFF data");
-
-    // Tokenize the line.
-    std::vector<std::string> tok = Tokenize(line, ',', '"');
-
-    size_t col = 0;
-    std::stringstream token;
-    for (std::vector<std::string>::iterator it = tok.begin(); it != tok.end();
-         ++it)
+    std::vector<std::string_view> lineTokens;
+    std::string tokenString;
+    std::istringstream token;
+
+    #pragma omp for schedule(dynamic, 256)
+    for (size_t row = 0; row < lines.size(); ++row)
     {
-      // Check that we are not too many columns in.
-      if (col >= matrix.n_rows)
+      std::ostringstream error;
+      const std::string_view dataLine = lines[row];
+
+      // If the first character is {, it is sparse data, and we can just say
+      // this is not handled for now...
+      if (dataLine[0] == '{')
+      {
+        error << "cannot yet parse sparse ARFF data";
+      }
+      else if (dataLine.find('\\') != std::string_view::npos)
       {
-        std::stringstream error;
-        error << "Too many columns in line " << (headerLines + row) << ".";
-        throw std::runtime_error(error.str());
+        std::string lineString(dataLine);
+        escapedTokens[row] = Tokenize(lineString, ',', '"');
+        lineTokens.assign(escapedTokens[row].begin(),
+            escapedTokens[row].end());
+      }
+      else
+      {
+        TokenizeView(dataLine, ',', '"', lineTokens);
       }
 
-      // What should this token be?
-      if (info.Type(col) == Datatype::categorical)
+      if (error.tellp() == 0 && lineTokens.size() > dimensionality)
+      {
+        error << "Too many columns in line " << lineNumbers[row] << ".";
+      }
+      else if (error.tellp() == 0 && lineTokens.size() < dimensionality)
       {
-        // Strip spaces before mapping.
-        std::string token = *it;
-        Trim(token);
-        const size_t currentNumMappings = info.NumMappings(col);
-        const eT result = info.template MapString<eT>(token, col);
-
-        // If the set of categories was pre-specified, then we must crash if
-        // this was not one of those categories.
-        if (categoryStrings.count(col) > 0 &&
-            currentNumMappings < info.NumMappings(col))
+        error << "Too few columns in line " << lineNumbers[row] << ".";
+      }
+
+      for (size_t col = 0; col < lineTokens.size() && error.tellp() == 0;
+          ++col)
+      {
+        if (types[col])
         {
-          std::stringstream error;
-          error << "Parse error at line " << (headerLines + row) << " token "
-              << col << ": category \"" << token << "\" not in the set of known"
-              << " categories for this dimension (";
-          for (size_t i = 0; i < categoryStrings.at(col).size() - 1; ++i)
-            error << "\"" << categoryStrings.at(col)[i] << "\", ";
-          error << "\"" << categoryStrings.at(col).back() << "\").";
-          throw std::runtime_error(error.str());
+          // Strip spaces before mapping.
+          tokens[col + row * dimensionality] = TrimView(lineTokens[col]);
+          continue;
         }
 
-        // We load transposed.
-        matrix(col, row) = result;
-      }
-      else if (info.Type(col) == Datatype::numeric)
-      {
         // Attempt to read as numeric.
+        tokenString.assign(lineTokens[col]);
         token.clear();
-        token.str(*it);
+        token.str(tokenString);
 
         eT val = eT(0);
         token >> val;
@@ -261,20 +280,18 @@ void LoadARFF(const std::string& filename,
         if (token.fail())
         {
           // Check for NaN or inf.
-          if (!IsNaNInf(val, token.str()))
+          if (!IsNaNInf(val, tokenString))
           {
             // Okay, it's not NaN or inf.  If it's '?', we issue a specific
             // error, otherwise we issue a general error.
-            std::stringstream error;
-            std::string tokenStr = token.str();
-            Trim(tokenStr);
+            std::string tokenStr(TrimView(tokenString));
             if (tokenStr == "?")
               error << "Missing values ('?') not supported, ";
             else
               error << "Parse error ";
-            error << "at line " << (headerLines + row) << " token " << col
+            error << "at line " << lineNumbers[row] << " token " << col
                 << ": \"" << tokenStr << "\".";
-            throw std::runtime_error(error.str());
+            break;
           }
         }
 
@@ -282,9 +299,51 @@ void LoadARFF(const std::string& filename,
         matrix(col, row) = val; // We load transposed.
       }
 
-      ++col;
+      if (error.tellp() != 0)
+      {
+        #pragma omp critical
+        {
+          if (row < failedRow)
+          {
+            failedRow = row;
+            failedMessage = error.str();
+          }
+        }
+      }
     }
-    ++row;
+  }
+
+  // Map the categorical values.  If the set of categories was pre-specified,
+  // then we must crash if a value was not one of those categories.  Only the
+  // lines before the first error found so far matter.
+  const size_t parseFailedRow = failedRow;
+  size_t failedCol = 0;
+  std::string failedToken;
+  MapTokens(tokens, categoricalDims, false, matrix, info,
+      [&](const size_t col, const size_t row, const std::string_view category)
+      {
+        if (categoryStrings.count(col) > 0 && row < failedRow)
+        {
+          failedRow = row;
+          failedCol = col;
+          failedToken = category;
+        }
+      });
+
+  if (failedRow == parseFailedRow && failedRow != SIZE_MAX)
+  {
+    throw std::runtime_error(failedMessage);
+  }
+  else if (failedRow != SIZE_MAX)
+  {
+    std::stringstream error;
+    error << "Parse error at line " << lineNumbers[failedRow] << " token "
+        << failedCol << ": category \"" << failedToken << "\" not in the set "
+        << "of known categories for this dimension (";
+    for (size_t i = 0; i < categoryStrings.at(failedCol).size() - 1; ++i)
+      error << "\"" << categoryStrings.at(failedCol)[i] << "\", ";
+    error << "\"" << categoryStrings.at(failedCol).back() << "\").";
+    throw std::runtime_error(error.str());
   }
 }
 
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_LOAD_CATEGORICAL_CSV_HPP
 
 #include "load_csv.hpp"
+#include "map_tokens.hpp"
 
 namespace mlpack{
 namespace data{
@@ -23,11 +24,7 @@ void LoadCSV::LoadCategoricalCSV(arma::Mat<eT> &inout,
                                  const bool transpose)
 {
   CheckOpen();
-
-  if (transpose)
-    TransposeParse(inout, infoSet);
-  else
-    NonTransposeParse(inout, infoSet);
+  CategoricalParse(inout, infoSet, transpose);
 }
 
 inline void LoadCSV::CategoricalMatSize(
@@ -217,133 +214,137 @@ void LoadCSV::InitializeMapper(size_t& rows, size_t& cols,
   }
 }
 
-template<typename T, typename PolicyType>
-void LoadCSV::TransposeParse(arma::Mat<T>& inout,
-                             DatasetMapper<PolicyType>& infoSet)
+inline void LoadCSV::TokenizeCategoricalLine(
+    const std::string_view line,
+    std::vector<std::string_view>& tokens) const
 {
-  // Get matrix size.  This also initializes infoSet correctly.
-  size_t rows, cols;
-  InitializeTransposeMapper<T>(rows, cols, infoSet);
-
-  // Set the matrix size.
-  inout.set_size(rows, cols);
-
-  // Initialize auxiliary variables.
-  size_t row = 0;
-  size_t col = 0;
-  std::string line;
-  inFile.clear();
-  inFile.seekg(0, std::ios::beg);
-
-  while (std::getline(inFile, line))
+  tokens.clear();
+  size_t start = 0;
+  while (true)
   {
-    // Remove whitespaces from either side.
-    Trim(line);
-    // Reset the row we are looking at.  (Remember this is transposed.)
-    row = 0;
-    std::stringstream lineStream;
-    std::string token;
-    lineStream.clear();
-    lineStream.str(line);
-
-    while (lineStream.good())
-    {
-      std::getline(lineStream, token, delim);
-      // Remove whitespaces from either side.
-      Trim(token);
+    size_t end = line.find(delim, start);
+    if (end == std::string_view::npos)
+      end = line.size();
 
-      if (token[0] == '"' && token[token.size() - 1] != '"')
+    // Remove whitespace from either side.
+    std::string_view token = TrimView(line.substr(start, end - start));
+    if (!token.empty() && token[0] == '"' && token.back() != '"')
+    {
+      // The token is quoted and contains the delimiter, so it continues until
+      // a piece that ends with a quote.
+      const size_t tokenStart = token.data() - line.data();
+      while (end < line.size())
       {
-        // First part of the string.
-        std::string tok = token;
-        while (token[token.size() - 1] != '"')
-        {
-          tok += delim;
-          std::getline(lineStream, token, delim);
-          tok += token;
-        }
-        token = tok;
+        start = end + 1;
+        end = line.find(delim, start);
+        if (end == std::string_view::npos)
+          end = line.size();
+        if (end > start && line[end - 1] == '"')
+          break;
       }
-      inout(row, col) = infoSet.template MapString<T>(std::move(token), row);
-      row++;
+      token = line.substr(tokenStart, end - tokenStart);
     }
 
-    // Make sure we got the right number of rows.
-    if (row != rows)
-    {
-      std::ostringstream oss;
-      oss << "LoadCSV::TransposeParse(): wrong number of dimensions (" << row
-          << ") on line " << col << "; should be " << rows << " dimensions.";
-      throw std::runtime_error(oss.str());
-    }
-    // Increment the column index.
-    ++col;
+    tokens.push_back(token);
+    if (end >= line.size())
+      break;
+    start = end + 1;
   }
 }
 
 template<typename T, typename PolicyType>
-void LoadCSV::NonTransposeParse(arma::Mat<T>& inout,
-                                DatasetMapper<PolicyType>& infoSet)
+void LoadCSV::CategoricalParse(arma::Mat<T>& inout,
+                               DatasetMapper<PolicyType>& infoSet,
+                               const bool transpose)
 {
-  // Get the size of the matrix.
-  size_t rows, cols;
-  InitializeMapper<T>(rows, cols, infoSet);
-
-  // Set up output matrix.
-  inout.set_size(rows, cols);
-  size_t row = 0;
-  size_t col = 0;
-
-  // Reset file position.
-  std::string line;
+  // Read the whole file into a single buffer; the tokens are views into it.
   inFile.clear();
   inFile.seekg(0, std::ios::beg);
-
-  while (std::getline(inFile, line))
+  const std::string buffer((std::istreambuf_iterator<char>(inFile)),
+      std::istreambuf_iterator<char>());
+
+  // Find the lines, removing whitespace from either side and skipping empty
+  // lines.
+  std::vector<std::string_view> lines;
+  size_t lineStart = 0;
+  while (lineStart < buffer.size())
   {
-    // Remove whitespaces from either side.
-    Trim(line);
-
-    std::stringstream lineStream;
-    std::string token;
+    size_t lineEnd = buffer.find('\n', lineStart);
+    if (lineEnd == std::string::npos)
+      lineEnd = buffer.size();
+
+    const std::string_view line = TrimView(std::string_view(buffer).substr(
+        lineStart, lineEnd - lineStart));
+    if (!line.empty())
+      lines.push_back(line);
+    lineStart = lineEnd + 1;
+  }
 
-    lineStream.clear();
-    lineStream.str(line);
+  // The first line gives the number of tokens on each line.  If the matrix is
+  // transposed, each line is a point; otherwise each line is a dimension.
+  std::vector<std::string_view> lineTokens;
+  if (!lines.empty())
+    TokenizeCategoricalLine(lines[0], lineTokens);
+  const size_t lineSize = lineTokens.size();
+  const size_t rows = transpose ? lineSize : lines.size();
+  const size_t cols = transpose ? lines.size() : lineSize;
 
-    while (lineStream.good())
-    {
-      if (token == "\t")
-        token.clear();
+  // Reset the DatasetInfo object, if needed.
+  if (infoSet.Dimensionality() == 0)
+  {
+    infoSet.SetDimensionality(rows);
+  }
+  else if (infoSet.Dimensionality() != rows)
+  {
+    std::ostringstream oss;
+    oss << "data::LoadCSV(): given DatasetInfo has dimensionality "
+        << infoSet.Dimensionality() << ", but data has dimensionality "
+        << rows;
+    throw std::invalid_argument(oss.str());
+  }
 
-      std::getline(lineStream, token, delim);
-      // Remove whitespace from either side.
-      Trim(token);
+  // Tokenize the lines in parallel, storing the token of each element of the
+  // matrix in column-major order.
+  inout.set_size(rows, cols);
+  std::vector<std::string_view> tokens(rows * cols);
+  std::vector<size_t> lineSizes(lines.size());
+  #pragma omp parallel for schedule(dynamic, 256) firstprivate(lineTokens)
+  for (size_t i = 0; i < lines.size(); ++i)
+  {
+    TokenizeCategoricalLine(lines[i], lineTokens);
+    lineSizes[i] = lineTokens.size();
+    if (lineTokens.size() != lineSize)
+      continue;
 
-      if (token[0] == '"' && token[token.size() - 1] != '"')
-      {
-        std::string tok = token;
-        while (token[token.size() - 1] != '"')
-        {
-          tok += delim;
-          std::getline(lineStream, token, delim);
-          tok += token;
-        }
-        token = tok;
-      }
-      inout(row, col++) = infoSet.template MapString<T>(std::move(token), row);
+    for (size_t j = 0; j < lineSize; ++j)
+    {
+      if (transpose)
+        tokens[j + i * rows] = lineTokens[j];
+      else
+        tokens[i + j * rows] = lineTokens[j];
     }
+  }
 
-    // Make sure we got the right number of rows.
-    if (col != cols)
+  // Make sure we got the right number of dimensions on each line.
+  for (size_t i = 0; i < lines.size(); ++i)
+  {
+    if (lineSizes[i] != lineSize)
     {
       std::ostringstream oss;
-      oss << "LoadCSV::NonTransposeParse(): wrong number of dimensions ("
-          << col << ") on line " << row << "; should be " << cols
+      oss << "LoadCSV::LoadCategoricalCSV(): wrong number of dimensions ("
+          << lineSizes[i] << ") on line " << i << "; should be " << lineSize
           << " dimensions.";
       throw std::runtime_error(oss.str());
     }
-    ++row; col = 0;
   }
+
+  // Map all the tokens, after a first pass over them if the DatasetMapper
+  // policy requires it (e.g. to find which dimensions are numeric or
+  // categorical).
+  std::vector<size_t> dimensions(rows);
+  std::iota(dimensions.begin(), dimensions.end(), 0);
+  MapTokens(tokens, dimensions, PolicyType::NeedsFirstPass, inout, infoSet,
+      [](const size_t, const size_t, const std::string_view) { });
 }
 
 } //namespace data
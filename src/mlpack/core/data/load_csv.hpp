@@ -101,17 +101,23 @@ class LoadCSV
   /**
   * Returns a bool value showing whether data was loaded successfully or not.
   *
-  * Parses a csv file and loads the data into the given matrix. In the first pass,
-  * the function will determine the number of cols and rows in the given file.
-  * Once the rows and cols are fixed we initialize the matrix with zeros. In 
-  * the second pass, the function converts each value to required datatype
-  * and sets it equal to val. 
+  * Parses a csv file and loads the data into the given matrix. In the first
+  * pass, the function counts the number of rows and columns in the file by
+  * only scanning for newlines and delimiters.  Once the rows and cols are fixed
+  * we initialize the matrix with zeros.  In the second pass, the file is read
+  * in large blocks, and the lines of each block are parsed in place (in
+  * parallel, if OpenMP is enabled), converting each value to the required
+  * datatype.
   *
   * @param x Matrix in which data will be loaded.
   * @param f File stream to access the data file.
+  * @param transpose If true, each line of the file is stored as a column of
+  *     the matrix.
   */
   template<typename eT>
-  bool LoadNumericCSV(arma::Mat<eT>& x, std::fstream& f);
+  bool LoadNumericCSV(arma::Mat<eT>& x,
+                      std::fstream& f,
+                      const bool transpose = false);
 
   /**
   * Converts the given string token to assigned datatype and assigns
@@ -127,6 +133,58 @@ class LoadCSV
   template<typename eT>
   bool ConvertToken(eT& val, const std::string& token);
 
+  /**
+  * Converts the token in the range [begin, end) to the assigned datatype,
+  * without copying it into a string.  Surrounding whitespace is ignored.
+  *
+  * @param val Token's value will be assigned to this address.
+  * @param begin Start of the token.
+  * @param end One past the end of the token.
+  */
+  template<typename eT>
+  bool ConvertToken(eT& val, const char* begin, const char* end);
+
+  /**
+   * Parse the lines in the range [begin, end) of a block of a numeric csv file
+   * into the given matrix, starting at the given row.  The range must not
+   * include the newline at the end of the last line.  Lines past the given
+   * number of rows are ignored.  If a token cannot be converted, the location
+   * of the first such token is stored and false is returned.
+   *
+   * @param x Matrix in which data will be loaded.
+   * @param begin Start of the block.
+   * @param end End of the block.
+   * @param row Row of the first line in the block; set to the row after the
+   *     last line in the block.
+   * @param rows Total number of rows in the matrix.
+   * @param transpose If true, each line is stored as a column of the matrix.
+   * @param failedRow Set to the row of the first token that failed to convert.
+   * @param failedCol Set to the column of the first token that failed to
+   *     convert.
+   * @param failedToken Set to the first token that failed to convert.
+   */
+  template<typename eT>
+  bool ParseNumericCSVBlock(arma::Mat<eT>& x,
+                            const char* begin,
+                            const char* end,
+                            size_t& row,
+                            const size_t rows,
+                            const bool transpose,
+                            size_t& failedRow,
+                            size_t& failedCol,
+                            std::string& failedToken);
+
+  /**
+   * Count the number of rows and the maximum number of columns in a numeric
+   * csv file, without parsing any values.  Counting stops at the first empty
+   * line.
+   *
+   * @param f File stream to access the data file.
+   * @param rows Set to the number of rows in the file.
+   * @param cols Set to the maximum number of columns in any row.
+   */
+  inline void NumericCSVSize(std::fstream& f, size_t& rows, size_t& cols);
+
   /**
    * Calculate the number of columns in each row
    * and assign the value to the col. This function
@@ -277,23 +335,31 @@ class LoadCSV
   // Functions for Categorical Parse.
 
   /**
-  * Parse a non-transposed matrix.
-  *
-  * @param input Matrix to load into.
-  * @param infoSet DatasetMapper object to load with.
-  */
+   * Parse a matrix that may contain categorical data.  The whole file is read
+   * into memory; the lines are tokenized in parallel into views of the tokens,
+   * which are then mapped with MapTokens(), so that each distinct token of
+   * each dimension is only mapped once.
+   *
+   * @param inout Matrix to load into.
+   * @param infoSet DatasetMapper object to load with.
+   * @param transpose If true, each line of the file is a column of the matrix.
+   */
   template<typename T, typename PolicyType>
-  void NonTransposeParse(arma::Mat<T>& inout,
-                         DatasetMapper<PolicyType>& infoSet);
+  void CategoricalParse(arma::Mat<T>& inout,
+                        DatasetMapper<PolicyType>& infoSet,
+                        const bool transpose);
 
   /**
-  * Parse a transposed matrix.
-  *
-  * @param input Matrix to load into.
-  * @param infoSet DatasetMapper to load with.
-  */
-  template<typename T, typename PolicyType>
-  void TransposeParse(arma::Mat<T>& inout, DatasetMapper<PolicyType>& infoSet);
+   * Split a line of a categorical file into views of its tokens.  Whitespace is
+   * removed from either side of each token, and quoted tokens may contain the
+   * delimiter.
+   *
+   * @param line Line to split.
+   * @param tokens Will hold the tokens of the line.
+   */
+  inline void TokenizeCategoricalLine(const std::string_view line,
+                                      std::vector<std::string_view>& tokens)
+      const;
 
   //! Extension (type) of file.
   std::string extension;
@@ -303,6 +369,9 @@ class LoadCSV
   std::fstream inFile;
   //! Delimiter char.
   char delim;
+
+  //! Size of the blocks read from numeric csv files (16MB).
+  static constexpr size_t csvBlockSize = (1 << 24);
 };
 
 } // namespace data
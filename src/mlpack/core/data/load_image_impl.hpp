@@ -76,14 +76,38 @@ bool Load(const std::vector<std::string>& files,
       info.Width() * info.Height() * info.Channels(), files.size());
   tmpMatrix.col(0) = img;
 
-  for (size_t i = 1; i < files.size() ; ++i)
+  // The other images are decoded in parallel.  An exception cannot leave an
+  // OpenMP loop, so failures are reported after the loop.
+  size_t failed = files.size();
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 1; i < files.size(); ++i)
   {
-    arma::Mat<unsigned char> colImg(tmpMatrix.colptr(i), tmpMatrix.n_rows, 1,
-        false, true);
-    status = LoadImage(files[i], colImg, info, fatal);
+    arma::Mat<unsigned char> colImg;
+    ImageInfo colInfo(info);
+    if (!LoadImage(files[i], colImg, colInfo, false) ||
+        colImg.n_elem != tmpMatrix.n_rows)
+    {
+      #pragma omp critical
+      failed = std::min(failed, i);
+    }
+    else
+    {
+      tmpMatrix.col(i) = colImg;
+    }
+  }
 
-    if (!status)
-      return false;
+  if (failed != files.size())
+  {
+    std::ostringstream oss;
+    oss << "Load(): failed to load image '" << files[failed] << "', or its "
+        << "size differs from the size of '" << files[0] << "'." << std::endl;
+
+    if (fatal)
+      Log::Fatal << oss.str();
+    else
+      Log::Warn << oss.str();
+
+    return false;
   }
 
   matrix = arma::conv_to<arma::Mat<eT>>::from(tmpMatrix);
@@ -163,8 +163,9 @@ bool Load(const std::string& filename,
 
   if (loadType != FileType::HDF5Binary)
   {
+    // The CSV loader can write the transposed matrix directly.
     if (loadType == FileType::CSVASCII)
-      success = loader.LoadNumericCSV(matrix, stream);
+      success = loader.LoadNumericCSV(matrix, stream, transpose);
     else
       success = matrix.load(stream, ToArmaFileType(loadType));
   }
@@ -182,12 +183,16 @@ bool Load(const std::string& filename,
 
     return false;
   }
+  else if (loadType == FileType::CSVASCII)
+    Log::Info << "Size is " << (transpose ? matrix.n_rows : matrix.n_cols)
+        << " x " << (transpose ? matrix.n_cols : matrix.n_rows) << ".\n";
   else
     Log::Info << "Size is " << (transpose ? matrix.n_cols : matrix.n_rows)
         << " x " << (transpose ? matrix.n_rows : matrix.n_cols) << ".\n";
 
-  // Now transpose the matrix, if necessary.
-  if (transpose)
+  // Now transpose the matrix, if necessary.  CSV files were already loaded
+  // transposed.
+  if (transpose && loadType != FileType::CSVASCII)
   {
     success = inplace_transpose(matrix, fatal);
   }
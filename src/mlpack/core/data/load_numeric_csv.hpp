@@ -14,6 +14,13 @@
 
 #include "load_csv.hpp"
 
+#include <charconv>
+#include <cstring>
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace data {
 
@@ -44,7 +51,23 @@ template<typename eT>
 bool LoadCSV::ConvertToken(eT& val,
                            const std::string& token)
 {
-  const size_t N = size_t(token.length());
+  return ConvertToken(val, token.c_str(), token.c_str() + token.length());
+}
+
+template<typename eT>
+bool LoadCSV::ConvertToken(eT& val,
+                           const char* str,
+                           const char* end)
+{
+  // Ignore surrounding whitespace (and '\r' from Windows line endings), like
+  // strtod() does.
+  while ((str < end) && ((*str == ' ') || (*str == '\t')))
+    ++str;
+  while ((end > str) &&
+         ((end[-1] == ' ') || (end[-1] == '\t') || (end[-1] == '\r')))
+    --end;
+
+  const size_t N = size_t(end - str);
   // Fill empty data points with 0.
   if (N == 0)
   {
@@ -52,8 +75,6 @@ bool LoadCSV::ConvertToken(eT& val,
     return true;
   }
 
-  const char* str = token.c_str();
-
   // Checks for +/-INF and NAN
   // Converts them to their equivalent representation from numeric_limits.
   if ((N == 3) || (N == 4))
@@ -83,95 +104,286 @@ bool LoadCSV::ConvertToken(eT& val,
     }
   }
 
-  char* endptr = nullptr;
+  // std::from_chars() does not accept a leading '+'.
+  if ((str[0] == '+') && (N > 1))
+    ++str;
 
   // Convert the token into correct type.
   // If we have a eT as unsigned int,
   // it will convert all negative numbers to 0.
-  if (std::is_floating_point_v<eT>)
+  if constexpr (std::is_floating_point_v<eT>)
   {
-    val = eT(std::strtod(str, &endptr));
+    #if defined(__cpp_lib_to_chars)
+    std::from_chars_result result = std::from_chars(str, end, val);
+    if (result.ec == std::errc::result_out_of_range)
+    {
+      // Match the behavior of strtod(): overflow gives infinity and underflow
+      // gives 0.
+      const std::string token(str, end);
+      val = eT(std::strtod(token.c_str(), nullptr));
+      return true;
+    }
+
+    return (result.ptr != str);
+    #else
+    // Floating-point std::from_chars() is not available, so we have to fall
+    // back to strtod(), which needs a null-terminated string.
+    const std::string token(str, end);
+    char* endptr = nullptr;
+    val = eT(std::strtod(token.c_str(), &endptr));
+    return (endptr != token.c_str());
+    #endif
   }
-  else if (std::is_integral_v<eT>)
+  else if constexpr (std::is_integral_v<eT>)
   {
-    if (std::is_signed_v<eT>)
-      val = eT(std::strtoll(str, &endptr, 10));
-    else
+    if (std::is_unsigned_v<eT> && str[0] == '-')
     {
-      if (str[0] == '-')
-      {
-        val = eT(0);
-        return true;
-      }
-      val = eT(std::strtoull(str, &endptr, 10));
+      val = eT(0);
+      return true;
     }
+
+    std::from_chars_result result = std::from_chars(str, end, val);
+    // If the value is out of range, val is left unmodified.
+    return (result.ptr != str);
   }
   // If none of the above conditions was executed,
   // then the conversion will fail.
   else
+  {
     return false;
-
-  // If any of strtod() or strtoll() fails, str will
-  // be set to nullptr and this condition will be
-  // executed.
-  if (str == endptr)
-    return false;
-
-  return true;
+  }
 }
 
 template<typename eT>
-bool LoadCSV::LoadNumericCSV(arma::Mat<eT>& x, std::fstream& f)
+bool LoadCSV::LoadNumericCSV(arma::Mat<eT>& x,
+                             std::fstream& f,
+                             const bool transpose)
 {
   bool loadOkay = f.good();
   f.clear();
-  std::pair<size_t, size_t> mat_size = GetMatrixSize<true>(f);
-  x.zeros(mat_size.first, mat_size.second);
-  size_t row = 0;
+  const std::fstream::pos_type start = f.tellg();
 
-  std::string lineString;
-  std::stringstream lineStream;
-  std::string token;
+  // The first pass only counts newlines and delimiters, so it is very cheap
+  // compared to parsing the values.
+  size_t rows, cols;
+  NumericCSVSize(f, rows, cols);
 
-  while (f.good())
+  f.clear();
+  f.seekg(start);
+
+  if (transpose)
+    x.zeros(cols, rows);
+  else
+    x.zeros(rows, cols);
+
+  // Now read the file in large blocks.  Each block is cut after the last
+  // complete line it contains, and the remainder is carried over into the next
+  // block.  The lines in each block are parsed in place, in parallel.
+  std::vector<char> buffer;
+  size_t carried = 0;
+  size_t row = 0;
+  while (row < rows)
   {
-    // Parse the file line by line.
-    std::getline(f, lineString);
+    buffer.resize(carried + csvBlockSize);
+    f.read(buffer.data() + carried, csvBlockSize);
+    const size_t length = carried + size_t(f.gcount());
+    const bool done = !f.good();
 
-    if (lineString.size() == 0)
-      break;
+    // Find the end of the last complete line.  If we have reached the end of
+    // the file, the last line is complete even without a trailing newline.
+    size_t end = length;
+    if (!done)
+    {
+      while (end > 0 && buffer[end - 1] != '\n')
+        --end;
 
-    lineStream.clear();
-    lineStream.str(lineString);
+      if (end == 0)
+      {
+        // This line is longer than a block; read more before parsing.
+        carried = length;
+        continue;
+      }
 
-    size_t col = 0;
+      --end; // Do not include the final newline.
+    }
 
-    while (lineStream.good())
+    size_t failedRow, failedCol;
+    std::string failedToken;
+    if (!ParseNumericCSVBlock(x, buffer.data(), buffer.data() + end, row,
+        rows, transpose, failedRow, failedCol, failedToken))
     {
-      // Parse each line.
-      std::getline(lineStream, token, ',');
+      // Printing failed token and it's location.
+      Log::Warn << "Failed to convert token " << failedToken << ", at row "
+          << failedRow << ", column " << failedCol << " of matrix!";
+
+      return false;
+    }
+
+    if (done)
+      break;
 
-      // This will handle loading of both dense and sparse.
-      // Initialize tmp_val of type eT with value 0.
-      eT tmpVal = eT(0);
+    // Carry over whatever comes after the newline at the end of the block.
+    carried = length - (end + 1);
+    std::memmove(buffer.data(), buffer.data() + end + 1, carried);
+  }
+
+  return loadOkay;
+}
+
+template<typename eT>
+bool LoadCSV::ParseNumericCSVBlock(arma::Mat<eT>& x,
+                                   const char* begin,
+                                   const char* end,
+                                   size_t& row,
+                                   const size_t rows,
+                                   const bool transpose,
+                                   size_t& failedRow,
+                                   size_t& failedCol,
+                                   std::string& failedToken)
+{
+  // Split the block into one chunk per thread, on line boundaries.  Tiny blocks
+  // are not worth splitting.
+  size_t numChunks = 1;
+  #ifdef MLPACK_USE_OPENMP
+  if (size_t(end - begin) > (1 << 16))
+    numChunks = omp_get_max_threads();
+  #endif
+
+  std::vector<const char*> chunkStarts(numChunks + 1);
+  chunkStarts[0] = begin;
+  chunkStarts[numChunks] = end;
+  for (size_t c = 1; c < numChunks; ++c)
+  {
+    const char* p = std::max(chunkStarts[c - 1],
+        begin + c * (size_t(end - begin) / numChunks));
+    p = (const char*) std::memchr(p, '\n', end - p);
+    chunkStarts[c] = (p == NULL) ? end : p + 1;
+  }
 
-      if (ConvertToken<eT>(tmpVal, token))
+  // Count the lines in each chunk, so that we know which row each chunk starts
+  // at.  Every line but the very last one in the block ends with a newline.
+  std::vector<size_t> chunkRows(numChunks + 1, 0);
+  chunkRows[0] = row;
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    chunkRows[c + 1] = chunkRows[c] + std::count(chunkStarts[c],
+        chunkStarts[c + 1], '\n');
+  }
+  // Account for the last line of the block, which has no newline.
+  const size_t blockRows = chunkRows[numChunks] + 1 - row;
+
+  // Keep track of the first failure (by row) in any chunk.
+  failedRow = SIZE_MAX;
+  failedCol = 0;
+
+  #pragma omp parallel for schedule(static, 1) num_threads(numChunks)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    const char* lineStart = chunkStarts[c];
+    const char* chunkEnd = chunkStarts[c + 1];
+    // All chunks but the last end right after a newline.
+    const bool lastChunk = (c == numChunks - 1);
+    if (!lastChunk && lineStart == chunkEnd)
+      continue;
+
+    for (size_t r = chunkRows[c]; r < rows; ++r)
+    {
+      const char* lineEnd = (const char*) std::memchr(lineStart, '\n',
+          chunkEnd - lineStart);
+      if (lineEnd == NULL)
+        lineEnd = chunkEnd;
+
+      // Parse each token in the line.
+      const char* tokenStart = lineStart;
+      size_t col = 0;
+      while (col < (transpose ? x.n_rows : x.n_cols))
       {
-        x.at(row, col) = tmpVal;
+        const char* tokenEnd = (const char*) std::memchr(tokenStart, ',',
+            lineEnd - tokenStart);
+        if (tokenEnd == NULL)
+          tokenEnd = lineEnd;
+
+        eT tmpVal = eT(0);
+        if (!ConvertToken<eT>(tmpVal, tokenStart, tokenEnd))
+        {
+          #pragma omp critical
+          {
+            if (r < failedRow)
+            {
+              failedRow = r;
+              failedCol = col;
+              failedToken = std::string(tokenStart, tokenEnd);
+            }
+          }
+          break;
+        }
+
+        if (transpose)
+          x.at(col, r) = tmpVal;
+        else
+          x.at(r, col) = tmpVal;
         ++col;
+
+        if (tokenEnd == lineEnd)
+          break;
+        tokenStart = tokenEnd + 1;
       }
-      else
+
+      if (lineEnd == chunkEnd)
+        break;
+      lineStart = lineEnd + 1;
+      if (!lastChunk && lineStart == chunkEnd)
+        break;
+    }
+  }
+
+  row += blockRows;
+  return (failedRow == SIZE_MAX);
+}
+
+inline void LoadCSV::NumericCSVSize(std::fstream& f,
+                                    size_t& rows,
+                                    size_t& cols)
+{
+  rows = 0;
+  cols = 0;
+
+  // Count the lines until the first empty line (or the end of the file), and
+  // the maximum number of delimiters on any line.
+  std::vector<char> buffer(csvBlockSize);
+  size_t lineLength = 0;
+  size_t lineCols = 1;
+  while (f.good())
+  {
+    f.read(buffer.data(), csvBlockSize);
+    const size_t length = size_t(f.gcount());
+    for (size_t i = 0; i < length; ++i)
+    {
+      if (buffer[i] == '\n')
       {
-        // Printing failed token and it's location.
-        Log::Warn << "Failed to convert token " << token << ", at row " << row
-            << ", column " << col << " of matrix!";
+        if (lineLength == 0)
+          return; // An empty line ends the matrix.
 
-        return false;
+        ++rows;
+        cols = std::max(cols, lineCols);
+        lineLength = 0;
+        lineCols = 1;
+      }
+      else
+      {
+        ++lineLength;
+        if (buffer[i] == ',')
+          ++lineCols;
       }
     }
-    ++row;
   }
-  return loadOkay;
+
+  // The last line may not end with a newline.
+  if (lineLength > 0)
+  {
+    ++rows;
+    cols = std::max(cols, lineCols);
+  }
 }
 
 inline void LoadCSV::NumericMatSize(std::stringstream& lineStream,
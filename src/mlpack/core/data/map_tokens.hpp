@@ -0,0 +1,126 @@
+/**
+ * @file core/data/map_tokens.hpp
+ *
+ * MapTokens(), a utility function to map the string tokens of a dataset with a
+ * DatasetMapper in parallel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAP_TOKENS_HPP
+#define MLPACK_CORE_DATA_MAP_TOKENS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "dataset_mapper.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Map the tokens of the given dimensions of a dataset with the DatasetMapper,
+ * and store the results in the matrix.  `tokens` holds a view of the token of
+ * each element of the matrix, in the same (column-major) order as the matrix;
+ * the buffers the tokens point into must be kept alive by the caller.
+ *
+ * Instead of calling DatasetMapper::MapString() (and allocating a string) for
+ * every token, the mapping is done in three phases:
+ *
+ *  1. In parallel over the dimensions, the distinct tokens of each dimension
+ *     are found with a dictionary keyed by std::string_view, so that no token
+ *     is copied.
+ *  2. Serially, the distinct tokens of each dimension are passed to
+ *     MapFirstPass() (if `firstPass` is true), then to MapString(), in the
+ *     order of their first occurrence.  This gives the same mappings as
+ *     mapping every token in order, whatever the number of threads.
+ *  3. In parallel, every element of the matrix is set to the mapping of its
+ *     token.
+ *
+ * This assumes that the policy maps a given token of a given dimension to the
+ * same value every time, which is true for IncrementPolicy and MissingPolicy.
+ *
+ * `onNewMapping(dimension, point, token)` is called (in phase 2) for each
+ * distinct token that adds a mapping to the DatasetMapper, with the index of
+ * the first point where the token occurs.
+ *
+ * @param tokens Token of each element of the matrix.
+ * @param dimensions Dimensions (rows of the matrix) to map.
+ * @param firstPass Whether to call MapFirstPass() before MapString().
+ * @param matrix Matrix to store the mapped values in; it must have the right
+ *     size already.
+ * @param info DatasetMapper to use.
+ * @param onNewMapping Function called for each new mapping.
+ */
+template<typename eT, typename PolicyType, typename NewMappingFunction>
+void MapTokens(const std::vector<std::string_view>& tokens,
+               const std::vector<size_t>& dimensions,
+               const bool firstPass,
+               arma::Mat<eT>& matrix,
+               DatasetMapper<PolicyType>& info,
+               const NewMappingFunction& onNewMapping)
+{
+  const size_t numDims = dimensions.size();
+  const size_t rows = matrix.n_rows;
+  const size_t cols = matrix.n_cols;
+
+  // Phase 1: find the distinct tokens of each dimension, and the index of the
+  // distinct token of each point.
+  std::vector<std::vector<size_t>> firstPoints(numDims);
+  std::vector<std::vector<size_t>> tokenIndices(numDims);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t k = 0; k < numDims; ++k)
+  {
+    const size_t d = dimensions[k];
+    std::unordered_map<std::string_view, size_t> dictionary;
+    tokenIndices[k].resize(cols);
+    for (size_t j = 0; j < cols; ++j)
+    {
+      const auto result = dictionary.emplace(tokens[d + j * rows],
+          firstPoints[k].size());
+      if (result.second)
+        firstPoints[k].push_back(j);
+      tokenIndices[k][j] = result.first->second;
+    }
+  }
+
+  // Phase 2: map the distinct tokens, in order.
+  std::vector<std::vector<eT>> values(numDims);
+  if (firstPass)
+  {
+    for (size_t k = 0; k < numDims; ++k)
+    {
+      const size_t d = dimensions[k];
+      for (const size_t j : firstPoints[k])
+        info.template MapFirstPass<eT>(std::string(tokens[d + j * rows]), d);
+    }
+  }
+
+  for (size_t k = 0; k < numDims; ++k)
+  {
+    const size_t d = dimensions[k];
+    values[k].resize(firstPoints[k].size());
+    for (size_t u = 0; u < firstPoints[k].size(); ++u)
+    {
+      const size_t j = firstPoints[k][u];
+      const std::string_view token = tokens[d + j * rows];
+      const size_t numMappings = info.NumMappings(d);
+      values[k][u] = info.template MapString<eT>(std::string(token), d);
+      if (info.NumMappings(d) > numMappings)
+        onNewMapping(d, j, token);
+    }
+  }
+
+  // Phase 3: store the mappings of every point.
+  #pragma omp parallel for schedule(static)
+  for (size_t j = 0; j < cols; ++j)
+  {
+    for (size_t k = 0; k < numDims; ++k)
+      matrix(dimensions[k], j) = values[k][tokenIndices[k][j]];
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,157 @@
+/**
+ * @file core/data/mapped_matrix.hpp
+ *
+ * Definition of the MappedMatrix class, which gives access to a dataset saved
+ * in mlpack's memory-mappable binary format without reading it into memory,
+ * and of the functions that save and load that format.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAPPED_MATRIX_HPP
+#define MLPACK_CORE_DATA_MAPPED_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "dataset_mapper.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A MappedMatrix gives read-only access to a dense matrix saved with
+ * SaveMapped(), along with the DatasetInfo that was saved with it.  The file
+ * stores the points column by column, exactly as they are stored in memory, so
+ * instead of being read, it is mapped into memory with mmap(), and Matrix()
+ * is an arma::Mat that uses the mapped pages as its (fixed-size) memory.
+ *
+ * Opening a file thus takes constant time, whatever the size of the dataset;
+ * the pages are read by the operating system only when they are accessed, can
+ * be evicted under memory pressure, and are shared by all the processes that
+ * map the same file.  On platforms without mmap() (Windows), the data is read
+ * into memory instead.
+ *
+ * The matrix is only valid while the MappedMatrix is open, and must not be
+ * modified: the mapping is read-only.  Copy it (e.g. `arma::mat m =
+ * mapped.Matrix();`) to get a modifiable matrix.
+ *
+ * @code
+ * // Once:
+ * data::SaveMapped("dataset.mlm", dataset, info);
+ *
+ * // Then, in any number of processes:
+ * data::MappedMatrix<double> mapped("dataset.mlm");
+ * const arma::mat& data = mapped.Matrix();
+ * @endcode
+ *
+ * @tparam eT Element type of the matrix; it must be the type it was saved
+ *     with.
+ */
+template<typename eT>
+class MappedMatrix
+{
+ public:
+  /**
+   * Create an empty MappedMatrix; use Open() or data::Load() to map a file.
+   */
+  MappedMatrix();
+
+  /**
+   * Map the given file.  A std::runtime_error is thrown if the file cannot be
+   * mapped, is not in the mapped format, or does not hold elements of type eT.
+   *
+   * @param filename Name of the file to map.
+   */
+  MappedMatrix(const std::string& filename);
+
+  //! The mapping cannot be shared between objects.
+  MappedMatrix(const MappedMatrix& other) = delete;
+  //! The mapping cannot be shared between objects.
+  MappedMatrix& operator=(const MappedMatrix& other) = delete;
+
+  //! Unmap the file.
+  ~MappedMatrix();
+
+  /**
+   * Map the given file, unmapping the previous one if any.  A
+   * std::runtime_error is thrown if the file cannot be mapped, is not in the
+   * mapped format, or does not hold elements of type eT; the object is then
+   * empty.
+   *
+   * @param filename Name of the file to map.
+   */
+  void Open(const std::string& filename);
+
+  //! Unmap the file; the matrix becomes empty.
+  void Close();
+
+  //! Get the matrix, whose memory is the mapped file.
+  const arma::Mat<eT>& Matrix() const { return matrix; }
+  //! Get the DatasetInfo saved with the matrix.
+  const DatasetInfo& Info() const { return info; }
+  //! Return whether the matrix uses the memory of a mapped file.
+  bool IsMapped() const { return mapping != nullptr; }
+
+ private:
+  //! Make the matrix an alias of the given memory.
+  void Alias(eT* memory, const size_t rows, const size_t cols);
+
+  //! The matrix.
+  arma::Mat<eT> matrix;
+  //! The DatasetInfo of the matrix.
+  DatasetInfo info;
+  //! Start of the mapping of the file (nullptr if nothing is mapped).
+  void* mapping;
+  //! Size of the mapping, in bytes.
+  size_t mappingSize;
+};
+
+/**
+ * Save the given matrix in mlpack's memory-mappable binary format, along with
+ * the given DatasetInfo, so that it can be opened with a MappedMatrix.  The
+ * file holds a small header (dimensions, element type, categorical mappings)
+ * followed by the points, column by column; it is not transposed.  The file
+ * can only be mapped on a platform with the same byte order.
+ *
+ * If the parameter 'fatal' is set to true, a std::runtime_error exception will
+ * be thrown if the matrix cannot be saved.
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Matrix to save.
+ * @param info DatasetInfo of the matrix; it must be empty or have the
+ *     dimensionality of the matrix.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of save.
+ */
+template<typename eT>
+bool SaveMapped(const std::string& filename,
+                const arma::Mat<eT>& matrix,
+                const DatasetInfo& info = DatasetInfo(),
+                const bool fatal = false);
+
+/**
+ * Load a matrix saved with SaveMapped() by mapping the file into memory: the
+ * matrix given by `matrix.Matrix()` uses the mapped file as its memory, so no
+ * data is copied.  See MappedMatrix.
+ *
+ * If the parameter 'fatal' is set to true, a std::runtime_error exception will
+ * be thrown if the file cannot be mapped.
+ *
+ * @param filename Name of file to load.
+ * @param matrix MappedMatrix to map the file with.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool Load(const std::string& filename,
+          MappedMatrix<eT>& matrix,
+          const bool fatal = false);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "mapped_matrix_impl.hpp"
+
+#endif
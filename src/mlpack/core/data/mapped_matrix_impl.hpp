@@ -0,0 +1,433 @@
+/**
+ * @file core/data/mapped_matrix_impl.hpp
+ *
+ * Implementation of the MappedMatrix class, SaveMapped(), and the corresponding
+ * Load() overload.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAPPED_MATRIX_IMPL_HPP
+#define MLPACK_CORE_DATA_MAPPED_MATRIX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mapped_matrix.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+/**
+ * A mapped matrix file starts with the magic string, followed by the fixed
+ * fields of the header (byte order marker, version, element kind, element
+ * size, number of rows, number of columns, offset of the data), each stored as
+ * a 64-bit integer.  Then, for each dimension, come its type (0 for numeric, 1
+ * for categorical), its number of mappings, and the strings mapped to 0, 1,
+ * ..., each stored as its length and its characters.  The data starts at the
+ * next multiple of MappedAlignment, so that it is aligned on a page boundary
+ * in the mapping.
+ */
+constexpr char MappedMagic[9] = "MLPKMMAT";
+constexpr size_t MappedHeaderSize = 8 + 7 * sizeof(uint64_t);
+constexpr size_t MappedAlignment = 4096;
+constexpr uint64_t MappedByteOrder = 0x0102030405060708ULL;
+constexpr uint64_t MappedVersion = 1;
+
+//! Get the code of the kind of elements of type eT (floating point, signed or
+//! unsigned integer).
+template<typename eT>
+constexpr uint64_t MappedElemKind()
+{
+  return std::is_floating_point<eT>::value ? 'f' :
+      (std::is_signed<eT>::value ? 'i' : 'u');
+}
+
+//! Append the given value to the header.
+inline void AppendMappedValue(std::string& header, const uint64_t value)
+{
+  header.append(reinterpret_cast<const char*>(&value), sizeof(uint64_t));
+}
+
+//! Read a value of the header, if there are enough bytes left.
+inline bool ReadMappedValue(const char* header,
+                            const size_t headerSize,
+                            size_t& position,
+                            uint64_t& value)
+{
+  if (headerSize - position < sizeof(uint64_t))
+    return false;
+
+  std::memcpy(&value, header + position, sizeof(uint64_t));
+  position += sizeof(uint64_t);
+  return true;
+}
+
+/**
+ * Parse the header of a mapped matrix file of the given size, whose first
+ * headerSize bytes are given, and check that it holds elements of type eT.  A
+ * std::runtime_error is thrown if the header is invalid.
+ */
+template<typename eT>
+void ReadMappedHeader(const char* header,
+                      const size_t headerSize,
+                      const size_t fileSize,
+                      const std::string& filename,
+                      size_t& rows,
+                      size_t& cols,
+                      size_t& dataOffset,
+                      DatasetInfo& info)
+{
+  const std::string invalid = "'" + filename + "' is not a valid mapped "
+      "matrix file";
+  if (headerSize < MappedHeaderSize ||
+      std::memcmp(header, MappedMagic, 8) != 0)
+    throw std::runtime_error(invalid);
+
+  size_t position = 8;
+  uint64_t byteOrder, version, elemKind, elemSize, r, c, offset;
+  ReadMappedValue(header, headerSize, position, byteOrder);
+  ReadMappedValue(header, headerSize, position, version);
+  ReadMappedValue(header, headerSize, position, elemKind);
+  ReadMappedValue(header, headerSize, position, elemSize);
+  ReadMappedValue(header, headerSize, position, r);
+  ReadMappedValue(header, headerSize, position, c);
+  ReadMappedValue(header, headerSize, position, offset);
+
+  if (byteOrder != MappedByteOrder)
+  {
+    throw std::runtime_error("'" + filename + "' was saved on a platform with "
+        "a different byte order");
+  }
+
+  if (version != MappedVersion)
+  {
+    throw std::runtime_error("'" + filename + "' was saved with an "
+        "unsupported version of the mapped matrix format");
+  }
+
+  if (elemKind != MappedElemKind<eT>() || elemSize != sizeof(eT))
+  {
+    throw std::runtime_error("'" + filename + "' holds elements of a "
+        "different type than the requested matrix");
+  }
+
+  // Make sure that the data is in the file; the product of the dimensions is
+  // not computed directly, because it could overflow.
+  if (offset < MappedHeaderSize || offset > fileSize)
+    throw std::runtime_error(invalid);
+  const uint64_t available = (fileSize - offset) / sizeof(eT);
+  if (r != 0 && (r > available || c > available / r))
+    throw std::runtime_error(invalid);
+
+  rows = (size_t) r;
+  cols = (size_t) c;
+  dataOffset = (size_t) offset;
+
+  // Now read the mappings of each dimension.
+  const size_t mappingsEnd = std::min(headerSize, dataOffset);
+  info = DatasetInfo(rows);
+  for (size_t d = 0; d < rows; ++d)
+  {
+    uint64_t type, numMappings;
+    if (!ReadMappedValue(header, mappingsEnd, position, type) ||
+        !ReadMappedValue(header, mappingsEnd, position, numMappings))
+      throw std::runtime_error(invalid);
+
+    if (type == 1)
+      info.Type(d) = Datatype::categorical;
+
+    for (uint64_t i = 0; i < numMappings; ++i)
+    {
+      uint64_t length;
+      if (!ReadMappedValue(header, mappingsEnd, position, length) ||
+          length > mappingsEnd - position)
+        throw std::runtime_error(invalid);
+
+      info.template MapString<size_t>(std::string(header + position, length),
+          d);
+      position += length;
+    }
+  }
+}
+
+} // namespace details
+
+template<typename eT>
+MappedMatrix<eT>::MappedMatrix() :
+    mapping(nullptr),
+    mappingSize(0)
+{
+  // Nothing to do.
+}
+
+template<typename eT>
+MappedMatrix<eT>::MappedMatrix(const std::string& filename) :
+    mapping(nullptr),
+    mappingSize(0)
+{
+  Open(filename);
+}
+
+template<typename eT>
+MappedMatrix<eT>::~MappedMatrix()
+{
+  Close();
+}
+
+template<typename eT>
+void MappedMatrix<eT>::Open(const std::string& filename)
+{
+  Close();
+
+  size_t rows, cols, dataOffset;
+#ifndef _WIN32
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("Cannot open file '" + filename + "'");
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 ||
+      (size_t) fileStat.st_size < details::MappedHeaderSize)
+  {
+    close(fd);
+    throw std::runtime_error("'" + filename + "' is not a valid mapped matrix "
+        "file");
+  }
+
+  // The mapping stays valid once the file is closed.
+  const size_t fileSize = (size_t) fileStat.st_size;
+  void* newMapping = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (newMapping == MAP_FAILED)
+    throw std::runtime_error("Cannot map file '" + filename + "'");
+
+  mapping = newMapping;
+  mappingSize = fileSize;
+
+  try
+  {
+    details::ReadMappedHeader<eT>((const char*) mapping, fileSize, fileSize,
+        filename, rows, cols, dataOffset, info);
+  }
+  catch (const std::runtime_error&)
+  {
+    Close();
+    throw;
+  }
+
+  // The mapping is read-only, but Armadillo needs a non-const pointer; the
+  // matrix is only given out as const.
+  Alias(reinterpret_cast<eT*>((char*) mapping + dataOffset), rows, cols);
+#else
+  // Without mmap(), the data has to be read.
+  std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!stream.is_open())
+    throw std::runtime_error("Cannot open file '" + filename + "'");
+
+  stream.seekg(0, std::ios::end);
+  const size_t fileSize = (size_t) stream.tellg();
+  stream.seekg(0, std::ios::beg);
+
+  // Read the fixed part of the header to find where the data starts, then the
+  // whole header.
+  std::string header(details::MappedHeaderSize, '\0');
+  stream.read(&header[0], header.size());
+  uint64_t offset = 0;
+  if (stream.good())
+    std::memcpy(&offset, &header[header.size() - sizeof(uint64_t)],
+        sizeof(uint64_t));
+  if (offset < details::MappedHeaderSize || offset > fileSize)
+  {
+    throw std::runtime_error("'" + filename + "' is not a valid mapped matrix "
+        "file");
+  }
+
+  header.resize(offset);
+  stream.read(&header[details::MappedHeaderSize],
+      offset - details::MappedHeaderSize);
+  details::ReadMappedHeader<eT>(header.data(), header.size(), fileSize,
+      filename, rows, cols, dataOffset, info);
+
+  matrix.set_size(rows, cols);
+  stream.read(reinterpret_cast<char*>(matrix.memptr()),
+      matrix.n_elem * sizeof(eT));
+  if (!stream.good())
+  {
+    Close();
+    throw std::runtime_error("Cannot read file '" + filename + "'");
+  }
+#endif
+}
+
+template<typename eT>
+void MappedMatrix<eT>::Close()
+{
+  // The matrix must not use the mapping anymore.
+  Alias(nullptr, 0, 0);
+  info = DatasetInfo();
+
+#ifndef _WIN32
+  if (mapping != nullptr)
+    munmap(mapping, mappingSize);
+#endif
+
+  mapping = nullptr;
+  mappingSize = 0;
+}
+
+template<typename eT>
+void MappedMatrix<eT>::Alias(eT* memory, const size_t rows, const size_t cols)
+{
+  // We use placement new to reinitialize the object, since the copy and move
+  // assignment operators in Armadillo will end up copying memory instead of
+  // making an alias.
+  using MatType = arma::Mat<eT>;
+  matrix.~MatType();
+  if (memory == nullptr)
+    new (&matrix) MatType();
+  else
+    new (&matrix) MatType(memory, rows, cols, false, true);
+}
+
+template<typename eT>
+bool SaveMapped(const std::string& filename,
+                const arma::Mat<eT>& matrix,
+                const DatasetInfo& info,
+                const bool fatal)
+{
+  Timer::Start("saving_data");
+
+  if (info.Dimensionality() != 0 && info.Dimensionality() != matrix.n_rows)
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << "SaveMapped(): the DatasetInfo has dimensionality "
+          << info.Dimensionality() << ", but the matrix has " << matrix.n_rows
+          << " rows." << std::endl;
+    else
+      Log::Warn << "SaveMapped(): the DatasetInfo has dimensionality "
+          << info.Dimensionality() << ", but the matrix has " << matrix.n_rows
+          << " rows; save failed." << std::endl;
+
+    return false;
+  }
+
+  // Build the mappings part of the header first, to know where the data
+  // starts.
+  std::string mappings;
+  for (size_t d = 0; d < matrix.n_rows; ++d)
+  {
+    if (info.Dimensionality() == 0)
+    {
+      details::AppendMappedValue(mappings, 0);
+      details::AppendMappedValue(mappings, 0);
+      continue;
+    }
+
+    details::AppendMappedValue(mappings,
+        (info.Type(d) == Datatype::categorical) ? 1 : 0);
+    details::AppendMappedValue(mappings, info.NumMappings(d));
+    for (size_t i = 0; i < info.NumMappings(d); ++i)
+    {
+      const std::string& mapping = info.UnmapString(i, d);
+      details::AppendMappedValue(mappings, mapping.size());
+      mappings.append(mapping);
+    }
+  }
+
+  const size_t headerSize = details::MappedHeaderSize + mappings.size();
+  const size_t dataOffset = ((headerSize + details::MappedAlignment - 1) /
+      details::MappedAlignment) * details::MappedAlignment;
+
+  std::string header(details::MappedMagic, 8);
+  details::AppendMappedValue(header, details::MappedByteOrder);
+  details::AppendMappedValue(header, details::MappedVersion);
+  details::AppendMappedValue(header, details::MappedElemKind<eT>());
+  details::AppendMappedValue(header, sizeof(eT));
+  details::AppendMappedValue(header, matrix.n_rows);
+  details::AppendMappedValue(header, matrix.n_cols);
+  details::AppendMappedValue(header, dataOffset);
+  header.append(mappings);
+  header.resize(dataOffset, '\0');
+
+  std::ofstream stream(filename.c_str(), std::ios::out | std::ios::binary |
+      std::ios::trunc);
+  if (!stream.is_open())
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "' for writing. "
+          << "Save failed." << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "' for writing; save "
+          << "failed." << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Saving mapped matrix to '" << filename << "'." << std::endl;
+
+  stream.write(header.data(), header.size());
+  stream.write(reinterpret_cast<const char*>(matrix.memptr()),
+      matrix.n_elem * sizeof(eT));
+  if (!stream.good())
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << "Save to '" << filename << "' failed." << std::endl;
+    else
+      Log::Warn << "Save to '" << filename << "' failed." << std::endl;
+
+    return false;
+  }
+
+  Timer::Stop("saving_data");
+  return true;
+}
+
+template<typename eT>
+bool Load(const std::string& filename,
+          MappedMatrix<eT>& matrix,
+          const bool fatal)
+{
+  Timer::Start("loading_data");
+
+  try
+  {
+    matrix.Open(filename);
+  }
+  catch (const std::runtime_error& e)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << e.what() << "; load failed." << std::endl;
+    else
+      Log::Warn << e.what() << "; load failed." << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Mapped '" << filename << "'.  Size is "
+      << matrix.Matrix().n_rows << " x " << matrix.Matrix().n_cols << ".\n";
+
+  Timer::Stop("loading_data");
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * @file core/data/one_hot_encoder.hpp
+ *
+ * Definition of the OneHotEncoder class, which one-hot encodes the categorical
+ * dimensions of a dataset batch by batch.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_ONE_HOT_ENCODER_HPP
+#define MLPACK_CORE_DATA_ONE_HOT_ENCODER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "dataset_mapper.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The OneHotEncoder class one-hot encodes some dimensions of a dataset: each
+ * encoded dimension with k categories is replaced by k binary dimensions, and
+ * the other dimensions are copied.  The layout of the output (the categories
+ * of each encoded dimension) is fixed before any point is encoded, so batches
+ * of points can be encoded independently, on demand, and directly into sparse
+ * matrices, without ever holding the whole encoded dataset in memory.
+ *
+ * The categories are either given by a DatasetInfo (the categories of a
+ * dimension marked `Datatype::categorical` are the values 0, ..., k - 1, where
+ * k is the number of mappings of the dimension), or learned from the data by
+ * one or more calls to Fit(), in order of first appearance.
+ *
+ * @code
+ * data::DatasetInfo info;
+ * arma::mat data;
+ * data::Load("dataset.arff", data, info);
+ *
+ * data::OneHotEncoder<> encoder(info);
+ * arma::sp_mat encoded;
+ * for (size_t i = 0; i < data.n_cols; i += 10000)
+ * {
+ *   const size_t last = std::min(i + 10000, (size_t) data.n_cols) - 1;
+ *   encoder.Transform(data.cols(i, last), encoded);
+ *   // Use the encoded points.
+ * }
+ * @endcode
+ *
+ * @tparam eT Element type of the data.
+ */
+template<typename eT = double>
+class OneHotEncoder
+{
+ public:
+  /**
+   * Create an encoder that encodes the given dimensions; their categories must
+   * then be learned with Fit().
+   *
+   * @param indices Dimensions to one-hot encode.
+   */
+  OneHotEncoder(const arma::Col<size_t>& indices = arma::Col<size_t>());
+
+  /**
+   * Create an encoder that encodes the dimensions marked as categorical in the
+   * given DatasetInfo, with the categories given by their mappings.  Fit() may
+   * still be called to add categories.
+   *
+   * @param datasetInfo DatasetInfo object that has information about the data.
+   */
+  OneHotEncoder(const DatasetInfo& datasetInfo);
+
+  /**
+   * Add the categories found in the given batch of points to the categories
+   * of the encoded dimensions.  New categories are appended, in order of first
+   * appearance, so the encoding of the categories seen before does not change.
+   * A std::invalid_argument is thrown if the dimensionality of the batch does
+   * not match the previous batches.
+   *
+   * @param batch Batch of points (one per column).
+   */
+  void Fit(const arma::Mat<eT>& batch);
+
+  /**
+   * One-hot encode the given batch of points, in parallel over the points if
+   * OpenMP is available.  With sparse output, only the nonzero values are
+   * stored, and the matrix is built at once.  A std::invalid_argument is thrown
+   * if a point has a category that the encoder does not know, or if the
+   * dimensionality of the batch is wrong.
+   *
+   * @tparam MatType Type of the output (arma::Mat<eT> or arma::SpMat<eT>).
+   * @param batch Batch of points to encode (one per column).
+   * @param output Encoded points.
+   */
+  template<typename MatType>
+  void Transform(const arma::Mat<eT>& batch, MatType& output) const;
+
+  //! Get the dimensionality of the points to encode (0 before the first Fit()
+  //! if no DatasetInfo was given).
+  size_t InputDimensionality() const { return isEncoded.size(); }
+  //! Get the dimensionality of the encoded points.
+  size_t OutputDimensionality() const { return outputDimensionality; }
+  //! Get the number of categories of the given dimension (1 if the dimension
+  //! is not encoded).
+  size_t NumCategories(const size_t dimension) const;
+  //! Get the first dimension of the encoding of the given input dimension.
+  size_t Offset(const size_t dimension) const { return offsets[dimension]; }
+
+  //! Serialize the encoder.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Set the dimensionality of the points, and which dimensions are encoded.
+  void Initialize(const size_t dimensionality);
+  //! Compute the offsets of the input dimensions in the encoded points.
+  void ComputeOffsets();
+
+  //! Dimensions to one-hot encode.
+  arma::Col<size_t> indices;
+  //! For each input dimension, whether it is encoded.
+  std::vector<bool> isEncoded;
+  //! For each input dimension, the index of each of its categories.
+  std::vector<std::unordered_map<eT, size_t>> categories;
+  //! For each input dimension, its first dimension in the encoded points.
+  std::vector<size_t> offsets;
+  //! Dimensionality of the encoded points.
+  size_t outputDimensionality;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "one_hot_encoder_impl.hpp"
+
+#endif
@@ -0,0 +1,241 @@
+/**
+ * @file core/data/one_hot_encoder_impl.hpp
+ *
+ * Implementation of the OneHotEncoder class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_ONE_HOT_ENCODER_IMPL_HPP
+#define MLPACK_CORE_DATA_ONE_HOT_ENCODER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "one_hot_encoder.hpp"
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+OneHotEncoder<eT>::OneHotEncoder(const arma::Col<size_t>& indices) :
+    indices(indices),
+    outputDimensionality(0)
+{
+  // Nothing to do: the dimensionality is set by the first call to Fit().
+}
+
+template<typename eT>
+OneHotEncoder<eT>::OneHotEncoder(const DatasetInfo& datasetInfo) :
+    outputDimensionality(0)
+{
+  std::vector<size_t> categoricalDimensions;
+  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
+    if (datasetInfo.Type(i) == Datatype::categorical)
+      categoricalDimensions.push_back(i);
+  indices = arma::Col<size_t>(categoricalDimensions);
+
+  Initialize(datasetInfo.Dimensionality());
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    const size_t d = indices[i];
+    for (size_t c = 0; c < datasetInfo.NumMappings(d); ++c)
+      categories[d][eT(c)] = c;
+  }
+
+  ComputeOffsets();
+}
+
+template<typename eT>
+void OneHotEncoder<eT>::Fit(const arma::Mat<eT>& batch)
+{
+  if (isEncoded.empty())
+    Initialize(batch.n_rows);
+
+  if (batch.n_rows != isEncoded.size())
+  {
+    std::ostringstream oss;
+    oss << "OneHotEncoder::Fit(): the batch has " << batch.n_rows
+        << " dimensions, but " << isEncoded.size() << " were expected";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Categories are numbered in order of first appearance, point by point.
+  for (size_t col = 0; col < batch.n_cols; ++col)
+  {
+    for (size_t i = 0; i < indices.n_elem; ++i)
+    {
+      std::unordered_map<eT, size_t>& map = categories[indices[i]];
+      map.emplace(batch(indices[i], col), map.size());
+    }
+  }
+
+  ComputeOffsets();
+}
+
+template<typename eT>
+template<typename MatType>
+void OneHotEncoder<eT>::Transform(const arma::Mat<eT>& batch,
+                                  MatType& output) const
+{
+  if (batch.n_rows != isEncoded.size())
+  {
+    std::ostringstream oss;
+    oss << "OneHotEncoder::Transform(): the batch has " << batch.n_rows
+        << " dimensions, but " << isEncoded.size() << " were expected";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // An exception cannot leave an OpenMP loop, so unknown categories are
+  // recorded and reported after the loop.
+  bool unknownCategory = false;
+
+  if constexpr (arma::is_SpMat<MatType>::value)
+  {
+    // Count the nonzero values of each encoded point, so that each point can
+    // be written independently.
+    arma::Col<size_t> columnOffsets(batch.n_cols + 1);
+    columnOffsets[0] = 0;
+    for (size_t col = 0; col < batch.n_cols; ++col)
+    {
+      size_t nonzeros = 0;
+      for (size_t row = 0; row < batch.n_rows; ++row)
+        if (isEncoded[row] || batch(row, col) != eT(0))
+          ++nonzeros;
+      columnOffsets[col + 1] = columnOffsets[col] + nonzeros;
+    }
+
+    arma::umat locations(2, columnOffsets[batch.n_cols]);
+    arma::Col<eT> values(columnOffsets[batch.n_cols]);
+
+    #pragma omp parallel for schedule(static)
+    for (size_t col = 0; col < batch.n_cols; ++col)
+    {
+      size_t n = columnOffsets[col];
+      for (size_t row = 0; row < batch.n_rows; ++row)
+      {
+        const eT value = batch(row, col);
+        if (isEncoded[row])
+        {
+          const auto it = categories[row].find(value);
+          if (it == categories[row].end())
+          {
+            #pragma omp atomic write
+            unknownCategory = true;
+          }
+
+          locations(0, n) = offsets[row] +
+              ((it == categories[row].end()) ? 0 : it->second);
+          values[n] = eT(1);
+        }
+        else if (value != eT(0))
+        {
+          locations(0, n) = offsets[row];
+          values[n] = value;
+        }
+        else
+        {
+          continue;
+        }
+
+        locations(1, n) = col;
+        ++n;
+      }
+    }
+
+    if (!unknownCategory)
+      output = MatType(locations, values, outputDimensionality, batch.n_cols);
+  }
+  else
+  {
+    output.zeros(outputDimensionality, batch.n_cols);
+
+    #pragma omp parallel for schedule(static)
+    for (size_t col = 0; col < batch.n_cols; ++col)
+    {
+      for (size_t row = 0; row < batch.n_rows; ++row)
+      {
+        const eT value = batch(row, col);
+        if (isEncoded[row])
+        {
+          const auto it = categories[row].find(value);
+          if (it == categories[row].end())
+          {
+            #pragma omp atomic write
+            unknownCategory = true;
+          }
+          else
+          {
+            output(offsets[row] + it->second, col) = eT(1);
+          }
+        }
+        else
+        {
+          output(offsets[row], col) = value;
+        }
+      }
+    }
+  }
+
+  if (unknownCategory)
+  {
+    throw std::invalid_argument("OneHotEncoder::Transform(): the batch contains "
+        "a category that was not seen by Fit()");
+  }
+}
+
+template<typename eT>
+size_t OneHotEncoder<eT>::NumCategories(const size_t dimension) const
+{
+  return isEncoded[dimension] ? categories[dimension].size() : 1;
+}
+
+template<typename eT>
+template<typename Archive>
+void OneHotEncoder<eT>::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(indices));
+  ar(CEREAL_NVP(isEncoded));
+  ar(CEREAL_NVP(categories));
+  ar(CEREAL_NVP(offsets));
+  ar(CEREAL_NVP(outputDimensionality));
+}
+
+template<typename eT>
+void OneHotEncoder<eT>::Initialize(const size_t dimensionality)
+{
+  isEncoded.assign(dimensionality, false);
+  categories.clear();
+  categories.resize(dimensionality);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    if (indices[i] >= dimensionality)
+    {
+      std::ostringstream oss;
+      oss << "OneHotEncoder: cannot encode dimension " << indices[i]
+          << " of " << dimensionality << "-dimensional points";
+      throw std::invalid_argument(oss.str());
+    }
+
+    isEncoded[indices[i]] = true;
+  }
+
+  ComputeOffsets();
+}
+
+template<typename eT>
+void OneHotEncoder<eT>::ComputeOffsets()
+{
+  offsets.resize(isEncoded.size());
+  outputDimensionality = 0;
+  for (size_t d = 0; d < isEncoded.size(); ++d)
+  {
+    offsets[d] = outputDimensionality;
+    outputDimensionality += NumCategories(d);
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
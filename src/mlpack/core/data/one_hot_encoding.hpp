@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core.hpp>
+#include "one_hot_encoder.hpp"
 
 namespace mlpack {
 namespace data {
@@ -47,6 +48,19 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     const arma::Col<size_t>& indices,
                     arma::Mat<eT>& output);
 
+/**
+ * Overloaded function for the above function, which writes the encoded matrix
+ * directly into a sparse matrix.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded sparse matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output);
+
 /**
  * Overloaded function for the above function, which takes a matrix as input
  * and also a DatasetInfo object and outputs a matrix.
@@ -62,6 +76,22 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     arma::Mat<eT>& output,
                     const data::DatasetInfo& datasetInfo);
 
+/**
+ * Overloaded function for the above function, which writes the encoded matrix
+ * directly into a sparse matrix; this avoids allocating the dense encoded
+ * matrix when the categorical dimensions have many categories.  Only the
+ * nonzero values of the input (and the ones of the encoded dimensions) are
+ * stored.  To encode a large dataset batch by batch, use OneHotEncoder.
+ *
+ * @param input Input dataset to be encoded.
+ * @param output Encoded sparse matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo);
+
 } // namespace data
 } // namespace mlpack
 
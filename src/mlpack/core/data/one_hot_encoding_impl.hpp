@@ -55,12 +55,28 @@ void OneHotEncoding(const RowType& labelsIn,
       ++curLabel;
     }
   }
-  // Resize output matrix to necessary size, and fill it with zeros.
-  output.zeros(curLabel, labelsIn.n_elem);
-  // Fill ones in at the required places.
-  for (size_t i = 0; i < labelsIn.n_elem; ++i)
+  if constexpr (arma::is_SpMat<MatType>::value)
   {
-    output(labels[i], i) = 1;
+    // Build the sparse matrix at once, instead of inserting the ones one by
+    // one.
+    arma::umat locations(2, labelsIn.n_elem);
+    for (size_t i = 0; i < labelsIn.n_elem; ++i)
+    {
+      locations(0, i) = labels[i];
+      locations(1, i) = i;
+    }
+    output = MatType(locations, arma::Col<typename MatType::elem_type>(
+        labelsIn.n_elem, arma::fill::ones), curLabel, labelsIn.n_elem);
+  }
+  else
+  {
+    // Resize output matrix to necessary size, and fill it with zeros.
+    output.zeros(curLabel, labelsIn.n_elem);
+    // Fill ones in at the required places.
+    for (size_t i = 0; i < labelsIn.n_elem; ++i)
+    {
+      output(labels[i], i) = 1;
+    }
   }
   labelMap.clear();
 }
@@ -86,61 +102,29 @@ void OneHotEncoding(const arma::Mat<eT>& input,
     return;
   }
 
-  // First, we need to compute the size of the output matrix.
-
-  // This vector will eventually hold the offsets for each dimension in the
-  // one-hot encoded matrix, but first it will just hold the counts of
-  // dimensions for each dimension.
-  arma::Col<size_t> dimensionOffsets(input.n_rows, arma::fill::ones);
-  // This will hold the mappings from a value that should be one-hot encoded to
-  // the index of the dimension it should take.
-  std::unordered_map<size_t, std::unordered_map<eT, size_t>> mappings;
-  for (size_t i = 0; i < indices.n_elem; ++i)
-  {
-    dimensionOffsets[indices[i]] = 0;
-    mappings.insert(
-        std::make_pair(indices[i], std::unordered_map<eT, size_t>()));
-  }
-
-  for (size_t col = 0; col < input.n_cols; ++col)
-  {
-    for (size_t row = 0; row < input.n_rows; ++row)
-    {
-      if (mappings.count(row) != 0)
-      {
-        // We have to one-hot encode this point.
-        if (mappings[row].count(input(row, col)) == 0)
-          mappings[row][input(row, col)] = dimensionOffsets[row]++;
-      }
-    }
-  }
-
-  // Turn the dimension counts into offsets.  Note that the last element is the
-  // total number of dimensions, and the first element is the offset for
-  // dimension *2* (not 1).
-  for (size_t i = 1; i < dimensionOffsets.n_elem; ++i)
-    dimensionOffsets[i] += dimensionOffsets[i - 1];
-
-  // Now, initialize the output matrix to the right size.
-  output.zeros(dimensionOffsets[dimensionOffsets.n_elem - 1], input.n_cols);
+  // The categories of each dimension are numbered in order of first
+  // appearance.
+  OneHotEncoder<eT> encoder(indices);
+  encoder.Fit(input);
+  encoder.Transform(input, output);
+}
 
-  // Finally, one-hot encode the matrix.
-  for (size_t col = 0; col < input.n_cols; ++col)
-  {
-    for (size_t row = 0; row < input.n_rows; ++row)
-    {
-      const size_t dimOffset = (row == 0) ? 0 : dimensionOffsets[row - 1];
-      if (mappings.count(row) != 0)
-      {
-        output(dimOffset + mappings[row][input(row, col)], col) = eT(1);
-      }
-      else
-      {
-        // No need for one-hot encoding.
-        output(dimOffset, col) = input(row, col);
-      }
-    }
-  }
+/**
+ * Overloaded function for the above function, which writes the encoded matrix
+ * directly into a sparse matrix.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded sparse matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output)
+{
+  OneHotEncoder<eT> encoder(indices);
+  encoder.Fit(input);
+  encoder.Transform(input, output);
 }
 
 /**
@@ -169,6 +153,30 @@ void OneHotEncoding(const arma::Mat<eT>& input,
   OneHotEncoding(input, arma::Col<size_t>(indices), output);
 }
 
+/**
+ * Overloaded function for the above function, which writes the encoded matrix
+ * directly into a sparse matrix.
+ *
+ * @param input Input dataset to be encoded.
+ * @param output Encoded sparse matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo)
+{
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
+  {
+    if (datasetInfo.Type(i) == data::Datatype::categorical)
+    {
+      indices.push_back(i);
+    }
+  }
+  OneHotEncoding(input, arma::Col<size_t>(indices), output);
+}
+
 } // namespace data
 } // namespace mlpack
 
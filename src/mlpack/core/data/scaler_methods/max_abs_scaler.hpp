@@ -47,15 +47,43 @@ class MaxAbsScaler
 {
  public:
   /**
-   * Function to fit features, to find out the min max and scale.
+   * Function to fit features, to find out the min max and scale.  This forgets
+   * any data given to earlier calls to Fit() or PartialFit().
    *
    * @param input Dataset to fit.
    */
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMin = min(input, 1);
-    itemMax = arma::max(input, 1);
+    itemMin.reset();
+    itemMax.reset();
+    PartialFit(input);
+  }
+
+  /**
+   * Update the minimum and maximum of the features with the given batch of
+   * points, so that a dataset that does not fit in memory can be fitted one
+   * batch at a time.
+   *
+   * @param input Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    if (itemMin.is_empty())
+    {
+      itemMin = arma::min(input, 1);
+      itemMax = arma::max(input, 1);
+    }
+    else
+    {
+      itemMin = arma::min(itemMin, arma::vec(arma::min(input, 1)));
+      itemMax = arma::max(itemMax, arma::vec(arma::max(input, 1)));
+    }
+
     scale = arma::max(arma::abs(itemMin), arma::abs(itemMax));
     // Handling zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -70,14 +98,32 @@ class MaxAbsScaler
    */
   template<typename MatType>
   void Transform(const MatType& input, MatType& output)
+  {
+    output = input;
+    Transform(output);
+  }
+
+  /**
+   * Function to scale features in place, in parallel over the points.
+   *
+   * @param data Dataset to scale features of.
+   */
+  template<typename MatType>
+  void Transform(MatType& data)
   {
     if (scale.is_empty())
     {
       throw std::runtime_error("Call Fit() before Transform(), please"
         " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = input.each_col() / scale;
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      typename MatType::elem_type* point = data.colptr(i);
+      for (size_t j = 0; j < data.n_rows; ++j)
+        point[j] /= scale[j];
+    }
   }
 
   /**
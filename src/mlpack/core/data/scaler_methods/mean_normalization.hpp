@@ -47,16 +47,52 @@ class MeanNormalization
 {
  public:
   /**
-   * Function to fit features, to find out the min max and scale.
+   * Default constructor.
+   */
+  MeanNormalization() : numPoints(0) { }
+
+  /**
+   * Function to fit features, to find out the min max and scale.  This forgets
+   * any data given to earlier calls to Fit() or PartialFit().
    *
    * @param input Dataset to fit.
    */
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemMin = min(input, 1);
-    itemMax = arma::max(input, 1);
+    numPoints = 0;
+    PartialFit(input);
+  }
+
+  /**
+   * Update the mean, minimum and maximum of the features with the given batch
+   * of points, so that a dataset that does not fit in memory can be fitted one
+   * batch at a time.
+   *
+   * @param input Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    if (numPoints == 0)
+    {
+      itemMean = arma::mean(input, 1);
+      itemMin = arma::min(input, 1);
+      itemMax = arma::max(input, 1);
+    }
+    else
+    {
+      const arma::vec batchMean = arma::mean(input, 1);
+      itemMean += (batchMean - itemMean) *
+          ((double) input.n_cols / (numPoints + input.n_cols));
+      itemMin = arma::min(itemMin, arma::vec(arma::min(input, 1)));
+      itemMax = arma::max(itemMax, arma::vec(arma::max(input, 1)));
+    }
+    numPoints += input.n_cols;
+
     scale = itemMax - itemMin;
     // Handling zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -71,14 +107,32 @@ class MeanNormalization
    */
   template<typename MatType>
   void Transform(const MatType& input, MatType& output)
+  {
+    output = input;
+    Transform(output);
+  }
+
+  /**
+   * Function to scale features in place, in parallel over the points.
+   *
+   * @param data Dataset to scale features of.
+   */
+  template<typename MatType>
+  void Transform(MatType& data)
   {
     if (itemMean.is_empty() || scale.is_empty())
     {
       throw std::runtime_error("Call Fit() before Transform(), please"
         " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() - itemMean).each_col() / scale;
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      typename MatType::elem_type* point = data.colptr(i);
+      for (size_t j = 0; j < data.n_rows; ++j)
+        point[j] = (point[j] - itemMean[j]) / scale[j];
+    }
   }
 
   /**
@@ -102,14 +156,20 @@ class MeanNormalization
   const arma::vec& ItemMax() const { return itemMax; }
   //! Get the Scale row vector.
   const arma::vec& Scale() const { return scale; }
+  //! Get the number of points fitted so far.
+  size_t NumPoints() const { return numPoints; }
 
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(itemMin));
     ar(CEREAL_NVP(itemMax));
     ar(CEREAL_NVP(scale));
     ar(CEREAL_NVP(itemMean));
+    if (version > 0)
+      ar(CEREAL_NVP(numPoints));
+    else if (cereal::is_loading<Archive>())
+      numPoints = 0; // Older models cannot be updated with PartialFit().
   }
 
  private:
@@ -121,9 +181,13 @@ class MeanNormalization
   arma::vec itemMax;
   // Vector which is used to scale up each feature.
   arma::vec scale;
+  // Number of points fitted so far.
+  size_t numPoints;
 }; // class MeanNormalization
 
 } // namespace data
 } // namespace mlpack
 
+CEREAL_CLASS_VERSION(mlpack::data::MeanNormalization, 1);
+
 #endif
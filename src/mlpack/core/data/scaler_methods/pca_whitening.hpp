@@ -51,7 +51,7 @@ class PCAWhitening
    *
    * @param eps Regularization parameter.
    */
-  PCAWhitening(double eps = 0.00005)
+  PCAWhitening(double eps = 0.00005) : numPoints(0)
   {
     epsilon = eps;
     // Ensure scaleMin is smaller than scaleMax.
@@ -62,17 +62,60 @@ class PCAWhitening
   }
 
   /**
-   * Function to fit features, to find out the min max and scale.
+   * Function to fit features, to find out the mean and the eigendecomposition
+   * of the covariance.  This forgets any data given to earlier calls to Fit()
+   * or PartialFit().
    *
    * @param input Dataset to fit.
    */
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
+    numPoints = 0;
+    PartialFit(input);
+  }
+
+  /**
+   * Update the mean and covariance of the features with the given batch of
+   * points, and recompute the eigendecomposition of the covariance, so that a
+   * dataset that does not fit in memory can be fitted one batch at a time.
+   * The scatter matrices of the batches are merged with the parallel variant
+   * of Welford's algorithm (Chan et al., 1979).
+   *
+   * @param input Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    const double batchSize = input.n_cols;
+    arma::vec batchMean = arma::mean(input, 1);
+    const arma::mat centered = input.each_col() - batchMean;
+    arma::mat batchScatter = centered * centered.t();
+
+    if (numPoints == 0)
+    {
+      itemMean = std::move(batchMean);
+      scatter = std::move(batchScatter);
+    }
+    else
+    {
+      const double total = numPoints + batchSize;
+      const arma::vec delta = batchMean - itemMean;
+      itemMean += delta * (batchSize / total);
+      scatter += batchScatter + (delta * delta.t()) *
+          (numPoints * batchSize / total);
+    }
+    numPoints += input.n_cols;
+
     // Get eigenvectors and eigenvalues of covariance of input matrix.
-    eig_sym(eigenValues, eigenVectors, ColumnCovariance(
-        input.each_col() - itemMean));
+    if (numPoints > 1)
+      eig_sym(eigenValues, eigenVectors, scatter / (numPoints - 1));
+    else
+      eig_sym(eigenValues, eigenVectors, arma::mat(arma::size(scatter),
+          arma::fill::zeros));
     eigenValues += epsilon;
   }
 
@@ -84,16 +127,52 @@ class PCAWhitening
    */
   template<typename MatType>
   void Transform(const MatType& input, MatType& output)
+  {
+    output = input;
+    Transform(output);
+  }
+
+  /**
+   * Function for PCA whitening in place.  The points are whitened in blocks,
+   * in parallel.
+   *
+   * @param data Dataset to whiten.
+   */
+  template<typename MatType>
+  void Transform(MatType& data)
   {
     if (eigenValues.is_empty() || eigenVectors.is_empty())
     {
       throw std::runtime_error("Call Fit() before Transform(), please"
           " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() - itemMean);
-    output = arma::diagmat(1.0 / (sqrt(eigenValues))) * eigenVectors.t()
-        * output;
+
+    const arma::mat whitening = arma::diagmat(1.0 / (sqrt(eigenValues))) *
+        eigenVectors.t();
+    ApplyInPlace(whitening, data);
+  }
+
+  /**
+   * Replace each point x of the given dataset by w * (x - mean), processing
+   * the points in blocks, in parallel.
+   *
+   * @param w Square matrix to apply.
+   * @param data Dataset to transform.
+   */
+  template<typename MatType>
+  void ApplyInPlace(const arma::mat& w, MatType& data) const
+  {
+    const size_t blockSize = 1024;
+    const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+
+    #pragma omp parallel for
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t first = b * blockSize;
+      const size_t last = std::min(first + blockSize, (size_t) data.n_cols) - 1;
+      data.cols(first, last) = w * (data.cols(first, last).each_col() -
+          itemMean);
+    }
   }
 
   /**
@@ -118,14 +197,27 @@ class PCAWhitening
   const arma::mat& EigenVectors() const { return eigenVectors; }
   //! Get the regularization parameter.
   const double& Epsilon() const { return epsilon; }
+  //! Get the number of points fitted so far.
+  size_t NumPoints() const { return numPoints; }
 
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(eigenValues));
     ar(CEREAL_NVP(eigenVectors));
     ar(CEREAL_NVP(itemMean));
     ar(CEREAL_NVP(epsilon));
+    if (version > 0)
+    {
+      ar(CEREAL_NVP(numPoints));
+      ar(CEREAL_NVP(scatter));
+    }
+    else if (cereal::is_loading<Archive>())
+    {
+      // Older models cannot be updated with PartialFit().
+      numPoints = 0;
+      scatter.clear();
+    }
   }
 
  private:
@@ -137,9 +229,15 @@ class PCAWhitening
   double epsilon;
   // Vector which hold the eigenvalues.
   arma::vec eigenValues;
+  // Number of points fitted so far.
+  size_t numPoints;
+  // Sum of the outer products of the deviations of the points from the mean.
+  arma::mat scatter;
 }; // class PCAWhitening
 
 } // namespace data
 } // namespace mlpack
 
+CEREAL_CLASS_VERSION(mlpack::data::PCAWhitening, 1);
+
 #endif
@@ -48,15 +48,59 @@ class StandardScaler
 {
  public:
   /**
-   * Function to fit features, to find out the min max and scale.
+   * Default constructor.
+   */
+  StandardScaler() : numPoints(0) { }
+
+  /**
+   * Function to fit features, to find out the mean and standard deviation.
+   * This forgets any data given to earlier calls to Fit() or PartialFit().
    *
    * @param input Dataset to fit.
    */
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemStdDev = arma::stddev(input, 1, 1);
+    numPoints = 0;
+    PartialFit(input);
+  }
+
+  /**
+   * Update the mean and standard deviation of the features with the given
+   * batch of points, so that a dataset that does not fit in memory can be
+   * fitted one batch at a time.  The statistics of the batch are merged with
+   * those of the previous batches with the parallel variant of Welford's
+   * algorithm (Chan et al., 1979), so the result is the same as a single call
+   * to Fit() on all the points, up to floating-point error.
+   *
+   * @param input Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    const double batchSize = input.n_cols;
+    arma::vec batchMean = arma::mean(input, 1);
+    arma::vec batchM2 = arma::sum(arma::square(
+        input.each_col() - batchMean), 1);
+
+    if (numPoints == 0)
+    {
+      itemMean = std::move(batchMean);
+      itemM2 = std::move(batchM2);
+    }
+    else
+    {
+      const double total = numPoints + batchSize;
+      const arma::vec delta = batchMean - itemMean;
+      itemMean += delta * (batchSize / total);
+      itemM2 += batchM2 + arma::square(delta) * (numPoints * batchSize / total);
+    }
+    numPoints += input.n_cols;
+
+    itemStdDev = arma::sqrt(itemM2 / numPoints);
     // Handle zeros in scale vector.
     itemStdDev.for_each([](arma::vec::elem_type& val) { val =
         (val == 0) ? 1 : val; });
@@ -70,14 +114,32 @@ class StandardScaler
    */
   template<typename MatType>
   void Transform(const MatType& input, MatType& output)
+  {
+    output = input;
+    Transform(output);
+  }
+
+  /**
+   * Function to scale features in place, in parallel over the points.
+   *
+   * @param data Dataset to scale features of.
+   */
+  template<typename MatType>
+  void Transform(MatType& data)
   {
     if (itemMean.is_empty() || itemStdDev.is_empty())
     {
       throw std::runtime_error("Call Fit() before Transform(), please"
         " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() - itemMean).each_col() / itemStdDev;
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      typename MatType::elem_type* point = data.colptr(i);
+      for (size_t j = 0; j < data.n_rows; ++j)
+        point[j] = (point[j] - itemMean[j]) / itemStdDev[j];
+    }
   }
 
   /**
@@ -97,12 +159,25 @@ class StandardScaler
   const arma::vec& ItemMean() const { return itemMean; }
   //! Get the standard deviation row vector.
   const arma::vec& ItemStdDev() const { return itemStdDev; }
+  //! Get the number of points fitted so far.
+  size_t NumPoints() const { return numPoints; }
 
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(itemMean));
     ar(CEREAL_NVP(itemStdDev));
+    if (version > 0)
+    {
+      ar(CEREAL_NVP(numPoints));
+      ar(CEREAL_NVP(itemM2));
+    }
+    else if (cereal::is_loading<Archive>())
+    {
+      // Older models cannot be updated with PartialFit().
+      numPoints = 0;
+      itemM2.clear();
+    }
   }
 
  private:
@@ -110,9 +185,16 @@ class StandardScaler
   arma::vec itemMean;
   // Vector which holds standard devation of each feature.
   arma::vec itemStdDev;
+  // Number of points fitted so far.
+  size_t numPoints;
+  // Vector which holds the sum of squared deviations from the mean of each
+  // feature.
+  arma::vec itemM2;
 }; // class StandardScaler
 
 } // namespace data
 } // namespace mlpack
 
+CEREAL_CLASS_VERSION(mlpack::data::StandardScaler, 1);
+
 #endif
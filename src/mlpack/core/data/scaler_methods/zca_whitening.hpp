@@ -64,6 +64,18 @@ class ZCAWhitening
     pca.Fit(input);
   }
 
+  /**
+   * Update the mean and covariance of the features with the given batch of
+   * points; see PCAWhitening::PartialFit().
+   *
+   * @param input Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    pca.PartialFit(input);
+  }
+
   /**
    * Function for ZCA whitening.
    *
@@ -73,8 +85,29 @@ class ZCAWhitening
   template<typename MatType>
   void Transform(const MatType& input, MatType& output)
   {
-    pca.Transform(input, output);
-    output = pca.EigenVectors() * output;
+    output = input;
+    Transform(output);
+  }
+
+  /**
+   * Function for ZCA whitening in place.  The points are whitened in blocks,
+   * in parallel.
+   *
+   * @param data Dataset to whiten.
+   */
+  template<typename MatType>
+  void Transform(MatType& data)
+  {
+    if (pca.EigenValues().is_empty() || pca.EigenVectors().is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+          " refer to the documentation.");
+    }
+
+    const arma::mat whitening = pca.EigenVectors() *
+        arma::diagmat(1.0 / (sqrt(pca.EigenValues()))) *
+        pca.EigenVectors().t();
+    pca.ApplyInPlace(whitening, data);
   }
 
   /**
@@ -14,6 +14,9 @@
 #define MLPACK_CORE_DATA_SPLIT_DATA_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/make_alias.hpp>
+
+#include "chunked_source.hpp"
 
 namespace mlpack {
 namespace data {
@@ -733,6 +736,309 @@ Split(const FieldType& input,
                          std::move(testData));
 }
 
+/**
+ * Reorder the points of `data` in place, so that point i becomes the point that
+ * was at index order[i].  The points of a vector are its elements, and the
+ * points of a matrix are its columns.  Each cycle of the permutation is
+ * followed with a single buffer of one point, so the only extra memory is that
+ * buffer and one flag per point.
+ */
+template<typename MatType>
+void PermutePointsInPlace(MatType& data, const arma::uvec& order)
+{
+  using eT = typename MatType::elem_type;
+
+  const size_t pointSize = IsVector<MatType>::value ? 1 : data.n_rows;
+  eT* mem = data.memptr();
+  std::vector<eT> buffer(pointSize);
+  std::vector<bool> done(order.n_elem, false);
+  for (size_t start = 0; start < order.n_elem; ++start)
+  {
+    if (done[start] || order[start] == start)
+      continue;
+
+    // Save the start of the cycle, then shift every point of the cycle.
+    std::copy(mem + start * pointSize, mem + (start + 1) * pointSize,
+        buffer.begin());
+    size_t current = start;
+    while (order[current] != start)
+    {
+      const size_t next = order[current];
+      std::copy(mem + next * pointSize, mem + (next + 1) * pointSize,
+          mem + current * pointSize);
+      done[current] = true;
+      current = next;
+    }
+
+    std::copy(buffer.begin(), buffer.end(), mem + current * pointSize);
+    done[current] = true;
+  }
+}
+
+/**
+ * Make `train` an alias of the first `trainSize` points of `data`, and `test`
+ * an alias of the remaining points.
+ */
+template<typename MatType>
+void MakeSplitAliases(MatType& data,
+                      MatType& train,
+                      MatType& test,
+                      const size_t trainSize,
+                      const typename std::enable_if_t<
+                          !IsVector<MatType>::value>* = 0)
+{
+  MakeAlias(train, data, data.n_rows, trainSize, 0, false);
+  MakeAlias(test, data, data.n_rows, data.n_cols - trainSize,
+      trainSize * data.n_rows, false);
+}
+
+/**
+ * Make `train` an alias of the first `trainSize` elements of `data`, and `test`
+ * an alias of the remaining elements.
+ */
+template<typename VecType>
+void MakeSplitAliases(VecType& data,
+                      VecType& train,
+                      VecType& test,
+                      const size_t trainSize,
+                      const typename std::enable_if_t<
+                          IsVector<VecType>::value>* = 0)
+{
+  MakeAlias(train, data, trainSize, 0, false);
+  MakeAlias(test, data, data.n_elem - trainSize, trainSize, false);
+}
+
+/**
+ * Given an input dataset and labels, split into a training set and test set
+ * without copying the data.  The points of `input` (and `inputLabel`) are
+ * shuffled in place, so that the training points are the first columns and the
+ * test points are the last ones; `trainData`, `testData`, `trainLabel` and
+ * `testLabel` are then made non-owning aliases of these ranges (see
+ * MakeAlias()).  The split uses no memory other than a buffer of one point and
+ * the shuffled order, so it can be used for datasets that could not be held in
+ * memory twice.
+ *
+ * The aliases are only valid as long as `input` and `inputLabel` are not
+ * modified or destroyed.  The points are in the same order as for Split() with
+ * the same random seed.
+ *
+ * @code
+ * arma::mat input = loadData();
+ * arma::Row<size_t> label = loadLabel();
+ * arma::mat trainData, testData;
+ * arma::Row<size_t> trainLabel, testLabel;
+ *
+ * // After this call, input and label are reordered, and trainData etc. are
+ * // aliases of parts of them.
+ * SplitInPlace(input, label, trainData, testData, trainLabel, testLabel, 0.3);
+ * @endcode
+ *
+ * @param input Input dataset to split; its points are reordered.
+ * @param inputLabel Input labels to split; they are reordered.
+ * @param trainData Will be an alias of the training data.
+ * @param testData Will be an alias of the test data.
+ * @param trainLabel Will be an alias of the training labels.
+ * @param testLabel Will be an alias of the test labels.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, the
+ *     points are not moved. (Default true.)
+ */
+template<typename T, typename LabelsType,
+         typename = std::enable_if_t<arma::is_arma_type<LabelsType>::value>>
+void SplitInPlace(arma::Mat<T>& input,
+                  LabelsType& inputLabel,
+                  arma::Mat<T>& trainData,
+                  arma::Mat<T>& testData,
+                  LabelsType& trainLabel,
+                  LabelsType& testLabel,
+                  const double testRatio,
+                  const bool shuffleData = true)
+{
+  util::CheckSameSizes(input, inputLabel, "data::SplitInPlace()");
+  if (shuffleData && input.n_cols > 0)
+  {
+    arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0,
+        input.n_cols - 1, input.n_cols));
+    PermutePointsInPlace(input, order);
+    PermutePointsInPlace(inputLabel, order);
+  }
+
+  const size_t testSize = static_cast<size_t>(input.n_cols * testRatio);
+  const size_t trainSize = input.n_cols - testSize;
+  MakeSplitAliases(input, trainData, testData, trainSize);
+  MakeSplitAliases(inputLabel, trainLabel, testLabel, trainSize);
+}
+
+/**
+ * Given an input dataset, split into a training set and test set without
+ * copying the data.  The points of `input` are shuffled in place, and
+ * `trainData` and `testData` are made non-owning aliases of its first and last
+ * columns.  See the overload with labels for more details.
+ *
+ * @param input Input dataset to split; its points are reordered.
+ * @param trainData Will be an alias of the training data.
+ * @param testData Will be an alias of the test data.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, the
+ *     points are not moved. (Default true.)
+ */
+template<typename T>
+void SplitInPlace(arma::Mat<T>& input,
+                  arma::Mat<T>& trainData,
+                  arma::Mat<T>& testData,
+                  const double testRatio,
+                  const bool shuffleData = true)
+{
+  if (shuffleData && input.n_cols > 0)
+  {
+    arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0,
+        input.n_cols - 1, input.n_cols));
+    PermutePointsInPlace(input, order);
+  }
+
+  const size_t testSize = static_cast<size_t>(input.n_cols * testRatio);
+  MakeSplitAliases(input, trainData, testData, input.n_cols - testSize);
+}
+
+/**
+ * Given an input dataset and labels, stratify into a training set and test set
+ * without copying the data.  The points are selected exactly as in
+ * StratifiedSplit() (with the same random seed, the training and test sets are
+ * the same, in the same order), but the points of `input` and `inputLabel` are
+ * reordered in place so that the training points come first, and `trainData`,
+ * `testData`, `trainLabel` and `testLabel` are made non-owning aliases of them.
+ * The aliases are only valid as long as `input` and `inputLabel` are not
+ * modified or destroyed.
+ *
+ * Expects labels to be of type arma::Row<> or arma::Col<>; throws a runtime
+ * error if this is not the case.
+ *
+ * @param input Input dataset to stratify; its points are reordered.
+ * @param inputLabel Input labels to stratify; they are reordered.
+ * @param trainData Will be an alias of the training data.
+ * @param testData Will be an alias of the test data.
+ * @param trainLabel Will be an alias of the training labels.
+ * @param testLabel Will be an alias of the test labels.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ */
+template<typename T, typename LabelsType,
+         typename = std::enable_if_t<arma::is_arma_type<LabelsType>::value>>
+void StratifiedSplitInPlace(arma::Mat<T>& input,
+                            LabelsType& inputLabel,
+                            arma::Mat<T>& trainData,
+                            arma::Mat<T>& testData,
+                            LabelsType& trainLabel,
+                            LabelsType& testLabel,
+                            const double testRatio,
+                            const bool shuffleData = true)
+{
+  const bool typeCheck = (arma::is_Row<LabelsType>::value)
+      || (arma::is_Col<LabelsType>::value);
+  if (!typeCheck)
+    throw std::runtime_error("data::StratifiedSplitInPlace(): when stratified "
+        "sampling is done, labels must have type `arma::Row<>`!");
+  util::CheckSameSizes(input, inputLabel, "data::StratifiedSplitInPlace()");
+
+  // Select the test points as StratifiedSplit() does; see there for details.
+  arma::uvec labelCounts;
+  arma::uvec testLabelCounts;
+  typename LabelsType::elem_type maxLabel = inputLabel.max();
+  labelCounts.zeros(maxLabel + 1);
+  testLabelCounts.zeros(maxLabel + 1);
+
+  for (typename LabelsType::elem_type label : inputLabel)
+    ++labelCounts[label];
+
+  size_t testSize = 0;
+  for (arma::uword labelCount : labelCounts)
+    testSize += floor(labelCount * testRatio);
+  const size_t trainSize = input.n_cols - testSize;
+
+  arma::uvec visitOrder = arma::linspace<arma::uvec>(0, input.n_cols - 1,
+      input.n_cols);
+  if (shuffleData)
+    visitOrder = arma::shuffle(visitOrder);
+
+  // The training points come first, then the test points, each in the order
+  // they are visited.
+  arma::uvec order(input.n_cols);
+  size_t trainIdx = 0;
+  size_t testIdx = trainSize;
+  for (arma::uword i : visitOrder)
+  {
+    typename LabelsType::elem_type label = inputLabel[i];
+    if (testLabelCounts[label] < floor(labelCounts[label] * testRatio))
+    {
+      testLabelCounts[label] += 1;
+      order[testIdx++] = i;
+    }
+    else
+    {
+      order[trainIdx++] = i;
+    }
+  }
+
+  PermutePointsInPlace(input, order);
+  PermutePointsInPlace(inputLabel, order);
+  MakeSplitAliases(input, trainData, testData, trainSize);
+  MakeSplitAliases(inputLabel, trainLabel, testLabel, trainSize);
+}
+
+/**
+ * Split a dataset stored in an HDF5 file into a training set and a test set,
+ * without loading the dataset.  `train` and `test` must be two ChunkedSources
+ * opened on the same HDF5 file (with the same `transpose` setting); after the
+ * call, `train` only returns the training points and `test` only returns the
+ * test points (see ChunkedSource::SetPoints()).  Only the indices of the points
+ * are held in memory, and each chunk is read from the file directly.  The
+ * points are in the same order as for Split() with the same random seed.
+ *
+ * @code
+ * data::ChunkedSource<double> train("dataset.h5"), test("dataset.h5");
+ * data::Split(train, test, 0.2);
+ * @endcode
+ *
+ * A std::invalid_argument is thrown if the sources are not opened on the same
+ * file, or if the file is not an HDF5 file.
+ *
+ * @param train Source that will return the training points.
+ * @param test Source that will return the test points.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, the
+ *     first points are the training points. (Default true.)
+ */
+template<typename T>
+void Split(ChunkedSource<T>& train,
+           ChunkedSource<T>& test,
+           const double testRatio,
+           const bool shuffleData = true)
+{
+  train.ClearPoints();
+  test.ClearPoints();
+  if (train.Filename() != test.Filename() ||
+      train.NumPoints() != test.NumPoints() ||
+      train.Dimensionality() != test.Dimensionality())
+  {
+    throw std::invalid_argument("data::Split(): training and test sources must "
+        "read the same dataset!");
+  }
+
+  const size_t numPoints = train.NumPoints();
+  const size_t testSize = static_cast<size_t>(numPoints * testRatio);
+  const size_t trainSize = numPoints - testSize;
+  arma::uvec order = arma::linspace<arma::uvec>(0, numPoints - 1, numPoints);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  // An empty subvector cannot be taken.
+  train.SetPoints(trainSize == 0 ? arma::uvec() :
+      arma::uvec(order.subvec(0, trainSize - 1)));
+  test.SetPoints(testSize == 0 ? arma::uvec() :
+      arma::uvec(order.subvec(trainSize, numPoints - 1)));
+}
+
 } // namespace data
 } // namespace mlpack
 
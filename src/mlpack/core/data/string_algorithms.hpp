@@ -183,6 +183,68 @@ inline std::vector<std::string> Tokenize(
   return tokens;
 }
 
+/**
+ * Return the view of the given string without the whitespace on either side.
+ * Unlike Trim(), this does not copy the string.
+ *
+ * @param str the string to be trimmed.
+ */
+inline std::string_view TrimView(std::string_view str)
+{
+  size_t startIndex = 0;
+  while (startIndex < str.size() && std::isspace(str[startIndex]))
+    startIndex++;
+
+  size_t endIndex = str.size();
+  while (endIndex > startIndex && std::isspace(str[endIndex - 1]))
+    endIndex--;
+
+  return str.substr(startIndex, endIndex - startIndex);
+}
+
+/**
+ * Split the given string into tokens like Tokenize(), but store views of the
+ * tokens into the string instead of copies.  Escaped characters are not
+ * supported, because removing the backslashes would change the tokens; lines
+ * that contain a backslash should be split with Tokenize() instead.
+ *
+ * @param line Input string to tokenize.
+ * @param tokenDelim Character to use as delimiter between tokens.
+ * @param escape Escape character, usually " or '.
+ * @param tokens Will hold the tokens (any previous contents are removed).
+ */
+inline void TokenizeView(std::string_view line,
+                         char tokenDelim,
+                         char escape,
+                         std::vector<std::string_view>& tokens)
+{
+  tokens.clear();
+
+  // Shortcut: if the line is empty, it has no tokens.
+  if (line.size() == 0)
+    return;
+
+  bool inEscape = false;
+  size_t lastSplitIndex = 0;
+  for (size_t currentIndex = 0; currentIndex < line.size(); ++currentIndex)
+  {
+    const char c = line[currentIndex];
+    if (c == escape)
+    {
+      inEscape = !inEscape;
+    }
+    else if (c == tokenDelim && !inEscape)
+    {
+      tokens.push_back(line.substr(lastSplitIndex,
+          currentIndex - lastSplitIndex));
+      lastSplitIndex = currentIndex + 1;
+    }
+  }
+
+  // Push the last token.
+  tokens.push_back(line.substr(lastSplitIndex));
+}
+
 } // namespace data
 } // namespace mlpack
 
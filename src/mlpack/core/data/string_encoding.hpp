@@ -66,7 +66,8 @@ class StringEncoding
   StringEncoding& operator=(StringEncoding&&) = default;
 
   /**
-   * Initialize the dictionary using the given corpus.
+   * Initialize the dictionary using the given corpus.  This does nothing if the
+   * encoding policy does not use a dictionary (e.g. HashingEncodingPolicy).
    *
    * @tparam TokenizerType Type of the tokenizer.
    *
@@ -98,6 +99,13 @@ class StringEncoding
    * writes it in the column-major order. If the output type is 2D std::vector
    * then the function writes it in the row major order.
    *
+   * The strings are tokenized in parallel if OpenMP is available (with
+   * per-thread dictionaries that are merged deterministically, so the labels
+   * do not depend on the number of threads), so the tokenizer must be safe to
+   * call from several threads at once, as SplitByAnyOf and CharExtract are.
+   * If the encoding policy does not use a dictionary (e.g.
+   * HashingEncodingPolicy), the strings are also encoded in parallel.
+   *
    * @tparam OutputType Type of the output container. The function supports
    *                    the following types: arma::mat, arma::sp_mat,
    *                    std::vector<std::vector<>>.
@@ -201,6 +209,47 @@ class StringEncoding
                     std::enable_if_t<StringEncodingPolicyTraits<
                         PolicyType>::onePassEncoding>* = 0);
 
+  /**
+   * Tokenize the given strings, add their tokens to the dictionary, and store
+   * the labels of the tokens of the i-th string in labels[i].  The strings
+   * are split into one contiguous block per thread and tokenized in
+   * parallel, each thread labelling its tokens with its own local dictionary;
+   * the local dictionaries are then merged into the dictionary in the order
+   * of the blocks, so the labels are the same as if the strings had been
+   * tokenized one after another, whatever the number of threads.
+   *
+   * @tparam TokenizerType Type of the tokenizer.
+   *
+   * @param input Corpus of text to tokenize.
+   * @param tokenizer The tokenizer object.
+   * @param labels Labels of the tokens of each string.
+   */
+  template<typename TokenizerType>
+  void Tokenize(const std::vector<std::string>& input,
+                const TokenizerType& tokenizer,
+                std::vector<std::vector<size_t>>& labels);
+
+  /**
+   * A helper function to encode the given text with a policy that does not use
+   * the dictionary (such as HashingEncodingPolicy), and write the result to
+   * the given output.  Each string is encoded independently, so the strings
+   * are encoded in parallel if OpenMP is available.  Sparse output is built
+   * at once from the encoded values of all the strings.
+   *
+   * @tparam OutputType Type of the output container. The function supports
+   *                    the following types: arma::mat, arma::sp_mat,
+   *                    std::vector<std::vector<>>.
+   * @tparam TokenizerType Type of the tokenizer.
+   *
+   * @param input Corpus of text to encode.
+   * @param output Output container to store the result.
+   * @param tokenizer The tokenizer object.
+   */
+  template<typename OutputType, typename TokenizerType>
+  void HashEncodeHelper(const std::vector<std::string>& input,
+                        OutputType& output,
+                        const TokenizerType& tokenizer);
+
  private:
   //! The encoding policy object.
   EncodingPolicyType encodingPolicy;
@@ -17,6 +17,10 @@
 #include "string_encoding.hpp"
 #include <type_traits>
 
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace data {
 
@@ -66,6 +70,13 @@ void StringEncoding<EncodingPolicyType, DictionaryType>::CreateMap(
     const std::string& input,
     const TokenizerType& tokenizer)
 {
+  // Nothing to do if the policy does not use the dictionary.
+  if constexpr (!StringEncodingPolicyTraits<
+      EncodingPolicyType>::usesDictionary)
+  {
+    return;
+  }
+
   std::string_view strView(input);
   auto token = tokenizer(strView);
 
@@ -93,7 +104,10 @@ void StringEncoding<EncodingPolicyType, DictionaryType>::Encode(
     OutputType& output,
     const TokenizerType& tokenizer)
 {
-  EncodeHelper(input, output, tokenizer, encodingPolicy);
+  if constexpr (StringEncodingPolicyTraits<EncodingPolicyType>::usesDictionary)
+    EncodeHelper(input, output, tokenizer, encodingPolicy);
+  else
+    HashEncodeHelper(input, output, tokenizer);
 }
 
 
@@ -105,55 +119,28 @@ EncodeHelper(const std::vector<std::string>& input,
              const TokenizerType& tokenizer,
              PolicyType& policy)
 {
-  size_t numColumns = 0;
-
   policy.Reset();
 
-  // The first pass adds the extracted tokens to the dictionary.
-  for (size_t i = 0; i < input.size(); ++i)
-  {
-    std::string_view strView(input[i]);
-    auto token = tokenizer(strView);
-
-    static_assert(
-        std::is_same_v<std::remove_reference_t<decltype(token)>,
-                       std::remove_reference_t<typename DictionaryType::
-                          TokenType>>,
-        "The dictionary token type doesn't match the return value type "
-        "of the tokenizer.");
-
-    size_t numTokens = 0;
-
-    while (!tokenizer.IsTokenEmpty(token))
-    {
-      if (!dictionary.HasToken(token))
-        dictionary.AddToken(std::move(token));
-
-      policy.PreprocessToken(i, numTokens, dictionary.Value(token));
+  // The first pass adds the extracted tokens to the dictionary, and labels
+  // the tokens of each string.
+  std::vector<std::vector<size_t>> labels;
+  Tokenize(input, tokenizer, labels);
 
-      token = tokenizer(strView);
-      numTokens++;
-    }
+  size_t numColumns = 0;
+  for (size_t i = 0; i < labels.size(); ++i)
+  {
+    for (size_t j = 0; j < labels[i].size(); ++j)
+      policy.PreprocessToken(i, j, labels[i][j]);
 
-    numColumns = std::max(numColumns, numTokens);
+    numColumns = std::max(numColumns, labels[i].size());
   }
 
   policy.InitMatrix(output, input.size(), numColumns, dictionary.Size());
 
   // The second pass writes the encoded values to the output.
-  for (size_t i = 0; i < input.size(); ++i)
-  {
-    std::string_view strView(input[i]);
-    auto token = tokenizer(strView);
-    size_t numTokens = 0;
-
-    while (!tokenizer.IsTokenEmpty(token))
-    {
-      policy.Encode(output, dictionary.Value(token), i, numTokens);
-      token = tokenizer(strView);
-      numTokens++;
-    }
-  }
+  for (size_t i = 0; i < labels.size(); ++i)
+    for (size_t j = 0; j < labels[i].size(); ++j)
+      policy.Encode(output, labels[i][j], i, j);
 }
 
 template<typename EncodingPolicyType, typename DictionaryType>
@@ -168,30 +155,185 @@ EncodeHelper(const std::vector<std::string>& input,
 {
   policy.Reset();
 
-  // The loop below extracts the tokens and writes the encoded values
-  // at once.
-  for (size_t i = 0; i < input.size(); ++i)
+  std::vector<std::vector<size_t>> labels;
+  Tokenize(input, tokenizer, labels);
+
+  // The loop below writes the encoded values of each string at once.
+  for (size_t i = 0; i < labels.size(); ++i)
   {
-    std::string_view strView(input[i]);
-    auto token = tokenizer(strView);
+    output.emplace_back();
+
+    for (size_t j = 0; j < labels[i].size(); ++j)
+      policy.Encode(output.back(), labels[i][j]);
+  }
+}
+
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename TokenizerType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::Tokenize(
+    const std::vector<std::string>& input,
+    const TokenizerType& tokenizer,
+    std::vector<std::vector<size_t>>& labels)
+{
+  using TokenType = typename DictionaryType::TokenType;
 
-    static_assert(
-        std::is_same_v<std::remove_reference_t<decltype(token)>,
-                       std::remove_reference_t<typename DictionaryType::
-                          TokenType>>,
-        "The dictionary token type doesn't match the return value type "
-        "of the tokenizer.");
+  labels.clear();
+  labels.resize(input.size());
 
-    output.emplace_back();
+  // Each thread tokenizes a contiguous block of the strings, and labels their
+  // tokens with a local dictionary, in the order in which they first occur.
+  size_t numThreads = 1;
+  #ifdef MLPACK_USE_OPENMP
+    numThreads = std::max(size_t(1), std::min((size_t) omp_get_max_threads(),
+        input.size()));
+  #endif
 
-    while (!tokenizer.IsTokenEmpty(token))
+  std::vector<std::vector<TokenType>> localTokens(numThreads);
+
+  #pragma omp parallel for schedule(static, 1) num_threads(numThreads)
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    std::unordered_map<TokenType, size_t> localDictionary;
+    const size_t first = input.size() * t / numThreads;
+    const size_t last = input.size() * (t + 1) / numThreads;
+
+    for (size_t i = first; i < last; ++i)
+    {
+      std::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      static_assert(
+          std::is_same_v<std::remove_reference_t<decltype(token)>,
+                         std::remove_reference_t<TokenType>>,
+          "The dictionary token type doesn't match the return value type "
+          "of the tokenizer.");
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        auto it = localDictionary.find(token);
+        if (it == localDictionary.end())
+        {
+          it = localDictionary.emplace(token, localTokens[t].size()).first;
+          localTokens[t].push_back(token);
+        }
+
+        labels[i].push_back(it->second);
+        token = tokenizer(strView);
+      }
+    }
+  }
+
+  // Merge the local dictionaries into the dictionary in the order of the
+  // blocks.  Since each local dictionary lists its tokens in the order of
+  // their first occurrence, the tokens get the same labels as if the strings
+  // had been tokenized one after another.
+  std::vector<std::vector<size_t>> globalLabels(numThreads);
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    globalLabels[t].resize(localTokens[t].size());
+    for (size_t j = 0; j < localTokens[t].size(); ++j)
+    {
+      const TokenType& token = localTokens[t][j];
+      globalLabels[t][j] = dictionary.HasToken(token) ?
+          dictionary.Value(token) : dictionary.AddToken(token);
+    }
+  }
+
+  // Translate the local labels into the labels of the dictionary.
+  #pragma omp parallel for schedule(static, 1) num_threads(numThreads)
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    const size_t first = input.size() * t / numThreads;
+    const size_t last = input.size() * (t + 1) / numThreads;
+    for (size_t i = first; i < last; ++i)
+      for (size_t j = 0; j < labels[i].size(); ++j)
+        labels[i][j] = globalLabels[t][labels[i][j]];
+  }
+}
+
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename OutputType, typename TokenizerType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::
+HashEncodeHelper(const std::vector<std::string>& input,
+                 OutputType& output,
+                 const TokenizerType& tokenizer)
+{
+  if constexpr (arma::is_SpMat<OutputType>::value)
+  {
+    using ElemType = typename OutputType::elem_type;
+
+    // Each string is encoded into its own list of (feature, value) pairs; the
+    // sparse matrix is then built at once from all the lists.
+    std::vector<std::vector<std::pair<size_t, ElemType>>> entries(input.size());
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      std::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        size_t feature;
+        ElemType value;
+        encodingPolicy.Hash(token, feature, value);
+        entries[i].emplace_back(feature, value);
+
+        token = tokenizer(strView);
+      }
+    }
+
+    size_t numEntries = 0;
+    for (size_t i = 0; i < entries.size(); ++i)
+      numEntries += entries[i].size();
+
+    arma::umat locations(2, numEntries);
+    arma::Col<ElemType> values(numEntries);
+    size_t n = 0;
+    for (size_t i = 0; i < entries.size(); ++i)
     {
-      if (dictionary.HasToken(token))
-        policy.Encode(output[i], dictionary.Value(token));
-      else
-        policy.Encode(output[i], dictionary.AddToken(std::move(token)));
+      for (size_t j = 0; j < entries[i].size(); ++j, ++n)
+      {
+        locations(0, n) = entries[i][j].first;
+        locations(1, n) = i;
+        values[n] = entries[i][j].second;
+      }
+    }
 
-      token = tokenizer(strView);
+    // Repeated (and colliding) tokens are summed.
+    output = OutputType(true, locations, values,
+        encodingPolicy.NumFeatures(), input.size());
+  }
+  else
+  {
+    encodingPolicy.InitMatrix(output, input.size());
+
+    // Each string writes to its own column (or row), so the strings can be
+    // encoded in parallel.
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      std::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        size_t feature;
+        if constexpr (arma::is_Mat<OutputType>::value)
+        {
+          typename OutputType::elem_type value;
+          encodingPolicy.Hash(token, feature, value);
+          output(feature, i) += value;
+        }
+        else
+        {
+          typename OutputType::value_type::value_type value;
+          encodingPolicy.Hash(token, feature, value);
+          output[i][feature] += value;
+        }
+
+        token = tokenizer(strView);
+      }
     }
   }
 }
@@ -133,6 +133,12 @@ struct StringEncodingPolicyTraits<DictionaryEncodingPolicy>
    * any information about other tokens as well as the total tokens count.
    */
   static const bool onePassEncoding = true;
+
+  /**
+   * Indicates if the policy encodes the tokens using the labels of the
+   * dictionary.
+   */
+  static const bool usesDictionary = true;
 };
 
 /**
@@ -0,0 +1,233 @@
+/**
+ * @file core/data/string_encoding_policies/hashing_encoding_policy.hpp
+ *
+ * Definition of the HashingEncodingPolicy class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_STRING_ENCODING_POLICIES_HASHING_ENCODING_POLICY_HPP
+#define MLPACK_CORE_DATA_STRING_ENCODING_POLICIES_HASHING_ENCODING_POLICY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/string_encoding_policies/policy_traits.hpp>
+#include <mlpack/core/data/string_encoding.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Definition of the HashingEncodingPolicy class. HashingEncodingPolicy is used
+ * as a helper class for StringEncoding.
+ *
+ * The encoder implements the hashing trick: each token is mapped to one of a
+ * fixed number of features by a hash function, instead of being assigned a
+ * label in a dictionary, and the i-th coordinate of the output vector of a
+ * dataset item is the number of its tokens that are hashed to i.  With signed
+ * hashing, a second bit of the hash gives each token a sign of +1 or -1, so
+ * that collisions cancel out in expectation:
+ *
+ * @code
+ * @inproceedings{weinberger2009feature,
+ *   title={Feature hashing for large scale multitask learning},
+ *   author={Weinberger, K. and Dasgupta, A. and Langford, J. and Smola, A.
+ *       and Attenberg, J.},
+ *   booktitle={Proceedings of the 26th Annual International Conference on
+ *       Machine Learning (ICML '09)},
+ *   pages={1113--1120},
+ *   year={2009}
+ * }
+ * @endcode
+ *
+ * No dictionary is built (the dictionary of the StringEncoding object stays
+ * empty), so the memory used by the encoder does not depend on the size of the
+ * vocabulary, every dataset item is encoded independently in a single pass,
+ * and items are encoded in parallel if OpenMP is available.  The hash function
+ * does not depend on the platform, so the same token always gives the same
+ * feature.  The output is best stored in an arma::sp_mat:
+ *
+ * @code
+ * HashingEncoding<SplitByAnyOf::TokenType> encoder(1 << 18);
+ * arma::sp_mat output;
+ * encoder.Encode(documents, output, SplitByAnyOf(" ,."));
+ * @endcode
+ */
+class HashingEncodingPolicy
+{
+ public:
+  /**
+   * Construct the policy with the given number of features.
+   *
+   * @param numFeatures Number of features (rows of the output) that the tokens
+   *     are hashed into.
+   * @param signedHash If true, the contribution of each token is multiplied by
+   *     a sign (+1 or -1) given by its hash.
+   */
+  HashingEncodingPolicy(const size_t numFeatures = 1048576,
+                        const bool signedHash = true) :
+      numFeatures(numFeatures),
+      signedHash(signedHash)
+  {
+    if (numFeatures == 0)
+    {
+      throw std::invalid_argument("HashingEncodingPolicy: the number of "
+          "features must be positive");
+    }
+  }
+
+  /**
+   * Hash the given token: compute the feature it contributes to and the value
+   * of its contribution (1, or the sign of the token with signed hashing).
+   *
+   * @tparam TokenType Type of the token (std::string_view or an integral
+   *     type, as returned by the tokenizers).
+   * @tparam ElemType Type of the output values.
+   * @param token The token to hash.
+   * @param feature The feature that the token is hashed to.
+   * @param value The contribution of the token to the feature.
+   */
+  template<typename TokenType, typename ElemType>
+  void Hash(const TokenType& token, size_t& feature, ElemType& value) const
+  {
+    uint64_t hash;
+    if constexpr (std::is_arithmetic_v<TokenType>)
+    {
+      hash = Hash64(reinterpret_cast<const unsigned char*>(&token),
+          sizeof(TokenType));
+    }
+    else
+    {
+      hash = Hash64(reinterpret_cast<const unsigned char*>(token.data()),
+          token.size());
+    }
+
+    // The lowest bits give the feature, and the highest bit gives the sign.
+    feature = (size_t) (hash % numFeatures);
+    value = (signedHash && (hash >> 63)) ? ElemType(-1) : ElemType(1);
+  }
+
+  /**
+   * The function initializes the output matrix. The encoder writes data in the
+   * column-major order.
+   *
+   * @tparam MatType The output matrix type.
+   *
+   * @param output Output matrix to store the encoded results (sp_mat or mat).
+   * @param datasetSize The number of strings in the input dataset.
+   */
+  template<typename MatType>
+  void InitMatrix(MatType& output, const size_t datasetSize) const
+  {
+    output.zeros(numFeatures, datasetSize);
+  }
+
+  /**
+   * The function initializes the output matrix. The encoder writes data in the
+   * row-major order.
+   *
+   * Overloaded function to save the result in vector<vector<ElemType>>.
+   *
+   * @tparam ElemType Type of the output values.
+   *
+   * @param output Output matrix to store the encoded results.
+   * @param datasetSize The number of strings in the input dataset.
+   */
+  template<typename ElemType>
+  void InitMatrix(std::vector<std::vector<ElemType>>& output,
+                  const size_t datasetSize) const
+  {
+    output.clear();
+    output.resize(datasetSize, std::vector<ElemType>(numFeatures));
+  }
+
+  /**
+   * Clear the necessary internal variables.
+   */
+  static void Reset()
+  {
+    // Nothing to do.
+  }
+
+  //! Get the number of features.
+  size_t NumFeatures() const { return numFeatures; }
+  //! Modify the number of features.
+  size_t& NumFeatures() { return numFeatures; }
+
+  //! Get whether signed hashing is used.
+  bool SignedHash() const { return signedHash; }
+  //! Modify whether signed hashing is used.
+  bool& SignedHash() { return signedHash; }
+
+  /**
+   * Serialize the class to the given archive.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(numFeatures));
+    ar(CEREAL_NVP(signedHash));
+  }
+
+ private:
+  /**
+   * Compute the 64-bit FNV-1a hash of the given bytes, followed by the
+   * MurmurHash3 finalizer so that all the bits of the result are well mixed.
+   */
+  static uint64_t Hash64(const unsigned char* bytes, const size_t size)
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i)
+    {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  //! Number of features that the tokens are hashed into.
+  size_t numFeatures;
+  //! Whether signed hashing is used.
+  bool signedHash;
+};
+
+/**
+ * The specialization provides some information about the hashing encoding
+ * policy.
+ */
+template<>
+struct StringEncodingPolicyTraits<HashingEncodingPolicy>
+{
+  /**
+   * Indicates if the policy is able to encode the token at once without
+   * any information about other tokens as well as the total tokens count.
+   */
+  static const bool onePassEncoding = true;
+
+  /**
+   * Indicates if the policy encodes the tokens using the labels of the
+   * dictionary.
+   */
+  static const bool usesDictionary = false;
+};
+
+/**
+ * A convenient alias for the StringEncoding class with HashingEncodingPolicy
+ * and the default dictionary for the given token type (which is not used).
+ *
+ * @tparam TokenType Type of the tokens.
+ */
+template<typename TokenType>
+using HashingEncoding = StringEncoding<HashingEncodingPolicy,
+                                       StringEncodingDictionary<TokenType>>;
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -31,6 +31,12 @@ struct StringEncodingPolicyTraits
    * any information about other tokens as well as the total tokens count.
    */
   static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the policy encodes the tokens using the labels of the
+   * dictionary.
+   */
+  static const bool usesDictionary = true;
 };
 
 } // namespace data
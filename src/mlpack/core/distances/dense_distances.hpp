@@ -0,0 +1,126 @@
+/**
+ * @file core/distances/dense_distances.hpp
+ *
+ * Simple loops to compute distances and inner products between dense vectors
+ * whose elements are stored contiguously.  These are used by LMetric and
+ * LinearKernel for dense vectors, where the cost of building Armadillo
+ * expressions dominates for the short vectors that are compared during tree
+ * traversals.  The loops are written so that the compiler can vectorize them.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTANCES_DENSE_DISTANCES_HPP
+#define MLPACK_CORE_DISTANCES_DENSE_DISTANCES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * 'value' is true if VecType is a dense Armadillo type whose elements are
+ * stored contiguously (arma::Mat, arma::Col, arma::Row or arma::subview_col)
+ * and are floating-point numbers.
+ */
+template<typename VecType>
+struct IsContiguousDense : std::false_type { };
+
+template<typename eT>
+struct IsContiguousDense<arma::Mat<eT>> :
+    std::bool_constant<std::is_floating_point_v<eT>> { };
+
+template<typename eT>
+struct IsContiguousDense<arma::Col<eT>> :
+    std::bool_constant<std::is_floating_point_v<eT>> { };
+
+template<typename eT>
+struct IsContiguousDense<arma::Row<eT>> :
+    std::bool_constant<std::is_floating_point_v<eT>> { };
+
+template<typename eT>
+struct IsContiguousDense<arma::subview_col<eT>> :
+    std::bool_constant<std::is_floating_point_v<eT>> { };
+
+/**
+ * 'value' is true if the dense loops below can be used for two vectors of the
+ * given types: both must be contiguous dense types with the same element type.
+ */
+template<typename VecTypeA, typename VecTypeB>
+struct UseDenseDistances
+{
+  static const bool value = IsContiguousDense<VecTypeA>::value &&
+      IsContiguousDense<VecTypeB>::value &&
+      std::is_same_v<typename VecTypeA::elem_type,
+                     typename VecTypeB::elem_type>;
+};
+
+//! Get a pointer to the elements of a dense matrix or vector.
+template<typename eT>
+inline const eT* DenseMemory(const arma::Mat<eT>& v) { return v.memptr(); }
+
+//! Get a pointer to the elements of a dense column view.
+template<typename eT>
+inline const eT* DenseMemory(const arma::subview_col<eT>& v)
+{
+  return v.colptr(0);
+}
+
+//! Compute the squared Euclidean distance between a and b, of length n.
+template<typename eT>
+inline eT DenseSquaredEuclidean(const eT* a, const eT* b, const size_t n)
+{
+  eT sum = 0;
+  #pragma omp simd reduction(+:sum)
+  for (size_t i = 0; i < n; ++i)
+  {
+    const eT diff = a[i] - b[i];
+    sum += diff * diff;
+  }
+
+  return sum;
+}
+
+//! Compute the Manhattan distance between a and b, of length n.
+template<typename eT>
+inline eT DenseManhattan(const eT* a, const eT* b, const size_t n)
+{
+  eT sum = 0;
+  #pragma omp simd reduction(+:sum)
+  for (size_t i = 0; i < n; ++i)
+    sum += std::abs(a[i] - b[i]);
+
+  return sum;
+}
+
+//! Compute the Chebyshev distance between a and b, of length n.
+template<typename eT>
+inline eT DenseChebyshev(const eT* a, const eT* b, const size_t n)
+{
+  eT result = 0;
+  #pragma omp simd reduction(max:result)
+  for (size_t i = 0; i < n; ++i)
+  {
+    const eT diff = std::abs(a[i] - b[i]);
+    result = (diff > result) ? diff : result;
+  }
+
+  return result;
+}
+
+//! Compute the inner product of a and b, of length n.
+template<typename eT>
+inline eT DenseDot(const eT* a, const eT* b, const size_t n)
+{
+  eT sum = 0;
+  #pragma omp simd reduction(+:sum)
+  for (size_t i = 0; i < n; ++i)
+    sum += a[i] * b[i];
+
+  return sum;
+}
+
+} // namespace mlpack
+
+#endif
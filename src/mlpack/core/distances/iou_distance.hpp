@@ -70,6 +70,21 @@ class IoUDistance
 
     return (ElemType) (1.0 - IoU<UseCoordinates>::Evaluate(a, b));
   }
+
+  /**
+   * Compute the distance between each bounding box in `a` and each bounding
+   * box in `b` (one per column), so that `distances(i, j)` is the distance
+   * between `a.col(i)` and `b.col(j)`.  See the batch overload of
+   * `IoU::Evaluate()`.
+   */
+  template<typename MatTypeA, typename MatTypeB>
+  static void Evaluate(const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::Mat<typename MatTypeA::elem_type>& distances)
+  {
+    IoU<UseCoordinates>::Evaluate(a, b, distances);
+    distances = 1 - distances;
+  }
 };
 
 } // namespace mlpack
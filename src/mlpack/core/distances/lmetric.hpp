@@ -69,7 +69,10 @@ class LMetric
   LMetric() { }
 
   /**
-   * Computes the distance between two points.
+   * Computes the distance between two points.  For the L1, L2 and
+   * L-infinity distances between dense vectors (or dense matrix columns) of
+   * `float` or `double`, this uses simple loops that the compiler can
+   * vectorize.
    *
    * @tparam VecTypeA Type of first vector (generally arma::vec or
    *      arma::sp_vec).
@@ -82,6 +85,48 @@ class LMetric
   static typename VecTypeA::elem_type Evaluate(const VecTypeA& a,
                                                const VecTypeB& b);
 
+  /**
+   * Computes the distances between one point and each column of a matrix.
+   * For dense vectors and matrices, this avoids building an Armadillo
+   * expression for every pair of points.
+   *
+   * @tparam VecType Type of the point (generally arma::vec).
+   * @tparam MatType Type of the matrix of points (generally arma::mat).
+   * @param a The point.
+   * @param b Matrix of points to compute the distances to (one per column).
+   * @param distances Vector to store the distance between a and each column
+   *      of b in.
+   */
+  template<typename VecType, typename MatType>
+  static void Evaluate(const VecType& a,
+                       const MatType& b,
+                       arma::Row<typename MatType::elem_type>& distances);
+
+  /**
+   * Computes the distances between one point and the columns of a matrix with
+   * the given indices: distances[i] is the distance between a and
+   * b.col(indices[i]), for i < n.  This is the form used by tree construction
+   * (e.g. CoverTree), where the points are given as a list of indices.  For
+   * the L1, L2 and L-infinity distances between dense vectors of `float` or
+   * `double`, the columns are read directly from the memory of b, with the
+   * loops of dense_distances.hpp.
+   *
+   * @tparam VecType Type of the point (generally arma::vec).
+   * @tparam MatType Type of the matrix of points (generally arma::mat).
+   * @tparam OutElemType Type of the distances (generally double).
+   * @param a The point.
+   * @param b Matrix of points.
+   * @param indices Indices of the columns of b to compute the distances to.
+   * @param n Number of indices.
+   * @param distances Array to store the n distances in.
+   */
+  template<typename VecType, typename MatType, typename OutElemType>
+  static void Evaluate(const VecType& a,
+                       const MatType& b,
+                       const size_t* indices,
+                       const size_t n,
+                       OutElemType* distances);
+
   //! Serialize the metric (nothing to do).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
@@ -115,6 +160,16 @@ using EuclideanDistance = LMetric<2, true>;
  */
 using ChebyshevDistance = LMetric<2147483647, false>;
 
+/**
+ * 'value' is true if DistanceType is an LMetric, so that its batch evaluations
+ * can be used.
+ */
+template<typename DistanceType>
+struct IsLMetric : std::false_type { };
+
+template<int TPower, bool TTakeRoot>
+struct IsLMetric<LMetric<TPower, TTakeRoot>> : std::true_type { };
+
 
 } // namespace mlpack
 
@@ -14,6 +14,7 @@
 
 // In case it hasn't been included.
 #include "lmetric.hpp"
+#include "dense_distances.hpp"
 
 namespace mlpack {
 
@@ -34,6 +35,70 @@ typename VecTypeA::elem_type LMetric<Power, TakeRoot>::Evaluate(
   return std::pow(sum, (1.0 / Power));
 }
 
+// Batch evaluation: the distance between a and each column of b.
+template<int Power, bool TakeRoot>
+template<typename VecType, typename MatType>
+void LMetric<Power, TakeRoot>::Evaluate(
+    const VecType& a,
+    const MatType& b,
+    arma::Row<typename MatType::elem_type>& distances)
+{
+  distances.set_size(b.n_cols);
+  for (size_t i = 0; i < b.n_cols; ++i)
+    distances[i] = Evaluate(a, b.col(i));
+}
+
+// Batch evaluation: the distance between a and the columns of b with the given
+// indices.
+template<int Power, bool TakeRoot>
+template<typename VecType, typename MatType, typename OutElemType>
+void LMetric<Power, TakeRoot>::Evaluate(
+    const VecType& a,
+    const MatType& b,
+    const size_t* indices,
+    const size_t n,
+    OutElemType* distances)
+{
+  using eT = typename MatType::elem_type;
+  constexpr bool denseLoops = (Power == 1 || Power == 2 || Power == INT_MAX) &&
+      UseDenseDistances<VecType, MatType>::value;
+
+  if constexpr (denseLoops)
+  {
+    // Only take the pointers once; column indices[i] of b starts at
+    // indices[i] * b.n_rows.
+    const eT* aMem = DenseMemory(a);
+    const eT* bMem = b.memptr();
+    const size_t dim = b.n_rows;
+    for (size_t i = 0; i < n; ++i)
+    {
+      const eT* bCol = bMem + indices[i] * dim;
+      if constexpr (Power == 1)
+      {
+        distances[i] = DenseManhattan(aMem, bCol, dim);
+      }
+      else if constexpr (Power == 2)
+      {
+        const eT sum = DenseSquaredEuclidean(aMem, bCol, dim);
+        distances[i] = TakeRoot ? std::sqrt(sum) : sum;
+      }
+      else
+      {
+        distances[i] = DenseChebyshev(aMem, bCol, dim);
+      }
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < n; ++i)
+      distances[i] = Evaluate(a, b.col(indices[i]));
+  }
+}
+
+// For the specializations below, dense vectors with contiguous elements use the
+// loops in dense_distances.hpp, which avoid the overhead of Armadillo
+// expressions for short vectors.
+
 // L1-metric specializations; the root doesn't matter.
 template<>
 template<typename VecTypeA, typename VecTypeB>
@@ -41,7 +106,14 @@ typename VecTypeA::elem_type LMetric<1, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return accu(abs(a - b));
+  if constexpr (UseDenseDistances<VecTypeA, VecTypeB>::value)
+  {
+    return DenseManhattan(DenseMemory(a), DenseMemory(b), a.n_elem);
+  }
+  else
+  {
+    return accu(abs(a - b));
+  }
 }
 
 template<>
@@ -50,7 +122,14 @@ typename VecTypeA::elem_type LMetric<1, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return accu(abs(a - b));
+  if constexpr (UseDenseDistances<VecTypeA, VecTypeB>::value)
+  {
+    return DenseManhattan(DenseMemory(a), DenseMemory(b), a.n_elem);
+  }
+  else
+  {
+    return accu(abs(a - b));
+  }
 }
 
 // L2-metric specializations.
@@ -60,7 +139,15 @@ typename VecTypeA::elem_type LMetric<2, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::norm(a - b, 2);
+  if constexpr (UseDenseDistances<VecTypeA, VecTypeB>::value)
+  {
+    return std::sqrt(DenseSquaredEuclidean(DenseMemory(a), DenseMemory(b),
+        a.n_elem));
+  }
+  else
+  {
+    return arma::norm(a - b, 2);
+  }
 }
 
 template<>
@@ -69,7 +156,14 @@ typename VecTypeA::elem_type LMetric<2, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return accu(arma::square(a - b));
+  if constexpr (UseDenseDistances<VecTypeA, VecTypeB>::value)
+  {
+    return DenseSquaredEuclidean(DenseMemory(a), DenseMemory(b), a.n_elem);
+  }
+  else
+  {
+    return accu(arma::square(a - b));
+  }
 }
 
 // L3-metric specialization (not very likely to be used, but just in case).
@@ -102,7 +196,14 @@ typename VecTypeA::elem_type LMetric<INT_MAX, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::as_scalar(arma::max(arma::abs(a - b)));
+  if constexpr (UseDenseDistances<VecTypeA, VecTypeB>::value)
+  {
+    return DenseChebyshev(DenseMemory(a), DenseMemory(b), a.n_elem);
+  }
+  else
+  {
+    return arma::as_scalar(arma::max(arma::abs(a - b)));
+  }
 }
 
 } // namespace mlpack
@@ -37,9 +37,14 @@ namespace mlpack {
  * If you wish to use the KNN class or other tree-based algorithms with this
  * distance, it is recommended to instead stretch the dataset first, by
  * decomposing Q = L^T L (perhaps via a Cholesky decomposition), and then
- * multiply the data by L.  If you still wish to use the KNN class with a custom
- * distance anyway, you will need to use a different tree type than the default
- * KDTree, which only works with the LMetric class.
+ * multiply the data by L; Whiten() does this.  If you still wish to use the KNN
+ * class with a custom distance anyway, you will need to use a different tree
+ * type than the default KDTree, which only works with the LMetric class.  (The
+ * brute-force search of KNN whitens the data itself, and so runs at the speed
+ * of a Euclidean search.)
+ *
+ * If Q is diagonal when it is given to the constructor, Evaluate() only uses
+ * the diagonal of Q.
  *
  * Similar to the LMetric class, this offers a template parameter TakeRoot
  * which, when set to false, will instead evaluate the distance
@@ -74,7 +79,8 @@ class MahalanobisDistance
    * @param dimensionality Dimensionality of the Q matrix.
    */
   MahalanobisDistance(const size_t dimensionality) :
-      q(arma::eye<MatType>(dimensionality, dimensionality)) { }
+      q(arma::eye<MatType>(dimensionality, dimensionality)),
+      qDiagonal(arma::ones<VecType>(dimensionality)) { }
 
   /**
    * Initialize the Mahalanobis distance with the given Q matrix.  The given Q
@@ -82,7 +88,11 @@ class MahalanobisDistance
    *
    * @param matQ The Q matrix to use for this distance.
    */
-  MahalanobisDistance(MatType matQ) : q(std::move(matQ)) { }
+  MahalanobisDistance(MatType matQ) : q(std::move(matQ))
+  {
+    if (q.is_diagmat())
+      qDiagonal = q.diag();
+  }
 
   /**
    * Evaluate the distance between the two given points using this Mahalanobis
@@ -96,17 +106,35 @@ class MahalanobisDistance
   template<typename VecTypeA, typename VecTypeB>
   double Evaluate(const VecTypeA& a, const VecTypeB& b);
 
+  /**
+   * Transform the given points (one per column) by a matrix L such that
+   * Q = L^T L, so that the Euclidean distance between two transformed points is
+   * the Mahalanobis distance between the original points.  If Q is diagonal,
+   * each dimension is scaled by the square root of its weight; otherwise, L is
+   * the upper Cholesky factor of Q, or, if Q is only positive semidefinite,
+   * it is obtained from the eigendecomposition of Q.  (Only the symmetric part
+   * of Q is used.)
+   *
+   * The transformed points can then be used with the EuclideanDistance (or,
+   * if TakeRoot is false, the SquaredEuclideanDistance) and any tree type.
+   *
+   * @param data Points to transform.
+   * @param whitened Matrix to store the transformed points in.
+   */
+  void Whiten(const MatType& data, MatType& whitened) const;
+
   // Access the Q matrix.
   [[deprecated("Will be removed in mlpack 5.0.0.  Use Q() instead")]]
   const MatType& Covariance() const { return q; }
   // Modify the Q matrix.
   [[deprecated("Will be removed in mlpack 5.0.0.  Use Q() instead")]]
-  MatType& Covariance() { return q; }
+  MatType& Covariance() { qDiagonal.clear(); return q; }
 
   // Access the Q matrix.
   const MatType& Q() const { return q; }
-  // Modify the Q matrix.
-  MatType& Q() { return q; }
+  // Modify the Q matrix.  After this, Evaluate() does not assume that Q is
+  // diagonal.
+  MatType& Q() { qDiagonal.clear(); return q; }
 
   //! Serialize the Mahalanobis distance.
   template<typename Archive>
@@ -115,6 +143,8 @@ class MahalanobisDistance
  private:
   //! The inverse covariance matrix associated with this distance.
   MatType q;
+  //! The diagonal of Q, if Q is known to be diagonal; empty otherwise.
+  VecType qDiagonal;
 };
 
 } // namespace mlpack
@@ -34,11 +34,71 @@ double MahalanobisDistance<TakeRoot, MatType>::Evaluate(
     throw std::runtime_error(oss.str());
   }
 
-  VecType m = (a - b);
+  double result;
+  if (!qDiagonal.is_empty())
+  {
+    // Only the diagonal of Q is needed, so no temporaries are necessary.
+    result = 0.0;
+    for (size_t i = 0; i < qDiagonal.n_elem; ++i)
+    {
+      const double diff = a[i] - b[i];
+      result += qDiagonal[i] * diff * diff;
+    }
+  }
+  else
+  {
+    const VecType m = (a - b);
+    result = arma::dot(m, q * m);
+  }
+
   if (TakeRoot == true)
-    return std::sqrt(as_scalar(m.t() * q * m));
+    return std::sqrt(result);
   else
-    return as_scalar(m.t() * q * m); // 1x1
+    return result;
+}
+
+template<bool TakeRoot, typename MatType>
+void MahalanobisDistance<TakeRoot, MatType>::Whiten(const MatType& data,
+                                                    MatType& whitened) const
+{
+  using ElemType = typename MatType::elem_type;
+
+  if (q.n_rows != data.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "MahalanobisDistance::Whiten(): given data dimensionality ("
+        << data.n_rows << ") does not match Q dimensionality (" << q.n_rows
+        << ")!";
+    throw std::runtime_error(oss.str());
+  }
+
+  if (!qDiagonal.is_empty() || q.is_diagmat())
+  {
+    const VecType scales = arma::sqrt(arma::clamp(VecType(q.diag()),
+        ElemType(0), std::numeric_limits<ElemType>::max()));
+    whitened = data.each_col() % scales;
+    return;
+  }
+
+  const MatType symmetricQ = ElemType(0.5) * (q + q.t());
+  MatType l;
+  if (!arma::chol(l, symmetricQ))
+  {
+    // Q is not positive definite; use Q = V D V^T, and L = D^(1/2) V^T.
+    VecType eigval;
+    MatType eigvec;
+    if (!arma::eig_sym(eigval, eigvec, symmetricQ))
+    {
+      throw std::runtime_error("MahalanobisDistance::Whiten(): "
+          "eigendecomposition of Q failed!");
+    }
+
+    const VecType scales = arma::sqrt(arma::clamp(eigval, ElemType(0),
+        std::numeric_limits<ElemType>::max()));
+    l = (eigvec.each_row() % scales.t()).t();
+  }
+
+  whitened = l * data;
 }
 
 // Serialize the Mahalanobis distance.
@@ -59,6 +119,13 @@ void MahalanobisDistance<TakeRoot, MatType>::serialize(
   {
     ar(CEREAL_NVP(q));
   }
+
+  if (Archive::is_loading::value)
+  {
+    qDiagonal.clear();
+    if (q.is_diagmat())
+      qDiagonal = q.diag();
+  }
 }
 
 } // namespace mlpack
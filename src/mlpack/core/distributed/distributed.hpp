@@ -0,0 +1,18 @@
+/**
+ * @file core/distributed/distributed.hpp
+ *
+ * Convenience include for distributed training utilities.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTRIBUTED_DISTRIBUTED_HPP
+#define MLPACK_CORE_DISTRIBUTED_DISTRIBUTED_HPP
+
+#include "local_communicator.hpp"
+#include "mpi_communicator.hpp"
+#include "distributed_function.hpp"
+
+#endif
@@ -0,0 +1,212 @@
+/**
+ * @file core/distributed/distributed_function.hpp
+ *
+ * A wrapper that lets an ensmallen optimizer train a function over data that
+ * is split across several processes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTRIBUTED_DISTRIBUTED_FUNCTION_HPP
+#define MLPACK_CORE_DISTRIBUTED_DISTRIBUTED_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "local_communicator.hpp"
+
+namespace mlpack {
+
+/**
+ * DistributedFunction wraps a differentiable (and optionally separable)
+ * objective function, such as `FFN`, `LogisticRegressionFunction` or
+ * `SoftmaxRegressionFunction`, so that it can be optimized with ensmallen when
+ * the data is split across several processes.  Every process (rank) holds its
+ * own shard of the data in its own `FunctionType` object, and runs the same
+ * optimizer on a DistributedFunction wrapping it.  Each time the optimizer
+ * evaluates the objective or gradient, every rank computes it on its local
+ * shard, and the results are averaged over all ranks with an allreduce, so
+ * every rank takes exactly the same optimizer step.
+ *
+ * For the separable overloads (used by SGD-like optimizers), `NumFunctions()`
+ * is the smallest number of local points over all ranks, so that every rank
+ * makes the same number of steps per epoch; `Shuffle()` shuffles each shard
+ * locally, so over several epochs all the local points are used.
+ *
+ * The coordinates must be the same on every rank when the optimization
+ * starts; use `Synchronize()` to copy those of rank 0 to all the others.  For
+ * example, with MPI:
+ *
+ * @code
+ * #define MLPACK_USE_MPI
+ * #include <mlpack.hpp>
+ *
+ * MPI_Init(&argc, &argv);
+ * // Each rank loads its own shard of the data.
+ * arma::mat data; arma::Row<size_t> labels;
+ * ...
+ * LogisticRegressionFunction<> lrf(data, labels, 0.001);
+ * DistributedFunction<LogisticRegressionFunction<>, MPICommunicator> f(lrf);
+ *
+ * arma::mat coordinates(1, data.n_rows + 1, arma::fill::randn);
+ * f.Synchronize(coordinates);
+ * ens::SGD<> sgd(0.01, 32);
+ * sgd.Optimize(f, coordinates);
+ * MPI_Finalize();
+ * @endcode
+ *
+ * An FFN can be wrapped in the same way, after calling `ResetData()` and
+ * `Reset()` on it, and optimizing `Parameters()` directly.
+ *
+ * @tparam FunctionType Type of the function to wrap.
+ * @tparam CommunicatorType Type of the communicator between processes (e.g.
+ *     MPICommunicator, or LocalCommunicator for a single process).
+ * @tparam MatType Type of the coordinates.
+ */
+template<typename FunctionType,
+         typename CommunicatorType = LocalCommunicator,
+         typename MatType = arma::mat>
+class DistributedFunction
+{
+ public:
+  //! The element type of the coordinates.
+  using ElemType = typename MatType::elem_type;
+
+  /**
+   * Wrap the given function, which holds the local shard of the data.  This
+   * is a collective operation: all ranks must construct their
+   * DistributedFunction at the same time.
+   *
+   * @param function Function to wrap; it must outlive this object.
+   * @param communicator Communicator between the processes.
+   */
+  DistributedFunction(FunctionType& function,
+                      CommunicatorType communicator = CommunicatorType());
+
+  /**
+   * Copy the coordinates of rank 0 to every other rank.  The coordinates must
+   * have the same size on all ranks.
+   */
+  void Synchronize(MatType& coordinates) const;
+
+  //! Evaluate the objective on all the data.
+  ElemType Evaluate(const MatType& coordinates);
+
+  //! Compute the gradient of the objective on all the data.
+  void Gradient(const MatType& coordinates, MatType& gradient);
+
+  //! Compute the objective and its gradient on all the data.
+  ElemType EvaluateWithGradient(const MatType& coordinates, MatType& gradient);
+
+  /**
+   * Evaluate the objective on the batch of `batchSize` local points starting
+   * at `begin` on each rank.
+   */
+  ElemType Evaluate(const MatType& coordinates,
+                    const size_t begin,
+                    const size_t batchSize);
+
+  /**
+   * Compute the gradient of the objective on the batch of `batchSize` local
+   * points starting at `begin` on each rank.
+   */
+  void Gradient(const MatType& coordinates,
+                const size_t begin,
+                MatType& gradient,
+                const size_t batchSize);
+
+  /**
+   * Compute the objective and its gradient on the batch of `batchSize` local
+   * points starting at `begin` on each rank.
+   */
+  ElemType EvaluateWithGradient(const MatType& coordinates,
+                                const size_t begin,
+                                MatType& gradient,
+                                const size_t batchSize);
+
+  //! Get the number of separable functions: the smallest number of local
+  //! points over all ranks.
+  size_t NumFunctions() const { return numFunctions; }
+
+  //! Shuffle the local points.
+  void Shuffle() { function.Shuffle(); }
+
+  //! Get the wrapped function.
+  const FunctionType& Function() const { return function; }
+  //! Modify the wrapped function.
+  FunctionType& Function() { return function; }
+
+  //! Get the communicator.
+  const CommunicatorType& Communicator() const { return communicator; }
+
+ private:
+  //! Average the objective over all ranks.
+  ElemType Average(const ElemType objective) const;
+  //! Average the gradient over all ranks.
+  void Average(MatType& gradient) const;
+
+  //! Compute the objective and gradient with the wrapped function's
+  //! EvaluateWithGradient(), if it has one.
+  template<typename F>
+  static auto LocalEvaluateWithGradient(F& f,
+                                        const MatType& coordinates,
+                                        MatType& gradient,
+                                        int)
+      -> decltype(f.EvaluateWithGradient(coordinates, gradient));
+  //! Otherwise, use Evaluate() and Gradient().
+  template<typename F>
+  static ElemType LocalEvaluateWithGradient(F& f,
+                                            const MatType& coordinates,
+                                            MatType& gradient,
+                                            long);
+
+  //! Compute the gradient with the wrapped function's Gradient(), if it has
+  //! one.
+  template<typename F>
+  static auto LocalGradient(F& f,
+                            const MatType& coordinates,
+                            MatType& gradient,
+                            int)
+      -> decltype(f.Gradient(coordinates, gradient));
+  //! Otherwise, use EvaluateWithGradient().
+  template<typename F>
+  static void LocalGradient(F& f,
+                            const MatType& coordinates,
+                            MatType& gradient,
+                            long);
+
+  //! Separable version of LocalEvaluateWithGradient().
+  template<typename F>
+  static auto LocalEvaluateWithGradient(F& f,
+                                        const MatType& coordinates,
+                                        const size_t begin,
+                                        MatType& gradient,
+                                        const size_t batchSize,
+                                        int)
+      -> decltype(f.EvaluateWithGradient(coordinates, begin, gradient,
+          batchSize));
+  //! Separable version of LocalEvaluateWithGradient() that uses Evaluate()
+  //! and Gradient().
+  template<typename F>
+  static ElemType LocalEvaluateWithGradient(F& f,
+                                            const MatType& coordinates,
+                                            const size_t begin,
+                                            MatType& gradient,
+                                            const size_t batchSize,
+                                            long);
+
+  //! The wrapped function.
+  FunctionType& function;
+  //! The communicator between processes.
+  CommunicatorType communicator;
+  //! The smallest number of local points over all ranks.
+  size_t numFunctions;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "distributed_function_impl.hpp"
+
+#endif
@@ -0,0 +1,202 @@
+/**
+ * @file core/distributed/distributed_function_impl.hpp
+ *
+ * Implementation of DistributedFunction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTRIBUTED_DISTRIBUTED_FUNCTION_IMPL_HPP
+#define MLPACK_CORE_DISTRIBUTED_DISTRIBUTED_FUNCTION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "distributed_function.hpp"
+
+namespace mlpack {
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+DistributedFunction<FunctionType, CommunicatorType, MatType>::
+DistributedFunction(FunctionType& function, CommunicatorType communicator) :
+    function(function),
+    communicator(std::move(communicator))
+{
+  // Every rank must make the same number of steps in each epoch.
+  numFunctions = this->communicator.AllReduceMin(function.NumFunctions());
+}
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+void DistributedFunction<FunctionType, CommunicatorType, MatType>::Synchronize(
+    MatType& coordinates) const
+{
+  communicator.Broadcast(coordinates, 0);
+}
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+typename MatType::elem_type
+DistributedFunction<FunctionType, CommunicatorType, MatType>::Evaluate(
+    const MatType& coordinates)
+{
+  return Average(function.Evaluate(coordinates));
+}
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+void DistributedFunction<FunctionType, CommunicatorType, MatType>::Gradient(
+    const MatType& coordinates, MatType& gradient)
+{
+  LocalGradient(function, coordinates, gradient, 0);
+  Average(gradient);
+}
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+typename MatType::elem_type
+DistributedFunction<FunctionType, CommunicatorType, MatType>::
+EvaluateWithGradient(const MatType& coordinates, MatType& gradient)
+{
+  const ElemType objective = LocalEvaluateWithGradient(function, coordinates,
+      gradient, 0);
+  Average(gradient);
+  return Average(objective);
+}
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+typename MatType::elem_type
+DistributedFunction<FunctionType, CommunicatorType, MatType>::Evaluate(
+    const MatType& coordinates,
+    const size_t begin,
+    const size_t batchSize)
+{
+  return Average(function.Evaluate(coordinates, begin, batchSize));
+}
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+void DistributedFunction<FunctionType, CommunicatorType, MatType>::Gradient(
+    const MatType& coordinates,
+    const size_t begin,
+    MatType& gradient,
+    const size_t batchSize)
+{
+  function.Gradient(coordinates, begin, gradient, batchSize);
+  Average(gradient);
+}
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+typename MatType::elem_type
+DistributedFunction<FunctionType, CommunicatorType, MatType>::
+EvaluateWithGradient(const MatType& coordinates,
+                     const size_t begin,
+                     MatType& gradient,
+                     const size_t batchSize)
+{
+  const ElemType objective = LocalEvaluateWithGradient(function, coordinates,
+      begin, gradient, batchSize, 0);
+  Average(gradient);
+  return Average(objective);
+}
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+typename MatType::elem_type
+DistributedFunction<FunctionType, CommunicatorType, MatType>::Average(
+    const ElemType objective) const
+{
+  if (communicator.Size() == 1)
+    return objective;
+
+  return communicator.AllReduceSum(objective) / ElemType(communicator.Size());
+}
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+void DistributedFunction<FunctionType, CommunicatorType, MatType>::Average(
+    MatType& gradient) const
+{
+  if (communicator.Size() == 1)
+    return;
+
+  communicator.AllReduceSum(gradient);
+  gradient /= ElemType(communicator.Size());
+}
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+template<typename F>
+auto DistributedFunction<FunctionType, CommunicatorType, MatType>::
+LocalEvaluateWithGradient(F& f,
+                          const MatType& coordinates,
+                          MatType& gradient,
+                          int)
+    -> decltype(f.EvaluateWithGradient(coordinates, gradient))
+{
+  return f.EvaluateWithGradient(coordinates, gradient);
+}
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+template<typename F>
+typename MatType::elem_type
+DistributedFunction<FunctionType, CommunicatorType, MatType>::
+LocalEvaluateWithGradient(F& f,
+                          const MatType& coordinates,
+                          MatType& gradient,
+                          long)
+{
+  const ElemType objective = f.Evaluate(coordinates);
+  f.Gradient(coordinates, gradient);
+  return objective;
+}
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+template<typename F>
+auto DistributedFunction<FunctionType, CommunicatorType, MatType>::
+LocalGradient(F& f,
+              const MatType& coordinates,
+              MatType& gradient,
+              int)
+    -> decltype(f.Gradient(coordinates, gradient))
+{
+  f.Gradient(coordinates, gradient);
+}
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+template<typename F>
+void DistributedFunction<FunctionType, CommunicatorType, MatType>::
+LocalGradient(F& f,
+              const MatType& coordinates,
+              MatType& gradient,
+              long)
+{
+  f.EvaluateWithGradient(coordinates, gradient);
+}
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+template<typename F>
+auto DistributedFunction<FunctionType, CommunicatorType, MatType>::
+LocalEvaluateWithGradient(F& f,
+                          const MatType& coordinates,
+                          const size_t begin,
+                          MatType& gradient,
+                          const size_t batchSize,
+                          int)
+    -> decltype(f.EvaluateWithGradient(coordinates, begin, gradient,
+        batchSize))
+{
+  return f.EvaluateWithGradient(coordinates, begin, gradient, batchSize);
+}
+
+template<typename FunctionType, typename CommunicatorType, typename MatType>
+template<typename F>
+typename MatType::elem_type
+DistributedFunction<FunctionType, CommunicatorType, MatType>::
+LocalEvaluateWithGradient(F& f,
+                          const MatType& coordinates,
+                          const size_t begin,
+                          MatType& gradient,
+                          const size_t batchSize,
+                          long)
+{
+  const ElemType objective = f.Evaluate(coordinates, begin, batchSize);
+  f.Gradient(coordinates, begin, gradient, batchSize);
+  return objective;
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * @file core/distributed/local_communicator.hpp
+ *
+ * A communicator for DistributedFunction that runs in a single process.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTRIBUTED_LOCAL_COMMUNICATOR_HPP
+#define MLPACK_CORE_DISTRIBUTED_LOCAL_COMMUNICATOR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The LocalCommunicator is a communicator with a single rank; all of its
+ * collective operations are no-ops.  A DistributedFunction that uses it behaves
+ * exactly like the function it wraps, so it can be used to test distributed
+ * code without MPI.
+ *
+ * Any communicator used with DistributedFunction must provide the same
+ * interface: `Rank()`, `Size()`, `AllReduceSum()` for matrices and scalars,
+ * `AllReduceMin()` for sizes, and `Broadcast()` for matrices.
+ */
+class LocalCommunicator
+{
+ public:
+  //! Get the rank of this process.
+  size_t Rank() const { return 0; }
+  //! Get the number of processes.
+  size_t Size() const { return 1; }
+
+  //! Replace each element of `m` with its sum over all processes.
+  template<typename MatType>
+  void AllReduceSum(MatType& /* m */) const { }
+
+  //! Return the sum of `value` over all processes.
+  template<typename ElemType>
+  ElemType AllReduceSum(const ElemType value) const { return value; }
+
+  //! Return the minimum of `value` over all processes.
+  size_t AllReduceMin(const size_t value) const { return value; }
+
+  //! Replace `m` with the matrix `m` of process `root`.
+  template<typename MatType>
+  void Broadcast(MatType& /* m */, const size_t /* root */ = 0) const { }
+};
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * @file core/distributed/mpi_communicator.hpp
+ *
+ * A communicator for DistributedFunction that uses MPI.  This is only
+ * available if MLPACK_USE_MPI is defined before mlpack is included, in which
+ * case the program must be compiled and linked against an MPI implementation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTRIBUTED_MPI_COMMUNICATOR_HPP
+#define MLPACK_CORE_DISTRIBUTED_MPI_COMMUNICATOR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#ifdef MLPACK_USE_MPI
+
+#include <mpi.h>
+
+namespace mlpack {
+
+/**
+ * The MPICommunicator performs the collective operations needed by
+ * DistributedFunction over an MPI communicator (by default, MPI_COMM_WORLD).
+ * MPI must be initialized (with MPI_Init()) before the communicator is used,
+ * and finalized by the user afterwards.
+ *
+ * All collective operations must be called by every process of the
+ * communicator in the same order, with matrices of the same size.  An MPI
+ * error results in a std::runtime_error.
+ */
+class MPICommunicator
+{
+ public:
+  /**
+   * Create the communicator.
+   *
+   * @param comm MPI communicator to use.
+   */
+  MPICommunicator(MPI_Comm comm = MPI_COMM_WORLD) : comm(comm)
+  {
+    int rank, size;
+    Check(MPI_Comm_rank(comm, &rank), "MPI_Comm_rank()");
+    Check(MPI_Comm_size(comm, &size), "MPI_Comm_size()");
+    this->rank = (size_t) rank;
+    this->size = (size_t) size;
+  }
+
+  //! Get the rank of this process.
+  size_t Rank() const { return rank; }
+  //! Get the number of processes.
+  size_t Size() const { return size; }
+
+  //! Replace each element of `m` with its sum over all processes.
+  template<typename MatType>
+  void AllReduceSum(MatType& m) const
+  {
+    using ElemType = typename MatType::elem_type;
+    Check(MPI_Allreduce(MPI_IN_PLACE, m.memptr(), (int) m.n_elem,
+        Type<ElemType>(), MPI_SUM, comm), "MPI_Allreduce()");
+  }
+
+  //! Return the sum of `value` over all processes.
+  template<typename ElemType>
+  ElemType AllReduceSum(const ElemType value) const
+  {
+    ElemType result = value;
+    Check(MPI_Allreduce(MPI_IN_PLACE, &result, 1, Type<ElemType>(), MPI_SUM,
+        comm), "MPI_Allreduce()");
+    return result;
+  }
+
+  //! Return the minimum of `value` over all processes.
+  size_t AllReduceMin(const size_t value) const
+  {
+    unsigned long long result = value;
+    Check(MPI_Allreduce(MPI_IN_PLACE, &result, 1, MPI_UNSIGNED_LONG_LONG,
+        MPI_MIN, comm), "MPI_Allreduce()");
+    return (size_t) result;
+  }
+
+  //! Replace `m` with the matrix `m` of process `root`.  `m` must already
+  //! have the same size on every process.
+  template<typename MatType>
+  void Broadcast(MatType& m, const size_t root = 0) const
+  {
+    using ElemType = typename MatType::elem_type;
+    Check(MPI_Bcast(m.memptr(), (int) m.n_elem, Type<ElemType>(), (int) root,
+        comm), "MPI_Bcast()");
+  }
+
+ private:
+  //! Get the MPI datatype corresponding to ElemType.
+  template<typename ElemType>
+  static MPI_Datatype Type()
+  {
+    static_assert(std::is_same_v<ElemType, float> ||
+        std::is_same_v<ElemType, double>, "MPICommunicator: only float and "
+        "double elements are supported.");
+    return std::is_same_v<ElemType, float> ? MPI_FLOAT : MPI_DOUBLE;
+  }
+
+  //! Throw an exception if an MPI call failed.
+  static void Check(const int result, const std::string& call)
+  {
+    if (result != MPI_SUCCESS)
+    {
+      throw std::runtime_error("MPICommunicator: " + call + " failed with "
+          "error code " + std::to_string(result) + "!");
+    }
+  }
+
+  //! The MPI communicator.
+  MPI_Comm comm;
+  //! The rank of this process.
+  size_t rank;
+  //! The number of processes.
+  size_t size;
+};
+
+} // namespace mlpack
+
+#endif
+
+#endif
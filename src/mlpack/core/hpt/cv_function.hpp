@@ -72,6 +72,22 @@ class CVFunction
    */
   double Evaluate(const arma::mat& parameters);
 
+  /**
+   * Run cross-validation with the bound and passed parameters, training on
+   * only the first `trainingFraction` of the training data (see
+   * KFoldCV::EvaluateSubset()), and store the trained model in `model`.  The
+   * best model is not updated, so this can be called from several threads at
+   * the same time.
+   *
+   * @param parameters Arguments (rather than the bound arguments) that should
+   *     be passed into the EvaluateSubset method of the CVType object.
+   * @param trainingFraction Fraction of the training data to train on.
+   * @param model Pointer to store the trained model in.
+   */
+  double EvaluateSubset(const arma::mat& parameters,
+                        const double trainingFraction,
+                        std::unique_ptr<MLAlgorithm>& model);
+
   /**
    * Evaluate numerically the gradient of the CVFunction with the given
    * parameters.
@@ -125,35 +141,45 @@ class CVFunction
   double minDelta;
 
   /**
-   * Collect all arguments and run cross-validation.
+   * Collect all arguments and pass them to the given function.
    */
   template<size_t BoundArgIndex,
            size_t ParamIndex,
+           typename FunctionType,
            typename... Args,
            typename =
                std::enable_if_t<(BoundArgIndex + ParamIndex < TotalArgs)>>
-  inline double Evaluate(const arma::mat& parameters, const Args&... args);
+  inline double Evaluate(const arma::mat& parameters,
+                         const FunctionType& function,
+                         const Args&... args);
 
   /**
-   * Run cross-validation with the collected arguments.
+   * Run the given function (which runs cross-validation) with the collected
+   * arguments.
    */
   template<size_t BoundArgIndex,
            size_t ParamIndex,
+           typename FunctionType,
            typename... Args,
            typename =
                std::enable_if_t<BoundArgIndex + ParamIndex == TotalArgs>,
            typename = void>
-  inline double Evaluate(const arma::mat& parameters, const Args&... args);
+  inline double Evaluate(const arma::mat& parameters,
+                         const FunctionType& function,
+                         const Args&... args);
 
   /**
    * Put the bound argument (at the BoundArgIndex position) as the next one.
    */
   template<size_t BoundArgIndex,
            size_t ParamIndex,
+           typename FunctionType,
            typename... Args,
            typename = std::enable_if_t<
                UseBoundArg<BoundArgIndex, ParamIndex>::value>>
-  inline double PutNextArg(const arma::mat& parameters, const Args&... args);
+  inline double PutNextArg(const arma::mat& parameters,
+                           const FunctionType& function,
+                           const Args&... args);
 
   /**
    * Put the element (at the ParamIndex position) of the parameters as the next
@@ -161,11 +187,14 @@ class CVFunction
    */
   template<size_t BoundArgIndex,
            size_t ParamIndex,
+           typename FunctionType,
            typename... Args,
            typename = std::enable_if_t<
                !UseBoundArg<BoundArgIndex, ParamIndex>::value>,
            typename = void>
-  inline double PutNextArg(const arma::mat& parameters, const Args&... args);
+  inline double PutNextArg(const arma::mat& parameters,
+                           const FunctionType& function,
+                           const Args&... args);
 };
 
 
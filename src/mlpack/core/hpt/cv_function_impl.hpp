@@ -64,7 +64,36 @@ template<typename CVType,
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& parameters)
 {
-  return Evaluate<0, 0>(parameters);
+  return Evaluate<0, 0>(parameters, [this](const auto&... args)
+  {
+    double objective = cv.Evaluate(args...);
+
+    // Change the best model if we have got a better score, or if we probably
+    // have not assigned any valid (trained) model yet.
+    if (bestObjective > objective ||
+        bestObjective == std::numeric_limits<double>::max())
+    {
+      bestObjective = objective;
+      bestModel = std::move(cv.Model());
+    }
+
+    return objective;
+  });
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::EvaluateSubset(
+    const arma::mat& parameters,
+    const double trainingFraction,
+    std::unique_ptr<MLAlgorithm>& model)
+{
+  return Evaluate<0, 0>(parameters, [&](const auto&... args)
+  {
+    return cv.EvaluateSubset(trainingFraction, model, args...);
+  });
 }
 
 template<typename CVType,
@@ -94,13 +123,15 @@ template<typename CVType,
          typename... BoundArgs>
 template<size_t BoundArgIndex,
          size_t ParamIndex,
+         typename FunctionType,
          typename... Args,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& parameters,
+    const FunctionType& function,
     const Args&... args)
 {
-  return PutNextArg<BoundArgIndex, ParamIndex>(parameters, args...);
+  return PutNextArg<BoundArgIndex, ParamIndex>(parameters, function, args...);
 }
 
 template<typename CVType,
@@ -109,25 +140,16 @@ template<typename CVType,
          typename... BoundArgs>
 template<size_t BoundArgIndex,
          size_t ParamIndex,
+         typename FunctionType,
          typename... Args,
          typename,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& /* parameters */,
+    const FunctionType& function,
     const Args&... args)
 {
-  double objective = cv.Evaluate(args...);
-
-  // Change the best model if we have got a better score, or if we probably
-  // have not assigned any valid (trained) model yet.
-  if (bestObjective > objective ||
-      bestObjective == std::numeric_limits<double>::max())
-  {
-    bestObjective = objective;
-    bestModel = std::move(cv.Model());
-  }
-
-  return objective;
+  return function(args...);
 }
 
 template<typename CVType,
@@ -136,14 +158,16 @@ template<typename CVType,
          typename... BoundArgs>
 template<size_t BoundArgIndex,
          size_t ParamIndex,
+         typename FunctionType,
          typename... Args,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::PutNextArg(
     const arma::mat& parameters,
+    const FunctionType& function,
     const Args&... args)
 {
-  return Evaluate<BoundArgIndex + 1, ParamIndex>(
-      parameters, args..., std::get<BoundArgIndex>(boundArgs).value);
+  return Evaluate<BoundArgIndex + 1, ParamIndex>(parameters, function,
+      args..., std::get<BoundArgIndex>(boundArgs).value);
 }
 
 template<typename CVType,
@@ -152,22 +176,25 @@ template<typename CVType,
          typename... BoundArgs>
 template<size_t BoundArgIndex,
          size_t ParamIndex,
+         typename FunctionType,
          typename... Args,
          typename,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::PutNextArg(
     const arma::mat& parameters,
+    const FunctionType& function,
     const Args&... args)
 {
   if (datasetInfo.Type(ParamIndex) == data::Datatype::categorical)
   {
-    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, args...,
-        datasetInfo.UnmapString(size_t(parameters(ParamIndex, 0)), ParamIndex));
+    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, function,
+        args..., datasetInfo.UnmapString(size_t(parameters(ParamIndex, 0)),
+        ParamIndex));
   }
   else
   {
-    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, args...,
-        parameters(ParamIndex, 0));
+    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, function,
+        args..., parameters(ParamIndex, 0));
   }
 }
 
@@ -150,6 +150,50 @@ class HyperParameterTuner
    */
   double& MinDelta() { return minDelta; }
 
+  /**
+   * Get the number of sets of hyper-parameters that are evaluated at the same
+   * time when GridSearch is used.
+   *
+   * The default value is 1.
+   */
+  size_t NumThreads() const { return numThreads; }
+
+  /**
+   * Modify the number of sets of hyper-parameters that are evaluated at the
+   * same time when GridSearch is used.  With OpenMP, the points of the grid
+   * are then trained and evaluated in parallel, on the same splits of the data
+   * (which are views, so each thread only adds the memory of one model).
+   * Other optimizers are sequential, so this is ignored for them.
+   *
+   * The default value is 1.
+   */
+  size_t& NumThreads() { return numThreads; }
+
+  /**
+   * Get the rate of successive halving when GridSearch is used (0 if
+   * successive halving is not used).
+   *
+   * The default value is 0.
+   */
+  size_t HalvingRate() const { return halvingRate; }
+
+  /**
+   * Modify the rate of successive halving when GridSearch is used.  With a
+   * rate eta of at least 2, the points of the grid are first evaluated with
+   * models trained on a small fraction of the training data; only the best
+   * 1 / eta of them are kept, and evaluated again with eta times more
+   * training data, and so on until the last few points are evaluated with all
+   * the training data.  With n points, there are floor(log_eta(n)) + 1 rounds,
+   * and the first one uses a fraction eta^(-floor(log_eta(n))) of the training
+   * data.  This is much cheaper than evaluating every point with all the data,
+   * and finds the same best point as long as the ranking of the points with
+   * small training sets is roughly the same as with the full training set.
+   * Values below 2 disable successive halving; other optimizers ignore it.
+   *
+   * The default value is 0.
+   */
+  size_t& HalvingRate() { return halvingRate; }
+
   /**
    * Find the best hyper-parameters by using the given Optimizer. For each
    * hyper-parameter one of the following should be passed as an argument.
@@ -228,6 +272,12 @@ class HyperParameterTuner
    */
   double minDelta;
 
+  //! The number of sets of hyper-parameters evaluated at the same time.
+  size_t numThreads;
+
+  //! The rate of successive halving (0 if it is not used).
+  size_t halvingRate;
+
   /**
    * A type function to check whether the element I of the tuple type is a
    * PreFixedArg.
@@ -322,6 +372,18 @@ class HyperParameterTuner
       data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo,
       FixedArgs... fixedArgs);
 
+  /**
+   * Evaluate all the points of the grid given by numCategories with the given
+   * CVFunction (in parallel, and with successive halving if it is enabled),
+   * store the best point in bestParams and the corresponding model in
+   * bestModel, and return the (minimized) objective of the best point.
+   * Numeric dimensions keep the value they have in bestParams.
+   */
+  template<typename CVFunctionType>
+  double ParallelGridSearch(CVFunctionType& cvFunction,
+                            arma::mat& bestParams,
+                            const arma::Row<size_t>& numCategories);
+
   /**
    * Gather all elements of vector in an argument list and use them to create a
    * tuple.
@@ -14,6 +14,8 @@
 
 #include <mlpack/core.hpp>
 
+#include <exception>
+
 namespace mlpack {
 
 template<typename MLAlgorithm,
@@ -31,7 +33,11 @@ HyperParameterTuner<MLAlgorithm,
                     MatType,
                     PredictionsType,
                     WeightsType>::HyperParameterTuner(const CVArgs&... args) :
-    cv(args...), relativeDelta(0.01), minDelta(1e-10) {}
+    cv(args...),
+    relativeDelta(0.01),
+    minDelta(1e-10),
+    numThreads(1),
+    halvingRate(0) {}
 
 template<typename MLAlgorithm,
          typename Metric,
@@ -103,6 +109,20 @@ void HyperParameterTuner<MLAlgorithm,
 
   CVFunction<CVType, MLAlgorithm, totalArgs, FixedArgs...>
       cvFunction(cv, datasetInfo, relativeDelta, minDelta, fixedArgs...);
+
+  // A grid can be searched in parallel, and with successive halving; the
+  // other optimizers evaluate one point after another.
+  if constexpr (std::is_same<Optimizer, ens::GridSearch>::value)
+  {
+    if (numThreads > 1 || halvingRate >= 2)
+    {
+      const double objective = ParallelGridSearch(cvFunction, bestParams,
+          numCategories);
+      bestObjective = Metric::NeedsMinimization ? objective : -objective;
+      return;
+    }
+  }
+
   bestObjective = Metric::NeedsMinimization ? optimizer.Optimize(cvFunction,
       bestParams, categoricalDimensions, numCategories) :
       -optimizer.Optimize(cvFunction, bestParams, categoricalDimensions,
@@ -110,6 +130,139 @@ void HyperParameterTuner<MLAlgorithm,
       bestModel = std::move(cvFunction.BestModel());
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename Optimizer,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename CVFunctionType>
+double HyperParameterTuner<MLAlgorithm,
+                           Metric,
+                           CV,
+                           Optimizer,
+                           MatType,
+                           PredictionsType,
+                           WeightsType>::ParallelGridSearch(
+    CVFunctionType& cvFunction,
+    arma::mat& bestParams,
+    const arma::Row<size_t>& numCategories)
+{
+  // Enumerate the points of the grid in the order GridSearch visits them: the
+  // first dimension changes fastest.
+  size_t numPoints = 1;
+  for (size_t d = 0; d < numCategories.n_elem; ++d)
+    numPoints *= std::max(numCategories[d], (size_t) 1);
+
+  arma::mat points(bestParams.n_rows, numPoints);
+  for (size_t p = 0; p < numPoints; ++p)
+  {
+    size_t index = p;
+    for (size_t d = 0; d < numCategories.n_elem; ++d)
+    {
+      if (numCategories[d] == 0)
+      {
+        points(d, p) = bestParams(d);
+      }
+      else
+      {
+        points(d, p) = index % numCategories[d];
+        index /= numCategories[d];
+      }
+    }
+  }
+
+  // With successive halving, the first round uses a fraction
+  // halvingRate^(-lastRound) of the training data.
+  size_t lastRound = 0;
+  if (halvingRate >= 2)
+  {
+    for (size_t n = halvingRate; n <= numPoints; n *= halvingRate)
+      ++lastRound;
+  }
+
+  std::vector<size_t> remaining(numPoints);
+  for (size_t p = 0; p < numPoints; ++p)
+    remaining[p] = p;
+
+  std::unique_ptr<MLAlgorithm> bestModelPtr;
+  double bestPointObjective = std::numeric_limits<double>::infinity();
+  size_t bestPoint = 0;
+  for (size_t round = 0; round <= lastRound; ++round)
+  {
+    const bool finalRound = (round == lastRound);
+    const double trainingFraction = finalRound ? 1.0 :
+        std::pow((double) halvingRate, (double) round - (double) lastRound);
+
+    arma::vec objectives(remaining.size());
+
+    // An exception cannot leave an OpenMP loop, so the first one is rethrown
+    // after the loop.
+    std::exception_ptr exception;
+
+    #pragma omp parallel for schedule(dynamic) \
+        num_threads(std::max(numThreads, (size_t) 1))
+    for (size_t i = 0; i < remaining.size(); ++i)
+    {
+      try
+      {
+        std::unique_ptr<MLAlgorithm> model;
+        objectives[i] = cvFunction.EvaluateSubset(points.col(remaining[i]),
+            trainingFraction, model);
+        // Invalid objectives rank last.
+        if (std::isnan(objectives[i]))
+          objectives[i] = std::numeric_limits<double>::infinity();
+
+        if (finalRound)
+        {
+          #pragma omp critical
+          {
+            // Ties go to the first point of the grid, so that the result does
+            // not depend on the order of evaluation.
+            if (!bestModelPtr || objectives[i] < bestPointObjective ||
+                (objectives[i] == bestPointObjective &&
+                 remaining[i] < bestPoint))
+            {
+              bestPointObjective = objectives[i];
+              bestPoint = remaining[i];
+              bestModelPtr = std::move(model);
+            }
+          }
+        }
+      }
+      catch (...)
+      {
+        #pragma omp critical
+        {
+          if (!exception)
+            exception = std::current_exception();
+        }
+      }
+    }
+
+    if (exception)
+      std::rethrow_exception(exception);
+
+    if (!finalRound)
+    {
+      // Keep the best 1 / halvingRate of the points, in grid order.
+      const size_t numKept = (remaining.size() + halvingRate - 1) /
+          halvingRate;
+      const arma::uvec order = arma::stable_sort_index(objectives);
+      std::vector<size_t> kept(numKept);
+      for (size_t i = 0; i < numKept; ++i)
+        kept[i] = remaining[order[i]];
+      std::sort(kept.begin(), kept.end());
+      remaining = std::move(kept);
+    }
+  }
+
+  bestParams = points.col(bestPoint);
+  bestModel = std::move(*bestModelPtr);
+  return bestPointObjective;
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          template<typename, typename, typename, typename, typename> class CV,
@@ -15,6 +15,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/distances/lmetric.hpp>
 #include <mlpack/core/kernels/kernel_traits.hpp>
+#include <mlpack/core/kernels/pairwise_distances.hpp>
 
 namespace mlpack {
 
@@ -67,6 +68,23 @@ class CauchyKernel
         std::pow(EuclideanDistance::Evaluate(a, b) / bandwidth, 2)));
   }
 
+  /**
+   * Batch evaluation of the Cauchy kernel between each column of a and each
+   * column of b, for dense matrices, from the squared distances given by
+   * PairwiseSquaredDistances().
+   *
+   * @param a First set of points (or a single point).
+   * @param b Second set of points.
+   * @param kernels Matrix (or row vector) to store the kernel values in.
+   */
+  template<typename MatTypeA, typename MatTypeB, typename OutMatType>
+  void Evaluate(const MatTypeA& a, const MatTypeB& b, OutMatType& kernels)
+  {
+    using ElemType = typename OutMatType::elem_type;
+    PairwiseSquaredDistances(a, b, kernels);
+    kernels = 1 / (1 + kernels / ElemType(bandwidth * bandwidth));
+  }
+
   /**
    * Serialize the kernel.
    */
@@ -93,6 +111,10 @@ class KernelTraits<CauchyKernel>
  public:
   //! The Cauchy kernel is normalized: K(x, x) = 1 for all x.
   static const bool IsNormalized = true;
+  //! The Cauchy kernel includes a squared distance.
+  static const bool UsesSquaredDistance = true;
+  //! The Cauchy kernel has a batch Evaluate() function.
+  static const bool HasBatchEvaluate = true;
 };
 
 } // namespace mlpack
@@ -40,6 +40,21 @@ class CosineSimilarity
   template<typename VecTypeA, typename VecTypeB>
   static double Evaluate(const VecTypeA& a, const VecTypeB& b);
 
+  /**
+   * Computes the cosine similarity between each column of a and each column of
+   * b, for dense matrices; the dot products are computed with one matrix
+   * multiplication and then divided by the norms of the points.  Like for a
+   * single pair of points, the similarity with a point of norm 0 is 0.
+   *
+   * @param a First set of points (or a single point).
+   * @param b Second set of points.
+   * @param kernels Matrix (or row vector) to store the similarities in.
+   */
+  template<typename MatTypeA, typename MatTypeB, typename OutMatType>
+  static void Evaluate(const MatTypeA& a,
+                       const MatTypeB& b,
+                       OutMatType& kernels);
+
   //! Serialize the class (there's nothing to save).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
@@ -55,6 +70,9 @@ class KernelTraits<CosineSimilarity>
 
   //! The cosine kernel doesn't include a squared distance.
   static const bool UsesSquaredDistance = false;
+
+  //! The cosine kernel has a batch Evaluate() function.
+  static const bool HasBatchEvaluate = true;
 };
 
 // This name is deprecated and can be removed in mlpack 5.0.0.
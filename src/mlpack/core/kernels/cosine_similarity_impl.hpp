@@ -31,6 +31,25 @@ double CosineSimilarity::Evaluate(const VecTypeA& a, const VecTypeB& b)
     return dot(a, b) / denominator;
 }
 
+template<typename MatTypeA, typename MatTypeB, typename OutMatType>
+void CosineSimilarity::Evaluate(const MatTypeA& a,
+                                const MatTypeB& b,
+                                OutMatType& kernels)
+{
+  using ElemType = typename OutMatType::elem_type;
+
+  const arma::Col<ElemType> aNorms = arma::sqrt(arma::sum(arma::square(a),
+      0)).t();
+  const arma::Row<ElemType> bNorms = arma::sqrt(arma::sum(arma::square(b), 0));
+
+  kernels = a.t() * b;
+  kernels /= aNorms * bNorms;
+
+  // The dot product with a point of norm 0 is 0, so these similarities are
+  // 0 / 0.
+  kernels.replace(arma::datum::nan, ElemType(0));
+}
+
 } // namespace mlpack
 
 #endif
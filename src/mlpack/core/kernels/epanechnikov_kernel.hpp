@@ -14,6 +14,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/kernels/kernel_traits.hpp>
+#include <mlpack/core/kernels/pairwise_distances.hpp>
 
 namespace mlpack {
 
@@ -50,6 +51,19 @@ class EpanechnikovKernel
   template<typename VecTypeA, typename VecTypeB>
   double Evaluate(const VecTypeA& a, const VecTypeB& b) const;
 
+  /**
+   * Evaluate the Epanechnikov kernel between each column of a and each column
+   * of b, for dense matrices, from the squared distances given by
+   * PairwiseSquaredDistances().
+   *
+   * @param a First set of points (or a single point).
+   * @param b Second set of points.
+   * @param kernels Matrix (or row vector) to store the kernel values in.
+   */
+  template<typename MatTypeA, typename MatTypeB, typename OutMatType>
+  void Evaluate(const MatTypeA& a, const MatTypeB& b, OutMatType& kernels)
+      const;
+
   /**
    * Evaluate the Epanechnikov kernel given that the distance between the two
    * input points is known.
@@ -101,6 +115,8 @@ class KernelTraits<EpanechnikovKernel>
   static const bool IsNormalized = true;
   //! The Epanechnikov kernel includes a squared distance.
   static const bool UsesSquaredDistance = true;
+  //! The Epanechnikov kernel has a batch Evaluate() function.
+  static const bool HasBatchEvaluate = true;
 };
 
 } // namespace mlpack
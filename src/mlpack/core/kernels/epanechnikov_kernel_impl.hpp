@@ -28,6 +28,17 @@ inline double EpanechnikovKernel::Evaluate(const VecTypeA& a, const VecTypeB& b)
       * inverseBandwidthSquared);
 }
 
+template<typename MatTypeA, typename MatTypeB, typename OutMatType>
+inline void EpanechnikovKernel::Evaluate(const MatTypeA& a,
+                                         const MatTypeB& b,
+                                         OutMatType& kernels) const
+{
+  using ElemType = typename OutMatType::elem_type;
+  PairwiseSquaredDistances(a, b, kernels);
+  kernels = arma::clamp(1 - ElemType(inverseBandwidthSquared) * kernels,
+      ElemType(0), std::numeric_limits<ElemType>::max());
+}
+
 /**
  * Compute the normalizer of this Epanechnikov kernel for the given dimension.
  *
@@ -17,6 +17,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/distances/lmetric.hpp>
 #include <mlpack/core/kernels/kernel_traits.hpp>
+#include <mlpack/core/kernels/pairwise_distances.hpp>
 
 namespace mlpack {
 
@@ -67,6 +68,26 @@ class GaussianKernel
     return std::exp(gamma * SquaredEuclideanDistance::Evaluate(a, b));
   }
 
+  /**
+   * Batch evaluation of the Gaussian kernel between each column of a and each
+   * column of b, for dense matrices: kernels(i, j) = Evaluate(a.col(i),
+   * b.col(j)).  The squared distances are obtained with one matrix
+   * multiplication (see PairwiseSquaredDistances()).  If a is a single point
+   * and kernels is a row vector, the kernel between a and every column of b is
+   * computed.
+   *
+   * @param a First set of points (or a single point).
+   * @param b Second set of points.
+   * @param kernels Matrix (or row vector) to store the kernel values in.
+   */
+  template<typename MatTypeA, typename MatTypeB, typename OutMatType>
+  void Evaluate(const MatTypeA& a, const MatTypeB& b, OutMatType& kernels) const
+  {
+    using ElemType = typename OutMatType::elem_type;
+    PairwiseSquaredDistances(a, b, kernels);
+    kernels = arma::exp(ElemType(gamma) * kernels);
+  }
+
   /**
    * Evaluation of the Gaussian kernel given the distance between two points.
    *
@@ -143,6 +164,8 @@ class KernelTraits<GaussianKernel>
   static const bool IsNormalized = true;
   //! The Gaussian kernel includes a squared distance.
   static const bool UsesSquaredDistance = true;
+  //! The Gaussian kernel has a batch Evaluate() function.
+  static const bool HasBatchEvaluate = true;
 };
 
 } // namespace mlpack
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_KERNELS_HYPERBOLIC_TANGENT_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
 
 namespace mlpack {
 
@@ -61,6 +62,22 @@ class HyperbolicTangentKernel
     return tanh(scale * dot(a, b) + offset);
   }
 
+  /**
+   * Batch evaluation of the hyperbolic tangent kernel between each column of a
+   * and each column of b, for dense matrices; the dot products are computed
+   * with one matrix multiplication.
+   *
+   * @param a First set of points (or a single point).
+   * @param b Second set of points.
+   * @param kernels Matrix (or row vector) to store the kernel values in.
+   */
+  template<typename MatTypeA, typename MatTypeB, typename OutMatType>
+  void Evaluate(const MatTypeA& a, const MatTypeB& b, OutMatType& kernels)
+  {
+    using ElemType = typename OutMatType::elem_type;
+    kernels = arma::tanh(ElemType(scale) * (a.t() * b) + ElemType(offset));
+  }
+
   //! Get scale factor.
   double Scale() const { return scale; }
   //! Modify scale factor.
@@ -84,6 +101,19 @@ class HyperbolicTangentKernel
   double offset;
 };
 
+//! Kernel traits for the hyperbolic tangent kernel.
+template<>
+class KernelTraits<HyperbolicTangentKernel>
+{
+ public:
+  //! The hyperbolic tangent kernel is not normalized.
+  static const bool IsNormalized = false;
+  //! The hyperbolic tangent kernel doesn't include a squared distance.
+  static const bool UsesSquaredDistance = false;
+  //! The hyperbolic tangent kernel has a batch Evaluate() function.
+  static const bool HasBatchEvaluate = true;
+};
+
 } // namespace mlpack
 
 #endif
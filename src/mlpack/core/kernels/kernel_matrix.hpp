@@ -0,0 +1,75 @@
+/**
+ * @file core/kernels/kernel_matrix.hpp
+ *
+ * Functions to compute kernel matrices (between two sets of points, or between
+ * all pairs of points of a set), in parallel and in blocks, with vectorized
+ * evaluation for the kernels that are functions of distances or dot products.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "kernel_traits.hpp"
+
+namespace mlpack {
+
+/**
+ * Compute the kernel matrix between the points of `a` and the points of `b`:
+ * `kernelMatrix(i, j) = kernel.Evaluate(a.col(i), b.col(j))`.
+ *
+ * For dense data and kernels with a batch Evaluate() function (see
+ * KernelTraits::HasBatchEvaluate), the whole matrix is computed by that
+ * function; for mlpack's kernels, it computes the dot products (and, from
+ * them, the squared distances) of all pairs of points with one matrix
+ * multiplication, and applies the kernel to all of them at once.  For other
+ * kernels, the kernel is evaluated on blocks of the matrix in parallel, so its
+ * Evaluate() function must be safe to call from several threads at once (this
+ * is the case for all of mlpack's kernels).
+ *
+ * @param kernel Kernel to evaluate.
+ * @param a First set of points (one column per point).
+ * @param b Second set of points (one column per point).
+ * @param kernelMatrix Matrix to store the kernel values in (a.n_cols x
+ *     b.n_cols).
+ */
+template<typename KernelType, typename MatType, typename OutMatType>
+void KernelMatrix(KernelType& kernel,
+                  const MatType& a,
+                  const MatType& b,
+                  OutMatType& kernelMatrix);
+
+/**
+ * Compute the (symmetric) kernel matrix between all pairs of points of
+ * `data`: `kernelMatrix(i, j) = kernel.Evaluate(data.col(i), data.col(j))`.
+ * This uses the batch evaluation of the kernel, like the other overload, when
+ * possible; otherwise only the upper triangle of the matrix is evaluated (in
+ * parallel blocks) and then mirrored.
+ *
+ * @param kernel Kernel to evaluate.
+ * @param data Set of points (one column per point).
+ * @param kernelMatrix Matrix to store the kernel values in (data.n_cols x
+ *     data.n_cols).
+ */
+template<typename KernelType, typename MatType, typename OutMatType>
+void KernelMatrix(KernelType& kernel,
+                  const MatType& data,
+                  OutMatType& kernelMatrix);
+
+/**
+ * The size of the square blocks of the kernel matrix that are evaluated by one
+ * thread at a time, when the kernel has no vectorized evaluation.
+ */
+constexpr size_t KernelMatrixBlockSize = 64;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "kernel_matrix_impl.hpp"
+
+#endif
@@ -0,0 +1,119 @@
+/**
+ * @file core/kernels/kernel_matrix_impl.hpp
+ *
+ * Implementation of the kernel matrix functions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_IMPL_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kernel_matrix.hpp"
+
+namespace mlpack {
+
+/**
+ * If true, KernelMatrix() uses the batch Evaluate() function of the kernel on
+ * matrices of type MatType.
+ */
+template<typename KernelType, typename MatType>
+struct UseBatchKernelMatrix
+{
+  static const bool value = KernelTraits<KernelType>::HasBatchEvaluate &&
+      !arma::is_SpMat<MatType>::value;
+};
+
+/**
+ * Evaluate the kernel on every pair of points, in parallel over square blocks
+ * of the kernel matrix.  If `symmetric` is true, `a` and `b` are the same set
+ * of points and only the upper triangle is evaluated.
+ */
+template<typename KernelType, typename MatType, typename OutMatType>
+void BlockedKernelMatrix(KernelType& kernel,
+                         const MatType& a,
+                         const MatType& b,
+                         OutMatType& kernelMatrix,
+                         const bool symmetric)
+{
+  kernelMatrix.set_size(a.n_cols, b.n_cols);
+
+  const size_t rowBlocks = (a.n_cols + KernelMatrixBlockSize - 1) /
+      KernelMatrixBlockSize;
+  const size_t colBlocks = (b.n_cols + KernelMatrixBlockSize - 1) /
+      KernelMatrixBlockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t block = 0; block < rowBlocks * colBlocks; ++block)
+  {
+    const size_t rowBlock = block % rowBlocks;
+    const size_t colBlock = block / rowBlocks;
+    if (symmetric && rowBlock > colBlock)
+      continue;
+
+    const size_t rowBegin = rowBlock * KernelMatrixBlockSize;
+    const size_t rowEnd = std::min((size_t) a.n_cols,
+        rowBegin + KernelMatrixBlockSize);
+    const size_t colBegin = colBlock * KernelMatrixBlockSize;
+    const size_t colEnd = std::min((size_t) b.n_cols,
+        colBegin + KernelMatrixBlockSize);
+
+    for (size_t j = colBegin; j < colEnd; ++j)
+    {
+      const size_t end = symmetric ? std::min(rowEnd, j + 1) : rowEnd;
+      for (size_t i = rowBegin; i < end; ++i)
+        kernelMatrix(i, j) = kernel.Evaluate(a.col(i), b.col(j));
+    }
+  }
+
+  // Copy to the lower triangular part of the matrix.
+  if (symmetric)
+    kernelMatrix = arma::symmatu(kernelMatrix);
+}
+
+template<typename KernelType, typename MatType, typename OutMatType>
+void KernelMatrix(KernelType& kernel,
+                  const MatType& a,
+                  const MatType& b,
+                  OutMatType& kernelMatrix)
+{
+  if (a.n_rows != b.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "KernelMatrix(): dimensionality of first set of points ("
+        << a.n_rows << ") does not match dimensionality of second set of "
+        << "points (" << b.n_rows << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if constexpr (UseBatchKernelMatrix<KernelType, MatType>::value)
+  {
+    kernel.Evaluate(a, b, kernelMatrix);
+  }
+  else
+  {
+    BlockedKernelMatrix(kernel, a, b, kernelMatrix, false);
+  }
+}
+
+template<typename KernelType, typename MatType, typename OutMatType>
+void KernelMatrix(KernelType& kernel,
+                  const MatType& data,
+                  OutMatType& kernelMatrix)
+{
+  if constexpr (UseBatchKernelMatrix<KernelType, MatType>::value)
+  {
+    kernel.Evaluate(data, data, kernelMatrix);
+  }
+  else
+  {
+    BlockedKernelMatrix(kernel, data, data, kernelMatrix, true);
+  }
+}
+
+} // namespace mlpack
+
+#endif
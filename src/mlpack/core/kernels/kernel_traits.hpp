@@ -35,6 +35,14 @@ class KernelTraits
    * If true, then the kernel include a squared distance, ||x - y||^2 .
    */
   static const bool UsesSquaredDistance = false;
+
+  /**
+   * If true, then the kernel has a batch Evaluate(a, b, kernels) function,
+   * which computes kernels(i, j) = Evaluate(a.col(i), b.col(j)) for two dense
+   * matrices a and b (or, if a is a single point and kernels a row vector, the
+   * kernel between a and each column of b) faster than evaluating each pair.
+   */
+  static const bool HasBatchEvaluate = false;
 };
 
 } // namespace mlpack
@@ -27,4 +27,6 @@
 #include "spherical_kernel.hpp"
 #include "triangular_kernel.hpp"
 
+#include "kernel_matrix.hpp"
+
 #endif
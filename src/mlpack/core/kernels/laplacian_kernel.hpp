@@ -13,6 +13,8 @@
 #define MLPACK_CORE_KERNELS_LAPLACIAN_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
+#include <mlpack/core/kernels/pairwise_distances.hpp>
 
 namespace mlpack {
 
@@ -55,6 +57,24 @@ class LaplacianKernel
     return std::exp(-EuclideanDistance::Evaluate(a, b) / bandwidth);
   }
 
+  /**
+   * Batch evaluation of the Laplacian kernel between each column of a and each
+   * column of b, for dense matrices, from the squared distances given by
+   * PairwiseSquaredDistances().  The result is the same as
+   * kernels(i, j) = Evaluate(a.col(i), b.col(j)).
+   *
+   * @param a First set of points (or a single point).
+   * @param b Second set of points.
+   * @param kernels Matrix (or row vector) to store the kernel values in.
+   */
+  template<typename MatTypeA, typename MatTypeB, typename OutMatType>
+  void Evaluate(const MatTypeA& a, const MatTypeB& b, OutMatType& kernels) const
+  {
+    using ElemType = typename OutMatType::elem_type;
+    PairwiseSquaredDistances(a, b, kernels);
+    kernels = arma::exp(-arma::sqrt(kernels) / ElemType(bandwidth));
+  }
+
   /**
    * Evaluation of the Laplacian kernel given the distance between two points.
    *
@@ -108,6 +128,8 @@ class KernelTraits<LaplacianKernel>
   static const bool IsNormalized = true;
   //! The Laplacian kernel doesn't include a squared distance.
   static const bool UsesSquaredDistance = false;
+  //! The Laplacian kernel has a batch Evaluate() function.
+  static const bool HasBatchEvaluate = true;
 };
 
 } // namespace mlpack
@@ -15,6 +15,8 @@
 #define MLPACK_CORE_KERNELS_LINEAR_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/distances/dense_distances.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
 
 namespace mlpack {
 
@@ -39,7 +41,8 @@ class LinearKernel
 
   /**
    * Simple evaluation of the dot product.  This evaluation uses Armadillo's
-   * dot() function.
+   * dot() function, except for dense vectors of `float` or `double`, where a
+   * simple loop that the compiler can vectorize is used.
    *
    * @tparam VecTypeA Type of first vector (should be arma::vec or
    *      arma::sp_vec).
@@ -51,7 +54,28 @@ class LinearKernel
   template<typename VecTypeA, typename VecTypeB>
   static double Evaluate(const VecTypeA& a, const VecTypeB& b)
   {
-    return dot(a, b);
+    if constexpr (UseDenseDistances<VecTypeA, VecTypeB>::value)
+      return DenseDot(DenseMemory(a), DenseMemory(b), a.n_elem);
+    else
+      return dot(a, b);
+  }
+
+  /**
+   * Batch evaluation of the linear kernel (the dot product) between each
+   * column of a and each column of b, with one matrix multiplication.  If a is
+   * a single point and kernels is a row vector, the dot products of a with
+   * every column of b are computed.
+   *
+   * @param a First set of points (or a single point).
+   * @param b Second set of points.
+   * @param kernels Matrix (or row vector) to store the kernel values in.
+   */
+  template<typename MatTypeA, typename MatTypeB, typename OutMatType>
+  static void Evaluate(const MatTypeA& a,
+                       const MatTypeB& b,
+                       OutMatType& kernels)
+  {
+    kernels = a.t() * b;
   }
 
   //! Serialize the kernel (it has no members... do nothing).
@@ -59,6 +83,19 @@ class LinearKernel
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
 };
 
+//! Kernel traits for the linear kernel.
+template<>
+class KernelTraits<LinearKernel>
+{
+ public:
+  //! The linear kernel is not normalized.
+  static const bool IsNormalized = false;
+  //! The linear kernel doesn't include a squared distance.
+  static const bool UsesSquaredDistance = false;
+  //! The linear kernel has a batch Evaluate() function.
+  static const bool HasBatchEvaluate = true;
+};
+
 } // namespace mlpack
 
 #endif
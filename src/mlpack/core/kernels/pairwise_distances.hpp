@@ -0,0 +1,58 @@
+/**
+ * @file core/kernels/pairwise_distances.hpp
+ *
+ * PairwiseSquaredDistances(), which computes the squared Euclidean distances
+ * between all pairs of columns of two dense matrices with one matrix
+ * multiplication.  It is used by the batch Evaluate() functions of the kernels
+ * that depend on the distance between points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_PAIRWISE_DISTANCES_HPP
+#define MLPACK_CORE_KERNELS_PAIRWISE_DISTANCES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Compute the squared Euclidean distance between each column of `a` and each
+ * column of `b`, using
+ *
+ *   || a_i - b_j ||^2 = || a_i ||^2 + || b_j ||^2 - 2 a_i^T b_j,
+ *
+ * so that all the dot products are given by one matrix multiplication.
+ * Rounding may make some of the distances slightly negative, so they are
+ * clamped to 0; if `a` and `b` are the same object, the diagonal is set to
+ * exactly 0.
+ *
+ * @param a First set of (dense) points, one per column.
+ * @param b Second set of (dense) points, one per column.
+ * @param distances Matrix to store the distances in (a.n_cols x b.n_cols).
+ */
+template<typename MatTypeA, typename MatTypeB, typename OutMatType>
+void PairwiseSquaredDistances(const MatTypeA& a,
+                              const MatTypeB& b,
+                              OutMatType& distances)
+{
+  using ElemType = typename OutMatType::elem_type;
+
+  const arma::Col<ElemType> aNorms = arma::sum(arma::square(a), 0).t();
+  const arma::Row<ElemType> bNorms = arma::sum(arma::square(b), 0);
+
+  distances = a.t() * b;
+  distances *= ElemType(-2);
+  distances.each_col() += aNorms;
+  distances.each_row() += bNorms;
+  distances.clamp(ElemType(0), std::numeric_limits<ElemType>::max());
+
+  if ((const void*) &a == (const void*) &b)
+    distances.diag().zeros();
+}
+
+} // namespace mlpack
+
+#endif
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_KERNELS_POLYNOMIAL_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
 
 namespace mlpack {
 
@@ -56,6 +57,22 @@ class PolynomialKernel
     return std::pow((dot(a, b) + offset), degree);
   }
 
+  /**
+   * Batch evaluation of the polynomial kernel between each column of a and
+   * each column of b, for dense matrices; the dot products are computed with
+   * one matrix multiplication.
+   *
+   * @param a First set of points (or a single point).
+   * @param b Second set of points.
+   * @param kernels Matrix (or row vector) to store the kernel values in.
+   */
+  template<typename MatTypeA, typename MatTypeB, typename OutMatType>
+  void Evaluate(const MatTypeA& a, const MatTypeB& b, OutMatType& kernels) const
+  {
+    using ElemType = typename OutMatType::elem_type;
+    kernels = arma::pow(a.t() * b + ElemType(offset), ElemType(degree));
+  }
+
   //! Get the degree of the polynomial.
   const double& Degree() const { return degree; }
   //! Modify the degree of the polynomial.
@@ -81,6 +98,19 @@ class PolynomialKernel
   double offset;
 };
 
+//! Kernel traits for the polynomial kernel.
+template<>
+class KernelTraits<PolynomialKernel>
+{
+ public:
+  //! The polynomial kernel is not normalized.
+  static const bool IsNormalized = false;
+  //! The polynomial kernel doesn't include a squared distance.
+  static const bool UsesSquaredDistance = false;
+  //! The polynomial kernel has a batch Evaluate() function.
+  static const bool HasBatchEvaluate = true;
+};
+
 } // namespace mlpack
 
 #endif
@@ -16,8 +16,8 @@
 #ifndef MLPACK_CORE_KERNELS_PSPECTRUM_STRING_KERNEL_HPP
 #define MLPACK_CORE_KERNELS_PSPECTRUM_STRING_KERNEL_HPP
 
-#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <mlpack/prereqs.hpp>
@@ -60,6 +60,15 @@ namespace mlpack {
  * the data according to the fake data matrix -- resulting in a meaningless
  * tree.  This kernel was originally written for the FastMKS method; so, at the
  * very least, it will work with that.
+ *
+ * At construction time, the substrings of length p (after conversion to
+ * lowercase; substrings with characters that are not alphanumeric are ignored)
+ * of each string are mapped to integer IDs and counted, in parallel over the
+ * strings of each dataset.  Each string is then represented by the sorted list
+ * of the IDs of its substrings, with their counts, so that a kernel evaluation
+ * is a sparse dot product of two such lists.  For p <= 12, the ID of a
+ * substring is an exact encoding of it; for larger p, it is a 64-bit hash, so
+ * two different substrings have the same ID with negligible probability.
  */
 class PSpectrumStringKernel
 {
@@ -89,12 +98,29 @@ class PSpectrumStringKernel
   template<typename VecType>
   double Evaluate(const VecType& a, const VecType& b) const;
 
+  /**
+   * Get the number of times the given substring (which should be of length p)
+   * appears in the given string.  The substring is converted to lowercase.
+   *
+   * @param dataset Index of the dataset.
+   * @param index Index of the string in the dataset.
+   * @param substring Substring to count.
+   */
+  inline size_t Count(const size_t dataset,
+                      const size_t index,
+                      const std::string& substring) const;
+
+  /**
+   * The substrings of a string: for each distinct substring, its ID and the
+   * number of times it appears, sorted by ID.
+   */
+  using SubstringCounts = std::vector<std::pair<uint64_t, size_t>>;
+
   //! Access the lists of substrings.
-  const std::vector<std::vector<std::map<std::string, int> > >& Counts() const
+  const std::vector<std::vector<SubstringCounts>>& Counts() const
   { return counts; }
   //! Modify the lists of substrings.
-  std::vector<std::vector<std::map<std::string, int> > >& Counts()
-  { return counts; }
+  std::vector<std::vector<SubstringCounts>>& Counts() { return counts; }
 
   //! Access the value of p.
   size_t P() const { return p; }
@@ -102,9 +128,19 @@ class PSpectrumStringKernel
   size_t& P() { return p; }
 
  private:
-  //! Mappings of the datasets to counts of substrings.  Such a huge structure
-  //! is not wonderful...
-  std::vector<std::vector<std::map<std::string, int> > > counts;
+  /**
+   * Compute the ID of the substring of length p that starts at the given
+   * character, or return false if it contains characters that are not
+   * alphanumeric.
+   */
+  inline bool SubstringID(const char* substring, uint64_t& id) const;
+
+  //! Compute the counts of the substrings of the given string.
+  inline void ExtractSubstrings(const std::string& str,
+                                SubstringCounts& strCounts) const;
+
+  //! Counts of the substrings of each string of each dataset.
+  std::vector<std::vector<SubstringCounts>> counts;
 
   //! The value of p to use in calculation.
   size_t p;
@@ -31,8 +31,8 @@ inline PSpectrumStringKernel::PSpectrumStringKernel(
         "PSpectrumStringKernel::PSpectrumStringKernel(): p must be positive");
   }
 
-  // We have to assemble the counts of substrings.  This is not a particularly
-  // fast operation, unfortunately, but it only needs to be done once.
+  // We have to assemble the counts of substrings.  This only needs to be done
+  // once, and the strings are independent, so they are processed in parallel.
   Log::Info << "Assembling counts of substrings of length " << p << "."
       << std::endl;
 
@@ -46,41 +46,9 @@ inline PSpectrumStringKernel::PSpectrumStringKernel(
     // Resize for number of strings in dataset.
     counts[dataset].resize(set.size());
 
-    // Inspect each string in the dataset.
+    #pragma omp parallel for schedule(dynamic, 64)
     for (size_t index = 0; index < set.size(); ++index)
-    {
-      // Convenience references.
-      const std::string& str = set[index];
-      std::map<std::string, int>& mapping = counts[dataset][index];
-
-      size_t start = 0;
-      while ((start + p) <= str.length())
-      {
-        std::string sub = str.substr(start, p);
-
-        // Convert all characters to lowercase.
-        bool invalid = false;
-        for (size_t j = 0; j < p; ++j)
-        {
-          if (!isalnum(sub[j]))
-          {
-            invalid = true;
-            break; // Only consider substrings with alphanumerics.
-          }
-
-          sub[j] = tolower(sub[j]);
-        }
-
-        // Increment position in string.
-        ++start;
-
-        if (!invalid)
-        {
-          // Add to the map.
-          ++mapping[sub];
-        }
-      }
-    }
+      ExtractSubstrings(set[index], counts[dataset][index]);
   }
   Log::Info << "Substring extraction complete." << std::endl;
 }
@@ -99,44 +67,110 @@ template<typename VecType>
 double PSpectrumStringKernel::Evaluate(const VecType& a,
                                        const VecType& b) const
 {
-  // Get the map of substrings for the two strings we are interested in.
-  const std::map<std::string, int>& aMap = counts[a[0]][a[1]];
-  const std::map<std::string, int>& bMap = counts[b[0]][b[1]];
+  // Get the substrings of the two strings we are interested in.
+  const SubstringCounts& aCounts = counts[(size_t) a[0]][(size_t) a[1]];
+  const SubstringCounts& bCounts = counts[(size_t) b[0]][(size_t) b[1]];
 
   double eval = 0;
 
-  // Loop through the two maps (which, when iterated through, are sorted
-  // alphabetically).
-  std::map<std::string, int>::const_iterator aIt = aMap.begin();
-  std::map<std::string, int>::const_iterator bIt = bMap.begin();
-
-  while ((aIt != aMap.end()) && (bIt != bMap.end()))
+  // Loop through the two lists, which are sorted by substring ID; only the
+  // substrings that appear in both contribute.
+  size_t i = 0, j = 0;
+  while ((i < aCounts.size()) && (j < bCounts.size()))
   {
-    // Compare alphabetically (this is how std::map is ordered).
-    int result = (*aIt).first.compare((*bIt).first);
-
-    if (result == 0) // The same substring.
+    if (aCounts[i].first == bCounts[j].first) // The same substring.
     {
-      eval += ((*aIt).second * (*bIt).second);
-
-      // Now increment both.
-      ++aIt;
-      ++bIt;
+      eval += (double) (aCounts[i].second * bCounts[j].second);
+      ++i;
+      ++j;
     }
-    else if (result > 0)
+    else if (aCounts[i].first > bCounts[j].first)
     {
-      // aIt is "ahead" of bIt (alphabetically); so increment bIt to "catch up".
-      ++bIt;
+      // a is "ahead" of b; so increment j to "catch up".
+      ++j;
     }
     else
     {
-      // bIt is "ahead" of aIt (alphabetically); so increment aIt to "catch up".
-      ++aIt;
+      // b is "ahead" of a; so increment i to "catch up".
+      ++i;
     }
   }
 
   return eval;
 }
+
+inline size_t PSpectrumStringKernel::Count(const size_t dataset,
+                                           const size_t index,
+                                           const std::string& substring) const
+{
+  uint64_t id;
+  if (substring.length() != p || !SubstringID(substring.data(), id))
+    return 0;
+
+  const SubstringCounts& strCounts = counts[dataset][index];
+  SubstringCounts::const_iterator it = std::lower_bound(strCounts.begin(),
+      strCounts.end(), std::make_pair(id, size_t(0)));
+
+  return (it != strCounts.end() && it->first == id) ? it->second : 0;
+}
+
+inline bool PSpectrumStringKernel::SubstringID(const char* substring,
+                                               uint64_t& id) const
+{
+  // For p <= 12, the ID is the lowercase substring written in base 36 (with
+  // digits '0'-'9' then 'a'-'z'), which fits in 64 bits.  Otherwise, it is the
+  // 64-bit FNV-1a hash of the lowercase substring.
+  const bool exact = (p <= 12);
+  id = exact ? 0 : 14695981039346656037ULL;
+  for (size_t j = 0; j < p; ++j)
+  {
+    const char c = substring[j];
+    uint64_t digit;
+    if (c >= '0' && c <= '9')
+      digit = c - '0';
+    else if (c >= 'a' && c <= 'z')
+      digit = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'Z')
+      digit = c - 'A' + 10;
+    else
+      return false; // Only consider substrings with alphanumerics.
+
+    if (exact)
+      id = 36 * id + digit;
+    else
+      id = (id ^ digit) * 1099511628211ULL;
+  }
+
+  return true;
+}
+
+inline void PSpectrumStringKernel::ExtractSubstrings(
+    const std::string& str,
+    SubstringCounts& strCounts) const
+{
+  strCounts.clear();
+  if (str.length() < p)
+    return;
+
+  // Collect the IDs of all the substrings, then sort them and count each
+  // distinct ID.
+  std::vector<uint64_t> ids;
+  ids.reserve(str.length() - p + 1);
+  uint64_t id;
+  for (size_t start = 0; start + p <= str.length(); ++start)
+    if (SubstringID(str.data() + start, id))
+      ids.push_back(id);
+
+  std::sort(ids.begin(), ids.end());
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    if (strCounts.empty() || strCounts.back().first != ids[i])
+      strCounts.push_back(std::make_pair(ids[i], size_t(1)));
+    else
+      ++strCounts.back().second;
+  }
+}
+
 } // namespace mlpack
 
 #endif
@@ -11,6 +11,8 @@
 #define MLPACK_CORE_KERNELS_SPHERICAL_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
+#include <mlpack/core/kernels/pairwise_distances.hpp>
 
 namespace mlpack {
 
@@ -54,6 +56,25 @@ class SphericalKernel
         1.0 : 0.0;
   }
 
+  /**
+   * Batch evaluation of the spherical kernel between each column of a and
+   * each column of b, for dense matrices: kernels(i, j) is 1 if the two points
+   * are within the bandwidth of each other, and 0 otherwise.
+   *
+   * @param a First set of points (or a single point).
+   * @param b Second set of points.
+   * @param kernels Matrix (or row vector) to store the kernel values in.
+   */
+  template<typename MatTypeA, typename MatTypeB, typename OutMatType>
+  void Evaluate(const MatTypeA& a, const MatTypeB& b, OutMatType& kernels) const
+  {
+    using ElemType = typename OutMatType::elem_type;
+    PairwiseSquaredDistances(a, b, kernels);
+    const ElemType threshold = ElemType(bandwidthSquared);
+    kernels.transform([threshold](const ElemType d)
+        { return (d <= threshold) ? ElemType(1) : ElemType(0); });
+  }
+
   double Normalizer(size_t dimension) const
   {
     return std::pow(bandwidth, (double) dimension) *
@@ -97,6 +118,8 @@ class KernelTraits<SphericalKernel>
   static const bool IsNormalized = true;
   //! The spherical kernel doesn't include a squared distance.
   static const bool UsesSquaredDistance = false;
+  //! The spherical kernel has a batch Evaluate() function.
+  static const bool HasBatchEvaluate = true;
 };
 
 } // namespace mlpack
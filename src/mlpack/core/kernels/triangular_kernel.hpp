@@ -14,6 +14,8 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/distances/lmetric.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
+#include <mlpack/core/kernels/pairwise_distances.hpp>
 
 namespace mlpack {
 
@@ -50,6 +52,24 @@ class TriangularKernel
     return std::max(0.0, (1 - EuclideanDistance::Evaluate(a, b) / bandwidth));
   }
 
+  /**
+   * Batch evaluation of the triangular kernel between each column of a and
+   * each column of b, for dense matrices, from the squared distances given by
+   * PairwiseSquaredDistances().
+   *
+   * @param a First set of points (or a single point).
+   * @param b Second set of points.
+   * @param kernels Matrix (or row vector) to store the kernel values in.
+   */
+  template<typename MatTypeA, typename MatTypeB, typename OutMatType>
+  void Evaluate(const MatTypeA& a, const MatTypeB& b, OutMatType& kernels) const
+  {
+    using ElemType = typename OutMatType::elem_type;
+    PairwiseSquaredDistances(a, b, kernels);
+    kernels = arma::clamp(1 - arma::sqrt(kernels) / ElemType(bandwidth),
+        ElemType(0), std::numeric_limits<ElemType>::max());
+  }
+
   /**
    * Evaluate the triangular kernel given that the distance between the two
    * points is known.
@@ -110,6 +130,8 @@ class KernelTraits<TriangularKernel>
   static const bool IsNormalized = true;
   //! The triangular kernel doesn't include a squared distance.
   static const bool UsesSquaredDistance = false;
+  //! The triangular kernel has a batch Evaluate() function.
+  static const bool HasBatchEvaluate = true;
 };
 
 } // namespace mlpack
@@ -40,9 +40,18 @@ inline arma::Mat<eT> ColumnCovariance(const arma::Mat<eT>& x,
     const size_t n = xAlias.n_cols;
     const eT normVal = (normType == 0) ? ((n > 1) ? eT(n - 1) : eT(1)) : eT(n);
 
-    const arma::Mat<eT> tmp = xAlias.each_col() - arma::mean(xAlias, 1);
+    // Center one block of points at a time, instead of a copy of the whole
+    // dataset.
+    const arma::Col<eT> mean = arma::mean(xAlias, 1);
+    const size_t blockSize = 4096;
+    out.zeros(xAlias.n_rows, xAlias.n_rows);
+    for (size_t begin = 0; begin < n; begin += blockSize)
+    {
+      const size_t end = std::min(begin + blockSize, n);
+      const arma::Mat<eT> tmp = xAlias.cols(begin, end - 1).each_col() - mean;
+      out += tmp * tmp.t();
+    }
 
-    out = tmp * tmp.t();
     out /= normVal;
   }
 
@@ -0,0 +1,189 @@
+/**
+ * @file core/math/column_moments.hpp
+ *
+ * Definition of the ColumnMoments class, which computes the mean, variance,
+ * skewness, kurtosis, minimum, maximum and (optionally) covariance of each
+ * dimension of a dataset in a single pass, given one block of points at a
+ * time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_COLUMN_MOMENTS_HPP
+#define MLPACK_CORE_MATH_COLUMN_MOMENTS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * ColumnMoments accumulates the central moments (up to the fourth), the
+ * minimum and the maximum of each dimension of a dataset (one point per
+ * column), and optionally the covariance matrix, without holding the dataset
+ * in memory: the blocks of points are given one at a time to Add(), and only
+ * one scan of the data is needed.  Partial results (e.g. of the blocks held by
+ * different threads or processes) can be combined with Merge(), in any order.
+ *
+ * The moments of each block are computed exactly (with a two-pass method on
+ * the block), and then merged with the pairwise update formulas of
+ *
+ * @code
+ * @techreport{pebay2008formulas,
+ *   title={Formulas for Robust, One-Pass Parallel Computation of Covariances
+ *       and Arbitrary-Order Statistical Moments},
+ *   author={P{\'e}bay, Philippe},
+ *   institution={Sandia National Laboratories},
+ *   number={SAND2008-6212},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * which are numerically stable even when the mean is large compared to the
+ * standard deviation.  Large blocks are split into sub-blocks that are
+ * processed in parallel with OpenMP; the result does not depend on the number
+ * of threads.
+ *
+ * @code
+ * ColumnMoments<arma::mat> moments(10);
+ * for (size_t i = 0; i < blocks.size(); ++i)
+ *   moments.Add(blocks[i]); // Each block has 10 rows.
+ * const arma::vec variances = moments.Variance();
+ * @endcode
+ *
+ * @tparam MatType Type of the blocks.
+ */
+template<typename MatType = arma::mat>
+class ColumnMoments
+{
+ public:
+  //! The element type of the blocks.
+  using ElemType = typename MatType::elem_type;
+  //! The type of the per-dimension statistics.
+  using ColType = typename GetColType<MatType>::type;
+
+  /**
+   * Create the statistics of an empty dataset with the given dimensionality.
+   * If the dimensionality is 0, it is set by the first call to Add().
+   *
+   * @param dimensionality Number of dimensions (rows) of the data.
+   * @param computeCovariance Whether to also accumulate the covariance matrix
+   *     (which takes O(d^2) memory and O(d^2) time per point).
+   */
+  ColumnMoments(const size_t dimensionality = 0,
+                const bool computeCovariance = false);
+
+  /**
+   * Add the given points (one per column) to the dataset.  A
+   * std::invalid_argument is thrown if the block does not have the right
+   * number of rows.
+   *
+   * @param block Points to add.
+   */
+  void Add(const MatType& block);
+
+  /**
+   * Add the points of the dataset described by `other` to this dataset.
+   *
+   * @param other Statistics to merge into these ones.
+   */
+  void Merge(const ColumnMoments& other);
+
+  //! Remove all the points of the dataset.
+  void Reset();
+
+  //! Get the number of points added so far.
+  size_t Count() const { return count; }
+  //! Get the number of dimensions of the data.
+  size_t Dimensionality() const { return mean.n_elem; }
+  //! Get whether the covariance matrix is accumulated.
+  bool ComputeCovariance() const { return computeCovariance; }
+
+  //! Get the mean of each dimension.
+  const ColType& Mean() const { return mean; }
+  //! Get the minimum of each dimension.
+  const ColType& Min() const { return min; }
+  //! Get the maximum of each dimension.
+  const ColType& Max() const { return max; }
+
+  /**
+   * Get the variance of each dimension.
+   *
+   * @param population If true, normalize by n (the population variance);
+   *     otherwise normalize by n - 1 (the sample variance).
+   */
+  ColType Variance(const bool population = false) const;
+
+  /**
+   * Get the standard deviation of each dimension.
+   *
+   * @param population If true, compute the population standard deviation;
+   *     otherwise compute the sample standard deviation.
+   */
+  ColType StandardDeviation(const bool population = false) const;
+
+  /**
+   * Get the skewness of each dimension.
+   *
+   * @param population If true, compute the population skewness; otherwise
+   *     compute the (adjusted) sample skewness.
+   */
+  ColType Skewness(const bool population = false) const;
+
+  /**
+   * Get the excess kurtosis of each dimension.
+   *
+   * @param population If true, compute the population excess kurtosis;
+   *     otherwise compute the (adjusted) sample excess kurtosis.
+   */
+  ColType Kurtosis(const bool population = false) const;
+
+  /**
+   * Get the covariance matrix of the data, which is the same as
+   * `ColumnCovariance()` of all the points.  A std::logic_error is thrown if
+   * the covariance is not accumulated.
+   *
+   * @param population If true, normalize by n; otherwise normalize by n - 1.
+   */
+  MatType Covariance(const bool population = false) const;
+
+  //! Serialize the statistics.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Compute the exact statistics of the given points, and merge them.
+  void AddBlock(const MatType& block);
+
+  //! The number of points in each sub-block.
+  static constexpr size_t blockSize = 1024;
+  //! The maximum number of sub-block groups that are processed in parallel.
+  static constexpr size_t maxGroups = 64;
+
+  //! Whether the covariance matrix is accumulated.
+  bool computeCovariance;
+  //! The number of points.
+  size_t count;
+  //! The mean of each dimension.
+  ColType mean;
+  //! The sum of the squared deviations from the mean of each dimension.
+  ColType m2;
+  //! The sum of the cubed deviations from the mean of each dimension.
+  ColType m3;
+  //! The sum of the fourth powers of the deviations from the mean.
+  ColType m4;
+  //! The minimum of each dimension.
+  ColType min;
+  //! The maximum of each dimension.
+  ColType max;
+  //! The sum of the outer products of the deviations from the mean.
+  MatType comoments;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "column_moments_impl.hpp"
+
+#endif
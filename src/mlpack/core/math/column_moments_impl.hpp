@@ -0,0 +1,245 @@
+/**
+ * @file core/math/column_moments_impl.hpp
+ *
+ * Implementation of the ColumnMoments class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_COLUMN_MOMENTS_IMPL_HPP
+#define MLPACK_CORE_MATH_COLUMN_MOMENTS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "column_moments.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+ColumnMoments<MatType>::ColumnMoments(const size_t dimensionality,
+                                      const bool computeCovariance) :
+    computeCovariance(computeCovariance),
+    count(0)
+{
+  mean.zeros(dimensionality);
+  Reset();
+}
+
+template<typename MatType>
+void ColumnMoments<MatType>::Add(const MatType& block)
+{
+  if (count == 0 && mean.n_elem == 0)
+  {
+    mean.zeros(block.n_rows);
+    Reset();
+  }
+
+  if (block.n_rows != mean.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "ColumnMoments::Add(): the block has " << block.n_rows
+        << " dimensions, but the data has " << mean.n_elem << " dimensions";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (block.n_cols <= blockSize)
+  {
+    AddBlock(block);
+    return;
+  }
+
+  // Split the block into contiguous groups of sub-blocks; each group is
+  // accumulated by one thread, and then the groups are merged in order, so
+  // that the result does not depend on the number of threads.
+  const size_t numBlocks = (block.n_cols + blockSize - 1) / blockSize;
+  const size_t numGroups = std::min(numBlocks, maxGroups);
+  std::vector<ColumnMoments> groups(numGroups,
+      ColumnMoments(mean.n_elem, computeCovariance));
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t g = 0; g < numGroups; ++g)
+  {
+    const size_t firstBlock = g * numBlocks / numGroups;
+    const size_t lastBlock = (g + 1) * numBlocks / numGroups;
+    for (size_t b = firstBlock; b < lastBlock; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t end = std::min(begin + blockSize, (size_t) block.n_cols);
+      groups[g].AddBlock(block.cols(begin, end - 1));
+    }
+  }
+
+  for (size_t g = 0; g < numGroups; ++g)
+    Merge(groups[g]);
+}
+
+template<typename MatType>
+void ColumnMoments<MatType>::Merge(const ColumnMoments& other)
+{
+  if (other.count == 0)
+    return;
+
+  if (mean.n_elem != 0 && other.Dimensionality() != mean.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "ColumnMoments::Merge(): the other data has "
+        << other.Dimensionality() << " dimensions, but this data has "
+        << mean.n_elem << " dimensions";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The covariance is only kept if both parts have it.
+  const bool keepCovariance = computeCovariance && other.computeCovariance;
+  if (count == 0)
+  {
+    *this = other;
+    computeCovariance = keepCovariance;
+    if (!computeCovariance)
+      comoments.reset();
+    return;
+  }
+
+  // The pairwise update formulas of Pébay (2008).  The higher moments are
+  // updated first, since they depend on the lower moments of both parts.
+  const ElemType nA = ElemType(count);
+  const ElemType nB = ElemType(other.count);
+  const ElemType n = nA + nB;
+  const ColType delta = other.mean - mean;
+  const ColType delta2 = arma::square(delta);
+
+  m4 += other.m4 + arma::square(delta2) * (nA * nB * (nA * nA - nA * nB +
+      nB * nB) / (n * n * n)) + 6 * delta2 % (nA * nA * other.m2 +
+      nB * nB * m2) / (n * n) + 4 * delta % (nA * other.m3 - nB * m3) / n;
+  m3 += other.m3 + delta2 % delta * (nA * nB * (nA - nB) / (n * n)) +
+      3 * delta % (nA * other.m2 - nB * m2) / n;
+  m2 += other.m2 + delta2 * (nA * nB / n);
+
+  computeCovariance = keepCovariance;
+  if (computeCovariance)
+    comoments += other.comoments + delta * delta.t() * (nA * nB / n);
+  else
+    comoments.reset();
+
+  mean += delta * (nB / n);
+  min = arma::min(min, other.min);
+  max = arma::max(max, other.max);
+  count += other.count;
+}
+
+template<typename MatType>
+void ColumnMoments<MatType>::Reset()
+{
+  const size_t d = mean.n_elem;
+  count = 0;
+  mean.zeros(d);
+  m2.zeros(d);
+  m3.zeros(d);
+  m4.zeros(d);
+  min.set_size(d);
+  min.fill(std::numeric_limits<ElemType>::max());
+  max.set_size(d);
+  max.fill(std::numeric_limits<ElemType>::lowest());
+  if (computeCovariance)
+    comoments.zeros(d, d);
+}
+
+template<typename MatType>
+typename ColumnMoments<MatType>::ColType ColumnMoments<MatType>::Variance(
+    const bool population) const
+{
+  const ElemType norm = population ? ElemType(count) :
+      ElemType((count > 1) ? count - 1 : 1);
+  return m2 / norm;
+}
+
+template<typename MatType>
+typename ColumnMoments<MatType>::ColType
+ColumnMoments<MatType>::StandardDeviation(const bool population) const
+{
+  return arma::sqrt(Variance(population));
+}
+
+template<typename MatType>
+typename ColumnMoments<MatType>::ColType ColumnMoments<MatType>::Skewness(
+    const bool population) const
+{
+  const ElemType n = ElemType(count);
+  const ColType s3 = arma::pow(StandardDeviation(population), 3);
+  if (population)
+    return m3 / (n * s3);
+  else
+    return n * m3 / ((n - 1) * (n - 2) * s3);
+}
+
+template<typename MatType>
+typename ColumnMoments<MatType>::ColType ColumnMoments<MatType>::Kurtosis(
+    const bool population) const
+{
+  const ElemType n = ElemType(count);
+  if (population)
+    return n * m4 / arma::square(m2) - 3;
+
+  const ColType s4 = arma::square(Variance(false));
+  const ElemType norm3 = 3 * (n - 1) * (n - 1) / ((n - 2) * (n - 3));
+  const ElemType normC = n * (n + 1) / ((n - 1) * (n - 2) * (n - 3));
+  return normC * m4 / s4 - norm3;
+}
+
+template<typename MatType>
+MatType ColumnMoments<MatType>::Covariance(const bool population) const
+{
+  if (!computeCovariance)
+  {
+    throw std::logic_error("ColumnMoments::Covariance(): the covariance is "
+        "not computed; set computeCovariance to true in the constructor");
+  }
+
+  const ElemType norm = population ? ElemType(count) :
+      ElemType((count > 1) ? count - 1 : 1);
+  return comoments / norm;
+}
+
+template<typename MatType>
+void ColumnMoments<MatType>::AddBlock(const MatType& block)
+{
+  if (block.n_cols == 0)
+    return;
+
+  ColumnMoments blockMoments;
+  blockMoments.computeCovariance = computeCovariance;
+  blockMoments.count = block.n_cols;
+  blockMoments.mean = arma::mean(block, 1);
+  blockMoments.min = arma::min(block, 1);
+  blockMoments.max = arma::max(block, 1);
+
+  const MatType centered = block.each_col() - blockMoments.mean;
+  const MatType squared = arma::square(centered);
+  blockMoments.m2 = arma::sum(squared, 1);
+  blockMoments.m3 = arma::sum(squared % centered, 1);
+  blockMoments.m4 = arma::sum(arma::square(squared), 1);
+  if (computeCovariance)
+    blockMoments.comoments = centered * centered.t();
+
+  Merge(blockMoments);
+}
+
+template<typename MatType>
+template<typename Archive>
+void ColumnMoments<MatType>::serialize(Archive& ar,
+                                       const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(computeCovariance));
+  ar(CEREAL_NVP(count));
+  ar(CEREAL_NVP(mean));
+  ar(CEREAL_NVP(m2));
+  ar(CEREAL_NVP(m3));
+  ar(CEREAL_NVP(m4));
+  ar(CEREAL_NVP(min));
+  ar(CEREAL_NVP(max));
+  ar(CEREAL_NVP(comoments));
+}
+
+} // namespace mlpack
+
+#endif
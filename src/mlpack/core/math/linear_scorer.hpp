@@ -0,0 +1,185 @@
+/**
+ * @file core/math/linear_scorer.hpp
+ *
+ * The LinearScorer class, which computes the class scores of linear models and
+ * selects the best label (or the k best labels) of points.  It is shared by the
+ * linear classifiers (LogisticRegression, SoftmaxRegression, LinearSVM and
+ * Perceptron).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_LINEAR_SCORER_HPP
+#define MLPACK_CORE_MATH_LINEAR_SCORER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The LinearScorer holds the weights of a linear multi-class model, laid out
+ * with one column per class (so that they need no transposition for
+ * single-point scoring, and can be given directly to GEMM for batches), and the
+ * bias of each class.  The score of class `c` for a point `x` is
+ * `dot(weights.col(c), x) + biases[c]`.
+ *
+ * It is meant for serving: the single-point Classify() does not allocate any
+ * memory, and the batch functions take the score matrix as an output buffer,
+ * which is reused between calls when its size does not change.
+ *
+ * The static ArgMax() and ComputeScores() kernels take any weights and biases
+ * objects (including Armadillo subviews) and are used by the linear models to
+ * classify points without building a LinearScorer.
+ *
+ * @code
+ * SoftmaxRegression sr(data, labels, numClasses);
+ * LinearScorer<> scorer = sr.Scorer();
+ *
+ * size_t label = scorer.Classify(point);
+ *
+ * arma::mat scores; // Reused by each call.
+ * arma::Mat<size_t> top3;
+ * scorer.TopK(batch, 3, top3, scores);
+ * @endcode
+ *
+ * @tparam MatType Type of matrix used to store the weights.
+ */
+template<typename MatType = arma::mat>
+class LinearScorer
+{
+ public:
+  //! The element type of the weights.
+  using ElemType = typename MatType::elem_type;
+  //! The type of the bias vector.
+  using ColType = arma::Col<ElemType>;
+
+  /**
+   * Create an empty scorer, with no classes.
+   */
+  LinearScorer() { }
+
+  /**
+   * Create a scorer with the given weights (one column per class) and biases
+   * (one per class).  If `biases` is empty, the biases are zero.  A
+   * std::invalid_argument is thrown if the number of biases does not match the
+   * number of classes.
+   *
+   * @param weights Weights of each class, one column per class.
+   * @param biases Bias of each class.
+   */
+  LinearScorer(const MatType& weights, const ColType& biases = ColType());
+
+  /**
+   * Create a scorer with the given weights (one column per class) and biases,
+   * taking ownership of them.
+   *
+   * @param weights Weights of each class, one column per class.
+   * @param biases Bias of each class.
+   */
+  LinearScorer(MatType&& weights, ColType&& biases);
+
+  /**
+   * Return the class with the highest score for the given point.  This does not
+   * allocate any memory.
+   *
+   * @param point Point to classify.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Compute the score of each class for each point (one column per point) into
+   * `scores`, which is only reallocated if it has the wrong size.
+   *
+   * @param data Points to score.
+   * @param scores Matrix to store the scores in (numClasses x data.n_cols).
+   */
+  template<typename DataType>
+  void Scores(const DataType& data, MatType& scores) const;
+
+  /**
+   * Return the class with the highest score for each point, using `scores` as
+   * a buffer for the scores.
+   *
+   * @param data Points to classify.
+   * @param labels Row to store the predicted labels in.
+   * @param scores Matrix to store the scores in (numClasses x data.n_cols).
+   */
+  template<typename DataType>
+  void Classify(const DataType& data,
+                arma::Row<size_t>& labels,
+                MatType& scores) const;
+
+  /**
+   * Return the class with the highest score for each point.
+   *
+   * @param data Points to classify.
+   * @param labels Row to store the predicted labels in.
+   */
+  template<typename DataType>
+  void Classify(const DataType& data, arma::Row<size_t>& labels) const;
+
+  /**
+   * Return the k classes with the highest scores for each point, from best to
+   * worst, using `scores` as a buffer for the scores.  A std::invalid_argument
+   * is thrown if k is larger than the number of classes.
+   *
+   * @param data Points to classify.
+   * @param k Number of labels to return for each point.
+   * @param labels Matrix to store the labels in (k x data.n_cols).
+   * @param scores Matrix to store the scores in (numClasses x data.n_cols).
+   */
+  template<typename DataType>
+  void TopK(const DataType& data,
+            const size_t k,
+            arma::Mat<size_t>& labels,
+            MatType& scores) const;
+
+  /**
+   * Return the class with the highest score `dot(weights.col(c), point) +
+   * biases[c]` for the given point, without allocating any memory.  If
+   * `biases` is empty, the biases are zero.
+   */
+  template<typename WeightsType, typename BiasesType, typename VecType>
+  static size_t ArgMax(const WeightsType& weights,
+                       const BiasesType& biases,
+                       const VecType& point);
+
+  /**
+   * Compute `scores = weights.t() * data`, plus the bias of each class (unless
+   * `biases` is empty), with one GEMM and no other temporary.
+   */
+  template<typename WeightsType,
+           typename BiasesType,
+           typename DataType,
+           typename ScoresType>
+  static void ComputeScores(const WeightsType& weights,
+                            const BiasesType& biases,
+                            const DataType& data,
+                            ScoresType& scores);
+
+  //! Get the number of classes.
+  size_t NumClasses() const { return weights.n_cols; }
+  //! Get the dimensionality of the points.
+  size_t Dimensionality() const { return weights.n_rows; }
+
+  //! Get the weights (one column per class).
+  const MatType& Weights() const { return weights; }
+  //! Get the biases.
+  const ColType& Biases() const { return biases; }
+
+ private:
+  //! The weights, one column per class.
+  MatType weights;
+  //! The bias of each class.
+  ColType biases;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "linear_scorer_impl.hpp"
+
+#endif
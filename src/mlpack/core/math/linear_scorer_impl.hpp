@@ -0,0 +1,179 @@
+/**
+ * @file core/math/linear_scorer_impl.hpp
+ *
+ * Implementation of the LinearScorer class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_LINEAR_SCORER_IMPL_HPP
+#define MLPACK_CORE_MATH_LINEAR_SCORER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "linear_scorer.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+LinearScorer<MatType>::LinearScorer(const MatType& weights,
+                                    const ColType& biases) :
+    weights(weights),
+    biases(biases)
+{
+  if (this->biases.n_elem == 0)
+    this->biases.zeros(weights.n_cols);
+
+  if (this->biases.n_elem != weights.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "LinearScorer::LinearScorer(): number of biases ("
+        << this->biases.n_elem << ") does not match number of classes ("
+        << weights.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+template<typename MatType>
+LinearScorer<MatType>::LinearScorer(MatType&& weightsIn, ColType&& biasesIn) :
+    weights(std::move(weightsIn)),
+    biases(std::move(biasesIn))
+{
+  if (biases.n_elem == 0)
+    biases.zeros(weights.n_cols);
+
+  if (biases.n_elem != weights.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "LinearScorer::LinearScorer(): number of biases (" << biases.n_elem
+        << ") does not match number of classes (" << weights.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+template<typename MatType>
+template<typename VecType>
+size_t LinearScorer<MatType>::Classify(const VecType& point) const
+{
+  return ArgMax(weights, biases, point);
+}
+
+template<typename MatType>
+template<typename DataType>
+void LinearScorer<MatType>::Scores(const DataType& data, MatType& scores) const
+{
+  ComputeScores(weights, biases, data, scores);
+}
+
+template<typename MatType>
+template<typename DataType>
+void LinearScorer<MatType>::Classify(const DataType& data,
+                                     arma::Row<size_t>& labels,
+                                     MatType& scores) const
+{
+  ComputeScores(weights, biases, data, scores);
+  labels = ConvTo<arma::Row<size_t>>::From(arma::index_max(scores, 0));
+}
+
+template<typename MatType>
+template<typename DataType>
+void LinearScorer<MatType>::Classify(const DataType& data,
+                                     arma::Row<size_t>& labels) const
+{
+  MatType scores;
+  Classify(data, labels, scores);
+}
+
+template<typename MatType>
+template<typename DataType>
+void LinearScorer<MatType>::TopK(const DataType& data,
+                                 const size_t k,
+                                 arma::Mat<size_t>& labels,
+                                 MatType& scores) const
+{
+  if (k > NumClasses())
+  {
+    std::ostringstream oss;
+    oss << "LinearScorer::TopK(): cannot return " << k << " labels for a "
+        << "model with only " << NumClasses() << " classes!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  ComputeScores(weights, biases, data, scores);
+  labels.set_size(k, data.n_cols);
+
+  #pragma omp parallel
+  {
+    // Each thread keeps its own ordering buffer.
+    std::vector<size_t> order(NumClasses());
+
+    #pragma omp for schedule(static)
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      for (size_t c = 0; c < order.size(); ++c)
+        order[c] = c;
+
+      // Sort by decreasing score; ties go to the lowest class, as in
+      // Classify().
+      const ElemType* colScores = scores.colptr(i);
+      std::partial_sort(order.begin(), order.begin() + k, order.end(),
+          [colScores](const size_t a, const size_t b)
+          {
+            return (colScores[a] > colScores[b]) ||
+                (colScores[a] == colScores[b] && a < b);
+          });
+
+      for (size_t j = 0; j < k; ++j)
+        labels(j, i) = order[j];
+    }
+  }
+}
+
+template<typename MatType>
+template<typename WeightsType, typename BiasesType, typename VecType>
+size_t LinearScorer<MatType>::ArgMax(const WeightsType& weights,
+                                     const BiasesType& biases,
+                                     const VecType& point)
+{
+  using ScoreType = typename WeightsType::elem_type;
+
+  size_t best = 0;
+  ScoreType bestScore = -std::numeric_limits<ScoreType>::infinity();
+  for (size_t c = 0; c < weights.n_cols; ++c)
+  {
+    // The dot product of a column and a vector is computed in place.
+    ScoreType score = arma::dot(weights.col(c), point);
+    if (biases.n_elem > 0)
+      score += biases[c];
+
+    if (score > bestScore)
+    {
+      bestScore = score;
+      best = c;
+    }
+  }
+
+  return best;
+}
+
+template<typename MatType>
+template<typename WeightsType,
+         typename BiasesType,
+         typename DataType,
+         typename ScoresType>
+void LinearScorer<MatType>::ComputeScores(const WeightsType& weights,
+                                          const BiasesType& biases,
+                                          const DataType& data,
+                                          ScoresType& scores)
+{
+  // The transposition is handled by GEMM, and the output memory is reused if
+  // scores already has the right size.
+  scores = weights.t() * data;
+  if (biases.n_elem > 0)
+    scores.each_col() += biases;
+}
+
+} // namespace mlpack
+
+#endif
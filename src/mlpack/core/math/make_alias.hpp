@@ -119,6 +119,78 @@ void ClearAlias(arma::SpMat<ElemType>& /* mat */)
   // We cannot make aliases of sparse matrices, so, nothing to do.
 }
 
+#ifdef MLPACK_HAS_COOT
+
+/**
+ * Get the device memory of `in`, starting `offset` elements in.  The CUDA
+ * backend stores a plain device pointer, and the OpenCL backend a buffer with
+ * an offset into it.
+ */
+template<typename eT>
+coot::dev_mem_t<eT> CootAliasMemory(const coot::Mat<eT>& in,
+                                    const size_t offset)
+{
+  coot::dev_mem_t<eT> mem = in.get_dev_mem(false);
+  if (coot::get_rt().backend == coot::CUDA_BACKEND)
+    mem.cuda_mem_ptr += offset;
+  else
+    mem.cl_mem_ptr.offset += offset;
+
+  return mem;
+}
+
+/**
+ * Reconstruct the Bandicoot matrix `m` as an alias of the device memory of
+ * `in`, with size `numRows` x `numCols`.  No data is copied between the host
+ * and the device.  Bandicoot aliases cannot be resized, so `strict` is ignored.
+ */
+template<typename eT>
+void MakeAlias(coot::Mat<eT>& m,
+               const coot::Mat<eT>& in,
+               const size_t numRows,
+               const size_t numCols,
+               const size_t offset = 0,
+               const bool /* strict */ = true)
+{
+  coot::dev_mem_t<eT> mem = CootAliasMemory(in, offset);
+  m.~Mat();
+  new (&m) coot::Mat<eT>(mem, numRows, numCols);
+}
+
+/**
+ * Reconstruct the Bandicoot column vector `v` as an alias of the device memory
+ * of `in`, with `numElems` elements.
+ */
+template<typename eT>
+void MakeAlias(coot::Col<eT>& v,
+               const coot::Mat<eT>& in,
+               const size_t numElems,
+               const size_t offset = 0,
+               const bool /* strict */ = true)
+{
+  coot::dev_mem_t<eT> mem = CootAliasMemory(in, offset);
+  v.~Col();
+  new (&v) coot::Col<eT>(mem, numElems);
+}
+
+/**
+ * Reconstruct the Bandicoot row vector `v` as an alias of the device memory of
+ * `in`, with `numElems` elements.
+ */
+template<typename eT>
+void MakeAlias(coot::Row<eT>& v,
+               const coot::Mat<eT>& in,
+               const size_t numElems,
+               const size_t offset = 0,
+               const bool /* strict */ = true)
+{
+  coot::dev_mem_t<eT> mem = CootAliasMemory(in, offset);
+  v.~Row();
+  new (&v) coot::Row<eT>(mem, numElems);
+}
+
+#endif
+
 } // namespace mlpack
 
 #endif
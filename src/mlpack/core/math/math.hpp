@@ -13,8 +13,10 @@
 #define MLPACK_CORE_MATH_MATH_HPP
 
 #include "ccov.hpp"
+#include "column_moments.hpp"
 #include "columns_to_blocks.hpp"
 #include "digamma.hpp"
+#include "linear_scorer.hpp"
 #include "log_add.hpp"
 #include "make_alias.hpp"
 #include "multiply_slices.hpp"
@@ -24,6 +26,8 @@
 #include "rand_vector.hpp"
 #include "range.hpp"
 #include "shuffle_data.hpp"
+#include "sparse_columns.hpp"
+#include "tall_skinny_qr.hpp"
 #include "trigamma.hpp"
 #include "unwrap_alias.hpp"
 
@@ -14,6 +14,8 @@
 #include <mlpack/prereqs.hpp>
 #include <random>
 
+#include "philox_rng.hpp"
+
 namespace mlpack {
 
 // Because we have multiple RNGs for mlpack (one for each thread, as they are
@@ -167,6 +169,21 @@ inline double RandNormal(const double mean, const double stddev)
   return stddev * RandNormalDist()(RandGen()) + mean;
 }
 
+/**
+ * Draw a new 64-bit key for counter-based random streams (see PhiloxRNG) from
+ * the random number generator of the calling thread, so that the key depends
+ * on the random seed given to RandomSeed().  Draw the key once, before a
+ * parallel loop, and give each task of the loop its own stream of that key:
+ * the random numbers of each task then do not depend on the number of threads
+ * or on the scheduling.
+ */
+inline uint64_t RandStreamKey()
+{
+  const uint64_t high = RandGen()();
+  const uint64_t low = RandGen()();
+  return (high << 32) | low;
+}
+
 } // namespace mlpack
 
 #endif // MLPACK_CORE_MATH_RANDOM_HPP
@@ -236,6 +236,40 @@ void ShuffleData(const MatType& inputPoints,
   }
 }
 
+#ifdef MLPACK_HAS_COOT
+
+/**
+ * Shuffle a Bandicoot dataset and associated labels (or responses).  It is
+ * expected that inputPoints and inputLabels have the same number of columns.
+ * Bandicoot cannot gather an arbitrary set of columns on the device, so the
+ * data is copied to the host, shuffled there, and copied back.
+ *
+ * Shuffled data will be output into outputPoints and outputLabels.
+ */
+template<typename eT, typename LabelsType>
+void ShuffleData(const coot::Mat<eT>& inputPoints,
+                 const LabelsType& inputLabels,
+                 coot::Mat<eT>& outputPoints,
+                 LabelsType& outputLabels)
+{
+  using LabelsElemType = typename LabelsType::elem_type;
+
+  arma::Mat<eT> points = coot::conv_to<arma::Mat<eT>>::from(inputPoints);
+  arma::Mat<LabelsElemType> labels =
+      coot::conv_to<arma::Mat<LabelsElemType>>::from(inputLabels);
+
+  // Generate ordering.
+  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
+      inputPoints.n_cols - 1, inputPoints.n_cols));
+
+  outputPoints = coot::conv_to<coot::Mat<eT>>::from(
+      arma::Mat<eT>(points.cols(ordering)));
+  outputLabels = coot::conv_to<LabelsType>::from(
+      arma::Mat<LabelsElemType>(labels.cols(ordering)));
+}
+
+#endif
+
 } // namespace mlpack
 
 #endif
@@ -0,0 +1,141 @@
+/**
+ * @file core/math/sparse_columns.hpp
+ *
+ * Products of dense matrices with a batch of consecutive columns of a sparse
+ * matrix, computed directly on the compressed sparse column storage.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_SPARSE_COLUMNS_HPP
+#define MLPACK_CORE_MATH_SPARSE_COLUMNS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Compute out = weights.rows(0, x.n_rows - 1).t() * x.cols(begin, begin +
+ * count - 1), where x is sparse.  The columns of x are read in place from its
+ * compressed sparse column storage, so neither the batch nor its transpose is
+ * copied, and only the nonzero elements of the batch are visited: the cost is
+ * O(nnz * weights.n_cols).  Any row of weights past x.n_rows (for instance, an
+ * intercept row) is ignored.
+ *
+ * @param weights Dense matrix with at least x.n_rows rows.
+ * @param x Sparse matrix.
+ * @param begin Index of the first column of the batch.
+ * @param count Number of columns in the batch.
+ * @param out Dense matrix to store the weights.n_cols x count result in.
+ */
+template<typename WeightsType, typename eT, typename OutType>
+void SparseColumnsProduct(const WeightsType& weights,
+                          const arma::SpMat<eT>& x,
+                          const size_t begin,
+                          const size_t count,
+                          OutType& out)
+{
+  x.sync();
+  out.zeros(weights.n_cols, count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (size_t k = x.col_ptrs[begin + i]; k < x.col_ptrs[begin + i + 1]; ++k)
+    {
+      const size_t r = x.row_indices[k];
+      const eT value = x.values[k];
+      for (size_t c = 0; c < weights.n_cols; ++c)
+        out.at(c, i) += weights.at(r, c) * value;
+    }
+  }
+}
+
+/**
+ * Compute out.rows(0, x.n_rows - 1) += x.cols(begin, begin + count - 1) *
+ * coefficients.t(), where x is sparse.  As with SparseColumnsProduct(), the
+ * batch is read in place and only its nonzero elements are visited, so only the
+ * rows of out that correspond to nonzero features of the batch are modified.
+ * out must already have at least x.n_rows rows and coefficients.n_rows
+ * columns.
+ *
+ * @param x Sparse matrix.
+ * @param begin Index of the first column of the batch.
+ * @param count Number of columns in the batch.
+ * @param coefficients Dense matrix of size k x count.
+ * @param out Dense matrix to accumulate the result into.
+ */
+template<typename eT, typename CoefficientsType, typename OutType>
+void SparseColumnsAccumulate(const arma::SpMat<eT>& x,
+                             const size_t begin,
+                             const size_t count,
+                             const CoefficientsType& coefficients,
+                             OutType& out)
+{
+  x.sync();
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (size_t k = x.col_ptrs[begin + i]; k < x.col_ptrs[begin + i + 1]; ++k)
+    {
+      const size_t r = x.row_indices[k];
+      const eT value = x.values[k];
+      for (size_t c = 0; c < coefficients.n_rows; ++c)
+        out.at(r, c) += value * coefficients.at(c, i);
+    }
+  }
+}
+
+/**
+ * Compute the sparse matrix out = coefficients * x.cols(begin, begin + count -
+ * 1).t(), with the columns shifted by colOffset: feature r of x gives column
+ * r + colOffset of out, which has coefficients.n_rows rows and numCols
+ * columns.  Only the columns of the features that are nonzero in the batch are
+ * nonzero in the result, so it can be built in O(nnz * coefficients.n_rows)
+ * time, independently of the dimensionality of x.
+ *
+ * @param x Sparse matrix.
+ * @param begin Index of the first column of the batch.
+ * @param count Number of columns in the batch.
+ * @param coefficients Dense matrix of size k x count.
+ * @param colOffset Column of out corresponding to the first feature of x.
+ * @param numCols Number of columns of out.
+ * @param out Sparse matrix to store the result in.
+ */
+template<typename eT, typename CoefficientsType, typename OutType>
+void SparseColumnsOuterProduct(const arma::SpMat<eT>& x,
+                               const size_t begin,
+                               const size_t count,
+                               const CoefficientsType& coefficients,
+                               const size_t colOffset,
+                               const size_t numCols,
+                               OutType& out)
+{
+  using OutElemType = typename OutType::elem_type;
+
+  x.sync();
+  const size_t k = coefficients.n_rows;
+  const size_t nnz = x.col_ptrs[begin + count] - x.col_ptrs[begin];
+  arma::umat locations(2, nnz * k);
+  arma::Col<OutElemType> values(nnz * k);
+
+  size_t n = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (size_t j = x.col_ptrs[begin + i]; j < x.col_ptrs[begin + i + 1]; ++j)
+    {
+      for (size_t c = 0; c < k; ++c, ++n)
+      {
+        locations(0, n) = c;
+        locations(1, n) = x.row_indices[j] + colOffset;
+        values[n] = x.values[j] * coefficients.at(c, i);
+      }
+    }
+  }
+
+  // Duplicate locations are summed.
+  out = OutType(true, locations, values, k, numCols);
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file core/math/tall_skinny_qr.hpp
+ *
+ * Definition of the TallSkinnyQR class, which computes the R factor of the QR
+ * decomposition of a tall and skinny matrix given one block of rows at a time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_TALL_SKINNY_QR_HPP
+#define MLPACK_CORE_MATH_TALL_SKINNY_QR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * TallSkinnyQR (TSQR) computes the R factor of the QR decomposition of a
+ * matrix A with many more rows than columns, without ever holding A in memory:
+ * the blocks of rows A_1, A_2, ... of A are given one at a time to Add(), and
+ * the R factor of [R; A_i] replaces the current R factor.  The memory used is
+ * that of the current block and of R (at most cols x cols).
+ *
+ * Since the R factor of A is also the R factor of the stacked R factors of any
+ * partition of the rows of A, partial decompositions (e.g. of the blocks held
+ * by different threads or processes) can be combined with Merge(), in any
+ * order and following any reduction tree.  The R factor is unique up to the
+ * signs of its rows.
+ *
+ * @code
+ * TallSkinnyQR<arma::mat> tsqr(10);
+ * for (size_t i = 0; i < blocks.size(); ++i)
+ *   tsqr.Add(blocks[i]); // Each block has 10 columns.
+ * const arma::mat& r = tsqr.R();
+ * @endcode
+ *
+ * For more information, see the following paper:
+ *
+ * @code
+ * @article{demmel2012communication,
+ *   title={Communication-optimal parallel and sequential QR and LU
+ *       factorizations},
+ *   author={Demmel, James and Grigori, Laura and Hoemmen, Mark and
+ *       Langou, Julien},
+ *   journal={SIAM Journal on Scientific Computing},
+ *   volume={34},
+ *   number={1},
+ *   pages={A206--A239},
+ *   year={2012}
+ * }
+ * @endcode
+ *
+ * @tparam MatType Type of the blocks and of the R factor.
+ */
+template<typename MatType = arma::mat>
+class TallSkinnyQR
+{
+ public:
+  /**
+   * Create the decomposition of an empty matrix with the given number of
+   * columns.
+   *
+   * @param cols Number of columns of the matrix.
+   */
+  TallSkinnyQR(const size_t cols = 0) : rows(0)
+  {
+    r.zeros(0, cols);
+  }
+
+  /**
+   * Add the given block of rows to the matrix.  A std::invalid_argument is
+   * thrown if the block does not have the right number of columns, and a
+   * std::runtime_error is thrown if the QR decomposition fails.
+   *
+   * @param block Rows to add.
+   */
+  void Add(const MatType& block)
+  {
+    if (block.n_cols != r.n_cols)
+    {
+      std::ostringstream oss;
+      oss << "TallSkinnyQR::Add(): the block has " << block.n_cols
+          << " columns, but the matrix has " << r.n_cols << " columns";
+      throw std::invalid_argument(oss.str());
+    }
+
+    Combine(block);
+    rows += block.n_rows;
+  }
+
+  /**
+   * Add the rows of the matrix decomposed by `other` to this matrix, using
+   * only the R factor of `other`.
+   *
+   * @param other Decomposition to merge into this one.
+   */
+  void Merge(const TallSkinnyQR& other)
+  {
+    if (other.Cols() != r.n_cols)
+    {
+      std::ostringstream oss;
+      oss << "TallSkinnyQR::Merge(): the other matrix has " << other.Cols()
+          << " columns, but this matrix has " << r.n_cols << " columns";
+      throw std::invalid_argument(oss.str());
+    }
+
+    Combine(other.R());
+    rows += other.Rows();
+  }
+
+  //! Get the R factor of the rows added so far (upper triangular, with
+  //! min(Rows(), Cols()) rows).
+  const MatType& R() const { return r; }
+
+  //! Get the number of rows added so far.
+  size_t Rows() const { return rows; }
+  //! Get the number of columns of the matrix.
+  size_t Cols() const { return r.n_cols; }
+
+  //! Remove all the rows of the matrix.
+  void Reset()
+  {
+    r.zeros(0, r.n_cols);
+    rows = 0;
+  }
+
+ private:
+  //! Replace the R factor with the R factor of [R; block].
+  void Combine(const MatType& block)
+  {
+    if (block.n_rows == 0)
+      return;
+
+    MatType q, stacked = arma::join_cols(r, block);
+    if (!arma::qr_econ(q, r, stacked))
+    {
+      throw std::runtime_error("TallSkinnyQR: the QR decomposition of a block "
+          "failed");
+    }
+  }
+
+  //! The R factor of the rows added so far.
+  MatType r;
+  //! The number of rows added so far.
+  size_t rows;
+};
+
+} // namespace mlpack
+
+#endif
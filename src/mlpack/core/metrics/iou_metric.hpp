@@ -25,7 +25,7 @@ namespace mlpack {
  * either as coordinates i.e. each value in vector represents a
  * coordinate in the format x0, y0, x1, y1 where x0, y0 represent the
  * lower left coordinate and x1, y1, represent upper right coordinate.
- * 
+ *
  * Second representation follows the following representation : x0, y0, h, w.
  * Where x0 and y0 are bottom left bounding box coordinates and h, w are
  * height and width of the bounding box.
@@ -53,6 +53,24 @@ class IoU
   static typename VecTypeA::elem_type Evaluate(const VecTypeA& a,
                                                const VecTypeB& b);
 
+  /**
+   * Computes the Intersection over Union metric between each bounding box in
+   * `a` and each bounding box in `b` (one per column), so that `ious(i, j)` is
+   * the IoU of `a.col(i)` and `b.col(j)`.  This is much faster than calling
+   * the other overload for each pair, since each bounding box is only
+   * converted and checked once and the inner loop vectorizes.
+   *
+   * @tparam MatTypeA Type of first matrix.
+   * @tparam MatTypeB Type of second matrix.
+   * @param a First set of bounding boxes.
+   * @param b Second set of bounding boxes.
+   * @param ious Matrix to store the IoU of each pair in.
+   */
+  template<typename MatTypeA, typename MatTypeB>
+  static void Evaluate(const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::Mat<typename MatTypeA::elem_type>& ious);
+
   static const bool useCoordinates = UseCoordinates;
 
   //! Serialize the metric.
@@ -65,6 +65,90 @@ typename VecTypeA::elem_type IoU<UseCoordinates>::Evaluate(
   return interSectionArea / (1.0 * ((a(2) + 1) * (a(3) + 1) + (b(2) + 1) *
       (b(3) + 1) - interSectionArea));
 }
+
+template<bool UseCoordinates>
+template<typename MatTypeA, typename MatTypeB>
+void IoU<UseCoordinates>::Evaluate(
+    const MatTypeA& a,
+    const MatTypeB& b,
+    arma::Mat<typename MatTypeA::elem_type>& ious)
+{
+  using ElemType = typename MatTypeA::elem_type;
+
+  Log::Assert(a.n_rows == 4 && b.n_rows == 4, "Incorrect shape for bounding "
+      "boxes. They must contain 4 elements either be {x0, y0, x1, y1} or {x0, "
+      "y0, h, w}. Refer to the documentation for more information.");
+
+  // Convert each set of bounding boxes to the {x0, y0, x1, y1} representation
+  // (with one column per coordinate, so that the inner loop below is
+  // contiguous), and compute their areas.
+  auto convert = [](const auto& boxes, arma::Mat<ElemType>& coordinates,
+                    arma::Row<ElemType>& area)
+  {
+    coordinates.set_size(4, boxes.n_cols);
+    for (size_t i = 0; i < boxes.n_cols; ++i)
+    {
+      if (UseCoordinates)
+      {
+        if (boxes(0, i) >= boxes(2, i) || boxes(1, i) >= boxes(3, i))
+        {
+          Log::Fatal << "Check the correctness of bounding boxes i.e. " <<
+              "{x0, y0} must represent lower left coordinates and " <<
+              "{x1, y1} must represent upper right coordinates of bounding" <<
+              "box." << std::endl;
+        }
+
+        coordinates(0, i) = boxes(0, i);
+        coordinates(1, i) = boxes(1, i);
+        coordinates(2, i) = boxes(2, i);
+        coordinates(3, i) = boxes(3, i);
+      }
+      else
+      {
+        Log::Assert(boxes(2, i) > 0 && boxes(3, i) > 0, "Height and width "
+            "of bounding boxes must be greater than zero.");
+
+        coordinates(0, i) = boxes(0, i);
+        coordinates(1, i) = boxes(1, i);
+        coordinates(2, i) = boxes(0, i) + boxes(2, i);
+        coordinates(3, i) = boxes(1, i) + boxes(3, i);
+      }
+    }
+
+    area = (coordinates.row(2) - coordinates.row(0) + 1) %
+        (coordinates.row(3) - coordinates.row(1) + 1);
+    coordinates = coordinates.t();
+  };
+
+  arma::Mat<ElemType> coordinatesA, coordinatesB;
+  arma::Row<ElemType> areaA, areaB;
+  convert(a, coordinatesA, areaA);
+  convert(b, coordinatesB, areaB);
+
+  ious.set_size(a.n_cols, b.n_cols);
+  #pragma omp parallel for schedule(static)
+  for (size_t j = 0; j < (size_t) b.n_cols; ++j)
+  {
+    const ElemType bx0 = coordinatesB(j, 0), by0 = coordinatesB(j, 1);
+    const ElemType bx1 = coordinatesB(j, 2), by1 = coordinatesB(j, 3);
+    const ElemType* ax0 = coordinatesA.colptr(0);
+    const ElemType* ay0 = coordinatesA.colptr(1);
+    const ElemType* ax1 = coordinatesA.colptr(2);
+    const ElemType* ay1 = coordinatesA.colptr(3);
+    ElemType* result = ious.colptr(j);
+
+    for (size_t i = 0; i < (size_t) a.n_cols; ++i)
+    {
+      const ElemType width = std::max(ElemType(0), std::min(ax1[i], bx1) -
+          std::max(ax0[i], bx0) + 1);
+      const ElemType height = std::max(ElemType(0), std::min(ay1[i], by1) -
+          std::max(ay0[i], by0) + 1);
+      const ElemType interSectionArea = width * height;
+      result[i] = interSectionArea / (areaA[i] + areaB[j] - interSectionArea);
+    }
+  }
+}
+
 template<bool UseCoordinates>
 template<typename Archive>
 void IoU<UseCoordinates>::serialize(
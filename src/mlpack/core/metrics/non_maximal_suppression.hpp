@@ -21,11 +21,17 @@ namespace mlpack {
  * Intersection-over-Union (IoU). NMS iteratively removes lower scoring boxes
  * which have an IoU greater than threshold with another high scoring box.
  *
+ * The boxes are visited in descending order of their confidence scores, and
+ * each one is only compared with the already selected boxes that share a cell
+ * of a uniform grid with it (the cells are about the size of the average box),
+ * since boxes that do not overlap cannot suppress each other.  For typical
+ * detections this takes O(n log n) time instead of O(n^2).
+ *
  * For bounding box representation there are two common representation
  * either as coordinates i.e. each value in vector represents a
  * coordinate in the format x0, y0, x1, y1 where x0, y0 represent the
  * lower left coordinate and x1, y1, represent upper right coordinate.
- * 
+ *
  * Second representation follows the following representation : x0, y0, h, w.
  * Where x0 and y0 are bottom left bounding box coordinates and h, w are
  * height and width of the bounding box.
@@ -1,5 +1,5 @@
 /**
- * @file core/metrics/nms_metric_impl.hpp
+ * @file core/metrics/non_maximal_suppression_impl.hpp
  * @author Kartik Dutt
  *
  * Implementation of Non Maximal Suppression metric.
@@ -36,94 +36,135 @@ void NMS<UseCoordinates>::Evaluate(
       "box either in {x1, y1, x2, y2} or {x1, y1, h, w} format."
       "Refer to the documentation for more information.");
 
-  Log::Assert(confidenceScores.n_cols != boundingBoxes.n_cols, "Each "
+  Log::Assert(confidenceScores.n_elem == boundingBoxes.n_cols, "Each "
       "bounding box must correspond to atleast and only 1 bounding box. "
-      "Found " + std::to_string(confidenceScores.n_cols) + " confidence "
+      "Found " + std::to_string(confidenceScores.n_elem) + " confidence "
       "scores for " + std::to_string(boundingBoxes.n_cols) +
       " bounding boxes.");
 
-  // Clear selected bounding boxes.
-  selectedIndices.clear();
-
-  // Obtain Sorted indices for bounding boxes according to
-  // their confidence scores.
-  arma::ucolvec sortedIndices = arma::sort_index(confidenceScores);
+  using ElemType = typename BoundingBoxesType::elem_type;
 
-  // Pre-Compute area of each bounding box.
-  arma::mat area;
-  if (UseCoordinates)
+  const size_t n = boundingBoxes.n_cols;
+  selectedIndices.clear();
+  if (n == 0)
+    return;
+
+  // Convert the bounding boxes to the {x0, y0, x1, y1} representation, and
+  // pre-compute the area of each bounding box.
+  arma::Mat<ElemType> boxes(4, n);
+  arma::Col<ElemType> area(n);
+  for (size_t i = 0; i < n; ++i)
   {
-    area = (boundingBoxes.row(2) - boundingBoxes.row(0)) %
-        (boundingBoxes.row(3) - boundingBoxes.row(1));
+    boxes(0, i) = boundingBoxes(0, i);
+    boxes(1, i) = boundingBoxes(1, i);
+    boxes(2, i) = UseCoordinates ? ElemType(boundingBoxes(2, i)) :
+        ElemType(boundingBoxes(0, i) + boundingBoxes(2, i));
+    boxes(3, i) = UseCoordinates ? ElemType(boundingBoxes(3, i)) :
+        ElemType(boundingBoxes(1, i) + boundingBoxes(3, i));
+    area[i] = (boxes(2, i) - boxes(0, i)) * (boxes(3, i) - boxes(1, i));
   }
-  else
+
+  // Visit the bounding boxes in descending order of their confidence scores.
+  const arma::uvec sortedIndices = arma::stable_sort_index(confidenceScores,
+      "descend");
+
+  // With a negative threshold, the box with the highest score suppresses all
+  // the others.
+  if (threshold < 0.0)
   {
-    area = boundingBoxes.row(2) % boundingBoxes.row(3);
+    selectedIndices.set_size(1);
+    selectedIndices[0] = sortedIndices[0];
+    return;
   }
 
-  while (sortedIndices.n_elem > 0)
+  // Otherwise only overlapping boxes can suppress each other, so the selected
+  // boxes are stored in a uniform grid, and each box is compared with the
+  // selected boxes in the cells it covers.  The cells are about the size of
+  // the average box, but there are at most 4n of them.
+  const ElemType minX = boxes.row(0).min();
+  const ElemType minY = boxes.row(1).min();
+  const double extentX = double(boxes.row(2).max() - minX);
+  const double extentY = double(boxes.row(3).max() - minY);
+  double cellWidth = std::max(double(arma::mean(boxes.row(2) -
+      boxes.row(0))), 1e-8 * (extentX + 1.0));
+  double cellHeight = std::max(double(arma::mean(boxes.row(3) -
+      boxes.row(1))), 1e-8 * (extentY + 1.0));
+  size_t gridCols, gridRows;
+  while (true)
   {
-    size_t selectedIndex = sortedIndices(sortedIndices.n_elem - 1);
-
-    // Choose the box with the largest probability.
-    selectedIndices.insert_rows(0, arma::uvec(1).fill(selectedIndex));
-
-    // Check if there are other bounding boxes to compare with.
-    if (sortedIndices.n_elem == 1)
-    {
+    gridCols = size_t(extentX / cellWidth) + 1;
+    gridRows = size_t(extentY / cellHeight) + 1;
+    if (double(gridCols) * double(gridRows) <= 4.0 * n)
       break;
-    }
 
-    // Remove the last index.
-    sortedIndices = sortedIndices(arma::span(0, sortedIndices.n_rows - 2),
-        arma::span());
-
-    // Get x and y coordinates for remaining bounding boxes.
-    BoundingBoxesType x2 = boundingBoxes.submat(arma::uvec(1).fill(2),
-        sortedIndices);
-
-    BoundingBoxesType x1 = boundingBoxes.submat(arma::uvec(1).fill(0),
-        sortedIndices);
+    cellWidth *= 2.0;
+    cellHeight *= 2.0;
+  }
 
-    BoundingBoxesType y2 = boundingBoxes.submat(arma::uvec(1).fill(3),
-        sortedIndices);
+  auto cellX = [&](const ElemType x)
+  {
+    return std::min(size_t(std::max(double(x - minX), 0.0) / cellWidth),
+        gridCols - 1);
+  };
+  auto cellY = [&](const ElemType y)
+  {
+    return std::min(size_t(std::max(double(y - minY), 0.0) / cellHeight),
+        gridRows - 1);
+  };
 
-    BoundingBoxesType y1 = boundingBoxes.submat(arma::uvec(1).fill(1),
-        sortedIndices);
+  std::vector<std::vector<size_t>> grid(gridCols * gridRows);
+  // The last box that each selected box was compared with, so that boxes
+  // covering several cells are only compared once.
+  std::vector<size_t> lastCompared(n, n);
+  std::vector<size_t> selected;
 
-    size_t selectedX2 = boundingBoxes(2, selectedIndex);
-    size_t selectedY2 = boundingBoxes(3, selectedIndex);
-    size_t selectedX1 = boundingBoxes(0, selectedIndex);
-    size_t selectedY1 = boundingBoxes(1, selectedIndex);
+  for (size_t k = 0; k < n; ++k)
+  {
+    const size_t i = sortedIndices[k];
+    const size_t cx0 = cellX(boxes(0, i)), cx1 = cellX(boxes(2, i));
+    const size_t cy0 = cellY(boxes(1, i)), cy1 = cellY(boxes(3, i));
 
-    if (!UseCoordinates)
+    bool suppressed = false;
+    for (size_t cy = cy0; cy <= cy1 && !suppressed; ++cy)
     {
-      // Change height - width representation to coordinate represention.
-      x2 = x2 + x1;
-      y2 = y2 + y1;
-      selectedX2 = selectedX2 + selectedX1;
-      selectedY2 = selectedY2 + selectedY1;
+      for (size_t cx = cx0; cx <= cx1 && !suppressed; ++cx)
+      {
+        for (const size_t j : grid[cy * gridCols + cx])
+        {
+          if (lastCompared[j] == i)
+            continue;
+          lastCompared[j] = i;
+
+          const ElemType width = std::min(boxes(2, i), boxes(2, j)) -
+              std::max(boxes(0, i), boxes(0, j));
+          const ElemType height = std::min(boxes(3, i), boxes(3, j)) -
+              std::max(boxes(1, i), boxes(1, j));
+          if (width <= 0 || height <= 0)
+            continue;
+
+          const ElemType intersectionArea = width * height;
+          if (intersectionArea > threshold * (area[i] + area[j] -
+              intersectionArea))
+          {
+            suppressed = true;
+            break;
+          }
+        }
+      }
     }
 
-    // Calculate points of intersection between the bounding box with
-    // highest confidence score and remaining bounding boxes.
-    x2 = arma::clamp(x2, DBL_MIN, selectedX2);
-    y2 = arma::clamp(y2, DBL_MIN, selectedY2);
-    x1 = arma::clamp(x1, selectedX1, DBL_MAX);
-    y1 = arma::clamp(y1, selectedY1, DBL_MAX);
-
-    BoundingBoxesType intersectionArea = arma::clamp(x2 - x1, 0.0, DBL_MAX) %
-          arma::clamp(y2 - y1, 0.0, DBL_MAX);
-
-    // Calculate IoU of remaining boxes with the last bounding box with
-    // the highest confidence score.
-    BoundingBoxesType calculateIoU = intersectionArea /
-        (area(sortedIndices).t() - intersectionArea + area(selectedIndex));
+    if (suppressed)
+      continue;
 
-    sortedIndices = sortedIndices(arma::find(calculateIoU <= threshold));
+    selected.push_back(i);
+    for (size_t cy = cy0; cy <= cy1; ++cy)
+      for (size_t cx = cx0; cx <= cx1; ++cx)
+        grid[cy * gridCols + cx].push_back(i);
   }
 
-  selectedIndices = arma::flipud(selectedIndices);
+  selectedIndices.set_size(selected.size());
+  for (size_t i = 0; i < selected.size(); ++i)
+    selectedIndices[i] = selected[i];
 }
 
 template<bool UseCoordinates>
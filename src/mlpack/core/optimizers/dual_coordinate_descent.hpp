@@ -0,0 +1,206 @@
+/**
+ * @file core/optimizers/dual_coordinate_descent.hpp
+ *
+ * Definition of DualCoordinateDescent, a solver for the dual problems of
+ * L2-regularized linear SVMs and logistic regression.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_DUAL_COORDINATE_DESCENT_HPP
+#define MLPACK_CORE_OPTIMIZERS_DUAL_COORDINATE_DESCENT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * DualCoordinateDescent solves the dual problems of binary linear classifiers
+ * with L2 regularization, as LIBLINEAR does:
+ *
+ *   min_w  (1/2) ||w||^2 + C sum_i loss(y_i w^T x_i),
+ *
+ * for the hinge loss (the linear SVM) with the dual coordinate descent method
+ * and shrinking of
+ *
+ * @code
+ * @inproceedings{hsieh2008dual,
+ *   title={A Dual Coordinate Descent Method for Large-scale Linear SVM},
+ *   author={Hsieh, C.-J. and Chang, K.-W. and Lin, C.-J. and Keerthi, S.S.
+ *       and Sundararajan, S.},
+ *   booktitle={Proceedings of the 25th International Conference on Machine
+ *       Learning (ICML 2008)},
+ *   pages={408--415},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * and for the logistic loss with the dual coordinate descent method of
+ *
+ * @code
+ * @article{yu2011dual,
+ *   title={Dual Coordinate Descent Methods for Logistic Regression and
+ *       Maximum Entropy Models},
+ *   author={Yu, H.-F. and Huang, F.-L. and Lin, C.-J.},
+ *   journal={Machine Learning},
+ *   volume={85},
+ *   number={1--2},
+ *   pages={41--75},
+ *   year={2011}
+ * }
+ * @endcode
+ *
+ * Each step optimizes one dual variable in closed form (or with a few Newton
+ * steps, for the logistic loss), and updates w with its point; the solver
+ * keeps w = sum_i y_i alpha_i x_i, so a step costs O(nnz(x_i)), and sparse
+ * data (arma::SpMat) only touches the nonzeros of each point.  For the hinge
+ * loss, the points whose dual variables are likely to stay at a bound are
+ * shrunk (skipped) until the active points are optimal, and the solver then
+ * checks all the points again.  The points are visited in a random order at
+ * each pass.
+ *
+ * The intercept, if fitted, is handled as an extra feature with value 1 for
+ * all points; as in LIBLINEAR, it is therefore regularized like the other
+ * weights.
+ *
+ * This is the solver used by the DualCoordinateDescent overloads of
+ * LinearSVM::Train() (one-vs-rest, see SolveOneVsRest()) and
+ * LogisticRegression::Train():
+ *
+ * @code
+ * extern arma::sp_mat data;
+ * extern arma::Row<size_t> labels;
+ *
+ * DualCoordinateDescent dcd(0.01); // Tolerance.
+ * LinearSVM<> svm;
+ * svm.Lambda() = 1e-4;
+ * svm.Train(data, labels, 10, dcd);
+ * @endcode
+ */
+class DualCoordinateDescent
+{
+ public:
+  /**
+   * Construct the solver with the given parameters.
+   *
+   * @param tolerance Tolerance on the violation of the optimality conditions
+   *     (the spread of the projected gradients for the hinge loss, the largest
+   *     gradient for the logistic loss).
+   * @param maxIterations Maximum number of passes over the data (0 means no
+   *     limit).
+   * @param shrinking Whether to use shrinking (for the hinge loss).
+   */
+  DualCoordinateDescent(const double tolerance = 0.1,
+                        const size_t maxIterations = 1000,
+                        const bool shrinking = true);
+
+  /**
+   * Train a binary linear SVM (the hinge loss) on the given data.
+   *
+   * @param data Dataset, one column per point.
+   * @param labels Labels of the points, +1 or -1.
+   * @param c Cost of the losses (the inverse of the regularization).
+   * @param fitIntercept Whether to fit an intercept.
+   * @param weights Vector to store the weights in, followed by the intercept if
+   *     it is fitted.
+   * @return Primal objective of the solution.
+   */
+  template<typename MatType, typename ElemType>
+  ElemType SolveHinge(const MatType& data,
+                      const arma::Col<ElemType>& labels,
+                      const double c,
+                      const bool fitIntercept,
+                      arma::Col<ElemType>& weights) const;
+
+  /**
+   * Train a binary logistic regression model on the given data.
+   *
+   * @param data Dataset, one column per point.
+   * @param labels Labels of the points, +1 or -1.
+   * @param c Cost of the losses (the inverse of the regularization).
+   * @param fitIntercept Whether to fit an intercept.
+   * @param weights Vector to store the weights in, followed by the intercept if
+   *     it is fitted.
+   * @return Primal objective of the solution.
+   */
+  template<typename MatType, typename ElemType>
+  ElemType SolveLogistic(const MatType& data,
+                         const arma::Col<ElemType>& labels,
+                         const double c,
+                         const bool fitIntercept,
+                         arma::Col<ElemType>& weights) const;
+
+  /**
+   * Train one binary linear SVM for each class against all the others, in
+   * parallel.
+   *
+   * @param data Dataset, one column per point.
+   * @param labels Labels of the points, between 0 and numClasses - 1.
+   * @param numClasses Number of classes.
+   * @param c Cost of the losses (the inverse of the regularization).
+   * @param fitIntercept Whether to fit an intercept.
+   * @param weights Matrix to store the weights in, one column per class, each
+   *     followed by the intercept if it is fitted.
+   * @return Sum of the primal objectives of the classifiers.
+   */
+  template<typename MatType, typename ElemType>
+  ElemType SolveOneVsRest(const MatType& data,
+                          const arma::Row<size_t>& labels,
+                          const size_t numClasses,
+                          const double c,
+                          const bool fitIntercept,
+                          arma::Mat<ElemType>& weights) const;
+
+  //! Get the tolerance on the violation of the optimality conditions.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance on the violation of the optimality conditions.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the maximum number of passes over the data (0 means no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of passes over the data (0 means no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get whether shrinking is used.
+  bool Shrinking() const { return shrinking; }
+  //! Modify whether shrinking is used.
+  bool& Shrinking() { return shrinking; }
+
+ private:
+  //! Compute w^T x_i (plus the intercept, the last weight, if it is fitted).
+  template<typename MatType, typename ElemType>
+  static ElemType Dot(const MatType& data,
+                      const size_t i,
+                      const bool fitIntercept,
+                      const arma::Col<ElemType>& weights);
+
+  //! Add a x_i (and a to the intercept, if it is fitted) to w.
+  template<typename MatType, typename ElemType>
+  static void Axpy(const MatType& data,
+                   const size_t i,
+                   const bool fitIntercept,
+                   const ElemType a,
+                   arma::Col<ElemType>& weights);
+
+  //! Compute x_i^T x_i (plus 1 if the intercept is fitted) for all points.
+  template<typename MatType, typename ElemType>
+  static void SquaredNorms(const MatType& data,
+                           const bool fitIntercept,
+                           arma::Col<ElemType>& norms);
+
+  //! Tolerance on the violation of the optimality conditions.
+  double tolerance;
+  //! Maximum number of passes over the data.
+  size_t maxIterations;
+  //! Whether to use shrinking.
+  bool shrinking;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "dual_coordinate_descent_impl.hpp"
+
+#endif
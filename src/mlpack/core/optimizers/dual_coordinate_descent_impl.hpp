@@ -0,0 +1,386 @@
+/**
+ * @file core/optimizers/dual_coordinate_descent_impl.hpp
+ *
+ * Implementation of DualCoordinateDescent.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_DUAL_COORDINATE_DESCENT_IMPL_HPP
+#define MLPACK_CORE_OPTIMIZERS_DUAL_COORDINATE_DESCENT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "dual_coordinate_descent.hpp"
+
+namespace mlpack {
+
+inline DualCoordinateDescent::DualCoordinateDescent(const double tolerance,
+                                                    const size_t maxIterations,
+                                                    const bool shrinking) :
+    tolerance(tolerance),
+    maxIterations(maxIterations),
+    shrinking(shrinking)
+{
+  // Nothing to do.
+}
+
+template<typename MatType, typename ElemType>
+ElemType DualCoordinateDescent::SolveHinge(const MatType& data,
+                                           const arma::Col<ElemType>& labels,
+                                           const double c,
+                                           const bool fitIntercept,
+                                           arma::Col<ElemType>& weights) const
+{
+  util::CheckSameSizes(data, labels, "DualCoordinateDescent::SolveHinge()",
+      "labels");
+  if (c <= 0.0)
+  {
+    throw std::invalid_argument("DualCoordinateDescent::SolveHinge(): C must "
+        "be positive!");
+  }
+
+  const size_t n = data.n_cols;
+  const ElemType upper = (ElemType) c;
+  weights.zeros(data.n_rows + (fitIntercept ? 1 : 0));
+  arma::Col<ElemType> alpha(n, arma::fill::zeros);
+  arma::Col<ElemType> squaredNorms;
+  SquaredNorms(data, fitIntercept, squaredNorms);
+
+  std::vector<size_t> order(n);
+  for (size_t i = 0; i < n; ++i)
+    order[i] = i;
+
+  // The points in order[0, activeSize) are active; the others are shrunk.
+  // Points are shrunk when the gradient of their dual variable, at a bound,
+  // points outside of the bound by more than the largest violation of the
+  // previous pass.
+  size_t activeSize = n;
+  const ElemType inf = std::numeric_limits<ElemType>::infinity();
+  ElemType maxOldPG = inf;
+  ElemType minOldPG = -inf;
+
+  size_t iteration = 0;
+  while (maxIterations == 0 || iteration < maxIterations)
+  {
+    ElemType maxPG = -inf;
+    ElemType minPG = inf;
+
+    for (size_t s = 0; s + 1 < activeSize; ++s)
+      std::swap(order[s], order[RandInt(s, activeSize)]);
+
+    for (size_t s = 0; s < activeSize; ++s)
+    {
+      const size_t i = order[s];
+      const ElemType g = labels[i] * Dot(data, i, fitIntercept, weights) - 1;
+
+      // Compute the projected gradient, shrinking the point if possible.
+      ElemType pg = 0;
+      if (alpha[i] == 0)
+      {
+        if (shrinking && g > maxOldPG)
+        {
+          --activeSize;
+          std::swap(order[s], order[activeSize]);
+          --s; // Visit the point that was swapped in.
+          continue;
+        }
+        pg = std::min(g, ElemType(0));
+      }
+      else if (alpha[i] == upper)
+      {
+        if (shrinking && g < minOldPG)
+        {
+          --activeSize;
+          std::swap(order[s], order[activeSize]);
+          --s; // Visit the point that was swapped in.
+          continue;
+        }
+        pg = std::max(g, ElemType(0));
+      }
+      else
+      {
+        pg = g;
+      }
+
+      maxPG = std::max(maxPG, pg);
+      minPG = std::min(minPG, pg);
+
+      if (std::abs(pg) > 1e-12 && squaredNorms[i] > 0)
+      {
+        const ElemType oldAlpha = alpha[i];
+        alpha[i] = std::min(std::max(alpha[i] - g / squaredNorms[i],
+            ElemType(0)), upper);
+        Axpy(data, i, fitIntercept, (alpha[i] - oldAlpha) * labels[i],
+            weights);
+      }
+    }
+
+    ++iteration;
+    if (maxPG - minPG <= tolerance)
+    {
+      // The active points are optimal; check all of them before stopping.
+      if (activeSize == n)
+        break;
+
+      activeSize = n;
+      maxOldPG = inf;
+      minOldPG = -inf;
+      continue;
+    }
+
+    maxOldPG = (maxPG <= 0) ? inf : maxPG;
+    minOldPG = (minPG >= 0) ? -inf : minPG;
+  }
+
+  if (maxIterations != 0 && iteration == maxIterations)
+  {
+    #pragma omp critical
+    Log::Warn << "DualCoordinateDescent::SolveHinge(): maximum number of "
+        << "iterations (" << maxIterations << ") reached; the solution may not "
+        << "be optimal." << std::endl;
+  }
+
+  ElemType loss = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    loss += std::max(ElemType(0),
+        1 - labels[i] * Dot(data, i, fitIntercept, weights));
+  }
+
+  return ElemType(0.5) * arma::dot(weights, weights) + upper * loss;
+}
+
+template<typename MatType, typename ElemType>
+ElemType DualCoordinateDescent::SolveLogistic(
+    const MatType& data,
+    const arma::Col<ElemType>& labels,
+    const double c,
+    const bool fitIntercept,
+    arma::Col<ElemType>& weights) const
+{
+  util::CheckSameSizes(data, labels, "DualCoordinateDescent::SolveLogistic()",
+      "labels");
+  if (c <= 0.0)
+  {
+    throw std::invalid_argument("DualCoordinateDescent::SolveLogistic(): C "
+        "must be positive!");
+  }
+
+  // Each point has two dual variables, alpha(0, i) for its label and
+  // alpha(1, i) = C - alpha(0, i), so that the logarithms of the dual
+  // objective are defined; w = sum_i y_i alpha(0, i) x_i.
+  const size_t n = data.n_cols;
+  const ElemType upper = (ElemType) c;
+  weights.zeros(data.n_rows + (fitIntercept ? 1 : 0));
+  arma::Mat<ElemType> alpha(2, n);
+  alpha.row(0).fill(std::min(ElemType(0.001) * upper, ElemType(1e-8)));
+  alpha.row(1) = upper - alpha.row(0);
+  for (size_t i = 0; i < n; ++i)
+    Axpy(data, i, fitIntercept, labels[i] * alpha(0, i), weights);
+
+  arma::Col<ElemType> squaredNorms;
+  SquaredNorms(data, fitIntercept, squaredNorms);
+
+  std::vector<size_t> order(n);
+  for (size_t i = 0; i < n; ++i)
+    order[i] = i;
+
+  // The tolerance of the Newton steps of each subproblem starts loose, and is
+  // tightened when the subproblems need few steps.
+  const size_t maxNewtonIterations = 100;
+  const ElemType minNewtonTolerance = std::min(ElemType(1e-8),
+      ElemType(tolerance));
+  ElemType newtonTolerance = ElemType(1e-2);
+
+  size_t iteration = 0;
+  while (maxIterations == 0 || iteration < maxIterations)
+  {
+    for (size_t s = 0; s + 1 < n; ++s)
+      std::swap(order[s], order[RandInt(s, n)]);
+
+    ElemType maxGradient = 0;
+    size_t newtonIterations = 0;
+    for (size_t s = 0; s < n; ++s)
+    {
+      const size_t i = order[s];
+      const ElemType a = squaredNorms[i];
+      const ElemType b = labels[i] * Dot(data, i, fitIntercept, weights);
+
+      // Minimize z log z + (C - z) log(C - z) + a (z - z_0)^2 / 2 +
+      // sign b (z - z_0) over the dual variable that is in the better
+      // numerical range.
+      size_t first = 0;
+      size_t second = 1;
+      ElemType sign = 1;
+      if (ElemType(0.5) * a * (alpha(second, i) - alpha(first, i)) + b < 0)
+      {
+        std::swap(first, second);
+        sign = -1;
+      }
+
+      const ElemType oldZ = alpha(first, i);
+      ElemType z = oldZ;
+      if (upper - z < ElemType(0.5) * upper)
+        z *= ElemType(0.1);
+      ElemType gradient = a * (z - oldZ) + sign * b +
+          std::log(z / (upper - z));
+      maxGradient = std::max(maxGradient, std::abs(gradient));
+
+      size_t newtonIteration = 0;
+      while (newtonIteration <= maxNewtonIterations &&
+             std::abs(gradient) >= newtonTolerance)
+      {
+        const ElemType hessian = a + upper / (upper - z) / z;
+        const ElemType newZ = z - gradient / hessian;
+        // Keep z inside (0, C).
+        z = (newZ <= 0) ? z * ElemType(0.1) : newZ;
+        gradient = a * (z - oldZ) + sign * b + std::log(z / (upper - z));
+        ++newtonIteration;
+      }
+      newtonIterations += newtonIteration;
+
+      if (newtonIteration > 0)
+      {
+        alpha(first, i) = z;
+        alpha(second, i) = upper - z;
+        Axpy(data, i, fitIntercept, sign * (z - oldZ) * labels[i], weights);
+      }
+    }
+
+    ++iteration;
+    if (maxGradient < tolerance)
+      break;
+
+    if (newtonIterations <= n / 10)
+      newtonTolerance = std::max(minNewtonTolerance,
+          ElemType(0.1) * newtonTolerance);
+  }
+
+  if (maxIterations != 0 && iteration == maxIterations)
+  {
+    #pragma omp critical
+    Log::Warn << "DualCoordinateDescent::SolveLogistic(): maximum number of "
+        << "iterations (" << maxIterations << ") reached; the solution may not "
+        << "be optimal." << std::endl;
+  }
+
+  ElemType loss = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    const ElemType margin = labels[i] * Dot(data, i, fitIntercept, weights);
+    // log(1 + exp(-margin)), computed stably.
+    loss += (margin > 0) ? std::log1p(std::exp(-margin)) :
+        -margin + std::log1p(std::exp(margin));
+  }
+
+  return ElemType(0.5) * arma::dot(weights, weights) + upper * loss;
+}
+
+template<typename MatType, typename ElemType>
+ElemType DualCoordinateDescent::SolveOneVsRest(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const double c,
+    const bool fitIntercept,
+    arma::Mat<ElemType>& weights) const
+{
+  util::CheckSameSizes(data, labels,
+      "DualCoordinateDescent::SolveOneVsRest()", "labels");
+
+  weights.set_size(data.n_rows + (fitIntercept ? 1 : 0), numClasses);
+  ElemType objective = 0;
+
+  // The classifiers are independent, so they are trained in parallel.
+  #pragma omp parallel for schedule(dynamic) reduction(+:objective)
+  for (size_t k = 0; k < numClasses; ++k)
+  {
+    arma::Col<ElemType> y(labels.n_elem);
+    for (size_t i = 0; i < labels.n_elem; ++i)
+      y[i] = (labels[i] == k) ? ElemType(1) : ElemType(-1);
+
+    arma::Col<ElemType> w;
+    objective += SolveHinge(data, y, c, fitIntercept, w);
+    weights.col(k) = w;
+  }
+
+  return objective;
+}
+
+template<typename MatType, typename ElemType>
+ElemType DualCoordinateDescent::Dot(const MatType& data,
+                                    const size_t i,
+                                    const bool fitIntercept,
+                                    const arma::Col<ElemType>& weights)
+{
+  ElemType result = fitIntercept ? weights[data.n_rows] : ElemType(0);
+  if constexpr (arma::is_SpMat<MatType>::value)
+  {
+    for (typename MatType::const_iterator it = data.begin_col(i);
+         it != data.end_col(i); ++it)
+      result += weights[it.row()] * ElemType(*it);
+  }
+  else
+  {
+    const typename MatType::elem_type* x = data.colptr(i);
+    for (size_t j = 0; j < data.n_rows; ++j)
+      result += weights[j] * ElemType(x[j]);
+  }
+
+  return result;
+}
+
+template<typename MatType, typename ElemType>
+void DualCoordinateDescent::Axpy(const MatType& data,
+                                 const size_t i,
+                                 const bool fitIntercept,
+                                 const ElemType a,
+                                 arma::Col<ElemType>& weights)
+{
+  if (fitIntercept)
+    weights[data.n_rows] += a;
+
+  if constexpr (arma::is_SpMat<MatType>::value)
+  {
+    for (typename MatType::const_iterator it = data.begin_col(i);
+         it != data.end_col(i); ++it)
+      weights[it.row()] += a * ElemType(*it);
+  }
+  else
+  {
+    const typename MatType::elem_type* x = data.colptr(i);
+    for (size_t j = 0; j < data.n_rows; ++j)
+      weights[j] += a * ElemType(x[j]);
+  }
+}
+
+template<typename MatType, typename ElemType>
+void DualCoordinateDescent::SquaredNorms(const MatType& data,
+                                         const bool fitIntercept,
+                                         arma::Col<ElemType>& norms)
+{
+  norms.set_size(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    ElemType norm = fitIntercept ? ElemType(1) : ElemType(0);
+    if constexpr (arma::is_SpMat<MatType>::value)
+    {
+      for (typename MatType::const_iterator it = data.begin_col(i);
+           it != data.end_col(i); ++it)
+        norm += ElemType(*it) * ElemType(*it);
+    }
+    else
+    {
+      const typename MatType::elem_type* x = data.colptr(i);
+      for (size_t j = 0; j < data.n_rows; ++j)
+        norm += ElemType(x[j]) * ElemType(x[j]);
+    }
+    norms[i] = norm;
+  }
+}
+
+} // namespace mlpack
+
+#endif
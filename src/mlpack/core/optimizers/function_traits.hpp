@@ -0,0 +1,40 @@
+/**
+ * @file core/optimizers/function_traits.hpp
+ *
+ * This provides the FunctionTraits class, a template class to get information
+ * about the separable objective functions that are optimized by HogwildSGD.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_FUNCTION_TRAITS_HPP
+#define MLPACK_CORE_OPTIMIZERS_FUNCTION_TRAITS_HPP
+
+namespace mlpack {
+
+/**
+ * This is a template class that can provide information about separable
+ * objective functions.  By default, this class will provide the weakest
+ * possible assumptions on functions, and each function should override values
+ * as necessary.  If a function doesn't need to override a value, then there's
+ * no need to write a FunctionTraits specialization for that class.
+ */
+template<typename FunctionType>
+class FunctionTraits
+{
+ public:
+  /**
+   * If true, then Gradient(coordinates, begin, gradient, batchSize) can be
+   * called with a sparse gradient (arma::SpMat), and the result is only
+   * nonzero for the coordinates that the batch touches.  In that case the
+   * regularization term only contributes to the touched coordinates, which is
+   * the usual convention for lock-free parallel SGD.
+   */
+  static const bool SparseGradient = false;
+};
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,150 @@
+/**
+ * @file core/optimizers/hogwild_sgd.hpp
+ *
+ * Definition of HogwildSGD, a lock-free parallel stochastic gradient descent
+ * driver for separable objective functions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_HOGWILD_SGD_HPP
+#define MLPACK_CORE_OPTIMIZERS_HOGWILD_SGD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
+#include "function_traits.hpp"
+
+namespace mlpack {
+
+/**
+ * HogwildSGD runs mini-batch stochastic gradient descent on all the cores at
+ * once, without any lock on the coordinates:
+ *
+ * @code
+ * @inproceedings{recht2011hogwild,
+ *   title={Hogwild!: A lock-free approach to parallelizing stochastic
+ *       gradient descent},
+ *   author={Recht, B. and Re, C. and Wright, S. and Niu, F.},
+ *   booktitle={Advances in Neural Information Processing Systems 24
+ *       (NIPS 2011)},
+ *   pages={693--701},
+ *   year={2011}
+ * }
+ * @endcode
+ *
+ * At each epoch, the points are shuffled (with the function's Shuffle()) and
+ * split into one contiguous partition per thread.  Each thread visits the
+ * mini-batches of its own partition in a random order, computes the gradient
+ * of each mini-batch on the shared coordinates, and applies the step to them
+ * with atomic updates.  If the function computes sparse gradients (see
+ * FunctionTraits), only the coordinates touched by the mini-batch are read
+ * back and written, so threads rarely conflict on sparse problems and the cost
+ * of a step does not depend on the number of coordinates.
+ *
+ * HogwildSGD works with any function that has the separable API used by
+ * ensmallen's SGD, such as LogisticRegressionFunction,
+ * SoftmaxRegressionFunction, LinearSVMFunction or RegularizedSVDFunction, and
+ * can be passed to the Train() functions of the corresponding models:
+ *
+ * @code
+ * extern arma::sp_mat data;
+ * extern arma::Row<size_t> labels;
+ *
+ * HogwildSGD hogwild(0.01, 32, 5); // Step size, batch size, epochs.
+ * LogisticRegression<arma::sp_mat> lr(data.n_rows, 0.001);
+ * lr.Train(data, labels, hogwild);
+ * @endcode
+ *
+ * With a single thread (or without OpenMP), this is plain mini-batch SGD.
+ */
+class HogwildSGD
+{
+ public:
+  /**
+   * Construct the optimizer with the given parameters.
+   *
+   * @param stepSize Step size of each update.
+   * @param batchSize Number of points in each mini-batch.
+   * @param maxEpochs Maximum number of passes over the data; 0 means no
+   *     limit.
+   * @param tolerance Stop when the objective improves by less than this
+   *     between two epochs.
+   * @param shuffle If true, the points are shuffled at each epoch, and each
+   *     thread visits its mini-batches in random order.
+   */
+  HogwildSGD(const double stepSize = 0.01,
+             const size_t batchSize = 32,
+             const size_t maxEpochs = 10,
+             const double tolerance = 1e-5,
+             const bool shuffle = true);
+
+  /**
+   * Optimize the given function, starting from (and storing the result in)
+   * the given coordinates.  The objective is evaluated on all the data after
+   * each epoch.
+   *
+   * @param function Separable function to optimize.
+   * @param iterate Starting point, which will hold the final point.
+   * @return Objective at the final point.
+   */
+  template<typename FunctionType, typename MatType>
+  typename MatType::elem_type Optimize(FunctionType& function,
+                                       MatType& iterate);
+
+  //! Get the step size.
+  double StepSize() const { return stepSize; }
+  //! Modify the step size.
+  double& StepSize() { return stepSize; }
+
+  //! Get the number of points in each mini-batch.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points in each mini-batch.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the maximum number of epochs (0 means no limit).
+  size_t MaxEpochs() const { return maxEpochs; }
+  //! Modify the maximum number of epochs (0 means no limit).
+  size_t& MaxEpochs() { return maxEpochs; }
+
+  //! Get the tolerance for termination.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for termination.
+  double& Tolerance() { return tolerance; }
+
+  //! Get whether the points are shuffled.
+  bool Shuffle() const { return shuffle; }
+  //! Modify whether the points are shuffled.
+  bool& Shuffle() { return shuffle; }
+
+ private:
+  //! Subtract stepSize * gradient from the coordinates, atomically.
+  template<typename ElemType, typename GradType>
+  static void Update(ElemType* coordinates,
+                     const size_t numRows,
+                     const ElemType stepSize,
+                     const GradType& gradient);
+
+  //! Step size of each update.
+  double stepSize;
+  //! Number of points in each mini-batch.
+  size_t batchSize;
+  //! Maximum number of epochs.
+  size_t maxEpochs;
+  //! Tolerance for termination.
+  double tolerance;
+  //! Whether to shuffle the points.
+  bool shuffle;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "hogwild_sgd_impl.hpp"
+
+#endif
@@ -0,0 +1,143 @@
+/**
+ * @file core/optimizers/hogwild_sgd_impl.hpp
+ *
+ * Implementation of HogwildSGD.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_HOGWILD_SGD_IMPL_HPP
+#define MLPACK_CORE_OPTIMIZERS_HOGWILD_SGD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hogwild_sgd.hpp"
+
+namespace mlpack {
+
+inline HogwildSGD::HogwildSGD(const double stepSize,
+                              const size_t batchSize,
+                              const size_t maxEpochs,
+                              const double tolerance,
+                              const bool shuffle) :
+    stepSize(stepSize),
+    batchSize(batchSize),
+    maxEpochs(maxEpochs),
+    tolerance(tolerance),
+    shuffle(shuffle)
+{
+  // Nothing to do.
+}
+
+template<typename FunctionType, typename MatType>
+typename MatType::elem_type HogwildSGD::Optimize(FunctionType& function,
+                                                 MatType& iterate)
+{
+  using ElemType = typename MatType::elem_type;
+  using GradType = std::conditional_t<
+      FunctionTraits<FunctionType>::SparseGradient,
+      arma::SpMat<ElemType>,
+      arma::Mat<ElemType>>;
+
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("HogwildSGD::Optimize(): the batch size must "
+        "be positive");
+  }
+
+  const size_t numFunctions = function.NumFunctions();
+  const ElemType step = (ElemType) stepSize;
+
+  ElemType objective = function.Evaluate(iterate);
+  for (size_t epoch = 1; maxEpochs == 0 || epoch <= maxEpochs; ++epoch)
+  {
+    if (shuffle)
+      function.Shuffle();
+
+    #pragma omp parallel
+    {
+      size_t thread = 0;
+      size_t numThreads = 1;
+      #ifdef MLPACK_USE_OPENMP
+        thread = omp_get_thread_num();
+        numThreads = omp_get_num_threads();
+      #endif
+
+      // Each thread gets a contiguous partition of the (shuffled) points, and
+      // visits its mini-batches in its own random order.
+      const size_t first = numFunctions * thread / numThreads;
+      const size_t last = numFunctions * (thread + 1) / numThreads;
+      std::vector<size_t> batchStarts;
+      for (size_t begin = first; begin < last; begin += batchSize)
+        batchStarts.push_back(begin);
+      if (shuffle)
+        std::shuffle(batchStarts.begin(), batchStarts.end(), RandGen());
+
+      GradType gradient;
+      for (const size_t begin : batchStarts)
+      {
+        const size_t effectiveBatchSize = std::min(batchSize, last - begin);
+        function.Gradient(iterate, begin, gradient, effectiveBatchSize);
+        Update(iterate.memptr(), iterate.n_rows, step, gradient);
+      }
+    }
+
+    const ElemType lastObjective = objective;
+    objective = function.Evaluate(iterate);
+    Log::Info << "HogwildSGD: epoch " << epoch << ", objective " << objective
+        << "." << std::endl;
+
+    if (std::isnan(objective) || std::isinf(objective))
+    {
+      Log::Warn << "HogwildSGD: converged to " << objective << "; terminating "
+          << "with failure.  Try a smaller step size?" << std::endl;
+      return objective;
+    }
+
+    if (std::abs(lastObjective - objective) < tolerance)
+    {
+      Log::Info << "HogwildSGD: minimized within tolerance " << tolerance
+          << "; terminating optimization." << std::endl;
+      return objective;
+    }
+  }
+
+  Log::Info << "HogwildSGD: maximum number of epochs (" << maxEpochs << ") "
+      << "reached; terminating optimization." << std::endl;
+  return objective;
+}
+
+template<typename ElemType, typename GradType>
+void HogwildSGD::Update(ElemType* coordinates,
+                        const size_t numRows,
+                        const ElemType stepSize,
+                        const GradType& gradient)
+{
+  if constexpr (arma::is_SpMat<GradType>::value)
+  {
+    // Only the coordinates that the batch touches are written.
+    for (typename GradType::const_iterator it = gradient.begin();
+         it != gradient.end(); ++it)
+    {
+      const size_t index = it.row() + it.col() * numRows;
+      const ElemType value = stepSize * (*it);
+      #pragma omp atomic
+      coordinates[index] -= value;
+    }
+  }
+  else
+  {
+    const ElemType* g = gradient.memptr();
+    for (size_t i = 0; i < gradient.n_elem; ++i)
+    {
+      const ElemType value = stepSize * g[i];
+      #pragma omp atomic
+      coordinates[i] -= value;
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
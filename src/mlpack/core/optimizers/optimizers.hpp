@@ -0,0 +1,20 @@
+/**
+ * @file core/optimizers/optimizers.hpp
+ *
+ * Convenience include for the optimizers that are implemented in mlpack
+ * itself (most optimizers are provided by ensmallen).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_OPTIMIZERS_HPP
+#define MLPACK_CORE_OPTIMIZERS_OPTIMIZERS_HPP
+
+#include "function_traits.hpp"
+#include "dual_coordinate_descent.hpp"
+#include "hogwild_sgd.hpp"
+#include "stratified_sgd.hpp"
+
+#endif
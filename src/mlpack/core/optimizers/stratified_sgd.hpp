@@ -0,0 +1,164 @@
+/**
+ * @file core/optimizers/stratified_sgd.hpp
+ *
+ * Definition of StratifiedSGD, a parallel stochastic gradient descent driver
+ * for matrix factorization that schedules the ratings in blocks that never
+ * share users or items.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_STRATIFIED_SGD_HPP
+#define MLPACK_CORE_OPTIMIZERS_STRATIFIED_SGD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/parallel.hpp>
+
+namespace mlpack {
+
+/**
+ * StratifiedSGD runs stochastic gradient descent for matrix factorization on
+ * all the cores at once, with the stratified schedule of distributed SGD
+ * (DSGD):
+ *
+ * @code
+ * @inproceedings{gemulla2011large,
+ *   title={Large-scale matrix factorization with distributed stochastic
+ *       gradient descent},
+ *   author={Gemulla, R. and Nijkamp, E. and Haas, P.J. and Sismanis, Y.},
+ *   booktitle={Proceedings of the 17th ACM SIGKDD International Conference on
+ *       Knowledge Discovery and Data Mining (KDD 2011)},
+ *   pages={69--77},
+ *   year={2011}
+ * }
+ * @endcode
+ *
+ * The users and the items are each split into B blocks (in a random order, so
+ * that popular items are spread over the blocks), which splits the ratings
+ * into B x B blocks.  An epoch is made of B strata: stratum s holds the blocks
+ * (b, (b + s) mod B) for every user block b.  The blocks of a stratum share no
+ * user and no item, so they are processed in parallel without any lock or
+ * atomic operation, and without two threads ever writing the same parameter
+ * column.  Unlike Hogwild-style updates, this does not degrade when a few
+ * items are in most of the ratings.
+ *
+ * The same schedule works on several nodes: if node b holds the ratings and
+ * the user factors of user block b, then during stratum s it only needs the
+ * factors of item block (b + s) mod B, and between two strata each item block
+ * only moves from one node to the next.
+ *
+ * The function must be a matrix factorization function in the form of
+ * RegularizedSVDFunction, BiasSVDFunction or SVDPlusPlusFunction: the columns
+ * of Dataset() are (user, item, rating) triples, the parameters of user u are
+ * in column u and those of item i in column NumUsers() + i, and the function
+ * provides
+ *
+ * - `Update(parameters, i, stepSize)`, which takes a step for rating i and
+ *   only writes the columns of its user and item, and
+ * - `FinishStratum(parameters, stepSize)`, which is called at the end of each
+ *   stratum to apply updates that do not fit the schedule (such as those of
+ *   the implicit item vectors of SVD++).
+ *
+ * @code
+ * extern arma::mat data; // (user, item, rating) table.
+ * arma::mat u, v;
+ *
+ * RegularizedSVD<StratifiedSGD> svd(10); // 10 epochs.
+ * svd.Apply(data, 20, u, v); // Rank 20.
+ * @endcode
+ *
+ * With a single block (for instance with a single thread, or without OpenMP),
+ * this is plain SGD over the ratings.
+ */
+class StratifiedSGD
+{
+ public:
+  /**
+   * Construct the optimizer with the given parameters.
+   *
+   * @param stepSize Step size of each update.
+   * @param maxEpochs Maximum number of passes over the data; 0 means no
+   *     limit.
+   * @param tolerance Stop when the objective improves by less than this
+   *     between two epochs.
+   * @param numBlocks Number of blocks of users and of items; 0 means
+   *     ThreadBudget().
+   * @param shuffle If true, the strata and the ratings of each block are
+   *     visited in a random order at each epoch.
+   */
+  StratifiedSGD(const double stepSize = 0.01,
+                const size_t maxEpochs = 10,
+                const double tolerance = 1e-5,
+                const size_t numBlocks = 0,
+                const bool shuffle = true);
+
+  /**
+   * Optimize the given function, starting from (and storing the result in)
+   * the given parameters.  The objective is evaluated on all the data after
+   * each epoch.
+   *
+   * @param function Matrix factorization function to optimize.
+   * @param iterate Starting point, which will hold the final point.
+   * @return Objective at the final point.
+   */
+  template<typename FunctionType>
+  double Optimize(FunctionType& function, arma::mat& iterate);
+
+  //! Get the step size.
+  double StepSize() const { return stepSize; }
+  //! Modify the step size.
+  double& StepSize() { return stepSize; }
+
+  //! Get the maximum number of epochs (0 means no limit).
+  size_t MaxEpochs() const { return maxEpochs; }
+  //! Modify the maximum number of epochs (0 means no limit).
+  size_t& MaxEpochs() { return maxEpochs; }
+
+  //! Get the tolerance for termination.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for termination.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the number of blocks (0 means ThreadBudget()).
+  size_t NumBlocks() const { return numBlocks; }
+  //! Modify the number of blocks (0 means ThreadBudget()).
+  size_t& NumBlocks() { return numBlocks; }
+
+  //! Get whether the strata and the ratings are shuffled.
+  bool Shuffle() const { return shuffle; }
+  //! Modify whether the strata and the ratings are shuffled.
+  bool& Shuffle() { return shuffle; }
+
+ private:
+  /**
+   * Assign each of n indices to one of the given number of blocks, so that
+   * the blocks have (nearly) the same size.
+   *
+   * @param n Number of indices.
+   * @param blocks Number of blocks.
+   * @param assignments Vector to store the block of each index in.
+   */
+  void AssignBlocks(const size_t n,
+                    const size_t blocks,
+                    arma::Col<size_t>& assignments) const;
+
+  //! Step size of each update.
+  double stepSize;
+  //! Maximum number of epochs.
+  size_t maxEpochs;
+  //! Tolerance for termination.
+  double tolerance;
+  //! Number of blocks of users and of items.
+  size_t numBlocks;
+  //! Whether to shuffle the strata and the ratings.
+  bool shuffle;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "stratified_sgd_impl.hpp"
+
+#endif
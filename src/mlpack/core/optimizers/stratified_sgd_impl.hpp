@@ -0,0 +1,132 @@
+/**
+ * @file core/optimizers/stratified_sgd_impl.hpp
+ *
+ * Implementation of StratifiedSGD.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_STRATIFIED_SGD_IMPL_HPP
+#define MLPACK_CORE_OPTIMIZERS_STRATIFIED_SGD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "stratified_sgd.hpp"
+
+namespace mlpack {
+
+inline StratifiedSGD::StratifiedSGD(const double stepSize,
+                                    const size_t maxEpochs,
+                                    const double tolerance,
+                                    const size_t numBlocks,
+                                    const bool shuffle) :
+    stepSize(stepSize),
+    maxEpochs(maxEpochs),
+    tolerance(tolerance),
+    numBlocks(numBlocks),
+    shuffle(shuffle)
+{
+  // Nothing to do.
+}
+
+template<typename FunctionType>
+double StratifiedSGD::Optimize(FunctionType& function, arma::mat& iterate)
+{
+  const arma::mat& data = function.Dataset();
+  const size_t numUsers = function.NumUsers();
+  const size_t numItems = function.NumItems();
+
+  const size_t threads = ThreadBudget();
+  size_t blocks = (numBlocks == 0) ? threads : numBlocks;
+  // A block can't be empty.
+  blocks = std::max(size_t(1), std::min(blocks, std::min(numUsers, numItems)));
+
+  arma::Col<size_t> userBlocks, itemBlocks;
+  AssignBlocks(numUsers, blocks, userBlocks);
+  AssignBlocks(numItems, blocks, itemBlocks);
+
+  // The ratings of block (b, c) are those of the users of block b for the
+  // items of block c.
+  std::vector<std::vector<size_t>> ratingBlocks(blocks * blocks);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    const size_t userBlock = userBlocks[(size_t) data(0, i)];
+    const size_t itemBlock = itemBlocks[(size_t) data(1, i)];
+    ratingBlocks[userBlock * blocks + itemBlock].push_back(i);
+  }
+
+  std::vector<size_t> strata(blocks);
+  for (size_t s = 0; s < blocks; ++s)
+    strata[s] = s;
+
+  double objective = function.Evaluate(iterate);
+  for (size_t epoch = 1; maxEpochs == 0 || epoch <= maxEpochs; ++epoch)
+  {
+    if (shuffle)
+      std::shuffle(strata.begin(), strata.end(), RandGen());
+
+    for (const size_t s : strata)
+    {
+      // The blocks of the stratum share no user and no item, so no two
+      // threads write the same parameter column.
+      #pragma omp parallel for schedule(dynamic) num_threads(threads)
+      for (size_t b = 0; b < blocks; ++b)
+      {
+        std::vector<size_t>& ratings =
+            ratingBlocks[b * blocks + (b + s) % blocks];
+        if (shuffle)
+          std::shuffle(ratings.begin(), ratings.end(), RandGen());
+
+        for (const size_t i : ratings)
+          function.Update(iterate, i, stepSize);
+      }
+
+      function.FinishStratum(iterate, stepSize);
+    }
+
+    const double lastObjective = objective;
+    objective = function.Evaluate(iterate);
+    Log::Info << "StratifiedSGD: epoch " << epoch << ", objective "
+        << objective << "." << std::endl;
+
+    if (std::isnan(objective) || std::isinf(objective))
+    {
+      Log::Warn << "StratifiedSGD: converged to " << objective << "; "
+          << "terminating with failure.  Try a smaller step size?"
+          << std::endl;
+      return objective;
+    }
+
+    if (std::abs(lastObjective - objective) < tolerance)
+    {
+      Log::Info << "StratifiedSGD: minimized within tolerance " << tolerance
+          << "; terminating optimization." << std::endl;
+      return objective;
+    }
+  }
+
+  Log::Info << "StratifiedSGD: maximum number of epochs (" << maxEpochs
+      << ") reached; terminating optimization." << std::endl;
+  return objective;
+}
+
+inline void StratifiedSGD::AssignBlocks(const size_t n,
+                                        const size_t blocks,
+                                        arma::Col<size_t>& assignments) const
+{
+  // Popular users and items tend to have neighboring indices (for instance
+  // when they are numbered in order of appearance), so the blocks are made
+  // from a random permutation of the indices.
+  arma::Col<size_t> order = arma::linspace<arma::Col<size_t>>(0, n - 1, n);
+  if (shuffle)
+    std::shuffle(order.begin(), order.end(), RandGen());
+
+  assignments.set_size(n);
+  for (size_t i = 0; i < n; ++i)
+    assignments[order[i]] = i * blocks / n;
+}
+
+} // namespace mlpack
+
+#endif
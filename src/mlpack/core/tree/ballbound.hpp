@@ -23,6 +23,11 @@ namespace mlpack {
  * specific point (center). DistanceType is the custom distance metric type that
  * defaults to the Euclidean (L2) distance.
  *
+ * The center can be stored in a smaller type than ElemType, by giving a dense
+ * VecType with another element type (see CompactBallBound); distances are
+ * still computed in ElemType, and the radius is grown by the rounding error of
+ * the center, so the ball still contains all the points it was expanded to.
+ *
  * @tparam DistanceType distance metric type used in the distance measure.
  * @tparam VecType Type of vector (arma::vec or arma::sp_vec or similar).
  */
@@ -121,6 +126,20 @@ class BallBound
    */
   void Center(VecType& center) const { center = this->center; }
 
+  /**
+   * Place the center of BallBound into the given vector of another type (for
+   * instance, an arma::Col<ElemType> when the center is compact).
+   *
+   * @param center Vector which the centroid will be written to.
+   */
+  template<typename OtherVecType>
+  void Center(OtherVecType& center,
+              typename std::enable_if_t<
+                  !std::is_same_v<OtherVecType, VecType>>* = 0) const
+  {
+    center = arma::conv_to<OtherVecType>::from(this->center);
+  }
+
   /**
    * Calculates minimum bound-to-point squared distance.
    *
@@ -207,8 +226,31 @@ class BallBound
   //! Serialize the bound.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
+
+ private:
+  //! True if the center is stored in another type than ElemType.
+  static constexpr bool CompactCenter =
+      !std::is_same_v<typename VecType::elem_type, ElemType>;
+
+  //! Compute the distance between the center and the given point, in
+  //! ElemType.
+  template<typename OtherVecType>
+  ElemType CenterDistance(const OtherVecType& point) const;
+
+  //! Compute the distance between the center and the center of another ball,
+  //! in ElemType.
+  ElemType CenterDistance(const BallBound& other) const;
 };
 
+/**
+ * A BallBound that stores its center in single precision; use it as the
+ * BoundType of a tree (e.g. a BinarySpaceTree) to reduce the memory used by the
+ * bounds of the tree.
+ */
+template<typename DistanceType = LMetric<2, true>,
+         typename ElemType = double>
+using CompactBallBound = BallBound<DistanceType, ElemType, arma::Col<float>>;
+
 //! A specialization of BoundTraits for this bound type.
 template<typename DistanceType, typename VecType>
 struct BoundTraits<BallBound<DistanceType, VecType>>
@@ -145,7 +145,7 @@ bool BallBound<DistanceType, ElemType, VecType>::Contains(const VecType& point)
   if (radius < 0)
     return false;
   else
-    return distance->Evaluate(center, point) <= radius;
+    return CenterDistance(point) <= radius;
 }
 
 /**
@@ -160,7 +160,7 @@ ElemType BallBound<DistanceType, ElemType, VecType>::MinDistance(
   if (radius < 0)
     return std::numeric_limits<ElemType>::max();
   else
-    return std::max(distance->Evaluate(point, center) - radius, (ElemType) 0.0);
+    return std::max(CenterDistance(point) - radius, (ElemType) 0.0);
 }
 
 /**
@@ -174,8 +174,7 @@ ElemType BallBound<DistanceType, ElemType, VecType>::MinDistance(
     return std::numeric_limits<ElemType>::max();
   else
   {
-    const ElemType delta = distance->Evaluate(center, other.center) - radius -
-        other.radius;
+    const ElemType delta = CenterDistance(other) - radius - other.radius;
     return std::max(delta, (ElemType) 0.0);
   }
 }
@@ -192,7 +191,7 @@ ElemType BallBound<DistanceType, ElemType, VecType>::MaxDistance(
   if (radius < 0)
     return std::numeric_limits<ElemType>::max();
   else
-    return distance->Evaluate(point, center) + radius;
+    return CenterDistance(point) + radius;
 }
 
 /**
@@ -205,7 +204,7 @@ ElemType BallBound<DistanceType, ElemType, VecType>::MaxDistance(
   if (radius < 0)
     return std::numeric_limits<ElemType>::max();
   else
-    return distance->Evaluate(other.center, center) + radius + other.radius;
+    return CenterDistance(other) + radius + other.radius;
 }
 
 /**
@@ -224,7 +223,7 @@ RangeType<ElemType> BallBound<DistanceType, ElemType, VecType>::RangeDistance(
                                std::numeric_limits<ElemType>::max());
   else
   {
-    const ElemType dist = distance->Evaluate(center, point);
+    const ElemType dist = CenterDistance(point);
     return RangeType<ElemType>(std::max(dist - radius, (ElemType) 0.0),
                                dist + radius);
   }
@@ -239,7 +238,7 @@ RangeType<ElemType> BallBound<DistanceType, ElemType, VecType>::RangeDistance(
                                std::numeric_limits<ElemType>::max());
   else
   {
-    const ElemType dist = distance->Evaluate(center, other.center);
+    const ElemType dist = CenterDistance(other);
     const ElemType sumradius = radius + other.radius;
     return RangeType<ElemType>(std::max(dist - sumradius, (ElemType) 0.0),
                                dist + sumradius);
@@ -257,31 +256,108 @@ template<typename MatType>
 const BallBound<DistanceType, ElemType, VecType>&
 BallBound<DistanceType, ElemType, VecType>::operator|=(const MatType& data)
 {
-  if (radius < 0)
+  if constexpr (CompactCenter)
   {
-    center = data.col(0);
-    radius = 0;
-  }
+    // Expand a copy of the center in ElemType; then round it to the compact
+    // type, and grow the radius by the distance that the center moved, so that
+    // the ball still contains all points.
+    arma::Col<ElemType> exactCenter;
+    if (radius < 0)
+    {
+      exactCenter = data.col(0);
+      radius = 0;
+    }
+    else
+    {
+      exactCenter = arma::conv_to<arma::Col<ElemType>>::from(center);
+    }
+
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      const arma::Col<ElemType> point(data.col(i));
+      const ElemType dist = distance->Evaluate(exactCenter, point);
+
+      if (dist > radius)
+      {
+        exactCenter += ((dist - radius) / (2 * dist)) * (point - exactCenter);
+        radius = 0.5 * (dist + radius);
+      }
+    }
 
-  // Now iteratively add points.
-  for (size_t i = 0; i < data.n_cols; ++i)
+    center = arma::conv_to<VecType>::from(exactCenter);
+    radius += CenterDistance(exactCenter);
+  }
+  else
   {
-    const ElemType dist = distance->Evaluate(center, (VecType) data.col(i));
+    if (radius < 0)
+    {
+      center = data.col(0);
+      radius = 0;
+    }
 
-    // See if the new point lies outside the bound.
-    if (dist > radius)
+    // Now iteratively add points.
+    for (size_t i = 0; i < data.n_cols; ++i)
     {
-      // Move towards the new point and increase the radius just enough to
-      // accommodate the new point.
-      const VecType diff = data.col(i) - center;
-      center += ((dist - radius) / (2 * dist)) * diff;
-      radius = 0.5 * (dist + radius);
+      const ElemType dist = distance->Evaluate(center, (VecType) data.col(i));
+
+      // See if the new point lies outside the bound.
+      if (dist > radius)
+      {
+        // Move towards the new point and increase the radius just enough to
+        // accommodate the new point.
+        const VecType diff = data.col(i) - center;
+        center += ((dist - radius) / (2 * dist)) * diff;
+        radius = 0.5 * (dist + radius);
+      }
     }
   }
 
   return *this;
 }
 
+/**
+ * Compute the distance between the center and the given point, in ElemType.
+ */
+template<typename DistanceType, typename ElemType, typename VecType>
+template<typename OtherVecType>
+ElemType BallBound<DistanceType, ElemType, VecType>::CenterDistance(
+    const OtherVecType& point) const
+{
+  if constexpr (CompactCenter)
+  {
+    const arma::Col<ElemType> exactCenter =
+        arma::conv_to<arma::Col<ElemType>>::from(center);
+    if constexpr (std::is_same_v<typename OtherVecType::elem_type, ElemType>)
+      return distance->Evaluate(point, exactCenter);
+    else
+      return distance->Evaluate(
+          arma::conv_to<arma::Col<ElemType>>::from(point), exactCenter);
+  }
+  else
+  {
+    return distance->Evaluate(point, center);
+  }
+}
+
+/**
+ * Compute the distance between the centers of two balls, in ElemType.
+ */
+template<typename DistanceType, typename ElemType, typename VecType>
+ElemType BallBound<DistanceType, ElemType, VecType>::CenterDistance(
+    const BallBound& other) const
+{
+  if constexpr (CompactCenter)
+  {
+    return distance->Evaluate(
+        arma::conv_to<arma::Col<ElemType>>::from(center),
+        arma::conv_to<arma::Col<ElemType>>::from(other.center));
+  }
+  else
+  {
+    return distance->Evaluate(center, other.center);
+  }
+}
+
 //! Serialize the BallBound.
 template<typename DistanceType, typename ElemType, typename VecType>
 template<typename Archive>
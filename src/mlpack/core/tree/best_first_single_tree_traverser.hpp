@@ -0,0 +1,125 @@
+/**
+ * @file core/tree/best_first_single_tree_traverser.hpp
+ *
+ * A best-first single-tree traverser, which visits the nodes of any type of
+ * tree in the order of their scores, with a global priority queue, and can stop
+ * after a given number of visited nodes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "tree_traits.hpp"
+
+#include <queue>
+#include <unordered_set>
+
+namespace mlpack {
+
+/**
+ * The BestFirstSingleTreeTraverser visits the nodes of the tree in order of
+ * their score: instead of recursing depth-first, it keeps all the nodes that
+ * have been scored but not visited yet in a priority queue, and always visits
+ * the node with the best (lowest) score, rescoring it first.  For
+ * nearest-neighbor search, this reaches the leaves that are closest to the
+ * query point first, so good candidates are found after only a few visits.
+ *
+ * The traversal can be stopped after a given number of visited nodes (the
+ * budget); the results are then approximate, but the time of each traversal is
+ * bounded.  When the budget is used up, the traversal continues only until
+ * rule.MinimumBaseCases() base cases have been computed, so that the results
+ * are complete.  With no budget, the traversal is exact: it gives the same
+ * results as the depth-first single-tree traversers.
+ *
+ * This works with any type of tree.  The RuleType class must implement
+ * BaseCase(), Score(), Rescore() and MinimumBaseCases().
+ */
+template<typename TreeType, typename RuleType>
+class BestFirstSingleTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the best-first single tree traverser with the given rule set.
+   *
+   * @param rule Rules to traverse the tree with.
+   * @param maxVisits Maximum number of nodes to visit for each query point (0
+   *     means no limit).
+   */
+  BestFirstSingleTreeTraverser(RuleType& rule, const size_t maxVisits = 0);
+
+  /**
+   * Traverse the tree with the given point.
+   *
+   * @param queryIndex The index of the point in the query set which is being
+   *     used as the query point.
+   * @param referenceNode The tree node to be traversed.
+   */
+  void Traverse(const size_t queryIndex, TreeType& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of prunes.
+  size_t& NumPrunes() { return numPrunes; }
+
+  //! Get the number of visited nodes.
+  size_t NumVisits() const { return numVisits; }
+
+  //! Get the maximum number of nodes to visit for each query point.
+  size_t MaxVisits() const { return maxVisits; }
+  //! Modify the maximum number of nodes to visit for each query point (0 means
+  //! no limit).
+  size_t& MaxVisits() { return maxVisits; }
+
+ private:
+  //! A node waiting to be visited, with its score.
+  struct QueueEntry
+  {
+    //! The score of the node.
+    double score;
+    //! The order in which the node was scored; when scores are equal, the
+    //! last scored node is visited first, so the traversal goes down the tree.
+    size_t order;
+    //! The node.
+    TreeType* node;
+
+    //! Order the entries so that the best one is at the top of the queue.
+    bool operator<(const QueueEntry& other) const
+    {
+      return (score > other.score) ||
+          (score == other.score && order < other.order);
+    }
+  };
+
+  //! Compute the base cases with the points held in the given node.
+  void BaseCases(const size_t queryIndex, const TreeType& node);
+
+  //! Reference to the rules with which the tree will be traversed.
+  RuleType& rule;
+  //! The maximum number of nodes to visit for each query point.
+  size_t maxVisits;
+
+  //! The number of nodes which have been pruned during traversal.
+  size_t numPrunes;
+  //! The number of nodes visited during traversal.
+  size_t numVisits;
+  //! The number of base cases computed for the current query point.
+  size_t queryBaseCases;
+
+  //! The nodes to visit for the current query point.
+  std::priority_queue<QueueEntry> queue;
+  //! The points already evaluated for the current query point, for trees in
+  //! which a point can be held by several nodes (like spill trees).
+  std::unordered_set<size_t> evaluated;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "best_first_single_tree_traverser_impl.hpp"
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * @file core/tree/best_first_single_tree_traverser_impl.hpp
+ *
+ * Implementation of the BestFirstSingleTreeTraverser, which visits the nodes
+ * of any type of tree in the order of their scores.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "best_first_single_tree_traverser.hpp"
+
+namespace mlpack {
+
+template<typename TreeType, typename RuleType>
+BestFirstSingleTreeTraverser<TreeType, RuleType>::BestFirstSingleTreeTraverser(
+    RuleType& rule,
+    const size_t maxVisits) :
+    rule(rule),
+    maxVisits(maxVisits),
+    numPrunes(0),
+    numVisits(0),
+    queryBaseCases(0)
+{ /* Nothing to do. */ }
+
+template<typename TreeType, typename RuleType>
+void BestFirstSingleTreeTraverser<TreeType, RuleType>::Traverse(
+    const size_t queryIndex,
+    TreeType& referenceNode)
+{
+  queue = std::priority_queue<QueueEntry>();
+  evaluated.clear();
+  queryBaseCases = 0;
+  size_t order = 0;
+  size_t visits = 0;
+
+  const double rootScore = rule.Score(queryIndex, referenceNode);
+  if (rootScore == DBL_MAX)
+  {
+    ++numPrunes;
+    return;
+  }
+  queue.push({ rootScore, order++, &referenceNode });
+
+  while (!queue.empty())
+  {
+    // Once the budget is used up, only continue until there are enough
+    // results.
+    if (maxVisits > 0 && visits >= maxVisits &&
+        queryBaseCases > rule.MinimumBaseCases())
+    {
+      numPrunes += queue.size();
+      break;
+    }
+
+    const QueueEntry entry = queue.top();
+    queue.pop();
+
+    // The bound may have tightened since the node was scored.
+    if (rule.Rescore(queryIndex, *entry.node, entry.score) == DBL_MAX)
+    {
+      ++numPrunes;
+      continue;
+    }
+
+    ++visits;
+    BaseCases(queryIndex, *entry.node);
+
+    for (size_t i = 0; i < entry.node->NumChildren(); ++i)
+    {
+      TreeType& child = entry.node->Child(i);
+      const double score = rule.Score(queryIndex, child);
+      if (score == DBL_MAX)
+        ++numPrunes;
+      else
+        queue.push({ score, order++, &child });
+    }
+  }
+
+  numVisits += visits;
+}
+
+template<typename TreeType, typename RuleType>
+void BestFirstSingleTreeTraverser<TreeType, RuleType>::BaseCases(
+    const size_t queryIndex,
+    const TreeType& node)
+{
+  // When the first point of a node is its centroid, Score() has already
+  // computed the base case with it.
+  const size_t first = TreeTraits<TreeType>::FirstPointIsCentroid ? 1 : 0;
+
+  for (size_t i = first; i < node.NumPoints(); ++i)
+  {
+    const size_t point = node.Point(i);
+    if constexpr (!TreeTraits<TreeType>::UniqueNumDescendants &&
+                  !TreeTraits<TreeType>::FirstPointIsCentroid)
+    {
+      // The point may also be held by a node that was already visited.
+      if (!evaluated.insert(point).second)
+        continue;
+    }
+
+    rule.BaseCase(queryIndex, point);
+    ++queryBaseCases;
+  }
+
+  // Count the base case with the centroid, unless it is the centroid of the
+  // parent too.
+  if (first == 1 && node.NumPoints() > 0 && (node.Parent() == NULL ||
+      node.Point(0) != node.Parent()->Point(0)))
+    ++queryBaseCases;
+}
+
+} // namespace mlpack
+
+#endif
@@ -15,6 +15,7 @@
 
 #include "../statistic.hpp"
 #include "midpoint_split.hpp"
+#include "node_layout.hpp"
 
 namespace mlpack {
 
@@ -88,6 +89,11 @@ class BinarySpaceTree
   //! The dataset.  If we are the root of the tree, we own the dataset and must
   //! delete it.
   MatType* dataset;
+  //! The array holding all the other nodes of the tree, if this is the root
+  //! and PackNodes() was called, or NULL otherwise.
+  BinarySpaceTree* nodePool;
+  //! The number of nodes in nodePool.
+  size_t nodePoolSize;
 
  public:
   //! A single-tree traverser for binary space trees; see
@@ -102,6 +108,17 @@ class BinarySpaceTree
   template<typename RuleType>
   class BreadthFirstDualTreeTraverser;
 
+  //! A dual-tree traverser that traverses independent query subtrees in
+  //! parallel; see parallel_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  class ParallelDualTreeTraverser;
+
+  //! A breadth-first dual-tree traverser that traverses the subtrees of the
+  //! children of large query nodes in parallel; see
+  //! parallel_breadth_first_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  class ParallelBreadthFirstDualTreeTraverser;
+
   /**
    * A default constructor.  This returns an empty tree, which is not useful.
    * In general this is only used for serialization or right before copying from
@@ -521,6 +538,30 @@ class BinarySpaceTree
   //! Store the center of the bounding region in the given vector.
   void Center(arma::Col<ElemType>& center) const { bound.Center(center); }
 
+  //! Nodes with at least this many points have their children built in
+  //! parallel, if OpenMP is enabled and the split type allows it.
+  static const size_t ParallelBuildMinPoints = 20000;
+
+  /**
+   * Move all the nodes of the tree, except this root node, into one contiguous
+   * array, in the given order, so that the traversals of the tree take fewer
+   * cache misses than with nodes allocated one by one.  Bounds and statistics
+   * are held by the nodes, so they are moved with them; pointers and
+   * references to nodes other than the root are invalidated.  The structure of
+   * the tree does not change, so all traversers work as before, and the array
+   * is freed with a single deallocation when the tree is destroyed.  Copies of
+   * the tree allocate their nodes one by one.  This can only be called on the
+   * root of the tree; otherwise, a std::invalid_argument is thrown.
+   *
+   * @param layout Order of the nodes in memory (DEPTH_FIRST_LAYOUT or
+   *     VAN_EMDE_BOAS_LAYOUT).
+   */
+  void PackNodes(const NodeLayout layout = DEPTH_FIRST_LAYOUT);
+
+  //! Return whether the nodes of the tree below this root are stored in one
+  //! contiguous array (see PackNodes()).
+  bool IsPacked() const { return nodePool != NULL; }
+
  private:
   /**
    * Splits the current node, assigning its left and right children recursively.
@@ -545,6 +586,43 @@ class BinarySpaceTree
       const size_t maxLeafSize,
       SplitType<BoundType<DistanceType, ElemType>, MatType>& splitter);
 
+  /**
+   * Build the children of the current node, after its points were partitioned
+   * around splitCol.  If the split type allows it (see SplitTraits) and the
+   * node holds at least ParallelBuildMinPoints points, the two children are
+   * built as parallel OpenMP tasks.
+   *
+   * @param splitCol First point of the right child.
+   * @param oldFromNew Vector holding permuted indices, or NULL.
+   * @param maxLeafSize Maximum number of points held in a leaf.
+   * @param splitter Instantiated SplitType object.
+   */
+  void BuildChildren(
+      const size_t splitCol,
+      std::vector<size_t>* oldFromNew,
+      const size_t maxLeafSize,
+      SplitType<BoundType<DistanceType, ElemType>, MatType>& splitter);
+
+  //! Build the child of the current node that holds the given points.
+  BinarySpaceTree* BuildChild(
+      const size_t childBegin,
+      const size_t childCount,
+      std::vector<size_t>* oldFromNew,
+      const size_t maxLeafSize,
+      SplitType<BoundType<DistanceType, ElemType>, MatType>& splitter);
+
+  /**
+   * Delete the children of this node.  If this is a root whose nodes were
+   * packed, the nodes of the array are destroyed and the array is freed.
+   */
+  void DeleteChildren();
+
+  //! Append the nodes of the subtree of node, down to the given number of
+  //! levels, to order, in van Emde Boas order.
+  static void VanEmdeBoasOrder(BinarySpaceTree* node,
+                               const size_t levels,
+                               std::vector<BinarySpaceTree*>& order);
+
   /**
    * Update the bound of the current node. This method does not take into
    * account bound-specific properties.
@@ -568,6 +646,32 @@ class BinarySpaceTree
    */
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
+
+  /**
+   * Save the tree, including the (permuted) dataset, to the given stream in a
+   * flat binary format.  This can only be called on the root of the tree.  The
+   * nodes are stored in depth-first order as one contiguous array of
+   * fixed-size records whose child links are offsets into that array; the
+   * dataset is stored as one contiguous block of column-major elements; and
+   * the bounds of all nodes follow in node order.  Unlike serialize(), this
+   * does not recurse and does not need to track pointers, so loading a large
+   * tree is much faster.  Node statistics are not saved; they are
+   * reinitialized when the tree is loaded.
+   *
+   * @param stream Binary stream to save the tree to.
+   */
+  void SaveFlat(std::ostream& stream) const;
+
+  /**
+   * Load a tree that was saved with SaveFlat().  The node array and the
+   * dataset are each read with a single block read (the dataset is read
+   * directly into the memory of the new tree's matrix).  The returned tree is
+   * owned by the caller.  If the stream does not hold a flat tree of this
+   * type, a std::runtime_error is thrown.
+   *
+   * @param stream Binary stream to load the tree from.
+   */
+  static BinarySpaceTree* LoadFlat(std::istream& stream);
 };
 
 } // namespace mlpack
@@ -13,9 +13,16 @@
 
 // In case it wasn't included already for some reason.
 #include "binary_space_tree.hpp"
+#include "split_traits.hpp"
 
 #include <mlpack/core/util/log.hpp>
 #include <queue>
+#include <stack>
+#include <unordered_map>
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
 
 namespace mlpack {
 
@@ -38,7 +45,9 @@ BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
     stat(*this),
     parentDistance(0),
     furthestDescendantDistance(0),
-    dataset(NULL)
+    dataset(NULL),
+    nodePool(NULL),
+    nodePoolSize(0)
 {
   // Nothing to do.
 }
@@ -64,7 +73,9 @@ BinarySpaceTree(
     count(data.n_cols), /* and spans all of the dataset. */
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    nodePool(NULL),
+    nodePoolSize(0)
 {
   // Do the actual splitting of this node.
   SplitType<BoundType<DistanceType, ElemType>, MatType> splitter;
@@ -94,7 +105,9 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    nodePool(NULL),
+    nodePoolSize(0)
 {
   // Initialize oldFromNew correctly.
   oldFromNew.resize(data.n_cols);
@@ -130,7 +143,9 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    nodePool(NULL),
+    nodePoolSize(0)
 {
   // Initialize the oldFromNew vector correctly.
   oldFromNew.resize(data.n_cols);
@@ -167,7 +182,9 @@ BinarySpaceTree(MatType&& data, const size_t maxLeafSize) :
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    nodePool(NULL),
+    nodePoolSize(0)
 {
   // Do the actual splitting of this node.
   SplitType<BoundType<DistanceType, ElemType>, MatType> splitter;
@@ -197,7 +214,9 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    nodePool(NULL),
+    nodePoolSize(0)
 {
   // Initialize oldFromNew correctly.
   oldFromNew.resize(dataset->n_cols);
@@ -233,7 +252,9 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    nodePool(NULL),
+    nodePoolSize(0)
 {
   // Initialize the oldFromNew vector correctly.
   oldFromNew.resize(dataset->n_cols);
@@ -274,7 +295,9 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset().n_rows),
-    dataset(&parent->Dataset()) // Point to the parent's dataset.
+    dataset(&parent->Dataset()), // Point to the parent's dataset.
+    nodePool(NULL),
+    nodePoolSize(0)
 {
   // Perform the actual splitting.
   SplitNode(maxLeafSize, splitter);
@@ -305,7 +328,9 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset().n_rows),
-    dataset(&parent->Dataset())
+    dataset(&parent->Dataset()),
+    nodePool(NULL),
+    nodePoolSize(0)
 {
   // Hopefully the vector is initialized correctly!  We can't check that
   // entirely but we can do a minor sanity check.
@@ -341,7 +366,9 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset()->n_rows),
-    dataset(&parent->Dataset())
+    dataset(&parent->Dataset()),
+    nodePool(NULL),
+    nodePoolSize(0)
 {
   // Hopefully the vector is initialized correctly!  We can't check that
   // entirely but we can do a minor sanity check.
@@ -385,7 +412,9 @@ BinarySpaceTree(
     furthestDescendantDistance(other.furthestDescendantDistance),
     minimumBoundDistance(other.minimumBoundDistance),
     // Copy matrix, but only if we are the root.
-    dataset((other.parent == NULL) ? new MatType(*other.dataset) : NULL)
+    dataset((other.parent == NULL) ? new MatType(*other.dataset) : NULL),
+    nodePool(NULL),
+    nodePoolSize(0)
 {
   // Create left and right children (if any).
   if (other.Left())
@@ -443,8 +472,7 @@ operator=(const BinarySpaceTree& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  delete left;
-  delete right;
+  DeleteChildren();
 
   left = NULL;
   right = NULL;
@@ -517,8 +545,7 @@ operator=(BinarySpaceTree&& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  delete left;
-  delete right;
+  DeleteChildren();
 
   parent = other.Parent();
   left = other.Left();
@@ -531,6 +558,8 @@ operator=(BinarySpaceTree&& other)
   furthestDescendantDistance = other.FurthestDescendantDistance();
   minimumBoundDistance = other.MinimumBoundDistance();
   dataset = other.dataset;
+  nodePool = other.nodePool;
+  nodePoolSize = other.nodePoolSize;
 
   other.left = NULL;
   other.right = NULL;
@@ -541,6 +570,14 @@ operator=(BinarySpaceTree&& other)
   other.furthestDescendantDistance = 0.0;
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
+  other.nodePool = NULL;
+  other.nodePoolSize = 0;
+
+  // Set new parent.
+  if (left)
+    left->parent = this;
+  if (right)
+    right->parent = this;
 
   return *this;
 }
@@ -569,7 +606,9 @@ BinarySpaceTree(BinarySpaceTree&& other) :
     parentDistance(other.parentDistance),
     furthestDescendantDistance(other.furthestDescendantDistance),
     minimumBoundDistance(other.minimumBoundDistance),
-    dataset(other.dataset)
+    dataset(other.dataset),
+    nodePool(other.nodePool),
+    nodePoolSize(other.nodePoolSize)
 {
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
@@ -582,6 +621,8 @@ BinarySpaceTree(BinarySpaceTree&& other) :
   other.furthestDescendantDistance = 0.0;
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
+  other.nodePool = NULL;
+  other.nodePoolSize = 0;
 
   // Set new parent.
   if (left)
@@ -629,14 +670,192 @@ template<typename DistanceType,
 BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
     ~BinarySpaceTree()
 {
-  delete left;
-  delete right;
+  DeleteChildren();
 
   // If we're the root, delete the matrix.
   if (!parent)
     delete dataset;
 }
 
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+void BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+    DeleteChildren()
+{
+  if (nodePool)
+  {
+    // The nodes of the array are destroyed in place; their children are in
+    // the array too, so they must not delete them.
+    for (size_t i = 0; i < nodePoolSize; ++i)
+    {
+      nodePool[i].left = NULL;
+      nodePool[i].right = NULL;
+      nodePool[i].~BinarySpaceTree();
+    }
+
+    std::allocator<BinarySpaceTree>().deallocate(nodePool, nodePoolSize);
+    nodePool = NULL;
+    nodePoolSize = 0;
+  }
+  else
+  {
+    delete left;
+    delete right;
+  }
+
+  left = NULL;
+  right = NULL;
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+void BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+    PackNodes(const NodeLayout layout)
+{
+  if (parent != NULL)
+  {
+    throw std::invalid_argument("BinarySpaceTree::PackNodes(): can only be "
+        "called on the root of the tree!");
+  }
+
+  // List the nodes in their new order; the root is always first.
+  std::vector<BinarySpaceTree*> order;
+  if (layout == DEPTH_FIRST_LAYOUT)
+  {
+    std::stack<BinarySpaceTree*> stack;
+    stack.push(this);
+    while (!stack.empty())
+    {
+      BinarySpaceTree* node = stack.top();
+      stack.pop();
+      order.push_back(node);
+
+      if (node->right)
+        stack.push(node->right);
+      if (node->left)
+        stack.push(node->left);
+    }
+  }
+  else
+  {
+    // Find the number of levels of the tree.
+    size_t levels = 0;
+    std::stack<std::pair<BinarySpaceTree*, size_t>> stack;
+    stack.push(std::make_pair(this, 1));
+    while (!stack.empty())
+    {
+      BinarySpaceTree* node = stack.top().first;
+      const size_t level = stack.top().second;
+      stack.pop();
+      levels = std::max(levels, level);
+
+      if (node->left)
+        stack.push(std::make_pair(node->left, level + 1));
+      if (node->right)
+        stack.push(std::make_pair(node->right, level + 1));
+    }
+
+    VanEmdeBoasOrder(this, levels, order);
+  }
+
+  const size_t numNodes = order.size() - 1;
+  if (numNodes == 0)
+    return;
+
+  // In both layouts, parents come before their children.  So, when a node is
+  // moved to the array, its parent was already moved, and the move
+  // constructor points the parent pointers of its (not yet moved) children to
+  // the new node.
+  BinarySpaceTree* pool = std::allocator<BinarySpaceTree>().allocate(numNodes);
+  std::unordered_map<const BinarySpaceTree*, BinarySpaceTree*> newNodes;
+  newNodes.reserve(numNodes);
+  for (size_t i = 1; i < order.size(); ++i)
+  {
+    newNodes[order[i]] =
+        new (pool + i - 1) BinarySpaceTree(std::move(*order[i]));
+  }
+
+  // Now point the nodes to the new locations of their children.
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    BinarySpaceTree* node = (i == 0) ? this : pool + i - 1;
+    if (node->left)
+      node->left = newNodes[node->left];
+    if (node->right)
+      node->right = newNodes[node->right];
+  }
+
+  // The old nodes are empty now, and can be freed.
+  if (nodePool)
+  {
+    for (size_t i = 0; i < nodePoolSize; ++i)
+      nodePool[i].~BinarySpaceTree();
+    std::allocator<BinarySpaceTree>().deallocate(nodePool, nodePoolSize);
+  }
+  else
+  {
+    for (size_t i = 1; i < order.size(); ++i)
+      delete order[i];
+  }
+
+  nodePool = pool;
+  nodePoolSize = numNodes;
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+void BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+    VanEmdeBoasOrder(BinarySpaceTree* node,
+                     const size_t levels,
+                     std::vector<BinarySpaceTree*>& order)
+{
+  if (levels == 1)
+  {
+    order.push_back(node);
+    return;
+  }
+
+  // Store the top half of the levels first, and then each subtree below it,
+  // from left to right.
+  const size_t topLevels = levels / 2;
+  VanEmdeBoasOrder(node, topLevels, order);
+
+  std::vector<BinarySpaceTree*> bottomRoots(1, node);
+  for (size_t l = 0; l < topLevels; ++l)
+  {
+    std::vector<BinarySpaceTree*> nextRoots;
+    for (BinarySpaceTree* n : bottomRoots)
+    {
+      if (n->left)
+        nextRoots.push_back(n->left);
+      if (n->right)
+        nextRoots.push_back(n->right);
+    }
+    bottomRoots.swap(nextRoots);
+  }
+
+  for (BinarySpaceTree* n : bottomRoots)
+    VanEmdeBoasOrder(n, levels - topLevels, order);
+}
+
 template<typename DistanceType,
          typename StatisticType,
          typename MatType,
@@ -988,10 +1207,7 @@ BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
-      maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      splitter, maxLeafSize);
+  BuildChildren(splitCol, NULL, maxLeafSize, splitter);
 
   // Calculate parent distances for those two nodes.
   arma::Col<ElemType> center, leftCenter, rightCenter;
@@ -1059,10 +1275,7 @@ SplitNode(std::vector<size_t>& oldFromNew,
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
-      splitter, maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      oldFromNew, splitter, maxLeafSize);
+  BuildChildren(splitCol, &oldFromNew, maxLeafSize, splitter);
 
   // Calculate parent distances for those two nodes.
   arma::Col<ElemType> center, leftCenter, rightCenter;
@@ -1079,6 +1292,87 @@ SplitNode(std::vector<size_t>& oldFromNew,
   right->ParentDistance() = rightParentDistance;
 }
 
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+void
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+BuildChildren(const size_t splitCol,
+              std::vector<size_t>* oldFromNew,
+              const size_t maxLeafSize,
+              SplitType<BoundType<DistanceType, ElemType>, MatType>& splitter)
+{
+  const bool parallel = SplitTraits<Split>::ParallelBuild &&
+      (count >= ParallelBuildMinPoints);
+
+  #ifdef MLPACK_USE_OPENMP
+  if (parallel && !omp_in_parallel())
+  {
+    // Start the threads that the tasks of the whole subtree will run on.
+    #pragma omp parallel
+    {
+      #pragma omp single
+      BuildChildren(splitCol, oldFromNew, maxLeafSize, splitter);
+    }
+    return;
+  }
+  #endif
+
+  if (parallel)
+  {
+    // Each child only modifies its own columns of the dataset (and its own
+    // elements of oldFromNew), so both can be built at the same time.  The
+    // split does not depend on the order in which nodes are built, so the tree
+    // is the same as the one built serially.
+    #pragma omp task shared(splitter)
+    left = BuildChild(begin, splitCol - begin, oldFromNew, maxLeafSize,
+        splitter);
+
+    right = BuildChild(splitCol, begin + count - splitCol, oldFromNew,
+        maxLeafSize, splitter);
+
+    #pragma omp taskwait
+  }
+  else
+  {
+    left = BuildChild(begin, splitCol - begin, oldFromNew, maxLeafSize,
+        splitter);
+    right = BuildChild(splitCol, begin + count - splitCol, oldFromNew,
+        maxLeafSize, splitter);
+  }
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>*
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+BuildChild(const size_t childBegin,
+           const size_t childCount,
+           std::vector<size_t>* oldFromNew,
+           const size_t maxLeafSize,
+           SplitType<BoundType<DistanceType, ElemType>, MatType>& splitter)
+{
+  if (oldFromNew == NULL)
+  {
+    return new BinarySpaceTree(this, childBegin, childCount, splitter,
+        maxLeafSize);
+  }
+
+  return new BinarySpaceTree(this, childBegin, childCount, *oldFromNew,
+      splitter, maxLeafSize);
+}
+
 template<typename DistanceType,
          typename StatisticType,
          typename MatType,
@@ -1144,10 +1438,7 @@ BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
   // If we're loading, and we have children, they need to be deleted.
   if (cereal::is_loading<Archive>())
   {
-    if (left)
-      delete left;
-    if (right)
-      delete right;
+    DeleteChildren();
     if (!parent)
       delete dataset;
 
@@ -1210,6 +1501,183 @@ BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
   }
 }
 
+/**
+ * A single node record in the flat tree format; see SaveFlat().  Child links
+ * are indices into the node array, and SIZE_MAX denotes no child.
+ */
+struct FlatTreeNode
+{
+  uint64_t begin;
+  uint64_t count;
+  uint64_t left;
+  uint64_t right;
+  double parentDistance;
+  double furthestDescendantDistance;
+  double minimumBoundDistance;
+};
+
+//! Header of the flat tree format; see SaveFlat().
+struct FlatTreeHeader
+{
+  char magic[8];
+  uint64_t version;
+  uint64_t elemSize;
+  uint64_t nRows;
+  uint64_t nCols;
+  uint64_t numNodes;
+};
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+void BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType,
+    SplitType>::SaveFlat(std::ostream& stream) const
+{
+  if (parent != NULL)
+  {
+    throw std::invalid_argument("BinarySpaceTree::SaveFlat(): can only be "
+        "called on the root of the tree!");
+  }
+
+  // Collect all nodes in depth-first order, so that the index of each node in
+  // the array is known before its record is written.
+  std::vector<const BinarySpaceTree*> nodes;
+  std::stack<const BinarySpaceTree*> stack;
+  stack.push(this);
+  while (!stack.empty())
+  {
+    const BinarySpaceTree* node = stack.top();
+    stack.pop();
+    nodes.push_back(node);
+
+    if (node->right)
+      stack.push(node->right);
+    if (node->left)
+      stack.push(node->left);
+  }
+
+  std::unordered_map<const BinarySpaceTree*, uint64_t> indices;
+  for (size_t i = 0; i < nodes.size(); ++i)
+    indices[nodes[i]] = i;
+
+  std::vector<FlatTreeNode> records(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    const BinarySpaceTree* node = nodes[i];
+    records[i].begin = node->begin;
+    records[i].count = node->count;
+    records[i].left = node->left ? indices[node->left] : SIZE_MAX;
+    records[i].right = node->right ? indices[node->right] : SIZE_MAX;
+    records[i].parentDistance = node->parentDistance;
+    records[i].furthestDescendantDistance = node->furthestDescendantDistance;
+    records[i].minimumBoundDistance = node->minimumBoundDistance;
+  }
+
+  FlatTreeHeader header;
+  std::memcpy(header.magic, "MLPKFLAT", 8);
+  header.version = 1;
+  header.elemSize = sizeof(ElemType);
+  header.nRows = dataset->n_rows;
+  header.nCols = dataset->n_cols;
+  header.numNodes = nodes.size();
+
+  stream.write((const char*) &header, sizeof(FlatTreeHeader));
+  stream.write((const char*) records.data(),
+      records.size() * sizeof(FlatTreeNode));
+  stream.write((const char*) dataset->memptr(),
+      dataset->n_elem * sizeof(ElemType));
+
+  // The bounds have variable size, so they are stored last.
+  cereal::BinaryOutputArchive ar(stream);
+  for (size_t i = 0; i < nodes.size(); ++i)
+    ar(nodes[i]->bound);
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>*
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+LoadFlat(std::istream& stream)
+{
+  FlatTreeHeader header;
+  stream.read((char*) &header, sizeof(FlatTreeHeader));
+  if (!stream || std::memcmp(header.magic, "MLPKFLAT", 8) != 0 ||
+      header.version != 1)
+  {
+    throw std::runtime_error("BinarySpaceTree::LoadFlat(): stream does not "
+        "contain a flat tree!");
+  }
+  if (header.elemSize != sizeof(ElemType) || header.numNodes == 0)
+  {
+    throw std::runtime_error("BinarySpaceTree::LoadFlat(): stream contains a "
+        "flat tree of a different type!");
+  }
+
+  std::vector<FlatTreeNode> records(header.numNodes);
+  stream.read((char*) records.data(), records.size() * sizeof(FlatTreeNode));
+
+  MatType* data = new MatType(header.nRows, header.nCols);
+  stream.read((char*) data->memptr(), data->n_elem * sizeof(ElemType));
+  if (!stream)
+  {
+    delete data;
+    throw std::runtime_error("BinarySpaceTree::LoadFlat(): unexpected end of "
+        "stream!");
+  }
+
+  // Allocate all nodes, then link them.  Since nodes are stored in depth-first
+  // order, a node's parent always comes before it.
+  std::vector<BinarySpaceTree*> nodes(records.size());
+  for (size_t i = 0; i < records.size(); ++i)
+  {
+    BinarySpaceTree* node = new BinarySpaceTree();
+    node->begin = records[i].begin;
+    node->count = records[i].count;
+    node->parentDistance = records[i].parentDistance;
+    node->furthestDescendantDistance = records[i].furthestDescendantDistance;
+    node->minimumBoundDistance = records[i].minimumBoundDistance;
+    node->dataset = data;
+    nodes[i] = node;
+  }
+
+  for (size_t i = 0; i < records.size(); ++i)
+  {
+    if (records[i].left != SIZE_MAX)
+    {
+      nodes[i]->left = nodes[records[i].left];
+      nodes[i]->left->parent = nodes[i];
+    }
+    if (records[i].right != SIZE_MAX)
+    {
+      nodes[i]->right = nodes[records[i].right];
+      nodes[i]->right->parent = nodes[i];
+    }
+  }
+
+  cereal::BinaryInputArchive ar(stream);
+  for (size_t i = 0; i < nodes.size(); ++i)
+    ar(nodes[i]->bound);
+
+  // Children come after their parents, so initializing the statistics in
+  // reverse order initializes every child before its parent, just like when
+  // the tree is built.
+  for (size_t i = nodes.size(); i > 0; --i)
+    nodes[i - 1]->stat = StatisticType(*nodes[i - 1]);
+
+  return nodes[0];
+}
+
 } // namespace mlpack
 
 #endif
@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/perform_split.hpp>
+#include "split_traits.hpp"
 
 namespace mlpack {
 
@@ -116,6 +117,14 @@ class MeanSplit
   }
 };
 
+//! The MeanSplit of a node only depends on its points, so its children can be
+//! built in parallel.
+template<typename BoundType, typename MatType>
+struct SplitTraits<MeanSplit<BoundType, MatType>>
+{
+  static const bool ParallelBuild = true;
+};
+
 } // namespace mlpack
 
 // Include implementation.
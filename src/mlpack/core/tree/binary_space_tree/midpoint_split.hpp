@@ -17,6 +17,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/perform_split.hpp>
+#include "split_traits.hpp"
 
 namespace mlpack {
 
@@ -117,6 +118,14 @@ class MidpointSplit
   }
 };
 
+//! The MidpointSplit of a node only depends on its points, so its children can be
+//! built in parallel.
+template<typename BoundType, typename MatType>
+struct SplitTraits<MidpointSplit<BoundType, MatType>>
+{
+  static const bool ParallelBuild = true;
+};
+
 } // namespace mlpack
 
 // Include implementation.
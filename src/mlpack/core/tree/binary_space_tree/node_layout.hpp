@@ -0,0 +1,40 @@
+/**
+ * @file core/tree/binary_space_tree/node_layout.hpp
+ *
+ * Definition of the memory layouts that BinarySpaceTree::PackNodes() can put
+ * the nodes of a tree in.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_NODE_LAYOUT_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_NODE_LAYOUT_HPP
+
+namespace mlpack {
+
+/**
+ * The orders in which BinarySpaceTree::PackNodes() can store the nodes of a
+ * tree in one contiguous array.
+ */
+enum NodeLayout
+{
+  /**
+   * Depth-first (preorder) layout: each node is followed by its left subtree,
+   * and then by its right subtree.  The left child of a node is next to it in
+   * memory, which suits depth-first traversals.
+   */
+  DEPTH_FIRST_LAYOUT,
+  /**
+   * Van Emde Boas layout: the top half of the levels of the tree is stored
+   * first (recursively in the same layout), followed by each of the subtrees
+   * below it.  Any path from the root to a leaf touches few blocks of memory,
+   * whatever the cache line or page size (the layout is cache-oblivious).
+   */
+  VAN_EMDE_BOAS_LAYOUT
+};
+
+} // namespace mlpack
+
+#endif
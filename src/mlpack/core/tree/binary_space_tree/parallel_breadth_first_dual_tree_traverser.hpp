@@ -0,0 +1,144 @@
+/**
+ * @file core/tree/binary_space_tree/parallel_breadth_first_dual_tree_traverser.hpp
+ *
+ * Defines the ParallelBreadthFirstDualTreeTraverser for the BinarySpaceTree
+ * tree type.  This is a nested class of BinarySpaceTree which performs the same
+ * traversal as the BreadthFirstDualTreeTraverser, but traverses the subtrees of
+ * the two children of large query nodes in parallel with OpenMP tasks.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_BF_DUAL_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_BF_DUAL_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <queue>
+
+#include "../binary_space_tree.hpp"
+#include "breadth_first_dual_tree_traverser.hpp"
+
+namespace mlpack {
+
+/**
+ * The ParallelBreadthFirstDualTreeTraverser is a drop-in replacement for the
+ * BreadthFirstDualTreeTraverser of a BinarySpaceTree.  The breadth-first
+ * traversal scores all the combinations of a query node with reference nodes
+ * before it recurses into the two query children, and the two children are
+ * then traversed independently; so, when a query node holds at least
+ * MinTaskPoints() points, the left child is traversed in a new OpenMP task with
+ * its own copy of the rules, while the right child is traversed by the current
+ * task.  Every node combination is scored in the same order, relative to the
+ * other combinations of the same query node, as with the
+ * BreadthFirstDualTreeTraverser.
+ *
+ * Because each task needs its own traversal state, the RuleType must be
+ * copy-constructible, and a copy of a RuleType object must share its results
+ * with the object it was copied from.  Since the subtrees of two query children
+ * hold disjoint sets of points, two tasks never write the results of the same
+ * query point or the same query node statistic; the rules may read the
+ * statistics of the query parent, which are final when the children are
+ * traversed, but must not modify the reference tree.  The RuleType must also
+ * provide modifiable BaseCases() and Scores() accessors, so that the counts
+ * from each task can be accumulated into the given rule set.
+ *
+ * If mlpack is compiled without OpenMP, this performs the same traversal as
+ * the BreadthFirstDualTreeTraverser.
+ */
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+class BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType,
+                      SplitType>::ParallelBreadthFirstDualTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the parallel breadth-first dual-tree traverser with the given
+   * rule set.
+   *
+   * @param rule Rule set to use for the traversal.
+   * @param minTaskPoints Query nodes with at least this many points have the
+   *     subtrees of their children traversed in parallel.
+   */
+  ParallelBreadthFirstDualTreeTraverser(RuleType& rule,
+                                        const size_t minTaskPoints = 1000);
+
+  using QueueFrameType =
+      QueueFrame<BinarySpaceTree, typename RuleType::TraversalInfoType>;
+
+  /**
+   * Traverse the two trees.  This does not reset the number of prunes.
+   *
+   * @param queryNode The query node to be traversed.
+   * @param referenceNode The reference node to be traversed.
+   */
+  void Traverse(BinarySpaceTree& queryNode,
+                BinarySpaceTree& referenceNode);
+  void Traverse(BinarySpaceTree& queryNode,
+                std::priority_queue<QueueFrameType>& referenceQueue);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of prunes.
+  size_t& NumPrunes() { return numPrunes; }
+
+  //! Get the number of visited combinations.
+  size_t NumVisited() const { return numVisited; }
+  //! Modify the number of visited combinations.
+  size_t& NumVisited() { return numVisited; }
+
+  //! Get the number of times a node combination was scored.
+  size_t NumScores() const { return numScores; }
+  //! Modify the number of times a node combination was scored.
+  size_t& NumScores() { return numScores; }
+
+  //! Get the number of times a base case was calculated.
+  size_t NumBaseCases() const { return numBaseCases; }
+  //! Modify the number of times a base case was calculated.
+  size_t& NumBaseCases() { return numBaseCases; }
+
+  //! Get the minimum number of points of a query node traversed in parallel.
+  size_t MinTaskPoints() const { return minTaskPoints; }
+  //! Modify the minimum number of points of a query node traversed in
+  //! parallel.
+  size_t& MinTaskPoints() { return minTaskPoints; }
+
+ private:
+  //! Traverse the subtree of the given query node, with the queue of reference
+  //! nodes it must be scored with; this may start tasks.
+  void TraverseTasks(BinarySpaceTree& queryNode,
+                     std::priority_queue<QueueFrameType>& referenceQueue);
+
+  //! Reference to the rules with which the trees will be traversed.
+  RuleType& rule;
+
+  //! The minimum number of points of a query node traversed in parallel.
+  size_t minTaskPoints;
+
+  //! The number of prunes.
+  size_t numPrunes;
+
+  //! The number of node combinations that have been visited during traversal.
+  size_t numVisited;
+
+  //! The number of times a node combination was scored.
+  size_t numScores;
+
+  //! The number of times a base case was calculated.
+  size_t numBaseCases;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_breadth_first_dual_tree_traverser_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_BF_DUAL_TREE_TRAVERSER_HPP
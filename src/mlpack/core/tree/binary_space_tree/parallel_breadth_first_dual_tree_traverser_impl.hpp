@@ -0,0 +1,258 @@
+/**
+ * @file core/tree/binary_space_tree/parallel_breadth_first_dual_tree_traverser_impl.hpp
+ *
+ * Implementation of the ParallelBreadthFirstDualTreeTraverser for
+ * BinarySpaceTree.  The subtrees of the two children of large query nodes are
+ * traversed in parallel OpenMP tasks.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_BF_DUAL_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_BF_DUAL_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "parallel_breadth_first_dual_tree_traverser.hpp"
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+ParallelBreadthFirstDualTreeTraverser<RuleType>::
+ParallelBreadthFirstDualTreeTraverser(RuleType& rule,
+                                      const size_t minTaskPoints) :
+    rule(rule),
+    minTaskPoints(minTaskPoints),
+    numPrunes(0),
+    numVisited(0),
+    numScores(0),
+    numBaseCases(0)
+{ /* Nothing to do. */ }
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+void
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+ParallelBreadthFirstDualTreeTraverser<RuleType>::Traverse(
+    BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>&
+        queryRoot,
+    BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>&
+        referenceRoot)
+{
+  // Increment the visit counter.
+  ++numVisited;
+
+  // Must score the root combination.
+  const double rootScore = rule.Score(queryRoot, referenceRoot);
+  if (rootScore == DBL_MAX)
+    return; // This probably means something is wrong.
+
+  std::priority_queue<QueueFrameType> queue;
+
+  QueueFrameType rootFrame;
+  rootFrame.queryNode = &queryRoot;
+  rootFrame.referenceNode = &referenceRoot;
+  rootFrame.queryDepth = 0;
+  rootFrame.score = 0.0;
+  rootFrame.traversalInfo = rule.TraversalInfo();
+
+  queue.push(rootFrame);
+
+  // Start the traversal.
+  Traverse(queryRoot, queue);
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+void BinarySpaceTree<
+    DistanceType, StatisticType, MatType, BoundType, SplitType
+>::ParallelBreadthFirstDualTreeTraverser<RuleType>::Traverse(
+    BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>&
+        queryNode,
+    std::priority_queue<QueueFrameType>& referenceQueue)
+{
+  #ifdef MLPACK_USE_OPENMP
+  if (queryNode.Count() >= minTaskPoints && !omp_in_parallel())
+  {
+    // Start the threads that the tasks of the whole traversal will run on.
+    #pragma omp parallel
+    {
+      #pragma omp single
+      TraverseTasks(queryNode, referenceQueue);
+    }
+    return;
+  }
+  #endif
+
+  TraverseTasks(queryNode, referenceQueue);
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+void BinarySpaceTree<
+    DistanceType, StatisticType, MatType, BoundType, SplitType
+>::ParallelBreadthFirstDualTreeTraverser<RuleType>::TraverseTasks(
+    BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>&
+        queryNode,
+    std::priority_queue<QueueFrameType>& referenceQueue)
+{
+  // Store queues for the children.  We will recurse into the children once our
+  // queue is empty.
+  std::priority_queue<QueueFrameType> leftChildQueue;
+  std::priority_queue<QueueFrameType> rightChildQueue;
+
+  while (!referenceQueue.empty())
+  {
+    QueueFrameType currentFrame = referenceQueue.top();
+    referenceQueue.pop();
+
+    BinarySpaceTree& queryNode = *currentFrame.queryNode;
+    BinarySpaceTree& referenceNode = *currentFrame.referenceNode;
+    typename RuleType::TraversalInfoType ti = currentFrame.traversalInfo;
+    rule.TraversalInfo() = ti;
+    const size_t queryDepth = currentFrame.queryDepth;
+
+    double score = rule.Score(queryNode, referenceNode);
+    ++numScores;
+
+    if (score == DBL_MAX)
+    {
+      ++numPrunes;
+      continue;
+    }
+
+    // If both are leaves, we must evaluate the base case.
+    if (queryNode.IsLeaf() && referenceNode.IsLeaf())
+    {
+      // Loop through each of the points in each node.
+      const size_t queryEnd = queryNode.Begin() + queryNode.Count();
+      const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
+      for (size_t query = queryNode.Begin(); query < queryEnd; ++query)
+      {
+        for (size_t ref = referenceNode.Begin(); ref < refEnd; ++ref)
+          rule.BaseCase(query, ref);
+
+        numBaseCases += referenceNode.Count();
+      }
+    }
+    else if ((!queryNode.IsLeaf()) && referenceNode.IsLeaf())
+    {
+      // We have to recurse down the query node.
+      QueueFrameType fl = { queryNode.Left(), &referenceNode, queryDepth + 1,
+          score, rule.TraversalInfo() };
+      leftChildQueue.push(fl);
+
+      QueueFrameType fr = { queryNode.Right(), &referenceNode, queryDepth + 1,
+          score, ti };
+      rightChildQueue.push(fr);
+    }
+    else if (queryNode.IsLeaf() && (!referenceNode.IsLeaf()))
+    {
+      // We have to recurse down the reference node.  In this case the recursion
+      // order does matter.  Before recursing, though, we have to set the
+      // traversal information correctly.
+      QueueFrameType fl = { &queryNode, referenceNode.Left(), queryDepth,
+          score, rule.TraversalInfo() };
+      referenceQueue.push(fl);
+
+      QueueFrameType fr = { &queryNode, referenceNode.Right(), queryDepth,
+          score, ti };
+      referenceQueue.push(fr);
+    }
+    else
+    {
+      // We have to recurse down both query and reference nodes.  Because the
+      // query descent order does not matter, we will go to the left query child
+      // first.  Before recursing, we have to set the traversal information
+      // correctly.
+      QueueFrameType fll = { queryNode.Left(), referenceNode.Left(),
+          queryDepth + 1, score, rule.TraversalInfo() };
+      leftChildQueue.push(fll);
+
+      QueueFrameType flr = { queryNode.Left(), referenceNode.Right(),
+          queryDepth + 1, score, rule.TraversalInfo() };
+      leftChildQueue.push(flr);
+
+      QueueFrameType frl = { queryNode.Right(), referenceNode.Left(),
+          queryDepth + 1, score, rule.TraversalInfo() };
+      rightChildQueue.push(frl);
+
+      QueueFrameType frr = { queryNode.Right(), referenceNode.Right(),
+          queryDepth + 1, score, rule.TraversalInfo() };
+      rightChildQueue.push(frr);
+    }
+  }
+
+  // Now, recurse into the left and right children queues.  The order doesn't
+  // matter, so if the query node is large enough, the left child is traversed
+  // in a new task, with its own copy of the rules.
+  if (queryNode.Count() >= minTaskPoints && leftChildQueue.size() > 0 &&
+      rightChildQueue.size() > 0)
+  {
+    RuleType leftRule(rule);
+    leftRule.BaseCases() = 0;
+    leftRule.Scores() = 0;
+    ParallelBreadthFirstDualTreeTraverser leftTraverser(leftRule,
+        minTaskPoints);
+
+    #pragma omp task shared(leftTraverser, leftChildQueue)
+    leftTraverser.TraverseTasks(*queryNode.Left(), leftChildQueue);
+
+    TraverseTasks(*queryNode.Right(), rightChildQueue);
+
+    #pragma omp taskwait
+
+    numPrunes += leftTraverser.NumPrunes();
+    numVisited += leftTraverser.NumVisited();
+    numScores += leftTraverser.NumScores();
+    numBaseCases += leftTraverser.NumBaseCases();
+    rule.BaseCases() += leftRule.BaseCases();
+    rule.Scores() += leftRule.Scores();
+  }
+  else
+  {
+    if (leftChildQueue.size() > 0)
+      TraverseTasks(*queryNode.Left(), leftChildQueue);
+    if (rightChildQueue.size() > 0)
+      TraverseTasks(*queryNode.Right(), rightChildQueue);
+  }
+}
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_BF_DUAL_TREE_TRAVERSER_IMPL_HPP
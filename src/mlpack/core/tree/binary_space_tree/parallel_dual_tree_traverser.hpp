@@ -0,0 +1,124 @@
+/**
+ * @file core/tree/binary_space_tree/parallel_dual_tree_traverser.hpp
+ *
+ * Defines the ParallelDualTreeTraverser for the BinarySpaceTree tree type.
+ * This is a nested class of BinarySpaceTree which splits the query tree into
+ * a set of independent subtrees and traverses each of them against the
+ * reference tree in parallel with OpenMP, using the regular depth-first
+ * DualTreeTraverser for each subtree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "binary_space_tree.hpp"
+
+namespace mlpack {
+
+/**
+ * The ParallelDualTreeTraverser is a drop-in replacement for the
+ * DualTreeTraverser of a BinarySpaceTree.  The top of the query tree is
+ * expanded (serially) until there are enough independent query subtrees to
+ * keep all OpenMP threads busy; then, each of those subtrees is traversed
+ * against the reference node by its own DualTreeTraverser.
+ *
+ * Because each thread needs its own traversal state, the RuleType must be
+ * copy-constructible, and a copy of a RuleType object must share its results
+ * (e.g. candidate neighbor lists) with the object it was copied from.  Since
+ * the query subtrees hold disjoint sets of points, no two threads will ever
+ * write to the same results or to the same query node statistic.  The
+ * RuleType must also provide modifiable BaseCases() and Scores() accessors, so
+ * that the counts from each thread can be accumulated into the given rule set.
+ *
+ * If mlpack is compiled without OpenMP, this performs the same traversal as
+ * the DualTreeTraverser.
+ */
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+class BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType,
+                      SplitType>::ParallelDualTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the parallel dual-tree traverser with the given rule set.
+   *
+   * @param rule Rule set to use for the traversal.
+   * @param minTasks Minimum number of query subtrees to create before starting
+   *     the parallel traversal.  If 0, four times the number of OpenMP threads
+   *     will be used.
+   */
+  ParallelDualTreeTraverser(RuleType& rule, const size_t minTasks = 0);
+
+  /**
+   * Traverse the two trees.  This does not reset the number of prunes.
+   *
+   * @param queryNode The query node to be traversed.
+   * @param referenceNode The reference node to be traversed.
+   */
+  void Traverse(BinarySpaceTree& queryNode,
+                BinarySpaceTree& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of prunes.
+  size_t& NumPrunes() { return numPrunes; }
+
+  //! Get the number of visited combinations.
+  size_t NumVisited() const { return numVisited; }
+  //! Modify the number of visited combinations.
+  size_t& NumVisited() { return numVisited; }
+
+  //! Get the number of times a node combination was scored.
+  size_t NumScores() const { return numScores; }
+  //! Modify the number of times a node combination was scored.
+  size_t& NumScores() { return numScores; }
+
+  //! Get the number of times a base case was calculated.
+  size_t NumBaseCases() const { return numBaseCases; }
+  //! Modify the number of times a base case was calculated.
+  size_t& NumBaseCases() { return numBaseCases; }
+
+  //! Get the minimum number of query subtrees (0 means automatic).
+  size_t MinTasks() const { return minTasks; }
+  //! Modify the minimum number of query subtrees (0 means automatic).
+  size_t& MinTasks() { return minTasks; }
+
+ private:
+  //! Reference to the rules with which the trees will be traversed.
+  RuleType& rule;
+
+  //! The minimum number of query subtrees to create.
+  size_t minTasks;
+
+  //! The number of prunes.
+  size_t numPrunes;
+
+  //! The number of node combinations that have been visited during traversal.
+  size_t numVisited;
+
+  //! The number of times a node combination was scored.
+  size_t numScores;
+
+  //! The number of times a base case was calculated.
+  size_t numBaseCases;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_dual_tree_traverser_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
@@ -0,0 +1,37 @@
+/**
+ * @file core/tree/binary_space_tree/split_traits.hpp
+ *
+ * The SplitTraits class, which gives compile-time information about the split
+ * types of the BinarySpaceTree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_SPLIT_TRAITS_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_SPLIT_TRAITS_HPP
+
+namespace mlpack {
+
+/**
+ * A class to obtain compile-time traits about SplitType classes of the
+ * BinarySpaceTree.  If you are writing your own SplitType class, you should
+ * make a template specialization in order to set the values correctly.
+ *
+ * @see TreeTraits, BoundTraits
+ */
+template<typename SplitType>
+struct SplitTraits
+{
+  //! If true, then the split of a node only depends on the points of the node
+  //! (and not on random numbers or on the state of the splitter), and
+  //! different nodes can be split at the same time by the same splitter.  If
+  //! so, the children of large nodes are built in parallel, and the tree is
+  //! identical to the one built serially.  This defaults to false.
+  static const bool ParallelBuild = false;
+};
+
+} // namespace mlpack
+
+#endif
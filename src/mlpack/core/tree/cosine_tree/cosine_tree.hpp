@@ -34,6 +34,16 @@ class CosineTree
  public:
   using VecType = typename GetDenseColType<MatType>::type;
 
+  //! The computations of a node over its columns (cosines, centroid) and over
+  //! the current basis (Gram-Schmidt projections, Monte Carlo error estimates)
+  //! are done in parallel when they involve at least this many elements of
+  //! the dataset.  The results do not depend on the number of threads.
+  static const size_t ParallelMinElements = 65536;
+
+  //! The centroid of a node is the ordered sum of the partial sums of blocks
+  //! of this many columns, so that the blocks can be summed in parallel.
+  static const size_t CentroidBlockSize = 1024;
+
   /**
    * CosineTree constructor for the root node of the tree. It initializes the
    * necessary variables required for splitting of the node, and building the
@@ -280,6 +290,31 @@ class CosineTree
   double frobNormSquared;
   //! If true, we own the dataset and need to destroy it in the destructor.
   bool localDataset;
+
+  /**
+   * Create a child node of the given node, like the public constructor, but
+   * use the given random value in [0, 1] to sample the splitting point.  This
+   * allows the random values of the children to be drawn before they are
+   * built in parallel.
+   *
+   * @param parentNode Parent cosine node.
+   * @param subIndices Indices of the columns of the parent to include.
+   * @param randValue Random value used to sample the splitting point.
+   */
+  CosineTree(CosineTree& parentNode,
+             const std::vector<size_t>& subIndices,
+             const double randValue);
+
+  //! Sample a point from the Length-Squared distribution of the node with the
+  //! given random value in [0, 1] (see ColumnSampleLS()).
+  size_t ColumnSampleLS(const double randValue);
+
+  //! Get the random value that ColumnSampleLS() needs for a node with the
+  //! given number of columns (none is drawn for less than two columns).
+  static double SampleValue(const size_t columns)
+  {
+    return (columns < 2) ? 0.0 : arma::randu();
+  }
 };
 
 class CompareCosineNode
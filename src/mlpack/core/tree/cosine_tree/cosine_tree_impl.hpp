@@ -30,6 +30,8 @@ inline CosineTree<MatType>::CosineTree(const MatType& dataset) :
   l2NormsSquared.zeros(numColumns);
 
   // Set indices and calculate squared norms of the columns.
+  #pragma omp parallel for schedule(static) \
+      if (numColumns * dataset.n_rows >= ParallelMinElements)
   for (size_t i = 0; i < numColumns; ++i)
   {
     indices[i] = i;
@@ -49,6 +51,15 @@ inline CosineTree<MatType>::CosineTree(const MatType& dataset) :
 template<typename MatType>
 inline CosineTree<MatType>::CosineTree(CosineTree& parentNode,
                                        const std::vector<size_t>& subIndices) :
+    CosineTree(parentNode, subIndices, SampleValue(subIndices.size()))
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+inline CosineTree<MatType>::CosineTree(CosineTree& parentNode,
+                                       const std::vector<size_t>& subIndices,
+                                       const double randValue) :
     dataset(&parentNode.GetDataset()),
     parent(&parentNode),
     left(NULL),
@@ -73,7 +84,7 @@ inline CosineTree<MatType>::CosineTree(CosineTree& parentNode,
   // Calculate centroid of columns in the node.
   CalculateCentroid();
 
-  splitPointIndex = ColumnSampleLS();
+  splitPointIndex = ColumnSampleLS(randValue);
 }
 
 template<typename MatType>
@@ -390,18 +401,32 @@ inline void CosineTree<MatType>::ModifiedGramSchmidt(
   // Set new basis vector to centroid.
   newBasisVector = centroid;
 
-  // Variables for iterating throught the priority queue.
-  CosineTree *currentNode;
-  typename CosineNodeQueue<MatType>::const_iterator i = treeQueue.cbegin();
+  // The projections of the centroid on the vectors of the current basis are
+  // independent.
+  const size_t basisSize = treeQueue.size();
+  const bool parallel = (basisSize * centroid.n_elem >= ParallelMinElements);
+  arma::vec projections(basisSize);
+  #pragma omp parallel for schedule(static) if (parallel)
+  for (size_t i = 0; i < basisSize; ++i)
+    projections[i] = (double) dot(treeQueue[i]->BasisVector(), centroid);
 
   // For every vector in the current basis, remove its projection from the
-  // centroid.
-  for ( ; i != treeQueue.cend(); ++i)
+  // centroid.  Each thread handles a block of rows, and the projections are
+  // removed from each element in the same order as with a single thread.
+  const size_t rowBlockSize = 256;
+  const size_t rowBlocks = (centroid.n_elem + rowBlockSize - 1) /
+      rowBlockSize;
+  #pragma omp parallel for schedule(static) if (parallel)
+  for (size_t b = 0; b < rowBlocks; ++b)
   {
-    currentNode = *i;
-
-    double projection = (double) dot(currentNode->BasisVector(), centroid);
-    newBasisVector -= projection * currentNode->BasisVector();
+    const size_t begin = b * rowBlockSize;
+    const size_t end = std::min(begin + rowBlockSize,
+        (size_t) centroid.n_elem) - 1;
+    for (size_t i = 0; i < basisSize; ++i)
+    {
+      newBasisVector.subvec(begin, end) -= projections[i] *
+          treeQueue[i]->BasisVector().subvec(begin, end);
+    }
   }
 
   // If additional basis vector is passed, take it into account.
@@ -446,36 +471,31 @@ inline double CosineTree<MatType>::MonteCarloError(
   else
     projectionSize = treeQueue.size();
 
+  // Compute the projections of the sampled vectors onto the existing
+  // subspace; they are all independent.  Column i holds the projection of the
+  // i'th sampled vector.
+  arma::Mat<typename VecType::elem_type> projections(projectionSize,
+      numSamples);
+  const size_t numProjections = projectionSize * numSamples;
+  #pragma omp parallel for schedule(static) \
+      if (numProjections * dataset.n_rows >= ParallelMinElements)
+  for (size_t p = 0; p < numProjections; ++p)
+  {
+    const size_t i = p / projectionSize;
+    const size_t k = p % projectionSize;
+
+    // If two additional vectors are passed, take their projections last.
+    const VecType& basisVector = (k < treeQueue.size()) ?
+        treeQueue[k]->BasisVector() : ((k == treeQueue.size()) ?
+        *addBasisVector1 : *addBasisVector2);
+    projections(k, i) = dot(dataset.col(sampledIndices[i]), basisVector);
+  }
+
   // For each sample, calculate the weighted projection onto the current basis.
   for (size_t i = 0; i < numSamples; ++i)
   {
-    // Initialize projection as a vector of zeros.
-    VecType projection;
-    projection.zeros(projectionSize);
-
-    CosineTree *currentNode;
-    typename CosineNodeQueue<MatType>::const_iterator j = treeQueue.cbegin();
-
-    size_t k = 0;
-    // Compute the projection of the sampled vector onto the existing subspace.
-    for ( ; j != treeQueue.cend(); ++j, ++k)
-    {
-      currentNode = *j;
-
-      projection(k) = dot(dataset.col(sampledIndices[i]),
-                                currentNode->BasisVector());
-    }
-    // If two additional vectors are passed, take their projections.
-    if (addBasisVector1 && addBasisVector2)
-    {
-      projection(k++) = dot(dataset.col(sampledIndices[i]),
-                                  *addBasisVector1);
-      projection(k) = dot(dataset.col(sampledIndices[i]),
-                                *addBasisVector2);
-    }
-
     // Calculate the Frobenius norm squared of the projected vector.
-    double frobProjection = arma::norm(projection, "frob");
+    double frobProjection = arma::norm(projections.col(i), "frob");
     double frobProjectionSquared = frobProjection * frobProjection;
 
     // Calculate the weighted projection magnitude.
@@ -555,9 +575,23 @@ inline void CosineTree<MatType>::CosineNodeSplit()
       rightIndices.push_back(i);
   }
 
-  // Split the node into left and right children.
-  left = new CosineTree(*this, leftIndices);
-  right = new CosineTree(*this, rightIndices);
+  // Split the node into left and right children.  The random values used to
+  // sample their splitting points are drawn first, so that the children can be
+  // built at the same time when neither of them is large enough to compute its
+  // centroid in parallel.
+  const double leftValue = SampleValue(leftIndices.size());
+  const double rightValue = SampleValue(rightIndices.size());
+  const bool parallelChildren =
+      (numColumns * dataset->n_rows >= ParallelMinElements) &&
+      (std::max(leftIndices.size(), rightIndices.size()) * dataset->n_rows <
+      ParallelMinElements);
+  #pragma omp parallel sections if (parallelChildren)
+  {
+    #pragma omp section
+    left = new CosineTree(*this, leftIndices, leftValue);
+    #pragma omp section
+    right = new CosineTree(*this, rightIndices, rightValue);
+  }
 }
 
 template<typename MatType>
@@ -596,6 +630,12 @@ inline void CosineTree<MatType>::ColumnSamplesLS(
 
 template<typename MatType>
 inline size_t CosineTree<MatType>::ColumnSampleLS()
+{
+  return ColumnSampleLS(SampleValue(numColumns));
+}
+
+template<typename MatType>
+inline size_t CosineTree<MatType>::ColumnSampleLS(const double randValue)
 {
   // If only one element is present, there can only be one sample.
   if (numColumns < 2)
@@ -614,11 +654,8 @@ inline size_t CosineTree<MatType>::ColumnSampleLS()
         (l2NormsSquared(i) / frobNormSquared);
   }
 
-  // Generate a random value for sampling.
-  double randValue = arma::randu();
-  size_t start = 0, end = numColumns;
-
   // Sample from the distribution.
+  size_t start = 0, end = numColumns;
   return BinarySearch(cDistribution, randValue, start, end);
 }
 
@@ -659,6 +696,8 @@ inline void CosineTree<MatType>::CalculateCosines(
   // Initialize cosine vector as a vector of zeros.
   cosines.zeros(numColumns);
 
+  #pragma omp parallel for schedule(static) \
+      if (numColumns * dataset->n_rows >= ParallelMinElements)
   for (size_t i = 0; i < numColumns; ++i)
   {
     // If norm is zero, store cosine value as zero. Else, calculate cosine value
@@ -682,10 +721,30 @@ inline void CosineTree<MatType>::CalculateCentroid()
   // Initialize centroid as vector of zeros.
   centroid.zeros(dataset->n_rows);
 
-  // Calculate centroid of columns in the node.
-  for (size_t i = 0; i < numColumns; ++i)
+  // Calculate the sums of the blocks of columns in the node, then add them in
+  // order, so that the result does not depend on the number of threads.
+  const size_t numBlocks = (numColumns + CentroidBlockSize - 1) /
+      CentroidBlockSize;
+  if (numBlocks < 2)
+  {
+    for (size_t i = 0; i < numColumns; ++i)
+      centroid += dataset->col(indices[i]);
+  }
+  else
   {
-    centroid += dataset->col(indices[i]);
+    arma::Mat<typename VecType::elem_type> blockSums(dataset->n_rows,
+        numBlocks, arma::fill::zeros);
+    #pragma omp parallel for schedule(static) \
+        if (numColumns * dataset->n_rows >= ParallelMinElements)
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t end = std::min((b + 1) * CentroidBlockSize, numColumns);
+      for (size_t i = b * CentroidBlockSize; i < end; ++i)
+        blockSums.col(b) += dataset->col(indices[i]);
+    }
+
+    for (size_t b = 0; b < numBlocks; ++b)
+      centroid += blockSums.col(b);
   }
   centroid /= numColumns;
 }
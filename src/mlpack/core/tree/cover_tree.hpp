@@ -19,6 +19,8 @@
 #include "cover_tree/single_tree_traverser_impl.hpp"
 #include "cover_tree/dual_tree_traverser.hpp"
 #include "cover_tree/dual_tree_traverser_impl.hpp"
+#include "cover_tree/parallel_dual_tree_traverser.hpp"
+#include "cover_tree/parallel_dual_tree_traverser_impl.hpp"
 #include "cover_tree/traits.hpp"
 #include "cover_tree/typedef.hpp"
 
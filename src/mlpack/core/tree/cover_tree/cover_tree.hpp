@@ -286,6 +286,11 @@ class CoverTree
   template<typename RuleType>
   using BreadthFirstDualTreeTraverser = DualTreeTraverser<RuleType>;
 
+  //! A dual-tree traverser that traverses independent query subtrees in
+  //! parallel; see parallel_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  class ParallelDualTreeTraverser;
+
   //! Get a reference to the dataset.
   const MatType& Dataset() const { return *dataset; }
 
@@ -1398,12 +1398,34 @@ void CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
                      const size_t pointSetSize)
 {
   // For each point, rebuild the distances.  The indices do not need to be
-  // modified.
+  // modified.  The children of a node have to be built one after another
+  // (each one claims points from the near set), but near the top of the tree
+  // the point sets hold most of the dataset, so these distance computations
+  // are split between threads when the set is large enough.
   distanceComps += pointSetSize;
-  for (size_t i = 0; i < pointSetSize; ++i)
+  if constexpr (IsLMetric<DistanceType>::value)
   {
-    distances[i] = distance->Evaluate(dataset->col(pointIndex),
-        dataset->col(indices[i]));
+    // The LMetric batch evaluation reads the columns directly; each thread
+    // takes blocks of points.
+    const size_t blockSize = 1024;
+    const size_t numBlocks = (pointSetSize + blockSize - 1) / blockSize;
+    #pragma omp parallel for schedule(static) if (pointSetSize >= 4096)
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t first = b * blockSize;
+      const size_t n = std::min(blockSize, pointSetSize - first);
+      DistanceType::Evaluate(dataset->col(pointIndex), *dataset,
+          indices.memptr() + first, n, distances.memptr() + first);
+    }
+  }
+  else
+  {
+    #pragma omp parallel for schedule(static) if (pointSetSize >= 4096)
+    for (size_t i = 0; i < pointSetSize; ++i)
+    {
+      distances[i] = distance->Evaluate(dataset->col(pointIndex),
+          dataset->col(indices[i]));
+    }
   }
 }
 
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_TREE_COVER_TREE_DUAL_TREE_TRAVERSER_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <deque>
 #include <queue>
 
 namespace mlpack {
@@ -52,13 +53,6 @@ class CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
   size_t NumScores() const { return 0; }
   size_t NumBaseCases() const { return 0; }
 
- private:
-  //! The instantiated rule set for pruning branches.
-  RuleType& rule;
-
-  //! The number of pruned nodes.
-  size_t numPrunes;
-
   //! Struct used for traversal.
   struct DualCoverTreeMapEntry
   {
@@ -82,26 +76,138 @@ class CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
     }
   };
 
+  /**
+   * The reference nodes that remain to be visited for a query node, indexed
+   * by scale.  The entries of each scale are held in a flat vector; the
+   * vectors are indexed by the distance of their scale to the largest scale
+   * the map can hold, and the entries at scale INT_MIN (the leaves) are kept
+   * apart.  Clear() keeps all the memory, so a map that is reused does not
+   * allocate anymore once its vectors are large enough; the traverser keeps
+   * one map per level of the recursion for this.  Adding entries never moves
+   * the entries of other scales.
+   *
+   * The map and the helpers below are public so that the
+   * ParallelDualTreeTraverser can split the top of the traversal into
+   * independent tasks.
+   */
+  class ReferenceMap
+  {
+   public:
+    /**
+     * Create an empty map that can hold entries of scale at most the given
+     * one.
+     */
+    ReferenceMap(const int topScale = INT_MIN) :
+        topScale(topScale),
+        first(0)
+    { /* Nothing to do. */ }
+
+    /**
+     * Remove all the entries, keeping the memory.  Afterwards, the map can
+     * hold entries of scale at most the given one.
+     */
+    void Clear(const int newTopScale)
+    {
+      for (size_t i = 0; i < scales.size(); ++i)
+        scales[i].clear();
+      leaves.clear();
+      topScale = newTopScale;
+      first = 0;
+    }
+
+    //! Return whether the map holds no entries.
+    bool Empty() const
+    {
+      return (FirstScale() == scales.size()) && leaves.empty();
+    }
+
+    //! Return the largest scale with entries (INT_MIN if only leaves remain).
+    //! The map must not be empty.
+    int MaxScale() const
+    {
+      const size_t i = FirstScale();
+      return (i == scales.size()) ? INT_MIN : Scale(i);
+    }
+
+    //! Get the largest scale the map can hold.
+    int TopScale() const { return topScale; }
+
+    //! Get the number of scale slots (not counting the leaves).
+    size_t NumScales() const { return scales.size(); }
+    //! Get the scale of the given slot.
+    int Scale(const size_t i) const { return topScale - (int) i; }
+    //! Modify the entries of the given slot.
+    std::vector<DualCoverTreeMapEntry>& Slot(const size_t i)
+    {
+      return scales[i];
+    }
+
+    //! Modify the entries of the given scale, which must be at most
+    //! TopScale().
+    std::vector<DualCoverTreeMapEntry>& Entries(const int scale)
+    {
+      if (scale == INT_MIN)
+        return leaves;
+
+      const size_t i = (size_t) (topScale - scale);
+      if (i >= scales.size())
+        scales.resize(i + 1);
+      first = std::min(first, i);
+      return scales[i];
+    }
+
+   private:
+    //! Return the first slot with entries, or NumScales() if there is none.
+    size_t FirstScale() const
+    {
+      while (first < scales.size() && scales[first].empty())
+        ++first;
+      return first;
+    }
+
+    //! The entries of each scale, starting at topScale.  A deque is used so
+    //! that adding scales does not move the existing vectors.
+    std::deque<std::vector<DualCoverTreeMapEntry>> scales;
+    //! The entries at scale INT_MIN.
+    std::vector<DualCoverTreeMapEntry> leaves;
+    //! The scale of the first slot.
+    int topScale;
+    //! No slot before this one has entries.
+    mutable size_t first;
+  };
+
   /**
    * Helper function for traversal of the two trees.
    */
-  void Traverse(
-      CoverTree& queryNode,
-      std::map<int, std::vector<DualCoverTreeMapEntry>,
-          std::greater<int>>& referenceMap);
+  void Traverse(CoverTree& queryNode, ReferenceMap& referenceMap);
 
   //! Prepare map for recursion.
-  void PruneMap(
-      CoverTree& queryNode,
-      std::map<int, std::vector<DualCoverTreeMapEntry>,
-          std::greater<int>>& referenceMap,
-      std::map<int, std::vector<DualCoverTreeMapEntry>,
-          std::greater<int>>& childMap);
-
-  void ReferenceRecursion(
-      CoverTree& queryNode,
-    std::map<int, std::vector<DualCoverTreeMapEntry>,
-        std::greater<int>>& referenceMap);
+  void PruneMap(CoverTree& queryNode,
+                ReferenceMap& referenceMap,
+                ReferenceMap& childMap);
+
+  //! Descend the reference nodes in the map down to the scale of the query
+  //! node.
+  void ReferenceRecursion(CoverTree& queryNode, ReferenceMap& referenceMap);
+
+ private:
+  //! Score the reference entries of one scale against the query node, and
+  //! add those that are not pruned to the given vector.
+  void PruneEntries(CoverTree& queryNode,
+                    std::vector<DualCoverTreeMapEntry>& scaleVector,
+                    std::vector<DualCoverTreeMapEntry>& newScaleVector);
+
+  //! The instantiated rule set for pruning branches.
+  RuleType& rule;
+
+  //! The number of pruned nodes.
+  size_t numPrunes;
+
+  //! The reference maps of each level of the recursion, which are reused by
+  //! all the query nodes of that level.
+  std::deque<ReferenceMap> maps;
+  //! The current level of the recursion.
+  size_t depth;
 };
 
 } // namespace mlpack
@@ -28,7 +28,8 @@ template<typename RuleType>
 CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
 DualTreeTraverser<RuleType>::DualTreeTraverser(RuleType& rule) :
     rule(rule),
-    numPrunes(0)
+    numPrunes(0),
+    depth(0)
 { /* Nothing to do. */ }
 
 template<
@@ -42,8 +43,13 @@ void CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
 DualTreeTraverser<RuleType>::Traverse(CoverTree& queryNode,
                                       CoverTree& referenceNode)
 {
-  // Start by creating a map and adding the reference root node to it.
-  std::map<int, std::vector<DualCoverTreeMapEntry>, std::greater<int>> refMap;
+  // Start by creating a map and adding the reference root node to it.  The
+  // first map of the recursion is used for it.
+  if (maps.empty())
+    maps.resize(1);
+  depth = 0;
+  ReferenceMap& refMap = maps[0];
+  refMap.Clear(referenceNode.Scale());
 
   DualCoverTreeMapEntry rootRefEntry;
 
@@ -55,7 +61,7 @@ DualTreeTraverser<RuleType>::Traverse(CoverTree& queryNode,
       referenceNode.Point());
   rootRefEntry.traversalInfo = rule.TraversalInfo();
 
-  refMap[referenceNode.Scale()].push_back(rootRefEntry);
+  refMap.Entries(referenceNode.Scale()).push_back(rootRefEntry);
 
   Traverse(queryNode, refMap);
 }
@@ -68,26 +74,32 @@ template<
 >
 template<typename RuleType>
 void CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
-DualTreeTraverser<RuleType>::Traverse(
-    CoverTree& queryNode,
-    std::map<int, std::vector<DualCoverTreeMapEntry>, std::greater<int>>&
-        referenceMap)
+DualTreeTraverser<RuleType>::Traverse(CoverTree& queryNode,
+                                      ReferenceMap& referenceMap)
 {
-  if (referenceMap.size() == 0)
+  if (referenceMap.Empty())
     return; // Nothing to do!
 
   // First recurse down the reference nodes as necessary.
   ReferenceRecursion(queryNode, referenceMap);
 
   // Did the map get emptied?
-  if (referenceMap.size() == 0)
+  if (referenceMap.Empty())
     return; // Nothing to do!
 
   // Now, reduce the scale of the query node by recursing.  But we can't recurse
   // if the query node is a leaf node.
   if ((queryNode.Scale() != INT_MIN) &&
-      (queryNode.Scale() >= (*referenceMap.begin()).first))
+      (queryNode.Scale() >= referenceMap.MaxScale()))
   {
+    // All the children of this query node use the map of the next level of
+    // the recursion, which is cleared (but not freed) before each of them.
+    // The deque does not move the maps of the levels above when it grows.
+    if (maps.size() < depth + 2)
+      maps.resize(depth + 2);
+    ReferenceMap& childMap = maps[depth + 1];
+    ++depth;
+
     // Recurse into the non-self-children first.  The recursion order cannot
     // affect the runtime of the algorithm, because each query child recursion's
     // results are separate and independent.  I don't think this is true in
@@ -95,18 +107,16 @@ DualTreeTraverser<RuleType>::Traverse(
     // the future.
     for (size_t i = 1; i < queryNode.NumChildren(); ++i)
     {
-      // We need a copy of the map for this child.
-      std::map<int, std::vector<DualCoverTreeMapEntry>, std::greater<int>>
-          childMap;
-
+      childMap.Clear(referenceMap.TopScale());
       PruneMap(queryNode.Child(i), referenceMap, childMap);
       Traverse(queryNode.Child(i), childMap);
     }
-    std::map<int, std::vector<DualCoverTreeMapEntry>, std::greater<int>>
-        selfChildMap;
 
-    PruneMap(queryNode.Child(0), referenceMap, selfChildMap);
-    Traverse(queryNode.Child(0), selfChildMap);
+    childMap.Clear(referenceMap.TopScale());
+    PruneMap(queryNode.Child(0), referenceMap, childMap);
+    Traverse(queryNode.Child(0), childMap);
+
+    --depth;
   }
 
   if (queryNode.Scale() != INT_MIN)
@@ -114,9 +124,10 @@ DualTreeTraverser<RuleType>::Traverse(
 
   // If we have made it this far, all we have is a bunch of base case
   // evaluations to do.
-  Log::Assert((*referenceMap.begin()).first == INT_MIN);
+  Log::Assert(referenceMap.MaxScale() == INT_MIN);
   Log::Assert(queryNode.Scale() == INT_MIN);
-  std::vector<DualCoverTreeMapEntry>& pointVector = referenceMap[INT_MIN];
+  std::vector<DualCoverTreeMapEntry>& pointVector =
+      referenceMap.Entries(INT_MIN);
 
   for (size_t i = 0; i < pointVector.size(); ++i)
   {
@@ -158,116 +169,76 @@ template<
 >
 template<typename RuleType>
 void CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
-DualTreeTraverser<RuleType>::PruneMap(
-    CoverTree& queryNode,
-    std::map<int, std::vector<DualCoverTreeMapEntry>, std::greater<int>>&
-        referenceMap,
-    std::map<int, std::vector<DualCoverTreeMapEntry>, std::greater<int>>&
-        childMap)
+DualTreeTraverser<RuleType>::PruneMap(CoverTree& queryNode,
+                                      ReferenceMap& referenceMap,
+                                      ReferenceMap& childMap)
 {
-  if (referenceMap.empty())
+  if (referenceMap.Empty())
     return; // Nothing to do.
 
   // Copy the zero set first.
-  if (referenceMap.count(INT_MIN) == 1)
-  {
-    // Get a reference to the vector representing the entries at this scale.
-    std::vector<DualCoverTreeMapEntry>& scaleVector = referenceMap[INT_MIN];
+  std::vector<DualCoverTreeMapEntry>& leaves = referenceMap.Entries(INT_MIN);
+  if (!leaves.empty())
+    PruneEntries(queryNode, leaves, childMap.Entries(INT_MIN));
 
-    // Before traversing all the points in this scale, sort by score.
-    std::sort(scaleVector.begin(), scaleVector.end());
-
-    childMap[INT_MIN].reserve(scaleVector.size());
-    std::vector<DualCoverTreeMapEntry>& newScaleVector = childMap[INT_MIN];
-
-    // Loop over each entry in the vector.
-    for (size_t j = 0; j < scaleVector.size(); ++j)
+  // Then all the other scales, from the largest to the smallest.
+  for (size_t i = 0; i < referenceMap.NumScales(); ++i)
+  {
+    std::vector<DualCoverTreeMapEntry>& scaleVector = referenceMap.Slot(i);
+    if (!scaleVector.empty())
     {
-      const DualCoverTreeMapEntry& frame = scaleVector[j];
-
-      // First evaluate if we can prune without performing the base case.
-      CoverTree* refNode = frame.referenceNode;
-
-      // Perform the actual scoring, after restoring the traversal info.
-      rule.TraversalInfo() = frame.traversalInfo;
-      double score = rule.Score(queryNode, *refNode);
-
-      if (score == DBL_MAX)
-      {
-        // Pruned.  Move on.
-        ++numPrunes;
-        continue;
-      }
-
-      // If it isn't pruned, we must evaluate the base case.
-      const double baseCase = rule.BaseCase(queryNode.Point(),
-          refNode->Point());
-
-      // Add to child map.
-      newScaleVector.push_back(frame);
-      newScaleVector.back().score = score;
-      newScaleVector.back().baseCase = baseCase;
-      newScaleVector.back().traversalInfo = rule.TraversalInfo();
+      PruneEntries(queryNode, scaleVector,
+          childMap.Entries(referenceMap.Scale(i)));
     }
-
-    // If we didn't add anything, then strike this vector from the map.
-    if (newScaleVector.size() == 0)
-      childMap.erase(INT_MIN);
   }
+}
+
+template<
+    typename DistanceType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+template<typename RuleType>
+void CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
+DualTreeTraverser<RuleType>::PruneEntries(
+    CoverTree& queryNode,
+    std::vector<DualCoverTreeMapEntry>& scaleVector,
+    std::vector<DualCoverTreeMapEntry>& newScaleVector)
+{
+  // Before traversing all the points in this scale, sort by score.
+  std::sort(scaleVector.begin(), scaleVector.end());
 
-  typename std::map<int, std::vector<DualCoverTreeMapEntry>,
-      std::greater<int>>::iterator it = referenceMap.begin();
+  newScaleVector.reserve(scaleVector.size());
 
-  while ((it != referenceMap.end()))
+  // Loop over each entry in the vector.
+  for (size_t j = 0; j < scaleVector.size(); ++j)
   {
-    const int thisScale = (*it).first;
-    if (thisScale == INT_MIN) // We already did it.
-      break;
+    const DualCoverTreeMapEntry& frame = scaleVector[j];
 
-    // Get a reference to the vector representing the entries at this scale.
-    std::vector<DualCoverTreeMapEntry>& scaleVector = (*it).second;
-
-    // Before traversing all the points in this scale, sort by score.
-    std::sort(scaleVector.begin(), scaleVector.end());
+    // First evaluate if we can prune without performing the base case.
+    CoverTree* refNode = frame.referenceNode;
 
-    childMap[thisScale].reserve(scaleVector.size());
-    std::vector<DualCoverTreeMapEntry>& newScaleVector = childMap[thisScale];
+    // Perform the actual scoring, after restoring the traversal info.
+    rule.TraversalInfo() = frame.traversalInfo;
+    double score = rule.Score(queryNode, *refNode);
 
-    // Loop over each entry in the vector.
-    for (size_t j = 0; j < scaleVector.size(); ++j)
+    if (score == DBL_MAX)
     {
-      const DualCoverTreeMapEntry& frame = scaleVector[j];
-
-      // First evaluate if we can prune without performing the base case.
-      CoverTree* refNode = frame.referenceNode;
-
-      // Perform the actual scoring, after restoring the traversal info.
-      rule.TraversalInfo() = frame.traversalInfo;
-      double score = rule.Score(queryNode, *refNode);
-
-      if (score == DBL_MAX)
-      {
-        // Pruned.  Move on.
-        ++numPrunes;
-        continue;
-      }
-
-      // If it isn't pruned, we must evaluate the base case.
-      const double baseCase = rule.BaseCase(queryNode.Point(),
-          refNode->Point());
-
-      // Add to child map.
-      newScaleVector.push_back(frame);
-      newScaleVector.back().score = score;
-      newScaleVector.back().baseCase = baseCase;
-      newScaleVector.back().traversalInfo = rule.TraversalInfo();
+      // Pruned.  Move on.
+      ++numPrunes;
+      continue;
     }
 
-    // If we didn't add anything, then strike this vector from the map.
-    if (newScaleVector.size() == 0)
-      childMap.erase((*it).first);
+    // If it isn't pruned, we must evaluate the base case.
+    const double baseCase = rule.BaseCase(queryNode.Point(),
+        refNode->Point());
 
-    ++it; // Advance to next scale.
+    // Add to child map.
+    newScaleVector.push_back(frame);
+    newScaleVector.back().score = score;
+    newScaleVector.back().baseCase = baseCase;
+    newScaleVector.back().traversalInfo = rule.TraversalInfo();
   }
 }
 
@@ -279,16 +250,14 @@ template<
 >
 template<typename RuleType>
 void CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
-DualTreeTraverser<RuleType>::ReferenceRecursion(
-    CoverTree& queryNode,
-    std::map<int, std::vector<DualCoverTreeMapEntry>, std::greater<int>>&
-        referenceMap)
+DualTreeTraverser<RuleType>::ReferenceRecursion(CoverTree& queryNode,
+                                                ReferenceMap& referenceMap)
 {
   // First, reduce the maximum scale in the reference map down to the scale of
   // the query node.
-  while (!referenceMap.empty())
+  while (!referenceMap.Empty())
   {
-    const int maxScale = ((*referenceMap.begin()).first);
+    const int maxScale = referenceMap.MaxScale();
     // Hacky bullshit to imitate jl cover tree.
     if (queryNode.Parent() == NULL && maxScale < queryNode.Scale())
       break;
@@ -299,8 +268,10 @@ DualTreeTraverser<RuleType>::ReferenceRecursion(
     if (queryNode.Scale() == INT_MIN && maxScale == INT_MIN)
       break;
 
-    // Get a reference to the current largest scale.
-    std::vector<DualCoverTreeMapEntry>& scaleVector = referenceMap[maxScale];
+    // Get a reference to the current largest scale.  The children are added
+    // to smaller scales, which does not move this vector.
+    std::vector<DualCoverTreeMapEntry>& scaleVector =
+        referenceMap.Entries(maxScale);
 
     // Before traversing all the points in this scale, sort by score.
     std::sort(scaleVector.begin(), scaleVector.end());
@@ -345,12 +316,13 @@ DualTreeTraverser<RuleType>::ReferenceRecursion(
         newFrame.score = childScore; // Use the score of the parent.
         newFrame.baseCase = baseCase;
         newFrame.traversalInfo = rule.TraversalInfo();
-        referenceMap[newFrame.referenceNode->Scale()].push_back(newFrame);
+        referenceMap.Entries(newFrame.referenceNode->Scale()).push_back(
+            newFrame);
       }
     }
 
-    // Now clear the memory for this scale; it isn't needed anymore.
-    referenceMap.erase(maxScale);
+    // Now clear this scale; its memory is kept for later.
+    scaleVector.clear();
   }
 }
 
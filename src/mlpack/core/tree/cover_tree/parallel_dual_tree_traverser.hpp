@@ -0,0 +1,109 @@
+/**
+ * @file core/tree/cover_tree/parallel_dual_tree_traverser.hpp
+ *
+ * Defines the ParallelDualTreeTraverser for the CoverTree tree type.  This is a
+ * nested class of CoverTree which splits the top of the query tree into a set
+ * of independent subtrees (each with its own map of reference nodes) and
+ * finishes the traversal of each of them in parallel with OpenMP, using the
+ * regular DualTreeTraverser.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_COVER_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_COVER_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "cover_tree.hpp"
+#include "dual_tree_traverser.hpp"
+
+namespace mlpack {
+
+/**
+ * The ParallelDualTreeTraverser is a drop-in replacement for the
+ * DualTreeTraverser of a CoverTree.  The traversal starts exactly like the
+ * DualTreeTraverser, but the recursion into the children of the query nodes is
+ * performed level by level (serially) until there are enough query subtrees to
+ * keep all OpenMP threads busy.  Each query subtree, along with the map of
+ * reference nodes that it still has to be compared with, is then traversed by
+ * its own DualTreeTraverser.
+ *
+ * The recursions into different query children are independent in the
+ * DualTreeTraverser too, so the results are the same as with the
+ * DualTreeTraverser.  The requirements on the RuleType are the same as for
+ * BinarySpaceTree::ParallelDualTreeTraverser: the RuleType must be
+ * copy-constructible, a copy must share its results with the object it was
+ * copied from, and it must provide modifiable BaseCases() and Scores()
+ * accessors.  Since the query subtrees are disjoint (the descendants of the
+ * children of a cover tree node partition its descendants), no two threads
+ * write to the same results or to the same query node statistic; statistics of
+ * the nodes above the split are only read during the parallel phase.
+ *
+ * If mlpack is compiled without OpenMP, this performs the same traversal as
+ * the DualTreeTraverser.
+ */
+template<
+    typename DistanceType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+template<typename RuleType>
+class CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
+    ParallelDualTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the parallel dual-tree traverser with the given rule set.
+   *
+   * @param rule Rule set to use for the traversal.
+   * @param minTasks Minimum number of query subtrees to create before starting
+   *     the parallel traversal.  If 0, four times the number of OpenMP threads
+   *     will be used.
+   */
+  ParallelDualTreeTraverser(RuleType& rule, const size_t minTasks = 0);
+
+  /**
+   * Traverse the two specified trees.  This does not reset the number of
+   * prunes.
+   *
+   * @param queryNode Root of query tree.
+   * @param referenceNode Root of reference tree.
+   */
+  void Traverse(CoverTree& queryNode, CoverTree& referenceNode);
+
+  //! Get the number of pruned nodes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of pruned nodes.
+  size_t& NumPrunes() { return numPrunes; }
+
+  // These are fake, like for the DualTreeTraverser.
+  size_t NumVisited() const { return 0; }
+  size_t NumScores() const { return 0; }
+  size_t NumBaseCases() const { return 0; }
+
+  //! Get the minimum number of query subtrees (0 means automatic).
+  size_t MinTasks() const { return minTasks; }
+  //! Modify the minimum number of query subtrees (0 means automatic).
+  size_t& MinTasks() { return minTasks; }
+
+ private:
+  //! Reference to the rules with which the trees will be traversed.
+  RuleType& rule;
+
+  //! The minimum number of query subtrees to create.
+  size_t minTasks;
+
+  //! The number of pruned nodes.
+  size_t numPrunes;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_dual_tree_traverser_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_COVER_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
@@ -0,0 +1,153 @@
+/**
+ * @file core/tree/cover_tree/parallel_dual_tree_traverser_impl.hpp
+ *
+ * Implementation of the ParallelDualTreeTraverser for CoverTree.  The top of
+ * the query tree is split into independent subtrees, each of which is
+ * traversed against its remaining reference nodes by a separate thread.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_COVER_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_COVER_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "parallel_dual_tree_traverser.hpp"
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+
+template<
+    typename DistanceType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+template<typename RuleType>
+CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
+ParallelDualTreeTraverser<RuleType>::ParallelDualTreeTraverser(
+    RuleType& rule,
+    const size_t minTasks) :
+    rule(rule),
+    minTasks(minTasks),
+    numPrunes(0)
+{ /* Nothing to do. */ }
+
+template<
+    typename DistanceType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+template<typename RuleType>
+void CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
+ParallelDualTreeTraverser<RuleType>::Traverse(CoverTree& queryNode,
+                                              CoverTree& referenceNode)
+{
+  using Traverser = DualTreeTraverser<RuleType>;
+  using ReferenceMap = typename Traverser::ReferenceMap;
+  using MapEntry = typename Traverser::DualCoverTreeMapEntry;
+  using Frontier = std::vector<std::pair<CoverTree*, ReferenceMap>>;
+
+  // The serial part of the traversal uses the given rules.
+  Traverser traverser(rule);
+
+  // Perform the evaluation between the roots of either tree, exactly like the
+  // DualTreeTraverser does.
+  ReferenceMap rootMap(referenceNode.Scale());
+  MapEntry rootRefEntry;
+  rootRefEntry.referenceNode = &referenceNode;
+  rootRefEntry.score = rule.Score(queryNode, referenceNode);
+  rootRefEntry.baseCase = rule.BaseCase(queryNode.Point(),
+      referenceNode.Point());
+  rootRefEntry.traversalInfo = rule.TraversalInfo();
+  rootMap.Entries(referenceNode.Scale()).push_back(rootRefEntry);
+
+  size_t targetTasks = minTasks;
+  if (targetTasks == 0)
+  {
+    #ifdef MLPACK_USE_OPENMP
+    targetTasks = 4 * omp_get_max_threads();
+    #else
+    targetTasks = 1;
+    #endif
+  }
+
+  // Recurse into the query children one level at a time, with the same steps
+  // as the DualTreeTraverser, until we have enough independent subtrees.  A
+  // query node whose reference map becomes empty needs no more work.
+  Frontier frontier;
+  frontier.emplace_back(&queryNode, std::move(rootMap));
+  while (frontier.size() < targetTasks)
+  {
+    Frontier nextFrontier;
+    bool expanded = false;
+    for (size_t i = 0; i < frontier.size(); ++i)
+    {
+      CoverTree* node = frontier[i].first;
+      ReferenceMap& referenceMap = frontier[i].second;
+
+      traverser.ReferenceRecursion(*node, referenceMap);
+      if (referenceMap.Empty())
+        continue;
+
+      // If the query node cannot be recursed into, all that is left is base
+      // cases; those are done in the parallel phase.
+      if ((node->Scale() == INT_MIN) ||
+          (node->Scale() < referenceMap.MaxScale()))
+      {
+        nextFrontier.emplace_back(node, std::move(referenceMap));
+        continue;
+      }
+
+      // Recurse into the non-self-children first, and then the self-child.
+      expanded = true;
+      for (size_t c = 1; c <= node->NumChildren(); ++c)
+      {
+        CoverTree& child = node->Child(c % node->NumChildren());
+        ReferenceMap childMap(referenceMap.TopScale());
+        traverser.PruneMap(child, referenceMap, childMap);
+        if (!childMap.Empty())
+          nextFrontier.emplace_back(&child, std::move(childMap));
+      }
+    }
+
+    frontier.swap(nextFrontier);
+    if (!expanded)
+      break; // Every query node in the frontier is done recursing.
+  }
+
+  // Now finish the traversal of each query subtree independently.  Every
+  // thread gets its own copy of the rules, which shares its results with the
+  // original rules.
+  size_t taskPrunes = 0, ruleScores = 0, ruleBaseCases = 0;
+
+  #pragma omp parallel for schedule(dynamic) \
+      reduction(+:taskPrunes, ruleScores, ruleBaseCases)
+  for (size_t i = 0; i < frontier.size(); ++i)
+  {
+    RuleType taskRule(rule);
+    taskRule.BaseCases() = 0;
+    taskRule.Scores() = 0;
+
+    Traverser taskTraverser(taskRule);
+    taskTraverser.Traverse(*frontier[i].first, frontier[i].second);
+
+    taskPrunes += taskTraverser.NumPrunes();
+    ruleScores += taskRule.Scores();
+    ruleBaseCases += taskRule.BaseCases();
+  }
+
+  numPrunes += traverser.NumPrunes() + taskPrunes;
+  rule.Scores() += ruleScores;
+  rule.BaseCases() += ruleBaseCases;
+}
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_COVER_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
@@ -0,0 +1,45 @@
+/**
+ * @file core/tree/dual_tree_traverser_type.hpp
+ *
+ * A utility struct that selects the dual-tree traverser to use for a given
+ * tree type and rule set: the tree's ParallelDualTreeTraverser, if it has one,
+ * and its DualTreeTraverser otherwise.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_DUAL_TREE_TRAVERSER_TYPE_HPP
+#define MLPACK_CORE_TREE_DUAL_TREE_TRAVERSER_TYPE_HPP
+
+namespace mlpack {
+
+/**
+ * The dual-tree traverser to use for the given tree type and rule set.  If the
+ * tree type has a ParallelDualTreeTraverser, that is used; otherwise, the
+ * regular DualTreeTraverser is used.  Rule sets used with this must satisfy the
+ * requirements of the ParallelDualTreeTraverser (see
+ * BinarySpaceTree::ParallelDualTreeTraverser).
+ *
+ * @code
+ * typename DualTreeTraverserType<TreeType, RuleType>::type traverser(rules);
+ * traverser.Traverse(queryTree, referenceTree);
+ * @endcode
+ */
+template<typename TreeType, typename RuleType, typename = void>
+struct DualTreeTraverserType
+{
+  using type = typename TreeType::template DualTreeTraverser<RuleType>;
+};
+
+template<typename TreeType, typename RuleType>
+struct DualTreeTraverserType<TreeType, RuleType, std::void_t<
+    typename TreeType::template ParallelDualTreeTraverser<RuleType>>>
+{
+  using type = typename TreeType::template ParallelDualTreeTraverser<RuleType>;
+};
+
+} // namespace mlpack
+
+#endif
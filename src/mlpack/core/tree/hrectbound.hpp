@@ -41,16 +41,30 @@ struct IsLMetric<LMetric<Power, TakeRoot>>
  * with the LMetric class.  Be sure to use the same template parameters for
  * LMetric as you do for HRectBound -- otherwise odd results may occur.
  *
+ * The bounds of each dimension can be stored in a smaller type than ElemType
+ * with the BoundElemType parameter (see CompactHRectBound); this halves the
+ * memory used by the bounds of a tree of double-precision data, which is most
+ * of the memory of the tree when the data is high-dimensional.  Compact bounds
+ * are rounded outwards, so they still contain all the points they were expanded
+ * to, and all distances are still computed in ElemType; so the distance bounds
+ * are looser by at most the rounding error of BoundElemType, but pruning stays
+ * correct.
+ *
  * @tparam DistanceType Type of distance metric to use; must be of type LMetric.
  * @tparam ElemType Element type (double/float/int/etc.).
+ * @tparam BoundElemType Type used to store the bounds of each dimension.
  */
 template<typename DistanceType = LMetric<2, true>,
-         typename ElemType = double>
+         typename ElemType = double,
+         typename BoundElemType = ElemType>
 class HRectBound
 {
   // It is required that HRectBound have an LMetric as the given DistanceType.
   static_assert(IsLMetric<DistanceType>::Value == true,
       "HRectBound can only be used with the LMetric<> metric type.");
+  static_assert(std::numeric_limits<BoundElemType>::digits <=
+      std::numeric_limits<ElemType>::digits,
+      "HRectBound: BoundElemType must not be more precise than ElemType.");
 
  public:
   /**
@@ -92,9 +106,9 @@ class HRectBound
 
   //! Get the range for a particular dimension.  No bounds checking.  Be
   //! careful: this may make MinWidth() invalid.
-  RangeType<ElemType>& operator[](const size_t i) { return bounds[i]; }
+  RangeType<BoundElemType>& operator[](const size_t i) { return bounds[i]; }
   //! Modify the range for a particular dimension.  No bounds checking.
-  const RangeType<ElemType>& operator[](const size_t i) const
+  const RangeType<BoundElemType>& operator[](const size_t i) const
   { return bounds[i]; }
 
   //! Get the minimum width of the bound.
@@ -244,18 +258,40 @@ class HRectBound
   //! The dimensionality of the bound.
   size_t dim;
   //! The bounds for each dimension.
-  RangeType<ElemType>* bounds;
+  RangeType<BoundElemType>* bounds;
   //! Cached minimum width of bound.
   ElemType minWidth;
   //! Instantiated distance metric (likely has size 0).
   DistanceType distance;
+
+  //! Get the width of the given dimension, computed in ElemType.
+  ElemType Width(const size_t i) const
+  {
+    return (bounds[i].Lo() < bounds[i].Hi()) ?
+        ((ElemType) bounds[i].Hi() - (ElemType) bounds[i].Lo()) : 0;
+  }
+
+  //! Round x down to BoundElemType.
+  static BoundElemType RoundDown(const ElemType x);
+  //! Round x up to BoundElemType.
+  static BoundElemType RoundUp(const ElemType x);
 };
 
+/**
+ * An HRectBound that stores its bounds in single precision; use it as the
+ * BoundType of a tree (e.g. a BinarySpaceTree) to reduce the memory used by the
+ * bounds of the tree.
+ */
+template<typename DistanceType = LMetric<2, true>,
+         typename ElemType = double>
+using CompactHRectBound = HRectBound<DistanceType, ElemType, float>;
+
 // A specialization of BoundTraits for this class.
-template<typename DistanceType, typename ElemType>
-struct BoundTraits<HRectBound<DistanceType, ElemType>>
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+struct BoundTraits<HRectBound<DistanceType, ElemType, BoundElemType>>
 {
-  //! These bounds are always tight for each dimension.
+  //! These bounds are always tight for each dimension (up to the rounding of
+  //! compact bounds).
   static const bool HasTightBounds = true;
 };
 
@@ -23,8 +23,8 @@ namespace mlpack {
 /**
  * Empty constructor.
  */
-template<typename DistanceType, typename ElemType>
-inline HRectBound<DistanceType, ElemType>::HRectBound() :
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline HRectBound<DistanceType, ElemType, BoundElemType>::HRectBound() :
     dim(0),
     bounds(NULL),
     minWidth(0)
@@ -34,21 +34,22 @@ inline HRectBound<DistanceType, ElemType>::HRectBound() :
  * Initializes to specified dimensionality with each dimension the empty
  * set.
  */
-template<typename DistanceType, typename ElemType>
-inline HRectBound<DistanceType, ElemType>::HRectBound(const size_t dimension) :
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline HRectBound<DistanceType, ElemType, BoundElemType>::HRectBound(
+    const size_t dimension) :
     dim(dimension),
-    bounds(new RangeType<ElemType>[dim]),
+    bounds(new RangeType<BoundElemType>[dim]),
     minWidth(0)
 { /* Nothing to do. */ }
 
 /**
  * Copy constructor necessary to prevent memory leaks.
  */
-template<typename DistanceType, typename ElemType>
-inline HRectBound<DistanceType, ElemType>::HRectBound(
-    const HRectBound<DistanceType, ElemType>& other) :
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline HRectBound<DistanceType, ElemType, BoundElemType>::HRectBound(
+    const HRectBound& other) :
     dim(other.Dim()),
-    bounds(new RangeType<ElemType>[dim]),
+    bounds(new RangeType<BoundElemType>[dim]),
     minWidth(other.MinWidth())
 {
   // Copy other bounds over.
@@ -59,11 +60,10 @@ inline HRectBound<DistanceType, ElemType>::HRectBound(
 /**
  * Same as the copy constructor.
  */
-template<typename DistanceType, typename ElemType>
-inline HRectBound<
-    DistanceType,
-    ElemType>& HRectBound<DistanceType,
-    ElemType>::operator=(const HRectBound<DistanceType, ElemType>& other)
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline HRectBound<DistanceType, ElemType, BoundElemType>&
+HRectBound<DistanceType, ElemType, BoundElemType>::operator=(
+    const HRectBound& other)
 {
   if (this == &other)
     return *this;
@@ -75,7 +75,7 @@ inline HRectBound<
       delete[] bounds;
 
     dim = other.Dim();
-    bounds = new RangeType<ElemType>[dim];
+    bounds = new RangeType<BoundElemType>[dim];
   }
 
   // Now copy each of the bound values.
@@ -90,9 +90,9 @@ inline HRectBound<
 /**
  * Move constructor: take possession of another bound's information.
  */
-template<typename DistanceType, typename ElemType>
-inline HRectBound<DistanceType, ElemType>::HRectBound(
-    HRectBound<DistanceType, ElemType>&& other) :
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline HRectBound<DistanceType, ElemType, BoundElemType>::HRectBound(
+    HRectBound&& other) :
     dim(other.dim),
     bounds(other.bounds),
     minWidth(other.minWidth)
@@ -106,10 +106,10 @@ inline HRectBound<DistanceType, ElemType>::HRectBound(
 /**
  * Move assignment operator.
  */
-template<typename DistanceType, typename ElemType>
-inline HRectBound<DistanceType, ElemType>&
-HRectBound<DistanceType, ElemType>::operator=(
-    HRectBound<DistanceType, ElemType>&& other)
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline HRectBound<DistanceType, ElemType, BoundElemType>&
+HRectBound<DistanceType, ElemType, BoundElemType>::operator=(
+    HRectBound&& other)
 {
   if (this != &other)
   {
@@ -126,8 +126,8 @@ HRectBound<DistanceType, ElemType>::operator=(
 /**
  * Destructor: clean up memory.
  */
-template<typename DistanceType, typename ElemType>
-inline HRectBound<DistanceType, ElemType>::~HRectBound()
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline HRectBound<DistanceType, ElemType, BoundElemType>::~HRectBound()
 {
   if (bounds)
     delete[] bounds;
@@ -136,11 +136,11 @@ inline HRectBound<DistanceType, ElemType>::~HRectBound()
 /**
  * Resets all dimensions to the empty set.
  */
-template<typename DistanceType, typename ElemType>
-inline void HRectBound<DistanceType, ElemType>::Clear()
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline void HRectBound<DistanceType, ElemType, BoundElemType>::Clear()
 {
   for (size_t i = 0; i < dim; ++i)
-    bounds[i] = RangeType<ElemType>();
+    bounds[i] = RangeType<BoundElemType>();
   minWidth = 0;
 }
 
@@ -149,27 +149,30 @@ inline void HRectBound<DistanceType, ElemType>::Clear()
  *
  * @param centroid Vector which the centroid will be written to.
  */
-template<typename DistanceType, typename ElemType>
-inline void HRectBound<DistanceType, ElemType>::Center(
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline void HRectBound<DistanceType, ElemType, BoundElemType>::Center(
     arma::Col<ElemType>& center) const
 {
   // Set size correctly if necessary.
   if (!(center.n_elem == dim))
     center.set_size(dim);
 
+  // Compute the center in ElemType, so that it is the exact center of the
+  // (possibly compact) stored bound.
   for (size_t i = 0; i < dim; ++i)
-    center(i) = bounds[i].Mid();
+    center(i) = ((ElemType) bounds[i].Lo() + (ElemType) bounds[i].Hi()) / 2;
 }
 
 /**
  * Recompute the minimum width of the bound.
  */
-template<typename DistanceType, typename ElemType>
-inline void HRectBound<DistanceType, ElemType>::RecomputeMinWidth()
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline void
+HRectBound<DistanceType, ElemType, BoundElemType>::RecomputeMinWidth()
 {
   minWidth = std::numeric_limits<ElemType>::max();
   for (size_t i = 0; i < dim; ++i)
-    minWidth = std::min(minWidth, bounds[i].Width());
+    minWidth = std::min(minWidth, Width(i));
 }
 
 /**
@@ -177,8 +180,9 @@ inline void HRectBound<DistanceType, ElemType>::RecomputeMinWidth()
  *
  * @return Volume of the hyperrectangle.
  */
-template<typename DistanceType, typename ElemType>
-inline ElemType HRectBound<DistanceType, ElemType>::Volume() const
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline ElemType
+HRectBound<DistanceType, ElemType, BoundElemType>::Volume() const
 {
   ElemType volume = 1.0;
   for (size_t i = 0; i < dim; ++i)
@@ -186,7 +190,7 @@ inline ElemType HRectBound<DistanceType, ElemType>::Volume() const
     if (bounds[i].Lo() >= bounds[i].Hi())
       return 0;
 
-    volume *= (bounds[i].Hi() - bounds[i].Lo());
+    volume *= Width(i);
   }
 
   return volume;
@@ -195,9 +199,9 @@ inline ElemType HRectBound<DistanceType, ElemType>::Volume() const
 /**
  * Calculates minimum bound-to-point squared distance.
  */
-template<typename DistanceType, typename ElemType>
+template<typename DistanceType, typename ElemType, typename BoundElemType>
 template<typename VecType>
-inline ElemType HRectBound<DistanceType, ElemType>::MinDistance(
+inline ElemType HRectBound<DistanceType, ElemType, BoundElemType>::MinDistance(
     const VecType& point,
     typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
 {
@@ -208,8 +212,8 @@ inline ElemType HRectBound<DistanceType, ElemType>::MinDistance(
   ElemType lower, higher;
   for (size_t d = 0; d < dim; d++)
   {
-    lower = bounds[d].Lo() - point[d];
-    higher = point[d] - bounds[d].Hi();
+    lower = (ElemType) bounds[d].Lo() - point[d];
+    higher = point[d] - (ElemType) bounds[d].Hi();
 
     // Since only one of 'lower' or 'higher' is negative, if we add each's
     // absolute value to itself and then sum those two, our result is the
@@ -254,21 +258,21 @@ inline ElemType HRectBound<DistanceType, ElemType>::MinDistance(
 /**
  * Calculates minimum bound-to-bound squared distance.
  */
-template<typename DistanceType, typename ElemType>
-ElemType HRectBound<DistanceType, ElemType>::MinDistance(
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+ElemType HRectBound<DistanceType, ElemType, BoundElemType>::MinDistance(
     const HRectBound& other) const
 {
   Log::Assert(dim == other.dim);
 
   ElemType sum = 0;
-  const RangeType<ElemType>* mbound = bounds;
-  const RangeType<ElemType>* obound = other.bounds;
+  const RangeType<BoundElemType>* mbound = bounds;
+  const RangeType<BoundElemType>* obound = other.bounds;
 
   ElemType lower, higher;
   for (size_t d = 0; d < dim; d++)
   {
-    lower = obound->Lo() - mbound->Hi();
-    higher = mbound->Lo() - obound->Hi();
+    lower = (ElemType) obound->Lo() - (ElemType) mbound->Hi();
+    higher = (ElemType) mbound->Lo() - (ElemType) obound->Hi();
     // We invoke the following:
     //   x + fabs(x) = max(x * 2, 0)
     //   (x * 2)^2 / 4 = x^2
@@ -315,9 +319,9 @@ ElemType HRectBound<DistanceType, ElemType>::MinDistance(
 /**
  * Calculates maximum bound-to-point squared distance.
  */
-template<typename DistanceType, typename ElemType>
+template<typename DistanceType, typename ElemType, typename BoundElemType>
 template<typename VecType>
-inline ElemType HRectBound<DistanceType, ElemType>::MaxDistance(
+inline ElemType HRectBound<DistanceType, ElemType, BoundElemType>::MaxDistance(
     const VecType& point,
     typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
 {
@@ -327,8 +331,8 @@ inline ElemType HRectBound<DistanceType, ElemType>::MaxDistance(
 
   for (size_t d = 0; d < dim; d++)
   {
-    ElemType v = std::max(fabs(point[d] - bounds[d].Lo()),
-        fabs(bounds[d].Hi() - point[d]));
+    ElemType v = std::max(fabs(point[d] - (ElemType) bounds[d].Lo()),
+        fabs((ElemType) bounds[d].Hi() - point[d]));
 
     // The compiler should optimize out this if statement entirely.
     if (DistanceType::Power == 1)
@@ -357,8 +361,8 @@ inline ElemType HRectBound<DistanceType, ElemType>::MaxDistance(
 /**
  * Computes maximum distance.
  */
-template<typename DistanceType, typename ElemType>
-inline ElemType HRectBound<DistanceType, ElemType>::MaxDistance(
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline ElemType HRectBound<DistanceType, ElemType, BoundElemType>::MaxDistance(
     const HRectBound& other)
     const
 {
@@ -369,8 +373,9 @@ inline ElemType HRectBound<DistanceType, ElemType>::MaxDistance(
   ElemType v;
   for (size_t d = 0; d < dim; d++)
   {
-    v = std::max(fabs(other.bounds[d].Hi() - bounds[d].Lo()),
-        fabs(bounds[d].Hi() - other.bounds[d].Lo()));
+    v = std::max(
+        fabs((ElemType) other.bounds[d].Hi() - (ElemType) bounds[d].Lo()),
+        fabs((ElemType) bounds[d].Hi() - (ElemType) other.bounds[d].Lo()));
 
     // The compiler should optimize out this if statement entirely.
     if (DistanceType::Power == 1)
@@ -399,9 +404,9 @@ inline ElemType HRectBound<DistanceType, ElemType>::MaxDistance(
 /**
  * Calculates minimum and maximum bound-to-bound squared distance.
  */
-template<typename DistanceType, typename ElemType>
+template<typename DistanceType, typename ElemType, typename BoundElemType>
 inline RangeType<ElemType>
-HRectBound<DistanceType, ElemType>::RangeDistance(
+HRectBound<DistanceType, ElemType, BoundElemType>::RangeDistance(
     const HRectBound& other) const
 {
   ElemType loSum = 0;
@@ -412,8 +417,8 @@ HRectBound<DistanceType, ElemType>::RangeDistance(
   ElemType v1, v2, vLo, vHi;
   for (size_t d = 0; d < dim; d++)
   {
-    v1 = other.bounds[d].Lo() - bounds[d].Hi();
-    v2 = bounds[d].Lo() - other.bounds[d].Hi();
+    v1 = (ElemType) other.bounds[d].Lo() - (ElemType) bounds[d].Hi();
+    v2 = (ElemType) bounds[d].Lo() - (ElemType) other.bounds[d].Hi();
     // One of v1 or v2 is negative.
     if (v1 >= v2)
     {
@@ -469,10 +474,10 @@ HRectBound<DistanceType, ElemType>::RangeDistance(
 /**
  * Calculates minimum and maximum bound-to-point squared distance.
  */
-template<typename DistanceType, typename ElemType>
+template<typename DistanceType, typename ElemType, typename BoundElemType>
 template<typename VecType>
 inline RangeType<ElemType>
-HRectBound<DistanceType, ElemType>::RangeDistance(
+HRectBound<DistanceType, ElemType, BoundElemType>::RangeDistance(
     const VecType& point,
     typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
 {
@@ -484,8 +489,10 @@ HRectBound<DistanceType, ElemType>::RangeDistance(
   ElemType v1, v2, vLo, vHi;
   for (size_t d = 0; d < dim; d++)
   {
-    v1 = bounds[d].Lo() - point[d]; // Negative if point[d] > lo.
-    v2 = point[d] - bounds[d].Hi(); // Negative if point[d] < hi.
+    // Negative if point[d] > lo.
+    v1 = (ElemType) bounds[d].Lo() - point[d];
+    // Negative if point[d] < hi.
+    v2 = point[d] - (ElemType) bounds[d].Hi();
     // One of v1 or v2 (or both) is negative.
     if (v1 >= 0) // point[d] <= bounds_[d].Lo().
     {
@@ -547,10 +554,11 @@ HRectBound<DistanceType, ElemType>::RangeDistance(
 /**
  * Expands this region to include a new point.
  */
-template<typename DistanceType, typename ElemType>
+template<typename DistanceType, typename ElemType, typename BoundElemType>
 template<typename MatType>
-inline HRectBound<DistanceType, ElemType>&
-HRectBound<DistanceType, ElemType>::operator|=(const MatType& data)
+inline HRectBound<DistanceType, ElemType, BoundElemType>&
+HRectBound<DistanceType, ElemType, BoundElemType>::operator|=(
+    const MatType& data)
 {
   Log::Assert(data.n_rows == dim);
 
@@ -560,8 +568,11 @@ HRectBound<DistanceType, ElemType>::operator|=(const MatType& data)
   minWidth = std::numeric_limits<ElemType>::max();
   for (size_t i = 0; i < dim; ++i)
   {
-    bounds[i] |= RangeType<ElemType>(mins[i], maxs[i]);
-    const ElemType width = bounds[i].Width();
+    // Compact bounds are rounded outwards, so that they still contain the
+    // points.
+    bounds[i] |= RangeType<BoundElemType>(RoundDown(mins[i]),
+        RoundUp(maxs[i]));
+    const ElemType width = Width(i);
     if (width < minWidth)
       minWidth = width;
   }
@@ -572,9 +583,10 @@ HRectBound<DistanceType, ElemType>::operator|=(const MatType& data)
 /**
  * Expands this region to encompass another bound.
  */
-template<typename DistanceType, typename ElemType>
-inline HRectBound<DistanceType, ElemType>&
-HRectBound<DistanceType, ElemType>::operator|=(const HRectBound& other)
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline HRectBound<DistanceType, ElemType, BoundElemType>&
+HRectBound<DistanceType, ElemType, BoundElemType>::operator|=(
+    const HRectBound& other)
 {
   assert(other.dim == dim);
 
@@ -582,7 +594,7 @@ HRectBound<DistanceType, ElemType>::operator|=(const HRectBound& other)
   for (size_t i = 0; i < dim; ++i)
   {
     bounds[i] |= other.bounds[i];
-    const ElemType width = bounds[i].Width();
+    const ElemType width = Width(i);
     if (width < minWidth)
       minWidth = width;
   }
@@ -593,14 +605,17 @@ HRectBound<DistanceType, ElemType>::operator|=(const HRectBound& other)
 /**
  * Determines if a point is within this bound.
  */
-template<typename DistanceType, typename ElemType>
+template<typename DistanceType, typename ElemType, typename BoundElemType>
 template<typename VecType>
-inline bool HRectBound<DistanceType, ElemType>::Contains(
+inline bool HRectBound<DistanceType, ElemType, BoundElemType>::Contains(
     const VecType& point) const
 {
   for (size_t i = 0; i < point.n_elem; ++i)
   {
-    if (!bounds[i].Contains(point(i)))
+    // Compare in ElemType, so that the point is not rounded to the type of
+    // compact bounds.
+    if (point(i) < (ElemType) bounds[i].Lo() ||
+        point(i) > (ElemType) bounds[i].Hi())
       return false;
   }
 
@@ -610,14 +625,14 @@ inline bool HRectBound<DistanceType, ElemType>::Contains(
 /**
  * Determines if this bound partially contains a bound.
  */
-template<typename DistanceType, typename ElemType>
-inline bool HRectBound<DistanceType, ElemType>::Contains(
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline bool HRectBound<DistanceType, ElemType, BoundElemType>::Contains(
     const HRectBound& bound) const
 {
   for (size_t i = 0; i < dim; ++i)
   {
-    const RangeType<ElemType>& r_a = bounds[i];
-    const RangeType<ElemType>& r_b = bound.bounds[i];
+    const RangeType<BoundElemType>& r_a = bounds[i];
+    const RangeType<BoundElemType>& r_b = bound.bounds[i];
 
     // If a does not overlap b at all.
     if (r_a.Hi() <= r_b.Lo() || r_a.Lo() >= r_b.Hi())
@@ -630,11 +645,12 @@ inline bool HRectBound<DistanceType, ElemType>::Contains(
 /**
  * Returns the intersection of this bound and another.
  */
-template<typename DistanceType, typename ElemType>
-inline HRectBound<DistanceType, ElemType>
-HRectBound<DistanceType, ElemType>::operator&(const HRectBound& bound) const
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline HRectBound<DistanceType, ElemType, BoundElemType>
+HRectBound<DistanceType, ElemType, BoundElemType>::operator&(
+    const HRectBound& bound) const
 {
-  HRectBound<DistanceType, ElemType> result(dim);
+  HRectBound result(dim);
 
   for (size_t k = 0; k < dim; ++k)
   {
@@ -647,9 +663,10 @@ HRectBound<DistanceType, ElemType>::operator&(const HRectBound& bound) const
 /**
  * Intersects this bound with another.
  */
-template<typename DistanceType, typename ElemType>
-inline HRectBound<DistanceType, ElemType>&
-HRectBound<DistanceType, ElemType>::operator&=(const HRectBound& bound)
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline HRectBound<DistanceType, ElemType, BoundElemType>&
+HRectBound<DistanceType, ElemType, BoundElemType>::operator&=(
+    const HRectBound& bound)
 {
   for (size_t k = 0; k < dim; ++k)
   {
@@ -662,8 +679,8 @@ HRectBound<DistanceType, ElemType>::operator&=(const HRectBound& bound)
 /**
  * Returns the volume of overlap of this bound and another.
  */
-template<typename DistanceType, typename ElemType>
-inline ElemType HRectBound<DistanceType, ElemType>::Overlap(
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline ElemType HRectBound<DistanceType, ElemType, BoundElemType>::Overlap(
     const HRectBound& bound) const
 {
   ElemType volume = 1.0;
@@ -684,12 +701,13 @@ inline ElemType HRectBound<DistanceType, ElemType>::Overlap(
 /**
  * Returns the diameter of the hyperrectangle (that is, the longest diagonal).
  */
-template<typename DistanceType, typename ElemType>
-inline ElemType HRectBound<DistanceType, ElemType>::Diameter() const
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline ElemType
+HRectBound<DistanceType, ElemType, BoundElemType>::Diameter() const
 {
   ElemType d = 0;
   for (size_t i = 0; i < dim; ++i)
-    d += std::pow(bounds[i].Hi() - bounds[i].Lo(),
+    d += std::pow((ElemType) bounds[i].Hi() - (ElemType) bounds[i].Lo(),
         (ElemType) DistanceType::Power);
 
   if (DistanceType::TakeRoot)
@@ -698,10 +716,62 @@ inline ElemType HRectBound<DistanceType, ElemType>::Diameter() const
     return d;
 }
 
+/**
+ * Return the largest value of BoundElemType that is not greater than x.
+ */
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline BoundElemType
+HRectBound<DistanceType, ElemType, BoundElemType>::RoundDown(const ElemType x)
+{
+  if constexpr (std::is_same_v<ElemType, BoundElemType>)
+  {
+    return x;
+  }
+  else
+  {
+    // Values outside of the range of BoundElemType go to the largest value or
+    // to -infinity.
+    if (x > (ElemType) std::numeric_limits<BoundElemType>::max())
+      return std::numeric_limits<BoundElemType>::max();
+    else if (x < (ElemType) std::numeric_limits<BoundElemType>::lowest())
+      return -std::numeric_limits<BoundElemType>::infinity();
+
+    BoundElemType r = (BoundElemType) x;
+    if ((ElemType) r > x)
+      r = std::nextafter(r, -std::numeric_limits<BoundElemType>::infinity());
+    return r;
+  }
+}
+
+/**
+ * Return the smallest value of BoundElemType that is not less than x.
+ */
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+inline BoundElemType
+HRectBound<DistanceType, ElemType, BoundElemType>::RoundUp(const ElemType x)
+{
+  if constexpr (std::is_same_v<ElemType, BoundElemType>)
+  {
+    return x;
+  }
+  else
+  {
+    if (x < (ElemType) std::numeric_limits<BoundElemType>::lowest())
+      return std::numeric_limits<BoundElemType>::lowest();
+    else if (x > (ElemType) std::numeric_limits<BoundElemType>::max())
+      return std::numeric_limits<BoundElemType>::infinity();
+
+    BoundElemType r = (BoundElemType) x;
+    if ((ElemType) r < x)
+      r = std::nextafter(r, std::numeric_limits<BoundElemType>::infinity());
+    return r;
+  }
+}
+
 //! Serialize the bound object.
-template<typename DistanceType, typename ElemType>
+template<typename DistanceType, typename ElemType, typename BoundElemType>
 template<typename Archive>
-void HRectBound<DistanceType, ElemType>::serialize(
+void HRectBound<DistanceType, ElemType, BoundElemType>::serialize(
     Archive& ar,
     const uint32_t /* version */)
 {
@@ -18,6 +18,29 @@
 
 namespace mlpack {
 
+/**
+ * The ways an Octree can be built.  Both give the same tree: the same nodes,
+ * holding the same points, with the same bounds; only the order of the points
+ * inside each leaf may differ.
+ */
+enum OctreeBuild
+{
+  /**
+   * Each node partitions its points around its center, from the root down.
+   */
+  TOP_DOWN_OCTREE_BUILD,
+  /**
+   * The points are sorted once by their Morton code (the interleaved indices of
+   * the children that hold them at each level), so that each node holds a
+   * contiguous run of the sorted points; then the nodes are built from the runs,
+   * and the bound of each node is computed from the bounds of its children.
+   * This takes linear time, instead of one pass over the points per level.
+   * With d dimensions, Morton codes describe floor(64 / d) levels; deeper
+   * nodes are built top-down.
+   */
+  MORTON_OCTREE_BUILD
+};
+
 template<typename DistanceType = EuclideanDistance,
          typename StatisticType = EmptyStatistic,
          typename MatType = arma::mat>
@@ -37,6 +60,11 @@ class Octree
   template<typename RuleType>
   class DualTreeTraverser;
 
+  //! A dual-tree traverser that traverses independent query subtrees in
+  //! parallel; see parallel_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  class ParallelDualTreeTraverser;
+
  private:
   //! The children held by this node.
   std::vector<Octree*> children;
@@ -156,6 +184,64 @@ class Octree
          std::vector<size_t>& newFromOld,
          const size_t maxLeafSize = 20);
 
+  /**
+   * Construct this as the root node of an octree on the given dataset, with
+   * the given build strategy.  This copies the dataset.
+   *
+   * @param data Dataset to create tree from.  This will be copied!
+   * @param build Build strategy (TOP_DOWN_OCTREE_BUILD or MORTON_OCTREE_BUILD).
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(const MatType& data,
+         const OctreeBuild build,
+         const size_t maxLeafSize = 20);
+
+  /**
+   * Construct this as the root node of an octree on the given dataset, with
+   * the given build strategy.  This copies the dataset and modifies its
+   * ordering; a mapping of the old point indices to the new point indices is
+   * filled.
+   *
+   * @param data Dataset to create tree from.  This will be copied!
+   * @param oldFromNew Vector which will be filled with the old positions for
+   *      each new point.
+   * @param build Build strategy (TOP_DOWN_OCTREE_BUILD or MORTON_OCTREE_BUILD).
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(const MatType& data,
+         std::vector<size_t>& oldFromNew,
+         const OctreeBuild build,
+         const size_t maxLeafSize = 20);
+
+  /**
+   * Construct this as the root node of an octree on the given dataset, with
+   * the given build strategy.  This will take ownership of the dataset.
+   *
+   * @param data Dataset to create tree from.
+   * @param build Build strategy (TOP_DOWN_OCTREE_BUILD or MORTON_OCTREE_BUILD).
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(MatType&& data,
+         const OctreeBuild build,
+         const size_t maxLeafSize = 20);
+
+  /**
+   * Construct this as the root node of an octree on the given dataset, with
+   * the given build strategy.  This will take ownership of the dataset and
+   * modifies its ordering; a mapping of the old point indices to the new point
+   * indices is filled.
+   *
+   * @param data Dataset to create tree from.
+   * @param oldFromNew Vector which will be filled with the old positions for
+   *      each new point.
+   * @param build Build strategy (TOP_DOWN_OCTREE_BUILD or MORTON_OCTREE_BUILD).
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(MatType&& data,
+         std::vector<size_t>& oldFromNew,
+         const OctreeBuild build,
+         const size_t maxLeafSize = 20);
+
   /**
    * Construct this node as a child of the given parent, starting at column
    * begin and using count points.  The ordering of that subset of points in the
@@ -399,6 +485,10 @@ class Octree
   //! Store the center of the bounding region in the given vector.
   void Center(arma::vec& center) const { bound.Center(center); }
 
+  //! Nodes with at least this many points have their children built in
+  //! parallel, if OpenMP is enabled.
+  static const size_t ParallelBuildMinPoints = 20000;
+
   //! Serialize the tree.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -442,6 +532,121 @@ class Octree
                  std::vector<size_t>& oldFromNew,
                  const size_t maxLeafSize);
 
+  /**
+   * Construct this node as a child of the given parent, holding the points
+   * starting at column begin, which are sorted by their Morton codes, and build
+   * its subtree with MortonSplitNode().  The parent distance and the statistic
+   * are set by the parent, once its bound is known.
+   *
+   * @param parent Parent of this node.
+   * @param begin Index of point to start tree construction with.
+   * @param count Number of points to use to construct tree.
+   * @param codes Morton codes of all points of the dataset.
+   * @param level Level of this node (the root is at level 0).
+   * @param levels Number of levels described by the Morton codes.
+   * @param center Center of the node (for splitting).
+   * @param width Width of the node in each dimension.
+   * @param oldFromNew Mappings from old to new, or NULL.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(Octree* parent,
+         const size_t begin,
+         const size_t count,
+         const std::vector<uint64_t>& codes,
+         const size_t level,
+         const size_t levels,
+         const arma::vec& center,
+         const double width,
+         std::vector<size_t>* oldFromNew,
+         const size_t maxLeafSize);
+
+  /**
+   * Build the tree below this root node, whose bound is already computed, with
+   * the given strategy, and initialize the statistic.
+   *
+   * @param oldFromNew Mappings from old to new (already filled with the
+   *      identity), or NULL.
+   * @param build Build strategy.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void BuildRoot(std::vector<size_t>* oldFromNew,
+                 const OctreeBuild build,
+                 const size_t maxLeafSize);
+
+  /**
+   * Sort the points of this root node by their Morton code, and build the tree
+   * below it from the sorted points.
+   *
+   * @param center Center of the node.
+   * @param width Width of the node.
+   * @param oldFromNew Mappings from old to new, or NULL.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void MortonBuild(const arma::vec& center,
+                   const double width,
+                   std::vector<size_t>* oldFromNew,
+                   const size_t maxLeafSize);
+
+  /**
+   * Split the node, whose points are sorted by their Morton code, into the runs
+   * of points with the same code at the given level, and compute the bound of
+   * the node from the bounds of its children.
+   *
+   * @param codes Morton codes of all points of the dataset.
+   * @param level Level of this node (the root is at level 0).
+   * @param levels Number of levels described by the Morton codes.
+   * @param center Center of the node.
+   * @param width Width of the node.
+   * @param oldFromNew Mappings from old to new, or NULL.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void MortonSplitNode(const std::vector<uint64_t>& codes,
+                       const size_t level,
+                       const size_t levels,
+                       const arma::vec& center,
+                       const double width,
+                       std::vector<size_t>* oldFromNew,
+                       const size_t maxLeafSize);
+
+  /**
+   * Create the children of this node, given the first point of each child
+   * (empty children are not created).  If the node holds at least
+   * ParallelBuildMinPoints points, the children are built as parallel OpenMP
+   * tasks.  If codes is not NULL, the children are built from the Morton codes
+   * with the given level.
+   *
+   * @param childBegins Index of the first point of each child, followed by the
+   *      index past the last point of the last child.
+   * @param center Center of the node.
+   * @param width Width of the node.
+   * @param oldFromNew Mappings from old to new, or NULL.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   * @param codes Morton codes of all points of the dataset, or NULL.
+   * @param level Level of the children.
+   * @param levels Number of levels described by the Morton codes.
+   */
+  void BuildChildren(const arma::Col<size_t>& childBegins,
+                     const arma::vec& center,
+                     const double width,
+                     std::vector<size_t>* oldFromNew,
+                     const size_t maxLeafSize,
+                     const std::vector<uint64_t>* codes = NULL,
+                     const size_t level = 0,
+                     const size_t levels = 0);
+
+  /**
+   * Return the Morton code of the given point: the index of the child that
+   * holds the point at each of the given number of levels below a node with the
+   * given center and width, with the first level in the most significant bits.
+   * The centers of the children are computed exactly like in SplitNode(), so
+   * the point is assigned to the same children.
+   */
+  template<typename VecType>
+  static uint64_t MortonCode(const VecType& point,
+                             const arma::vec& center,
+                             const double width,
+                             const size_t levels);
+
   /**
    * This is used for sorting points while splitting.
    */
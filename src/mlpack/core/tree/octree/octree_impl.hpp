@@ -16,6 +16,10 @@
 #include <mlpack/core/tree/perform_split.hpp>
 #include <stack>
 
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 
 //! Construct the tree.
@@ -339,6 +343,121 @@ Octree<DistanceType, StatisticType, MatType>::Octree(
   stat = StatisticType(*this);
 }
 
+//! Construct the tree with the given build strategy.
+template<typename DistanceType, typename StatisticType, typename MatType>
+Octree<DistanceType, StatisticType, MatType>::Octree(
+    const MatType& dataset,
+    const OctreeBuild build,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(dataset)),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  BuildRoot(NULL, build, maxLeafSize);
+}
+
+//! Construct the tree with the given build strategy.
+template<typename DistanceType, typename StatisticType, typename MatType>
+Octree<DistanceType, StatisticType, MatType>::Octree(
+    const MatType& dataset,
+    std::vector<size_t>& oldFromNew,
+    const OctreeBuild build,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(dataset)),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  oldFromNew.resize(this->dataset->n_cols);
+  for (size_t i = 0; i < this->dataset->n_cols; ++i)
+    oldFromNew[i] = i;
+
+  BuildRoot(&oldFromNew, build, maxLeafSize);
+}
+
+//! Construct the tree with the given build strategy.
+template<typename DistanceType, typename StatisticType, typename MatType>
+Octree<DistanceType, StatisticType, MatType>::Octree(
+    MatType&& dataset,
+    const OctreeBuild build,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(std::move(dataset))),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  BuildRoot(NULL, build, maxLeafSize);
+}
+
+//! Construct the tree with the given build strategy.
+template<typename DistanceType, typename StatisticType, typename MatType>
+Octree<DistanceType, StatisticType, MatType>::Octree(
+    MatType&& dataset,
+    std::vector<size_t>& oldFromNew,
+    const OctreeBuild build,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(std::move(dataset))),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  oldFromNew.resize(this->dataset->n_cols);
+  for (size_t i = 0; i < this->dataset->n_cols; ++i)
+    oldFromNew[i] = i;
+
+  BuildRoot(&oldFromNew, build, maxLeafSize);
+}
+
+//! Construct a child node from points sorted by Morton code.
+template<typename DistanceType, typename StatisticType, typename MatType>
+Octree<DistanceType, StatisticType, MatType>::Octree(
+    Octree* parent,
+    const size_t begin,
+    const size_t count,
+    const std::vector<uint64_t>& codes,
+    const size_t level,
+    const size_t levels,
+    const arma::vec& center,
+    const double width,
+    std::vector<size_t>* oldFromNew,
+    const size_t maxLeafSize) :
+    begin(begin),
+    count(count),
+    bound(parent->dataset->n_rows),
+    dataset(parent->dataset),
+    parent(parent),
+    parentDistance(0.0)
+{
+  if (count > maxLeafSize && level < levels)
+  {
+    // The bound is computed from the children.
+    MortonSplitNode(codes, level, levels, center, width, oldFromNew,
+        maxLeafSize);
+  }
+  else
+  {
+    bound |= dataset->cols(begin, begin + count - 1);
+
+    // If the Morton codes don't describe this level, we have to continue
+    // top-down.
+    if (oldFromNew == NULL)
+      SplitNode(center, width, maxLeafSize);
+    else
+      SplitNode(center, width, *oldFromNew, maxLeafSize);
+  }
+
+  furthestDescendantDistance = 0.5 * bound.Diameter();
+}
+
 //! Copy the given tree.
 template<typename DistanceType, typename StatisticType, typename MatType>
 Octree<DistanceType, StatisticType, MatType>::Octree(const Octree& other) :
@@ -845,28 +964,7 @@ void Octree<DistanceType, StatisticType, MatType>::SplitNode(
   }
 
   // Now that the dataset is reordered, we can create the children.
-  arma::vec childCenter(center.n_elem);
-  const double childWidth = width / 2.0;
-  for (size_t i = 0; i < childBegins.n_elem - 1; ++i)
-  {
-    // If the child has no points, don't create it.
-    if (childBegins[i + 1] - childBegins[i] == 0)
-      continue;
-
-    // Create the correct center.
-    for (size_t d = 0; d < center.n_elem; ++d)
-    {
-      // Is the dimension "right" (1) or "left" (0)?
-      if (((i >> d) & 1) == 0)
-        childCenter[d] = center[d] - childWidth;
-      else
-        childCenter[d] = center[d] + childWidth;
-    }
-
-    children.push_back(new Octree(this, childBegins[i],
-        childBegins[i + 1] - childBegins[i], childCenter, childWidth,
-        maxLeafSize));
-  }
+  BuildChildren(childBegins, center, width, NULL, maxLeafSize);
 }
 
 //! Split the node, and store mappings.
@@ -947,28 +1045,300 @@ void Octree<DistanceType, StatisticType, MatType>::SplitNode(
   }
 
   // Now that the dataset is reordered, we can create the children.
-  arma::vec childCenter(center.n_elem);
-  const double childWidth = width / 2.0;
+  BuildChildren(childBegins, center, width, &oldFromNew, maxLeafSize);
+}
+
+//! Build the tree below the root.
+template<typename DistanceType, typename StatisticType, typename MatType>
+void Octree<DistanceType, StatisticType, MatType>::BuildRoot(
+    std::vector<size_t>* oldFromNew,
+    const OctreeBuild build,
+    const size_t maxLeafSize)
+{
+  if (count > 0)
+  {
+    // Calculate empirical center of data.
+    bound |= *dataset;
+    arma::vec center;
+    bound.Center(center);
+
+    double maxWidth = 0.0;
+    for (size_t i = 0; i < bound.Dim(); ++i)
+      if (bound[i].Hi() - bound[i].Lo() > maxWidth)
+        maxWidth = bound[i].Hi() - bound[i].Lo();
+
+    if (build == MORTON_OCTREE_BUILD)
+      MortonBuild(center, maxWidth, oldFromNew, maxLeafSize);
+    else if (oldFromNew == NULL)
+      SplitNode(center, maxWidth, maxLeafSize);
+    else
+      SplitNode(center, maxWidth, *oldFromNew, maxLeafSize);
+
+    furthestDescendantDistance = 0.5 * bound.Diameter();
+  }
+  else
+  {
+    furthestDescendantDistance = 0.0;
+  }
+
+  // Initialize the statistic.
+  stat = StatisticType(*this);
+}
+
+//! Sort the points by Morton code and build the tree from them.
+template<typename DistanceType, typename StatisticType, typename MatType>
+void Octree<DistanceType, StatisticType, MatType>::MortonBuild(
+    const arma::vec& center,
+    const double width,
+    std::vector<size_t>* oldFromNew,
+    const size_t maxLeafSize)
+{
+  if (count <= maxLeafSize)
+    return;
+
+  // Each level takes one bit per dimension; if a single level does not fit in
+  // a code, the tree can only be built top-down.
+  const size_t dims = dataset->n_rows;
+  const size_t levels = (dims < 64) ? 64 / dims : 0;
+  if (levels == 0)
+  {
+    if (oldFromNew == NULL)
+      SplitNode(center, width, maxLeafSize);
+    else
+      SplitNode(center, width, *oldFromNew, maxLeafSize);
+    return;
+  }
+
+  std::vector<uint64_t> codes(count);
+  #pragma omp parallel for schedule(static) \
+      if (count >= ParallelBuildMinPoints)
+  for (size_t i = 0; i < count; ++i)
+    codes[i] = MortonCode(dataset->col(i), center, width, levels);
+
+  // Sort the points by code with a least significant digit radix sort, one
+  // byte at a time, over the bits that are used.
+  std::vector<size_t> order(count);
+  for (size_t i = 0; i < count; ++i)
+    order[i] = i;
+
+  std::vector<uint64_t> sortedCodes(count);
+  std::vector<size_t> sortedOrder(count);
+  const size_t passes = (levels * dims + 7) / 8;
+  for (size_t p = 0; p < passes; ++p)
+  {
+    const size_t shift = 8 * p;
+    std::array<size_t, 257> offsets;
+    offsets.fill(0);
+    for (size_t i = 0; i < count; ++i)
+      ++offsets[((codes[i] >> shift) & 0xFF) + 1];
+    for (size_t b = 1; b < offsets.size(); ++b)
+      offsets[b] += offsets[b - 1];
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      const size_t j = offsets[(codes[i] >> shift) & 0xFF]++;
+      sortedCodes[j] = codes[i];
+      sortedOrder[j] = order[i];
+    }
+
+    codes.swap(sortedCodes);
+    order.swap(sortedOrder);
+  }
+
+  // Now move the points to their position in place, one cycle of the
+  // permutation at a time, so that the dataset is not copied.
+  std::vector<bool> placed(count, false);
+  for (size_t i = 0; i < count; ++i)
+  {
+    size_t j = i;
+    while (!placed[j])
+    {
+      placed[j] = true;
+      if (order[j] == i)
+        break;
+
+      dataset->swap_cols(j, order[j]);
+      j = order[j];
+    }
+  }
+
+  if (oldFromNew != NULL)
+  {
+    const std::vector<size_t> oldMappings(*oldFromNew);
+    for (size_t i = 0; i < count; ++i)
+      (*oldFromNew)[i] = oldMappings[order[i]];
+  }
+
+  MortonSplitNode(codes, 0, levels, center, width, oldFromNew, maxLeafSize);
+}
+
+//! Split a node whose points are sorted by Morton code.
+template<typename DistanceType, typename StatisticType, typename MatType>
+void Octree<DistanceType, StatisticType, MatType>::MortonSplitNode(
+    const std::vector<uint64_t>& codes,
+    const size_t level,
+    const size_t levels,
+    const arma::vec& center,
+    const double width,
+    std::vector<size_t>* oldFromNew,
+    const size_t maxLeafSize)
+{
+  // The points of the node all have the same code up to this level, so the
+  // points of each child are the run of points with the same index at this
+  // level.
+  const size_t dims = dataset->n_rows;
+  const size_t shift = (levels - level - 1) * dims;
+  const uint64_t mask = (((uint64_t) 1) << dims) - 1;
+  auto childIndex = [&](const uint64_t code) { return (code >> shift) & mask; };
+
+  arma::Col<size_t> childBegins(((size_t) 1 << dims) + 1);
+  childBegins[childBegins.n_elem - 1] = begin + count;
+  size_t childBegin = begin;
+  for (size_t c = 0; c < childBegins.n_elem - 1; ++c)
+  {
+    childBegins[c] = childBegin;
+    childBegin = std::upper_bound(codes.begin() + childBegin,
+        codes.begin() + begin + count, (uint64_t) c,
+        [&](const uint64_t index, const uint64_t code)
+        { return index < childIndex(code); }) - codes.begin();
+  }
+
+  BuildChildren(childBegins, center, width, oldFromNew, maxLeafSize, &codes,
+      level + 1, levels);
+
+  // Now that the children are built, we can compute the bound, and then the
+  // parent distances and statistics of the children.
+  for (size_t i = 0; i < children.size(); ++i)
+    bound |= children[i]->Bound();
+
+  arma::vec trueCenter, childCenter;
+  bound.Center(trueCenter);
+  for (size_t i = 0; i < children.size(); ++i)
+  {
+    children[i]->Bound().Center(childCenter);
+    children[i]->parentDistance = distance.Evaluate(childCenter, trueCenter);
+    children[i]->stat = StatisticType(*children[i]);
+  }
+}
+
+//! Create the children of a node.
+template<typename DistanceType, typename StatisticType, typename MatType>
+void Octree<DistanceType, StatisticType, MatType>::BuildChildren(
+    const arma::Col<size_t>& childBegins,
+    const arma::vec& center,
+    const double width,
+    std::vector<size_t>* oldFromNew,
+    const size_t maxLeafSize,
+    const std::vector<uint64_t>* codes,
+    const size_t level,
+    const size_t levels)
+{
+  const bool parallel = (count >= ParallelBuildMinPoints);
+
+  #ifdef MLPACK_USE_OPENMP
+  if (parallel && !omp_in_parallel())
+  {
+    // Start the threads that the tasks of the whole subtree will run on.
+    #pragma omp parallel
+    {
+      #pragma omp single
+      BuildChildren(childBegins, center, width, oldFromNew, maxLeafSize, codes,
+          level, levels);
+    }
+    return;
+  }
+  #endif
+
+  // If a child has no points, don't create it.
+  std::vector<size_t> childIndices;
   for (size_t i = 0; i < childBegins.n_elem - 1; ++i)
+    if (childBegins[i + 1] - childBegins[i] > 0)
+      childIndices.push_back(i);
+
+  // Each child only modifies its own columns of the dataset (and its own
+  // elements of oldFromNew), so all of them can be built at the same time.
+  children.resize(childIndices.size(), NULL);
+  const double childWidth = width / 2.0;
+  for (size_t c = 0; c < childIndices.size(); ++c)
   {
-    // If the child has no points, don't create it.
-    if (childBegins[i + 1] - childBegins[i] == 0)
-      continue;
+    #pragma omp task if (parallel) shared(childBegins, center, childIndices)
+    {
+      const size_t i = childIndices[c];
+      const size_t childBegin = childBegins[i];
+      const size_t childCount = childBegins[i + 1] - childBegins[i];
 
-    // Create the correct center.
+      // Create the correct center.
+      arma::vec childCenter(center.n_elem);
+      for (size_t d = 0; d < center.n_elem; ++d)
+      {
+        // Is the dimension "right" (1) or "left" (0)?
+        if (((i >> d) & 1) == 0)
+          childCenter[d] = center[d] - childWidth;
+        else
+          childCenter[d] = center[d] + childWidth;
+      }
+
+      if (codes != NULL)
+      {
+        children[c] = new Octree(this, childBegin, childCount, *codes, level,
+            levels, childCenter, childWidth, oldFromNew, maxLeafSize);
+      }
+      else if (oldFromNew == NULL)
+      {
+        children[c] = new Octree(this, childBegin, childCount, childCenter,
+            childWidth, maxLeafSize);
+      }
+      else
+      {
+        children[c] = new Octree(this, childBegin, childCount, *oldFromNew,
+            childCenter, childWidth, maxLeafSize);
+      }
+    }
+  }
+
+  #pragma omp taskwait
+}
+
+//! Compute the Morton code of a point.
+template<typename DistanceType, typename StatisticType, typename MatType>
+template<typename VecType>
+uint64_t Octree<DistanceType, StatisticType, MatType>::MortonCode(
+    const VecType& point,
+    const arma::vec& center,
+    const double width,
+    const size_t levels)
+{
+  // Codes are only computed for fewer than 64 dimensions, so the center fits on
+  // the stack.
+  std::array<double, 64> nodeCenter;
+  for (size_t d = 0; d < center.n_elem; ++d)
+    nodeCenter[d] = center[d];
+
+  double nodeWidth = width;
+  uint64_t code = 0;
+  for (size_t l = 0; l < levels; ++l)
+  {
+    const double childWidth = nodeWidth / 2.0;
+    uint64_t childIndex = 0;
     for (size_t d = 0; d < center.n_elem; ++d)
     {
-      // Is the dimension "right" (1) or "left" (0)?
-      if (((i >> d) & 1) == 0)
-        childCenter[d] = center[d] - childWidth;
+      // This is the test of SplitType::AssignToLeftNode().
+      if (point[d] < nodeCenter[d])
+      {
+        nodeCenter[d] -= childWidth;
+      }
       else
-        childCenter[d] = center[d] + childWidth;
+      {
+        childIndex |= ((uint64_t) 1 << d);
+        nodeCenter[d] += childWidth;
+      }
     }
 
-    children.push_back(new Octree(this, childBegins[i],
-        childBegins[i + 1] - childBegins[i], oldFromNew, childCenter,
-        childWidth, maxLeafSize));
+    code = (code << center.n_elem) | childIndex;
+    nodeWidth = childWidth;
   }
+
+  return code;
 }
 
 } // namespace mlpack
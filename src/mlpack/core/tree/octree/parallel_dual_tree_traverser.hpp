@@ -0,0 +1,107 @@
+/**
+ * @file core/tree/octree/parallel_dual_tree_traverser.hpp
+ *
+ * Defines the ParallelDualTreeTraverser for the Octree tree type.  This is a
+ * nested class of Octree which splits the query tree into a set of independent
+ * subtrees and traverses each of them against the reference tree in parallel
+ * with OpenMP, using the regular DualTreeTraverser for each subtree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_OCTREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_OCTREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "octree.hpp"
+
+namespace mlpack {
+
+/**
+ * The ParallelDualTreeTraverser is a drop-in replacement for the
+ * DualTreeTraverser of an Octree.  The top of the query tree is expanded
+ * (serially) until there are enough independent query subtrees to keep all
+ * OpenMP threads busy; then, each of those subtrees is traversed against the
+ * reference node by its own DualTreeTraverser.
+ *
+ * As for BinarySpaceTree::ParallelDualTreeTraverser, the RuleType must be
+ * copy-constructible, copies of a RuleType object must share their results
+ * with the object they were copied from, and the RuleType must provide
+ * modifiable BaseCases() and Scores() accessors.
+ *
+ * If mlpack is compiled without OpenMP, this performs the same traversal as
+ * the DualTreeTraverser.
+ */
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType>
+template<typename RuleType>
+class Octree<DistanceType, StatisticType, MatType>::ParallelDualTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the parallel dual-tree traverser with the given rule set.
+   *
+   * @param rule Rule set to use for the traversal.
+   * @param minTasks Minimum number of query subtrees to create before starting
+   *     the parallel traversal.  If 0, four times the number of OpenMP threads
+   *     will be used.
+   */
+  ParallelDualTreeTraverser(RuleType& rule, const size_t minTasks = 0);
+
+  /**
+   * Traverse the two trees.  This does not reset the statistics of the
+   * traversals (it just adds to them).
+   */
+  void Traverse(Octree& queryNode, Octree& referenceNode);
+
+  //! Get the number of pruned nodes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of pruned nodes (i.e. to reset it).
+  size_t& NumPrunes() { return numPrunes; }
+
+  //! Get the number of visited node combinations.
+  size_t NumVisited() const { return numVisited; }
+  //! Modify the number of visited node combinations.
+  size_t& NumVisited() { return numVisited; }
+
+  //! Get the number of times a node was scored.
+  size_t NumScores() const { return numScores; }
+  //! Modify the number of times a node was scored.
+  size_t& NumScores() { return numScores; }
+
+  //! Get the number of times a base case was computed.
+  size_t NumBaseCases() const { return numBaseCases; }
+  //! Modify the number of times a base case was computed.
+  size_t& NumBaseCases() { return numBaseCases; }
+
+  //! Get the minimum number of query subtrees (0 means automatic).
+  size_t MinTasks() const { return minTasks; }
+  //! Modify the minimum number of query subtrees (0 means automatic).
+  size_t& MinTasks() { return minTasks; }
+
+ private:
+  //! The rule type to use.
+  RuleType& rule;
+
+  //! The minimum number of query subtrees to create.
+  size_t minTasks;
+
+  //! The number of prunes.
+  size_t numPrunes;
+  //! The number of visited node combinations.
+  size_t numVisited;
+  //! The number of times a node was scored.
+  size_t numScores;
+  //! The number of times a base case was calculated.
+  size_t numBaseCases;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_dual_tree_traverser_impl.hpp"
+
+#endif
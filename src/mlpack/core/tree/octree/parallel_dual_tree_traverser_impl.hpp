@@ -0,0 +1,154 @@
+/**
+ * @file core/tree/octree/parallel_dual_tree_traverser_impl.hpp
+ *
+ * Implementation of the ParallelDualTreeTraverser for the Octree.  The query
+ * tree is split into independent subtrees, each of which is traversed against
+ * the reference tree by a separate thread.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_OCTREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_OCTREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "parallel_dual_tree_traverser.hpp"
+#include "dual_tree_traverser.hpp"
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+
+template<typename DistanceType, typename StatisticType, typename MatType>
+template<typename RuleType>
+Octree<DistanceType, StatisticType, MatType>::
+ParallelDualTreeTraverser<RuleType>::ParallelDualTreeTraverser(
+    RuleType& rule,
+    const size_t minTasks) :
+    rule(rule),
+    minTasks(minTasks),
+    numPrunes(0),
+    numVisited(0),
+    numScores(0),
+    numBaseCases(0)
+{
+  // Nothing to do.
+}
+
+template<typename DistanceType, typename StatisticType, typename MatType>
+template<typename RuleType>
+void Octree<DistanceType, StatisticType, MatType>::
+ParallelDualTreeTraverser<RuleType>::Traverse(Octree& queryNode,
+                                              Octree& referenceNode)
+{
+  using TraversalInfoType = typename RuleType::TraversalInfoType;
+  using Frontier = std::vector<std::pair<Octree*, TraversalInfoType>>;
+
+  ++numVisited;
+
+  // If both nodes are root nodes, just score them, exactly like the
+  // DualTreeTraverser does.
+  if (queryNode.Parent() == NULL && referenceNode.Parent() == NULL)
+  {
+    const double rootScore = rule.Score(queryNode, referenceNode);
+    if (rootScore == DBL_MAX)
+    {
+      ++numPrunes;
+      return;
+    }
+  }
+
+  size_t targetTasks = minTasks;
+  if (targetTasks == 0)
+  {
+    #ifdef MLPACK_USE_OPENMP
+    targetTasks = 4 * omp_get_max_threads();
+    #else
+    targetTasks = 1;
+    #endif
+  }
+
+  // Expand the query tree one level at a time until we have enough independent
+  // subtrees.  As in the DualTreeTraverser, each query child is scored against
+  // the reference node before it is traversed; this is done before it is added
+  // to the frontier, so that the statistics of every query node above the
+  // frontier are up to date before any thread reads them.
+  Frontier frontier;
+  frontier.push_back(std::make_pair(&queryNode, rule.TraversalInfo()));
+  while (frontier.size() < targetTasks)
+  {
+    Frontier nextFrontier;
+    bool expanded = false;
+    for (size_t i = 0; i < frontier.size(); ++i)
+    {
+      Octree* node = frontier[i].first;
+      if (node->IsLeaf())
+      {
+        nextFrontier.push_back(frontier[i]);
+        continue;
+      }
+
+      expanded = true;
+      for (size_t c = 0; c < node->NumChildren(); ++c)
+      {
+        rule.TraversalInfo() = frontier[i].second;
+        const double score = rule.Score(node->Child(c), referenceNode);
+        ++numScores;
+
+        if (score == DBL_MAX)
+        {
+          ++numPrunes;
+        }
+        else
+        {
+          nextFrontier.push_back(std::make_pair(&node->Child(c),
+              rule.TraversalInfo()));
+        }
+      }
+    }
+
+    frontier.swap(nextFrontier);
+    if (!expanded)
+      break; // Every node in the frontier is a leaf.
+  }
+
+  // Now traverse each query subtree independently.  Every thread gets its own
+  // copy of the rules, which shares its results with the original rules.
+  size_t taskPrunes = 0, taskVisited = 0, taskScores = 0, taskBaseCases = 0;
+  size_t ruleScores = 0, ruleBaseCases = 0;
+
+  #pragma omp parallel for schedule(dynamic) reduction(+:taskPrunes, \
+      taskVisited, taskScores, taskBaseCases, ruleScores, ruleBaseCases)
+  for (size_t i = 0; i < frontier.size(); ++i)
+  {
+    RuleType taskRule(rule);
+    taskRule.BaseCases() = 0;
+    taskRule.Scores() = 0;
+    taskRule.TraversalInfo() = frontier[i].second;
+
+    DualTreeTraverser<RuleType> traverser(taskRule);
+    traverser.Traverse(*frontier[i].first, referenceNode);
+
+    taskPrunes += traverser.NumPrunes();
+    taskVisited += traverser.NumVisited();
+    taskScores += traverser.NumScores();
+    taskBaseCases += traverser.NumBaseCases();
+    ruleScores += taskRule.Scores();
+    ruleBaseCases += taskRule.BaseCases();
+  }
+
+  numPrunes += taskPrunes;
+  numVisited += taskVisited;
+  numScores += taskScores;
+  numBaseCases += taskBaseCases;
+  rule.Scores() += ruleScores;
+  rule.BaseCases() += ruleBaseCases;
+}
+
+} // namespace mlpack
+
+#endif
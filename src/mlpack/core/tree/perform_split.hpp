@@ -18,8 +18,92 @@
 
 #include <mlpack/core/util/log.hpp>
 
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 
+//! Splits of nodes with at least this many points are partitioned in parallel,
+//! if OpenMP is enabled (and the split is not already run by a parallel
+//! region).
+static const size_t ParallelPartitionMinPoints = 100000;
+
+/**
+ * Partition the points of a node with OpenMP: the child of each point is found
+ * in parallel, then the points are swapped in parallel.  The result (including
+ * oldFromNew) is exactly the one of the serial partition of PerformSplit(),
+ * which swaps the k-th point of the left part that belongs to the right child
+ * with the k-th last point of the right part that belongs to the left child.
+ *
+ * @param data The dataset used by the binary space tree.
+ * @param begin Index of the starting point in the dataset that belongs to
+ *    this node.
+ * @param count Number of points in this node.
+ * @param splitInfo The information about the split.
+ * @param oldFromNew Vector of the old positions of each new point, or NULL.
+ */
+template<typename MatType, typename SplitType>
+size_t ParallelPerformSplit(MatType& data,
+                            const size_t begin,
+                            const size_t count,
+                            const typename SplitType::SplitInfo& splitInfo,
+                            std::vector<size_t>* oldFromNew)
+{
+  // Each point is only looked at once, since this is the expensive part.
+  std::vector<char> toLeft(count);
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < count; ++i)
+    toLeft[i] = SplitType::AssignToLeftNode(data.col(begin + i), splitInfo);
+
+  size_t numLeft = 0;
+  for (size_t i = 0; i < count; ++i)
+    numLeft += toLeft[i];
+
+  // Find the points that are on the wrong side of the split column, in the
+  // order in which the serial partition swaps them.
+  std::vector<size_t> wrongLeft, wrongRight;
+  for (size_t i = 0; i < numLeft; ++i)
+    if (!toLeft[i])
+      wrongLeft.push_back(begin + i);
+  for (size_t i = count; i > numLeft; --i)
+    if (toLeft[i - 1])
+      wrongRight.push_back(begin + i - 1);
+
+  Log::Assert(wrongLeft.size() == wrongRight.size());
+
+  // Each swap touches different columns.
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < wrongLeft.size(); ++i)
+  {
+    data.swap_cols(wrongLeft[i], wrongRight[i]);
+    if (oldFromNew != NULL)
+    {
+      std::swap((*oldFromNew)[wrongLeft[i]], (*oldFromNew)[wrongRight[i]]);
+    }
+  }
+
+  return begin + numLeft;
+}
+
+/**
+ * Return whether the points of a node with the given number of points should
+ * be partitioned with ParallelPerformSplit().
+ */
+template<typename MatType>
+bool UseParallelPartition(const size_t count)
+{
+  #ifdef MLPACK_USE_OPENMP
+  // Sparse columns cannot be swapped in parallel.
+  return !arma::is_SpMat<MatType>::value &&
+      (count >= ParallelPartitionMinPoints) && !omp_in_parallel() &&
+      (omp_get_max_threads() > 1);
+  #else
+  (void) count;
+  return false;
+  #endif
+}
+
 /**
  * This function implements the default split behavior i.e. it rearranges
  * points according to the split information. The SplitType::AssignToLeftNode()
@@ -38,6 +122,12 @@ size_t PerformSplit(MatType& data,
                     const size_t count,
                     const typename SplitType::SplitInfo& splitInfo)
 {
+  if (UseParallelPartition<MatType>(count))
+  {
+    return ParallelPerformSplit<MatType, SplitType>(data, begin, count,
+        splitInfo, NULL);
+  }
+
   // This method modifies the input dataset.  We loop both from the left and
   // right sides of the points contained in this node.
   size_t left = begin;
@@ -104,6 +194,12 @@ size_t PerformSplit(MatType& data,
                     const typename SplitType::SplitInfo& splitInfo,
                     std::vector<size_t>& oldFromNew)
 {
+  if (UseParallelPartition<MatType>(count))
+  {
+    return ParallelPerformSplit<MatType, SplitType>(data, begin, count,
+        splitInfo, &oldFromNew);
+  }
+
   // This method modifies the input dataset.  We loop both from the left and
   // right sides of the points contained in this node.
   size_t left = begin;
@@ -0,0 +1,58 @@
+/**
+ * @file core/tree/rectangle_tree/bulk_load.hpp
+ *
+ * Definition of the bulk loading strategies of the RectangleTree, and of the
+ * BulkLoadTraits class, which tells which auxiliary information types can be
+ * used with bulk loading.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RECTANGLE_TREE_BULK_LOAD_HPP
+#define MLPACK_CORE_TREE_RECTANGLE_TREE_BULK_LOAD_HPP
+
+namespace mlpack {
+
+/**
+ * The strategies that may be used to bulk load a RectangleTree, that is, to
+ * build it in one pass from a whole dataset instead of inserting the points
+ * one by one.  Bulk loaded trees are balanced and their nodes are close to
+ * full.
+ */
+enum RectangleTreeBulkLoad
+{
+  /**
+   * Sort-Tile-Recursive: the points of each node are sorted along their widest
+   * dimension and cut into slabs, which are cut again along the next widest
+   * dimension, until there is one tile per child.  The children of a node do
+   * not overlap.
+   */
+  STR_BULK_LOAD,
+  /**
+   * The points are sorted by their Hilbert value (see DiscreteHilbertValue),
+   * and each node holds a contiguous run of the sorted points.
+   */
+  HILBERT_SORT_BULK_LOAD
+};
+
+/**
+ * The BulkLoadTraits class tells whether a tree with the given auxiliary
+ * information type can be bulk loaded.  The auxiliary information of the
+ * Hilbert R tree (the ordering of the nodes by Hilbert value) and of the R++
+ * tree (the maximum bounding rectangles of the nodes) is only maintained by
+ * insertion, so these trees can't be bulk loaded; this is given by
+ * specializations in their auxiliary information headers.
+ */
+template<typename AuxiliaryInformationType>
+class BulkLoadTraits
+{
+ public:
+  //! If true, trees with this auxiliary information can be bulk loaded.
+  static const bool SupportsBulkLoad = true;
+};
+
+} // namespace mlpack
+
+#endif
@@ -14,6 +14,8 @@
 #ifndef MLPACK_CORE_TREE_RECTANGLE_TREE_HR_TREE_AUXILIARY_INFO_HPP
 #define MLPACK_CORE_TREE_RECTANGLE_TREE_HR_TREE_AUXILIARY_INFO_HPP
 
+#include "bulk_load.hpp"
+
 namespace mlpack {
 
 template<typename TreeType,
@@ -141,6 +143,19 @@ class HilbertRTreeAuxiliaryInformation
   void serialize(Archive& ar, const uint32_t /* version */);
 };
 
+/**
+ * The Hilbert R tree keeps its nodes ordered by their largest Hilbert value as
+ * the points are inserted, so it can't be bulk loaded.
+ */
+template<typename TreeType,
+         template<typename> class HilbertValueType>
+class BulkLoadTraits<HilbertRTreeAuxiliaryInformation<TreeType,
+                                                      HilbertValueType>>
+{
+ public:
+  static const bool SupportsBulkLoad = false;
+};
+
 } // namespace mlpack
 
 #include "hilbert_r_tree_auxiliary_information_impl.hpp"
@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include "../hrectbound.hpp"
+#include "bulk_load.hpp"
 
 namespace mlpack {
 
@@ -159,6 +160,17 @@ class RPlusPlusTreeAuxiliaryInformation
   void serialize(Archive &, const uint32_t /* version */);
 };
 
+/**
+ * The maximum bounding rectangles of the nodes of the R++ tree are computed by
+ * its splits, so it can't be bulk loaded.
+ */
+template<typename TreeType>
+class BulkLoadTraits<RPlusPlusTreeAuxiliaryInformation<TreeType>>
+{
+ public:
+  static const bool SupportsBulkLoad = false;
+};
+
 } // namespace mlpack
 
 #include "r_plus_plus_tree_auxiliary_information_impl.hpp"
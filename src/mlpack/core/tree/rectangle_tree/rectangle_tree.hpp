@@ -17,6 +17,9 @@
 
 #include "../hrectbound.hpp"
 #include "../statistic.hpp"
+#include "../tree_traits.hpp"
+#include "bulk_load.hpp"
+#include "discrete_hilbert_value.hpp"
 #include "r_tree_split.hpp"
 #include "r_tree_descent_heuristic.hpp"
 #include "no_auxiliary_information.hpp"
@@ -155,6 +158,56 @@ class RectangleTree
                 const size_t minNumChildren = 2,
                 const size_t firstDataIndex = 0);
 
+  /**
+   * Construct this as the root node of a rectangle type tree using the given
+   * dataset, bulk loading the whole dataset in one pass with the given
+   * strategy instead of inserting the points one by one.  This is much faster
+   * than insertion for large datasets, and the tree is balanced and its nodes
+   * are close to full; points may still be inserted and deleted afterwards.
+   * The Hilbert R tree and the R++ tree can't be bulk loaded (see
+   * BulkLoadTraits), and the R+ tree can only use STR_BULK_LOAD, since the
+   * children of its nodes must not overlap; otherwise, a std::invalid_argument
+   * exception is thrown.
+   *
+   * @param data Dataset from which to create the tree.
+   * @param bulkLoad Bulk loading strategy (STR_BULK_LOAD or
+   *      HILBERT_SORT_BULK_LOAD).
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node may
+   *      have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node may
+   *      have.
+   */
+  RectangleTree(const MatType& data,
+                const RectangleTreeBulkLoad bulkLoad,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2);
+
+  /**
+   * Construct this as the root node of a rectangle type tree using the given
+   * dataset, taking ownership of the given dataset, and bulk loading it with
+   * the given strategy.  See the constructor above for the details.
+   *
+   * @param data Dataset from which to create the tree.
+   * @param bulkLoad Bulk loading strategy (STR_BULK_LOAD or
+   *      HILBERT_SORT_BULK_LOAD).
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node may
+   *      have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node may
+   *      have.
+   */
+  RectangleTree(MatType&& data,
+                const RectangleTreeBulkLoad bulkLoad,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2);
+
   /**
    * Construct this as an empty node with the specified parent.  Copying the
    * parameters (maxLeafSize, minLeafSize, maxNumChildren, minNumChildren,
@@ -567,6 +620,53 @@ class RectangleTree
    */
   void BuildStatistics(RectangleTree* node);
 
+  /**
+   * Bulk load all the points of the dataset into this node, which must be an
+   * empty root, with the given strategy.
+   *
+   * @param bulkLoad Bulk loading strategy.
+   */
+  void BulkLoad(const RectangleTreeBulkLoad bulkLoad);
+
+  /**
+   * Bulk load the given points into this empty node, building a subtree of the
+   * given height.
+   *
+   * @param indices Indices of the points, which are reordered.
+   * @param first Position in indices of the first point of this node.
+   * @param numPoints Number of points of this node.
+   * @param height Height of the subtree (0 for a leaf).
+   * @param capacity Number of points held by a full subtree of that height.
+   * @param bulkLoad Bulk loading strategy.
+   */
+  void BulkLoadNode(std::vector<size_t>& indices,
+                    const size_t first,
+                    const size_t numPoints,
+                    const size_t height,
+                    const size_t capacity,
+                    const RectangleTreeBulkLoad bulkLoad);
+
+  /**
+   * Reorder the given points so that each group of points is contiguous
+   * (group i holds groupSizes[i] points), with the Sort-Tile-Recursive
+   * strategy: the points are sorted along the widest dimension that has not
+   * been cut yet, and cut into slabs of whole groups, which are tiled
+   * recursively.
+   *
+   * @param indices Indices of the points, which are reordered.
+   * @param first Position in indices of the first point of the first group.
+   * @param groupSizes Number of points of each group.
+   * @param firstGroup Index of the first group to tile.
+   * @param numGroups Number of groups to tile.
+   * @param cutDimensions Dimensions that have already been cut.
+   */
+  void TilePoints(std::vector<size_t>& indices,
+                  const size_t first,
+                  const std::vector<size_t>& groupSizes,
+                  const size_t firstGroup,
+                  const size_t numGroups,
+                  std::vector<bool>& cutDimensions) const;
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
@@ -38,6 +38,227 @@ BuildStatistics(RectangleTree* node)
   node->Stat() = StatisticType(*node);
 }
 
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<DistanceType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+BulkLoad(const RectangleTreeBulkLoad bulkLoad)
+{
+  if (!BulkLoadTraits<AuxiliaryInformationType<RectangleTree>>::
+      SupportsBulkLoad)
+  {
+    throw std::invalid_argument("RectangleTree::RectangleTree(): this tree "
+        "type can't be bulk loaded");
+  }
+
+  if (bulkLoad == HILBERT_SORT_BULK_LOAD &&
+      !TreeTraits<RectangleTree>::HasOverlappingChildren)
+  {
+    throw std::invalid_argument("RectangleTree::RectangleTree(): the children "
+        "of this tree type can't overlap, so it can't be bulk loaded with "
+        "HILBERT_SORT_BULK_LOAD; use STR_BULK_LOAD instead");
+  }
+
+  if (maxLeafSize == 0 || maxNumChildren < 2)
+  {
+    throw std::invalid_argument("RectangleTree::RectangleTree(): maxLeafSize "
+        "must be positive and maxNumChildren must be at least 2");
+  }
+
+  std::vector<size_t> indices(dataset->n_cols);
+  for (size_t i = 0; i < indices.size(); ++i)
+    indices[i] = i;
+
+  if (bulkLoad == HILBERT_SORT_BULK_LOAD)
+  {
+    // Compute the Hilbert values once, and sort the points by them.
+    using HilbertValueType = DiscreteHilbertValue<ElemType>;
+    std::vector<arma::Col<typename HilbertValueType::HilbertElemType>>
+        values(dataset->n_cols);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      values[i] = HilbertValueType::CalculateValue(
+          arma::Col<ElemType>(dataset->col(i)));
+    }
+
+    std::stable_sort(indices.begin(), indices.end(),
+        [&values](const size_t a, const size_t b)
+        {
+          return HilbertValueType::CompareValues(values[a], values[b]) < 0;
+        });
+  }
+
+  // All the leaves are at the same depth: find the smallest height of a full
+  // tree that holds the whole dataset.
+  size_t height = 0;
+  size_t capacity = maxLeafSize;
+  while (capacity < dataset->n_cols)
+  {
+    capacity *= maxNumChildren;
+    ++height;
+  }
+
+  BulkLoadNode(indices, 0, dataset->n_cols, height, capacity, bulkLoad);
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<DistanceType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+BulkLoadNode(std::vector<size_t>& indices,
+             const size_t first,
+             const size_t numPoints,
+             const size_t height,
+             const size_t capacity,
+             const RectangleTreeBulkLoad bulkLoad)
+{
+  numDescendants = numPoints;
+
+  if (height == 0)
+  {
+    for (size_t i = first; i < first + numPoints; ++i)
+    {
+      points[count++] = indices[i];
+      bound |= dataset->col(indices[i]);
+    }
+
+    return;
+  }
+
+  // Use as few children as possible, and spread the points evenly between
+  // them, so that the nodes are as full as the minimum fills allow.
+  const size_t childCapacity = capacity / maxNumChildren;
+  size_t numGroups = (numPoints + childCapacity - 1) / childCapacity;
+  numGroups = std::max(numGroups, minNumChildren);
+  numGroups = std::max(std::min(numGroups, std::min(numPoints,
+      maxNumChildren)), (size_t) 1);
+
+  std::vector<size_t> groupSizes(numGroups, numPoints / numGroups);
+  for (size_t i = 0; i < numPoints % numGroups; ++i)
+    ++groupSizes[i];
+
+  // With the Hilbert sort the points of each group are already contiguous.
+  if (bulkLoad == STR_BULK_LOAD)
+  {
+    std::vector<bool> cutDimensions(dataset->n_rows, false);
+    TilePoints(indices, first, groupSizes, 0, numGroups, cutDimensions);
+  }
+
+  size_t groupBegin = first;
+  for (size_t i = 0; i < numGroups; ++i)
+  {
+    RectangleTree* child = new RectangleTree(this);
+    children[numChildren++] = child;
+    child->BulkLoadNode(indices, groupBegin, groupSizes[i], height - 1,
+        childCapacity, bulkLoad);
+
+    bound |= child->Bound();
+    groupBegin += groupSizes[i];
+  }
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<DistanceType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+TilePoints(std::vector<size_t>& indices,
+           const size_t first,
+           const std::vector<size_t>& groupSizes,
+           const size_t firstGroup,
+           const size_t numGroups,
+           std::vector<bool>& cutDimensions) const
+{
+  if (numGroups <= 1)
+    return;
+
+  size_t numPoints = 0;
+  for (size_t i = firstGroup; i < firstGroup + numGroups; ++i)
+    numPoints += groupSizes[i];
+
+  // Find the widest dimension that hasn't been cut yet.
+  size_t dim = 0;
+  size_t remainingDimensions = 0;
+  ElemType widest = -1;
+  for (size_t d = 0; d < dataset->n_rows; ++d)
+  {
+    if (cutDimensions[d])
+      continue;
+
+    ++remainingDimensions;
+    ElemType lo = std::numeric_limits<ElemType>::max();
+    ElemType hi = std::numeric_limits<ElemType>::lowest();
+    for (size_t i = first; i < first + numPoints; ++i)
+    {
+      const ElemType value = (*dataset)(d, indices[i]);
+      lo = std::min(lo, value);
+      hi = std::max(hi, value);
+    }
+
+    if (hi - lo > widest)
+    {
+      widest = hi - lo;
+      dim = d;
+    }
+  }
+
+  // Cut the groups into numSlabs slabs, where numSlabs is the smallest number
+  // such that numSlabs^remainingDimensions >= numGroups, so that every
+  // remaining dimension is cut about the same number of times.
+  size_t numSlabs = numGroups;
+  if (remainingDimensions > 1)
+  {
+    numSlabs = 2;
+    while (true)
+    {
+      size_t tiles = 1;
+      for (size_t i = 0; i < remainingDimensions && tiles < numGroups; ++i)
+        tiles *= numSlabs;
+      if (tiles >= numGroups)
+        break;
+      ++numSlabs;
+    }
+  }
+
+  const MatType& data = *dataset;
+  std::sort(indices.begin() + first, indices.begin() + first + numPoints,
+      [&data, dim](const size_t a, const size_t b)
+      {
+        return data(dim, a) < data(dim, b);
+      });
+
+  cutDimensions[dim] = true;
+  size_t slabBegin = first;
+  size_t slabFirstGroup = firstGroup;
+  for (size_t i = 0; i < numSlabs; ++i)
+  {
+    const size_t slabGroups = numGroups / numSlabs +
+        ((i < numGroups % numSlabs) ? 1 : 0);
+
+    size_t slabPoints = 0;
+    for (size_t j = slabFirstGroup; j < slabFirstGroup + slabGroups; ++j)
+      slabPoints += groupSizes[j];
+
+    TilePoints(indices, slabBegin, groupSizes, slabFirstGroup, slabGroups,
+        cutDimensions);
+
+    slabBegin += slabPoints;
+    slabFirstGroup += slabGroups;
+  }
+  cutDimensions[dim] = false;
+}
+
 template<typename DistanceType,
          typename StatisticType,
          typename MatType,
@@ -120,6 +341,80 @@ RectangleTree(MatType&& data,
   BuildStatistics(this);
 }
 
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+RectangleTree<DistanceType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(const MatType& data,
+              const RectangleTreeBulkLoad bulkLoad,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(data)),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this)
+{
+  BulkLoad(bulkLoad);
+
+  // Initialize statistic recursively after tree construction is complete.
+  BuildStatistics(this);
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+RectangleTree<DistanceType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(MatType&& data,
+              const RectangleTreeBulkLoad bulkLoad,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(std::move(data))),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this)
+{
+  BulkLoad(bulkLoad);
+
+  // Initialize statistic recursively after tree construction is complete.
+  BuildStatistics(this);
+}
+
 template<typename DistanceType,
          typename StatisticType,
          typename MatType,
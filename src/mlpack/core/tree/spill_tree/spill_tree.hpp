@@ -440,6 +440,10 @@ class SpillTree
   //! Store the center of the bounding region in the given vector.
   void Center(arma::vec& center) { bound.Center(center); }
 
+  //! Nodes with at least this many points have their children built in
+  //! parallel, if OpenMP is enabled and the hyperplanes are axis-orthogonal.
+  static const size_t ParallelBuildMinPoints = 20000;
+
  private:
   /**
    * Splits the current node, assigning its left and right children recursively.
@@ -469,6 +473,24 @@ class SpillTree
                    const arma::Col<size_t>& points,
                    arma::Col<size_t>& leftPoints,
                    arma::Col<size_t>& rightPoints);
+
+  /**
+   * Build the children of the current node from the given lists of points.
+   * If the hyperplanes are axis-orthogonal (so that the splits do not use
+   * random numbers) and the node holds at least ParallelBuildMinPoints points,
+   * the two children are built as parallel OpenMP tasks.
+   *
+   * @param leftPoints Indexes of points to be included in left child.
+   * @param rightPoints Indexes of points to be included in right child.
+   * @param maxLeafSize Maximum number of points held in a leaf.
+   * @param tau Overlapping size.
+   * @param rho Balance threshold.
+   */
+  void BuildChildren(arma::Col<size_t>& leftPoints,
+                     arma::Col<size_t>& rightPoints,
+                     const size_t maxLeafSize,
+                     const double tau,
+                     const double rho);
  protected:
   /**
    * A default constructor.  This is meant to only be used with
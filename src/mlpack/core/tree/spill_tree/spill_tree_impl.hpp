@@ -16,6 +16,10 @@
 
 #include <queue>
 
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 
 template<typename DistanceType,
@@ -768,8 +772,7 @@ SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>::
 
   // Now we will recursively split the children by calling their constructors
   // (which perform this splitting process).
-  left = new SpillTree(this, leftPoints, tau, maxLeafSize, rho);
-  right = new SpillTree(this, rightPoints, tau, maxLeafSize, rho);
+  BuildChildren(leftPoints, rightPoints, maxLeafSize, tau, rho);
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -872,6 +875,59 @@ SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>::
   return false;
 }
 
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename HyperplaneDistanceType> class HyperplaneType,
+         template<typename SplitDistanceType, typename SplitMatType>
+             class SplitType>
+void
+SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>::
+    BuildChildren(arma::Col<size_t>& leftPoints,
+                  arma::Col<size_t>& rightPoints,
+                  const size_t maxLeafSize,
+                  const double tau,
+                  const double rho)
+{
+  // Non-orthogonal splits pick a random point with rand(), which must not be
+  // called from several threads, and would make the tree depend on the order
+  // in which the nodes are built.
+  const bool parallel = std::is_same<
+      typename HyperplaneType<DistanceType>::ProjVectorType,
+      AxisParallelProjVector>::value && (count >= ParallelBuildMinPoints);
+
+  #ifdef MLPACK_USE_OPENMP
+  if (parallel && !omp_in_parallel())
+  {
+    // Start the threads that the tasks of the whole subtree will run on.
+    #pragma omp parallel
+    {
+      #pragma omp single
+      BuildChildren(leftPoints, rightPoints, maxLeafSize, tau, rho);
+    }
+    return;
+  }
+  #endif
+
+  if (parallel)
+  {
+    // The children hold their own lists of point indexes and only read the
+    // dataset, so both can be built at the same time, and the tree is the
+    // same as the one built serially.
+    #pragma omp task shared(leftPoints)
+    left = new SpillTree(this, leftPoints, tau, maxLeafSize, rho);
+
+    right = new SpillTree(this, rightPoints, tau, maxLeafSize, rho);
+
+    #pragma omp taskwait
+  }
+  else
+  {
+    left = new SpillTree(this, leftPoints, tau, maxLeafSize, rho);
+    right = new SpillTree(this, rightPoints, tau, maxLeafSize, rho);
+  }
+}
+
 // Default constructor (private), for cereal.
 template<typename DistanceType,
          typename StatisticType,
@@ -0,0 +1,124 @@
+/**
+ * @file core/tree/traversal_stats.hpp
+ *
+ * The TraversalStats class, which holds the statistics of the tree traversals
+ * done by a search (base cases, scores, prunes, and time spent).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TRAVERSAL_STATS_HPP
+#define MLPACK_CORE_TREE_TRAVERSAL_STATS_HPP
+
+#include <chrono>
+
+namespace mlpack {
+
+/**
+ * The TraversalStats class holds the statistics of the last search (or
+ * evaluation) of a tree-based algorithm, in the same form for all algorithms,
+ * so that the leaf size, tree type and search mode can be tuned from the
+ * actual cost of a workload.  The algorithms that use it (NeighborSearch,
+ * RangeSearch, KDE, FastMKS) give the statistics of their last call with
+ * `Stats()`.
+ *
+ * @code
+ * KNN knn(referenceData);
+ * knn.Search(queryData, 5, neighbors, distances);
+ * std::cout << knn.Stats().BaseCases() << " base cases, "
+ *     << knn.Stats().Prunes() << " prunes, "
+ *     << knn.Stats().TraversalTime().count() << "us." << std::endl;
+ * @endcode
+ */
+class TraversalStats
+{
+ public:
+  //! Create empty statistics.
+  TraversalStats() { Reset(); }
+
+  //! Reset all statistics to zero.
+  void Reset()
+  {
+    baseCases = 0;
+    scores = 0;
+    prunes = 0;
+    distanceEvaluations = 0;
+    treeBuildingTime = std::chrono::microseconds(0);
+    traversalTime = std::chrono::microseconds(0);
+  }
+
+  //! Add the given statistics to these.
+  TraversalStats& operator+=(const TraversalStats& other)
+  {
+    baseCases += other.baseCases;
+    scores += other.scores;
+    prunes += other.prunes;
+    distanceEvaluations += other.distanceEvaluations;
+    treeBuildingTime += other.treeBuildingTime;
+    traversalTime += other.traversalTime;
+    return *this;
+  }
+
+  //! Get the number of base cases computed.
+  size_t BaseCases() const { return baseCases; }
+  //! Modify the number of base cases computed.
+  size_t& BaseCases() { return baseCases; }
+
+  //! Get the number of nodes (or node combinations) visited and scored.
+  size_t Scores() const { return scores; }
+  //! Modify the number of nodes (or node combinations) visited and scored.
+  size_t& Scores() { return scores; }
+
+  //! Get the number of nodes (or node combinations) pruned.
+  size_t Prunes() const { return prunes; }
+  //! Modify the number of nodes (or node combinations) pruned.
+  size_t& Prunes() { return prunes; }
+
+  //! Get the number of distance (or kernel) evaluations between points.
+  size_t DistanceEvaluations() const { return distanceEvaluations; }
+  //! Modify the number of distance (or kernel) evaluations between points.
+  size_t& DistanceEvaluations() { return distanceEvaluations; }
+
+  //! Get the time spent building trees for the search (e.g. the query tree).
+  std::chrono::microseconds TreeBuildingTime() const
+  { return treeBuildingTime; }
+  //! Modify the time spent building trees for the search.
+  std::chrono::microseconds& TreeBuildingTime() { return treeBuildingTime; }
+
+  //! Get the time spent traversing the trees (or computing the brute-force
+  //! results).
+  std::chrono::microseconds TraversalTime() const { return traversalTime; }
+  //! Modify the time spent traversing the trees.
+  std::chrono::microseconds& TraversalTime() { return traversalTime; }
+
+  /**
+   * Return the time elapsed since the given time point; this is the helper
+   * used by the algorithms to fill TreeBuildingTime() and TraversalTime().
+   */
+  static std::chrono::microseconds Since(
+      const std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+  }
+
+ private:
+  //! The number of base cases.
+  size_t baseCases;
+  //! The number of scores.
+  size_t scores;
+  //! The number of prunes.
+  size_t prunes;
+  //! The number of distance evaluations.
+  size_t distanceEvaluations;
+  //! The time spent building trees.
+  std::chrono::microseconds treeBuildingTime;
+  //! The time spent traversing trees.
+  std::chrono::microseconds traversalTime;
+};
+
+} // namespace mlpack
+
+#endif
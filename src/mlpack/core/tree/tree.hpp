@@ -27,6 +27,10 @@
 
 #include "statistic.hpp"
 #include "traversal_info.hpp"
+#include "traversal_stats.hpp"
+#include "dual_tree_traverser_type.hpp"
 #include "greedy_single_tree_traverser.hpp"
+#include "best_first_single_tree_traverser.hpp"
+#include "tree_memory_usage.hpp"
 
 #endif
@@ -0,0 +1,121 @@
+/**
+ * @file core/tree/tree_memory_usage.hpp
+ *
+ * Compute the memory used by the nodes, bounds and dataset of any tree type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TREE_MEMORY_USAGE_HPP
+#define MLPACK_CORE_TREE_TREE_MEMORY_USAGE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "bounds.hpp"
+
+namespace mlpack {
+
+//! Return the heap memory held by a bound; by default, a bound has none.
+template<typename BoundType>
+size_t BoundMemoryUsage(const BoundType& /* bound */)
+{
+  return 0;
+}
+
+//! Return the heap memory held by a hyperrectangle bound (its ranges).
+template<typename DistanceType, typename ElemType, typename BoundElemType>
+size_t BoundMemoryUsage(
+    const HRectBound<DistanceType, ElemType, BoundElemType>& bound)
+{
+  return bound.Dim() * sizeof(RangeType<BoundElemType>);
+}
+
+//! Return the heap memory held by a ball bound (its center).
+template<typename DistanceType, typename ElemType, typename VecType>
+size_t BoundMemoryUsage(
+    const BallBound<DistanceType, ElemType, VecType>& bound)
+{
+  return bound.Dim() * sizeof(typename VecType::elem_type);
+}
+
+//! Return the heap memory held by a hollow ball bound (its two centers).
+template<typename DistanceType, typename ElemType>
+size_t BoundMemoryUsage(const HollowBallBound<DistanceType, ElemType>& bound)
+{
+  return MemoryOf(bound.Center()) + MemoryOf(bound.HollowCenter());
+}
+
+//! Return the heap memory held by a cell bound (its ranges, its subrectangles
+//! and its addresses).
+template<typename DistanceType, typename ElemType>
+size_t BoundMemoryUsage(const CellBound<DistanceType, ElemType>& bound)
+{
+  return bound.Dim() * sizeof(RangeType<ElemType>) +
+      MemoryOf(bound.LoBound()) + MemoryOf(bound.HiBound()) +
+      MemoryOf(bound.LoAddress()) + MemoryOf(bound.HiAddress());
+}
+
+//! Return the heap memory held by the bound of the given node, if its tree type
+//! has bounds.
+template<typename TreeType>
+auto NodeBoundMemoryUsage(const TreeType& node, int /* prefer this */)
+    -> decltype(BoundMemoryUsage(node.Bound()))
+{
+  return BoundMemoryUsage(node.Bound());
+}
+
+//! Trees without bounds (like CoverTree) hold no memory for them.
+template<typename TreeType>
+size_t NodeBoundMemoryUsage(const TreeType& /* node */, long /* fallback */)
+{
+  return 0;
+}
+
+/**
+ * Return the memory used by the given tree, with these components:
+ *
+ *  - "nodes": the node objects (each of which holds its bound and statistic);
+ *  - "bounds": the heap memory of the bounds of the nodes (e.g. the ranges of
+ *    hyperrectangle bounds, or the centers of ball bounds), for tree types
+ *    with bounds;
+ *  - "dataset": the dataset of the tree, if includeDataset is true.
+ *
+ * The heap memory held by the statistics, and the arrays of children and
+ * points of the nodes of some tree types (like RectangleTree), are not
+ * counted.
+ *
+ * @param tree Root of the tree.
+ * @param includeDataset Whether to count the dataset of the tree.
+ */
+template<typename TreeType>
+MemoryReport TreeMemoryUsage(const TreeType& tree,
+                             const bool includeDataset = true)
+{
+  MemoryReport report;
+  size_t numNodes = 0;
+  size_t boundBytes = 0;
+
+  std::vector<const TreeType*> stack(1, &tree);
+  while (!stack.empty())
+  {
+    const TreeType* node = stack.back();
+    stack.pop_back();
+
+    ++numNodes;
+    boundBytes += NodeBoundMemoryUsage(*node, 0);
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      stack.push_back(&node->Child(i));
+  }
+
+  report.Add("nodes", numNodes * sizeof(TreeType));
+  report.Add("bounds", boundBytes);
+  if (includeDataset)
+    report.Add("dataset", MemoryOf(tree.Dataset()));
+
+  return report;
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,195 @@
+/**
+ * @file core/util/batch_scheduler.hpp
+ *
+ * Definition of the BatchScheduler class, which collects single queries from
+ * any number of threads into batches for the batch API of a model, and the
+ * ClassifyBatches(), PredictBatches() and SearchBatches() adapters.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_BATCH_SCHEDULER_HPP
+#define MLPACK_CORE_UTIL_BATCH_SCHEDULER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace mlpack {
+
+/**
+ * A BatchScheduler answers single queries (e.g. from the threads of an RPC
+ * server) with the batch API of a model.  Submit() queues a query and returns
+ * a future for its result; a background thread takes the queued queries in
+ * micro-batches, calls the batch function once per batch, and gives each
+ * query its result.  A batch is started as soon as `maxBatchSize` queries are
+ * queued, or when the oldest queued query has waited for `maxDelay`, so the
+ * time a query waits before its batch starts is bounded by `maxDelay` (when
+ * the model keeps up with the load).
+ *
+ * The batch function is only ever called from the background thread, one
+ * batch at a time, so a model whose batch method is not thread-safe (like
+ * FFN::Predict() or NeighborSearch::Search()) can be used as is.  The
+ * ClassifyBatches(), PredictBatches() and SearchBatches() adapters give the
+ * batch functions of most mlpack models.
+ *
+ * @code
+ * RandomForest<> rf(data, labels, numClasses);
+ * BatchScheduler<size_t> scheduler(ClassifyBatches(rf), data.n_rows);
+ *
+ * // From any thread:
+ * std::future<size_t> prediction = scheduler.Submit(point);
+ * const size_t label = prediction.get();
+ * @endcode
+ *
+ * @tparam ResultType Type of the result of one query.
+ * @tparam MatType Type of the batches of queries (one query per column).
+ */
+template<typename ResultType, typename MatType = arma::mat>
+class BatchScheduler
+{
+ public:
+  //! The type of a single query.
+  using ColType = typename GetColType<MatType>::type;
+  //! The type of the batch function, which must compute one result for each
+  //! column of the given batch.
+  using BatchFunction =
+      std::function<void(const MatType&, std::vector<ResultType>&)>;
+
+  /**
+   * Create the scheduler and start its background thread.  A
+   * std::invalid_argument is thrown if `maxBatchSize` is 0.
+   *
+   * @param batchFunction Function that computes the results of a batch.
+   * @param dimensionality Dimensionality of the queries.
+   * @param maxBatchSize Maximum number of queries in a batch.
+   * @param maxDelay Maximum time a query waits for its batch to fill up.
+   */
+  BatchScheduler(BatchFunction batchFunction,
+                 const size_t dimensionality,
+                 const size_t maxBatchSize = 64,
+                 const std::chrono::microseconds maxDelay =
+                     std::chrono::microseconds(1000));
+
+  //! The background thread cannot be shared between schedulers.
+  BatchScheduler(const BatchScheduler& other) = delete;
+  //! The background thread cannot be shared between schedulers.
+  BatchScheduler& operator=(const BatchScheduler& other) = delete;
+
+  //! Answer the queries that are still queued, and stop the background
+  //! thread.
+  ~BatchScheduler();
+
+  /**
+   * Queue a query, and get a future for its result.  If the batch function
+   * throws an exception, the futures of all the queries of the batch hold it.
+   * A std::invalid_argument is thrown if the query does not have the
+   * dimensionality of the scheduler, and a std::runtime_error if the scheduler
+   * is being destroyed.  This may be called from any thread.
+   *
+   * @param query Query.
+   */
+  std::future<ResultType> Submit(const ColType& query);
+
+  //! Get the number of batches computed so far.
+  size_t NumBatches() const { return numBatches; }
+  //! Get the number of queries answered so far.
+  size_t NumQueries() const { return numQueries; }
+
+  //! Get the dimensionality of the queries.
+  size_t Dimensionality() const { return dimensionality; }
+  //! Get the maximum number of queries in a batch.
+  size_t MaxBatchSize() const { return maxBatchSize; }
+  //! Get the maximum time a query waits for its batch to fill up.
+  std::chrono::microseconds MaxDelay() const { return maxDelay; }
+
+ private:
+  //! A queued query.
+  struct Query
+  {
+    ColType point;
+    std::promise<ResultType> promise;
+    std::chrono::steady_clock::time_point time;
+  };
+
+  //! Body of the background thread.
+  void Run();
+
+  //! The batch function.
+  BatchFunction batchFunction;
+  //! Dimensionality of the queries.
+  size_t dimensionality;
+  //! Maximum number of queries in a batch.
+  size_t maxBatchSize;
+  //! Maximum time a query waits for its batch to fill up.
+  std::chrono::microseconds maxDelay;
+
+  //! The queued queries, oldest first.
+  std::deque<Query> queue;
+  //! Set when the scheduler is destroyed.
+  bool stop;
+  //! Number of batches computed so far.
+  std::atomic<size_t> numBatches;
+  //! Number of queries answered so far.
+  std::atomic<size_t> numQueries;
+
+  //! Protects the queue and `stop`.
+  std::mutex mutex;
+  //! Signaled when a query is queued, and when the scheduler is stopped.
+  std::condition_variable queued;
+  //! The background thread.
+  std::thread worker;
+};
+
+/**
+ * Get a batch function for BatchScheduler<size_t, MatType> that calls
+ * `model.Classify(queries, predictions)`, for models such as RandomForest,
+ * DecisionTree, or LogisticRegression.  The model must outlive the scheduler.
+ *
+ * @param model Trained classifier.
+ */
+template<typename MatType = arma::mat, typename ModelType>
+typename BatchScheduler<size_t, MatType>::BatchFunction ClassifyBatches(
+    const ModelType& model);
+
+/**
+ * Get a batch function for BatchScheduler<ColType, MatType> (where ColType is
+ * the column type of MatType) that calls `model.Predict(queries, results)`
+ * and gives each query its column of the results, for models such as FFN.
+ * The model must outlive the scheduler.
+ *
+ * @param model Trained model.
+ */
+template<typename MatType = arma::mat, typename ModelType>
+typename BatchScheduler<typename GetColType<MatType>::type, MatType>::
+    BatchFunction PredictBatches(ModelType& model);
+
+/**
+ * Get a batch function for a BatchScheduler that calls
+ * `model.Search(queries, k, neighbors, distances)` of a NeighborSearch model,
+ * and gives each query its neighbors and distances.  The model must outlive
+ * the scheduler.
+ *
+ * @param model Neighbor search model with a reference set.
+ * @param k Number of neighbors to search for.
+ */
+template<typename MatType = arma::mat, typename ModelType>
+typename BatchScheduler<std::pair<arma::Col<size_t>,
+    arma::Col<typename MatType::elem_type>>, MatType>::BatchFunction
+SearchBatches(ModelType& model, const size_t k);
+
+} // namespace mlpack
+
+// Include implementation.
+#include "batch_scheduler_impl.hpp"
+
+#endif
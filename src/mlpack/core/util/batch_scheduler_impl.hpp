@@ -0,0 +1,210 @@
+/**
+ * @file core/util/batch_scheduler_impl.hpp
+ *
+ * Implementation of the BatchScheduler class and its batch function adapters.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_BATCH_SCHEDULER_IMPL_HPP
+#define MLPACK_CORE_UTIL_BATCH_SCHEDULER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "batch_scheduler.hpp"
+
+namespace mlpack {
+
+template<typename ResultType, typename MatType>
+BatchScheduler<ResultType, MatType>::BatchScheduler(
+    BatchFunction batchFunction,
+    const size_t dimensionality,
+    const size_t maxBatchSize,
+    const std::chrono::microseconds maxDelay) :
+    batchFunction(std::move(batchFunction)),
+    dimensionality(dimensionality),
+    maxBatchSize(maxBatchSize),
+    maxDelay(maxDelay),
+    stop(false),
+    numBatches(0),
+    numQueries(0)
+{
+  if (maxBatchSize == 0)
+  {
+    throw std::invalid_argument("BatchScheduler::BatchScheduler(): "
+        "maxBatchSize must be positive!");
+  }
+
+  // The worker is started last, once all the other members are initialized.
+  worker = std::thread(&BatchScheduler::Run, this);
+}
+
+template<typename ResultType, typename MatType>
+BatchScheduler<ResultType, MatType>::~BatchScheduler()
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    stop = true;
+  }
+  queued.notify_one();
+  worker.join();
+}
+
+template<typename ResultType, typename MatType>
+std::future<ResultType> BatchScheduler<ResultType, MatType>::Submit(
+    const ColType& query)
+{
+  if (query.n_elem != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "BatchScheduler::Submit(): query has dimensionality "
+        << query.n_elem << ", but the scheduler expects dimensionality "
+        << dimensionality << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  Query q;
+  q.point = query;
+  q.time = std::chrono::steady_clock::now();
+  std::future<ResultType> result = q.promise.get_future();
+
+  bool notify;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (stop)
+    {
+      throw std::runtime_error("BatchScheduler::Submit(): the scheduler is "
+          "being destroyed!");
+    }
+
+    queue.push_back(std::move(q));
+    // The worker only has to wake up for the first query of a batch, and when
+    // the batch is full; otherwise it is waiting for the deadline anyway.
+    notify = (queue.size() == 1 || queue.size() >= maxBatchSize);
+  }
+
+  if (notify)
+    queued.notify_one();
+
+  return result;
+}
+
+template<typename ResultType, typename MatType>
+void BatchScheduler<ResultType, MatType>::Run()
+{
+  std::vector<Query> batch;
+  MatType queries;
+  std::vector<ResultType> results;
+
+  while (true)
+  {
+    batch.clear();
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      queued.wait(lock, [this] { return stop || !queue.empty(); });
+      if (queue.empty())
+        return; // Stopped, and nothing left to answer.
+
+      // Wait for the batch to fill up, until the oldest query's deadline.
+      // When stopping, the queued queries are answered without waiting.
+      const std::chrono::steady_clock::time_point deadline =
+          queue.front().time + maxDelay;
+      queued.wait_until(lock, deadline,
+          [this] { return stop || queue.size() >= maxBatchSize; });
+
+      const size_t batchSize = std::min(maxBatchSize, queue.size());
+      for (size_t i = 0; i < batchSize; ++i)
+      {
+        batch.push_back(std::move(queue.front()));
+        queue.pop_front();
+      }
+    }
+
+    queries.set_size(dimensionality, batch.size());
+    for (size_t i = 0; i < batch.size(); ++i)
+      queries.col(i) = batch[i].point;
+
+    // An exception of the batch function is given to every query of the
+    // batch, and the worker goes on with the next batch.
+    std::exception_ptr exception;
+    try
+    {
+      results.clear();
+      batchFunction(queries, results);
+      if (results.size() != batch.size())
+      {
+        std::ostringstream oss;
+        oss << "BatchScheduler: the batch function gave " << results.size()
+            << " results for a batch of " << batch.size() << " queries!";
+        throw std::runtime_error(oss.str());
+      }
+    }
+    catch (...)
+    {
+      exception = std::current_exception();
+    }
+
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+      if (exception)
+        batch[i].promise.set_exception(exception);
+      else
+        batch[i].promise.set_value(std::move(results[i]));
+    }
+
+    ++numBatches;
+    numQueries += batch.size();
+  }
+}
+
+template<typename MatType, typename ModelType>
+typename BatchScheduler<size_t, MatType>::BatchFunction ClassifyBatches(
+    const ModelType& model)
+{
+  return [&model](const MatType& queries, std::vector<size_t>& results)
+  {
+    arma::Row<size_t> predictions;
+    model.Classify(queries, predictions);
+    results.assign(predictions.begin(), predictions.end());
+  };
+}
+
+template<typename MatType, typename ModelType>
+typename BatchScheduler<typename GetColType<MatType>::type, MatType>::
+    BatchFunction PredictBatches(ModelType& model)
+{
+  using ColType = typename GetColType<MatType>::type;
+
+  return [&model](const MatType& queries, std::vector<ColType>& results)
+  {
+    MatType predictions;
+    model.Predict(queries, predictions);
+    results.resize(predictions.n_cols);
+    for (size_t i = 0; i < predictions.n_cols; ++i)
+      results[i] = predictions.col(i);
+  };
+}
+
+template<typename MatType, typename ModelType>
+typename BatchScheduler<std::pair<arma::Col<size_t>,
+    arma::Col<typename MatType::elem_type>>, MatType>::BatchFunction
+SearchBatches(ModelType& model, const size_t k)
+{
+  using ElemType = typename MatType::elem_type;
+  using ResultType = std::pair<arma::Col<size_t>, arma::Col<ElemType>>;
+
+  return [&model, k](const MatType& queries, std::vector<ResultType>& results)
+  {
+    arma::Mat<size_t> neighbors;
+    arma::Mat<ElemType> distances;
+    model.Search(queries, k, neighbors, distances);
+    results.resize(neighbors.n_cols);
+    for (size_t i = 0; i < neighbors.n_cols; ++i)
+      results[i] = ResultType(neighbors.col(i), distances.col(i));
+  };
+}
+
+} // namespace mlpack
+
+#endif
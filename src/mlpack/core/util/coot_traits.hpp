@@ -0,0 +1,74 @@
+/**
+ * @file core/util/coot_traits.hpp
+ *
+ * Specializations of the traits in arma_traits.hpp for Bandicoot types, so that
+ * code templated on the matrix type gets Bandicoot vectors and matrices when
+ * it is used with coot::Mat.  This file is only included when MLPACK_HAS_COOT
+ * is defined.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_COOT_TRAITS_HPP
+#define MLPACK_CORE_UTIL_COOT_TRAITS_HPP
+
+// Get the row vector type corresponding to a given MatType.
+
+template<typename eT>
+struct GetRowType<coot::Mat<eT>>
+{
+  using type = coot::Row<eT>;
+};
+
+// Get the column vector type corresponding to a given MatType.
+
+template<typename eT>
+struct GetColType<coot::Mat<eT>>
+{
+  using type = coot::Col<eT>;
+};
+
+template<typename eT>
+struct GetUColType<coot::Mat<eT>>
+{
+  using type = coot::Col<coot::uword>;
+};
+
+// Get the dense matrix type corresponding to a given MatType.
+
+template<typename eT>
+struct GetDenseMatType<coot::Mat<eT>>
+{
+  using type = coot::Mat<eT>;
+};
+
+template<typename eT>
+struct GetUDenseMatType<coot::Mat<eT>>
+{
+  using type = coot::Mat<coot::uword>;
+};
+
+// Get whether or not the given type is a base matrix type (e.g. not an
+// expression).
+
+template<typename eT>
+struct IsBaseMatType<coot::Mat<eT>>
+{
+  constexpr static bool value = true;
+};
+
+template<typename eT>
+struct IsBaseMatType<coot::Col<eT>>
+{
+  constexpr static bool value = true;
+};
+
+template<typename eT>
+struct IsBaseMatType<coot::Row<eT>>
+{
+  constexpr static bool value = true;
+};
+
+#endif
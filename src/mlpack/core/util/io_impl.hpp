@@ -206,23 +206,39 @@ inline util::Timers& IO::GetTimers()
  */
 inline util::Params IO::Parameters(const std::string& bindingName)
 {
-  // We don't need a mutex here, because we are only randomly accessing elements
-  // of the maps.
-  std::map<char, std::string> resultAliases =
-      GetSingleton().aliases[bindingName];
+  // We don't need a mutex here, because we are only looking up elements of
+  // the maps.  The maps are searched with find(), so that nothing is inserted
+  // in them, and each map is copied only once.
+  IO& io = GetSingleton();
+
+  std::map<char, std::string> resultAliases;
+  std::map<std::string, std::map<char, std::string>>::const_iterator
+      aliasIt = io.aliases.find(bindingName);
+  if (aliasIt != io.aliases.end())
+    resultAliases = aliasIt->second;
   // Merge in any persistent parameters (e.g. parameters in the "" binding map).
-  std::map<char, std::string> persistentAliases = GetSingleton().aliases[""];
-  resultAliases.insert(persistentAliases.begin(), persistentAliases.end());
-
-  std::map<std::string, util::ParamData> resultParams =
-      GetSingleton().parameters[bindingName];
+  aliasIt = io.aliases.find("");
+  if (aliasIt != io.aliases.end())
+    resultAliases.insert(aliasIt->second.begin(), aliasIt->second.end());
+
+  std::map<std::string, util::ParamData> resultParams;
+  std::map<std::string, std::map<std::string, util::ParamData>>::const_iterator
+      paramIt = io.parameters.find(bindingName);
+  if (paramIt != io.parameters.end())
+    resultParams = paramIt->second;
   // Merge in any persistent parameters (e.g. parameters in the "" binding map).
-  std::map<std::string, util::ParamData> persistentParams =
-      GetSingleton().parameters[""];
-  resultParams.insert(persistentParams.begin(), persistentParams.end());
-
-  return util::Params(resultAliases, resultParams, GetSingleton().functionMap,
-      bindingName, GetSingleton().docs[bindingName]);
+  paramIt = io.parameters.find("");
+  if (paramIt != io.parameters.end())
+    resultParams.insert(paramIt->second.begin(), paramIt->second.end());
+
+  std::map<std::string, util::BindingDetails>::const_iterator docIt =
+      io.docs.find(bindingName);
+  static const util::BindingDetails emptyDoc;
+  const util::BindingDetails& doc = (docIt != io.docs.end()) ? docIt->second :
+      emptyDoc;
+
+  return util::Params(std::move(resultAliases), std::move(resultParams),
+      io.functionMap, bindingName, doc);
 }
 
 } // namespace mlpack
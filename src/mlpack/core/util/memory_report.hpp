@@ -0,0 +1,202 @@
+/**
+ * @file core/util/memory_report.hpp
+ *
+ * Definition of the MemoryReport class, which holds the memory used by the
+ * components of a model, and of utility functions to compute the memory held
+ * by Armadillo objects and standard containers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_MEMORY_REPORT_HPP
+#define MLPACK_CORE_UTIL_MEMORY_REPORT_HPP
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <sys/resource.h>
+#endif
+
+namespace mlpack {
+
+/**
+ * A MemoryReport holds the number of bytes used by each component of an
+ * object, as returned by the MemoryUsage() method of models and by
+ * TreeMemoryUsage().  Components are named; the report of a sub-object can be
+ * added under a prefix, so that for instance the nodes of the reference tree
+ * of a NeighborSearch object are reported as "reference tree/nodes".  The
+ * sizes only count the heap memory held by the components (the elements of
+ * matrices and containers, and the tree nodes), not the small fixed-size
+ * members of the objects themselves, so they are a lower bound of the memory
+ * used.
+ *
+ * @code
+ * KNN knn(referenceData);
+ * const MemoryReport report = knn.MemoryUsage();
+ * std::cout << report.Print();
+ * std::cout << "The tree takes " << report.Bytes("reference tree/nodes")
+ *     << " bytes." << std::endl;
+ * @endcode
+ */
+class MemoryReport
+{
+ public:
+  //! Add the given number of bytes to the given component.
+  void Add(const std::string& component, const size_t bytes)
+  {
+    components[component] += bytes;
+  }
+
+  //! Add every component of the given report, with names prefixed by
+  //! "prefix/".
+  void Add(const std::string& prefix, const MemoryReport& other)
+  {
+    for (const auto& it : other.components)
+      components[prefix + "/" + it.first] += it.second;
+  }
+
+  //! Add every component of the given report, with the same names.
+  MemoryReport& operator+=(const MemoryReport& other)
+  {
+    for (const auto& it : other.components)
+      components[it.first] += it.second;
+    return *this;
+  }
+
+  //! Get the number of bytes of the given component (0 if it is not in the
+  //! report).
+  size_t Bytes(const std::string& component) const
+  {
+    std::map<std::string, size_t>::const_iterator it =
+        components.find(component);
+    return (it == components.end()) ? 0 : it->second;
+  }
+
+  //! Get the total number of bytes of all components.
+  size_t Total() const
+  {
+    size_t total = 0;
+    for (const auto& it : components)
+      total += it.second;
+    return total;
+  }
+
+  //! Get the components and their number of bytes.
+  const std::map<std::string, size_t>& Components() const
+  {
+    return components;
+  }
+
+  //! Return a printable version of the report, one component per line,
+  //! followed by the total.
+  std::string Print() const
+  {
+    std::ostringstream oss;
+    for (const auto& it : components)
+      oss << "  " << it.first << ": " << PrintBytes(it.second) << std::endl;
+    oss << "  total: " << PrintBytes(Total()) << std::endl;
+    return oss.str();
+  }
+
+  //! Return a human-readable version of the given number of bytes.
+  static std::string PrintBytes(const size_t bytes)
+  {
+    const char* units[] = { "B", "kB", "MB", "GB", "TB" };
+    double value = (double) bytes;
+    size_t unit = 0;
+    while (value >= 1024.0 && unit < 4)
+    {
+      value /= 1024.0;
+      ++unit;
+    }
+
+    std::ostringstream oss;
+    oss.precision(unit == 0 ? 0 : 2);
+    oss << std::fixed << value << " " << units[unit];
+    return oss.str();
+  }
+
+ private:
+  //! The number of bytes of each component.
+  std::map<std::string, size_t> components;
+};
+
+//! Return the number of bytes held by the elements of a dense matrix (or
+//! vector).
+template<typename eT>
+size_t MemoryOf(const arma::Mat<eT>& matrix)
+{
+  return matrix.n_elem * sizeof(eT);
+}
+
+#ifdef MLPACK_HAS_COOT
+//! Return the number of bytes held by the elements of a Bandicoot matrix (or
+//! vector), in the memory of the device.
+template<typename eT>
+size_t MemoryOf(const coot::Mat<eT>& matrix)
+{
+  return matrix.n_elem * sizeof(eT);
+}
+#endif
+
+//! Return the number of bytes held by the elements of a cube.
+template<typename eT>
+size_t MemoryOf(const arma::Cube<eT>& cube)
+{
+  return cube.n_elem * sizeof(eT);
+}
+
+//! Return the number of bytes held by a sparse matrix (its nonzero values,
+//! their row indices, and the column pointers).
+template<typename eT>
+size_t MemoryOf(const arma::SpMat<eT>& matrix)
+{
+  return matrix.n_nonzero * (sizeof(eT) + sizeof(arma::uword)) +
+      (matrix.n_cols + 1) * sizeof(arma::uword);
+}
+
+//! Return the number of bytes allocated by a vector (its capacity).
+template<typename T>
+size_t MemoryOf(const std::vector<T>& vector)
+{
+  return vector.capacity() * sizeof(T);
+}
+
+//! Return the number of bytes allocated by a vector of bools, which are
+//! packed.
+inline size_t MemoryOf(const std::vector<bool>& vector)
+{
+  return (vector.capacity() + 7) / 8;
+}
+
+/**
+ * Return the peak resident memory of the process so far, in bytes, or 0 if it
+ * is not available on this platform.  Since memory is rarely returned to the
+ * operating system, comparing it before and after a call to Train() bounds
+ * the memory that the training needed on top of what was already used.
+ */
+inline size_t PeakResidentMemory()
+{
+  #if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+      return 0;
+
+    #if defined(__APPLE__)
+      return (size_t) usage.ru_maxrss; // Bytes on macOS.
+    #else
+      return (size_t) usage.ru_maxrss * 1024; // Kilobytes on Linux and BSDs.
+    #endif
+  #else
+    return 0;
+  #endif
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ * @file core/util/parallel.hpp
+ *
+ * A thread budget for mlpack, and ParallelTasks(), which runs independent
+ * pieces of work as OpenMP tasks on one shared team of threads, so that
+ * parallel code that calls other parallel code does not oversubscribe the
+ * cores.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PARALLEL_HPP
+#define MLPACK_CORE_UTIL_PARALLEL_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <atomic>
+#include <exception>
+
+namespace mlpack {
+
+namespace util {
+
+//! The thread budget set with SetThreadBudget() (0 for the OpenMP default).
+inline std::atomic<size_t>& ThreadBudgetValue()
+{
+  static std::atomic<size_t> budget(0);
+  return budget;
+}
+
+} // namespace util
+
+/**
+ * Set the maximum number of threads that mlpack starts a team of threads with
+ * (in ParallelTasks() and in the other parallel regions that use
+ * ThreadBudget()).  If 0, the OpenMP default (omp_get_max_threads()) is used.
+ * This does not limit the threads of the BLAS library.
+ *
+ * @param threads Maximum number of threads.
+ */
+inline void SetThreadBudget(const size_t threads)
+{
+  util::ThreadBudgetValue() = threads;
+}
+
+/**
+ * Get the number of threads that mlpack starts a team of threads with: the
+ * budget set with SetThreadBudget(), or the OpenMP default, and 1 if mlpack was
+ * compiled without OpenMP.
+ */
+inline size_t ThreadBudget()
+{
+  #ifdef MLPACK_USE_OPENMP
+  const size_t budget = util::ThreadBudgetValue();
+  return (budget == 0) ? (size_t) omp_get_max_threads() : budget;
+  #else
+  return 1;
+  #endif
+}
+
+/**
+ * Call `f(i)` for each i in [0, n), with one OpenMP task for each call, and
+ * return when all the calls are done.  If the caller is not in a parallel
+ * region, a team of ThreadBudget() threads is started for the tasks; otherwise
+ * the tasks are added to the team of the caller.  So when `f()` itself calls
+ * ParallelTasks() (or creates OpenMP tasks, as DecisionTree does), the nested
+ * work is shared by the same threads: idle threads pick up pending tasks of
+ * any level, and the number of threads never exceeds the budget.
+ *
+ * An exception thrown by `f()` cannot leave a task, so the first one is
+ * rethrown once all the calls are done.
+ *
+ * @param n Number of calls.
+ * @param f Function to call, with the index of each call.
+ */
+template<typename FunctionType>
+void ParallelTasks(const size_t n, const FunctionType& f)
+{
+  std::exception_ptr exception;
+  auto run = [&](const size_t i)
+  {
+    try
+    {
+      f(i);
+    }
+    catch (...)
+    {
+      #pragma omp critical(mlpack_parallel_tasks)
+      {
+        if (!exception)
+          exception = std::current_exception();
+      }
+    }
+  };
+
+  #ifdef MLPACK_USE_OPENMP
+  if (n > 1 && omp_in_parallel())
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      #pragma omp task shared(run)
+      run(i);
+    }
+    #pragma omp taskwait
+  }
+  else if (n > 1 && ThreadBudget() > 1)
+  {
+    // The team has the whole budget even if n is small, since the calls may
+    // create more tasks.
+    #pragma omp parallel num_threads(ThreadBudget())
+    {
+      // The barrier at the end of the single region waits for the tasks.
+      #pragma omp single
+      {
+        for (size_t i = 0; i < n; ++i)
+        {
+          #pragma omp task shared(run)
+          run(i);
+        }
+      }
+    }
+  }
+  else
+  #endif
+  {
+    for (size_t i = 0; i < n; ++i)
+      run(i);
+  }
+
+  if (exception)
+    std::rethrow_exception(exception);
+}
+
+} // namespace mlpack
+
+#endif
@@ -490,6 +490,57 @@
 #define PARAM_UMATRIX_OUT(ID, DESC, ALIAS) \
     PARAM_UMATRIX(ID, DESC, ALIAS, false, true, false)
 
+/**
+ * Define a single-precision matrix input parameter (arma::fmat).  This is the
+ * same as PARAM_MATRIX_IN(), but the matrix is loaded with 32-bit floating
+ * point elements, which halves the memory used and the memory bandwidth needed
+ * for large datasets.  From the command line, the user can specify the file
+ * that holds the matrix, using the name of the matrix parameter with "_file"
+ * appended (and the same alias); from Python, a float32 array is passed
+ * without conversion.
+ *
+ * Single-precision matrix parameters are only supported by the command-line
+ * and Python bindings.
+ *
+ * @param ID Name of the parameter.
+ * @param DESC Description of the parameter (1-2 sentences).  Don't use
+ *      printing macros like PRINT_PARAM_STRING() or PRINT_DATASET() or others
+ *      here---it will cause problems.
+ * @param ALIAS An alias for the parameter (one letter).
+ */
+#define PARAM_FMATRIX_IN(ID, DESC, ALIAS) \
+    PARAM_FMATRIX(ID, DESC, ALIAS, false, true, true)
+
+/**
+ * Define a required single-precision matrix input parameter (arma::fmat).  See
+ * PARAM_FMATRIX_IN().
+ *
+ * @param ID Name of the parameter.
+ * @param DESC Description of the parameter (1-2 sentences).  Don't use
+ *      printing macros like PRINT_PARAM_STRING() or PRINT_DATASET() or others
+ *      here---it will cause problems.
+ * @param ALIAS An alias for the parameter (one letter).
+ */
+#define PARAM_FMATRIX_IN_REQ(ID, DESC, ALIAS) \
+    PARAM_FMATRIX(ID, DESC, ALIAS, true, true, true)
+
+/**
+ * Define a single-precision matrix output parameter (arma::fmat).  This is the
+ * same as PARAM_MATRIX_OUT(), but the matrix holds 32-bit floating point
+ * elements; from Python, it is returned as a float32 array.
+ *
+ * Single-precision matrix parameters are only supported by the command-line
+ * and Python bindings.
+ *
+ * @param ID Name of the parameter.
+ * @param DESC Description of the parameter (1-2 sentences).  Don't use
+ *      printing macros like PRINT_PARAM_STRING() or PRINT_DATASET() or others
+ *      here---it will cause problems.
+ * @param ALIAS An alias for the parameter (one letter).
+ */
+#define PARAM_FMATRIX_OUT(ID, DESC, ALIAS) \
+    PARAM_FMATRIX(ID, DESC, ALIAS, false, true, false)
+
 
 /**
  * Define a vector input parameter (type arma::vec).  From the command line, the
@@ -955,6 +1006,10 @@
     PARAM(arma::Mat<size_t>, ID, DESC, ALIAS, "arma::Mat<size_t>", \
         REQ, IN, TRANS, arma::Mat<size_t>());
 
+#define PARAM_FMATRIX(ID, DESC, ALIAS, REQ, TRANS, IN) \
+    PARAM(arma::fmat, ID, DESC, ALIAS, "arma::fmat", REQ, IN, \
+        TRANS, arma::fmat());
+
 #define PARAM_COL(ID, DESC, ALIAS, REQ, TRANS, IN) \
     PARAM(arma::vec, ID, DESC, ALIAS, "arma::vec", REQ, IN, TRANS, \
         arma::vec());
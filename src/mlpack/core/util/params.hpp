@@ -27,16 +27,18 @@ namespace util {
 class Params
 {
  public:
-  // Convenience typedef for function maps.
+  // Convenience typedefs for function maps.
+  using FunctionType = void (*)(ParamData&, const void*, void*);
   using FunctionMapType = std::map<std::string, std::map<std::string,
-      void (*)(ParamData&, const void*, void*)>>;
+      FunctionType>>;
 
   /**
    * Create a new Params class.  In general this should only be called via
-   * `IO::Parameters()`.
+   * `IO::Parameters()`.  The maps of aliases and parameters are taken by value,
+   * so they can be moved in.
    */
-  Params(const std::map<char, std::string>& aliases,
-         const std::map<std::string, ParamData>& parameters,
+  Params(std::map<char, std::string> aliases,
+         std::map<std::string, ParamData> parameters,
          FunctionMapType& functionMap,
          const std::string& bindingName,
          const BindingDetails& doc);
@@ -146,6 +148,25 @@ class Params
   //! Utility function, used by CheckInputMatrices().
   template<typename T>
   void CheckInputMatrix(const T& matrix, const std::string& identifier);
+
+  /**
+   * Find the parameter with the given name, or, if there is none and the name
+   * is a single character, the parameter that it is an alias of.  This is a
+   * single lookup in the map (two for an alias), and it does not insert
+   * anything; Log::Fatal is used if the parameter does not exist.
+   */
+  const ParamData& FindParameter(const std::string& identifier) const;
+  //! Find the parameter with the given name (or alias), as above.
+  ParamData& FindParameter(const std::string& identifier);
+
+  //! Make sure that the given parameter has type T (with Log::Fatal).
+  template<typename T>
+  void CheckType(const ParamData& d) const;
+
+  //! Get the function with the given name registered for the type of the
+  //! given parameter, or NULL if there is none.  Nothing is inserted in
+  //! `functionMap`.
+  FunctionType FindFunction(const ParamData& d, const std::string& name) const;
 };
 
 } // namespace util
@@ -22,14 +22,14 @@
 namespace mlpack {
 namespace util {
 
-inline Params::Params(const std::map<char, std::string>& aliases,
-                      const std::map<std::string, ParamData>& parameters,
+inline Params::Params(std::map<char, std::string> aliases,
+                      std::map<std::string, ParamData> parameters,
                       Params::FunctionMapType& functionMap,
                       const std::string& bindingName,
                       const BindingDetails& doc) :
-    // Copy all the given inputs.
-    aliases(aliases),
-    parameters(parameters),
+    // Take the maps, and copy the other inputs.
+    aliases(std::move(aliases)),
+    parameters(std::move(parameters)),
     functionMap(functionMap),
     bindingName(bindingName),
     doc(doc)
@@ -42,6 +42,62 @@ inline Params::Params()
   // Nothing to do.
 }
 
+inline const ParamData& Params::FindParameter(
+    const std::string& identifier) const
+{
+  std::map<std::string, ParamData>::const_iterator it =
+      parameters.find(identifier);
+
+  // Check any aliases, but only after we are sure the actual option as given
+  // does not exist.
+  // TODO: can we isolate alias support inside of the CLI binding code?
+  if (it == parameters.end() && identifier.length() == 1)
+  {
+    std::map<char, std::string>::const_iterator alias =
+        aliases.find(identifier[0]);
+    if (alias != aliases.end())
+      it = parameters.find(alias->second);
+  }
+
+  if (it == parameters.end())
+  {
+    Log::Fatal << "Parameter '" << identifier << "' does not exist in this "
+        << "program!" << std::endl;
+  }
+
+  return it->second;
+}
+
+inline ParamData& Params::FindParameter(const std::string& identifier)
+{
+  return const_cast<ParamData&>(
+      static_cast<const Params&>(*this).FindParameter(identifier));
+}
+
+template<typename T>
+void Params::CheckType(const ParamData& d) const
+{
+  // Compare against the mangled name directly; TYPENAME() builds a string.
+  if (d.tname != typeid(T).name())
+  {
+    Log::Fatal << "Attempted to access parameter '" << d.name << "' as type "
+        << TYPENAME(T) << ", but its true type is " << d.tname << "!"
+        << std::endl;
+  }
+}
+
+inline Params::FunctionType Params::FindFunction(const ParamData& d,
+                                                 const std::string& name) const
+{
+  FunctionMapType::const_iterator typeFunctions = functionMap.find(d.tname);
+  if (typeFunctions == functionMap.end())
+    return NULL;
+
+  std::map<std::string, FunctionType>::const_iterator f =
+      typeFunctions->second.find(name);
+  return (f == typeFunctions->second.end()) ? NULL : f->second;
+}
+
 /**
  * Return `true` if the specified parameter was given.
  *
@@ -49,25 +105,7 @@ inline Params::Params()
  */
 inline bool Params::Has(const std::string& key) const
 {
-  std::string usedKey = key;
-
-  if (!parameters.count(key))
-  {
-    // Check any aliases, but only after we are sure the actual option as given
-    // does not exist.
-    // TODO: can we isolate alias support inside of the CLI binding code?
-    if (key.length() == 1 && aliases.count(key[0]))
-      usedKey = aliases.at(key[0]);
-
-    if (!parameters.count(usedKey))
-    {
-      Log::Fatal << "Parameter '" << key << "' does not exist in this "
-          << "program." << std::endl;
-    }
-  }
-  const std::string& checkKey = usedKey;
-
-  return (parameters.at(checkKey).wasPassed > 0);
+  return (FindParameter(key).wasPassed > 0);
 }
 
 /**
@@ -79,29 +117,17 @@ inline bool Params::Has(const std::string& key) const
 template<typename T>
 T& Params::Get(const std::string& identifier)
 {
-  // TODO: can we remove the alias support here?
-  // Only use the alias if the parameter does not exist as given.
-  std::string key = (parameters.count(identifier) == 0 &&
-      identifier.length() == 1 && aliases.count(identifier[0])) ?
-      aliases[identifier[0]] : identifier;
-
-  if (parameters.count(key) == 0)
-    Log::Fatal << "Parameter '" << key << "' does not exist in this program!"
-        << std::endl;
-
-  ParamData& d = parameters[key];
+  ParamData& d = FindParameter(identifier);
 
   // Make sure the types are correct.
-  if (TYPENAME(T) != d.tname)
-    Log::Fatal << "Attempted to access parameter '" << key << "' as type "
-        << TYPENAME(T) << ", but its true type is " << d.tname << "!"
-        << std::endl;
+  CheckType<T>(d);
 
   // Do we have a special mapped function?
-  if (functionMap[d.tname].count("GetParam") != 0)
+  FunctionType getParam = FindFunction(d, "GetParam");
+  if (getParam != NULL)
   {
     T* output = NULL;
-    functionMap[d.tname]["GetParam"](d, NULL, (void*) &output);
+    getParam(d, NULL, (void*) &output);
     return *output;
   }
   else
@@ -121,29 +147,17 @@ T& Params::Get(const std::string& identifier)
 template<typename T>
 std::string Params::GetPrintable(const std::string& identifier)
 {
-  // TODO: can we remove the alias support here?
-  // Only use the alias if the parameter does not exist as given.
-  std::string key = ((parameters.count(identifier) == 0) &&
-      (identifier.length() == 1) && (aliases.count(identifier[0]) > 0)) ?
-      aliases[identifier[0]] : identifier;
-
-  if (parameters.count(key) == 0)
-    Log::Fatal << "Parameter '" << key << "' does not exist in this program!"
-        << std::endl;
-
-  ParamData& d = parameters[key];
+  ParamData& d = FindParameter(identifier);
 
   // Make sure the types are correct.
-  if (TYPENAME(T) != d.tname)
-    Log::Fatal << "Attempted to access parameter '" << key << "' as type "
-        << TYPENAME(T) << ", but its true type is " << d.tname << "!"
-        << std::endl;
+  CheckType<T>(d);
 
   // Do we have a special mapped function?
-  if (functionMap[d.tname].count("GetPrintableParam") != 0)
+  FunctionType getPrintableParam = FindFunction(d, "GetPrintableParam");
+  if (getPrintableParam != NULL)
   {
     std::string output;
-    functionMap[d.tname]["GetPrintableParam"](d, NULL, (void*) &output);
+    getPrintableParam(d, NULL, (void*) &output);
     return output;
   }
   else
@@ -167,29 +181,17 @@ std::string Params::GetPrintable(const std::string& identifier)
 template<typename T>
 T& Params::GetRaw(const std::string& identifier)
 {
-  // TODO: can we remove the alias support here?
-  // Only use the alias if the parameter does not exist as given.
-  std::string key = (parameters.count(identifier) == 0 &&
-      identifier.length() == 1 && aliases.count(identifier[0])) ?
-      aliases[identifier[0]] : identifier;
-
-  if (parameters.count(key) == 0)
-    Log::Fatal << "Parameter '" << key << "' does not exist in this program!"
-        << std::endl;
-
-  ParamData& d = parameters[key];
+  ParamData& d = FindParameter(identifier);
 
   // Make sure the types are correct.
-  if (TYPENAME(T) != d.tname)
-    Log::Fatal << "Attempted to access parameter '" << key << "' as type "
-        << TYPENAME(T) << ", but its true type is " << d.tname << "!"
-        << std::endl;
+  CheckType<T>(d);
 
   // Do we have a special mapped function?
-  if (functionMap[d.tname].count("GetRawParam") != 0)
+  FunctionType getRawParam = FindFunction(d, "GetRawParam");
+  if (getRawParam != NULL)
   {
     T* output = NULL;
-    functionMap[d.tname]["GetRawParam"](d, NULL, (void*) &output);
+    getRawParam(d, NULL, (void*) &output);
     return *output;
   }
   else
@@ -224,13 +226,17 @@ void Params::CheckInputMatrix(const T& matrix, const std::string& identifier)
 inline void Params::MakeInPlaceCopy(const std::string& outputParamName,
                                     const std::string& inputParamName)
 {
-  if (!parameters.count(outputParamName))
+  std::map<std::string, ParamData>::iterator outputIt =
+      parameters.find(outputParamName);
+  std::map<std::string, ParamData>::iterator inputIt =
+      parameters.find(inputParamName);
+  if (outputIt == parameters.end())
     Log::Fatal << "Unknown parameter '" << outputParamName << "'!" << std::endl;
-  if (!parameters.count(inputParamName))
+  if (inputIt == parameters.end())
     Log::Fatal << "Unknown parameter '" << inputParamName << "'!" << std::endl;
 
-  ParamData& output = parameters[outputParamName];
-  ParamData& input = parameters[inputParamName];
+  ParamData& output = outputIt->second;
+  ParamData& input = inputIt->second;
 
   if (output.cppType != input.cppType)
   {
@@ -239,10 +245,9 @@ inline void Params::MakeInPlaceCopy(const std::string& outputParamName,
   }
 
   // Is there a function to do this?
-  if (functionMap[output.tname].count("InPlaceCopy") != 0)
-  {
-    functionMap[output.tname]["InPlaceCopy"](output, (void*) &input, NULL);
-  }
+  FunctionType inPlaceCopy = FindFunction(output, "InPlaceCopy");
+  if (inPlaceCopy != NULL)
+    inPlaceCopy(output, (void*) &input, NULL);
 }
 
 /**
@@ -252,14 +257,15 @@ inline void Params::MakeInPlaceCopy(const std::string& outputParamName,
  */
 inline void Params::SetPassed(const std::string& name)
 {
-  if (parameters.count(name) == 0)
+  std::map<std::string, ParamData>::iterator it = parameters.find(name);
+  if (it == parameters.end())
   {
     throw std::invalid_argument("Params::SetPassed(): parameter " + name +
         " not known for binding " + bindingName + "!");
   }
 
   // Set passed to true.
-  parameters[name].wasPassed = true;
+  it->second.wasPassed = true;
 }
 
 /**
@@ -0,0 +1,383 @@
+/**
+ * @file core/util/profiler.hpp
+ *
+ * A low-overhead profiler for the hot paths of mlpack (tree traversals,
+ * per-batch loops), with static counters and scopes recorded in per-thread
+ * buffers, and Chrome trace export.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PROFILER_HPP
+#define MLPACK_CORE_UTIL_PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#ifndef MLPACK_NO_STD_MUTEX
+#include <mutex>
+#endif
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * The quantities counted by the Profiler.  Each counter has a static ID, so
+ * counting does not involve any lookup.
+ */
+enum class ProfileCounter : size_t
+{
+  //! Calls to BaseCase() of a rules class that computed a base case.
+  BaseCases = 0,
+  //! Calls to Score() of a rules class.
+  Scores,
+  //! Nodes (or node combinations) pruned by a traversal.
+  Prunes,
+  //! Distance (or kernel) evaluations between two points.
+  DistanceEvaluations,
+  //! The number of counters; not a counter.
+  NumCounters
+};
+
+/**
+ * Return the name of the given counter, as used in exported traces.
+ */
+inline const char* ProfileCounterName(const ProfileCounter counter)
+{
+  switch (counter)
+  {
+    case ProfileCounter::BaseCases:
+      return "base_cases";
+    case ProfileCounter::Scores:
+      return "scores";
+    case ProfileCounter::Prunes:
+      return "prunes";
+    case ProfileCounter::DistanceEvaluations:
+      return "distance_evaluations";
+    default:
+      return "unknown";
+  }
+}
+
+/**
+ * The Profiler holds counters and timed scopes recorded by the
+ * MLPACK_PROFILE_COUNT() and MLPACK_PROFILE_SCOPE() macros, which are placed
+ * inside mlpack's hot paths (the rules classes of the tree-based algorithms,
+ * for instance).  Unlike mlpack::Timer, which looks up timers by name in a map
+ * under a lock, everything is recorded in a buffer owned by the calling thread,
+ * and scopes are identified by static strings, so nothing is locked or looked
+ * up on the hot path.
+ *
+ * The macros do nothing unless MLPACK_ENABLE_PROFILING is defined before
+ * mlpack is included, so the instrumentation has no cost in regular builds.
+ *
+ * @code
+ * #define MLPACK_ENABLE_PROFILING
+ * #include <mlpack.hpp>
+ *
+ * KNN knn(referenceData);
+ * knn.Search(queryData, 5, neighbors, distances);
+ *
+ * std::cout << util::Profiler::Counter(util::ProfileCounter::BaseCases)
+ *     << " base cases." << std::endl;
+ * util::Profiler::ExportChromeTrace("knn.json");
+ * @endcode
+ *
+ * The exported file can be opened in chrome://tracing or Perfetto; it holds one
+ * event per profiled scope, per thread, and the totals of the counters in
+ * `otherData`.
+ *
+ * The results (Counter(), Counters(), ExportChromeTrace()) and Reset() must
+ * only be used while no profiled code is running.
+ */
+class Profiler
+{
+ public:
+  //! The counters of a thread, or their totals.
+  using CounterArray = std::array<size_t,
+      (size_t) ProfileCounter::NumCounters>;
+
+  /**
+   * Add n to the given counter of the calling thread.
+   */
+  static void Count(const ProfileCounter counter, const size_t n = 1)
+  {
+    std::atomic<size_t>& c = LocalBuffer().counters[(size_t) counter];
+    // Only the owning thread writes to the counter, so no atomic increment is
+    // needed.
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+  /**
+   * Record a scope of the calling thread that started at the given time and
+   * ended now.
+   *
+   * @param name Name of the scope; it must be a string with static storage
+   *     (usually a literal), since only the pointer is kept.
+   * @param start When the scope started.
+   */
+  static void AddScope(const char* name,
+                       const std::chrono::steady_clock::time_point start)
+  {
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+    LocalBuffer().events.push_back({ name, Microseconds(start),
+        std::chrono::duration<double, std::micro>(end - start).count() });
+  }
+
+  /**
+   * Return the total of the given counter over all threads.
+   */
+  static size_t Counter(const ProfileCounter counter)
+  {
+    return Counters()[(size_t) counter];
+  }
+
+  /**
+   * Return the totals of all counters over all threads.
+   */
+  static CounterArray Counters()
+  {
+    CounterArray totals;
+    totals.fill(0);
+
+    #ifndef MLPACK_NO_STD_MUTEX
+    std::lock_guard<std::mutex> lock(Mutex());
+    #endif
+    for (const std::unique_ptr<Buffer>& buffer : Buffers())
+      for (size_t i = 0; i < totals.size(); ++i)
+        totals[i] += buffer->counters[i].load(std::memory_order_relaxed);
+
+    return totals;
+  }
+
+  /**
+   * Reset all counters and drop all recorded scopes, for all threads.
+   */
+  static void Reset()
+  {
+    #ifndef MLPACK_NO_STD_MUTEX
+    std::lock_guard<std::mutex> lock(Mutex());
+    #endif
+    for (const std::unique_ptr<Buffer>& buffer : Buffers())
+    {
+      for (std::atomic<size_t>& c : buffer->counters)
+        c.store(0, std::memory_order_relaxed);
+      buffer->events.clear();
+    }
+  }
+
+  /**
+   * Write the recorded scopes and the counter totals to the given stream, in
+   * the JSON format of Chrome traces.
+   */
+  static void ExportChromeTrace(std::ostream& stream)
+  {
+    const CounterArray totals = Counters();
+
+    #ifndef MLPACK_NO_STD_MUTEX
+    std::lock_guard<std::mutex> lock(Mutex());
+    #endif
+    stream << "{\"traceEvents\":[";
+    bool first = true;
+    for (const std::unique_ptr<Buffer>& buffer : Buffers())
+    {
+      for (const Event& e : buffer->events)
+      {
+        stream << (first ? "\n" : ",\n") << "{\"name\":\"";
+        WriteEscaped(stream, e.name);
+        stream << "\",\"ph\":\"X\",\"ts\":" << e.start << ",\"dur\":"
+            << e.duration << ",\"pid\":0,\"tid\":" << buffer->thread << "}";
+        first = false;
+      }
+    }
+
+    stream << "\n],\"otherData\":{";
+    for (size_t i = 0; i < totals.size(); ++i)
+    {
+      stream << (i == 0 ? "" : ",") << "\""
+          << ProfileCounterName((ProfileCounter) i) << "\":" << totals[i];
+    }
+    stream << "}}" << std::endl;
+  }
+
+  /**
+   * Write the recorded scopes and the counter totals to the given file, in the
+   * JSON format of Chrome traces.  A std::runtime_error is thrown if the file
+   * cannot be opened.
+   */
+  static void ExportChromeTrace(const std::string& filename)
+  {
+    std::ofstream stream(filename);
+    if (!stream.is_open())
+    {
+      throw std::runtime_error("Profiler::ExportChromeTrace(): cannot open "
+          "file '" + filename + "' for writing");
+    }
+
+    ExportChromeTrace(stream);
+  }
+
+  //! Return the start of the trace (the first use of the profiler); the times
+  //! of the exported scopes are relative to it.
+  static std::chrono::steady_clock::time_point Epoch()
+  {
+    static const std::chrono::steady_clock::time_point epoch =
+        std::chrono::steady_clock::now();
+    return epoch;
+  }
+
+ private:
+  //! A profiled scope.
+  struct Event
+  {
+    //! Name of the scope.
+    const char* name;
+    //! Start of the scope, in microseconds since the start of the trace.
+    double start;
+    //! Duration of the scope, in microseconds.
+    double duration;
+  };
+
+  //! The results recorded by one thread.
+  struct Buffer
+  {
+    Buffer(const size_t thread) : thread(thread)
+    {
+      for (std::atomic<size_t>& c : counters)
+        c.store(0, std::memory_order_relaxed);
+    }
+
+    //! Identifier of the thread in the traces.
+    size_t thread;
+    //! Counters of the thread.  Only the owning thread writes to them, but
+    //! they are atomic so that they can be read at any time.
+    std::array<std::atomic<size_t>, (size_t) ProfileCounter::NumCounters>
+        counters;
+    //! Scopes recorded by the thread.
+    std::vector<Event> events;
+  };
+
+  //! Return the buffer of the calling thread, creating it at the first call.
+  static Buffer& LocalBuffer()
+  {
+    // The buffers outlive their threads, so results are not lost when a thread
+    // exits.
+    thread_local Buffer* buffer = Register();
+    return *buffer;
+  }
+
+  //! Create and register a buffer for a new thread.
+  static Buffer* Register()
+  {
+    #ifndef MLPACK_NO_STD_MUTEX
+    std::lock_guard<std::mutex> lock(Mutex());
+    #endif
+    std::vector<std::unique_ptr<Buffer>>& buffers = Buffers();
+    buffers.emplace_back(new Buffer(buffers.size()));
+    return buffers.back().get();
+  }
+
+  //! Return the time point as microseconds since the start of the trace.
+  static double Microseconds(const std::chrono::steady_clock::time_point t)
+  {
+    return std::chrono::duration<double, std::micro>(t - Epoch()).count();
+  }
+
+  //! Write a string to a JSON stream, escaping the characters that need it.
+  static void WriteEscaped(std::ostream& stream, const char* s)
+  {
+    for (; *s != '\0'; ++s)
+    {
+      if (*s == '"' || *s == '\\')
+        stream << '\\';
+      stream << *s;
+    }
+  }
+
+  //! The buffers of all threads that recorded anything.
+  static std::vector<std::unique_ptr<Buffer>>& Buffers()
+  {
+    static std::vector<std::unique_ptr<Buffer>> buffers;
+    return buffers;
+  }
+
+  #ifndef MLPACK_NO_STD_MUTEX
+  //! Lock for the list of buffers; it is only taken when a thread records its
+  //! first result, and when the results are read.
+  static std::mutex& Mutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+  #endif
+};
+
+/**
+ * A ProfileScope records the time between its construction and its destruction
+ * as a scope of the Profiler.  Use it through MLPACK_PROFILE_SCOPE().
+ */
+class ProfileScope
+{
+ public:
+  /**
+   * Start the scope.
+   *
+   * @param name Name of the scope; it must be a string with static storage
+   *     (usually a literal).
+   */
+  ProfileScope(const char* name) : name(name)
+  {
+    // Make sure that the trace does not start after the scope.
+    Profiler::Epoch();
+    start = std::chrono::steady_clock::now();
+  }
+
+  //! Record the scope.
+  ~ProfileScope() { Profiler::AddScope(name, start); }
+
+  ProfileScope(const ProfileScope& other) = delete;
+  ProfileScope& operator=(const ProfileScope& other) = delete;
+
+ private:
+  //! Name of the scope.
+  const char* name;
+  //! When the scope started.
+  std::chrono::steady_clock::time_point start;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#define MLPACK_PROFILE_JOIN_INNER(A, B) A ## B
+#define MLPACK_PROFILE_JOIN(A, B) MLPACK_PROFILE_JOIN_INNER(A, B)
+
+#ifdef MLPACK_ENABLE_PROFILING
+  /**
+   * Record the time until the end of the enclosing block as a scope with the
+   * given name (a string literal), if MLPACK_ENABLE_PROFILING is defined.
+   */
+  #define MLPACK_PROFILE_SCOPE(NAME) \
+      mlpack::util::ProfileScope MLPACK_PROFILE_JOIN(mlpackProfileScope, \
+          __LINE__)(NAME)
+
+  /**
+   * Add N to the given mlpack::util::ProfileCounter (e.g. `BaseCases`), if
+   * MLPACK_ENABLE_PROFILING is defined.
+   */
+  #define MLPACK_PROFILE_COUNT(COUNTER, N) \
+      mlpack::util::Profiler::Count(mlpack::util::ProfileCounter::COUNTER, N)
+#else
+  #define MLPACK_PROFILE_SCOPE(NAME) ((void) 0)
+  #define MLPACK_PROFILE_COUNT(COUNTER, N) ((void) 0)
+#endif
+
+#endif
@@ -78,7 +78,7 @@ using coot::zeros;
 #endif
 
 // By default, assume that we are using an Armadillo object.
-template<typename MatType>
+template<typename MatType, typename = void>
 struct GetFillType
 {
   static constexpr const decltype(arma::fill::none)& none   = arma::fill::none;
@@ -90,10 +90,9 @@ struct GetFillType
 
 #ifdef MLPACK_HAS_COOT
 // If the matrix type is a Bandicoot type, use Bandicoot fill objects instead.
-template<
-    typename MatType,
-    typename = std::enable_if_t<is_coot_type<MatType>::value>*>
-struct GetFillType
+template<typename MatType>
+struct GetFillType<MatType,
+    std::enable_if_t<coot::is_coot_type<MatType>::value>>
 {
   static constexpr const decltype(coot::fill::none)& none   = coot::fill::none;
   static constexpr const decltype(coot::fill::zeros)& zeros = coot::fill::zeros;
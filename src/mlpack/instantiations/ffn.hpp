@@ -0,0 +1,42 @@
+/**
+ * @file instantiations/ffn.hpp
+ *
+ * Explicit instantiations of FFN with the negative log-likelihood and mean
+ * squared error losses, and of the common layers (Linear, Dropout, ReLU,
+ * Sigmoid, TanH, LogSoftMax and Softmax) on dense matrices.  Train() is a
+ * template over the optimizer, so it is still compiled by the programs that
+ * call it.  See instantiations.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_INSTANTIATIONS_FFN_HPP
+#define MLPACK_INSTANTIATIONS_FFN_HPP
+
+#include <mlpack/methods/ann.hpp>
+
+// Outside of libmlpack_instantiations the instantiations are only declared.
+#ifndef MLPACK_INSTANTIATE
+  #define MLPACK_INSTANTIATE extern template
+#endif
+
+namespace mlpack {
+
+MLPACK_INSTANTIATE class FFN<NegativeLogLikelihood, RandomInitialization,
+    arma::mat>;
+MLPACK_INSTANTIATE class FFN<MeanSquaredError, RandomInitialization,
+    arma::mat>;
+
+MLPACK_INSTANTIATE class LinearType<arma::mat, NoRegularizer>;
+MLPACK_INSTANTIATE class DropoutType<arma::mat>;
+MLPACK_INSTANTIATE class BaseLayer<RectifierFunction, arma::mat>;
+MLPACK_INSTANTIATE class BaseLayer<LogisticFunction, arma::mat>;
+MLPACK_INSTANTIATE class BaseLayer<TanhFunction, arma::mat>;
+MLPACK_INSTANTIATE class LogSoftMaxType<arma::mat>;
+MLPACK_INSTANTIATE class SoftmaxType<arma::mat>;
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,32 @@
+/**
+ * @file instantiations/instantiations.hpp
+ *
+ * Declarations of the explicit instantiations compiled into
+ * libmlpack_instantiations.
+ *
+ * mlpack is header-only, so every program that uses, e.g., KNN compiles all of
+ * it.  When mlpack is configured with -DBUILD_INSTANTIATIONS=ON, the common
+ * configurations listed in the headers included here are compiled once, into
+ * libmlpack_instantiations.  A program that includes this file after the mlpack
+ * headers (or just includes this file), and links against
+ * libmlpack_instantiations, uses those compiled instantiations instead of
+ * compiling its own, which makes it faster to build and smaller.
+ *
+ * The library must be built with the same compiler options and the same mlpack
+ * configuration macros (for instance MLPACK_ENABLE_ANN_SERIALIZATION, or
+ * OpenMP support) as the programs that link against it.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_INSTANTIATIONS_INSTANTIATIONS_HPP
+#define MLPACK_INSTANTIATIONS_INSTANTIATIONS_HPP
+
+#include "neighbor_search.hpp"
+#include "random_forest.hpp"
+#include "kmeans.hpp"
+#include "ffn.hpp"
+
+#endif
@@ -0,0 +1,12 @@
+/**
+ * @file instantiations/kmeans.cpp
+ *
+ * Compile the instantiations declared in kmeans.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#define MLPACK_INSTANTIATE template
+#include "kmeans.hpp"
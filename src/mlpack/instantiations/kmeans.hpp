@@ -0,0 +1,37 @@
+/**
+ * @file instantiations/kmeans.hpp
+ *
+ * Explicit instantiations of KMeans with its default policies and the naive,
+ * Elkan and Hamerly Lloyd steps, and of those steps.  See instantiations.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_INSTANTIATIONS_KMEANS_HPP
+#define MLPACK_INSTANTIATIONS_KMEANS_HPP
+
+#include <mlpack/methods/kmeans.hpp>
+
+// Outside of libmlpack_instantiations the instantiations are only declared.
+#ifndef MLPACK_INSTANTIATE
+  #define MLPACK_INSTANTIATE extern template
+#endif
+
+namespace mlpack {
+
+MLPACK_INSTANTIATE class NaiveKMeans<EuclideanDistance, arma::mat>;
+MLPACK_INSTANTIATE class ElkanKMeans<EuclideanDistance, arma::mat>;
+MLPACK_INSTANTIATE class HamerlyKMeans<EuclideanDistance, arma::mat>;
+
+MLPACK_INSTANTIATE class KMeans<EuclideanDistance, SampleInitialization,
+    MaxVarianceNewCluster, NaiveKMeans, arma::mat>;
+MLPACK_INSTANTIATE class KMeans<EuclideanDistance, SampleInitialization,
+    MaxVarianceNewCluster, ElkanKMeans, arma::mat>;
+MLPACK_INSTANTIATE class KMeans<EuclideanDistance, SampleInitialization,
+    MaxVarianceNewCluster, HamerlyKMeans, arma::mat>;
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,33 @@
+/**
+ * @file instantiations/neighbor_search.hpp
+ *
+ * Explicit instantiations of NeighborSearch for k-nearest-neighbor search with
+ * kd-trees and cover trees.  See instantiations.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_INSTANTIATIONS_NEIGHBOR_SEARCH_HPP
+#define MLPACK_INSTANTIATIONS_NEIGHBOR_SEARCH_HPP
+
+#include <mlpack/methods/neighbor_search.hpp>
+
+// Outside of libmlpack_instantiations the instantiations are only declared.
+#ifndef MLPACK_INSTANTIATE
+  #define MLPACK_INSTANTIATE extern template
+#endif
+
+namespace mlpack {
+
+// KNN.
+MLPACK_INSTANTIATE class NeighborSearch<NearestNeighborSort, EuclideanDistance,
+    arma::mat, KDTree>;
+// KNN with cover trees.
+MLPACK_INSTANTIATE class NeighborSearch<NearestNeighborSort, EuclideanDistance,
+    arma::mat, StandardCoverTree>;
+
+} // namespace mlpack
+
+#endif
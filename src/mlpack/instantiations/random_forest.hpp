@@ -0,0 +1,82 @@
+/**
+ * @file instantiations/random_forest.hpp
+ *
+ * Explicit instantiations of the default RandomForest, for training and
+ * classification on dense matrices.  The training and classification functions
+ * are templates, so they are instantiated explicitly, in addition to the class.
+ * See instantiations.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_INSTANTIATIONS_RANDOM_FOREST_HPP
+#define MLPACK_INSTANTIATIONS_RANDOM_FOREST_HPP
+
+#include <mlpack/methods/random_forest.hpp>
+
+// Outside of libmlpack_instantiations the instantiations are only declared.
+#ifndef MLPACK_INSTANTIATE
+  #define MLPACK_INSTANTIATE extern template
+#endif
+
+namespace mlpack {
+
+MLPACK_INSTANTIATE class RandomForest<>;
+
+MLPACK_INSTANTIATE double RandomForest<>::Train(
+    const arma::mat& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const size_t numTrees,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    const bool warmStart,
+    MultipleRandomDimensionSelect dimensionSelector);
+
+MLPACK_INSTANTIATE double RandomForest<>::Train(
+    const arma::mat& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& weights,
+    const size_t numTrees,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    const bool warmStart,
+    MultipleRandomDimensionSelect dimensionSelector);
+
+MLPACK_INSTANTIATE double RandomForest<>::Train(
+    const arma::mat& data,
+    const data::DatasetInfo& datasetInfo,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const size_t numTrees,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    const bool warmStart,
+    MultipleRandomDimensionSelect dimensionSelector);
+
+MLPACK_INSTANTIATE size_t RandomForest<>::Classify(const arma::vec& point)
+    const;
+
+MLPACK_INSTANTIATE void RandomForest<>::Classify(
+    const arma::vec& point,
+    size_t& prediction,
+    arma::vec& probabilities) const;
+
+MLPACK_INSTANTIATE void RandomForest<>::Classify(
+    const arma::mat& data,
+    arma::Row<size_t>& predictions) const;
+
+MLPACK_INSTANTIATE void RandomForest<>::Classify(
+    const arma::mat& data,
+    arma::Row<size_t>& predictions,
+    arma::mat& probabilities) const;
+
+} // namespace mlpack
+
+#endif
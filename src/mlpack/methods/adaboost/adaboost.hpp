@@ -247,6 +247,10 @@ class AdaBoost
   void Classify(const MatType& test,
                 arma::Row<size_t>& predictedLabels) const;
 
+  //! The number of points classified by all weak learners at once by
+  //! Classify(); blocks of points are classified in parallel.
+  static const size_t ClassifyBlockSize = 1024;
+
   /**
    * Classify the given test points.
    *
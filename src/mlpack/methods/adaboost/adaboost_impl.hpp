@@ -190,21 +190,33 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
   probabilities.zeros(numClasses, test.n_cols);
   predictedLabels.set_size(test.n_cols);
 
-  for (size_t i = 0; i < wl.size(); ++i)
+  // All the weak learners classify one block of points before moving to the
+  // next block, so that the block stays in cache; blocks are classified in
+  // parallel.
+  const size_t numBlocks = (test.n_cols + ClassifyBlockSize - 1) /
+      ClassifyBlockSize;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < numBlocks; ++b)
   {
-    wl[i].Classify(test, predictedLabels);
+    const size_t begin = b * ClassifyBlockSize;
+    const size_t end = std::min(begin + ClassifyBlockSize,
+        (size_t) test.n_cols);
+    const MatType block = test.cols(begin, end - 1);
+    arma::Row<size_t> blockLabels;
 
-    for (size_t j = 0; j < predictedLabels.n_cols; ++j)
-      probabilities(predictedLabels(j), j) += alpha[i];
-  }
+    for (size_t i = 0; i < wl.size(); ++i)
+    {
+      wl[i].Classify(block, blockLabels);
 
-  arma::uword maxIndex = 0;
+      for (size_t j = 0; j < blockLabels.n_elem; ++j)
+        probabilities(blockLabels[j], begin + j) += alpha[i];
+    }
 
-  for (size_t i = 0; i < predictedLabels.n_cols; ++i)
-  {
-    probabilities.col(i) /= accu(probabilities.col(i));
-    maxIndex = probabilities.col(i).index_max();
-    predictedLabels(i) = maxIndex;
+    for (size_t j = begin; j < end; ++j)
+    {
+      probabilities.col(j) /= accu(probabilities.col(j));
+      predictedLabels(j) = probabilities.col(j).index_max();
+    }
   }
 }
 
@@ -389,6 +401,7 @@ typename MatType::elem_type AdaBoost<WeakLearnerType, MatType>::TrainInternal(
     w.Classify(tempData, predictedLabels);
 
     // Now, calculate alpha(t) using ht.
+    #pragma omp parallel for reduction(+:rt) schedule(static)
     for (size_t j = 0; j < D.n_cols; ++j) // instead of D, ht
     {
       if (predictedLabels(j) == labels(j))
@@ -418,10 +431,12 @@ typename MatType::elem_type AdaBoost<WeakLearnerType, MatType>::TrainInternal(
     alpha.push_back(alphat);
     wl.push_back(w);
 
-    // Now start modifying the weights.
+    // Now start modifying the weights.  Each point only modifies its own
+    // column, so this is done in parallel over points.
+    const ElemType expo = std::exp(alphat);
+    #pragma omp parallel for reduction(+:zt) schedule(static)
     for (size_t j = 0; j < D.n_cols; ++j)
     {
-      const ElemType expo = std::exp(alphat);
       if (predictedLabels(j) == labels(j))
       {
         for (size_t k = 0; k < D.n_rows; ++k)
@@ -74,7 +74,7 @@ class NMFALSUpdate
   {
     // The call to inv() sometimes fails; so we are using the psuedoinverse.
     // W = (inv(H * H.t()) * H * V.t()).t();
-    W = V * H.t() * pinv(H * H.t());
+    W = (V * H.t()) * pinv(H * H.t());
 
     // Set all negative numbers to machine epsilon.
     for (size_t i = 0; i < W.n_elem; ++i)
@@ -105,7 +105,7 @@ class NMFALSUpdate
                              const WHMatType& W,
                              WHMatType& H)
   {
-    H = pinv(W.t() * W) * W.t() * V;
+    H = pinv(W.t() * W) * (W.t() * V);
 
     // Set all negative numbers to 0.
     for (size_t i = 0; i < H.n_elem; ++i)
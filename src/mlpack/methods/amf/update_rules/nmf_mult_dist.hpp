@@ -70,8 +70,9 @@ class NMFMultiplicativeDistanceUpdate
                              WHMatType& W,
                              const WHMatType& H)
   {
-    WHMatType zz = W * H * H.t();
-    W = (W % (V * H.t())) / (W * H * H.t() + 1e-15);
+    // W (H H^T) only needs the small r x r product H H^T; this is much cheaper
+    // than forming W H.  V H^T costs O(nnz * r) when V is sparse.
+    W %= (V * H.t()) / (W * (H * H.t()) + 1e-15);
   }
 
   /**
@@ -93,8 +94,8 @@ class NMFMultiplicativeDistanceUpdate
                              const WHMatType& W,
                              WHMatType& H)
   {
-    WHMatType zz = W.t() * W * H;
-    H = (H % (W.t() * V)) / (W.t() * W * H + 1e-15);
+    // As in WUpdate(), W^T W is only r x r.
+    H %= (W.t() * V) / ((W.t() * W) * H + 1e-15);
   }
 
   //! Serialize the object (in this case, there is nothing to serialize).
@@ -40,9 +40,12 @@ namespace mlpack {
  * is non-increasing between subsequent iterations. Both of the update rules
  * for W and H are defined in this file.
  *
- * This set of update rules is not meant to work with sparse matrices.  Using
- * sparse matrices often causes NaNs in the output, so other choices of update
- * rules are better in that situation.
+ * For dense matrices, the ratios V / (W H) are computed for blocks of columns
+ * at a time (in parallel, if OpenMP is available), so that W H is never held in
+ * memory in full.  For sparse matrices, the ratios are zero wherever V is zero,
+ * so they are only computed at the nonzero elements of V, and the cost of an
+ * iteration is linear in the number of nonzero elements instead of in the size
+ * of V.
  */
 class NMFMultiplicativeDivergenceUpdate
 {
@@ -80,9 +83,47 @@ class NMFMultiplicativeDivergenceUpdate
                              WHMatType& W,
                              const WHMatType& H)
   {
-    // Simple implementation left in the header file.
-    W %= ((V / (W * H + 1e-15)) * H.t()) /
-        (repmat(sum(H, 1).t(), W.n_rows, 1) + 1e-15);
+    // Accumulate (V / (W H)) H^T one block of columns at a time.
+    WHMatType numerator(W.n_rows, W.n_cols, arma::fill::zeros);
+    const size_t numBlocks = (V.n_cols + blockSize - 1) / blockSize;
+
+    #pragma omp parallel
+    {
+      WHMatType threadNumerator(W.n_rows, W.n_cols, arma::fill::zeros);
+      WHMatType ratio;
+
+      #pragma omp for schedule(static) nowait
+      for (size_t block = 0; block < numBlocks; ++block)
+      {
+        const size_t begin = block * blockSize;
+        const size_t end = std::min(begin + blockSize, (size_t) V.n_cols) - 1;
+        ratio = V.cols(begin, end) / (W * H.cols(begin, end) + 1e-15);
+        threadNumerator += ratio * H.cols(begin, end).t();
+      }
+
+      #pragma omp critical
+      numerator += threadNumerator;
+    }
+
+    W %= numerator.each_row() / (sum(H, 1).t() + 1e-15);
+  }
+
+  /**
+   * The update rule for the basis matrix W, for sparse input matrices.  This is
+   * the same as the rule for dense matrices, but the ratios V / (W H) are only
+   * computed at the nonzero elements of V.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix.
+   */
+  template<typename eT, typename WHMatType>
+  inline static void WUpdate(const arma::SpMat<eT>& V,
+                             WHMatType& W,
+                             const WHMatType& H)
+  {
+    const arma::SpMat<eT> ratio = SparseRatio(V, W, H);
+    W %= (ratio * H.t()).eval().each_row() / (sum(H, 1).t() + 1e-15);
   }
 
   /**
@@ -105,14 +146,83 @@ class NMFMultiplicativeDivergenceUpdate
                              const WHMatType& W,
                              WHMatType& H)
   {
-    // Simple implementation left in the header file.
-    H %= (W.t() * (V / (W * H + 1e-15))) /
-        (repmat(sum(W, 0).t(), 1, H.n_cols) + 1e-15);
+    // Each block of columns of H only depends on the same block of columns of
+    // V, so the blocks can be updated independently.
+    const arma::Col<typename WHMatType::elem_type> denominator =
+        sum(W, 0).t() + 1e-15;
+    const size_t numBlocks = (V.n_cols + blockSize - 1) / blockSize;
+
+    #pragma omp parallel
+    {
+      WHMatType ratio;
+
+      #pragma omp for schedule(static)
+      for (size_t block = 0; block < numBlocks; ++block)
+      {
+        const size_t begin = block * blockSize;
+        const size_t end = std::min(begin + blockSize, (size_t) V.n_cols) - 1;
+        ratio = V.cols(begin, end) / (W * H.cols(begin, end) + 1e-15);
+        H.cols(begin, end) %= (W.t() * ratio).eval().each_col() /
+            denominator;
+      }
+    }
+  }
+
+  /**
+   * The update rule for the encoding matrix H, for sparse input matrices.  This
+   * is the same as the rule for dense matrices, but the ratios V / (W H) are
+   * only computed at the nonzero elements of V.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix.
+   * @param H Encoding matrix to updated.
+   */
+  template<typename eT, typename WHMatType>
+  inline static void HUpdate(const arma::SpMat<eT>& V,
+                             const WHMatType& W,
+                             WHMatType& H)
+  {
+    const arma::SpMat<eT> ratio = SparseRatio(V, W, H);
+    H %= (W.t() * ratio).eval().each_col() / (sum(W, 0).t() + 1e-15);
   }
 
   //! Serialize the object (in this case, there is nothing to serialize).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
+
+ private:
+  //! Number of columns of V in each block of the dense updates.
+  static constexpr size_t blockSize = 256;
+
+  /**
+   * Compute V / (W H) at the nonzero elements of the sparse matrix V.  The
+   * result has the same sparsity pattern as V.
+   */
+  template<typename eT, typename WHMatType>
+  static arma::SpMat<eT> SparseRatio(const arma::SpMat<eT>& V,
+                                     const WHMatType& W,
+                                     const WHMatType& H)
+  {
+    V.sync();
+
+    // Element (i, j) of W H is the dot product of row i of W and column j of
+    // H; rows of W are contiguous in its transpose.
+    const WHMatType Wt = W.t();
+    arma::Col<eT> values(V.n_nonzero);
+
+    #pragma omp parallel for schedule(static)
+    for (size_t j = 0; j < (size_t) V.n_cols; ++j)
+    {
+      for (size_t k = V.col_ptrs[j]; k < (size_t) V.col_ptrs[j + 1]; ++k)
+      {
+        values[k] = V.values[k] / (arma::dot(Wt.col(V.row_indices[k]),
+            H.col(j)) + 1e-15);
+      }
+    }
+
+    return arma::SpMat<eT>(arma::uvec(V.row_indices, V.n_nonzero),
+        arma::uvec(V.col_ptrs, V.n_cols + 1), values, V.n_rows, V.n_cols);
+  }
 };
 
 } // namespace mlpack
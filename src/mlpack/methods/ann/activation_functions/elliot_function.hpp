@@ -59,7 +59,7 @@ class ElliotFunction
   template <typename InputVecType, typename OutputVecType>
   static void Fn(const InputVecType &x, OutputVecType &y)
   {
-    y = x / (1.0 + arma::abs(x));
+    y = x / (1.0 + abs(x));
   }
 
   /**
@@ -86,7 +86,7 @@ class ElliotFunction
                     const OutputVecType& /* y */,
                     DerivVecType &dy)
   {
-    dy = 1.0 / pow(1.0 + arma::abs(x), 2);
+    dy = 1.0 / pow(1.0 + abs(x), 2);
   }
 }; // class ElliotFunction
 
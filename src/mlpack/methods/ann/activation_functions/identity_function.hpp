@@ -76,7 +76,7 @@ class IdentityFunction
                     const OutputVecType& /* y */,
                     DerivVecType& dy)
   {
-    dy.ones(arma::size(x));
+    dy.ones(size(x));
   }
 
   /**
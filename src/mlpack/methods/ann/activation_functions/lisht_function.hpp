@@ -61,7 +61,7 @@ class LiSHTFunction
   template <typename InputVecType, typename OutputVecType>
   static void Fn(const InputVecType &x, OutputVecType &y)
   {
-    y = x % arma::tanh(x);
+    y = x % tanh(x);
   }
 
   /**
@@ -88,7 +88,7 @@ class LiSHTFunction
                     const OutputVecType& /* y */,
                     DerivVecType& dy)
   {
-    dy = arma::tanh(x) + x % (1 - pow(arma::tanh(x), 2));
+    dy = tanh(x) + x % (1 - pow(tanh(x), 2));
   }
 }; // class LishtFunction
 
@@ -65,7 +65,7 @@ class SoftplusFunction
   template<typename InputType, typename OutputType>
   static void Fn(const InputType& x, OutputType& y)
   {
-    y.set_size(arma::size(x));
+    y.set_size(size(x));
 
     for (size_t i = 0; i < x.n_elem; ++i)
       y(i) = Fn(x(i));
@@ -121,7 +121,7 @@ class SoftplusFunction
   template<typename InputType, typename OutputType>
   static void Inv(const InputType& y, OutputType& x)
   {
-    x.set_size(arma::size(y));
+    x.set_size(size(y));
 
     for (size_t i = 0; i < y.n_elem; ++i)
       x(i) = Inv(y(i));
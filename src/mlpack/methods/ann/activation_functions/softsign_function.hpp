@@ -68,7 +68,7 @@ class SoftsignFunction
   template<typename InputVecType, typename OutputVecType>
   static void Fn(const InputVecType& x, OutputVecType& y)
   {
-    y.set_size(arma::size(x));
+    y.set_size(size(x));
 
     for (size_t i = 0; i < x.n_elem; ++i)
       y(i) = Fn(x(i));
@@ -98,7 +98,7 @@ class SoftsignFunction
                     const OutputVecType& /* y */,
                     DerivVecType& dy)
   {
-    dy = 1.0 / pow(1.0 + arma::abs(x), 2);
+    dy = 1.0 / pow(1.0 + abs(x), 2);
   }
 
   /**
@@ -124,7 +124,7 @@ class SoftsignFunction
   template<typename InputVecType, typename OutputVecType>
   static void Inv(const InputVecType& y, OutputVecType& x)
   {
-    x.set_size(arma::size(y));
+    x.set_size(size(y));
 
     for (size_t i = 0; i < y.n_elem; ++i)
       x(i) = Inv(y(i));
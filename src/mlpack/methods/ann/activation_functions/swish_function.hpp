@@ -64,7 +64,7 @@ class SwishFunction
   static void Fn(const VecType& x, VecType& y,
       const typename std::enable_if_t<IsVector<VecType>::value>* = 0)
   {
-    y.set_size(arma::size(x));
+    y.set_size(size(x));
 
     for (size_t i = 0; i < x.n_elem; ++i)
       y(i) = Fn(x(i));
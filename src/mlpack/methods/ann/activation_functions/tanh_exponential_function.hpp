@@ -62,7 +62,7 @@ class TanhExpFunction
   template<typename InputVecType, typename OutputVecType>
   static void Fn(const InputVecType& x, OutputVecType& y)
   {
-    y = x % arma::tanh(exp(x));
+    y = x % tanh(exp(x));
   }
 
   /**
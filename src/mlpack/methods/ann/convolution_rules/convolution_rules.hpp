@@ -15,7 +15,9 @@
 
 #include "border_modes.hpp"
 #include "fft_convolution.hpp"
+#include "im2col_convolution.hpp"
 #include "naive_convolution.hpp"
 #include "svd_convolution.hpp"
+#include "winograd_convolution.hpp"
 
 #endif
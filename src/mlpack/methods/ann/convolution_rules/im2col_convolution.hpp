@@ -0,0 +1,494 @@
+/**
+ * @file methods/ann/convolution_rules/im2col_convolution.hpp
+ *
+ * Implementation of the convolution through im2col lowering and matrix
+ * multiplication.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/make_alias.hpp>
+#include "border_modes.hpp"
+
+namespace mlpack {
+
+/**
+ * Computes the two-dimensional convolution by lowering the input into a matrix
+ * of patches ("im2col"), so that the convolution becomes a single matrix
+ * multiplication that is handled by BLAS.  This class allows specification of
+ * the type of the border type. The convolution can be computed with the valid
+ * border type or the full border type (default).
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * Like the other convolution rules, Convolution() computes a single
+ * two-dimensional convolution.  In addition, ForwardBatch(), BackwardBatch()
+ * and GradientBatch() compute the three passes of a convolution layer for all
+ * the input maps, output maps and points of a batch at once: the whole batch
+ * is lowered into one patch matrix, which is multiplied with the matrix of all
+ * the filters.  The Convolution and GroupedConvolution layers use these when
+ * they are given this convolution rule.
+ *
+ * In all functions, `dW` and `dilationW` are the stride and dilation along the
+ * columns, and `dH` and `dilationH` are the stride and dilation along the rows,
+ * like for NaiveConvolution.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class Im2ColConvolution
+{
+ public:
+  /**
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename InMatType, typename FilMatType, typename OutMatType,
+      typename Border = BorderMode>
+  static std::enable_if_t<std::is_same_v<Border, ValidConvolution>, void>
+  Convolution(const InMatType& input,
+              const FilMatType& filter,
+              OutMatType& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false,
+              const typename std::enable_if_t<IsMatrix<InMatType>::value>* = 0)
+  {
+    using MatType = typename GetDenseMatType<InMatType>::type;
+
+    // See NaiveConvolution for the computation of the output size.
+    const size_t filterRows = filter.n_rows * dilationH - (dilationH - 1);
+    const size_t filterCols = filter.n_cols * dilationW - (dilationW - 1);
+    const size_t outputRows = (input.n_rows - filterRows + dH) / dH;
+    const size_t outputCols = (input.n_cols - filterCols + dW) / dW;
+    if (!appending)
+      output.zeros(outputRows, outputCols);
+
+    MatType patches(outputRows * outputCols, filter.n_elem);
+    for (size_t kj = 0; kj < filter.n_cols; ++kj)
+    {
+      for (size_t ki = 0; ki < filter.n_rows; ++ki)
+      {
+        LowerPatch(input.memptr(), input.n_rows, ki, kj, outputRows,
+            outputCols, dW, dH, dilationW, dilationH,
+            patches.colptr(ki + kj * filter.n_rows));
+      }
+    }
+
+    const MatType result = patches * vectorise(filter);
+    output += reshape(result, outputRows, outputCols);
+  }
+
+  /**
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename InMatType, typename FilMatType, typename OutMatType,
+      typename Border = BorderMode>
+  static std::enable_if_t<std::is_same_v<Border, FullConvolution>, void>
+  Convolution(const InMatType& input,
+              const FilMatType& filter,
+              OutMatType& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false,
+              const typename std::enable_if_t<IsMatrix<InMatType>::value>* = 0)
+  {
+    using MatType = typename GetDenseMatType<InMatType>::type;
+
+    // Pad the input so that the valid convolution of the padded input is the
+    // full convolution of the input (see NaiveConvolution).
+    const size_t paddingRows = filter.n_rows * dilationH - dilationH;
+    const size_t paddingCols = filter.n_cols * dilationW - dilationW;
+
+    MatType inputPadded(input.n_rows + 2 * paddingRows,
+        input.n_cols + 2 * paddingCols, arma::fill::zeros);
+    inputPadded.submat(paddingRows, paddingCols, paddingRows + input.n_rows - 1,
+        paddingCols + input.n_cols - 1) = input;
+
+    Im2ColConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output, dW, dH, dilationW, dilationH, appending);
+  }
+
+  /**
+   * Compute the forward pass of a (valid) convolution layer for a whole batch.
+   * The input holds `inMaps` slices for each point; the filters hold one slice
+   * for each pair of output map and input map of the same group, ordered by
+   * output map and then by input map.  The output must already have the size
+   * of the result, with one slice for each pair of point and output map; it is
+   * overwritten.
+   *
+   * @param input Input maps of every point.
+   * @param filters Filters of every pair of output map and input map.
+   * @param output Output maps of every point.
+   * @param inMaps Number of input maps of each point.
+   * @param groups Number of groups of maps (see GroupedConvolution).
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename CubeType>
+  static void ForwardBatch(const CubeType& input,
+                           const CubeType& filters,
+                           CubeType& output,
+                           const size_t inMaps,
+                           const size_t groups = 1,
+                           const size_t dW = 1,
+                           const size_t dH = 1,
+                           const size_t dilationW = 1,
+                           const size_t dilationH = 1)
+  {
+    using MatType = typename GetDenseMatType<CubeType>::type;
+
+    const size_t points = input.n_slices / inMaps;
+    const size_t maps = output.n_slices / points;
+    const size_t pixels = output.n_rows * output.n_cols;
+    const size_t groupPatchCols = filters.n_rows * filters.n_cols *
+        (inMaps / groups);
+    const size_t outGroupSize = maps / groups;
+
+    // Each row of `patches` holds the input values seen by one output pixel of
+    // one point.
+    MatType patches;
+    Im2Col(input, inMaps, filters.n_rows, filters.n_cols, output.n_rows,
+        output.n_cols, dW, dH, dilationW, dilationH, patches);
+
+    // The filters of each group, as a matrix with one column per output map,
+    // are simply an alias of the filter memory.
+    MatType result(pixels * points, maps);
+    for (size_t g = 0; g < groups; ++g)
+    {
+      MatType groupPatches, groupFilters, groupResult;
+      MakeAlias(groupPatches, patches, patches.n_rows, groupPatchCols,
+          g * groupPatchCols * patches.n_rows);
+      MakeAlias(groupFilters, filters, groupPatchCols, outGroupSize,
+          g * groupPatchCols * outGroupSize);
+      MakeAlias(groupResult, result, result.n_rows, outGroupSize,
+          g * outGroupSize * result.n_rows);
+
+      groupResult = groupPatches * groupFilters;
+    }
+
+    // Now move the result into the layout of the output.
+    #pragma omp parallel for
+    for (size_t p = 0; p < points; ++p)
+    {
+      for (size_t m = 0; m < maps; ++m)
+      {
+        const typename MatType::elem_type* from = result.colptr(m) +
+            p * pixels;
+        std::copy(from, from + pixels, output.slice_memptr(m + p * maps));
+      }
+    }
+  }
+
+  /**
+   * Compute the backward pass of a (valid) convolution layer for a whole
+   * batch: the error with respect to the input, given the error with respect
+   * to the output.  The input error must already have the size of the input
+   * given to ForwardBatch(); it is overwritten.  Input elements that were not
+   * seen by any filter application get an error of zero.
+   *
+   * @param error Error with respect to the output maps of every point.
+   * @param filters Filters of every pair of output map and input map.
+   * @param inputError Error with respect to the input maps of every point.
+   * @param inMaps Number of input maps of each point.
+   * @param groups Number of groups of maps (see GroupedConvolution).
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename CubeType>
+  static void BackwardBatch(const CubeType& error,
+                            const CubeType& filters,
+                            CubeType& inputError,
+                            const size_t inMaps,
+                            const size_t groups = 1,
+                            const size_t dW = 1,
+                            const size_t dH = 1,
+                            const size_t dilationW = 1,
+                            const size_t dilationH = 1)
+  {
+    using MatType = typename GetDenseMatType<CubeType>::type;
+
+    const size_t points = inputError.n_slices / inMaps;
+    const size_t groupPatchCols = filters.n_rows * filters.n_cols *
+        (inMaps / groups);
+    const size_t maps = error.n_slices / points;
+    const size_t outGroupSize = maps / groups;
+
+    MatType errorMatrix;
+    Lower(error, points, errorMatrix);
+
+    MatType patchErrors(errorMatrix.n_rows, groupPatchCols * groups);
+    for (size_t g = 0; g < groups; ++g)
+    {
+      MatType groupError, groupFilters, groupPatchErrors;
+      MakeAlias(groupError, errorMatrix, errorMatrix.n_rows, outGroupSize,
+          g * outGroupSize * errorMatrix.n_rows);
+      MakeAlias(groupFilters, filters, groupPatchCols, outGroupSize,
+          g * groupPatchCols * outGroupSize);
+      MakeAlias(groupPatchErrors, patchErrors, patchErrors.n_rows,
+          groupPatchCols, g * groupPatchCols * patchErrors.n_rows);
+
+      groupPatchErrors = groupError * groupFilters.t();
+    }
+
+    inputError.zeros();
+    Col2Im(patchErrors, inMaps, filters.n_rows, filters.n_cols, error.n_rows,
+        error.n_cols, dW, dH, dilationW, dilationH, inputError);
+  }
+
+  /**
+   * Compute the gradient of the filters of a (valid) convolution layer for a
+   * whole batch, given the input of the forward pass and the error with
+   * respect to the output.  The filter gradient must already have the size of
+   * the filters; it is overwritten.
+   *
+   * @param input Input maps of every point.
+   * @param error Error with respect to the output maps of every point.
+   * @param filterGradient Gradient of every filter.
+   * @param inMaps Number of input maps of each point.
+   * @param groups Number of groups of maps (see GroupedConvolution).
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename CubeType>
+  static void GradientBatch(const CubeType& input,
+                            const CubeType& error,
+                            CubeType& filterGradient,
+                            const size_t inMaps,
+                            const size_t groups = 1,
+                            const size_t dW = 1,
+                            const size_t dH = 1,
+                            const size_t dilationW = 1,
+                            const size_t dilationH = 1)
+  {
+    using MatType = typename GetDenseMatType<CubeType>::type;
+
+    const size_t points = input.n_slices / inMaps;
+    const size_t groupPatchCols = filterGradient.n_rows *
+        filterGradient.n_cols * (inMaps / groups);
+    const size_t maps = error.n_slices / points;
+    const size_t outGroupSize = maps / groups;
+
+    MatType patches, errorMatrix;
+    Im2Col(input, inMaps, filterGradient.n_rows, filterGradient.n_cols,
+        error.n_rows, error.n_cols, dW, dH, dilationW, dilationH, patches);
+    Lower(error, points, errorMatrix);
+
+    for (size_t g = 0; g < groups; ++g)
+    {
+      MatType groupPatches, groupError, groupGradient;
+      MakeAlias(groupPatches, patches, patches.n_rows, groupPatchCols,
+          g * groupPatchCols * patches.n_rows);
+      MakeAlias(groupError, errorMatrix, errorMatrix.n_rows, outGroupSize,
+          g * outGroupSize * errorMatrix.n_rows);
+      MakeAlias(groupGradient, filterGradient, groupPatchCols, outGroupSize,
+          g * groupPatchCols * outGroupSize);
+
+      groupGradient = groupPatches.t() * groupError;
+    }
+  }
+
+ private:
+  /**
+   * Lower every input map of every point into the columns of `patches`: the
+   * column of filter element (ki, kj) of input map c holds, for every point
+   * and every output pixel, the input value that the filter element is applied
+   * to.
+   */
+  template<typename CubeType, typename MatType>
+  static void Im2Col(const CubeType& input,
+                     const size_t inMaps,
+                     const size_t filterRows,
+                     const size_t filterCols,
+                     const size_t outputRows,
+                     const size_t outputCols,
+                     const size_t dW,
+                     const size_t dH,
+                     const size_t dilationW,
+                     const size_t dilationH,
+                     MatType& patches)
+  {
+    const size_t points = input.n_slices / inMaps;
+    const size_t pixels = outputRows * outputCols;
+    const size_t filterSize = filterRows * filterCols;
+    patches.set_size(pixels * points, filterSize * inMaps);
+
+    #pragma omp parallel for
+    for (size_t p = 0; p < points; ++p)
+    {
+      for (size_t c = 0; c < inMaps; ++c)
+      {
+        for (size_t kj = 0; kj < filterCols; ++kj)
+        {
+          for (size_t ki = 0; ki < filterRows; ++ki)
+          {
+            LowerPatch(input.slice_memptr(c + p * inMaps), input.n_rows, ki,
+                kj, outputRows, outputCols, dW, dH, dilationW, dilationH,
+                patches.colptr(ki + kj * filterRows + c * filterSize) +
+                p * pixels);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * The reverse of Im2Col(): add every element of `patches` to the input
+   * element it was taken from.
+   */
+  template<typename MatType, typename CubeType>
+  static void Col2Im(const MatType& patches,
+                     const size_t inMaps,
+                     const size_t filterRows,
+                     const size_t filterCols,
+                     const size_t outputRows,
+                     const size_t outputCols,
+                     const size_t dW,
+                     const size_t dH,
+                     const size_t dilationW,
+                     const size_t dilationH,
+                     CubeType& input)
+  {
+    using eT = typename MatType::elem_type;
+
+    const size_t points = input.n_slices / inMaps;
+    const size_t pixels = outputRows * outputCols;
+    const size_t filterSize = filterRows * filterCols;
+
+    // Every point has its own input slices, so points can be handled in
+    // parallel.
+    #pragma omp parallel for
+    for (size_t p = 0; p < points; ++p)
+    {
+      for (size_t c = 0; c < inMaps; ++c)
+      {
+        eT* in = input.slice_memptr(c + p * inMaps);
+        for (size_t kj = 0; kj < filterCols; ++kj)
+        {
+          for (size_t ki = 0; ki < filterRows; ++ki)
+          {
+            const eT* patchPtr = patches.colptr(ki + kj * filterRows +
+                c * filterSize) + p * pixels;
+            for (size_t j = 0; j < outputCols; ++j)
+            {
+              eT* inPtr = in + (kj * dilationW + j * dW) * input.n_rows +
+                  ki * dilationH;
+              for (size_t i = 0; i < outputRows; ++i, ++patchPtr)
+                inPtr[i * dH] += *patchPtr;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Copy the values of one input map that filter element (ki, kj) is applied
+   * to, for every output pixel, into `patchPtr`.
+   */
+  template<typename eT>
+  static void LowerPatch(const eT* input,
+                         const size_t inputRows,
+                         const size_t ki,
+                         const size_t kj,
+                         const size_t outputRows,
+                         const size_t outputCols,
+                         const size_t dW,
+                         const size_t dH,
+                         const size_t dilationW,
+                         const size_t dilationH,
+                         eT* patchPtr)
+  {
+    for (size_t j = 0; j < outputCols; ++j)
+    {
+      const eT* inPtr = input + (kj * dilationW + j * dW) * inputRows +
+          ki * dilationH;
+      for (size_t i = 0; i < outputRows; ++i, ++patchPtr)
+        *patchPtr = inPtr[i * dH];
+    }
+  }
+
+  /**
+   * Lower the output maps of every point into a matrix with one column per
+   * output map and one row per pair of point and output pixel (the layout of
+   * the result of the matrix multiplication in ForwardBatch()).
+   */
+  template<typename CubeType, typename MatType>
+  static void Lower(const CubeType& maps,
+                    const size_t points,
+                    MatType& lowered)
+  {
+    const size_t numMaps = maps.n_slices / points;
+    const size_t pixels = maps.n_rows * maps.n_cols;
+    lowered.set_size(pixels * points, numMaps);
+
+    #pragma omp parallel for
+    for (size_t p = 0; p < points; ++p)
+    {
+      for (size_t m = 0; m < numMaps; ++m)
+      {
+        const typename MatType::elem_type* from =
+            maps.slice_memptr(m + p * numMaps);
+        std::copy(from, from + pixels, lowered.colptr(m) + p * pixels);
+      }
+    }
+  }
+};  // class Im2ColConvolution
+
+/**
+ * This is true if the given convolution rule is an Im2ColConvolution, so that
+ * convolution layers can use its batch functions.
+ */
+template<typename ConvolutionRule>
+struct IsIm2ColConvolution
+{
+  static const bool value = false;
+};
+
+template<typename BorderMode>
+struct IsIm2ColConvolution<Im2ColConvolution<BorderMode>>
+{
+  static const bool value = true;
+};
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,780 @@
+/**
+ * @file methods/ann/convolution_rules/winograd_convolution.hpp
+ *
+ * Implementation of the convolution of 3x3 filters with the minimal filtering
+ * algorithms of Winograd.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/make_alias.hpp>
+#include "border_modes.hpp"
+#include "im2col_convolution.hpp"
+
+namespace mlpack {
+
+/**
+ * The transforms of the Winograd minimal filtering algorithm F(T x T, 3 x 3),
+ * which computes a T x T tile of the output of a 3x3 filter from an
+ * (T + 2) x (T + 2) tile of the input.  `bt`, `g` and `at` are the matrices
+ * B^T, G and A^T of Lavin and Gray, stored by rows.
+ */
+template<size_t TileSize>
+struct WinogradTransforms;
+
+template<>
+struct WinogradTransforms<2>
+{
+  static constexpr double bt[16] = {
+      1,  0, -1,  0,
+      0,  1,  1,  0,
+      0, -1,  1,  0,
+      0,  1,  0, -1 };
+
+  static constexpr double g[12] = {
+      1.0,  0.0, 0.0,
+      0.5,  0.5, 0.5,
+      0.5, -0.5, 0.5,
+      0.0,  0.0, 1.0 };
+
+  static constexpr double at[8] = {
+      1, 1,  1,  0,
+      0, 1, -1, -1 };
+};
+
+template<>
+struct WinogradTransforms<4>
+{
+  static constexpr double bt[36] = {
+      4,  0, -5,  0, 1, 0,
+      0, -4, -4,  1, 1, 0,
+      0,  4, -4, -1, 1, 0,
+      0, -2, -1,  2, 1, 0,
+      0,  2, -1, -2, 1, 0,
+      0,  4,  0, -5, 0, 1 };
+
+  static constexpr double g[18] = {
+       1.0 / 4,         0.0,        0.0,
+      -1.0 / 6,  -1.0 / 6,  -1.0 / 6,
+      -1.0 / 6,   1.0 / 6,  -1.0 / 6,
+       1.0 / 24,  1.0 / 12,  1.0 / 6,
+       1.0 / 24, -1.0 / 12,  1.0 / 6,
+       0.0,         0.0,        1.0 };
+
+  static constexpr double at[24] = {
+      1, 1,  1, 1,  1, 0,
+      0, 1, -1, 2, -2, 0,
+      0, 1,  1, 4,  4, 0,
+      0, 1, -1, 8, -8, 1 };
+};
+
+/**
+ * Computes the two-dimensional convolution of 3x3 filters with the minimal
+ * filtering algorithm F(T x T, 3 x 3) of Winograd:
+ *
+ * @code
+ * @inproceedings{lavin2016fast,
+ *   title={Fast Algorithms for Convolutional Neural Networks},
+ *   author={Lavin, A. and Gray, S.},
+ *   booktitle={Proceedings of the IEEE Conference on Computer Vision and
+ *       Pattern Recognition (CVPR 2016)},
+ *   pages={4013--4021},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * The output is split into T x T tiles.  The filters and the (T + 2) x
+ * (T + 2) input tiles are transformed, multiplied elementwise in the
+ * transformed domain, and transformed back; this takes (T + 2)^2
+ * multiplications per tile instead of 9 T^2.  For the batch functions the
+ * elementwise products over the input maps become (T + 2)^2 matrix
+ * multiplications, handled by BLAS, so F(2 x 2, 3 x 3) needs 2.25 times fewer
+ * multiplications than Im2ColConvolution, and F(4 x 4, 3 x 3) 4 times fewer.
+ * The larger tiles round more, though (the transforms have larger
+ * coefficients), so F(2 x 2, 3 x 3) is the default; it is as accurate as a
+ * direct convolution for all practical purposes.
+ *
+ * The algorithm only applies to 3x3 filters with stride 1 and no dilation.
+ * With any other filter, every function of this class falls back to
+ * Im2ColConvolution, so WinogradConvolution can be given to a convolution
+ * layer whatever its filter size; the layer switches to the Winograd algorithm
+ * when the filter shape matches.  Like Im2ColConvolution, the class provides
+ * Convolution() for a single two-dimensional convolution, and ForwardBatch(),
+ * BackwardBatch() and GradientBatch() for the three passes of the Convolution
+ * and GroupedConvolution layers.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ *     ValidConvolution).
+ * @tparam TileSize Size T of the output tiles (2 or 4).
+ */
+template<typename BorderMode = FullConvolution, size_t TileSize = 2>
+class WinogradConvolution
+{
+  static_assert(TileSize == 2 || TileSize == 4,
+      "WinogradConvolution: the tile size must be 2 or 4.");
+
+  //! The transforms of the algorithm.
+  using Transforms = WinogradTransforms<TileSize>;
+  //! Size of the input tiles, and of the transformed tiles.
+  static constexpr size_t alpha = TileSize + 2;
+  //! Number of elements of a transformed tile.
+  static constexpr size_t alpha2 = alpha * alpha;
+
+ public:
+  /**
+   * Return whether the Winograd algorithm applies to a convolution with the
+   * given filter size, strides and dilations.  If not, the functions of this
+   * class fall back to Im2ColConvolution.
+   */
+  static bool Applies(const size_t filterRows,
+                      const size_t filterCols,
+                      const size_t dW = 1,
+                      const size_t dH = 1,
+                      const size_t dilationW = 1,
+                      const size_t dilationH = 1)
+  {
+    return (filterRows == 3 && filterCols == 3 && dW == 1 && dH == 1 &&
+        dilationW == 1 && dilationH == 1);
+  }
+
+  /**
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename InMatType, typename FilMatType, typename OutMatType,
+      typename Border = BorderMode>
+  static std::enable_if_t<std::is_same_v<Border, ValidConvolution>, void>
+  Convolution(const InMatType& input,
+              const FilMatType& filter,
+              OutMatType& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false,
+              const typename std::enable_if_t<IsMatrix<InMatType>::value>* = 0)
+  {
+    using eT = typename InMatType::elem_type;
+
+    if (!Applies(filter.n_rows, filter.n_cols, dW, dH, dilationW, dilationH) ||
+        input.n_rows < 3 || input.n_cols < 3)
+    {
+      Im2ColConvolution<ValidConvolution>::Convolution(input, filter, output,
+          dW, dH, dilationW, dilationH, appending);
+      return;
+    }
+
+    const size_t outputRows = input.n_rows - 2;
+    const size_t outputCols = input.n_cols - 2;
+    if (!appending)
+      output.zeros(outputRows, outputCols);
+
+    eT filterTile[9], u[alpha2], d[alpha2], v[alpha2], y[TileSize * TileSize];
+    for (size_t j = 0; j < 3; ++j)
+      for (size_t i = 0; i < 3; ++i)
+        filterTile[i + j * 3] = filter(i, j);
+    Transform(Transforms::g, alpha, 3, filterTile, 3, u, alpha);
+
+    for (size_t tj = 0; tj < outputCols; tj += TileSize)
+    {
+      for (size_t ti = 0; ti < outputRows; ti += TileSize)
+      {
+        LoadTile(input.memptr(), input.n_rows, input.n_cols, ti, tj, alpha, d);
+        Transform(Transforms::bt, alpha, alpha, d, alpha, v, alpha);
+        for (size_t k = 0; k < alpha2; ++k)
+          v[k] *= u[k];
+        Transform(Transforms::at, TileSize, alpha, v, alpha, y, TileSize);
+
+        const size_t rows = std::min(TileSize, outputRows - ti);
+        const size_t cols = std::min(TileSize, outputCols - tj);
+        for (size_t j = 0; j < cols; ++j)
+          for (size_t i = 0; i < rows; ++i)
+            output(ti + i, tj + j) += y[i + j * TileSize];
+      }
+    }
+  }
+
+  /**
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename InMatType, typename FilMatType, typename OutMatType,
+      typename Border = BorderMode>
+  static std::enable_if_t<std::is_same_v<Border, FullConvolution>, void>
+  Convolution(const InMatType& input,
+              const FilMatType& filter,
+              OutMatType& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false,
+              const typename std::enable_if_t<IsMatrix<InMatType>::value>* = 0)
+  {
+    using MatType = typename GetDenseMatType<InMatType>::type;
+
+    if (!Applies(filter.n_rows, filter.n_cols, dW, dH, dilationW, dilationH))
+    {
+      Im2ColConvolution<FullConvolution>::Convolution(input, filter, output,
+          dW, dH, dilationW, dilationH, appending);
+      return;
+    }
+
+    // The full convolution is the valid convolution of the input padded with
+    // two zeros on each side.
+    MatType inputPadded(input.n_rows + 4, input.n_cols + 4, arma::fill::zeros);
+    inputPadded.submat(2, 2, input.n_rows + 1, input.n_cols + 1) = input;
+
+    WinogradConvolution<ValidConvolution, TileSize>::Convolution(inputPadded,
+        filter, output, dW, dH, dilationW, dilationH, appending);
+  }
+
+  /**
+   * Compute the forward pass of a (valid) convolution layer for a whole batch,
+   * like Im2ColConvolution::ForwardBatch().  The input holds `inMaps` slices
+   * for each point; the filters hold one slice for each pair of output map and
+   * input map of the same group, ordered by output map and then by input map.
+   * The output must already have the size of the result, with one slice for
+   * each pair of point and output map; it is overwritten.
+   *
+   * @param input Input maps of every point.
+   * @param filters Filters of every pair of output map and input map.
+   * @param output Output maps of every point.
+   * @param inMaps Number of input maps of each point.
+   * @param groups Number of groups of maps (see GroupedConvolution).
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename CubeType>
+  static void ForwardBatch(const CubeType& input,
+                           const CubeType& filters,
+                           CubeType& output,
+                           const size_t inMaps,
+                           const size_t groups = 1,
+                           const size_t dW = 1,
+                           const size_t dH = 1,
+                           const size_t dilationW = 1,
+                           const size_t dilationH = 1)
+  {
+    using MatType = typename GetDenseMatType<CubeType>::type;
+    using eT = typename CubeType::elem_type;
+
+    if (!Applies(filters.n_rows, filters.n_cols, dW, dH, dilationW, dilationH))
+    {
+      Im2ColConvolution<ValidConvolution>::ForwardBatch(input, filters, output,
+          inMaps, groups, dW, dH, dilationW, dilationH);
+      return;
+    }
+
+    const size_t points = input.n_slices / inMaps;
+    const size_t maps = output.n_slices / points;
+    const size_t inGroupSize = inMaps / groups;
+    const size_t outGroupSize = maps / groups;
+    const size_t tiles = NumTiles(output.n_rows) * NumTiles(output.n_cols);
+
+    CubeType u, v;
+    TransformFilters(filters, inGroupSize, maps, u);
+    TransformInput(input, inMaps, output.n_rows, output.n_cols, v);
+
+    // Slice k of `m` holds element k of the transformed output tiles, with one
+    // row per pair of point and tile, and one column per output map.
+    CubeType m(tiles * points, maps, alpha2);
+    for (size_t k = 0; k < alpha2; ++k)
+    {
+      for (size_t g = 0; g < groups; ++g)
+      {
+        MatType groupV, groupU, groupM;
+        MakeAlias(groupV, v, v.n_rows, inGroupSize,
+            k * v.n_rows * v.n_cols + g * inGroupSize * v.n_rows);
+        MakeAlias(groupU, u, u.n_rows, outGroupSize,
+            k * u.n_rows * u.n_cols + g * outGroupSize * u.n_rows);
+        MakeAlias(groupM, m, m.n_rows, outGroupSize,
+            k * m.n_rows * m.n_cols + g * outGroupSize * m.n_rows);
+
+        groupM = groupV * groupU;
+      }
+    }
+
+    // Transform each output tile back into the output.
+    const size_t tileRows = NumTiles(output.n_rows);
+    #pragma omp parallel for
+    for (size_t p = 0; p < points; ++p)
+    {
+      eT tile[alpha2], y[TileSize * TileSize];
+      for (size_t o = 0; o < maps; ++o)
+      {
+        eT* out = output.slice_memptr(o + p * maps);
+        for (size_t t = 0; t < tiles; ++t)
+        {
+          for (size_t k = 0; k < alpha2; ++k)
+            tile[k] = m(t + p * tiles, o, k);
+          Transform(Transforms::at, TileSize, alpha, tile, alpha, y, TileSize);
+          StoreTile(y, TileSize, (t % tileRows) * TileSize,
+              (t / tileRows) * TileSize, out, output.n_rows, output.n_cols,
+              false);
+        }
+      }
+    }
+  }
+
+  /**
+   * Compute the backward pass of a (valid) convolution layer for a whole
+   * batch, like Im2ColConvolution::BackwardBatch(): the error with respect to
+   * the input, given the error with respect to the output.  The input error
+   * must already have the size of the input given to ForwardBatch(); it is
+   * overwritten.
+   *
+   * @param error Error with respect to the output maps of every point.
+   * @param filters Filters of every pair of output map and input map.
+   * @param inputError Error with respect to the input maps of every point.
+   * @param inMaps Number of input maps of each point.
+   * @param groups Number of groups of maps (see GroupedConvolution).
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename CubeType>
+  static void BackwardBatch(const CubeType& error,
+                            const CubeType& filters,
+                            CubeType& inputError,
+                            const size_t inMaps,
+                            const size_t groups = 1,
+                            const size_t dW = 1,
+                            const size_t dH = 1,
+                            const size_t dilationW = 1,
+                            const size_t dilationH = 1)
+  {
+    using MatType = typename GetDenseMatType<CubeType>::type;
+    using eT = typename CubeType::elem_type;
+
+    if (!Applies(filters.n_rows, filters.n_cols, dW, dH, dilationW, dilationH))
+    {
+      Im2ColConvolution<ValidConvolution>::BackwardBatch(error, filters,
+          inputError, inMaps, groups, dW, dH, dilationW, dilationH);
+      return;
+    }
+
+    const size_t points = inputError.n_slices / inMaps;
+    const size_t maps = error.n_slices / points;
+    const size_t inGroupSize = inMaps / groups;
+    const size_t outGroupSize = maps / groups;
+    const size_t tiles = NumTiles(error.n_rows) * NumTiles(error.n_cols);
+
+    CubeType u, dm;
+    TransformFilters(filters, inGroupSize, maps, u);
+    TransformError(error, points, dm);
+
+    // The error of the transformed input tiles.
+    CubeType dv(tiles * points, inMaps, alpha2);
+    for (size_t k = 0; k < alpha2; ++k)
+    {
+      for (size_t g = 0; g < groups; ++g)
+      {
+        MatType groupDm, groupU, groupDv;
+        MakeAlias(groupDm, dm, dm.n_rows, outGroupSize,
+            k * dm.n_rows * dm.n_cols + g * outGroupSize * dm.n_rows);
+        MakeAlias(groupU, u, u.n_rows, outGroupSize,
+            k * u.n_rows * u.n_cols + g * outGroupSize * u.n_rows);
+        MakeAlias(groupDv, dv, dv.n_rows, inGroupSize,
+            k * dv.n_rows * dv.n_cols + g * inGroupSize * dv.n_rows);
+
+        groupDv = groupDm * groupU.t();
+      }
+    }
+
+    // Transform the error of each input tile back, and add it to the input
+    // error.  The input tiles overlap, but those of one point only write the
+    // slices of that point.
+    inputError.zeros();
+    const size_t tileRows = NumTiles(error.n_rows);
+    #pragma omp parallel for
+    for (size_t p = 0; p < points; ++p)
+    {
+      eT tile[alpha2], d[alpha2];
+      for (size_t c = 0; c < inMaps; ++c)
+      {
+        eT* in = inputError.slice_memptr(c + p * inMaps);
+        for (size_t t = 0; t < tiles; ++t)
+        {
+          for (size_t k = 0; k < alpha2; ++k)
+            tile[k] = dv(t + p * tiles, c, k);
+          TransformTransposed(Transforms::bt, alpha, alpha, tile, alpha, d,
+              alpha);
+          StoreTile(d, alpha, (t % tileRows) * TileSize,
+              (t / tileRows) * TileSize, in, inputError.n_rows,
+              inputError.n_cols, true);
+        }
+      }
+    }
+  }
+
+  /**
+   * Compute the gradient of the filters of a (valid) convolution layer for a
+   * whole batch, like Im2ColConvolution::GradientBatch(), given the input of
+   * the forward pass and the error with respect to the output.  The filter
+   * gradient must already have the size of the filters; it is overwritten.
+   *
+   * @param input Input maps of every point.
+   * @param error Error with respect to the output maps of every point.
+   * @param filterGradient Gradient of every filter.
+   * @param inMaps Number of input maps of each point.
+   * @param groups Number of groups of maps (see GroupedConvolution).
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename CubeType>
+  static void GradientBatch(const CubeType& input,
+                            const CubeType& error,
+                            CubeType& filterGradient,
+                            const size_t inMaps,
+                            const size_t groups = 1,
+                            const size_t dW = 1,
+                            const size_t dH = 1,
+                            const size_t dilationW = 1,
+                            const size_t dilationH = 1)
+  {
+    using MatType = typename GetDenseMatType<CubeType>::type;
+    using eT = typename CubeType::elem_type;
+
+    if (!Applies(filterGradient.n_rows, filterGradient.n_cols, dW, dH,
+        dilationW, dilationH))
+    {
+      Im2ColConvolution<ValidConvolution>::GradientBatch(input, error,
+          filterGradient, inMaps, groups, dW, dH, dilationW, dilationH);
+      return;
+    }
+
+    const size_t points = input.n_slices / inMaps;
+    const size_t maps = error.n_slices / points;
+    const size_t inGroupSize = inMaps / groups;
+    const size_t outGroupSize = maps / groups;
+
+    CubeType v, dm;
+    TransformInput(input, inMaps, error.n_rows, error.n_cols, v);
+    TransformError(error, points, dm);
+
+    // The gradient of the transformed filters, in the layout of
+    // TransformFilters().
+    CubeType du(inGroupSize, maps, alpha2);
+    for (size_t k = 0; k < alpha2; ++k)
+    {
+      for (size_t g = 0; g < groups; ++g)
+      {
+        MatType groupV, groupDm, groupDu;
+        MakeAlias(groupV, v, v.n_rows, inGroupSize,
+            k * v.n_rows * v.n_cols + g * inGroupSize * v.n_rows);
+        MakeAlias(groupDm, dm, dm.n_rows, outGroupSize,
+            k * dm.n_rows * dm.n_cols + g * outGroupSize * dm.n_rows);
+        MakeAlias(groupDu, du, du.n_rows, outGroupSize,
+            k * du.n_rows * du.n_cols + g * outGroupSize * du.n_rows);
+
+        groupDu = groupV.t() * groupDm;
+      }
+    }
+
+    #pragma omp parallel for
+    for (size_t o = 0; o < maps; ++o)
+    {
+      eT tile[alpha2];
+      for (size_t c = 0; c < inGroupSize; ++c)
+      {
+        for (size_t k = 0; k < alpha2; ++k)
+          tile[k] = du(c, o, k);
+        TransformTransposed(Transforms::g, alpha, 3, tile, alpha,
+            filterGradient.slice_memptr(c + o * inGroupSize), 3);
+      }
+    }
+  }
+
+ private:
+  //! Return the number of tiles needed to cover the given number of output
+  //! rows (or columns).
+  static size_t NumTiles(const size_t outputSize)
+  {
+    return (outputSize + TileSize - 1) / TileSize;
+  }
+
+  /**
+   * Transform every filter: element k of the transformed filter of output map
+   * o and input map c (of the group of o) is stored in u(c, o, k).
+   */
+  template<typename CubeType>
+  static void TransformFilters(const CubeType& filters,
+                               const size_t inGroupSize,
+                               const size_t maps,
+                               CubeType& u)
+  {
+    using eT = typename CubeType::elem_type;
+
+    u.set_size(inGroupSize, maps, alpha2);
+    #pragma omp parallel for
+    for (size_t o = 0; o < maps; ++o)
+    {
+      eT tile[alpha2];
+      for (size_t c = 0; c < inGroupSize; ++c)
+      {
+        Transform(Transforms::g, alpha, 3,
+            filters.slice_memptr(c + o * inGroupSize), 3, tile, alpha);
+        for (size_t k = 0; k < alpha2; ++k)
+          u(c, o, k) = tile[k];
+      }
+    }
+  }
+
+  /**
+   * Transform every input tile of every input map: element k of the
+   * transformed tile t of input map c of point p is stored in
+   * v(t + p * tiles, c, k).  The tiles past the edges of the input are padded
+   * with zeros.
+   */
+  template<typename CubeType>
+  static void TransformInput(const CubeType& input,
+                             const size_t inMaps,
+                             const size_t outputRows,
+                             const size_t outputCols,
+                             CubeType& v)
+  {
+    using eT = typename CubeType::elem_type;
+
+    const size_t points = input.n_slices / inMaps;
+    const size_t tileRows = NumTiles(outputRows);
+    const size_t tiles = tileRows * NumTiles(outputCols);
+    v.set_size(tiles * points, inMaps, alpha2);
+
+    #pragma omp parallel for
+    for (size_t p = 0; p < points; ++p)
+    {
+      eT d[alpha2], tile[alpha2];
+      for (size_t c = 0; c < inMaps; ++c)
+      {
+        const eT* in = input.slice_memptr(c + p * inMaps);
+        for (size_t t = 0; t < tiles; ++t)
+        {
+          LoadTile(in, input.n_rows, input.n_cols, (t % tileRows) * TileSize,
+              (t / tileRows) * TileSize, alpha, d);
+          Transform(Transforms::bt, alpha, alpha, d, alpha, tile, alpha);
+          for (size_t k = 0; k < alpha2; ++k)
+            v(t + p * tiles, c, k) = tile[k];
+        }
+      }
+    }
+  }
+
+  /**
+   * Transform every tile of the error with respect to the output (with the
+   * transpose of the output transform): element k of tile t of output map o
+   * of point p is stored in dm(t + p * tiles, o, k).
+   */
+  template<typename CubeType>
+  static void TransformError(const CubeType& error,
+                             const size_t points,
+                             CubeType& dm)
+  {
+    using eT = typename CubeType::elem_type;
+
+    const size_t maps = error.n_slices / points;
+    const size_t tileRows = NumTiles(error.n_rows);
+    const size_t tiles = tileRows * NumTiles(error.n_cols);
+    dm.set_size(tiles * points, maps, alpha2);
+
+    #pragma omp parallel for
+    for (size_t p = 0; p < points; ++p)
+    {
+      eT e[TileSize * TileSize], tile[alpha2];
+      for (size_t o = 0; o < maps; ++o)
+      {
+        const eT* err = error.slice_memptr(o + p * maps);
+        for (size_t t = 0; t < tiles; ++t)
+        {
+          LoadTile(err, error.n_rows, error.n_cols, (t % tileRows) * TileSize,
+              (t / tileRows) * TileSize, TileSize, e);
+          TransformTransposed(Transforms::at, TileSize, alpha, e, TileSize,
+              tile, alpha);
+          for (size_t k = 0; k < alpha2; ++k)
+            dm(t + p * tiles, o, k) = tile[k];
+        }
+      }
+    }
+  }
+
+  /**
+   * Copy the size x size tile of the given (column-major) map that starts at
+   * (row, col) into `tile`, with zeros past the edges of the map.
+   */
+  template<typename eT>
+  static void LoadTile(const eT* map,
+                       const size_t mapRows,
+                       const size_t mapCols,
+                       const size_t row,
+                       const size_t col,
+                       const size_t size,
+                       eT* tile)
+  {
+    for (size_t j = 0; j < size; ++j)
+    {
+      for (size_t i = 0; i < size; ++i)
+      {
+        tile[i + j * size] = (row + i < mapRows && col + j < mapCols) ?
+            map[(row + i) + (col + j) * mapRows] : eT(0);
+      }
+    }
+  }
+
+  /**
+   * Write (or add, if `accumulate` is true) the size x size tile into the
+   * given (column-major) map, starting at (row, col); the part of the tile
+   * past the edges of the map is dropped.
+   */
+  template<typename eT>
+  static void StoreTile(const eT* tile,
+                        const size_t size,
+                        const size_t row,
+                        const size_t col,
+                        eT* map,
+                        const size_t mapRows,
+                        const size_t mapCols,
+                        const bool accumulate)
+  {
+    const size_t rows = std::min(size, mapRows - row);
+    const size_t cols = std::min(size, mapCols - col);
+    for (size_t j = 0; j < cols; ++j)
+    {
+      eT* out = map + row + (col + j) * mapRows;
+      for (size_t i = 0; i < rows; ++i)
+      {
+        if (accumulate)
+          out[i] += tile[i + j * size];
+        else
+          out[i] = tile[i + j * size];
+      }
+    }
+  }
+
+  /**
+   * Compute out = L * in * L^T, where L is the lRows x lCols matrix given by
+   * rows, `in` is an lCols x lCols matrix and `out` an lRows x lRows matrix,
+   * both column-major with the given column strides.
+   */
+  template<typename eT>
+  static void Transform(const double* l,
+                        const size_t lRows,
+                        const size_t lCols,
+                        const eT* in,
+                        const size_t inStride,
+                        eT* out,
+                        const size_t outStride)
+  {
+    // tmp = L * in, an lRows x lCols matrix.
+    eT tmp[alpha2];
+    for (size_t j = 0; j < lCols; ++j)
+    {
+      for (size_t i = 0; i < lRows; ++i)
+      {
+        eT sum = 0;
+        for (size_t k = 0; k < lCols; ++k)
+          sum += eT(l[i * lCols + k]) * in[k + j * inStride];
+        tmp[i + j * lRows] = sum;
+      }
+    }
+
+    for (size_t j = 0; j < lRows; ++j)
+    {
+      for (size_t i = 0; i < lRows; ++i)
+      {
+        eT sum = 0;
+        for (size_t k = 0; k < lCols; ++k)
+          sum += tmp[i + k * lRows] * eT(l[j * lCols + k]);
+        out[i + j * outStride] = sum;
+      }
+    }
+  }
+
+  /**
+   * Compute out = L^T * in * L, where L is the lRows x lCols matrix given by
+   * rows, `in` is an lRows x lRows matrix and `out` an lCols x lCols matrix,
+   * both column-major with the given column strides.
+   */
+  template<typename eT>
+  static void TransformTransposed(const double* l,
+                                  const size_t lRows,
+                                  const size_t lCols,
+                                  const eT* in,
+                                  const size_t inStride,
+                                  eT* out,
+                                  const size_t outStride)
+  {
+    // tmp = L^T * in, an lCols x lRows matrix.
+    eT tmp[alpha2];
+    for (size_t j = 0; j < lRows; ++j)
+    {
+      for (size_t i = 0; i < lCols; ++i)
+      {
+        eT sum = 0;
+        for (size_t k = 0; k < lRows; ++k)
+          sum += eT(l[k * lCols + i]) * in[k + j * inStride];
+        tmp[i + j * lCols] = sum;
+      }
+    }
+
+    for (size_t j = 0; j < lCols; ++j)
+    {
+      for (size_t i = 0; i < lCols; ++i)
+      {
+        eT sum = 0;
+        for (size_t k = 0; k < lRows; ++k)
+          sum += tmp[i + k * lCols] * eT(l[k * lCols + j]);
+        out[i + j * outStride] = sum;
+      }
+    }
+  }
+};  // class WinogradConvolution
+
+/**
+ * This is true if the given convolution rule provides ForwardBatch(),
+ * BackwardBatch() and GradientBatch(), so that convolution layers can use its
+ * batch functions.
+ */
+template<typename ConvolutionRule>
+struct HasBatchConvolution
+{
+  static const bool value = IsIm2ColConvolution<ConvolutionRule>::value;
+};
+
+template<typename BorderMode, size_t TileSize>
+struct HasBatchConvolution<WinogradConvolution<BorderMode, TileSize>>
+{
+  static const bool value = true;
+};
+
+} // namespace mlpack
+
+#endif
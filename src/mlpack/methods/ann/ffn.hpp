@@ -16,6 +16,7 @@
 #include <mlpack/core.hpp>
 
 #include "forward_decls.hpp"
+#include "inference_context.hpp"
 #include "init_rules/init_rules.hpp"
 #include "loss_functions/loss_functions.hpp"
 
@@ -190,6 +191,86 @@ class FFN
                                     MatType responses,
                                     CallbackTypes&&... callbacks);
 
+  /**
+   * Train the feedforward network on data that is read from disk in chunks, so
+   * that the full dataset never has to be in memory.  For each epoch, the
+   * optimizer is run on each chunk of `predictors` (and the corresponding chunk
+   * of `responses`) in turn, starting from the current parameters.  This is
+   * only useful with stochastic optimizers (such as ens::SGD or ens::Adam),
+   * whose MaxIterations() should be set to roughly the chunk size so that each
+   * call makes a single pass over the chunk.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Source of input training variables.
+   * @param responses Source of outputs results from input training variables.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param epochs Number of passes over the whole dataset.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The sum of the final objectives for each chunk in the last epoch.
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  typename MatType::elem_type Train(
+      data::ChunkedSource<typename MatType::elem_type>& predictors,
+      data::ChunkedSource<typename MatType::elem_type>& responses,
+      OptimizerType& optimizer,
+      const size_t epochs = 1,
+      CallbackTypes&&... callbacks);
+
+  /**
+   * Train the feedforward network on images that are decoded in the
+   * background by the given ImageBatchLoader, which also gives the responses.
+   * For each epoch, the optimizer is run on each batch of the loader in turn,
+   * starting from the current parameters, while the next batches are decoded;
+   * as with the ChunkedSource overload, this is only useful with stochastic
+   * optimizers whose MaxIterations() is roughly the loader batch size.  The
+   * loader is reset at the start of each epoch.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param loader Loader of the images and their responses.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param epochs Number of passes over the whole dataset.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The sum of the final objectives for each batch in the last epoch.
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  typename MatType::elem_type Train(
+      data::ImageBatchLoader<typename MatType::elem_type>& loader,
+      OptimizerType& optimizer,
+      const size_t epochs = 1,
+      CallbackTypes&&... callbacks);
+
+  /**
+   * Train the feedforward network on the batches of the given BatchPrefetcher,
+   * which assembles (and optionally shuffles and transforms) the next batch in
+   * the background while the current one is used.  For each epoch, the
+   * optimizer is run on each batch in turn, starting from the current
+   * parameters; as with the ChunkedSource overload, this is only useful with
+   * stochastic optimizers whose MaxIterations() is roughly the prefetcher batch
+   * size.  Since the batches are already shuffled by the prefetcher (if its
+   * Shuffle() is true), the shuffling of the optimizer can be disabled (e.g.
+   * with `optimizer.Shuffle() = false` for ens::SGD) to avoid copying each
+   * batch.  The prefetcher is reset at the start of each epoch.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param prefetcher Prefetcher of the batches of predictors and responses.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param epochs Number of passes over the whole dataset.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The sum of the final objectives for each batch in the last epoch.
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  typename MatType::elem_type Train(
+      data::BatchPrefetcher<MatType>& prefetcher,
+      OptimizerType& optimizer,
+      const size_t epochs = 1,
+      CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will be
    * the output of the output layer when `predictors` is passed through the
@@ -203,9 +284,100 @@ class FFN
                MatType& results,
                const size_t batchSize = 128);
 
+  /**
+   * Initialize `context` for the const `Predict()` overload below: it gets a
+   * copy of the layers of the network (in test mode) that uses the weights of
+   * the network, and holds the activations of its forward passes.  The network
+   * must have been trained, or had its parameters set.  See InferenceContext
+   * for when a context must be initialized again.
+   *
+   * @param context Context to initialize.
+   */
+  void InitContext(InferenceContext<MatType>& context);
+
+  /**
+   * Predict the responses to a given set of predictors, like `Predict()`
+   * above, but writing only into the given context (and `results`).  The
+   * network is not modified, so many threads can call this at the same time,
+   * each with its own context.
+   *
+   * A std::invalid_argument is thrown if `context` was not initialized with
+   * `InitContext()` for this network.
+   *
+   * @param context Context initialized with `InitContext()`.
+   * @param predictors Input predictors.
+   * @param results Matrix to put output predictions of responses into.
+   * @param batchSize Batch size to use for prediction.
+   */
+  void Predict(InferenceContext<MatType>& context,
+               const MatType& predictors,
+               MatType& results,
+               const size_t batchSize = 128) const;
+
   // Return the number of weights in the model.
   size_t WeightSize();
 
+  /**
+   * Convert the network into an inference-only network with 8-bit integer
+   * weights: every (unregularized) Linear layer at the top level of the network
+   * is replaced with a QuantizedLinear layer, whose weights are quantized with
+   * one scale per output unit and whose forward pass uses integer arithmetic.
+   * The parameters of the other layers are kept as they are.
+   *
+   * The network must have been trained (or had its parameters set) first.
+   * After quantization, `Predict()` can be used as before, but the network can
+   * no longer be trained.
+   */
+  void Quantize();
+
+  /**
+   * Optimize the network for inference by fusing common patterns of layers at
+   * the top level of the network:
+   *
+   *  - Dropout and AlphaDropout layers are removed, since they are the
+   *    identity at inference time.
+   *  - A BatchNorm layer that follows a Convolution layer (and normalizes each
+   *    of its output maps) is folded into the weights and bias of the
+   *    convolution, using the running mean and variance of the BatchNorm layer.
+   *  - An (unregularized) Linear layer followed by a ReLU, Sigmoid or TanH layer
+   *    is replaced with a FusedLinear layer, which adds the bias and applies
+   *    the activation in a single pass.
+   *
+   * The network must have been trained (or had its parameters set) first.
+   * After fusion, `Predict()` gives the same results as before (up to
+   * floating-point error), but the network can no longer be trained.
+   */
+  void Fuse();
+
+  /**
+   * Prune the weights of the network by magnitude: in every (unregularized)
+   * Linear and LinearNoBias layer at the top level of the network, the given
+   * fraction of the weights with the smallest absolute values is set to zero.
+   * Each layer is pruned separately, and biases are not pruned.
+   *
+   * The network stays a regular network: it can still be trained (for
+   * instance, to recover accuracy after pruning, although the pruned weights
+   * may then become nonzero again), and `Sparsify()` can be called to store
+   * only the remaining weights.
+   *
+   * @param sparsity Fraction of the weights of each layer to set to zero; must
+   *     be in [0, 1).
+   */
+  void Prune(const double sparsity);
+
+  /**
+   * Convert the network into an inference-only network that stores only the
+   * nonzero weights of its Linear layers: every (unregularized) Linear and
+   * LinearNoBias layer at the top level of the network is replaced with a
+   * SparseLinear layer.  The parameters of the other layers are kept as they
+   * are.  This is usually called after `Prune()`.
+   *
+   * The network must have been trained (or had its parameters set) first.
+   * After the conversion, `Predict()` gives the same results as before (up to
+   * floating-point error), but the network can no longer be trained.
+   */
+  void Sparsify();
+
   /**
    * Set the logical dimensions of the input.  `Train()` and `Predict()` expect
    * data to be passed such that one point corresponds to one column, but this
@@ -230,6 +402,54 @@ class FFN
   //! Get the logical dimensions of the input.
   const std::vector<size_t>& InputDimensions() const { return inputDimensions; }
 
+  //! Get the number of workers used to compute the gradient of each batch
+  //! during training.
+  size_t Workers() const { return workers; }
+  /**
+   * Modify the number of workers used to compute the gradient of each batch
+   * during training.  If this is greater than 1, each batch given to
+   * `EvaluateWithGradient()` is split into (at most) this many shards, which
+   * are passed forward and backward in parallel (with OpenMP) by replicas of
+   * the network.  The replicas share the weights of the network but have their
+   * own activation memory, and the gradients of the shards are summed with a
+   * tree reduction before they are returned to the optimizer.
+   *
+   * The result is the same as with one worker, except for layers whose output
+   * for a point depends on the other points in the batch (e.g. BatchNorm in
+   * training mode, which uses the statistics of each shard; only the running
+   * statistics of the first shard are kept), and layers whose `Gradient()`
+   * adds the gradient of a penalty term (e.g. a regularized Linear layer),
+   * which is then added once per shard.
+   */
+  size_t& Workers() { return workers; }
+
+  //! Get the indices of the layers whose outputs are kept for the backward
+  //! pass during training (all of them, if this is empty).
+  const std::vector<size_t>& Checkpoints() const
+  {
+    return network.Checkpoints();
+  }
+  /**
+   * Modify the indices of the layers whose outputs are kept for the backward
+   * pass during training (gradient checkpointing).  By default this is empty,
+   * and the output of every layer is kept.  Otherwise, the outputs of the
+   * layers between two checkpoints are computed again during the backward
+   * pass, trading about one more forward pass for less activation memory; for
+   * `n` layers, `{ k - 1, 2k - 1, ... }` with `k` about `sqrt(n)` gives
+   * `O(sqrt(n))` activation memory.  The gradient is the same, as long as no
+   * layer between two checkpoints is random or updates its state in its
+   * forward pass (see `MultiLayer::Checkpoints()`).
+   */
+  std::vector<size_t>& Checkpoints() { return network.Checkpoints(); }
+
+  /**
+   * Return the memory used by the network: its parameters, the copy of the
+   * training data held during training, the outputs and deltas of the layers
+   * ("network/..."), the output and error buffers, and the replicas and
+   * gradients of the parallel workers.
+   */
+  MemoryReport MemoryUsage() const;
+
   //! Return the current set of weights.  These are linearized: this contains
   //! the weights of every layer.
   const MatType& Parameters() const { return parameters; }
@@ -450,6 +670,62 @@ class FFN
   //! SetWeightPtr() on each layer.
   void SetLayerMemory();
 
+  //! Copy the layers of the network into `context`, and make them use the
+  //! weights of the network.  The network must already be checked.
+  void FillContext(InferenceContext<MatType>& context) const;
+
+  //! Throw a std::invalid_argument if `context` was not initialized for this
+  //! network, and a std::logic_error if the input size is wrong.
+  void CheckContext(const std::string& functionName,
+                    InferenceContext<MatType>& context,
+                    const size_t inputDimensionality) const;
+
+  /**
+   * Compute the objective and gradient of the batch of `batchSize` points
+   * starting at `begin` by splitting it over `Workers()` replicas of the
+   * network (see `Workers()`).  The network must already be checked with
+   * `CheckNetwork()`.
+   */
+  typename MatType::elem_type ParallelEvaluateWithGradient(
+      const size_t begin,
+      MatType& gradient,
+      const size_t batchSize);
+
+  /**
+   * Ensure that the network has layers and parameters of the right size, and
+   * that each layer points at its parameters, so that the network can be
+   * transformed for inference (see Quantize() and Fuse()).
+   *
+   * @param functionName Name of function to use if an exception is thrown.
+   */
+  void CheckTrainedNetwork(const std::string& functionName);
+
+  /**
+   * Set the given fraction of the elements of `weights` with the smallest
+   * absolute values to zero.
+   */
+  static void PruneWeights(MatType& weights, const double sparsity);
+
+  /**
+   * If `layer` is an unregularized Linear layer and `next` is the activation
+   * layer for the given activation function, return a new FusedLinear layer
+   * with the weights of `layer`; otherwise, return nullptr.
+   */
+  template<typename ActivationFunction>
+  static Layer<MatType>* FuseLinear(Layer<MatType>* layer,
+                                    Layer<MatType>* next);
+
+  /**
+   * If `layer` is a convolution layer of the given type and `next` is a
+   * BatchNorm layer that normalizes its output maps, return a copy of the
+   * convolution layer (with a bias) and store in `foldedWeights` its weights
+   * with the batch normalization folded in; otherwise, return nullptr.
+   */
+  template<typename ConvolutionLayerType>
+  static Layer<MatType>* FoldBatchNorm(Layer<MatType>* layer,
+                                       Layer<MatType>* next,
+                                       MatType& foldedWeights);
+
   /**
    * Ensure that all the locally-cached information about the network is valid,
    * all parameter memory is initialized, and we can make forward and backward
@@ -545,6 +821,14 @@ class FFN
   //! Locally-stored error of the backward pass; used by the gradient pass.
   MatType error;
 
+  //! Number of workers used to compute the gradient of each batch.
+  size_t workers;
+  //! Replicas of the network for workers other than the first, which uses
+  //! `network`.  Each replica's layers point at `parameters`.
+  std::vector<MultiLayer<MatType>> replicas;
+  //! Gradients computed by workers other than the first.
+  std::vector<MatType> workerGradients;
+
   //! If true, each layer has its memory properly set for a forward/backward
   //! pass.
   bool layerMemoryIsSet;
@@ -27,6 +27,7 @@ FFN<
 >::FFN(OutputLayerType outputLayer, InitializationRuleType initializeRule) :
     outputLayer(std::move(outputLayer)),
     initializeRule(std::move(initializeRule)),
+    workers(1),
     layerMemoryIsSet(false),
     inputDimensionsAreSet(false)
 {
@@ -48,6 +49,7 @@ FFN<
     inputDimensions(network.inputDimensions),
     predictors(network.predictors),
     responses(network.responses),
+    workers(network.workers),
     // These will be set correctly in the first Forward() call.
     layerMemoryIsSet(false),
     inputDimensionsAreSet(false)
@@ -70,6 +72,7 @@ FFN<
     inputDimensions(std::move(network.inputDimensions)),
     predictors(std::move(network.predictors)),
     responses(std::move(network.responses)),
+    workers(network.workers),
     // Aliases will not be correct after a std::move(), so we will manually
     // reset them.
     layerMemoryIsSet(false),
@@ -99,11 +102,13 @@ FFN<OutputLayerType, InitializationRuleType, MatType>& FFN<
     networkOutput = other.networkOutput;
     networkDelta = other.networkDelta;
     error = other.error;
+    workers = other.workers;
     inputDimensionsAreSet = other.inputDimensionsAreSet;
 
     // Copying will not preserve Armadillo aliases correctly, so we will reset
-    // those.
+    // those.  The replicas will be recreated when they are needed.
     layerMemoryIsSet = false;
+    replicas.clear();
   }
 
   return *this;
@@ -130,8 +135,11 @@ FFN<OutputLayerType, InitializationRuleType, MatType>& FFN<
     networkOutput = std::move(other.networkOutput);
     networkDelta = std::move(other.networkDelta);
     error = std::move(other.error);
+    workers = other.workers;
     inputDimensionsAreSet = std::move(other.inputDimensionsAreSet);
     layerMemoryIsSet = std::move(other.layerMemoryIsSet);
+    replicas.clear();
+    other.replicas.clear();
   }
 
   return *this;
@@ -185,6 +193,100 @@ typename MatType::elem_type FFN<
       callbacks...);
 }
 
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+template<typename OptimizerType, typename... CallbackTypes>
+typename MatType::elem_type FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Train(data::ChunkedSource<typename MatType::elem_type>& predictors,
+         data::ChunkedSource<typename MatType::elem_type>& responses,
+         OptimizerType& optimizer,
+         const size_t epochs,
+         CallbackTypes&&... callbacks)
+{
+  using ElemType = typename MatType::elem_type;
+
+  ElemType out = 0;
+  for (size_t e = 0; e < epochs; ++e)
+  {
+    out = 0;
+    data::ForEachChunk(predictors, responses,
+        [&](arma::Mat<ElemType>& predictorsChunk,
+            arma::Mat<ElemType>& responsesChunk)
+        {
+          out += Train(MatType(std::move(predictorsChunk)),
+              MatType(std::move(responsesChunk)), optimizer, callbacks...);
+        });
+  }
+
+  return out;
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+template<typename OptimizerType, typename... CallbackTypes>
+typename MatType::elem_type FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Train(data::ImageBatchLoader<typename MatType::elem_type>& loader,
+         OptimizerType& optimizer,
+         const size_t epochs,
+         CallbackTypes&&... callbacks)
+{
+  using ElemType = typename MatType::elem_type;
+
+  ElemType out = 0;
+  arma::Mat<ElemType> predictorsBatch, responsesBatch;
+  for (size_t e = 0; e < epochs; ++e)
+  {
+    out = 0;
+    loader.Reset();
+    while (loader.Next(predictorsBatch, responsesBatch))
+    {
+      out += Train(MatType(std::move(predictorsBatch)),
+          MatType(std::move(responsesBatch)), optimizer, callbacks...);
+    }
+  }
+
+  return out;
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+template<typename OptimizerType, typename... CallbackTypes>
+typename MatType::elem_type FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Train(data::BatchPrefetcher<MatType>& prefetcher,
+         OptimizerType& optimizer,
+         const size_t epochs,
+         CallbackTypes&&... callbacks)
+{
+  using ElemType = typename MatType::elem_type;
+
+  ElemType out = 0;
+  MatType predictorsBatch, responsesBatch;
+  for (size_t e = 0; e < epochs; ++e)
+  {
+    out = 0;
+    prefetcher.Reset();
+    while (prefetcher.Next(predictorsBatch, responsesBatch))
+    {
+      out += Train(std::move(predictorsBatch), std::move(responsesBatch),
+          optimizer, callbacks...);
+    }
+  }
+
+  return out;
+}
+
 template<typename OutputLayerType,
          typename InitializationRuleType,
          typename MatType>
@@ -211,7 +313,52 @@ void FFN<
     MakeAlias(resultAlias, results, results.n_rows, effectiveBatchSize,
         i * results.n_rows);
 
-    network.Forward(predictorAlias, resultAlias);
+    network.Predict(predictorAlias, resultAlias);
+  }
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::InitContext(InferenceContext<MatType>& context)
+{
+  CheckTrainedNetwork("FFN::InitContext()");
+  FillContext(context);
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Predict(InferenceContext<MatType>& context,
+           const MatType& predictors,
+           MatType& results,
+           const size_t batchSize) const
+{
+  CheckContext("FFN::Predict()", context, predictors.n_rows);
+
+  results.set_size(context.network.OutputSize(), predictors.n_cols);
+
+  for (size_t i = 0; i < predictors.n_cols; i += batchSize)
+  {
+    const size_t effectiveBatchSize = std::min(batchSize,
+        size_t(predictors.n_cols) - i);
+
+    MatType predictorAlias, resultAlias;
+
+    MakeAlias(predictorAlias, predictors, predictors.n_rows,
+        effectiveBatchSize, i * predictors.n_rows);
+    MakeAlias(resultAlias, results, results.n_rows, effectiveBatchSize,
+        i * results.n_rows);
+
+    context.network.Predict(predictorAlias, resultAlias);
   }
 }
 
@@ -230,6 +377,253 @@ size_t FFN<
   return network.WeightSize();
 }
 
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Quantize()
+{
+  // The weights of the Linear layers are taken from `parameters`.
+  CheckTrainedNetwork("FFN::Quantize()");
+
+  // Replace each Linear layer, and collect the parameters of all the other
+  // layers, in order.
+  std::vector<Layer<MatType>*>& layers = network.Network();
+  MatType newParameters(parameters.n_elem, 1);
+  size_t offset = 0, newOffset = 0;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    const size_t weightSize = layers[i]->WeightSize();
+    LinearType<MatType, NoRegularizer>* linear =
+        dynamic_cast<LinearType<MatType, NoRegularizer>*>(layers[i]);
+    if (linear != nullptr)
+    {
+      Layer<MatType>* quantized = new QuantizedLinearType<MatType>(*linear);
+      delete layers[i];
+      layers[i] = quantized;
+    }
+    else if (weightSize > 0)
+    {
+      newParameters.rows(newOffset, newOffset + weightSize - 1) =
+          parameters.rows(offset, offset + weightSize - 1);
+      newOffset += weightSize;
+    }
+
+    offset += weightSize;
+  }
+
+  newParameters.resize(newOffset, 1);
+  parameters = std::move(newParameters);
+
+  // The layers have changed, so their dimensions and memory must be set again
+  // before the next pass.
+  inputDimensionsAreSet = false;
+  layerMemoryIsSet = false;
+  network.InputDimensions().clear();
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Fuse()
+{
+  CheckTrainedNetwork("FFN::Fuse()");
+
+  // First remove all dropout layers, which have no weights.
+  std::vector<Layer<MatType>*> layers;
+  for (Layer<MatType>* layer : network.Network())
+  {
+    if (dynamic_cast<DropoutType<MatType>*>(layer) != nullptr ||
+        dynamic_cast<AlphaDropoutType<MatType>*>(layer) != nullptr)
+      delete layer;
+    else
+      layers.push_back(layer);
+  }
+
+  // Now fuse consecutive pairs of layers, and collect the weights of the new
+  // layers in order.
+  MultiLayer<MatType> fused;
+  std::vector<MatType> newWeights;
+  size_t offset = 0;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    Layer<MatType>* next = (i + 1 < layers.size()) ? layers[i + 1] : nullptr;
+    const size_t weightSize = layers[i]->WeightSize();
+    const size_t nextWeightSize = (next == nullptr) ? 0 : next->WeightSize();
+
+    Layer<MatType>* replacement = nullptr;
+    MatType replacementWeights;
+    if (next != nullptr)
+    {
+      replacement = FuseLinear<RectifierFunction>(layers[i], next);
+      if (replacement == nullptr)
+        replacement = FuseLinear<LogisticFunction>(layers[i], next);
+      if (replacement == nullptr)
+        replacement = FuseLinear<TanhFunction>(layers[i], next);
+
+      // A fused Linear layer keeps the weights of the Linear layer.
+      if (replacement != nullptr)
+        replacementWeights = parameters.rows(offset, offset + weightSize - 1);
+      else
+        replacement = FoldBatchNorm<ConvolutionType<
+            WinogradConvolution<ValidConvolution>,
+            WinogradConvolution<FullConvolution>,
+            WinogradConvolution<ValidConvolution>,
+            MatType>>(layers[i], next, replacementWeights);
+
+      if (replacement == nullptr)
+      {
+        replacement = FoldBatchNorm<ConvolutionType<
+            Im2ColConvolution<ValidConvolution>,
+            Im2ColConvolution<FullConvolution>,
+            Im2ColConvolution<ValidConvolution>,
+            MatType>>(layers[i], next, replacementWeights);
+      }
+    }
+
+    if (replacement != nullptr)
+    {
+      delete layers[i];
+      delete next;
+      fused.Add(replacement);
+      newWeights.push_back(std::move(replacementWeights));
+      offset += weightSize + nextWeightSize;
+      ++i;
+    }
+    else
+    {
+      fused.Add(layers[i]);
+      if (weightSize > 0)
+        newWeights.push_back(parameters.rows(offset, offset + weightSize - 1));
+      offset += weightSize;
+    }
+  }
+
+  size_t totalWeightSize = 0;
+  for (size_t i = 0; i < newWeights.size(); ++i)
+    totalWeightSize += newWeights[i].n_elem;
+
+  MatType newParameters(totalWeightSize, 1);
+  offset = 0;
+  for (size_t i = 0; i < newWeights.size(); ++i)
+  {
+    if (newWeights[i].n_elem == 0)
+      continue;
+
+    newParameters.rows(offset, offset + newWeights[i].n_elem - 1) =
+        vectorise(newWeights[i]);
+    offset += newWeights[i].n_elem;
+  }
+
+  // The old layers have been deleted or moved to `fused`, so the old network
+  // must not delete them again.
+  network.Network().clear();
+  network = std::move(fused);
+  fused.Network().clear();
+  parameters = std::move(newParameters);
+
+  inputDimensionsAreSet = false;
+  layerMemoryIsSet = false;
+  network.InputDimensions().clear();
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Prune(const double sparsity)
+{
+  if (sparsity < 0.0 || sparsity >= 1.0)
+  {
+    std::ostringstream oss;
+    oss << "FFN::Prune(): sparsity must be in [0, 1), but " << sparsity
+        << " was given!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The weights of the layers are aliases of `parameters`, so they are pruned
+  // in place.
+  CheckTrainedNetwork("FFN::Prune()");
+
+  for (Layer<MatType>* layer : network.Network())
+  {
+    LinearType<MatType, NoRegularizer>* linear =
+        dynamic_cast<LinearType<MatType, NoRegularizer>*>(layer);
+    LinearNoBiasType<MatType, NoRegularizer>* linearNoBias =
+        dynamic_cast<LinearNoBiasType<MatType, NoRegularizer>*>(layer);
+    if (linear != nullptr)
+      PruneWeights(linear->Weight(), sparsity);
+    else if (linearNoBias != nullptr)
+      PruneWeights(linearNoBias->Parameters(), sparsity);
+  }
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Sparsify()
+{
+  // The weights of the Linear layers are taken from `parameters`.
+  CheckTrainedNetwork("FFN::Sparsify()");
+
+  // Replace each Linear and LinearNoBias layer, and collect the parameters of
+  // all the other layers, in order.
+  std::vector<Layer<MatType>*>& layers = network.Network();
+  MatType newParameters(parameters.n_elem, 1);
+  size_t offset = 0, newOffset = 0;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    const size_t weightSize = layers[i]->WeightSize();
+    LinearType<MatType, NoRegularizer>* linear =
+        dynamic_cast<LinearType<MatType, NoRegularizer>*>(layers[i]);
+    LinearNoBiasType<MatType, NoRegularizer>* linearNoBias =
+        dynamic_cast<LinearNoBiasType<MatType, NoRegularizer>*>(layers[i]);
+
+    Layer<MatType>* sparse = nullptr;
+    if (linear != nullptr)
+      sparse = new SparseLinearType<MatType>(*linear);
+    else if (linearNoBias != nullptr)
+      sparse = new SparseLinearType<MatType>(*linearNoBias);
+
+    if (sparse != nullptr)
+    {
+      delete layers[i];
+      layers[i] = sparse;
+    }
+    else if (weightSize > 0)
+    {
+      newParameters.rows(newOffset, newOffset + weightSize - 1) =
+          parameters.rows(offset, offset + weightSize - 1);
+      newOffset += weightSize;
+    }
+
+    offset += weightSize;
+  }
+
+  newParameters.resize(newOffset, 1);
+  parameters = std::move(newParameters);
+
+  // The layers have changed, so their dimensions and memory must be set again
+  // before the next pass.
+  inputDimensionsAreSet = false;
+  layerMemoryIsSet = false;
+  network.InputDimensions().clear();
+}
+
 template<typename OutputLayerType,
          typename InitializationRuleType,
          typename MatType>
@@ -335,13 +729,11 @@ typename MatType::elem_type FFN<
   // Compute the error of the output layer.
   outputLayer.Backward(networkOutput, targets, error);
 
-  // Perform the backward pass.
-  network.Backward(inputs, networkOutput, error, networkDelta);
-
-  // Now compute the gradients.
+  // Perform the backward pass and compute the gradients in the same sweep.
   // The gradient should have the same size as the parameters.
   gradients.set_size(parameters.n_rows, parameters.n_cols);
-  network.Gradient(inputs, error, gradients);
+  network.BackwardWithGradient(inputs, networkOutput, error, networkDelta,
+      gradients);
 
   return res;
 }
@@ -359,8 +751,8 @@ typename MatType::elem_type FFN<
   CheckNetwork("FFN::Evaluate()", predictors.n_rows);
 
   // Set networkOutput to the right size if needed, then perform the forward
-  // pass.
-  network.Forward(predictors, networkOutput);
+  // pass.  No backward pass follows, so intermediate outputs can be shared.
+  network.Predict(predictors, networkOutput);
 
   return outputLayer.Forward(networkOutput, responses) + network.Loss();
 }
@@ -456,7 +848,7 @@ typename MatType::elem_type FFN<
       begin * predictors.n_rows);
   MakeAlias(responsesBatch, responses, responses.n_rows, batchSize,
       begin * responses.n_rows);
-  network.Forward(predictorsBatch, networkOutput);
+  network.Predict(predictorsBatch, networkOutput);
 
   return outputLayer.Forward(networkOutput, responsesBatch) + network.Loss();
 }
@@ -497,6 +889,9 @@ typename MatType::elem_type FFN<
 {
   CheckNetwork("FFN::EvaluateWithGradient()", predictors.n_rows);
 
+  if (workers > 1 && batchSize > 1)
+    return ParallelEvaluateWithGradient(begin, gradient, batchSize);
+
   // Set networkOutput to the right size if needed, then perform the forward
   // pass.
   networkOutput.set_size(network.OutputSize(), batchSize);
@@ -516,14 +911,115 @@ typename MatType::elem_type FFN<
   // Now perform the backward pass.
   outputLayer.Backward(networkOutput, responsesBatch, error);
 
-  // The delta should have the same size as the input.
+  // The delta should have the same size as the input, and the gradient should
+  // have the same size as the parameters.  Computing the gradient of each layer
+  // right after its backward pass lets the layers share delta memory.
   networkDelta.set_size(predictors.n_rows, batchSize);
-  network.Backward(predictorsBatch, networkOutput, error, networkDelta);
+  gradient.set_size(parameters.n_rows, parameters.n_cols);
+  network.BackwardWithGradient(predictorsBatch, networkOutput, error,
+      networkDelta, gradient);
 
-  // Now compute the gradients.
-  // The gradient should have the same size as the parameters.
+  return obj;
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+typename MatType::elem_type FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::ParallelEvaluateWithGradient(const size_t begin,
+                                MatType& gradient,
+                                const size_t batchSize)
+{
+  // Create the replicas if needed.  They are only valid as long as the layer
+  // memory of the network is; SetLayerMemory() clears them.
+  if (replicas.size() != workers - 1)
+  {
+    replicas.clear();
+    replicas.reserve(workers - 1);
+    for (size_t w = 1; w < workers; ++w)
+      replicas.push_back(network);
+    for (size_t w = 0; w < replicas.size(); ++w)
+      replicas[w].SetWeights(parameters);
+  }
+
+  // Each worker handles a contiguous shard of the batch.
+  const size_t numWorkers = std::min(workers, batchSize);
+  for (size_t w = 0; w < replicas.size(); ++w)
+  {
+    replicas[w].Training() = network.Training();
+    replicas[w].Checkpoints() = network.Checkpoints();
+  }
+
+  networkOutput.set_size(network.OutputSize(), batchSize);
+  networkDelta.set_size(predictors.n_rows, batchSize);
   gradient.set_size(parameters.n_rows, parameters.n_cols);
-  network.Gradient(predictorsBatch, error, gradient);
+  workerGradients.resize(numWorkers - 1);
+  for (size_t w = 0; w < numWorkers - 1; ++w)
+    workerGradients[w].set_size(parameters.n_rows, parameters.n_cols);
+
+  // Forward pass: each worker writes its shard of networkOutput.
+  #pragma omp parallel for
+  for (size_t w = 0; w < numWorkers; ++w)
+  {
+    const size_t shardBegin = w * batchSize / numWorkers;
+    const size_t shardSize = (w + 1) * batchSize / numWorkers - shardBegin;
+
+    MatType input, output;
+    MakeAlias(input, predictors, predictors.n_rows, shardSize,
+        (begin + shardBegin) * predictors.n_rows);
+    MakeAlias(output, networkOutput, networkOutput.n_rows, shardSize,
+        shardBegin * networkOutput.n_rows);
+
+    MultiLayer<MatType>& replica = (w == 0) ? network : replicas[w - 1];
+    replica.Forward(input, output);
+  }
+
+  // The output layer is evaluated on the whole batch, so that the objective
+  // and error are the same as for a single worker.
+  MatType responsesBatch;
+  MakeAlias(responsesBatch, responses, responses.n_rows, batchSize,
+      begin * responses.n_rows);
+  const typename MatType::elem_type obj = outputLayer.Forward(networkOutput,
+      responsesBatch) + network.Loss();
+  outputLayer.Backward(networkOutput, responsesBatch, error);
+
+  // Backward pass: each worker computes the gradient of its shard.
+  #pragma omp parallel for
+  for (size_t w = 0; w < numWorkers; ++w)
+  {
+    const size_t shardBegin = w * batchSize / numWorkers;
+    const size_t shardSize = (w + 1) * batchSize / numWorkers - shardBegin;
+
+    MatType input, output, shardError, delta;
+    MakeAlias(input, predictors, predictors.n_rows, shardSize,
+        (begin + shardBegin) * predictors.n_rows);
+    MakeAlias(output, networkOutput, networkOutput.n_rows, shardSize,
+        shardBegin * networkOutput.n_rows);
+    MakeAlias(shardError, error, error.n_rows, shardSize,
+        shardBegin * error.n_rows);
+    MakeAlias(delta, networkDelta, networkDelta.n_rows, shardSize,
+        shardBegin * networkDelta.n_rows);
+
+    MultiLayer<MatType>& replica = (w == 0) ? network : replicas[w - 1];
+    MatType& workerGradient = (w == 0) ? gradient : workerGradients[w - 1];
+    replica.BackwardWithGradient(input, output, shardError, delta,
+        workerGradient);
+  }
+
+  // Sum the gradients of all workers into `gradient` with a tree reduction:
+  // at each step, worker w adds in the gradient of worker w + step.
+  for (size_t step = 1; step < numWorkers; step *= 2)
+  {
+    #pragma omp parallel for
+    for (size_t w = 0; w < numWorkers - step; w += 2 * step)
+    {
+      MatType& target = (w == 0) ? gradient : workerGradients[w - 1];
+      target += workerGradients[w + step - 1];
+    }
+  }
 
   return obj;
 }
@@ -604,6 +1100,175 @@ void FFN<
 
   network.SetWeights(parameters);
   layerMemoryIsSet = true;
+
+  // Any replicas used for parallel training point at the old memory.
+  replicas.clear();
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::FillContext(InferenceContext<MatType>& context) const
+{
+  // Copying the layers does not copy the weights once SetWeights() points the
+  // copies at `parameters`; only the activation buffers are per-context.
+  context.network = network;
+  context.network.SetWeights(parameters);
+  context.network.Training() = false;
+  context.weightSize = parameters.n_elem;
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::CheckContext(const std::string& functionName,
+                InferenceContext<MatType>& context,
+                const size_t inputDimensionality) const
+{
+  if (context.weightSize == 0 || context.weightSize != parameters.n_elem ||
+      context.network.Network().size() != network.Network().size())
+  {
+    throw std::invalid_argument(functionName + ": the given context was not "
+        "initialized for this network; use InitContext()!");
+  }
+
+  size_t totalInputSize = 1;
+  const std::vector<size_t>& dims = context.network.InputDimensions();
+  for (size_t i = 0; i < dims.size(); ++i)
+    totalInputSize *= dims[i];
+
+  if (totalInputSize != inputDimensionality)
+  {
+    throw std::logic_error(functionName + ": input size does not match expected"
+        " size set with InputDimensions()!");
+  }
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::CheckTrainedNetwork(const std::string& functionName)
+{
+  if (network.Network().size() == 0)
+  {
+    throw std::invalid_argument(functionName + ": cannot use network with no "
+        "layers!");
+  }
+
+  if (parameters.n_elem > 0)
+    UpdateDimensions(functionName);
+  if (parameters.n_elem == 0 || parameters.n_elem != network.WeightSize())
+  {
+    throw std::invalid_argument(functionName + ": the network must be trained "
+        "or have its parameters set first!");
+  }
+
+  if (!layerMemoryIsSet)
+    SetLayerMemory();
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::PruneWeights(MatType& weights, const double sparsity)
+{
+  const size_t numPruned = (size_t) (sparsity * weights.n_elem);
+  if (numPruned == 0)
+    return;
+
+  // Sorting (instead of comparing with a threshold) prunes exactly numPruned
+  // weights, even when many weights have the same magnitude.
+  const arma::uvec order = arma::sort_index(arma::vectorise(arma::abs(
+      weights)));
+  for (size_t i = 0; i < numPruned; ++i)
+    weights[order[i]] = 0;
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+template<typename ActivationFunction>
+Layer<MatType>* FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::FuseLinear(Layer<MatType>* layer, Layer<MatType>* next)
+{
+  LinearType<MatType, NoRegularizer>* linear =
+      dynamic_cast<LinearType<MatType, NoRegularizer>*>(layer);
+  if (linear == nullptr ||
+      dynamic_cast<BaseLayer<ActivationFunction, MatType>*>(next) == nullptr)
+    return nullptr;
+
+  return new FusedLinearType<ActivationFunction, MatType>(*linear);
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+template<typename ConvolutionLayerType>
+Layer<MatType>* FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::FoldBatchNorm(Layer<MatType>* layer,
+                 Layer<MatType>* next,
+                 MatType& foldedWeights)
+{
+  ConvolutionLayerType* conv = dynamic_cast<ConvolutionLayerType*>(layer);
+  BatchNormType<MatType>* bn = dynamic_cast<BatchNormType<MatType>*>(next);
+  if (conv == nullptr || bn == nullptr)
+    return nullptr;
+
+  // The batch normalization must be applied to each output map (the third
+  // axis of the output of the convolution).
+  if (bn->MinAxis() != 2 || bn->MaxAxis() != 2 ||
+      bn->InputSize() != conv->Maps())
+    return nullptr;
+
+  // Each output map o of the convolution is scaled by
+  // gamma_o / sqrt(var_o + eps), and shifted accordingly.
+  const size_t maps = conv->Maps();
+  const size_t inMaps = conv->Weight().n_slices / maps;
+  const MatType scale = bn->Gamma() /
+      sqrt(bn->TrainingVariance() + bn->Epsilon());
+
+  foldedWeights.set_size(conv->Weight().n_elem + maps, 1);
+  const size_t sliceSize = conv->Weight().n_rows * conv->Weight().n_cols;
+  for (size_t o = 0; o < maps; ++o)
+  {
+    for (size_t i = 0; i < inMaps; ++i)
+    {
+      const size_t slice = o * inMaps + i;
+      foldedWeights.rows(slice * sliceSize, (slice + 1) * sliceSize - 1) =
+          vectorise(conv->Weight().slice(slice)) * scale[o];
+    }
+
+    const typename MatType::elem_type bias = conv->UseBias() ?
+        conv->Bias()[o] : 0;
+    foldedWeights[conv->Weight().n_elem + o] = (bias - bn->TrainingMean()[o]) *
+        scale[o] + bn->Beta()[o];
+  }
+
+  ConvolutionLayerType* folded = conv->Clone();
+  folded->UseBias() = true;
+  return folded;
 }
 
 template<typename OutputLayerType,
@@ -731,6 +1396,35 @@ FFN<
   // Nothing to do here.
 }
 
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+MemoryReport FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::MemoryUsage() const
+{
+  MemoryReport report;
+  report.Add("parameters", MemoryOf(parameters));
+  report.Add("training data", MemoryOf(predictors) + MemoryOf(responses));
+  report.Add("network", network.MemoryUsage());
+  report.Add("output buffers", MemoryOf(networkOutput) +
+      MemoryOf(networkDelta) + MemoryOf(error));
+
+  MemoryReport replicasReport;
+  for (size_t i = 0; i < replicas.size(); ++i)
+    replicasReport += replicas[i].MemoryUsage();
+  report.Add("replicas", replicasReport);
+
+  size_t workerGradientsBytes = 0;
+  for (size_t i = 0; i < workerGradients.size(); ++i)
+    workerGradientsBytes += MemoryOf(workerGradients[i]);
+  report.Add("worker gradients", workerGradientsBytes);
+
+  return report;
+}
+
 } // namespace mlpack
 
 #endif
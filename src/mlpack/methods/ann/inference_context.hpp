@@ -0,0 +1,83 @@
+/**
+ * @file methods/ann/inference_context.hpp
+ *
+ * Definition of the InferenceContext class, which holds the per-caller state
+ * of a forward pass for the const Predict() overloads of FFN and RNN.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_INFERENCE_CONTEXT_HPP
+#define MLPACK_METHODS_ANN_INFERENCE_CONTEXT_HPP
+
+#include <mlpack/core.hpp>
+
+#include "layer/multi_layer.hpp"
+
+namespace mlpack {
+
+/**
+ * An InferenceContext holds everything a forward pass of an FFN or an RNN
+ * writes to: a copy of the layers of the network, with their activation
+ * buffers and (for recurrent layers) their recurrent state.  The copied layers
+ * use the weights of the network; they are not copied.  With one context per
+ * thread, the const `Predict()` overloads of `FFN` and `RNN` can be called
+ * from many threads at once on a single network, instead of loading one copy
+ * of the model per thread.
+ *
+ * A context is created for a given network by `FFN::InitContext()` (or
+ * `RNN::InitContext()`), and can only be used with that network.  It stays
+ * valid as long as the weights of the network keep their memory and size; it
+ * must be initialized again after anything that reallocates them, such as
+ * `Reset()`, `Quantize()`, `Fuse()`, loading the network, or changing its
+ * layers.  No thread may train the network while others predict with it.
+ *
+ * @code
+ * FFN<> model;
+ * // ... build and train the network ...
+ *
+ * #pragma omp parallel
+ * {
+ *   InferenceContext<> context;
+ *   #pragma omp critical
+ *   model.InitContext(context);
+ *
+ *   // ... for each request of this thread ...
+ *   arma::mat output;
+ *   model.Predict(context, input, output);
+ * }
+ * @endcode
+ *
+ * @tparam MatType Type of matrix used by the network.
+ */
+template<typename MatType = arma::mat>
+class InferenceContext
+{
+ public:
+  //! Create an empty context; use `FFN::InitContext()` or
+  //! `RNN::InitContext()` to initialize it.
+  InferenceContext() : weightSize(0) { }
+
+  //! Get the number of weights of the network the context was initialized
+  //! for (0 if it was not initialized).
+  size_t WeightSize() const { return weightSize; }
+
+ private:
+  // The FFN and RNN classes set and use the context.
+  template<typename, typename, typename>
+  friend class FFN;
+  template<typename, typename, typename>
+  friend class RNN;
+
+  //! The copy of the layers of the network, in test mode, whose weights point
+  //! at the parameters of the network.
+  MultiLayer<MatType> network;
+  //! The number of weights of the network.
+  size_t weightSize;
+};
+
+} // namespace mlpack
+
+#endif
@@ -77,9 +77,9 @@ void AddMergeType<MatType>::Forward(
     tempOutput.set_size(arma::size(output));
 
     // Forward pass every layer in network with same input.
-    // Reduce the outputs to single output by adding element-wise.
-    this->network[0]->Forward(input, tempOutput);
-    output = tempOutput;
+    // Reduce the outputs to single output by adding element-wise.  The first
+    // layer writes directly to the output.
+    this->network[0]->Forward(input, output);
     for (size_t i = 1; i < this->network.size(); i++)
     {
       this->network[i]->Forward(input, tempOutput);
@@ -110,8 +110,8 @@ void AddMergeType<MatType>::Backward(
     MatType tempDelta;
     tempDelta.set_size(arma::size(g));
 
-    g.zeros();
-    for (size_t i = 0; i < this->network.size(); i++)
+    this->network[0]->Backward(input, output, gy, g);
+    for (size_t i = 1; i < this->network.size(); i++)
     {
       this->network[i]->Backward(input, output, gy, tempDelta);
       g += tempDelta;
@@ -158,6 +158,8 @@ void AddMergeType<MatType>::Gradient(
 template<typename MatType>
 void AddMergeType<MatType>::ComputeOutputDimensions()
 {
+  this->ResetAliases();
+
   this->inSize = 0;
   this->totalInputSize = 0;
   this->totalOutputSize = 0;
@@ -18,6 +18,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include "layer.hpp"
+#include "dropout_mask.hpp"
 
 namespace mlpack {
 
@@ -106,8 +107,14 @@ class AlphaDropoutType : public Layer<MatType>
   //! Value of alphaDash.
   double AlphaDash() const { return alphaDash; }
 
-  //! Get the mask.
-  const MatType& Mask() const { return mask; }
+  //! Get the mask of the last forward pass (ones for the kept elements, and
+  //! zeros for the dropped ones).
+  MatType Mask() const
+  {
+    MatType m;
+    mask.ToMatrix(m);
+    return m;
+  }
 
   //! Modify the probability of setting a value to alphaDash. As
   //! 'a' and 'b' depend on 'ratio', modify them as well.
@@ -126,7 +133,7 @@ class AlphaDropoutType : public Layer<MatType>
 
  private:
   //! Locally-stored mask object.
-  MatType mask;
+  DropoutMask mask;
 
   //! The probability of setting a value to aplhaDash.
   double ratio;
@@ -201,6 +201,12 @@ class BatchNormType : public Layer<MatType>
   //! Get the average parameter.
   bool Average() const { return average; }
 
+  //! Get the first axis along which batch normalization is applied.
+  size_t MinAxis() const { return minAxis; }
+
+  //! Get the last axis along which batch normalization is applied.
+  size_t MaxAxis() const { return maxAxis; }
+
   //! Get size of weights.
   size_t WeightSize() const { return 2 * size; }
 
@@ -268,7 +274,8 @@ class BatchNormType : public Layer<MatType>
   //! Locally-stored normalized input.
   arma::Cube<typename MatType::elem_type> normalized;
 
-  //! Locally-stored zero mean input.
+  //! Unused (the backward pass only needs the normalized input); kept so that
+  //! serialized models remain compatible.
   arma::Cube<typename MatType::elem_type> inputMean;
 }; // class BatchNorm
 
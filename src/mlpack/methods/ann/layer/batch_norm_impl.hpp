@@ -185,53 +185,84 @@ void BatchNormType<MatType>::Forward(
     const MatType& input,
     MatType& output)
 {
+  using ElemType = typename MatType::elem_type;
+
   const size_t batchSize = input.n_cols;
   const size_t inputSize = inputDimension;
-  const size_t m = inputSize * batchSize * higherDimension;
+  const size_t slices = batchSize * higherDimension;
+  const size_t m = inputSize * slices;
+
+  // The input is seen as a cube with one column per channel and one slice per
+  // point and higher dimension; the elements of a channel in one slice are
+  // contiguous.
+  const size_t sliceSize = inputSize * size;
+  output.set_size(arma::size(input));
+  const ElemType* in = input.memptr();
+  ElemType* out = output.memptr();
 
   // We will calculate minibatch norm on each channel / feature map.
   if (this->training)
   {
     // Check only during training, batch-size can be one during inference.
-    if ((batchSize * higherDimension) == 1 && inputSize == 1)
+    if (slices == 1 && inputSize == 1)
     {
       Log::Warn << "Variance for single element isn't defined and" <<
           " will be set to 0.0 for training. Use a batch-size" <<
           " greater than 1 to fix the warning." << std::endl;
     }
 
-    // Input corresponds to output from previous layer.
-    // Used a cube for simplicity.
-    arma::Cube<typename MatType::elem_type> inputTemp(
-        const_cast<MatType&>(input).memptr(), inputSize, size,
-        batchSize * higherDimension, false, false);
-
-    // Initialize output to same size and values for convenience.
-    arma::Cube<typename MatType::elem_type> outputTemp(
-        const_cast<MatType&>(output).memptr(), inputSize, size,
-        batchSize * higherDimension, false, false);
-    outputTemp = inputTemp;
-
-    // Calculate mean and variance over all channels.
-    MatType mean = sum(sum(inputTemp, 2), 0) / m;
-    variance = sum(sum(pow(
-        inputTemp.each_slice() - repmat(mean, inputSize, 1), 2), 2), 0) / m;
-
-    outputTemp.each_slice() -= repmat(mean, inputSize, 1);
-
-    // Used in backward propagation.
-    inputMean.set_size(arma::size(inputTemp));
-    inputMean = outputTemp;
+    // The normalized input is kept for the backward pass; its memory is reused
+    // between passes with the same batch size.
+    normalized.set_size(inputSize, size, slices);
+    ElemType* xhat = normalized.memptr();
 
-    // Normalize output.
-    outputTemp.each_slice() /= sqrt(repmat(variance, inputSize, 1) + eps);
+    MatType mean(1, size);
+    variance.set_size(1, size);
 
-    // Re-used in backward propagation.
-    normalized.set_size(arma::size(inputTemp));
-    normalized = outputTemp;
-
-    outputTemp.each_slice() %= repmat(gamma.t(), inputSize, 1);
-    outputTemp.each_slice() += repmat(beta.t(), inputSize, 1);
+    // Each channel is handled by one thread, with one pass over the input to
+    // compute its statistics and one pass to normalize it.
+    #pragma omp parallel for schedule(static)
+    for (size_t c = 0; c < size; ++c)
+    {
+      // The statistics of the contiguous runs of the channel are merged one
+      // run at a time (Chan et al.), which is Welford's update when the runs
+      // hold a single element.
+      ElemType channelMean = 0, channelM2 = 0;
+      size_t n = 0;
+      for (size_t s = 0; s < slices; ++s)
+      {
+        const ElemType* x = in + s * sliceSize + c * inputSize;
+
+        ElemType runMean = 0;
+        for (size_t r = 0; r < inputSize; ++r)
+          runMean += x[r];
+        runMean /= inputSize;
+
+        ElemType runM2 = 0;
+        for (size_t r = 0; r < inputSize; ++r)
+          runM2 += (x[r] - runMean) * (x[r] - runMean);
+
+        const size_t total = n + inputSize;
+        const ElemType delta = runMean - channelMean;
+        channelMean += delta * inputSize / total;
+        channelM2 += runM2 + delta * delta * (ElemType(n) * inputSize / total);
+        n = total;
+      }
+
+      mean[c] = channelMean;
+      variance[c] = channelM2 / m;
+
+      const ElemType stdInv = 1 / std::sqrt(variance[c] + ElemType(eps));
+      for (size_t s = 0; s < slices; ++s)
+      {
+        const size_t offset = s * sliceSize + c * inputSize;
+        for (size_t r = 0; r < inputSize; ++r)
+        {
+          xhat[offset + r] = (in[offset + r] - channelMean) * stdInv;
+          out[offset + r] = gamma[c] * xhat[offset + r] + beta[c];
+        }
+      }
+    }
 
     count += 1;
     // Value for average factor which used to update running parameters.
@@ -249,17 +280,21 @@ void BatchNormType<MatType>::Forward(
   }
   else
   {
-    // Normalize the input and scale and shift the output.
-    output = input;
-    arma::Cube<typename MatType::elem_type> outputTemp(
-        const_cast<MatType&>(output).memptr(), inputSize, size,
-        batchSize * higherDimension, false, false);
-
-    outputTemp.each_slice() -= repmat(runningMean.t(), inputSize, 1);
-    outputTemp.each_slice() /= sqrt(repmat(runningVariance.t(),
-        inputSize, 1) + eps);
-    outputTemp.each_slice() %= repmat(gamma.t(), inputSize, 1);
-    outputTemp.each_slice() += repmat(beta.t(), inputSize, 1);
+    // Normalize the input and scale and shift the output, with one
+    // multiply-add per element.
+    #pragma omp parallel for schedule(static)
+    for (size_t c = 0; c < size; ++c)
+    {
+      const ElemType scale = gamma[c] /
+          std::sqrt(runningVariance[c] + ElemType(eps));
+      const ElemType shift = beta[c] - runningMean[c] * scale;
+      for (size_t s = 0; s < slices; ++s)
+      {
+        const size_t offset = s * sliceSize + c * inputSize;
+        for (size_t r = 0; r < inputSize; ++r)
+          out[offset + r] = in[offset + r] * scale + shift;
+      }
+    }
   }
 }
 
@@ -270,39 +305,47 @@ void BatchNormType<MatType>::Backward(
     const MatType& gy,
     MatType& g)
 {
-  const MatType stdInv = 1.0 / sqrt(variance + eps);
+  using ElemType = typename MatType::elem_type;
 
   const size_t batchSize = gy.n_cols;
   const size_t inputSize = inputDimension;
-  const size_t m = inputSize * batchSize * higherDimension;
-
-  arma::Cube<typename MatType::elem_type> gyTemp(
-      const_cast<MatType&>(gy).memptr(), inputSize, size,
-      batchSize * higherDimension, false, false);
-  arma::Cube<typename MatType::elem_type> gTemp(
-      const_cast<MatType&>(g).memptr(), inputSize, size,
-      batchSize * higherDimension, false, false);
-
-  // Step 1: dl / dxhat.
-  arma::Cube<typename MatType::elem_type> norm =
-      gyTemp.each_slice() % repmat(gamma.t(), inputSize, 1);
-
-  // Step 2: sum dl / dxhat * (x - mu) * -0.5 * stdInv^3.
-  MatType temp = sum(sum(norm % inputMean, 2), 0);
-  MatType vars = temp % pow(stdInv, 3) * (-0.5);
-
-  // Step 3: dl / dxhat * 1 / stdInv + variance * 2 * (x - mu) / m +
-  // dl / dmu * 1 / m.
-  gTemp = (norm.each_slice() % repmat(stdInv, inputSize, 1)) +
-      ((inputMean.each_slice() % repmat(vars, inputSize, 1) * 2.0) / m);
-
-  // Step 4: sum (dl / dxhat * -1 / stdInv) + variance *
-  // sum (-2 * (x - mu)) / m.
-  MatType normTemp = sum(sum((norm.each_slice() %
-      repmat(-stdInv, inputSize, 1)) +
-      (inputMean.each_slice() % repmat(vars, inputSize, 1) * (-2.0) / m),
-      2), 0) / m;
-  gTemp.each_slice() += repmat(normTemp, inputSize, 1);
+  const size_t slices = batchSize * higherDimension;
+  const size_t m = inputSize * slices;
+  const size_t sliceSize = inputSize * size;
+
+  const ElemType* dy = gy.memptr();
+  const ElemType* xhat = normalized.memptr();
+  ElemType* dx = g.memptr();
+
+  // With xhat the normalized input, the gradient of each channel is
+  //   dx = gamma * stdInv / m * (m * dy - sum(dy) - xhat * sum(dy % xhat)),
+  // so only two sums per channel are needed.
+  #pragma omp parallel for schedule(static)
+  for (size_t c = 0; c < size; ++c)
+  {
+    ElemType sumDy = 0, sumDyXhat = 0;
+    for (size_t s = 0; s < slices; ++s)
+    {
+      const size_t offset = s * sliceSize + c * inputSize;
+      for (size_t r = 0; r < inputSize; ++r)
+      {
+        sumDy += dy[offset + r];
+        sumDyXhat += dy[offset + r] * xhat[offset + r];
+      }
+    }
+
+    const ElemType factor = gamma[c] / (std::sqrt(variance[c] +
+        ElemType(eps)) * m);
+    for (size_t s = 0; s < slices; ++s)
+    {
+      const size_t offset = s * sliceSize + c * inputSize;
+      for (size_t r = 0; r < inputSize; ++r)
+      {
+        dx[offset + r] = factor * (m * dy[offset + r] - sumDy -
+            xhat[offset + r] * sumDyXhat);
+      }
+    }
+  }
 }
 
 template<typename MatType>
@@ -311,19 +354,34 @@ void BatchNormType<MatType>::Gradient(
     const MatType& error,
     MatType& gradient)
 {
+  using ElemType = typename MatType::elem_type;
+
   const size_t inputSize = inputDimension;
+  const size_t slices = error.n_cols * higherDimension;
+  const size_t sliceSize = inputSize * size;
 
-  arma::Cube<typename MatType::elem_type> errorTemp(
-      const_cast<MatType&>(error).memptr(), inputSize, size,
-      error.n_cols * higherDimension, false, false);
+  const ElemType* dy = error.memptr();
+  const ElemType* xhat = normalized.memptr();
 
-  // Step 5: dl / dy * xhat.
-  MatType temp = sum(sum(normalized % errorTemp, 0), 2);
-  gradient.submat(0, 0, gamma.n_elem - 1, 0) = temp.t();
+  #pragma omp parallel for schedule(static)
+  for (size_t c = 0; c < size; ++c)
+  {
+    ElemType sumDy = 0, sumDyXhat = 0;
+    for (size_t s = 0; s < slices; ++s)
+    {
+      const size_t offset = s * sliceSize + c * inputSize;
+      for (size_t r = 0; r < inputSize; ++r)
+      {
+        sumDy += dy[offset + r];
+        sumDyXhat += dy[offset + r] * xhat[offset + r];
+      }
+    }
 
-  // Step 6: dl / dy.
-  temp = sum(sum(errorTemp, 0), 2);
-  gradient.submat(gamma.n_elem, 0, gradient.n_elem - 1, 0) = temp.t();
+    // Step 5: dl / dy * xhat.
+    gradient[c] = sumDyXhat;
+    // Step 6: dl / dy.
+    gradient[size + c] = sumDy;
+  }
 }
 
 template<typename MatType>
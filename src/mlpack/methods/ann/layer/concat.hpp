@@ -138,6 +138,8 @@ class ConcatType : public MultiLayer<MatType>
 
   void ComputeOutputDimensions()
   {
+    this->ResetAliases();
+
     // The input is sent to every layer.
     for (size_t i = 0; i < this->network.size(); ++i)
     {
@@ -220,11 +222,23 @@ class ConcatType : public MultiLayer<MatType>
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  /**
+   * Copy the part of `error` (the error of the output of the Concat layer) that
+   * corresponds to the output of the held layer `index` into `childError`,
+   * which will be an alias of `errorMatrix`.
+   */
+  void ChildError(const MatType& error,
+                  const size_t index,
+                  MatType& childError);
+
   //! Parameter which indicates the axis of concatenation.
   size_t axis;
 
   //! Parameter which indicates whether to use the axis of concatenation.
   bool useAxis;
+
+  //! Memory for the error of a held layer, reused by each backward pass.
+  MatType errorMatrix;
 }; // class ConcatType.
 
 // Standard Concat layer.
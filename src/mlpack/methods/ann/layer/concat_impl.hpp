@@ -149,43 +149,19 @@ void ConcatType<MatType>::Backward(
 {
   // The implementation of MultiLayer is fine: this will allocate a matrix that
   // is able to hold each child layer's delta (which has the same size as the
-  // input).
+  // input).  The first layer writes its delta directly to `g`, and the deltas
+  // of the other layers are added to it.
   this->InitializeBackwardPassMemory(gy.n_cols);
 
-  // Just like the forward pass, we can treat our inputs as a cube, but here we
-  // have to distribute the correct parts of `gy` to the layers.
-
-  size_t rows = 1;
-  for (size_t i = 0; i < axis; ++i)
-    rows *= this->outputDimensions[i];
-
-  size_t slices = gy.n_cols;
-  for (size_t i = axis + 1; i < this->outputDimensions.size(); ++i)
-    slices *= this->outputDimensions[i];
-
-  arma::Cube<typename MatType::elem_type> gyTmp;
-  MakeAlias(gyTmp, gy, rows, this->outputDimensions[axis], slices);
-
-  size_t startCol = 0;
+  MatType delta;
   for (size_t i = 0; i < this->network.size(); ++i)
   {
-    const size_t cols = this->network[i]->OutputDimensions()[axis];
-    MatType delta = gyTmp.cols(startCol, startCol + cols - 1);
-    // Reshape so that the batch size is the number of columns.
-    delta.reshape(delta.n_elem / gy.n_cols, gy.n_cols);
-    this->network[i]->Backward(
-        input,
-        this->layerOutputs[i],
-        delta,
-        this->layerDeltas[i]);
-
-    startCol += cols;
-  }
+    ChildError(gy, i, delta);
+    this->network[i]->Backward(input, this->layerOutputs[i], delta,
+        (i == 0) ? g : this->layerDeltas[i]);
 
-  g = this->layerDeltas[0];
-  for (size_t i = 1; i < this->network.size(); ++i)
-  {
-    g += this->layerDeltas[i];
+    if (i > 0)
+      g += this->layerDeltas[i];
   }
 }
 
@@ -197,32 +173,10 @@ void ConcatType<MatType>::Backward(
     MatType& g,
     const size_t index)
 {
-  // We only intend to perform a backward pass on one layer.
-  // Thus, we need to extract the parts of gy that correspond to the desired
-  // layer (specified by `index`).
-
-  size_t rows = 1;
-  for (size_t i = 0; i < axis; ++i)
-    rows *= this->outputDimensions[i];
-
-  size_t slices = gy.n_cols;
-  for (size_t i = axis + 1; i < this->outputDimensions.size(); ++i)
-    slices *= this->outputDimensions[i];
-
-  arma::Cube<typename MatType::elem_type> gyTmp;
-  MakeAlias(gyTmp, gy, rows, this->outputDimensions[axis], slices);
-
-  size_t startCol = 0;
-  for (size_t i = 0; i < index; ++i)
-  {
-    startCol += this->network[i]->OutputDimensions()[axis];
-  }
-
-  const size_t cols = this->network[index]->OutputDimensions()[axis];
-  MatType delta = gyTmp.cols(startCol, startCol + cols - 1);
-  // Reshape so that the batch size is the number of columns.
-  delta.reshape(delta.n_elem / gy.n_cols, gy.n_cols);
-
+  // We only intend to perform a backward pass on one layer, so we only need
+  // the part of gy that corresponds to the desired layer.
+  MatType delta;
+  ChildError(gy, index, delta);
   this->network[index]->Backward(input, this->layerOutputs[index], delta, g);
 }
 
@@ -232,34 +186,17 @@ void ConcatType<MatType>::Gradient(
     const MatType& error,
     MatType& gradient)
 {
-  // Just like the forward pass, we can treat our inputs as a cube, but here we
-  // have to distribute the correct parts of `error` to the layers.
-
-  size_t rows = 1;
-  for (size_t i = 0; i < axis; ++i)
-    rows *= this->outputDimensions[i];
-
-  size_t slices = input.n_cols;
-  for (size_t i = axis + 1; i < this->outputDimensions.size(); ++i)
-    slices *= this->outputDimensions[i];
-
-  arma::Cube<typename MatType::elem_type> errorTmp;
-  MakeAlias(errorTmp, error, rows, this->outputDimensions[axis], slices);
-
-  size_t startCol = 0;
+  MatType err;
   size_t startParam = 0;
   for (size_t i = 0; i < this->network.size(); ++i)
   {
-    const size_t cols = this->network[i]->OutputDimensions()[axis];
     const size_t params = this->network[i]->WeightSize();
 
-    MatType err = errorTmp.cols(startCol, startCol + cols - 1);
-    err.reshape(err.n_elem / input.n_cols, input.n_cols);
+    ChildError(error, i, err);
     MatType gradientAlias;
     MakeAlias(gradientAlias, gradient, params, 1, startParam);
     this->network[i]->Gradient(input, err, gradientAlias);
 
-    startCol += cols;
     startParam += params;
   }
 }
@@ -271,36 +208,51 @@ void ConcatType<MatType>::Gradient(
     MatType& gradient,
     const size_t index)
 {
-  // Just like the forward pass, we can treat our inputs as a cube, but here we
-  // have to distribute the correct parts of `error` to the layers.
+  size_t startParam = 0;
+  for (size_t i = 0; i < index; ++i)
+    startParam += this->network[i]->WeightSize();
+
+  const size_t params = this->network[index]->WeightSize();
 
+  MatType err;
+  ChildError(error, index, err);
+  MatType gradientAlias;
+  MakeAlias(gradientAlias, gradient, params, 1, startParam);
+  this->network[index]->Gradient(input, err, gradientAlias);
+}
+
+template<typename MatType>
+void ConcatType<MatType>::ChildError(const MatType& error,
+                                     const size_t index,
+                                     MatType& childError)
+{
+  // Just like the forward pass, we can treat the error as a cube, and take the
+  // columns of the cube that correspond to the output of the layer.  They are
+  // copied into a cube that aliases `childError`, so that `childError` has the
+  // batch size as its number of columns without reshaping it.
   size_t rows = 1;
   for (size_t i = 0; i < axis; ++i)
     rows *= this->outputDimensions[i];
 
-  size_t slices = input.n_cols;
+  size_t slices = error.n_cols;
   for (size_t i = axis + 1; i < this->outputDimensions.size(); ++i)
     slices *= this->outputDimensions[i];
 
-  arma::Cube<typename MatType::elem_type> errorTmp;
-  MakeAlias(errorTmp, error, rows, this->outputDimensions[axis], slices);
-
   size_t startCol = 0;
-  size_t startParam = 0;
   for (size_t i = 0; i < index; ++i)
-  {
     startCol += this->network[i]->OutputDimensions()[axis];
-    startParam += this->network[i]->WeightSize();
-  }
-
   const size_t cols = this->network[index]->OutputDimensions()[axis];
-  const size_t params = this->network[index]->WeightSize();
 
-  MatType err = errorTmp.cols(startCol, startCol + cols - 1);
-  err.reshape(err.n_elem / input.n_cols, input.n_cols);
-  MatType gradientAlias;
-  MakeAlias(gradientAlias, gradient, params, 1, startParam);
-  this->network[index]->Gradient(input, err, gradientAlias);
+  // Only grow the memory; the held layers may have different output sizes.
+  const size_t childSize = this->network[index]->OutputSize();
+  if (errorMatrix.n_elem < childSize * error.n_cols)
+    errorMatrix.set_size(childSize * error.n_cols, 1);
+  MakeAlias(childError, errorMatrix, childSize, error.n_cols);
+
+  arma::Cube<typename MatType::elem_type> errorAlias, childErrorAlias;
+  MakeAlias(errorAlias, error, rows, this->outputDimensions[axis], slices);
+  MakeAlias(childErrorAlias, childError, rows, cols, slices);
+  childErrorAlias = errorAlias.cols(startCol, startCol + cols - 1);
 }
 
 template<typename MatType>
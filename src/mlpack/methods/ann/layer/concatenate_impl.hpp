@@ -80,9 +80,9 @@ void ConcatenateType<MatType>::Forward(const MatType& input, MatType& output)
         << "not provided." << std::endl;
   }
 
-  output.submat(0, 0, input.n_rows - 1, input.n_cols - 1) = input;
-  output.submat(input.n_rows, 0, output.n_rows - 1, input.n_cols - 1) =
-      repmat(vectorise(concat), 1, input.n_cols);
+  output.rows(0, input.n_rows - 1) = input;
+  if (!concat.is_empty())
+    output.rows(input.n_rows, output.n_rows - 1).each_col() = vectorise(concat);
 }
 
 template<typename MatType>
@@ -17,6 +17,8 @@
 #include <mlpack/methods/ann/convolution_rules/border_modes.hpp>
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/winograd_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
 #include <mlpack/core/util/to_lower.hpp>
 
@@ -58,6 +60,14 @@ namespace mlpack {
  * a 2-D image (or object) of the original 196x14 size, using this as the input
  * for the 14 filters of this example.
  *
+ * By default, the convolution rules are WinogradConvolution: with 3x3 filters,
+ * stride 1 and no dilation, each of the forward, backward and gradient passes
+ * uses the Winograd algorithm on the whole batch, and with any other filter the
+ * rule falls back to Im2ColConvolution, which lowers the whole batch into a
+ * single matrix multiplication.  With any other convolution rule than these
+ * two, one two-dimensional convolution is computed for each pair of input and
+ * output maps of each point.
+ *
  * @tparam ForwardConvolutionRule Convolution to perform forward process.
  * @tparam BackwardConvolutionRule Convolution to perform backward process.
  * @tparam GradientConvolutionRule Convolution to calculate gradient.
@@ -65,9 +75,9 @@ namespace mlpack {
  *    computation.
  */
 template <
-    typename ForwardConvolutionRule = NaiveConvolution<ValidConvolution>,
-    typename BackwardConvolutionRule = NaiveConvolution<FullConvolution>,
-    typename GradientConvolutionRule = NaiveConvolution<ValidConvolution>,
+    typename ForwardConvolutionRule = WinogradConvolution<ValidConvolution>,
+    typename BackwardConvolutionRule = WinogradConvolution<FullConvolution>,
+    typename GradientConvolutionRule = WinogradConvolution<ValidConvolution>,
     typename MatType = arma::mat
 >
 class ConvolutionType : public Layer<MatType>
@@ -253,6 +263,12 @@ class ConvolutionType : public Layer<MatType>
   //! Modify the right padding width.
   size_t& PadWRight() { return padWRight; }
 
+  //! Get whether the layer uses a bias.
+  bool const& UseBias() const { return useBias; }
+  //! Modify whether the layer uses a bias.  This changes WeightSize(), so the
+  //! weights must be set again afterwards.
+  bool& UseBias() { return useBias; }
+
   //! Get size of weights for the layer.
   size_t WeightSize() const
   {
@@ -397,9 +413,9 @@ class ConvolutionType : public Layer<MatType>
 }; // class Convolution
 
 // Standard Convolution layer.
-using Convolution = ConvolutionType<NaiveConvolution<ValidConvolution>,
-                                    NaiveConvolution<FullConvolution>,
-                                    NaiveConvolution<ValidConvolution>,
+using Convolution = ConvolutionType<WinogradConvolution<ValidConvolution>,
+                                    WinogradConvolution<FullConvolution>,
+                                    WinogradConvolution<ValidConvolution>,
                                     arma::mat>;
 
 } // namespace mlpack
@@ -16,6 +16,7 @@
 #include <mlpack/prereqs.hpp>
 
 #include "layer.hpp"
+#include "dropout_mask.hpp"
 
 namespace mlpack {
 
@@ -108,7 +109,7 @@ class DropoutType : public Layer<MatType>
 
  private:
   //! Locally-stored mask object.
-  MatType mask;
+  DropoutMask mask;
 
   //! The probability of setting a value to zero.
   double ratio;
@@ -0,0 +1,149 @@
+/**
+ * @file methods/ann/layer/dropout_mask.hpp
+ *
+ * Definition of the DropoutMask class, a random binary mask stored as packed
+ * bits, used by the Dropout, AlphaDropout and DropConnect layers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_DROPOUT_MASK_HPP
+#define MLPACK_METHODS_ANN_LAYER_DROPOUT_MASK_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+namespace mlpack {
+
+/**
+ * DropoutMask is a random binary mask for a matrix, where each element is kept
+ * with probability `1 - ratio`.  The mask is stored as one bit per element
+ * (instead of one element of the matrix type), and the memory is reused by the
+ * next mask if it is not bigger.
+ *
+ * Each column of the mask is drawn from its own stream of a PhiloxRNG, keyed by
+ * RandStreamKey(), with one 32-bit random number per element; so the columns
+ * are generated in parallel, and the mask does not depend on the number of
+ * threads.  Apply() then computes the masked matrix in a single pass.
+ */
+class DropoutMask
+{
+ public:
+  //! Create an empty mask.
+  DropoutMask() : rows(0), cols(0), wordsPerCol(0) { }
+
+  /**
+   * Draw a new mask of the given size.
+   *
+   * @param rowsIn Number of rows of the mask.
+   * @param colsIn Number of columns of the mask.
+   * @param ratio Probability of dropping each element.
+   */
+  void Generate(const size_t rowsIn, const size_t colsIn, const double ratio)
+  {
+    rows = rowsIn;
+    cols = colsIn;
+    wordsPerCol = (rows + 63) / 64;
+    bits.resize(wordsPerCol * cols);
+
+    // An element is dropped if its random number is less than the threshold.
+    const double clampedRatio = std::min(std::max(ratio, 0.0), 1.0);
+    const uint64_t threshold = (uint64_t) (clampedRatio * 4294967296.0);
+
+    const uint64_t key = RandStreamKey();
+    #pragma omp parallel for schedule(static)
+    for (size_t j = 0; j < cols; ++j)
+    {
+      PhiloxRNG rng(key, j);
+      uint64_t* colBits = bits.data() + j * wordsPerCol;
+      for (size_t w = 0; w < wordsPerCol; ++w)
+      {
+        const size_t wordRows = std::min((size_t) 64, rows - 64 * w);
+        uint64_t word = 0;
+        for (size_t b = 0; b < wordRows; ++b)
+          word |= ((uint64_t) (rng() >= threshold)) << b;
+        colBits[w] = word;
+      }
+    }
+  }
+
+  //! Return whether element (i, j) is kept.
+  bool Kept(const size_t i, const size_t j) const
+  {
+    return (bits[j * wordsPerCol + i / 64] >> (i % 64)) & 1;
+  }
+
+  /**
+   * Compute `output(i, j) = input(i, j) * scale + shift` for the elements that
+   * are kept, and `output(i, j) = dropped` for the others.  `input` must have
+   * the size of the mask; `output` may be the same matrix.
+   *
+   * @param input Matrix to apply the mask to.
+   * @param output Matrix to store the result in.
+   * @param scale Scale of the kept elements.
+   * @param shift Shift of the kept elements.
+   * @param dropped Value of the dropped elements.
+   */
+  template<typename MatType>
+  void Apply(const MatType& input,
+             MatType& output,
+             const double scale,
+             const double shift = 0.0,
+             const double dropped = 0.0) const
+  {
+    using ElemType = typename MatType::elem_type;
+    const ElemType s = (ElemType) scale;
+    const ElemType t = (ElemType) shift;
+    const ElemType d = (ElemType) dropped;
+
+    output.set_size(input.n_rows, input.n_cols);
+    #pragma omp parallel for schedule(static)
+    for (size_t j = 0; j < (size_t) input.n_cols; ++j)
+    {
+      const ElemType* in = input.colptr(j);
+      ElemType* out = output.colptr(j);
+      const uint64_t* colBits = bits.data() + j * wordsPerCol;
+      for (size_t i = 0; i < (size_t) input.n_rows; ++i)
+        out[i] = ((colBits[i / 64] >> (i % 64)) & 1) ? in[i] * s + t : d;
+    }
+  }
+
+  //! Store the mask in the given matrix, as ones (kept) and zeros (dropped).
+  template<typename MatType>
+  void ToMatrix(MatType& m) const
+  {
+    m.set_size(rows, cols);
+    for (size_t j = 0; j < cols; ++j)
+      for (size_t i = 0; i < rows; ++i)
+        m(i, j) = Kept(i, j) ? 1 : 0;
+  }
+
+  //! Free the memory of the mask.
+  void Clear()
+  {
+    rows = cols = wordsPerCol = 0;
+    bits.clear();
+    bits.shrink_to_fit();
+  }
+
+  //! Get the number of rows of the mask.
+  size_t Rows() const { return rows; }
+  //! Get the number of columns of the mask.
+  size_t Cols() const { return cols; }
+
+ private:
+  //! Number of rows of the mask.
+  size_t rows;
+  //! Number of columns of the mask.
+  size_t cols;
+  //! Number of 64-bit words of each column.
+  size_t wordsPerCol;
+  //! The bits of the mask, column by column.
+  std::vector<uint64_t> bits;
+};
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,192 @@
+/**
+ * @file methods/ann/layer/embedding.hpp
+ *
+ * Definition of the Embedding layer, which maps tokens to embedding vectors
+ * and can compute its gradient sparsely, for the embeddings that were used
+ * only.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_EMBEDDING_HPP
+#define MLPACK_METHODS_ANN_LAYER_EMBEDDING_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer.hpp"
+
+namespace mlpack {
+
+/**
+ * The Embedding layer stores one embedding vector for each token of a
+ * vocabulary, and replaces each token of its input with its embedding.  Each
+ * input point (column) is a sequence of tokens, which are integers in
+ * `[0, vocabSize)` stored in the input matrix; the output for a point is the
+ * concatenation of the embeddings of its tokens.  Because tokens are not
+ * differentiable, the Embedding layer is meant to be the first layer of the
+ * network, and its backward pass gives a zero delta.
+ *
+ * The embeddings are stored as the columns of an `embeddingSize x vocabSize`
+ * matrix (see `Parameters()`).  Only the columns of the tokens in a batch have
+ * a non-zero gradient, and the `SparseGradient()` functions compute just these
+ * columns, either as a list of tokens and their gradients or as a sparse
+ * matrix with the shape of the embedding table, so that they can be applied
+ * to huge tables with a cost that depends on the batch and not on the size of
+ * the vocabulary.  (The `Gradient()` function used by the FFN class returns a
+ * dense gradient, as is required for the parameters of a whole network.)
+ *
+ * The input shape: (sequenceLength, batchSize).
+ * The output shape: (embeddingSize * sequenceLength, batchSize).
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class EmbeddingType : public Layer<MatType>
+{
+ public:
+  //! The element type of the matrices.
+  using ElemType = typename MatType::elem_type;
+  //! The type of the sparse gradient.
+  using SpMatType = arma::SpMat<ElemType>;
+
+  //! Create an empty Embedding object.
+  EmbeddingType();
+
+  /**
+   * Create the Embedding object using the specified vocabulary and embedding
+   * size.
+   *
+   * @param vocabSize The number of tokens of the vocabulary.
+   * @param embeddingSize The length of each embedding vector.
+   */
+  EmbeddingType(const size_t vocabSize, const size_t embeddingSize);
+
+  //! Clone the EmbeddingType object. This handles polymorphism correctly.
+  EmbeddingType* Clone() const { return new EmbeddingType(*this); }
+
+  //! Copy the given EmbeddingType layer.
+  EmbeddingType(const EmbeddingType& layer);
+  //! Take ownership of the given EmbeddingType layer.
+  EmbeddingType(EmbeddingType&& layer);
+  //! Copy the given EmbeddingType layer.
+  EmbeddingType& operator=(const EmbeddingType& layer);
+  //! Take ownership of the given EmbeddingType layer.
+  EmbeddingType& operator=(EmbeddingType&& layer);
+
+  //! Virtual destructor.
+  virtual ~EmbeddingType() { }
+
+  //! Reset the layer parameter.
+  void SetWeights(const MatType& weightsIn);
+
+  /**
+   * Replace each token of the input with its embedding.  A
+   * std::invalid_argument is thrown if a token is not in `[0, vocabSize)`.
+   *
+   * @param input Tokens of each point.
+   * @param output Resulting embeddings.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * The tokens are not differentiable, so the delta is zero.
+   *
+   * @param input The input data (x) given to the forward pass.
+   * @param output The propagated data (f(x)) resulting from Forward()
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& /* gy */,
+                MatType& g);
+
+  /**
+   * Calculate the gradient of all the embeddings (as a vector of WeightSize()
+   * elements), which is zero for the tokens that are not in the input.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Gradient(const MatType& input,
+                const MatType& error,
+                MatType& gradient);
+
+  /**
+   * Calculate the gradient of the embeddings of the tokens in the input only.
+   * `tokens` is set to the sorted distinct tokens of the input, and column `j`
+   * of `tokenGradients` to the gradient of the embedding of `tokens[j]`.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param tokens Distinct tokens of the input.
+   * @param tokenGradients Gradient of the embedding of each token.
+   */
+  void SparseGradient(const MatType& input,
+                      const MatType& error,
+                      arma::uvec& tokens,
+                      MatType& tokenGradients);
+
+  /**
+   * Calculate the gradient of the embeddings as a sparse matrix with the shape
+   * of the embedding table (embeddingSize x vocabSize), whose only non-zero
+   * columns are the ones of the tokens in the input.  This can be given to
+   * optimizers that accept sparse gradients, or applied to `Parameters()`
+   * directly: `Parameters() -= stepSize * gradient` only visits the non-zero
+   * columns.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void SparseGradient(const MatType& input,
+                      const MatType& error,
+                      SpMatType& gradient);
+
+  //! Get the parameters (the embeddings, one column per token).
+  const MatType& Parameters() const { return weights; }
+  //! Modify the parameters (the embeddings, one column per token).
+  MatType& Parameters() { return weights; }
+
+  //! Get the size of the vocabulary.
+  size_t VocabSize() const { return vocabSize; }
+  //! Get the length of each embedding vector.
+  size_t EmbeddingSize() const { return embeddingSize; }
+
+  //! Get the number of trainable parameters.
+  size_t WeightSize() const { return embeddingSize * vocabSize; }
+
+  //! Compute the output dimensions of the layer using `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  //! Serialize the layer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Throw if any token of the input is not in the vocabulary.
+  void CheckTokens(const MatType& input) const;
+
+  //! Locally-stored size of the vocabulary.
+  size_t vocabSize;
+
+  //! Locally-stored length of each embedding vector.
+  size_t embeddingSize;
+
+  //! Locally-stored embeddings (embeddingSize x vocabSize).
+  MatType weights;
+}; // class EmbeddingType
+
+// Standard Embedding layer.
+using Embedding = EmbeddingType<arma::mat>;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "embedding_impl.hpp"
+
+#endif
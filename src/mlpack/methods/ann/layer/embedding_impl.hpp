@@ -0,0 +1,238 @@
+/**
+ * @file methods/ann/layer/embedding_impl.hpp
+ *
+ * Implementation of the Embedding layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_EMBEDDING_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_EMBEDDING_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "embedding.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+EmbeddingType<MatType>::EmbeddingType() :
+    Layer<MatType>(),
+    vocabSize(0),
+    embeddingSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+EmbeddingType<MatType>::EmbeddingType(const size_t vocabSize,
+                                      const size_t embeddingSize) :
+    Layer<MatType>(),
+    vocabSize(vocabSize),
+    embeddingSize(embeddingSize)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+EmbeddingType<MatType>::EmbeddingType(const EmbeddingType& layer) :
+    Layer<MatType>(layer),
+    vocabSize(layer.vocabSize),
+    embeddingSize(layer.embeddingSize)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+EmbeddingType<MatType>::EmbeddingType(EmbeddingType&& layer) :
+    Layer<MatType>(std::move(layer)),
+    vocabSize(std::move(layer.vocabSize)),
+    embeddingSize(std::move(layer.embeddingSize))
+{
+  // Reset parameters of other layer.
+  layer.vocabSize = 0;
+  layer.embeddingSize = 0;
+}
+
+template<typename MatType>
+EmbeddingType<MatType>&
+EmbeddingType<MatType>::operator=(const EmbeddingType& layer)
+{
+  if (this != &layer)
+  {
+    Layer<MatType>::operator=(layer);
+    vocabSize = layer.vocabSize;
+    embeddingSize = layer.embeddingSize;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+EmbeddingType<MatType>&
+EmbeddingType<MatType>::operator=(EmbeddingType&& layer)
+{
+  if (this != &layer)
+  {
+    Layer<MatType>::operator=(std::move(layer));
+    vocabSize = std::move(layer.vocabSize);
+    embeddingSize = std::move(layer.embeddingSize);
+
+    // Reset parameters of other layer.
+    layer.vocabSize = 0;
+    layer.embeddingSize = 0;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+void EmbeddingType<MatType>::SetWeights(const MatType& weightsIn)
+{
+  MakeAlias(weights, weightsIn, embeddingSize, vocabSize);
+}
+
+template<typename MatType>
+void EmbeddingType<MatType>::Forward(const MatType& input, MatType& output)
+{
+  CheckTokens(input);
+
+  const size_t seqLength = input.n_rows;
+
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < (size_t) input.n_cols; ++i)
+  {
+    for (size_t t = 0; t < seqLength; ++t)
+    {
+      const size_t token = (size_t) input(t, i);
+      output.submat(t * embeddingSize, i, (t + 1) * embeddingSize - 1, i) =
+          weights.col(token);
+    }
+  }
+}
+
+template<typename MatType>
+void EmbeddingType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& /* gy */,
+    MatType& g)
+{
+  g.zeros();
+}
+
+template<typename MatType>
+void EmbeddingType<MatType>::Gradient(
+    const MatType& input,
+    const MatType& error,
+    MatType& gradient)
+{
+  MatType gradientMat;
+  MakeAlias(gradientMat, gradient, embeddingSize, vocabSize);
+  gradientMat.zeros();
+
+  // Tokens may appear several times in a batch, so the gradients are
+  // accumulated serially.
+  const size_t seqLength = input.n_rows;
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    for (size_t t = 0; t < seqLength; ++t)
+    {
+      gradientMat.col((size_t) input(t, i)) += error.submat(t * embeddingSize,
+          i, (t + 1) * embeddingSize - 1, i);
+    }
+  }
+}
+
+template<typename MatType>
+void EmbeddingType<MatType>::SparseGradient(
+    const MatType& input,
+    const MatType& error,
+    arma::uvec& tokens,
+    MatType& tokenGradients)
+{
+  CheckTokens(input);
+
+  // Sorted distinct tokens of the batch.
+  tokens = arma::unique(ConvTo<arma::uvec>::From(arma::vectorise(input)));
+  tokenGradients.zeros(embeddingSize, tokens.n_elem);
+
+  const size_t seqLength = input.n_rows;
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    for (size_t t = 0; t < seqLength; ++t)
+    {
+      const size_t token = (size_t) input(t, i);
+      const size_t index = std::lower_bound(tokens.begin(), tokens.end(),
+          token) - tokens.begin();
+      tokenGradients.col(index) += error.submat(t * embeddingSize, i,
+          (t + 1) * embeddingSize - 1, i);
+    }
+  }
+}
+
+template<typename MatType>
+void EmbeddingType<MatType>::SparseGradient(
+    const MatType& input,
+    const MatType& error,
+    SpMatType& gradient)
+{
+  arma::uvec tokens;
+  MatType tokenGradients;
+  SparseGradient(input, error, tokens, tokenGradients);
+
+  // Build the compressed sparse column representation directly: each column
+  // of a token holds a full embedding, and the other columns are empty.
+  arma::uvec rowIndices(embeddingSize * tokens.n_elem);
+  arma::uvec colPtrs(vocabSize + 1, arma::fill::zeros);
+  for (size_t j = 0; j < tokens.n_elem; ++j)
+  {
+    rowIndices.subvec(j * embeddingSize, (j + 1) * embeddingSize - 1) =
+        arma::regspace<arma::uvec>(0, embeddingSize - 1);
+    colPtrs[tokens[j] + 1] = embeddingSize;
+  }
+  colPtrs = arma::cumsum(colPtrs);
+
+  gradient = SpMatType(rowIndices, colPtrs,
+      arma::Col<ElemType>(tokenGradients.memptr(), tokenGradients.n_elem,
+      false, true), embeddingSize, vocabSize);
+}
+
+template<typename MatType>
+void EmbeddingType<MatType>::ComputeOutputDimensions()
+{
+  // Each token is replaced by its embedding, which adds a dimension.
+  this->outputDimensions = std::vector<size_t>(
+      this->inputDimensions.size() + 1, embeddingSize);
+  for (size_t i = 0; i < this->inputDimensions.size(); ++i)
+    this->outputDimensions[i + 1] = this->inputDimensions[i];
+}
+
+template<typename MatType>
+void EmbeddingType<MatType>::CheckTokens(const MatType& input) const
+{
+  if (input.n_elem > 0 && (input.min() < 0 || input.max() >= vocabSize))
+  {
+    std::ostringstream oss;
+    oss << "Embedding: input tokens must be in [0, " << vocabSize << "), but "
+        << "the input contains tokens in [" << input.min() << ", "
+        << input.max() << "]!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+template<typename MatType>
+template<typename Archive>
+void EmbeddingType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(vocabSize));
+  ar(CEREAL_NVP(embeddingSize));
+}
+
+} // namespace mlpack
+
+#endif
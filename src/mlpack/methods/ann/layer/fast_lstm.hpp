@@ -0,0 +1,224 @@
+/**
+ * @file methods/ann/layer/fast_lstm.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the FastLSTM class, which implements a LSTM network layer
+ * without peephole connections, using stacked gate weights.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_FAST_LSTM_HPP
+#define MLPACK_METHODS_ANN_LAYER_FAST_LSTM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "recurrent_layer.hpp"
+
+namespace mlpack {
+
+/**
+ * An implementation of a faster version of the LSTM network layer, without
+ * peephole connections between the cell and the gates:
+ *
+ * i_t = sigmoid(W_i x_t + R_i y_{t - 1} + b_i)
+ * o_t = sigmoid(W_o x_t + R_o y_{t - 1} + b_o)
+ * f_t = sigmoid(W_f x_t + R_f y_{t - 1} + b_f)
+ * z_t =    tanh(W_z x_t + R_z y_{t - 1} + b_z)
+ * c_t = i_t % z_t + f_t % c_{t - 1}
+ * y_t = o_t % tanh(c_t)
+ *
+ * The weights of the four gates are stacked into one input weight matrix
+ * W = [W_i; W_o; W_f; W_z] and one recurrent weight matrix
+ * R = [R_i; R_o; R_f; R_z], so each time step takes a single matrix product
+ * with the input and a single one with the previous output, after which the
+ * bias, the nonlinearities and the cell update are applied in one pass over
+ * the gates.  The backward pass is organized in the same way.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @article{Hochreiter1997,
+ *   author  = {Hochreiter, Sepp and Schmidhuber, J\"{u}rgen},
+ *   title   = {Long Short-term Memory},
+ *   journal = {Neural Comput.},
+ *   year    = {1997},
+ *   url     = {https://www.bioinf.jku.at/publications/older/2604.pdf}
+ * }
+ * @endcode
+ *
+ * \see LSTM for an implementation of the LSTM layer with peephole connections.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class FastLSTMType : public RecurrentLayer<MatType>
+{
+ public:
+  //! Create the FastLSTM object.
+  FastLSTMType();
+
+  /**
+   * Create the FastLSTM layer object using the specified parameters.
+   *
+   * @param outSize The number of output units.
+   */
+  FastLSTMType(const size_t outSize);
+
+  //! Clone the FastLSTMType object. This handles polymorphism correctly.
+  FastLSTMType* Clone() const { return new FastLSTMType(*this); }
+
+  //! Copy the given FastLSTMType object.
+  FastLSTMType(const FastLSTMType& other);
+  //! Take ownership of the given FastLSTMType object's data.
+  FastLSTMType(FastLSTMType&& other);
+  //! Copy the given FastLSTMType object.
+  FastLSTMType& operator=(const FastLSTMType& other);
+  //! Take ownership of the given FastLSTMType object's data.
+  FastLSTMType& operator=(FastLSTMType&& other);
+
+  virtual ~FastLSTMType() { }
+
+  /**
+   * Reset the layer parameter. The method is called to
+   * assign the allocated memory to the internal learnable parameters.
+   */
+  void SetWeights(const MatType& weightsIn);
+
+  /**
+   * Ordinary feed-forward pass of a neural network, evaluating the function
+   * f(x) by propagating the activity forward through f.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * Ordinary feed backward pass of a neural network, calculating the function
+   * f(x) by propagating x backwards trough f. Using the results from the feed
+   * forward pass.
+   *
+   * @param input The input data (x) given to the forward pass.
+   * @param output The propagated data (f(x)) resulting from Forward()
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& output,
+                const MatType& gy,
+                MatType& g);
+
+  /*
+   * Calculate the gradient using the output delta and the input activation.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Gradient(const MatType& input,
+                const MatType& /* error */,
+                MatType& gradient);
+
+  // Get the parameters.
+  const MatType& Parameters() const { return weights; }
+  // Modify the parameters.
+  MatType& Parameters() { return weights; }
+
+  // Get the stacked input weight matrix [W_i; W_o; W_f; W_z].
+  const MatType& InputWeight() const { return inputWeight; }
+  // Modify the stacked input weight matrix [W_i; W_o; W_f; W_z].
+  MatType& InputWeight() { return inputWeight; }
+  // Get the stacked bias vector [b_i; b_o; b_f; b_z].
+  const MatType& Bias() const { return bias; }
+  // Modify the stacked bias vector [b_i; b_o; b_f; b_z].
+  MatType& Bias() { return bias; }
+  // Get the stacked recurrent weight matrix [R_i; R_o; R_f; R_z].
+  const MatType& RecurrentWeight() const { return recurrentWeight; }
+  // Modify the stacked recurrent weight matrix [R_i; R_o; R_f; R_z].
+  MatType& RecurrentWeight() { return recurrentWeight; }
+
+  // Get the total number of trainable parameters.
+  size_t WeightSize() const;
+
+  // Get the total number of recurrent state parameters.
+  size_t RecurrentSize() const;
+
+  // Given a properly set InputDimensions(), compute the output dimensions.
+  void ComputeOutputDimensions()
+  {
+    inSize = std::accumulate(this->inputDimensions.begin(),
+        this->inputDimensions.end(), 1, std::multiplies<size_t>());
+    this->outputDimensions = std::vector<size_t>(this->inputDimensions.size(),
+        1);
+
+    // The FastLSTM layer flattens its input.
+    this->outputDimensions[0] = outSize;
+  }
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  // Locally-stored number of input units.
+  size_t inSize;
+
+  // Locally-stored number of output units.
+  size_t outSize;
+
+  // Locally-stored weight object.
+  MatType weights;
+
+  // Stacked weights of the input connections, the biases, and the recurrent
+  // connections.
+  MatType inputWeight;
+  MatType bias;
+  MatType recurrentWeight;
+
+  // These matrices are internally used for computation only; they are aliases
+  // for recurrent state.  `gates` holds the activations of i, o, f and z (in
+  // that order) for each point.
+  MatType thisRecurrent;
+  MatType thisCell;
+  MatType gates;
+  MatType prevRecurrent;
+  MatType prevCell;
+
+  // These matrices are also internally used for computation only.
+  // Everything below 'workspace' is an alias of memory in 'workspace'.
+  MatType workspace;
+  MatType deltaY;
+  // Deltas of the gates before the nonlinearities.
+  MatType deltaGates;
+  // The part of dc_t that is passed to c_{t - 1}: dc_t % f_t.
+  MatType deltaCellCarry;
+  // These correspond to, e.g., dgates_{t + 1}.
+  MatType nextDeltaGates;
+  MatType nextDeltaCellCarry;
+
+  // Calling this function will set all the aliases for the functions above to
+  // the correct places in the current recurrent state methods.
+  void SetInternalAliases(const size_t batchSize);
+
+  // Calling this function will set up workspace memory for the backward pass,
+  // if necessary.
+  void SetBackwardWorkspace(const size_t batchSize);
+}; // class FastLSTMType
+
+// Convenience typedefs.
+
+// Standard FastLSTM layer.
+using FastLSTM = FastLSTMType<arma::mat>;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "fast_lstm_impl.hpp"
+
+#endif
@@ -0,0 +1,329 @@
+/**
+ * @file methods/ann/layer/fast_lstm_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the FastLSTM class, which implements a fast lstm network
+ * layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_FAST_LSTM_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_FAST_LSTM_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "fast_lstm.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+FastLSTMType<MatType>::FastLSTMType() :
+    RecurrentLayer<MatType>(),
+    inSize(0),
+    outSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+FastLSTMType<MatType>::FastLSTMType(const size_t outSize) :
+    RecurrentLayer<MatType>(),
+    inSize(0),
+    outSize(outSize)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+FastLSTMType<MatType>::FastLSTMType(const FastLSTMType& layer) :
+    RecurrentLayer<MatType>(layer),
+    inSize(layer.inSize),
+    outSize(layer.outSize)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+FastLSTMType<MatType>::FastLSTMType(FastLSTMType&& layer) :
+    RecurrentLayer<MatType>(std::move(layer)),
+    inSize(layer.inSize),
+    outSize(layer.outSize)
+{
+  layer.inSize = 0;
+  layer.outSize = 0;
+}
+
+template<typename MatType>
+FastLSTMType<MatType>&
+FastLSTMType<MatType>::operator=(const FastLSTMType& layer)
+{
+  if (this != &layer)
+  {
+    RecurrentLayer<MatType>::operator=(layer);
+    inSize = layer.inSize;
+    outSize = layer.outSize;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+FastLSTMType<MatType>&
+FastLSTMType<MatType>::operator=(FastLSTMType&& layer)
+{
+  if (this != &layer)
+  {
+    RecurrentLayer<MatType>::operator=(std::move(layer));
+    inSize = layer.inSize;
+    outSize = layer.outSize;
+
+    layer.inSize = 0;
+    layer.outSize = 0;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+void FastLSTMType<MatType>::SetWeights(const MatType& weightsIn)
+{
+  MakeAlias(weights, weightsIn, WeightSize(), 1);
+  MakeAlias(inputWeight, weightsIn, 4 * outSize, inSize);
+  MakeAlias(bias, weightsIn, 4 * outSize, 1, inputWeight.n_elem);
+  MakeAlias(recurrentWeight, weightsIn, 4 * outSize, outSize,
+      inputWeight.n_elem + bias.n_elem);
+}
+
+template<typename MatType>
+void FastLSTMType<MatType>::Forward(const MatType& input, MatType& output)
+{
+  using ElemType = typename MatType::elem_type;
+
+  // Convenience alias.
+  const size_t batchSize = input.n_cols;
+
+  // The internal quantities are stored as recurrent state; so, set aliases
+  // correctly for this time step.
+  SetInternalAliases(batchSize);
+
+  // Compute the pre-activations of all four gates with one matrix product for
+  // the input, and one for the recurrent connection.
+  gates = inputWeight * input;
+  if (this->HasPreviousStep())
+    gates += recurrentWeight * prevRecurrent;
+
+  // Now add the bias, apply the nonlinearities, and update the cell and output
+  // in a single pass.
+  const bool hasPreviousStep = this->HasPreviousStep();
+  output.set_size(outSize, batchSize);
+
+  #pragma omp parallel for
+  for (size_t c = 0; c < batchSize; ++c)
+  {
+    ElemType* i = gates.colptr(c);
+    ElemType* o = i + outSize;
+    ElemType* f = o + outSize;
+    ElemType* z = f + outSize;
+    const ElemType* b = bias.memptr();
+    ElemType* cell = thisCell.colptr(c);
+    ElemType* y = output.colptr(c);
+
+    for (size_t r = 0; r < outSize; ++r)
+    {
+      i[r] = 1 / (1 + std::exp(-(i[r] + b[r])));
+      o[r] = 1 / (1 + std::exp(-(o[r] + b[outSize + r])));
+      f[r] = 1 / (1 + std::exp(-(f[r] + b[2 * outSize + r])));
+      z[r] = std::tanh(z[r] + b[3 * outSize + r]);
+
+      cell[r] = i[r] * z[r];
+      if (hasPreviousStep)
+        cell[r] += f[r] * prevCell(r, c);
+
+      y[r] = o[r] * std::tanh(cell[r]);
+    }
+  }
+
+  // If necessary, store the recurrent output.
+  if (!this->AtFinalStep())
+    thisRecurrent = output;
+}
+
+template<typename MatType>
+void FastLSTMType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& output,
+    const MatType& gy,
+    MatType& g)
+{
+  using ElemType = typename MatType::elem_type;
+
+  // Compute backward partial derivatives.  As in the LSTM layer, `o_t` (for
+  // example) refers to the output gate *after* the nonlinearity, but `do_t`
+  // refers to the delta *before* the nonlinearity.
+  //
+  // dy_t = gy + R^T dgates_{t + 1}
+  //
+  // do_t = dy_t % tanh(c_t) % (o_t % (1 - o_t))
+  // dc_t = dy_t % o_t % (1 - tanh(c_t) .^ 2) + dc_{t + 1} % f_{t + 1}
+  // df_t = dc_t % c_{t - 1} % (f_t % (1 - f_t))
+  // di_t = dc_t % z_t       % (i_t % (1 - i_t))
+  // dz_t = dc_t % i_t       % (1 - z_t .^ 2)
+  //
+  // dx_t = W^T dgates_t
+  const size_t batchSize = output.n_cols;
+  SetInternalAliases(batchSize);
+  SetBackwardWorkspace(batchSize);
+
+  if (this->AtFinalStep())
+    deltaY = gy;
+  else
+    deltaY = gy + recurrentWeight.t() * nextDeltaGates;
+
+  const bool atFinalStep = this->AtFinalStep();
+  const bool hasPreviousStep = this->HasPreviousStep();
+
+  #pragma omp parallel for
+  for (size_t c = 0; c < batchSize; ++c)
+  {
+    const ElemType* i = gates.colptr(c);
+    const ElemType* o = i + outSize;
+    const ElemType* f = o + outSize;
+    const ElemType* z = f + outSize;
+    ElemType* di = deltaGates.colptr(c);
+    ElemType* dO = di + outSize;
+    ElemType* df = dO + outSize;
+    ElemType* dz = df + outSize;
+    const ElemType* dy = deltaY.colptr(c);
+    const ElemType* cell = thisCell.colptr(c);
+    ElemType* carry = deltaCellCarry.colptr(c);
+
+    for (size_t r = 0; r < outSize; ++r)
+    {
+      const ElemType tanhCell = std::tanh(cell[r]);
+      dO[r] = dy[r] * tanhCell * o[r] * (1 - o[r]);
+
+      ElemType dc = dy[r] * o[r] * (1 - tanhCell * tanhCell);
+      if (!atFinalStep)
+        dc += nextDeltaCellCarry(r, c);
+
+      df[r] = (hasPreviousStep) ? dc * prevCell(r, c) * f[r] * (1 - f[r]) : 0;
+      di[r] = dc * z[r] * i[r] * (1 - i[r]);
+      dz[r] = dc * i[r] * (1 - z[r] * z[r]);
+      carry[r] = dc * f[r];
+    }
+  }
+
+  // Finally, compute deltaX.
+  g = inputWeight.t() * deltaGates;
+}
+
+template<typename MatType>
+void FastLSTMType<MatType>::Gradient(
+    const MatType& input,
+    const MatType& /* error */,
+    MatType& gradient)
+{
+  // This implementation depends on Gradient() being called just after
+  // Backward(), so the workspace aliases are already set by
+  // SetBackwardWorkspace().
+  MatType inputWeightGradient, biasGradient, recurrentWeightGradient;
+  MakeAlias(inputWeightGradient, gradient, 4 * outSize, inSize);
+  MakeAlias(biasGradient, gradient, 4 * outSize, 1, inputWeight.n_elem);
+  MakeAlias(recurrentWeightGradient, gradient, 4 * outSize, outSize,
+      inputWeight.n_elem + bias.n_elem);
+
+  // dW = < dgates_t, x_t >
+  inputWeightGradient = deltaGates * input.t();
+  // db = sum(dgates_t)
+  biasGradient = sum(deltaGates, 1);
+  // dR = < dgates_t, y_{t - 1} >; there is no recurrent input at the first
+  // time step.
+  if (this->HasPreviousStep())
+    recurrentWeightGradient = deltaGates * prevRecurrent.t();
+  else
+    recurrentWeightGradient.zeros();
+}
+
+template<typename MatType>
+size_t FastLSTMType<MatType>::WeightSize() const
+{
+  return 4 * outSize * inSize /* input weight connections */ +
+      4 * outSize /* bias */ +
+      4 * outSize * outSize /* recurrent weight connections */;
+}
+
+template<typename MatType>
+size_t FastLSTMType<MatType>::RecurrentSize() const
+{
+  // We have to account for the output, the cell, and the activations of the
+  // four gates, which we compute in Forward() and use in Backward().
+  return 6 * outSize;
+}
+
+template<typename MatType>
+void FastLSTMType<MatType>::SetInternalAliases(const size_t batchSize)
+{
+  // Make all of the aliases for internal state point to the correct place.
+  MatType& state = this->RecurrentState(this->CurrentStep());
+
+  MakeAlias(thisRecurrent, state, outSize, batchSize);
+  MakeAlias(thisCell, state, outSize, batchSize, outSize * batchSize);
+  MakeAlias(gates, state, 4 * outSize, batchSize, 2 * outSize * batchSize);
+
+  // Make aliases for the previous time step, too, if we can.
+  if (this->HasPreviousStep())
+  {
+    MatType& prevState = this->RecurrentState(this->PreviousStep());
+
+    MakeAlias(prevRecurrent, prevState, outSize, batchSize);
+    MakeAlias(prevCell, prevState, outSize, batchSize, outSize * batchSize);
+  }
+}
+
+template<typename MatType>
+void FastLSTMType<MatType>::SetBackwardWorkspace(const size_t batchSize)
+{
+  // We need to hold the gate and cell deltas for two time steps, plus deltaY.
+  workspace.set_size(11 * outSize, batchSize);
+
+  const size_t thisOffset = (this->CurrentStep() % 2 == 0) ? 0 : 5;
+  const size_t nextOffset = 5 - thisOffset;
+
+  MakeAlias(deltaGates, workspace, 4 * outSize, batchSize,
+      thisOffset * outSize * batchSize);
+  MakeAlias(deltaCellCarry, workspace, outSize, batchSize,
+      (thisOffset + 4) * outSize * batchSize);
+  MakeAlias(nextDeltaGates, workspace, 4 * outSize, batchSize,
+      nextOffset * outSize * batchSize);
+  MakeAlias(nextDeltaCellCarry, workspace, outSize, batchSize,
+      (nextOffset + 4) * outSize * batchSize);
+  MakeAlias(deltaY, workspace, outSize, batchSize, 10 * outSize * batchSize);
+}
+
+template<typename MatType>
+template<typename Archive>
+void FastLSTMType<MatType>::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<RecurrentLayer<MatType>>(this));
+
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+
+  // Clear internal scratch space if we are loading.
+  if (Archive::is_loading::value)
+  {
+    workspace.clear();
+
+    deltaY.clear();
+    deltaGates.clear();
+    deltaCellCarry.clear();
+    nextDeltaGates.clear();
+    nextDeltaCellCarry.clear();
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,147 @@
+/**
+ * @file methods/ann/layer/fused_linear.hpp
+ *
+ * Definition of the FusedLinear layer, a Linear layer fused with the
+ * elementwise activation function that follows it, for inference.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_FUSED_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_FUSED_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer.hpp"
+#include "linear.hpp"
+#include "base_layer.hpp"
+
+namespace mlpack {
+
+/**
+ * The FusedLinear layer computes y = f(Ax + b) for an elementwise activation
+ * function f in a single layer.  The bias is added and the activation is
+ * applied in a single pass over the result of the matrix product, instead of
+ * the three passes (and extra output matrix) used by a Linear layer followed
+ * by an activation layer.  The weights have exactly the same layout as those
+ * of a Linear layer.
+ *
+ * A FusedLinear layer is usually not created directly; instead, call
+ * `FFN::Fuse()` on a trained network.  The layer is inference-only:
+ * Backward() and Gradient() throw.
+ *
+ * @tparam ActivationFunction Activation function to apply; it must have a
+ *    static scalar `Fn(x)` function (e.g. RectifierFunction).
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename ActivationFunction = RectifierFunction,
+         typename MatType = arma::mat>
+class FusedLinearType : public Layer<MatType>
+{
+ public:
+  //! Create an empty FusedLinear object (for serialization).
+  FusedLinearType();
+
+  /**
+   * Create a FusedLinear layer with the same weights as the given Linear layer.
+   * The Linear layer must have its output dimensions computed.  After
+   * construction, the weights must be set with SetWeights().
+   *
+   * @param layer Linear layer to fuse.
+   */
+  template<typename RegularizerType>
+  FusedLinearType(const LinearType<MatType, RegularizerType>& layer);
+
+  virtual ~FusedLinearType() { }
+
+  //! Clone the FusedLinearType object. This handles polymorphism correctly.
+  FusedLinearType* Clone() const { return new FusedLinearType(*this); }
+
+  /**
+   * Reset the layer parameter (weights and bias). The method is called to
+   * assign the allocated memory to the internal learnable parameters.
+   */
+  void SetWeights(const MatType& weightsIn);
+
+  /**
+   * Compute the output of the layer, f(Ax + b).
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  //! FusedLinear layers are inference-only; this throws an exception.
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& /* gy */,
+                MatType& /* g */);
+
+  //! FusedLinear layers are inference-only; this throws an exception.
+  void Gradient(const MatType& /* input */,
+                const MatType& /* error */,
+                MatType& /* gradient */);
+
+  //! Get the parameters.
+  const MatType& Parameters() const { return weights; }
+  //! Modify the parameters.
+  MatType& Parameters() { return weights; }
+
+  //! Get the weight of the layer.
+  MatType const& Weight() const { return weight; }
+  //! Modify the weight of the layer.
+  MatType& Weight() { return weight; }
+
+  //! Get the bias of the layer.
+  MatType const& Bias() const { return bias; }
+  //! Modify the bias weights of the layer.
+  MatType& Bias() { return bias; }
+
+  //! Get the size of the weights.
+  size_t WeightSize() const { return (inSize * outSize) + outSize; }
+
+  //! Compute the output dimensions of the layer given `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  //! Serialize the layer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! Locally-stored weight object.  This holds all the weights in a vectorized
+  //! form; i.e., the weight and the bias.
+  MatType weights;
+
+  //! Locally-stored weight parameters.
+  MatType weight;
+
+  //! Locally-stored bias term parameters.
+  MatType bias;
+}; // class FusedLinearType
+
+// Convenience typedefs.
+
+// Linear layer fused with a ReLU activation.
+using FusedLinearReLU = FusedLinearType<RectifierFunction, arma::mat>;
+
+// Linear layer fused with a sigmoid activation.
+using FusedLinearSigmoid = FusedLinearType<LogisticFunction, arma::mat>;
+
+// Linear layer fused with a tanh activation.
+using FusedLinearTanH = FusedLinearType<TanhFunction, arma::mat>;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "fused_linear_impl.hpp"
+
+#endif
@@ -0,0 +1,111 @@
+/**
+ * @file methods/ann/layer/fused_linear_impl.hpp
+ *
+ * Implementation of the FusedLinear layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_FUSED_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_FUSED_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "fused_linear.hpp"
+
+namespace mlpack {
+
+template<typename ActivationFunction, typename MatType>
+FusedLinearType<ActivationFunction, MatType>::FusedLinearType() :
+    Layer<MatType>(),
+    inSize(0),
+    outSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename ActivationFunction, typename MatType>
+template<typename RegularizerType>
+FusedLinearType<ActivationFunction, MatType>::FusedLinearType(
+    const LinearType<MatType, RegularizerType>& layer) :
+    Layer<MatType>(layer),
+    inSize(layer.Weight().n_cols),
+    outSize(layer.Weight().n_rows)
+{
+  // Nothing to do here.
+}
+
+template<typename ActivationFunction, typename MatType>
+void FusedLinearType<ActivationFunction, MatType>::SetWeights(
+    const MatType& weightsIn)
+{
+  MakeAlias(weights, weightsIn, outSize * inSize + outSize, 1);
+  MakeAlias(weight, weightsIn, outSize, inSize);
+  MakeAlias(bias, weightsIn, outSize, 1, weight.n_elem);
+}
+
+template<typename ActivationFunction, typename MatType>
+void FusedLinearType<ActivationFunction, MatType>::Forward(
+    const MatType& input, MatType& output)
+{
+  output = weight * input;
+
+  // Add the bias and apply the activation in the same pass.
+  #pragma omp parallel for
+  for (size_t c = 0; c < (size_t) output.n_cols; ++c)
+  {
+    typename MatType::elem_type* out = output.colptr(c);
+    for (size_t r = 0; r < outSize; ++r)
+      out[r] = ActivationFunction::Fn(out[r] + bias[r]);
+  }
+}
+
+template<typename ActivationFunction, typename MatType>
+void FusedLinearType<ActivationFunction, MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& /* gy */,
+    MatType& /* g */)
+{
+  throw std::invalid_argument("FusedLinear::Backward(): fused layers can only "
+      "be used for inference!");
+}
+
+template<typename ActivationFunction, typename MatType>
+void FusedLinearType<ActivationFunction, MatType>::Gradient(
+    const MatType& /* input */,
+    const MatType& /* error */,
+    MatType& /* gradient */)
+{
+  throw std::invalid_argument("FusedLinear::Gradient(): fused layers can only "
+      "be used for inference!");
+}
+
+template<typename ActivationFunction, typename MatType>
+void FusedLinearType<ActivationFunction, MatType>::ComputeOutputDimensions()
+{
+  inSize = this->inputDimensions[0];
+  for (size_t i = 1; i < this->inputDimensions.size(); ++i)
+    inSize *= this->inputDimensions[i];
+  this->outputDimensions = std::vector<size_t>(this->inputDimensions.size(),
+      1);
+
+  // Like the Linear layer, the FusedLinear layer flattens its input.
+  this->outputDimensions[0] = outSize;
+}
+
+template<typename ActivationFunction, typename MatType>
+template<typename Archive>
+void FusedLinearType<ActivationFunction, MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+}
+
+} // namespace mlpack
+
+#endif
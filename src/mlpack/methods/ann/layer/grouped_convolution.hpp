@@ -18,6 +18,8 @@
 #include <mlpack/methods/ann/convolution_rules/border_modes.hpp>
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/winograd_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
 #include <mlpack/core/util/to_lower.hpp>
 
@@ -62,6 +64,14 @@ namespace mlpack {
  * }
  * @endcode
  *
+ * By default, the convolution rules are WinogradConvolution: with 3x3 filters,
+ * stride 1 and no dilation, each of the forward, backward and gradient passes
+ * uses the Winograd algorithm on the whole batch, and with any other filter the
+ * rule falls back to Im2ColConvolution, which lowers the whole batch into a
+ * single matrix multiplication.  With any other convolution rule than these
+ * two, one two-dimensional convolution is computed for each pair of input and
+ * output maps of each point.
+ *
  * @tparam ForwardConvolutionRule Convolution to perform forward process.
  * @tparam BackwardConvolutionRule Convolution to perform backward process.
  * @tparam GradientConvolutionRule Convolution to calculate gradient.
@@ -69,9 +79,9 @@ namespace mlpack {
  *    computation.
  */
 template <
-    typename ForwardConvolutionRule = NaiveConvolution<ValidConvolution>,
-    typename BackwardConvolutionRule = NaiveConvolution<FullConvolution>,
-    typename GradientConvolutionRule = NaiveConvolution<ValidConvolution>,
+    typename ForwardConvolutionRule = WinogradConvolution<ValidConvolution>,
+    typename BackwardConvolutionRule = WinogradConvolution<FullConvolution>,
+    typename GradientConvolutionRule = WinogradConvolution<ValidConvolution>,
     typename MatType = arma::mat
 >
 class GroupedConvolutionType : public Layer<MatType>
@@ -418,9 +428,9 @@ class GroupedConvolutionType : public Layer<MatType>
 
 // Standard Convolution layer.
 using GroupedConvolution = GroupedConvolutionType<
-    NaiveConvolution<ValidConvolution>,
-    NaiveConvolution<FullConvolution>,
-    NaiveConvolution<ValidConvolution>,
+    WinogradConvolution<ValidConvolution>,
+    WinogradConvolution<FullConvolution>,
+    WinogradConvolution<ValidConvolution>,
     arma::mat>;
 
 } // namespace mlpack
@@ -329,6 +329,25 @@ void GroupedConvolutionType<
 
   MakeAlias(outputTemp, output, this->outputDimensions[0],
       this->outputDimensions[1], maps * higherInDimensions * batchSize);
+
+  if constexpr (HasBatchConvolution<ForwardConvolutionRule>::value)
+  {
+    // Convolve the whole batch (including any higher dimensions) at once with
+    // the batch functions of the convolution rule.
+    ForwardConvolutionRule::ForwardBatch(inputTemp, weight, outputTemp, inMaps,
+        groups, strideWidth, strideHeight);
+
+    // Make sure to add the bias.
+    if (useBias)
+    {
+      #pragma omp parallel for
+      for (size_t s = 0; s < (size_t) outputTemp.n_slices; ++s)
+        outputTemp.slice(s) += bias(s % maps);
+    }
+
+    return;
+  }
+
   outputTemp.zeros();
 
   size_t inGroupSize = inMaps / groups;
@@ -403,6 +422,32 @@ void GroupedConvolutionType<
   const bool usingPadding =
       (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0);
 
+  if constexpr (HasBatchConvolution<BackwardConvolutionRule>::value)
+  {
+    // The error of the padded input is computed directly from the error and
+    // the filters, so there is no need to rotate the filters or dilate the
+    // error.  Then the padding is removed.
+    if (usingPadding)
+    {
+      CubeType paddedG(this->inputDimensions[0] + padWLeft + padWRight,
+          this->inputDimensions[1] + padHTop + padHBottom, gTemp.n_slices);
+      BackwardConvolutionRule::BackwardBatch(mappedError, weight, paddedG,
+          inMaps, groups, strideWidth, strideHeight);
+      gTemp = paddedG.tube(
+          padWLeft,
+          padHTop,
+          padWLeft + gTemp.n_rows - 1,
+          padHTop + gTemp.n_cols - 1);
+    }
+    else
+    {
+      BackwardConvolutionRule::BackwardBatch(mappedError, weight, gTemp, inMaps,
+          groups, strideWidth, strideHeight);
+    }
+
+    return;
+  }
+
   // To perform the backward pass, we need to rotate all the filters.
   CubeType rotatedFilters(weight.n_rows,
       weight.n_cols, weight.n_slices);
@@ -527,6 +572,30 @@ void GroupedConvolutionType<
   const size_t paddedRows = this->inputDimensions[0] + padWLeft + padWRight;
   const size_t paddedCols = this->inputDimensions[1] + padHTop + padHBottom;
 
+  if constexpr (HasBatchConvolution<GradientConvolutionRule>::value)
+  {
+    CubeType inputTemp;
+    MakeAlias(inputTemp, (usingPadding ? inputPadded : input), paddedRows,
+        paddedCols, inMaps * higherInDimensions * batchSize);
+
+    // As in the other case, the alias is only for the convolution map weights.
+    MakeAlias(gradientTemp, gradient, weight.n_rows, weight.n_cols,
+        weight.n_slices);
+    GradientConvolutionRule::GradientBatch(inputTemp, mappedError,
+        gradientTemp, inMaps, groups, strideWidth, strideHeight);
+
+    if (useBias)
+    {
+      for (size_t outMap = 0; outMap < maps; ++outMap)
+        gradient[weight.n_elem + outMap] = 0;
+
+      for (size_t s = 0; s < (size_t) mappedError.n_slices; ++s)
+        gradient[weight.n_elem + (s % maps)] += accu(mappedError.slice(s));
+    }
+
+    return;
+  }
+
   CubeType inputTemp(
       const_cast<MatType&>(usingPadding ? inputPadded : input).memptr(),
       paddedRows, paddedCols, inMaps * batchSize, false, false);
@@ -0,0 +1,229 @@
+/**
+ * @file methods/ann/layer/gru.hpp
+ * @author Sumedh Ghaisas
+ *
+ * Definition of the GRU layer.
+ *
+ * For more information, read the following paper:
+ *
+ * @code
+ * @inproceedings{chung2015gated,
+ *    title     = {Gated Feedback Recurrent Neural Networks.},
+ *    author    = {Chung, Junyoung and G{\"u}l{\c{c}}ehre, Caglar and Cho,
+                  Kyunghyun and Bengio, Yoshua},
+ *    booktitle = {ICML},
+ *    pages     = {2067--2075},
+ *    year      = {2015},
+ *    url       = {https://arxiv.org/abs/1502.02367}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_GRU_HPP
+#define MLPACK_METHODS_ANN_LAYER_GRU_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "recurrent_layer.hpp"
+
+namespace mlpack {
+
+/**
+ * An implementation of a gru network layer:
+ *
+ * z_t = sigmoid(W_z x_t + U_z h_{t - 1} + b_z)
+ * r_t = sigmoid(W_r x_t + U_r h_{t - 1} + b_r)
+ * o_t =    tanh(W_o x_t + U_o (r_t % h_{t - 1}) + b_o)
+ * h_t = z_t % h_{t - 1} + (1 - z_t) % o_t
+ *
+ * The input weights of the three gates are stacked into one matrix
+ * W = [W_z; W_r; W_o], and the recurrent weights of the update and reset gates
+ * into one matrix U = [U_z; U_r], so that each time step takes one matrix
+ * product with the input and one with the previous output (plus the product
+ * with U_o, which depends on the reset gate); the biases and nonlinearities are
+ * applied in a single pass over the gates.
+ *
+ * This cell can be used in RNN networks.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class GRUType : public RecurrentLayer<MatType>
+{
+ public:
+  //! Create the GRU object.
+  GRUType();
+
+  /**
+   * Create the GRU layer object using the specified parameters.
+   *
+   * @param outSize The number of output units.
+   */
+  GRUType(const size_t outSize);
+
+  //! Clone the GRUType object. This handles polymorphism correctly.
+  GRUType* Clone() const { return new GRUType(*this); }
+
+  //! Copy the given GRUType object.
+  GRUType(const GRUType& other);
+  //! Take ownership of the given GRUType object's data.
+  GRUType(GRUType&& other);
+  //! Copy the given GRUType object.
+  GRUType& operator=(const GRUType& other);
+  //! Take ownership of the given GRUType object's data.
+  GRUType& operator=(GRUType&& other);
+
+  virtual ~GRUType() { }
+
+  /**
+   * Reset the layer parameter. The method is called to
+   * assign the allocated memory to the internal learnable parameters.
+   */
+  void SetWeights(const MatType& weightsIn);
+
+  /**
+   * Ordinary feed-forward pass of a neural network, evaluating the function
+   * f(x) by propagating the activity forward through f.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * Ordinary feed backward pass of a neural network, calculating the function
+   * f(x) by propagating x backwards trough f. Using the results from the feed
+   * forward pass.
+   *
+   * @param input The input data (x) given to the forward pass.
+   * @param output The propagated data (f(x)) resulting from Forward()
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& output,
+                const MatType& gy,
+                MatType& g);
+
+  /*
+   * Calculate the gradient using the output delta and the input activation.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Gradient(const MatType& input,
+                const MatType& /* error */,
+                MatType& gradient);
+
+  // Get the parameters.
+  const MatType& Parameters() const { return weights; }
+  // Modify the parameters.
+  MatType& Parameters() { return weights; }
+
+  // Get the stacked input weight matrix [W_z; W_r; W_o].
+  const MatType& InputWeight() const { return inputWeight; }
+  // Modify the stacked input weight matrix [W_z; W_r; W_o].
+  MatType& InputWeight() { return inputWeight; }
+  // Get the stacked bias vector [b_z; b_r; b_o].
+  const MatType& Bias() const { return bias; }
+  // Modify the stacked bias vector [b_z; b_r; b_o].
+  MatType& Bias() { return bias; }
+  // Get the stacked recurrent weight matrix [U_z; U_r].
+  const MatType& RecurrentWeight() const { return recurrentWeight; }
+  // Modify the stacked recurrent weight matrix [U_z; U_r].
+  MatType& RecurrentWeight() { return recurrentWeight; }
+  // Get the recurrent weight matrix of the candidate output, U_o.
+  const MatType& CandidateRecurrentWeight() const
+  { return candidateRecurrentWeight; }
+  // Modify the recurrent weight matrix of the candidate output, U_o.
+  MatType& CandidateRecurrentWeight() { return candidateRecurrentWeight; }
+
+  // Get the total number of trainable parameters.
+  size_t WeightSize() const;
+
+  // Get the total number of recurrent state parameters.
+  size_t RecurrentSize() const;
+
+  // Given a properly set InputDimensions(), compute the output dimensions.
+  void ComputeOutputDimensions()
+  {
+    inSize = std::accumulate(this->inputDimensions.begin(),
+        this->inputDimensions.end(), 1, std::multiplies<size_t>());
+    this->outputDimensions = std::vector<size_t>(this->inputDimensions.size(),
+        1);
+
+    // The GRU layer flattens its input.
+    this->outputDimensions[0] = outSize;
+  }
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  // Locally-stored number of input units.
+  size_t inSize;
+
+  // Locally-stored number of output units.
+  size_t outSize;
+
+  // Locally-stored weight object.
+  MatType weights;
+
+  // Stacked weights of the input connections, the biases, the recurrent
+  // connections of the update and reset gates, and the recurrent connection of
+  // the candidate output.
+  MatType inputWeight;
+  MatType bias;
+  MatType recurrentWeight;
+  MatType candidateRecurrentWeight;
+
+  // These matrices are internally used for computation only; they are aliases
+  // for recurrent state.  `gates` holds the activations of z, r and o (in that
+  // order) for each point.
+  MatType thisRecurrent;
+  MatType gates;
+  MatType prevRecurrent;
+
+  // These matrices are also internally used for computation only.
+  // Everything below 'workspace' is an alias of memory in 'workspace'.
+  MatType workspace;
+  MatType deltaY;
+  // Deltas of the gates before the nonlinearities.
+  MatType deltaGates;
+  // The delta of r_t % h_{t - 1}.
+  MatType deltaReset;
+  // The part of dh_t that is passed directly to h_{t - 1}.
+  MatType deltaCarry;
+  // These correspond to, e.g., dgates_{t + 1}.
+  MatType nextDeltaGates;
+  MatType nextDeltaCarry;
+
+  // Calling this function will set all the aliases for the functions above to
+  // the correct places in the current recurrent state methods.
+  void SetInternalAliases(const size_t batchSize);
+
+  // Calling this function will set up workspace memory for the backward pass,
+  // if necessary.
+  void SetBackwardWorkspace(const size_t batchSize);
+}; // class GRUType
+
+// Convenience typedefs.
+
+// Standard GRU layer.
+using GRU = GRUType<arma::mat>;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "gru_impl.hpp"
+
+#endif
@@ -0,0 +1,364 @@
+/**
+ * @file methods/ann/layer/gru_impl.hpp
+ * @author Sumedh Ghaisas
+ *
+ * Implementation of the GRU class, which implements a gru network layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_GRU_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_GRU_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "gru.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+GRUType<MatType>::GRUType() :
+    RecurrentLayer<MatType>(),
+    inSize(0),
+    outSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+GRUType<MatType>::GRUType(const size_t outSize) :
+    RecurrentLayer<MatType>(),
+    inSize(0),
+    outSize(outSize)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+GRUType<MatType>::GRUType(const GRUType& layer) :
+    RecurrentLayer<MatType>(layer),
+    inSize(layer.inSize),
+    outSize(layer.outSize)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+GRUType<MatType>::GRUType(GRUType&& layer) :
+    RecurrentLayer<MatType>(std::move(layer)),
+    inSize(layer.inSize),
+    outSize(layer.outSize)
+{
+  layer.inSize = 0;
+  layer.outSize = 0;
+}
+
+template<typename MatType>
+GRUType<MatType>& GRUType<MatType>::operator=(const GRUType& layer)
+{
+  if (this != &layer)
+  {
+    RecurrentLayer<MatType>::operator=(layer);
+    inSize = layer.inSize;
+    outSize = layer.outSize;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+GRUType<MatType>& GRUType<MatType>::operator=(GRUType&& layer)
+{
+  if (this != &layer)
+  {
+    RecurrentLayer<MatType>::operator=(std::move(layer));
+    inSize = layer.inSize;
+    outSize = layer.outSize;
+
+    layer.inSize = 0;
+    layer.outSize = 0;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+void GRUType<MatType>::SetWeights(const MatType& weightsIn)
+{
+  MakeAlias(weights, weightsIn, WeightSize(), 1);
+  MakeAlias(inputWeight, weightsIn, 3 * outSize, inSize);
+  MakeAlias(bias, weightsIn, 3 * outSize, 1, inputWeight.n_elem);
+  MakeAlias(recurrentWeight, weightsIn, 2 * outSize, outSize,
+      inputWeight.n_elem + bias.n_elem);
+  MakeAlias(candidateRecurrentWeight, weightsIn, outSize, outSize,
+      inputWeight.n_elem + bias.n_elem + recurrentWeight.n_elem);
+}
+
+template<typename MatType>
+void GRUType<MatType>::Forward(const MatType& input, MatType& output)
+{
+  using ElemType = typename MatType::elem_type;
+
+  // Convenience alias.
+  const size_t batchSize = input.n_cols;
+
+  // The internal quantities are stored as recurrent state; so, set aliases
+  // correctly for this time step.
+  SetInternalAliases(batchSize);
+
+  const bool hasPreviousStep = this->HasPreviousStep();
+
+  // Compute the pre-activations of all three gates with one matrix product for
+  // the input, and one for the recurrent connection of z and r.
+  gates = inputWeight * input;
+  if (hasPreviousStep)
+    gates.rows(0, 2 * outSize - 1) += recurrentWeight * prevRecurrent;
+
+  // Apply the nonlinearities to the update and reset gates.
+  #pragma omp parallel for
+  for (size_t c = 0; c < batchSize; ++c)
+  {
+    // z and r are contiguous in each column.
+    ElemType* zr = gates.colptr(c);
+    const ElemType* b = bias.memptr();
+
+    for (size_t i = 0; i < 2 * outSize; ++i)
+      zr[i] = 1 / (1 + std::exp(-(zr[i] + b[i])));
+  }
+
+  // The candidate output depends on the reset gate; so, its recurrent
+  // connection can only be added now.
+  if (hasPreviousStep)
+  {
+    gates.rows(2 * outSize, 3 * outSize - 1) += candidateRecurrentWeight *
+        (gates.rows(outSize, 2 * outSize - 1) % prevRecurrent);
+  }
+
+  output.set_size(outSize, batchSize);
+
+  #pragma omp parallel for
+  for (size_t c = 0; c < batchSize; ++c)
+  {
+    const ElemType* z = gates.colptr(c);
+    ElemType* o = gates.colptr(c) + 2 * outSize;
+    const ElemType* b = bias.memptr() + 2 * outSize;
+    ElemType* y = output.colptr(c);
+
+    for (size_t i = 0; i < outSize; ++i)
+    {
+      o[i] = std::tanh(o[i] + b[i]);
+      y[i] = (1 - z[i]) * o[i];
+      if (hasPreviousStep)
+        y[i] += z[i] * prevRecurrent(i, c);
+    }
+  }
+
+  // If necessary, store the recurrent output.
+  if (!this->AtFinalStep())
+    thisRecurrent = output;
+}
+
+template<typename MatType>
+void GRUType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& output,
+    const MatType& gy,
+    MatType& g)
+{
+  using ElemType = typename MatType::elem_type;
+
+  // Compute backward partial derivatives.  As in the LSTM layer, `o_t` (for
+  // example) refers to the candidate output *after* the nonlinearity, but
+  // `do_t` refers to the delta *before* the nonlinearity.
+  //
+  // dh_t = gy + U^T [dz_{t + 1}; dr_{t + 1}] + dcarry_{t + 1}
+  //
+  // do_t  = dh_t % (1 - z_t) % (1 - o_t .^ 2)
+  // dz_t  = dh_t % (h_{t - 1} - o_t) % (z_t % (1 - z_t))
+  // drh_t = U_o^T do_t
+  // dr_t  = drh_t % h_{t - 1} % (r_t % (1 - r_t))
+  //
+  // dcarry_t = dh_t % z_t + drh_t % r_t
+  //
+  // dx_t = W^T dgates_t
+  const size_t batchSize = output.n_cols;
+  SetInternalAliases(batchSize);
+  SetBackwardWorkspace(batchSize);
+
+  if (this->AtFinalStep())
+  {
+    deltaY = gy;
+  }
+  else
+  {
+    deltaY = gy + nextDeltaCarry + recurrentWeight.t() *
+        nextDeltaGates.rows(0, 2 * outSize - 1);
+  }
+
+  const bool hasPreviousStep = this->HasPreviousStep();
+
+  #pragma omp parallel for
+  for (size_t c = 0; c < batchSize; ++c)
+  {
+    const ElemType* z = gates.colptr(c);
+    const ElemType* o = z + 2 * outSize;
+    ElemType* dz = deltaGates.colptr(c);
+    ElemType* dO = dz + 2 * outSize;
+    const ElemType* dy = deltaY.colptr(c);
+
+    for (size_t i = 0; i < outSize; ++i)
+    {
+      const ElemType prev = (hasPreviousStep) ? prevRecurrent(i, c) : 0;
+      dO[i] = dy[i] * (1 - z[i]) * (1 - o[i] * o[i]);
+      dz[i] = dy[i] * (prev - o[i]) * z[i] * (1 - z[i]);
+    }
+  }
+
+  deltaReset = candidateRecurrentWeight.t() *
+      deltaGates.rows(2 * outSize, 3 * outSize - 1);
+
+  #pragma omp parallel for
+  for (size_t c = 0; c < batchSize; ++c)
+  {
+    const ElemType* z = gates.colptr(c);
+    const ElemType* r = z + outSize;
+    ElemType* dr = deltaGates.colptr(c) + outSize;
+    const ElemType* drh = deltaReset.colptr(c);
+    const ElemType* dy = deltaY.colptr(c);
+    ElemType* carry = deltaCarry.colptr(c);
+
+    for (size_t i = 0; i < outSize; ++i)
+    {
+      dr[i] = (hasPreviousStep) ?
+          drh[i] * prevRecurrent(i, c) * r[i] * (1 - r[i]) : 0;
+      carry[i] = dy[i] * z[i] + drh[i] * r[i];
+    }
+  }
+
+  // Finally, compute deltaX.
+  g = inputWeight.t() * deltaGates;
+}
+
+template<typename MatType>
+void GRUType<MatType>::Gradient(
+    const MatType& input,
+    const MatType& /* error */,
+    MatType& gradient)
+{
+  // This implementation depends on Gradient() being called just after
+  // Backward(), so the workspace aliases are already set by
+  // SetBackwardWorkspace().
+  MatType inputWeightGradient, biasGradient, recurrentWeightGradient,
+      candidateRecurrentWeightGradient;
+  MakeAlias(inputWeightGradient, gradient, 3 * outSize, inSize);
+  MakeAlias(biasGradient, gradient, 3 * outSize, 1, inputWeight.n_elem);
+  MakeAlias(recurrentWeightGradient, gradient, 2 * outSize, outSize,
+      inputWeight.n_elem + bias.n_elem);
+  MakeAlias(candidateRecurrentWeightGradient, gradient, outSize, outSize,
+      inputWeight.n_elem + bias.n_elem + recurrentWeight.n_elem);
+
+  // dW = < dgates_t, x_t >
+  inputWeightGradient = deltaGates * input.t();
+  // db = sum(dgates_t)
+  biasGradient = sum(deltaGates, 1);
+  // There is no recurrent input at the first time step.
+  if (this->HasPreviousStep())
+  {
+    // dU = < [dz_t; dr_t], h_{t - 1} >
+    recurrentWeightGradient = deltaGates.rows(0, 2 * outSize - 1) *
+        prevRecurrent.t();
+    // dU_o = < do_t, r_t % h_{t - 1} >
+    candidateRecurrentWeightGradient =
+        deltaGates.rows(2 * outSize, 3 * outSize - 1) *
+        (gates.rows(outSize, 2 * outSize - 1) % prevRecurrent).t();
+  }
+  else
+  {
+    recurrentWeightGradient.zeros();
+    candidateRecurrentWeightGradient.zeros();
+  }
+}
+
+template<typename MatType>
+size_t GRUType<MatType>::WeightSize() const
+{
+  return 3 * outSize * inSize /* input weight connections */ +
+      3 * outSize /* bias */ +
+      3 * outSize * outSize /* recurrent weight connections */;
+}
+
+template<typename MatType>
+size_t GRUType<MatType>::RecurrentSize() const
+{
+  // We have to account for the output and the activations of the three gates,
+  // which we compute in Forward() and use in Backward().
+  return 4 * outSize;
+}
+
+template<typename MatType>
+void GRUType<MatType>::SetInternalAliases(const size_t batchSize)
+{
+  // Make all of the aliases for internal state point to the correct place.
+  MatType& state = this->RecurrentState(this->CurrentStep());
+
+  MakeAlias(thisRecurrent, state, outSize, batchSize);
+  MakeAlias(gates, state, 3 * outSize, batchSize, outSize * batchSize);
+
+  // Make an alias for the previous time step, too, if we can.
+  if (this->HasPreviousStep())
+  {
+    MatType& prevState = this->RecurrentState(this->PreviousStep());
+    MakeAlias(prevRecurrent, prevState, outSize, batchSize);
+  }
+}
+
+template<typename MatType>
+void GRUType<MatType>::SetBackwardWorkspace(const size_t batchSize)
+{
+  // We need to hold the gate deltas and the carried delta for two time steps,
+  // plus deltaReset and deltaY.
+  workspace.set_size(10 * outSize, batchSize);
+
+  const size_t thisOffset = (this->CurrentStep() % 2 == 0) ? 0 : 4;
+  const size_t nextOffset = 4 - thisOffset;
+
+  MakeAlias(deltaGates, workspace, 3 * outSize, batchSize,
+      thisOffset * outSize * batchSize);
+  MakeAlias(deltaCarry, workspace, outSize, batchSize,
+      (thisOffset + 3) * outSize * batchSize);
+  MakeAlias(nextDeltaGates, workspace, 3 * outSize, batchSize,
+      nextOffset * outSize * batchSize);
+  MakeAlias(nextDeltaCarry, workspace, outSize, batchSize,
+      (nextOffset + 3) * outSize * batchSize);
+  MakeAlias(deltaReset, workspace, outSize, batchSize,
+      8 * outSize * batchSize);
+  MakeAlias(deltaY, workspace, outSize, batchSize, 9 * outSize * batchSize);
+}
+
+template<typename MatType>
+template<typename Archive>
+void GRUType<MatType>::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<RecurrentLayer<MatType>>(this));
+
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+
+  // Clear internal scratch space if we are loading.
+  if (Archive::is_loading::value)
+  {
+    workspace.clear();
+
+    deltaY.clear();
+    deltaGates.clear();
+    deltaReset.clear();
+    deltaCarry.clear();
+    nextDeltaGates.clear();
+    nextDeltaCarry.clear();
+  }
+}
+
+} // namespace mlpack
+
+#endif
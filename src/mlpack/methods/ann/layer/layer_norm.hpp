@@ -171,8 +171,6 @@ class LayerNormType : public Layer<MatType>
   //! Locally-stored normalized input.
   MatType normalized;
 
-  //! Locally-stored zero mean input.
-  MatType inputMean;
 }; // class LayerNormType
 
 // Standard LayerNorm type
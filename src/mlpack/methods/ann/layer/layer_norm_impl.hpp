@@ -59,20 +59,44 @@ template<typename MatType>
 void LayerNormType<MatType>::Forward(
     const MatType& input, MatType& output)
 {
-  mean = arma::mean(input, 0);
-  variance = arma::var(input, 1, 0);
+  using ElemType = typename MatType::elem_type;
 
-  // Normalize the input.
-  output = input.each_row() - mean;
-  inputMean = output;
-  output.each_row() /= sqrt(variance + eps);
+  const size_t n = input.n_rows;
+  mean.set_size(1, input.n_cols);
+  variance.set_size(1, input.n_cols);
 
-  // Reused in the backward and gradient step.
-  normalized = output;
+  // Reused in the backward and gradient step; the memory is kept between
+  // passes with the same batch size.
+  normalized.set_size(arma::size(input));
+  output.set_size(arma::size(input));
 
-  // Scale and shift the output.
-  output.each_col() %= gamma;
-  output.each_col() += beta;
+  // Each point is handled by one thread, with one (Welford) pass to compute
+  // its statistics and one pass to normalize, scale and shift it.
+  #pragma omp parallel for schedule(static)
+  for (size_t c = 0; c < (size_t) input.n_cols; ++c)
+  {
+    const ElemType* x = input.colptr(c);
+
+    ElemType pointMean = 0, pointM2 = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      const ElemType delta = x[i] - pointMean;
+      pointMean += delta / (i + 1);
+      pointM2 += delta * (x[i] - pointMean);
+    }
+
+    mean[c] = pointMean;
+    variance[c] = pointM2 / n;
+
+    const ElemType stdInv = 1 / std::sqrt(variance[c] + ElemType(eps));
+    ElemType* xhat = normalized.colptr(c);
+    ElemType* out = output.colptr(c);
+    for (size_t i = 0; i < n; ++i)
+    {
+      xhat[i] = (x[i] - pointMean) * stdInv;
+      out[i] = gamma[i] * xhat[i] + beta[i];
+    }
+  }
 }
 
 template<typename MatType>
@@ -82,22 +106,36 @@ void LayerNormType<MatType>::Backward(
     const MatType& gy,
     MatType& g)
 {
-  const MatType stdInv = 1.0 / sqrt(variance + eps);
-
-  // dl / dxhat.
-  const MatType norm = gy.each_col() % gamma;
+  using ElemType = typename MatType::elem_type;
 
-  // sum dl / dxhat * (x - mu) * -0.5 * stdInv^3.
-  const MatType var = sum(norm % inputMean, 0) % pow(stdInv, 3.0) * -0.5;
+  const size_t n = gy.n_rows;
+  g.set_size(arma::size(gy));
 
-  // dl / dxhat * 1 / stdInv + variance * 2 * (x - mu) / m +
-  // dl / dmu * 1 / m.
-  g = (norm.each_row() % stdInv) + (inputMean.each_row() %
-      var * 2 / gy.n_rows);
-
-  // sum (dl / dxhat * -1 / stdInv) + variance *
-  // (sum -2 * (x - mu)) / m.
-  g.each_row() += sum(norm.each_row() % -stdInv, 0) / gy.n_rows;
+  // With xhat the normalized input and dxhat = gamma % dy, the gradient of
+  // each point is
+  //   dx = stdInv / n * (n * dxhat - sum(dxhat) - xhat * sum(dxhat % xhat)).
+  #pragma omp parallel for schedule(static)
+  for (size_t c = 0; c < (size_t) gy.n_cols; ++c)
+  {
+    const ElemType* dy = gy.colptr(c);
+    const ElemType* xhat = normalized.colptr(c);
+    ElemType* dx = g.colptr(c);
+
+    ElemType sumDxhat = 0, sumDxhatXhat = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      const ElemType dxhat = gamma[i] * dy[i];
+      sumDxhat += dxhat;
+      sumDxhatXhat += dxhat * xhat[i];
+    }
+
+    const ElemType factor = 1 / (std::sqrt(variance[c] + ElemType(eps)) * n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      dx[i] = factor * (n * gamma[i] * dy[i] - sumDxhat -
+          xhat[i] * sumDxhatXhat);
+    }
+  }
 }
 
 template<typename MatType>
@@ -110,11 +110,10 @@ template<typename MatType, typename RegularizerType>
 void LinearType<MatType, RegularizerType>::Forward(
     const MatType& input, MatType& output)
 {
+  // Adding the bias with each_col() is a single operation, so it also works
+  // (as one kernel) for matrices that are stored on a GPU.
   output = weight * input;
-
-  #pragma omp for
-  for (size_t c = 0; c < (size_t) output.n_cols; ++c)
-    output.col(c) += bias;
+  output.each_col() += bias;
 }
 
 template<typename MatType, typename RegularizerType>
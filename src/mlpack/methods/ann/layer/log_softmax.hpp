@@ -23,7 +23,8 @@ namespace mlpack {
  * the multinomial logistic loss of the softmax of its inputs. This layer is
  * meant to be used in combination with the negative log likelihood layer
  * (NegativeLogLikelihoodLayer), which expects that the input contains
- * log-probabilities for each class.
+ * log-probabilities for each class.  For the output of a network, the
+ * SoftmaxCrossEntropy loss computes the same thing, faster.
  *
  * @tparam MatType Matrix representation to accept as input and use for
  *    computation.
@@ -68,14 +69,16 @@ class LogSoftMaxType : public Layer<MatType>
    * @param input Input data used for evaluating the specified function.
    * @param output Resulting output activation.
    */
-  void ForwardImpl(const MatType& input, MatType& output,
+  template<typename InputType>
+  void ForwardImpl(const InputType& input, MatType& output,
                    const typename std::enable_if_t<
-                       arma::is_arma_type<MatType>::value>* = 0);
+                       arma::is_arma_type<InputType>::value>* = 0);
 
 #ifdef MLPACK_HAS_COOT
-  void ForwardImpl(const MatType& input, MatType& output,
+  template<typename InputType>
+  void ForwardImpl(const InputType& input, MatType& output,
                    const typename std::enable_if_t<
-                       coot::is_coot_type<MatType>::value>* = 0);
+                       coot::is_coot_type<InputType>::value>* = 0);
 #endif
 
   /**
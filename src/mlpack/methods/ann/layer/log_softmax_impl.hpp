@@ -69,10 +69,11 @@ void LogSoftMaxType<MatType>::Forward(const MatType& input, MatType& output)
 }
 
 template<typename MatType>
+template<typename InputType>
 void LogSoftMaxType<MatType>::ForwardImpl(
-    const MatType& input,
+    const InputType& input,
     MatType& output,
-    const typename std::enable_if_t<arma::is_arma_type<MatType>::value>*)
+    const typename std::enable_if_t<arma::is_arma_type<InputType>::value>*)
 {
   MatType maxInput = repmat(max(input, 0), input.n_rows, 1);
   output = (maxInput - input);
@@ -126,10 +127,11 @@ void LogSoftMaxType<MatType>::ForwardImpl(
 #ifdef MLPACK_HAS_COOT
 
 template<typename MatType>
+template<typename InputType>
 void LogSoftMaxType<MatType>::ForwardImpl(
-    const MatType& input,
+    const InputType& input,
     MatType& output,
-    const typename std::enable_if_t<coot::is_coot_type<MatType>::value>*)
+    const typename std::enable_if_t<coot::is_coot_type<InputType>::value>*)
 {
   MatType maxInput = repmat(max(input), input.n_rows, 1);
   output = (maxInput - input);
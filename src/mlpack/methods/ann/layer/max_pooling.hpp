@@ -153,7 +153,8 @@ class MaxPoolingType : public Layer<MatType>
 
  private:
   /**
-   * Apply pooling to the input and store the results.
+   * Apply pooling to all slices of the input and store the results, and the
+   * index of the maximum of each window (as an offset into its slice).
    *
    * @param input The input to be apply the pooling rule.
    * @param output The pooled result.
@@ -162,56 +163,9 @@ class MaxPoolingType : public Layer<MatType>
   void PoolingOperation(
       const arma::Cube<typename MatType::elem_type>& input,
       arma::Cube<typename MatType::elem_type>& output,
-      arma::Cube<size_t>& poolingIndices)
+      arma::Cube<arma::u32>& poolingIndices)
   {
-    // Iterate over all slices individually.
-    #pragma omp parallel for
-    for (size_t s = 0; s < (size_t) input.n_slices; ++s)
-    {
-      for (size_t j = 0, colidx = 0; j < output.n_cols;
-          ++j, colidx += strideHeight)
-      {
-        size_t colEnd = colidx + kernelHeight - 1;
-        // Check if the kernel along column is out of bounds.
-        if (colEnd > input.n_cols - 1)
-        {
-          // If so, we need to reduce the kernel height or terminate.
-          if (floor)
-            continue;
-          colEnd = input.n_cols - 1;
-        }
-        for (size_t i = 0, rowidx = 0; i < output.n_rows;
-            ++i, rowidx += strideWidth)
-        {
-          size_t rowEnd = rowidx + kernelWidth - 1;
-          // Check if the kernel along row is out of bounds.
-          if (rowEnd > input.n_rows - 1)
-          {
-            // If so, we need to reduce the kernel width or terminate.
-            if (floor)
-              continue;
-            rowEnd = input.n_rows - 1;
-          }
-          const std::tuple<size_t, typename MatType::elem_type> poolResult =
-              pooling.PoolingWithIndex(input.slice(s).submat(
-                  rowidx,
-                  colidx,
-                  rowEnd,
-                  colEnd));
-
-          // Now map the returned pooling index, which corresponds to the
-          // submatrix we gave, back to its position in the (linearized) input.
-          const size_t poolIndex = std::get<0>(poolResult);
-          const size_t poolingCol = poolIndex / (kernelWidth);
-          const size_t poolingRow = poolIndex % (kernelWidth);
-          const size_t unmappedPoolingIndex = (rowidx + poolingRow) +
-              input.n_rows * (colidx + poolingCol);
-
-          poolingIndices(i, j, s) = unmappedPoolingIndex;
-          output(i, j, s) = std::get<1>(poolResult);
-        }
-      }
-    }
+    PoolingKernel<true>(input, output, &poolingIndices);
   }
 
   /**
@@ -225,45 +179,26 @@ class MaxPoolingType : public Layer<MatType>
       const arma::Cube<typename MatType::elem_type>& input,
       arma::Cube<typename MatType::elem_type>& output)
   {
-    // Iterate over all slices individually.
-    #pragma omp parallel for
-    for (size_t s = 0; s < (size_t) input.n_slices; ++s)
-    {
-      for (size_t j = 0, colidx = 0; j < output.n_cols;
-          ++j, colidx += strideHeight)
-      {
-        size_t colEnd = colidx + kernelHeight - 1;
-        // Check if the kernel along column is out of bounds.
-        if (colEnd > input.n_cols - 1)
-        {
-          // If so, we need to reduce the kernel height or terminate.
-          if (floor)
-            continue;
-          colEnd = input.n_cols - 1;
-        }
-        for (size_t i = 0, rowidx = 0; i < output.n_rows;
-            ++i, rowidx += strideWidth)
-        {
-          size_t rowEnd = rowidx + kernelWidth - 1;
-          // Check if the kernel along row is out of bounds.
-          if (rowEnd > input.n_rows - 1)
-          {
-            // If so, we need to reduce the kernel width or terminate.
-            if (floor)
-              continue;
-            rowEnd = input.n_rows - 1;
-          }
-
-          output(i, j, s) = pooling.Pooling(input.slice(s).submat(
-              rowidx,
-              colidx,
-              rowEnd,
-              colEnd));
-        }
-      }
-    }
+    PoolingKernel<false>(input, output, nullptr);
   }
 
+  /**
+   * The pooling kernel.  The maximum of each window is computed in two steps:
+   * for each column of the output, the input columns under the window are
+   * scanned contiguously and reduced element-wise (which vectorizes), and then
+   * each window of rows of the reduced column is reduced.
+   *
+   * @tparam StoreIndices Whether to store the index of each maximum.
+   * @param input The input to apply the pooling rule to.
+   * @param output The pooled result.
+   * @param poolingIndices The pooled indices (only used if StoreIndices).
+   */
+  template<bool StoreIndices>
+  void PoolingKernel(
+      const arma::Cube<typename MatType::elem_type>& input,
+      arma::Cube<typename MatType::elem_type>& output,
+      arma::Cube<arma::u32>* poolingIndices);
+
   /**
    * Apply unpooling to all slices of the input and store the results.
    *
@@ -274,12 +209,13 @@ class MaxPoolingType : public Layer<MatType>
   void UnpoolingOperation(
       const MatType& error,
       MatType& output,
-      const arma::Mat<size_t>& poolingIndices)
+      const arma::Mat<arma::u32>& poolingIndices)
   {
+    const typename MatType::elem_type* e = error.memptr();
+    typename MatType::elem_type* out = output.memptr();
+    const arma::u32* indices = poolingIndices.memptr();
     for (size_t i = 0; i < poolingIndices.n_elem; ++i)
-    {
-      output(poolingIndices(i)) += error(i);
-    }
+      out[indices[i]] += e[i];
   }
 
   //! Locally-stored width of the pooling window.
@@ -300,11 +236,8 @@ class MaxPoolingType : public Layer<MatType>
   //! Locally-stored number of channels.
   size_t channels;
 
-  //! Locally-stored pooling strategy.
-  MaxPoolingRule pooling;
-
-  //! Locally-stored pooling indices.
-  arma::Cube<size_t> poolingIndices;
+  //! Locally-stored pooling indices (offsets into each input slice).
+  arma::Cube<arma::u32> poolingIndices;
 }; // class MaxPoolingType
 
 // Standard MaxPooling layer.
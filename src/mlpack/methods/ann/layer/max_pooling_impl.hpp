@@ -52,8 +52,7 @@ MaxPoolingType<MatType>::MaxPoolingType(
     strideWidth(other.strideWidth),
     strideHeight(other.strideHeight),
     floor(other.floor),
-    channels(other.channels),
-    pooling(other.pooling)
+    channels(other.channels)
 {
   // Nothing to do here.
 }
@@ -67,8 +66,7 @@ MaxPoolingType<MatType>::MaxPoolingType(
     strideWidth(std::move(other.strideWidth)),
     strideHeight(std::move(other.strideHeight)),
     floor(std::move(other.floor)),
-    channels(std::move(other.channels)),
-    pooling(std::move(other.pooling))
+    channels(std::move(other.channels))
 {
   // Nothing to do here.
 }
@@ -86,7 +84,6 @@ MaxPoolingType<MatType>::operator=(const MaxPoolingType& other)
     strideHeight = other.strideHeight;
     floor = other.floor;
     channels = other.channels;
-    pooling = other.pooling;
   }
 
   return *this;
@@ -105,7 +102,6 @@ MaxPoolingType<MatType>::operator=(MaxPoolingType&& other)
     strideHeight = std::move(other.strideHeight);
     floor = std::move(other.floor);
     channels = std::move(other.channels);
-    pooling = std::move(other.pooling);
   }
 
   return *this;
@@ -165,6 +161,79 @@ void MaxPoolingType<MatType>::Backward(
   }
 }
 
+template<typename MatType>
+template<bool StoreIndices>
+void MaxPoolingType<MatType>::PoolingKernel(
+    const arma::Cube<typename MatType::elem_type>& input,
+    arma::Cube<typename MatType::elem_type>& output,
+    arma::Cube<arma::u32>* poolingIndices)
+{
+  using ElemType = typename MatType::elem_type;
+
+  const size_t inRows = input.n_rows;
+  const size_t inCols = input.n_cols;
+  const size_t outRows = output.n_rows;
+
+  #pragma omp parallel
+  {
+    // The maximum of each input row over the columns of the current window,
+    // and the column it was found in.
+    arma::Col<ElemType> colMax(inRows);
+    arma::Col<arma::u32> colArg(inRows);
+    ElemType* m = colMax.memptr();
+    arma::u32* a = colArg.memptr();
+
+    #pragma omp for schedule(static)
+    for (size_t s = 0; s < (size_t) input.n_slices; ++s)
+    {
+      const ElemType* in = input.slice_memptr(s);
+      ElemType* out = output.slice_memptr(s);
+
+      for (size_t j = 0; j < output.n_cols; ++j)
+      {
+        // If the kernel is out of bounds (which can only happen when floor is
+        // false), it is reduced to the part inside the input.
+        const size_t colStart = j * strideHeight;
+        const size_t colEnd = std::min(colStart + kernelHeight, inCols);
+
+        std::copy(in + colStart * inRows, in + (colStart + 1) * inRows, m);
+        std::fill(a, a + inRows, (arma::u32) colStart);
+        for (size_t c = colStart + 1; c < colEnd; ++c)
+        {
+          const ElemType* x = in + c * inRows;
+          for (size_t r = 0; r < inRows; ++r)
+          {
+            const bool greater = (x[r] > m[r]);
+            m[r] = greater ? x[r] : m[r];
+            a[r] = greater ? (arma::u32) c : a[r];
+          }
+        }
+
+        for (size_t i = 0; i < outRows; ++i)
+        {
+          const size_t rowStart = i * strideWidth;
+          const size_t rowEnd = std::min(rowStart + kernelWidth, inRows);
+
+          // Ties are broken in column-major order of the window.
+          size_t best = rowStart;
+          for (size_t r = rowStart + 1; r < rowEnd; ++r)
+          {
+            if (m[r] > m[best] || (m[r] == m[best] && a[r] < a[best]))
+              best = r;
+          }
+
+          out[j * outRows + i] = m[best];
+          if constexpr (StoreIndices)
+          {
+            poolingIndices->slice_memptr(s)[j * outRows + i] =
+                (arma::u32) (best + inRows * a[best]);
+          }
+        }
+      }
+    }
+  }
+}
+
 template<typename MatType>
 void MaxPoolingType<MatType>::ComputeOutputDimensions()
 {
@@ -188,6 +257,15 @@ void MaxPoolingType<MatType>::ComputeOutputDimensions()
 
   // Higher dimensions are not modified.
 
+  // The pooling indices are offsets into one input slice.
+  if (this->inputDimensions[0] * this->inputDimensions[1] >
+      (size_t) std::numeric_limits<arma::u32>::max())
+  {
+    throw std::invalid_argument("MaxPooling::ComputeOutputDimensions(): the "
+        "input is too large (the first two dimensions must have fewer than "
+        "2^32 elements)!");
+  }
+
   // Cache input size and output size.
   channels = 1;
   for (size_t i = 2; i < this->inputDimensions.size(); ++i)
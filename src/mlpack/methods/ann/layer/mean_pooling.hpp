@@ -123,7 +123,10 @@ class MeanPoolingType : public Layer<MatType>
 
  private:
   /**
-   * Apply pooling to all slices of the input and store the results.
+   * Apply pooling to all slices of the input and store the results.  For each
+   * column of the output, the input columns under the window are summed
+   * contiguously (which vectorizes), and then each window of rows of the sum
+   * is reduced.
    *
    * @param input The input to be apply the pooling rule.
    * @param output The pooled result.
@@ -140,17 +143,6 @@ class MeanPoolingType : public Layer<MatType>
    */
   void Unpooling(const MatType& error, MatType& output);
 
-  /**
-   * Return the average value of the receptive block.
-   *
-   * @param input Input used to perform the pooling operation.  Could be an
-   *     Armadillo subview.
-   */
-  typename MatType::elem_type Pooling(const MatType& input)
-  {
-    return arma::mean(vectorise(input));
-  }
-
   //! Locally-stored width of the pooling window.
   size_t kernelWidth;
 
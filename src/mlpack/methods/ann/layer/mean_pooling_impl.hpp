@@ -204,39 +204,53 @@ void MeanPoolingType<MatType>::PoolingOperation(
     const arma::Cube<typename MatType::elem_type>& input,
     arma::Cube<typename MatType::elem_type>& output)
 {
-  // Iterate over all slices individually.
-  #pragma omp parallel for
-  for (size_t s = 0; s < (size_t) input.n_slices; ++s)
+  using ElemType = typename MatType::elem_type;
+
+  const size_t inRows = input.n_rows;
+  const size_t inCols = input.n_cols;
+  const size_t outRows = output.n_rows;
+
+  #pragma omp parallel
   {
-    for (size_t j = 0, colidx = 0; j < output.n_cols;
-        ++j, colidx += strideHeight)
+    // The sum of each input row over the columns of the current window.
+    arma::Col<ElemType> colSum(inRows);
+    ElemType* sums = colSum.memptr();
+
+    #pragma omp for schedule(static)
+    for (size_t s = 0; s < (size_t) input.n_slices; ++s)
     {
-      size_t colEnd = colidx + kernelHeight - 1;
-      // Check if the kernel along column is out of bounds.
-      if (colEnd > input.n_cols - 1)
-      {
-        // If so, we need to reduce the kernel height or terminate.
-        if (floor)
-          continue;
-        colEnd = input.n_cols - 1;
-      }
-      for (size_t i = 0, rowidx = 0; i < output.n_rows;
-          ++i, rowidx += strideWidth)
+      const ElemType* in = input.slice_memptr(s);
+      ElemType* out = output.slice_memptr(s);
+
+      for (size_t j = 0; j < output.n_cols; ++j)
       {
-        size_t rowEnd = rowidx + kernelWidth - 1;
-        // Check if the kernel along row is out of bounds.
-        if (rowEnd > input.n_rows - 1)
+        // If the kernel is out of bounds (which can only happen when floor is
+        // false), it is reduced to the part inside the input.
+        const size_t colStart = j * strideHeight;
+        const size_t colEnd = std::min(colStart + kernelHeight, inCols);
+
+        // Sum the input columns under the window; each column is scanned
+        // contiguously.
+        std::copy(in + colStart * inRows, in + (colStart + 1) * inRows, sums);
+        for (size_t c = colStart + 1; c < colEnd; ++c)
         {
-          // If so, we need to reduce the kernel width or terminate.
-          if (floor)
-            continue;
-          rowEnd = input.n_rows - 1;
+          const ElemType* x = in + c * inRows;
+          for (size_t r = 0; r < inRows; ++r)
+            sums[r] += x[r];
+        }
+
+        for (size_t i = 0; i < outRows; ++i)
+        {
+          const size_t rowStart = i * strideWidth;
+          const size_t rowEnd = std::min(rowStart + kernelWidth, inRows);
+
+          ElemType sum = 0;
+          for (size_t r = rowStart; r < rowEnd; ++r)
+            sum += sums[r];
+
+          out[j * outRows + i] = sum /
+              ((rowEnd - rowStart) * (colEnd - colStart));
         }
-        output(i, j, s) = Pooling(input.slice(s).submat(
-            rowidx,
-            colidx,
-            rowEnd,
-            colEnd));
       }
     }
   }
@@ -359,7 +373,6 @@ void MeanPoolingType<MatType>::Unpooling(
   }
   else
   {
-    arma::Mat<typename MatType::elem_type> unpooledError;
     for (size_t j = 0, colidx = 0; j < output.n_cols; j += strideHeight,
          ++colidx)
     {
@@ -386,15 +399,9 @@ void MeanPoolingType<MatType>::Unpooling(
           rowEnd = output.n_rows - 1;
         }
 
-        MatType outputArea = output(arma::span(i, rowEnd),
-                                    arma::span(j, colEnd));
-
-        unpooledError = arma::Mat<typename MatType::elem_type>(
-            outputArea.n_rows, outputArea.n_cols);
-        unpooledError.fill(error(rowidx, colidx) / outputArea.n_elem);
-
-        output(arma::span(i, i + outputArea.n_rows - 1),
-               arma::span(j, j + outputArea.n_cols - 1)) += unpooledError;
+        const size_t kernelArea = (rowEnd - i + 1) * (colEnd - j + 1);
+        output(arma::span(i, rowEnd), arma::span(j, colEnd)) +=
+            error(rowidx, colidx) / kernelArea;
       }
     }
   }
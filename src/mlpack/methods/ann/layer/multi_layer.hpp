@@ -125,6 +125,41 @@ class MultiLayer : public Layer<MatType>
                         const MatType& error,
                         MatType& gradient);
 
+  /**
+   * Perform a forward pass for inference only.  This computes the same output
+   * as `Forward()`, but the output of each layer is only kept until the next
+   * layer has consumed it, so the intermediate outputs of all layers share two
+   * buffers (sized for the largest outputs of the even- and odd-indexed layers)
+   * instead of using one buffer per layer.  Because of this, `Backward()` and
+   * `Gradient()` must not be called after `Predict()`; use `Forward()` when a
+   * backward pass is needed.
+   *
+   * @param input Input data to pass through the MultiLayer.
+   * @param output Matrix to store output in.
+   */
+  void Predict(const MatType& input, MatType& output);
+
+  /**
+   * Perform a backward pass and compute the gradients of each layer in the same
+   * sweep.  This gives the same results as calling `Backward()` and then
+   * `Gradient()`, but the gradient of each layer is computed as soon as the
+   * error it needs is available, so the propagated errors of all layers share
+   * two buffers instead of using one buffer per layer.  It must be called after
+   * `Forward()` with the same input.  `g` and `gradient` are expected to have
+   * the correct size already.
+   *
+   * @param input The input data (x) given to the forward pass.
+   * @param output The propagated data (f(x)) resulting from Forward().
+   * @param gy Propagated error from next layer.
+   * @param g Matrix to store propagated error in for previous layer.
+   * @param gradient Matrix to store the gradients in.
+   */
+  void BackwardWithGradient(const MatType& input,
+                            const MatType& output,
+                            const MatType& gy,
+                            MatType& g,
+                            MatType& gradient);
+
   /**
    * Set the weights of the layer to use the memory given as `weightsPtr`.
    */
@@ -170,6 +205,7 @@ class MultiLayer : public Layer<MatType>
     layerOutputs.push_back(MatType());
     layerDeltas.push_back(MatType());
     layerGradients.push_back(MatType());
+    ResetAliases();
   }
 
   /**
@@ -183,6 +219,7 @@ class MultiLayer : public Layer<MatType>
     layerOutputs.push_back(MatType());
     layerDeltas.push_back(MatType());
     layerGradients.push_back(MatType());
+    ResetAliases();
   }
 
   //! Get the network (series of layers) held by this MultiLayer.
@@ -192,7 +229,47 @@ class MultiLayer : public Layer<MatType>
   }
   //! Modify the network (series of layers) held by this MultiLayer.  Be
   //! careful!
-  std::vector<Layer<MatType>*>& Network() { return network; }
+  std::vector<Layer<MatType>*>& Network()
+  {
+    ResetAliases();
+    return network;
+  }
+
+  //! Get the indices of the layers whose outputs are kept by Forward().
+  const std::vector<size_t>& Checkpoints() const { return checkpoints; }
+  /**
+   * Modify the indices of the layers whose outputs are kept by Forward() (the
+   * checkpoints).  If this is empty (the default), Forward() keeps the output
+   * of every layer for the backward pass.  Otherwise, a forward pass through
+   * all the layers only keeps the outputs of the checkpoints; the outputs of
+   * the layers between two checkpoints share memory with the outputs of the
+   * layers between other checkpoints, and are recomputed from the output of
+   * the preceding checkpoint by `Backward()`, `Gradient()`, and
+   * `BackwardWithGradient()` when they are needed.  The results are the same,
+   * but each layer that is not a checkpoint may be passed forward twice.
+   *
+   * The memory used for the outputs is then the sum of the outputs of the
+   * checkpoints, plus the largest sum of the outputs between two checkpoints;
+   * for a network of `n` layers of similar size, using every `sqrt(n)`-th layer
+   * as a checkpoint reduces it from `O(n)` to `O(sqrt(n))` outputs.
+   *
+   * The layers between checkpoints must compute the same output when they are
+   * passed forward again; this is not the case for Dropout in training mode,
+   * which would draw a new mask, and BatchNorm in training mode updates its
+   * running statistics again.  Those layers should be checkpoints.  Indices
+   * that are not less than the index of the last layer are ignored.
+   */
+  std::vector<size_t>& Checkpoints() { return checkpoints; }
+
+  //! Return the memory held by the network for the outputs and the deltas of
+  //! the layers (the workspace of the layers themselves is not counted).
+  MemoryReport MemoryUsage() const
+  {
+    MemoryReport report;
+    report.Add("layer outputs", MemoryOf(layerOutputMatrix));
+    report.Add("layer deltas", MemoryOf(layerDeltaMatrix));
+    return report;
+  }
 
   //! Serialize the MultiLayer.
   template<typename Archive>
@@ -205,8 +282,13 @@ class MultiLayer : public Layer<MatType>
    * is called, each internally-held layer will output its results into the
    * memory allocated by this function (this is the internal member
    * `layerOutputMatrix` and its aliases `layerOutputs`).
+   *
+   * If `shareOutputs` is true, the output of layer `i` is only assumed to be
+   * needed until layer `i + 1` has been computed; even- and odd-indexed layers
+   * then alternate between two regions of `layerOutputMatrix`.
    */
-  void InitializeForwardPassMemory(const size_t batchSize);
+  void InitializeForwardPassMemory(const size_t batchSize,
+                                   const bool shareOutputs = false);
 
   /**
    * Initialize memory that will be used by each layer for the backwards pass,
@@ -214,8 +296,14 @@ class MultiLayer : public Layer<MatType>
    * is called, each internally-held layer will output the results of its
    * backwards pass into the memory allocated by this function (this is the
    * internal member `layerDeltaMatrix` and its aliases `layerDeltas`).
+   *
+   * If `shareDeltas` is true, the delta of layer `i` is only assumed to be
+   * needed until the backward pass and gradient of layer `i - 1` have been
+   * computed; even- and odd-indexed layers then alternate between two regions
+   * of `layerDeltaMatrix`.
    */
-  void InitializeBackwardPassMemory(const size_t batchSize);
+  void InitializeBackwardPassMemory(const size_t batchSize,
+                                    const bool shareDeltas = false);
 
   /**
    * Initialize memory for the gradient pass.  This sets the internal aliases
@@ -225,6 +313,43 @@ class MultiLayer : public Layer<MatType>
    */
   void InitializeGradientPassMemory(MatType& gradient);
 
+  /**
+   * Forget the memory that the aliases in `layerOutputs`, `layerDeltas` and
+   * `layerGradients` were made for, so that they are made again by the next
+   * pass.  The Initialize*PassMemory() functions only make the aliases when the
+   * memory, the batch size or the layout changes; this must be called whenever
+   * the sizes of the layers may have changed.
+   */
+  void ResetAliases()
+  {
+    outputAliasMemory = NULL;
+    deltaAliasMemory = NULL;
+    gradientAliasMemory = NULL;
+  }
+
+  /**
+   * Initialize memory for a forward pass through all the layers that only keeps
+   * the outputs of the checkpoints (see `Checkpoints()`).  The checkpoint
+   * outputs are stored at the start of `layerOutputMatrix`; they are followed
+   * by one region that the outputs of the other layers of every segment (the
+   * layers after a checkpoint, up to and including the next checkpoint or the
+   * last layer) share.  This also computes `segmentEnds`.
+   */
+  void InitializeCheckpointedForwardPassMemory(const size_t batchSize);
+
+  /**
+   * Make sure that the outputs of the layers of the given segment that are not
+   * checkpoints are available, passing them forward again from the output of
+   * the previous checkpoint if another segment has used their memory since.
+   */
+  void RecomputeSegment(const MatType& input, const size_t segment);
+
+  //! Get the input that was given to the layer with the given index.
+  const MatType& LayerInput(const MatType& input, const size_t i) const
+  {
+    return (i == 0) ? input : layerOutputs[i - 1];
+  }
+
   //! The internally-held network.
   std::vector<Layer<MatType>*> network;
 
@@ -251,6 +376,30 @@ class MultiLayer : public Layer<MatType>
   //! context of `Gradient()`!  We have it as a class member to avoid
   //! reallocating the `MatType`s each call to `Gradient()`.
   std::vector<MatType> layerGradients;
+
+  //! Memory of `layerOutputMatrix` that `layerOutputs` alias, or NULL.
+  const void* outputAliasMemory;
+  //! Batch size and layout that `layerOutputs` were made for.
+  size_t outputAliasBatchSize;
+  bool outputAliasShared;
+  //! Memory of `layerDeltaMatrix` that `layerDeltas` alias, or NULL.
+  const void* deltaAliasMemory;
+  //! Batch size and layout that `layerDeltas` were made for.
+  size_t deltaAliasBatchSize;
+  bool deltaAliasShared;
+  //! Memory of the gradient that `layerGradients` alias, or NULL.
+  const void* gradientAliasMemory;
+
+  //! Indices of the layers whose outputs are kept; see `Checkpoints()`.
+  std::vector<size_t> checkpoints;
+  //! Whether the last call to Forward() only kept the checkpoint outputs.
+  bool checkpointedPass;
+  //! Index of the last layer of each segment; only valid for a checkpointed
+  //! pass.
+  std::vector<size_t> segmentEnds;
+  //! Segment whose outputs are currently held in the shared region of
+  //! `layerOutputMatrix`.
+  size_t currentSegment;
 };
 
 } // namespace mlpack
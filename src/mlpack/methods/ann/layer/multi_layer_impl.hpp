@@ -24,7 +24,16 @@ MultiLayer<MatType>::MultiLayer() :
     Layer<MatType>(),
     inSize(0),
     totalInputSize(0),
-    totalOutputSize(0)
+    totalOutputSize(0),
+    outputAliasMemory(NULL),
+    outputAliasBatchSize(0),
+    outputAliasShared(false),
+    deltaAliasMemory(NULL),
+    deltaAliasBatchSize(0),
+    deltaAliasShared(false),
+    gradientAliasMemory(NULL),
+    checkpointedPass(false),
+    currentSegment(0)
 {
   // Nothing to do.
 }
@@ -36,7 +45,17 @@ MultiLayer<MatType>::MultiLayer(const MultiLayer& other) :
     totalInputSize(other.totalInputSize),
     totalOutputSize(other.totalOutputSize),
     layerOutputMatrix(other.layerOutputMatrix),
-    layerDeltaMatrix(other.layerDeltaMatrix)
+    layerDeltaMatrix(other.layerDeltaMatrix),
+    checkpoints(other.checkpoints),
+    outputAliasMemory(NULL),
+    outputAliasBatchSize(0),
+    outputAliasShared(false),
+    deltaAliasMemory(NULL),
+    deltaAliasBatchSize(0),
+    deltaAliasShared(false),
+    gradientAliasMemory(NULL),
+    checkpointedPass(false),
+    currentSegment(0)
 {
   // Copy each layer.
   for (size_t i = 0; i < other.network.size(); ++i)
@@ -59,7 +78,17 @@ MultiLayer<MatType>::MultiLayer(MultiLayer&& other) :
     totalInputSize(std::move(other.totalInputSize)),
     totalOutputSize(std::move(other.totalOutputSize)),
     layerOutputMatrix(std::move(other.layerOutputMatrix)),
-    layerDeltaMatrix(std::move(other.layerDeltaMatrix))
+    layerDeltaMatrix(std::move(other.layerDeltaMatrix)),
+    checkpoints(std::move(other.checkpoints)),
+    outputAliasMemory(NULL),
+    outputAliasBatchSize(0),
+    outputAliasShared(false),
+    deltaAliasMemory(NULL),
+    deltaAliasBatchSize(0),
+    deltaAliasShared(false),
+    gradientAliasMemory(NULL),
+    checkpointedPass(false),
+    currentSegment(0)
 {
   // Ensure that the aliases for layers during passes have the right size.
   layerOutputs.resize(network.size(), MatType());
@@ -93,6 +122,10 @@ MultiLayer<MatType>& MultiLayer<MatType>::operator=(const MultiLayer& other)
     layerOutputMatrix = other.layerOutputMatrix;
     layerDeltaMatrix = other.layerDeltaMatrix;
 
+    checkpoints = other.checkpoints;
+    checkpointedPass = false;
+    ResetAliases();
+
     for (size_t i = 0; i < other.network.size(); ++i)
       network.push_back(other.network[i]->Clone());
 
@@ -121,6 +154,9 @@ MultiLayer<MatType>& MultiLayer<MatType>::operator=(MultiLayer&& other)
     totalOutputSize = std::move(other.totalOutputSize);
 
     network = std::move(other.network);
+    checkpoints = std::move(other.checkpoints);
+    checkpointedPass = false;
+    ResetAliases();
 
     layerOutputs.resize(network.size(), MatType());
     layerDeltas.resize(network.size(), MatType());
@@ -156,8 +192,12 @@ void MultiLayer<MatType>::Forward(
   // intermediate values between layers.
   if ((end - start) > 0)
   {
-    // Initialize memory for the forward pass (if needed).
-    InitializeForwardPassMemory(input.n_cols);
+    // Initialize memory for the forward pass (if needed).  Only a pass through
+    // all the layers can be recomputed by the backward pass.
+    if (!checkpoints.empty() && start == 0 && end == network.size() - 1)
+      InitializeCheckpointedForwardPassMemory(input.n_cols);
+    else
+      InitializeForwardPassMemory(input.n_cols);
 
     network[start]->Forward(input, layerOutputs[start]);
     for (size_t i = start + 1; i < end; ++i)
@@ -182,7 +222,28 @@ void MultiLayer<MatType>::Backward(
     const MatType& gy,
     MatType& g)
 {
-  if (network.size() > 1)
+  if (network.size() > 1 && checkpointedPass)
+  {
+    InitializeBackwardPassMemory(input.n_cols);
+
+    // Go through the segments in reverse, recomputing the outputs of each
+    // segment before passing the error backward through it.
+    const size_t last = network.size() - 1;
+    for (size_t s = segmentEnds.size(); s-- > 0; )
+    {
+      RecomputeSegment(input, s);
+
+      const size_t begin = (s == 0) ? 0 : segmentEnds[s - 1] + 1;
+      for (size_t i = segmentEnds[s] + 1; i-- > begin; )
+      {
+        network[i]->Backward(LayerInput(input, i),
+            (i == last) ? output : layerOutputs[i],
+            (i == last) ? gy : layerDeltas[i + 1],
+            (i == 0) ? g : layerDeltas[i]);
+      }
+    }
+  }
+  else if (network.size() > 1)
   {
     // Initialize memory for the backward pass (if needed).
     InitializeBackwardPassMemory(input.n_cols);
@@ -212,7 +273,26 @@ void MultiLayer<MatType>::Gradient(
   // We assume gradient has the right size already.
 
   // Pass gradients through each layer.
-  if (network.size() > 1)
+  if (network.size() > 1 && checkpointedPass)
+  {
+    InitializeGradientPassMemory(gradient);
+
+    // The segment that Backward() finished with is the first one, so go
+    // through the segments in order.
+    const size_t last = network.size() - 1;
+    for (size_t s = 0; s < segmentEnds.size(); ++s)
+    {
+      RecomputeSegment(input, s);
+
+      const size_t begin = (s == 0) ? 0 : segmentEnds[s - 1] + 1;
+      for (size_t i = begin; i <= segmentEnds[s]; ++i)
+      {
+        network[i]->Gradient(LayerInput(input, i),
+            (i == last) ? error : layerDeltas[i + 1], layerGradients[i]);
+      }
+    }
+  }
+  else if (network.size() > 1)
   {
     // Initialize memory for the gradient pass (if needed).
     InitializeGradientPassMemory(gradient);
@@ -236,9 +316,108 @@ void MultiLayer<MatType>::Gradient(
   }
 }
 
+template<typename MatType>
+void MultiLayer<MatType>::Predict(const MatType& input, MatType& output)
+{
+  // Make sure training/testing mode is set right in each layer.
+  for (size_t i = 0; i < network.size(); ++i)
+    network[i]->Training() = this->training;
+
+  if (network.size() > 1)
+  {
+    // Layer i writes into the buffer that layer i - 1 read from, so only two
+    // intermediate outputs are ever alive at once.
+    InitializeForwardPassMemory(input.n_cols, true);
+
+    network.front()->Forward(input, layerOutputs.front());
+    for (size_t i = 1; i < network.size() - 1; ++i)
+      network[i]->Forward(layerOutputs[i - 1], layerOutputs[i]);
+    network.back()->Forward(layerOutputs[network.size() - 2], output);
+  }
+  else if (network.size() == 1)
+  {
+    network[0]->Forward(input, output);
+  }
+  else
+  {
+    // Empty network?
+    output = input;
+  }
+}
+
+template<typename MatType>
+void MultiLayer<MatType>::BackwardWithGradient(
+    const MatType& input,
+    const MatType& output,
+    const MatType& gy,
+    MatType& g,
+    MatType& gradient)
+{
+  if (network.size() > 1 && checkpointedPass)
+  {
+    InitializeBackwardPassMemory(input.n_cols, true);
+    InitializeGradientPassMemory(gradient);
+
+    // As in Backward(), but each gradient is computed right after the
+    // corresponding backward pass.  The last segment is still in memory from
+    // Forward(), so it is not recomputed.
+    const size_t last = network.size() - 1;
+    for (size_t s = segmentEnds.size(); s-- > 0; )
+    {
+      RecomputeSegment(input, s);
+
+      const size_t begin = (s == 0) ? 0 : segmentEnds[s - 1] + 1;
+      for (size_t i = segmentEnds[s] + 1; i-- > begin; )
+      {
+        const MatType& layerInput = LayerInput(input, i);
+        const MatType& layerGy = (i == last) ? gy : layerDeltas[i + 1];
+        network[i]->Backward(layerInput,
+            (i == last) ? output : layerOutputs[i], layerGy,
+            (i == 0) ? g : layerDeltas[i]);
+        network[i]->Gradient(layerInput, layerGy, layerGradients[i]);
+      }
+    }
+  }
+  else if (network.size() > 1)
+  {
+    // The delta of layer i + 1 is last used by the gradient of layer i, so we
+    // compute each gradient right after the corresponding backward pass, and
+    // only two deltas are ever alive at once.
+    InitializeBackwardPassMemory(input.n_cols, true);
+    InitializeGradientPassMemory(gradient);
+
+    const size_t last = network.size() - 1;
+    network[last]->Backward(layerOutputs[last - 1], output, gy,
+        layerDeltas[last]);
+    network[last]->Gradient(layerOutputs[last - 1], gy, layerGradients[last]);
+    for (size_t i = last - 1; i > 0; --i)
+    {
+      network[i]->Backward(layerOutputs[i - 1], layerOutputs[i],
+          layerDeltas[i + 1], layerDeltas[i]);
+      network[i]->Gradient(layerOutputs[i - 1], layerDeltas[i + 1],
+          layerGradients[i]);
+    }
+    network[0]->Backward(input, layerOutputs[0], layerDeltas[1], g);
+    network[0]->Gradient(input, layerDeltas[1], layerGradients[0]);
+  }
+  else if (network.size() == 1)
+  {
+    network[0]->Backward(input, output, gy, g);
+    network[0]->Gradient(input, gy, gradient);
+  }
+  else
+  {
+    // Empty network?
+    g = gy;
+  }
+}
+
 template<typename MatType>
 void MultiLayer<MatType>::SetWeights(const MatType& weightsIn)
 {
+  // The weight sizes of the layers may have changed.
+  gradientAliasMemory = NULL;
+
   size_t start = 0;
   const size_t totalWeightSize = WeightSize();
   for (size_t i = 0; i < network.size(); ++i)
@@ -307,6 +486,8 @@ size_t MultiLayer<MatType>::WeightSize() const
 template<typename MatType>
 void MultiLayer<MatType>::ComputeOutputDimensions()
 {
+  ResetAliases();
+
   inSize = 0;
   totalInputSize = 0;
   totalOutputSize = 0;
@@ -367,22 +548,48 @@ void MultiLayer<MatType>::serialize(
     layerOutputs.resize(network.size(), MatType());
     layerDeltas.resize(network.size(), MatType());
     layerGradients.resize(network.size(), MatType());
+    ResetAliases();
   }
 }
 
 template<typename MatType>
-void MultiLayer<MatType>::InitializeForwardPassMemory(const size_t batchSize)
+void MultiLayer<MatType>::InitializeForwardPassMemory(const size_t batchSize,
+                                                      const bool shareOutputs)
 {
+  checkpointedPass = false;
+
+  // The aliases only depend on the memory, the batch size and the layout (the
+  // sizes of the layers are fixed until ResetAliases() is called), so there is
+  // nothing to do if none of them changed since the last call.
+  if (outputAliasMemory != NULL &&
+      outputAliasMemory == layerOutputMatrix.memptr() &&
+      outputAliasBatchSize == batchSize && outputAliasShared == shareOutputs)
+    return;
+
+  // If outputs are shared, even-indexed layers write to the first region of
+  // layerOutputMatrix and odd-indexed layers write to the second region, so
+  // each region must be big enough for the largest output it will hold.
+  size_t evenSize = 0, oddSize = 0;
+  if (shareOutputs)
+  {
+    for (size_t i = 0; i < layerOutputs.size(); ++i)
+    {
+      size_t& regionSize = (i % 2 == 0) ? evenSize : oddSize;
+      regionSize = std::max(regionSize, (size_t) network[i]->OutputSize());
+    }
+  }
+  const size_t outputSize = shareOutputs ? (evenSize + oddSize) :
+      totalOutputSize;
+
   // We need to initialize memory to store the output of each layer's Forward()
   // call.  We'll do this all in one matrix, but, the size of this matrix
   // depends on the batch size we are using for computation.  We avoid resizing
   // layerOutputMatrix down, unless we only need 10% or less of it.
-  if (batchSize * totalOutputSize > layerOutputMatrix.n_elem ||
-      batchSize * totalOutputSize <
-          std::floor(0.1 * layerOutputMatrix.n_elem))
+  if (batchSize * outputSize > layerOutputMatrix.n_elem ||
+      batchSize * outputSize < std::floor(0.1 * layerOutputMatrix.n_elem))
   {
     // All outputs will be represented by one big block of memory.
-    layerOutputMatrix = MatType(1, batchSize * totalOutputSize);
+    layerOutputMatrix = MatType(1, batchSize * outputSize);
   }
 
   // Now, create an alias to the right place for each layer.  We assume that
@@ -391,24 +598,140 @@ void MultiLayer<MatType>::InitializeForwardPassMemory(const size_t batchSize)
   for (size_t i = 0; i < layerOutputs.size(); ++i)
   {
     const size_t layerOutputSize = network[i]->OutputSize();
+    if (shareOutputs)
+      start = (i % 2 == 0) ? 0 : batchSize * evenSize;
+
     MakeAlias(layerOutputs[i], layerOutputMatrix, layerOutputSize, batchSize,
         start * layerOutputMatrix.n_rows);
     start += batchSize * layerOutputSize;
   }
+
+  outputAliasMemory = layerOutputMatrix.memptr();
+  outputAliasBatchSize = batchSize;
+  outputAliasShared = shareOutputs;
 }
 
 template<typename MatType>
-void MultiLayer<MatType>::InitializeBackwardPassMemory(
+void MultiLayer<MatType>::InitializeCheckpointedForwardPassMemory(
     const size_t batchSize)
 {
+  // Find the last layer of each segment.  The last layer writes its output to
+  // the `output` given to Forward(), so it needs no memory here.
+  const size_t last = network.size() - 1;
+  std::vector<bool> isCheckpoint(network.size(), false);
+  for (const size_t c : checkpoints)
+  {
+    if (c < last)
+      isCheckpoint[c] = true;
+  }
+
+  segmentEnds.clear();
+  for (size_t i = 0; i < last; ++i)
+  {
+    if (isCheckpoint[i])
+      segmentEnds.push_back(i);
+  }
+  segmentEnds.push_back(last);
+
+  // The shared region must be big enough for the non-checkpoint outputs of the
+  // largest segment.
+  size_t checkpointSize = 0, sharedSize = 0, segmentSize = 0;
+  for (size_t i = 0; i < last; ++i)
+  {
+    if (isCheckpoint[i])
+    {
+      checkpointSize += network[i]->OutputSize();
+      segmentSize = 0;
+    }
+    else
+    {
+      segmentSize += network[i]->OutputSize();
+      sharedSize = std::max(sharedSize, segmentSize);
+    }
+  }
+  const size_t outputSize = checkpointSize + sharedSize;
+
+  // As in InitializeForwardPassMemory(), we avoid resizing layerOutputMatrix
+  // down, unless we only need 10% or less of it.
+  if (batchSize * outputSize > layerOutputMatrix.n_elem ||
+      batchSize * outputSize < std::floor(0.1 * layerOutputMatrix.n_elem))
+  {
+    layerOutputMatrix = MatType(1, batchSize * outputSize);
+  }
+
+  // Each segment starts again at the beginning of the shared region.
+  size_t checkpointStart = 0;
+  size_t sharedStart = batchSize * checkpointSize;
+  for (size_t i = 0; i < last; ++i)
+  {
+    const size_t layerOutputSize = network[i]->OutputSize();
+    size_t& start = isCheckpoint[i] ? checkpointStart : sharedStart;
+    MakeAlias(layerOutputs[i], layerOutputMatrix, layerOutputSize, batchSize,
+        start * layerOutputMatrix.n_rows);
+    start += batchSize * layerOutputSize;
+
+    if (isCheckpoint[i])
+      sharedStart = batchSize * checkpointSize;
+  }
+
+  // The aliases of the other layouts are not valid anymore.
+  outputAliasMemory = NULL;
+
+  // Forward() will leave the outputs of the last segment in memory.
+  checkpointedPass = true;
+  currentSegment = segmentEnds.size() - 1;
+}
+
+template<typename MatType>
+void MultiLayer<MatType>::RecomputeSegment(const MatType& input,
+                                           const size_t segment)
+{
+  if (segment == currentSegment)
+    return;
+
+  // The last layer of the segment is not passed forward again: its output is
+  // kept, and so is whatever it stored during Forward().
+  const size_t begin = (segment == 0) ? 0 : segmentEnds[segment - 1] + 1;
+  for (size_t i = begin; i < segmentEnds[segment]; ++i)
+    network[i]->Forward(LayerInput(input, i), layerOutputs[i]);
+
+  currentSegment = segment;
+}
+
+template<typename MatType>
+void MultiLayer<MatType>::InitializeBackwardPassMemory(
+    const size_t batchSize,
+    const bool shareDeltas)
+{
+  // As in InitializeForwardPassMemory(), the aliases only need to be made
+  // again if the memory, the batch size or the layout changed.
+  if (deltaAliasMemory != NULL &&
+      deltaAliasMemory == layerDeltaMatrix.memptr() &&
+      deltaAliasBatchSize == batchSize && deltaAliasShared == shareDeltas)
+    return;
+
+  // Compute the input size of each layer; this is the size of its delta.
+  std::vector<size_t> layerInputSizes(layerDeltas.size(), 1);
+  size_t evenSize = 0, oddSize = 0;
+  for (size_t i = 0; i < layerDeltas.size(); ++i)
+  {
+    for (size_t j = 0; j < this->network[i]->InputDimensions().size(); ++j)
+      layerInputSizes[i] *= this->network[i]->InputDimensions()[j];
+
+    size_t& regionSize = (i % 2 == 0) ? evenSize : oddSize;
+    regionSize = std::max(regionSize, layerInputSizes[i]);
+  }
+  const size_t inputSize = shareDeltas ? (evenSize + oddSize) :
+      totalInputSize;
+
   // We need to initialize memory to store the output of each layer's Backward()
   // call.  We do this similarly to InitializeForwardPassMemory(), but we must
   // store a matrix to use as the delta for each layer.
-  if (batchSize * totalInputSize > layerDeltaMatrix.n_elem ||
-      batchSize * totalInputSize < std::floor(0.1 * layerDeltaMatrix.n_elem))
+  if (batchSize * inputSize > layerDeltaMatrix.n_elem ||
+      batchSize * inputSize < std::floor(0.1 * layerDeltaMatrix.n_elem))
   {
     // All deltas will be represented by one big block of memory.
-    layerDeltaMatrix = MatType(1, batchSize * totalInputSize);
+    layerDeltaMatrix = MatType(1, batchSize * inputSize);
   }
 
   // Now, create an alias to the right place for each layer.  We assume that
@@ -416,19 +739,27 @@ void MultiLayer<MatType>::InitializeBackwardPassMemory(
   size_t start = 0;
   for (size_t i = 0; i < layerDeltas.size(); ++i)
   {
-    size_t layerInputSize = 1;
-    for (size_t j = 0; j < this->network[i]->InputDimensions().size(); ++j)
-      layerInputSize *= this->network[i]->InputDimensions()[j];
+    if (shareDeltas)
+      start = (i % 2 == 0) ? 0 : batchSize * evenSize;
 
-    MakeAlias(layerDeltas[i], layerDeltaMatrix, layerInputSize,
+    MakeAlias(layerDeltas[i], layerDeltaMatrix, layerInputSizes[i],
         batchSize, start * layerDeltaMatrix.n_rows);
-    start += batchSize * layerInputSize;
+    start += batchSize * layerInputSizes[i];
   }
+
+  deltaAliasMemory = layerDeltaMatrix.memptr();
+  deltaAliasBatchSize = batchSize;
+  deltaAliasShared = shareDeltas;
 }
 
 template<typename MatType>
 void MultiLayer<MatType>::InitializeGradientPassMemory(MatType& gradient)
 {
+  // The optimizer usually passes the same gradient matrix at every iteration;
+  // the weight sizes do not change until SetWeights() is called again.
+  if (gradientAliasMemory != NULL && gradientAliasMemory == gradient.memptr())
+    return;
+
   // We need to initialize memory to store the gradients of each layer.  To do
   // this, we need to know the weight size of each layer.
   size_t gradientStart = 0;
@@ -438,6 +769,8 @@ void MultiLayer<MatType>::InitializeGradientPassMemory(MatType& gradient)
     MakeAlias(layerGradients[i], gradient, weightSize, 1, gradientStart);
     gradientStart += weightSize;
   }
+
+  gradientAliasMemory = gradient.memptr();
 }
 
 } // namespace mlpack
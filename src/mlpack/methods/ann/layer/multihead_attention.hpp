@@ -58,6 +58,16 @@ namespace mlpack {
  * [embedDim * (2 * srcSeqLen + tgtSeqLen), batchSize].  The
  * output data will always be of size (embedDim * tgtSeqLen, batchSize)
  *
+ * By default, the full (tgtSeqLen, srcSeqLen) attention matrix of every head
+ * is computed and stored for the backward pass.  If a nonzero block size is
+ * given, the attention is instead computed in (blockSize, blockSize) tiles of
+ * queries and keys with a streaming softmax, so that the attention matrix is
+ * never stored: only the log-sum-exp of the scores of each key is kept, and
+ * the tiles are recomputed when needed.  The heads (and points in the batch)
+ * are processed in parallel with OpenMP in this mode.  The result is the same
+ * as in the default mode, but the memory used no longer grows with
+ * tgtSeqLen * srcSeqLen, at the cost of computing the scores several times.
+ *
  * @tparam MatType Type of the input/output data (arma::colvec, arma::mat,
  *         arma::sp_mat or arma::cube).
  * @tparam RegularizerType Type of the regularizer to be used.
@@ -85,12 +95,15 @@ class MultiheadAttentionType : public Layer<MatType>
    * @param keyPaddingMask Key Padding Mask.  Takes the values [-Inf, 0]
    * @param selfAttention Use self-attention; source key, query, and value all
    *     come from the same inputs
+   * @param blockSize If nonzero, compute the attention in tiles of this many
+   *     queries and keys without storing the full attention matrix.
    */
   MultiheadAttentionType(const size_t tgtSeqLen,
                          const size_t numHeads,
                          const MatType& attnMask = MatType(),
                          const MatType& keyPaddingMask = MatType(),
-                         const bool selfAttention = false);
+                         const bool selfAttention = false,
+                         const size_t blockSize = 0);
 
   //! Clone the MultiheadAttentionType object. This handles polymorphism
   //! correctly.
@@ -190,6 +203,13 @@ class MultiheadAttentionType : public Layer<MatType>
   //! all come from the same input).
   bool& SelfAttention() { return selfAttention; }
 
+  //! Get the block size used for memory-efficient attention (0 means the full
+  //! attention matrix is computed).
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the block size used for memory-efficient attention (0 means the
+  //! full attention matrix is computed).
+  size_t& BlockSize() { return blockSize; }
+
   void ComputeOutputDimensions() override
   {
     if (this->inputDimensions.size() < 2)
@@ -266,6 +286,44 @@ class MultiheadAttentionType : public Layer<MatType>
  private:
   //! Element Type of the output.
   using ElemType = typename MatType::elem_type;
+  //! Cube type used for per-head computations.
+  using CubeType = arma::Cube<ElemType>;
+
+  /**
+   * Compute the attention output `attnOut` of each head from `qProj`, `kProj`
+   * and `vProj` one tile at a time, storing the log-sum-exp of the scores of
+   * each key in `logSumExp` instead of the scores themselves.
+   */
+  void BlockedAttention();
+
+  //! Compute the masked scores of slice `s` for the given (inclusive) ranges
+  //! of queries and keys.
+  void ScoreTile(const size_t s,
+                 const size_t qBegin,
+                 const size_t qEnd,
+                 const size_t kBegin,
+                 const size_t kEnd,
+                 MatType& tile) const;
+
+  //! Compute the attention probabilities of slice `s` for the given
+  //! (inclusive) ranges of queries and keys, using `logSumExp`.
+  void ProbabilityTile(const size_t s,
+                       const size_t qBegin,
+                       const size_t qEnd,
+                       const size_t kBegin,
+                       const size_t kEnd,
+                       MatType& tile) const;
+
+  /**
+   * Given the delta of the attention output of each head, of shape
+   * (tgtSeqLen, headDim, numHeads * batchSize), compute the deltas of the
+   * (scaled) projected query, key, and value.  This uses the stored `scores`,
+   * or recomputes them tile by tile if `blockSize` is nonzero.
+   */
+  void AttentionDeltas(const CubeType& gy,
+                       CubeType& dQuery,
+                       CubeType& dKey,
+                       CubeType& dValue);
 
   //! Target sequence length.
   size_t tgtSeqLen;
@@ -293,6 +351,10 @@ class MultiheadAttentionType : public Layer<MatType>
   //! come from the same input).
   bool selfAttention;
 
+  //! Size of the query and key tiles for memory-efficient attention; 0 if the
+  //! full attention matrix is used.
+  size_t blockSize;
+
   //! Locally-stored weight matrix associated with query.
   MatType queryWt;
 
@@ -332,6 +394,10 @@ class MultiheadAttentionType : public Layer<MatType>
   //! Locally-stored result of output of dropout layer.
   arma::Cube<ElemType> scores;
 
+  //! Log-sum-exp of the scores of each key, of shape
+  //! (srcSeqLen, numHeads * batchSize); only used if blockSize is nonzero.
+  MatType logSumExp;
+
   //! Locally-stored attention output weight to be fed to last linear layer.
   arma::Cube<ElemType> attnOut;
 
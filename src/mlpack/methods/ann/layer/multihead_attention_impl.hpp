@@ -29,7 +29,8 @@ MultiheadAttentionType() :
     embedDim(0),
     numHeads(0),
     headDim(0),
-    selfAttention(false)
+    selfAttention(false),
+    blockSize(0)
 {
   // Nothing to do here.
 }
@@ -41,14 +42,16 @@ MultiheadAttentionType(
     const size_t numHeads,
     const MatType& attnmask,
     const MatType& keypaddingmask,
-    const bool selfAttention) :
+    const bool selfAttention,
+    const size_t blockSize) :
     tgtSeqLen(tgtSeqLen),
     srcSeqLen(0),
     embedDim(0),
     numHeads(numHeads),
     attnMask(attnmask),
     keyPaddingMask(keypaddingmask),
-    selfAttention(selfAttention)
+    selfAttention(selfAttention),
+    blockSize(blockSize)
 {
 }
 
@@ -132,41 +135,54 @@ Forward(const MatType& input, MatType& output)
   kProj.reshape(srcSeqLen, headDim, numHeads * batchSize);
   vProj.reshape(srcSeqLen, headDim, numHeads * batchSize);
 
-  // Calculate the scores i.e. perform the matrix multiplication operation
-  // on qProj and kProj. Here score = qProj . kProj'
-  scores = MultiplyCube2Cube(qProj, kProj, false, true);
-
-  // Apply the attention mask if provided. The attention mask is used to black-
-  // out future sequences and generally used in Encoder-Decoder attention.
-  // The attention mask has elements -inf or 0.
+  // The attention mask is used to black-out future sequences and generally
+  // used in Encoder-Decoder attention; the key padding mask blacks-out any
+  // particular word in the sequence.  Both have elements -inf or 0.
   // The shape of the attention mask : (tgtSeqLen, srcSeqLen).
-  if (!attnMask.is_empty())
+  // The shape of keyPaddingMask : (1, srcSeqLen).
+  if (!attnMask.is_empty() &&
+      (attnMask.n_rows != tgtSeqLen || attnMask.n_cols != srcSeqLen))
   {
-    if (attnMask.n_rows != tgtSeqLen || attnMask.n_cols != srcSeqLen)
-      Log::Fatal << "The size of the 'attn_mask' is not correct.\n";
-    scores.each_slice() += attnMask;
+    Log::Fatal << "The size of the 'attn_mask' is not correct.\n";
   }
 
-  // Apply the key padding mask when provided. It blacks-out any particular
-  // word in the sequence.
-  // The key padding mask has elements -inf or 0
-  // The shape of keyPaddingMask : (1, srcSeqLen).
-  if (!keyPaddingMask.is_empty())
+  if (!keyPaddingMask.is_empty() &&
+      (keyPaddingMask.n_rows != 1 || keyPaddingMask.n_cols != srcSeqLen))
   {
-    if (keyPaddingMask.n_rows != 1 || keyPaddingMask.n_cols != srcSeqLen)
-        Log::Fatal << "The size of the 'keyPaddingMask' is not correct.\n";
-    scores.each_slice() += repmat(keyPaddingMask, tgtSeqLen, 1);
+    Log::Fatal << "The size of the 'keyPaddingMask' is not correct.\n";
   }
 
-  for (size_t i = 0; i < numHeads * batchSize; ++i)
+  if (blockSize > 0)
   {
-    softmax.Forward(scores.slice(i), scores.slice(i));
+    // Compute the attention output one tile at a time, without ever storing
+    // the scores.
+    // The shape of attnOutput : (tgtSeqLen, headDim, numHeads * batchSize).
+    scores.clear();
+    BlockedAttention();
   }
+  else
+  {
+    // Calculate the scores i.e. perform the matrix multiplication operation
+    // on qProj and kProj. Here score = qProj . kProj'
+    scores = MultiplyCube2Cube(qProj, kProj, false, true);
+
+    // Apply the masks if provided.
+    if (!attnMask.is_empty())
+      scores.each_slice() += attnMask;
+
+    if (!keyPaddingMask.is_empty())
+      scores.each_slice() += repmat(keyPaddingMask, tgtSeqLen, 1);
 
-  // Calculate the attention output i.e. matrix multiplication of softmax
-  // output and vProj.
-  // The shape of attnOutput : (tgtSeqLen, headDim, numHeads * batchSize).
-  attnOut = MultiplyCube2Cube(scores, vProj, false, false);
+    for (size_t i = 0; i < numHeads * batchSize; ++i)
+    {
+      softmax.Forward(scores.slice(i), scores.slice(i));
+    }
+
+    // Calculate the attention output i.e. matrix multiplication of softmax
+    // output and vProj.
+    // The shape of attnOutput : (tgtSeqLen, headDim, numHeads * batchSize).
+    attnOut = MultiplyCube2Cube(scores, vProj, false, false);
+  }
 
   // Now we will concatenate output of all the heads i.e. we will reshape
   // attnOut to (tgtSeqLen, embedDim, batchSize).
@@ -215,49 +231,31 @@ Backward(const MatType& /* input */,
   // The shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
   gyTemp.reshape(tgtSeqLen, headDim, numHeads * batchSize);
 
-  // Obtain backpropagted error of value.
-  // Shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
-  // Shape of scores : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  // The shape of tmp : (srcSeqLen, headDim, numHeads * batchSize).
-  CubeType tmp = MultiplyCube2Cube(scores, gyTemp, true, false);
+  // Obtain the backpropagated errors of the projected query, key, and value.
+  // The shape of dQuery : (tgtSeqLen, headDim, numHeads * batchSize).
+  // The shape of dKey and dValue : (srcSeqLen, headDim, numHeads * batchSize).
+  CubeType dQuery, dKey, dValue;
+  AttentionDeltas(gyTemp, dQuery, dKey, dValue);
 
   // Concatenate results of all the attention heads.
-  tmp.reshape(srcSeqLen, embedDim, batchSize);
+  dValue.reshape(srcSeqLen, embedDim, batchSize);
 
   for (size_t i = 0; i < batchSize; ++i)
   {
     if (selfAttention)
     {
       g.submat(0, i, g.n_rows - 1, i) =
-          vectorise(trans(tmp.slice(i) * valueWt));
+          vectorise(trans(dValue.slice(i) * valueWt));
     }
     else
     {
       g.submat((tgtSeqLen + srcSeqLen) * embedDim, i, g.n_rows - 1, i) =
-          vectorise(trans(tmp.slice(i) * valueWt));
+          vectorise(trans(dValue.slice(i) * valueWt));
     }
   }
 
-  // The shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
-  // The shape of vProj : (srcSeqLen, headDim, numHeads * batchSize).
-  // So the new shape of gyTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  gyTemp = MultiplyCube2Cube(gyTemp, vProj, false, true);
-
-  for (size_t i = 0; i < numHeads * batchSize; ++i)
-  {
-    // We will perform backpropagation of softmax over each slice of gyTemp.
-    softmax.Backward({} /* unused */, scores.slice(i), gyTemp.slice(i),
-        gyTemp.slice(i));
-  }
-
-  // Obtain backpropagated error of key.
-  // The shape of qProj : (tgtSeqLen, headDim, numHeads * batchSize).
-  // The shape of gyTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  // The new shape of tmp : (srcSeqLen, headDim, numHeads * batchSize).
-  tmp = MultiplyCube2Cube(gyTemp, qProj, true, false);
-
   // Concatenate results of all the attention heads.
-  tmp.reshape(srcSeqLen, embedDim, batchSize);
+  dKey.reshape(srcSeqLen, embedDim, batchSize);
 
   for (size_t i = 0; i < batchSize; ++i)
   {
@@ -265,24 +263,18 @@ Backward(const MatType& /* input */,
     {
       // Sum the query, key, and value deltas.
       g.submat(0, i, g.n_rows - 1, i) +=
-          vectorise(trans(tmp.slice(i) * keyWt));
+          vectorise(trans(dKey.slice(i) * keyWt));
     }
     else
     {
       g.submat(tgtSeqLen * embedDim, i,
                (tgtSeqLen + srcSeqLen) * embedDim - 1, i) =
-          vectorise(trans(tmp.slice(i) * keyWt));
+          vectorise(trans(dKey.slice(i) * keyWt));
     }
   }
 
-  // Obtain backpropagated error of the query.
-  // The shape of kProj : (srcSeqLen, headDim, numHeads * batchSize).
-  // The shape of gyTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  // The new shape of tmp : (tgtSeqLen, headDim, numHeads * batchSize).
-  tmp = MultiplyCube2Cube(gyTemp, kProj) / std::sqrt(headDim);
-
   // Concatenate results of all the attention heads.
-  tmp.reshape(tgtSeqLen, embedDim, batchSize);
+  dQuery.reshape(tgtSeqLen, embedDim, batchSize);
 
   for (size_t i = 0; i < batchSize; ++i)
   {
@@ -290,12 +282,12 @@ Backward(const MatType& /* input */,
     {
       // Sum the query, key, and value deltas.
       g.submat(0, i, g.n_rows - 1, i) +=
-          vectorise(trans(tmp.slice(i) * queryWt));
+          vectorise(trans(dQuery.slice(i) * queryWt));
     }
     else
     {
       g.submat(0, i, tgtSeqLen * embedDim - 1, i) =
-          vectorise(trans(tmp.slice(i) * queryWt));
+          vectorise(trans(dQuery.slice(i) * queryWt));
     }
   }
 }
@@ -369,84 +361,60 @@ Gradient(const MatType& input,
   // (tgtSeqLen, headDim, numHeads * batchSize).
   gyTemp.reshape(tgtSeqLen, headDim, numHeads * batchSize);
 
-  // Shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
-  // Shape of scores : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  // The new shape of errorTemp : (srcSeqLen, headDim, numHeads * batchSize).
-  errorTemp = MultiplyCube2Cube(scores, gyTemp, true, false);
+  // Obtain the propagated errors of the projected query, key, and value.
+  // The shape of dQuery : (tgtSeqLen, headDim, numHeads * batchSize).
+  // The shape of dKey and dValue : (srcSeqLen, headDim, numHeads * batchSize).
+  CubeType dQuery, dKey, dValue;
+  AttentionDeltas(gyTemp, dQuery, dKey, dValue);
 
   // Now we will concatenate the propagated errors from all heads i.e. we
-  // will reshape errorTemp to (srcSeqLen, embedDim, batchSize).
-  errorTemp.reshape(srcSeqLen, embedDim, batchSize);
+  // will reshape dValue to (srcSeqLen, embedDim, batchSize).
+  dValue.reshape(srcSeqLen, embedDim, batchSize);
 
-  // Gradient wrt. vBias, i.e. dL/d(vBias). We will take summation of errorTemp
+  // Gradient wrt. vBias, i.e. dL/d(vBias). We will take summation of dValue
   // over all the batches and over all the sequences.
   gradient.rows(4 * wtSize + 2 * embedDim, 4 * wtSize + 3 * embedDim - 1)
-      = vectorise(sum(sum(errorTemp, 2), 0));
+      = vectorise(sum(sum(dValue, 2), 0));
 
   // Shape of v : (srcSeqLen, embedDim, batchSize).
-  // Shape of errorTemp : (srcSeqLen, embedDim, bathSize).
+  // Shape of dValue : (srcSeqLen, embedDim, bathSize).
   // The new shape of errorTemp : (embedDim, embedDim, batchSize).
-  errorTemp = MultiplyCube2Cube(errorTemp, v, true, true);
+  errorTemp = MultiplyCube2Cube(dValue, v, true, true);
 
   // Gradient wrt. valueWt, i.e. dL/d(valueWt). We will take summation over all
   // batches of errorTemp.
   gradient.rows(2 * wtSize, 3 * wtSize - 1) = vectorise(sum(errorTemp, 2));
 
-  // Now, the shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
-  // The shape of vProj : (srcSeqLen, headDim, numHeads * batchSize).
-  // The new shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  errorTemp = MultiplyCube2Cube(gyTemp, vProj, false, true);
-
-  for (size_t i = 0; i < numHeads * batchSize; ++i)
-  {
-    // The shape of scores : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-    // The shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-    // The new shape of errorTemp remain same.
-    softmax.Backward({} /* unused */, scores.slice(i), errorTemp.slice(i),
-        errorTemp.slice(i));
-  }
-
-  // The shape of qProj : (tgtSeqLen, headDim, numHeads * batchSize).
-  // The shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  // The shape of gyTemp : (srcSeqLen, headDim, numHeads * batchSize).
-  gyTemp = MultiplyCube2Cube(errorTemp, qProj, true, false);
-
   // We will now conctenate the propagated errors from all heads.
-  // The new shape of gyTemp : (srcSeqLen, embedDim, batchSize).
-  gyTemp.reshape(srcSeqLen, embedDim, batchSize);
+  // The new shape of dKey : (srcSeqLen, embedDim, batchSize).
+  dKey.reshape(srcSeqLen, embedDim, batchSize);
 
   // Gradient wrt. kBias, i.e. dL/d(kBias). We will take summation over all the
-  // batches of gyTemp and then over all the sequences.
+  // batches of dKey and then over all the sequences.
   gradient.rows(4 * wtSize + embedDim, 4 * wtSize + 2 * embedDim - 1)
-      = vectorise(sum(sum(gyTemp, 2), 0));
+      = vectorise(sum(sum(dKey, 2), 0));
 
   // The shape of k : (embedDim, srcSeqLen, batchSize).
-  // The shape of gyTemp : (srcSeqLen, embedDim, batchSize).
+  // The shape of dKey : (srcSeqLen, embedDim, batchSize).
   // The shape of dkeyWt : (embedDim, embedDim, batchSize).
-  gyTemp = MultiplyCube2Cube(gyTemp, k, true, true);
+  gyTemp = MultiplyCube2Cube(dKey, k, true, true);
 
   // Gradient wrt. keyWt, i.e. dL/d(keyWt). We will take summation over all the
   // batches of dkeyWt.
   gradient.rows(wtSize, 2 * wtSize - 1) = vectorise(sum(gyTemp, 2));
 
-  // The shape of kProj : (srcSeqLen, headDim, numHeads * batchSize).
-  // The shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  // The shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
-  gyTemp = MultiplyCube2Cube(errorTemp, kProj, false, false);
-
   // Now, we will concatenate propagated error of all heads.
-  gyTemp.reshape(tgtSeqLen, embedDim, batchSize);
-  gyTemp /= std::sqrt(headDim);
+  dQuery.reshape(tgtSeqLen, embedDim, batchSize);
 
   // Gradient wrt. qBias, i.e. dL/d(qBias). We will take summation over all the
-  // batches of gyTemp and over all the sequences.
+  // batches of dQuery and over all the sequences.
   gradient.rows(4 * wtSize, 4 * wtSize + embedDim - 1)
-      = vectorise(sum(sum(gyTemp, 2), 0));
+      = vectorise(sum(sum(dQuery, 2), 0));
 
-  // The shape of gyTemp : (tgtSeqLen, embedDim, batchSize).
+  // The shape of dQuery : (tgtSeqLen, embedDim, batchSize).
   // The shape of q : (embedDim, tgtSeqLen, batchSize).
   // The shape of gyTemp : (embedDim, embedDim, batchSize).
-  gyTemp = MultiplyCube2Cube(gyTemp, q, true, true);
+  gyTemp = MultiplyCube2Cube(dQuery, q, true, true);
 
   // Gradient wrt. queryWt, i.e. dL/d(queryBias). We will take summation over
   // all the batches of gyTemp.
@@ -456,6 +424,207 @@ Gradient(const MatType& input,
   regularizer.Evaluate(weights, gradient);
 }
 
+template <typename MatType, typename RegularizerType>
+void MultiheadAttentionType<MatType, RegularizerType>::BlockedAttention()
+{
+  const size_t numSlices = qProj.n_slices;
+  attnOut.zeros(tgtSeqLen, headDim, numSlices);
+  logSumExp.set_size(srcSeqLen, numSlices);
+
+  // Each head of each point is independent, so they can be computed in
+  // parallel.
+  #pragma omp parallel for
+  for (size_t s = 0; s < numSlices; ++s)
+  {
+    // The scores of a tile of queries and keys; each column holds the scores
+    // of one key.
+    MatType tile;
+
+    // The softmax normalizes the scores of each key over all queries; so,
+    // first compute the log-sum-exp of each column of scores, one tile of
+    // queries at a time.
+    for (size_t kb = 0; kb < srcSeqLen; kb += blockSize)
+    {
+      const size_t ke = std::min(kb + blockSize, srcSeqLen) - 1;
+      const size_t bk = ke - kb + 1;
+
+      // Running maximum and sum of the exponentiated scores of each key.
+      arma::Col<ElemType> colMax(bk);
+      colMax.fill(-std::numeric_limits<ElemType>::infinity());
+      arma::Col<ElemType> colSum(bk, arma::fill::zeros);
+
+      for (size_t qb = 0; qb < tgtSeqLen; qb += blockSize)
+      {
+        const size_t qe = std::min(qb + blockSize, tgtSeqLen) - 1;
+        const size_t bq = qe - qb + 1;
+
+        ScoreTile(s, qb, qe, kb, ke, tile);
+
+        // Update the sum of each key with the new scores, rescaling what has
+        // been accumulated so far if the maximum changed.
+        for (size_t j = 0; j < bk; ++j)
+        {
+          const ElemType* t = tile.colptr(j);
+          ElemType newMax = colMax[j];
+          for (size_t i = 0; i < bq; ++i)
+            newMax = std::max(newMax, t[i]);
+
+          // If everything is masked so far, all terms are zero.
+          const ElemType shift = std::isinf(newMax) ? 0 : newMax;
+          ElemType sum = 0;
+          for (size_t i = 0; i < bq; ++i)
+            sum += std::exp(t[i] - shift);
+
+          colSum[j] = std::exp(colMax[j] - shift) * colSum[j] + sum;
+          colMax[j] = newMax;
+        }
+      }
+
+      // For a key where every query is masked, the log-sum-exp is set to +inf
+      // so that all of its probabilities are zero.
+      for (size_t j = 0; j < bk; ++j)
+      {
+        logSumExp(kb + j, s) = (colSum[j] > 0) ?
+            colMax[j] + std::log(colSum[j]) :
+            std::numeric_limits<ElemType>::infinity();
+      }
+    }
+
+    // Now accumulate the output, one tile at a time.
+    for (size_t kb = 0; kb < srcSeqLen; kb += blockSize)
+    {
+      const size_t ke = std::min(kb + blockSize, srcSeqLen) - 1;
+      for (size_t qb = 0; qb < tgtSeqLen; qb += blockSize)
+      {
+        const size_t qe = std::min(qb + blockSize, tgtSeqLen) - 1;
+
+        ProbabilityTile(s, qb, qe, kb, ke, tile);
+        attnOut.slice(s).rows(qb, qe) += tile * vProj.slice(s).rows(kb, ke);
+      }
+    }
+  }
+}
+
+template <typename MatType, typename RegularizerType>
+void MultiheadAttentionType<MatType, RegularizerType>::ScoreTile(
+    const size_t s,
+    const size_t qBegin,
+    const size_t qEnd,
+    const size_t kBegin,
+    const size_t kEnd,
+    MatType& tile) const
+{
+  tile = qProj.slice(s).rows(qBegin, qEnd) *
+      trans(kProj.slice(s).rows(kBegin, kEnd));
+
+  if (!attnMask.is_empty())
+    tile += attnMask.submat(qBegin, kBegin, qEnd, kEnd);
+
+  if (!keyPaddingMask.is_empty())
+    tile.each_row() += keyPaddingMask.cols(kBegin, kEnd);
+}
+
+template <typename MatType, typename RegularizerType>
+void MultiheadAttentionType<MatType, RegularizerType>::ProbabilityTile(
+    const size_t s,
+    const size_t qBegin,
+    const size_t qEnd,
+    const size_t kBegin,
+    const size_t kEnd,
+    MatType& tile) const
+{
+  ScoreTile(s, qBegin, qEnd, kBegin, kEnd, tile);
+  tile.each_row() -= trans(logSumExp.submat(kBegin, s, kEnd, s));
+  tile = exp(tile);
+}
+
+template <typename MatType, typename RegularizerType>
+void MultiheadAttentionType<MatType, RegularizerType>::AttentionDeltas(
+    const CubeType& gy,
+    CubeType& dQuery,
+    CubeType& dKey,
+    CubeType& dValue)
+{
+  if (blockSize == 0)
+  {
+    // Shape of gy : (tgtSeqLen, headDim, numHeads * batchSize).
+    // Shape of scores : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
+    // The shape of dValue : (srcSeqLen, headDim, numHeads * batchSize).
+    dValue = MultiplyCube2Cube(scores, gy, true, false);
+
+    // The shape of vProj : (srcSeqLen, headDim, numHeads * batchSize).
+    // So the shape of dScores : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
+    CubeType dScores = MultiplyCube2Cube(gy, vProj, false, true);
+
+    for (size_t i = 0; i < dScores.n_slices; ++i)
+    {
+      // We will perform backpropagation of softmax over each slice.
+      softmax.Backward({} /* unused */, scores.slice(i), dScores.slice(i),
+          dScores.slice(i));
+    }
+
+    // The shape of qProj : (tgtSeqLen, headDim, numHeads * batchSize).
+    // The shape of dKey : (srcSeqLen, headDim, numHeads * batchSize).
+    dKey = MultiplyCube2Cube(dScores, qProj, true, false);
+
+    // The shape of kProj : (srcSeqLen, headDim, numHeads * batchSize).
+    // The shape of dQuery : (tgtSeqLen, headDim, numHeads * batchSize).
+    dQuery = MultiplyCube2Cube(dScores, kProj) / std::sqrt(headDim);
+    return;
+  }
+
+  // The scores were not stored, so recompute the probabilities one tile at a
+  // time from the log-sum-exp of each key.
+  const size_t numSlices = gy.n_slices;
+  dQuery.zeros(tgtSeqLen, headDim, numSlices);
+  dKey.zeros(srcSeqLen, headDim, numSlices);
+  dValue.zeros(srcSeqLen, headDim, numSlices);
+
+  #pragma omp parallel for
+  for (size_t s = 0; s < numSlices; ++s)
+  {
+    // Probabilities and their deltas for a tile.
+    MatType tile, dTile;
+
+    for (size_t kb = 0; kb < srcSeqLen; kb += blockSize)
+    {
+      const size_t ke = std::min(kb + blockSize, srcSeqLen) - 1;
+
+      // The delta of the values of this tile of keys needs all queries.
+      for (size_t qb = 0; qb < tgtSeqLen; qb += blockSize)
+      {
+        const size_t qe = std::min(qb + blockSize, tgtSeqLen) - 1;
+
+        ProbabilityTile(s, qb, qe, kb, ke, tile);
+        dValue.slice(s).rows(kb, ke) += trans(tile) * gy.slice(s).rows(qb, qe);
+      }
+
+      // The softmax backward pass needs, for each key, the sum over all
+      // queries of the probabilities times their deltas; that is the same as
+      // the dot product of the value and its delta.
+      const arma::Row<ElemType> colDot = trans(sum(
+          vProj.slice(s).rows(kb, ke) % dValue.slice(s).rows(kb, ke), 1));
+
+      for (size_t qb = 0; qb < tgtSeqLen; qb += blockSize)
+      {
+        const size_t qe = std::min(qb + blockSize, tgtSeqLen) - 1;
+
+        // Backpropagate through the softmax.
+        ProbabilityTile(s, qb, qe, kb, ke, tile);
+        dTile = gy.slice(s).rows(qb, qe) * trans(vProj.slice(s).rows(kb, ke));
+        dTile.each_row() -= colDot;
+        dTile %= tile;
+
+        dKey.slice(s).rows(kb, ke) += trans(dTile) *
+            qProj.slice(s).rows(qb, qe);
+        dQuery.slice(s).rows(qb, qe) += dTile * kProj.slice(s).rows(kb, ke);
+      }
+    }
+  }
+
+  dQuery /= std::sqrt(headDim);
+}
+
 template <typename MatType, typename RegularizerType>
 template <typename Archive>
 void MultiheadAttentionType<MatType, RegularizerType>::
@@ -473,6 +642,7 @@ serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(regularizer));
   ar(CEREAL_NVP(attnMask));
   ar(CEREAL_NVP(keyPaddingMask));
+  ar(CEREAL_NVP(blockSize));
 
   if (Archive::is_loading::value)
   {
@@ -489,6 +659,7 @@ serialize(Archive& ar, const uint32_t /* version */)
     kProj.clear();
     vProj.clear();
     scores.clear();
+    logSumExp.clear();
     attnOut.clear();
   }
 }
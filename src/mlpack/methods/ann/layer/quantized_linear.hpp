@@ -0,0 +1,131 @@
+/**
+ * @file methods/ann/layer/quantized_linear.hpp
+ *
+ * Definition of the QuantizedLinear layer, an inference-only version of the
+ * Linear layer whose weights are stored as 8-bit integers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer.hpp"
+#include "linear.hpp"
+
+namespace mlpack {
+
+/**
+ * The QuantizedLinear layer is an inference-only copy of a trained Linear
+ * layer, y = Ax + b, whose weight matrix A is quantized to signed 8-bit
+ * integers with one scale per output unit (that is, per row of A): each row is
+ * divided by (max_j |A_ij|) / 127 and rounded.  The bias is kept in full
+ * precision.
+ *
+ * In the forward pass, each input point is quantized in the same way with its
+ * own scale, the product of the quantized weights and inputs is computed with
+ * 32-bit integer accumulation, and the result is rescaled back to the element
+ * type of `MatType`.  The weights take a quarter of the memory of the original
+ * layer (an eighth for `arma::mat`), and the layer has no trainable
+ * parameters: WeightSize() is 0, and Backward() and Gradient() throw.
+ *
+ * A QuantizedLinear layer is usually not created directly; instead, call
+ * `FFN::Quantize()` on a trained network to replace all of its Linear layers.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class QuantizedLinearType : public Layer<MatType>
+{
+ public:
+  //! Create an empty QuantizedLinear object (for serialization).
+  QuantizedLinearType();
+
+  /**
+   * Quantize the weights of the given Linear layer.  The layer must have its
+   * output dimensions computed and its weights set (e.g., it must be a layer
+   * of a trained network).
+   *
+   * @param layer Linear layer to quantize.
+   */
+  template<typename RegularizerType>
+  QuantizedLinearType(const LinearType<MatType, RegularizerType>& layer);
+
+  virtual ~QuantizedLinearType() { }
+
+  //! Clone the QuantizedLinearType object. This handles polymorphism correctly.
+  QuantizedLinearType* Clone() const { return new QuantizedLinearType(*this); }
+
+  /**
+   * Compute the output of the layer, Ax + b, with the quantized weights.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  //! QuantizedLinear layers are inference-only; this throws an exception.
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& /* gy */,
+                MatType& /* g */);
+
+  //! QuantizedLinear layers are inference-only; this throws an exception.
+  void Gradient(const MatType& /* input */,
+                const MatType& /* error */,
+                MatType& /* gradient */);
+
+  //! Get the quantized weights (one column per output unit).
+  const arma::Mat<arma::s8>& QuantizedWeight() const { return weight; }
+  //! Get the scale of the weights of each output unit.
+  const MatType& WeightScales() const { return weightScales; }
+  //! Get the bias of the layer.
+  const MatType& Bias() const { return bias; }
+
+  //! Get the number of output units.
+  size_t OutputUnits() const { return outSize; }
+
+  //! Compute the output dimensions of the layer given `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  //! Serialize the layer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Number of points processed together by the integer kernel, so that each
+  //! row of weights is reused while it is in cache.
+  static constexpr size_t tileSize = 8;
+
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! The quantized weights, transposed: column i holds row i of A.
+  arma::Mat<arma::s8> weight;
+
+  //! The scale of each row of the weights.
+  MatType weightScales;
+
+  //! The (unquantized) bias.
+  MatType bias;
+}; // class QuantizedLinearType
+
+// Convenience typedefs.
+
+// Standard QuantizedLinear layer.
+using QuantizedLinear = QuantizedLinearType<arma::mat>;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "quantized_linear_impl.hpp"
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ * @file methods/ann/layer/quantized_linear_impl.hpp
+ *
+ * Implementation of the QuantizedLinear layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "quantized_linear.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+QuantizedLinearType<MatType>::QuantizedLinearType() :
+    Layer<MatType>(),
+    inSize(0),
+    outSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+template<typename RegularizerType>
+QuantizedLinearType<MatType>::QuantizedLinearType(
+    const LinearType<MatType, RegularizerType>& layer) :
+    Layer<MatType>(layer),
+    inSize(layer.Weight().n_cols),
+    outSize(layer.Weight().n_rows)
+{
+  using eT = typename MatType::elem_type;
+
+  if (layer.Weight().n_elem == 0 && layer.WeightSize() != 0)
+  {
+    throw std::invalid_argument("QuantizedLinear: cannot quantize a Linear "
+        "layer whose weights have not been set!");
+  }
+
+  weight.set_size(inSize, outSize);
+  weightScales.set_size(outSize, 1);
+  bias = layer.Bias();
+
+  for (size_t i = 0; i < outSize; ++i)
+  {
+    const eT maxValue = arma::max(arma::abs(layer.Weight().row(i)));
+    const eT scale = (maxValue > 0) ? maxValue / eT(127) : eT(1);
+    weightScales[i] = scale;
+    for (size_t j = 0; j < inSize; ++j)
+    {
+      weight(j, i) = (arma::s8) std::lround(
+          std::clamp(layer.Weight()(i, j) / scale, eT(-127), eT(127)));
+    }
+  }
+}
+
+template<typename MatType>
+void QuantizedLinearType<MatType>::Forward(
+    const MatType& input, MatType& output)
+{
+  using eT = typename MatType::elem_type;
+
+  // Quantize each input point with its own scale.
+  arma::Mat<arma::s8> quantizedInput(inSize, input.n_cols);
+  MatType inputScales(1, input.n_cols);
+
+  #pragma omp parallel for
+  for (size_t c = 0; c < (size_t) input.n_cols; ++c)
+  {
+    const eT maxValue = arma::max(arma::abs(input.col(c)));
+    const eT scale = (maxValue > 0) ? maxValue / eT(127) : eT(1);
+    inputScales[c] = scale;
+
+    arma::s8* q = quantizedInput.colptr(c);
+    for (size_t j = 0; j < inSize; ++j)
+    {
+      q[j] = (arma::s8) std::lround(std::clamp(input(j, c) / scale, eT(-127),
+          eT(127)));
+    }
+  }
+
+  // Compute the integer product of the weights and the inputs, a tile of
+  // points at a time so that each row of the weights is read once per tile.
+  const size_t numTiles = (input.n_cols + tileSize - 1) / tileSize;
+
+  #pragma omp parallel for
+  for (size_t t = 0; t < numTiles; ++t)
+  {
+    const size_t begin = t * tileSize;
+    const size_t end = std::min(begin + tileSize, (size_t) input.n_cols);
+
+    for (size_t i = 0; i < outSize; ++i)
+    {
+      const arma::s8* w = weight.colptr(i);
+      for (size_t c = begin; c < end; ++c)
+      {
+        const arma::s8* x = quantizedInput.colptr(c);
+        int32_t sum = 0;
+        for (size_t j = 0; j < inSize; ++j)
+          sum += int32_t(w[j]) * int32_t(x[j]);
+
+        output(i, c) = eT(sum) * weightScales[i] * inputScales[c] + bias[i];
+      }
+    }
+  }
+}
+
+template<typename MatType>
+void QuantizedLinearType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& /* gy */,
+    MatType& /* g */)
+{
+  throw std::invalid_argument("QuantizedLinear::Backward(): quantized layers "
+      "can only be used for inference!");
+}
+
+template<typename MatType>
+void QuantizedLinearType<MatType>::Gradient(
+    const MatType& /* input */,
+    const MatType& /* error */,
+    MatType& /* gradient */)
+{
+  throw std::invalid_argument("QuantizedLinear::Gradient(): quantized layers "
+      "can only be used for inference!");
+}
+
+template<typename MatType>
+void QuantizedLinearType<MatType>::ComputeOutputDimensions()
+{
+  size_t inputSize = this->inputDimensions[0];
+  for (size_t i = 1; i < this->inputDimensions.size(); ++i)
+    inputSize *= this->inputDimensions[i];
+
+  if (inputSize != inSize)
+  {
+    std::ostringstream oss;
+    oss << "QuantizedLinear::ComputeOutputDimensions(): input size "
+        << inputSize << " does not match the " << inSize << " input units of "
+        << "the quantized weights!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Like the Linear layer, the QuantizedLinear layer flattens its input.
+  this->outputDimensions = std::vector<size_t>(this->inputDimensions.size(),
+      1);
+  this->outputDimensions[0] = outSize;
+}
+
+template<typename MatType>
+template<typename Archive>
+void QuantizedLinearType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+  ar(CEREAL_NVP(weight));
+  ar(CEREAL_NVP(weightScales));
+  ar(CEREAL_NVP(bias));
+}
+
+} // namespace mlpack
+
+#endif
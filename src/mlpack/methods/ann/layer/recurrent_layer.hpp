@@ -107,6 +107,17 @@ class RecurrentLayer : public Layer<MatType>
   // Modify the stored recurrent state at time step `t`.  Be careful!
   MatType& RecurrentState(const size_t t);
 
+  /**
+   * Swap the stored recurrent state of all time steps with the given cube.
+   * This is used by `RNN::Step()` to run the layer on the state of a set of
+   * sessions, without copying it: the state is swapped in before the forward
+   * pass and swapped back out after it.
+   */
+  void SwapRecurrentState(arma::Cube<typename MatType::elem_type>& state)
+  {
+    recurrentState.swap(state);
+  }
+
   /**
    * Get the stored recurrent gradient at the given time step `t`.  `t` must be
    * `CurrentStep()` or `PreviousStep()`.  The recurrent gradient represents the
@@ -40,6 +40,16 @@
     CEREAL_REGISTER_TYPE(mlpack::BatchNormType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::ConcatType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::ConcatenateType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::ConvolutionType< \
+        mlpack::WinogradConvolution<mlpack::ValidConvolution>, \
+        mlpack::WinogradConvolution<mlpack::FullConvolution>, \
+        mlpack::WinogradConvolution<mlpack::ValidConvolution>, \
+        __VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::ConvolutionType< \
+        mlpack::Im2ColConvolution<mlpack::ValidConvolution>, \
+        mlpack::Im2ColConvolution<mlpack::FullConvolution>, \
+        mlpack::Im2ColConvolution<mlpack::ValidConvolution>, \
+        __VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::ConvolutionType< \
         mlpack::NaiveConvolution<mlpack::ValidConvolution>, \
         mlpack::NaiveConvolution<mlpack::FullConvolution>, \
@@ -50,12 +60,25 @@
     CEREAL_REGISTER_TYPE(mlpack::DropConnectType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::DropoutType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::ELUType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::EmbeddingType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::FastLSTMType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::FlexibleReLUType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::GroupedConvolutionType< \
+        mlpack::WinogradConvolution<mlpack::ValidConvolution>, \
+        mlpack::WinogradConvolution<mlpack::FullConvolution>, \
+        mlpack::WinogradConvolution<mlpack::ValidConvolution>, \
+        __VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::GroupedConvolutionType< \
+        mlpack::Im2ColConvolution<mlpack::ValidConvolution>, \
+        mlpack::Im2ColConvolution<mlpack::FullConvolution>, \
+        mlpack::Im2ColConvolution<mlpack::ValidConvolution>, \
+        __VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::GroupedConvolutionType< \
         mlpack::NaiveConvolution<mlpack::ValidConvolution>, \
         mlpack::NaiveConvolution<mlpack::FullConvolution>, \
         mlpack::NaiveConvolution<mlpack::ValidConvolution>, \
         __VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::GRUType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::IdentityType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::LeakyReLUType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::LayerNormType<__VA_ARGS__>); \
@@ -71,13 +94,21 @@
     CEREAL_REGISTER_TYPE(mlpack::NoisyLinearType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::PaddingType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::PReLUType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::QuantizedLinearType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::RBFType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::ReLU6Type<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::RepeatType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::SoftmaxType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::SoftminType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::SparseLinearType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::HardTanHType<__VA_ARGS__>); \
     CEREAL_REGISTER_TYPE(mlpack::FTSwishType<__VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::FusedLinearType< \
+        mlpack::RectifierFunction, __VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::FusedLinearType< \
+        mlpack::LogisticFunction, __VA_ARGS__>); \
+    CEREAL_REGISTER_TYPE(mlpack::FusedLinearType< \
+        mlpack::TanhFunction, __VA_ARGS__>); \
 
 CEREAL_REGISTER_MLPACK_LAYERS(arma::mat);
 
@@ -0,0 +1,145 @@
+/**
+ * @file methods/ann/layer/sparse_linear.hpp
+ *
+ * Definition of the SparseLinear layer, an inference-only version of the
+ * Linear and LinearNoBias layers that stores only the nonzero weights.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer.hpp"
+#include "linear.hpp"
+#include "linear_no_bias.hpp"
+
+namespace mlpack {
+
+/**
+ * The SparseLinear layer is an inference-only copy of a trained Linear layer,
+ * y = Ax + b (or of a LinearNoBias layer, y = Ax), that stores only the
+ * nonzero elements of the weight matrix A.  It is meant for networks whose
+ * weights have been pruned (see `FFN::Prune()`): at 90% sparsity, the weights
+ * take a fifth of the memory of the dense layer, and the forward pass does a
+ * tenth of the multiplications.
+ *
+ * The rows of A are stored in compressed sparse row (CSR) form, as the columns
+ * of a sparse matrix holding A^T.  In the forward pass the input batch is
+ * transposed, so that each feature of the input is contiguous over the points
+ * of the batch; then each nonzero weight A_ij adds a multiple of column j of
+ * the transposed input to column i of the transposed output, a contiguous
+ * loop that the compiler vectorizes.  The rows of A are distributed over
+ * threads with OpenMP.
+ *
+ * The layer has no trainable parameters: WeightSize() is 0, and Backward() and
+ * Gradient() throw.  A SparseLinear layer is usually not created directly;
+ * instead, call `FFN::Sparsify()` on a trained (and pruned) network to replace
+ * all of its Linear and LinearNoBias layers.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class SparseLinearType : public Layer<MatType>
+{
+ public:
+  //! Type of the sparse weight matrix.
+  using SpMatType = arma::SpMat<typename MatType::elem_type>;
+
+  //! Create an empty SparseLinear object (for serialization).
+  SparseLinearType();
+
+  /**
+   * Store the nonzero weights of the given Linear layer.  The layer must have
+   * its output dimensions computed and its weights set (e.g., it must be a
+   * layer of a trained network).
+   *
+   * @param layer Linear layer to convert.
+   */
+  template<typename RegularizerType>
+  SparseLinearType(const LinearType<MatType, RegularizerType>& layer);
+
+  /**
+   * Store the nonzero weights of the given LinearNoBias layer; the bias of the
+   * SparseLinear layer is zero.  The layer must have its output dimensions
+   * computed and its weights set.
+   *
+   * @param layer LinearNoBias layer to convert.
+   */
+  template<typename RegularizerType>
+  SparseLinearType(const LinearNoBiasType<MatType, RegularizerType>& layer);
+
+  virtual ~SparseLinearType() { }
+
+  //! Clone the SparseLinearType object. This handles polymorphism correctly.
+  SparseLinearType* Clone() const { return new SparseLinearType(*this); }
+
+  /**
+   * Compute the output of the layer, Ax + b, with the sparse weights.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  //! SparseLinear layers are inference-only; this throws an exception.
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& /* gy */,
+                MatType& /* g */);
+
+  //! SparseLinear layers are inference-only; this throws an exception.
+  void Gradient(const MatType& /* input */,
+                const MatType& /* error */,
+                MatType& /* gradient */);
+
+  //! Get the sparse weights, transposed: column i holds row i of A.
+  const SpMatType& Weight() const { return weight; }
+  //! Get the bias of the layer.
+  const MatType& Bias() const { return bias; }
+
+  //! Get the number of nonzero weights.
+  size_t NonZeros() const { return weight.n_nonzero; }
+  //! Get the number of output units.
+  size_t OutputUnits() const { return outSize; }
+
+  //! Compute the output dimensions of the layer given `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  //! Serialize the layer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Store the nonzero elements of the given dense weights.
+  void SetSparseWeights(const MatType& denseWeight);
+
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! The nonzero weights, transposed: column i holds row i of A.
+  SpMatType weight;
+
+  //! The bias.
+  MatType bias;
+}; // class SparseLinearType
+
+// Convenience typedefs.
+
+// Standard SparseLinear layer.
+using SparseLinear = SparseLinearType<arma::mat>;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "sparse_linear_impl.hpp"
+
+#endif
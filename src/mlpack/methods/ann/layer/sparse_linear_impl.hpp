@@ -0,0 +1,163 @@
+/**
+ * @file methods/ann/layer/sparse_linear_impl.hpp
+ *
+ * Implementation of the SparseLinear layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "sparse_linear.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+SparseLinearType<MatType>::SparseLinearType() :
+    Layer<MatType>(),
+    inSize(0),
+    outSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+template<typename RegularizerType>
+SparseLinearType<MatType>::SparseLinearType(
+    const LinearType<MatType, RegularizerType>& layer) :
+    Layer<MatType>(layer),
+    inSize(layer.Weight().n_cols),
+    outSize(layer.Weight().n_rows)
+{
+  if (layer.Weight().n_elem == 0 && layer.WeightSize() != 0)
+  {
+    throw std::invalid_argument("SparseLinear: cannot convert a Linear layer "
+        "whose weights have not been set!");
+  }
+
+  SetSparseWeights(layer.Weight());
+  bias = layer.Bias();
+}
+
+template<typename MatType>
+template<typename RegularizerType>
+SparseLinearType<MatType>::SparseLinearType(
+    const LinearNoBiasType<MatType, RegularizerType>& layer) :
+    Layer<MatType>(layer),
+    inSize(layer.Parameters().n_cols),
+    outSize(layer.Parameters().n_rows)
+{
+  if (layer.Parameters().n_elem == 0 && layer.WeightSize() != 0)
+  {
+    throw std::invalid_argument("SparseLinear: cannot convert a LinearNoBias "
+        "layer whose weights have not been set!");
+  }
+
+  SetSparseWeights(layer.Parameters());
+  bias.zeros(outSize, 1);
+}
+
+template<typename MatType>
+void SparseLinearType<MatType>::SetSparseWeights(const MatType& denseWeight)
+{
+  // Only the nonzero elements are kept.
+  weight = SpMatType(MatType(denseWeight.t()));
+}
+
+template<typename MatType>
+void SparseLinearType<MatType>::Forward(
+    const MatType& input, MatType& output)
+{
+  using eT = typename MatType::elem_type;
+
+  // With the input transposed, each term of the product is a contiguous loop
+  // over the points of the batch.
+  const MatType inputT = input.t();
+  MatType outputT(input.n_cols, outSize);
+
+  const arma::uword* colPtrs = weight.col_ptrs;
+  const arma::uword* rowIndices = weight.row_indices;
+  const eT* values = weight.values;
+  const size_t points = input.n_cols;
+
+  #pragma omp parallel for schedule(dynamic, 16)
+  for (size_t i = 0; i < outSize; ++i)
+  {
+    eT* out = outputT.colptr(i);
+    std::fill(out, out + points, bias[i]);
+
+    for (size_t k = colPtrs[i]; k < colPtrs[i + 1]; ++k)
+    {
+      const eT w = values[k];
+      const eT* x = inputT.colptr(rowIndices[k]);
+      for (size_t c = 0; c < points; ++c)
+        out[c] += w * x[c];
+    }
+  }
+
+  output = outputT.t();
+}
+
+template<typename MatType>
+void SparseLinearType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& /* gy */,
+    MatType& /* g */)
+{
+  throw std::invalid_argument("SparseLinear::Backward(): sparse layers can "
+      "only be used for inference!");
+}
+
+template<typename MatType>
+void SparseLinearType<MatType>::Gradient(
+    const MatType& /* input */,
+    const MatType& /* error */,
+    MatType& /* gradient */)
+{
+  throw std::invalid_argument("SparseLinear::Gradient(): sparse layers can "
+      "only be used for inference!");
+}
+
+template<typename MatType>
+void SparseLinearType<MatType>::ComputeOutputDimensions()
+{
+  size_t inputSize = this->inputDimensions[0];
+  for (size_t i = 1; i < this->inputDimensions.size(); ++i)
+    inputSize *= this->inputDimensions[i];
+
+  if (inputSize != inSize)
+  {
+    std::ostringstream oss;
+    oss << "SparseLinear::ComputeOutputDimensions(): input size "
+        << inputSize << " does not match the " << inSize << " input units of "
+        << "the sparse weights!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Like the Linear layer, the SparseLinear layer flattens its input.
+  this->outputDimensions = std::vector<size_t>(this->inputDimensions.size(),
+      1);
+  this->outputDimensions[0] = outSize;
+}
+
+template<typename MatType>
+template<typename Archive>
+void SparseLinearType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+  ar(CEREAL_NVP(weight));
+  ar(CEREAL_NVP(bias));
+}
+
+} // namespace mlpack
+
+#endif
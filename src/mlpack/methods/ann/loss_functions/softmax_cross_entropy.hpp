@@ -0,0 +1,106 @@
+/**
+ * @file methods/ann/loss_functions/softmax_cross_entropy.hpp
+ *
+ * Definition of the SoftmaxCrossEntropyType class, the fused combination of the
+ * LogSoftmax layer and the NegativeLogLikelihood loss.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LOSS_FUNCTIONS_SOFTMAX_CROSS_ENTROPY_HPP
+#define MLPACK_METHODS_ANN_LOSS_FUNCTIONS_SOFTMAX_CROSS_ENTROPY_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The softmax cross-entropy loss, which is the negative log likelihood of the
+ * softmax of its input.  The input contains one unnormalized score (logit) for
+ * each class, and the target is a class index in the range
+ * [0, numClasses - 1].  For each point, the loss is
+ *
+ * @f[
+ * l = \log \sum_c \exp(x_c) - x_t
+ * @f]
+ *
+ * and its gradient is softmax(x) - e_t.
+ *
+ * The result is the same as a network that ends with a LogSoftmax layer and
+ * uses the NegativeLogLikelihood loss, but the loss and the gradient are each
+ * computed in a single pass over each column (after subtracting the maximum of
+ * the column, for numerical stability), in parallel over the columns, and
+ * without intermediate matrices.  This matters when there are many classes.
+ *
+ * Since the softmax does not change the order of the scores, the predicted
+ * class of a network using this loss is still the index of its largest output.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class SoftmaxCrossEntropyType
+{
+ public:
+  /**
+   * Create the SoftmaxCrossEntropyType object.
+   *
+   * @param reduction Specifies the reduction to apply to the output. If false,
+   *                  'mean' reduction is used, where sum of the output will be
+   *                  divided by the number of points. If true, 'sum' reduction
+   *                  is used and the output will be summed. It is set to true
+   *                  by default.
+   */
+  SoftmaxCrossEntropyType(const bool reduction = true);
+
+  /**
+   * Compute the softmax cross-entropy loss.
+   *
+   * @param prediction Unnormalized scores of each class (one column per point).
+   * @param target The target vector, that contains the class index of each
+   *        point, in the range [0, numClasses - 1].
+   */
+  typename MatType::elem_type Forward(const MatType& prediction,
+                                      const MatType& target);
+
+  /**
+   * Compute the gradient of the softmax cross-entropy loss with respect to the
+   * scores.
+   *
+   * @param prediction Unnormalized scores of each class (one column per point).
+   * @param target The target vector, that contains the class index of each
+   *        point, in the range [0, numClasses - 1].
+   * @param loss The calculated error.
+   */
+  void Backward(const MatType& prediction,
+                const MatType& target,
+                MatType& loss);
+
+  //! Get the reduction type, represented as boolean
+  //! (false 'mean' reduction, true 'sum' reduction).
+  bool Reduction() const { return reduction; }
+  //! Modify the type of reduction used.
+  bool& Reduction() { return reduction; }
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Boolean value that tells if reduction is 'sum' or 'mean'.
+  bool reduction;
+}; // class SoftmaxCrossEntropyType
+
+// Default typedef for typical `arma::mat` usage.
+using SoftmaxCrossEntropy = SoftmaxCrossEntropyType<arma::mat>;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "softmax_cross_entropy_impl.hpp"
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * @file methods/ann/loss_functions/softmax_cross_entropy_impl.hpp
+ *
+ * Implementation of the SoftmaxCrossEntropyType class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LOSS_FUNCTIONS_SOFTMAX_CROSS_ENTROPY_IMPL_HPP
+#define MLPACK_METHODS_ANN_LOSS_FUNCTIONS_SOFTMAX_CROSS_ENTROPY_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "softmax_cross_entropy.hpp"
+
+#include <mlpack/core/util/log.hpp>
+
+namespace mlpack {
+
+template<typename MatType>
+SoftmaxCrossEntropyType<MatType>::SoftmaxCrossEntropyType(
+    const bool reduction) : reduction(reduction)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+typename MatType::elem_type SoftmaxCrossEntropyType<MatType>::Forward(
+    const MatType& prediction,
+    const MatType& target)
+{
+  using ElemType = typename MatType::elem_type;
+
+  const size_t numClasses = prediction.n_rows;
+  ElemType lossSum = 0;
+
+  // Check the targets outside of the parallel loop, where an exception could
+  // not be propagated.
+  for (size_t i = 0; i < target.n_elem; ++i)
+  {
+    Log::Assert(target(i) >= 0 && target(i) < numClasses,
+        "Target class out of range.");
+  }
+
+  #pragma omp parallel for schedule(static) reduction(+:lossSum)
+  for (size_t i = 0; i < prediction.n_cols; ++i)
+  {
+    const size_t t = (size_t) target(i);
+
+    const ElemType* scores = prediction.colptr(i);
+    ElemType maxScore = scores[0];
+    for (size_t c = 1; c < numClasses; ++c)
+      maxScore = std::max(maxScore, scores[c]);
+
+    ElemType sum = 0;
+    for (size_t c = 0; c < numClasses; ++c)
+      sum += std::exp(scores[c] - maxScore);
+
+    // -log(softmax(x)_t) = log(sum_c exp(x_c - max)) + max - x_t.
+    lossSum += std::log(sum) + maxScore - scores[t];
+  }
+
+  if (reduction)
+    return lossSum;
+
+  return lossSum / target.n_elem;
+}
+
+template<typename MatType>
+void SoftmaxCrossEntropyType<MatType>::Backward(
+    const MatType& prediction,
+    const MatType& target,
+    MatType& loss)
+{
+  using ElemType = typename MatType::elem_type;
+
+  const size_t numClasses = prediction.n_rows;
+  const ElemType scale = reduction ? 1 : (ElemType(1) / target.n_elem);
+  loss.set_size(prediction.n_rows, prediction.n_cols);
+
+  for (size_t i = 0; i < target.n_elem; ++i)
+  {
+    Log::Assert(target(i) >= 0 && target(i) < numClasses,
+        "Target class out of range.");
+  }
+
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < prediction.n_cols; ++i)
+  {
+    const size_t t = (size_t) target(i);
+
+    const ElemType* scores = prediction.colptr(i);
+    ElemType* gradient = loss.colptr(i);
+    ElemType maxScore = scores[0];
+    for (size_t c = 1; c < numClasses; ++c)
+      maxScore = std::max(maxScore, scores[c]);
+
+    ElemType sum = 0;
+    for (size_t c = 0; c < numClasses; ++c)
+    {
+      gradient[c] = std::exp(scores[c] - maxScore);
+      sum += gradient[c];
+    }
+
+    // The gradient is softmax(x) - e_t.
+    const ElemType factor = scale / sum;
+    for (size_t c = 0; c < numClasses; ++c)
+      gradient[c] *= factor;
+    gradient[t] -= scale;
+  }
+}
+
+template<typename MatType>
+template<typename Archive>
+void SoftmaxCrossEntropyType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(reduction));
+}
+
+} // namespace mlpack
+
+#endif
@@ -15,6 +15,7 @@
 #include <mlpack/core.hpp>
 
 #include "ffn.hpp"
+#include "rnn_state.hpp"
 
 namespace mlpack {
 
@@ -160,6 +161,32 @@ class RNN
       arma::Cube<typename MatType::elem_type> responses,
       CallbackTypes&&... callbacks);
 
+  /**
+   * Train the recurrent network on the batches of sequences of the given
+   * BatchPrefetcher, which assembles (and optionally shuffles and transforms)
+   * the next batch in the background while the current one is used.  For each
+   * epoch, the optimizer is run on each batch in turn, starting from the
+   * current parameters; this is only useful with stochastic optimizers whose
+   * MaxIterations() is roughly the prefetcher batch size.  The prefetcher is
+   * reset at the start of each epoch.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param prefetcher Prefetcher of the batches of predictors and responses.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param epochs Number of passes over the whole dataset.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The sum of the final objectives for each batch in the last epoch.
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  typename MatType::elem_type Train(
+      data::BatchPrefetcher<arma::Cube<typename MatType::elem_type>>&
+          prefetcher,
+      OptimizerType& optimizer,
+      const size_t epochs = 1,
+      CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
@@ -173,6 +200,90 @@ class RNN
                arma::Cube<typename MatType::elem_type>& results,
                const size_t batchSize = 128);
 
+  /**
+   * Initialize `context` for the const `Predict()` overload below: it gets a
+   * copy of the layers of the network (in test mode), with their own recurrent
+   * state, that uses the weights of the network.  The network must have been
+   * trained, or its weights set with `Reset()`.  See InferenceContext for when
+   * a context must be initialized again.
+   *
+   * @param context Context to initialize.
+   */
+  void InitContext(InferenceContext<MatType>& context);
+
+  /**
+   * Predict the responses to a given set of predictors, like `Predict()`
+   * above, but writing only into the given context (and `results`).  The
+   * network is not modified (and the stream of `PredictStep()` is not reset),
+   * so many threads can call this at the same time, each with its own
+   * context.
+   *
+   * A std::invalid_argument is thrown if `context` was not initialized with
+   * `InitContext()` for this network.
+   *
+   * @param context Context initialized with `InitContext()`.
+   * @param predictors Input predictors.
+   * @param results Matrix to put output predictions of responses into.
+   * @param batchSize Batch size to use for prediction.
+   */
+  void Predict(InferenceContext<MatType>& context,
+               const arma::Cube<typename MatType::elem_type>& predictors,
+               arma::Cube<typename MatType::elem_type>& results,
+               const size_t batchSize = 128) const;
+
+  /**
+   * Predict the response to one time step of a stream of sequences, continuing
+   * from the state left by the previous call.  Each column of `input` holds the
+   * next time step of one sequence, so the number of columns must stay the same
+   * for the whole stream.  Unlike `Predict()`, earlier steps are never run
+   * again and only the state of the last step is kept, so arbitrarily long
+   * sequences can be scored online in constant memory.
+   *
+   * Call `ResetStream()` to start new sequences.  Note that `Train()`,
+   * `Predict()` and `Evaluate()` also reset the stream, since they use the same
+   * recurrent state.
+   *
+   * @param input Next time step of each sequence.
+   * @param output Matrix to put the output of the network for this time step
+   *     into.
+   */
+  void PredictStep(const MatType& input, MatType& output);
+
+  //! Start new sequences for `PredictStep()`: the next call will be the first
+  //! time step.
+  void ResetStream() { streamStep = 0; }
+  //! Get the number of time steps processed by `PredictStep()` since the
+  //! stream was started.
+  size_t StreamStep() const { return streamStep; }
+
+  /**
+   * Initialize `state` to hold the recurrent state of `numSessions` new
+   * sessions for `Step()`.  The network must have been trained, or its weights
+   * set with `Reset()`, so that the sizes of its layers are known.
+   *
+   * @param state State to initialize.
+   * @param numSessions Number of sessions to hold.
+   */
+  void InitState(RNNState<MatType>& state, const size_t numSessions);
+
+  /**
+   * Advance every session of `state` by one time step: compute the output of
+   * the network for the next time step of each session (one column of `input`
+   * per session), starting from and then updating the recurrent state held by
+   * `state`.  The cost of a call does not depend on the number of steps taken
+   * before, and many states can be served with the same network.
+   *
+   * A std::invalid_argument is thrown if the number of columns of `input` is
+   * not the number of sessions of `state`, or if `state` was not initialized
+   * for this network.
+   *
+   * @param input Next time step of each session.
+   * @param state Recurrent state of the sessions.
+   * @param output Matrix to put the output of the network for this time step
+   *     into.
+   */
+  void Step(const MatType& input, RNNState<MatType>& state, MatType& output);
+
   // Return the nujmber of weights in the model.
   size_t WeightSize() { return network.WeightSize(); }
 
@@ -207,6 +318,21 @@ class RNN
   //! Modify the number of steps allowed for BPTT.
   size_t& BPTTSteps() { return bpttSteps; }
 
+  /**
+   * Get whether chunked truncated BPTT is used for training.  By default
+   * (`false`), the gradient of the output at each time step is backpropagated
+   * through the `BPTTSteps()` steps before it, so the cost of a pass over a
+   * sequence of length T is O(T * BPTTSteps()).  If `true`, each sequence is
+   * instead split into consecutive chunks of `BPTTSteps()` steps: the hidden
+   * state is carried from one chunk to the next, but each chunk is
+   * backpropagated only once, from its last step to its first, so that the
+   * cost is O(T) and only `BPTTSteps()` steps are kept in memory.  This is the
+   * method of choice for very long sequences.
+   */
+  bool ChunkedBPTT() const { return chunkedBPTT; }
+  //! Modify whether chunked truncated BPTT is used for training.
+  bool& ChunkedBPTT() { return chunkedBPTT; }
+
   /**
    * Reset the stored data of the network entirely.  This reset all weights of
    * each layer using `InitializationRuleType`, and prepares the network to
@@ -354,11 +480,35 @@ class RNN
   //! Set the current step index of all recurrent layers to `step`.
   void SetCurrentStep(const size_t step, const bool end);
 
+  //! Reset the states of the recurrent layers of `layers` (see
+  //! `ResetMemoryState()`).
+  static void ClearRecurrentStates(MultiLayer<MatType>& layers,
+                                   const size_t memorySize,
+                                   const size_t batchSize);
+
+  //! Set the current step index of the recurrent layers of `layers` to
+  //! `step`.
+  static void SetCurrentStep(MultiLayer<MatType>& layers,
+                             const size_t step,
+                             const bool end);
+
+  /**
+   * Compute the objective and gradient for a batch of sequences with chunked
+   * truncated BPTT (see `ChunkedBPTT()`).
+   */
+  template<typename GradType>
+  typename MatType::elem_type ChunkedEvaluateWithGradient(
+      const size_t begin,
+      GradType& gradient,
+      const size_t batchSize);
+
   //! Number of timesteps to consider for backpropagation through time (BPTT).
   size_t bpttSteps;
   //! Whether the network expects only one single response per sequence, or one
   //! response per time step.
   bool single;
+  //! Whether sequences are trained in chunks of `bpttSteps` steps.
+  bool chunkedBPTT;
 
   //! The network itself is stored in this FFN object.  Note that this network
   //! may contain recursive layers, and thus we will be responsible for
@@ -373,6 +523,12 @@ class RNN
   //! The matrix of responses to the input data points.  This member is empty,
   //! except during training.
   arma::Cube<typename MatType::elem_type> responses;
+
+  //! The number of time steps processed by PredictStep() in the current
+  //! stream.
+  size_t streamStep;
+  //! The number of sequences of the current stream.
+  size_t streamBatchSize;
 }; // class RNNType
 
 } // namespace mlpack
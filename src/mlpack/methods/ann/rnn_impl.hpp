@@ -34,7 +34,10 @@ RNN<
     InitializationRuleType initializeRule) :
     bpttSteps(bpttSteps),
     single(single),
-    network(std::move(outputLayer), std::move(initializeRule))
+    chunkedBPTT(false),
+    network(std::move(outputLayer), std::move(initializeRule)),
+    streamStep(0),
+    streamBatchSize(0)
 {
   /* Nothing to do here */
 }
@@ -52,7 +55,10 @@ RNN<
     const RNN& network) :
     bpttSteps(network.bpttSteps),
     single(network.single),
-    network(network.network)
+    chunkedBPTT(network.chunkedBPTT),
+    network(network.network),
+    streamStep(0),
+    streamBatchSize(0)
 {
   // Nothing else to do.
 }
@@ -70,7 +76,10 @@ RNN<
     RNN&& network) :
     bpttSteps(std::move(network.bpttSteps)),
     single(std::move(network.single)),
-    network(std::move(network.network))
+    chunkedBPTT(std::move(network.chunkedBPTT)),
+    network(std::move(network.network)),
+    streamStep(0),
+    streamBatchSize(0)
 {
   // Nothing to do here.
 }
@@ -95,9 +104,11 @@ RNN<
   {
     bpttSteps = other.bpttSteps;
     single = other.single;
+    chunkedBPTT = other.chunkedBPTT;
     network = other.network;
     predictors.clear();
     responses.clear();
+    streamStep = 0;
   }
 
   return *this;
@@ -123,9 +134,11 @@ RNN<
   {
     bpttSteps = std::move(other.bpttSteps);
     single = std::move(other.single);
+    chunkedBPTT = std::move(other.chunkedBPTT);
     network = std::move(other.network);
     predictors.clear();
     responses.clear();
+    streamStep = 0;
   }
 
   return *this;
@@ -199,6 +212,40 @@ typename MatType::elem_type RNN<
       callbacks...);
 }
 
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+template<typename OptimizerType, typename... CallbackTypes>
+typename MatType::elem_type RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Train(
+    data::BatchPrefetcher<arma::Cube<typename MatType::elem_type>>& prefetcher,
+    OptimizerType& optimizer,
+    const size_t epochs,
+    CallbackTypes&&... callbacks)
+{
+  using ElemType = typename MatType::elem_type;
+
+  ElemType out = 0;
+  arma::Cube<ElemType> predictorsBatch, responsesBatch;
+  for (size_t e = 0; e < epochs; ++e)
+  {
+    out = 0;
+    prefetcher.Reset();
+    while (prefetcher.Next(predictorsBatch, responsesBatch))
+    {
+      out += Train(std::move(predictorsBatch), std::move(responsesBatch),
+          optimizer, callbacks...);
+    }
+  }
+
+  return out;
+}
+
 template<
     typename OutputLayerType,
     typename InitializationRuleType,
@@ -246,6 +293,210 @@ void RNN<
   }
 }
 
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::InitContext(InferenceContext<MatType>& context)
+{
+  if (network.Parameters().is_empty())
+  {
+    throw std::invalid_argument("RNN::InitContext(): the network must be "
+        "trained, or its weights set with Reset(), before a context can be "
+        "created!");
+  }
+
+  // Make sure the layers know their sizes.
+  network.CheckNetwork("RNN::InitContext()", 0, true, false);
+  network.FillContext(context);
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Predict(
+    InferenceContext<MatType>& context,
+    const arma::Cube<typename MatType::elem_type>& predictors,
+    arma::Cube<typename MatType::elem_type>& results,
+    const size_t batchSize) const
+{
+  network.CheckContext("RNN::Predict()", context, predictors.n_rows);
+
+  results.set_size(context.network.OutputSize(), predictors.n_cols,
+      single ? 1 : predictors.n_slices);
+
+  // This is the same as Predict() above, on the layers of the context.
+  MatType inputAlias, outputAlias;
+  for (size_t i = 0; i < predictors.n_cols; i += batchSize)
+  {
+    const size_t effectiveBatchSize = std::min(batchSize,
+        size_t(predictors.n_cols) - i);
+
+    ClearRecurrentStates(context.network, 0, effectiveBatchSize);
+
+    for (size_t t = 0; t < predictors.n_slices; ++t)
+    {
+      SetCurrentStep(context.network, t, (t == predictors.n_slices - 1));
+
+      MakeAlias(inputAlias, predictors.slice(t), predictors.n_rows,
+          effectiveBatchSize, i * predictors.n_rows);
+      MakeAlias(outputAlias, results.slice(single ? 0 : t), results.n_rows,
+          effectiveBatchSize, i * results.n_rows);
+
+      context.network.Forward(inputAlias, outputAlias);
+    }
+  }
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::PredictStep(const MatType& input, MatType& output)
+{
+  if (streamStep == 0)
+  {
+    // Ensure that the network is configured correctly.
+    network.CheckNetwork("RNN::PredictStep()", input.n_rows, true, false);
+
+    // As in Predict(), only the state of the last step is needed.
+    ResetMemoryState(0, input.n_cols);
+    streamBatchSize = input.n_cols;
+  }
+  else if (input.n_cols != streamBatchSize)
+  {
+    std::ostringstream oss;
+    oss << "RNN::PredictStep(): the stream holds " << streamBatchSize
+        << " sequences, but the input has " << input.n_cols << " columns!  "
+        << "Call ResetStream() to start new sequences.";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The stream has no known end, so every step stores its state.
+  SetCurrentStep(streamStep, false);
+  output.set_size(network.network.OutputSize(), input.n_cols);
+  network.Forward(input, output);
+  ++streamStep;
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::InitState(RNNState<MatType>& state, const size_t numSessions)
+{
+  if (network.Parameters().is_empty())
+  {
+    throw std::invalid_argument("RNN::InitState(): the network must be "
+        "trained, or its weights set with Reset(), before sessions can be "
+        "started!");
+  }
+
+  // Make sure the layers know their sizes.
+  network.CheckNetwork("RNN::InitState()", 0, true, false);
+
+  // One time step of zero state for each recurrent layer.
+  state.layerStates.clear();
+  for (Layer<MatType>* l : network.Network())
+  {
+    RecurrentLayer<MatType>* r =
+        dynamic_cast<RecurrentLayer<MatType>*>(l);
+    if (r != nullptr)
+    {
+      state.layerStates.emplace_back(r->RecurrentSize(), numSessions, 1,
+          arma::fill::zeros);
+    }
+  }
+
+  state.numSessions = numSessions;
+  state.steps = 0;
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Step(const MatType& input, RNNState<MatType>& state, MatType& output)
+{
+  if (input.n_cols != state.numSessions)
+  {
+    std::ostringstream oss;
+    oss << "RNN::Step(): the state holds " << state.numSessions << " sessions, "
+        << "but the input has " << input.n_cols << " columns!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Ensure that the network is configured correctly.
+  network.CheckNetwork("RNN::Step()", input.n_rows, true, false);
+
+  // Gather the recurrent layers, and check that the state matches them.
+  std::vector<RecurrentLayer<MatType>*> recurrentLayers;
+  for (Layer<MatType>* l : network.Network())
+  {
+    RecurrentLayer<MatType>* r =
+        dynamic_cast<RecurrentLayer<MatType>*>(l);
+    if (r != nullptr)
+    {
+      const size_t i = recurrentLayers.size();
+      if (i >= state.layerStates.size() ||
+          state.layerStates[i].n_rows != r->RecurrentSize())
+      {
+        throw std::invalid_argument("RNN::Step(): the given state was not "
+            "initialized for this network; use InitState()!");
+      }
+
+      recurrentLayers.push_back(r);
+    }
+  }
+
+  if (recurrentLayers.size() != state.layerStates.size())
+  {
+    throw std::invalid_argument("RNN::Step(): the given state was not "
+        "initialized for this network; use InitState()!");
+  }
+
+  // Run the layers on the state of the sessions.  The state holds only one
+  // time step, so, as in Predict(), each step overwrites the previous one.
+  for (size_t i = 0; i < recurrentLayers.size(); ++i)
+    recurrentLayers[i]->SwapRecurrentState(state.layerStates[i]);
+
+  SetCurrentStep(state.steps, false);
+  output.set_size(network.network.OutputSize(), input.n_cols);
+  network.Forward(input, output);
+
+  // Give the state back, and restore the memory the layers had before.
+  for (size_t i = 0; i < recurrentLayers.size(); ++i)
+    recurrentLayers[i]->SwapRecurrentState(state.layerStates[i]);
+
+  ++state.steps;
+}
+
 template<
     typename OutputLayerType,
     typename InitializationRuleType,
@@ -390,6 +641,9 @@ typename MatType::elem_type RNN<
 {
   network.CheckNetwork("RNN::EvaluateWithGradient()", predictors.n_rows);
 
+  if (chunkedBPTT)
+    return ChunkedEvaluateWithGradient(begin, gradient, batchSize);
+
   typename MatType::elem_type loss = 0;
 
   // We must save anywhere between 1 and `bpttSteps` states, but we are limited
@@ -491,6 +745,98 @@ typename MatType::elem_type RNN<
   return loss;
 }
 
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+template<typename GradType>
+typename MatType::elem_type RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::ChunkedEvaluateWithGradient(
+    const size_t begin,
+    GradType& gradient,
+    const size_t batchSize)
+{
+  typename MatType::elem_type loss = network.network.Loss();
+
+  const size_t chunkSize = std::max(size_t(1),
+      std::min(bpttSteps, size_t(predictors.n_slices)));
+
+  // Keep one more step than the chunk size, so that the state of the last step
+  // of the previous chunk (which the chunk starts from) is not overwritten.
+  ResetMemoryState(chunkSize + 1, batchSize);
+
+  MatType stepData, responseData, error, networkDelta;
+  MatType output(network.network.OutputSize(), batchSize);
+  gradient.zeros(network.Parameters().n_rows, network.Parameters().n_cols);
+  GradType currentGradient(gradient.n_rows, gradient.n_cols);
+
+  for (size_t chunkBegin = 0; chunkBegin < predictors.n_slices;
+       chunkBegin += chunkSize)
+  {
+    const size_t chunkEnd = std::min(chunkBegin + chunkSize,
+        size_t(predictors.n_slices)) - 1;
+
+    // In single mode, only the chunk holding the last step has an error; the
+    // other chunks only carry the state forward.
+    const bool hasError = !single || (chunkEnd == predictors.n_slices - 1);
+
+    // Forward pass through the chunk, starting from the state of the previous
+    // chunk.  The last step is computed by the backward sweep below.
+    const size_t forwardEnd = hasError ? chunkEnd : chunkEnd + 1;
+    for (size_t t = chunkBegin; t < forwardEnd; ++t)
+    {
+      SetCurrentStep(t, false);
+      MakeAlias(stepData, predictors.slice(t), predictors.n_rows, batchSize,
+          begin * predictors.slice(t).n_rows);
+      network.network.Forward(stepData, output);
+    }
+
+    if (!hasError)
+      continue;
+
+    // Backpropagate once through the chunk, from its last step to its first.
+    // The incoming gradient is not carried into the previous chunk.
+    for (size_t t = chunkEnd + 1; t-- > chunkBegin; )
+    {
+      // The non-recurrent layers only hold the activations of their last
+      // forward pass, so the forward pass of this step is run again; the
+      // recurrent state of the step is recomputed with the same values.
+      SetCurrentStep(t, false);
+      MakeAlias(stepData, predictors.slice(t), predictors.n_rows, batchSize,
+          begin * predictors.slice(t).n_rows);
+      network.network.Forward(stepData, output);
+
+      SetCurrentStep(t, (t == chunkEnd));
+      if (!single || t == predictors.n_slices - 1)
+      {
+        const size_t responseStep = (single) ? 0 : t;
+        MakeAlias(responseData, responses.slice(responseStep),
+            responses.n_rows, batchSize,
+            begin * responses.slice(responseStep).n_rows);
+
+        loss += network.outputLayer.Forward(output, responseData);
+        network.outputLayer.Backward(output, responseData, error);
+      }
+      else
+      {
+        // Only the recurrent terms contribute to the gradient of this step.
+        error.zeros(output.n_rows, output.n_cols);
+      }
+
+      currentGradient.zeros();
+      network.network.Backward(stepData, output, error, networkDelta);
+      network.network.Gradient(stepData, error, currentGradient);
+      gradient += currentGradient;
+    }
+  }
+
+  return loss;
+}
+
 template<
     typename OutputLayerType,
     typename InitializationRuleType,
@@ -551,9 +897,28 @@ void RNN<
     InitializationRuleType,
     MatType
 >::ResetMemoryState(const size_t memorySize, const size_t batchSize)
+{
+  // Any stream of PredictStep() calls is interrupted.
+  streamStep = 0;
+
+  ClearRecurrentStates(network.network, memorySize, batchSize);
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::ClearRecurrentStates(MultiLayer<MatType>& layers,
+                        const size_t memorySize,
+                        const size_t batchSize)
 {
   // Iterate over all layers and set the memory size.
-  for (Layer<MatType>* l : network.Network())
+  for (Layer<MatType>* l : layers.Network())
   {
     // We can only call ClearRecurrentState() on RecurrentLayers.
     RecurrentLayer<MatType>* r =
@@ -573,9 +938,25 @@ void RNN<
     InitializationRuleType,
     MatType
 >::SetCurrentStep(const size_t step, const bool end)
+{
+  SetCurrentStep(network.network, step, end);
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::SetCurrentStep(MultiLayer<MatType>& layers,
+                  const size_t step,
+                  const bool end)
 {
   // Iterate over all layers and set the memory size.
-  for (Layer<MatType>* l : network.Network())
+  for (Layer<MatType>* l : layers.Network())
   {
     // We can only call CurrentStep() on RecurrentLayers.
     RecurrentLayer<MatType>* r =
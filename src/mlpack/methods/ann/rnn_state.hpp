@@ -0,0 +1,90 @@
+/**
+ * @file methods/ann/rnn_state.hpp
+ *
+ * Definition of the RNNState class, which holds the recurrent state of a set of
+ * sequences (sessions) between calls to RNN::Step().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_RNN_STATE_HPP
+#define MLPACK_METHODS_ANN_RNN_STATE_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * An RNNState holds the recurrent state of every recurrent layer of an RNN for
+ * a batch of sessions (sequences that are being processed one time step at a
+ * time), so that an RNN can serve many independent sets of sessions: each call
+ * to `RNN::Step()` advances all the sessions of one state by one time step, in
+ * one forward pass, and does not depend on the length of their history.
+ *
+ * An RNNState is created for a given network by `RNN::InitState()`, and can
+ * only be used with that network (or a copy of it).  All the sessions of a
+ * state advance together; to serve sessions that arrive at different times,
+ * use one state per group of sessions.
+ *
+ * @code
+ * RNN<> rnn;
+ * // ... build and train the network ...
+ *
+ * RNNState<> state;
+ * rnn.InitState(state, 16); // 16 sessions.
+ * arma::mat input(inputSize, 16), output;
+ * for (...)
+ * {
+ *   // ... fill the next time step of each session into `input` ...
+ *   rnn.Step(input, state, output);
+ * }
+ * @endcode
+ *
+ * @tparam MatType Type of matrix used by the network.
+ */
+template<typename MatType = arma::mat>
+class RNNState
+{
+ public:
+  //! The type used to hold the state of a recurrent layer.
+  using CubeType = arma::Cube<typename MatType::elem_type>;
+
+  //! Create an empty state; use `RNN::InitState()` to initialize it.
+  RNNState() : numSessions(0), steps(0) { }
+
+  //! Get the number of sessions held by the state.
+  size_t NumSessions() const { return numSessions; }
+  //! Get the number of time steps the sessions have been advanced by.
+  size_t Steps() const { return steps; }
+
+  //! Get the state of each recurrent layer of the network, in the order of the
+  //! layers (RecurrentSize() x NumSessions() x 1 each).
+  const std::vector<CubeType>& LayerStates() const { return layerStates; }
+
+  //! Serialize the state.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(numSessions));
+    ar(CEREAL_NVP(steps));
+    ar(CEREAL_NVP(layerStates));
+  }
+
+ private:
+  // The RNN class sets and advances the state.
+  template<typename, typename, typename>
+  friend class RNN;
+
+  //! The number of sessions.
+  size_t numSessions;
+  //! The number of time steps processed so far.
+  size_t steps;
+  //! The recurrent state of each recurrent layer.
+  std::vector<CubeType> layerStates;
+};
+
+} // namespace mlpack
+
+#endif
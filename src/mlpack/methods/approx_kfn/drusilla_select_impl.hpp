@@ -17,6 +17,7 @@
 
 #include <queue>
 #include <mlpack/methods/neighbor_search/neighbor_search_rules.hpp>
+#include <mlpack/methods/neighbor_search/blocked_brute_force.hpp>
 #include <mlpack/methods/neighbor_search/sort_policies/furthest_neighbor_sort.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include <algorithm>
@@ -177,19 +178,32 @@ void DrusillaSelect<MatType>::Search(const MatType& querySet,
     throw std::invalid_argument("DrusillaSelect::Search(): requested k is "
         "greater than number of points in candidate set!  Increase l or m.");
 
-  // We'll use the NeighborSearchRules class to perform our brute-force search.
-  // Note that we aren't using trees for our search, so we can use 'int' as a
-  // TreeType.
   EuclideanDistance metric;
-  NeighborSearchRules<FurthestNeighborSort, EuclideanDistance,
-      KDTree<EuclideanDistance, EmptyStatistic, MatType>>
-      rules(candidateSet, querySet, k, metric, 0, false);
-
-  for (size_t q = 0; q < querySet.n_cols; ++q)
-    for (size_t r = 0; r < candidateSet.n_cols; ++r)
-      rules.BaseCase(q, r);
-
-  rules.GetResults(neighbors, distances);
+  if constexpr (UseBlockedBruteForce<EuclideanDistance, MatType>::value)
+  {
+    // The candidate set is small, so a brute-force search is all we need; it
+    // is done in parallel over blocks of queries, with matrix
+    // multiplications.
+    arma::Mat<typename MatType::elem_type> candidateDistances;
+    BlockedBruteForceSearch<FurthestNeighborSort>(querySet, candidateSet, k,
+        metric, false, std::vector<bool>(), neighbors, candidateDistances);
+    distances = arma::conv_to<arma::mat>::from(candidateDistances);
+  }
+  else
+  {
+    // We'll use the NeighborSearchRules class to perform our brute-force
+    // search.  Note that we aren't using trees for our search, so the TreeType
+    // is never used.
+    NeighborSearchRules<FurthestNeighborSort, EuclideanDistance,
+        KDTree<EuclideanDistance, EmptyStatistic, MatType>>
+        rules(candidateSet, querySet, k, metric, 0, false);
+
+    for (size_t q = 0; q < querySet.n_cols; ++q)
+      for (size_t r = 0; r < candidateSet.n_cols; ++r)
+        rules.BaseCase(q, r);
+
+    rules.GetResults(neighbors, distances);
+  }
 
   // Map the neighbors back to their original indices in the reference set.
   for (size_t i = 0; i < neighbors.n_elem; ++i)
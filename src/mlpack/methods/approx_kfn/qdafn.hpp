@@ -70,7 +70,8 @@ class QDAFN
    * Search for the k furthest neighbors of the given query set.  (The query set
    * can contain just one point, that is okay.)  The results will be stored in
    * the given neighbors and distances matrices, in the same format as the
-   * mlpack NeighborSearch and LSHSearch classes.
+   * mlpack NeighborSearch and LSHSearch classes.  All the query points are
+   * projected onto the random lines at once, and then searched in parallel.
    */
   void Search(const MatType& querySet,
               const size_t k,
@@ -82,12 +83,19 @@ class QDAFN
   void serialize(Archive& ar, const uint32_t /* version */);
 
   //! Get the number of projections.
-  size_t NumProjections() const { return candidateSet.size(); }
+  size_t NumProjections() const { return l; }
 
-  //! Get the candidate set for the given projection table.
-  const MatType& CandidateSet(const size_t t) const { return candidateSet[t]; }
-  //! Modify the candidate set for the given projection table.  Careful!
-  MatType& CandidateSet(const size_t t) { return candidateSet[t]; }
+  //! Get (a copy of) the candidate set for the given projection table.
+  MatType CandidateSet(const size_t t) const
+  {
+    return candidateSet.cols(t * m, (t + 1) * m - 1);
+  }
+
+  //! Get the candidate sets of all the projection tables; table t is stored in
+  //! columns [t * m, (t + 1) * m).
+  const MatType& CandidateSets() const { return candidateSet; }
+  //! Modify the candidate sets of all the projection tables.  Careful!
+  MatType& CandidateSets() { return candidateSet; }
 
  private:
   //! The number of projections.
@@ -96,20 +104,22 @@ class QDAFN
   size_t m;
   //! The random lines we are projecting onto.  Has l columns.
   arma::mat lines;
-  //! Projections of each point onto each random line.
-  arma::mat projections;
 
   //! Indices of the points for each S.
   arma::Mat<size_t> sIndices;
   //! Values of a_i * x for each point in S.
   arma::mat sValues;
 
-  // Candidate sets; one element in the vector for each table.
-  std::vector<MatType> candidateSet;
+  //! Candidate sets of all the tables, stored contiguously: the candidates of
+  //! table t are columns [t * m, (t + 1) * m).
+  MatType candidateSet;
 };
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename MatType),
+    (mlpack::QDAFN<MatType>), (1));
+
 // Include implementation.
 #include "qdafn_impl.hpp"
 
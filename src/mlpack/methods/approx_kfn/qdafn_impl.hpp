@@ -67,15 +67,14 @@ void QDAFN<MatType>::Train(const MatType& referenceSet,
 
   // Now, project each of the reference points onto each line, and collect the
   // top m elements.
-  projections = referenceSet.t() * lines;
+  const arma::mat projections = referenceSet.t() * lines;
 
   // Loop over each projection and find the top m elements.
   sIndices.set_size(m, l);
   sValues.set_size(m, l);
-  candidateSet.resize(l);
+  candidateSet.set_size(referenceSet.n_rows, l * m);
   for (size_t i = 0; i < l; ++i)
   {
-    candidateSet[i].set_size(referenceSet.n_rows, m);
     arma::uvec sortedIndices = arma::sort_index(projections.col(i), "descend");
 
     // Grab the top m elements.
@@ -83,7 +82,7 @@ void QDAFN<MatType>::Train(const MatType& referenceSet,
     {
       sIndices(j, i) = sortedIndices[j];
       sValues(j, i) = projections(sortedIndices[j], i);
-      candidateSet[i].col(j) = referenceSet.col(sortedIndices[j]);
+      candidateSet.col(i * m + j) = referenceSet.col(sortedIndices[j]);
     }
   }
 }
@@ -103,7 +102,12 @@ void QDAFN<MatType>::Search(const MatType& querySet,
   neighbors.fill(size_t() - 1);
   distances.zeros(k, querySet.n_cols);
 
+  // Project all the query points onto all the lines at once; column q holds
+  // l_i * query for each line.
+  const arma::mat queryProjections = lines.t() * querySet;
+
   // Search for each point.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t q = 0; q < querySet.n_cols; ++q)
   {
     // Initialize a priority queue.
@@ -112,8 +116,7 @@ void QDAFN<MatType>::Search(const MatType& querySet,
     std::priority_queue<std::pair<double, size_t>> queue;
     for (size_t i = 0; i < l; ++i)
     {
-      const double val = sValues(0, i) - dot(querySet.col(q),
-          lines.col(i));
+      const double val = sValues(0, i) - queryProjections(i, q);
       queue.push(std::make_pair(val, i));
     }
 
@@ -128,7 +131,7 @@ void QDAFN<MatType>::Search(const MatType& querySet,
         resultsQueue(std::less<std::pair<double, size_t>>(), std::move(v));
     for (size_t i = 0; i < m; ++i)
     {
-      std::pair<size_t, double> p = queue.top();
+      const std::pair<double, size_t> p = queue.top();
       queue.pop();
 
       // Get index of reference point to look at.
@@ -136,7 +139,7 @@ void QDAFN<MatType>::Search(const MatType& querySet,
 
       // Calculate distance from query point.
       const double dist = EuclideanDistance::Evaluate(querySet.col(q),
-          candidateSet[p.second].col(tableIndex));
+          candidateSet.col(p.second * m + tableIndex));
 
       resultsQueue.push(std::make_pair(dist, sIndices(tableIndex, p.second)));
 
@@ -170,8 +173,8 @@ void QDAFN<MatType>::Search(const MatType& querySet,
       // Avoid inserting any duplicates.
       if (neighbors(extracted - 1, q) != result.second)
       {
-        neighbors(extracted, q) = resultsQueue.top().second;
-        distances(extracted, q) = resultsQueue.top().first;
+        neighbors(extracted, q) = result.second;
+        distances(extracted, q) = result.first;
         ++extracted;
       }
     }
@@ -180,17 +183,35 @@ void QDAFN<MatType>::Search(const MatType& querySet,
 
 template<typename MatType>
 template<typename Archive>
-void QDAFN<MatType>::serialize(Archive& ar, const uint32_t /* version */)
+void QDAFN<MatType>::serialize(Archive& ar, const uint32_t version)
 {
   ar(CEREAL_NVP(l));
   ar(CEREAL_NVP(m));
   ar(CEREAL_NVP(lines));
-  ar(CEREAL_NVP(projections));
+  if (version == 0)
+  {
+    // Older models also store the projections of the reference set, which are
+    // not needed for search.
+    arma::mat projections;
+    ar(CEREAL_NVP(projections));
+  }
   ar(CEREAL_NVP(sIndices));
   ar(CEREAL_NVP(sValues));
-  if (cereal::is_loading<Archive>())
-    candidateSet.clear();
-  ar(CEREAL_NVP(candidateSet));
+  if (version > 0)
+  {
+    ar(CEREAL_NVP(candidateSet));
+  }
+  else
+  {
+    // Older models store each candidate set in its own matrix; convert them to
+    // the contiguous layout.
+    std::vector<MatType> candidateSets;
+    ar(cereal::make_nvp("candidateSet", candidateSets));
+
+    candidateSet.set_size(lines.n_rows, l * m);
+    for (size_t t = 0; t < candidateSets.size(); ++t)
+      candidateSet.cols(t * m, (t + 1) * m - 1) = candidateSets[t];
+  }
 }
 
 } // namespace mlpack
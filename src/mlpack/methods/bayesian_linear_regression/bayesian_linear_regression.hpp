@@ -16,6 +16,7 @@
 #define MLPACK_METHODS_BAYESIAN_LINEAR_REGRESSION_HPP
 
 #include <mlpack/core.hpp>
+#include <mlpack/methods/linear_regression/linear_regression_statistics.hpp>
 
 namespace mlpack {
 
@@ -194,6 +195,31 @@ class BayesianLinearRegression
                  const size_t maxIterations,
                  const double tolerance);
 
+  /**
+   * Run BayesianLinearRegression on the sufficient statistics of a dataset
+   * (see LinearRegressionStatistics), which can be accumulated one batch at a
+   * time.  The settings given to the constructor (or set with CenterData(),
+   * ScaleData(), MaxIterations() and Tolerance()) are used.  The result is the
+   * same as training on the whole dataset at once, up to rounding errors.
+   *
+   * @param stats Sufficient statistics of the dataset.
+   * @return Root mean squared error.
+   */
+  ElemType Train(const LinearRegressionStatistics<ModelMatType>& stats);
+
+  /**
+   * Run BayesianLinearRegression on a dataset read from disk in chunks, with a
+   * single pass over the data.  The settings given to the constructor are
+   * used.
+   *
+   * @param data Source of the input data.
+   * @param responses Source of the targets; each point must be a single
+   *     value.
+   * @return Root mean squared error.
+   */
+  ElemType Train(data::ChunkedSource<ElemType>& data,
+                 data::ChunkedSource<ElemType>& responses);
+
   /**
    * Predict \f$y\f$ for a single data point \f$x\f$ using the currently-trained
    * Bayesian ridge regression model.
@@ -383,6 +409,24 @@ class BayesianLinearRegression
   //! Covariance matrix of the solution vector omega.
   ModelMatType matCovariance;
 
+  /**
+   * Run the evidence maximization on the given (centered and scaled)
+   * statistics phi phi^T and phi t^T, computing omega, alpha, beta, gamma and
+   * matCovariance.  residual(w) must return ||t - w^T phi||^2.
+   *
+   * @param phiPhiT Product of the processed data with itself, dim(P, P).
+   * @param phiT Product of the processed data with the targets, dim(P).
+   * @param tVariance Variance of the processed targets.
+   * @param n Number of points.
+   * @param residual Function computing the squared residual of a solution.
+   */
+  template<typename ResidualFunction>
+  void Fit(const ModelMatType& phiPhiT,
+           const DenseVecType& phiT,
+           const ElemType tVariance,
+           const ElemType n,
+           ResidualFunction&& residual);
+
   /**
    * Center and scale the data accordind to centerData and scaleData.
    * Allows future modifications of new points.
@@ -103,13 +103,117 @@ BayesianLinearRegression<ModelMatType>::Train(
 
   ModelMatType phi;
   DenseRowType t;
-  DenseVecType eigVal;
-  ModelMatType eigVec;
 
   // Preprocess the data. Center and scale.
   responsesOffset = CenterScaleData(data, responses, phi, t);
 
-  if (!arma::eig_sym(eigVal, eigVec, arma::symmatu(phi * phi.t())))
+  Fit(phi * phi.t(), phi * t.t(), (ElemType) var(t, 1),
+      (ElemType) data.n_cols,
+      [&](const DenseVecType& w)
+      {
+        const DenseRowType temp = t - w.t() * phi;
+        return (ElemType) dot(temp, temp);
+      });
+
+  return RMSE(data, responses);
+}
+
+template<typename ModelMatType>
+inline
+typename BayesianLinearRegression<ModelMatType>::ElemType
+BayesianLinearRegression<ModelMatType>::Train(
+    const LinearRegressionStatistics<ModelMatType>& stats)
+{
+  if (stats.NumPoints() < 2)
+  {
+    throw std::invalid_argument("BayesianLinearRegression::Train(): at least "
+        "two points are needed!");
+  }
+
+  const ElemType n = stats.TotalWeight();
+  const DenseVecType mean = stats.MeanPredictors();
+
+  // phi phi^T, phi t^T and t t^T are the moments of the data about the
+  // offsets, divided by the scales.
+  ModelMatType phiPhiT;
+  DenseVecType x, phiT;
+  ElemType sumT, tt;
+  stats.Moments(mean, stats.MeanResponses(), phiPhiT, x, phiT, sumT, tt);
+
+  if (scaleData)
+  {
+    // This is stddev(data, 0, 1).
+    dataScale = sqrt(phiPhiT.diag() / (n - 1));
+  }
+
+  if (centerData)
+  {
+    dataOffset = mean;
+    responsesOffset = stats.MeanResponses();
+  }
+  else
+  {
+    responsesOffset = 0;
+    stats.Moments(DenseVecType(mean.n_elem, arma::fill::zeros), 0, phiPhiT, x,
+        phiT, sumT, tt);
+  }
+
+  if (scaleData)
+  {
+    phiPhiT.each_col() /= dataScale;
+    phiPhiT.each_row() /= dataScale.t();
+    phiT /= dataScale;
+  }
+
+  // ||t - w^T phi||^2 = t t^T - 2 w^T phi t^T + w^T phi phi^T w.
+  auto residual = [&](const DenseVecType& w)
+  {
+    const ElemType sse = tt - 2 * dot(w, phiT) + dot(w, phiPhiT * w);
+    return std::max(sse, (ElemType) 0);
+  };
+
+  Fit(phiPhiT, phiT, tt / n - (sumT / n) * (sumT / n), n, residual);
+
+  return std::sqrt(residual(omega) / n);
+}
+
+template<typename ModelMatType>
+inline
+typename BayesianLinearRegression<ModelMatType>::ElemType
+BayesianLinearRegression<ModelMatType>::Train(
+    data::ChunkedSource<ElemType>& data,
+    data::ChunkedSource<ElemType>& responses)
+{
+  LinearRegressionStatistics<ModelMatType> stats;
+  data::ForEachChunk(data, responses,
+      [&](const arma::Mat<ElemType>& dataChunk,
+          const arma::Mat<ElemType>& responsesChunk)
+      {
+        if (responsesChunk.n_rows != 1)
+        {
+          throw std::invalid_argument("BayesianLinearRegression::Train(): "
+              "responses must have one dimension!");
+        }
+
+        stats.Accumulate(dataChunk, responsesChunk);
+      });
+
+  return Train(stats);
+}
+
+template<typename ModelMatType>
+template<typename ResidualFunction>
+inline void BayesianLinearRegression<ModelMatType>::Fit(
+    const ModelMatType& phiPhiT,
+    const DenseVecType& phiT,
+    const ElemType tVariance,
+    const ElemType n,
+    ResidualFunction&& residual)
+{
+  DenseVecType eigVal;
+  ModelMatType eigVec;
+
+  if (!arma::eig_sym(eigVal, eigVec, arma::symmatu(phiPhiT)))
   {
     Log::Fatal << "BayesianLinearRegression::Train(): Eigendecomposition "
                << "of covariance failed!" << std::endl;
@@ -117,11 +221,11 @@ BayesianLinearRegression<ModelMatType>::Train(
 
   // Compute this quantities once and for all.
   const ModelMatType eigVecInv = inv(eigVec);
-  const DenseVecType eigVecInvPhitT = eigVecInv * phi * t.t();
+  const DenseVecType eigVecInvPhitT = eigVecInv * phiT;
 
   // Initialize the hyperparameters and begin with an infinitely broad prior.
   alpha = ((ElemType) 1e-6);
-  beta = ((ElemType) 1 / (var(t, 1) * 0.1));
+  beta = ((ElemType) 1 / (tVariance * 0.1));
 
   unsigned short i = 0;
   ElemType crit = ((ElemType) 1.0);
@@ -139,8 +243,7 @@ BayesianLinearRegression<ModelMatType>::Train(
     alpha = gamma / dot(omega, omega);
 
     // Update beta.
-    const DenseRowType temp = t - omega.t() * phi;
-    beta = (data.n_cols - gamma) / dot(temp, temp);
+    beta = (n - gamma) / residual(omega);
 
     // Compute the stopping criterion.
     deltaAlpha += alpha;
@@ -151,8 +254,6 @@ BayesianLinearRegression<ModelMatType>::Train(
   // Compute the covariance matrix for the uncertainties later.
   matCovariance = eigVec * diagmat(((ElemType) 1) / (beta * eigVal + alpha)) *
       eigVecInv;
-
-  return RMSE(data, responses);
 }
 
 template<typename ModelMatType>
@@ -100,6 +100,25 @@ class BiasSVDFunction
                 GradType& gradient,
                 const size_t batchSize = 1) const;
 
+  /**
+   * Take a stochastic gradient step for the given rating, in place.  Only the
+   * columns of the user and the item of the rating are written, so ratings
+   * that share no user and no item can be updated concurrently.  This is used
+   * by StratifiedSGD.
+   *
+   * @param parameters Parameters(user/item matrices/bias) of the decomposition.
+   * @param i Index of the rating.
+   * @param stepSize Step size of the update.
+   */
+  void Update(arma::mat& parameters,
+              const size_t i,
+              const double stepSize) const;
+
+  //! Nothing to do at the end of a stratum of StratifiedSGD, since Update()
+  //! applies the whole step.
+  void FinishStratum(arma::mat& /* parameters */,
+                     const double /* stepSize */) const { }
+
   //! Return the initial point for the optimization.
   const MatType& GetInitialPoint() const { return initialPoint; }
 
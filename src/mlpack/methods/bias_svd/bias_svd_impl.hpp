@@ -35,20 +35,29 @@ void BiasSVD<OptimizerType, MatType, VecType>::Apply(const MatType& data,
                                                      VecType& p,
                                                      VecType& q)
 {
-  // batchSize is 1 in our implementation of Bias SVD.
-  // batchSize other than 1 has not been supported yet.
-  const int batchSize = 1;
-  Log::Warn << "The batch size for optimizing BiasSVD is 1."
-      << std::endl;
-
-  // Make the optimizer object using a BiasSVDFunction object.
+  // Make the BiasSVDFunction object to optimize.
   BiasSVDFunction<arma::mat> biasSVDFunc(data, rank, lambda);
-  ens::StandardSGD optimizer(alpha, batchSize,
-      iterations * data.n_cols);
 
   // Get optimized parameters.
   MatType parameters = biasSVDFunc.GetInitialPoint();
-  optimizer.Optimize(biasSVDFunc, parameters);
+  if constexpr (std::is_same_v<OptimizerType, StratifiedSGD>)
+  {
+    // Each of the iterations is an epoch over all the ratings.
+    StratifiedSGD optimizer(alpha, iterations);
+    optimizer.Optimize(biasSVDFunc, parameters);
+  }
+  else
+  {
+    // batchSize is 1 in our implementation of Bias SVD.
+    // batchSize other than 1 has not been supported yet.
+    const int batchSize = 1;
+    Log::Warn << "The batch size for optimizing BiasSVD is 1."
+        << std::endl;
+
+    ens::StandardSGD optimizer(alpha, batchSize,
+        iterations * data.n_cols);
+    optimizer.Optimize(biasSVDFunc, parameters);
+  }
 
   // Constants for extracting user and item matrices.
   const size_t numUsers = max(data.row(0)) + 1;
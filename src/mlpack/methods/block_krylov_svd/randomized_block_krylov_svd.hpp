@@ -105,6 +105,63 @@ class RandomizedBlockKrylovSVD
              MatType& v,
              const size_t rank);
 
+  /**
+   * Apply Principal Component Analysis to the provided data set, centered on
+   * the given mean, using the randomized block krylov SVD.  The centered data
+   * (data - rowMean * 1^T) is never formed: it is only applied to blocks of
+   * vectors, so a sparse data matrix stays sparse.
+   *
+   * @param data Data matrix (dense or sparse).
+   * @param u First unitary matrix.
+   * @param v Second unitary matrix.
+   * @param s Diagonal matrix of singular values.
+   * @param rank Rank of the approximation.
+   * @param rowMean Mean to center the data on (a column vector).
+   */
+  template<typename InMatType,
+           typename MatType,
+           typename VecType,
+           typename MeanType>
+  void Apply(const InMatType& data,
+             MatType& u,
+             VecType& s,
+             MatType& v,
+             const size_t rank,
+             const MeanType& rowMean);
+
+  /**
+   * Apply Principal Component Analysis to a dataset that is read from disk in
+   * chunks, using the randomized block krylov SVD.  As for the other
+   * overloads, the data is not centered.  The Krylov subspace is built on the
+   * side of the dimensions, so only the current chunk, the d x (BlockSize() *
+   * (MaxIterations() + 1)) Krylov matrix and the n x BlockSize() *
+   * (MaxIterations() + 1) matrix v are held in memory (for d-dimensional data
+   * with n points).
+   *
+   * The data is read MaxIterations() + 3 times: once for the first block of
+   * the Krylov subspace (the data applied to a random matrix, generated one
+   * chunk at a time), once for each of the other blocks, once for the
+   * tall-skinny QR decomposition of the projection of the data on the
+   * subspace (see TallSkinnyQR), and once to compute v.  Each pass only sums
+   * the contributions of the chunks, so the chunks could be processed
+   * independently (e.g. by different processes).
+   *
+   * A std::invalid_argument is thrown if the rank is 0 or greater than the
+   * dimensionality or the number of points of the dataset.
+   *
+   * @param source Source of the data.
+   * @param u First unitary matrix.
+   * @param v Second unitary matrix.
+   * @param s Diagonal matrix of singular values.
+   * @param rank Rank of the approximation.
+   */
+  template<typename eT, typename MatType, typename VecType>
+  void Apply(data::ChunkedSource<eT>& source,
+             MatType& u,
+             VecType& s,
+             MatType& v,
+             const size_t rank);
+
   //! Get the number of iterations for the power method.
   size_t MaxIterations() const { return maxIterations; }
   //! Modify the number of iterations for the power method.
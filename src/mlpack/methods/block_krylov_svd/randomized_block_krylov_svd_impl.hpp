@@ -54,7 +54,23 @@ inline void RandomizedBlockKrylovSVD::Apply(const InMatType& data,
                                             MatType& v,
                                             const size_t rank)
 {
-  MatType Q, R, block, blockIteration;
+  // Subtracting a zero mean does not change any of the products.
+  const MatType rowMean(data.n_rows, 1, arma::fill::zeros);
+  Apply(data, u, s, v, rank, rowMean);
+}
+
+template<typename InMatType,
+         typename MatType,
+         typename VecType,
+         typename MeanType>
+inline void RandomizedBlockKrylovSVD::Apply(const InMatType& data,
+                                            MatType& u,
+                                            VecType& s,
+                                            MatType& v,
+                                            const size_t rank,
+                                            const MeanType& rowMean)
+{
+  MatType Q, R, block, blockIteration, dataTBlock;
 
   if (blockSize == 0)
   {
@@ -71,9 +87,11 @@ inline void RandomizedBlockKrylovSVD::Apply(const InMatType& data,
   MatType K(data.n_rows, blockSize * (maxIterations + 1));
 
   // Create a working matrix using data from writable auxiliary memory
-  // (K matrix). Doing so avoids an unnecessary copy in upcoming step.
+  // (K matrix). Doing so avoids an unnecessary copy in upcoming step.  The
+  // centered data (data - rowMean * 1^T) is applied to G as
+  // data * G - rowMean * (1^T G).
   MakeAlias(block, K, data.n_rows, blockSize, false);
-  arma::qr_econ(block, R, data * G);
+  arma::qr_econ(block, R, data * G - rowMean * arma::sum(G, 0));
 
   for (size_t blockOffset = block.n_elem; blockOffset < K.n_elem;
       blockOffset += block.n_elem)
@@ -82,7 +100,10 @@ inline void RandomizedBlockKrylovSVD::Apply(const InMatType& data,
     MakeAlias(blockIteration, K, block.n_rows, block.n_cols, blockOffset,
         false);
 
-    arma::qr_econ(blockIteration, R, data * (data.t() * block));
+    dataTBlock = data.t() * block;
+    dataTBlock.each_row() -= rowMean.t() * block;
+    arma::qr_econ(blockIteration, R, data * dataTBlock -
+        rowMean * arma::sum(dataTBlock, 0));
 
     // Update working matrix for the next iteration.
     MakeAlias(block, K, block.n_rows, block.n_cols, blockOffset,
@@ -92,7 +113,9 @@ inline void RandomizedBlockKrylovSVD::Apply(const InMatType& data,
   arma::qr_econ(Q, R, K);
 
   // Approximate eigenvalues and eigenvectors using Rayleigh-Ritz method.
-  arma::svd_econ(u, s, v, Q.t() * data);
+  MatType qData = Q.t() * data;
+  qData.each_col() -= Q.t() * rowMean;
+  arma::svd_econ(u, s, v, qData);
 
   // Do economical singular value decomposition and compute only the
   // approximations of the left singular vectors by using the centered data
@@ -100,6 +123,105 @@ inline void RandomizedBlockKrylovSVD::Apply(const InMatType& data,
   u = Q * u;
 }
 
+template<typename eT, typename MatType, typename VecType>
+inline void RandomizedBlockKrylovSVD::Apply(data::ChunkedSource<eT>& source,
+                                            MatType& u,
+                                            VecType& s,
+                                            MatType& v,
+                                            const size_t rank)
+{
+  const size_t d = source.Dimensionality();
+  const size_t n = source.NumPoints();
+  if (rank == 0 || rank > std::min(d, n))
+  {
+    std::ostringstream oss;
+    oss << "RandomizedBlockKrylovSVD::Apply(): the rank (" << rank << ") must "
+        << "be positive and at most the dimensionality (" << d << ") and the "
+        << "number of points (" << n << ") of the dataset";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (blockSize == 0)
+  {
+    // The block size cannot be greater than the number of points in the
+    // dataset or the dimensionality of the dataset.
+    blockSize = std::min(d, std::min(n, rank + 10));
+  }
+
+  // Call f(chunk, offset) for every chunk of the data; `offset` is the index
+  // of the first point of the chunk.
+  arma::Mat<eT> chunk;
+  auto forEachChunk = [&](auto&& f)
+  {
+    source.Reset();
+    size_t offset = 0;
+    while (source.Next(chunk))
+    {
+      f(chunk, offset);
+      offset += chunk.n_cols;
+    }
+  };
+
+  MatType Q, R, block, blockIteration, G;
+  MatType K(d, blockSize * (maxIterations + 1));
+
+  // The first block is the data applied to a random n x blockSize matrix,
+  // whose rows are generated with the chunks.
+  MakeAlias(block, K, d, blockSize, false);
+  MatType product(d, blockSize, arma::fill::zeros);
+  forEachChunk([&](const arma::Mat<eT>& c, const size_t /* offset */)
+  {
+    G.randn(c.n_cols, blockSize);
+    product += c * G;
+  });
+  arma::qr_econ(block, R, product);
+
+  // Each of the other blocks takes a single pass over the data, since
+  // X X^T B is the sum of X_i (X_i^T B) over the chunks X_i.
+  for (size_t blockOffset = block.n_elem; blockOffset < K.n_elem;
+      blockOffset += block.n_elem)
+  {
+    MakeAlias(blockIteration, K, block.n_rows, block.n_cols, blockOffset,
+        false);
+
+    product.zeros();
+    forEachChunk([&](const arma::Mat<eT>& c, const size_t /* offset */)
+    {
+      product += c * (c.t() * block);
+    });
+    arma::qr_econ(blockIteration, R, product);
+
+    MakeAlias(block, K, block.n_rows, block.n_cols, blockOffset, false);
+  }
+
+  arma::qr_econ(Q, R, K);
+
+  // Rayleigh-Ritz: the tall and skinny matrix X^T Q = Q_2 R is never formed,
+  // only its R factor.  With R = A S B^T, Q^T X = B S (Q_2 A)^T, so the left
+  // singular vectors are Q B, and the right singular vectors are X^T Q B S^-1.
+  TallSkinnyQR<MatType> tsqr(Q.n_cols);
+  forEachChunk([&](const arma::Mat<eT>& c, const size_t /* offset */)
+  {
+    tsqr.Add(c.t() * Q);
+  });
+
+  MatType a, b;
+  arma::svd(a, s, b, tsqr.R());
+  const size_t r = std::min((size_t) s.n_elem, (size_t) b.n_cols);
+  u = Q * b.cols(0, r - 1);
+
+  v.set_size(n, r);
+  forEachChunk([&](const arma::Mat<eT>& c, const size_t offset)
+  {
+    v.rows(offset, offset + c.n_cols - 1) = c.t() * u;
+  });
+  for (size_t i = 0; i < r; ++i)
+  {
+    if (s[i] > 0)
+      v.col(i) /= s[i];
+  }
+}
+
 } // namespace mlpack
 
 #endif
@@ -20,6 +20,7 @@
 
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/methods/amf/amf.hpp>
+#include <mlpack/methods/fastmks/fastmks.hpp>
 
 #include "normalization/normalization.hpp"
 #include "decomposition_policies/decomposition_policies.hpp"
@@ -140,6 +141,47 @@ class CFType
              const double minResidue = 1e-5,
              const bool mit = false);
 
+  /**
+   * Add new users to the model without retraining it ("fold-in").  The item
+   * matrix W is kept fixed, and the factors of each new user u are the
+   * solution of the regularized least-squares problem
+   *
+   *   min_h sum_{i rated by u} (r_ui - W.row(i) * h)^2 + lambda ||h||^2,
+   *
+   * which only costs O(n_u * rank^2 + rank^3) for a user with n_u ratings.
+   * The new users get the indices CleanedData().n_cols, ..., and can then be
+   * used with all the other methods.  The neighborhoods of GetRecommendations()
+   * and Predict() are searched again at each call, so they include the new
+   * users.  The ratings are normalized with the existing statistics of the
+   * normalization (and the means of the new users, for UserMeanNormalization).
+   *
+   * With ImplicitALSPolicy, the confidence-weighted problem of the policy is
+   * solved instead, with its own alpha and lambda.  This cannot be used with
+   * BiasSVDPolicy or SVDPlusPlusPolicy, whose ratings are not W * H.
+   *
+   * @param ratings Ratings of the new users: a sparse matrix with one row per
+   *     item and one column per new user, like the data of Train().
+   * @param lambda Regularization parameter of the least-squares problems.
+   * @return Index of the first new user.
+   */
+  size_t AddUsers(const arma::sp_mat& ratings, const double lambda = 0.01);
+
+  /**
+   * Add new items to the model without retraining it ("fold-in").  This is
+   * the same as AddUsers(), with the user matrix H kept fixed: the factors of
+   * each new item i are the solution of
+   *
+   *   min_w sum_{u who rated i} (r_ui - w * H.col(u))^2 + lambda ||w||^2.
+   *
+   * The new items get the indices CleanedData().n_rows, ....
+   *
+   * @param ratings Ratings of the new items: a sparse matrix with one row per
+   *     new item and one column per user.
+   * @param lambda Regularization parameter of the least-squares problems.
+   * @return Index of the first new item.
+   */
+  size_t AddItems(const arma::sp_mat& ratings, const double lambda = 0.01);
+
   //! Sets number of users for calculating similarity.
   void NumUsersForSimilarity(const size_t num)
   {
@@ -179,6 +221,12 @@ class CFType
   //! Get the normalization object.
   const NormalizationType& Normalization() const { return normalization; }
 
+  /**
+   * Return the memory used by the model: the factor matrices W and H of the
+   * decomposition, and the cleaned (sparse) rating data.
+   */
+  MemoryReport MemoryUsage() const;
+
   /**
    * Generates the given number of recommendations for all users.
    *
@@ -213,6 +261,50 @@ class CFType
                           arma::Mat<size_t>& recommendations,
                           const arma::Col<size_t>& users);
 
+  /**
+   * Generates the given number of recommendations for all users, ranking the
+   * items by the rating predicted for each user itself (that is, without
+   * interpolating the ratings of its neighborhood).  See the other overload of
+   * GetDirectRecommendations().
+   *
+   * @param numRecs Number of Recommendations.
+   * @param recommendations Matrix to save recommendations into.
+   * @param useFastMKS If true, search the items with FastMKS instead of
+   *     scoring all of them.
+   */
+  void GetDirectRecommendations(const size_t numRecs,
+                                arma::Mat<size_t>& recommendations,
+                                const bool useFastMKS = false) const;
+
+  /**
+   * Generates the given number of recommendations for the specified users,
+   * ranking the items by the rating predicted for each user itself (that is,
+   * without interpolating the ratings of its neighborhood).  The predicted
+   * rating of item i for user u is W.row(i) * H.col(u), so this can only be
+   * used with decompositions that predict ratings that way (all of them but
+   * BiasSVDPolicy and SVDPlusPlusPolicy).
+   *
+   * By default, the users are processed in blocks: the ratings of all items
+   * for a block of users are computed with a single matrix product, and then
+   * the best items of each user are selected with a bounded heap, in parallel.
+   * If useFastMKS is true, the best items are instead found with maximum
+   * inner product search over the item factors (with FastMKS and the linear
+   * kernel), which is sublinear in the number of items for each user.  In
+   * that case, the items are ranked by their normalized rating, so the results
+   * are only the same as the default search if the normalization does not
+   * depend on the item (e.g. not for ItemMeanNormalization).
+   *
+   * @param numRecs Number of Recommendations.
+   * @param recommendations Matrix to save recommendations.
+   * @param users Users for which recommendations are to be generated.
+   * @param useFastMKS If true, search the items with FastMKS instead of
+   *     scoring all of them.
+   */
+  void GetDirectRecommendations(const size_t numRecs,
+                                arma::Mat<size_t>& recommendations,
+                                const arma::Col<size_t>& users,
+                                const bool useFastMKS = false) const;
+
   //! Converts the User, Item, Value Matrix to User-Item Table.
   static void CleanData(const arma::mat& data, arma::sp_mat& cleanedData);
 
@@ -271,16 +363,35 @@ class CFType
   //! Data normalization object.
   NormalizationType normalization;
 
+  /**
+   * Compute the factors of new users (or items) for AddUsers() and AddItems(),
+   * given the fixed factors of the items (or users).  Column j of data holds
+   * the normalized ratings of target j for each column of fixed.
+   *
+   * @param data Normalized ratings of the targets.
+   * @param fixed Fixed factors (one column per item or user).
+   * @param target Matrix to store the factors of the targets in.
+   * @param lambda Regularization parameter.
+   */
+  void FoldIn(const arma::sp_mat& data,
+              const arma::mat& fixed,
+              arma::mat& target,
+              const double lambda) const;
+
   //! Candidate represents a possible recommendation (value, item).
   using Candidate = std::pair<double, size_t>;
 
   //! Compare two candidates based on the value.
   struct CandidateCmp {
-    bool operator()(const Candidate& c1, const Candidate& c2)
+    bool operator()(const Candidate& c1, const Candidate& c2) const
     {
       return c1.first > c2.first;
     };
   };
+
+  //! Maximum number of ratings computed at once by
+  //! GetDirectRecommendations().
+  static constexpr size_t blockRatings = 1 << 22;
 }; // class CFType
 
 using CF = CFType<>;
@@ -149,6 +149,133 @@ Train(const arma::sp_mat& data,
       data, cleanedData, rank, maxIterations, minResidue, mit);
 }
 
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+size_t CFType<DecompositionPolicy,
+              NormalizationType>::
+AddUsers(const arma::sp_mat& ratings, const double lambda)
+{
+  static_assert(!std::is_same_v<DecompositionPolicy, BiasSVDPolicy> &&
+      !std::is_same_v<DecompositionPolicy, SVDPlusPlusPolicy>,
+      "AddUsers() cannot be used with BiasSVDPolicy or SVDPlusPlusPolicy, "
+      "since their ratings are not W * H.");
+
+  if (ratings.n_rows != cleanedData.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "CFType::AddUsers(): the ratings have " << ratings.n_rows
+        << " rows, but the model has " << cleanedData.n_rows << " items!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  arma::sp_mat normalizedRatings(ratings);
+  normalization.NormalizeNewUsers(normalizedRatings);
+
+  arma::mat newH;
+  FoldIn(normalizedRatings, decomposition.W().t(), newH, lambda);
+
+  const size_t firstUser = cleanedData.n_cols;
+  decomposition.H().insert_cols(firstUser, newH);
+  cleanedData = arma::join_rows(cleanedData, normalizedRatings);
+
+  return firstUser;
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+size_t CFType<DecompositionPolicy,
+              NormalizationType>::
+AddItems(const arma::sp_mat& ratings, const double lambda)
+{
+  static_assert(!std::is_same_v<DecompositionPolicy, BiasSVDPolicy> &&
+      !std::is_same_v<DecompositionPolicy, SVDPlusPlusPolicy>,
+      "AddItems() cannot be used with BiasSVDPolicy or SVDPlusPlusPolicy, "
+      "since their ratings are not W * H.");
+
+  if (ratings.n_cols != cleanedData.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "CFType::AddItems(): the ratings have " << ratings.n_cols
+        << " columns, but the model has " << cleanedData.n_cols << " users!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  arma::sp_mat normalizedRatings(ratings);
+  normalization.NormalizeNewItems(normalizedRatings);
+
+  // The targets of FoldIn() are the columns of the data.
+  arma::mat newW;
+  FoldIn(normalizedRatings.t(), decomposition.H(), newW, lambda);
+
+  const size_t firstItem = cleanedData.n_rows;
+  decomposition.W().insert_rows(firstItem, newW.t());
+  cleanedData = arma::join_cols(cleanedData, normalizedRatings);
+
+  return firstItem;
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+FoldIn(const arma::sp_mat& data,
+       const arma::mat& fixed,
+       arma::mat& target,
+       const double lambda) const
+{
+  constexpr bool implicit =
+      std::is_same_v<DecompositionPolicy, ImplicitALSPolicy>;
+
+  const size_t rank = fixed.n_rows;
+  target.zeros(rank, data.n_cols);
+
+  // For implicit feedback, every entry is an observation (of preference 0 for
+  // the entries that are not in the data) so the Gram matrix of all the fixed
+  // factors is part of each problem.
+  arma::mat base(rank, rank, arma::fill::zeros);
+  double alpha = 0.0;
+  double regularization = lambda;
+  if constexpr (implicit)
+  {
+    base = fixed * fixed.t();
+    alpha = decomposition.Alpha();
+    regularization = decomposition.Lambda();
+  }
+  base.diag() += regularization;
+
+  data.sync();
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t j = 0; j < (size_t) data.n_cols; ++j)
+  {
+    // A target without observations keeps zero factors.
+    if (!implicit && data.col_ptrs[j] == data.col_ptrs[j + 1])
+      continue;
+
+    arma::mat a(base);
+    arma::vec b(rank, arma::fill::zeros);
+    for (auto it = data.begin_col(j); it != data.end_col(j); ++it)
+    {
+      const arma::vec f(fixed.colptr(it.row()), rank);
+      if constexpr (implicit)
+      {
+        const double confidence = 1.0 + alpha * (*it);
+        a += (confidence - 1.0) * f * f.t();
+        b += confidence * f;
+      }
+      else
+      {
+        a += f * f.t();
+        b += (*it) * f;
+      }
+    }
+
+    arma::vec x;
+    if (arma::solve(x, a, b, arma::solve_opts::likely_sympd))
+      target.col(j) = x;
+  }
+}
+
 template<typename DecompositionPolicy,
          typename NormalizationType>
 template<typename NeighborSearchPolicy,
@@ -268,6 +395,145 @@ GetRecommendations(const size_t numRecs,
   }
 }
 
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GetDirectRecommendations(const size_t numRecs,
+                         arma::Mat<size_t>& recommendations,
+                         const bool useFastMKS) const
+{
+  arma::Col<size_t> users = arma::linspace<arma::Col<size_t> >(0,
+      cleanedData.n_cols - 1, cleanedData.n_cols);
+
+  GetDirectRecommendations(numRecs, recommendations, users, useFastMKS);
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GetDirectRecommendations(const size_t numRecs,
+                         arma::Mat<size_t>& recommendations,
+                         const arma::Col<size_t>& users,
+                         const bool useFastMKS) const
+{
+  static_assert(!std::is_same_v<DecompositionPolicy, BiasSVDPolicy> &&
+      !std::is_same_v<DecompositionPolicy, SVDPlusPlusPolicy>,
+      "GetDirectRecommendations() cannot be used with BiasSVDPolicy or "
+      "SVDPlusPlusPolicy, since their ratings are not W * H.");
+
+  const arma::mat& w = decomposition.W();
+  const arma::mat& h = decomposition.H();
+  const size_t numItems = cleanedData.n_rows;
+  const size_t invalidItem = cleanedData.n_rows;
+
+  recommendations.set_size(numRecs, users.n_elem);
+  recommendations.fill(invalidItem);
+  cleanedData.sync();
+
+  if (!useFastMKS)
+  {
+    // Score as many users at once as fit in the block.
+    const size_t blockSize = std::max((size_t) 1, std::min(
+        (size_t) users.n_elem, blockRatings / std::max(numItems, (size_t) 1)));
+
+    arma::mat ratings;
+    for (size_t begin = 0; begin < users.n_elem; begin += blockSize)
+    {
+      const size_t end = std::min(begin + blockSize, (size_t) users.n_elem);
+      ratings = w * h.cols(arma::conv_to<arma::uvec>::from(
+          users.subvec(begin, end - 1)));
+
+      #pragma omp parallel for schedule(static)
+      for (size_t i = begin; i < end; ++i)
+      {
+        const size_t user = users[i];
+
+        // Keep the best numRecs candidates in a heap whose top is the worst of
+        // them.  The items that the user rated are skipped; they are sorted,
+        // like the items we look through.
+        const Candidate def = std::make_pair(-DBL_MAX, invalidItem);
+        std::vector<Candidate> vect(numRecs, def);
+        using CandidateList = std::priority_queue<Candidate,
+            std::vector<Candidate>, CandidateCmp>;
+        CandidateList pqueue(CandidateCmp(), std::move(vect));
+
+        size_t k = cleanedData.col_ptrs[user];
+        const size_t kEnd = cleanedData.col_ptrs[user + 1];
+        const double* userRatings = ratings.colptr(i - begin);
+        for (size_t j = 0; j < numItems; ++j)
+        {
+          if (k < kEnd && cleanedData.row_indices[k] == j)
+          {
+            ++k;
+            continue; // The user already rated the item.
+          }
+
+          // Denormalize rating before comparison.
+          const double realRating = normalization.Denormalize(user, j,
+              userRatings[j]);
+          if (realRating > pqueue.top().first)
+          {
+            pqueue.pop();
+            pqueue.push(std::make_pair(realRating, j));
+          }
+        }
+
+        for (size_t p = 1; p <= numRecs; p++)
+        {
+          recommendations(numRecs - p, i) = pqueue.top().second;
+          pqueue.pop();
+        }
+      }
+    }
+  }
+  else
+  {
+    // Search enough items that numRecs are left for each user after removing
+    // the items it already rated.
+    size_t maxRated = 0;
+    for (size_t i = 0; i < users.n_elem; ++i)
+    {
+      maxRated = std::max(maxRated, (size_t) (cleanedData.col_ptrs[users[i] +
+          1] - cleanedData.col_ptrs[users[i]]));
+    }
+    const size_t k = std::min(numRecs + maxRated, numItems);
+
+    // The items are the reference points, as columns.
+    FastMKS<LinearKernel> fastmks(arma::mat(w.t()));
+    const arma::mat queries = h.cols(arma::conv_to<arma::uvec>::from(users));
+    arma::Mat<size_t> indices;
+    arma::mat kernels;
+    fastmks.Search(queries, k, indices, kernels);
+
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < users.n_elem; ++i)
+    {
+      // The results are sorted by decreasing rating.
+      size_t count = 0;
+      for (size_t j = 0; j < k && count < numRecs; ++j)
+      {
+        const size_t item = indices(j, i);
+        if (item == SIZE_MAX || cleanedData(item, users[i]) != 0.0)
+          continue;
+
+        recommendations(count++, i) = item;
+      }
+    }
+  }
+
+  // If we were not able to come up with enough recommendations, issue a
+  // warning.
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    if (numRecs > 0 && recommendations(numRecs - 1, i) == invalidItem)
+      Log::Warn << "Could not provide " << numRecs << " recommendations "
+          << "for user " << users(i) << " (not enough un-rated items)!"
+          << std::endl;
+  }
+}
+
 // Predict the rating for a single user/item combination.
 template<typename DecompositionPolicy,
          typename NormalizationType>
@@ -416,6 +682,18 @@ CleanData(const arma::mat& data, arma::sp_mat& cleanedData)
   cleanedData = arma::sp_mat(locations, values, maxItemID, maxUserID);
 }
 
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+MemoryReport CFType<DecompositionPolicy,
+                    NormalizationType>::MemoryUsage() const
+{
+  MemoryReport report;
+  report.Add("W", MemoryOf(decomposition.W()));
+  report.Add("H", MemoryOf(decomposition.H()));
+  report.Add("cleaned data", MemoryOf(cleanedData));
+  return report;
+}
+
 //! Serialize the model.
 template<typename DecompositionPolicy,
          typename NormalizationType>
@@ -334,6 +334,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     cf = std::move(params.Get<CFModel*>("input_model"));
   }
 
+  Log::Info << "Memory used by the model:" << endl << cf->MemoryUsage().Print();
+
   // Get the types of the neighbor search method and the interpolation.  (These
   // may or may not be used.)
   NeighborSearchTypes nsType;
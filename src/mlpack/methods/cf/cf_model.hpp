@@ -77,6 +77,17 @@ class CFWrapperBase
       const size_t numRecs,
       arma::Mat<size_t>& recommendations,
       const arma::Col<size_t>& users) = 0;
+
+  //! Add new users to the model, and return the index of the first one.
+  virtual size_t AddUsers(const arma::sp_mat& ratings,
+                          const double lambda) = 0;
+
+  //! Add new items to the model, and return the index of the first one.
+  virtual size_t AddItems(const arma::sp_mat& ratings,
+                          const double lambda) = 0;
+
+  //! Return the memory used by the model.
+  virtual MemoryReport MemoryUsage() const = 0;
 };
 
 /**
@@ -143,6 +154,15 @@ class CFWrapper : public CFWrapperBase
       arma::Mat<size_t>& recommendations,
       const arma::Col<size_t>& users);
 
+  //! Add new users to the model, and return the index of the first one.
+  virtual size_t AddUsers(const arma::sp_mat& ratings, const double lambda);
+
+  //! Add new items to the model, and return the index of the first one.
+  virtual size_t AddItems(const arma::sp_mat& ratings, const double lambda);
+
+  //! Return the memory used by the model.
+  virtual MemoryReport MemoryUsage() const { return cf.MemoryUsage(); }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
@@ -268,6 +288,37 @@ class CFModel
                           const size_t numRecs,
                           arma::Mat<size_t>& recommendations);
 
+  /**
+   * Add new users to the model without retraining it; see CFType::AddUsers().
+   * A std::invalid_argument is thrown for the BIAS_SVD and SVD_PLUS_PLUS
+   * decompositions.
+   *
+   * @param ratings Ratings of the new users (one row per item, one column per
+   *     new user).
+   * @param lambda Regularization parameter of the least-squares problems.
+   * @return Index of the first new user.
+   */
+  size_t AddUsers(const arma::sp_mat& ratings, const double lambda = 0.01);
+
+  /**
+   * Add new items to the model without retraining it; see CFType::AddItems().
+   * A std::invalid_argument is thrown for the BIAS_SVD and SVD_PLUS_PLUS
+   * decompositions.
+   *
+   * @param ratings Ratings of the new items (one row per new item, one column
+   *     per user).
+   * @param lambda Regularization parameter of the least-squares problems.
+   * @return Index of the first new item.
+   */
+  size_t AddItems(const arma::sp_mat& ratings, const double lambda = 0.01);
+
+  //! Return the memory used by the model (see CFType::MemoryUsage()); the
+  //! report is empty if no model is trained.
+  MemoryReport MemoryUsage() const
+  {
+    return cf ? cf->MemoryUsage() : MemoryReport();
+  }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
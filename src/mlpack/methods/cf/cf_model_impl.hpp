@@ -283,6 +283,40 @@ void CFWrapper<DecompositionPolicy, NormalizationPolicy>::GetRecommendations(
   }
 }
 
+template<typename DecompositionPolicy, typename NormalizationPolicy>
+size_t CFWrapper<DecompositionPolicy, NormalizationPolicy>::AddUsers(
+    const arma::sp_mat& ratings,
+    const double lambda)
+{
+  if constexpr (std::is_same_v<DecompositionPolicy, BiasSVDPolicy> ||
+      std::is_same_v<DecompositionPolicy, SVDPlusPlusPolicy>)
+  {
+    throw std::invalid_argument("CFModel::AddUsers(): new users cannot be "
+        "added to BiasSVD or SVD++ models!");
+  }
+  else
+  {
+    return cf.AddUsers(ratings, lambda);
+  }
+}
+
+template<typename DecompositionPolicy, typename NormalizationPolicy>
+size_t CFWrapper<DecompositionPolicy, NormalizationPolicy>::AddItems(
+    const arma::sp_mat& ratings,
+    const double lambda)
+{
+  if constexpr (std::is_same_v<DecompositionPolicy, BiasSVDPolicy> ||
+      std::is_same_v<DecompositionPolicy, SVDPlusPlusPolicy>)
+  {
+    throw std::invalid_argument("CFModel::AddItems(): new items cannot be "
+        "added to BiasSVD or SVD++ models!");
+  }
+  else
+  {
+    return cf.AddItems(ratings, lambda);
+  }
+}
+
 template<typename DecompositionPolicy>
 CFWrapperBase* InitializeModelHelper(
     CFModel::NormalizationTypes normalizationType)
@@ -501,6 +535,20 @@ inline void CFModel::GetRecommendations(
   cf->GetRecommendations(nsType, interpolationType, numRecs, recommendations);
 }
 
+//! Add new users to the model.
+inline size_t CFModel::AddUsers(const arma::sp_mat& ratings,
+                                const double lambda)
+{
+  return cf->AddUsers(ratings, lambda);
+}
+
+//! Add new items to the model.
+inline size_t CFModel::AddItems(const arma::sp_mat& ratings,
+                                const double lambda)
+{
+  return cf->AddItems(ratings, lambda);
+}
+
 template<typename Archive>
 void CFModel::serialize(Archive& ar, const uint32_t /* version */)
 {
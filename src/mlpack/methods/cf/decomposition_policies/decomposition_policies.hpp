@@ -14,6 +14,7 @@
 
 #include "batch_svd_method.hpp"
 #include "bias_svd_method.hpp"
+#include "implicit_als_method.hpp"
 #include "nmf_method.hpp"
 #include "randomized_svd_method.hpp"
 #include "regularized_svd_method.hpp"
@@ -0,0 +1,325 @@
+/**
+ * @file methods/cf/decomposition_policies/implicit_als_method.hpp
+ *
+ * Implementation of the weighted alternating least squares method for implicit
+ * feedback, for use in Collaborative Filtering.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_IMPLICIT_ALS_METHOD_HPP
+#define MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_IMPLICIT_ALS_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Implementation of the weighted alternating least squares (ALS) method for
+ * implicit feedback to act as a decomposition policy for CFType:
+ *
+ * @code
+ * @inproceedings{hu2008collaborative,
+ *   title={Collaborative filtering for implicit feedback datasets},
+ *   author={Hu, Y. and Koren, Y. and Volinsky, C.},
+ *   booktitle={Proceedings of the 8th IEEE International Conference on Data
+ *       Mining (ICDM 2008)},
+ *   pages={263--272},
+ *   year={2008}
+ * }
+ *
+ * @inproceedings{takacs2011applications,
+ *   title={Applications of the conjugate gradient method for implicit
+ *       feedback collaborative filtering},
+ *   author={Tak{\'a}cs, G. and Pil{\'a}szy, I. and Tikk, D.},
+ *   booktitle={Proceedings of the 5th ACM Conference on Recommender Systems
+ *       (RecSys 2011)},
+ *   pages={297--300},
+ *   year={2011}
+ * }
+ * @endcode
+ *
+ * Each nonzero entry r of the data (for instance, a number of plays or clicks)
+ * is taken as an observed preference of 1 with confidence 1 + alpha * r, and
+ * every other entry as a preference of 0 with confidence 1.  The item matrix W
+ * and the user matrix H then minimize the confidence-weighted squared error of
+ * W H over all entries, plus lambda times the squared norms of W and H.  So
+ * the predicted ratings are preferences, which are meaningful for ranking but
+ * not on the scale of the data; use this with NoNormalization and non-negative
+ * data.
+ *
+ * The minimization alternates between the users and the items.  The
+ * least-squares problem of each user (or item) only depends on its own
+ * interactions and on the Gram matrix of the other factor, which is computed
+ * once per half-iteration, so the problems are solved in parallel (if OpenMP is
+ * available).  Each problem is solved approximately with a few steps of the
+ * conjugate gradient method, warm-started from the previous solution, so that
+ * an iteration costs O(nnz * rank + (users + items) * rank^2).
+ *
+ * An example of how to use ImplicitALSPolicy in CF is shown below:
+ *
+ * @code
+ * extern arma::mat data; // data is a (user, item, count) table.
+ * arma::Mat<size_t> recommendations; // Resulting recommendations.
+ *
+ * CFType<ImplicitALSPolicy> cf(data, ImplicitALSPolicy(), 5, 20, 15);
+ *
+ * // Generate 10 recommendations for all users.
+ * cf.GetRecommendations(10, recommendations);
+ * @endcode
+ */
+class ImplicitALSPolicy
+{
+ public:
+  /**
+   * Use weighted ALS for implicit feedback to perform collaborative filtering.
+   *
+   * @param alpha Scale of the confidence of the observed entries.
+   * @param lambda Regularization parameter.
+   * @param cgIterations Number of conjugate gradient steps for each user and
+   *     item at each iteration.
+   */
+  ImplicitALSPolicy(const double alpha = 40.0,
+                    const double lambda = 0.1,
+                    const size_t cgIterations = 3) :
+      alpha(alpha),
+      lambda(lambda),
+      cgIterations(cgIterations)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Apply Collaborative Filtering to the provided data set using weighted ALS.
+   *
+   * @param * (data) Data matrix: dense matrix (coordinate lists)
+   *    or sparse matrix(cleaned).
+   * @param cleanedData item user table in form of sparse matrix.
+   * @param rank Rank parameter for matrix factorization.
+   * @param maxIterations Maximum number of iterations.
+   * @param minResidue Relative change of the user matrix required to
+   *     terminate.
+   * @param mit Whether to terminate only when maxIterations is reached.
+   */
+  template<typename MatType>
+  void Apply(const MatType& /* data */,
+             const arma::sp_mat& cleanedData,
+             const size_t rank,
+             const size_t maxIterations,
+             const double minResidue,
+             const bool mit)
+  {
+    // The item factors are updated as columns, and transposed at the end.
+    arma::mat wt(rank, cleanedData.n_rows, arma::fill::randn);
+    h.randn(rank, cleanedData.n_cols);
+    wt *= 0.01;
+    h *= 0.01;
+
+    // The users of each item are the columns of the transpose.
+    const arma::sp_mat cleanedDataT = cleanedData.t();
+
+    arma::mat oldH;
+    for (size_t i = 0; i < maxIterations; ++i)
+    {
+      oldH = h;
+      UpdateFactors(cleanedDataT, h, wt);
+      UpdateFactors(cleanedData, wt, h);
+
+      const double residue = arma::norm(h - oldH, "fro") /
+          arma::norm(oldH, "fro");
+      Log::Info << "Iteration " << i + 1 << "; residue " << residue << "."
+          << std::endl;
+      if (!mit && residue < minResidue)
+        break;
+    }
+
+    w = wt.t();
+  }
+
+  /**
+   * Return predicted rating given user ID and item ID.
+   *
+   * @param user User ID.
+   * @param item Item ID.
+   */
+  double GetRating(const size_t user, const size_t item) const
+  {
+    double rating = arma::as_scalar(w.row(item) * h.col(user));
+    return rating;
+  }
+
+  /**
+   * Get predicted ratings for a user.
+   *
+   * @param user User ID.
+   * @param rating Resulting rating vector.
+   */
+  void GetRatingOfUser(const size_t user, arma::vec& rating) const
+  {
+    rating = w * h.col(user);
+  }
+
+  /**
+   * Get the neighborhood and corresponding similarities for a set of users.
+   *
+   * @tparam NeighborSearchPolicy The policy to perform neighbor search.
+   *
+   * @param users Users whose neighborhood is to be computed.
+   * @param numUsersForSimilarity The number of neighbors returned for
+   *     each user.
+   * @param neighborhood Neighbors represented by user IDs.
+   * @param similarities Similarity between each user and each of its
+   *     neighbors.
+   */
+  template<typename NeighborSearchPolicy>
+  void GetNeighborhood(const arma::Col<size_t>& users,
+                       const size_t numUsersForSimilarity,
+                       arma::Mat<size_t>& neighborhood,
+                       arma::mat& similarities) const
+  {
+    // We want to avoid calculating the full rating matrix, so we will do
+    // nearest neighbor search only on the H matrix, using the observation that
+    // if the rating matrix X = W*H, then d(X.col(i), X.col(j)) = d(W H.col(i),
+    // W H.col(j)).  This can be seen as nearest neighbor search on the H
+    // matrix with the Mahalanobis distance where M^{-1} = W^T W.  So, we'll
+    // decompose M^{-1} = L L^T (the Cholesky decomposition), and then multiply
+    // H by L^T. Then we can perform nearest neighbor search.
+    arma::mat l = arma::chol(w.t() * w);
+    arma::mat stretchedH = l * h; // Due to the Armadillo API, l is L^T.
+
+    // Temporarily store feature vector of queried users.
+    arma::mat query(stretchedH.n_rows, users.n_elem);
+    // Select feature vectors of queried users.
+    for (size_t i = 0; i < users.n_elem; ++i)
+      query.col(i) = stretchedH.col(users(i));
+
+    NeighborSearchPolicy neighborSearch(stretchedH);
+    neighborSearch.Search(
+        query, numUsersForSimilarity, neighborhood, similarities);
+  }
+
+  //! Get the Item Matrix.
+  const arma::mat& W() const { return w; }
+  //! Get the User Matrix.
+  const arma::mat& H() const { return h; }
+  //! Modify the Item Matrix.
+  arma::mat& W() { return w; }
+  //! Modify the User Matrix.
+  arma::mat& H() { return h; }
+
+  //! Get the scale of the confidence of the observed entries.
+  double Alpha() const { return alpha; }
+  //! Modify the scale of the confidence of the observed entries.
+  double& Alpha() { return alpha; }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Get the number of conjugate gradient steps per iteration.
+  size_t CGIterations() const { return cgIterations; }
+  //! Modify the number of conjugate gradient steps per iteration.
+  size_t& CGIterations() { return cgIterations; }
+
+  /**
+   * Serialization.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(w));
+    ar(CEREAL_NVP(h));
+  }
+
+ private:
+  /**
+   * Update each column of target, given the fixed factors.  Column j of data
+   * holds the interactions of target j with the columns of fixed.
+   *
+   * For target j with interactions N(j), this approximately solves
+   *
+   *   (F F^T + lambda I + sum_{i in N(j)} (c_ij - 1) f_i f_i^T) x_j =
+   *       sum_{i in N(j)} c_ij f_i
+   *
+   * where F is the fixed matrix, f_i its columns, and c_ij the confidences.
+   */
+  void UpdateFactors(const arma::sp_mat& data,
+                     const arma::mat& fixed,
+                     arma::mat& target) const
+  {
+    const size_t rank = fixed.n_rows;
+    const arma::mat gram = fixed * fixed.t() +
+        lambda * arma::eye<arma::mat>(rank, rank);
+
+    data.sync();
+
+    #pragma omp parallel
+    {
+      // Workspace of the conjugate gradient method.
+      arma::vec r(rank), p(rank), ap(rank);
+
+      // The number of interactions varies a lot from one target to another.
+      #pragma omp for schedule(dynamic, 16)
+      for (size_t j = 0; j < (size_t) data.n_cols; ++j)
+      {
+        const size_t begin = data.col_ptrs[j];
+        const size_t end = data.col_ptrs[j + 1];
+
+        // Compute out = A v, without forming A.
+        auto multiply = [&](const arma::vec& v, arma::vec& out)
+        {
+          out = gram * v;
+          for (size_t k = begin; k < end; ++k)
+          {
+            const double c = alpha * std::max(data.values[k], 0.0);
+            const auto f = fixed.unsafe_col(data.row_indices[k]);
+            out += (c * arma::dot(f, v)) * f;
+          }
+        };
+
+        arma::vec x(target.colptr(j), rank, false, true);
+
+        // The residual of the previous solution is the starting direction.
+        multiply(x, ap);
+        r = -ap;
+        for (size_t k = begin; k < end; ++k)
+        {
+          const double c = 1.0 + alpha * std::max(data.values[k], 0.0);
+          r += c * fixed.unsafe_col(data.row_indices[k]);
+        }
+        p = r;
+        double rs = arma::dot(r, r);
+
+        for (size_t it = 0; it < cgIterations && rs > 1e-20; ++it)
+        {
+          multiply(p, ap);
+          const double step = rs / arma::dot(p, ap);
+          x += step * p;
+          r -= step * ap;
+
+          const double newRs = arma::dot(r, r);
+          p = r + (newRs / rs) * p;
+          rs = newRs;
+        }
+      }
+    }
+  }
+
+  //! Scale of the confidence of the observed entries.
+  double alpha;
+  //! Regularization parameter.
+  double lambda;
+  //! Number of conjugate gradient steps per iteration.
+  size_t cgIterations;
+  //! Item matrix.
+  arma::mat w;
+  //! User matrix.
+  arma::mat h;
+};
+
+} // namespace mlpack
+
+#endif
@@ -146,6 +146,10 @@ class NMFPolicy
   const arma::mat& W() const { return w; }
   //! Get the User Matrix.
   const arma::mat& H() const { return h; }
+  //! Modify the Item Matrix.
+  arma::mat& W() { return w; }
+  //! Modify the User Matrix.
+  arma::mat& H() { return h; }
 
   /**
    * Serialization.
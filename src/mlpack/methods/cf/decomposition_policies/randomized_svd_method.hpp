@@ -155,6 +155,10 @@ class RandomizedSVDPolicy
   const arma::mat& W() const { return w; }
   //! Get the User Matrix.
   const arma::mat& H() const { return h; }
+  //! Modify the Item Matrix.
+  arma::mat& W() { return w; }
+  //! Modify the User Matrix.
+  arma::mat& H() { return h; }
 
   //! Get the size of the normalized power iterations.
   size_t IteratedPower() const { return iteratedPower; }
@@ -142,6 +142,10 @@ class RegSVDPolicy
   const arma::mat& W() const { return w; }
   //! Get the User Matrix.
   const arma::mat& H() const { return h; }
+  //! Modify the Item Matrix.
+  arma::mat& W() { return w; }
+  //! Modify the User Matrix.
+  arma::mat& H() { return h; }
 
   //! Get the number of iterations.
   size_t MaxIterations() const { return maxIterations; }
@@ -59,6 +59,30 @@ class CombinedNormalization
     SequenceNormalize<0>(data);
   }
 
+  /**
+   * Normalize the ratings of new users by calling NormalizeNewUsers() in each
+   * normalization object.
+   *
+   * @param ratings Ratings of the new users (one row per item, one column per
+   *     new user).
+   */
+  void NormalizeNewUsers(arma::sp_mat& ratings)
+  {
+    SequenceNormalizeNewUsers<0>(ratings);
+  }
+
+  /**
+   * Normalize the ratings of new items by calling NormalizeNewItems() in each
+   * normalization object.
+   *
+   * @param ratings Ratings of the new items (one row per new item, one column
+   *     per user).
+   */
+  void NormalizeNewItems(arma::sp_mat& ratings)
+  {
+    SequenceNormalizeNewItems<0>(ratings);
+  }
+
   /**
    * Denormalize rating by calling Denormalize() in each normalization object.
    * Note that the order of objects calling Denormalize() should be the
@@ -129,6 +153,40 @@ class CombinedNormalization
       typename = void>
   void SequenceNormalize(MatType& /* data */) { }
 
+  //! Unpack normalizations tuple to normalize the ratings of new users.
+  template<
+      int I, /* Which normalization in tuple to use */
+      typename = std::enable_if_t<(I < std::tuple_size<TupleType>::value)>>
+  void SequenceNormalizeNewUsers(arma::sp_mat& ratings)
+  {
+    std::get<I>(normalizations).NormalizeNewUsers(ratings);
+    SequenceNormalizeNewUsers<I + 1>(ratings);
+  }
+
+  //! End of tuple unpacking.
+  template<
+      int I, /* Which normalization in tuple to use */
+      typename = std::enable_if_t<(I >= std::tuple_size<TupleType>::value)>,
+      typename = void>
+  void SequenceNormalizeNewUsers(arma::sp_mat& /* ratings */) { }
+
+  //! Unpack normalizations tuple to normalize the ratings of new items.
+  template<
+      int I, /* Which normalization in tuple to use */
+      typename = std::enable_if_t<(I < std::tuple_size<TupleType>::value)>>
+  void SequenceNormalizeNewItems(arma::sp_mat& ratings)
+  {
+    std::get<I>(normalizations).NormalizeNewItems(ratings);
+    SequenceNormalizeNewItems<I + 1>(ratings);
+  }
+
+  //! End of tuple unpacking.
+  template<
+      int I, /* Which normalization in tuple to use */
+      typename = std::enable_if_t<(I >= std::tuple_size<TupleType>::value)>,
+      typename = void>
+  void SequenceNormalizeNewItems(arma::sp_mat& /* ratings */) { }
+
   //! Unpack normalizations tuple to denormalize.
   template<
       int I, /* Which normalization in tuple to use */
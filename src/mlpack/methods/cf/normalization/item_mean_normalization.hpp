@@ -119,6 +119,64 @@ class ItemMeanNormalization
     }
   }
 
+  /**
+   * Normalize the ratings of new users by subtracting the mean of each item.
+   *
+   * @param ratings Ratings of the new users (one row per item, one column per
+   *     new user).
+   */
+  void NormalizeNewUsers(arma::sp_mat& ratings) const
+  {
+    for (arma::sp_mat::iterator it = ratings.begin(); it != ratings.end(); ++it)
+    {
+      double tmp = *it - itemMean(it.row());
+
+      // The algorithm omits rating of zero. If normalized rating equals zero,
+      // it is set to the smallest positive float value.
+      if (tmp == 0)
+        tmp = std::numeric_limits<float>::min();
+
+      *it = tmp;
+    }
+  }
+
+  /**
+   * Normalize the ratings of new items by subtracting the mean of each new
+   * item, and append their means to the item means.
+   *
+   * @param ratings Ratings of the new items (one row per new item, one column
+   *     per user).
+   */
+  void NormalizeNewItems(arma::sp_mat& ratings)
+  {
+    arma::vec newMean(ratings.n_rows);
+    arma::Col<size_t> ratingNum(ratings.n_rows);
+    for (arma::sp_mat::iterator it = ratings.begin(); it != ratings.end(); ++it)
+    {
+      newMean(it.row()) += *it;
+      ratingNum(it.row()) += 1;
+    }
+    for (size_t i = 0; i < newMean.n_elem; ++i)
+    {
+      if (ratingNum(i) != 0)
+        newMean(i) /= ratingNum(i);
+    }
+
+    for (arma::sp_mat::iterator it = ratings.begin(); it != ratings.end(); ++it)
+    {
+      double tmp = *it - newMean(it.row());
+
+      // The algorithm omits rating of zero. If normalized rating equals zero,
+      // it is set to the smallest positive float value.
+      if (tmp == 0)
+        tmp = std::numeric_limits<float>::min();
+
+      *it = tmp;
+    }
+
+    itemMean = arma::join_cols(itemMean, newMean);
+  }
+
   /**
    * Denormalize computed rating by adding item mean.
    *
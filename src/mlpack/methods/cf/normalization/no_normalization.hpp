@@ -35,6 +35,20 @@ class NoNormalization
   template<typename MatType>
   inline void Normalize(const MatType& /* data */) const { }
 
+  /**
+   * Do nothing.
+   *
+   * @param * (ratings) Ratings of the new users.
+   */
+  inline void NormalizeNewUsers(const arma::sp_mat& /* ratings */) const { }
+
+  /**
+   * Do nothing.
+   *
+   * @param * (ratings) Ratings of the new items.
+   */
+  inline void NormalizeNewItems(const arma::sp_mat& /* ratings */) const { }
+
   /**
    * Do nothing.
    *
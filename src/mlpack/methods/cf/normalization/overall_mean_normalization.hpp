@@ -92,6 +92,40 @@ class OverallMeanNormalization
     }
   }
 
+  /**
+   * Normalize the ratings of new users by subtracting the mean of the training
+   * ratings.  The mean is not updated.
+   *
+   * @param ratings Ratings of the new users (one row per item, one column per
+   *     new user).
+   */
+  void NormalizeNewUsers(arma::sp_mat& ratings) const
+  {
+    for (arma::sp_mat::iterator it = ratings.begin(); it != ratings.end(); ++it)
+    {
+      double tmp = *it - mean;
+
+      // The algorithm omits rating of zero. If normalized rating equals zero,
+      // it is set to the smallest positive float value.
+      if (tmp == 0)
+        tmp = std::numeric_limits<float>::min();
+
+      *it = tmp;
+    }
+  }
+
+  /**
+   * Normalize the ratings of new items by subtracting the mean of the training
+   * ratings.  The mean is not updated.
+   *
+   * @param ratings Ratings of the new items (one row per new item, one column
+   *     per user).
+   */
+  void NormalizeNewItems(arma::sp_mat& ratings) const
+  {
+    NormalizeNewUsers(ratings);
+  }
+
   /**
    * Denormalize computed rating by adding mean.
    *
@@ -119,6 +119,64 @@ class UserMeanNormalization
     }
   }
 
+  /**
+   * Normalize the ratings of new users by subtracting the mean of each new
+   * user, and append their means to the user means.
+   *
+   * @param ratings Ratings of the new users (one row per item, one column per
+   *     new user).
+   */
+  void NormalizeNewUsers(arma::sp_mat& ratings)
+  {
+    arma::vec newMean(ratings.n_cols);
+    arma::Col<size_t> ratingNum(ratings.n_cols);
+    for (arma::sp_mat::iterator it = ratings.begin(); it != ratings.end(); ++it)
+    {
+      newMean(it.col()) += *it;
+      ratingNum(it.col()) += 1;
+    }
+    for (size_t i = 0; i < newMean.n_elem; ++i)
+    {
+      if (ratingNum(i) != 0)
+        newMean(i) /= ratingNum(i);
+    }
+
+    for (arma::sp_mat::iterator it = ratings.begin(); it != ratings.end(); ++it)
+    {
+      double tmp = *it - newMean(it.col());
+
+      // The algorithm omits rating of zero. If normalized rating equals zero,
+      // it is set to the smallest positive float value.
+      if (tmp == 0)
+        tmp = std::numeric_limits<float>::min();
+
+      *it = tmp;
+    }
+
+    userMean = arma::join_cols(userMean, newMean);
+  }
+
+  /**
+   * Normalize the ratings of new items by subtracting the mean of each user.
+   *
+   * @param ratings Ratings of the new items (one row per new item, one column
+   *     per user).
+   */
+  void NormalizeNewItems(arma::sp_mat& ratings) const
+  {
+    for (arma::sp_mat::iterator it = ratings.begin(); it != ratings.end(); ++it)
+    {
+      double tmp = *it - userMean(it.col());
+
+      // The algorithm omits rating of zero. If normalized rating equals zero,
+      // it is set to the smallest positive float value.
+      if (tmp == 0)
+        tmp = std::numeric_limits<float>::min();
+
+      *it = tmp;
+    }
+  }
+
   /**
    * Denormalize computed rating by adding user mean.
    *
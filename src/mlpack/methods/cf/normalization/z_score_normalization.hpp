@@ -104,6 +104,40 @@ class ZScoreNormalization
     }
   }
 
+  /**
+   * Normalize the ratings of new users with the mean and standard deviation of
+   * the training ratings, which are not updated.
+   *
+   * @param ratings Ratings of the new users (one row per item, one column per
+   *     new user).
+   */
+  void NormalizeNewUsers(arma::sp_mat& ratings) const
+  {
+    for (arma::sp_mat::iterator it = ratings.begin(); it != ratings.end(); ++it)
+    {
+      double tmp = (*it - mean) / stddev;
+
+      // The algorithm omits rating of zero. If normalized rating equals zero,
+      // it is set to the smallest positive float value.
+      if (tmp == 0)
+        tmp = std::numeric_limits<float>::min();
+
+      *it = tmp;
+    }
+  }
+
+  /**
+   * Normalize the ratings of new items with the mean and standard deviation of
+   * the training ratings, which are not updated.
+   *
+   * @param ratings Ratings of the new items (one row per new item, one column
+   *     per user).
+   */
+  void NormalizeNewItems(arma::sp_mat& ratings) const
+  {
+    NormalizeNewUsers(ratings);
+  }
+
   /**
    * Denormalize computed rating by adding mean and multiplying stddev.
    *
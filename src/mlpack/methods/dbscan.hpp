@@ -1,7 +1,8 @@
 /**
  * @file dbscan.hpp
  *
- * Convenience include for mlpack/methods/dbscan/dbscan.hpp.
+ * Convenience include for mlpack/methods/dbscan/dbscan.hpp and
+ * mlpack/methods/dbscan/incremental_dbscan.hpp.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -12,5 +13,6 @@
 #define MLPACK_DBSCAN_HPP
 
 #include "dbscan/dbscan.hpp"
+#include "dbscan/incremental_dbscan.hpp"
 
 #endif
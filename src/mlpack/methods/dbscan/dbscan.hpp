@@ -143,7 +143,8 @@ class DBSCAN
   /**
    * Performs DBSCAN clustering on the data, returning number of clusters and
    * also the list of cluster assignments.  This can perform search in batch, so
-   * it is well suited for dual-tree or naive search.
+   * it is well suited for dual-tree or naive search.  If OpenMP is enabled,
+   * the clusters are built from the range search results in parallel.
    *
    * @param data Dataset to cluster.
    * @param assignments Assignments for each point.
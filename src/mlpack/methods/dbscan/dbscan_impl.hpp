@@ -112,24 +112,28 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
 
   // Get a count of all clusters.
   const size_t numClusters = max(assignments) + 1;
-  arma::Col<size_t> counts(numClusters);
+  arma::Col<size_t> counts(numClusters, arma::fill::zeros);
   for (size_t i = 0; i < assignments.n_elem; ++i)
     counts[assignments[i]]++;
 
-  // Now assign clusters to new indices.
+  // Now assign clusters to new indices, in the order of the first point of each
+  // cluster.  (The representative of each set in the UnionFind structure may
+  // depend on the order in which the sets were merged, so it is not used for
+  // the numbering.)
   size_t currentCluster = 0;
   arma::Col<size_t> newAssignments(numClusters);
-  for (size_t i = 0; i < counts.n_elem; ++i)
+  newAssignments.fill(SIZE_MAX - 1);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
   {
-    if (counts[i] >= minPoints)
-      newAssignments[i] = currentCluster++;
-    else
-      newAssignments[i] = SIZE_MAX;
-  }
+    const size_t oldCluster = assignments[i];
+    if (newAssignments[oldCluster] == SIZE_MAX - 1)
+    {
+      newAssignments[oldCluster] = (counts[oldCluster] >= minPoints) ?
+          currentCluster++ : SIZE_MAX;
+    }
 
-  // Now reassign.
-  for (size_t i = 0; i < assignments.n_elem; ++i)
-    assignments[i] = newAssignments[assignments[i]];
+    assignments[i] = newAssignments[oldCluster];
+  }
 
   Log::Info << currentCluster << " clusters found." << std::endl;
 
@@ -226,45 +230,70 @@ void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
     UnionFind& uf)
 {
   // For each point, find the points in epsilon-neighborhood and their
-  // distances.
-  std::vector<std::vector<size_t>> neighbors;
-  std::vector<std::vector<ElemType>> distances;
+  // distances.  The neighbors of point i are neighbors[offsets[i]] to
+  // neighbors[offsets[i + 1] - 1].
+  arma::Col<size_t> offsets, neighbors;
+  arma::Col<ElemType> distances;
   Log::Info << "Performing range search." << std::endl;
   rangeSearch.Train(data);
-  rangeSearch.Search(RangeType<ElemType>(ElemType(0.0), epsilon), neighbors,
-      distances);
+  rangeSearch.Search(RangeType<ElemType>(ElemType(0.0), epsilon), offsets,
+      neighbors, distances);
   Log::Info << "Range search complete." << std::endl;
 
-  // See the description of the algorithm in `PointwiseCluster()`.  The strategy
-  // is the same here, but we have cached all range search results already.
-  // That means we already have computed whether each point is or is not a core
-  // point, just based on the size of its neighbors; so we don't need an
-  // auxiliary std::vector<bool> for that.
+  // See the description of the algorithm in `PointwiseCluster()`.  The result
+  // is the same here, but we have cached all range search results already, so
+  // we already know whether each point is or is not a core point.  Monochromatic
+  // range search does not return the point as its own neighbor, so we are
+  // looking for `minPoints - 1` neighbors instead.
+  std::vector<char> corePoints(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    corePoints[i] = (offsets[i + 1] - offsets[i] >= minPoints - 1);
 
-  // Now loop over all points.
+  // First, union every core point with all of its core neighbors.  The result
+  // does not depend on the order of the unions, so they can be done in
+  // parallel; UnionFind::Union() is safe to call from multiple threads.
+  #pragma omp parallel for schedule(dynamic, 256)
   for (size_t i = 0; i < data.n_cols; ++i)
   {
-    // Get the next index.
-    const size_t index = pointSelector.Select(i, data);
-    // Monochromatic dual-tree range search does not return the point as its own
-    // neighbor, so we are looking for `minPoints - 1` instead.
-    if (neighbors[index].size() >= minPoints - 1)
+    if (!corePoints[i])
+      continue;
+
+    for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
     {
-      for (size_t j = 0; j < neighbors[index].size(); ++j)
-      {
-        if (uf.Find(neighbors[index][j]) == neighbors[index][j])
-        {
-          // This unions unlabeled points.
-          uf.Union(index, neighbors[index][j]);
-        }
-        else if (neighbors[neighbors[index][j]].size() >= (minPoints - 1))
-        {
-          // This unions core points of other clusters.
-          uf.Union(index, neighbors[index][j]);
-        }
-      }
+      // Each pair of core points only needs to be unioned once.
+      const size_t neighbor = neighbors[j];
+      if (neighbor > i && corePoints[neighbor])
+        uf.Union(i, neighbor);
     }
   }
+
+  // Now, each non-core point is included into the cluster of the first core
+  // point (in the order given by the point selection policy) that has it as a
+  // neighbor.  If there is none, it is left unlabeled as noise.
+  arma::Col<size_t> selectionOrder(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    selectionOrder[pointSelector.Select(i, data)] = i;
+
+  #pragma omp parallel for schedule(dynamic, 256)
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    if (corePoints[i])
+      continue;
+
+    size_t firstCore = SIZE_MAX;
+    for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+    {
+      const size_t neighbor = neighbors[j];
+      if (corePoints[neighbor] && (firstCore == SIZE_MAX ||
+          selectionOrder[neighbor] < selectionOrder[firstCore]))
+        firstCore = neighbor;
+    }
+
+    // Non-core points are never roots of a non-trivial set, so this only ever
+    // attaches point i to the cluster of firstCore.
+    if (firstCore != SIZE_MAX)
+      uf.Union(firstCore, i);
+  }
 }
 
 } // namespace mlpack
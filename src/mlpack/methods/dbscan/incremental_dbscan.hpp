@@ -0,0 +1,192 @@
+/**
+ * @file methods/dbscan/incremental_dbscan.hpp
+ *
+ * An incremental version of DBSCAN, which updates the clustering as batches of
+ * points are inserted.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DBSCAN_INCREMENTAL_DBSCAN_HPP
+#define MLPACK_METHODS_DBSCAN_INCREMENTAL_DBSCAN_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/core/tree/rectangle_tree.hpp>
+#include <mlpack/methods/range_search/range_search.hpp>
+
+namespace mlpack {
+
+/**
+ * IncrementalDBSCAN maintains a DBSCAN clustering of a set of points that only
+ * grows: each call to Insert() adds a batch of points and updates the
+ * clustering, without reclustering the points that were inserted before, as
+ * in incremental DBSCAN:
+ *
+ * @code
+ * @inproceedings{ester1998incremental,
+ *   title={Incremental Clustering for Mining in a Data Warehousing
+ *       Environment},
+ *   author={Ester, M. and Kriegel, H.-P. and Sander, J. and Wimmer, M. and
+ *       Xu, X.},
+ *   booktitle={Proceedings of the 24th International Conference on Very Large
+ *       Data Bases (VLDB '98)},
+ *   pages={323--333},
+ *   year={1998}
+ * }
+ * @endcode
+ *
+ * The points are held in a tree that supports dynamic insertion (by default an
+ * R*-tree), and the number of points in the epsilon-neighborhood of each point
+ * is kept.  Inserting a point can only add neighbors, so points can only
+ * become core points.  When a batch is inserted, the neighborhoods of the new
+ * points are searched, the neighbor counts of their neighbors are updated, and
+ * the neighborhoods of the old points that just became core points are
+ * searched too.  Each new core point is then merged with its core neighbors in
+ * a union-find structure over the core points, and the non-core points in the
+ * neighborhood of a core point that do not belong to a cluster yet become
+ * border points of its cluster.  So, the cost of an insertion depends on the
+ * size of the batch and on the density around it, but not on the number of
+ * points inserted before.
+ *
+ * As for DBSCAN, a point is a core point if there are at least minPoints
+ * points (including itself) within distance epsilon of it.  Core points that
+ * are within distance epsilon of each other are in the same cluster, so the
+ * clusters of core points are the same as those found by DBSCAN on all the
+ * points; a border point (a non-core point within distance epsilon of a core
+ * point) is assigned to one of its neighboring clusters, which may be a
+ * different one than the one chosen by DBSCAN.  Other points are noise.
+ *
+ * @code
+ * IncrementalDBSCAN<> dbscan(0.5, 10);
+ * dbscan.Insert(firstBatch);
+ * dbscan.Insert(secondBatch);
+ *
+ * // Get the cluster of every point inserted so far.
+ * arma::Row<size_t> assignments;
+ * const size_t numClusters = dbscan.Assignments(assignments);
+ * @endcode
+ *
+ * @tparam DistanceType Distance metric to use.
+ * @tparam MatType Type of data to use.
+ * @tparam TreeType Type of tree to hold the points; it must support
+ *     InsertPoint(), like the RectangleTree variants.
+ */
+template<typename DistanceType = EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = RStarTree>
+class IncrementalDBSCAN
+{
+ public:
+  //! The type of the range search.
+  using RangeSearchType = RangeSearch<DistanceType, MatType, TreeType>;
+  //! The type of the tree holding the points.
+  using Tree = typename RangeSearchType::Tree;
+  //! Easy access to the element type of the matrix.
+  using ElemType = typename MatType::elem_type;
+
+  /**
+   * Construct the IncrementalDBSCAN object with the given parameters, and no
+   * points.
+   *
+   * @param epsilon Size of range query.
+   * @param minPoints Minimum number of points in the neighborhood of a core
+   *     point (including itself).
+   * @param distance Instantiated distance metric.
+   */
+  IncrementalDBSCAN(const ElemType epsilon,
+                    const size_t minPoints,
+                    DistanceType distance = DistanceType());
+
+  //! Copying is not supported, since the range search refers to the tree.
+  IncrementalDBSCAN(const IncrementalDBSCAN& other) = delete;
+  //! Copying is not supported, since the range search refers to the tree.
+  IncrementalDBSCAN& operator=(const IncrementalDBSCAN& other) = delete;
+
+  //! Destroy the object, and the tree.
+  ~IncrementalDBSCAN();
+
+  /**
+   * Insert a batch of points, and update the clustering.  The points get the
+   * next indices, in order: the first point of the batch is point NumPoints()
+   * (before the call).
+   *
+   * @param points Points to insert.
+   */
+  void Insert(const MatType& points);
+
+  /**
+   * Get the cluster of each point inserted so far.  Clusters are numbered in
+   * the order of their first point, and assignments[i] is SIZE_MAX if point i
+   * is noise.  The numbering can change when points are inserted, since
+   * clusters can merge.
+   *
+   * @param assignments Vector to store cluster assignments.
+   * @return The number of clusters.
+   */
+  size_t Assignments(arma::Row<size_t>& assignments) const;
+
+  //! Return whether the given point is a core point.
+  bool IsCore(const size_t point) const { return core[point]; }
+
+  //! Get the number of clusters.
+  size_t NumClusters() const { return numClusters; }
+  //! Get the number of points inserted so far.
+  size_t NumPoints() const { return numPoints; }
+
+  //! Get the size of range queries.
+  ElemType Epsilon() const { return epsilon; }
+  //! Get the minimum number of points in the neighborhood of a core point.
+  size_t MinPoints() const { return minPoints; }
+
+ private:
+  //! Return the root of the cluster of the given core point.
+  size_t Find(size_t point) const;
+
+  //! Merge the clusters of two core points; return false if they were already
+  //! in the same cluster.
+  bool Union(const size_t x, const size_t y);
+
+  /**
+   * Make the given point a core point, merge it with its core neighbors, and
+   * make its unassigned non-core neighbors border points of its cluster.
+   */
+  void AddCore(const size_t point, const std::vector<size_t>& neighbors);
+
+  //! Maximum distance between two neighbors.
+  ElemType epsilon;
+  //! Minimum number of points in the neighborhood of a core point.
+  size_t minPoints;
+
+  //! The tree holding the points (NULL until the first insertion).
+  Tree* tree;
+  //! The single-tree range search on the tree, which holds the distance
+  //! metric.
+  RangeSearchType rangeSearch;
+  //! The number of points inserted so far; the dataset of the tree may have
+  //! more columns, to allow for future insertions.
+  size_t numPoints;
+  //! The number of clusters.
+  size_t numClusters;
+
+  //! The number of points in the neighborhood of each point.
+  std::vector<size_t> neighborCounts;
+  //! Whether each point is a core point.
+  std::vector<bool> core;
+  //! For non-core points, a core neighbor (SIZE_MAX for noise).
+  std::vector<size_t> borderOf;
+  //! The parent of each core point in the union-find structure.
+  std::vector<size_t> parents;
+  //! The rank of each core point in the union-find structure.
+  std::vector<size_t> ranks;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "incremental_dbscan_impl.hpp"
+
+#endif
@@ -0,0 +1,257 @@
+/**
+ * @file methods/dbscan/incremental_dbscan_impl.hpp
+ *
+ * Implementation of IncrementalDBSCAN.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DBSCAN_INCREMENTAL_DBSCAN_IMPL_HPP
+#define MLPACK_METHODS_DBSCAN_INCREMENTAL_DBSCAN_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "incremental_dbscan.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+IncrementalDBSCAN<DistanceType, MatType, TreeType>::IncrementalDBSCAN(
+    const ElemType epsilon,
+    const size_t minPoints,
+    DistanceType distance) :
+    epsilon(epsilon),
+    minPoints(minPoints),
+    tree(NULL),
+    rangeSearch(false, true /* single-tree search */, distance),
+    numPoints(0),
+    numClusters(0)
+{
+  // Nothing to do.
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+IncrementalDBSCAN<DistanceType, MatType, TreeType>::~IncrementalDBSCAN()
+{
+  if (tree)
+    delete tree;
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void IncrementalDBSCAN<DistanceType, MatType, TreeType>::Insert(
+    const MatType& points)
+{
+  if (points.n_cols == 0)
+    return;
+
+  const size_t first = numPoints;
+  if (tree == NULL)
+  {
+    tree = new Tree(MatType(points));
+    rangeSearch.Train(tree);
+  }
+  else
+  {
+    util::CheckSameDimensionality(points, tree->Dataset(),
+        "IncrementalDBSCAN::Insert()", "points");
+
+    // The dataset of the tree grows geometrically, so that the points inserted
+    // before are only copied a constant number of times on average.
+    MatType& dataset = tree->Dataset();
+    if (first + points.n_cols > dataset.n_cols)
+    {
+      dataset.resize(dataset.n_rows, std::max(2 * (size_t) dataset.n_cols,
+          first + points.n_cols));
+    }
+
+    dataset.cols(first, first + points.n_cols - 1) = points;
+    for (size_t i = 0; i < points.n_cols; ++i)
+      tree->InsertPoint(first + i);
+  }
+
+  numPoints += points.n_cols;
+  neighborCounts.resize(numPoints, 0);
+  core.resize(numPoints, false);
+  borderOf.resize(numPoints, SIZE_MAX);
+  parents.resize(numPoints);
+  ranks.resize(numPoints, 0);
+  for (size_t i = first; i < numPoints; ++i)
+    parents[i] = i;
+
+  // Search the neighborhoods of the new points; each of them contains the
+  // point itself.
+  std::vector<std::vector<size_t>> neighbors;
+  std::vector<std::vector<ElemType>> distances;
+  rangeSearch.Search(points, RangeType<ElemType>(ElemType(0.0), epsilon),
+      neighbors, distances);
+
+  // The new points are counted in the neighborhoods of the old points; an old
+  // point can only reach minPoints neighbors once.
+  std::vector<size_t> newOldCores;
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    neighborCounts[first + i] = neighbors[i].size();
+    for (const size_t j : neighbors[i])
+    {
+      if (j < first && ++neighborCounts[j] == minPoints)
+        newOldCores.push_back(j);
+    }
+  }
+
+  // The neighborhoods of the old points that became core points are needed to
+  // merge them with their neighbors.
+  std::vector<std::vector<size_t>> oldNeighbors;
+  if (!newOldCores.empty())
+  {
+    MatType oldPoints(points.n_rows, newOldCores.size());
+    for (size_t i = 0; i < newOldCores.size(); ++i)
+      oldPoints.col(i) = tree->Dataset().col(newOldCores[i]);
+
+    rangeSearch.Search(oldPoints, RangeType<ElemType>(ElemType(0.0), epsilon),
+        oldNeighbors, distances);
+  }
+
+  for (size_t i = 0; i < points.n_cols; ++i)
+    if (neighborCounts[first + i] >= minPoints)
+      AddCore(first + i, neighbors[i]);
+  for (size_t i = 0; i < newOldCores.size(); ++i)
+    AddCore(newOldCores[i], oldNeighbors[i]);
+
+  // New non-core points that are not border points of a new core point may
+  // still be border points of an old core point.
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    const size_t point = first + i;
+    if (core[point] || borderOf[point] != SIZE_MAX)
+      continue;
+
+    for (const size_t j : neighbors[i])
+    {
+      if (core[j])
+      {
+        borderOf[point] = j;
+        break;
+      }
+    }
+  }
+
+  Log::Info << "IncrementalDBSCAN::Insert(): " << numClusters << " clusters "
+      << "after inserting " << points.n_cols << " points." << std::endl;
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t IncrementalDBSCAN<DistanceType, MatType, TreeType>::Assignments(
+    arma::Row<size_t>& assignments) const
+{
+  // Number the clusters in the order of their first point.
+  std::vector<size_t> clusterOfRoot(numPoints, SIZE_MAX);
+  size_t currentCluster = 0;
+  assignments.set_size(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    const size_t corePoint = core[i] ? i : borderOf[i];
+    if (corePoint == SIZE_MAX)
+    {
+      assignments[i] = SIZE_MAX;
+      continue;
+    }
+
+    const size_t root = Find(corePoint);
+    if (clusterOfRoot[root] == SIZE_MAX)
+      clusterOfRoot[root] = currentCluster++;
+    assignments[i] = clusterOfRoot[root];
+  }
+
+  return currentCluster;
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t IncrementalDBSCAN<DistanceType, MatType, TreeType>::Find(
+    size_t point) const
+{
+  // With union by rank, the depth of the trees is logarithmic, so no path
+  // compression is needed.
+  while (parents[point] != point)
+    point = parents[point];
+
+  return point;
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+bool IncrementalDBSCAN<DistanceType, MatType, TreeType>::Union(
+    const size_t x,
+    const size_t y)
+{
+  size_t xRoot = Find(x);
+  size_t yRoot = Find(y);
+  if (xRoot == yRoot)
+    return false;
+
+  if (ranks[xRoot] < ranks[yRoot])
+    std::swap(xRoot, yRoot);
+  else if (ranks[xRoot] == ranks[yRoot])
+    ++ranks[xRoot];
+
+  parents[yRoot] = xRoot;
+  return true;
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void IncrementalDBSCAN<DistanceType, MatType, TreeType>::AddCore(
+    const size_t point,
+    const std::vector<size_t>& neighbors)
+{
+  // The point starts its own cluster, which is merged with the clusters of
+  // the neighbors that are already core points.  (Neighbors that become core
+  // points later in the same batch merge with this point then.)
+  core[point] = true;
+  ++numClusters;
+  for (const size_t j : neighbors)
+  {
+    if (j == point)
+      continue;
+
+    if (core[j])
+    {
+      if (Union(point, j))
+        --numClusters;
+    }
+    else if (borderOf[j] == SIZE_MAX)
+    {
+      borderOf[j] = point;
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -18,6 +18,7 @@
 #include "fitness_functions/fitness_functions.hpp"
 #include "splits/splits.hpp"
 #include "select_functions/select_functions.hpp"
+#include "utils.hpp"
 
 namespace mlpack {
 
@@ -45,6 +46,23 @@ class DecisionTree :
   //! Allow access to the dimension selection type.
   using DimensionSelection = DimensionSelectionType;
 
+  //! Nodes with at least this many points search the dimensions for the best
+  //! split in parallel.
+  static const size_t ParallelSplitMinPoints = 2048;
+
+  //! When training with Train(), children with at least this many points are
+  //! built as parallel OpenMP tasks, if ParallelSubtrees is true.
+  static const size_t ParallelSubtreeMinPoints = 512;
+
+  //! Whether the subtrees of a node can be built in parallel by Train().  This
+  //! is only the case if neither the dimension selection nor the numeric split
+  //! draw random numbers, so that the tree does not depend on the order in
+  //! which the subtrees are built.
+  static constexpr bool ParallelSubtrees =
+      std::is_same<DimensionSelectionType, AllDimensionSelect>::value &&
+      !std::is_same<NumericSplit,
+                    RandomBinaryNumericSplit<FitnessFunction>>::value;
+
   /**
    * Construct the decision tree on the given data and labels, where the data
    * can be both numeric and categorical. Setting minimumLeafSize and
@@ -394,6 +412,149 @@ class DecisionTree :
                const std::enable_if_t<arma::is_arma_type<
                    std::remove_reference_t<WeightsType>>::value>* = 0);
 
+  /**
+   * Train the decision tree on the points of the given dataset given by
+   * `indices`, without copying the dataset: only the indices are reordered
+   * while the tree is built, and the values of each node are gathered one
+   * dimension at a time.  An index may appear several times (as in a bootstrap
+   * sample), which is the same as training on a dataset with the point
+   * repeated.  If `dimensions` is not empty, only those dimensions may be split
+   * on (the dimension selector chooses among them).  The data may have numeric
+   * and categorical types, specified by the datasetInfo parameter.  This will
+   * overwrite the existing model.
+   *
+   * If `presort` is true, all the allowed dimensions are numeric, and the
+   * numeric split type supports it (see SupportsSortedSplit; this is the case
+   * of BestBinaryNumericSplit), each dimension is sorted once for the whole
+   * tree, and the sorted lists are stably partitioned between the children of
+   * each node, so that no node sorts its values again: the time spent on each
+   * level of the tree is linear in the number of points.  This needs one index
+   * per point and allowed dimension, and gives the same tree.  Otherwise,
+   * `presort` is ignored.
+   *
+   * @param data Dataset to train on.
+   * @param datasetInfo Type information for each dimension.
+   * @param indices Indices of the points of the dataset to train on.
+   * @param labels Labels for each point of the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param dimensions Dimensions that may be split on (all if empty).
+   * @param presort Whether to sort each dimension once for the whole tree.
+   * @return The final entropy of decision tree.
+   */
+  template<typename MatType>
+  double TrainIndices(const MatType& data,
+                      const data::DatasetInfo& datasetInfo,
+                      const arma::uvec& indices,
+                      const arma::Row<size_t>& labels,
+                      const size_t numClasses,
+                      const size_t minimumLeafSize = 10,
+                      const double minimumGainSplit = 1e-7,
+                      const size_t maximumDepth = 0,
+                      DimensionSelectionType dimensionSelector =
+                          DimensionSelectionType(),
+                      const arma::uvec& dimensions = arma::uvec(),
+                      const bool presort = false);
+
+  /**
+   * Train the decision tree on the points of the given dataset given by
+   * `indices`, without copying the dataset, assuming that all dimensions are
+   * numeric.  See the overload above for details.
+   *
+   * @param data Dataset to train on.
+   * @param indices Indices of the points of the dataset to train on.
+   * @param labels Labels for each point of the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param dimensions Dimensions that may be split on (all if empty).
+   * @param presort Whether to sort each dimension once for the whole tree.
+   * @return The final entropy of decision tree.
+   */
+  template<typename MatType>
+  double TrainIndices(const MatType& data,
+                      const arma::uvec& indices,
+                      const arma::Row<size_t>& labels,
+                      const size_t numClasses,
+                      const size_t minimumLeafSize = 10,
+                      const double minimumGainSplit = 1e-7,
+                      const size_t maximumDepth = 0,
+                      DimensionSelectionType dimensionSelector =
+                          DimensionSelectionType(),
+                      const arma::uvec& dimensions = arma::uvec(),
+                      const bool presort = false);
+
+  /**
+   * Train the decision tree on the weighted points of the given dataset given
+   * by `indices`, without copying the dataset.  See the unweighted overload
+   * for details.
+   *
+   * @param data Dataset to train on.
+   * @param datasetInfo Type information for each dimension.
+   * @param indices Indices of the points of the dataset to train on.
+   * @param labels Labels for each point of the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights of each point of the dataset.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param dimensions Dimensions that may be split on (all if empty).
+   * @param presort Whether to sort each dimension once for the whole tree.
+   * @return The final entropy of decision tree.
+   */
+  template<typename MatType>
+  double TrainIndices(const MatType& data,
+                      const data::DatasetInfo& datasetInfo,
+                      const arma::uvec& indices,
+                      const arma::Row<size_t>& labels,
+                      const size_t numClasses,
+                      const arma::rowvec& weights,
+                      const size_t minimumLeafSize = 10,
+                      const double minimumGainSplit = 1e-7,
+                      const size_t maximumDepth = 0,
+                      DimensionSelectionType dimensionSelector =
+                          DimensionSelectionType(),
+                      const arma::uvec& dimensions = arma::uvec(),
+                      const bool presort = false);
+
+  /**
+   * Train the decision tree on the weighted points of the given dataset given
+   * by `indices`, without copying the dataset, assuming that all dimensions
+   * are numeric.  See the unweighted overload for details.
+   *
+   * @param data Dataset to train on.
+   * @param indices Indices of the points of the dataset to train on.
+   * @param labels Labels for each point of the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights of each point of the dataset.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param dimensions Dimensions that may be split on (all if empty).
+   * @param presort Whether to sort each dimension once for the whole tree.
+   * @return The final entropy of decision tree.
+   */
+  template<typename MatType>
+  double TrainIndices(const MatType& data,
+                      const arma::uvec& indices,
+                      const arma::Row<size_t>& labels,
+                      const size_t numClasses,
+                      const arma::rowvec& weights,
+                      const size_t minimumLeafSize = 10,
+                      const double minimumGainSplit = 1e-7,
+                      const size_t maximumDepth = 0,
+                      DimensionSelectionType dimensionSelector =
+                          DimensionSelectionType(),
+                      const arma::uvec& dimensions = arma::uvec(),
+                      const bool presort = false);
+
   /**
    * Classify the given point, using the entire tree.  The predicted label is
    * returned.
@@ -461,6 +622,13 @@ class DecisionTree :
   //! trained tree).
   size_t SplitDimension() const { return splitDimension; }
 
+  //! Get the type of the split dimension (only meaningful if this is a
+  //! non-leaf in a trained tree).
+  data::Datatype SplitDimensionType() const
+  {
+    return (data::Datatype) dimensionType;
+  }
+
   //! Get the class probabilities, if this is a leaf node in the trained tree.
   //! Note that if this is not a leaf, then this may contain arbitrary
   //! information used by the split in the tree!
@@ -481,6 +649,12 @@ class DecisionTree :
    */
   size_t NumClasses() const;
 
+  /**
+   * Return the memory used by the tree: its nodes, their vectors of children,
+   * and their class probabilities (or split information, for internal nodes).
+   */
+  MemoryReport MemoryUsage() const;
+
  private:
   //! The vector of children.
   std::vector<DecisionTree*> children;
@@ -576,6 +750,105 @@ class DecisionTree :
                const double minimumGainSplit,
                const size_t maximumDepth,
                DimensionSelectionType& dimensionSelector);
+
+  /**
+   * Check the arguments of the public TrainIndices() methods, and train the
+   * tree on a copy of the indices (or on presorted lists of them, if `presort`
+   * is true and presorting is possible).  If datasetInfo is NULL, all
+   * dimensions are numeric.
+   */
+  template<bool UseWeights, typename MatType>
+  double TrainIndices(const MatType& data,
+                      const data::DatasetInfo* datasetInfo,
+                      const arma::uvec& indices,
+                      const arma::Row<size_t>& labels,
+                      const size_t numClasses,
+                      const arma::rowvec& weights,
+                      const size_t minimumLeafSize,
+                      const double minimumGainSplit,
+                      const size_t maximumDepth,
+                      DimensionSelectionType& dimensionSelector,
+                      const arma::uvec& dimensions,
+                      const bool presort);
+
+  /**
+   * Train the node on the points given by indices[begin, begin + count), and
+   * build its children recursively, reordering only the indices.
+   *
+   * @param data Dataset to train on.
+   * @param indices Indices of the points to train on; the indices of the node
+   *      are reordered so that those of each child are contiguous.
+   * @param begin Index (in `indices`) of the first point of this node.
+   * @param count Number of points in this node.
+   * @param datasetInfo Type information for each dimension (NULL if all
+   *      dimensions are numeric).
+   * @param labels Labels for each point of the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights of each point of the dataset (ignored if
+   *      UseWeights is false).
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param dimensions Dimensions that may be split on (all if empty).
+   * @return The final entropy of decision tree.
+   */
+  template<bool UseWeights, typename MatType>
+  double TrainIndices(const MatType& data,
+                      arma::uvec& indices,
+                      const size_t begin,
+                      const size_t count,
+                      const data::DatasetInfo* datasetInfo,
+                      const arma::Row<size_t>& labels,
+                      const size_t numClasses,
+                      const arma::rowvec& weights,
+                      const size_t minimumLeafSize,
+                      const double minimumGainSplit,
+                      const size_t maximumDepth,
+                      DimensionSelectionType& dimensionSelector,
+                      const arma::uvec& dimensions);
+
+  /**
+   * Train the node on the points of the rows [begin, begin + count) of
+   * `sorted`, and build its children recursively.  Column k of `sorted` holds
+   * the positions (in `indices`) of the points of each node, sorted by their
+   * value in the k-th allowed dimension; the rows of this node are stably
+   * partitioned between the children in every column, so that the rows of
+   * each child stay sorted.  All dimensions must be numeric.
+   *
+   * @param data Dataset to train on.
+   * @param indices Indices of the points to train on (not reordered).
+   * @param sorted Sorted positions in `indices`, for each allowed dimension.
+   * @param childAssignments Buffer with one element per position in
+   *      `indices`, used while partitioning.
+   * @param begin First row (in `sorted`) of this node.
+   * @param count Number of points in this node.
+   * @param labels Labels for each point of the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights of each point of the dataset (ignored if
+   *      UseWeights is false).
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param dimensions Dimensions that may be split on (all if empty).
+   * @return The final entropy of decision tree.
+   */
+  template<bool UseWeights, typename MatType>
+  double TrainSorted(const MatType& data,
+                     const arma::uvec& indices,
+                     arma::umat& sorted,
+                     arma::uvec& childAssignments,
+                     const size_t begin,
+                     const size_t count,
+                     const arma::Row<size_t>& labels,
+                     const size_t numClasses,
+                     const arma::rowvec& weights,
+                     const size_t minimumLeafSize,
+                     const double minimumGainSplit,
+                     const size_t maximumDepth,
+                     DimensionSelectionType& dimensionSelector,
+                     const arma::uvec& dimensions);
 };
 
 /**
@@ -627,6 +627,23 @@ double DecisionTree<FitnessFunction,
     const size_t maximumDepth,
     DimensionSelectionType& dimensionSelector)
 {
+  #ifdef MLPACK_USE_OPENMP
+  if (ParallelSubtrees && count >= ParallelSubtreeMinPoints &&
+      omp_get_level() == 0)
+  {
+    // Start the threads that the tasks of the whole tree will run on.
+    double gain = 0.0;
+    #pragma omp parallel num_threads(ThreadBudget())
+    {
+      #pragma omp single
+      gain = Train<UseWeights>(data, begin, count, datasetInfo, labels,
+          numClasses, weights, minimumLeafSize, minimumGainSplit,
+          maximumDepth, dimensionSelector);
+    }
+    return gain;
+  }
+  #endif
+
   // Clear children if needed.
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
@@ -644,7 +661,75 @@ double DecisionTree<FitnessFunction,
   size_t bestDim = datasetInfo.Dimensionality(); // This means "no split".
   const size_t end = dimensionSelector.End();
 
-  if (maximumDepth != 1)
+  if (maximumDepth != 1 && count >= ParallelSplitMinPoints)
+  {
+    // For large nodes, search the dimensions in parallel, each with its own
+    // split information, against the gain of this node.
+    std::vector<size_t> dimensions;
+    for (size_t i = dimensionSelector.Begin(); i != end;
+         i = dimensionSelector.Next())
+      dimensions.push_back(i);
+
+    std::vector<double> dimGains(dimensions.size(), DBL_MAX);
+    std::vector<arma::vec> dimSplitInfo(dimensions.size());
+    std::vector<NumericAuxiliarySplitInfo> dimNumericAux(dimensions.size());
+    std::vector<CategoricalAuxiliarySplitInfo> dimCategoricalAux(
+        dimensions.size());
+    ParallelFor(dimensions.size(), true, ParallelSubtrees,
+        [&](const size_t d)
+    {
+      const size_t i = dimensions[d];
+      if (datasetInfo.Type(i) == data::Datatype::categorical)
+      {
+        dimGains[d] = CategoricalSplit::template SplitIfBetter<UseWeights>(
+            bestGain,
+            data.cols(begin, begin + count - 1).row(i),
+            datasetInfo.NumMappings(i),
+            labels.subvec(begin, begin + count - 1),
+            numClasses,
+            UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
+            minimumLeafSize,
+            minimumGainSplit,
+            dimSplitInfo[d],
+            dimCategoricalAux[d]);
+      }
+      else if (datasetInfo.Type(i) == data::Datatype::numeric)
+      {
+        dimGains[d] = NumericSplit::template SplitIfBetter<UseWeights>(
+            bestGain,
+            data.cols(begin, begin + count - 1).row(i),
+            labels.subvec(begin, begin + count - 1),
+            numClasses,
+            UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
+            minimumLeafSize,
+            minimumGainSplit,
+            dimSplitInfo[d],
+            dimNumericAux[d]);
+      }
+    });
+
+    // Now take the first dimension that improves on the best gain so far, as
+    // the serial search below does.
+    for (size_t d = 0; d < dimensions.size(); ++d)
+    {
+      if (dimGains[d] == DBL_MAX ||
+          dimGains[d] <= bestGain + minimumGainSplit)
+        continue;
+
+      bestDim = dimensions[d];
+      bestGain = dimGains[d];
+      classProbabilities = std::move(dimSplitInfo[d]);
+      if (datasetInfo.Type(bestDim) == data::Datatype::categorical)
+        CategoricalAuxiliarySplitInfo::operator=(dimCategoricalAux[d]);
+      else
+        NumericAuxiliarySplitInfo::operator=(dimNumericAux[d]);
+
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
+    }
+  }
+  else if (maximumDepth != 1)
   {
     for (size_t i = dimensionSelector.Begin(); i != end;
          i = dimensionSelector.Next())
@@ -721,23 +806,14 @@ double DecisionTree<FitnessFunction,
       }
     }
 
-    // Figure out counts of children.
-    arma::Row<size_t> childCounts(numChildren);
-    for (size_t i = begin; i < begin + count; ++i)
-      childCounts[childAssignments[i - begin]]++;
-
-    // Initialize bestGain if recursive split is allowed.
-    if (!NoRecursion)
-    {
-      bestGain = 0.0;
-    }
-
-    // Split into children.
+    // Split the points into the children, so that the points of each child are
+    // contiguous.
+    std::vector<size_t> childBegins(numChildren + 1);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = currentCol; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -749,26 +825,49 @@ double DecisionTree<FitnessFunction,
           ++currentCol;
         }
       }
+    }
+    childBegins[numChildren] = currentCol;
+
+    // Now build the children recursively.  Each child only modifies its own
+    // columns of the data, so large children are built as parallel tasks if
+    // possible.
+    children.resize(numChildren, NULL);
+    std::vector<double> childGains(numChildren, 0.0);
+    auto buildChild = [&](const size_t i)
+    {
+      const size_t childCount = childBegins[i + 1] - childBegins[i];
+
+      // Subtrees built at the same time need their own dimension selector.
+      DimensionSelectionType childSelector;
+      DimensionSelectionType& selector = ParallelSubtrees ?
+          (childSelector = dimensionSelector) : dimensionSelector;
 
-      // Now build the child recursively.
       DecisionTree* child = new DecisionTree();
-      if (NoRecursion)
-      {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, currentCol - currentChildBegin, minimumGainSplit,
-            maximumDepth - 1, dimensionSelector);
-      }
-      else
+      childGains[i] = child->Train<UseWeights>(data, childBegins[i],
+          childCount, datasetInfo, labels, numClasses, weights,
+          NoRecursion ? childCount : minimumLeafSize, minimumGainSplit,
+          maximumDepth - 1, selector);
+      children[i] = child;
+    };
+
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+      #pragma omp task if (ParallelSubtrees && \
+          childBegins[i + 1] - childBegins[i] >= ParallelSubtreeMinPoints) \
+          shared(buildChild)
+      buildChild(i);
+    }
+    #pragma omp taskwait
+
+    // During recursion entropy of child node may change.
+    if (!NoRecursion)
+    {
+      bestGain = 0.0;
+      for (size_t i = 0; i < numChildren; ++i)
       {
-        // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+        bestGain += double(childBegins[i + 1] - childBegins[i]) /
+            double(count) * (-childGains[i]);
       }
-      children.push_back(child);
     }
   }
   else
@@ -810,6 +909,22 @@ double DecisionTree<FitnessFunction,
     const size_t maximumDepth,
     DimensionSelectionType& dimensionSelector)
 {
+  #ifdef MLPACK_USE_OPENMP
+  if (ParallelSubtrees && count >= ParallelSubtreeMinPoints &&
+      omp_get_level() == 0)
+  {
+    // Start the threads that the tasks of the whole tree will run on.
+    double gain = 0.0;
+    #pragma omp parallel num_threads(ThreadBudget())
+    {
+      #pragma omp single
+      gain = Train<UseWeights>(data, begin, count, labels, numClasses, weights,
+          minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+    }
+    return gain;
+  }
+  #endif
+
   // Clear children if needed.
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
@@ -829,7 +944,57 @@ double DecisionTree<FitnessFunction,
       UseWeights ? weights.subvec(begin, begin + count - 1) : weights);
   size_t bestDim = data.n_rows; // This means "no split".
 
-  if (maximumDepth != 1)
+  if (maximumDepth != 1 && count >= ParallelSplitMinPoints)
+  {
+    // For large nodes, search the dimensions in parallel, each with its own
+    // split information, against the gain of this node.  The selection
+    // policies pick their dimensions in Begin(), so listing them all first
+    // does not change them.
+    std::vector<size_t> dimensions;
+    for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
+         i = dimensionSelector.Next())
+      dimensions.push_back(i);
+
+    std::vector<double> dimGains(dimensions.size());
+    std::vector<arma::vec> dimSplitInfo(dimensions.size());
+    std::vector<NumericAuxiliarySplitInfo> dimAux(dimensions.size());
+    ParallelFor(dimensions.size(), true, ParallelSubtrees,
+        [&](const size_t d)
+    {
+      dimGains[d] = NumericSplitType<FitnessFunction>::template
+          SplitIfBetter<UseWeights>(bestGain,
+                                    data.cols(begin, begin + count - 1).row(
+                                        dimensions[d]),
+                                    labels.cols(begin, begin + count - 1),
+                                    numClasses,
+                                    UseWeights ?
+                                        weights.cols(begin, begin + count - 1) :
+                                        weights,
+                                    minimumLeafSize,
+                                    minimumGainSplit,
+                                    dimSplitInfo[d],
+                                    dimAux[d]);
+    });
+
+    // Now take the first dimension that improves on the best gain so far, as
+    // the serial search below does.
+    for (size_t d = 0; d < dimensions.size(); ++d)
+    {
+      if (dimGains[d] == DBL_MAX ||
+          dimGains[d] <= bestGain + minimumGainSplit)
+        continue;
+
+      bestDim = dimensions[d];
+      bestGain = dimGains[d];
+      classProbabilities = std::move(dimSplitInfo[d]);
+      NumericAuxiliarySplitInfo::operator=(dimAux[d]);
+
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
+    }
+  }
+  else if (maximumDepth != 1)
   {
     for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
          i = dimensionSelector.Next())
@@ -879,23 +1044,14 @@ double DecisionTree<FitnessFunction,
           data(bestDim, j), classProbabilities, *this);
     }
 
-    // Calculate counts of children in each node.
-    arma::Row<size_t> childCounts(numChildren);
-    childCounts.zeros();
-    for (size_t j = begin; j < begin + count; ++j)
-      childCounts[childAssignments[j - begin]]++;
-
-    // Initialize bestGain if recursive split is allowed.
-    if (!NoRecursion)
-    {
-      bestGain = 0.0;
-    }
-
+    // Split the points into the children, so that the points of each child are
+    // contiguous.
+    std::vector<size_t> childBegins(numChildren + 1);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = currentCol; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -907,26 +1063,49 @@ double DecisionTree<FitnessFunction,
           ++currentCol;
         }
       }
+    }
+    childBegins[numChildren] = currentCol;
+
+    // Now build the children recursively.  Each child only modifies its own
+    // columns of the data, so large children are built as parallel tasks if
+    // possible.
+    children.resize(numChildren, NULL);
+    std::vector<double> childGains(numChildren, 0.0);
+    auto buildChild = [&](const size_t i)
+    {
+      const size_t childCount = childBegins[i + 1] - childBegins[i];
+
+      // Subtrees built at the same time need their own dimension selector.
+      DimensionSelectionType childSelector;
+      DimensionSelectionType& selector = ParallelSubtrees ?
+          (childSelector = dimensionSelector) : dimensionSelector;
 
-      // Now build the child recursively.
       DecisionTree* child = new DecisionTree();
-      if (NoRecursion)
-      {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            currentCol - currentChildBegin, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-      }
-      else
+      childGains[i] = child->Train<UseWeights>(data, childBegins[i],
+          childCount, labels, numClasses, weights,
+          NoRecursion ? childCount : minimumLeafSize, minimumGainSplit,
+          maximumDepth - 1, selector);
+      children[i] = child;
+    };
+
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+      #pragma omp task if (ParallelSubtrees && \
+          childBegins[i + 1] - childBegins[i] >= ParallelSubtreeMinPoints) \
+          shared(buildChild)
+      buildChild(i);
+    }
+    #pragma omp taskwait
+
+    // During recursion entropy of child node may change.
+    if (!NoRecursion)
+    {
+      bestGain = 0.0;
+      for (size_t i = 0; i < numChildren; ++i)
       {
-        // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+        bestGain += double(childBegins[i + 1] - childBegins[i]) /
+            double(count) * (-childGains[i]);
       }
-      children.push_back(child);
     }
   }
   else
@@ -944,6 +1123,700 @@ double DecisionTree<FitnessFunction,
   return -bestGain;
 }
 
+//! Train on the points given by indices, with dimension types.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    NoRecursion>::TrainIndices(
+    const MatType& data,
+    const data::DatasetInfo& datasetInfo,
+    const arma::uvec& indices,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector,
+    const arma::uvec& dimensions,
+    const bool presort)
+{
+  arma::rowvec weights; // Fake weights, not used.
+  return TrainIndices<false>(data, &datasetInfo, indices, labels, numClasses,
+      weights, minimumLeafSize, minimumGainSplit, maximumDepth,
+      dimensionSelector, dimensions, presort);
+}
+
+//! Train on the points given by indices, assuming all dimensions are numeric.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    NoRecursion>::TrainIndices(
+    const MatType& data,
+    const arma::uvec& indices,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector,
+    const arma::uvec& dimensions,
+    const bool presort)
+{
+  arma::rowvec weights; // Fake weights, not used.
+  return TrainIndices<false>(data, (const data::DatasetInfo*) NULL, indices,
+      labels, numClasses, weights, minimumLeafSize, minimumGainSplit,
+      maximumDepth, dimensionSelector, dimensions, presort);
+}
+
+//! Train on the weighted points given by indices, with dimension types.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    NoRecursion>::TrainIndices(
+    const MatType& data,
+    const data::DatasetInfo& datasetInfo,
+    const arma::uvec& indices,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector,
+    const arma::uvec& dimensions,
+    const bool presort)
+{
+  return TrainIndices<true>(data, &datasetInfo, indices, labels, numClasses,
+      weights, minimumLeafSize, minimumGainSplit, maximumDepth,
+      dimensionSelector, dimensions, presort);
+}
+
+//! Train on the weighted points given by indices, assuming all dimensions are
+//! numeric.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    NoRecursion>::TrainIndices(
+    const MatType& data,
+    const arma::uvec& indices,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector,
+    const arma::uvec& dimensions,
+    const bool presort)
+{
+  return TrainIndices<true>(data, (const data::DatasetInfo*) NULL, indices,
+      labels, numClasses, weights, minimumLeafSize, minimumGainSplit,
+      maximumDepth, dimensionSelector, dimensions, presort);
+}
+
+//! Check the arguments and train on a copy of the indices.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<bool UseWeights, typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    NoRecursion>::TrainIndices(
+    const MatType& data,
+    const data::DatasetInfo* datasetInfo,
+    const arma::uvec& indices,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType& dimensionSelector,
+    const arma::uvec& dimensions,
+    const bool presort)
+{
+  // Sanity checks on the data.
+  util::CheckSameSizes(data, labels, "DecisionTree::TrainIndices()");
+  if (UseWeights)
+  {
+    util::CheckSameSizes(data, weights, "DecisionTree::TrainIndices()",
+        "weights");
+  }
+
+  if (indices.n_elem == 0)
+  {
+    throw std::invalid_argument("DecisionTree::TrainIndices(): no points to "
+        "train on");
+  }
+
+  if (indices.max() >= data.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "DecisionTree::TrainIndices(): index " << indices.max() << " is "
+        << "out of bounds for a dataset with " << data.n_cols << " points";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (dimensions.n_elem > 0 && dimensions.max() >= data.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "DecisionTree::TrainIndices(): dimension " << dimensions.max()
+        << " is out of bounds for a dataset with " << data.n_rows
+        << " dimensions";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The dimension selector selects among the allowed dimensions.
+  dimensionSelector.Dimensions() = (dimensions.n_elem > 0) ?
+      dimensions.n_elem : data.n_rows;
+
+  if constexpr (SupportsSortedSplit<NumericSplit>::value)
+  {
+    // Presorting is only possible if all the allowed dimensions are numeric.
+    const size_t numDimensions = dimensionSelector.Dimensions();
+    bool allNumeric = true;
+    for (size_t i = 0; i < numDimensions && datasetInfo != NULL; ++i)
+    {
+      const size_t d = (dimensions.n_elem == 0) ? i : (size_t) dimensions[i];
+      if (datasetInfo->Type(d) != data::Datatype::numeric)
+      {
+        allNumeric = false;
+        break;
+      }
+    }
+
+    if (presort && allNumeric)
+    {
+      // Column k holds the positions in `indices` sorted by the values of the
+      // k-th allowed dimension.  The sort is stable, so that ties keep the
+      // order of `indices`.
+      arma::umat sorted(indices.n_elem, numDimensions);
+      #pragma omp parallel
+      {
+        arma::Row<typename MatType::elem_type> values(indices.n_elem);
+
+        #pragma omp for schedule(dynamic)
+        for (size_t k = 0; k < numDimensions; ++k)
+        {
+          const size_t d = (dimensions.n_elem == 0) ? k :
+              (size_t) dimensions[k];
+          for (size_t j = 0; j < indices.n_elem; ++j)
+            values[j] = data(d, indices[j]);
+          sorted.col(k) = arma::stable_sort_index(values);
+        }
+      }
+
+      arma::uvec childAssignments(indices.n_elem);
+      return TrainSorted<UseWeights>(data, indices, sorted, childAssignments,
+          0, indices.n_elem, labels, numClasses, weights, minimumLeafSize,
+          minimumGainSplit, maximumDepth, dimensionSelector, dimensions);
+    }
+  }
+
+  arma::uvec treeIndices(indices);
+  return TrainIndices<UseWeights>(data, treeIndices, 0, treeIndices.n_elem,
+      datasetInfo, labels, numClasses, weights, minimumLeafSize,
+      minimumGainSplit, maximumDepth, dimensionSelector, dimensions);
+}
+
+//! Train the node on the points given by indices.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<bool UseWeights, typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    NoRecursion>::TrainIndices(
+    const MatType& data,
+    arma::uvec& indices,
+    const size_t begin,
+    const size_t count,
+    const data::DatasetInfo* datasetInfo,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType& dimensionSelector,
+    const arma::uvec& dimensions)
+{
+  using ElemType = typename MatType::elem_type;
+
+  // Clear children if needed.
+  for (size_t i = 0; i < children.size(); ++i)
+    delete children[i];
+  children.clear();
+
+  // We won't be using these members if all dimensions are numeric.
+  if (datasetInfo == NULL)
+    CategoricalAuxiliarySplitInfo::operator=(CategoricalAuxiliarySplitInfo());
+
+  // Only the labels and weights of the node are gathered; the values of the
+  // points are gathered one dimension at a time.
+  arma::uvec nodeIndices = indices.subvec(begin, begin + count - 1);
+  arma::Row<size_t> nodeLabels = labels.cols(nodeIndices);
+  arma::rowvec nodeWeights;
+  if (UseWeights)
+    nodeWeights = weights.cols(nodeIndices);
+
+  // A dimension returned by the dimension selector is a position in
+  // `dimensions`, if it is given.
+  auto dimension = [&](const size_t i)
+  {
+    return (dimensions.n_elem == 0) ? i : (size_t) dimensions[i];
+  };
+  auto isCategorical = [&](const size_t d)
+  {
+    return (datasetInfo != NULL) &&
+        (datasetInfo->Type(d) == data::Datatype::categorical);
+  };
+  auto gather = [&](const size_t d, arma::Row<ElemType>& values)
+  {
+    values.set_size(count);
+    for (size_t j = 0; j < count; ++j)
+      values[j] = data(d, nodeIndices[j]);
+  };
+
+  // Look through the list of dimensions and obtain the best split, as Train()
+  // does.
+  double bestGain = FitnessFunction::template Evaluate<UseWeights>(nodeLabels,
+      numClasses, nodeWeights);
+  size_t bestDim = data.n_rows; // This means "no split".
+
+  if (maximumDepth != 1 && count >= ParallelSplitMinPoints &&
+      datasetInfo == NULL)
+  {
+    // For large nodes, search the dimensions in parallel.
+    std::vector<size_t> selected;
+    for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
+         i = dimensionSelector.Next())
+      selected.push_back(dimension(i));
+
+    std::vector<double> dimGains(selected.size());
+    std::vector<arma::vec> dimSplitInfo(selected.size());
+    std::vector<NumericAuxiliarySplitInfo> dimAux(selected.size());
+    #pragma omp parallel
+    {
+      arma::Row<ElemType> values;
+
+      #pragma omp for schedule(dynamic)
+      for (size_t d = 0; d < selected.size(); ++d)
+      {
+        gather(selected[d], values);
+        dimGains[d] = NumericSplitType<FitnessFunction>::template
+            SplitIfBetter<UseWeights>(bestGain, values, nodeLabels, numClasses,
+            nodeWeights, minimumLeafSize, minimumGainSplit, dimSplitInfo[d],
+            dimAux[d]);
+      }
+    }
+
+    // Now take the first dimension that improves on the best gain so far, as
+    // the serial search below does.
+    for (size_t d = 0; d < selected.size(); ++d)
+    {
+      if (dimGains[d] == DBL_MAX ||
+          dimGains[d] <= bestGain + minimumGainSplit)
+        continue;
+
+      bestDim = selected[d];
+      bestGain = dimGains[d];
+      classProbabilities = std::move(dimSplitInfo[d]);
+      NumericAuxiliarySplitInfo::operator=(dimAux[d]);
+
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
+    }
+  }
+  else if (maximumDepth != 1)
+  {
+    arma::Row<ElemType> values;
+    const size_t end = dimensionSelector.End();
+    for (size_t i = dimensionSelector.Begin(); i != end;
+         i = dimensionSelector.Next())
+    {
+      const size_t d = dimension(i);
+      gather(d, values);
+
+      double dimGain;
+      if (isCategorical(d))
+      {
+        dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(bestGain,
+            values, datasetInfo->NumMappings(d), nodeLabels, numClasses,
+            nodeWeights, minimumLeafSize, minimumGainSplit, classProbabilities,
+            *this);
+      }
+      else
+      {
+        dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
+            values, nodeLabels, numClasses, nodeWeights, minimumLeafSize,
+            minimumGainSplit, classProbabilities, *this);
+      }
+
+      // If the splitter reported that it did not split, move to the next
+      // dimension.
+      if (dimGain == DBL_MAX)
+        continue;
+
+      bestDim = d;
+      bestGain = dimGain;
+
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
+    }
+  }
+
+  if (bestDim == data.n_rows)
+  {
+    // Clear auxiliary info objects.
+    NumericAuxiliarySplitInfo::operator=(NumericAuxiliarySplitInfo());
+    CategoricalAuxiliarySplitInfo::operator=(CategoricalAuxiliarySplitInfo());
+
+    // Calculate class probabilities because we are a leaf.
+    CalculateClassProbabilities<UseWeights>(nodeLabels, numClasses,
+        nodeWeights);
+    return -bestGain;
+  }
+
+  // We split: reorder the indices of the node so that those of each child are
+  // contiguous, then build the children.
+  const bool categorical = isCategorical(bestDim);
+  dimensionType = (size_t) (categorical ? data::Datatype::categorical :
+      data::Datatype::numeric);
+  splitDimension = bestDim;
+  const size_t numChildren = categorical ?
+      CategoricalSplit::NumChildren(classProbabilities, *this) :
+      NumericSplit::NumChildren(classProbabilities, *this);
+
+  arma::Row<size_t> childAssignments(count);
+  for (size_t j = 0; j < count; ++j)
+  {
+    const ElemType value = data(bestDim, nodeIndices[j]);
+    childAssignments[j] = categorical ?
+        CategoricalSplit::CalculateDirection(value, classProbabilities, *this) :
+        NumericSplit::CalculateDirection(value, classProbabilities, *this);
+  }
+
+  std::vector<size_t> childBegins(numChildren + 1);
+  size_t currentCol = begin;
+  for (size_t i = 0; i < numChildren; ++i)
+  {
+    childBegins[i] = currentCol;
+    for (size_t j = currentCol; j < begin + count; ++j)
+    {
+      if (childAssignments[j - begin] == i)
+      {
+        childAssignments.swap_cols(currentCol - begin, j - begin);
+        std::swap(indices[currentCol], indices[j]);
+        ++currentCol;
+      }
+    }
+  }
+  childBegins[numChildren] = currentCol;
+
+  // The gathered values of the node are not needed by the children.
+  childAssignments.reset();
+  nodeIndices.reset();
+  nodeLabels.reset();
+  nodeWeights.reset();
+
+  // Initialize bestGain if recursive split is allowed.
+  if (!NoRecursion)
+    bestGain = 0.0;
+
+  for (size_t i = 0; i < numChildren; ++i)
+  {
+    const size_t childCount = childBegins[i + 1] - childBegins[i];
+    DecisionTree* child = new DecisionTree();
+    if (NoRecursion)
+    {
+      child->TrainIndices<UseWeights>(data, indices, childBegins[i],
+          childCount, datasetInfo, labels, numClasses, weights, childCount,
+          minimumGainSplit, maximumDepth - 1, dimensionSelector, dimensions);
+    }
+    else
+    {
+      // During recursion entropy of child node may change.
+      const double childGain = child->TrainIndices<UseWeights>(data, indices,
+          childBegins[i], childCount, datasetInfo, labels, numClasses, weights,
+          minimumLeafSize, minimumGainSplit, maximumDepth - 1,
+          dimensionSelector, dimensions);
+      bestGain += double(childCount) / double(count) * (-childGain);
+    }
+    children.push_back(child);
+  }
+
+  return -bestGain;
+}
+
+//! Train the node on presorted lists of the points.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<bool UseWeights, typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    NoRecursion>::TrainSorted(
+    const MatType& data,
+    const arma::uvec& indices,
+    arma::umat& sorted,
+    arma::uvec& childAssignments,
+    const size_t begin,
+    const size_t count,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType& dimensionSelector,
+    const arma::uvec& dimensions)
+{
+  using ElemType = typename MatType::elem_type;
+
+  // Clear children if needed.
+  for (size_t i = 0; i < children.size(); ++i)
+    delete children[i];
+  children.clear();
+
+  // We won't be using these members, so reset them.
+  CategoricalAuxiliarySplitInfo::operator=(CategoricalAuxiliarySplitInfo());
+
+  // Gather the values, labels and weights of the node in the order of the
+  // given column of `sorted`.
+  auto dimension = [&](const size_t k)
+  {
+    return (dimensions.n_elem == 0) ? k : (size_t) dimensions[k];
+  };
+  auto gather = [&](const size_t k,
+                    arma::Row<ElemType>& values,
+                    arma::Row<size_t>& nodeLabels,
+                    arma::rowvec& nodeWeights)
+  {
+    const size_t d = dimension(k);
+    values.set_size(count);
+    nodeLabels.set_size(count);
+    if (UseWeights)
+      nodeWeights.set_size(count);
+    for (size_t j = 0; j < count; ++j)
+    {
+      const size_t point = indices[sorted(begin + j, k)];
+      values[j] = data(d, point);
+      nodeLabels[j] = labels[point];
+      if (UseWeights)
+        nodeWeights[j] = weights[point];
+    }
+  };
+
+  arma::Row<ElemType> values;
+  arma::Row<size_t> nodeLabels;
+  arma::rowvec nodeWeights;
+  gather(0, values, nodeLabels, nodeWeights);
+
+  // Look through the list of dimensions and obtain the best split, as Train()
+  // does; the values of each dimension are already sorted.
+  double bestGain = FitnessFunction::template Evaluate<UseWeights>(nodeLabels,
+      numClasses, nodeWeights);
+  size_t bestDim = data.n_rows; // This means "no split".
+
+  if (maximumDepth != 1 && count >= ParallelSplitMinPoints)
+  {
+    // For large nodes, search the dimensions in parallel.
+    std::vector<size_t> selected;
+    for (size_t k = dimensionSelector.Begin(); k != dimensionSelector.End();
+         k = dimensionSelector.Next())
+      selected.push_back(k);
+
+    std::vector<double> dimGains(selected.size());
+    std::vector<arma::vec> dimSplitInfo(selected.size());
+    std::vector<NumericAuxiliarySplitInfo> dimAux(selected.size());
+    #pragma omp parallel
+    {
+      arma::Row<ElemType> dimValues;
+      arma::Row<size_t> dimLabels;
+      arma::rowvec dimWeights;
+
+      #pragma omp for schedule(dynamic)
+      for (size_t i = 0; i < selected.size(); ++i)
+      {
+        gather(selected[i], dimValues, dimLabels, dimWeights);
+        dimGains[i] = NumericSplit::template SplitIfBetterSorted<UseWeights>(
+            bestGain, dimValues, dimLabels, numClasses, dimWeights,
+            minimumLeafSize, minimumGainSplit, dimSplitInfo[i], dimAux[i]);
+      }
+    }
+
+    // Now take the first dimension that improves on the best gain so far, as
+    // the serial search below does.
+    for (size_t i = 0; i < selected.size(); ++i)
+    {
+      if (dimGains[i] == DBL_MAX ||
+          dimGains[i] <= bestGain + minimumGainSplit)
+        continue;
+
+      bestDim = selected[i];
+      bestGain = dimGains[i];
+      classProbabilities = std::move(dimSplitInfo[i]);
+      NumericAuxiliarySplitInfo::operator=(dimAux[i]);
+
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
+    }
+  }
+  else if (maximumDepth != 1)
+  {
+    arma::Row<ElemType> dimValues;
+    arma::Row<size_t> dimLabels;
+    arma::rowvec dimWeights;
+    const size_t end = dimensionSelector.End();
+    for (size_t k = dimensionSelector.Begin(); k != end;
+         k = dimensionSelector.Next())
+    {
+      gather(k, dimValues, dimLabels, dimWeights);
+      const double dimGain = NumericSplit::template
+          SplitIfBetterSorted<UseWeights>(bestGain, dimValues, dimLabels,
+          numClasses, dimWeights, minimumLeafSize, minimumGainSplit,
+          classProbabilities, *this);
+
+      // If the splitter reported that it did not split, move to the next
+      // dimension.
+      if (dimGain == DBL_MAX)
+        continue;
+
+      bestDim = k;
+      bestGain = dimGain;
+
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
+    }
+  }
+
+  if (bestDim == data.n_rows)
+  {
+    // We won't be needing these members, so reset them.
+    NumericAuxiliarySplitInfo::operator=(NumericAuxiliarySplitInfo());
+
+    // Calculate class probabilities because we are a leaf.
+    CalculateClassProbabilities<UseWeights>(nodeLabels, numClasses,
+        nodeWeights);
+    return -bestGain;
+  }
+
+  // We split.  `bestDim` is a column of `sorted`.
+  splitDimension = dimension(bestDim);
+  dimensionType = (size_t) data::Datatype::numeric;
+  const size_t numChildren = NumericSplit::NumChildren(classProbabilities,
+      *this);
+
+  std::vector<size_t> childBegins(numChildren + 1, 0);
+  for (size_t j = begin; j < begin + count; ++j)
+  {
+    const size_t position = sorted(j, 0);
+    const size_t child = NumericSplit::CalculateDirection(
+        data(splitDimension, indices[position]), classProbabilities, *this);
+    childAssignments[position] = child;
+    ++childBegins[child + 1];
+  }
+  childBegins[0] = begin;
+  for (size_t i = 0; i < numChildren; ++i)
+    childBegins[i + 1] += childBegins[i];
+
+  // The gathered values of the node are not needed by the children.
+  values.reset();
+  nodeLabels.reset();
+  nodeWeights.reset();
+
+  // Stably partition the rows of the node between the children, in every
+  // column, so that each child's rows stay sorted.
+  #pragma omp parallel if (count >= ParallelSplitMinPoints)
+  {
+    arma::uvec buffer(count);
+    std::vector<size_t> next(numChildren);
+
+    #pragma omp for
+    for (size_t k = 0; k < sorted.n_cols; ++k)
+    {
+      for (size_t i = 0; i < numChildren; ++i)
+        next[i] = childBegins[i] - begin;
+      for (size_t j = begin; j < begin + count; ++j)
+        buffer[next[childAssignments[sorted(j, k)]]++] = sorted(j, k);
+      std::copy(buffer.begin(), buffer.end(), sorted.colptr(k) + begin);
+    }
+  }
+
+  // Initialize bestGain if recursive split is allowed.
+  if (!NoRecursion)
+    bestGain = 0.0;
+
+  for (size_t i = 0; i < numChildren; ++i)
+  {
+    const size_t childCount = childBegins[i + 1] - childBegins[i];
+    DecisionTree* child = new DecisionTree();
+    if (NoRecursion)
+    {
+      child->TrainSorted<UseWeights>(data, indices, sorted, childAssignments,
+          childBegins[i], childCount, labels, numClasses, weights, childCount,
+          minimumGainSplit, maximumDepth - 1, dimensionSelector, dimensions);
+    }
+    else
+    {
+      // During recursion entropy of child node may change.
+      const double childGain = child->TrainSorted<UseWeights>(data, indices,
+          sorted, childAssignments, childBegins[i], childCount, labels,
+          numClasses, weights, minimumLeafSize, minimumGainSplit,
+          maximumDepth - 1, dimensionSelector, dimensions);
+      bestGain += double(childCount) / double(count) * (-childGain);
+    }
+    children.push_back(child);
+  }
+
+  return -bestGain;
+}
+
 //! Return the class.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
@@ -1127,6 +2000,41 @@ size_t DecisionTree<FitnessFunction,
     return children[0]->NumClasses();
 }
 
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+MemoryReport DecisionTree<FitnessFunction,
+                          NumericSplitType,
+                          CategoricalSplitType,
+                          DimensionSelectionType,
+                          NoRecursion>::MemoryUsage() const
+{
+  size_t numNodes = 0;
+  size_t childrenBytes = 0;
+  size_t probabilitiesBytes = 0;
+
+  std::vector<const DecisionTree*> stack(1, this);
+  while (!stack.empty())
+  {
+    const DecisionTree* node = stack.back();
+    stack.pop_back();
+
+    ++numNodes;
+    childrenBytes += MemoryOf(node->children);
+    probabilitiesBytes += MemoryOf(node->classProbabilities);
+    for (size_t i = 0; i < node->children.size(); ++i)
+      stack.push_back(node->children[i]);
+  }
+
+  MemoryReport report;
+  report.Add("nodes", numNodes * sizeof(DecisionTree));
+  report.Add("children", childrenBytes);
+  report.Add("class probabilities", probabilitiesBytes);
+  return report;
+}
+
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
          template<typename> class CategoricalSplitType,
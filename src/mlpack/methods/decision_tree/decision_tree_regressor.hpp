@@ -45,6 +45,23 @@ class DecisionTreeRegressor :
   //! Allow access to the dimension selection type.
   using DimensionSelection = DimensionSelectionType;
 
+  //! Nodes with at least this many points search the dimensions for the best
+  //! split in parallel.
+  static const size_t ParallelSplitMinPoints = 1000;
+
+  //! Children with at least this many points are built as parallel OpenMP
+  //! tasks, if ParallelSubtrees is true.
+  static const size_t ParallelSubtreeMinPoints = 512;
+
+  //! Whether the subtrees of a node can be built in parallel.  This is only
+  //! the case if neither the dimension selection nor the numeric split draw
+  //! random numbers, so that the tree does not depend on the order in which
+  //! the subtrees are built.
+  static constexpr bool ParallelSubtrees =
+      std::is_same<DimensionSelectionType, AllDimensionSelect>::value &&
+      !std::is_same<NumericSplit,
+                    RandomBinaryNumericSplit<FitnessFunction>>::value;
+
   /**
    * Construct a decision tree without training it.  It will be a leaf node.
    */
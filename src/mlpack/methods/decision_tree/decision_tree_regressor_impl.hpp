@@ -610,6 +610,23 @@ double DecisionTreeRegressor<FitnessFunction,
     DimensionSelectionType& dimensionSelector,
     FitnessFunction fitnessFunction)
 {
+  #ifdef MLPACK_USE_OPENMP
+  if (ParallelSubtrees && count >= ParallelSubtreeMinPoints &&
+      omp_get_level() == 0)
+  {
+    // Start the threads that the tasks of the whole tree will run on.
+    double gain = 0.0;
+    #pragma omp parallel
+    {
+      #pragma omp single
+      gain = Train<UseWeights>(data, begin, count, datasetInfo, responses,
+          weights, minimumLeafSize, minimumGainSplit, maximumDepth,
+          dimensionSelector, fitnessFunction);
+    }
+    return gain;
+  }
+  #endif
+
   // Clear children if needed.
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
@@ -626,49 +643,93 @@ double DecisionTreeRegressor<FitnessFunction,
 
   if (maximumDepth != 1)
   {
+    // Collect the dimensions to try, so that they can be evaluated in
+    // parallel.  Each dimension gets its own split information and its own
+    // copy of the fitness function.
+    std::vector<size_t> dims;
     for (size_t i = dimensionSelector.Begin(); i != end;
          i = dimensionSelector.Next())
+      dims.push_back(i);
+
+    std::vector<double> dimGains(dims.size(), DBL_MAX);
+    std::vector<arma::vec> dimSplitInfo(dims.size());
+    std::vector<NumericAuxiliarySplitInfo> dimNumericAux(dims.size());
+    std::vector<CategoricalAuxiliarySplitInfo> dimCategoricalAux(dims.size());
+
+    // Small nodes are not worth the overhead of parallelism.
+    ParallelFor(dims.size(), count >= ParallelSplitMinPoints, ParallelSubtrees,
+        [&](const size_t d)
     {
-      double dimGain = -DBL_MAX;
+      const size_t i = dims[d];
+      FitnessFunction dimFitnessFunction(fitnessFunction);
       if (datasetInfo.Type(i) == data::Datatype::categorical)
       {
-        dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(bestGain,
+        dimGains[d] = CategoricalSplit::template SplitIfBetter<UseWeights>(
+            bestGain,
             data.cols(begin, begin + count - 1).row(i),
             datasetInfo.NumMappings(i),
             responses.cols(begin, begin + count - 1),
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
             minimumLeafSize,
             minimumGainSplit,
-            splitInfo,
-            *this,
-            fitnessFunction);
+            dimSplitInfo[d],
+            dimCategoricalAux[d],
+            dimFitnessFunction);
       }
       else if (datasetInfo.Type(i) == data::Datatype::numeric)
       {
-        dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
+        dimGains[d] = NumericSplit::template SplitIfBetter<UseWeights>(
+            bestGain,
             data.cols(begin, begin + count - 1).row(i),
             responses.cols(begin, begin + count - 1),
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
             minimumLeafSize,
             minimumGainSplit,
-            splitInfo,
-            *this,
-            fitnessFunction);
+            dimSplitInfo[d],
+            dimNumericAux[d],
+            dimFitnessFunction);
       }
+    });
 
+    size_t bestIndex = dims.size();
+    for (size_t d = 0; d < dims.size(); ++d)
+    {
       // If the splitter reported that it did not split, move to the next
       // dimension.
-      if (dimGain == DBL_MAX)
+      if (dimGains[d] == DBL_MAX)
+        continue;
+
+      // Every dimension was compared against the gain of the unsplit node, so
+      // also make sure that this dimension improves on the best one so far,
+      // exactly like a sequential scan over the dimensions would.
+      if (bestIndex != dims.size() &&
+          dimGains[d] <= std::min(bestGain + minimumGainSplit, 0.0))
         continue;
 
       // Was there an improvement?  If so mark that it's the new best dimension.
-      bestDim = i;
-      bestGain = dimGain;
+      bestIndex = d;
+      bestDim = dims[d];
+      bestGain = dimGains[d];
 
       // If the gain is the best possible, no need to keep looking.
       if (bestGain >= 0.0)
         break;
     }
+
+    if (bestIndex != dims.size())
+    {
+      splitInfo = std::move(dimSplitInfo[bestIndex]);
+      if (datasetInfo.Type(bestDim) == data::Datatype::categorical)
+      {
+        CategoricalAuxiliarySplitInfo::operator=(
+            std::move(dimCategoricalAux[bestIndex]));
+      }
+      else
+      {
+        NumericAuxiliarySplitInfo::operator=(
+            std::move(dimNumericAux[bestIndex]));
+      }
+    }
   }
 
   // Did we split or not?  If so, then split the data and create the children.
@@ -701,23 +762,14 @@ double DecisionTreeRegressor<FitnessFunction,
       }
     }
 
-    // Figure out counts of children.
-    arma::Row<size_t> childCounts(numChildren);
-    for (size_t i = begin; i < begin + count; ++i)
-      childCounts[childAssignments[i - begin]]++;
-
-    // Initialize bestGain if recursive split is allowed.
-    if (!NoRecursion)
-    {
-      bestGain = 0.0;
-    }
-
-    // Split into children.
+    // Split the points into the children, so that the points of each child are
+    // contiguous.
+    std::vector<size_t> childBegins(numChildren + 1);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = currentCol; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -729,26 +781,49 @@ double DecisionTreeRegressor<FitnessFunction,
           ++currentCol;
         }
       }
+    }
+    childBegins[numChildren] = currentCol;
+
+    // Now build the children recursively.  Each child only modifies its own
+    // columns of the data, so large children are built as parallel tasks if
+    // possible.
+    children.resize(numChildren, NULL);
+    std::vector<double> childGains(numChildren, 0.0);
+    auto buildChild = [&](const size_t i)
+    {
+      const size_t childCount = childBegins[i + 1] - childBegins[i];
+
+      // Subtrees built at the same time need their own dimension selector.
+      DimensionSelectionType childSelector;
+      DimensionSelectionType& selector = ParallelSubtrees ?
+          (childSelector = dimensionSelector) : dimensionSelector;
 
-      // Now build the child recursively.
       DecisionTreeRegressor* child = new DecisionTreeRegressor();
-      if (NoRecursion)
-      {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, responses,
-            weights, currentCol - currentChildBegin, minimumGainSplit,
-            maximumDepth - 1, dimensionSelector);
-      }
-      else
+      childGains[i] = child->Train<UseWeights>(data, childBegins[i],
+          childCount, datasetInfo, responses, weights,
+          NoRecursion ? childCount : minimumLeafSize, minimumGainSplit,
+          maximumDepth - 1, selector, fitnessFunction);
+      children[i] = child;
+    };
+
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+      #pragma omp task if (ParallelSubtrees && \
+          childBegins[i + 1] - childBegins[i] >= ParallelSubtreeMinPoints) \
+          shared(buildChild)
+      buildChild(i);
+    }
+    #pragma omp taskwait
+
+    // During recursion entropy of child node may change.
+    if (!NoRecursion)
+    {
+      bestGain = 0.0;
+      for (size_t i = 0; i < numChildren; ++i)
       {
-        // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, responses,
-            weights, minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+        bestGain += double(childBegins[i + 1] - childBegins[i]) /
+            double(count) * (-childGains[i]);
       }
-      children.push_back(child);
     }
   }
   else
@@ -789,6 +864,23 @@ double DecisionTreeRegressor<FitnessFunction,
     DimensionSelectionType& dimensionSelector,
     FitnessFunction fitnessFunction)
 {
+  #ifdef MLPACK_USE_OPENMP
+  if (ParallelSubtrees && count >= ParallelSubtreeMinPoints &&
+      omp_get_level() == 0)
+  {
+    // Start the threads that the tasks of the whole tree will run on.
+    double gain = 0.0;
+    #pragma omp parallel
+    {
+      #pragma omp single
+      gain = Train<UseWeights>(data, begin, count, responses, weights,
+          minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector,
+          fitnessFunction);
+    }
+    return gain;
+  }
+  #endif
+
   // Clear children if needed.
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
@@ -808,34 +900,67 @@ double DecisionTreeRegressor<FitnessFunction,
 
   if (maximumDepth != 1)
   {
+    // Collect the dimensions to try, so that they can be evaluated in
+    // parallel.  Each dimension gets its own split information and its own
+    // copy of the fitness function.
+    std::vector<size_t> dims;
     for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
          i = dimensionSelector.Next())
+      dims.push_back(i);
+
+    std::vector<double> dimGains(dims.size());
+    std::vector<arma::vec> dimSplitInfo(dims.size());
+    std::vector<NumericAuxiliarySplitInfo> dimAux(dims.size());
+
+    // Small nodes are not worth the overhead of parallelism.
+    ParallelFor(dims.size(), count >= ParallelSplitMinPoints, ParallelSubtrees,
+        [&](const size_t d)
     {
-      const double dimGain = NumericSplitType<FitnessFunction>::template
+      FitnessFunction dimFitnessFunction(fitnessFunction);
+      dimGains[d] = NumericSplitType<FitnessFunction>::template
           SplitIfBetter<UseWeights>(bestGain,
-                                    data.cols(begin, begin + count - 1).row(i),
+                                    data.cols(begin, begin + count - 1).row(
+                                        dims[d]),
                                     responses.cols(begin, begin + count - 1),
                                     UseWeights ?
                                         weights.cols(begin, begin + count - 1) :
                                         weights,
                                     minimumLeafSize,
                                     minimumGainSplit,
-                                    splitInfo,
-                                    *this,
-                                    fitnessFunction);
+                                    dimSplitInfo[d],
+                                    dimAux[d],
+                                    dimFitnessFunction);
+    });
 
+    size_t bestIndex = dims.size();
+    for (size_t d = 0; d < dims.size(); ++d)
+    {
       // If the splitter did not report that it improved, then move to the next
       // dimension.
-      if (dimGain == DBL_MAX)
+      if (dimGains[d] == DBL_MAX)
+        continue;
+
+      // Every dimension was compared against the gain of the unsplit node, so
+      // also make sure that this dimension improves on the best one so far,
+      // exactly like a sequential scan over the dimensions would.
+      if (bestIndex != dims.size() &&
+          dimGains[d] <= std::min(bestGain + minimumGainSplit, 0.0))
         continue;
 
-      bestDim = i;
-      bestGain = dimGain;
+      bestIndex = d;
+      bestDim = dims[d];
+      bestGain = dimGains[d];
 
       // If the gain is the best possible, no need to keep looking.
       if (bestGain >= 0.0)
         break;
     }
+
+    if (bestIndex != dims.size())
+    {
+      splitInfo = std::move(dimSplitInfo[bestIndex]);
+      NumericAuxiliarySplitInfo::operator=(std::move(dimAux[bestIndex]));
+    }
   }
 
   // Did we split or not?  If so, then split the data and create the children.
@@ -855,23 +980,14 @@ double DecisionTreeRegressor<FitnessFunction,
           data(bestDim, j), splitInfo, *this);
     }
 
-    // Calculate counts of children in each node.
-    arma::Row<size_t> childCounts(numChildren);
-    childCounts.zeros();
-    for (size_t j = begin; j < begin + count; ++j)
-      childCounts[childAssignments[j - begin]]++;
-
-    // Initialize bestGain if recursive split is allowed.
-    if (!NoRecursion)
-    {
-      bestGain = 0.0;
-    }
-
+    // Split the points into the children, so that the points of each child are
+    // contiguous.
+    std::vector<size_t> childBegins(numChildren + 1);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = currentCol; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -883,26 +999,49 @@ double DecisionTreeRegressor<FitnessFunction,
           ++currentCol;
         }
       }
+    }
+    childBegins[numChildren] = currentCol;
+
+    // Now build the children recursively.  Each child only modifies its own
+    // columns of the data, so large children are built as parallel tasks if
+    // possible.
+    children.resize(numChildren, NULL);
+    std::vector<double> childGains(numChildren, 0.0);
+    auto buildChild = [&](const size_t i)
+    {
+      const size_t childCount = childBegins[i + 1] - childBegins[i];
+
+      // Subtrees built at the same time need their own dimension selector.
+      DimensionSelectionType childSelector;
+      DimensionSelectionType& selector = ParallelSubtrees ?
+          (childSelector = dimensionSelector) : dimensionSelector;
 
-      // Now build the child recursively.
       DecisionTreeRegressor* child = new DecisionTreeRegressor();
-      if (NoRecursion)
-      {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, responses, weights,
-            currentCol - currentChildBegin, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-      }
-      else
+      childGains[i] = child->Train<UseWeights>(data, childBegins[i],
+          childCount, responses, weights,
+          NoRecursion ? childCount : minimumLeafSize, minimumGainSplit,
+          maximumDepth - 1, selector, fitnessFunction);
+      children[i] = child;
+    };
+
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+      #pragma omp task if (ParallelSubtrees && \
+          childBegins[i + 1] - childBegins[i] >= ParallelSubtreeMinPoints) \
+          shared(buildChild)
+      buildChild(i);
+    }
+    #pragma omp taskwait
+
+    // During recursion entropy of child node may change.
+    if (!NoRecursion)
+    {
+      bestGain = 0.0;
+      for (size_t i = 0; i < numChildren; ++i)
       {
-        // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, responses, weights,
-            minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+        bestGain += double(childBegins[i + 1] - childBegins[i]) /
+            double(count) * (-childGains[i]);
       }
-      children.push_back(child);
     }
   }
   else
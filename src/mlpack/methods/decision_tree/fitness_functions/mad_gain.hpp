@@ -121,6 +121,176 @@ class MADGain
       return sum / responses.n_elem;
     }
   }
+
+  /**
+   * Calculates the mean absolute deviation gain for the left and right
+   * children for the current index.
+   *
+   * The deviation of a child around its mean m is
+   *
+   * @f{eqnarray*}{
+   *   \sum\limits_{X_i > m} (X_i - m) + \sum\limits_{X_i \le m} (m - X_i),
+   * @f}
+   *
+   * so it only needs the (weighted) count and sum of the responses of the
+   * child that are at most m; these are prefix sums over the ranks of the
+   * responses, kept in Fenwick trees.
+   */
+  std::tuple<double, double> BinaryGains()
+  {
+    const double rightSize = totalSize - leftSize;
+    const double rightSum = totalSum - leftSum;
+
+    double madLeft = 0.0;
+    if (leftSize > 1e-9)
+    {
+      const double mean = leftSum / leftSize;
+      const size_t rank = RankAbove(mean);
+      const double sizeBelow = PrefixSum(leftSizeTree, rank);
+      const double sumBelow = PrefixSum(leftSumTree, rank);
+      madLeft = Deviation(mean, leftSize, leftSum, sizeBelow, sumBelow) /
+          leftSize;
+    }
+
+    double madRight = 0.0;
+    if (rightSize > 1e-9)
+    {
+      const double mean = rightSum / rightSize;
+      const size_t rank = RankAbove(mean);
+      const double sizeBelow = totalSizePrefix[rank] -
+          PrefixSum(leftSizeTree, rank);
+      const double sumBelow = totalSumPrefix[rank] -
+          PrefixSum(leftSumTree, rank);
+      madRight = Deviation(mean, rightSize, rightSum, sizeBelow, sumBelow) /
+          rightSize;
+    }
+
+    return std::make_tuple(-madLeft, -madRight);
+  }
+
+  /**
+   * Ranks the responses and caches the prefix sums of all of them, so that
+   * the gain of each split can be computed in logarithmic time. The first
+   * `minimum - 1` responses are put in the left child.
+   *
+   * @param responses The set of responses on which statistics are computed.
+   * @param weights The set of weights associated to each response.
+   * @param minimum The minimum number of elements in a leaf.
+   */
+  template<bool UseWeights, typename ResponsesType, typename WeightVecType>
+  void BinaryScanInitialize(const ResponsesType& responses,
+                            const WeightVecType& weights,
+                            const size_t minimum)
+  {
+    const size_t n = responses.n_elem;
+    const arma::uvec order = arma::sort_index(responses);
+
+    ranks.set_size(n);
+    sortedResponses.set_size(n);
+    totalSizePrefix.zeros(n + 1);
+    totalSumPrefix.zeros(n + 1);
+    for (size_t j = 0; j < n; ++j)
+    {
+      const double w = UseWeights ? (double) weights[order[j]] : 1.0;
+      const double x = (double) responses[order[j]];
+
+      ranks[order[j]] = j;
+      sortedResponses[j] = x;
+      totalSizePrefix[j + 1] = totalSizePrefix[j] + w;
+      totalSumPrefix[j + 1] = totalSumPrefix[j] + w * x;
+    }
+    totalSize = totalSizePrefix[n];
+    totalSum = totalSumPrefix[n];
+
+    leftSizeTree.zeros(n + 1);
+    leftSumTree.zeros(n + 1);
+    leftSize = 0.0;
+    leftSum = 0.0;
+    for (size_t i = 0; i < minimum - 1; ++i)
+      BinaryStep<UseWeights>(responses, weights, i);
+  }
+
+  /**
+   * Moves the response at the given index to the left child.
+   *
+   * @param responses The set of responses on which statistics are computed.
+   * @param weights The set of weights associated to each response.
+   * @param index The current index.
+   */
+  template<bool UseWeights, typename ResponsesType, typename WeightVecType>
+  void BinaryStep(const ResponsesType& responses,
+                  const WeightVecType& weights,
+                  const size_t index)
+  {
+    const double w = UseWeights ? (double) weights[index] : 1.0;
+    const double x = (double) responses[index];
+
+    leftSize += w;
+    leftSum += w * x;
+    const size_t n = leftSizeTree.n_elem;
+    for (size_t j = ranks[index] + 1; j < n; j += j & (~j + 1))
+    {
+      leftSizeTree[j] += w;
+      leftSumTree[j] += w * x;
+    }
+  }
+
+ private:
+  //! Returns the number of sorted responses that are at most the given value.
+  size_t RankAbove(const double value) const
+  {
+    return std::upper_bound(sortedResponses.begin(), sortedResponses.end(),
+        value) - sortedResponses.begin();
+  }
+
+  //! Returns the sum of the first `rank` ranks in the given Fenwick tree.
+  static double PrefixSum(const arma::vec& tree, size_t rank)
+  {
+    double sum = 0.0;
+    for (; rank > 0; rank -= rank & (~rank + 1))
+      sum += tree[rank];
+    return sum;
+  }
+
+  /**
+   * Returns the (weighted) absolute deviation around the given mean of a set
+   * with the given size and sum, of which the responses that are at most the
+   * mean have the given size and sum.
+   */
+  static double Deviation(const double mean,
+                          const double size,
+                          const double sum,
+                          const double sizeBelow,
+                          const double sumBelow)
+  {
+    const double deviation = (mean * sizeBelow - sumBelow) +
+        ((sum - sumBelow) - mean * (size - sizeBelow));
+    // Cancellation can make the deviation of a constant set slightly negative.
+    return std::max(deviation, 0.0);
+  }
+
+  /**
+   * The following data members cache statistics for weighted data when
+   * `UseWeights` is true, else it will calculate unweighted statistics.
+   */
+  // The rank of each response among all the responses.
+  arma::Col<size_t> ranks;
+  // The sorted responses.
+  arma::vec sortedResponses;
+  // Prefix sums of the weights (or counts) and of the weighted responses of
+  // all the responses, by rank.
+  arma::vec totalSizePrefix;
+  arma::vec totalSumPrefix;
+  // Fenwick trees over the ranks of the weights (or counts) and of the
+  // weighted responses of the left child.
+  arma::vec leftSizeTree;
+  arma::vec leftSumTree;
+  // Sum of weights (or number of elements) and weighted sum of responses of
+  // the left child and of all the responses.
+  double leftSize;
+  double leftSum;
+  double totalSize;
+  double totalSum;
 };
 
 } // namespace mlpack
@@ -30,7 +30,8 @@ class MultipleRandomDimensionSelect
   MultipleRandomDimensionSelect(const size_t numDimensions = 0) :
         numDimensions(numDimensions),
         i(0),
-        dimensions(0)
+        dimensions(0),
+        useStream(false)
   { }
 
   /**
@@ -52,7 +53,7 @@ class MultipleRandomDimensionSelect
       size_t value;
       while (!unique)
       {
-        value = RandInt(dimensions);
+        value = useStream ? rng.RandInt(dimensions) : RandInt(dimensions);
 
         // Check if we already have the value.
         unique = true;
@@ -93,6 +94,16 @@ class MultipleRandomDimensionSelect
   //! Set the number of dimensions.
   size_t& Dimensions() { return dimensions; }
 
+  /**
+   * Draw the dimensions from the given random stream instead of mlpack's
+   * random number generator (RandomForest gives each tree its own stream).
+   */
+  void SetStream(const PhiloxRNG& stream)
+  {
+    rng = stream;
+    useStream = true;
+  }
+
  private:
   //! The number of dimensions.
   size_t numDimensions;
@@ -102,6 +113,10 @@ class MultipleRandomDimensionSelect
   size_t i;
   //! Number of dimensions.
   size_t dimensions;
+  //! Whether the dimensions are drawn from `rng`.
+  bool useStream;
+  //! The random stream, if `useStream` is true.
+  PhiloxRNG rng;
 };
 
 } // namespace mlpack
@@ -24,12 +24,15 @@ class RandomDimensionSelect
    * Construct the RandomDimensionSelect object with the given number of
    * dimensions.
    */
-  RandomDimensionSelect() : dimensions(0) { }
+  RandomDimensionSelect() : useStream(false), dimensions(0) { }
 
   /**
    * Get the first dimension to select from.
    */
-  size_t Begin() const { return RandInt(dimensions); }
+  size_t Begin()
+  {
+    return useStream ? rng.RandInt(dimensions) : RandInt(dimensions);
+  }
 
   /**
    * Get the last dimension to select from.
@@ -47,7 +50,21 @@ class RandomDimensionSelect
   //! Set the number of dimensions.
   size_t& Dimensions() { return dimensions; }
 
+  /**
+   * Draw the dimensions from the given random stream instead of mlpack's
+   * random number generator (RandomForest gives each tree its own stream).
+   */
+  void SetStream(const PhiloxRNG& stream)
+  {
+    rng = stream;
+    useStream = true;
+  }
+
  private:
+  //! Whether the dimensions are drawn from `rng`.
+  bool useStream;
+  //! The random stream, if `useStream` is true.
+  PhiloxRNG rng;
   //! The number of dimensions to select from.
   size_t dimensions;
 };
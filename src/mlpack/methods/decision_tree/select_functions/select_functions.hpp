@@ -15,5 +15,6 @@
 #include "all_dimension_select.hpp"
 #include "mult_random_dimension_select.hpp"
 #include "random_dimension_select.hpp"
+#include "subset_dimension_select.hpp"
 
 #endif
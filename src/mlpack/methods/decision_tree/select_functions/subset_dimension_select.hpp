@@ -0,0 +1,88 @@
+/**
+ * @file methods/decision_tree/select_functions/subset_dimension_select.hpp
+ *
+ * Selects dimensions from a fixed subset of dimensions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_SUBSET_DIMENSION_SELECT_HPP
+#define MLPACK_METHODS_DECISION_TREE_SUBSET_DIMENSION_SELECT_HPP
+
+namespace mlpack {
+
+/**
+ * This dimension selection policy only allows the dimensions in a fixed subset,
+ * given at construction time, to be selected for splitting.  The same subset is
+ * used for every node of the tree; this can be used for per-tree column
+ * subsampling in ensembles.  If the subset is empty, every dimension can be
+ * selected, like AllDimensionSelect.
+ */
+class SubsetDimensionSelect
+{
+ public:
+  /**
+   * Construct the SubsetDimensionSelect object with the given subset of
+   * dimensions.
+   *
+   * @param subset Dimensions that may be selected.
+   */
+  SubsetDimensionSelect(const arma::uvec& subset = arma::uvec()) :
+      subset(subset),
+      i(0),
+      dimensions(0)
+  { }
+
+  /**
+   * Get the first dimension to select from.
+   */
+  size_t Begin()
+  {
+    i = 0;
+    if (subset.n_elem == 0)
+      return (dimensions == 0) ? End() : 0;
+
+    return subset[0];
+  }
+
+  /**
+   * Get the last dimension to select from.
+   */
+  size_t End() const { return size_t(-1); }
+
+  /**
+   * Get the next dimension.
+   */
+  size_t Next()
+  {
+    ++i;
+    if (subset.n_elem == 0)
+      return (i < dimensions) ? i : End();
+
+    return (i < subset.n_elem) ? subset[i] : End();
+  }
+
+  //! Get the subset of dimensions.
+  const arma::uvec& Subset() const { return subset; }
+  //! Modify the subset of dimensions.
+  arma::uvec& Subset() { return subset; }
+
+  //! Get the number of dimensions.
+  size_t Dimensions() const { return dimensions; }
+  //! Modify the number of dimensions.
+  size_t& Dimensions() { return dimensions; }
+
+ private:
+  //! The dimensions we select from.
+  arma::uvec subset;
+  //! The index of the current dimension in the subset.
+  size_t i;
+  //! The number of dimensions.
+  size_t dimensions;
+};
+
+} // namespace mlpack
+
+#endif
@@ -38,6 +38,18 @@ struct HasOptimizedBinarySplitForms
       std::tuple<double, double>(T::*)()>::value;
 };
 
+/**
+ * SupportsSortedSplit<SplitType>::value is true if the numeric split type
+ * provides a SplitIfBetterSorted() function for classification, which searches
+ * for the best split of values that are already sorted.  DecisionTree can then
+ * sort each dimension once for the whole tree (see DecisionTree::TrainIndices()).
+ */
+template<typename SplitType>
+struct SupportsSortedSplit
+{
+  static const bool value = false;
+};
+
 /**
  * The BestBinaryNumericSplit is a splitting function for decision trees that
  * will exhaustively search a numeric dimension for the best binary split.
@@ -84,6 +96,41 @@ class BestBinaryNumericSplit
       arma::vec& splitInfo,
       AuxiliarySplitInfo& aux);
 
+  /**
+   * Check if we can split a node, given the values of the dimension in
+   * increasing order, and the labels and weights in the same order.  This is
+   * the same as SplitIfBetter() without the sort, so it takes linear time; it
+   * is used by DecisionTree to avoid sorting the same values again at every
+   * node.
+   *
+   * This overload is used only for classification tasks.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param sortedData The values of the dimension, in increasing order.
+   * @param sortedLabels Labels for each point, in the same order.
+   * @param numClasses Number of classes in the dataset.
+   * @param sortedWeights Weights for each point, in the same order (ignored if
+   *      UseWeights is false).
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename WeightVecType>
+  static double SplitIfBetterSorted(
+      const double bestGain,
+      const VecType& sortedData,
+      const arma::Row<size_t>& sortedLabels,
+      const size_t numClasses,
+      const WeightVecType& sortedWeights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux);
+
   /**
    * Check if we can split a node.  If we can split a node in a way that
    * improves on 'bestGain', then we return the improved gain.  Otherwise we
@@ -185,6 +232,13 @@ class BestBinaryNumericSplit
       const AuxiliarySplitInfo& /* aux */);
 };
 
+//! BestBinaryNumericSplit can search sorted values directly.
+template<typename FitnessFunction>
+struct SupportsSortedSplit<BestBinaryNumericSplit<FitnessFunction>>
+{
+  static const bool value = true;
+};
+
 } // namespace mlpack
 
 // Include implementation.
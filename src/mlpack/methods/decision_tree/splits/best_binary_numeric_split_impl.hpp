@@ -26,8 +26,10 @@ double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
     const size_t minimumLeafSize,
     const double minimumGainSplit,
     arma::vec& splitInfo,
-    AuxiliarySplitInfo& /* aux */)
+    AuxiliarySplitInfo& aux)
 {
+  using ElemType = typename VecType::elem_type;
+
   // First sanity check: if we don't have enough points, we can't split.
   if (data.n_elem < (minimumLeafSize * 2))
     return DBL_MAX;
@@ -36,15 +38,14 @@ double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
 
   // Next, sort the data.
   arma::uvec sortedIndices = arma::sort_index(data);
+  arma::Row<ElemType> sortedData(data.n_elem);
   arma::Row<size_t> sortedLabels(labels.n_elem);
   arma::rowvec sortedWeights;
   for (size_t i = 0; i < sortedLabels.n_elem; ++i)
+  {
+    sortedData[i] = data[sortedIndices[i]];
     sortedLabels[i] = labels[sortedIndices[i]];
-
-  // Sanity check: if the first element is the same as the last, we can't split
-  // in this dimension.
-  if (data[sortedIndices[0]] == data[sortedIndices[sortedIndices.n_elem - 1]])
-    return DBL_MAX;
+  }
 
   // Only initialize if we are using weights.
   if (UseWeights)
@@ -55,6 +56,36 @@ double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
       sortedWeights[i] = weights[sortedIndices[i]];
   }
 
+  return SplitIfBetterSorted<UseWeights>(bestGain, sortedData, sortedLabels,
+      numClasses, sortedWeights, minimumLeafSize, minimumGainSplit, splitInfo,
+      aux);
+}
+
+// Overload used for classification, on sorted values.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetterSorted(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& sortedLabels,
+    const size_t numClasses,
+    const WeightVecType& sortedWeights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2) || data.n_elem == 0)
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Sanity check: if the first element is the same as the last, we can't split
+  // in this dimension.
+  if (data[0] == data[data.n_elem - 1])
+    return DBL_MAX;
+
   // Loop through all possible split points, choosing the best one.  Also, force
   // a minimum leaf size of 1 (empty children don't make sense).
   double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
@@ -119,7 +150,7 @@ double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
       ++classCounts(sortedLabels[index - 1], 0);
     }
     // Make sure that the value has changed.
-    if (data[sortedIndices[index - 1]] == data[sortedIndices[index]])
+    if (data[index - 1] == data[index])
       continue;
 
     // Calculate the gain for the left and right child.  Only use weights if
@@ -154,17 +185,17 @@ double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
       // take this one. The actual split value will be halfway between the
       // value at index - 1 and index.
       splitInfo.set_size(1);
-      splitInfo[0] = (data[sortedIndices[index - 1]] +
-          data[sortedIndices[index]]) / 2.0;
+      splitInfo[0] = (data[index - 1] +
+          data[index]) / 2.0;
 
       // In some very extreme cases, floating-point inaccuracies can lead to the
       // split result being the upper bound, which is problematic for later as
       // all the child points will be sent to the left child.  If this happens,
       // bump it down incrementally.
-      if (splitInfo[0] == data[sortedIndices[index]])
+      if (splitInfo[0] == data[index])
       {
         splitInfo[0] = std::nexttoward(splitInfo[0],
-            data[sortedIndices[index - 1]]);
+            data[index - 1]);
       }
 
       return gain;
@@ -174,18 +205,18 @@ double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
       // We still have a better split.
       bestFoundGain = gain;
       splitInfo.set_size(1);
-      splitInfo[0] = (data[sortedIndices[index - 1]] +
-          data[sortedIndices[index]]) / 2.0;
+      splitInfo[0] = (data[index - 1] +
+          data[index]) / 2.0;
       improved = true;
 
       // In some very extreme cases, floating-point inaccuracies can lead to the
       // split result being the upper bound, which is problematic for later as
       // all the child points will be sent to the left child.  If this happens,
       // bump it down incrementally.
-      if (splitInfo[0] == data[sortedIndices[index]])
+      if (splitInfo[0] == data[index])
       {
         splitInfo[0] = std::nexttoward(splitInfo[0],
-            data[sortedIndices[index - 1]]);
+            data[index - 1]);
       }
     }
   }
@@ -0,0 +1,200 @@
+/**
+ * @file methods/decision_tree/splits/histogram_categorical_split.hpp
+ *
+ * A tree splitter that finds a binary categorical split by ordering the
+ * categories by their statistics, and then splitting them with the histogram
+ * numeric split.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_SPLITS_HISTOGRAM_CATEGORICAL_SPLIT_HPP
+#define MLPACK_METHODS_DECISION_TREE_SPLITS_HISTOGRAM_CATEGORICAL_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "histogram_numeric_split.hpp"
+
+namespace mlpack {
+
+/**
+ * The HistogramCategoricalSplit is a splitting function for decision trees
+ * that finds a binary split of a categorical dimension, and is meant for
+ * dimensions with many categories (where AllCategoricalSplit would create too
+ * many children, and BestBinaryCategoricalSplit is too slow).  As is done by
+ * histogram-based tree learners such as LightGBM, a single pass over the points
+ * in the node accumulates the statistics of each category, and the categories
+ * are sorted by a score:
+ *
+ *  - for classification with two classes, the proportion of the second class
+ *    (which gives the optimal split, see BestBinaryCategoricalSplit);
+ *  - for classification with more classes, the proportion of the most frequent
+ *    class of the node (a heuristic);
+ *  - for regression, the (weighted) mean response.  For the trees of XGBoost,
+ *    whose responses are -g / h with weights h, this is the ratio of the sums
+ *    of the gradients and hessians of each category.
+ *
+ * Categories with the same score are merged, and if there are more than
+ * MaxGroups categories, consecutive categories in that order are also merged
+ * into at most MaxGroups groups of at least about n / MaxGroups points.  The
+ * best split between two groups is then found by HistogramNumericSplit on the
+ * group index of each point, so that a split is found in O(n + J log J) time
+ * for J categories in the node.
+ * The categories that are not in the node are sent to the larger child.
+ *
+ * @tparam FitnessFunction Fitness function to use to calculate gain.
+ */
+template<typename FitnessFunction>
+class HistogramCategoricalSplit
+{
+ public:
+  // No extra info needed for split.
+  class AuxiliarySplitInfo { };
+
+  //! The maximum number of groups of categories.
+  static const size_t MaxGroups =
+      HistogramNumericSplit<FitnessFunction>::MaxBins;
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on bestGain, then we return the improved gain.  Otherwise we
+   * return the value DBL_MAX.
+   *
+   * This overload is used only for classification.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param numCategories Number of categories in the categorical data.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights associated with labels.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.  A vector
+   *      of size J, where J is the number of categories; splitInfo[k] is zero
+   *      if category k is assigned to the left child, and one otherwise.
+   * @param aux (ignored)
+   */
+  template<bool UseWeights, typename VecType, typename LabelsType,
+           typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const size_t numCategories,
+      const LabelsType& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux);
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on bestGain, then we return the improved gain.  Otherwise we
+   * return the value DBL_MAX.
+   *
+   * This overload is used only for regression.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param numCategories Number of categories in the categorical data.
+   * @param responses Responses for each point.
+   * @param weights Weights associated with responses.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.  A vector
+   *      of size J, where J is the number of categories; splitInfo[k] is zero
+   *      if category k is assigned to the left child, and one otherwise.
+   * @param aux (ignored)
+   * @param fitnessFunction The FitnessFunction object instance. It is used to
+   *      evaluate the gain for the split.
+   */
+  template<bool UseWeights, typename VecType, typename ResponsesType,
+           typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const size_t numCategories,
+      const ResponsesType& responses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux,
+      FitnessFunction& fitnessFunction);
+
+  /**
+   * If a split was found, returns the number of children of the split.
+   * Otherwise returns zero. A binary split always has two children.
+   */
+  static size_t NumChildren(const arma::vec& splitInfo,
+                            const AuxiliarySplitInfo& /* aux */)
+  {
+    return splitInfo.n_elem == 0 ? 0 : 2;
+  }
+
+  /**
+   * In the case that a split was found, given a point, calculates the index of
+   * the child it should go to. Otherwise if there was no split, returns
+   * SIZE_MAX.
+   *
+   * @param point The category of the point.
+   * @param splitInfo Auxiliary information for the split.
+   * @param * (aux) Auxiliary information for the split (Unused).
+   */
+  template<typename ElemType>
+  static size_t CalculateDirection(
+      const ElemType& point,
+      const arma::vec& splitInfo,
+      const AuxiliarySplitInfo& /* aux */)
+  {
+    return splitInfo.n_elem == 0 ? SIZE_MAX : (size_t) splitInfo[point];
+  }
+
+ private:
+  /**
+   * Sort the categories that are in the node by score, merge them into at
+   * most MaxGroups groups, and compute the group index of each point.  If
+   * there are fewer than two categories in the node, false is returned.
+   *
+   * @param data The category of each point.
+   * @param scores Score of each category.
+   * @param counts Number of points of each category.
+   * @param groups Set to the group index of each point.
+   * @param categoryGroups Set to the group index of each category (-1 for the
+   *      categories that are not in the node).
+   */
+  template<typename VecType>
+  static bool GroupCategories(const VecType& data,
+                              const arma::vec& scores,
+                              const arma::Col<size_t>& counts,
+                              arma::rowvec& groups,
+                              arma::vec& categoryGroups);
+
+  /**
+   * Convert the split found on the group indices to a split of the
+   * categories.
+   *
+   * @param categoryGroups Group index of each category.
+   * @param counts Number of points of each category.
+   * @param groupSplitInfo Split information of the numeric split.
+   * @param splitInfo Set to the direction of each category.
+   */
+  static void SetSplitInfo(const arma::vec& categoryGroups,
+                           const arma::Col<size_t>& counts,
+                           const arma::vec& groupSplitInfo,
+                           arma::vec& splitInfo);
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "histogram_categorical_split_impl.hpp"
+
+#endif
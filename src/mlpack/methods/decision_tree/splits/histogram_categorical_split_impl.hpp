@@ -0,0 +1,241 @@
+/**
+ * @file methods/decision_tree/splits/histogram_categorical_split_impl.hpp
+ *
+ * Implementation of the strategy that finds a binary categorical split by
+ * ordering the categories by their statistics.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_SPLITS_HISTOGRAM_CATEGORICAL_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_SPLITS_HISTOGRAM_CATEGORICAL_SPLIT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "histogram_categorical_split.hpp"
+
+namespace mlpack {
+
+// Overload used for classification.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename LabelsType,
+         typename WeightVecType>
+double HistogramCategoricalSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const size_t numCategories,
+    const LabelsType& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Build the histogram: the class weight sums of each category.
+  arma::mat classWeightSums(numClasses, numCategories, arma::fill::zeros);
+  arma::Col<size_t> counts(numCategories, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t category = (size_t) data[i];
+    classWeightSums(labels[i], category) += UseWeights ?
+        (double) weights[i] : 1.0;
+    ++counts[category];
+  }
+
+  // Order the categories by the proportion of the second class (or of the
+  // most frequent class, if there are more than two classes).
+  const size_t orderClass = (numClasses == 2) ? 1 :
+      (size_t) arma::sum(classWeightSums, 1).index_max();
+  const arma::rowvec categoryWeights = arma::sum(classWeightSums, 0);
+  arma::vec scores(numCategories, arma::fill::zeros);
+  for (size_t c = 0; c < numCategories; ++c)
+  {
+    if (categoryWeights[c] > 0.0)
+      scores[c] = classWeightSums(orderClass, c) / categoryWeights[c];
+  }
+
+  arma::rowvec groups;
+  arma::vec categoryGroups;
+  if (!GroupCategories(data, scores, counts, groups, categoryGroups))
+    return DBL_MAX;
+
+  arma::vec groupSplitInfo;
+  typename HistogramNumericSplit<FitnessFunction>::AuxiliarySplitInfo
+      groupAux;
+  const double gain = HistogramNumericSplit<FitnessFunction>::template
+      SplitIfBetter<UseWeights>(bestGain, groups, labels, numClasses, weights,
+      minimumLeafSize, minimumGainSplit, groupSplitInfo, groupAux);
+  if (gain == DBL_MAX)
+    return DBL_MAX;
+
+  SetSplitInfo(categoryGroups, counts, groupSplitInfo, splitInfo);
+  return gain;
+}
+
+// Overload used for regression.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType>
+double HistogramCategoricalSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const size_t numCategories,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */,
+    FitnessFunction& fitnessFunction)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Build the histogram: the weighted response sums and the weight sums of
+  // each category, and order the categories by their mean response.
+  arma::vec responseSums(numCategories, arma::fill::zeros);
+  arma::vec weightSums(numCategories, arma::fill::zeros);
+  arma::Col<size_t> counts(numCategories, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t category = (size_t) data[i];
+    const double w = UseWeights ? (double) weights[i] : 1.0;
+    responseSums[category] += w * (double) responses[i];
+    weightSums[category] += w;
+    ++counts[category];
+  }
+
+  arma::vec scores(numCategories, arma::fill::zeros);
+  for (size_t c = 0; c < numCategories; ++c)
+  {
+    if (weightSums[c] > 0.0)
+      scores[c] = responseSums[c] / weightSums[c];
+  }
+
+  arma::rowvec groups;
+  arma::vec categoryGroups;
+  if (!GroupCategories(data, scores, counts, groups, categoryGroups))
+    return DBL_MAX;
+
+  arma::vec groupSplitInfo;
+  typename HistogramNumericSplit<FitnessFunction>::AuxiliarySplitInfo
+      groupAux;
+  const double gain = HistogramNumericSplit<FitnessFunction>::template
+      SplitIfBetter<UseWeights>(bestGain, groups, responses, weights,
+      minimumLeafSize, minimumGainSplit, groupSplitInfo, groupAux,
+      fitnessFunction);
+  if (gain == DBL_MAX)
+    return DBL_MAX;
+
+  SetSplitInfo(categoryGroups, counts, groupSplitInfo, splitInfo);
+  return gain;
+}
+
+template<typename FitnessFunction>
+template<typename VecType>
+bool HistogramCategoricalSplit<FitnessFunction>::GroupCategories(
+    const VecType& data,
+    const arma::vec& scores,
+    const arma::Col<size_t>& counts,
+    arma::rowvec& groups,
+    arma::vec& categoryGroups)
+{
+  // Only the categories that are in the node are sorted.
+  std::vector<size_t> categories;
+  for (size_t c = 0; c < counts.n_elem; ++c)
+    if (counts[c] > 0)
+      categories.push_back(c);
+
+  if (categories.size() < 2)
+    return false;
+
+  std::stable_sort(categories.begin(), categories.end(),
+      [&scores](const size_t a, const size_t b)
+      {
+        return scores[a] < scores[b];
+      });
+
+  // Categories with the same score are always in the same group.  If there are
+  // too many categories, consecutive categories are also merged so that each
+  // group has at least about data.n_elem / MaxGroups points.  The group indices
+  // are consecutive, so that each group gets its own bin in
+  // HistogramNumericSplit.
+  const bool merge = (categories.size() > MaxGroups);
+  categoryGroups.set_size(counts.n_elem);
+  categoryGroups.fill(-1.0);
+  size_t numPoints = 0;
+  size_t groupQuantile = 0;
+  size_t group = 0;
+  for (size_t k = 0; k < categories.size(); ++k)
+  {
+    const size_t c = categories[k];
+    const size_t quantile = numPoints * MaxGroups / data.n_elem;
+    if (k > 0 && scores[c] != scores[categories[k - 1]] &&
+        (!merge || quantile != groupQuantile))
+    {
+      ++group;
+      groupQuantile = quantile;
+    }
+
+    categoryGroups[c] = (double) group;
+    numPoints += counts[c];
+  }
+
+  // Every category may have been merged into the same group.
+  if (group == 0)
+    return false;
+
+  groups.set_size(data.n_elem);
+  for (size_t i = 0; i < data.n_elem; ++i)
+    groups[i] = categoryGroups[(size_t) data[i]];
+
+  return true;
+}
+
+template<typename FitnessFunction>
+void HistogramCategoricalSplit<FitnessFunction>::SetSplitInfo(
+    const arma::vec& categoryGroups,
+    const arma::Col<size_t>& counts,
+    const arma::vec& groupSplitInfo,
+    arma::vec& splitInfo)
+{
+  splitInfo.set_size(categoryGroups.n_elem);
+  size_t leftCount = 0, rightCount = 0;
+  for (size_t c = 0; c < categoryGroups.n_elem; ++c)
+  {
+    if (categoryGroups[c] < 0.0)
+      continue;
+
+    if (categoryGroups[c] <= groupSplitInfo[0])
+    {
+      splitInfo[c] = 0;
+      leftCount += counts[c];
+    }
+    else
+    {
+      splitInfo[c] = 1;
+      rightCount += counts[c];
+    }
+  }
+
+  // The categories that are not in the node go to the larger child.
+  const double largerChild = (leftCount >= rightCount) ? 0 : 1;
+  for (size_t c = 0; c < categoryGroups.n_elem; ++c)
+    if (categoryGroups[c] < 0.0)
+      splitInfo[c] = largerChild;
+}
+
+} // namespace mlpack
+
+#endif
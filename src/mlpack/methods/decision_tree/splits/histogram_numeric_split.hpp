@@ -0,0 +1,230 @@
+/**
+ * @file methods/decision_tree/splits/histogram_numeric_split.hpp
+ *
+ * A tree splitter that finds the best binary numeric split on a histogram of
+ * the data, instead of on the sorted data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_SPLITS_HISTOGRAM_NUMERIC_SPLIT_HPP
+#define MLPACK_METHODS_DECISION_TREE_SPLITS_HISTOGRAM_NUMERIC_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "best_binary_numeric_split.hpp"
+
+namespace mlpack {
+
+/**
+ * The HistogramNumericSplit is a splitting function for decision trees that
+ * quantizes a numeric dimension into (at most) 256 equal-width bins over the
+ * range of the values in the node, accumulates the label counts (or response
+ * statistics) of each bin, and then only considers splits between bins.  This
+ * is the strategy used by histogram-based tree learners such as LightGBM.
+ *
+ * Building the histogram takes a single linear pass over the points in the
+ * node, so a split can be found in O(n + bins) time for classification, instead
+ * of the O(n log n) time needed by BestBinaryNumericSplit to sort the data.
+ * During the scan over the bins, the statistics of the right child are obtained
+ * by subtracting those of the left child from the node's totals, so the
+ * histogram is only built once.  If there are no more than 256 distinct values
+ * in the node, the found split is the same as that of BestBinaryNumericSplit
+ * (as long as each value falls in its own bin).
+ *
+ * The split value is always halfway between the largest value on the left and
+ * the smallest value on the right, so that points are directed exactly as they
+ * were during training.
+ *
+ * @tparam FitnessFunction Fitness function to use to calculate gain.
+ */
+template<typename FitnessFunction>
+class HistogramNumericSplit
+{
+ public:
+  // No extra info needed for split.
+  class AuxiliarySplitInfo { };
+
+  //! The maximum number of bins used for each dimension.
+  static const size_t MaxBins = 256;
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then splitInfo and aux
+   * may be modified.
+   *
+   * This overload is used only for classification tasks.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights associated with labels.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const arma::Row<size_t>& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux);
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then splitInfo and aux
+   * may be modified.
+   *
+   * This overload is used only for regression tasks.  The points are ordered
+   * by bin with a counting sort, and the fitness function is evaluated only at
+   * bin boundaries.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param responses Responses for each point.
+   * @param weights Weights associated with responses.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   * @param fitnessFunction The FitnessFunction object instance. It is used to
+   *      evaluate the gain for the split.
+   */
+  template<bool UseWeights, typename VecType, typename ResponsesType,
+           typename WeightVecType>
+  static std::enable_if_t<
+      !HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+      double>
+  SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const ResponsesType& responses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux,
+      FitnessFunction& fitnessFunction);
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then splitInfo and aux
+   * may be modified.
+   *
+   * This overload is specialized for any fitness function that implements
+   * BinaryScanInitialize(), BinaryStep() and BinaryGains() functions.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param responses Responses for each point.
+   * @param weights Weights associated with responses.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename ResponsesType,
+          typename WeightVecType>
+  static std::enable_if_t<
+      HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+      double>
+  SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const ResponsesType& responses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& /* aux */,
+      FitnessFunction& fitnessFunction);
+
+  /**
+   * If a split was found, returns the number of children of the split.
+   * Otherwise returns zero. A binary split always has two children.
+   */
+  static size_t NumChildren(const arma::vec& splitInfo,
+                            const AuxiliarySplitInfo& /* aux */)
+  {
+    return splitInfo.n_elem == 0 ? 0 : 2;
+  }
+
+  /**
+   * In the case that a split was found, given a point, calculate
+   * which child it should go to (left or right). Otherwise if
+   * there was no split, returns SIZE_MAX.
+   *
+   * @param point Point to calculate direction of.
+   * @param splitInfo Auxiliary information for the split.
+   * @param * (aux) Auxiliary information for the split (Unused).
+   */
+  template<typename ElemType>
+  static size_t CalculateDirection(
+      const ElemType& point,
+      const arma::vec& splitInfo,
+      const AuxiliarySplitInfo& /* aux */);
+
+ private:
+  /**
+   * Compute the bin of each value in `data`, using at most MaxBins equal-width
+   * bins over the range of `data`, and the smallest and largest value in each
+   * bin.  If all values are the same, false is returned.
+   *
+   * @param data Values to compute bins of.
+   * @param bins Set to the bin of each value.
+   * @param binMin Set to the smallest value in each bin (DBL_MAX if empty).
+   * @param binMax Set to the largest value in each bin (-DBL_MAX if empty).
+   */
+  template<typename VecType>
+  static bool ComputeBins(const VecType& data,
+                          arma::uvec& bins,
+                          arma::vec& binMin,
+                          arma::vec& binMax);
+
+  /**
+   * Compute the order of the points when they are sorted by bin, with a
+   * counting sort.
+   *
+   * @param bins Bin of each point.
+   * @param numBins Number of bins.
+   * @param order Set to the indices of the points, in order of bin.
+   */
+  static void SortByBin(const arma::uvec& bins,
+                        const size_t numBins,
+                        arma::uvec& order);
+
+  /**
+   * Store the split value halfway between `leftMax` and `rightMin` in
+   * `splitInfo`, making sure that it is strictly less than `rightMin`.
+   */
+  static void SetSplitValue(const double leftMax,
+                            const double rightMin,
+                            arma::vec& splitInfo);
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "histogram_numeric_split_impl.hpp"
+
+#endif
@@ -0,0 +1,567 @@
+/**
+ * @file methods/decision_tree/splits/histogram_numeric_split_impl.hpp
+ *
+ * Implementation of strategy that finds the best binary numeric split on a
+ * histogram of the data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_SPLITS_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_SPLITS_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "histogram_numeric_split.hpp"
+
+namespace mlpack {
+
+// Overload used for classification.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Quantize the data.  If all values are the same, we can't split in this
+  // dimension.
+  arma::uvec bins;
+  arma::vec binMin, binMax;
+  if (!ComputeBins(data, bins, binMin, binMax))
+    return DBL_MAX;
+  const size_t numBins = binMin.n_elem;
+
+  // Build the histogram: the class counts (or class weight sums) of the points
+  // in each bin.
+  arma::Mat<size_t> classCounts;
+  arma::mat classWeightSums;
+  arma::Row<size_t> binCounts(numBins, arma::fill::zeros);
+  arma::rowvec binWeights;
+  if (UseWeights)
+  {
+    classWeightSums.zeros(numClasses, numBins);
+    binWeights.zeros(numBins);
+    for (size_t i = 0; i < data.n_elem; ++i)
+    {
+      classWeightSums(labels[i], bins[i]) += weights[i];
+      binWeights[bins[i]] += weights[i];
+      ++binCounts[bins[i]];
+    }
+  }
+  else
+  {
+    classCounts.zeros(numClasses, numBins);
+    for (size_t i = 0; i < data.n_elem; ++i)
+    {
+      ++classCounts(labels[i], bins[i]);
+      ++binCounts[bins[i]];
+    }
+  }
+
+  // The smallest value to the right of each bin.
+  arma::vec rightMin(numBins);
+  rightMin[numBins - 1] = DBL_MAX;
+  for (size_t b = numBins - 1; b > 0; --b)
+    rightMin[b - 1] = std::min(binMin[b], rightMin[b]);
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  // The left child starts empty, and the right child holds every point.  As we
+  // scan over the bins, the statistics of the right child are the node's
+  // totals minus those of the left child.
+  arma::Col<size_t> leftCounts, rightCounts;
+  arma::vec leftWeightSums, rightWeightSums;
+  double totalWeight = 0.0;
+  double totalLeftWeight = 0.0;
+  double totalRightWeight = 0.0;
+  if (UseWeights)
+  {
+    leftWeightSums.zeros(numClasses);
+    rightWeightSums = arma::sum(classWeightSums, 1);
+    totalWeight = arma::accu(binWeights);
+    totalRightWeight = totalWeight;
+    bestFoundGain *= totalWeight;
+  }
+  else
+  {
+    leftCounts.zeros(numClasses);
+    rightCounts = arma::sum(classCounts, 1);
+    bestFoundGain *= data.n_elem;
+  }
+
+  size_t leftSize = 0;
+  for (size_t b = 0; b < numBins - 1; ++b)
+  {
+    if (binCounts[b] == 0)
+      continue;
+
+    // Move the points in this bin to the left child.
+    if (UseWeights)
+    {
+      leftWeightSums += classWeightSums.col(b);
+      rightWeightSums -= classWeightSums.col(b);
+      totalLeftWeight += binWeights[b];
+      totalRightWeight -= binWeights[b];
+    }
+    else
+    {
+      leftCounts += classCounts.col(b);
+      rightCounts -= classCounts.col(b);
+    }
+    leftSize += binCounts[b];
+
+    const size_t rightSize = data.n_elem - leftSize;
+    if (leftSize < minimum)
+      continue;
+    if (rightSize < minimum)
+      break;
+
+    // Calculate the gain for the left and right child.  Only use weights if
+    // needed.
+    const double leftGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(leftWeightSums.memptr(),
+            numClasses, totalLeftWeight) :
+        FitnessFunction::template EvaluatePtr<false>(leftCounts.memptr(),
+            numClasses, leftSize);
+    const double rightGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(rightWeightSums.memptr(),
+            numClasses, totalRightWeight) :
+        FitnessFunction::template EvaluatePtr<false>(rightCounts.memptr(),
+            numClasses, rightSize);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this split point.
+      gain = double(leftSize) * leftGain + double(rightSize) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.
+      SetSplitValue(binMax[b], rightMin[b], splitInfo);
+      return gain;
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      SetSplitValue(binMax[b], rightMin[b], splitInfo);
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+// Overload used for regression.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType>
+std::enable_if_t<
+    !HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+    double>
+HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */,
+    FitnessFunction& fitnessFunction)
+{
+  using RType = typename ResponsesType::elem_type;
+  using WType = typename WeightVecType::elem_type;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Quantize the data, and order the points by bin.
+  arma::uvec bins;
+  arma::vec binMin, binMax;
+  if (!ComputeBins(data, bins, binMin, binMax))
+    return DBL_MAX;
+
+  arma::uvec order;
+  SortByBin(bins, binMin.n_elem, order);
+
+  arma::Row<RType> sortedResponses(responses.n_elem);
+  arma::Row<WType> sortedWeights;
+  for (size_t i = 0; i < sortedResponses.n_elem; ++i)
+    sortedResponses[i] = responses[order[i]];
+
+  // Only initialize if we are using weights.
+  if (UseWeights)
+  {
+    sortedWeights.set_size(sortedResponses.n_elem);
+    // The weights must keep the same order as the responses.
+    for (size_t i = 0; i < sortedResponses.n_elem; ++i)
+      sortedWeights[i] = weights[order[i]];
+  }
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  WType totalWeight = 0.0;
+  WType totalLeftWeight = 0.0;
+  WType totalRightWeight = 0.0;
+
+  if (UseWeights)
+  {
+    totalWeight = accu(sortedWeights);
+    bestFoundGain *= totalWeight;
+
+    for (size_t i = 0; i < minimum - 1; ++i)
+      totalLeftWeight += sortedWeights[i];
+
+    for (size_t i = minimum - 1; i < data.n_elem; ++i)
+      totalRightWeight += sortedWeights[i];
+  }
+  else
+  {
+    bestFoundGain *= data.n_elem;
+  }
+
+  // Loop through all bin boundaries, choosing the best one.
+  for (size_t index = minimum; index < data.n_elem - minimum + 1; ++index)
+  {
+    if (UseWeights)
+    {
+      totalLeftWeight += sortedWeights[index - 1];
+      totalRightWeight -= sortedWeights[index - 1];
+    }
+
+    // We can only split between bins.
+    const size_t leftBin = bins[order[index - 1]];
+    const size_t rightBin = bins[order[index]];
+    if (leftBin == rightBin)
+      continue;
+
+    // Calculate the gain for the left and right child.
+    const double leftGain = fitnessFunction.template
+        Evaluate<UseWeights>(sortedResponses, sortedWeights, 0, index);
+    const double rightGain = fitnessFunction.template
+        Evaluate<UseWeights>(sortedResponses, sortedWeights, index,
+            responses.n_elem);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this split point.
+      gain = double(index) * leftGain +
+          double(sortedResponses.n_elem - index) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.
+      SetSplitValue(binMax[leftBin], binMin[rightBin], splitInfo);
+      return gain;
+    }
+    if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      SetSplitValue(binMax[leftBin], binMin[rightBin], splitInfo);
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+// Optimized version for any fitness function that implements
+// BinaryScanInitialize(), BinaryStep() and BinaryGains() functions.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType>
+std::enable_if_t<
+    HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+    double>
+HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */,
+    FitnessFunction& fitnessFunction)
+{
+  using RType = typename ResponsesType::elem_type;
+  using WType = typename WeightVecType::elem_type;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Quantize the data, and order the points by bin.
+  arma::uvec bins;
+  arma::vec binMin, binMax;
+  if (!ComputeBins(data, bins, binMin, binMax))
+    return DBL_MAX;
+
+  arma::uvec order;
+  SortByBin(bins, binMin.n_elem, order);
+
+  arma::Row<RType> sortedResponses(responses.n_elem);
+  arma::Row<WType> sortedWeights;
+  for (size_t i = 0; i < sortedResponses.n_elem; ++i)
+    sortedResponses[i] = responses[order[i]];
+
+  // Only initialize if we are using weights.
+  if (UseWeights)
+  {
+    sortedWeights.set_size(sortedResponses.n_elem);
+    // The weights must keep the same order as the responses.
+    for (size_t i = 0; i < sortedResponses.n_elem; ++i)
+      sortedWeights[i] = weights[order[i]];
+  }
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  WType totalWeight = 0.0;
+  WType leftChildWeight = 0.0;
+  WType rightChildWeight = 0.0;
+
+  if (UseWeights)
+  {
+    totalWeight = accu(sortedWeights);
+    bestFoundGain *= totalWeight;
+
+    for (size_t i = 0; i < minimum - 1; ++i)
+      leftChildWeight += sortedWeights[i];
+
+    for (size_t i = minimum - 1; i < data.n_elem; ++i)
+      rightChildWeight += sortedWeights[i];
+  }
+  else
+  {
+    bestFoundGain *= data.n_elem;
+  }
+
+  // Initialize and precompute various statistics to efficiently compute gain
+  // values for all possible splits.
+  fitnessFunction.template BinaryScanInitialize<UseWeights>(sortedResponses,
+      sortedWeights, minimum);
+
+  // Loop through all bin boundaries, choosing the best one.
+  for (size_t index = minimum; index < data.n_elem - minimum + 1; ++index)
+  {
+    if (UseWeights)
+    {
+      leftChildWeight += sortedWeights[index - 1];
+      rightChildWeight -= sortedWeights[index - 1];
+    }
+
+    // Steps through the current index and updates the cached data.
+    fitnessFunction.template BinaryStep<UseWeights>(sortedResponses,
+        sortedWeights, index - 1);
+
+    // We can only split between bins.
+    const size_t leftBin = bins[order[index - 1]];
+    const size_t rightBin = bins[order[index]];
+    if (leftBin == rightBin)
+      continue;
+
+    // Calculate the gain for the left and right child.
+    std::tuple<double, double> binaryGains = fitnessFunction.BinaryGains();
+    const double leftGain = std::get<0>(binaryGains);
+    const double rightGain = std::get<1>(binaryGains);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = leftChildWeight * leftGain + rightChildWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this split point.
+      gain = double(index) * leftGain +
+          double(sortedResponses.n_elem - index) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.
+      SetSplitValue(binMax[leftBin], binMin[rightBin], splitInfo);
+      return gain;
+    }
+    if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      SetSplitValue(binMax[leftBin], binMin[rightBin], splitInfo);
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t HistogramNumericSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const arma::vec& splitInfo,
+    const AuxiliarySplitInfo& /* aux */)
+{
+  if (splitInfo.n_elem == 0)
+    return SIZE_MAX;
+  else if (point <= splitInfo[0])
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+template<typename FitnessFunction>
+template<typename VecType>
+bool HistogramNumericSplit<FitnessFunction>::ComputeBins(
+    const VecType& data,
+    arma::uvec& bins,
+    arma::vec& binMin,
+    arma::vec& binMax)
+{
+  const double minValue = (double) min(data);
+  const double maxValue = (double) max(data);
+  // We can't split if every value is the same (or the range is not finite).
+  if (!(maxValue > minValue) || !std::isfinite(maxValue - minValue))
+    return false;
+
+  const size_t numBins = std::min(MaxBins, (size_t) data.n_elem);
+  const double scale = double(numBins) / (maxValue - minValue);
+
+  bins.set_size(data.n_elem);
+  binMin.set_size(numBins);
+  binMin.fill(DBL_MAX);
+  binMax.set_size(numBins);
+  binMax.fill(-DBL_MAX);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const double value = (double) data[i];
+    // The largest value would fall just past the last bin.
+    const size_t bin = std::min((size_t) ((value - minValue) * scale),
+        numBins - 1);
+
+    bins[i] = bin;
+    binMin[bin] = std::min(binMin[bin], value);
+    binMax[bin] = std::max(binMax[bin], value);
+  }
+
+  return true;
+}
+
+template<typename FitnessFunction>
+void HistogramNumericSplit<FitnessFunction>::SortByBin(
+    const arma::uvec& bins,
+    const size_t numBins,
+    arma::uvec& order)
+{
+  // Compute the position of the first point of each bin.
+  arma::uvec binStarts(numBins + 1, arma::fill::zeros);
+  for (size_t i = 0; i < bins.n_elem; ++i)
+    ++binStarts[bins[i] + 1];
+  for (size_t b = 1; b <= numBins; ++b)
+    binStarts[b] += binStarts[b - 1];
+
+  order.set_size(bins.n_elem);
+  for (size_t i = 0; i < bins.n_elem; ++i)
+    order[binStarts[bins[i]]++] = i;
+}
+
+template<typename FitnessFunction>
+void HistogramNumericSplit<FitnessFunction>::SetSplitValue(
+    const double leftMax,
+    const double rightMin,
+    arma::vec& splitInfo)
+{
+  // The actual split value will be halfway between the largest value on the
+  // left and the smallest value on the right.
+  splitInfo.set_size(1);
+  splitInfo[0] = (leftMax + rightMin) / 2.0;
+
+  // In some very extreme cases, floating-point inaccuracies can lead to the
+  // split result being the upper bound, which is problematic for later as all
+  // the child points will be sent to the left child.  If this happens, bump it
+  // down incrementally.
+  if (splitInfo[0] == rightMin)
+    splitInfo[0] = std::nexttoward(splitInfo[0], leftMax);
+}
+
+} // namespace mlpack
+
+#endif
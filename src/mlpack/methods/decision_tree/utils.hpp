@@ -134,6 +134,37 @@ inline void Sum(const VecType& values,
   mean = total[0];
 }
 
+/**
+ * Call `f(i)` for each i in [0, n), in parallel if `parallel` is true.  If
+ * `useTasks` is true and the caller is already in a parallel region (as while
+ * the subtrees of a decision tree are built by OpenMP tasks), one task is
+ * created for each call; otherwise a parallel loop is used.  The function
+ * returns when all the calls are done.
+ */
+template<typename FunctionType>
+inline void ParallelFor(const size_t n,
+                        const bool parallel,
+                        const bool useTasks,
+                        const FunctionType& f)
+{
+  #ifdef MLPACK_USE_OPENMP
+  if (parallel && useTasks && omp_in_parallel())
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      #pragma omp task shared(f)
+      f(i);
+    }
+    #pragma omp taskwait
+    return;
+  }
+  #endif
+
+  #pragma omp parallel for schedule(dynamic) if (parallel)
+  for (size_t i = 0; i < n; ++i)
+    f(i);
+}
+
 } // namespace mlpack
 
 #endif
@@ -111,6 +111,10 @@ PARAM_INT_IN("min_leaf_size", "The minimum size of a leaf in the unpruned, "
     "fully grown DET.", "l", 5);
 PARAM_INT_IN("max_leaf_size", "The maximum size of a leaf in the unpruned, "
     "fully grown DET.", "L", 10);
+PARAM_INT_IN("histogram_bins", "If nonzero, the splits of nodes with more "
+    "points than this are only searched at the bounds of this many equal-width "
+    "bins in each dimension, which is faster on large datasets but gives an "
+    "approximate tree (0 tries all splits).", "b", 0);
 /*
 PARAM_FLAG("volume_regularization", "This flag gives the used the option to use"
     "a form of regularization similar to the usual alpha-pruning in decision "
@@ -128,6 +132,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   ReportIgnoredParam(params, {{ "training", false }}, "folds");
   ReportIgnoredParam(params, {{ "training", false }}, "min_leaf_size");
   ReportIgnoredParam(params, {{ "training", false }}, "max_leaf_size");
+  ReportIgnoredParam(params, {{ "training", false }}, "histogram_bins");
 
   if (params.Has("tag_file"))
     RequireAtLeastOnePassed(params, { "training", "test" }, true);
@@ -147,6 +152,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
       true, "maximum leaf size must be positive");
   RequireParamValue<int>(params, "min_leaf_size", [](int x) { return x > 0; },
       true, "minimum leaf size must be positive");
+  RequireParamValue<int>(params, "histogram_bins", [](int x) { return x >= 0; },
+      true, "number of histogram bins must be non-negative");
 
   // Are we training a DET or loading from file?
   DTree<arma::mat, int>* tree;
@@ -162,6 +169,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     const int maxLeafSize = params.Get<int>("max_leaf_size");
     const int minLeafSize = params.Get<int>("min_leaf_size");
     const bool skipPruning = params.Has("skip_pruning");
+    const size_t histogramBins = params.Get<int>("histogram_bins");
     size_t folds = params.Get<int>("folds");
 
     if (folds == 0)
@@ -171,7 +179,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     timers.Start("det_training");
     tree = Trainer<arma::mat, int>(trainingData, folds, regularization,
                                    maxLeafSize, minLeafSize,
-                                   skipPruning, timers);
+                                   skipPruning, timers, histogramBins);
     timers.Stop("det_training");
 
     // Compute training set estimates, if desired.
@@ -50,16 +50,18 @@ void PrintVariableImportance(const DTree<MatType, TagType>* dtree,
 
 /**
  * Train the optimal decision tree using cross-validation with the given number
- * of folds.  Optionally, give a filename to print the unpruned tree to.  This
- * initializes a tree on the heap, so you are responsible for deleting it.
+ * of folds.  This initializes a tree on the heap, so you are responsible for
+ * deleting it.  The trees of the folds are grown and pruned in parallel.
  *
  * @param dataset Dataset for the tree to use.
  * @param folds Number of folds to use for cross-validation.
  * @param useVolumeReg If true, use volume regularization.
  * @param maxLeafSize Maximum number of points allowed in a leaf.
  * @param minLeafSize Minimum number of points allowed in a leaf.
- * @param unprunedTreeOutput Filename to print unpruned tree to (optional).
  * @param skipPruning Set true to skip pruning.
+ * @param timers Timers to record the training steps with.
+ * @param histogramBins If nonzero, the splits of large nodes are only searched
+ *     at the bounds of this many bins (see DTree::Grow()).
  */
 template <typename MatType, typename TagType>
 DTree<MatType, TagType>* Trainer(MatType& dataset,
@@ -67,9 +69,9 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
                                  const bool useVolumeReg = false,
                                  const size_t maxLeafSize = 10,
                                  const size_t minLeafSize = 5,
-                                 const std::string unprunedTreeOutput = "",
                                  const bool skipPruning = false,
-                                 util::Timers& timers = IO::GetTimers());
+                                 util::Timers& timers = IO::GetTimers(),
+                                 const size_t histogramBins = 0);
 
 /**
  * This class is responsible for caching the path to each node of the tree. Its
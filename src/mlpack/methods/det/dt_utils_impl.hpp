@@ -112,7 +112,8 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
                                  const size_t maxLeafSize,
                                  const size_t minLeafSize,
                                  const bool skipPruning,
-                                 util::Timers& timers)
+                                 util::Timers& timers,
+                                 const size_t histogramBins)
 {
   // Initialize the tree.
   DTree<MatType, TagType>* dtree = new DTree<MatType, TagType>(dataset);
@@ -129,7 +130,7 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
   // Growing the tree
   double oldAlpha = 0.0;
   double alpha = dtree->Grow(newDataset, oldFromNew, useVolumeReg, maxLeafSize,
-      minLeafSize);
+      minLeafSize, histogramBins);
 
   timers.Stop("tree_growing");
   Log::Info << dtree->SubtreeLeaves() << " leaf nodes in the tree using full "
@@ -138,6 +139,11 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
   if (skipPruning)
     return dtree;
 
+  // Keep the unpruned tree; the optimally pruned tree is obtained by pruning it
+  // again once the cross-validation is done, instead of growing it again.
+  const DTree<MatType, TagType> unprunedTree(*dtree);
+  const double unprunedAlpha = alpha;
+
   if (folds == dataset.n_cols)
     Log::Info << "Performing leave-one-out cross validation." << std::endl;
   else
@@ -173,7 +179,7 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
   Log::Info << prunedSequence.size() << " trees in the sequence; maximum alpha:"
       << " " << oldAlpha << "." << std::endl;
 
-  const MatType cvData(dataset);
+  const MatType& cvData = dataset;
   const size_t testSize = dataset.n_cols / folds;
 
   arma::vec regularizationConstants(prunedSequence.size());
@@ -181,7 +187,8 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
 
   timers.Start("cross_validation");
   // Go through each fold.
-  #pragma omp parallel for shared(prunedSequence, regularizationConstants)
+  #pragma omp parallel for shared(prunedSequence, regularizationConstants) \
+      schedule(dynamic)
   for (size_t fold = 0; fold < (size_t) folds; fold++)
   {
     // Break up data into train and test sets.
@@ -216,7 +223,7 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
 
     // Grow the tree.
     cvDTree.Grow(train, cvOldFromNew, useVolumeReg, maxLeafSize,
-        minLeafSize);
+        minLeafSize, histogramBins);
 
     // Sequentially prune with all the values of available alphas and adding
     // values for test values.  Don't enter this loop if there are less than two
@@ -281,24 +288,10 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
 
   Log::Info << "Optimal alpha: " << optimalAlpha << "." << std::endl;
 
-  // Re-Initialize the tree.
-  delete dtree;
-  dtree = new DTree<MatType, TagType>(dataset);
-
-  // Getting ready to grow the tree...
-  for (size_t i = 0; i < oldFromNew.n_elem; ++i)
-    oldFromNew[i] = i;
-
-  // Save the dataset since it would be modified while growing the tree.
-  newDataset = dataset;
-
-  // Grow the tree.
+  // Restore the unpruned tree.
+  *dtree = unprunedTree;
   oldAlpha = -DBL_MAX;
-  alpha = dtree->Grow(newDataset,
-                         oldFromNew,
-                         useVolumeReg,
-                         maxLeafSize,
-                         minLeafSize);
+  alpha = unprunedAlpha;
 
   // Prune with optimal alpha.
   while ((oldAlpha < optimalAlpha) && (dtree->SubtreeLeaves() > 1))
@@ -150,17 +150,28 @@ class DTree
    * Greedily expand the tree.  The points in the dataset will be reordered
    * during tree growth.
    *
+   * For dense data, each dimension is sorted once before growing, and the
+   * sorted order is maintained as nodes are split, so the splits of each node
+   * are found without sorting its points.  If histogramBins is nonzero, the
+   * splits of nodes with more points than that are instead only searched at
+   * the bounds of histogramBins equal-width bins spanning the points of the
+   * node in each dimension, which takes linear time and no additional memory;
+   * the tree is then approximate.
+   *
    * @param data Dataset to build tree on.
    * @param oldFromNew Mappings from old points to new points.
    * @param useVolReg If true, volume regularization is used.
    * @param maxLeafSize Maximum size of a leaf.
    * @param minLeafSize Minimum size of a leaf.
+   * @param histogramBins Number of bins for histogram split finding (0 means
+   *     that all possible splits are tried).
    */
   double Grow(MatType& data,
               arma::Col<size_t>& oldFromNew,
               const bool useVolReg = false,
               const size_t maxLeafSize = 10,
-              const size_t minLeafSize = 5);
+              const size_t minLeafSize = 5,
+              const size_t histogramBins = 0);
 
   /**
    * Perform alpha pruning on a tree.  Returns the new value of alpha.
@@ -335,14 +346,56 @@ class DTree
   // Utility methods.
 
   /**
-   * Find the dimension to split on.
+   * The points of the dataset sorted along each dimension, in the order of the
+   * nodes: the entries start to end of each column are the points of the node
+   * holding points start to end of the dataset, sorted along that dimension.
+   */
+  struct SortedPoints
+  {
+    //! The sorted values of each dimension (one column per dimension).
+    arma::Mat<ElemType> values;
+    //! The indices of the points of each entry of values, in the dataset as it
+    //! was before growing.
+    arma::Mat<size_t> ids;
+    //! Temporary storage: whether each point goes to the left child of the
+    //! node being split.
+    std::vector<char> goesLeft;
+  };
+
+  /**
+   * Find the dimension to split on.  If sorted is given, the points of the
+   * node are not sorted again; if histogramBins is nonzero and the node has
+   * more points than that, only the bounds of the bins are tried.
    */
   bool FindSplit(const MatType& data,
                  size_t& splitDim,
                  ElemType& splitValue,
                  double& leftError,
                  double& rightError,
-                 const size_t minLeafSize = 5) const;
+                 const size_t minLeafSize = 5,
+                 const size_t histogramBins = 0,
+                 const SortedPoints* sorted = NULL) const;
+
+  /**
+   * Expand the node and its children; sorted is NULL if the dimensions were
+   * not presorted.
+   */
+  double GrowInternal(MatType& data,
+                      arma::Col<size_t>& oldFromNew,
+                      const bool useVolReg,
+                      const size_t maxLeafSize,
+                      const size_t minLeafSize,
+                      const size_t histogramBins,
+                      SortedPoints* sorted);
+
+  /**
+   * Once the node has been split with SplitData(), move the points of each
+   * dimension of sorted to the part of the node they now lie in, keeping them
+   * sorted.
+   */
+  void SplitSortedPoints(SortedPoints& sorted,
+                         const size_t splitDim,
+                         const size_t splitIndex) const;
 
   /**
    * Split the data, returning the number of points left of the split.
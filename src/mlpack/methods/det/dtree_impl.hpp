@@ -142,6 +142,89 @@ void ExtractSplits(std::vector<std::pair<ElemType, size_t>>& splitVec,
   }
 }
 
+/**
+ * This one puts all splits of the sorted values of a dimension of a node in a
+ * vector; it is used when the dimensions of the dataset have been sorted before
+ * growing the tree.
+ */
+template<typename ElemType>
+void ExtractSortedSplits(std::vector<std::pair<ElemType, size_t>>& splitVec,
+                         const ElemType* dimVec,
+                         const size_t points,
+                         const size_t minLeafSize)
+{
+  using SplitItem = std::pair<ElemType, size_t>;
+
+  for (size_t i = minLeafSize - 1; i < points - minLeafSize; ++i)
+  {
+    // This is the same split as the one of ExtractSplits().
+    const ElemType split = (dimVec[i] + dimVec[i + 1]) / 2.0;
+
+    if (split != dimVec[i])
+      splitVec.push_back(SplitItem(split, i + 1));
+  }
+}
+
+/**
+ * This one puts in a vector the bounds of `bins` equal-width bins spanning the
+ * values of the points of a node in the given dimension, with the number of
+ * points left of each bound.  It takes linear time and does not sort anything.
+ */
+template<typename ElemType, typename MatType>
+void ExtractHistogramSplits(std::vector<std::pair<ElemType, size_t>>& splitVec,
+                            const MatType& data,
+                            size_t dim,
+                            const size_t start,
+                            const size_t end,
+                            const size_t minLeafSize,
+                            const size_t bins)
+{
+  using SplitItem = std::pair<ElemType, size_t>;
+
+  // Find the range of the points in this dimension.
+  ElemType lo = data(dim, start);
+  ElemType hi = lo;
+  for (size_t i = start + 1; i < end; ++i)
+  {
+    const ElemType value = data(dim, i);
+    lo = std::min(lo, value);
+    hi = std::max(hi, value);
+  }
+
+  if (hi == lo)
+    return;
+
+  // Bin b holds the points in (Bound(b), Bound(b + 1)], and bin 0 also holds
+  // the points equal to lo.  The points are binned by comparing them to the
+  // bounds themselves, so that the counts agree with SplitData().
+  const ElemType width = (hi - lo) / bins;
+  auto Bound = [lo, width](const size_t b) { return lo + ElemType(b) * width; };
+
+  std::vector<size_t> counts(bins, 0);
+  for (size_t i = start; i < end; ++i)
+  {
+    const ElemType value = data(dim, i);
+    size_t b = (size_t) std::max(std::ceil((value - lo) / width) - 1,
+        ElemType(0));
+    b = std::min(b, bins - 1);
+    while (b > 0 && value <= Bound(b))
+      --b;
+    while (b < bins - 1 && value > Bound(b + 1))
+      ++b;
+
+    ++counts[b];
+  }
+
+  const size_t points = end - start;
+  size_t leftPoints = 0;
+  for (size_t b = 1; b < bins; ++b)
+  {
+    leftPoints += counts[b - 1];
+    if (leftPoints >= minLeafSize && points - leftPoints >= minLeafSize)
+      splitVec.push_back(SplitItem(Bound(b), leftPoints));
+  }
+}
+
 template<typename MatType, typename TagType>
 DTree<MatType, TagType>::DTree() :
     start(0),
@@ -432,7 +515,9 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
                                         ElemType& splitValue,
                                         double& leftError,
                                         double& rightError,
-                                        const size_t minLeafSize) const
+                                        const size_t minLeafSize,
+                                        const size_t histogramBins,
+                                        const SortedPoints* sorted) const
 {
   using SplitItem = std::pair<ElemType, size_t>;
 
@@ -478,10 +563,25 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
     //   dimVec = arma::sort(dimVec);
     // could be quite inefficient for sparse matrices, due to
     // copy operations (3). This one has custom implementation for dense and
-    // sparse matrices.
+    // sparse matrices.  When the dimensions have been presorted, the sorted
+    // values of the node are used directly, and with histograms only the bin
+    // bounds are tried for large nodes.
 
     std::vector<SplitItem> splitVec;
-    ExtractSplits<ElemType>(splitVec, data, dim, start, end, minLeafSize);
+    if (histogramBins > 0 && points > histogramBins)
+    {
+      ExtractHistogramSplits<ElemType>(splitVec, data, dim, start, end,
+          minLeafSize, histogramBins);
+    }
+    else if (sorted)
+    {
+      ExtractSortedSplits<ElemType>(splitVec,
+          sorted->values.colptr(dim) + start, points, minLeafSize);
+    }
+    else
+    {
+      ExtractSplits<ElemType>(splitVec, data, dim, start, end, minLeafSize);
+    }
 
     // Iterate on all the splits for this dimension
     for (typename std::vector<SplitItem>::iterator i = splitVec.begin();
@@ -578,13 +678,101 @@ size_t DTree<MatType, TagType>::SplitData(
   return left;
 }
 
+// Once the node has been split, move the presorted points to their child,
+// keeping them sorted.
+template<typename MatType, typename TagType>
+void DTree<MatType, TagType>::SplitSortedPoints(SortedPoints& sorted,
+                                                const size_t splitDim,
+                                                const size_t splitIndex) const
+{
+  // The points that went left are the first ones along the split dimension.
+  for (size_t i = start; i < end; ++i)
+    sorted.goesLeft[sorted.ids(i, splitDim)] = (i < splitIndex);
+
+  // Now stably partition every other dimension.
+  #pragma omp parallel for schedule(static)
+  for (size_t dim = 0; dim < sorted.values.n_cols; ++dim)
+  {
+    if (dim == splitDim)
+      continue;
+
+    std::vector<std::pair<ElemType, size_t>> rightPoints;
+    rightPoints.reserve(end - splitIndex);
+    size_t leftIndex = start;
+    for (size_t i = start; i < end; ++i)
+    {
+      const size_t id = sorted.ids(i, dim);
+      if (sorted.goesLeft[id])
+      {
+        sorted.values(leftIndex, dim) = sorted.values(i, dim);
+        sorted.ids(leftIndex, dim) = id;
+        ++leftIndex;
+      }
+      else
+      {
+        rightPoints.push_back(std::make_pair(sorted.values(i, dim), id));
+      }
+    }
+
+    for (size_t i = 0; i < rightPoints.size(); ++i)
+    {
+      sorted.values(splitIndex + i, dim) = rightPoints[i].first;
+      sorted.ids(splitIndex + i, dim) = rightPoints[i].second;
+    }
+  }
+}
+
 // Greedily expand the tree.
 template<typename MatType, typename TagType>
 double DTree<MatType, TagType>::Grow(MatType& data,
                                      arma::Col<size_t>& oldFromNew,
                                      const bool useVolReg,
                                      const size_t maxLeafSize,
-                                     const size_t minLeafSize)
+                                     const size_t minLeafSize,
+                                     const size_t histogramBins)
+{
+  // For exact split finding on dense data, sort each dimension once, so that
+  // the nodes don't have to sort their points again.  (With histograms, only
+  // the small nodes sort their points.)
+  if constexpr (!arma::is_SpMat<MatType>::value)
+  {
+    if (histogramBins == 0 && (size_t) (end - start) > maxLeafSize)
+    {
+      SortedPoints sorted;
+      sorted.values.set_size(data.n_cols, data.n_rows);
+      sorted.ids.set_size(data.n_cols, data.n_rows);
+      sorted.goesLeft.resize(data.n_cols);
+
+      #pragma omp parallel for schedule(dynamic)
+      for (size_t dim = 0; dim < data.n_rows; ++dim)
+      {
+        const arma::uvec order = arma::sort_index(
+            data(dim, arma::span(start, end - 1)));
+        for (size_t i = 0; i < order.n_elem; ++i)
+        {
+          sorted.ids(start + i, dim) = start + order[i];
+          sorted.values(start + i, dim) = data(dim, start + order[i]);
+        }
+      }
+
+      return GrowInternal(data, oldFromNew, useVolReg, maxLeafSize,
+          minLeafSize, histogramBins, &sorted);
+    }
+  }
+
+  return GrowInternal(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize,
+      histogramBins, NULL);
+}
+
+// Greedily expand the node and its children.
+template<typename MatType, typename TagType>
+double DTree<MatType, TagType>::GrowInternal(MatType& data,
+                                             arma::Col<size_t>& oldFromNew,
+                                             const bool useVolReg,
+                                             const size_t maxLeafSize,
+                                             const size_t minLeafSize,
+                                             const size_t histogramBins,
+                                             SortedPoints* sorted)
 {
   Log::Assert(data.n_rows == maxVals.n_elem);
   Log::Assert(data.n_rows == minVals.n_elem);
@@ -605,13 +793,16 @@ double DTree<MatType, TagType>::Grow(MatType& data,
   {
     // Find the split.
     size_t dim;
-    double splitValueTmp;
+    ElemType splitValueTmp;
     double leftError, rightError;
-    if (FindSplit(data, dim, splitValueTmp, leftError, rightError, minLeafSize))
+    if (FindSplit(data, dim, splitValueTmp, leftError, rightError, minLeafSize,
+        histogramBins, sorted))
     {
       // Move the data around for the children to have points in a node lie
       // contiguously (to increase efficiency during the training).
       const size_t splitIndex = SplitData(data, dim, splitValueTmp, oldFromNew);
+      if (sorted)
+        SplitSortedPoints(*sorted, dim, splitIndex);
 
       // Make max and min vals for the children.
       StatType maxValsL(maxVals);
@@ -630,10 +821,10 @@ double DTree<MatType, TagType>::Grow(MatType& data,
       left = new DTree(maxValsL, minValsL, start, splitIndex, leftError);
       right = new DTree(maxValsR, minValsR, splitIndex, end, rightError);
 
-      leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                         minLeafSize);
-      rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                           minLeafSize);
+      leftG = left->GrowInternal(data, oldFromNew, useVolReg, maxLeafSize,
+                                 minLeafSize, histogramBins, sorted);
+      rightG = right->GrowInternal(data, oldFromNew, useVolReg, maxLeafSize,
+                                   minLeafSize, histogramBins, sorted);
 
       // Store values of R(T~) and |T~|.
       subtreeLeaves = left->SubtreeLeaves() + right->SubtreeLeaves();
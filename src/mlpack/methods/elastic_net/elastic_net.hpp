@@ -0,0 +1,219 @@
+/**
+ * @file methods/elastic_net/elastic_net.hpp
+ *
+ * Definition of ElasticNet, l1- and l2-regularized linear regression trained
+ * with coordinate descent.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_HPP
+#define MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "elastic_net_solver.hpp"
+
+namespace mlpack {
+
+/**
+ * ElasticNet solves the same problem as LARS,
+ *
+ * \f[ \min_{b, \beta} 0.5 || y - b - X \beta ||_2^2 + \lambda_1 || \beta ||_1 +
+ *     0.5 \lambda_2 || \beta ||_2^2, \f]
+ *
+ * (the LASSO when \f$ \lambda_2 = 0 \f$), with cyclic coordinate descent (see
+ * ElasticNetSolver) instead of an active set Cholesky factorization: this
+ * never forms the Gram matrix, each pass costs O(nnz) for sparse data, and
+ * the strong rule skips most of the features when \f$ \lambda_1 \f$ is large,
+ * so it scales to datasets with many more features.  The intercept b is not
+ * penalized.
+ *
+ * TrainPath() computes the solutions for a decreasing sequence of
+ * \f$ \lambda_1 \f$ values (with the same \f$ \lambda_2 \f$), each
+ * warm-started from the previous one; this is typically not much slower than
+ * training for the last value directly.
+ *
+ * @code
+ * extern arma::sp_mat data; // One column per point.
+ * extern arma::rowvec responses;
+ *
+ * ElasticNet<arma::sp_mat> model(0.0, 0.1); // lambda1 is set below.
+ * const arma::vec lambdas = model.LambdaPath(data, responses, 50);
+ * arma::mat betas;
+ * arma::rowvec intercepts;
+ * model.TrainPath(data, responses, lambdas, betas, intercepts);
+ * @endcode
+ *
+ * @tparam MatType Type of the data matrix (dense or sparse).
+ */
+template<typename MatType = arma::mat>
+class ElasticNet
+{
+ public:
+  /**
+   * Create the model without training it.
+   *
+   * @param lambda1 Regularization parameter of the l1-norm.
+   * @param lambda2 Regularization parameter of the squared l2-norm.
+   * @param fitIntercept Whether to fit an intercept.
+   * @param tolerance Convergence tolerance, relative to the loss of the model
+   *     with only an intercept.
+   * @param maxIterations Maximum number of coordinate descent passes for each
+   *     value of lambda1.
+   */
+  ElasticNet(const double lambda1 = 0.0,
+             const double lambda2 = 0.0,
+             const bool fitIntercept = true,
+             const double tolerance = 1e-7,
+             const size_t maxIterations = 100000);
+
+  /**
+   * Train the model on the given data; see the other constructor for the
+   * parameters.
+   *
+   * @param data Dataset, one column per point.
+   * @param responses Responses of the points.
+   */
+  ElasticNet(const MatType& data,
+             const arma::rowvec& responses,
+             const double lambda1 = 0.0,
+             const double lambda2 = 0.0,
+             const bool fitIntercept = true,
+             const double tolerance = 1e-7,
+             const size_t maxIterations = 100000);
+
+  /**
+   * Train the model on the given data, with the current value of Lambda1().
+   * If the model already has coefficients of the right dimensionality, they
+   * are used as the starting point.
+   *
+   * @param data Dataset, one column per point.
+   * @param responses Responses of the points.
+   * @return Final objective of the model.
+   */
+  double Train(const MatType& data, const arma::rowvec& responses);
+
+  /**
+   * Train the model for each of the given values of lambda1, which must be
+   * decreasing, warm-starting each from the previous solution.  The model
+   * keeps the solution of the last value, which is also stored in Lambda1().
+   *
+   * @param data Dataset, one column per point.
+   * @param responses Responses of the points.
+   * @param lambdas Decreasing values of lambda1.
+   * @param betas Matrix to store the coefficients for each value of lambda1 in
+   *     (one column per value).
+   * @param intercepts Vector to store the intercept for each value of lambda1
+   *     in.
+   */
+  void TrainPath(const MatType& data,
+                 const arma::rowvec& responses,
+                 const arma::vec& lambdas,
+                 arma::mat& betas,
+                 arma::rowvec& intercepts);
+
+  /**
+   * Return the smallest lambda1 for which all the coefficients are zero.
+   *
+   * @param data Dataset, one column per point.
+   * @param responses Responses of the points.
+   */
+  double LambdaMax(const MatType& data, const arma::rowvec& responses) const;
+
+  /**
+   * Return numLambdas values of lambda1, decreasing geometrically from
+   * LambdaMax() to ratio * LambdaMax(), for TrainPath().
+   *
+   * @param data Dataset, one column per point.
+   * @param responses Responses of the points.
+   * @param numLambdas Number of values.
+   * @param ratio Ratio of the last value to the first.
+   */
+  arma::vec LambdaPath(const MatType& data,
+                       const arma::rowvec& responses,
+                       const size_t numLambdas = 100,
+                       const double ratio = 1e-3) const;
+
+  /**
+   * Predict the responses of the given points.
+   *
+   * @param points Points, one per column.
+   * @param predictions Vector to store the predictions in.
+   */
+  void Predict(const MatType& points, arma::rowvec& predictions) const;
+
+  /**
+   * Compute the mean squared error of the predictions on the given points.
+   *
+   * @param points Points, one per column.
+   * @param responses True responses of the points.
+   */
+  double ComputeError(const MatType& points,
+                      const arma::rowvec& responses) const;
+
+  //! Get the regularization parameter of the l1-norm.
+  double Lambda1() const { return lambda1; }
+  //! Modify the regularization parameter of the l1-norm.
+  double& Lambda1() { return lambda1; }
+
+  //! Get the regularization parameter of the squared l2-norm.
+  double Lambda2() const { return lambda2; }
+  //! Modify the regularization parameter of the squared l2-norm.
+  double& Lambda2() { return lambda2; }
+
+  //! Get whether an intercept is fitted.
+  bool FitIntercept() const { return fitIntercept; }
+  //! Modify whether an intercept is fitted.
+  bool& FitIntercept() { return fitIntercept; }
+
+  //! Get the convergence tolerance.
+  double Tolerance() const { return tolerance; }
+  //! Modify the convergence tolerance.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the maximum number of passes for each value of lambda1.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of passes for each value of lambda1.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the coefficients.
+  const arma::vec& Beta() const { return beta; }
+  //! Modify the coefficients.
+  arma::vec& Beta() { return beta; }
+
+  //! Get the intercept.
+  double Intercept() const { return intercept; }
+  //! Modify the intercept.
+  double& Intercept() { return intercept; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The regularization parameter of the l1-norm.
+  double lambda1;
+  //! The regularization parameter of the squared l2-norm.
+  double lambda2;
+  //! Whether to fit an intercept.
+  bool fitIntercept;
+  //! The convergence tolerance.
+  double tolerance;
+  //! The maximum number of passes for each value of lambda1.
+  size_t maxIterations;
+
+  //! The coefficients.
+  arma::vec beta;
+  //! The intercept.
+  double intercept;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "elastic_net_impl.hpp"
+
+#endif
@@ -0,0 +1,166 @@
+/**
+ * @file methods/elastic_net/elastic_net_impl.hpp
+ *
+ * Implementation of ElasticNet.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_IMPL_HPP
+#define MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "elastic_net.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+ElasticNet<MatType>::ElasticNet(const double lambda1,
+                                const double lambda2,
+                                const bool fitIntercept,
+                                const double tolerance,
+                                const size_t maxIterations) :
+    lambda1(lambda1),
+    lambda2(lambda2),
+    fitIntercept(fitIntercept),
+    tolerance(tolerance),
+    maxIterations(maxIterations),
+    intercept(0.0)
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+ElasticNet<MatType>::ElasticNet(const MatType& data,
+                                const arma::rowvec& responses,
+                                const double lambda1,
+                                const double lambda2,
+                                const bool fitIntercept,
+                                const double tolerance,
+                                const size_t maxIterations) :
+    ElasticNet(lambda1, lambda2, fitIntercept, tolerance, maxIterations)
+{
+  Train(data, responses);
+}
+
+template<typename MatType>
+double ElasticNet<MatType>::Train(const MatType& data,
+                                  const arma::rowvec& responses)
+{
+  ElasticNetSolver<MatType> solver(data, responses, false, lambda2,
+      fitIntercept, tolerance, maxIterations);
+
+  // Warm-start from the current model if possible.
+  if (beta.n_elem != data.n_rows)
+    solver.NullModel(beta, intercept);
+  if (!fitIntercept)
+    intercept = 0.0;
+
+  const size_t passes = solver.Solve(lambda1, beta, intercept);
+  Log::Info << "ElasticNet::Train(): converged in " << passes << " passes, "
+      << "with " << solver.NumCandidates() << " candidate features."
+      << std::endl;
+
+  return solver.Objective(lambda1, beta);
+}
+
+template<typename MatType>
+void ElasticNet<MatType>::TrainPath(const MatType& data,
+                                    const arma::rowvec& responses,
+                                    const arma::vec& lambdas,
+                                    arma::mat& betas,
+                                    arma::rowvec& intercepts)
+{
+  for (size_t k = 1; k < lambdas.n_elem; ++k)
+  {
+    if (lambdas[k] > lambdas[k - 1])
+    {
+      throw std::invalid_argument("ElasticNet::TrainPath(): the values of "
+          "lambda1 must be decreasing!");
+    }
+  }
+
+  ElasticNetSolver<MatType> solver(data, responses, false, lambda2,
+      fitIntercept, tolerance, maxIterations);
+  solver.NullModel(beta, intercept);
+
+  betas.set_size(data.n_rows, lambdas.n_elem);
+  intercepts.set_size(lambdas.n_elem);
+  for (size_t k = 0; k < lambdas.n_elem; ++k)
+  {
+    solver.Solve(lambdas[k], beta, intercept);
+    betas.col(k) = beta;
+    intercepts[k] = intercept;
+  }
+
+  if (lambdas.n_elem > 0)
+    lambda1 = lambdas[lambdas.n_elem - 1];
+}
+
+template<typename MatType>
+double ElasticNet<MatType>::LambdaMax(const MatType& data,
+                                      const arma::rowvec& responses) const
+{
+  ElasticNetSolver<MatType> solver(data, responses, false, lambda2,
+      fitIntercept, tolerance, maxIterations);
+  return solver.LambdaMax();
+}
+
+template<typename MatType>
+arma::vec ElasticNet<MatType>::LambdaPath(const MatType& data,
+                                          const arma::rowvec& responses,
+                                          const size_t numLambdas,
+                                          const double ratio) const
+{
+  const double lambdaMax = LambdaMax(data, responses);
+  if (numLambdas <= 1 || lambdaMax == 0.0)
+    return arma::vec(numLambdas).fill(lambdaMax);
+
+  return arma::exp(arma::linspace<arma::vec>(std::log(lambdaMax),
+      std::log(ratio * lambdaMax), numLambdas));
+}
+
+template<typename MatType>
+void ElasticNet<MatType>::Predict(const MatType& points,
+                                  arma::rowvec& predictions) const
+{
+  if (points.n_rows != beta.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "ElasticNet::Predict(): dimensionality of points (" << points.n_rows
+        << ") does not match the dimensionality of the model (" << beta.n_elem
+        << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  predictions = beta.t() * points;
+  predictions += intercept;
+}
+
+template<typename MatType>
+double ElasticNet<MatType>::ComputeError(const MatType& points,
+                                         const arma::rowvec& responses) const
+{
+  arma::rowvec predictions;
+  Predict(points, predictions);
+  return arma::mean(arma::square(predictions - responses));
+}
+
+template<typename MatType>
+template<typename Archive>
+void ElasticNet<MatType>::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(lambda1));
+  ar(CEREAL_NVP(lambda2));
+  ar(CEREAL_NVP(fitIntercept));
+  ar(CEREAL_NVP(tolerance));
+  ar(CEREAL_NVP(maxIterations));
+  ar(CEREAL_NVP(beta));
+  ar(CEREAL_NVP(intercept));
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,218 @@
+/**
+ * @file methods/elastic_net/elastic_net_solver.hpp
+ *
+ * Definition of ElasticNetSolver, the cyclic coordinate descent solver that is
+ * shared by ElasticNet and LogisticElasticNet.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_SOLVER_HPP
+#define MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_SOLVER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * ElasticNetSolver minimizes
+ *
+ *   L(b, beta) + lambda1 ||beta||_1 + (lambda2 / 2) ||beta||_2^2,
+ *
+ * where L is either the squared loss (1 / 2) sum_i (y_i - b - x_i^T beta)^2 or
+ * the logistic loss sum_i log(1 + exp(b + x_i^T beta)) - y_i (b + x_i^T beta)
+ * (with y_i in {0, 1}), and the intercept b is not penalized.  This is the
+ * method of glmnet:
+ *
+ * @code
+ * @article{friedman2010regularization,
+ *   title={Regularization Paths for Generalized Linear Models via Coordinate
+ *       Descent},
+ *   author={Friedman, J. and Hastie, T. and Tibshirani, R.},
+ *   journal={Journal of Statistical Software},
+ *   volume={33},
+ *   number={1},
+ *   pages={1--22},
+ *   year={2010}
+ * }
+ * @endcode
+ *
+ * Each coordinate is updated in closed form (with soft-thresholding) given
+ * the current residual, which is then updated; both only touch the nonzeros
+ * of the feature, so a pass costs O(nnz) for sparse data.  The data is stored
+ * transposed, so that each feature is contiguous.  Coordinate descent first
+ * cycles over all the candidate features, then only over the nonzero
+ * coefficients until they converge, and then over all the candidates again.
+ * The logistic loss is minimized with an outer loop of Newton (IRLS) steps,
+ * each of which is a weighted squared loss problem.
+ *
+ * Solve() is meant to be called for a decreasing sequence of lambda1 values,
+ * warm-starting from the previous solution.  Each call only runs coordinate
+ * descent over the features kept by the sequential strong rule of
+ *
+ * @code
+ * @article{tibshirani2012strong,
+ *   title={Strong Rules for Discarding Predictors in Lasso-type Problems},
+ *   author={Tibshirani, R. and Bien, J. and Friedman, J. and Hastie, T. and
+ *       Simon, N. and Taylor, J. and Tibshirani, R.J.},
+ *   journal={Journal of the Royal Statistical Society Series B},
+ *   volume={74},
+ *   number={2},
+ *   pages={245--266},
+ *   year={2012}
+ * }
+ * @endcode
+ *
+ * (features with |x_j^T r| < 2 lambda1 - lambda1', where lambda1' is the
+ * previous value, are discarded), and the optimality conditions of the
+ * discarded features are checked afterwards; any violator is added back, so
+ * the solution is always exact.
+ *
+ * @tparam MatType Type of the data matrix (dense or sparse).
+ */
+template<typename MatType = arma::mat>
+class ElasticNetSolver
+{
+ public:
+  /**
+   * Create the solver for the given data and responses, which must stay valid
+   * as long as the solver is used.
+   *
+   * @param data Dataset, one column per point.
+   * @param responses Responses of the points (0 or 1 for the logistic loss).
+   * @param logistic Whether to use the logistic loss (otherwise the squared
+   *     loss).
+   * @param lambda2 Regularization parameter of the squared l2-norm.
+   * @param fitIntercept Whether to fit an intercept.
+   * @param tolerance Convergence tolerance, relative to the loss of the model
+   *     with only an intercept.
+   * @param maxIterations Maximum number of coordinate descent passes for each
+   *     call to Solve().
+   */
+  ElasticNetSolver(const MatType& data,
+                   const arma::rowvec& responses,
+                   const bool logistic,
+                   const double lambda2,
+                   const bool fitIntercept,
+                   const double tolerance,
+                   const size_t maxIterations);
+
+  /**
+   * Return the smallest lambda1 for which all the coefficients are zero.
+   */
+  double LambdaMax() const { return lambdaMax; }
+
+  /**
+   * Return the coefficients and the intercept of the solution for lambda1 = ∞
+   * (zero coefficients, and the intercept that minimizes the loss).
+   */
+  void NullModel(arma::vec& beta, double& intercept) const;
+
+  /**
+   * Minimize the objective for the given lambda1, starting from the given
+   * coefficients and intercept.  The starting point must be the result of the
+   * previous call if there is one (it may be any point for the first call).
+   *
+   * @param lambda1 Regularization parameter of the l1-norm.
+   * @param beta Coefficients (one per dimension), overwritten with the
+   *     solution.
+   * @param intercept Intercept, overwritten with the solution.
+   * @return Number of coordinate descent passes.
+   */
+  size_t Solve(const double lambda1, arma::vec& beta, double& intercept);
+
+  /**
+   * Compute the objective for the given lambda1 at the current solution
+   * (that is, after Solve()).
+   */
+  double Objective(const double lambda1, const arma::vec& beta) const;
+
+  //! Get the number of features kept by the strong rule in the last call to
+  //! Solve() (including those added back by the optimality checks).
+  size_t NumCandidates() const { return numCandidates; }
+
+ private:
+  //! Compute the linear predictions b + X^T beta.
+  void ComputePredictions(const arma::vec& beta, const double intercept);
+
+  //! Compute the weights, the working responses, the residuals and the
+  //! weighted squared norms of the features for the current predictions.
+  void ComputeWeights();
+
+  //! Compute the gradient x_j^T (w % r) of the loss for all the features.
+  void ComputeGradient();
+
+  //! Run coordinate descent over the given features with the current weights,
+  //! and return the number of passes.
+  size_t CoordinateDescent(const std::vector<size_t>& features,
+                           const double lambda1,
+                           arma::vec& beta,
+                           double& intercept,
+                           const size_t maxPasses);
+
+  //! Update the intercept and the given features once, and return the largest
+  //! weighted squared change of a coordinate.
+  double Pass(const std::vector<size_t>& features,
+              const double lambda1,
+              arma::vec& beta,
+              double& intercept);
+
+  //! Compute x_j^T (w % r).
+  double WeightedDot(const size_t j) const;
+
+  //! Compute sum_i w_i x_ij^2.
+  double WeightedSquaredNorm(const size_t j) const;
+
+  //! Subtract a x_j from the residuals.
+  void UpdateResiduals(const size_t j, const double a);
+
+  //! The dataset, transposed (one column per feature).
+  MatType dataT;
+  //! The responses.
+  arma::vec y;
+  //! Whether the loss is the logistic loss.
+  bool logistic;
+  //! The regularization parameter of the squared l2-norm.
+  double lambda2;
+  //! Whether to fit an intercept.
+  bool fitIntercept;
+  //! The convergence tolerance (absolute).
+  double tolerance;
+  //! The maximum number of passes for each call to Solve().
+  size_t maxIterations;
+
+  //! The linear predictions b + X^T beta.
+  arma::vec predictions;
+  //! The weights of the points (1 for the squared loss).
+  arma::vec weights;
+  //! The sum of the weights.
+  double sumWeights;
+  //! The working responses (the responses for the squared loss).
+  arma::vec z;
+  //! The residuals z - predictions.
+  arma::vec residuals;
+  //! The weighted squared norm of each feature.
+  arma::vec squaredNorms;
+  //! The gradient of the loss at the previous solution.
+  arma::vec gradient;
+
+  //! The smallest lambda1 for which all the coefficients are zero.
+  double lambdaMax;
+  //! The intercept of the null model.
+  double nullIntercept;
+  //! lambda1 of the previous call to Solve().
+  double previousLambda;
+  //! Whether Solve() has been called.
+  bool started;
+  //! The number of candidate features of the last call to Solve().
+  size_t numCandidates;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "elastic_net_solver_impl.hpp"
+
+#endif
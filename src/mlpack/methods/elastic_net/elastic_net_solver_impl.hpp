@@ -0,0 +1,402 @@
+/**
+ * @file methods/elastic_net/elastic_net_solver_impl.hpp
+ *
+ * Implementation of ElasticNetSolver.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_SOLVER_IMPL_HPP
+#define MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_SOLVER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "elastic_net_solver.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+ElasticNetSolver<MatType>::ElasticNetSolver(const MatType& data,
+                                            const arma::rowvec& responses,
+                                            const bool logistic,
+                                            const double lambda2,
+                                            const bool fitIntercept,
+                                            const double tolerance,
+                                            const size_t maxIterations) :
+    dataT(data.t()),
+    y(responses.t()),
+    logistic(logistic),
+    lambda2(lambda2),
+    fitIntercept(fitIntercept),
+    maxIterations(maxIterations),
+    previousLambda(0.0),
+    started(false),
+    numCandidates(0)
+{
+  util::CheckSameSizes(data, responses, "ElasticNetSolver::ElasticNetSolver()",
+      "responses");
+
+  if (lambda2 < 0.0)
+  {
+    throw std::invalid_argument("ElasticNetSolver::ElasticNetSolver(): "
+        "lambda2 must be nonnegative!");
+  }
+
+  // The null model only has the intercept that minimizes the loss.
+  nullIntercept = 0.0;
+  if (fitIntercept && y.n_elem > 0)
+  {
+    if (logistic)
+    {
+      const double p = std::min(std::max(arma::mean(y), 1e-5), 1.0 - 1e-5);
+      nullIntercept = std::log(p / (1.0 - p));
+    }
+    else
+    {
+      nullIntercept = arma::mean(y);
+    }
+  }
+
+  predictions.set_size(y.n_elem);
+  predictions.fill(nullIntercept);
+  ComputeWeights();
+  ComputeGradient();
+  lambdaMax = (gradient.n_elem > 0) ? arma::max(arma::abs(gradient)) : 0.0;
+
+  // The tolerance is relative to the loss of the null model.
+  double nullLoss = 0.0;
+  for (size_t i = 0; i < y.n_elem; ++i)
+  {
+    nullLoss += logistic ? std::log1p(std::exp(nullIntercept)) -
+        y[i] * nullIntercept : 0.5 * std::pow(y[i] - nullIntercept, 2.0);
+  }
+  this->tolerance = (nullLoss > 0.0) ? tolerance * nullLoss : tolerance;
+}
+
+template<typename MatType>
+void ElasticNetSolver<MatType>::NullModel(arma::vec& beta,
+                                          double& intercept) const
+{
+  beta.zeros(dataT.n_cols);
+  intercept = nullIntercept;
+}
+
+template<typename MatType>
+size_t ElasticNetSolver<MatType>::Solve(const double lambda1,
+                                        arma::vec& beta,
+                                        double& intercept)
+{
+  if (lambda1 < 0.0)
+  {
+    throw std::invalid_argument("ElasticNetSolver::Solve(): lambda1 must be "
+        "nonnegative!");
+  }
+
+  if (beta.n_elem != dataT.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "ElasticNetSolver::Solve(): the number of coefficients ("
+        << beta.n_elem << ") does not match the dimensionality of the data ("
+        << dataT.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (!started)
+  {
+    ComputePredictions(beta, intercept);
+    ComputeWeights();
+    ComputeGradient();
+    previousLambda = std::max(lambdaMax, lambda1);
+    started = true;
+  }
+
+  // Sequential strong rule: keep the nonzero coefficients, and the features
+  // whose gradient at the previous solution is large enough.
+  const size_t d = dataT.n_cols;
+  const double threshold = 2.0 * lambda1 - previousLambda;
+  std::vector<bool> isCandidate(d, false);
+  std::vector<size_t> candidates;
+  for (size_t j = 0; j < d; ++j)
+  {
+    if (beta[j] != 0.0 || std::abs(gradient[j]) >= threshold)
+    {
+      isCandidate[j] = true;
+      candidates.push_back(j);
+    }
+  }
+
+  size_t passes = 0;
+  while (true)
+  {
+    if (logistic)
+    {
+      // Newton steps: each one minimizes the weighted squared loss around the
+      // current predictions.
+      while (passes < maxIterations)
+      {
+        const arma::vec oldBeta(beta);
+        const double oldIntercept = intercept;
+        passes += CoordinateDescent(candidates, lambda1, beta, intercept,
+            maxIterations - passes);
+        predictions = z - residuals;
+
+        double change = sumWeights * std::pow(intercept - oldIntercept, 2.0);
+        for (const size_t j : candidates)
+        {
+          change = std::max(change,
+              squaredNorms[j] * std::pow(beta[j] - oldBeta[j], 2.0));
+        }
+
+        ComputeWeights();
+        if (change < tolerance)
+          break;
+      }
+    }
+    else
+    {
+      passes += CoordinateDescent(candidates, lambda1, beta, intercept,
+          maxIterations - passes);
+    }
+
+    // Check the optimality conditions of the discarded features, and add back
+    // those that violate them.
+    ComputeGradient();
+    bool violations = false;
+    for (size_t j = 0; j < d; ++j)
+    {
+      if (!isCandidate[j] && std::abs(gradient[j]) > lambda1)
+      {
+        isCandidate[j] = true;
+        candidates.push_back(j);
+        violations = true;
+      }
+    }
+
+    if (!violations || passes >= maxIterations)
+      break;
+  }
+
+  if (passes >= maxIterations)
+  {
+    Log::Warn << "ElasticNetSolver::Solve(): maximum number of iterations ("
+        << maxIterations << ") reached for lambda1 = " << lambda1 << "; the "
+        << "solution may not be optimal." << std::endl;
+  }
+
+  previousLambda = lambda1;
+  numCandidates = candidates.size();
+  return passes;
+}
+
+template<typename MatType>
+double ElasticNetSolver<MatType>::Objective(const double lambda1,
+                                            const arma::vec& beta) const
+{
+  double loss = 0.0;
+  if (logistic)
+  {
+    for (size_t i = 0; i < y.n_elem; ++i)
+    {
+      // log(1 + exp(eta)), computed stably.
+      const double eta = predictions[i];
+      loss += ((eta > 0.0) ? eta + std::log1p(std::exp(-eta)) :
+          std::log1p(std::exp(eta))) - y[i] * eta;
+    }
+  }
+  else
+  {
+    loss = 0.5 * arma::dot(residuals, residuals);
+  }
+
+  return loss + lambda1 * arma::norm(beta, 1) +
+      0.5 * lambda2 * arma::dot(beta, beta);
+}
+
+template<typename MatType>
+void ElasticNetSolver<MatType>::ComputePredictions(const arma::vec& beta,
+                                                   const double intercept)
+{
+  predictions = dataT * beta;
+  predictions += intercept;
+}
+
+template<typename MatType>
+void ElasticNetSolver<MatType>::ComputeWeights()
+{
+  const size_t n = y.n_elem;
+  if (logistic)
+  {
+    weights.set_size(n);
+    z.set_size(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      const double p = 1.0 / (1.0 + std::exp(-predictions[i]));
+      weights[i] = std::max(p * (1.0 - p), 1e-5);
+      z[i] = predictions[i] + (y[i] - p) / weights[i];
+    }
+    residuals = z - predictions;
+  }
+  else
+  {
+    // The weights do not change, so the squared norms only need to be
+    // computed once.
+    residuals = y - predictions;
+    if (weights.n_elem == n)
+      return;
+
+    weights.ones(n);
+    z = y;
+  }
+
+  sumWeights = arma::accu(weights);
+  squaredNorms.set_size(dataT.n_cols);
+  #pragma omp parallel for schedule(static)
+  for (size_t j = 0; j < dataT.n_cols; ++j)
+    squaredNorms[j] = WeightedSquaredNorm(j);
+}
+
+template<typename MatType>
+void ElasticNetSolver<MatType>::ComputeGradient()
+{
+  gradient.set_size(dataT.n_cols);
+  #pragma omp parallel for schedule(static)
+  for (size_t j = 0; j < dataT.n_cols; ++j)
+    gradient[j] = WeightedDot(j);
+}
+
+template<typename MatType>
+size_t ElasticNetSolver<MatType>::CoordinateDescent(
+    const std::vector<size_t>& features,
+    const double lambda1,
+    arma::vec& beta,
+    double& intercept,
+    const size_t maxPasses)
+{
+  std::vector<size_t> active;
+  size_t passes = 0;
+  while (passes < maxPasses)
+  {
+    double change = Pass(features, lambda1, beta, intercept);
+    ++passes;
+    if (change < tolerance)
+      break;
+
+    // Iterate over the nonzero coefficients only until they converge, and
+    // then check all the features again.
+    active.clear();
+    for (const size_t j : features)
+      if (beta[j] != 0.0)
+        active.push_back(j);
+
+    while (passes < maxPasses)
+    {
+      change = Pass(active, lambda1, beta, intercept);
+      ++passes;
+      if (change < tolerance)
+        break;
+    }
+  }
+
+  return passes;
+}
+
+template<typename MatType>
+double ElasticNetSolver<MatType>::Pass(const std::vector<size_t>& features,
+                                       const double lambda1,
+                                       arma::vec& beta,
+                                       double& intercept)
+{
+  double maxChange = 0.0;
+  if (fitIntercept && sumWeights > 0.0)
+  {
+    const double delta = arma::dot(weights, residuals) / sumWeights;
+    intercept += delta;
+    residuals -= delta;
+    maxChange = sumWeights * delta * delta;
+  }
+
+  for (const size_t j : features)
+  {
+    const double denominator = squaredNorms[j] + lambda2;
+    if (denominator == 0.0)
+      continue;
+
+    // Soft-threshold the coefficient that minimizes the loss along feature j.
+    const double oldBeta = beta[j];
+    const double rho = WeightedDot(j) + squaredNorms[j] * oldBeta;
+    const double newBeta = (rho > lambda1) ? (rho - lambda1) / denominator :
+        (rho < -lambda1) ? (rho + lambda1) / denominator : 0.0;
+
+    if (newBeta != oldBeta)
+    {
+      const double diff = newBeta - oldBeta;
+      UpdateResiduals(j, diff);
+      beta[j] = newBeta;
+      maxChange = std::max(maxChange, squaredNorms[j] * diff * diff);
+    }
+  }
+
+  return maxChange;
+}
+
+template<typename MatType>
+double ElasticNetSolver<MatType>::WeightedDot(const size_t j) const
+{
+  double result = 0.0;
+  if constexpr (arma::is_SpMat<MatType>::value)
+  {
+    for (typename MatType::const_iterator it = dataT.begin_col(j);
+         it != dataT.end_col(j); ++it)
+      result += (*it) * weights[it.row()] * residuals[it.row()];
+  }
+  else
+  {
+    const typename MatType::elem_type* x = dataT.colptr(j);
+    for (size_t i = 0; i < dataT.n_rows; ++i)
+      result += x[i] * weights[i] * residuals[i];
+  }
+
+  return result;
+}
+
+template<typename MatType>
+double ElasticNetSolver<MatType>::WeightedSquaredNorm(const size_t j) const
+{
+  double result = 0.0;
+  if constexpr (arma::is_SpMat<MatType>::value)
+  {
+    for (typename MatType::const_iterator it = dataT.begin_col(j);
+         it != dataT.end_col(j); ++it)
+      result += (*it) * (*it) * weights[it.row()];
+  }
+  else
+  {
+    const typename MatType::elem_type* x = dataT.colptr(j);
+    for (size_t i = 0; i < dataT.n_rows; ++i)
+      result += x[i] * x[i] * weights[i];
+  }
+
+  return result;
+}
+
+template<typename MatType>
+void ElasticNetSolver<MatType>::UpdateResiduals(const size_t j, const double a)
+{
+  if constexpr (arma::is_SpMat<MatType>::value)
+  {
+    for (typename MatType::const_iterator it = dataT.begin_col(j);
+         it != dataT.end_col(j); ++it)
+      residuals[it.row()] -= a * (*it);
+  }
+  else
+  {
+    const typename MatType::elem_type* x = dataT.colptr(j);
+    for (size_t i = 0; i < dataT.n_rows; ++i)
+      residuals[i] -= a * x[i];
+  }
+}
+
+} // namespace mlpack
+
+#endif
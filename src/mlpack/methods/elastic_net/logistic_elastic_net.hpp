@@ -0,0 +1,230 @@
+/**
+ * @file methods/elastic_net/logistic_elastic_net.hpp
+ *
+ * Definition of LogisticElasticNet, l1- and l2-regularized logistic regression
+ * trained with coordinate descent.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ELASTIC_NET_LOGISTIC_ELASTIC_NET_HPP
+#define MLPACK_METHODS_ELASTIC_NET_LOGISTIC_ELASTIC_NET_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "elastic_net_solver.hpp"
+
+namespace mlpack {
+
+/**
+ * LogisticElasticNet trains a binary logistic regression model with l1 and l2
+ * regularization,
+ *
+ * \f[ \min_{b, \beta} \sum_i \left( \log(1 + e^{b + x_i^T \beta}) -
+ *     y_i (b + x_i^T \beta) \right) + \lambda_1 || \beta ||_1 +
+ *     0.5 \lambda_2 || \beta ||_2^2, \f]
+ *
+ * with labels \f$ y_i \f$ in {0, 1}, using Newton steps whose weighted least
+ * squares problems are solved with cyclic coordinate descent (see
+ * ElasticNetSolver).  As with ElasticNet, each pass costs O(nnz) for sparse
+ * data, the strong rule skips most of the features when \f$ \lambda_1 \f$ is
+ * large, and TrainPath() computes a whole warm-started path of solutions.  The
+ * intercept b is not penalized.  With \f$ \lambda_1 = 0 \f$, this is the
+ * same model as LogisticRegression (whose intercept is also not penalized).
+ *
+ * @code
+ * extern arma::sp_mat data; // One column per point.
+ * extern arma::Row<size_t> labels; // 0 or 1.
+ *
+ * LogisticElasticNet<arma::sp_mat> model(data, labels, 1.0, 0.1);
+ * arma::Row<size_t> predictions;
+ * model.Classify(data, predictions);
+ * @endcode
+ *
+ * @tparam MatType Type of the data matrix (dense or sparse).
+ */
+template<typename MatType = arma::mat>
+class LogisticElasticNet
+{
+ public:
+  /**
+   * Create the model without training it.
+   *
+   * @param lambda1 Regularization parameter of the l1-norm.
+   * @param lambda2 Regularization parameter of the squared l2-norm.
+   * @param fitIntercept Whether to fit an intercept.
+   * @param tolerance Convergence tolerance, relative to the loss of the model
+   *     with only an intercept.
+   * @param maxIterations Maximum number of coordinate descent passes for each
+   *     value of lambda1.
+   */
+  LogisticElasticNet(const double lambda1 = 0.0,
+                     const double lambda2 = 0.0,
+                     const bool fitIntercept = true,
+                     const double tolerance = 1e-7,
+                     const size_t maxIterations = 100000);
+
+  /**
+   * Train the model on the given data; see the other constructor for the
+   * parameters.
+   *
+   * @param data Dataset, one column per point.
+   * @param labels Labels of the points (0 or 1).
+   */
+  LogisticElasticNet(const MatType& data,
+                     const arma::Row<size_t>& labels,
+                     const double lambda1 = 0.0,
+                     const double lambda2 = 0.0,
+                     const bool fitIntercept = true,
+                     const double tolerance = 1e-7,
+                     const size_t maxIterations = 100000);
+
+  /**
+   * Train the model on the given data, with the current value of Lambda1().
+   * If the model already has coefficients of the right dimensionality, they
+   * are used as the starting point.
+   *
+   * @param data Dataset, one column per point.
+   * @param labels Labels of the points (0 or 1).
+   * @return Final objective of the model.
+   */
+  double Train(const MatType& data, const arma::Row<size_t>& labels);
+
+  /**
+   * Train the model for each of the given values of lambda1, which must be
+   * decreasing, warm-starting each from the previous solution.  The model
+   * keeps the solution of the last value, which is also stored in Lambda1().
+   *
+   * @param data Dataset, one column per point.
+   * @param labels Labels of the points (0 or 1).
+   * @param lambdas Decreasing values of lambda1.
+   * @param betas Matrix to store the coefficients for each value of lambda1 in
+   *     (one column per value).
+   * @param intercepts Vector to store the intercept for each value of lambda1
+   *     in.
+   */
+  void TrainPath(const MatType& data,
+                 const arma::Row<size_t>& labels,
+                 const arma::vec& lambdas,
+                 arma::mat& betas,
+                 arma::rowvec& intercepts);
+
+  /**
+   * Return the smallest lambda1 for which all the coefficients are zero.
+   *
+   * @param data Dataset, one column per point.
+   * @param labels Labels of the points (0 or 1).
+   */
+  double LambdaMax(const MatType& data, const arma::Row<size_t>& labels) const;
+
+  /**
+   * Return numLambdas values of lambda1, decreasing geometrically from
+   * LambdaMax() to ratio * LambdaMax(), for TrainPath().
+   *
+   * @param data Dataset, one column per point.
+   * @param labels Labels of the points (0 or 1).
+   * @param numLambdas Number of values.
+   * @param ratio Ratio of the last value to the first.
+   */
+  arma::vec LambdaPath(const MatType& data,
+                       const arma::Row<size_t>& labels,
+                       const size_t numLambdas = 100,
+                       const double ratio = 1e-3) const;
+
+  /**
+   * Classify the given points.
+   *
+   * @param points Points, one per column.
+   * @param labels Vector to store the predicted labels in.
+   */
+  void Classify(const MatType& points, arma::Row<size_t>& labels) const;
+
+  /**
+   * Classify the given points, and store the probability of class 1 of each.
+   *
+   * @param points Points, one per column.
+   * @param labels Vector to store the predicted labels in.
+   * @param probabilities Vector to store the probabilities of class 1 in.
+   */
+  void Classify(const MatType& points,
+                arma::Row<size_t>& labels,
+                arma::rowvec& probabilities) const;
+
+  /**
+   * Compute the percentage of the given points whose label is predicted
+   * correctly.
+   *
+   * @param points Points, one per column.
+   * @param labels True labels of the points.
+   */
+  double ComputeAccuracy(const MatType& points,
+                         const arma::Row<size_t>& labels) const;
+
+  //! Get the regularization parameter of the l1-norm.
+  double Lambda1() const { return lambda1; }
+  //! Modify the regularization parameter of the l1-norm.
+  double& Lambda1() { return lambda1; }
+
+  //! Get the regularization parameter of the squared l2-norm.
+  double Lambda2() const { return lambda2; }
+  //! Modify the regularization parameter of the squared l2-norm.
+  double& Lambda2() { return lambda2; }
+
+  //! Get whether an intercept is fitted.
+  bool FitIntercept() const { return fitIntercept; }
+  //! Modify whether an intercept is fitted.
+  bool& FitIntercept() { return fitIntercept; }
+
+  //! Get the convergence tolerance.
+  double Tolerance() const { return tolerance; }
+  //! Modify the convergence tolerance.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the maximum number of passes for each value of lambda1.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of passes for each value of lambda1.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the coefficients.
+  const arma::vec& Beta() const { return beta; }
+  //! Modify the coefficients.
+  arma::vec& Beta() { return beta; }
+
+  //! Get the intercept.
+  double Intercept() const { return intercept; }
+  //! Modify the intercept.
+  double& Intercept() { return intercept; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Convert the labels to responses, checking that they are 0 or 1.
+  static arma::rowvec Responses(const arma::Row<size_t>& labels);
+
+  //! The regularization parameter of the l1-norm.
+  double lambda1;
+  //! The regularization parameter of the squared l2-norm.
+  double lambda2;
+  //! Whether to fit an intercept.
+  bool fitIntercept;
+  //! The convergence tolerance.
+  double tolerance;
+  //! The maximum number of passes for each value of lambda1.
+  size_t maxIterations;
+
+  //! The coefficients.
+  arma::vec beta;
+  //! The intercept.
+  double intercept;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "logistic_elastic_net_impl.hpp"
+
+#endif
@@ -0,0 +1,192 @@
+/**
+ * @file methods/elastic_net/logistic_elastic_net_impl.hpp
+ *
+ * Implementation of LogisticElasticNet.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ELASTIC_NET_LOGISTIC_ELASTIC_NET_IMPL_HPP
+#define MLPACK_METHODS_ELASTIC_NET_LOGISTIC_ELASTIC_NET_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "logistic_elastic_net.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+LogisticElasticNet<MatType>::LogisticElasticNet(const double lambda1,
+                                                const double lambda2,
+                                                const bool fitIntercept,
+                                                const double tolerance,
+                                                const size_t maxIterations) :
+    lambda1(lambda1),
+    lambda2(lambda2),
+    fitIntercept(fitIntercept),
+    tolerance(tolerance),
+    maxIterations(maxIterations),
+    intercept(0.0)
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+LogisticElasticNet<MatType>::LogisticElasticNet(const MatType& data,
+                                                const arma::Row<size_t>& labels,
+                                                const double lambda1,
+                                                const double lambda2,
+                                                const bool fitIntercept,
+                                                const double tolerance,
+                                                const size_t maxIterations) :
+    LogisticElasticNet(lambda1, lambda2, fitIntercept, tolerance, maxIterations)
+{
+  Train(data, labels);
+}
+
+template<typename MatType>
+double LogisticElasticNet<MatType>::Train(const MatType& data,
+                                          const arma::Row<size_t>& labels)
+{
+  ElasticNetSolver<MatType> solver(data, Responses(labels), true, lambda2,
+      fitIntercept, tolerance, maxIterations);
+
+  // Warm-start from the current model if possible.
+  if (beta.n_elem != data.n_rows)
+    solver.NullModel(beta, intercept);
+  if (!fitIntercept)
+    intercept = 0.0;
+
+  const size_t passes = solver.Solve(lambda1, beta, intercept);
+  Log::Info << "LogisticElasticNet::Train(): converged in " << passes
+      << " passes, with " << solver.NumCandidates() << " candidate features."
+      << std::endl;
+
+  return solver.Objective(lambda1, beta);
+}
+
+template<typename MatType>
+void LogisticElasticNet<MatType>::TrainPath(const MatType& data,
+                                            const arma::Row<size_t>& labels,
+                                            const arma::vec& lambdas,
+                                            arma::mat& betas,
+                                            arma::rowvec& intercepts)
+{
+  for (size_t k = 1; k < lambdas.n_elem; ++k)
+  {
+    if (lambdas[k] > lambdas[k - 1])
+    {
+      throw std::invalid_argument("LogisticElasticNet::TrainPath(): the "
+          "values of lambda1 must be decreasing!");
+    }
+  }
+
+  ElasticNetSolver<MatType> solver(data, Responses(labels), true, lambda2,
+      fitIntercept, tolerance, maxIterations);
+  solver.NullModel(beta, intercept);
+
+  betas.set_size(data.n_rows, lambdas.n_elem);
+  intercepts.set_size(lambdas.n_elem);
+  for (size_t k = 0; k < lambdas.n_elem; ++k)
+  {
+    solver.Solve(lambdas[k], beta, intercept);
+    betas.col(k) = beta;
+    intercepts[k] = intercept;
+  }
+
+  if (lambdas.n_elem > 0)
+    lambda1 = lambdas[lambdas.n_elem - 1];
+}
+
+template<typename MatType>
+double LogisticElasticNet<MatType>::LambdaMax(
+    const MatType& data,
+    const arma::Row<size_t>& labels) const
+{
+  ElasticNetSolver<MatType> solver(data, Responses(labels), true, lambda2,
+      fitIntercept, tolerance, maxIterations);
+  return solver.LambdaMax();
+}
+
+template<typename MatType>
+arma::vec LogisticElasticNet<MatType>::LambdaPath(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numLambdas,
+    const double ratio) const
+{
+  const double lambdaMax = LambdaMax(data, labels);
+  if (numLambdas <= 1 || lambdaMax == 0.0)
+    return arma::vec(numLambdas).fill(lambdaMax);
+
+  return arma::exp(arma::linspace<arma::vec>(std::log(lambdaMax),
+      std::log(ratio * lambdaMax), numLambdas));
+}
+
+template<typename MatType>
+void LogisticElasticNet<MatType>::Classify(const MatType& points,
+                                           arma::Row<size_t>& labels) const
+{
+  arma::rowvec probabilities;
+  Classify(points, labels, probabilities);
+}
+
+template<typename MatType>
+void LogisticElasticNet<MatType>::Classify(const MatType& points,
+                                           arma::Row<size_t>& labels,
+                                           arma::rowvec& probabilities) const
+{
+  if (points.n_rows != beta.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "LogisticElasticNet::Classify(): dimensionality of points ("
+        << points.n_rows << ") does not match the dimensionality of the model ("
+        << beta.n_elem << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  probabilities = beta.t() * points;
+  probabilities = 1.0 / (1.0 + arma::exp(-(probabilities + intercept)));
+  labels = arma::conv_to<arma::Row<size_t>>::from(probabilities >= 0.5);
+}
+
+template<typename MatType>
+double LogisticElasticNet<MatType>::ComputeAccuracy(
+    const MatType& points,
+    const arma::Row<size_t>& labels) const
+{
+  arma::Row<size_t> predictions;
+  Classify(points, predictions);
+  return 100.0 * arma::accu(predictions == labels) / labels.n_elem;
+}
+
+template<typename MatType>
+arma::rowvec LogisticElasticNet<MatType>::Responses(
+    const arma::Row<size_t>& labels)
+{
+  if (labels.n_elem > 0 && labels.max() > 1)
+  {
+    throw std::invalid_argument("LogisticElasticNet: labels must be 0 or 1!");
+  }
+
+  return arma::conv_to<arma::rowvec>::from(labels);
+}
+
+template<typename MatType>
+template<typename Archive>
+void LogisticElasticNet<MatType>::serialize(Archive& ar,
+                                            const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(lambda1));
+  ar(CEREAL_NVP(lambda2));
+  ar(CEREAL_NVP(fitIntercept));
+  ar(CEREAL_NVP(tolerance));
+  ar(CEREAL_NVP(maxIterations));
+  ar(CEREAL_NVP(beta));
+  ar(CEREAL_NVP(intercept));
+}
+
+} // namespace mlpack
+
+#endif
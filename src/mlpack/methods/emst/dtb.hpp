@@ -108,6 +108,10 @@ class DualTreeBoruvka
   //! List of edge distances.
   arma::vec neighborsDistances;
 
+  //! Core distances of the points (in the order of the tree's dataset), if a
+  //! mutual reachability MST is being computed; otherwise, this is empty.
+  arma::vec coreDistances;
+
   //! Total distance of the tree.
   double totalDist;
 
@@ -171,6 +175,19 @@ class DualTreeBoruvka
    */
   void ComputeMST(arma::mat& results);
 
+  /**
+   * Compute the minimum spanning tree of the dataset under the mutual
+   * reachability distance, which is used by HDBSCAN: the distance between
+   * points a and b is max(d(a, b), coreDistances[a], coreDistances[b]).  The
+   * results have the same format as for ComputeMST(results), and the core
+   * distances are given in the order of the dataset passed to the constructor
+   * (or of the tree's dataset, if a pre-built tree was given).
+   *
+   * @param results Matrix which results will be stored in.
+   * @param coreDistances Core distance of each point.
+   */
+  void ComputeMST(arma::mat& results, const arma::vec& coreDistances);
+
  private:
   /**
    * Adds a single edge to the edge list
@@ -197,6 +214,12 @@ class DualTreeBoruvka
    * The values stored in the tree must be reset on each iteration.
    */
   void Cleanup();
+
+  /**
+   * Set the maximum core distance of every node in the given subtree, and
+   * return the value for the given node.
+   */
+  double CoreDistanceHelper(Tree* tree);
 }; // class DualTreeBoruvka
 
 } // namespace mlpack
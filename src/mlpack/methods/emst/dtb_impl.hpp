@@ -100,19 +100,35 @@ void DualTreeBoruvka<DistanceType, MatType, TreeType>::ComputeMST(
 
   using RuleType = DTBRules<DistanceType, Tree>;
   RuleType rules(data, connections, neighborsDistances, neighborsInComponent,
-                 neighborsOutComponent, distance);
+                 neighborsOutComponent, distance, coreDistances);
   while (edges.size() < (data.n_cols - 1))
   {
     if (naive)
     {
-      // Full O(N^2) traversal.
-      for (size_t i = 0; i < data.n_cols; ++i)
-        for (size_t j = 0; j < data.n_cols; ++j)
-          rules.BaseCase(i, j);
+      // Full O(N^2) traversal, with the query points split over threads.  Each
+      // thread has its own copy of the rules, which shares the candidate edges
+      // of the components with the original rules.
+      size_t threadBaseCases = 0;
+      #pragma omp parallel reduction(+:threadBaseCases)
+      {
+        RuleType threadRules(rules);
+        threadRules.BaseCases() = 0;
+
+        #pragma omp for schedule(dynamic, 16)
+        for (size_t i = 0; i < data.n_cols; ++i)
+          for (size_t j = 0; j < data.n_cols; ++j)
+            threadRules.BaseCase(i, j);
+
+        threadBaseCases += threadRules.BaseCases();
+      }
+
+      rules.BaseCases() += threadBaseCases;
     }
     else
     {
-      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+      // If the tree supports it, independent query subtrees are traversed in
+      // parallel.
+      typename DualTreeTraverserType<Tree, RuleType>::type traverser(rules);
       traverser.Traverse(*tree, *tree);
     }
 
@@ -134,6 +150,48 @@ void DualTreeBoruvka<DistanceType, MatType, TreeType>::ComputeMST(
   Log::Info << "Total spanning tree length: " << totalDist << std::endl;
 }
 
+/**
+ * Compute the MST under the mutual reachability distance.
+ */
+template<
+    typename DistanceType,
+    typename MatType,
+    template<typename TreeDistanceType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+void DualTreeBoruvka<DistanceType, MatType, TreeType>::ComputeMST(
+    arma::mat& results,
+    const arma::vec& coreDistancesIn)
+{
+  if (coreDistancesIn.n_elem != data.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "DualTreeBoruvka::ComputeMST(): number of core distances ("
+        << coreDistancesIn.n_elem << ") does not match number of points ("
+        << data.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Put the core distances in the order of the tree's dataset.
+  if (!naive && ownTree && TreeTraits<Tree>::RearrangesDataset)
+  {
+    coreDistances.set_size(data.n_cols);
+    for (size_t i = 0; i < data.n_cols; ++i)
+      coreDistances[i] = coreDistancesIn[oldFromNew[i]];
+  }
+  else
+  {
+    coreDistances = coreDistancesIn;
+  }
+
+  if (!naive)
+    CoreDistanceHelper(tree);
+
+  ComputeMST(results);
+
+  coreDistances.clear();
+}
+
 /**
  * Adds a single edge to the edge list
  */
@@ -173,13 +231,12 @@ void DualTreeBoruvka<DistanceType, MatType, TreeType>::AddAllEdges()
     size_t component = connections.Find(i);
     size_t inEdge = neighborsInComponent[component];
     size_t outEdge = neighborsOutComponent[component];
-    if (connections.Find(inEdge) != connections.Find(outEdge))
+    if (connections.Union(inEdge, outEdge))
     {
       // totalDist = totalDist + dist;
       // changed to make this agree with the cover tree code
       totalDist += neighborsDistances[component];
       AddEdge(inEdge, outEdge, neighborsDistances[component]);
-      connections.Union(inEdge, outEdge);
     }
   }
 }
@@ -298,6 +355,31 @@ void DualTreeBoruvka<DistanceType, MatType, TreeType>::Cleanup()
     CleanupHelper(tree);
 }
 
+/**
+ * Set the maximum core distance of each node.
+ */
+template<
+    typename DistanceType,
+    typename MatType,
+    template<typename TreeDistanceType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+double DualTreeBoruvka<DistanceType, MatType, TreeType>::CoreDistanceHelper(
+    Tree* tree)
+{
+  double maxCoreDistance = 0.0;
+  for (size_t i = 0; i < tree->NumPoints(); ++i)
+    maxCoreDistance = std::max(maxCoreDistance,
+        coreDistances[tree->Point(i)]);
+
+  for (size_t i = 0; i < tree->NumChildren(); ++i)
+    maxCoreDistance = std::max(maxCoreDistance,
+        CoreDistanceHelper(&tree->Child(i)));
+
+  tree->Stat().MaxCoreDistance() = maxCoreDistance;
+  return maxCoreDistance;
+}
+
 } // namespace mlpack
 
 #endif
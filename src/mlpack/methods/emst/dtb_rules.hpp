@@ -22,12 +22,18 @@ template<typename DistanceType, typename TreeType>
 class DTBRules
 {
  public:
+  /**
+   * Construct the rules.  If coreDistances is not empty, the distance between
+   * two points a and b is their mutual reachability distance,
+   * max(d(a, b), coreDistances[a], coreDistances[b]).
+   */
   DTBRules(const arma::mat& dataSet,
            UnionFind& connections,
            arma::vec& neighborsDistances,
            arma::Col<size_t>& neighborsInComponent,
            arma::Col<size_t>& neighborsOutComponent,
-           DistanceType& distance);
+           DistanceType& distance,
+           const arma::vec& coreDistances);
 
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
@@ -117,11 +123,25 @@ class DTBRules
   //! The instantiated distance metric.
   DistanceType& distance;
 
+  //! The core distance of each point, if the MST is computed with the mutual
+  //! reachability distance; otherwise, this is empty.
+  const arma::vec& coreDistances;
+
   /**
    * Update the bound for the given query node.
    */
   inline double CalculateBound(TreeType& queryNode) const;
 
+  /**
+   * Store the edge (queryIndex, referenceIndex) as the candidate edge of the
+   * given component, if it is better than the current candidate.  This is safe
+   * to call from several threads.
+   */
+  inline void UpdateCandidate(const size_t component,
+                              const size_t queryIndex,
+                              const size_t referenceIndex,
+                              const double dist);
+
   TraversalInfoType traversalInfo;
 
   //! The number of base cases calculated.
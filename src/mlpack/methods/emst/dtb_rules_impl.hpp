@@ -23,7 +23,8 @@ DTBRules(const arma::mat& dataSet,
          arma::vec& neighborsDistances,
          arma::Col<size_t>& neighborsInComponent,
          arma::Col<size_t>& neighborsOutComponent,
-         DistanceType& distance)
+         DistanceType& distance,
+         const arma::vec& coreDistances)
 :
   dataSet(dataSet),
   connections(connections),
@@ -31,6 +32,7 @@ DTBRules(const arma::mat& dataSet,
   neighborsInComponent(neighborsInComponent),
   neighborsOutComponent(neighborsOutComponent),
   distance(distance),
+  coreDistances(coreDistances),
   baseCases(0),
   scores(0)
 {
@@ -57,14 +59,16 @@ double DTBRules<DistanceType, TreeType>::BaseCase(const size_t queryIndex,
     ++baseCases;
     double dist = distance.Evaluate(dataSet.col(queryIndex),
                                     dataSet.col(referenceIndex));
+    if (!coreDistances.empty())
+    {
+      dist = std::max(dist, std::max(coreDistances[queryIndex],
+          coreDistances[referenceIndex]));
+    }
 
-    if (dist < neighborsDistances[queryComponentIndex])
+    if (dist <= neighborsDistances[queryComponentIndex])
     {
       Log::Assert(queryIndex != referenceIndex);
-
-      neighborsDistances[queryComponentIndex] = dist;
-      neighborsInComponent[queryComponentIndex] = queryIndex;
-      neighborsOutComponent[queryComponentIndex] = referenceIndex;
+      UpdateCandidate(queryComponentIndex, queryIndex, referenceIndex, dist);
     }
   }
 
@@ -76,6 +80,34 @@ double DTBRules<DistanceType, TreeType>::BaseCase(const size_t queryIndex,
   return newUpperBound;
 }
 
+template<typename DistanceType, typename TreeType>
+inline void DTBRules<DistanceType, TreeType>::UpdateCandidate(
+    const size_t component,
+    const size_t queryIndex,
+    const size_t referenceIndex,
+    const double dist)
+{
+  // Query points of the same component may be handled by different threads,
+  // so the candidate edge of a component is only modified in a critical
+  // section.  Other threads may read an outdated distance, but since it can
+  // only decrease, this only makes their pruning less aggressive.  Ties are
+  // broken by the indices of the points, so that the same edges are found no
+  // matter in which order the pairs are visited.
+  #pragma omp critical(DTBRulesUpdateCandidate)
+  {
+    const double oldDist = neighborsDistances[component];
+    if (dist < oldDist || (dist == oldDist &&
+        std::make_pair(queryIndex, referenceIndex) <
+        std::make_pair(neighborsInComponent[component],
+                       neighborsOutComponent[component])))
+    {
+      neighborsDistances[component] = dist;
+      neighborsInComponent[component] = queryIndex;
+      neighborsOutComponent[component] = referenceIndex;
+    }
+  }
+}
+
 template<typename DistanceType, typename TreeType>
 double DTBRules<DistanceType, TreeType>::Score(const size_t queryIndex,
                                                TreeType& referenceNode)
@@ -90,7 +122,10 @@ double DTBRules<DistanceType, TreeType>::Score(const size_t queryIndex,
     return DBL_MAX;
 
   const arma::vec queryPoint = dataSet.unsafe_col(queryIndex);
-  const double distance = referenceNode.MinDistance(queryPoint);
+  double distance = referenceNode.MinDistance(queryPoint);
+  // The mutual reachability distance is at least the core distance.
+  if (!coreDistances.empty())
+    distance = std::max(distance, coreDistances[queryIndex]);
 
   // If all the points in the reference node are farther than the candidate
   // nearest neighbor for the query's component, we prune.
@@ -178,8 +213,11 @@ inline double DTBRules<DistanceType, TreeType>::CalculateBound(
   const double worstBound = std::max(worstPointBound, worstChildBound);
   const double bestBound = std::min(bestPointBound, bestChildBound);
   // We must check that bestBound != DBL_MAX; otherwise, we risk overflow.
+  // With the mutual reachability distance, the core distance of a query point
+  // may be larger than this (it is 0 otherwise).
   const double bestAdjustedBound = (bestBound == DBL_MAX) ? DBL_MAX :
-      bestBound + 2 * queryNode.FurthestDescendantDistance();
+      std::max(bestBound + 2 * queryNode.FurthestDescendantDistance(),
+               queryNode.Stat().MaxCoreDistance());
 
   // Update the relevant quantities in the node.
   queryNode.Stat().MaxNeighborDistance() = worstBound;
@@ -40,6 +40,10 @@ class DTBStat
   //! negative.
   int componentMembership;
 
+  //! The maximum core distance of any descendant point of this node, when a
+  //! mutual reachability MST is computed (0 otherwise).
+  double maxCoreDistance;
+
  public:
   /**
    * A generic initializer.  Sets the maximum neighbor distance to its default,
@@ -49,7 +53,8 @@ class DTBStat
       maxNeighborDistance(DBL_MAX),
       minNeighborDistance(DBL_MAX),
       bound(DBL_MAX),
-      componentMembership(-1) { }
+      componentMembership(-1),
+      maxCoreDistance(0.0) { }
 
   /**
    * This is called when a node is finished initializing.  We set the maximum
@@ -65,7 +70,8 @@ class DTBStat
       bound(DBL_MAX),
       componentMembership(
           ((node.NumPoints() == 1) && (node.NumChildren() == 0)) ?
-            node.Point(0) : -1) { }
+            node.Point(0) : -1),
+      maxCoreDistance(0.0) { }
 
   //! Get the maximum neighbor distance.
   double MaxNeighborDistance() const { return maxNeighborDistance; }
@@ -86,6 +92,11 @@ class DTBStat
   int ComponentMembership() const { return componentMembership; }
   //! Modify the component membership of this node.
   int& ComponentMembership() { return componentMembership; }
+
+  //! Get the maximum core distance of any descendant point.
+  double MaxCoreDistance() const { return maxCoreDistance; }
+  //! Modify the maximum core distance of any descendant point.
+  double& MaxCoreDistance() { return maxCoreDistance; }
 }; // class DTBStat
 
 } // namespace mlpack
@@ -17,6 +17,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include <atomic>
+
 namespace mlpack {
 
 /**
@@ -25,22 +27,32 @@ namespace mlpack {
  * initially in its own component.  Calling Union(x, y) unites the components
  * indexed by x and y.  Find(x) returns the index of the component containing
  * point x.
+ *
+ * Find() and Union() may be called concurrently from several threads; the
+ * structure is lock-free.  Each element is stored as a single atomic word that
+ * holds either the index of its parent or, for the root of a component, a flag
+ * and the rank of the component.  The rank is thus updated together with the
+ * parent, and a root can only be linked below a root of strictly higher rank,
+ * so no cycles can be formed.  Find() compresses paths by path halving.  When
+ * used from a single thread, the results are the same as those of the usual
+ * union by rank.
  */
 class UnionFind
 {
  private:
-  arma::Col<size_t> parent;
-  arma::ivec rank;
+  //! The parent of each element, or rootFlag | rank for roots.
+  std::vector<std::atomic<size_t>> nodes;
+
+  //! The flag that marks a root.
+  static constexpr size_t rootFlag = size_t(1) <<
+      (std::numeric_limits<size_t>::digits - 1);
 
  public:
   //! Construct the object with the given size.
-  UnionFind(const size_t size) : parent(size), rank(size)
+  UnionFind(const size_t size) : nodes(size)
   {
     for (size_t i = 0; i < size; ++i)
-    {
-      parent[i] = i;
-      rank[i] = 0;
-    }
+      nodes[i].store(rootFlag);
   }
 
   //! Destroy the object (nothing to do).
@@ -52,17 +64,25 @@ class UnionFind
    * @param x the component to be found
    * @return The index of the component containing x
    */
-  size_t Find(const size_t x)
+  size_t Find(size_t x)
   {
-    if (parent[x] == x)
+    while (true)
     {
-      return x;
-    }
-    else
-    {
-      // This ensures that the tree has a small depth.
-      parent[x] = Find(parent[x]);
-      return parent[x];
+      const size_t parent = nodes[x].load();
+      if (parent & rootFlag)
+        return x;
+
+      const size_t grandparent = nodes[parent].load();
+      if (grandparent & rootFlag)
+        return parent;
+
+      // This ensures that the tree has a small depth.  If another thread has
+      // already changed the parent of x, it can only have been moved closer to
+      // the root, so a failure can be ignored.
+      size_t expected = parent;
+      nodes[x].compare_exchange_weak(expected, grandparent,
+          std::memory_order_relaxed);
+      x = grandparent;
     }
   }
 
@@ -71,28 +91,45 @@ class UnionFind
    *
    * @param x one component
    * @param y the other component
+   * @return false if x and y were already in the same component.
    */
-  void Union(const size_t x, const size_t y)
+  bool Union(const size_t x, const size_t y)
   {
-    const size_t xRoot = Find(x);
-    const size_t yRoot = Find(y);
-
-    if (xRoot == yRoot)
+    while (true)
     {
-      return;
-    }
-    else if (rank[xRoot] == rank[yRoot])
-    {
-      parent[yRoot] = parent[xRoot];
-      rank[xRoot] = rank[xRoot] + 1;
-    }
-    else if (rank[xRoot] > rank[yRoot])
-    {
-      parent[yRoot] = xRoot;
-    }
-    else
-    {
-      parent[xRoot] = yRoot;
+      const size_t xRoot = Find(x);
+      const size_t yRoot = Find(y);
+      if (xRoot == yRoot)
+        return false;
+
+      size_t xNode = nodes[xRoot].load();
+      size_t yNode = nodes[yRoot].load();
+
+      // Another thread may have linked one of the roots in the meantime.
+      if (!(xNode & rootFlag) || !(yNode & rootFlag))
+        continue;
+
+      const size_t xRank = xNode & ~rootFlag;
+      const size_t yRank = yNode & ~rootFlag;
+      if (xRank == yRank)
+      {
+        // Increase the rank of xRoot before linking yRoot below it, so that
+        // yRoot is linked below a root of strictly higher rank.
+        if (!nodes[xRoot].compare_exchange_strong(xNode, xNode + 1))
+          continue;
+      }
+
+      // Link the root of lower rank below the other one.  The exchange fails if
+      // the root has been linked or its rank has changed.
+      if (xRank >= yRank)
+      {
+        if (nodes[yRoot].compare_exchange_strong(yNode, xRoot))
+          return true;
+      }
+      else if (nodes[xRoot].compare_exchange_strong(xNode, yRoot))
+      {
+        return true;
+      }
     }
   }
 }; // class UnionFind
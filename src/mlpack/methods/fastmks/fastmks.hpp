@@ -307,6 +307,9 @@ class FastMKS
   //! Modify whether or not brute-force (naive) search is used.
   bool& Naive() { return naive; }
 
+  //! Get the statistics of the last search.
+  const TraversalStats& Stats() const { return stats; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -331,6 +334,13 @@ class FastMKS
   //! kernel.
   IPMetric<KernelType> distance;
 
+  //! The statistics of the last search.
+  TraversalStats stats;
+
+  //! Fill the remaining statistics of the last search, which started at the
+  //! given time.
+  void FinishStats(const std::chrono::steady_clock::time_point start);
+
   //! Candidate represents a possible candidate point (value, index).
   using Candidate = std::pair<double, size_t>;
 
@@ -345,6 +355,52 @@ class FastMKS
   //! Use a priority queue to represent the list of candidate points.
   using CandidateList = std::priority_queue<Candidate, std::vector<Candidate>,
       CandidateCmp>;
+
+  //! The dual-tree traverser to use with the given rules: the tree's
+  //! ParallelDualTreeTraverser if it has one, and its DualTreeTraverser
+  //! otherwise.
+  template<typename RuleType, typename = void>
+  struct DualTreeTraversal
+  {
+    using Type = typename Tree::template DualTreeTraverser<RuleType>;
+  };
+
+  template<typename RuleType>
+  struct DualTreeTraversal<RuleType, std::void_t<
+      typename Tree::template ParallelDualTreeTraverser<RuleType>>>
+  {
+    using Type = typename Tree::template ParallelDualTreeTraverser<RuleType>;
+  };
+
+  /**
+   * Perform naive search: evaluate the kernel between each query point and
+   * each reference point.  The query points are split into blocks that are
+   * processed in parallel, and the kernel values between a block of queries
+   * and a block of reference points are computed with KernelMatrix() (so, with
+   * the batch evaluation of the kernel, if it has one).  If sameSet is true,
+   * the query set is the reference set, and a point is not returned as its own
+   * candidate.
+   */
+  void NaiveSearch(const MatType& querySet,
+                   const size_t k,
+                   arma::Mat<size_t>& indices,
+                   arma::mat& kernels,
+                   const bool sameSet);
+
+  /**
+   * Perform single-tree search for each point in the query set, splitting the
+   * query points between threads.  Each thread caches the kernel evaluations
+   * of the reference nodes in its own rules, so the reference tree is only
+   * read.
+   */
+  void SingleTreeSearch(const MatType& querySet,
+                        const size_t k,
+                        arma::Mat<size_t>& indices,
+                        arma::mat& kernels);
+
+  //! Set the index of each node in the subtree rooted at the given node in
+  //! depth-first order, starting with the given index; return the next index.
+  static size_t IndexNodes(Tree& node, size_t index);
 };
 
 } // namespace mlpack
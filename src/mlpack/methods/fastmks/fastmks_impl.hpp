@@ -412,6 +412,12 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
     arma::Mat<size_t>& indices,
     arma::mat& kernels)
 {
+  MLPACK_PROFILE_SCOPE("FastMKS::Search");
+
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
   if (k > referenceSet->n_cols)
   {
     std::stringstream ss;
@@ -436,63 +442,31 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < querySet.n_cols; ++q)
-    {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
-
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
-      {
-        const double eval = distance.Kernel().Evaluate(querySet.col(q),
-                                                       referenceSet->col(r));
-
-        if (eval > pqueue.top().first)
-        {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
-        }
-      }
-
-      for (size_t j = 1; j <= k; ++j)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
-      }
-    }
-
+    NaiveSearch(querySet, k, indices, kernels, false);
+    stats.BaseCases() = querySet.n_cols * referenceSet->n_cols;
+    FinishStats(start);
     return;
   }
 
   // Single-tree implementation.
   if (singleMode)
   {
-    // Create rules object (this will store the results).  This constructor
-    // precalculates each self-kernel value.
-    using RuleType = FastMKSRules<KernelType, Tree>;
-    RuleType rules(*referenceSet, querySet, k, distance.Kernel());
-
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
-
-    Log::Info << rules.BaseCases() << " base cases." << std::endl;
-    Log::Info << rules.Scores() << " scores." << std::endl;
-
-    rules.GetResults(indices, kernels);
-
+    SingleTreeSearch(querySet, k, indices, kernels);
+    FinishStats(start);
     return;
   }
 
   // Dual-tree implementation.  First, we need to build the query tree.  We are
   // assuming it doesn't map anything...
   Tree queryTree(querySet);
+  const std::chrono::microseconds treeBuildingTime =
+      TraversalStats::Since(start);
 
   Search(&queryTree, k, indices, kernels);
+
+  // The search with the query tree resets the statistics.
+  stats.TreeBuildingTime() = treeBuildingTime;
+  stats.TraversalTime() = TraversalStats::Since(start) - treeBuildingTime;
 }
 
 template<typename KernelType,
@@ -506,6 +480,12 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
     arma::Mat<size_t>& indices,
     arma::mat& kernels)
 {
+  MLPACK_PROFILE_SCOPE("FastMKS::Search");
+
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
   if (k > referenceSet->n_cols)
   {
     std::stringstream ss;
@@ -536,14 +516,23 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   using RuleType = FastMKSRules<KernelType, Tree>;
   RuleType rules(*referenceSet, queryTree->Dataset(), k, distance.Kernel());
 
-  typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+  // Independent query subtrees are traversed in parallel, if the tree type
+  // supports it.
+  typename DualTreeTraversal<RuleType>::Type traverser(rules);
 
   traverser.Traverse(*queryTree, *referenceTree);
 
+  MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+
   Log::Info << rules.BaseCases() << " base cases." << std::endl;
   Log::Info << rules.Scores() << " scores." << std::endl;
 
   rules.GetResults(indices, kernels);
+
+  stats.BaseCases() = rules.BaseCases();
+  stats.Scores() = rules.Scores();
+  stats.Prunes() = traverser.NumPrunes();
+  FinishStats(start);
 }
 
 template<typename KernelType,
@@ -556,6 +545,12 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
     arma::Mat<size_t>& indices,
     arma::mat& kernels)
 {
+  MLPACK_PROFILE_SCOPE("FastMKS::Search");
+
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
   // No remapping will be necessary because we are using the cover tree.
   indices.set_size(k, referenceSet->n_cols);
   kernels.set_size(k, referenceSet->n_cols);
@@ -563,68 +558,173 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < referenceSet->n_cols; ++q)
-    {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
+    NaiveSearch(*referenceSet, k, indices, kernels, true);
+    stats.BaseCases() = referenceSet->n_cols * (referenceSet->n_cols - 1);
+    FinishStats(start);
+    return;
+  }
 
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
-      {
-        if (q == r)
-          continue; // Don't return the point as its own candidate.
+  // Single-tree implementation.
+  if (singleMode)
+  {
+    SingleTreeSearch(*referenceSet, k, indices, kernels);
+    FinishStats(start);
+    return;
+  }
+
+  // Dual-tree implementation.
+  Search(referenceTree, k, indices, kernels);
+}
+
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void FastMKS<KernelType, MatType, TreeType>::NaiveSearch(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& indices,
+    arma::mat& kernels,
+    const bool sameSet)
+{
+  // The kernel values of each block of queries are computed for one block of
+  // reference points at a time, so that each thread only holds a
+  // queryBlockSize x referenceBlockSize matrix.
+  const size_t queryBlockSize = 256;
+  const size_t referenceBlockSize = 1024;
+  const size_t numQueryBlocks = (querySet.n_cols + queryBlockSize - 1) /
+      queryBlockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < numQueryBlocks; ++b)
+  {
+    const size_t queryBegin = b * queryBlockSize;
+    const size_t queryEnd = std::min(queryBegin + queryBlockSize,
+        (size_t) querySet.n_cols);
+    const MatType queries = querySet.cols(queryBegin, queryEnd - 1);
 
-        const double eval = distance.Kernel().Evaluate(referenceSet->col(q),
-                                                       referenceSet->col(r));
+    const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+    std::vector<CandidateList> pqueues(queryEnd - queryBegin,
+        CandidateList(CandidateCmp(), std::vector<Candidate>(k, def)));
 
-        if (eval > pqueue.top().first)
+    arma::mat blockKernels;
+    for (size_t r = 0; r < referenceSet->n_cols; r += referenceBlockSize)
+    {
+      const size_t referenceEnd = std::min(r + referenceBlockSize,
+          (size_t) referenceSet->n_cols);
+      const MatType references = referenceSet->cols(r, referenceEnd - 1);
+      KernelMatrix(distance.Kernel(), queries, references, blockKernels);
+
+      for (size_t q = 0; q < queryEnd - queryBegin; ++q)
+      {
+        CandidateList& pqueue = pqueues[q];
+        for (size_t j = 0; j < referenceEnd - r; ++j)
         {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
+          // Don't return the point as its own candidate.
+          if (sameSet && (queryBegin + q == r + j))
+            continue;
+
+          const double eval = blockKernels(q, j);
+          if (eval > pqueue.top().first)
+          {
+            pqueue.pop();
+            pqueue.push(std::make_pair(eval, r + j));
+          }
         }
       }
+    }
 
+    for (size_t q = 0; q < queryEnd - queryBegin; ++q)
+    {
+      CandidateList& pqueue = pqueues[q];
       for (size_t j = 1; j <= k; ++j)
       {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
+        indices(k - j, queryBegin + q) = pqueue.top().second;
+        kernels(k - j, queryBegin + q) = pqueue.top().first;
         pqueue.pop();
       }
     }
-
-    return;
   }
+}
 
-  // Single-tree implementation.
-  if (singleMode)
-  {
-    // Create rules object (this will store the results).  This constructor
-    // precalculates each self-kernel value.
-    using RuleType = FastMKSRules<KernelType, Tree>;
-    RuleType rules(*referenceSet, *referenceSet, k, distance.Kernel());
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void FastMKS<KernelType, MatType, TreeType>::SingleTreeSearch(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& indices,
+    arma::mat& kernels)
+{
+  // Number the reference nodes, so that each thread can keep its own kernel
+  // evaluations for them.
+  const size_t numNodes = IndexNodes(*referenceTree, 0);
 
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+  // Create rules object (this will store the results).  This constructor
+  // precalculates each self-kernel value.
+  using RuleType = FastMKSRules<KernelType, Tree>;
+  RuleType rules(*referenceSet, querySet, k, distance.Kernel(), numNodes);
 
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+  size_t numPrunes = 0, threadScores = 0, threadBaseCases = 0;
+  #pragma omp parallel reduction(+:numPrunes, threadScores, threadBaseCases)
+  {
+    RuleType threadRules(rules);
+    typename Tree::template SingleTreeTraverser<RuleType>
+        traverser(threadRules);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t i = 0; i < querySet.n_cols; ++i)
       traverser.Traverse(i, *referenceTree);
 
-    // Save the number of pruned nodes.
-    const size_t numPrunes = traverser.NumPrunes();
+    MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
 
-    Log::Info << "Pruned " << numPrunes << " nodes." << std::endl;
+    numPrunes += traverser.NumPrunes();
+    threadScores += threadRules.Scores();
+    threadBaseCases += threadRules.BaseCases();
+  }
 
-    Log::Info << rules.BaseCases() << " base cases." << std::endl;
-    Log::Info << rules.Scores() << " scores." << std::endl;
+  Log::Info << "Pruned " << numPrunes << " nodes." << std::endl;
 
-    rules.GetResults(indices, kernels);
+  Log::Info << threadBaseCases << " base cases." << std::endl;
+  Log::Info << threadScores << " scores." << std::endl;
 
-    return;
-  }
+  rules.GetResults(indices, kernels);
 
-  // Dual-tree implementation.
-  Search(referenceTree, k, indices, kernels);
+  stats.BaseCases() = threadBaseCases;
+  stats.Scores() = threadScores;
+  stats.Prunes() = numPrunes;
+}
+
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void FastMKS<KernelType, MatType, TreeType>::FinishStats(
+    const std::chrono::steady_clock::time_point start)
+{
+  // Every base case evaluates the kernel once.
+  stats.DistanceEvaluations() = stats.BaseCases();
+  stats.TraversalTime() = TraversalStats::Since(start) -
+      stats.TreeBuildingTime();
+}
+
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t FastMKS<KernelType, MatType, TreeType>::IndexNodes(Tree& node,
+                                                          size_t index)
+{
+  node.Stat().Index() = index++;
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    index = IndexNodes(node.Child(i), index);
+
+  return index;
 }
 
 //! Serialize the model.
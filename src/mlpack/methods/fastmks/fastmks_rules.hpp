@@ -41,11 +41,35 @@ class FastMKSRules
    * @param querySet Set of query data.
    * @param k Number of candidates to search for.
    * @param kernel Kernel to run FastMKS with.
+   * @param numReferenceNodes If nonzero, the last kernel evaluation of each
+   *     reference node during single-tree search is cached in this object
+   *     instead of in the node statistic; the index of each node (in
+   *     [0, numReferenceNodes)) must then be held by its statistic.
    */
   FastMKSRules(const typename TreeType::Mat& referenceSet,
                const typename TreeType::Mat& querySet,
                const size_t k,
-               KernelType& kernel);
+               KernelType& kernel,
+               const size_t numReferenceNodes = 0);
+
+  /**
+   * Copy the given FastMKSRules object for use by a different thread of a
+   * parallel traversal.  The copy has its own traversal information, caches,
+   * and counters, but it shares the list of candidates for each query point
+   * with the original object.  So, the original object must outlive the copy,
+   * and any two copies must only be used to search for disjoint sets of query
+   * points.  If the original object caches the reference node kernels itself,
+   * then two copies can run single-tree searches on the same reference tree at
+   * the same time.
+   *
+   * @param other FastMKSRules object to share candidates with.
+   */
+  FastMKSRules(const FastMKSRules& other);
+
+  /**
+   * Delete the list of candidates, if this object owns it.
+   */
+  ~FastMKSRules();
 
   /**
    * Store the list of candidates for each query point in the given matrices.
@@ -146,8 +170,11 @@ class FastMKSRules
 
   //! Set of candidates for each point.  We use a min-heap built on a
   //! std::vector to represent the list of candidate points for each query
-  //! point.
-  std::vector<std::vector<Candidate>> candidates;
+  //! point.  This may be shared with other copies of this object.
+  std::vector<std::vector<Candidate>>* candidates;
+
+  //! If true, this object owns the candidate lists and must delete them.
+  bool ownsCandidates;
 
   //! Number of points to search for.
   const size_t k;
@@ -167,6 +194,17 @@ class FastMKSRules
   //! The last kernel evaluation resulting from BaseCase().
   double lastKernel;
 
+  //! The last kernel evaluation of each reference node in single-tree search,
+  //! indexed by the node's index; if empty, it is held by the node statistic.
+  std::vector<double> nodeKernels;
+
+  //! Get the last kernel evaluation of the given reference node.
+  double& NodeKernel(TreeType& node)
+  {
+    return nodeKernels.empty() ? node.Stat().LastKernel() :
+        nodeKernels[node.Stat().Index()];
+  }
+
   //! Calculate the bound for a given query node.
   double CalculateBound(TreeType& queryNode) const;
 
@@ -22,14 +22,18 @@ FastMKSRules<KernelType, TreeType>::FastMKSRules(
     const typename TreeType::Mat& referenceSet,
     const typename TreeType::Mat& querySet,
     const size_t k,
-    KernelType& kernel) :
+    KernelType& kernel,
+    const size_t numReferenceNodes) :
     referenceSet(referenceSet),
     querySet(querySet),
+    candidates(new std::vector<std::vector<Candidate>>()),
+    ownsCandidates(true),
     k(k),
     kernel(kernel),
     lastQueryIndex(-1),
     lastReferenceIndex(-1),
     lastKernel(0.0),
+    nodeKernels(numReferenceNodes),
     baseCases(0),
     scores(0)
 {
@@ -57,7 +61,35 @@ FastMKSRules<KernelType, TreeType>::FastMKSRules(
 
   std::vector<Candidate> pqueue(k, def);
   std::make_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
-  candidates = std::vector<std::vector<Candidate>>(querySet.n_cols, pqueue);
+  candidates->resize(querySet.n_cols, pqueue);
+}
+
+template<typename KernelType, typename TreeType>
+FastMKSRules<KernelType, TreeType>::FastMKSRules(const FastMKSRules& other) :
+    referenceSet(other.referenceSet),
+    querySet(other.querySet),
+    candidates(other.candidates),
+    ownsCandidates(false),
+    k(other.k),
+    queryKernels(other.queryKernels),
+    referenceKernels(other.referenceKernels),
+    kernel(other.kernel),
+    lastQueryIndex(-1),
+    lastReferenceIndex(-1),
+    lastKernel(0.0),
+    nodeKernels(other.nodeKernels.size()),
+    baseCases(0),
+    scores(0),
+    traversalInfo(other.traversalInfo)
+{
+  // Nothing to do.
+}
+
+template<typename KernelType, typename TreeType>
+FastMKSRules<KernelType, TreeType>::~FastMKSRules()
+{
+  if (ownsCandidates)
+    delete candidates;
 }
 
 template<typename KernelType, typename TreeType>
@@ -70,7 +102,7 @@ void FastMKSRules<KernelType, TreeType>::GetResults(
 
   for (size_t i = 0; i < querySet.n_cols; ++i)
   {
-    std::vector<Candidate>& pqueue = candidates[i];
+    std::vector<Candidate>& pqueue = (*candidates)[i];
     std::sort_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
     for (size_t j = 0; j < k; ++j)
     {
@@ -102,6 +134,8 @@ double FastMKSRules<KernelType, TreeType>::BaseCase(
   }
 
   ++baseCases;
+  MLPACK_PROFILE_COUNT(BaseCases, 1);
+  MLPACK_PROFILE_COUNT(DistanceEvaluations, 1);
   double kernelEval = kernel.Evaluate(querySet.col(queryIndex),
                                       referenceSet.col(referenceIndex));
 
@@ -125,7 +159,7 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
                                                  TreeType& referenceNode)
 {
   // Compare with the current best.
-  const double bestKernel = candidates[queryIndex].front().first;
+  const double bestKernel = (*candidates)[queryIndex].front().first;
 
   // See if we can perform a parent-child prune.
   const double furthestDist = referenceNode.FurthestDescendantDistance();
@@ -134,7 +168,7 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
     double maxKernelBound;
     const double parentDist = referenceNode.ParentDistance();
     const double combinedDistBound = parentDist + furthestDist;
-    const double lastKernel = referenceNode.Parent()->Stat().LastKernel();
+    const double lastKernel = NodeKernel(*referenceNode.Parent());
     if (KernelTraits<KernelType>::IsNormalized)
     {
       const double squaredDist = std::pow(combinedDistBound, 2.0);
@@ -164,6 +198,7 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
   // Calculate the maximum possible kernel value, either by calculating the
   // centroid or, if the centroid is a point, use that.
   ++scores;
+  MLPACK_PROFILE_COUNT(Scores, 1);
   double kernelEval;
   if (TreeTraits<TreeType>::FirstPointIsCentroid)
   {
@@ -172,7 +207,7 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
         referenceNode.Parent() != NULL &&
         referenceNode.Point(0) == referenceNode.Parent()->Point(0))
     {
-      kernelEval = referenceNode.Parent()->Stat().LastKernel();
+      kernelEval = NodeKernel(*referenceNode.Parent());
     }
     else
     {
@@ -185,9 +220,10 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
     referenceNode.Center(refCenter);
 
     kernelEval = kernel.Evaluate(querySet.col(queryIndex), refCenter);
+    MLPACK_PROFILE_COUNT(DistanceEvaluations, 1);
   }
 
-  referenceNode.Stat().LastKernel() = kernelEval;
+  NodeKernel(referenceNode) = kernelEval;
 
   double maxKernel;
   if (KernelTraits<KernelType>::IsNormalized)
@@ -355,10 +391,12 @@ double FastMKSRules<KernelType, TreeType>::Score(TreeType& queryNode,
     referenceNode.Center(refCenter);
 
     kernelEval = kernel.Evaluate(queryCenter, refCenter);
+    MLPACK_PROFILE_COUNT(DistanceEvaluations, 1);
 
     traversalInfo.LastBaseCase() = kernelEval;
   }
   ++scores;
+  MLPACK_PROFILE_COUNT(Scores, 1);
 
   double maxKernel;
   if (KernelTraits<KernelType>::IsNormalized)
@@ -410,7 +448,7 @@ double FastMKSRules<KernelType, TreeType>::Rescore(const size_t queryIndex,
                                                    TreeType& /*referenceNode*/,
                                                    const double oldScore) const
 {
-  const double bestKernel = candidates[queryIndex].front().first;
+  const double bestKernel = (*candidates)[queryIndex].front().first;
 
   return ((1.0 / oldScore) >= bestKernel) ? oldScore : DBL_MAX;
 }
@@ -457,7 +495,7 @@ double FastMKSRules<KernelType, TreeType>::CalculateBound(TreeType& queryNode)
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
     const size_t point = queryNode.Point(i);
-    const std::vector<Candidate>& candidatesPoints = candidates[point];
+    const std::vector<Candidate>& candidatesPoints = (*candidates)[point];
     if (candidatesPoints.front().first < worstPointKernel)
       worstPointKernel = candidatesPoints.front().first;
 
@@ -527,7 +565,7 @@ inline void FastMKSRules<KernelType, TreeType>::InsertNeighbor(
     const size_t index,
     const double product)
 {
-  std::vector<Candidate>& pqueue = candidates[queryIndex];
+  std::vector<Candidate>& pqueue = (*candidates)[queryIndex];
   if (product > pqueue.front().first)
   {
     Candidate c = std::make_pair(product, index);
@@ -31,7 +31,8 @@ class FastMKSStat
       bound(-DBL_MAX),
       selfKernel(0.0),
       lastKernel(0.0),
-      lastKernelNode(NULL)
+      lastKernelNode(NULL),
+      index(0)
   { }
 
   /**
@@ -45,7 +46,8 @@ class FastMKSStat
   FastMKSStat(const TreeType& node) :
       bound(-DBL_MAX),
       lastKernel(0.0),
-      lastKernelNode(NULL)
+      lastKernelNode(NULL),
+      index(0)
   {
     // Do we have to calculate the centroid?
     if (TreeTraits<TreeType>::FirstPointIsCentroid)
@@ -97,6 +99,13 @@ class FastMKSStat
   //! evaluation.
   void*& LastKernelNode() { return lastKernelNode; }
 
+  //! Get the index of the node in the tree.  This is set by FastMKS before a
+  //! parallel single-tree search, so that each thread can cache its last
+  //! kernel evaluations for every node outside of the statistic.
+  size_t Index() const { return index; }
+  //! Modify the index of the node in the tree.
+  size_t& Index() { return index; }
+
   //! Serialize the statistic.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
@@ -125,6 +134,9 @@ class FastMKSStat
   //! The node corresponding to the last kernel evaluation.  This has to be void
   //! otherwise we get recursive template arguments.
   void* lastKernelNode;
+
+  //! The index of the node in the tree (not serialized).
+  size_t index;
 };
 
 } // namespace mlpack
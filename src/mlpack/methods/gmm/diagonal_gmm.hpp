@@ -19,6 +19,8 @@
 
 // This is the default fitting method class.
 #include "em_fit.hpp"
+#include "stepwise_em_fit.hpp"
+#include "mixture_log_probability.hpp"
 
 // This is the default covariance matrix constraint.
 #include "diagonal_constraint.hpp"
@@ -278,6 +280,29 @@ class DiagonalGMM
                const bool useExistingModel = false,
                FittingType fitter = FittingType());
 
+  /**
+   * Estimate the probability distribution from the observations read from the
+   * given source, using the given FittingType, which must provide an
+   * Estimate() overload taking a data::ChunkedSource (such as StepwiseEMFit).
+   * Only one chunk of the source is held in memory at a time, so this can be
+   * used for datasets that are much larger than the available memory.
+   *
+   * Optionally, the existing model can be used as an initial model for the
+   * estimation by setting 'useExistingModel' to true.
+   *
+   * @param source Source of the observations.
+   * @param useExistingModel If true, the existing model is used as an initial
+   *     model for the estimation.
+   * @param fitter The fitter to use, optional.
+   * @return The log-likelihood returned by the fitter (for StepwiseEMFit, the
+   *     log-likelihood of the points during the last pass).
+   */
+  template<typename eT, typename FittingType = StepwiseEMFit<KMeans<>,
+      DiagonalConstraint, DiagonalGaussianDistribution<>>>
+  double Train(data::ChunkedSource<eT>& source,
+               const bool useExistingModel = false,
+               FittingType fitter = FittingType());
+
   /**
    * Classify the given observations as being from an individual component in
    * this DiagonalGMM. The resultant classifications are stored in the 'labels'
@@ -164,24 +164,7 @@ inline void DiagonalGMM::LogProbability(const arma::mat& observation,
 {
   // Sum the probability for each Gaussian in our mixture (and we have to
   // multiply by the prior for each Gaussian too).
-  logProbs.set_size(observation.n_cols);
-
-  // Store log-probability value in a matrix.
-  arma::mat logProb(observation.n_cols, gaussians);
-
-  // Assign value to the matrix.
-  for (size_t i = 0; i < gaussians; i++)
-  {
-    arma::vec temp(logProb.colptr(i), observation.n_cols, false, true);
-    dists[i].LogProbability(observation, temp);
-  }
-
-  // Save log(weights) as a vector.
-  arma::vec logWeights = log(weights);
-
-  // Compute log-probability.
-  logProb += repmat(logWeights.t(), logProb.n_rows, 1);
-  LogSumExp(logProb, logProbs);
+  MixtureLogProbability(observation, dists, weights, logProbs);
 }
 
 /**
@@ -261,25 +244,10 @@ inline arma::vec DiagonalGMM::Random() const
 inline void DiagonalGMM::Classify(const arma::mat& observations,
                                   arma::Row<size_t>& labels) const
 {
-  // This is not the best way to do this!
-
-  // We should not have to fill this with values, because each one should be
-  // overwritten.
-  labels.set_size(observations.n_cols);
-  for (size_t i = 0; i < observations.n_cols; ++i)
-  {
-    // Find maximum probability component.
-    double probability = 0;
-    for (size_t j = 0; j < gaussians; ++j)
-    {
-      double newProb = Probability(observations.unsafe_col(i), j);
-      if (newProb >= probability)
-      {
-        probability = newProb;
-        labels[i] = j;
-      }
-    }
-  }
+  // Find the maximum probability component of each point, using
+  // log-probabilities so that they do not underflow.
+  arma::vec logProbs;
+  MixtureLogProbability(observations, dists, weights, logProbs, &labels);
 }
 
 /**
@@ -290,26 +258,18 @@ inline double DiagonalGMM::LogLikelihood(
     const std::vector<DiagonalGaussianDistribution<>>& dists,
     const arma::vec& weights) const
 {
-  double logLikelihood = 0;
-  arma::vec phis;
-  arma::mat likelihoods(gaussians, observations.n_cols);
+  arma::vec logProbs;
+  MixtureLogProbability(observations, dists, weights, logProbs);
 
-  for (size_t i = 0; i < gaussians; ++i)
+  const size_t zeroPoints = arma::accu(logProbs ==
+      -std::numeric_limits<double>::infinity());
+  if (zeroPoints > 0)
   {
-    dists[i].Probability(observations, phis);
-    likelihoods.row(i) = weights(i) * trans(phis);
+    Log::Info << "Likelihood of " << zeroPoints << " points is 0!  They are "
+        << "probably outliers." << std::endl;
   }
 
-  // Now sum over every point.
-  for (size_t j = 0; j < observations.n_cols; ++j)
-  {
-    if (accu(likelihoods.col(j)) == 0)
-      Log::Info << "Likelihood of point " << j << " is 0!  It is probably an "
-          << "outlier." << std::endl;
-    logLikelihood += std::log(accu(likelihoods.col(j)));
-  }
-
-  return logLikelihood;
+  return arma::accu(logProbs);
 }
 
 /**
@@ -400,6 +360,31 @@ double DiagonalGMM::Train(const arma::mat& observations,
   return bestLikelihood;
 }
 
+/**
+ * Fit the DiagonalGMM to the observations read from the given source.
+ */
+template<typename eT, typename FittingType>
+double DiagonalGMM::Train(data::ChunkedSource<eT>& source,
+                          const bool useExistingModel,
+                          FittingType fitter)
+{
+  if (source.Dimensionality() != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "DiagonalGMM::Train(): dimensionality of source ("
+        << source.Dimensionality() << ") does not match the dimensionality "
+        << "of the model (" << dimensionality << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const double logLikelihood = fitter.Estimate(source, dists, weights,
+      useExistingModel);
+
+  Log::Info << "DiagonalGMM::Train(): log-likelihood of trained GMM is "
+      << logLikelihood << "." << std::endl;
+  return logLikelihood;
+}
+
 //! Serialize the object.
 template<typename Archive>
 void DiagonalGMM::serialize(Archive& ar, const uint32_t /* version */)
@@ -160,6 +160,28 @@ class EMFit
       const std::vector<Distribution>& dists,
       const arma::vec& weights) const;
 
+  /**
+   * Perform one iteration of EM: compute the probability of each observation
+   * coming from each distribution (the E-step), and then update the
+   * distributions and their weights (the M-step).  The observations are
+   * processed in blocks of blockSize points, which are split between OpenMP
+   * threads; each thread accumulates its own sums, and these are combined
+   * once per pass.
+   *
+   * @param observations List of observations.
+   * @param probabilities Probability of each observation being from the
+   *     model, or NULL if all observations are certain.
+   * @param dists Distributions to update.
+   * @param weights A priori weights to update.
+   * @param responsibilities Matrix of size dists.size() x observations.n_cols
+   *     used to store the conditional probabilities.
+   */
+  void Iterate(const arma::mat& observations,
+               const arma::vec* probabilities,
+               std::vector<Distribution>& dists,
+               arma::vec& weights,
+               arma::mat& responsibilities);
+
   /**
    * Use the Armadillo gmm_diag clusterer to train a GMM with diagonal
    * covariance.  If InitialClusteringType == KMeans<>, this will use
@@ -176,6 +198,9 @@ class EMFit
       arma::vec& weights,
       const bool useInitialModel);
 
+  //! Number of points processed at once in each pass over the data.
+  static constexpr size_t blockSize = 1024;
+
   //! Maximum iterations of EM algorithm.
   size_t maxIterations;
   //! Tolerance for convergence of EM.
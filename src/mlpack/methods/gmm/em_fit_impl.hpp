@@ -17,6 +17,8 @@
 #include "em_fit.hpp"
 #include "diagonal_constraint.hpp"
 #include <mlpack/core/math/log_add.hpp>
+#include <mlpack/core/math/make_alias.hpp>
+#include "mixture_log_probability.hpp"
 
 namespace mlpack {
 
@@ -75,7 +77,7 @@ Estimate(const arma::mat& observations,
       << l << std::endl;
 
   double lOld = -DBL_MAX;
-  arma::mat condLogProb(observations.n_cols, dists.size());
+  arma::mat responsibilities(dists.size(), observations.n_cols);
 
   // Iterate to update the model until no more improvement is found.
   size_t iteration = 1;
@@ -84,76 +86,7 @@ Estimate(const arma::mat& observations,
     Log::Info << "EMFit::Estimate(): iteration " << iteration << ", "
         << "log-likelihood " << l << "." << std::endl;
 
-    // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Store conditional log probabilities into condLogProb vector for each
-      // Gaussian.  First we make an alias of the condLogProb vector.
-      arma::vec condLogProbAlias = condLogProb.unsafe_col(i);
-      dists[i].LogProbability(observations, condLogProbAlias);
-      condLogProbAlias += std::log(weights[i]);
-    }
-
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
-    {
-      // Avoid dividing by zero; if the probability for everything is 0, we
-      // don't want to make it NaN.
-      const double probSum = AccuLog(condLogProb.row(i));
-      if (probSum != -std::numeric_limits<double>::infinity())
-        condLogProb.row(i) -= probSum;
-    }
-
-    // Store the sum of the probability of each state over all the observations.
-    arma::vec probRowSums(dists.size());
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      probRowSums(i) = AccuLog(condLogProb.col(i));
-    }
-
-    // Calculate the new value of the means using the updated conditional
-    // probabilities.
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Don't update if there's no probability of the Gaussian having points.
-      if (probRowSums[i] != -std::numeric_limits<double>::infinity())
-        dists[i].Mean() = observations * exp(condLogProb.col(i) -
-                                                   probRowSums[i]);
-      else
-        continue;
-
-      // Calculate the new value of the covariances using the updated
-      // conditional probabilities and the updated means.
-      arma::mat tmp = observations.each_col() - dists[i].Mean();
-
-      // If the distribution is DiagonalGaussianDistribution, calculate the
-      // covariance only with diagonal components.
-      if (std::is_same_v<Distribution, DiagonalGaussianDistribution<>>)
-      {
-        arma::vec covariance = sum((tmp % tmp) %
-            (ones<arma::vec>(observations.n_rows) *
-            trans(exp(condLogProb.col(i) - probRowSums[i]))), 1);
-
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(covariance);
-        dists[i].Covariance(std::move(covariance));
-      }
-      else
-      {
-        arma::mat tmpB = tmp.each_row() % trans(exp(condLogProb.col(i) -
-                                                          probRowSums[i]));
-        arma::mat covariance = tmp * trans(tmpB);
-
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(covariance);
-        dists[i].Covariance(std::move(covariance));
-      }
-    }
-
-    // Calculate the new values for omega using the updated conditional
-    // probabilities.
-    weights = exp(probRowSums - std::log(observations.n_cols));
+    Iterate(observations, NULL, dists, weights, responsibilities);
 
     // Update values of l; calculate new log-likelihood.
     lOld = l;
@@ -182,90 +115,13 @@ Estimate(const arma::mat& observations,
       << l << std::endl;
 
   double lOld = -DBL_MAX;
-  arma::mat condLogProb(observations.n_cols, dists.size());
+  arma::mat responsibilities(dists.size(), observations.n_cols);
 
   // Iterate to update the model until no more improvement is found.
   size_t iteration = 1;
   while (std::abs(l - lOld) > tolerance && iteration != maxIterations)
   {
-    // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Store conditional log probabilities into condLogProb vector for each
-      // Gaussian.  First we make an alias of the condLogProb vector.
-      arma::vec condLogProbAlias = condLogProb.unsafe_col(i);
-      dists[i].LogProbability(observations, condLogProbAlias);
-      condLogProbAlias += std::log(weights[i]);
-    }
-
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
-    {
-      // Avoid dividing by zero; if the probability for everything is 0, we
-      // don't want to make it NaN.
-      const double probSum = AccuLog(condLogProb.row(i));
-      if (probSum != -std::numeric_limits<double>::infinity())
-        condLogProb.row(i) -= probSum;
-    }
-
-    // This will store the sum of probabilities of each state over all the
-    // observations.
-    arma::vec probRowSums(dists.size());
-
-    // Calculate the new value of the means using the updated conditional
-    // probabilities.
-    arma::vec logProbabilities = log(probabilities);
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Calculate the sum of probabilities of points, which is the
-      // conditional probability of each point being from Gaussian i
-      // multiplied by the probability of the point being from this mixture
-      // model.
-      arma::vec tmpProb = condLogProb.col(i) + logProbabilities;
-      probRowSums[i] = AccuLog(tmpProb);
-
-      // Don't update if there's no probability of the Gaussian having points.
-      if (probRowSums[i] != -std::numeric_limits<double>::infinity())
-      {
-        dists[i].Mean() = observations *
-              exp(condLogProb.col(i) + logProbabilities - probRowSums[i]);
-      }
-      else
-        continue;
-
-      // Calculate the new value of the covariances using the updated
-      // conditional probabilities and the updated means.
-      arma::mat tmp = observations.each_col() - dists[i].Mean();
-
-      // If the distribution is DiagonalGaussianDistribution, calculate the
-      // covariance only with diagonal components.
-      if (std::is_same_v<Distribution, DiagonalGaussianDistribution<>>)
-      {
-        arma::vec cov = sum((tmp % tmp) %
-            (ones<arma::vec>(observations.n_rows) *
-            trans(exp(condLogProb.col(i) +
-                            logProbabilities - probRowSums[i]))), 1);
-
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(cov);
-        dists[i].Covariance(std::move(cov));
-      }
-      else
-      {
-        arma::mat tmpB = tmp.each_row() % trans(exp(condLogProb.col(i) +
-            logProbabilities - probRowSums[i]));
-        arma::mat cov = (tmp * trans(tmpB));
-
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(cov);
-        dists[i].Covariance(std::move(cov));
-      }
-    }
-
-    // Calculate the new values for omega using the updated conditional
-    // probabilities.
-    weights = exp(probRowSums - AccuLog(logProbabilities));
+    Iterate(observations, &probabilities, dists, weights, responsibilities);
 
     // Update values of l; calculate new log-likelihood.
     lOld = l;
@@ -377,30 +233,200 @@ LogLikelihood(const arma::mat& observations,
               const std::vector<Distribution>& dists,
               const arma::vec& weights) const
 {
+  const size_t numBlocks = (observations.n_cols + blockSize - 1) / blockSize;
+  const arma::vec logWeights = arma::log(weights);
+
   double logLikelihood = 0;
+  size_t zeroPoints = 0;
+  #pragma omp parallel reduction(+:logLikelihood, zeroPoints)
+  {
+    arma::mat logLikelihoods;
 
-  arma::vec logPhis;
-  arma::mat logLikelihoods(dists.size(), observations.n_cols);
+    #pragma omp for schedule(static)
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t count = std::min(blockSize, observations.n_cols - begin);
+      arma::mat block;
+      MakeAlias(block, observations, observations.n_rows, count,
+          begin * observations.n_rows, false);
+
+      // It has to be LogProbability() otherwise Probability() would overflow
+      // easily.
+      ComponentLogProbabilities(block, dists, logWeights, logLikelihoods);
+
+      // Now sum over every point.
+      for (size_t j = 0; j < count; ++j)
+      {
+        const double pointLogLikelihood = AccuLog(logLikelihoods.col(j));
+        if (pointLogLikelihood == -std::numeric_limits<double>::infinity())
+          ++zeroPoints;
+        logLikelihood += pointLogLikelihood;
+      }
+    }
+  }
 
-  // It has to be LogProbability() otherwise Probability() would overflow easily
-  for (size_t i = 0; i < dists.size(); ++i)
+  if (zeroPoints > 0)
   {
-    dists[i].LogProbability(observations, logPhis);
-    logLikelihoods.row(i) = std::log(weights(i)) + trans(logPhis);
+    Log::Info << "Likelihood of " << zeroPoints << " points is 0!  They are "
+        << "probably outliers." << std::endl;
   }
-  // Now sum over every point.
-  for (size_t j = 0; j < observations.n_cols; ++j)
+
+  return logLikelihood;
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+Iterate(const arma::mat& observations,
+        const arma::vec* probabilities,
+        std::vector<Distribution>& dists,
+        arma::vec& weights,
+        arma::mat& responsibilities)
+{
+  const size_t numDists = dists.size();
+  const size_t dimensionality = observations.n_rows;
+  const size_t numBlocks = (observations.n_cols + blockSize - 1) / blockSize;
+  const arma::vec logWeights = arma::log(weights);
+
+  // Calculate the conditional probabilities of choosing a particular Gaussian
+  // given the observations and the present theta value, one block of points
+  // at a time.  Each thread accumulates the sum of the probabilities of each
+  // Gaussian and the weighted sum of the points, which are then used for the
+  // new means.
+  arma::vec probSums(numDists, arma::fill::zeros);
+  arma::mat means(dimensionality, numDists, arma::fill::zeros);
+  #pragma omp parallel
   {
-    if (AccuLog(logLikelihoods.col(j)) ==
-        -std::numeric_limits<double>::infinity())
+    arma::vec localProbSums(numDists, arma::fill::zeros);
+    arma::mat localMeans(dimensionality, numDists, arma::fill::zeros);
+    arma::mat condLogProb;
+
+    #pragma omp for schedule(static) nowait
+    for (size_t b = 0; b < numBlocks; ++b)
     {
-      Log::Info << "Likelihood of point " << j << " is 0!  It is probably an "
-          << "outlier." << std::endl;
+      const size_t begin = b * blockSize;
+      const size_t count = std::min(blockSize, observations.n_cols - begin);
+      arma::mat block, blockProb;
+      MakeAlias(block, observations, dimensionality, count,
+          begin * dimensionality, false);
+      MakeAlias(blockProb, responsibilities, numDists, count,
+          begin * numDists, false);
+
+      ComponentLogProbabilities(block, dists, logWeights, condLogProb);
+
+      // Normalize each point.
+      for (size_t j = 0; j < count; ++j)
+      {
+        // Avoid dividing by zero; if the probability for everything is 0, we
+        // don't want to make it NaN.
+        const double probSum = AccuLog(condLogProb.col(j));
+        if (probSum == -std::numeric_limits<double>::infinity())
+        {
+          blockProb.col(j).zeros();
+          continue;
+        }
+
+        blockProb.col(j) = arma::exp(condLogProb.col(j) - probSum);
+        if (probabilities != NULL)
+          blockProb.col(j) *= (*probabilities)[begin + j];
+      }
+
+      localProbSums += arma::sum(blockProb, 1);
+      localMeans += block * trans(blockProb);
+    }
+
+    #pragma omp critical
+    {
+      probSums += localProbSums;
+      means += localMeans;
     }
-    logLikelihood += AccuLog(logLikelihoods.col(j));
   }
 
-  return logLikelihood;
+  // Don't update a Gaussian if there's no probability of it having points.
+  for (size_t i = 0; i < numDists; ++i)
+    if (probSums[i] > 0.0)
+      means.col(i) /= probSums[i];
+
+  // Now calculate the new covariances using the updated means, with another
+  // pass over the blocks.
+  constexpr bool isDiagGaussDist = std::is_same_v<Distribution,
+      DiagonalGaussianDistribution<>>;
+  using CovType = std::conditional_t<isDiagGaussDist, arma::vec, arma::mat>;
+  std::vector<CovType> covs(numDists);
+  for (size_t i = 0; i < numDists; ++i)
+  {
+    // If the distribution is DiagonalGaussianDistribution, calculate the
+    // covariance only with diagonal components.
+    if constexpr (isDiagGaussDist)
+      covs[i].zeros(dimensionality);
+    else
+      covs[i].zeros(dimensionality, dimensionality);
+  }
+
+  #pragma omp parallel
+  {
+    std::vector<CovType> localCovs(covs);
+    arma::mat diffs, weightedDiffs;
+    arma::rowvec blockProb;
+
+    #pragma omp for schedule(static) nowait
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t count = std::min(blockSize, observations.n_cols - begin);
+      arma::mat block;
+      MakeAlias(block, observations, dimensionality, count,
+          begin * dimensionality, false);
+
+      for (size_t i = 0; i < numDists; ++i)
+      {
+        if (probSums[i] == 0.0)
+          continue;
+
+        blockProb = responsibilities.submat(i, begin, i, begin + count - 1);
+        diffs = block;
+        diffs.each_col() -= means.col(i);
+        if constexpr (isDiagGaussDist)
+        {
+          localCovs[i] += arma::square(diffs) * trans(blockProb);
+        }
+        else
+        {
+          weightedDiffs = diffs;
+          weightedDiffs.each_row() %= blockProb;
+          localCovs[i] += diffs * trans(weightedDiffs);
+        }
+      }
+    }
+
+    #pragma omp critical
+    {
+      for (size_t i = 0; i < numDists; ++i)
+        covs[i] += localCovs[i];
+    }
+  }
+
+  for (size_t i = 0; i < numDists; ++i)
+  {
+    if (probSums[i] == 0.0)
+      continue;
+
+    dists[i].Mean() = means.col(i);
+    covs[i] /= probSums[i];
+
+    // Apply covariance constraint.
+    constraint.ApplyConstraint(covs[i]);
+    dists[i].Covariance(std::move(covs[i]));
+  }
+
+  // Calculate the new values for omega using the updated conditional
+  // probabilities.
+  if (probabilities != NULL)
+    weights = probSums / arma::accu(*probabilities);
+  else
+    weights = probSums / observations.n_cols;
 }
 
 template<typename InitialClusteringType,
@@ -81,24 +81,7 @@ inline void GMM::LogProbability(const arma::mat& observation,
 {
   // Sum the probability for each Gaussian in our mixture (and we have to
   // multiply by the prior for each Gaussian too).
-  logProbs.set_size(observation.n_cols);
-
-  // Store log-probability value in a matrix.
-  arma::mat logProb(observation.n_cols, gaussians);
-
-  // Assign value to the matrix.
-  for (size_t i = 0; i < gaussians; i++)
-  {
-    arma::vec temp(logProb.colptr(i), observation.n_cols, false, true);
-    dists[i].LogProbability(observation, temp);
-  }
-
-  // Save log(weights) as a vector.
-  arma::vec logWeights = log(weights);
-
-  // Compute log-probability.
-  logProb += repmat(logWeights.t(), logProb.n_rows, 1);
-  LogSumExp(logProb, logProbs);
+  MixtureLogProbability(observation, dists, weights, logProbs);
 }
 
 /**
@@ -194,27 +177,10 @@ inline arma::vec GMM::Random() const
 inline void GMM::Classify(const arma::mat& observations,
                           arma::Row<size_t>& labels) const
 {
-  // This is not the best way to do this!
-
-  // We should not have to fill this with values, because each one should be
-  // overwritten.
-  labels.set_size(observations.n_cols);
-  for (size_t i = 0; i < observations.n_cols; ++i)
-  {
-    // Find maximum probability component.
-    double probability = -std::numeric_limits<double>::infinity();
-    for (size_t j = 0; j < gaussians; ++j)
-    {
-      // We have to use LogProbability() otherwise Probability() would overflow
-      // easily.
-      double newProb = LogProbability(observations.unsafe_col(i), j);
-      if (newProb >= probability)
-      {
-        probability = newProb;
-        labels[i] = j;
-      }
-    }
-  }
+  // Find the maximum probability component of each point.  We have to use
+  // log-probabilities, otherwise the probabilities would underflow easily.
+  arma::vec logProbs;
+  MixtureLogProbability(observations, dists, weights, logProbs, &labels);
 }
 
 /**
@@ -229,21 +195,11 @@ inline double GMM::LogLikelihood(
     const std::vector<GaussianDistribution<>>& distsL,
     const arma::vec& weightsL) const
 {
-  double loglikelihood = 0;
-  arma::vec logPhis;
-  arma::mat logLikelihoods(gaussians, data.n_cols);
-
-  // It has to be LogProbability() otherwise Probability() would overflow easily
-  for (size_t i = 0; i < gaussians; ++i)
-  {
-    distsL[i].LogProbability(data, logPhis);
-    logLikelihoods.row(i) = std::log(weightsL(i)) + trans(logPhis);
-  }
-
-  // Now sum over every point.
-  for (size_t j = 0; j < data.n_cols; ++j)
-    loglikelihood += AccuLog(logLikelihoods.col(j));
-  return loglikelihood;
+  // It has to be LogProbability() otherwise Probability() would overflow
+  // easily.
+  arma::vec logProbs;
+  MixtureLogProbability(data, distsL, weightsL, logProbs);
+  return arma::accu(logProbs);
 }
 
 /**
@@ -413,6 +369,31 @@ double GMM::Train(const arma::mat& observations,
   return bestLikelihood;
 }
 
+/**
+ * Fit the GMM to the observations read from the given source.
+ */
+template<typename eT, typename FittingType>
+double GMM::Train(data::ChunkedSource<eT>& source,
+                  const bool useExistingModel,
+                  FittingType fitter)
+{
+  if (source.Dimensionality() != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "GMM::Train(): dimensionality of source ("
+        << source.Dimensionality() << ") does not match the dimensionality "
+        << "of the model (" << dimensionality << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const double logLikelihood = fitter.Estimate(source, dists, weights,
+      useExistingModel);
+
+  Log::Info << "GMM::Train(): log-likelihood of trained GMM is "
+      << logLikelihood << "." << std::endl;
+  return logLikelihood;
+}
+
 /**
  * Serialize the object.
  */
@@ -0,0 +1,117 @@
+/**
+ * @file methods/gmm/mixture_log_probability.hpp
+ *
+ * Utility functions to compute the log-probabilities of a block of points
+ * under every component of a mixture at once, used by GMM, DiagonalGMM and
+ * EMFit.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_MIXTURE_LOG_PROBABILITY_HPP
+#define MLPACK_METHODS_GMM_MIXTURE_LOG_PROBABILITY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/log_add.hpp>
+#include <mlpack/core/math/make_alias.hpp>
+
+namespace mlpack {
+
+/**
+ * Compute the weighted log-probability of each point of `block` under each
+ * component of a mixture; after the call, `logProbs(i, j)` is
+ * `logWeights[i] + log p_i(block.col(j))`.  Each component evaluates the whole
+ * block at once with its batch LogProbability() (for GaussianDistribution,
+ * that is a triangular solve against the cached Cholesky factor of the
+ * covariance).
+ *
+ * @param block Points to evaluate.
+ * @param dists Components of the mixture.
+ * @param logWeights Log of the weight of each component.
+ * @param logProbs Will hold the weighted log-probabilities (one row per
+ *     component, one column per point).
+ */
+template<typename DistributionType>
+void ComponentLogProbabilities(const arma::mat& block,
+                               const std::vector<DistributionType>& dists,
+                               const arma::vec& logWeights,
+                               arma::mat& logProbs)
+{
+  arma::vec logPhis;
+  logProbs.set_size(dists.size(), block.n_cols);
+  for (size_t i = 0; i < dists.size(); ++i)
+  {
+    dists[i].LogProbability(block, logPhis);
+    logProbs.row(i) = logWeights[i] + trans(logPhis);
+  }
+}
+
+/**
+ * Compute the log-probability of each point under a mixture, and optionally
+ * the most likely component of each point.  The points are processed in
+ * parallel, in blocks; for each block the weighted log-probabilities of all
+ * components are computed with ComponentLogProbabilities(), and then reduced
+ * with a log-sum-exp (and an arg-max) for each point.
+ *
+ * @param observations Points to evaluate.
+ * @param dists Components of the mixture.
+ * @param weights Weight of each component.
+ * @param logProbs Will hold the log-probability of each point.
+ * @param labels If not NULL, will hold the most likely component of each
+ *     point (the last one, in case of ties).
+ */
+template<typename DistributionType>
+void MixtureLogProbability(const arma::mat& observations,
+                           const std::vector<DistributionType>& dists,
+                           const arma::vec& weights,
+                           arma::vec& logProbs,
+                           arma::Row<size_t>* labels = NULL)
+{
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (observations.n_cols + blockSize - 1) / blockSize;
+  const arma::vec logWeights = arma::log(weights);
+
+  logProbs.set_size(observations.n_cols);
+  if (labels)
+    labels->set_size(observations.n_cols);
+
+  #pragma omp parallel
+  {
+    arma::mat blockLogProbs;
+
+    #pragma omp for schedule(static)
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t count = std::min(blockSize,
+          (size_t) observations.n_cols - begin);
+      arma::mat block;
+      MakeAlias(block, observations, observations.n_rows, count,
+          begin * observations.n_rows, false);
+
+      ComponentLogProbabilities(block, dists, logWeights, blockLogProbs);
+      for (size_t j = 0; j < count; ++j)
+      {
+        logProbs[begin + j] = AccuLog(blockLogProbs.col(j));
+        if (labels)
+        {
+          double maxLogProb = -std::numeric_limits<double>::infinity();
+          for (size_t i = 0; i < dists.size(); ++i)
+          {
+            if (blockLogProbs(i, j) >= maxLogProb)
+            {
+              maxLogProb = blockLogProbs(i, j);
+              (*labels)[begin + j] = i;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
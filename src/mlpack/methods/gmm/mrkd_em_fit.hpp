@@ -0,0 +1,285 @@
+/**
+ * @file methods/gmm/mrkd_em_fit.hpp
+ *
+ * Utility class to fit a GMM with the EM algorithm accelerated by a kd-tree
+ * holding the sufficient statistics of its nodes (an mrkd-tree).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_MRKD_EM_FIT_HPP
+#define MLPACK_METHODS_GMM_MRKD_EM_FIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/distributions/distributions.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
+
+// Default clustering mechanism.
+#include <mlpack/methods/kmeans/kmeans.hpp>
+// Default covariance matrix constraint.
+#include "positive_definite_constraint.hpp"
+#include "mrkd_statistic.hpp"
+
+namespace mlpack {
+
+/**
+ * This class fits a GMM to observations with the EM algorithm, using a kd-tree
+ * whose nodes cache the sufficient statistics of their points (see
+ * MRKDStatistic) to compute the E-step and the M-step for whole nodes at once:
+ *
+ * @code
+ * @inproceedings{moore1999very,
+ *   title={Very Fast EM-Based Mixture Model Clustering Using Multiresolution
+ *       kd-Trees},
+ *   author={Moore, Andrew W.},
+ *   booktitle={Advances in Neural Information Processing Systems 11},
+ *   pages={543--549},
+ *   year={1999}
+ * }
+ * @endcode
+ *
+ * At each iteration the tree is traversed from the root.  For each node, the
+ * distance between the bounding box of the node and the mean of each
+ * component, together with the extreme eigenvalues of its covariance, bound
+ * the Mahalanobis distance of the points of the node, and so the range of the
+ * responsibility of each component over the node.  If every range is smaller
+ * than the responsibility tolerance, the responsibilities are taken to be
+ * those of the centroid of the node for all its points, and the cached count,
+ * centroid and scatter of the node are added to the statistics of each
+ * component, without visiting the points.  Otherwise, the components whose
+ * responsibility is below the tolerance divided by the number of components
+ * everywhere in the node are dropped for the whole subtree, and the children
+ * are visited; the points of leaves that cannot be pruned are evaluated
+ * exactly.
+ *
+ * The result is an approximation of an EM iteration whose error is controlled
+ * by the responsibility tolerance (with a tolerance of 0, the iteration is
+ * exact, but no node is pruned).  The log-likelihood used for the convergence
+ * check is computed during the same traversal, with the same approximation.
+ * This makes EM on many points in few dimensions (up to about 10) much
+ * faster, when the components are well separated relative to the size of the
+ * nodes; in high dimensions, the bounds are too loose to prune much.
+ *
+ * MRKDEMFit can be used as the FittingType of GMM::Train():
+ *
+ * @code
+ * GMM gmm(10, data.n_rows);
+ * gmm.Train(data, 1, false, MRKDEMFit<>());
+ * @endcode
+ *
+ * The initial model is obtained with the InitialClusteringType, as for EMFit.
+ * Since the cached statistics of the nodes cannot take per-point
+ * probabilities into account, the overload of Estimate() taking probabilities
+ * uses EMFit instead.
+ *
+ * @tparam InitialClusteringType Type of the initial clustering.
+ * @tparam CovarianceConstraintPolicy Constraint applied to the covariances.
+ */
+template<typename InitialClusteringType = KMeans<>,
+         typename CovarianceConstraintPolicy = PositiveDefiniteConstraint>
+class MRKDEMFit
+{
+ public:
+  //! The type of the components.
+  using Distribution = GaussianDistribution<>;
+  //! The type of tree used to hold the observations.
+  using TreeType = KDTree<EuclideanDistance, MRKDStatistic, arma::mat>;
+
+  /**
+   * Construct the MRKDEMFit object with the given parameters.  Setting the
+   * maximum number of iterations to 0 means that the EM algorithm will iterate
+   * until convergence (with the given tolerance).
+   *
+   * @param maxIterations Maximum number of iterations for EM.
+   * @param tolerance Log-likelihood tolerance required for convergence.
+   * @param responsibilityTolerance Largest range of the responsibility of a
+   *     component over a node for which the node is pruned.
+   * @param leafSize Maximum number of points in a leaf of the kd-tree.
+   * @param clusterer Object which will perform the initial clustering.
+   * @param constraint Constraint policy of covariance.
+   */
+  MRKDEMFit(const size_t maxIterations = 300,
+            const double tolerance = 1e-10,
+            const double responsibilityTolerance = 1e-3,
+            const size_t leafSize = 20,
+            InitialClusteringType clusterer = InitialClusteringType(),
+            CovarianceConstraintPolicy constraint =
+                CovarianceConstraintPolicy());
+
+  /**
+   * Fit the observations to a Gaussian mixture model (GMM) using the
+   * tree-accelerated EM algorithm.  The size of the vectors (indicating the
+   * number of components) must already be set.  Optionally, if
+   * useInitialModel is set to true, then the model given in the dists and
+   * weights parameters is used as the initial model, instead of using the
+   * InitialClusteringType::Cluster() option.
+   *
+   * @param observations List of observations to train on.
+   * @param dists Distributions to store model in.
+   * @param weights Vector to store a priori weights in.
+   * @param useInitialModel If true, the given model is used for the initial
+   *      clustering.
+   */
+  void Estimate(const arma::mat& observations,
+                std::vector<Distribution>& dists,
+                arma::vec& weights,
+                const bool useInitialModel = false);
+
+  /**
+   * Fit the observations to a Gaussian mixture model (GMM), taking into
+   * account the probabilities of each point being from this mixture.  This
+   * uses EMFit with the same parameters, since the statistics cached in the
+   * tree do not depend on the probabilities.
+   *
+   * @param observations List of observations to train on.
+   * @param probabilities Probability of each point being from this model.
+   * @param dists Distributions to store model in.
+   * @param weights Vector to store a priori weights in.
+   * @param useInitialModel If true, the given model is used for the initial
+   *      clustering.
+   */
+  void Estimate(const arma::mat& observations,
+                const arma::vec& probabilities,
+                std::vector<Distribution>& dists,
+                arma::vec& weights,
+                const bool useInitialModel = false);
+
+  //! Get the clusterer.
+  const InitialClusteringType& Clusterer() const { return clusterer; }
+  //! Modify the clusterer.
+  InitialClusteringType& Clusterer() { return clusterer; }
+
+  //! Get the covariance constraint policy class.
+  const CovarianceConstraintPolicy& Constraint() const { return constraint; }
+  //! Modify the covariance constraint policy class.
+  CovarianceConstraintPolicy& Constraint() { return constraint; }
+
+  //! Get the maximum number of iterations of the EM algorithm.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of iterations of the EM algorithm.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the tolerance for the convergence of the EM algorithm.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for the convergence of the EM algorithm.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the tolerance on the responsibilities for pruning a node.
+  double ResponsibilityTolerance() const { return responsibilityTolerance; }
+  //! Modify the tolerance on the responsibilities for pruning a node.
+  double& ResponsibilityTolerance() { return responsibilityTolerance; }
+
+  //! Get the maximum number of points in a leaf of the kd-tree.
+  size_t LeafSize() const { return leafSize; }
+  //! Modify the maximum number of points in a leaf of the kd-tree.
+  size_t& LeafSize() { return leafSize; }
+
+  //! Get the number of nodes pruned during the last iteration.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Get the number of points evaluated exactly during the last iteration.
+  size_t NumBaseCases() const { return numBaseCases; }
+
+  //! Serialize the fitter.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+ private:
+  /**
+   * The quantities of each component computed once per iteration, used to
+   * bound the responsibilities over the nodes.
+   */
+  struct ComponentCache
+  {
+    //! The log of the weight of each component.
+    arma::vec logWeights;
+    //! The log of the largest weighted density of each component.
+    arma::vec logMaxDensities;
+    //! The smallest eigenvalue of the covariance of each component.
+    arma::vec minEigvals;
+    //! The largest eigenvalue of the covariance of each component.
+    arma::vec maxEigvals;
+  };
+
+  /**
+   * The statistics of the components accumulated during a traversal: the sum
+   * of the responsibilities of each component, and the first and second
+   * moments of the points weighted by the responsibilities, both centered on
+   * the current mean of the component.
+   */
+  struct Accumulator
+  {
+    //! Initialize the accumulator for the given mixture.
+    Accumulator(const size_t dimensionality, const size_t numDists);
+
+    //! Add the statistics of another accumulator.
+    void Merge(const Accumulator& other);
+
+    //! The sum of the responsibilities of each component.
+    arma::vec probSums;
+    //! The weighted sum of the centered points of each component.
+    arma::mat firstMoments;
+    //! The weighted sum of the outer products of the centered points.
+    std::vector<arma::mat> secondMoments;
+    //! The log-likelihood of the visited points.
+    double logLikelihood;
+    //! The number of pruned nodes.
+    size_t numPrunes;
+    //! The number of points evaluated exactly.
+    size_t numBaseCases;
+  };
+
+  /**
+   * Perform one iteration of EM with the given tree, and return the
+   * log-likelihood of the observations under the model before the update.
+   */
+  double Iterate(const TreeType& tree,
+                 std::vector<Distribution>& dists,
+                 arma::vec& weights);
+
+  /**
+   * Add the statistics of the points of the given node to the accumulator,
+   * considering only the given active components.
+   */
+  void Traverse(const TreeType& node,
+                const std::vector<size_t>& active,
+                const std::vector<Distribution>& dists,
+                const ComponentCache& cache,
+                Accumulator& accumulator) const;
+
+  /**
+   * Evaluate the points of the given leaf exactly, and add their statistics
+   * to the accumulator.
+   */
+  void BaseCases(const TreeType& leaf,
+                 const std::vector<size_t>& active,
+                 const std::vector<Distribution>& dists,
+                 const ComponentCache& cache,
+                 Accumulator& accumulator) const;
+
+  //! Maximum iterations of EM algorithm.
+  size_t maxIterations;
+  //! Tolerance for convergence of EM.
+  double tolerance;
+  //! Tolerance on the responsibilities for pruning a node.
+  double responsibilityTolerance;
+  //! Maximum number of points in a leaf of the kd-tree.
+  size_t leafSize;
+  //! Object which will perform the clustering.
+  InitialClusteringType clusterer;
+  //! Object which applies constraints to the covariance matrix.
+  CovarianceConstraintPolicy constraint;
+
+  //! The number of nodes pruned during the last iteration.
+  size_t numPrunes;
+  //! The number of points evaluated exactly during the last iteration.
+  size_t numBaseCases;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "mrkd_em_fit_impl.hpp"
+
+#endif
@@ -0,0 +1,390 @@
+/**
+ * @file methods/gmm/mrkd_em_fit_impl.hpp
+ *
+ * Implementation of the EM algorithm for fitting GMMs accelerated by a kd-tree
+ * of sufficient statistics.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_MRKD_EM_FIT_IMPL_HPP
+#define MLPACK_METHODS_GMM_MRKD_EM_FIT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mrkd_em_fit.hpp"
+#include "em_fit.hpp"
+#include <mlpack/core/math/log_add.hpp>
+#include <mlpack/core/math/make_alias.hpp>
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+
+template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
+MRKDEMFit<InitialClusteringType, CovarianceConstraintPolicy>::MRKDEMFit(
+    const size_t maxIterations,
+    const double tolerance,
+    const double responsibilityTolerance,
+    const size_t leafSize,
+    InitialClusteringType clusterer,
+    CovarianceConstraintPolicy constraint) :
+    maxIterations(maxIterations),
+    tolerance(tolerance),
+    responsibilityTolerance(responsibilityTolerance),
+    leafSize(leafSize),
+    clusterer(clusterer),
+    constraint(constraint),
+    numPrunes(0),
+    numBaseCases(0)
+{ /* Nothing to do. */ }
+
+template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
+void MRKDEMFit<InitialClusteringType, CovarianceConstraintPolicy>::Estimate(
+    const arma::mat& observations,
+    std::vector<Distribution>& dists,
+    arma::vec& weights,
+    const bool useInitialModel)
+{
+  if (leafSize == 0)
+  {
+    throw std::invalid_argument("MRKDEMFit::Estimate(): leaf size must be "
+        "positive!");
+  }
+
+  if (observations.n_cols == 0)
+  {
+    throw std::invalid_argument("MRKDEMFit::Estimate(): no observations "
+        "given!");
+  }
+
+  // The initial clustering is the same as for EMFit; with a single iteration,
+  // EMFit stops right after it.
+  if (!useInitialModel)
+  {
+    EMFit<InitialClusteringType, CovarianceConstraintPolicy> initialFit(1,
+        tolerance, clusterer, constraint);
+    initialFit.Estimate(observations, dists, weights, false);
+  }
+
+  // The tree is built once, and is reused for every iteration.
+  const TreeType tree(observations, leafSize);
+
+  // Each iteration returns the log-likelihood of the model before its update,
+  // so there is no log-likelihood to compare with before the first one.
+  double lOld = -DBL_MAX;
+  double l = DBL_MAX;
+
+  // Iterate to update the model until no more improvement is found.
+  size_t iteration = 1;
+  while (std::abs(l - lOld) > tolerance && iteration != maxIterations)
+  {
+    lOld = l;
+    l = Iterate(tree, dists, weights);
+
+    Log::Info << "MRKDEMFit::Estimate(): iteration " << iteration << ", "
+        << "log-likelihood " << l << " (" << numPrunes << " prunes, "
+        << numBaseCases << " base cases)." << std::endl;
+
+    iteration++;
+  }
+}
+
+template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
+void MRKDEMFit<InitialClusteringType, CovarianceConstraintPolicy>::Estimate(
+    const arma::mat& observations,
+    const arma::vec& probabilities,
+    std::vector<Distribution>& dists,
+    arma::vec& weights,
+    const bool useInitialModel)
+{
+  EMFit<InitialClusteringType, CovarianceConstraintPolicy> fit(maxIterations,
+      tolerance, clusterer, constraint);
+  fit.Estimate(observations, probabilities, dists, weights, useInitialModel);
+}
+
+template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
+double MRKDEMFit<InitialClusteringType, CovarianceConstraintPolicy>::Iterate(
+    const TreeType& tree,
+    std::vector<Distribution>& dists,
+    arma::vec& weights)
+{
+  const size_t numDists = dists.size();
+  const size_t dimensionality = tree.Dataset().n_rows;
+
+  // Cache the quantities needed for the bounds; the Mahalanobis distance of a
+  // point at Euclidean distance r from the mean of a component is between
+  // r^2 / maxEigval and r^2 / minEigval.
+  ComponentCache cache;
+  cache.logWeights = arma::log(weights);
+  cache.logMaxDensities.set_size(numDists);
+  cache.minEigvals.set_size(numDists);
+  cache.maxEigvals.set_size(numDists);
+  for (size_t i = 0; i < numDists; ++i)
+  {
+    const arma::vec eigvals = arma::eig_sym(dists[i].Covariance());
+    cache.minEigvals[i] = std::max(eigvals.min(), DBL_MIN);
+    cache.maxEigvals[i] = std::max(eigvals.max(), DBL_MIN);
+    cache.logMaxDensities[i] = cache.logWeights[i] - 0.5 * dimensionality *
+        std::log(2.0 * M_PI) - 0.5 * dists[i].LogDetCov();
+  }
+
+  // Split the tree into enough subtrees for all threads; each thread
+  // accumulates its own statistics, and these are combined at the end.
+  std::vector<const TreeType*> frontier(1, &tree);
+  #ifdef MLPACK_USE_OPENMP
+  const size_t minSubtrees = 4 * omp_get_max_threads();
+  #else
+  const size_t minSubtrees = 1;
+  #endif
+  bool expanded = true;
+  while (expanded && frontier.size() < minSubtrees)
+  {
+    expanded = false;
+    std::vector<const TreeType*> nextFrontier;
+    for (const TreeType* node : frontier)
+    {
+      if (node->IsLeaf())
+      {
+        nextFrontier.push_back(node);
+      }
+      else
+      {
+        nextFrontier.push_back(node->Left());
+        nextFrontier.push_back(node->Right());
+        expanded = true;
+      }
+    }
+
+    frontier.swap(nextFrontier);
+  }
+
+  std::vector<size_t> active(numDists);
+  for (size_t i = 0; i < numDists; ++i)
+    active[i] = i;
+
+  Accumulator total(dimensionality, numDists);
+  #pragma omp parallel
+  {
+    Accumulator local(dimensionality, numDists);
+
+    #pragma omp for schedule(dynamic) nowait
+    for (size_t i = 0; i < frontier.size(); ++i)
+      Traverse(*frontier[i], active, dists, cache, local);
+
+    #pragma omp critical
+    total.Merge(local);
+  }
+
+  numPrunes = total.numPrunes;
+  numBaseCases = total.numBaseCases;
+
+  // The moments are centered on the current means, so the new mean is the
+  // current mean shifted by the mean of the centered points.
+  for (size_t i = 0; i < numDists; ++i)
+  {
+    // Don't update a Gaussian if there's no probability of it having points.
+    if (total.probSums[i] == 0.0)
+      continue;
+
+    const arma::vec shift = total.firstMoments.col(i) / total.probSums[i];
+    arma::mat cov = total.secondMoments[i] / total.probSums[i] -
+        shift * shift.t();
+    dists[i].Mean() += shift;
+
+    // Apply covariance constraint.
+    constraint.ApplyConstraint(cov);
+    dists[i].Covariance(std::move(cov));
+  }
+
+  // Some responsibility may have been dropped with the components that are
+  // negligible in a subtree, so the weights are normalized by the total.
+  weights = total.probSums / arma::accu(total.probSums);
+
+  return total.logLikelihood;
+}
+
+template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
+void MRKDEMFit<InitialClusteringType, CovarianceConstraintPolicy>::Traverse(
+    const TreeType& node,
+    const std::vector<size_t>& active,
+    const std::vector<Distribution>& dists,
+    const ComponentCache& cache,
+    Accumulator& accumulator) const
+{
+  // Bound the log of the weighted density of each active component over the
+  // bounding box of the node.
+  arma::vec lowerBounds(active.size()), upperBounds(active.size());
+  for (size_t a = 0; a < active.size(); ++a)
+  {
+    const size_t i = active[a];
+    const Range r = node.Bound().RangeDistance(dists[i].Mean());
+    lowerBounds[a] = cache.logMaxDensities[i] -
+        0.5 * r.Hi() * r.Hi() / cache.minEigvals[i];
+    upperBounds[a] = cache.logMaxDensities[i] -
+        0.5 * r.Lo() * r.Lo() / cache.maxEigvals[i];
+  }
+
+  // The responsibility of a component is at least its smallest density over
+  // the largest total density, and at most its largest density over the
+  // smallest total density.
+  const double logLowerSum = AccuLog(lowerBounds);
+  const double logUpperSum = AccuLog(upperBounds);
+  const double dropTolerance = responsibilityTolerance / dists.size();
+  bool prune = true;
+  std::vector<size_t> childActive;
+  for (size_t a = 0; a < active.size(); ++a)
+  {
+    const double maxResponsibility = std::min(1.0,
+        std::exp(upperBounds[a] - logLowerSum));
+    const double minResponsibility = std::exp(lowerBounds[a] - logUpperSum);
+    if (!(maxResponsibility - minResponsibility <= responsibilityTolerance))
+      prune = false;
+    if (maxResponsibility > dropTolerance || active.size() == 1)
+      childActive.push_back(active[a]);
+  }
+
+  if (prune)
+  {
+    // Give every point of the node the responsibilities of the centroid.
+    const arma::vec& centroid = node.Stat().Centroid();
+    const double numPoints = (double) node.NumDescendants();
+    arma::vec logProbs(active.size());
+    for (size_t a = 0; a < active.size(); ++a)
+    {
+      logProbs[a] = cache.logWeights[active[a]] +
+          dists[active[a]].LogProbability(centroid);
+    }
+
+    const double logSum = AccuLog(logProbs);
+    ++accumulator.numPrunes;
+    if (logSum == -std::numeric_limits<double>::infinity())
+      return;
+
+    for (size_t a = 0; a < active.size(); ++a)
+    {
+      const size_t i = active[a];
+      const double responsibility = std::exp(logProbs[a] - logSum);
+      if (responsibility == 0.0)
+        continue;
+
+      const arma::vec delta = centroid - dists[i].Mean();
+      accumulator.probSums[i] += responsibility * numPoints;
+      accumulator.firstMoments.col(i) += (responsibility * numPoints) * delta;
+      accumulator.secondMoments[i] += responsibility *
+          (node.Stat().Scatter() + numPoints * (delta * delta.t()));
+    }
+
+    accumulator.logLikelihood += numPoints * logSum;
+    return;
+  }
+
+  if (node.IsLeaf())
+  {
+    BaseCases(node, childActive, dists, cache, accumulator);
+    return;
+  }
+
+  Traverse(*node.Left(), childActive, dists, cache, accumulator);
+  Traverse(*node.Right(), childActive, dists, cache, accumulator);
+}
+
+template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
+void MRKDEMFit<InitialClusteringType, CovarianceConstraintPolicy>::BaseCases(
+    const TreeType& leaf,
+    const std::vector<size_t>& active,
+    const std::vector<Distribution>& dists,
+    const ComponentCache& cache,
+    Accumulator& accumulator) const
+{
+  // The points of a leaf are contiguous in the dataset of the tree.
+  const size_t dimensionality = leaf.Dataset().n_rows;
+  arma::mat block;
+  MakeAlias(block, leaf.Dataset(), dimensionality, leaf.Count(),
+      leaf.Begin() * dimensionality, false);
+
+  arma::mat responsibilities(active.size(), block.n_cols);
+  arma::vec logPhis;
+  for (size_t a = 0; a < active.size(); ++a)
+  {
+    dists[active[a]].LogProbability(block, logPhis);
+    responsibilities.row(a) = cache.logWeights[active[a]] + trans(logPhis);
+  }
+
+  // Normalize each point.
+  for (size_t j = 0; j < block.n_cols; ++j)
+  {
+    // Avoid dividing by zero; if the probability for everything is 0, we
+    // don't want to make it NaN.
+    const double logSum = AccuLog(responsibilities.col(j));
+    if (logSum == -std::numeric_limits<double>::infinity())
+    {
+      responsibilities.col(j).zeros();
+      continue;
+    }
+
+    responsibilities.col(j) = arma::exp(responsibilities.col(j) - logSum);
+    accumulator.logLikelihood += logSum;
+  }
+
+  arma::mat diffs, weightedDiffs;
+  for (size_t a = 0; a < active.size(); ++a)
+  {
+    const size_t i = active[a];
+    diffs = block;
+    diffs.each_col() -= dists[i].Mean();
+    weightedDiffs = diffs;
+    weightedDiffs.each_row() %= responsibilities.row(a);
+
+    accumulator.probSums[i] += arma::accu(responsibilities.row(a));
+    accumulator.firstMoments.col(i) += arma::sum(weightedDiffs, 1);
+    accumulator.secondMoments[i] += weightedDiffs * diffs.t();
+  }
+
+  accumulator.numBaseCases += block.n_cols;
+}
+
+template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
+MRKDEMFit<InitialClusteringType, CovarianceConstraintPolicy>::Accumulator::
+Accumulator(const size_t dimensionality, const size_t numDists) :
+    probSums(numDists, arma::fill::zeros),
+    firstMoments(dimensionality, numDists, arma::fill::zeros),
+    secondMoments(numDists, arma::mat(dimensionality, dimensionality,
+        arma::fill::zeros)),
+    logLikelihood(0.0),
+    numPrunes(0),
+    numBaseCases(0)
+{ /* Nothing to do. */ }
+
+template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
+void MRKDEMFit<InitialClusteringType, CovarianceConstraintPolicy>::Accumulator::
+Merge(const Accumulator& other)
+{
+  probSums += other.probSums;
+  firstMoments += other.firstMoments;
+  for (size_t i = 0; i < secondMoments.size(); ++i)
+    secondMoments[i] += other.secondMoments[i];
+  logLikelihood += other.logLikelihood;
+  numPrunes += other.numPrunes;
+  numBaseCases += other.numBaseCases;
+}
+
+template<typename InitialClusteringType, typename CovarianceConstraintPolicy>
+template<typename Archive>
+void MRKDEMFit<InitialClusteringType, CovarianceConstraintPolicy>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(maxIterations));
+  ar(CEREAL_NVP(tolerance));
+  ar(CEREAL_NVP(responsibilityTolerance));
+  ar(CEREAL_NVP(leafSize));
+  ar(CEREAL_NVP(clusterer));
+  ar(CEREAL_NVP(constraint));
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @file methods/gmm/mrkd_statistic.hpp
+ *
+ * A tree statistic holding the sufficient statistics of the points of a node,
+ * used by MRKDEMFit.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_MRKD_STATISTIC_HPP
+#define MLPACK_METHODS_GMM_MRKD_STATISTIC_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * A statistic for trees which caches the sufficient statistics of the points
+ * of a node, as in the mrkd-tree: their centroid, and their scatter matrix
+ * (the sum of the outer products of the points centered on the centroid).  The
+ * number of points is the number of descendants of the node.  Keeping the
+ * scatter centered on the centroid (instead of the raw sum of outer products)
+ * avoids the loss of precision of large sums far from the origin.
+ *
+ * The statistic of a node is computed from its points if it is a leaf, and is
+ * merged from the statistics of its children otherwise, so the tree must be
+ * built depth-first and must not have self-children (like BinarySpaceTree).
+ */
+class MRKDStatistic
+{
+ public:
+  //! Initialize the statistic without a node (this does nothing).
+  MRKDStatistic() { }
+
+  //! Initialize the statistic for a node, computing its centroid and scatter.
+  template<typename TreeType>
+  MRKDStatistic(TreeType& node)
+  {
+    const size_t dimensionality = node.Dataset().n_rows;
+    centroid.zeros(dimensionality);
+    scatter.zeros(dimensionality, dimensionality);
+    if (node.NumDescendants() == 0)
+      return;
+
+    if (node.NumChildren() == 0)
+    {
+      arma::mat points(dimensionality, node.NumPoints());
+      for (size_t i = 0; i < node.NumPoints(); ++i)
+        points.col(i) = node.Dataset().col(node.Point(i));
+
+      centroid = arma::mean(points, 1);
+      points.each_col() -= centroid;
+      scatter = points * points.t();
+      return;
+    }
+
+    for (size_t i = 0; i < node.NumChildren(); ++i)
+    {
+      centroid += node.Child(i).NumDescendants() *
+          node.Child(i).Stat().Centroid();
+    }
+    centroid /= node.NumDescendants();
+
+    // Each child contributes its own scatter, plus the scatter of its centroid
+    // around the centroid of the node.
+    for (size_t i = 0; i < node.NumChildren(); ++i)
+    {
+      const arma::vec delta = node.Child(i).Stat().Centroid() - centroid;
+      scatter += node.Child(i).Stat().Scatter() +
+          node.Child(i).NumDescendants() * (delta * delta.t());
+    }
+  }
+
+  //! Get the centroid of the points of the node.
+  const arma::vec& Centroid() const { return centroid; }
+  //! Modify the centroid of the points of the node (be careful!).
+  arma::vec& Centroid() { return centroid; }
+
+  //! Get the scatter matrix of the points of the node around the centroid.
+  const arma::mat& Scatter() const { return scatter; }
+  //! Modify the scatter matrix of the points of the node (be careful!).
+  arma::mat& Scatter() { return scatter; }
+
+ private:
+  //! The centroid of the points of the node.
+  arma::vec centroid;
+  //! The sum of the outer products of the centered points of the node.
+  arma::mat scatter;
+};
+
+} // namespace mlpack
+
+#endif
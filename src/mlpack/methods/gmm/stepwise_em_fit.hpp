@@ -0,0 +1,309 @@
+/**
+ * @file methods/gmm/stepwise_em_fit.hpp
+ *
+ * Utility class to fit a GMM with stepwise (online) EM, updating the model
+ * from mini-batches of observations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_STEPWISE_EM_FIT_HPP
+#define MLPACK_METHODS_GMM_STEPWISE_EM_FIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/chunked_source.hpp>
+#include <mlpack/core/distributions/distributions.hpp>
+
+// Default clustering mechanism.
+#include <mlpack/methods/kmeans/kmeans.hpp>
+// Default covariance matrix constraint.
+#include "positive_definite_constraint.hpp"
+
+namespace mlpack {
+
+/**
+ * This class fits a GMM to observations with stepwise EM, an online variant of
+ * the EM algorithm:
+ *
+ * @code
+ * @article{cappe2009online,
+ *   title={On-line expectation-maximization algorithm for latent data
+ *       models},
+ *   author={Capp{\'e}, O. and Moulines, E.},
+ *   journal={Journal of the Royal Statistical Society: Series B},
+ *   volume={71},
+ *   number={3},
+ *   pages={593--613},
+ *   year={2009}
+ * }
+ *
+ * @inproceedings{liang2009online,
+ *   title={Online EM for unsupervised models},
+ *   author={Liang, P. and Klein, D.},
+ *   booktitle={Proceedings of Human Language Technologies: NAACL 2009},
+ *   pages={611--619},
+ *   year={2009}
+ * }
+ * @endcode
+ *
+ * Instead of computing the sufficient statistics of the mixture (the total
+ * responsibility of each component, and the responsibility-weighted sums of
+ * the points and their outer products) over the whole dataset at each
+ * iteration, each mini-batch of points gives an estimate of them, which is
+ * blended into the running statistics with step size (t + 2)^-stepDecay at
+ * step t.  The model parameters are then recomputed from the running
+ * statistics.  With 0.5 < stepDecay <= 1, this converges to a local maximum of
+ * the likelihood, and usually does so in a few passes over the data.
+ *
+ * Since only one mini-batch is needed at a time, the observations can also be
+ * read from a data::ChunkedSource, so that the dataset does not need to fit in
+ * memory.  StepwiseEMFit can be used as the FittingType of GMM::Train() and
+ * DiagonalGMM::Train(), and GMM and DiagonalGMM also have Train() overloads
+ * taking a data::ChunkedSource.
+ *
+ * @code
+ * // Fit a GMM with 10 components to data in memory, with mini-batches of 500
+ * // points and 3 passes over the data.
+ * GMM gmm(10, data.n_rows);
+ * gmm.Train(data, 1, false, StepwiseEMFit<>(3, 500));
+ *
+ * // Fit it to a dataset on disk, reading 100k points at a time.
+ * data::ChunkedSource<> source("dataset.bin", 100000);
+ * gmm.Train(source);
+ * @endcode
+ *
+ * The initial model is obtained by running the InitialClusteringType on a
+ * sample of the points (for in-memory data) or on the first chunk (for chunked
+ * sources), unless an existing model is given.  The clusterer must implement
+ * the same Cluster() method as for EMFit.
+ *
+ * @tparam InitialClusteringType Type of the initial clustering.
+ * @tparam CovarianceConstraintPolicy Constraint applied to the covariances.
+ * @tparam Distribution Type of the components, either GaussianDistribution<>
+ *     or DiagonalGaussianDistribution<>.
+ */
+template<typename InitialClusteringType = KMeans<>,
+         typename CovarianceConstraintPolicy = PositiveDefiniteConstraint,
+         typename Distribution = GaussianDistribution<>>
+class StepwiseEMFit
+{
+ public:
+  /**
+   * Construct the StepwiseEMFit object with the given parameters.
+   *
+   * @param passes Number of passes over the data.
+   * @param batchSize Number of points in each mini-batch.
+   * @param stepDecay Exponent of the decay of the step size; it should be
+   *     between 0.5 (exclusive) and 1 (inclusive).
+   * @param clusterer Object which will perform the initial clustering.
+   * @param constraint Constraint policy of covariance.
+   */
+  StepwiseEMFit(const size_t passes = 5,
+                const size_t batchSize = 1000,
+                const double stepDecay = 0.6,
+                InitialClusteringType clusterer = InitialClusteringType(),
+                CovarianceConstraintPolicy constraint =
+                    CovarianceConstraintPolicy());
+
+  /**
+   * Fit the observations to a Gaussian mixture model with stepwise EM, using
+   * mini-batches of random points.  The size of the vectors (indicating the
+   * number of components) must already be set.  If useInitialModel is true,
+   * the given model is used as the initial model.
+   *
+   * @param observations List of observations to train on.
+   * @param dists Distributions to store model in.
+   * @param weights Vector to store a priori weights in.
+   * @param useInitialModel If true, the given model is used as the initial
+   *     model.
+   */
+  void Estimate(const arma::mat& observations,
+                std::vector<Distribution>& dists,
+                arma::vec& weights,
+                const bool useInitialModel = false);
+
+  /**
+   * Fit the observations to a Gaussian mixture model with stepwise EM, taking
+   * into account the probability of each point being from this mixture.  The
+   * size of the vectors (indicating the number of components) must already be
+   * set.  If useInitialModel is true, the given model is used as the initial
+   * model.
+   *
+   * @param observations List of observations to train on.
+   * @param probabilities Probability of each point being from this model.
+   * @param dists Distributions to store model in.
+   * @param weights Vector to store a priori weights in.
+   * @param useInitialModel If true, the given model is used as the initial
+   *     model.
+   */
+  void Estimate(const arma::mat& observations,
+                const arma::vec& probabilities,
+                std::vector<Distribution>& dists,
+                arma::vec& weights,
+                const bool useInitialModel = false);
+
+  /**
+   * Fit the observations read from the given source to a Gaussian mixture
+   * model with stepwise EM.  Each pass reads the whole source once, and the
+   * points of each chunk are visited in random order.  The size of the vectors
+   * (indicating the number of components) must already be set.  If
+   * useInitialModel is true, the given model is used as the initial model.
+   *
+   * @param source Source of the observations.
+   * @param dists Distributions to store model in.
+   * @param weights Vector to store a priori weights in.
+   * @param useInitialModel If true, the given model is used as the initial
+   *     model.
+   * @return The log-likelihood of the points during the last pass, each
+   *     mini-batch being evaluated just before the model is updated with it.
+   */
+  template<typename eT>
+  double Estimate(data::ChunkedSource<eT>& source,
+                  std::vector<Distribution>& dists,
+                  arma::vec& weights,
+                  const bool useInitialModel = false);
+
+  /**
+   * Update the model with one mini-batch of points.  This can be used to fit
+   * a model to a stream of points; the model must already be initialized
+   * (for instance by a call to Estimate() or GMM::Train()).  The first call
+   * after construction or Reset() starts from the statistics of the given
+   * model.
+   *
+   * @param batch Mini-batch of points.
+   * @param dists Distributions to update.
+   * @param weights A priori weights to update.
+   * @return The log-likelihood of the mini-batch under the model before the
+   *     update.
+   */
+  double Update(const arma::mat& batch,
+                std::vector<Distribution>& dists,
+                arma::vec& weights);
+
+  //! Forget the running statistics; the next Update() will start from the
+  //! statistics of the given model.
+  void Reset() { steps = 0; statWeights.reset(); }
+
+  //! Get the clusterer.
+  const InitialClusteringType& Clusterer() const { return clusterer; }
+  //! Modify the clusterer.
+  InitialClusteringType& Clusterer() { return clusterer; }
+
+  //! Get the covariance constraint policy class.
+  const CovarianceConstraintPolicy& Constraint() const { return constraint; }
+  //! Modify the covariance constraint policy class.
+  CovarianceConstraintPolicy& Constraint() { return constraint; }
+
+  //! Get the number of passes over the data.
+  size_t Passes() const { return passes; }
+  //! Modify the number of passes over the data.
+  size_t& Passes() { return passes; }
+
+  //! Get the number of points in each mini-batch.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points in each mini-batch.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the exponent of the decay of the step size.
+  double StepDecay() const { return stepDecay; }
+  //! Modify the exponent of the decay of the step size.
+  double& StepDecay() { return stepDecay; }
+
+  //! Get the number of steps taken since the running statistics were
+  //! initialized.
+  size_t Steps() const { return steps; }
+
+  //! Serialize the fitter.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+ private:
+  //! Whether the components have diagonal covariances.
+  static constexpr bool isDiagGaussDist = std::is_same_v<Distribution,
+      DiagonalGaussianDistribution<>>;
+  //! Type of the covariance statistics.
+  using CovType = std::conditional_t<isDiagGaussDist, arma::vec, arma::mat>;
+
+  /**
+   * Initialize the model by running the clusterer on a sample of the given
+   * points, and initialize the running statistics from the clustering.
+   */
+  void InitialClustering(const arma::mat& observations,
+                         std::vector<Distribution>& dists,
+                         arma::vec& weights);
+
+  //! Initialize the running statistics from the given model.
+  void InitializeStatistics(const std::vector<Distribution>& dists,
+                            const arma::vec& weights);
+
+  /**
+   * Compute the statistics of the given batch, weighted by the given
+   * responsibilities (of size dists.size() x batch.n_cols), and normalized by
+   * the given total weight of the batch.
+   */
+  void BatchStatistics(const arma::mat& batch,
+                       const arma::mat& responsibilities,
+                       const double totalWeight,
+                       arma::vec& batchWeights,
+                       arma::mat& batchMeans,
+                       std::vector<CovType>& batchCovs) const;
+
+  /**
+   * Perform one step on the given batch: compute the responsibilities, blend
+   * the statistics of the batch into the running statistics, and update the
+   * model.  probabilities may be NULL.  Returns the log-likelihood of the
+   * batch before the update.
+   */
+  double Step(const arma::mat& batch,
+              const arma::vec* probabilities,
+              std::vector<Distribution>& dists,
+              arma::vec& weights);
+
+  //! Recompute the model from the running statistics.
+  void UpdateModel(std::vector<Distribution>& dists, arma::vec& weights);
+
+  /**
+   * Take one step for each mini-batch of the given points, visited in random
+   * order.  probabilities may be NULL.  Returns the sum of the log-likelihoods
+   * of the mini-batches.
+   */
+  double Pass(const arma::mat& observations,
+              const arma::vec* probabilities,
+              std::vector<Distribution>& dists,
+              arma::vec& weights);
+
+  //! Number of passes over the data.
+  size_t passes;
+  //! Number of points in each mini-batch.
+  size_t batchSize;
+  //! Exponent of the decay of the step size.
+  double stepDecay;
+  //! Object which will perform the clustering.
+  InitialClusteringType clusterer;
+  //! Object which applies constraints to the covariance matrix.
+  CovarianceConstraintPolicy constraint;
+
+  //! Number of steps taken.
+  size_t steps;
+  //! Point that the statistics are centered on, to avoid losing precision
+  //! when the covariances are recovered from the second moments.
+  arma::vec shift;
+  //! Running total responsibility of each component (per point).
+  arma::vec statWeights;
+  //! Running responsibility-weighted sum of the (shifted) points of each
+  //! component (per point).
+  arma::mat statMeans;
+  //! Running responsibility-weighted sum of the outer products (or squares,
+  //! for diagonal covariances) of the shifted points of each component (per
+  //! point).
+  std::vector<CovType> statCovs;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "stepwise_em_fit_impl.hpp"
+
+#endif
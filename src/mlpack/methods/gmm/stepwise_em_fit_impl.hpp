@@ -0,0 +1,437 @@
+/**
+ * @file methods/gmm/stepwise_em_fit_impl.hpp
+ *
+ * Implementation of stepwise EM for fitting GMMs.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_STEPWISE_EM_FIT_IMPL_HPP
+#define MLPACK_METHODS_GMM_STEPWISE_EM_FIT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "stepwise_em_fit.hpp"
+#include <mlpack/core/math/log_add.hpp>
+
+namespace mlpack {
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+StepwiseEMFit(const size_t passes,
+              const size_t batchSize,
+              const double stepDecay,
+              InitialClusteringType clusterer,
+              CovarianceConstraintPolicy constraint) :
+    passes(passes),
+    batchSize(batchSize),
+    stepDecay(stepDecay),
+    clusterer(clusterer),
+    constraint(constraint),
+    steps(0)
+{ /* Nothing to do. */ }
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::Estimate(const arma::mat& observations,
+                            std::vector<Distribution>& dists,
+                            arma::vec& weights,
+                            const bool useInitialModel)
+{
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("StepwiseEMFit::Estimate(): batch size must "
+        "be positive!");
+  }
+
+  Reset();
+  if (useInitialModel)
+    InitializeStatistics(dists, weights);
+  else
+    InitialClustering(observations, dists, weights);
+
+  for (size_t p = 0; p < passes; ++p)
+  {
+    const double l = Pass(observations, NULL, dists, weights);
+    Log::Info << "StepwiseEMFit::Estimate(): pass " << p << ", log-likelihood "
+        << l << "." << std::endl;
+  }
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::Estimate(const arma::mat& observations,
+                            const arma::vec& probabilities,
+                            std::vector<Distribution>& dists,
+                            arma::vec& weights,
+                            const bool useInitialModel)
+{
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("StepwiseEMFit::Estimate(): batch size must "
+        "be positive!");
+  }
+
+  Reset();
+  if (useInitialModel)
+    InitializeStatistics(dists, weights);
+  else
+    InitialClustering(observations, dists, weights);
+
+  for (size_t p = 0; p < passes; ++p)
+  {
+    const double l = Pass(observations, &probabilities, dists, weights);
+    Log::Info << "StepwiseEMFit::Estimate(): pass " << p << ", log-likelihood "
+        << l << "." << std::endl;
+  }
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+template<typename eT>
+double StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::Estimate(data::ChunkedSource<eT>& source,
+                            std::vector<Distribution>& dists,
+                            arma::vec& weights,
+                            const bool useInitialModel)
+{
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("StepwiseEMFit::Estimate(): batch size must "
+        "be positive!");
+  }
+
+  // Chunks of other element types have to be converted first.
+  arma::Mat<eT> chunk;
+  arma::mat convertedChunk;
+  auto nextChunk = [&]() -> const arma::mat*
+  {
+    if (!source.Next(chunk))
+      return NULL;
+
+    if constexpr (std::is_same_v<eT, double>)
+    {
+      return &chunk;
+    }
+    else
+    {
+      convertedChunk = arma::conv_to<arma::mat>::from(chunk);
+      return &convertedChunk;
+    }
+  };
+
+  Reset();
+  source.Reset();
+  if (useInitialModel)
+  {
+    InitializeStatistics(dists, weights);
+  }
+  else
+  {
+    const arma::mat* firstChunk = nextChunk();
+    if (firstChunk == NULL)
+    {
+      throw std::invalid_argument("StepwiseEMFit::Estimate(): the source has "
+          "no points!");
+    }
+
+    InitialClustering(*firstChunk, dists, weights);
+  }
+
+  double logLikelihood = 0.0;
+  for (size_t p = 0; p < passes; ++p)
+  {
+    source.Reset();
+    logLikelihood = 0.0;
+    while (const arma::mat* data = nextChunk())
+      logLikelihood += Pass(*data, NULL, dists, weights);
+
+    Log::Info << "StepwiseEMFit::Estimate(): pass " << p << ", log-likelihood "
+        << logLikelihood << "." << std::endl;
+  }
+
+  return logLikelihood;
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+double StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::Update(const arma::mat& batch,
+                          std::vector<Distribution>& dists,
+                          arma::vec& weights)
+{
+  return Step(batch, NULL, dists, weights);
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+template<typename Archive>
+void StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(passes));
+  ar(CEREAL_NVP(batchSize));
+  ar(CEREAL_NVP(stepDecay));
+  ar(CEREAL_NVP(clusterer));
+  ar(CEREAL_NVP(constraint));
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::InitialClustering(const arma::mat& observations,
+                                     std::vector<Distribution>& dists,
+                                     arma::vec& weights)
+{
+  // Clustering a few mini-batches worth of points is enough for a starting
+  // point.
+  const size_t numSamples = std::min(observations.n_cols,
+      std::max((size_t) 10 * batchSize, 10 * dists.size()));
+  arma::mat sample;
+  if (numSamples < observations.n_cols)
+  {
+    const arma::uvec indices = arma::randperm(observations.n_cols,
+        numSamples);
+    sample = observations.cols(indices);
+  }
+  else
+  {
+    sample = observations;
+  }
+
+  arma::Row<size_t> assignments;
+  clusterer.Cluster(sample, dists.size(), assignments);
+
+  // The statistics of the clustering are those of the sample, with each point
+  // entirely given to its cluster.
+  arma::mat responsibilities(dists.size(), sample.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < sample.n_cols; ++i)
+    responsibilities(assignments[i], i) = 1.0;
+
+  shift = arma::mean(sample, 1);
+  BatchStatistics(sample, responsibilities, sample.n_cols, statWeights,
+      statMeans, statCovs);
+  UpdateModel(dists, weights);
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::InitializeStatistics(const std::vector<Distribution>& dists,
+                                        const arma::vec& weights)
+{
+  shift.zeros(dists[0].Mean().n_elem);
+  for (size_t i = 0; i < dists.size(); ++i)
+    shift += weights[i] * dists[i].Mean();
+
+  statWeights = weights;
+  statMeans.set_size(shift.n_elem, dists.size());
+  statCovs.resize(dists.size());
+  for (size_t i = 0; i < dists.size(); ++i)
+  {
+    const arma::vec offset = dists[i].Mean() - shift;
+    statMeans.col(i) = weights[i] * offset;
+    if constexpr (isDiagGaussDist)
+    {
+      statCovs[i] = weights[i] * (dists[i].Covariance() +
+          arma::square(offset));
+    }
+    else
+    {
+      statCovs[i] = weights[i] * (dists[i].Covariance() + offset * offset.t());
+    }
+  }
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::BatchStatistics(const arma::mat& batch,
+                                   const arma::mat& responsibilities,
+                                   const double totalWeight,
+                                   arma::vec& batchWeights,
+                                   arma::mat& batchMeans,
+                                   std::vector<CovType>& batchCovs) const
+{
+  arma::mat centered = batch;
+  centered.each_col() -= shift;
+
+  batchWeights = arma::sum(responsibilities, 1) / totalWeight;
+  batchMeans = centered * trans(responsibilities) / totalWeight;
+  batchCovs.resize(responsibilities.n_rows);
+
+  // The components are independent, so they can be handled in parallel.
+  #pragma omp parallel
+  {
+    arma::mat weightedCentered;
+
+    #pragma omp for schedule(dynamic)
+    for (size_t i = 0; i < responsibilities.n_rows; ++i)
+    {
+      if constexpr (isDiagGaussDist)
+      {
+        batchCovs[i] = arma::square(centered) *
+            trans(responsibilities.row(i)) / totalWeight;
+      }
+      else
+      {
+        weightedCentered = centered.each_row() % responsibilities.row(i);
+        batchCovs[i] = centered * trans(weightedCentered) / totalWeight;
+      }
+    }
+  }
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+double StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::Step(const arma::mat& batch,
+                        const arma::vec* probabilities,
+                        std::vector<Distribution>& dists,
+                        arma::vec& weights)
+{
+  if (statWeights.n_elem == 0)
+    InitializeStatistics(dists, weights);
+
+  // E-step: compute the conditional probability of each component for each
+  // point of the batch.
+  arma::mat condLogProb(dists.size(), batch.n_cols);
+  #pragma omp parallel
+  {
+    arma::vec logPhis;
+
+    #pragma omp for schedule(dynamic)
+    for (size_t i = 0; i < dists.size(); ++i)
+    {
+      dists[i].LogProbability(batch, logPhis);
+      condLogProb.row(i) = trans(logPhis) + std::log(weights[i]);
+    }
+  }
+
+  double logLikelihood = 0.0;
+  double totalWeight = 0.0;
+  for (size_t j = 0; j < batch.n_cols; ++j)
+  {
+    // Points with no probability under the model are ignored.
+    const double probSum = AccuLog(condLogProb.col(j));
+    logLikelihood += probSum;
+    if (probSum == -std::numeric_limits<double>::infinity())
+    {
+      condLogProb.col(j).zeros();
+      continue;
+    }
+
+    const double pointWeight = (probabilities == NULL) ? 1.0 :
+        (*probabilities)[j];
+    condLogProb.col(j) = pointWeight * arma::exp(condLogProb.col(j) - probSum);
+    totalWeight += pointWeight;
+  }
+
+  if (totalWeight == 0.0)
+    return logLikelihood;
+
+  arma::vec batchWeights;
+  arma::mat batchMeans;
+  std::vector<CovType> batchCovs;
+  BatchStatistics(batch, condLogProb, totalWeight, batchWeights, batchMeans,
+      batchCovs);
+
+  // Blend the statistics of the batch into the running statistics.
+  const double stepSize = std::pow(steps + 2.0, -stepDecay);
+  statWeights = (1.0 - stepSize) * statWeights + stepSize * batchWeights;
+  statMeans = (1.0 - stepSize) * statMeans + stepSize * batchMeans;
+  for (size_t i = 0; i < dists.size(); ++i)
+    statCovs[i] = (1.0 - stepSize) * statCovs[i] + stepSize * batchCovs[i];
+  ++steps;
+
+  // M-step.
+  UpdateModel(dists, weights);
+
+  return logLikelihood;
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::UpdateModel(std::vector<Distribution>& dists,
+                               arma::vec& weights)
+{
+  for (size_t i = 0; i < dists.size(); ++i)
+  {
+    // Don't update if there's no probability of the Gaussian having points.
+    if (statWeights[i] <= 0.0)
+      continue;
+
+    const arma::vec offset = statMeans.col(i) / statWeights[i];
+    dists[i].Mean() = shift + offset;
+
+    CovType covariance;
+    if constexpr (isDiagGaussDist)
+    {
+      covariance = statCovs[i] / statWeights[i] - arma::square(offset);
+      covariance = arma::clamp(covariance, 1e-10, DBL_MAX);
+    }
+    else
+    {
+      covariance = statCovs[i] / statWeights[i] - offset * offset.t();
+    }
+
+    // Apply covariance constraint.
+    constraint.ApplyConstraint(covariance);
+    dists[i].Covariance(std::move(covariance));
+  }
+
+  weights = statWeights / arma::accu(statWeights);
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+double StepwiseEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    Distribution>::Pass(const arma::mat& observations,
+                        const arma::vec* probabilities,
+                        std::vector<Distribution>& dists,
+                        arma::vec& weights)
+{
+  const arma::uvec order = arma::randperm(observations.n_cols);
+  arma::mat batch;
+  arma::vec batchProbabilities;
+
+  double logLikelihood = 0.0;
+  for (size_t begin = 0; begin < observations.n_cols; begin += batchSize)
+  {
+    const size_t end = std::min(begin + batchSize, (size_t) observations.n_cols);
+    const arma::uvec indices = order.subvec(begin, end - 1);
+    batch = observations.cols(indices);
+    if (probabilities != NULL)
+    {
+      batchProbabilities = probabilities->elem(indices);
+      logLikelihood += Step(batch, &batchProbabilities, dists, weights);
+    }
+    else
+    {
+      logLikelihood += Step(batch, NULL, dists, weights);
+    }
+  }
+
+  return logLikelihood;
+}
+
+} // namespace mlpack
+
+#endif
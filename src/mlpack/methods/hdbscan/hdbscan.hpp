@@ -0,0 +1,222 @@
+/**
+ * @file methods/hdbscan/hdbscan.hpp
+ *
+ * An implementation of HDBSCAN, a hierarchical density-based clustering method
+ * that builds on DualTreeBoruvka and NeighborSearch.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HDBSCAN_HDBSCAN_HPP
+#define MLPACK_METHODS_HDBSCAN_HDBSCAN_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/emst/dtb.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+
+namespace mlpack {
+
+/**
+ * HDBSCAN (Hierarchical DBSCAN) is a clustering technique described in the
+ * following papers:
+ *
+ * @code
+ * @inproceedings{campello2013density,
+ *   title={Density-based clustering based on hierarchical density estimates},
+ *   author={Campello, R.J.G.B. and Moulavi, D. and Sander, J.},
+ *   booktitle={Advances in Knowledge Discovery and Data Mining (PAKDD 2013)},
+ *   pages={160--172},
+ *   year={2013}
+ * }
+ *
+ * @inproceedings{mcinnes2017accelerated,
+ *   title={Accelerated hierarchical density based clustering},
+ *   author={McInnes, L. and Healy, J.},
+ *   booktitle={2017 IEEE International Conference on Data Mining Workshops
+ *       (ICDMW)},
+ *   pages={33--42},
+ *   year={2017}
+ * }
+ * @endcode
+ *
+ * The core distance of a point is the distance to its (minPoints - 1)-th
+ * nearest neighbor (so that, counting the point itself, minPoints points are
+ * within that distance), and the mutual reachability distance between two
+ * points a and b is max(d(a, b), core(a), core(b)).  HDBSCAN computes the core
+ * distances with NeighborSearch and the minimum spanning tree of the dataset
+ * under the mutual reachability distance with DualTreeBoruvka.  That tree
+ * encodes the DBSCAN* clusterings for every value of epsilon at once.
+ *
+ * From the spanning tree, the single-linkage hierarchy is condensed: as the
+ * distance threshold decreases, a cluster either loses points (or groups of
+ * fewer than minClusterSize points), which are then considered noise, or
+ * splits into two clusters of at least minClusterSize points each.  The
+ * clusters of the condensed tree with the greatest stability (excess of mass)
+ * are then selected as the final flat clustering.
+ *
+ * After Cluster() has been called, ExtractDBSCAN() returns the DBSCAN*
+ * clustering for any value of epsilon, without any new search.
+ *
+ * @code
+ * arma::mat data; // The dataset to cluster.
+ *
+ * HDBSCAN<> hdbscan(10); // Clusters have at least 10 points.
+ * arma::Row<size_t> assignments;
+ * const size_t numClusters = hdbscan.Cluster(data, assignments);
+ *
+ * // Get the DBSCAN* clustering with epsilon = 0.5 from the same run.
+ * hdbscan.ExtractDBSCAN(0.5, assignments);
+ * @endcode
+ *
+ * @tparam TreeType The tree type to use for the nearest neighbor search and
+ *     the minimum spanning tree computation.
+ */
+template<template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = KDTree>
+class HDBSCAN
+{
+ public:
+  /**
+   * Construct the HDBSCAN object with the given parameters.
+   *
+   * @param minClusterSize Minimum number of points in a cluster (at least 2).
+   * @param minPoints Number of points (including the point itself) that must
+   *     be within the core distance of each point.  If 0, minClusterSize is
+   *     used.
+   * @param allowSingleCluster If true, the whole dataset may be returned as a
+   *     single cluster.
+   */
+  HDBSCAN(const size_t minClusterSize = 5,
+          const size_t minPoints = 0,
+          const bool allowSingleCluster = false);
+
+  /**
+   * Perform HDBSCAN clustering on the data, returning the number of clusters
+   * and also the list of cluster assignments.  If assignments[i] == SIZE_MAX,
+   * then the point is considered "noise".
+   *
+   * @param data Dataset to cluster.
+   * @param assignments Vector to store cluster assignments.
+   * @return The number of clusters.
+   */
+  size_t Cluster(const arma::mat& data, arma::Row<size_t>& assignments);
+
+  /**
+   * Perform HDBSCAN clustering on the data, returning the number of clusters,
+   * the centroid of each cluster and also the list of cluster assignments.  If
+   * assignments[i] == SIZE_MAX, then the point is considered "noise".
+   *
+   * @param data Dataset to cluster.
+   * @param assignments Vector to store cluster assignments.
+   * @param centroids Matrix in which centroids are stored.
+   * @return The number of clusters.
+   */
+  size_t Cluster(const arma::mat& data,
+                 arma::Row<size_t>& assignments,
+                 arma::mat& centroids);
+
+  /**
+   * Compute the DBSCAN* clustering of the last dataset given to Cluster() for
+   * the given epsilon: the points whose core distance is at most epsilon are
+   * clustered together if they are connected by a chain of points whose
+   * mutual reachability distances are at most epsilon, and every other point
+   * is noise.  Clusters of fewer than MinClusterSize() points are also noise.
+   * This only uses the spanning tree computed by Cluster().
+   *
+   * @param epsilon Size of the neighborhood of each point.
+   * @param assignments Vector to store cluster assignments.
+   * @return The number of clusters.
+   */
+  size_t ExtractDBSCAN(const double epsilon,
+                       arma::Row<size_t>& assignments) const;
+
+  //! Get the minimum number of points in a cluster.
+  size_t MinClusterSize() const { return minClusterSize; }
+  //! Modify the minimum number of points in a cluster.
+  size_t& MinClusterSize() { return minClusterSize; }
+
+  //! Get the number of points used for the core distances (0 means
+  //! MinClusterSize()).
+  size_t MinPoints() const { return minPoints; }
+  //! Modify the number of points used for the core distances.
+  size_t& MinPoints() { return minPoints; }
+
+  //! Get whether the whole dataset may be a single cluster.
+  bool AllowSingleCluster() const { return allowSingleCluster; }
+  //! Modify whether the whole dataset may be a single cluster.
+  bool& AllowSingleCluster() { return allowSingleCluster; }
+
+  //! Get the core distance of each point of the last clustered dataset.
+  const arma::vec& CoreDistances() const { return coreDistances; }
+
+  //! Get the minimum spanning tree of the last clustered dataset under the
+  //! mutual reachability distance, in the format of
+  //! DualTreeBoruvka::ComputeMST().
+  const arma::mat& SpanningTree() const { return spanningTree; }
+
+  /**
+   * Get the condensed cluster tree of the last clustered dataset.  Each column
+   * is an edge (parent, child, lambda, child size), where lambda is 1 / the
+   * distance at which the child leaves the parent cluster.  With N points,
+   * children less than N are points, and cluster i of the condensed tree is
+   * numbered N + i; the root cluster is N.
+   */
+  const arma::mat& CondensedTree() const { return condensedTree; }
+
+  //! Get the stability of each cluster of the condensed tree.
+  const arma::vec& Stabilities() const { return stabilities; }
+
+ private:
+  //! Minimum number of points in a cluster.
+  size_t minClusterSize;
+
+  //! Number of points used for the core distances.
+  size_t minPoints;
+
+  //! Whether the whole dataset may be a single cluster.
+  bool allowSingleCluster;
+
+  //! Core distance of each point.
+  arma::vec coreDistances;
+
+  //! Mutual reachability minimum spanning tree.
+  arma::mat spanningTree;
+
+  //! Condensed cluster tree.
+  arma::mat condensedTree;
+
+  //! Stability of each cluster of the condensed tree.
+  arma::vec stabilities;
+
+  /**
+   * Build the condensed tree from the spanning tree, and compute the stability
+   * of each of its clusters.
+   *
+   * @param numPoints Number of points in the dataset.
+   * @param pointClusters Will hold the cluster that each point leaves.
+   * @param clusterParents Will hold the parent of each cluster.
+   */
+  void CondenseTree(const size_t numPoints,
+                    arma::Col<size_t>& pointClusters,
+                    arma::Col<size_t>& clusterParents);
+
+  /**
+   * Select the clusters with the greatest total stability, such that no
+   * selected cluster is a descendant of another one.
+   *
+   * @param clusterParents Parent of each cluster.
+   * @param selected Will hold whether each cluster is selected.
+   */
+  void SelectClusters(const arma::Col<size_t>& clusterParents,
+                      std::vector<bool>& selected) const;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "hdbscan_impl.hpp"
+
+#endif
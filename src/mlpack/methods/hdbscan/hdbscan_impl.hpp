@@ -0,0 +1,357 @@
+/**
+ * @file methods/hdbscan/hdbscan_impl.hpp
+ *
+ * Implementation of HDBSCAN.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HDBSCAN_HDBSCAN_IMPL_HPP
+#define MLPACK_METHODS_HDBSCAN_HDBSCAN_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hdbscan.hpp"
+
+namespace mlpack {
+
+template<template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+HDBSCAN<TreeType>::HDBSCAN(const size_t minClusterSize,
+                           const size_t minPoints,
+                           const bool allowSingleCluster) :
+    minClusterSize(minClusterSize),
+    minPoints(minPoints),
+    allowSingleCluster(allowSingleCluster)
+{
+  // Nothing to do.
+}
+
+template<template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t HDBSCAN<TreeType>::Cluster(const arma::mat& data,
+                                  arma::Row<size_t>& assignments,
+                                  arma::mat& centroids)
+{
+  const size_t numClusters = Cluster(data, assignments);
+
+  // Now calculate the centroids.
+  centroids.zeros(data.n_rows, numClusters);
+
+  arma::Row<size_t> counts;
+  counts.zeros(numClusters);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    if (assignments[i] != SIZE_MAX)
+    {
+      centroids.col(assignments[i]) += data.col(i);
+      ++counts[assignments[i]];
+    }
+  }
+
+  for (size_t i = 0; i < numClusters; ++i)
+    centroids.col(i) /= counts[i];
+
+  return numClusters;
+}
+
+template<template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t HDBSCAN<TreeType>::Cluster(const arma::mat& data,
+                                  arma::Row<size_t>& assignments)
+{
+  if (minClusterSize < 2)
+  {
+    throw std::invalid_argument("HDBSCAN::Cluster(): minClusterSize must be "
+        "at least 2!");
+  }
+
+  const size_t k = (minPoints == 0) ? minClusterSize : minPoints;
+  if (data.n_cols < 2 || k > data.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "HDBSCAN::Cluster(): the dataset has " << data.n_cols << " points, "
+        << "but at least " << std::max(k, (size_t) 2) << " are needed!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The core distance of each point is the distance to its (k - 1)-th nearest
+  // neighbor, not counting the point itself.
+  if (k > 1)
+  {
+    NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat, TreeType>
+        knn(data);
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    knn.Search(k - 1, neighbors, distances);
+    coreDistances = distances.row(k - 2).t();
+  }
+  else
+  {
+    coreDistances.zeros(data.n_cols);
+  }
+
+  Log::Info << "Computing mutual reachability spanning tree." << std::endl;
+  DualTreeBoruvka<EuclideanDistance, arma::mat, TreeType> dtb(data);
+  dtb.ComputeMST(spanningTree, coreDistances);
+
+  arma::Col<size_t> pointClusters, clusterParents;
+  CondenseTree(data.n_cols, pointClusters, clusterParents);
+
+  std::vector<bool> selected;
+  SelectClusters(clusterParents, selected);
+
+  // Number the selected clusters, and give every other cluster the label of
+  // the selected cluster that contains it, if any.  Parents always come before
+  // their children.
+  arma::Col<size_t> labels(clusterParents.n_elem);
+  size_t numClusters = 0;
+  for (size_t c = 0; c < clusterParents.n_elem; ++c)
+  {
+    if (selected[c])
+      labels[c] = numClusters++;
+    else if (c == 0)
+      labels[c] = SIZE_MAX;
+    else
+      labels[c] = labels[clusterParents[c]];
+  }
+
+  assignments.set_size(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    assignments[i] = labels[pointClusters[i]];
+
+  Log::Info << numClusters << " clusters found." << std::endl;
+
+  return numClusters;
+}
+
+template<template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t HDBSCAN<TreeType>::ExtractDBSCAN(const double epsilon,
+                                        arma::Row<size_t>& assignments) const
+{
+  if (coreDistances.n_elem == 0)
+  {
+    throw std::invalid_argument("HDBSCAN::ExtractDBSCAN(): Cluster() must be "
+        "called first!");
+  }
+
+  // The points within epsilon of each other in the mutual reachability
+  // distance are connected through the edges of the spanning tree that are no
+  // longer than epsilon.
+  const size_t numPoints = coreDistances.n_elem;
+  UnionFind uf(numPoints);
+  for (size_t i = 0; i < spanningTree.n_cols; ++i)
+  {
+    if (spanningTree(2, i) <= epsilon)
+    {
+      uf.Union((size_t) spanningTree(0, i), (size_t) spanningTree(1, i));
+    }
+  }
+
+  arma::Col<size_t> counts(numPoints, arma::fill::zeros);
+  for (size_t i = 0; i < numPoints; ++i)
+    if (coreDistances[i] <= epsilon)
+      ++counts[uf.Find(i)];
+
+  arma::Col<size_t> labels(numPoints);
+  labels.fill(SIZE_MAX);
+  size_t numClusters = 0;
+
+  assignments.set_size(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    const size_t component = uf.Find(i);
+    if (coreDistances[i] > epsilon || counts[component] < minClusterSize)
+    {
+      assignments[i] = SIZE_MAX;
+      continue;
+    }
+
+    if (labels[component] == SIZE_MAX)
+      labels[component] = numClusters++;
+    assignments[i] = labels[component];
+  }
+
+  return numClusters;
+}
+
+template<template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void HDBSCAN<TreeType>::CondenseTree(const size_t numPoints,
+                                     arma::Col<size_t>& pointClusters,
+                                     arma::Col<size_t>& clusterParents)
+{
+  // First build the single-linkage hierarchy from the spanning tree, whose
+  // edges are sorted by distance.  Nodes below numPoints are points, and node
+  // numPoints + i is the merge made by edge i.
+  const size_t numEdges = spanningTree.n_cols;
+  arma::Col<size_t> left(numEdges), right(numEdges);
+  arma::Col<size_t> sizes(numPoints + numEdges);
+  arma::Col<size_t> rootNodes(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    sizes[i] = 1;
+    rootNodes[i] = i;
+  }
+
+  UnionFind uf(numPoints);
+  for (size_t i = 0; i < numEdges; ++i)
+  {
+    const size_t a = uf.Find((size_t) spanningTree(0, i));
+    const size_t b = uf.Find((size_t) spanningTree(1, i));
+    left[i] = rootNodes[a];
+    right[i] = rootNodes[b];
+    sizes[numPoints + i] = sizes[left[i]] + sizes[right[i]];
+
+    uf.Union(a, b);
+    rootNodes[uf.Find(a)] = numPoints + i;
+  }
+
+  // Now walk down the hierarchy from the root.  Cluster c is the parent of the
+  // clusters created when it splits, so parents always come before children.
+  std::vector<size_t> parents(1, 0);
+  std::vector<double> births(1, 0.0);
+  std::vector<double> edgeParents, edgeChildren, edgeLambdas, edgeSizes;
+  pointClusters.set_size(numPoints);
+
+  std::vector<std::pair<size_t, size_t>> stack;
+  stack.push_back(std::make_pair(numPoints + numEdges - 1, 0));
+  std::vector<size_t> fallenStack;
+  while (!stack.empty())
+  {
+    const size_t node = stack.back().first;
+    const size_t cluster = stack.back().second;
+    stack.pop_back();
+
+    const size_t edge = node - numPoints;
+    const double lambda = (spanningTree(2, edge) > 0.0) ?
+        1.0 / spanningTree(2, edge) : DBL_MAX;
+    const size_t children[2] = { left[edge], right[edge] };
+
+    if (sizes[children[0]] >= minClusterSize &&
+        sizes[children[1]] >= minClusterSize)
+    {
+      // The cluster splits into two new clusters.
+      for (size_t c = 0; c < 2; ++c)
+      {
+        const size_t newCluster = parents.size();
+        parents.push_back(cluster);
+        births.push_back(lambda);
+
+        edgeParents.push_back(numPoints + cluster);
+        edgeChildren.push_back(numPoints + newCluster);
+        edgeLambdas.push_back(lambda);
+        edgeSizes.push_back(sizes[children[c]]);
+
+        stack.push_back(std::make_pair(children[c], newCluster));
+      }
+
+      continue;
+    }
+
+    for (size_t c = 0; c < 2; ++c)
+    {
+      if (sizes[children[c]] >= minClusterSize)
+      {
+        // The cluster continues in this child.
+        stack.push_back(std::make_pair(children[c], cluster));
+        continue;
+      }
+
+      // The points of this child leave the cluster.
+      fallenStack.push_back(children[c]);
+      while (!fallenStack.empty())
+      {
+        const size_t fallenNode = fallenStack.back();
+        fallenStack.pop_back();
+        if (fallenNode >= numPoints)
+        {
+          fallenStack.push_back(left[fallenNode - numPoints]);
+          fallenStack.push_back(right[fallenNode - numPoints]);
+          continue;
+        }
+
+        pointClusters[fallenNode] = cluster;
+        edgeParents.push_back(numPoints + cluster);
+        edgeChildren.push_back(fallenNode);
+        edgeLambdas.push_back(lambda);
+        edgeSizes.push_back(1);
+      }
+    }
+  }
+
+  clusterParents = arma::conv_to<arma::Col<size_t>>::from(parents);
+
+  condensedTree.set_size(4, edgeParents.size());
+  condensedTree.row(0) = arma::rowvec(edgeParents);
+  condensedTree.row(1) = arma::rowvec(edgeChildren);
+  condensedTree.row(2) = arma::rowvec(edgeLambdas);
+  condensedTree.row(3) = arma::rowvec(edgeSizes);
+
+  // The stability of a cluster is the sum, over its points, of the range of
+  // lambda for which they belong to it.
+  stabilities.zeros(parents.size());
+  for (size_t i = 0; i < edgeParents.size(); ++i)
+  {
+    const size_t cluster = (size_t) edgeParents[i] - numPoints;
+    stabilities[cluster] += (edgeLambdas[i] - births[cluster]) * edgeSizes[i];
+  }
+}
+
+template<template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void HDBSCAN<TreeType>::SelectClusters(const arma::Col<size_t>& clusterParents,
+                                       std::vector<bool>& selected) const
+{
+  const size_t numClusters = clusterParents.n_elem;
+  selected.assign(numClusters, false);
+
+  // Go up the condensed tree: a cluster is kept if it is at least as stable as
+  // the best selection among its descendants.
+  arma::vec childStabilities(numClusters, arma::fill::zeros);
+  std::vector<bool> hasChildren(numClusters, false);
+  for (size_t c = numClusters - 1; c > 0; --c)
+  {
+    double subtreeStability = childStabilities[c];
+    if (!hasChildren[c] || stabilities[c] >= childStabilities[c])
+    {
+      selected[c] = true;
+      subtreeStability = stabilities[c];
+    }
+
+    childStabilities[clusterParents[c]] += subtreeStability;
+    hasChildren[clusterParents[c]] = true;
+  }
+
+  if (allowSingleCluster &&
+      (!hasChildren[0] || stabilities[0] >= childStabilities[0]))
+    selected[0] = true;
+
+  // No selected cluster may have a selected ancestor.
+  std::vector<bool> covered(numClusters, false);
+  covered[0] = selected[0];
+  for (size_t c = 1; c < numClusters; ++c)
+  {
+    if (covered[clusterParents[c]])
+    {
+      selected[c] = false;
+      covered[c] = true;
+    }
+    else
+    {
+      covered[c] = selected[c];
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -140,6 +140,31 @@ class HMM
       const std::vector<Distribution>& emission,
       const double tolerance = 1e-5);
 
+  /**
+   * Create the Hidden Markov Model with the given initial probability vector,
+   * the given sparse transition matrix, and the given emission distributions.
+   * This is otherwise the same as the constructor taking a dense transition
+   * matrix.
+   *
+   * Only the transitions with nonzero probability are visited by the
+   * forward-backward algorithm, the Viterbi algorithm and Baum-Welch training
+   * (whichever constructor is used), so for models with few transitions per
+   * state, such as left-to-right or banded models, these cost O(T * nnz)
+   * instead of O(T * S^2) for S states.  Transitions with zero probability
+   * remain impossible after training with Baum-Welch.
+   *
+   * @param initial Initial state probabilities.
+   * @param transition Sparse transition matrix.
+   * @param emission Emission distributions.
+   * @param tolerance Tolerance for convergence of training algorithm
+   *      (Baum-Welch).
+   */
+  template<typename eT>
+  HMM(const arma::vec& initial,
+      const arma::SpMat<eT>& transition,
+      const std::vector<Distribution>& emission,
+      const double tolerance = 1e-5);
+
   /**
    * Train the model using the Baum-Welch algorithm, with only the given
    * unlabeled observations.  Instead of giving a guess transition and emission
@@ -284,6 +309,23 @@ class HMM
   double Predict(const arma::mat& dataSeq,
                  arma::Row<size_t>& stateSeq) const;
 
+  /**
+   * Compute the most probable hidden state sequence for each of the given data
+   * sequences, using the Viterbi algorithm.  The sequences are decoded in
+   * parallel (if OpenMP is available), and each thread reuses its workspace
+   * from one sequence to the next, so this is much faster than calling
+   * Predict() on each sequence when there are many short sequences.
+   *
+   * @param dataSeq Sequences of observations.
+   * @param stateSeq Vector in which the most probable state sequence of each
+   *    data sequence will be stored.
+   * @param logLikelihoods Vector in which the log-likelihood of the most
+   *    probable state sequence of each data sequence will be stored.
+   */
+  void Predict(const std::vector<arma::mat>& dataSeq,
+               std::vector<arma::Row<size_t>>& stateSeq,
+               arma::vec& logLikelihoods) const;
+
   /**
    * Compute the log-likelihood of the given data sequence.
    *
@@ -441,6 +483,21 @@ class HMM
   void save(Archive& ar, const uint32_t version) const;
 
  protected:
+  /**
+   * The transitions with nonzero probability, grouped by column (or by row) of
+   * the transition matrix, in compressed sparse format.  The entries of column
+   * (or row) j are offsets[j] to offsets[j + 1] - 1.
+   */
+  struct LogTransitionEntries
+  {
+    //! Offset of the first entry of each column (or row), and the total count.
+    std::vector<size_t> offsets;
+    //! Row (or column) of each entry.
+    std::vector<size_t> indices;
+    //! Log of the transition probability of each entry.
+    std::vector<double> values;
+  };
+
   /**
    * Given emission probabilities, computes forward probabilities at time t=0.
    *
@@ -473,11 +530,15 @@ class HMM
    * @param dataSeq Data sequence to compute probabilities for.
    * @param logScales Vector in which the log of scaling factors will be saved.
    * @param forwardLogProb Matrix in which forward probabilities will be saved.
+   * @param logProbs Emission log-probabilities of the observations.
+   * @param logTransitionRows Transitions of the model, grouped by row (see
+   *     CompressLogTransition()).
    */
   void Forward(const arma::mat& dataSeq,
                arma::vec& logScales,
                arma::mat& forwardLogProb,
-               arma::mat& logProbs) const;
+               const arma::mat& logProbs,
+               const LogTransitionEntries& logTransitionRows) const;
 
   /**
    * The Backward algorithm (part of the Forward-Backward algorithm).  Computes
@@ -489,11 +550,23 @@ class HMM
    * @param dataSeq Data sequence to compute probabilities for.
    * @param logScales Vector of log of scaling factors.
    * @param backwardLogProb Matrix in which backward probabilities will be saved.
+   * @param logProbs Emission log-probabilities of the observations.
+   * @param logTransitionCols Transitions of the model, grouped by column (see
+   *     CompressLogTransition()).
    */
   void Backward(const arma::mat& dataSeq,
                 const arma::vec& logScales,
                 arma::mat& backwardLogProb,
-                arma::mat& logProbs) const;
+                const arma::mat& logProbs,
+                const LogTransitionEntries& logTransitionCols) const;
+
+  /**
+   * Collect the transitions with nonzero probability, grouped by column of the
+   * transition matrix (or by row, if byRow is true).  ConvertToLogSpace() must
+   * have been called.
+   */
+  void CompressLogTransition(LogTransitionEntries& entries,
+                             const bool byRow) const;
 
   //! Set of emission probability distributions; one for each state.
   std::vector<Distribution> emission;
@@ -515,6 +588,31 @@ class HMM
    */
   void ConvertToLogSpace() const;
 
+  /**
+   * Compute the log-probability of each observation of the given sequence
+   * under the emission distribution of each state.  logProbs will have one row
+   * for each observation and one column for each state.
+   */
+  void EmissionLogProbabilities(const arma::mat& dataSeq,
+                                arma::mat& logProbs) const;
+
+  /**
+   * The Viterbi algorithm, with precomputed emission log-probabilities and
+   * transitions grouped by row, and with caller-owned workspaces.  Returns the
+   * log-likelihood of the most probable state sequence.
+   */
+  double Viterbi(const arma::mat& logProbs,
+                 const LogTransitionEntries& logTransitionRows,
+                 arma::Row<size_t>& stateSeq,
+                 arma::mat& logStateProb,
+                 arma::Mat<size_t>& stateSeqBack) const;
+
+  //! Compute log(sum_k exp(v_k + b[i_k])) over the entries (i_k, v_k) of
+  //! column (or row) j, without temporaries.
+  static double AccuLogSum(const LogTransitionEntries& entries,
+                           const size_t j,
+                           const double* b);
+
   /**
    * A proxy vriable in linear space for logInitial.
    * Should be removed in mlpack 4.0.
@@ -75,6 +75,21 @@ HMM<Distribution>::HMM(const arma::vec& initial,
   }
 }
 
+/**
+ * Create the Hidden Markov Model with the given sparse transition matrix.
+ */
+template<typename Distribution>
+template<typename eT>
+HMM<Distribution>::HMM(const arma::vec& initial,
+                       const arma::SpMat<eT>& transition,
+                       const std::vector<Distribution>& emission,
+                       const double tolerance) :
+    HMM(initial, arma::conv_to<arma::mat>::from(arma::Mat<eT>(transition)),
+        emission, tolerance)
+{
+  // Nothing to do.
+}
+
 /**
  * Train the model using the Baum-Welch algorithm, with only the given unlabeled
  * observations.  Each matrix in the vector of data sequences holds an
@@ -113,89 +128,117 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
   }
 
   // These are used later for training of each distribution.  We initialize it
-  // all now so we don't have to do any allocation later on.
+  // all now so we don't have to do any allocation later on.  The observations
+  // do not change between iterations, so the list of them is built only once;
+  // offsets[seq] is the index of the first observation of sequence seq in it.
   std::vector<arma::vec> emissionProb(logTransition.n_cols,
       arma::vec(totalLength));
   arma::mat emissionList(dimensionality, totalLength);
+  std::vector<size_t> offsets(dataSeq.size() + 1, 0);
+  for (size_t seq = 0; seq < dataSeq.size(); seq++)
+  {
+    offsets[seq + 1] = offsets[seq] + dataSeq[seq].n_cols;
+    if (dataSeq[seq].n_cols > 0)
+      emissionList.cols(offsets[seq], offsets[seq + 1] - 1) = dataSeq[seq];
+  }
 
   // This should be the Baum-Welch algorithm (EM for HMM estimation). This
   // follows the procedure outlined in Elliot, Aggoun, and Moore's book "Hidden
   // Markov Models: Estimation and Control", pp. 36-40.
   for (size_t iter = 0; iter < iterations; iter++)
   {
-    // Clear new transition matrix and emission probabilities.
-    arma::vec newLogInitial(logTransition.n_rows);
-    newLogInitial.fill(-std::numeric_limits<double>::infinity());
-    arma::mat newLogTransition(logTransition.n_rows, logTransition.n_cols);
-    newLogTransition.fill(-std::numeric_limits<double>::infinity());
+    // This must happen before the parallel region, since it modifies the
+    // model.
+    ConvertToLogSpace();
+    const size_t states = logTransition.n_rows;
+
+    // Only the transitions with nonzero probability need to be visited, and
+    // only they can have a nonzero probability after the update.
+    LogTransitionEntries logTransitionRows, logTransitionCols;
+    CompressLogTransition(logTransitionRows, true);
+    CompressLogTransition(logTransitionCols, false);
+    const size_t numEntries = logTransitionCols.values.size();
+
+    // Clear new transition matrix and initial probabilities.  These
+    // expectations are all between 0 and the number of observations, so they
+    // can safely be accumulated in linear space.  The new transition
+    // probabilities are stored in the same order as logTransitionCols.
+    arma::vec newInitial(states, arma::fill::zeros);
+    arma::vec newTransition(numEntries, arma::fill::zeros);
 
     // Reset log likelihood.
     loglik = 0;
 
-    // Sum over time.
-    size_t sumTime = 0;
-
-    // Loop over each sequence.
-    for (size_t seq = 0; seq < dataSeq.size(); seq++)
+    // The sequences are independent given the current model, so each thread
+    // handles a share of them, with its own statistics and workspaces.  The
+    // length of the sequences may vary a lot, hence the dynamic schedule.
+    #pragma omp parallel
     {
-      arma::mat stateLogProb;
-      arma::mat forwardLog;
-      arma::mat backwardLog;
-      arma::vec logScales;
-
-      // Add the log-likelihood of this sequence.  This is the E-step.
-      loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
-          backwardLog, logScales);
-
-      // Add to estimate of initial probability for state j.
-      LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
-          newLogInitial);
-
-      // Define a variable to store the value of log-probability for data.
-      arma::mat logProbs(dataSeq[seq].n_cols, logTransition.n_rows);
-      // Save the values of log-probability to logProbs.
-      for (size_t i = 0; i < logTransition.n_rows; i++)
-      {
-        // Define alias of desired column.
-        arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-        // Use advanced constructor for using logProbs directly.
-        emission[i].LogProbability(dataSeq[seq], alias);
-      }
+      arma::vec threadInitial(states, arma::fill::zeros);
+      arma::vec threadTransition(numEntries, arma::fill::zeros);
+      arma::mat logProbs, forwardLog, backwardLog;
+      arma::vec logScales, nextLogProb(states);
 
-      // Now re-estimate the parameters.  This is the M-step.
-      //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
-      //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t]) b(i,
-      //           t + 1)))
-      //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t) b(i, t)
-      // We store the new estimates in a different matrix.
-      for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+      #pragma omp for schedule(dynamic) reduction(+:loglik)
+      for (size_t seq = 0; seq < dataSeq.size(); seq++)
       {
-        // Assemble temporary vector that's used in log-sum computation.
-        if (t < dataSeq[seq].n_cols - 1)
+        // Run the forward-backward algorithm on this sequence, and add its
+        // log-likelihood.  This is the E-step.
+        EmissionLogProbabilities(dataSeq[seq], logProbs);
+        Forward(dataSeq[seq], logScales, forwardLog, logProbs,
+            logTransitionRows);
+        Backward(dataSeq[seq], logScales, backwardLog, logProbs,
+            logTransitionCols);
+        loglik += accu(logScales);
+
+        // Now collect the statistics for the M-step.
+        //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
+        //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij
+        //           E_i(seq[d][t]) b(i, t + 1)))
+        //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t)
+        //           b(i, t)
+        // forwardLog + backwardLog holds the log-probability of each state at
+        // each time step.
+        threadInitial += exp(forwardLog.col(0) + backwardLog.col(0));
+
+        for (size_t t = 0; t + 1 < dataSeq[seq].n_cols; ++t)
         {
-          // This term is the same across all states, so compute it once and
-          // cache it.
-          const arma::vec tmp = backwardLog.col(t + 1) +
-              logProbs.row(t + 1).t() - logScales[t + 1];
-          arma::vec output;
-          LogSumExp(tmp, output);
-
-          for (size_t j = 0; j < logTransition.n_cols; ++j)
+          if (!std::isfinite(logScales[t + 1]))
+            continue;
+
+          // This term is the same across all states, so compute it once.
+          for (size_t i = 0; i < states; ++i)
+          {
+            nextLogProb[i] = backwardLog(i, t + 1) + logProbs(t + 1, i) -
+                logScales[t + 1];
+          }
+
+          // Add the probability of the transition from state j to state i at
+          // time t.
+          for (size_t j = 0; j < states; ++j)
           {
-            // Compute the estimate of T_ij (probability of transition from
-            // state j to state i).  We postpone multiplication of the old T_ij
-            // until later.
-            arma::vec tmp2 = output + forwardLog(j, t);
-            arma::vec alias = newLogTransition.unsafe_col(j);
-            LogSumExp<arma::vec, true>(tmp2, alias);
+            for (size_t k = logTransitionCols.offsets[j];
+                 k < logTransitionCols.offsets[j + 1]; ++k)
+            {
+              threadTransition[k] += std::exp(forwardLog(j, t) +
+                  logTransitionCols.values[k] +
+                  nextLogProb[logTransitionCols.indices[k]]);
+            }
           }
         }
 
-        // Add to list of emission observations, for Distribution::Train().
-        for (size_t j = 0; j < logTransition.n_cols; ++j)
-          emissionProb[j][sumTime] = std::exp(stateLogProb(j, t));
-        emissionList.col(sumTime) = dataSeq[seq].col(t);
-        sumTime++;
+        // Store the state probabilities of the observations, for
+        // Distribution::Train().  Each sequence has its own range of them.
+        for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+          for (size_t j = 0; j < states; ++j)
+            emissionProb[j][offsets[seq] + t] = std::exp(forwardLog(j, t) +
+                backwardLog(j, t));
+      }
+
+      #pragma omp critical
+      {
+        newInitial += threadInitial;
+        newTransition += threadTransition;
       }
     }
 
@@ -208,25 +251,43 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
     oldLoglik = loglik;
 
     // Normalize the new initial probabilities.
-    if (dataSeq.size() > 1)
-      logInitial = newLogInitial - std::log(dataSeq.size());
-    else
-      logInitial = newLogInitial;
+    logInitial = log(newInitial / (double) dataSeq.size());
 
-    // Assign the new transition matrix.  We use %= (element-wise
-    // multiplication) because every element of the new transition matrix must
-    // still be multiplied by the old elements (this is the multiplication we
-    // earlier postponed).
-    logTransition += newLogTransition;
+    // Assign the new transition matrix.  The old transition probabilities have
+    // already been multiplied into each term.
+    logTransition.fill(-std::numeric_limits<double>::infinity());
+    for (size_t j = 0; j < states; ++j)
+    {
+      for (size_t k = logTransitionCols.offsets[j];
+           k < logTransitionCols.offsets[j + 1]; ++k)
+      {
+        logTransition(logTransitionCols.indices[k], j) =
+            std::log(newTransition[k]);
+      }
+    }
 
-    // Now we normalize the transition matrix.
+    // Now we normalize the transition matrix.  If a state was never visited,
+    // its transitions are kept as they were, so that they stay sparse.
     for (size_t i = 0; i < logTransition.n_cols; i++)
     {
       const double sum = AccuLog(logTransition.col(i));
       if (std::isfinite(sum))
+      {
         logTransition.col(i) -= sum;
+      }
+      else if (logTransitionCols.offsets[i + 1] > logTransitionCols.offsets[i])
+      {
+        for (size_t k = logTransitionCols.offsets[i];
+             k < logTransitionCols.offsets[i + 1]; ++k)
+        {
+          logTransition(logTransitionCols.indices[k], i) =
+              logTransitionCols.values[k];
+        }
+      }
       else
+      {
         logTransition.col(i).fill(-std::log((double) logTransition.n_rows));
+      }
     }
 
     initialProxy = exp(logInitial);
@@ -352,20 +413,17 @@ double HMM<Distribution>::LogEstimate(const arma::mat& dataSeq,
                                       arma::mat& backwardLogProb,
                                       arma::vec& logScales) const
 {
-  arma::mat logProbs(dataSeq.n_cols, logTransition.n_rows);
+  arma::mat logProbs;
+  EmissionLogProbabilities(dataSeq, logProbs);
 
-  // Save the values of log-probability to logProbs.
-  for (size_t i = 0; i < logTransition.n_rows; i++)
-  {
-    // Define alias of desired column.
-    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-    // Use advanced constructor for using logProbs directly.
-    emission[i].LogProbability(dataSeq, alias);
-  }
+  ConvertToLogSpace();
+  LogTransitionEntries logTransitionRows, logTransitionCols;
+  CompressLogTransition(logTransitionRows, true);
+  CompressLogTransition(logTransitionCols, false);
 
   // First run the forward-backward algorithm.
-  Forward(dataSeq, logScales, forwardLogProb, logProbs);
-  Backward(dataSeq, logScales, backwardLogProb, logProbs);
+  Forward(dataSeq, logScales, forwardLogProb, logProbs, logTransitionRows);
+  Backward(dataSeq, logScales, backwardLogProb, logProbs, logTransitionCols);
 
   // Now assemble the state probability matrix based on the forward and backward
   // probabilities.
@@ -484,66 +542,117 @@ template<typename Distribution>
 double HMM<Distribution>::Predict(const arma::mat& dataSeq,
                                   arma::Row<size_t>& stateSeq) const
 {
-  // This is an implementation of the Viterbi algorithm for finding the most
-  // probable sequence of states to produce the observed data sequence.  We
-  // don't use log-likelihoods to save that little bit of time, but we'll
-  // calculate the log-likelihood at the end of it all.
-  stateSeq.set_size(dataSeq.n_cols);
-  arma::mat logStateProb(logTransition.n_rows, dataSeq.n_cols);
-  arma::mat stateSeqBack(logTransition.n_rows, dataSeq.n_cols);
+  ConvertToLogSpace();
+
+  arma::mat logProbs;
+  EmissionLogProbabilities(dataSeq, logProbs);
 
+  LogTransitionEntries logTransitionRows;
+  CompressLogTransition(logTransitionRows, true);
+
+  arma::mat logStateProb;
+  arma::Mat<size_t> stateSeqBack;
+  return Viterbi(logProbs, logTransitionRows, stateSeq, logStateProb,
+      stateSeqBack);
+}
+
+/**
+ * Compute the most probable hidden state sequence of each of the given data
+ * sequences, using the Viterbi algorithm.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Predict(const std::vector<arma::mat>& dataSeq,
+                                std::vector<arma::Row<size_t>>& stateSeq,
+                                arma::vec& logLikelihoods) const
+{
+  // This must happen before the parallel region, since it may modify the
+  // model.
   ConvertToLogSpace();
 
-  // The calculation of the first state is slightly different; the probability
-  // of the first state being state j is the maximum probability that the state
-  // came to be j from another state.
-  logStateProb.col(0).zeros();
-  for (size_t state = 0; state < logTransition.n_rows; state++)
+  stateSeq.resize(dataSeq.size());
+  logLikelihoods.set_size(dataSeq.size());
+  LogTransitionEntries logTransitionRows;
+  CompressLogTransition(logTransitionRows, true);
+
+  #pragma omp parallel
   {
-    logStateProb(state, 0) = logInitial[state] +
-        emission[state].LogProbability(dataSeq.unsafe_col(0));
-    stateSeqBack(state, 0) = state;
-  }
+    // The workspaces of each thread are only reallocated when a longer
+    // sequence comes along.
+    arma::mat logProbs, logStateProb;
+    arma::Mat<size_t> stateSeqBack;
 
-  // Store the best first state.
-  arma::uword index;
+    #pragma omp for schedule(dynamic)
+    for (size_t seq = 0; seq < dataSeq.size(); ++seq)
+    {
+      EmissionLogProbabilities(dataSeq[seq], logProbs);
+      logLikelihoods[seq] = Viterbi(logProbs, logTransitionRows,
+          stateSeq[seq], logStateProb, stateSeqBack);
+    }
+  }
+}
 
-  // Define a variable to store the value of log-probability for dataSeq.
-  arma::mat logProbs(dataSeq.n_cols, logTransition.n_rows);
+/**
+ * The Viterbi algorithm, given the emission log-probabilities of each
+ * observation.
+ */
+template<typename Distribution>
+double HMM<Distribution>::Viterbi(const arma::mat& logProbs,
+                                  const LogTransitionEntries& logTransitionRows,
+                                  arma::Row<size_t>& stateSeq,
+                                  arma::mat& logStateProb,
+                                  arma::Mat<size_t>& stateSeqBack) const
+{
+  // This is an implementation of the Viterbi algorithm for finding the most
+  // probable sequence of states to produce the observed data sequence.
+  const size_t n = logProbs.n_rows;
+  const size_t states = logTransitionRows.offsets.size() - 1;
+  stateSeq.set_size(n);
+  logStateProb.set_size(states, n);
+  stateSeqBack.set_size(states, n);
 
-  // Save the values of log-probability to logProbs.
-  for (size_t i = 0; i < logTransition.n_rows; i++)
+  // The calculation of the first state is slightly different; the probability
+  // of the first state being state j is the maximum probability that the state
+  // came to be j from another state.
+  for (size_t state = 0; state < states; state++)
   {
-    // Define alias of desired column.
-    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-    // Use advanced constructor for using logProbs directly.
-    emission[i].LogProbability(dataSeq, alias);
+    logStateProb(state, 0) = logInitial[state] + logProbs(0, state);
+    stateSeqBack(state, 0) = state;
   }
 
-  for (size_t t = 1; t < dataSeq.n_cols; t++)
+  for (size_t t = 1; t < n; t++)
   {
     // Assemble the state probability for this element.
     // Given that we are in state j, we use state with the highest probability
-    // of being the previous state.
-    for (size_t j = 0; j < logTransition.n_rows; j++)
+    // of being the previous state.  Only the states that can transition to j
+    // need to be considered.
+    const double* prev = logStateProb.colptr(t - 1);
+    for (size_t j = 0; j < states; j++)
     {
-      arma::vec prob = logStateProb.col(t - 1) + logTransition.row(j).t();
-      index = prob.index_max();
-      logStateProb(j, t) = prob[index] + logProbs(t, j);
+      size_t index = 0;
+      double best = -std::numeric_limits<double>::infinity();
+      for (size_t k = logTransitionRows.offsets[j];
+           k < logTransitionRows.offsets[j + 1]; k++)
+      {
+        const size_t i = logTransitionRows.indices[k];
+        const double prob = prev[i] + logTransitionRows.values[k];
+        if (prob > best)
+        {
+          best = prob;
+          index = i;
+        }
+      }
+
+      logStateProb(j, t) = best + logProbs(t, j);
       stateSeqBack(j, t) = index;
     }
   }
 
   // Backtrack to find the most probable state sequence.
-  index = logStateProb.unsafe_col(dataSeq.n_cols - 1).index_max();
-  stateSeq[dataSeq.n_cols - 1] = index;
-  for (size_t t = 2; t <= dataSeq.n_cols; t++)
-  {
-    stateSeq[dataSeq.n_cols - t] =
-        stateSeqBack(stateSeq[dataSeq.n_cols - t + 1], dataSeq.n_cols - t + 1);
-  }
+  stateSeq[n - 1] = logStateProb.unsafe_col(n - 1).index_max();
+  for (size_t t = 2; t <= n; t++)
+    stateSeq[n - t] = stateSeqBack(stateSeq[n - t + 1], n - t + 1);
 
-  return logStateProb(stateSeq(dataSeq.n_cols - 1), dataSeq.n_cols - 1);
+  return logStateProb(stateSeq[n - 1], n - 1);
 }
 
 /**
@@ -556,18 +665,14 @@ double HMM<Distribution>::LogLikelihood(const arma::mat& dataSeq) const
   arma::vec logScales;
 
   // This is needed here.
-  arma::mat logProbs(dataSeq.n_cols, logTransition.n_rows);
+  arma::mat logProbs;
+  EmissionLogProbabilities(dataSeq, logProbs);
 
-  // Save the values of log-probability to logProbs.
-  for (size_t i = 0; i < logTransition.n_rows; i++)
-  {
-    // Define alias of desired column.
-    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-    // Use advanced constructor for using logProbs directly.
-    emission[i].LogProbability(dataSeq, alias);
-  }
+  ConvertToLogSpace();
+  LogTransitionEntries logTransitionRows;
+  CompressLogTransition(logTransitionRows, true);
 
-  Forward(dataSeq, logScales, forwardLog, logProbs);
+  Forward(dataSeq, logScales, forwardLog, logProbs, logTransitionRows);
 
   // The log-likelihood is the log of the scales for each time step.
   return accu(logScales);
@@ -658,18 +763,14 @@ void HMM<Distribution>::Filter(const arma::mat& dataSeq,
   arma::mat forwardLogProb;
   arma::vec logScales;
   // This is needed here.
-  arma::mat logProbs(dataSeq.n_cols, logTransition.n_rows);
+  arma::mat logProbs;
+  EmissionLogProbabilities(dataSeq, logProbs);
 
-  // Save the values of log-probability to logProbs.
-  for (size_t i = 0; i < logTransition.n_rows; i++)
-  {
-    // Define alias of desired column.
-    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-    // Use advanced constructor for using logProbs directly.
-    emission[i].LogProbability(dataSeq, alias);
-  }
+  ConvertToLogSpace();
+  LogTransitionEntries logTransitionRows;
+  CompressLogTransition(logTransitionRows, true);
 
-  Forward(dataSeq, logScales, forwardLogProb, logProbs);
+  Forward(dataSeq, logScales, forwardLogProb, logProbs, logTransitionRows);
 
   // Propagate state ahead.
   if (ahead != 0)
@@ -769,13 +870,15 @@ template<typename Distribution>
 void HMM<Distribution>::Forward(const arma::mat& dataSeq,
                                 arma::vec& logScales,
                                 arma::mat& forwardLogProb,
-                                arma::mat& logProbs) const
+                                const arma::mat& logProbs,
+                                const LogTransitionEntries& logTransitionRows)
+    const
 {
   // Our goal is to calculate the forward probabilities:
   //  P(X_k | o_{1:k}) for all possible states X_k, for each time point k.
-  forwardLogProb.resize(logTransition.n_rows, dataSeq.n_cols);
+  forwardLogProb.set_size(logTransition.n_rows, dataSeq.n_cols);
   forwardLogProb.fill(-std::numeric_limits<double>::infinity());
-  logScales.resize(dataSeq.n_cols);
+  logScales.set_size(dataSeq.n_cols);
   logScales.fill(-std::numeric_limits<double>::infinity());
 
   // The first entry in the forward algorithm uses the initial state
@@ -786,11 +889,22 @@ void HMM<Distribution>::Forward(const arma::mat& dataSeq,
 
   forwardLogProb.col(0) = ForwardAtT0(logProbs.row(0).t(), logScales(0));
 
-  // Now compute the probabilities for each successive observation.
+  // Now compute the probabilities for each successive observation.  This is
+  // the same computation as ForwardAtTn(), but without any temporaries, and
+  // only over the transitions with nonzero probability.
   for (size_t t = 1; t < dataSeq.n_cols; t++)
   {
-    forwardLogProb.col(t) = ForwardAtTn(logProbs.row(t).t(), logScales(t),
-        forwardLogProb.col(t - 1));
+    const double* prev = forwardLogProb.colptr(t - 1);
+    for (size_t i = 0; i < logTransition.n_rows; i++)
+    {
+      forwardLogProb(i, t) = AccuLogSum(logTransitionRows, i, prev) +
+          logProbs(t, i);
+    }
+
+    // Normalize probability.
+    logScales[t] = AccuLog(forwardLogProb.col(t));
+    if (std::isfinite(logScales[t]))
+      forwardLogProb.col(t) -= logScales[t];
   }
 }
 
@@ -798,29 +912,35 @@ template<typename Distribution>
 void HMM<Distribution>::Backward(const arma::mat& dataSeq,
                                  const arma::vec& logScales,
                                  arma::mat& backwardLogProb,
-                                 arma::mat& logProbs) const
+                                 const arma::mat& logProbs,
+                                 const LogTransitionEntries& logTransitionCols)
+    const
 {
   // Our goal is to calculate the backward probabilities:
   //  P(X_k | o_{k + 1:T}) for all possible states X_k, for each time point k.
-  backwardLogProb.resize(logTransition.n_rows, dataSeq.n_cols);
+  backwardLogProb.set_size(logTransition.n_rows, dataSeq.n_cols);
   backwardLogProb.fill(-std::numeric_limits<double>::infinity());
 
   // The last element probability is 1.
   backwardLogProb.col(dataSeq.n_cols - 1).fill(0);
 
   // Now step backwards through all other observations.
+  arma::vec nextLogProb(logTransition.n_rows);
   for (size_t t = dataSeq.n_cols - 2; t + 1 > 0; t--)
   {
     // The backward probability of state j at time t is the sum over all
     // states of the probability of the next state having been a transition
     // from the current state multiplied by the probability of each of those
-    // states emitting the given observation.  To compute this in log-space, we
-    // can use LogSumExpT().
-    const arma::mat tmp = logTransition +
-        repmat(backwardLogProb.col(t + 1), 1, logTransition.n_cols) +
-        repmat(logProbs.row(t + 1).t(), 1, logTransition.n_cols);
-    arma::vec alias = backwardLogProb.unsafe_col(t);
-    LogSumExpT<arma::mat, true>(tmp, alias);
+    // states emitting the given observation.  The part of each term that does
+    // not depend on j is computed only once.
+    for (size_t i = 0; i < logTransition.n_rows; i++)
+      nextLogProb[i] = backwardLogProb(i, t + 1) + logProbs(t + 1, i);
+
+    for (size_t j = 0; j < logTransition.n_cols; j++)
+    {
+      backwardLogProb(j, t) = AccuLogSum(logTransitionCols, j,
+          nextLogProb.memptr());
+    }
 
     // Normalize by the weights from the forward algorithm.
     if (std::isfinite(logScales[t + 1]))
@@ -848,6 +968,77 @@ void HMM<Distribution>::ConvertToLogSpace() const
   }
 }
 
+/**
+ * Compute the log-probability of each observation under the emission
+ * distribution of each state.
+ */
+template<typename Distribution>
+void HMM<Distribution>::EmissionLogProbabilities(const arma::mat& dataSeq,
+                                                 arma::mat& logProbs) const
+{
+  logProbs.set_size(dataSeq.n_cols, emission.size());
+  for (size_t i = 0; i < emission.size(); i++)
+  {
+    // Define alias of desired column.
+    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+    // Use advanced constructor for using logProbs directly.
+    emission[i].LogProbability(dataSeq, alias);
+  }
+}
+
+/**
+ * Collect the transitions with nonzero probability, by column or by row.
+ */
+template<typename Distribution>
+void HMM<Distribution>::CompressLogTransition(LogTransitionEntries& entries,
+                                              const bool byRow) const
+{
+  const size_t states = logTransition.n_rows;
+  entries.offsets.assign(states + 1, 0);
+  entries.indices.clear();
+  entries.values.clear();
+  for (size_t j = 0; j < states; j++)
+  {
+    for (size_t i = 0; i < states; i++)
+    {
+      const double value = byRow ? logTransition(j, i) : logTransition(i, j);
+      if (value == -std::numeric_limits<double>::infinity())
+        continue;
+
+      entries.indices.push_back(i);
+      entries.values.push_back(value);
+    }
+
+    entries.offsets[j + 1] = entries.indices.size();
+  }
+}
+
+/**
+ * Compute log(sum_k exp(v_k + b[i_k])) over the entries of column (or row) j,
+ * taking care of underflow.
+ */
+template<typename Distribution>
+double HMM<Distribution>::AccuLogSum(const LogTransitionEntries& entries,
+                                     const size_t j,
+                                     const double* b)
+{
+  const size_t begin = entries.offsets[j];
+  const size_t end = entries.offsets[j + 1];
+
+  double maxValue = -std::numeric_limits<double>::infinity();
+  for (size_t k = begin; k < end; k++)
+    maxValue = std::max(maxValue, entries.values[k] + b[entries.indices[k]]);
+
+  if (!std::isfinite(maxValue))
+    return maxValue;
+
+  double sum = 0.0;
+  for (size_t k = begin; k < end; k++)
+    sum += std::exp(entries.values[k] + b[entries.indices[k]] - maxValue);
+
+  return maxValue + std::log(sum);
+}
+
 //! Serialize the HMM.
 template<typename Distribution>
 template<typename Archive>
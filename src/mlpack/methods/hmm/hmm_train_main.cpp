@@ -257,6 +257,7 @@ struct Init
   static void RandomInitialize(util::Params& params,
                                vector<GMM>& e)
   {
+    const int gaussians = params.Get<int>("gaussians");
     for (size_t i = 0; i < e.size(); ++i)
     {
       // Random weights.
@@ -264,7 +265,7 @@ struct Init
       e[i].Weights() /= accu(e[i].Weights());
 
       // Random means and covariances.
-      for (int g = 0; g < params.Get<int>("gaussians"); ++g)
+      for (int g = 0; g < gaussians; ++g)
       {
         const size_t dimensionality = e[i].Component(g).Mean().n_rows;
         e[i].Component(g).Mean().randu();
@@ -281,6 +282,7 @@ struct Init
   static void RandomInitialize(util::Params& params,
                                vector<DiagonalGMM>& e)
   {
+    const int gaussians = params.Get<int>("gaussians");
     for (size_t i = 0; i < e.size(); ++i)
     {
       // Random weights.
@@ -288,7 +290,7 @@ struct Init
       e[i].Weights() /= accu(e[i].Weights());
 
       // Random means and covariances.
-      for (int g = 0; g < params.Get<int>("gaussians"); ++g)
+      for (int g = 0; g < gaussians; ++g)
       {
         const size_t dimensionality = e[i].Component(g).Mean().n_rows;
         e[i].Component(g).Mean().randu();
@@ -0,0 +1,16 @@
+/**
+ * @file hnsw.hpp
+ *
+ * Convenience include for mlpack/methods/hnsw/hnsw.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_HNSW_HPP
+#define MLPACK_HNSW_HPP
+
+#include "hnsw/hnsw.hpp"
+
+#endif
@@ -0,0 +1,350 @@
+/**
+ * @file methods/hnsw/hnsw_search.hpp
+ *
+ * Defines the HNSWSearch class, which performs approximate nearest neighbor
+ * search with a hierarchical navigable small world graph.
+ *
+ * The details of this method can be found in the following paper:
+ *
+ * @code
+ * @article{malkov2018efficient,
+ *   title={Efficient and robust approximate nearest neighbor search using
+ *       hierarchical navigable small world graphs},
+ *   author={Malkov, Yu A. and Yashunin, Dmitry A.},
+ *   journal={IEEE Transactions on Pattern Analysis and Machine Intelligence},
+ *   volume={42},
+ *   number={4},
+ *   pages={824--836},
+ *   year={2018},
+ *   publisher={IEEE}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HNSW_HNSW_SEARCH_HPP
+#define MLPACK_METHODS_HNSW_HNSW_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+
+#include <mlpack/methods/neighbor_search/sort_policies/nearest_neighbor_sort.hpp>
+
+#include <mutex>
+#include <unordered_set>
+
+namespace mlpack {
+
+/**
+ * The HNSWSearch class builds a hierarchical navigable small world (HNSW) graph
+ * on the reference set, and uses it to find the approximate nearest neighbors
+ * of query points.  Every point is a node of the bottom layer of the graph, and
+ * each node is also present in a random number of the layers above it, with an
+ * exponentially decaying probability, so that the upper layers form a
+ * hierarchy of increasingly coarse graphs.  A search descends greedily through
+ * the upper layers, then does a best-first search of the bottom layer that
+ * keeps track of the `ef` best candidates found so far.
+ *
+ * Compared to LSHSearch, HNSW typically gives much higher recall for the same
+ * search time on high-dimensional data.  Larger values of `ef` give better
+ * recall at the cost of slower search; `ef` can be changed at any time without
+ * rebuilding the graph.
+ *
+ * Points can be added to the graph incrementally with `Insert()`.  Building
+ * the graph (in `Train()` and `Insert()`) and searching are both parallelized
+ * with OpenMP, but `Search()` must not be called at the same time as
+ * `Insert()`.
+ *
+ * @code
+ * arma::mat dataset; // The reference set.
+ * arma::mat queries; // The query set.
+ *
+ * HNSWSearch<> hnsw(dataset, 16, 200);
+ * hnsw.Ef() = 100;
+ *
+ * arma::Mat<size_t> neighbors;
+ * arma::mat distances;
+ * hnsw.Search(queries, 10, neighbors, distances);
+ * @endcode
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ *     The graph construction heuristics are designed for nearest neighbor
+ *     search.
+ * @tparam DistanceType The distance metric to use.
+ * @tparam MatType Type of matrix to use to store the data.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename DistanceType = EuclideanDistance,
+         typename MatType = arma::mat>
+class HNSWSearch
+{
+ public:
+  //! The type of element held in MatType.
+  using ElemType = typename MatType::elem_type;
+
+  /**
+   * Build the HNSW graph on the given reference set.  In order to avoid
+   * copying the reference set, consider passing it with std::move().
+   *
+   * @param referenceSet Set of reference points.
+   * @param m Number of links each node keeps in each layer of the graph (the
+   *     bottom layer keeps 2 * m links).  Values between 8 and 48 are usually
+   *     reasonable; larger values are better for high-dimensional data.
+   * @param efConstruction Number of candidates considered when linking a new
+   *     node into the graph.  Larger values build a better graph, but more
+   *     slowly.
+   * @param ef Number of candidates considered during search.  Larger values
+   *     give better recall, but slower search.
+   * @param distance Instantiated distance metric.
+   */
+  HNSWSearch(MatType referenceSet,
+             const size_t m = 16,
+             const size_t efConstruction = 200,
+             const size_t ef = 50,
+             DistanceType distance = DistanceType());
+
+  /**
+   * Create an empty HNSW graph with the given parameters.  Use Train() or
+   * Insert() to add points to it.
+   *
+   * @param m Number of links each node keeps in each layer of the graph (the
+   *     bottom layer keeps 2 * m links).
+   * @param efConstruction Number of candidates considered when linking a new
+   *     node into the graph.
+   * @param ef Number of candidates considered during search.
+   * @param distance Instantiated distance metric.
+   */
+  HNSWSearch(const size_t m = 16,
+             const size_t efConstruction = 200,
+             const size_t ef = 50,
+             DistanceType distance = DistanceType());
+
+  /**
+   * Copy the given HNSW model.
+   *
+   * @param other HNSW model to copy.
+   */
+  HNSWSearch(const HNSWSearch& other);
+
+  /**
+   * Take ownership of the given HNSW model.
+   *
+   * @param other HNSW model to take ownership of.
+   */
+  HNSWSearch(HNSWSearch&& other);
+
+  /**
+   * Copy the given HNSW model.
+   *
+   * @param other HNSW model to copy.
+   */
+  HNSWSearch& operator=(const HNSWSearch& other);
+
+  /**
+   * Take ownership of the given HNSW model.
+   *
+   * @param other HNSW model to take ownership of.
+   */
+  HNSWSearch& operator=(HNSWSearch&& other);
+
+  /**
+   * Discard the current graph and build a new one on the given reference set.
+   * In order to avoid copying the reference set, consider passing it with
+   * std::move().
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * Insert the given points into the graph.  They are appended to the
+   * reference set, so the first new point has index `ReferenceSet().n_cols`
+   * (as it was before the call).
+   *
+   * @param points Points to insert (one per column).
+   */
+  void Insert(const MatType& points);
+
+  /**
+   * Compute the approximate nearest neighbors of each point in the query set.
+   * The results are stored in the same format as NeighborSearch::Search():
+   * column i of `neighbors` and `distances` holds the k neighbors of query
+   * point i, best first.  If fewer than k neighbors could be found, the
+   * remaining entries are set to `ReferenceSet().n_cols` and
+   * `SortPolicy::WorstDistance()`.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances) const;
+
+  /**
+   * Compute the approximate nearest neighbors of each point in the reference
+   * set.  A point is never returned as its own neighbor.
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each point.
+   * @param distances Matrix storing distances of neighbors for each point.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances) const;
+
+  //! Return the reference dataset.
+  const MatType& ReferenceSet() const { return referenceSet; }
+
+  //! Get the number of links per node in each layer.
+  size_t M() const { return m; }
+
+  //! Get the number of candidates considered during construction.
+  size_t EfConstruction() const { return efConstruction; }
+  //! Modify the number of candidates considered during construction.  This
+  //! only affects points inserted afterwards.
+  size_t& EfConstruction() { return efConstruction; }
+
+  //! Get the number of candidates considered during search.
+  size_t Ef() const { return ef; }
+  //! Modify the number of candidates considered during search.
+  size_t& Ef() { return ef; }
+
+  //! Get the index of the highest layer of the graph.
+  size_t MaxLevel() const { return maxLevel; }
+
+  //! Get the highest layer that the given point belongs to.
+  size_t Level(const size_t point) const { return graph[point].size() - 1; }
+
+  //! Get the links of the given point in the given layer.
+  const std::vector<size_t>& Links(const size_t point, const size_t level) const
+  { return graph[point][level]; }
+
+  //! Get the distance metric.
+  const DistanceType& Distance() const { return distance; }
+  //! Modify the distance metric.
+  DistanceType& Distance() { return distance; }
+
+  //! Serialize the HNSW model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Candidate represents a possible neighbor (distance, index).
+  using Candidate = std::pair<ElemType, size_t>;
+
+  //! Order candidates so that the best one is at the top of a priority queue.
+  struct BestOnTop
+  {
+    bool operator()(const Candidate& c1, const Candidate& c2) const
+    {
+      return SortPolicy::IsBetter(c2.first, c1.first);
+    }
+  };
+
+  //! Order candidates so that the worst one is at the top of a priority queue.
+  struct WorstOnTop
+  {
+    bool operator()(const Candidate& c1, const Candidate& c2) const
+    {
+      return SortPolicy::IsBetter(c1.first, c2.first);
+    }
+  };
+
+  /**
+   * Draw the levels of the points in [begin, referenceSet.n_cols), then link
+   * them into the graph.
+   */
+  void Build(const size_t begin);
+
+  //! Link the given point into the graph.
+  void InsertPoint(const size_t index);
+
+  /**
+   * Search one layer of the graph for the given query.  On input, `candidates`
+   * holds the entry points of the search; on output, it holds the best `ef`
+   * points found, best first.
+   *
+   * @param query Query point.
+   * @param candidates Entry points on input; results on output.
+   * @param ef Number of results to keep.
+   * @param level Layer of the graph to search.
+   * @param lock Whether the links of each node must be read under its lock
+   *     (that is, whether the graph may be modified concurrently).
+   */
+  template<typename VecType>
+  void SearchLayer(const VecType& query,
+                   std::vector<Candidate>& candidates,
+                   const size_t ef,
+                   const size_t level,
+                   const bool lock) const;
+
+  /**
+   * Find the best `ef` points for the given query, descending through every
+   * layer of the graph.  The results are returned best first.
+   */
+  template<typename VecType>
+  void SearchPoint(const VecType& query,
+                   const size_t ef,
+                   std::vector<Candidate>& results) const;
+
+  /**
+   * Choose at most `maxLinks` of the given candidates (sorted best first) to
+   * link to, with the neighbor selection heuristic of the HNSW paper: a
+   * candidate is skipped if it is closer to an already selected neighbor than
+   * to the point itself.  This keeps links pointing in diverse directions.
+   */
+  void SelectNeighbors(std::vector<Candidate>& candidates,
+                       const size_t maxLinks) const;
+
+  /**
+   * Add the given links to the given point in the given layer, and prune its
+   * links if it has too many.  The lock of the point must not be held.
+   */
+  void AddLinks(const size_t point,
+                const size_t level,
+                const std::vector<Candidate>& newLinks);
+
+  //! Reference dataset.
+  MatType referenceSet;
+
+  //! Number of links per node in each layer (2 * m in the bottom layer).
+  size_t m;
+
+  //! Number of candidates considered during construction.
+  size_t efConstruction;
+
+  //! Number of candidates considered during search.
+  size_t ef;
+
+  //! Instantiated distance metric.
+  DistanceType distance;
+
+  //! The links of each node: graph[i][l] holds the links of node i in layer l.
+  std::vector<std::vector<std::vector<size_t>>> graph;
+
+  //! The node that searches start from; it is in the highest layer.
+  size_t entryPoint;
+
+  //! The highest layer of the graph.
+  size_t maxLevel;
+
+  //! One lock per node, held while its links are read or modified during
+  //! construction.
+  mutable std::vector<std::mutex> nodeLocks;
+
+  //! Lock held while the entry point may be changed.
+  std::mutex entryLock;
+}; // class HNSWSearch
+
+} // namespace mlpack
+
+// Include implementation.
+#include "hnsw_search_impl.hpp"
+
+#endif
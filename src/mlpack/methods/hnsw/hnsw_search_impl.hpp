@@ -0,0 +1,518 @@
+/**
+ * @file methods/hnsw/hnsw_search_impl.hpp
+ *
+ * Implementation of the HNSWSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HNSW_HNSW_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_HNSW_HNSW_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hnsw_search.hpp"
+
+namespace mlpack {
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+HNSWSearch<SortPolicy, DistanceType, MatType>::HNSWSearch(
+    MatType referenceSetIn,
+    const size_t m,
+    const size_t efConstruction,
+    const size_t ef,
+    DistanceType distance) :
+    HNSWSearch(m, efConstruction, ef, std::move(distance))
+{
+  Train(std::move(referenceSetIn));
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+HNSWSearch<SortPolicy, DistanceType, MatType>::HNSWSearch(
+    const size_t m,
+    const size_t efConstruction,
+    const size_t ef,
+    DistanceType distance) :
+    m(m),
+    efConstruction(efConstruction),
+    ef(ef),
+    distance(std::move(distance)),
+    entryPoint(0),
+    maxLevel(0)
+{
+  if (m < 2)
+  {
+    throw std::invalid_argument("HNSWSearch::HNSWSearch(): the number of "
+        "links per node (m) must be at least 2!");
+  }
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+HNSWSearch<SortPolicy, DistanceType, MatType>::HNSWSearch(
+    const HNSWSearch& other) :
+    referenceSet(other.referenceSet),
+    m(other.m),
+    efConstruction(other.efConstruction),
+    ef(other.ef),
+    distance(other.distance),
+    graph(other.graph),
+    entryPoint(other.entryPoint),
+    maxLevel(other.maxLevel),
+    nodeLocks(other.graph.size())
+{
+  // Nothing to do.
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+HNSWSearch<SortPolicy, DistanceType, MatType>::HNSWSearch(
+    HNSWSearch&& other) :
+    referenceSet(std::move(other.referenceSet)),
+    m(other.m),
+    efConstruction(other.efConstruction),
+    ef(other.ef),
+    distance(std::move(other.distance)),
+    graph(std::move(other.graph)),
+    entryPoint(other.entryPoint),
+    maxLevel(other.maxLevel),
+    nodeLocks(graph.size())
+{
+  other.graph.clear();
+  other.entryPoint = 0;
+  other.maxLevel = 0;
+  std::vector<std::mutex>().swap(other.nodeLocks);
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+HNSWSearch<SortPolicy, DistanceType, MatType>&
+HNSWSearch<SortPolicy, DistanceType, MatType>::operator=(
+    const HNSWSearch& other)
+{
+  if (this != &other)
+  {
+    referenceSet = other.referenceSet;
+    m = other.m;
+    efConstruction = other.efConstruction;
+    ef = other.ef;
+    distance = other.distance;
+    graph = other.graph;
+    entryPoint = other.entryPoint;
+    maxLevel = other.maxLevel;
+    std::vector<std::mutex>(graph.size()).swap(nodeLocks);
+  }
+
+  return *this;
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+HNSWSearch<SortPolicy, DistanceType, MatType>&
+HNSWSearch<SortPolicy, DistanceType, MatType>::operator=(HNSWSearch&& other)
+{
+  if (this != &other)
+  {
+    referenceSet = std::move(other.referenceSet);
+    m = other.m;
+    efConstruction = other.efConstruction;
+    ef = other.ef;
+    distance = std::move(other.distance);
+    graph = std::move(other.graph);
+    entryPoint = other.entryPoint;
+    maxLevel = other.maxLevel;
+    std::vector<std::mutex>(graph.size()).swap(nodeLocks);
+
+    other.graph.clear();
+    other.entryPoint = 0;
+    other.maxLevel = 0;
+    std::vector<std::mutex>().swap(other.nodeLocks);
+  }
+
+  return *this;
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+void HNSWSearch<SortPolicy, DistanceType, MatType>::Train(
+    MatType referenceSetIn)
+{
+  referenceSet = std::move(referenceSetIn);
+  graph.clear();
+  entryPoint = 0;
+  maxLevel = 0;
+
+  Build(0);
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+void HNSWSearch<SortPolicy, DistanceType, MatType>::Insert(
+    const MatType& points)
+{
+  if (referenceSet.n_cols == 0)
+  {
+    Train(points);
+    return;
+  }
+
+  util::CheckSameDimensionality(points, referenceSet, "HNSWSearch::Insert()",
+      "points");
+
+  const size_t begin = referenceSet.n_cols;
+  referenceSet.insert_cols(begin, points);
+  Build(begin);
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+void HNSWSearch<SortPolicy, DistanceType, MatType>::Build(const size_t begin)
+{
+  const size_t numPoints = referenceSet.n_cols;
+  if (begin == numPoints)
+    return;
+
+  // Draw the level of each new point from an exponentially decaying
+  // distribution, normalized by ln(m) as suggested in the paper.  This is done
+  // before the parallel section so that the levels do not depend on the
+  // thread schedule.
+  const double levelMult = 1.0 / std::log((double) m);
+  graph.resize(numPoints);
+  for (size_t i = begin; i < numPoints; ++i)
+  {
+    const size_t level = (size_t) (-std::log(1.0 - Random()) * levelMult);
+    graph[i].resize(level + 1);
+  }
+
+  // The existing links are kept; only the locks are recreated.
+  std::vector<std::mutex>(numPoints).swap(nodeLocks);
+
+  // The first point of an empty graph is its entry point.
+  size_t first = begin;
+  if (begin == 0)
+  {
+    entryPoint = 0;
+    maxLevel = graph[0].size() - 1;
+    first = 1;
+  }
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = first; i < numPoints; ++i)
+    InsertPoint(i);
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+void HNSWSearch<SortPolicy, DistanceType, MatType>::InsertPoint(
+    const size_t index)
+{
+  const size_t level = graph[index].size() - 1;
+
+  // If this point becomes the new entry point, the entry lock is held for the
+  // whole insertion, so that no other point uses it as an entry point before
+  // it is linked.
+  std::unique_lock<std::mutex> entryGuard(entryLock);
+  const size_t currentEntryPoint = entryPoint;
+  const size_t currentMaxLevel = maxLevel;
+  if (level <= currentMaxLevel)
+    entryGuard.unlock();
+
+  const auto point = referenceSet.col(index);
+  std::vector<Candidate> candidates(1, Candidate(distance.Evaluate(point,
+      referenceSet.col(currentEntryPoint)), currentEntryPoint));
+
+  // Greedily descend through the layers above the point's level.
+  for (size_t l = currentMaxLevel; l > level; --l)
+    SearchLayer(point, candidates, 1, l, true);
+
+  // Link the point in each of its layers, from the top down.
+  for (size_t l = std::min(level, currentMaxLevel) + 1; l-- > 0; )
+  {
+    SearchLayer(point, candidates, efConstruction, l, true);
+
+    std::vector<Candidate> neighbors(candidates);
+    SelectNeighbors(neighbors, m);
+
+    AddLinks(index, l, neighbors);
+    for (size_t j = 0; j < neighbors.size(); ++j)
+    {
+      AddLinks(neighbors[j].second, l, std::vector<Candidate>(1,
+          Candidate(neighbors[j].first, index)));
+    }
+  }
+
+  if (level > currentMaxLevel)
+  {
+    entryPoint = index;
+    maxLevel = level;
+  }
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+template<typename VecType>
+void HNSWSearch<SortPolicy, DistanceType, MatType>::SearchLayer(
+    const VecType& query,
+    std::vector<Candidate>& candidates,
+    const size_t ef,
+    const size_t level,
+    const bool lock) const
+{
+  std::unordered_set<size_t> visited;
+  std::priority_queue<Candidate, std::vector<Candidate>, BestOnTop> toVisit;
+  std::priority_queue<Candidate, std::vector<Candidate>, WorstOnTop> results;
+  for (size_t i = 0; i < candidates.size(); ++i)
+  {
+    visited.insert(candidates[i].second);
+    toVisit.push(candidates[i]);
+    results.push(candidates[i]);
+    if (results.size() > ef)
+      results.pop();
+  }
+
+  std::vector<size_t> links;
+  while (!toVisit.empty())
+  {
+    const Candidate current = toVisit.top();
+
+    // Stop once the best unvisited candidate is worse than every result.
+    if (results.size() >= ef &&
+        SortPolicy::IsBetter(results.top().first, current.first))
+      break;
+    toVisit.pop();
+
+    if (lock)
+    {
+      std::lock_guard<std::mutex> guard(nodeLocks[current.second]);
+      links = graph[current.second][level];
+    }
+    else
+    {
+      links = graph[current.second][level];
+    }
+
+    for (size_t i = 0; i < links.size(); ++i)
+    {
+      if (!visited.insert(links[i]).second)
+        continue;
+
+      const ElemType d = distance.Evaluate(query, referenceSet.col(links[i]));
+      if (results.size() < ef || SortPolicy::IsBetter(d, results.top().first))
+      {
+        toVisit.push(Candidate(d, links[i]));
+        results.push(Candidate(d, links[i]));
+        if (results.size() > ef)
+          results.pop();
+      }
+    }
+  }
+
+  // Return the results best first.
+  candidates.resize(results.size());
+  for (size_t i = results.size(); i > 0; --i)
+  {
+    candidates[i - 1] = results.top();
+    results.pop();
+  }
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+template<typename VecType>
+void HNSWSearch<SortPolicy, DistanceType, MatType>::SearchPoint(
+    const VecType& query,
+    const size_t ef,
+    std::vector<Candidate>& results) const
+{
+  results.assign(1, Candidate(distance.Evaluate(query,
+      referenceSet.col(entryPoint)), entryPoint));
+
+  for (size_t l = maxLevel; l > 0; --l)
+    SearchLayer(query, results, 1, l, false);
+
+  SearchLayer(query, results, ef, 0, false);
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+void HNSWSearch<SortPolicy, DistanceType, MatType>::SelectNeighbors(
+    std::vector<Candidate>& candidates,
+    const size_t maxLinks) const
+{
+  if (candidates.size() <= maxLinks)
+    return;
+
+  std::vector<Candidate> selected;
+  selected.reserve(maxLinks);
+  for (size_t i = 0; i < candidates.size() && selected.size() < maxLinks; ++i)
+  {
+    const auto candidate = referenceSet.col(candidates[i].second);
+
+    bool keep = true;
+    for (size_t j = 0; j < selected.size(); ++j)
+    {
+      const ElemType d = distance.Evaluate(candidate,
+          referenceSet.col(selected[j].second));
+      if (SortPolicy::IsBetter(d, candidates[i].first))
+      {
+        keep = false;
+        break;
+      }
+    }
+
+    if (keep)
+      selected.push_back(candidates[i]);
+  }
+
+  candidates = std::move(selected);
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+void HNSWSearch<SortPolicy, DistanceType, MatType>::AddLinks(
+    const size_t point,
+    const size_t level,
+    const std::vector<Candidate>& newLinks)
+{
+  std::lock_guard<std::mutex> guard(nodeLocks[point]);
+  std::vector<size_t>& links = graph[point][level];
+
+  for (size_t i = 0; i < newLinks.size(); ++i)
+  {
+    if (newLinks[i].second != point && std::find(links.begin(), links.end(),
+        newLinks[i].second) == links.end())
+      links.push_back(newLinks[i].second);
+  }
+
+  // Prune the links with the same heuristic used to select them.
+  const size_t maxLinks = (level == 0) ? 2 * m : m;
+  if (links.size() > maxLinks)
+  {
+    const auto p = referenceSet.col(point);
+    std::vector<Candidate> candidates(links.size());
+    for (size_t i = 0; i < links.size(); ++i)
+    {
+      candidates[i] = Candidate(distance.Evaluate(p,
+          referenceSet.col(links[i])), links[i]);
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+        [](const Candidate& c1, const Candidate& c2)
+        {
+          return SortPolicy::IsBetter(c1.first, c2.first);
+        });
+    SelectNeighbors(candidates, maxLinks);
+
+    links.resize(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i)
+      links[i] = candidates[i].second;
+  }
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+void HNSWSearch<SortPolicy, DistanceType, MatType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& distances) const
+{
+  // Ensure the dimensionality of the query set is correct.
+  util::CheckSameDimensionality(querySet, referenceSet, "HNSWSearch::Search()",
+      "query set");
+
+  if (k > referenceSet.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "HNSWSearch::Search(): requested " << k << " approximate nearest "
+        << "neighbors, but reference set has " << referenceSet.n_cols
+        << " points!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  // If the user asked for 0 nearest neighbors... uh... we're done.
+  if (k == 0)
+    return;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+  {
+    std::vector<Candidate> results;
+    SearchPoint(querySet.col(i), std::max(ef, k), results);
+
+    for (size_t j = 0; j < k; ++j)
+    {
+      if (j < results.size())
+      {
+        neighbors(j, i) = results[j].second;
+        distances(j, i) = results[j].first;
+      }
+      else
+      {
+        neighbors(j, i) = referenceSet.n_cols;
+        distances(j, i) = SortPolicy::WorstDistance();
+      }
+    }
+  }
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+void HNSWSearch<SortPolicy, DistanceType, MatType>::Search(
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& distances) const
+{
+  if (k >= referenceSet.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "HNSWSearch::Search(): requested " << k << " approximate nearest "
+        << "neighbors, but reference set has only " << referenceSet.n_cols
+        << " points (a point is not its own neighbor)!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  neighbors.set_size(k, referenceSet.n_cols);
+  distances.set_size(k, referenceSet.n_cols);
+
+  if (k == 0)
+    return;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < (size_t) referenceSet.n_cols; ++i)
+  {
+    // Search for one extra point, since the point itself will be found.
+    std::vector<Candidate> results;
+    SearchPoint(referenceSet.col(i), std::max(ef, k + 1), results);
+
+    size_t j = 0;
+    for (size_t r = 0; r < results.size() && j < k; ++r)
+    {
+      if (results[r].second == i)
+        continue;
+
+      neighbors(j, i) = results[r].second;
+      distances(j, i) = results[r].first;
+      ++j;
+    }
+
+    for (; j < k; ++j)
+    {
+      neighbors(j, i) = referenceSet.n_cols;
+      distances(j, i) = SortPolicy::WorstDistance();
+    }
+  }
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+template<typename Archive>
+void HNSWSearch<SortPolicy, DistanceType, MatType>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(referenceSet));
+  ar(CEREAL_NVP(m));
+  ar(CEREAL_NVP(efConstruction));
+  ar(CEREAL_NVP(ef));
+  ar(CEREAL_NVP(distance));
+  ar(CEREAL_NVP(graph));
+  ar(CEREAL_NVP(entryPoint));
+  ar(CEREAL_NVP(maxLevel));
+
+  if (cereal::is_loading<Archive>())
+    std::vector<std::mutex>(graph.size()).swap(nodeLocks);
+}
+
+} // namespace mlpack
+
+#endif
@@ -72,6 +72,11 @@ class HoeffdingTree
   //! Allow access to the categorical split type.
   using CategoricalSplit = CategoricalSplitType<FitnessFunction>;
 
+  //! The number of observations (points times dimensions) a leaf must receive
+  //! at once before its split statistics are trained in parallel; this is also
+  //! the number of points above which batch classification is parallel.
+  static const size_t ParallelMinObservations = 4096;
+
   /**
    * Construct a Hoeffding tree with no data and no information.  Be sure to
    * call Train() before trying to use the tree.
@@ -558,6 +563,20 @@ class HoeffdingTree
                      const arma::Row<size_t>& labels,
                      const bool batchTraining);
 
+  /**
+   * Train on the given points of the dataset, in order, as in streaming mode.
+   * The observations a leaf receives between two split checks are added to the
+   * split statistics of all dimensions in parallel.
+   *
+   * @param data Dataset.
+   * @param labels Labels of all points in the dataset.
+   * @param points Indices of the points to train on, in order.
+   */
+  template<typename MatType>
+  void TrainPoints(const MatType& data,
+                   const arma::Row<size_t>& labels,
+                   const arma::uvec& points);
+
   /**
    * Reset the tree.  This assumes datasetInfo is set correctly.
    */
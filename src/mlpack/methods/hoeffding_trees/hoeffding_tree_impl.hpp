@@ -898,7 +898,10 @@ void HoeffdingTree<
     CategoricalSplitType
 >::Classify(const MatType& data, arma::Row<size_t>& predictions) const
 {
+  // Each point descends the tree independently.
   predictions.set_size(data.n_cols);
+  #pragma omp parallel for schedule(static) \
+      if (data.n_cols >= ParallelMinObservations)
   for (size_t i = 0; i < data.n_cols; ++i)
     predictions[i] = Classify(data.col(i));
 }
@@ -920,6 +923,8 @@ void HoeffdingTree<
 {
   predictions.set_size(data.n_cols);
   probabilities.set_size(data.n_cols);
+  #pragma omp parallel for schedule(static) \
+      if (data.n_cols >= ParallelMinObservations)
   for (size_t i = 0; i < data.n_cols; ++i)
     Classify(data.col(i), predictions[i], probabilities[i]);
 }
@@ -1187,8 +1192,8 @@ void HoeffdingTree<
     // Don't split if there are fewer than five points.
     size_t oldMaxSamples = maxSamples;
     maxSamples = std::max(size_t(data.n_cols - 1), size_t(5));
-    for (size_t i = 0; i < data.n_cols; ++i)
-      Train(data.col(i), labels[i]);
+    if (data.n_cols > 0)
+      TrainPoints(data, labels, arma::regspace<arma::uvec>(0, data.n_cols - 1));
     maxSamples = oldMaxSamples;
 
     // Now, if we did split, find out which points go to which child, and
@@ -1250,9 +1255,106 @@ void HoeffdingTree<
   }
   else
   {
-    // We aren't training in batch mode; loop through the points.
-    for (size_t i = 0; i < data.n_cols; ++i)
-      Train(data.col(i), labels[i]);
+    // We aren't training in batch mode; stream the points in order.
+    if (data.n_cols > 0)
+      TrainPoints(data, labels, arma::regspace<arma::uvec>(0, data.n_cols - 1));
+  }
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainPoints(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const arma::uvec& points)
+{
+  // This gives the same tree as calling Train() on each point in order, but
+  // the points that a leaf sees between two split checks are given to the
+  // statistics of each dimension at once, and the dimensions are trained in
+  // parallel.  The statistics of a dimension are only touched by one thread.
+  size_t start = 0;
+  const size_t numDimensions = numericSplits.size() + categoricalSplits.size();
+  while (splitDimension == size_t(-1) && start < points.n_elem)
+  {
+    // Stop at the next split check.
+    const size_t end = std::min((size_t) points.n_elem,
+        start + checkInterval - (numSamples % checkInterval));
+    const size_t numObservations = (end - start) * numDimensions;
+
+    #pragma omp parallel for schedule(dynamic) \
+        if (numObservations >= ParallelMinObservations)
+    for (size_t d = 0; d < numDimensions; ++d)
+    {
+      const std::pair<size_t, size_t>& mapping = dimensionMappings->at(d);
+      if (mapping.first == data::Datatype::categorical)
+      {
+        CategoricalSplitType<FitnessFunction>& split =
+            categoricalSplits[mapping.second];
+        for (size_t i = start; i < end; ++i)
+          split.Train(data(d, points[i]), labels[points[i]]);
+      }
+      else if (mapping.first == data::Datatype::numeric)
+      {
+        NumericSplitType<FitnessFunction>& split =
+            numericSplits[mapping.second];
+        for (size_t i = start; i < end; ++i)
+          split.Train(data(d, points[i]), labels[points[i]]);
+      }
+    }
+
+    numSamples += (end - start);
+    start = end;
+
+    // Grab majority class from splits.
+    if (categoricalSplits.size() > 0)
+    {
+      majorityClass = categoricalSplits[0].MajorityClass();
+      majorityProbability = categoricalSplits[0].MajorityProbability();
+    }
+    else
+    {
+      majorityClass = numericSplits[0].MajorityClass();
+      majorityProbability = numericSplits[0].MajorityProbability();
+    }
+
+    // Check for a split, if we should.
+    if (numSamples % checkInterval == 0 && SplitCheck() > 0)
+    {
+      children.clear();
+      CreateChildren();
+    }
+  }
+
+  if (start == points.n_elem)
+    return;
+
+  // This node has split; pass the remaining points to the children, in order.
+  arma::Col<size_t> directions(points.n_elem - start);
+  #pragma omp parallel for schedule(static) \
+      if (directions.n_elem >= ParallelMinObservations)
+  for (size_t i = 0; i < directions.n_elem; ++i)
+    directions[i] = CalculateDirection(data.col(points[start + i]));
+
+  std::vector<arma::uvec> childPoints(children.size(),
+      arma::uvec(directions.n_elem));
+  arma::Col<size_t> counts = zeros<arma::Col<size_t>>(children.size());
+  for (size_t i = 0; i < directions.n_elem; ++i)
+    childPoints[directions[i]][counts[directions[i]]++] = points[start + i];
+
+  for (size_t i = 0; i < children.size(); ++i)
+  {
+    if (counts[i] > 0)
+    {
+      children[i]->TrainPoints(data, labels,
+          childPoints[i].subvec(0, counts[i] - 1));
+    }
   }
 }
 
@@ -0,0 +1,17 @@
+/**
+ * @file methods/inverted_index/inverted_index.hpp
+ *
+ * Convenience include for the inverted index.  This exists for the include
+ * convention of `module_name/module_name.hpp`.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_INVERTED_INDEX_INVERTED_INDEX_HPP
+#define MLPACK_METHODS_INVERTED_INDEX_INVERTED_INDEX_HPP
+
+#include "inverted_index_search.hpp"
+
+#endif
@@ -0,0 +1,183 @@
+/**
+ * @file methods/inverted_index/inverted_index_search.hpp
+ *
+ * Defines the InvertedIndexSearch class, which performs exact cosine or
+ * inner-product similarity search on sparse vectors with an inverted index
+ * and the WAND traversal of its posting lists.
+ *
+ * The WAND traversal is described in the following paper:
+ *
+ * @code
+ * @inproceedings{broder2003efficient,
+ *   title={Efficient query evaluation using a two-level retrieval process},
+ *   author={Broder, Andrei Z. and Carmel, David and Herscovici, Michael and
+ *       Soffer, Aya and Zien, Jason},
+ *   booktitle={Proceedings of the 12th International Conference on
+ *       Information and Knowledge Management (CIKM '03)},
+ *   pages={426--434},
+ *   year={2003}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_INVERTED_INDEX_INVERTED_INDEX_SEARCH_HPP
+#define MLPACK_METHODS_INVERTED_INDEX_INVERTED_INDEX_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * The InvertedIndexSearch class finds the k reference points with the largest
+ * cosine similarity (or inner product) to each query point, for sparse data
+ * such as TF-IDF vectors of documents.  Trees are of no use for such data: the
+ * bounds of a node over millions of sparse dimensions prune almost nothing.
+ * Instead, the reference set is stored as an inverted index, with one posting
+ * list per dimension (the reference points that are nonzero in it, in order)
+ * and the largest and smallest value of each list.
+ *
+ * A query only visits the posting lists of its nonzero dimensions.  They are
+ * traversed together in order of reference point, with the WAND algorithm:
+ * the sum of the bounds of the lists gives an upper bound on the similarity of
+ * the next reference points, and the lists skip over the points whose bound is
+ * not better than the k-th best similarity found so far.  The results are
+ * exact.
+ *
+ * With cosine similarity, the reference points and the queries are normalized
+ * to unit length (the similarities are then the inner products of the
+ * normalized points).  Reference points that share no nonzero dimension with
+ * a query have similarity 0, and are returned if fewer than k reference points
+ * have a positive similarity.
+ *
+ * @code
+ * arma::sp_mat documents; // TF-IDF vectors, one per column.
+ * arma::sp_mat queries;
+ *
+ * InvertedIndexSearch<> index(documents);
+ * arma::Mat<size_t> neighbors;
+ * arma::mat similarities;
+ * index.Search(queries, 10, neighbors, similarities);
+ * @endcode
+ *
+ * @tparam MatType Type of sparse matrix to use to store the data.
+ */
+template<typename MatType = arma::sp_mat>
+class InvertedIndexSearch
+{
+ public:
+  //! The type of element held in MatType.
+  using ElemType = typename MatType::elem_type;
+
+  /**
+   * Build the inverted index on the given reference set.  In order to avoid
+   * copying the reference set, consider passing it with std::move().
+   *
+   * @param referenceSet Set of reference points.
+   * @param cosine If true, search by cosine similarity; otherwise by inner
+   *     product.
+   */
+  InvertedIndexSearch(MatType referenceSet, const bool cosine = true);
+
+  /**
+   * Create an empty index.  Use Train() to build it.
+   *
+   * @param cosine If true, search by cosine similarity; otherwise by inner
+   *     product.
+   */
+  InvertedIndexSearch(const bool cosine = true);
+
+  /**
+   * Discard the current index and build a new one on the given reference set.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * Find the k reference points with the largest similarity to each point of
+   * the query set.  Column i of `neighbors` and `similarities` holds the
+   * results of query point i, best first.  A std::invalid_argument is thrown
+   * if k is larger than the number of reference points, or if the
+   * dimensionality of the query set does not match.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param similarities Matrix storing the similarities of the neighbors of
+   *     each query point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& similarities) const;
+
+  /**
+   * Find the k reference points with the largest similarity to each point of
+   * the reference set.  A point is never returned as its own neighbor.
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each point.
+   * @param similarities Matrix storing the similarities of the neighbors of
+   *     each point.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& similarities) const;
+
+  //! Get whether the similarity is the cosine similarity.
+  bool Cosine() const { return cosine; }
+
+  //! Get the number of reference points.
+  size_t NumReferences() const { return postings.n_rows; }
+  //! Get the dimensionality of the reference points.
+  size_t Dimensionality() const { return postings.n_cols; }
+
+  //! Get the posting lists: column d holds the (normalized, if the similarity
+  //! is the cosine similarity) values of the reference points in dimension d.
+  const MatType& Postings() const { return postings; }
+
+  //! Get the number of similarities computed by the last call to Search().
+  size_t Evaluations() const { return evaluations; }
+
+  //! Serialize the index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Find the k best reference points for the query in the given column of
+   * `queries`, skipping the reference point `self` (if it is a valid index),
+   * and store them in the given column of `neighbors` and `similarities`.
+   * Returns the number of similarities computed.
+   */
+  size_t SearchPoint(const MatType& queries,
+                     const size_t query,
+                     const size_t k,
+                     const size_t self,
+                     arma::Mat<size_t>& neighbors,
+                     arma::Mat<ElemType>& similarities) const;
+
+  //! The transposed (and possibly normalized) reference set: one row per
+  //! reference point, and one column (posting list) per dimension.
+  MatType postings;
+  //! The largest value of each posting list.
+  arma::Col<ElemType> maxValues;
+  //! The smallest value of each posting list.
+  arma::Col<ElemType> minValues;
+  //! Whether the similarity is the cosine similarity.
+  bool cosine;
+
+  //! Number of similarities computed by the last call to Search().
+  mutable size_t evaluations;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "inverted_index_search_impl.hpp"
+
+#endif
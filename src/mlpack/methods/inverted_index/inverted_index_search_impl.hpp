@@ -0,0 +1,324 @@
+/**
+ * @file methods/inverted_index/inverted_index_search_impl.hpp
+ *
+ * Implementation of the InvertedIndexSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_INVERTED_INDEX_INVERTED_INDEX_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_INVERTED_INDEX_INVERTED_INDEX_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "inverted_index_search.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+InvertedIndexSearch<MatType>::InvertedIndexSearch(MatType referenceSet,
+                                                  const bool cosine) :
+    cosine(cosine),
+    evaluations(0)
+{
+  Train(std::move(referenceSet));
+}
+
+template<typename MatType>
+InvertedIndexSearch<MatType>::InvertedIndexSearch(const bool cosine) :
+    cosine(cosine),
+    evaluations(0)
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+void InvertedIndexSearch<MatType>::Train(MatType referenceSet)
+{
+  if (cosine)
+    referenceSet = arma::normalise(referenceSet, 2, 0);
+
+  // Column d of the transposed reference set lists the reference points that
+  // are nonzero in dimension d, in order.
+  postings = referenceSet.t();
+  postings.sync();
+
+  // The bounds include 0, which does not change the bound on the similarity
+  // of a point (that is clamped at 0, since a point may not be in a list).
+  maxValues.zeros(postings.n_cols);
+  minValues.zeros(postings.n_cols);
+  for (size_t d = 0; d < postings.n_cols; ++d)
+  {
+    for (size_t i = postings.col_ptrs[d]; i < postings.col_ptrs[d + 1]; ++i)
+    {
+      maxValues[d] = std::max(maxValues[d], postings.values[i]);
+      minValues[d] = std::min(minValues[d], postings.values[i]);
+    }
+  }
+
+  evaluations = 0;
+}
+
+template<typename MatType>
+void InvertedIndexSearch<MatType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& similarities) const
+{
+  if (k > NumReferences())
+  {
+    std::ostringstream oss;
+    oss << "InvertedIndexSearch::Search(): requested " << k << " neighbors, "
+        << "but reference set has " << NumReferences() << " points!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  util::CheckSameDimensionality(querySet, Dimensionality(),
+      "InvertedIndexSearch::Search()", "query set");
+
+  neighbors.set_size(k, querySet.n_cols);
+  similarities.set_size(k, querySet.n_cols);
+
+  // Make sure the compressed representation is up to date before the threads
+  // read it.
+  querySet.sync();
+
+  size_t totalEvaluations = 0;
+  #pragma omp parallel for schedule(dynamic) reduction(+:totalEvaluations)
+  for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+  {
+    totalEvaluations += SearchPoint(querySet, i, k, size_t(-1), neighbors,
+        similarities);
+  }
+
+  evaluations = totalEvaluations;
+}
+
+template<typename MatType>
+void InvertedIndexSearch<MatType>::Search(
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& similarities) const
+{
+  if (k >= NumReferences())
+  {
+    std::ostringstream oss;
+    oss << "InvertedIndexSearch::Search(): requested " << k << " neighbors, "
+        << "but reference set has " << NumReferences() << " points (and a "
+        << "point is not its own neighbor)!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The queries are the (normalized) reference points.
+  const MatType queries = postings.t();
+  queries.sync();
+
+  neighbors.set_size(k, queries.n_cols);
+  similarities.set_size(k, queries.n_cols);
+
+  size_t totalEvaluations = 0;
+  #pragma omp parallel for schedule(dynamic) reduction(+:totalEvaluations)
+  for (size_t i = 0; i < (size_t) queries.n_cols; ++i)
+  {
+    totalEvaluations += SearchPoint(queries, i, k, i, neighbors,
+        similarities);
+  }
+
+  evaluations = totalEvaluations;
+}
+
+template<typename MatType>
+size_t InvertedIndexSearch<MatType>::SearchPoint(
+    const MatType& queries,
+    const size_t query,
+    const size_t k,
+    const size_t self,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& similarities) const
+{
+  // Candidate represents a possible neighbor (similarity, index).
+  using Candidate = std::pair<double, size_t>;
+
+  // A cursor walks through the posting list of one dimension of the query.
+  struct Cursor
+  {
+    //! Current position in the values of the posting lists.
+    size_t pos;
+    //! End of the posting list.
+    size_t end;
+    //! Value of the query in this dimension.
+    double weight;
+    //! Upper bound on the contribution of this dimension to a similarity.
+    double bound;
+  };
+
+  const arma::uword* points = postings.row_indices;
+  const ElemType* values = postings.values;
+
+  // Ties are broken by index, so that the results do not depend on the order
+  // in which points are found.
+  auto better = [](const Candidate& a, const Candidate& b)
+  {
+    return (a.first > b.first) || (a.first == b.first && a.second < b.second);
+  };
+  auto byPoint = [points](const Cursor& a, const Cursor& b)
+  {
+    return points[a.pos] < points[b.pos];
+  };
+
+  double queryNorm = 1.0;
+  if (cosine)
+  {
+    double squaredNorm = 0.0;
+    for (auto it = queries.begin_col(query); it != queries.end_col(query); ++it)
+      squaredNorm += double(*it) * double(*it);
+    queryNorm = (squaredNorm > 0.0) ? std::sqrt(squaredNorm) : 1.0;
+  }
+
+  std::vector<Cursor> cursors;
+  for (auto it = queries.begin_col(query); it != queries.end_col(query); ++it)
+  {
+    const size_t d = it.row();
+    if (postings.col_ptrs[d] == postings.col_ptrs[d + 1])
+      continue;
+
+    const double weight = double(*it) / queryNorm;
+    const double bound = (weight > 0.0) ? weight * maxValues[d] :
+        weight * minValues[d];
+    cursors.push_back({ (size_t) postings.col_ptrs[d],
+        (size_t) postings.col_ptrs[d + 1], weight, std::max(0.0, bound) });
+  }
+  std::sort(cursors.begin(), cursors.end(), byPoint);
+
+  // The heap holds the best k candidates so far, with the worst on top.
+  std::vector<Candidate> heap;
+  heap.reserve(k);
+  double threshold = -std::numeric_limits<double>::infinity();
+  // The points whose similarity was computed, in order.
+  std::vector<size_t> evaluated;
+
+  while (!cursors.empty())
+  {
+    // The pivot is the first cursor at which the sum of the bounds of the
+    // cursors so far exceeds the threshold.  No point before the point of the
+    // pivot can beat the threshold, since it only appears in the lists before
+    // the pivot.
+    double bound = 0.0;
+    size_t pivot = cursors.size();
+    for (size_t i = 0; i < cursors.size(); ++i)
+    {
+      bound += cursors[i].bound;
+      if (bound > threshold)
+      {
+        pivot = i;
+        break;
+      }
+    }
+
+    if (pivot == cursors.size())
+      break; // No remaining point can beat the threshold.
+
+    const size_t pivotPoint = points[cursors[pivot].pos];
+    if (points[cursors[0].pos] == pivotPoint)
+    {
+      // All the cursors up to the pivot are at the pivot point, so compute
+      // its similarity.
+      double similarity = 0.0;
+      for (size_t i = 0; i < cursors.size() &&
+          points[cursors[i].pos] == pivotPoint; ++i)
+      {
+        similarity += cursors[i].weight * values[cursors[i].pos];
+        ++cursors[i].pos;
+      }
+
+      if (pivotPoint != self)
+      {
+        evaluated.push_back(pivotPoint);
+        const Candidate c(similarity, pivotPoint);
+        if (heap.size() < k)
+        {
+          heap.push_back(c);
+          std::push_heap(heap.begin(), heap.end(), better);
+        }
+        else if (better(c, heap.front()))
+        {
+          std::pop_heap(heap.begin(), heap.end(), better);
+          heap.back() = c;
+          std::push_heap(heap.begin(), heap.end(), better);
+        }
+
+        if (heap.size() == k)
+          threshold = heap.front().first;
+      }
+    }
+    else
+    {
+      // Skip the cursors before the pivot to the pivot point.
+      for (size_t i = 0; i < pivot; ++i)
+      {
+        cursors[i].pos = std::lower_bound(points + cursors[i].pos,
+            points + cursors[i].end, (arma::uword) pivotPoint) - points;
+      }
+    }
+
+    cursors.erase(std::remove_if(cursors.begin(), cursors.end(),
+        [](const Cursor& c) { return c.pos == c.end; }), cursors.end());
+    std::sort(cursors.begin(), cursors.end(), byPoint);
+  }
+
+  std::sort(heap.begin(), heap.end(), better);
+
+  // Points that share no dimension with the query have similarity 0.  They
+  // are only needed if fewer than k points were found, or if some of the
+  // results are negative; in both cases the threshold never exceeded 0, so
+  // nothing was skipped and all the other points were evaluated.
+  std::vector<Candidate> results;
+  if (heap.size() < k || threshold < 0.0)
+  {
+    std::vector<Candidate> zeros;
+    size_t e = 0;
+    for (size_t p = 0; p < NumReferences() && zeros.size() < k; ++p)
+    {
+      if (e < evaluated.size() && evaluated[e] == p)
+        ++e;
+      else if (p != self)
+        zeros.push_back(Candidate(0.0, p));
+    }
+
+    std::merge(heap.begin(), heap.end(), zeros.begin(), zeros.end(),
+        std::back_inserter(results), better);
+    results.resize(k);
+  }
+  else
+  {
+    results = std::move(heap);
+  }
+
+  for (size_t i = 0; i < k; ++i)
+  {
+    neighbors(i, query) = results[i].second;
+    similarities(i, query) = ElemType(results[i].first);
+  }
+
+  return evaluated.size();
+}
+
+template<typename MatType>
+template<typename Archive>
+void InvertedIndexSearch<MatType>::serialize(Archive& ar,
+                                             const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(cosine));
+  ar(CEREAL_NVP(postings));
+  ar(CEREAL_NVP(maxValues));
+  ar(CEREAL_NVP(minValues));
+
+  if (cereal::is_loading<Archive>())
+    evaluations = 0;
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,274 @@
+/**
+ * @file methods/ivf_pq/ivf_pq_search.hpp
+ *
+ * Defines the IVFPQSearch class, an inverted file index with product-quantized
+ * residuals for approximate nearest neighbor search in large datasets.
+ *
+ * The details of this method can be found in the following paper:
+ *
+ * @code
+ * @article{jegou2011product,
+ *   title={Product quantization for nearest neighbor search},
+ *   author={J{\'e}gou, Herv{\'e} and Douze, Matthijs and Schmid, Cordelia},
+ *   journal={IEEE Transactions on Pattern Analysis and Machine Intelligence},
+ *   volume={33},
+ *   number={1},
+ *   pages={117--128},
+ *   year={2011},
+ *   publisher={IEEE}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_HPP
+#define MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+
+#include <mlpack/methods/kmeans/kmeans.hpp>
+
+namespace mlpack {
+
+/**
+ * The IVFPQSearch class is an inverted file index with product-quantized
+ * residuals (IVF-PQ) for approximate Euclidean nearest neighbor search.
+ * Instead of the points themselves, it stores a short code for each point, so
+ * that very large reference sets fit in memory:
+ *
+ *  - A coarse quantizer, trained with KMeans, splits the space into
+ *    `numLists` cells.  Each point is stored in the inverted list of its
+ *    nearest coarse centroid.
+ *  - The residual of each point (its offset from its coarse centroid) is split
+ *    into `numSubspaces` subvectors, and each subvector is replaced by the
+ *    index of its nearest codeword in a small per-subspace codebook (of at most
+ *    256 codewords, also trained with KMeans).  A point is thus stored as
+ *    `numSubspaces` bytes plus its index.
+ *
+ * A search only scans the `numProbes` inverted lists whose coarse centroids
+ * are nearest to the query.  Distances to the codes are computed
+ * asymmetrically: for each scanned list, a lookup table of the squared
+ * distances between the query's residual and every codeword of every subspace
+ * is computed once, and the distance to a code is then the sum of
+ * `numSubspaces` table entries.
+ *
+ * If the reference set is kept (see `keepReferenceSet`), the best `Rerank()`
+ * candidates found with the codes can be re-ranked with their exact distances.
+ *
+ * @code
+ * arma::mat dataset; // The reference set.
+ * arma::mat queries; // The query set.
+ *
+ * // 1024 lists, 16 subspaces of 256 codewords: 16 bytes per point.
+ * IVFPQSearch<> ivfpq(dataset, 1024, 16);
+ * ivfpq.NumProbes() = 8;
+ *
+ * arma::Mat<size_t> neighbors;
+ * arma::mat distances;
+ * ivfpq.Search(queries, 10, neighbors, distances);
+ * @endcode
+ *
+ * @tparam MatType Type of matrix to use to store the data.
+ */
+template<typename MatType = arma::mat>
+class IVFPQSearch
+{
+ public:
+  //! The type of element held in MatType.
+  using ElemType = typename MatType::elem_type;
+
+  /**
+   * Train the quantizers on the given reference set, and add every point of it
+   * to the index.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numLists Number of coarse centroids (inverted lists).
+   * @param numSubspaces Number of subvectors each residual is split into; this
+   *     is the number of bytes used per point, and it must divide the
+   *     dimensionality of the data.
+   * @param numCodewords Number of codewords of each subspace codebook (at most
+   *     256).
+   * @param numProbes Number of inverted lists scanned for each query.
+   * @param keepReferenceSet If true, the full-precision reference set is kept,
+   *     so that candidates can be re-ranked with their exact distances.
+   * @param maxIterations Maximum number of iterations of each k-means run.
+   */
+  IVFPQSearch(const MatType& referenceSet,
+              const size_t numLists,
+              const size_t numSubspaces,
+              const size_t numCodewords = 256,
+              const size_t numProbes = 1,
+              const bool keepReferenceSet = false,
+              const size_t maxIterations = 100);
+
+  /**
+   * Create an untrained index with the given parameters.  Call Train() and
+   * Add() before calling Search().
+   *
+   * @param numLists Number of coarse centroids (inverted lists).
+   * @param numSubspaces Number of subvectors each residual is split into.
+   * @param numCodewords Number of codewords of each subspace codebook (at most
+   *     256).
+   * @param numProbes Number of inverted lists scanned for each query.
+   * @param keepReferenceSet If true, the full-precision points are kept.
+   * @param maxIterations Maximum number of iterations of each k-means run.
+   */
+  IVFPQSearch(const size_t numLists = 1024,
+              const size_t numSubspaces = 8,
+              const size_t numCodewords = 256,
+              const size_t numProbes = 1,
+              const bool keepReferenceSet = false,
+              const size_t maxIterations = 100);
+
+  /**
+   * Train the coarse quantizer and the subspace codebooks on the given
+   * training set.  This removes every point from the index; use Add() to add
+   * points afterwards.  The training set may be a sample of the points that
+   * will be added.
+   *
+   * @param trainingSet Set of points to train the quantizers on.
+   */
+  void Train(const MatType& trainingSet);
+
+  /**
+   * Encode the given points and add them to the index.  The indices of the new
+   * points start at `NumPoints()` (as it was before the call).
+   *
+   * @param points Points to add (one per column).
+   */
+  void Add(const MatType& points);
+
+  /**
+   * Compute the approximate nearest neighbors of each point in the query set.
+   * The results are stored in the same format as NeighborSearch::Search():
+   * column i of `neighbors` and `distances` holds the k neighbors of query
+   * point i, nearest first.  If the scanned lists hold fewer than k points, the
+   * remaining entries are set to `NumPoints()` and DBL_MAX.
+   *
+   * The distances are the exact distances for the re-ranked candidates, and
+   * the distances to the quantized points otherwise.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances) const;
+
+  //! Get the number of points in the index.
+  size_t NumPoints() const { return numPoints; }
+
+  //! Get the number of inverted lists.
+  size_t NumLists() const { return numLists; }
+  //! Get the number of subspaces.
+  size_t NumSubspaces() const { return numSubspaces; }
+  //! Get the number of codewords of each subspace codebook.
+  size_t NumCodewords() const { return numCodewords; }
+
+  //! Get the number of inverted lists scanned for each query.
+  size_t NumProbes() const { return numProbes; }
+  //! Modify the number of inverted lists scanned for each query.
+  size_t& NumProbes() { return numProbes; }
+
+  //! Get the number of candidates re-ranked with their exact distances (0
+  //! means no re-ranking).
+  size_t Rerank() const { return rerank; }
+  //! Modify the number of candidates re-ranked with their exact distances.
+  //! Re-ranking requires the reference set to be kept.
+  size_t& Rerank() { return rerank; }
+
+  //! Get whether the full-precision points are kept.
+  bool KeepReferenceSet() const { return keepReferenceSet; }
+
+  //! Get the maximum number of k-means iterations.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of k-means iterations.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the coarse centroids (one per column).
+  const MatType& Centroids() const { return centroids; }
+
+  //! Get the subspace codebooks.  Column j holds codeword j of every subspace;
+  //! the rows of subspace m are [m * d / numSubspaces, (m + 1) * d /
+  //! numSubspaces).
+  const MatType& Codebooks() const { return codebooks; }
+
+  //! Get the indices of the points in the given inverted list.
+  const arma::Col<size_t>& ListIndices(const size_t list) const
+  { return listIndices[list]; }
+  //! Get the codes of the points in the given inverted list (one per column).
+  const arma::Mat<arma::u8>& ListCodes(const size_t list) const
+  { return listCodes[list]; }
+
+  //! Get the full-precision reference set (empty unless it is kept).
+  const MatType& ReferenceSet() const { return referenceSet; }
+
+  //! Serialize the index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Candidate represents a possible neighbor (distance, index).
+  using Candidate = std::pair<ElemType, size_t>;
+
+  //! Compute the index of the nearest coarse centroid of the given point.
+  template<typename VecType>
+  size_t NearestList(const VecType& point) const;
+
+  //! Encode the residual of the given point with respect to the given list.
+  template<typename VecType>
+  void Encode(const VecType& point, const size_t list, arma::u8* code) const;
+
+  //! Number of coarse centroids (inverted lists).
+  size_t numLists;
+
+  //! Number of subspaces.
+  size_t numSubspaces;
+
+  //! Number of codewords of each subspace codebook.
+  size_t numCodewords;
+
+  //! Number of inverted lists scanned for each query.
+  size_t numProbes;
+
+  //! Number of candidates re-ranked with their exact distances.
+  size_t rerank;
+
+  //! Whether the full-precision points are kept.
+  bool keepReferenceSet;
+
+  //! Maximum number of iterations of each k-means run.
+  size_t maxIterations;
+
+  //! Number of points in the index.
+  size_t numPoints;
+
+  //! The coarse centroids.
+  MatType centroids;
+
+  //! The subspace codebooks.
+  MatType codebooks;
+
+  //! The indices of the points in each inverted list.
+  std::vector<arma::Col<size_t>> listIndices;
+
+  //! The codes of the points in each inverted list.
+  std::vector<arma::Mat<arma::u8>> listCodes;
+
+  //! The full-precision points, if they are kept.
+  MatType referenceSet;
+}; // class IVFPQSearch
+
+} // namespace mlpack
+
+// Include implementation.
+#include "ivf_pq_search_impl.hpp"
+
+#endif
@@ -0,0 +1,399 @@
+/**
+ * @file methods/ivf_pq/ivf_pq_search_impl.hpp
+ *
+ * Implementation of the IVFPQSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "ivf_pq_search.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+IVFPQSearch<MatType>::IVFPQSearch(const MatType& referenceSetIn,
+                                  const size_t numLists,
+                                  const size_t numSubspaces,
+                                  const size_t numCodewords,
+                                  const size_t numProbes,
+                                  const bool keepReferenceSet,
+                                  const size_t maxIterations) :
+    IVFPQSearch(numLists, numSubspaces, numCodewords, numProbes,
+        keepReferenceSet, maxIterations)
+{
+  Train(referenceSetIn);
+  Add(referenceSetIn);
+}
+
+template<typename MatType>
+IVFPQSearch<MatType>::IVFPQSearch(const size_t numLists,
+                                  const size_t numSubspaces,
+                                  const size_t numCodewords,
+                                  const size_t numProbes,
+                                  const bool keepReferenceSet,
+                                  const size_t maxIterations) :
+    numLists(numLists),
+    numSubspaces(numSubspaces),
+    numCodewords(numCodewords),
+    numProbes(numProbes),
+    rerank(0),
+    keepReferenceSet(keepReferenceSet),
+    maxIterations(maxIterations),
+    numPoints(0)
+{
+  if (numLists == 0)
+  {
+    throw std::invalid_argument("IVFPQSearch::IVFPQSearch(): the number of "
+        "lists must be positive!");
+  }
+
+  if (numSubspaces == 0)
+  {
+    throw std::invalid_argument("IVFPQSearch::IVFPQSearch(): the number of "
+        "subspaces must be positive!");
+  }
+
+  if (numCodewords == 0 || numCodewords > 256)
+  {
+    throw std::invalid_argument("IVFPQSearch::IVFPQSearch(): the number of "
+        "codewords must be between 1 and 256!");
+  }
+}
+
+template<typename MatType>
+void IVFPQSearch<MatType>::Train(const MatType& trainingSet)
+{
+  if (trainingSet.n_rows % numSubspaces != 0)
+  {
+    std::ostringstream oss;
+    oss << "IVFPQSearch::Train(): the number of subspaces (" << numSubspaces
+        << ") must divide the dimensionality of the data ("
+        << trainingSet.n_rows << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (trainingSet.n_cols < std::max(numLists, numCodewords))
+  {
+    std::ostringstream oss;
+    oss << "IVFPQSearch::Train(): the training set has " << trainingSet.n_cols
+        << " points, but at least " << std::max(numLists, numCodewords)
+        << " are needed to train " << numLists << " lists and "
+        << numCodewords << " codewords!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      NaiveKMeans, MatType> kmeans(maxIterations);
+
+  // Train the coarse quantizer.
+  Log::Info << "IVFPQSearch::Train(): training " << numLists << " coarse "
+      << "centroids..." << std::endl;
+  arma::Row<size_t> assignments;
+  arma::mat coarseCentroids;
+  kmeans.Cluster(trainingSet, numLists, assignments, coarseCentroids);
+  centroids = arma::conv_to<MatType>::from(coarseCentroids);
+
+  // Train the codebook of each subspace on the residuals.
+  MatType residuals(trainingSet);
+  for (size_t i = 0; i < residuals.n_cols; ++i)
+    residuals.col(i) -= centroids.col(assignments[i]);
+
+  Log::Info << "IVFPQSearch::Train(): training " << numSubspaces << " "
+      << "codebooks of " << numCodewords << " codewords..." << std::endl;
+  const size_t subDim = trainingSet.n_rows / numSubspaces;
+  codebooks.set_size(trainingSet.n_rows, numCodewords);
+  for (size_t m = 0; m < numSubspaces; ++m)
+  {
+    const MatType subResiduals = residuals.rows(m * subDim,
+        (m + 1) * subDim - 1);
+    arma::mat subCentroids;
+    kmeans.Cluster(subResiduals, numCodewords, subCentroids);
+    codebooks.rows(m * subDim, (m + 1) * subDim - 1) =
+        arma::conv_to<MatType>::from(subCentroids);
+  }
+
+  // Remove every point from the index.
+  listIndices.assign(numLists, arma::Col<size_t>());
+  listCodes.assign(numLists, arma::Mat<arma::u8>(numSubspaces, 0));
+  referenceSet.reset();
+  numPoints = 0;
+}
+
+template<typename MatType>
+void IVFPQSearch<MatType>::Add(const MatType& points)
+{
+  if (centroids.n_cols == 0)
+  {
+    throw std::invalid_argument("IVFPQSearch::Add(): the index must be "
+        "trained with Train() first!");
+  }
+
+  util::CheckSameDimensionality(points, centroids, "IVFPQSearch::Add()",
+      "points");
+
+  // Assign and encode each point.
+  arma::Row<size_t> assignments(points.n_cols);
+  arma::Mat<arma::u8> codes(numSubspaces, points.n_cols);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) points.n_cols; ++i)
+  {
+    assignments[i] = NearestList(points.col(i));
+    Encode(points.col(i), assignments[i], codes.colptr(i));
+  }
+
+  // Append the codes to their lists, growing each list only once.
+  arma::Col<size_t> counts(numLists, arma::fill::zeros);
+  for (size_t i = 0; i < points.n_cols; ++i)
+    ++counts[assignments[i]];
+
+  arma::Col<size_t> positions(numLists);
+  for (size_t l = 0; l < numLists; ++l)
+  {
+    positions[l] = listIndices[l].n_elem;
+    if (counts[l] > 0)
+    {
+      listIndices[l].resize(positions[l] + counts[l]);
+      listCodes[l].resize(numSubspaces, positions[l] + counts[l]);
+    }
+  }
+
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    const size_t l = assignments[i];
+    listIndices[l][positions[l]] = numPoints + i;
+    listCodes[l].col(positions[l]) = codes.col(i);
+    ++positions[l];
+  }
+
+  if (keepReferenceSet)
+    referenceSet.insert_cols(referenceSet.n_cols, points);
+
+  numPoints += points.n_cols;
+}
+
+template<typename MatType>
+void IVFPQSearch<MatType>::Search(const MatType& querySet,
+                                  const size_t k,
+                                  arma::Mat<size_t>& neighbors,
+                                  arma::Mat<ElemType>& distances) const
+{
+  if (centroids.n_cols == 0)
+  {
+    throw std::invalid_argument("IVFPQSearch::Search(): the index must be "
+        "trained with Train() first!");
+  }
+
+  // Ensure the dimensionality of the query set is correct.
+  util::CheckSameDimensionality(querySet, centroids, "IVFPQSearch::Search()",
+      "query set");
+
+  if (k > numPoints)
+  {
+    std::ostringstream oss;
+    oss << "IVFPQSearch::Search(): requested " << k << " approximate nearest "
+        << "neighbors, but the index has " << numPoints << " points!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (rerank > 0 && !keepReferenceSet)
+  {
+    throw std::invalid_argument("IVFPQSearch::Search(): re-ranking requires "
+        "the reference set to be kept (keepReferenceSet)!");
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  // If the user asked for 0 nearest neighbors... uh... we're done.
+  if (k == 0)
+    return;
+
+  const size_t probes = std::min(numProbes, numLists);
+  const size_t numCandidates = std::max(rerank, k);
+  const size_t subDim = centroids.n_rows / numSubspaces;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+  {
+    const arma::Col<ElemType> query(querySet.col(i));
+
+    // Find the nearest lists.
+    arma::Col<ElemType> listDistances(numLists);
+    for (size_t l = 0; l < numLists; ++l)
+    {
+      listDistances[l] = SquaredEuclideanDistance::Evaluate(query,
+          centroids.col(l));
+    }
+    const arma::uvec order = arma::sort_index(listDistances);
+
+    // The best candidates found so far, worst on top.
+    std::priority_queue<Candidate> best;
+    arma::Mat<ElemType> table(numCodewords, numSubspaces);
+    arma::Col<ElemType> residual(query.n_elem);
+    for (size_t p = 0; p < probes; ++p)
+    {
+      const size_t list = order[p];
+      if (listIndices[list].n_elem == 0)
+        continue;
+
+      // Compute the lookup table of squared distances between the residual of
+      // the query and every codeword; column m holds the table of subspace m.
+      residual = query - centroids.col(list);
+      for (size_t m = 0; m < numSubspaces; ++m)
+      {
+        const ElemType* r = residual.memptr() + m * subDim;
+        ElemType* t = table.colptr(m);
+        for (size_t j = 0; j < numCodewords; ++j)
+        {
+          const ElemType* c = codebooks.colptr(j) + m * subDim;
+          ElemType sum = 0;
+          for (size_t d = 0; d < subDim; ++d)
+            sum += (r[d] - c[d]) * (r[d] - c[d]);
+          t[j] = sum;
+        }
+      }
+
+      // Scan the list: each distance is a sum of table entries.
+      const ElemType* t = table.memptr();
+      const arma::Mat<arma::u8>& codes = listCodes[list];
+      const arma::Col<size_t>& indices = listIndices[list];
+      for (size_t c = 0; c < codes.n_cols; ++c)
+      {
+        const arma::u8* code = codes.colptr(c);
+        ElemType dist = 0;
+        for (size_t m = 0; m < numSubspaces; ++m)
+          dist += t[m * numCodewords + code[m]];
+
+        if (best.size() < numCandidates)
+        {
+          best.push(Candidate(dist, indices[c]));
+        }
+        else if (dist < best.top().first)
+        {
+          best.pop();
+          best.push(Candidate(dist, indices[c]));
+        }
+      }
+    }
+
+    // Extract the candidates, nearest first.
+    std::vector<Candidate> results(best.size());
+    for (size_t r = results.size(); r > 0; --r)
+    {
+      results[r - 1] = best.top();
+      best.pop();
+    }
+
+    if (rerank > 0)
+    {
+      // Re-rank the candidates with their exact distances.
+      for (size_t r = 0; r < results.size(); ++r)
+      {
+        results[r].first = EuclideanDistance::Evaluate(query,
+            referenceSet.col(results[r].second));
+      }
+      std::sort(results.begin(), results.end());
+    }
+    else
+    {
+      for (size_t r = 0; r < results.size(); ++r)
+        results[r].first = std::sqrt(results[r].first);
+    }
+
+    for (size_t j = 0; j < k; ++j)
+    {
+      if (j < results.size())
+      {
+        neighbors(j, i) = results[j].second;
+        distances(j, i) = results[j].first;
+      }
+      else
+      {
+        neighbors(j, i) = numPoints;
+        distances(j, i) = DBL_MAX;
+      }
+    }
+  }
+}
+
+template<typename MatType>
+template<typename VecType>
+size_t IVFPQSearch<MatType>::NearestList(const VecType& point) const
+{
+  size_t bestList = 0;
+  ElemType bestDistance = std::numeric_limits<ElemType>::max();
+  for (size_t l = 0; l < numLists; ++l)
+  {
+    const ElemType d = SquaredEuclideanDistance::Evaluate(point,
+        centroids.col(l));
+    if (d < bestDistance)
+    {
+      bestDistance = d;
+      bestList = l;
+    }
+  }
+
+  return bestList;
+}
+
+template<typename MatType>
+template<typename VecType>
+void IVFPQSearch<MatType>::Encode(const VecType& point,
+                                  const size_t list,
+                                  arma::u8* code) const
+{
+  const size_t subDim = centroids.n_rows / numSubspaces;
+  const arma::Col<ElemType> residual = point - centroids.col(list);
+
+  for (size_t m = 0; m < numSubspaces; ++m)
+  {
+    const ElemType* r = residual.memptr() + m * subDim;
+    size_t bestCodeword = 0;
+    ElemType bestDistance = std::numeric_limits<ElemType>::max();
+    for (size_t j = 0; j < numCodewords; ++j)
+    {
+      const ElemType* c = codebooks.colptr(j) + m * subDim;
+      ElemType sum = 0;
+      for (size_t d = 0; d < subDim; ++d)
+        sum += (r[d] - c[d]) * (r[d] - c[d]);
+
+      if (sum < bestDistance)
+      {
+        bestDistance = sum;
+        bestCodeword = j;
+      }
+    }
+
+    code[m] = (arma::u8) bestCodeword;
+  }
+}
+
+template<typename MatType>
+template<typename Archive>
+void IVFPQSearch<MatType>::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numLists));
+  ar(CEREAL_NVP(numSubspaces));
+  ar(CEREAL_NVP(numCodewords));
+  ar(CEREAL_NVP(numProbes));
+  ar(CEREAL_NVP(rerank));
+  ar(CEREAL_NVP(keepReferenceSet));
+  ar(CEREAL_NVP(maxIterations));
+  ar(CEREAL_NVP(numPoints));
+  ar(CEREAL_NVP(centroids));
+  ar(CEREAL_NVP(codebooks));
+  ar(CEREAL_NVP(listIndices));
+  ar(CEREAL_NVP(listCodes));
+  ar(CEREAL_NVP(referenceSet));
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,177 @@
+/**
+ * @file methods/kde/fast_gauss_transform.hpp
+ *
+ * An implementation of the Improved Fast Gauss Transform (IFGT), which computes
+ * Gaussian kernel sums in time roughly linear in the number of reference and
+ * query points.  It is used by KDE in KDE_IFGT_MODE.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_FAST_GAUSS_TRANSFORM_HPP
+#define MLPACK_METHODS_KDE_FAST_GAUSS_TRANSFORM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The FastGaussTransform class computes, for each query point y, the Gaussian
+ * kernel density estimate
+ *
+ *   f(y) = (1 / N) sum_i exp(-|| y - x_i ||^2 / (2 * bandwidth^2))
+ *
+ * over the N reference points x_i, with the Improved Fast Gauss Transform:
+ *
+ * @code
+ * @inproceedings{yang2003improved,
+ *   title={Improved fast gauss transform and efficient kernel density
+ *       estimation},
+ *   author={Yang, C. and Duraiswami, R. and Gumerov, N.A. and Davis, L.},
+ *   booktitle={Proceedings of the Ninth IEEE International Conference on
+ *       Computer Vision (ICCV 2003)},
+ *   pages={664--671},
+ *   year={2003}
+ * }
+ *
+ * @article{raykar2005fast,
+ *   title={Fast computation of sums of Gaussians in high dimensions},
+ *   author={Raykar, V.C. and Yang, C. and Duraiswami, R. and Gumerov, N.},
+ *   journal={Technical Report CS-TR-4767, University of Maryland},
+ *   year={2005}
+ * }
+ * @endcode
+ *
+ * The reference points are grouped into clusters with farthest-point
+ * clustering, and the contribution of each cluster is represented by a
+ * truncated multivariate Taylor expansion around its center.  Each query point
+ * then only sums the expansions of the clusters within a cutoff radius.  The
+ * number of clusters, the truncation order and the cutoff radius are chosen
+ * automatically for the requested error tolerance, so that the cost is
+ * O((N + M) * terms) instead of O(N * M).  This is most useful when the
+ * bandwidth is large and the dimensionality is low, which is exactly when
+ * tree-based pruning is least effective.
+ *
+ * The error of each query point's estimate is bounded during the evaluation;
+ * if the bound does not meet the tolerance, that point is computed exactly.
+ * So, like the tree-based KDE, the error is always within the tolerance.  If
+ * the expansion would cost more than the exact sums (for instance, for small
+ * bandwidths or many dimensions), all points are computed exactly.
+ */
+class FastGaussTransform
+{
+ public:
+  /**
+   * Create the FastGaussTransform object.
+   *
+   * @param bandwidth Bandwidth of the Gaussian kernel.
+   * @param maxClusters Maximum number of clusters of reference points.
+   * @param maxOrder Maximum truncation order of the expansions.
+   */
+  FastGaussTransform(const double bandwidth = 1.0,
+                     const size_t maxClusters = 256,
+                     const size_t maxOrder = 20);
+
+  /**
+   * Compute the kernel density estimate of each query point.  Each estimate
+   * will be within relError of the true value, plus absError.
+   *
+   * @param referenceSet Reference points.
+   * @param querySet Query points.
+   * @param estimations Will hold the estimate of each query point.
+   * @param relError Relative error tolerance.
+   * @param absError Absolute error tolerance.
+   * @param sameSet If true, the query set must be the reference set, and the
+   *     contribution of each point to its own estimate is left out.
+   */
+  void Evaluate(const arma::mat& referenceSet,
+                const arma::mat& querySet,
+                arma::vec& estimations,
+                const double relError,
+                const double absError,
+                const bool sameSet = false);
+
+  //! Get the bandwidth of the kernel.
+  double Bandwidth() const { return bandwidth; }
+  //! Modify the bandwidth of the kernel.
+  double& Bandwidth() { return bandwidth; }
+
+  //! Get the maximum number of clusters.
+  size_t MaxClusters() const { return maxClusters; }
+  //! Modify the maximum number of clusters.
+  size_t& MaxClusters() { return maxClusters; }
+
+  //! Get the maximum truncation order.
+  size_t MaxOrder() const { return maxOrder; }
+  //! Modify the maximum truncation order.
+  size_t& MaxOrder() { return maxOrder; }
+
+  //! Get the number of clusters used in the last evaluation (0 if every point
+  //! was computed exactly).
+  size_t NumClusters() const { return numClusters; }
+  //! Get the truncation order used in the last evaluation.
+  size_t Order() const { return order; }
+  //! Get the number of query points that were computed exactly in the last
+  //! evaluation.
+  size_t NumExactQueries() const { return numExactQueries; }
+
+ private:
+  //! Bandwidth of the kernel.
+  double bandwidth;
+  //! Maximum number of clusters.
+  size_t maxClusters;
+  //! Maximum truncation order.
+  size_t maxOrder;
+
+  //! Number of clusters used in the last evaluation.
+  size_t numClusters;
+  //! Truncation order used in the last evaluation.
+  size_t order;
+  //! Number of query points computed exactly in the last evaluation.
+  size_t numExactQueries;
+
+  /**
+   * Compute the exact estimate of the given query point.
+   *
+   * @param referenceSet Reference points.
+   * @param query Query point.
+   * @param h2 Square of the scaled bandwidth (2 * bandwidth^2).
+   */
+  static double ExactEstimate(const arma::mat& referenceSet,
+                              const double* query,
+                              const double h2);
+
+  /**
+   * Compute all monomials of v of total degree less than the given order, in
+   * graded order.  The first element of monomials is 1.
+   *
+   * @param v Vector of length dimensionality.
+   * @param dimensionality Length of v.
+   * @param order Truncation order.
+   * @param heads Workspace of size dimensionality.
+   * @param monomials Will hold the monomials; must already have the right
+   *     size.
+   */
+  static void ComputeMonomials(const double* v,
+                               const size_t dimensionality,
+                               const size_t order,
+                               std::vector<size_t>& heads,
+                               arma::vec& monomials);
+
+  /**
+   * Compute the constant 2^|alpha| / alpha! of each multi-index alpha, in the
+   * same order as ComputeMonomials().
+   */
+  static void ComputeConstants(const size_t dimensionality,
+                               const size_t order,
+                               arma::vec& constants);
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "fast_gauss_transform_impl.hpp"
+
+#endif
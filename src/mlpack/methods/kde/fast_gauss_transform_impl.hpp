@@ -0,0 +1,404 @@
+/**
+ * @file methods/kde/fast_gauss_transform_impl.hpp
+ *
+ * Implementation of the Improved Fast Gauss Transform.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_FAST_GAUSS_TRANSFORM_IMPL_HPP
+#define MLPACK_METHODS_KDE_FAST_GAUSS_TRANSFORM_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "fast_gauss_transform.hpp"
+
+namespace mlpack {
+
+inline FastGaussTransform::FastGaussTransform(const double bandwidth,
+                                              const size_t maxClusters,
+                                              const size_t maxOrder) :
+    bandwidth(bandwidth),
+    maxClusters(maxClusters),
+    maxOrder(maxOrder),
+    numClusters(0),
+    order(0),
+    numExactQueries(0)
+{
+  if (bandwidth <= 0.0)
+  {
+    throw std::invalid_argument("FastGaussTransform: bandwidth must be "
+        "positive!");
+  }
+  if (maxClusters == 0 || maxOrder == 0)
+  {
+    throw std::invalid_argument("FastGaussTransform: maxClusters and maxOrder "
+        "must be positive!");
+  }
+}
+
+inline void FastGaussTransform::Evaluate(const arma::mat& referenceSet,
+                                         const arma::mat& querySet,
+                                         arma::vec& estimations,
+                                         const double relError,
+                                         const double absError,
+                                         const bool sameSet)
+{
+  if (querySet.n_rows != referenceSet.n_rows)
+  {
+    throw std::invalid_argument("FastGaussTransform::Evaluate(): querySet and "
+        "referenceSet dimensions don't match");
+  }
+
+  const size_t n = referenceSet.n_cols;
+  const size_t m = querySet.n_cols;
+  const size_t d = referenceSet.n_rows;
+  // The kernel is exp(-|| x - y ||^2 / h^2) with this h.
+  const double h2 = 2.0 * bandwidth * bandwidth;
+  const double h = std::sqrt(h2);
+
+  numClusters = 0;
+  order = 0;
+  numExactQueries = 0;
+  estimations.zeros(m);
+  if (n == 0 || m == 0)
+    return;
+
+  // The tolerance is relative to the estimates, so get an idea of the
+  // smallest estimate from a few query points.
+  double minEstimate = DBL_MAX;
+  const size_t numSamples = std::min(m, (size_t) 20);
+  for (size_t i = 0; i < numSamples; ++i)
+  {
+    const size_t q = (i * m) / numSamples;
+    double estimate = ExactEstimate(referenceSet, querySet.colptr(q), h2);
+    if (sameSet)
+      estimate -= 1.0 / n;
+    minEstimate = std::min(minEstimate, std::max(estimate, 0.0));
+  }
+
+  // Half of the tolerance goes to the truncation of the expansions, and half
+  // to the clusters that are too far away to be considered.
+  const double epsilon = 0.5 * (absError + relError * minEstimate);
+  const double cutoff = (epsilon > 0.0 && epsilon < 1.0) ?
+      h * std::sqrt(-std::log(epsilon)) : 0.0;
+
+  // Farthest-point clustering (Gonzalez's algorithm) gives, for every number
+  // of clusters K, a clustering whose radius is within a factor of 2 of the
+  // optimal one.  Record the radius for each K, so that the cheapest
+  // combination of K and truncation order can be chosen.
+  const size_t maxK = std::min(n, maxClusters);
+  std::vector<size_t> centers;
+  std::vector<double> radii;
+  arma::vec minDistances(n);
+  minDistances.fill(DBL_MAX);
+  size_t nextCenter = 0;
+  if (epsilon > 0.0)
+  {
+    while (centers.size() < maxK)
+    {
+      centers.push_back(nextCenter);
+      const double* center = referenceSet.colptr(nextCenter);
+
+      #pragma omp parallel for
+      for (size_t i = 0; i < n; ++i)
+      {
+        const double* point = referenceSet.colptr(i);
+        double dist = 0.0;
+        for (size_t k = 0; k < d; ++k)
+          dist += (point[k] - center[k]) * (point[k] - center[k]);
+        if (dist < minDistances[i])
+          minDistances[i] = dist;
+      }
+
+      nextCenter = minDistances.index_max();
+      radii.push_back(std::sqrt(minDistances[nextCenter]));
+      if (radii.back() == 0.0)
+        break;
+    }
+  }
+
+  // For each K, find the smallest truncation order for which the error bound
+  // (2^p / p!) (rx (rx + ry) / h^2)^p is below the tolerance, and estimate the
+  // cost of the transform.  The number of terms of an expansion of order p in
+  // d dimensions is (p - 1 + d) choose d.
+  const double directCost = (double) n * (double) m * (double) d;
+  double bestCost = directCost;
+  size_t bestK = 0, bestOrder = 0;
+  for (size_t k = 0; k < radii.size(); ++k)
+  {
+    const double x = radii[k] * (radii[k] + cutoff) / h2;
+    double bound = 1.0;
+    size_t p = 0;
+    for (size_t i = 1; i <= maxOrder; ++i)
+    {
+      bound *= 2.0 * x / i;
+      if (bound <= epsilon)
+      {
+        p = i;
+        break;
+      }
+    }
+
+    if (p == 0)
+      continue;
+
+    double terms = 1.0;
+    for (size_t i = 1; i <= d; ++i)
+      terms *= (double) (p - 1 + i) / i;
+
+    // Keep the coefficients (and the table of exponents) to a reasonable
+    // size.
+    if (terms * (k + 1) > 1e7 || terms * d > 1e7)
+      continue;
+
+    const double cost = (double) n * terms +
+        (double) m * (k + 1) * (d + terms);
+    if (cost < bestCost)
+    {
+      bestCost = cost;
+      bestK = k + 1;
+      bestOrder = p;
+    }
+  }
+
+  if (bestK == 0)
+  {
+    // The expansion is not worth it; compute everything exactly.
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (size_t q = 0; q < m; ++q)
+    {
+      estimations[q] = ExactEstimate(referenceSet, querySet.colptr(q), h2);
+      if (sameSet)
+        estimations[q] -= 1.0 / n;
+    }
+
+    numExactQueries = m;
+    return;
+  }
+
+  numClusters = bestK;
+  order = bestOrder;
+  arma::vec constants;
+  ComputeConstants(d, order, constants);
+  const size_t numTerms = constants.n_elem;
+
+  // Assign each reference point to its nearest center among the first K.
+  arma::mat clusterCenters(d, numClusters);
+  for (size_t c = 0; c < numClusters; ++c)
+    clusterCenters.col(c) = referenceSet.col(centers[c]);
+
+  arma::Col<size_t> assignments(n);
+  #pragma omp parallel for
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double* point = referenceSet.colptr(i);
+    double bestDist = DBL_MAX;
+    for (size_t c = 0; c < numClusters; ++c)
+    {
+      const double* center = clusterCenters.colptr(c);
+      double dist = 0.0;
+      for (size_t k = 0; k < d; ++k)
+        dist += (point[k] - center[k]) * (point[k] - center[k]);
+      if (dist < bestDist)
+      {
+        bestDist = dist;
+        assignments[i] = c;
+      }
+    }
+    minDistances[i] = std::sqrt(bestDist);
+  }
+
+  // Group the points of each cluster together, and compute the radius and
+  // weight of each cluster.
+  arma::Col<size_t> offsets(numClusters + 1, arma::fill::zeros);
+  for (size_t i = 0; i < n; ++i)
+    ++offsets[assignments[i] + 1];
+  for (size_t c = 0; c < numClusters; ++c)
+    offsets[c + 1] += offsets[c];
+
+  arma::Col<size_t> clusterPoints(n);
+  arma::Col<size_t> positions(offsets.memptr(), numClusters);
+  arma::vec clusterRadii(numClusters, arma::fill::zeros);
+  for (size_t i = 0; i < n; ++i)
+  {
+    const size_t c = assignments[i];
+    clusterPoints[positions[c]++] = i;
+    clusterRadii[c] = std::max(clusterRadii[c], minDistances[i]);
+  }
+
+  // Compute the coefficients of each cluster:
+  //   C_alpha = (2^|alpha| / alpha!) (1 / N)
+  //       sum_x exp(-|| x - c ||^2 / h^2) ((x - c) / h)^alpha.
+  arma::mat coefficients(numTerms, numClusters, arma::fill::zeros);
+  #pragma omp parallel
+  {
+    arma::vec v(d), monomials(numTerms);
+    std::vector<size_t> heads(d);
+
+    #pragma omp for schedule(dynamic)
+    for (size_t c = 0; c < numClusters; ++c)
+    {
+      const double* center = clusterCenters.colptr(c);
+      for (size_t j = offsets[c]; j < offsets[c + 1]; ++j)
+      {
+        const double* point = referenceSet.colptr(clusterPoints[j]);
+        double norm = 0.0;
+        for (size_t k = 0; k < d; ++k)
+        {
+          v[k] = (point[k] - center[k]) / h;
+          norm += v[k] * v[k];
+        }
+
+        ComputeMonomials(v.memptr(), d, order, heads, monomials);
+        coefficients.col(c) += std::exp(-norm) * monomials;
+      }
+
+      coefficients.col(c) %= constants / n;
+    }
+  }
+
+  // The constant of the truncation error bound, 2^p / p!.
+  double truncationConstant = 1.0;
+  for (size_t i = 1; i <= order; ++i)
+    truncationConstant *= 2.0 / i;
+
+  // Now evaluate the expansions at each query point, keeping a bound on the
+  // error; if that bound is not good enough, evaluate the point exactly.
+  size_t exactQueries = 0;
+  #pragma omp parallel reduction(+:exactQueries)
+  {
+    arma::vec u(d), monomials(numTerms);
+    std::vector<size_t> heads(d);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t q = 0; q < m; ++q)
+    {
+      const double* query = querySet.colptr(q);
+      double estimate = 0.0, bound = 0.0;
+      for (size_t c = 0; c < numClusters; ++c)
+      {
+        const double* center = clusterCenters.colptr(c);
+        double dist = 0.0;
+        for (size_t k = 0; k < d; ++k)
+          dist += (query[k] - center[k]) * (query[k] - center[k]);
+        dist = std::sqrt(dist);
+
+        const double weight = (double) (offsets[c + 1] - offsets[c]) / n;
+        if (dist > clusterRadii[c] + cutoff)
+        {
+          // Every point of the cluster is at least this far from the query.
+          const double minDist = dist - clusterRadii[c];
+          bound += weight * std::exp(-minDist * minDist / h2);
+          continue;
+        }
+
+        for (size_t k = 0; k < d; ++k)
+          u[k] = (query[k] - center[k]) / h;
+
+        ComputeMonomials(u.memptr(), d, order, heads, monomials);
+        estimate += std::exp(-dist * dist / h2) *
+            arma::dot(coefficients.col(c), monomials);
+        bound += weight * truncationConstant *
+            std::pow(clusterRadii[c] * dist / h2, (double) order);
+      }
+
+      if (sameSet)
+        estimate -= 1.0 / n;
+
+      if (bound > absError + relError * std::max(estimate - bound, 0.0))
+      {
+        estimate = ExactEstimate(referenceSet, query, h2);
+        if (sameSet)
+          estimate -= 1.0 / n;
+        ++exactQueries;
+      }
+
+      estimations[q] = estimate;
+    }
+  }
+
+  numExactQueries = exactQueries;
+}
+
+inline double FastGaussTransform::ExactEstimate(const arma::mat& referenceSet,
+                                                const double* query,
+                                                const double h2)
+{
+  double sum = 0.0;
+  for (size_t i = 0; i < referenceSet.n_cols; ++i)
+  {
+    const double* point = referenceSet.colptr(i);
+    double dist = 0.0;
+    for (size_t k = 0; k < referenceSet.n_rows; ++k)
+      dist += (point[k] - query[k]) * (point[k] - query[k]);
+    sum += std::exp(-dist / h2);
+  }
+
+  return sum / referenceSet.n_cols;
+}
+
+inline void FastGaussTransform::ComputeMonomials(const double* v,
+                                                 const size_t dimensionality,
+                                                 const size_t order,
+                                                 std::vector<size_t>& heads,
+                                                 arma::vec& monomials)
+{
+  // The monomials of degree k are the monomials of degree k - 1 multiplied by
+  // each v[i]; heads[i] is the first monomial of the previous degree that
+  // does not contain any v[j] with j < i, so each monomial is built once.
+  std::fill(heads.begin(), heads.end(), 0);
+  monomials[0] = 1.0;
+  size_t t = 1;
+  for (size_t k = 1; k < order; ++k)
+  {
+    const size_t tail = t;
+    for (size_t i = 0; i < dimensionality; ++i)
+    {
+      const size_t head = heads[i];
+      heads[i] = t;
+      for (size_t j = head; j < tail; ++j)
+        monomials[t++] = v[i] * monomials[j];
+    }
+  }
+}
+
+inline void FastGaussTransform::ComputeConstants(const size_t dimensionality,
+                                                 const size_t order,
+                                                 arma::vec& constants)
+{
+  size_t numTerms = 1;
+  for (size_t i = 1; i <= dimensionality; ++i)
+    numTerms = (numTerms * (order - 1 + i)) / i;
+
+  // Build the exponents of each multi-index with the same recursion as
+  // ComputeMonomials(); multiplying by v[i] multiplies the constant by
+  // 2 / (alpha_i + 1).
+  arma::Mat<unsigned char> exponents(dimensionality, numTerms,
+      arma::fill::zeros);
+  std::vector<size_t> heads(dimensionality, 0);
+  constants.set_size(numTerms);
+  constants[0] = 1.0;
+  size_t t = 1;
+  for (size_t k = 1; k < order; ++k)
+  {
+    const size_t tail = t;
+    for (size_t i = 0; i < dimensionality; ++i)
+    {
+      const size_t head = heads[i];
+      heads[i] = t;
+      for (size_t j = head; j < tail; ++j)
+      {
+        exponents.col(t) = exponents.col(j);
+        ++exponents(i, t);
+        constants[t] = constants[j] * 2.0 / exponents(i, t);
+        ++t;
+      }
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
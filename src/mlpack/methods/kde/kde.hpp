@@ -16,6 +16,7 @@
 #include <mlpack/core.hpp>
 
 #include "kde_stat.hpp"
+#include "fast_gauss_transform.hpp"
 
 namespace mlpack {
 
@@ -23,7 +24,9 @@ namespace mlpack {
 enum KDEMode
 {
   KDE_DUAL_TREE_MODE,
-  KDE_SINGLE_TREE_MODE
+  KDE_SINGLE_TREE_MODE,
+  //! Use the Improved Fast Gauss Transform (only for the Gaussian kernel).
+  KDE_IFGT_MODE
 };
 
 //! KDEDefaultParams contains the default input parameter values for KDE.
@@ -221,6 +224,47 @@ class KDE
    */
   void Evaluate(arma::vec& estimations);
 
+  /**
+   * Decide whether the density of each point in the query set is at least the
+   * given threshold (in the same units as the estimations of Evaluate()),
+   * without estimating the densities: each query point is only evaluated
+   * until it is certain on which side of the threshold its density is, so
+   * this is typically much faster than Evaluate() followed by a comparison.
+   * The labels are exact; the error tolerances are only used to decide how
+   * closely the kernel values of node combinations have to be known before
+   * they are pruned (the points whose density is within about
+   * `RelativeError() * threshold + AbsoluteError()` of the threshold are then
+   * evaluated exactly).  Monte Carlo estimations are not used.
+   *
+   * In the IFGT mode, and for trees whose nodes share points (such as cover
+   * trees), the densities are estimated with Evaluate() and compared with the
+   * threshold instead, so the labels are only exact up to the error
+   * tolerances.
+   *
+   * - Use std::move if the query set is no longer needed.
+   *
+   * @pre The model has to be previously trained.
+   * @param querySet Set of query points to classify.
+   * @param threshold Density threshold.
+   * @param labels Object which will hold 1 for each query point whose density
+   *     is at least the threshold, and 0 otherwise.
+   */
+  void Classify(MatType querySet,
+                const double threshold,
+                arma::Row<size_t>& labels);
+
+  /**
+   * Decide whether the density of each point in the reference set (without
+   * the point itself) is at least the given threshold; see the other overload
+   * of Classify().  This is the typical use for outlier detection.
+   *
+   * @pre The model has to be previously trained.
+   * @param threshold Density threshold.
+   * @param labels Object which will hold 1 for each reference point whose
+   *     density is at least the threshold, and 0 otherwise.
+   */
+  void Classify(const double threshold, arma::Row<size_t>& labels);
+
   //! Get the kernel.
   const KernelType& Kernel() const { return kernel; }
 
@@ -297,6 +341,9 @@ class KDE
   //! Modify Monte Carlo break coefficient. (0 < newCoef <= 1).
   void MCBreakCoef(const double newCoef);
 
+  //! Get the statistics of the last evaluation.
+  const TraversalStats& Stats() const { return stats; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
@@ -348,12 +395,82 @@ class KDE
   //! is the limit before Monte Carlo estimation recurses.
   double mcBreakCoef;
 
+  //! The statistics of the last evaluation.
+  TraversalStats stats;
+
   //! Check whether absolute and relative error values are compatible.
   static void CheckErrorValues(const double relError, const double absError);
 
   //! Rearrange estimations vector if required.
   static void RearrangeEstimations(const std::vector<size_t>& oldFromNew,
                                    arma::vec& estimations);
+
+  //! Rearrange labels vector if required.
+  static void RearrangeLabels(const std::vector<size_t>& oldFromNew,
+                              arma::Row<size_t>& labels);
+
+  //! The dual-tree traverser used for the evaluation: if DualTreeTraversalType
+  //! is the default traverser of the tree, the tree's parallel traverser is
+  //! used when it has one.
+  template<typename RuleType>
+  using EvaluationTraverser = std::conditional_t<std::is_same_v<
+      DualTreeTraversalType<RuleType>,
+      typename Tree::template DualTreeTraverser<RuleType>>,
+      typename DualTreeTraverserType<Tree, RuleType>::type,
+      DualTreeTraversalType<RuleType>>;
+
+  /**
+   * Compute the Monte Carlo alpha of the given node and all of its
+   * descendants, so that the alphas are only read (possibly by several threads
+   * at once) during the evaluation.
+   */
+  void ComputeMCAlpha(Tree& node) const;
+
+  //! Fill the statistics of the last evaluation from the given rules, for an
+  //! evaluation that started at the given time.
+  template<typename RuleType>
+  void FinishStats(const RuleType& rules,
+                   const std::chrono::steady_clock::time_point start);
+
+  /**
+   * Perform single-tree evaluation of the given number of query points with
+   * the given rules.  If OpenMP is enabled, the query points are split between
+   * threads, each with its own copy of the rules.
+   */
+  template<typename RuleType>
+  void SingleTreeEvaluate(RuleType& rules, const size_t numQueries);
+
+  /**
+   * Evaluate the density of each point of the query set with the Improved
+   * Fast Gauss Transform.  This throws std::invalid_argument if the kernel is
+   * not a GaussianKernel.
+   *
+   * @param querySet Set of query points to get the density of.
+   * @param estimations Object which will hold the density of each query point.
+   * @param sameSet If true, the query set is the reference set, and the
+   *     estimation of a point with itself is left out.
+   */
+  void FastGaussEvaluate(const MatType& querySet,
+                         arma::vec& estimations,
+                         const bool sameSet);
+
+  /**
+   * Classify the points of the given query set (or query tree, in dual-tree
+   * mode) with KDEThresholdRules, and evaluate the undecided points exactly.
+   * The labels are in the order of the dataset of the query tree.
+   *
+   * @param querySet Set of query points to classify.
+   * @param queryTree Tree of the query points (only used in dual-tree mode).
+   * @param threshold Density threshold.
+   * @param labels Object which will hold the labels.
+   * @param sameSet If true, the query set is the reference set, and the
+   *     estimation of a point with itself is left out.
+   */
+  void ThresholdClassify(const MatType& querySet,
+                         Tree* queryTree,
+                         const double threshold,
+                         arma::Row<size_t>& labels,
+                         const bool sameSet);
 };
 
 } // namespace mlpack
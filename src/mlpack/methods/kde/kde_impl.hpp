@@ -12,6 +12,7 @@
 
 #include "kde.hpp"
 #include "kde_rules.hpp"
+#include "kde_threshold_rules.hpp"
 
 namespace mlpack {
 
@@ -367,10 +368,18 @@ void KDE<KernelType,
          SingleTreeTraversalType>::
 Evaluate(MatType querySet, arma::vec& estimations)
 {
+  MLPACK_PROFILE_SCOPE("KDE::Evaluate");
+
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
   if (mode == KDE_DUAL_TREE_MODE)
   {
     std::vector<size_t> oldFromNewQueries;
     Tree* queryTree = BuildTree<Tree>(std::move(querySet), oldFromNewQueries);
+    const std::chrono::microseconds treeBuildingTime =
+        TraversalStats::Since(start);
     try
     {
       this->Evaluate(queryTree, oldFromNewQueries, estimations);
@@ -382,8 +391,11 @@ Evaluate(MatType querySet, arma::vec& estimations)
       throw;
     }
     delete queryTree;
+
+    // The evaluation with the query tree resets the statistics.
+    stats.TreeBuildingTime() = treeBuildingTime;
   }
-  else if (mode == KDE_SINGLE_TREE_MODE)
+  else if (mode == KDE_SINGLE_TREE_MODE || mode == KDE_IFGT_MODE)
   {
     // Get estimations vector ready.
     estimations.clear();
@@ -412,6 +424,19 @@ Evaluate(MatType querySet, arma::vec& estimations)
                                   "referenceSet dimensions don't match");
     }
 
+    if (mode == KDE_IFGT_MODE)
+    {
+      FastGaussEvaluate(querySet, estimations, false);
+      stats.TraversalTime() = TraversalStats::Since(start);
+      return;
+    }
+
+    // Compute the alphas of the reference nodes now if Monte Carlo
+    // estimations are available, so that the traversal does not modify the
+    // reference tree.
+    if (monteCarlo && std::is_same_v<KernelType, GaussianKernel>)
+      ComputeMCAlpha(*referenceTree);
+
     // Evaluate.
     using RuleType = KDERules<DistanceType, KernelType, Tree>;
     RuleType rules = RuleType(referenceTree->Dataset(),
@@ -428,14 +453,11 @@ Evaluate(MatType querySet, arma::vec& estimations)
                               monteCarlo,
                               false);
 
-    // Create traverser.
-    SingleTreeTraversalType<RuleType> traverser(rules);
-
     // Traverse for each point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+    SingleTreeEvaluate(rules, querySet.n_cols);
 
     estimations /= referenceTree->Dataset().n_cols;
+    FinishStats(rules, start);
 
     Log::Info << rules.Scores() << " node combinations were scored."
               << std::endl;
@@ -462,6 +484,12 @@ Evaluate(Tree* queryTree,
          const std::vector<size_t>& oldFromNewQueries,
          arma::vec& estimations)
 {
+  MLPACK_PROFILE_SCOPE("KDE::Evaluate");
+
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
   // Get estimations vector ready.
   estimations.clear();
   estimations.set_size(queryTree->Dataset().n_cols);
@@ -503,6 +531,10 @@ Evaluate(Tree* queryTree,
     KDECleanRules<Tree> cleanRules;
     SingleTreeTraversalType<KDECleanRules<Tree>> cleanTraverser(cleanRules);
     cleanTraverser.Traverse(0, *queryTree);
+
+    // The alphas of the reference nodes are also computed now, so that the
+    // traversal does not modify the reference tree.
+    ComputeMCAlpha(*referenceTree);
   }
 
   // Evaluate.
@@ -521,13 +553,19 @@ Evaluate(Tree* queryTree,
                             monteCarlo,
                             false);
 
-  // Create traverser.
-  DualTreeTraversalType<RuleType> traverser(rules);
+  // Create traverser.  If possible, independent query subtrees are traversed
+  // in parallel; the error tolerance accumulated in each query node is only
+  // ever used by the thread that owns it.
+  EvaluationTraverser<RuleType> traverser(rules);
   traverser.Traverse(*queryTree, *referenceTree);
+  MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+  stats.Prunes() += traverser.NumPrunes();
+
   estimations /= referenceTree->Dataset().n_cols;
 
   // Rearrange if necessary.
   RearrangeEstimations(oldFromNewQueries, estimations);
+  FinishStats(rules, start);
 
   Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
   Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
@@ -549,6 +587,12 @@ void KDE<KernelType,
          SingleTreeTraversalType>::
 Evaluate(arma::vec& estimations)
 {
+  MLPACK_PROFILE_SCOPE("KDE::Evaluate");
+
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
   // Check whether has already been trained.
   if (!trained)
   {
@@ -561,12 +605,24 @@ Evaluate(arma::vec& estimations)
   estimations.set_size(referenceTree->Dataset().n_cols);
   estimations.fill(arma::fill::zeros);
 
+  if (mode == KDE_IFGT_MODE)
+  {
+    FastGaussEvaluate(referenceTree->Dataset(), estimations, true);
+    RearrangeEstimations(*oldFromNewReferences, estimations);
+    stats.TraversalTime() = TraversalStats::Since(start);
+    return;
+  }
+
   // Clean accumulated alpha if Monte Carlo estimations are available.
   if (monteCarlo && std::is_same_v<KernelType, GaussianKernel>)
   {
     KDECleanRules<Tree> cleanRules;
     SingleTreeTraversalType<KDECleanRules<Tree>> cleanTraverser(cleanRules);
     cleanTraverser.Traverse(0, *referenceTree);
+
+    // The alphas of the reference nodes are also computed now, so that the
+    // traversal does not modify the reference tree.
+    ComputeMCAlpha(*referenceTree);
   }
 
   // Evaluate.
@@ -588,19 +644,20 @@ Evaluate(arma::vec& estimations)
   if (mode == KDE_DUAL_TREE_MODE)
   {
     // Create traverser.
-    DualTreeTraversalType<RuleType> traverser(rules);
+    EvaluationTraverser<RuleType> traverser(rules);
     traverser.Traverse(*referenceTree, *referenceTree);
+    MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+    stats.Prunes() += traverser.NumPrunes();
   }
   else if (mode == KDE_SINGLE_TREE_MODE)
   {
-    SingleTreeTraversalType<RuleType> traverser(rules);
-    for (size_t i = 0; i < referenceTree->Dataset().n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+    SingleTreeEvaluate(rules, referenceTree->Dataset().n_cols);
   }
 
   estimations /= referenceTree->Dataset().n_cols;
   // Rearrange if necessary.
   RearrangeEstimations(*oldFromNewReferences, estimations);
+  FinishStats(rules, start);
 
   Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
   Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
@@ -824,4 +881,402 @@ RearrangeEstimations(const std::vector<size_t>& oldFromNew,
   }
 }
 
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+ComputeMCAlpha(Tree& node) const
+{
+  // This gives the same alphas as KDERules::CalculateAlpha(): the root gets
+  // the whole significance level, and each node splits its alpha evenly
+  // between its children.
+  KDEStat& stat = node.Stat();
+  if (node.Parent() == NULL)
+    stat.MCAlpha() = 1 - mcProb;
+  else
+    stat.MCAlpha() = node.Parent()->Stat().MCAlpha() /
+        node.Parent()->NumChildren();
+  stat.MCBeta() = 1 - mcProb;
+
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    ComputeMCAlpha(node.Child(i));
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename RuleType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+SingleTreeEvaluate(RuleType& rules, const size_t numQueries)
+{
+  // Each query point is only ever handled by one thread, and its error
+  // tolerance is only used for its own estimation, so the error guarantees are
+  // the same as for the serial traversal.
+  size_t threadBaseCases = 0, threadScores = 0, threadPrunes = 0;
+  #pragma omp parallel reduction(+:threadBaseCases, threadScores, \
+      threadPrunes)
+  {
+    RuleType threadRules(rules);
+    threadRules.BaseCases() = 0;
+    threadRules.Scores() = 0;
+    SingleTreeTraversalType<RuleType> traverser(threadRules);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t i = 0; i < numQueries; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+
+    threadBaseCases += threadRules.BaseCases();
+    threadScores += threadRules.Scores();
+    threadPrunes += traverser.NumPrunes();
+  }
+
+  rules.BaseCases() += threadBaseCases;
+  rules.Scores() += threadScores;
+  stats.Prunes() += threadPrunes;
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename RuleType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+FinishStats(const RuleType& rules,
+            const std::chrono::steady_clock::time_point start)
+{
+  stats.BaseCases() = rules.BaseCases();
+  stats.Scores() = rules.Scores();
+  // Every base case evaluates the kernel once.  (The kernel evaluations of the
+  // Monte Carlo samples are not counted.)
+  stats.DistanceEvaluations() = rules.BaseCases();
+  stats.TraversalTime() = TraversalStats::Since(start) -
+      stats.TreeBuildingTime();
+}
+
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+FastGaussEvaluate(const MatType& querySet,
+                  arma::vec& estimations,
+                  const bool sameSet)
+{
+  if constexpr (!std::is_same_v<KernelType, GaussianKernel>)
+  {
+    throw std::invalid_argument("KDE::Evaluate(): the IFGT mode can only be "
+        "used with the Gaussian kernel");
+  }
+  else
+  {
+    FastGaussTransform fgt(kernel.Bandwidth());
+    fgt.Evaluate(arma::conv_to<arma::mat>::from(referenceTree->Dataset()),
+                 arma::conv_to<arma::mat>::from(querySet),
+                 estimations,
+                 relError,
+                 absError,
+                 sameSet);
+
+    Log::Info << "IFGT used " << fgt.NumClusters() << " clusters with order "
+        << fgt.Order() << "; " << fgt.NumExactQueries() << " query points "
+        << "were evaluated exactly." << std::endl;
+  }
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+Classify(MatType querySet,
+         const double threshold,
+         arma::Row<size_t>& labels)
+{
+  MLPACK_PROFILE_SCOPE("KDE::Classify");
+
+  // Check whether has already been trained.
+  if (!trained)
+  {
+    throw std::runtime_error("cannot classify with KDE model: model needs to "
+                             "be trained before classification");
+  }
+
+  // Check whether dimensions match.
+  if (querySet.n_cols > 0 &&
+      querySet.n_rows != referenceTree->Dataset().n_rows)
+  {
+    throw std::invalid_argument("cannot classify with KDE model: querySet "
+                                "and referenceSet dimensions don't match");
+  }
+
+  // The bounds of KDEThresholdRules would count the points shared by several
+  // nodes more than once.
+  if (mode == KDE_IFGT_MODE || TreeTraits<Tree>::HasSelfChildren)
+  {
+    arma::vec estimations;
+    Evaluate(std::move(querySet), estimations);
+    labels = arma::conv_to<arma::Row<size_t>>::from(
+        estimations.t() >= threshold);
+    return;
+  }
+
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  if (querySet.n_cols == 0)
+  {
+    Log::Warn << "KDE::Classify(): querySet is empty, no predictions will "
+              << "be returned" << std::endl;
+    labels.clear();
+    return;
+  }
+
+  if (mode == KDE_DUAL_TREE_MODE)
+  {
+    std::vector<size_t> oldFromNewQueries;
+    Tree* queryTree = BuildTree<Tree>(std::move(querySet), oldFromNewQueries);
+    stats.TreeBuildingTime() = TraversalStats::Since(start);
+    try
+    {
+      ThresholdClassify(queryTree->Dataset(), queryTree, threshold, labels,
+          false);
+    }
+    catch (std::exception& e)
+    {
+      // Make sure we delete the query tree.
+      delete queryTree;
+      throw;
+    }
+    delete queryTree;
+
+    RearrangeLabels(oldFromNewQueries, labels);
+  }
+  else
+  {
+    ThresholdClassify(querySet, NULL, threshold, labels, false);
+  }
+
+  stats.TraversalTime() = TraversalStats::Since(start) -
+      stats.TreeBuildingTime();
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+Classify(const double threshold, arma::Row<size_t>& labels)
+{
+  MLPACK_PROFILE_SCOPE("KDE::Classify");
+
+  // Check whether has already been trained.
+  if (!trained)
+  {
+    throw std::runtime_error("cannot classify with KDE model: model needs to "
+                             "be trained before classification");
+  }
+
+  // The bounds of KDEThresholdRules would count the points shared by several
+  // nodes more than once.
+  if (mode == KDE_IFGT_MODE || TreeTraits<Tree>::HasSelfChildren)
+  {
+    arma::vec estimations;
+    Evaluate(estimations);
+    labels = arma::conv_to<arma::Row<size_t>>::from(
+        estimations.t() >= threshold);
+    return;
+  }
+
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  ThresholdClassify(referenceTree->Dataset(), referenceTree, threshold, labels,
+      true);
+  RearrangeLabels(*oldFromNewReferences, labels);
+
+  stats.TraversalTime() = TraversalStats::Since(start);
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+ThresholdClassify(const MatType& querySet,
+                  Tree* queryTree,
+                  const double threshold,
+                  arma::Row<size_t>& labels,
+                  const bool sameSet)
+{
+  using RuleType = KDEThresholdRules<DistanceType, KernelType, Tree>;
+
+  const size_t numQueries = querySet.n_cols;
+  const size_t numReferences = referenceTree->Dataset().n_cols;
+  arma::vec lowerBounds(numQueries, arma::fill::zeros);
+  arma::vec upperBounds(numQueries, arma::fill::zeros);
+  arma::vec numVisited(numQueries, arma::fill::zeros);
+  labels.set_size(numQueries);
+  labels.fill(RuleType::Undecided);
+
+  // The rules work with the sums of the kernel values, which are not divided
+  // by the number of reference points.  The kernel values of a pruned node
+  // combination may be known to within twice the error tolerance, so that the
+  // bounds of each density are within the tolerance of each other at the end.
+  const double tolerance = 2 * (relError * threshold + absError);
+  RuleType rules(referenceTree->Dataset(),
+                 querySet,
+                 threshold * numReferences,
+                 tolerance,
+                 lowerBounds,
+                 upperBounds,
+                 numVisited,
+                 labels,
+                 distance,
+                 kernel,
+                 sameSet);
+
+  if (mode == KDE_DUAL_TREE_MODE)
+  {
+    EvaluationTraverser<RuleType> traverser(rules);
+    traverser.Traverse(*queryTree, *referenceTree);
+    MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+    stats.Prunes() += traverser.NumPrunes();
+  }
+  else
+  {
+    SingleTreeEvaluate(rules, numQueries);
+  }
+
+  // The points whose density is too close to the threshold are evaluated
+  // exactly.
+  std::vector<size_t> undecided;
+  for (size_t i = 0; i < numQueries; ++i)
+    if (labels[i] == RuleType::Undecided)
+      undecided.push_back(i);
+
+  #pragma omp parallel for schedule(dynamic, 16)
+  for (size_t k = 0; k < undecided.size(); ++k)
+  {
+    const size_t i = undecided[k];
+    double sum = 0.0;
+    for (size_t j = 0; j < numReferences; ++j)
+    {
+      if (!sameSet || i != j)
+      {
+        sum += kernel.Evaluate(distance.Evaluate(querySet.col(i),
+            referenceTree->Dataset().col(j)));
+      }
+    }
+
+    labels[i] = (sum >= threshold * numReferences) ? 1 : 0;
+  }
+
+  stats.BaseCases() = rules.BaseCases() + undecided.size() * numReferences;
+  stats.Scores() = rules.Scores();
+  stats.DistanceEvaluations() = stats.BaseCases();
+
+  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
+  Log::Info << rules.BaseCases() << " base cases were calculated."
+            << std::endl;
+  Log::Info << undecided.size() << " query points were evaluated exactly."
+            << std::endl;
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+RearrangeLabels(const std::vector<size_t>& oldFromNew,
+                arma::Row<size_t>& labels)
+{
+  if (TreeTraits<Tree>::RearrangesDataset)
+  {
+    arma::Row<size_t> rearrangedLabels(oldFromNew.size());
+    for (size_t i = 0; i < oldFromNew.size(); ++i)
+      rearrangedLabels[oldFromNew[i]] = labels[i];
+
+    labels = std::move(rearrangedLabels);
+  }
+}
+
 } // namespace mlpack
@@ -55,7 +55,10 @@ BINDING_LONG_DESC(
     "type of tree to use for the dual-tree algorithm with " +
     PRINT_PARAM_STRING("tree") + ". It is also possible to select whether to "
     "use dual-tree algorithm or single-tree algorithm using the " +
-    PRINT_PARAM_STRING("algorithm") + " option."
+    PRINT_PARAM_STRING("algorithm") + " option.  For the Gaussian kernel, "
+    "the 'ifgt' algorithm uses the Improved Fast Gauss Transform instead of "
+    "trees; this is much faster when the bandwidth is large compared to the "
+    "spread of the data and the dimensionality is low."
     "\n\n"
     "Monte Carlo estimations can be used to accelerate the KDE estimate when "
     "the Gaussian Kernel is used. This provides a probabilistic guarantee on "
@@ -152,7 +155,7 @@ PARAM_STRING_IN("tree", "Tree to use for the prediction."
     "('kd-tree', 'ball-tree', 'cover-tree', 'octree', 'r-tree').",
     "t", "kd-tree");
 PARAM_STRING_IN("algorithm", "Algorithm to use for the prediction."
-    "('dual-tree', 'single-tree').",
+    "('dual-tree', 'single-tree', 'ifgt').",
     "a", "dual-tree");
 PARAM_DOUBLE_IN("rel_error",
                 "Relative error tolerance for the prediction.",
@@ -231,8 +234,14 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
       "laplacian", "spherical", "triangular" }, true, "unknown kernel type");
   RequireParamInSet<string>(params, "tree", { "kd-tree", "ball-tree",
       "cover-tree", "octree", "r-tree"}, true, "unknown tree type");
-  RequireParamInSet<string>(params, "algorithm", { "dual-tree", "single-tree"},
+  RequireParamInSet<string>(params, "algorithm", { "dual-tree", "single-tree",
+      "ifgt" },
       true, "unknown algorithm");
+  if (modeStr == "ifgt" && params.Has("reference") && kernelStr != "gaussian")
+  {
+    Log::Fatal << "The 'ifgt' algorithm can only be used with the Gaussian "
+        << "kernel." << std::endl;
+  }
   RequireParamValue<double>(params, "rel_error",
       [](double x){ return x >= 0 && x <= 1; },
       true, "relative error must be between 0 and 1");
@@ -294,6 +303,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
       kde->Mode() = KDEMode::KDE_DUAL_TREE_MODE;
     else if (modeStr == "single-tree")
       kde->Mode() = KDEMode::KDE_SINGLE_TREE_MODE;
+    else if (modeStr == "ifgt")
+      kde->Mode() = KDEMode::KDE_IFGT_MODE;
   }
   else
   {
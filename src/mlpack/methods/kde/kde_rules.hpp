@@ -59,6 +59,15 @@ class KDERules
            const bool monteCarlo,
            const bool sameSet);
 
+  /**
+   * Construct a copy of the given KDERules object that shares its density
+   * estimations and its per-query-point accumulated error tolerances, so that
+   * several threads can evaluate disjoint sets of query points at once (see
+   * BinarySpaceTree::ParallelDualTreeTraverser).  The given object must
+   * outlive the copy.
+   */
+  KDERules(const KDERules& other);
+
   //! Base Case.
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
@@ -89,9 +98,15 @@ class KDERules
   //! Get the number of base cases.
   size_t BaseCases() const { return baseCases; }
 
+  //! Modify the number of base cases.
+  size_t& BaseCases() { return baseCases; }
+
   //! Get the number of scores.
   size_t Scores() const { return scores; }
 
+  //! Modify the number of scores.
+  size_t& Scores() { return scores; }
+
   //! Get the minimum number of base cases we need to perform to have acceptable
   //! results.
   size_t MinimumBaseCases() const { return 0; }
@@ -63,6 +63,36 @@ KDERules<DistanceType, KernelType, TreeType>::KDERules(
     accumMCAlpha = arma::vec(querySet.n_cols);
 }
 
+template<typename DistanceType, typename KernelType, typename TreeType>
+KDERules<DistanceType, KernelType, TreeType>::KDERules(const KDERules& other) :
+    referenceSet(other.referenceSet),
+    querySet(other.querySet),
+    densities(other.densities),
+    absError(other.absError),
+    relError(other.relError),
+    mcBeta(other.mcBeta),
+    initialSampleSize(other.initialSampleSize),
+    mcAccessCoef(other.mcAccessCoef),
+    mcBreakCoef(other.mcBreakCoef),
+    distance(other.distance),
+    kernel(other.kernel),
+    monteCarlo(other.monteCarlo),
+    sameSet(other.sameSet),
+    absErrorTol(other.absErrorTol),
+    lastQueryIndex(other.lastQueryIndex),
+    lastReferenceIndex(other.lastReferenceIndex),
+    traversalInfo(other.traversalInfo),
+    baseCases(other.baseCases),
+    scores(other.scores)
+{
+  // The accumulated error tolerances of each query point are shared with the
+  // other object, so that they are not copied for each thread.
+  if (other.accumError.n_elem > 0)
+    MakeAlias(accumError, other.accumError, other.accumError.n_elem);
+  if (other.accumMCAlpha.n_elem > 0)
+    MakeAlias(accumMCAlpha, other.accumMCAlpha, other.accumMCAlpha.n_elem);
+}
+
 //! The base case.
 template<typename DistanceType, typename KernelType, typename TreeType>
 inline mlpack_force_inline
@@ -89,6 +119,8 @@ double KDERules<DistanceType, KernelType, TreeType>::BaseCase(
   accumError(queryIndex) += 2 * relError * kernelValue;
 
   ++baseCases;
+  MLPACK_PROFILE_COUNT(BaseCases, 1);
+  MLPACK_PROFILE_COUNT(DistanceEvaluations, 1);
   lastQueryIndex = queryIndex;
   lastReferenceIndex = referenceIndex;
   traversalInfo.LastBaseCase() = d;
@@ -285,6 +317,7 @@ Score(const size_t queryIndex, TreeType& referenceNode)
   }
 
   ++scores;
+  MLPACK_PROFILE_COUNT(Scores, 1);
   traversalInfo.LastReferenceNode() = &referenceNode;
   traversalInfo.LastScore() = score;
   return score;
@@ -506,6 +539,7 @@ Score(TreeType& queryNode, TreeType& referenceNode)
   }
 
   ++scores;
+  MLPACK_PROFILE_COUNT(Scores, 1);
   traversalInfo.LastQueryNode() = &queryNode;
   traversalInfo.LastReferenceNode() = &referenceNode;
   traversalInfo.LastScore() = score;
@@ -0,0 +1,192 @@
+/**
+ * @file methods/kde/kde_threshold_rules.hpp
+ *
+ * Rules for classifying query points by whether their kernel density is above
+ * or below a threshold, so that it can be done with arbitrary tree types.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_THRESHOLD_RULES_HPP
+#define MLPACK_METHODS_KDE_THRESHOLD_RULES_HPP
+
+#include <mlpack/core/tree/traversal_info.hpp>
+
+namespace mlpack {
+
+/**
+ * A tree traversal Rules class for density classification: instead of
+ * estimating the kernel density of each query point to within a relative
+ * error, it only decides whether the density (the sum of the kernel values
+ * over the reference set) is at least a threshold.
+ *
+ * Each query point keeps a lower and an upper bound of its kernel sum: the
+ * base cases add their exact kernel value to both bounds, and a pruned node
+ * combination adds the smallest and largest possible kernel values of the
+ * reference node.  The reference points that have not been visited yet are
+ * bounded by the largest value of the kernel.  As soon as the lower bound of a
+ * query point reaches the threshold, or its upper bound falls below it, the
+ * point is decided, and no more work is done for it; a query node whose points
+ * are all decided is pruned.  Node combinations are pruned when the kernel
+ * bounds are within the given tolerance of each other, which does not depend
+ * on the density of the query points themselves (unlike KDERules), so far away
+ * reference nodes are pruned early even for outliers.
+ *
+ * Since the bounds are always valid, every decision is exact; the points that
+ * are still undecided at the end of the traversal (whose density is within
+ * about the tolerance of the threshold) have to be evaluated exactly by the
+ * caller.
+ *
+ * This is the density classification variant of dual-tree KDE; see
+ *
+ * @code
+ * @inproceedings{gray2003nonparametric,
+ *   title={Nonparametric Density Estimation: Toward Computational
+ *       Tractability},
+ *   author={Gray, Alexander G. and Moore, Andrew W.},
+ *   booktitle={Proceedings of the 2003 SIAM International Conference on Data
+ *       Mining},
+ *   pages={203--211},
+ *   year={2003}
+ * }
+ * @endcode
+ *
+ * The trees must not share points between nodes (that is, they must not have
+ * self-children), so that each pair of points is counted only once.
+ */
+template<typename DistanceType, typename KernelType, typename TreeType>
+class KDEThresholdRules
+{
+ public:
+  //! The label of a query point that is not decided yet.
+  static constexpr size_t Undecided = 2;
+
+  /**
+   * Construct the rules.  The decisions are written to `labels`, which must
+   * be filled with Undecided: 1 if the kernel sum of the query point is at
+   * least the threshold, 0 otherwise.
+   *
+   * @param referenceSet Reference set data.
+   * @param querySet Query set data.
+   * @param threshold Threshold of the kernel sum (not divided by the number of
+   *     reference points).
+   * @param tolerance Largest difference between the bounds of the kernel value
+   *     for which a node combination is pruned.
+   * @param lowerBounds Lower bounds of the kernel sums (initially zero).
+   * @param upperBounds Upper bounds of the kernel sums of the visited reference
+   *     points (initially zero).
+   * @param numVisited Number of reference points visited for each query point
+   *     (initially zero).
+   * @param labels Decision of each query point.
+   * @param distance Instantiated distance metric.
+   * @param kernel Instantiated kernel.
+   * @param sameSet True if query and reference sets are the same
+   *     (monochromatic evaluation).
+   */
+  KDEThresholdRules(const arma::mat& referenceSet,
+                    const arma::mat& querySet,
+                    const double threshold,
+                    const double tolerance,
+                    arma::vec& lowerBounds,
+                    arma::vec& upperBounds,
+                    arma::vec& numVisited,
+                    arma::Row<size_t>& labels,
+                    DistanceType& distance,
+                    KernelType& kernel,
+                    const bool sameSet);
+
+  //! Base Case.
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex);
+
+  //! Single-tree Score.
+  double Score(const size_t queryIndex, TreeType& referenceNode);
+
+  //! Single-tree Rescore.
+  double Rescore(const size_t /* queryIndex */,
+                 TreeType& /* referenceNode */,
+                 const double oldScore) const { return oldScore; }
+
+  //! Dual-tree Score.
+  double Score(TreeType& queryNode, TreeType& referenceNode);
+
+  //! Dual-tree Rescore.
+  double Rescore(TreeType& /* queryNode */,
+                 TreeType& /* referenceNode */,
+                 const double oldScore) const { return oldScore; }
+
+  using TraversalInfoType = mlpack::TraversalInfo<TreeType>;
+
+  //! Get traversal information.
+  const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
+  //! Modify traversal information.
+  TraversalInfoType& TraversalInfo() { return traversalInfo; }
+
+  //! Get the number of base cases.
+  size_t BaseCases() const { return baseCases; }
+  //! Modify the number of base cases.
+  size_t& BaseCases() { return baseCases; }
+
+  //! Get the number of scores.
+  size_t Scores() const { return scores; }
+  //! Modify the number of scores.
+  size_t& Scores() { return scores; }
+
+  //! Get the minimum number of base cases we need to perform to have acceptable
+  //! results.
+  size_t MinimumBaseCases() const { return 0; }
+
+ private:
+  //! Decide the given query point if its bounds allow it.
+  void Decide(const size_t queryIndex);
+
+  //! Return whether all the points of the given query node are decided.
+  bool Decided(TreeType& queryNode);
+
+  //! The reference set.
+  const arma::mat& referenceSet;
+  //! The query set.
+  const arma::mat& querySet;
+  //! The threshold of the kernel sum.
+  const double threshold;
+  //! The largest difference between the kernel bounds of a pruned combination.
+  const double tolerance;
+  //! The lower bounds of the kernel sums.
+  arma::vec& lowerBounds;
+  //! The upper bounds of the kernel sums of the visited reference points.
+  arma::vec& upperBounds;
+  //! The number of reference points visited for each query point.
+  arma::vec& numVisited;
+  //! The decisions.
+  arma::Row<size_t>& labels;
+  //! Instantiated distance metric.
+  DistanceType& distance;
+  //! Instantiated kernel.
+  KernelType& kernel;
+  //! Whether reference and query sets are the same.
+  const bool sameSet;
+  //! The largest value of the kernel.
+  const double maxKernelValue;
+
+  //! The last query node found to be decided (decisions are never undone).
+  const TreeType* lastDecidedNode;
+  //! The last query index.
+  size_t lastQueryIndex;
+  //! The last reference index.
+  size_t lastReferenceIndex;
+
+  //! Traversal information.
+  TraversalInfoType traversalInfo;
+  //! The number of base cases.
+  size_t baseCases;
+  //! The number of scores.
+  size_t scores;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "kde_threshold_rules_impl.hpp"
+
+#endif
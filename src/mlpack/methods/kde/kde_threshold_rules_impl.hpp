@@ -0,0 +1,202 @@
+/**
+ * @file methods/kde/kde_threshold_rules_impl.hpp
+ *
+ * Implementation of the rules for density classification with generic trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_THRESHOLD_RULES_IMPL_HPP
+#define MLPACK_METHODS_KDE_THRESHOLD_RULES_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kde_threshold_rules.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType, typename KernelType, typename TreeType>
+KDEThresholdRules<DistanceType, KernelType, TreeType>::KDEThresholdRules(
+    const arma::mat& referenceSet,
+    const arma::mat& querySet,
+    const double threshold,
+    const double tolerance,
+    arma::vec& lowerBounds,
+    arma::vec& upperBounds,
+    arma::vec& numVisited,
+    arma::Row<size_t>& labels,
+    DistanceType& distance,
+    KernelType& kernel,
+    const bool sameSet) :
+    referenceSet(referenceSet),
+    querySet(querySet),
+    threshold(threshold),
+    tolerance(tolerance),
+    lowerBounds(lowerBounds),
+    upperBounds(upperBounds),
+    numVisited(numVisited),
+    labels(labels),
+    distance(distance),
+    kernel(kernel),
+    sameSet(sameSet),
+    maxKernelValue(kernel.Evaluate(0.0)),
+    lastDecidedNode(NULL),
+    lastQueryIndex(querySet.n_cols),
+    lastReferenceIndex(referenceSet.n_cols),
+    baseCases(0),
+    scores(0)
+{
+  // Nothing to do.
+}
+
+template<typename DistanceType, typename KernelType, typename TreeType>
+inline mlpack_force_inline
+double KDEThresholdRules<DistanceType, KernelType, TreeType>::BaseCase(
+    const size_t queryIndex,
+    const size_t referenceIndex)
+{
+  // Nothing more needs to be done for decided points.
+  if (labels[queryIndex] != Undecided)
+    return 0.0;
+
+  // Avoid duplicated calculations.
+  if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
+    return 0.0;
+
+  lastQueryIndex = queryIndex;
+  lastReferenceIndex = referenceIndex;
+
+  // The estimation of a point with itself is not computed, but the point still
+  // counts as visited.
+  numVisited[queryIndex] += 1;
+  if (sameSet && (queryIndex == referenceIndex))
+  {
+    Decide(queryIndex);
+    return 0.0;
+  }
+
+  const double d = distance.Evaluate(querySet.col(queryIndex),
+                                     referenceSet.col(referenceIndex));
+  const double kernelValue = kernel.Evaluate(d);
+  lowerBounds[queryIndex] += kernelValue;
+  upperBounds[queryIndex] += kernelValue;
+  Decide(queryIndex);
+
+  ++baseCases;
+  MLPACK_PROFILE_COUNT(BaseCases, 1);
+  MLPACK_PROFILE_COUNT(DistanceEvaluations, 1);
+  traversalInfo.LastBaseCase() = d;
+  return d;
+}
+
+template<typename DistanceType, typename KernelType, typename TreeType>
+inline double KDEThresholdRules<DistanceType, KernelType, TreeType>::Score(
+    const size_t queryIndex,
+    TreeType& referenceNode)
+{
+  ++scores;
+  MLPACK_PROFILE_COUNT(Scores, 1);
+  if (labels[queryIndex] != Undecided)
+    return DBL_MAX;
+
+  const Range r = referenceNode.RangeDistance(querySet.unsafe_col(queryIndex));
+  const double maxKernel = kernel.Evaluate(r.Lo());
+  const double minKernel = kernel.Evaluate(r.Hi());
+  // In monochromatic mode, the reference node may contain the query point
+  // itself, which must not be counted.
+  if ((maxKernel - minKernel > tolerance) || (sameSet && r.Lo() == 0.0))
+    return r.Lo();
+
+  // The kernel values of all the descendants are known closely enough.
+  const size_t refNumDesc = referenceNode.NumDescendants();
+  lowerBounds[queryIndex] += refNumDesc * minKernel;
+  upperBounds[queryIndex] += refNumDesc * maxKernel;
+  numVisited[queryIndex] += refNumDesc;
+  Decide(queryIndex);
+  return DBL_MAX;
+}
+
+template<typename DistanceType, typename KernelType, typename TreeType>
+inline double KDEThresholdRules<DistanceType, KernelType, TreeType>::Score(
+    TreeType& queryNode,
+    TreeType& referenceNode)
+{
+  ++scores;
+  MLPACK_PROFILE_COUNT(Scores, 1);
+  traversalInfo.LastQueryNode() = &queryNode;
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  if (Decided(queryNode))
+  {
+    traversalInfo.LastScore() = DBL_MAX;
+    return DBL_MAX;
+  }
+
+  const Range r = queryNode.RangeDistance(referenceNode);
+  const double maxKernel = kernel.Evaluate(r.Lo());
+  const double minKernel = kernel.Evaluate(r.Hi());
+  // In monochromatic mode, the nodes may share points, which must not be
+  // counted with themselves.
+  if ((maxKernel - minKernel > tolerance) || (sameSet && r.Lo() == 0.0))
+  {
+    traversalInfo.LastScore() = r.Lo();
+    return r.Lo();
+  }
+
+  // The kernel values of all the pairs of descendants are known closely
+  // enough.
+  const size_t refNumDesc = referenceNode.NumDescendants();
+  for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+  {
+    const size_t queryIndex = queryNode.Descendant(i);
+    if (labels[queryIndex] != Undecided)
+      continue;
+
+    lowerBounds[queryIndex] += refNumDesc * minKernel;
+    upperBounds[queryIndex] += refNumDesc * maxKernel;
+    numVisited[queryIndex] += refNumDesc;
+    Decide(queryIndex);
+  }
+
+  traversalInfo.LastScore() = DBL_MAX;
+  return DBL_MAX;
+}
+
+template<typename DistanceType, typename KernelType, typename TreeType>
+inline mlpack_force_inline
+void KDEThresholdRules<DistanceType, KernelType, TreeType>::Decide(
+    const size_t queryIndex)
+{
+  if (lowerBounds[queryIndex] >= threshold)
+  {
+    labels[queryIndex] = 1;
+  }
+  else
+  {
+    // The reference points that have not been visited yet contribute at most
+    // the largest kernel value each.
+    const double unvisited = std::max(double(referenceSet.n_cols) -
+        numVisited[queryIndex], 0.0);
+    if (upperBounds[queryIndex] + unvisited * maxKernelValue < threshold)
+      labels[queryIndex] = 0;
+  }
+}
+
+template<typename DistanceType, typename KernelType, typename TreeType>
+inline bool KDEThresholdRules<DistanceType, KernelType, TreeType>::Decided(
+    TreeType& queryNode)
+{
+  if (&queryNode == lastDecidedNode)
+    return true;
+
+  for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+    if (labels[queryNode.Descendant(i)] == Undecided)
+      return false;
+
+  lastDecidedNode = &queryNode;
+  return true;
+}
+
+} // namespace mlpack
+
+#endif
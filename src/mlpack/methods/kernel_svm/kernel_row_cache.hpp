@@ -0,0 +1,128 @@
+/**
+ * @file methods/kernel_svm/kernel_row_cache.hpp
+ *
+ * Definition of KernelRowCache, a bounded least-recently-used cache of the
+ * rows of a kernel matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KERNEL_SVM_KERNEL_ROW_CACHE_HPP
+#define MLPACK_METHODS_KERNEL_SVM_KERNEL_ROW_CACHE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
+
+#include <list>
+
+namespace mlpack {
+
+/**
+ * A KernelRowCache holds the most recently used rows of the kernel matrix of a
+ * dataset, K(i, j) = kernel.Evaluate(data.col(i), data.col(j)), within a fixed
+ * memory budget.  Solvers like SMO need two rows of the kernel matrix per
+ * iteration, but the whole matrix is too large to store for more than a few
+ * tens of thousands of points; since the same rows tend to be used again and
+ * again, caching them saves most kernel evaluations.
+ *
+ * A missing row is computed with KernelMatrix(), in parallel (and with one
+ * matrix multiplication for kernels with a batch evaluation), and replaces the
+ * least recently used row when the cache is full.  The diagonal of the kernel
+ * matrix is computed once, when the cache is created.
+ *
+ * The kernel matrix is symmetric, so row i is also column i; it is stored
+ * contiguously.  A pointer returned by Row() stays valid until the row is
+ * evicted; since the cache always holds at least two rows, the last two rows
+ * returned are always valid.
+ *
+ * @tparam KernelType Type of kernel.
+ * @tparam MatType Type of the data matrix.
+ */
+template<typename KernelType, typename MatType = arma::mat>
+class KernelRowCache
+{
+ public:
+  //! The element type of the kernel values.
+  using ElemType = typename MatType::elem_type;
+
+  /**
+   * Create the cache for the given kernel and dataset, which must stay valid
+   * as long as the cache is used.
+   *
+   * @param kernel Kernel to evaluate.
+   * @param data Dataset (one column per point).
+   * @param cacheSize Maximum size of the cached rows, in megabytes; at least
+   *     two rows are always cached, and never more than the whole matrix.
+   */
+  KernelRowCache(KernelType& kernel,
+                 const MatType& data,
+                 const double cacheSize = 100.0);
+
+  /**
+   * Get row i of the kernel matrix (of length NumPoints()), computing it if it
+   * is not cached.
+   *
+   * @param i Index of the row.
+   */
+  const ElemType* Row(const size_t i);
+
+  /**
+   * Compute the columns of the kernel matrix for the given points, K(:,
+   * indices), without caching them.  This is meant for the occasional bulk
+   * computation, such as the reconstruction of the gradient after shrinking.
+   *
+   * @param indices Indices of the points.
+   * @param columns Matrix to store the columns in (NumPoints() x
+   *     indices.n_elem).
+   */
+  void Columns(const arma::uvec& indices, arma::Mat<ElemType>& columns);
+
+  //! Get the diagonal of the kernel matrix.
+  const arma::Col<ElemType>& Diagonal() const { return diagonal; }
+
+  //! Get the number of points of the dataset.
+  size_t NumPoints() const { return data.n_cols; }
+  //! Get the maximum number of rows held in the cache.
+  size_t Capacity() const { return rows.n_cols; }
+
+  //! Get the number of calls to Row() that found the row in the cache.
+  size_t Hits() const { return hits; }
+  //! Get the number of calls to Row() that had to compute the row.
+  size_t Misses() const { return misses; }
+
+ private:
+  //! The kernel.
+  KernelType& kernel;
+  //! The dataset.
+  const MatType& data;
+
+  //! The cached rows, one per column.
+  arma::Mat<ElemType> rows;
+  //! The point whose row is in each slot (SIZE_MAX if the slot is unused).
+  std::vector<size_t> slotPoint;
+  //! The slot of the row of each point (SIZE_MAX if not cached).
+  std::vector<size_t> pointSlot;
+  //! The slots in use, from the most to the least recently used.
+  std::list<size_t> order;
+  //! The position of each slot in use in `order`.
+  std::vector<std::list<size_t>::iterator> slotPosition;
+  //! The number of slots in use.
+  size_t usedSlots;
+
+  //! The diagonal of the kernel matrix.
+  arma::Col<ElemType> diagonal;
+
+  //! The number of cache hits.
+  size_t hits;
+  //! The number of cache misses.
+  size_t misses;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "kernel_row_cache_impl.hpp"
+
+#endif
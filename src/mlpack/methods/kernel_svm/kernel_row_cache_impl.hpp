@@ -0,0 +1,100 @@
+/**
+ * @file methods/kernel_svm/kernel_row_cache_impl.hpp
+ *
+ * Implementation of KernelRowCache.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KERNEL_SVM_KERNEL_ROW_CACHE_IMPL_HPP
+#define MLPACK_METHODS_KERNEL_SVM_KERNEL_ROW_CACHE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kernel_row_cache.hpp"
+
+namespace mlpack {
+
+template<typename KernelType, typename MatType>
+KernelRowCache<KernelType, MatType>::KernelRowCache(KernelType& kernel,
+                                                    const MatType& data,
+                                                    const double cacheSize) :
+    kernel(kernel),
+    data(data),
+    pointSlot(data.n_cols, SIZE_MAX),
+    usedSlots(0),
+    hits(0),
+    misses(0)
+{
+  const size_t n = data.n_cols;
+  const double rowBytes = double(std::max(n, size_t(1)) * sizeof(ElemType));
+  const size_t budgetRows = (size_t) (cacheSize * 1024.0 * 1024.0 / rowBytes);
+  const size_t capacity = std::max(size_t(2), std::min(n, budgetRows));
+
+  rows.set_size(n, capacity);
+  slotPoint.resize(capacity, SIZE_MAX);
+  slotPosition.resize(capacity);
+
+  diagonal.set_size(n);
+  #pragma omp parallel for
+  for (size_t i = 0; i < n; ++i)
+    diagonal[i] = kernel.Evaluate(data.col(i), data.col(i));
+}
+
+template<typename KernelType, typename MatType>
+const typename KernelRowCache<KernelType, MatType>::ElemType*
+KernelRowCache<KernelType, MatType>::Row(const size_t i)
+{
+  size_t slot = pointSlot[i];
+  if (slot != SIZE_MAX)
+  {
+    // Move the row to the front of the list.
+    ++hits;
+    order.splice(order.begin(), order, slotPosition[slot]);
+    return rows.colptr(slot);
+  }
+
+  ++misses;
+  if (usedSlots < rows.n_cols)
+  {
+    slot = usedSlots++;
+  }
+  else
+  {
+    // Evict the least recently used row.
+    slot = order.back();
+    order.pop_back();
+    pointSlot[slotPoint[slot]] = SIZE_MAX;
+  }
+
+  // The kernel matrix is symmetric, so row i is the kernel between the data
+  // and point i.
+  const MatType point(data.col(i));
+  arma::Mat<ElemType> row;
+  KernelMatrix(kernel, data, point, row);
+  rows.col(slot) = row;
+
+  slotPoint[slot] = i;
+  pointSlot[i] = slot;
+  order.push_front(slot);
+  slotPosition[slot] = order.begin();
+
+  return rows.colptr(slot);
+}
+
+template<typename KernelType, typename MatType>
+void KernelRowCache<KernelType, MatType>::Columns(
+    const arma::uvec& indices,
+    arma::Mat<ElemType>& columns)
+{
+  MatType points(data.n_rows, indices.n_elem);
+  for (size_t k = 0; k < indices.n_elem; ++k)
+    points.col(k) = data.col(indices[k]);
+
+  KernelMatrix(kernel, data, points, columns);
+}
+
+} // namespace mlpack
+
+#endif
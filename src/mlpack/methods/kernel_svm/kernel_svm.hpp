@@ -0,0 +1,252 @@
+/**
+ * @file methods/kernel_svm/kernel_svm.hpp
+ *
+ * Definition of KernelSVM, a soft-margin support vector machine with an
+ * arbitrary kernel, trained with SMO.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KERNEL_SVM_KERNEL_SVM_HPP
+#define MLPACK_METHODS_KERNEL_SVM_KERNEL_SVM_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
+
+#include "kernel_row_cache.hpp"
+#include "smo.hpp"
+
+namespace mlpack {
+
+/**
+ * The KernelSVM class implements a soft-margin support vector machine with any
+ * of mlpack's kernels (or any class with the same interface, see
+ * core/kernels/example_kernel.hpp):
+ *
+ * @code
+ * @article{cortes1995support,
+ *   title={Support-vector networks},
+ *   author={Cortes, Corinna and Vapnik, Vladimir},
+ *   journal={Machine Learning},
+ *   volume={20},
+ *   number={3},
+ *   pages={273--297},
+ *   year={1995}
+ * }
+ * @endcode
+ *
+ * The dual problem is solved with SMO (with the WSS-3 working set selection
+ * and shrinking heuristics of LIBSVM).  Training time is dominated by kernel
+ * evaluations, so the rows of the kernel matrix are kept in a bounded
+ * least-recently-used cache (KernelRowCache), whose size is given in
+ * megabytes, and each missing row is computed in parallel.
+ *
+ * With more than two classes, one binary classifier is trained for each class
+ * against all the others; the classifiers share the kernel cache, since the
+ * kernel matrix does not depend on the labels.  The support vectors of all the
+ * classifiers are stored once, with one column of coefficients alpha_i y_i
+ * per classifier.  Prediction computes the kernel matrix between all the
+ * support vectors and a batch of points at once, and then the decision values
+ * of all the classifiers with one matrix multiplication.
+ *
+ * An example:
+ *
+ * @code
+ * extern arma::mat data; // Training data, one column per point.
+ * extern arma::Row<size_t> labels; // Labels, between 0 and 2.
+ *
+ * // Gaussian kernel with bandwidth 0.5, and C = 10.
+ * KernelSVM<GaussianKernel> svm(data, labels, 3, 10.0, GaussianKernel(0.5));
+ *
+ * extern arma::mat testData;
+ * arma::Row<size_t> predictions;
+ * svm.Classify(testData, predictions);
+ * @endcode
+ *
+ * @tparam KernelType Type of kernel.
+ * @tparam MatType Type of the data matrix.
+ */
+template<typename KernelType = GaussianKernel, typename MatType = arma::mat>
+class KernelSVM
+{
+ public:
+  /**
+   * Create the model without training it.  Be sure to call Train() before
+   * Classify().
+   *
+   * @param c Cost of the slack variables (the upper bound of the dual
+   *     variables); larger values fit the training data more closely.
+   * @param kernel Kernel to use.
+   * @param tolerance Tolerance of SMO on the violation of the optimality
+   *     conditions.
+   * @param maxIterations Maximum number of SMO iterations for each binary
+   *     classifier (0 means no limit).
+   * @param cacheSize Size of the kernel row cache, in megabytes.
+   * @param shrinking Whether SMO uses the shrinking heuristics.
+   */
+  KernelSVM(const double c = 1.0,
+            const KernelType& kernel = KernelType(),
+            const double tolerance = 1e-3,
+            const size_t maxIterations = 10000000,
+            const double cacheSize = 100.0,
+            const bool shrinking = true);
+
+  /**
+   * Train the model on the given data and labels.  See the other constructor
+   * for the parameters.
+   *
+   * @param data Training data, one column per point.
+   * @param labels Labels of the points, between 0 and numClasses - 1.
+   * @param numClasses Number of classes (at least 2).
+   */
+  KernelSVM(const MatType& data,
+            const arma::Row<size_t>& labels,
+            const size_t numClasses,
+            const double c = 1.0,
+            const KernelType& kernel = KernelType(),
+            const double tolerance = 1e-3,
+            const size_t maxIterations = 10000000,
+            const double cacheSize = 100.0,
+            const bool shrinking = true);
+
+  /**
+   * Train the model on the given data and labels, with the parameters that
+   * are already set.  Any previous model is replaced.
+   *
+   * @param data Training data, one column per point.
+   * @param labels Labels of the points, between 0 and numClasses - 1.
+   * @param numClasses Number of classes (at least 2).
+   */
+  void Train(const MatType& data,
+             const arma::Row<size_t>& labels,
+             const size_t numClasses);
+
+  /**
+   * Classify the given points.
+   *
+   * @param data Points to classify.
+   * @param labels Vector to store the predicted labels in.
+   */
+  void Classify(const MatType& data, arma::Row<size_t>& labels) const;
+
+  /**
+   * Classify the given points, and store the decision values of the binary
+   * classifiers: with two classes, there is one row of decision values, which
+   * are positive for class 1; otherwise, row k holds the decision values of
+   * class k against all the others, and the predicted label is the class with
+   * the largest value.
+   *
+   * @param data Points to classify.
+   * @param labels Vector to store the predicted labels in.
+   * @param decisionValues Matrix to store the decision values in.
+   */
+  void Classify(const MatType& data,
+                arma::Row<size_t>& labels,
+                arma::mat& decisionValues) const;
+
+  /**
+   * Classify the given point.
+   *
+   * @param point Point to classify.
+   * @return Predicted label of the point.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Compute the accuracy of the model on the given data and labels, as the
+   * percentage of points whose label is predicted correctly.
+   *
+   * @param testData Points to classify.
+   * @param testLabels True labels of the points.
+   * @return Accuracy of the model (between 0 and 100).
+   */
+  double ComputeAccuracy(const MatType& testData,
+                         const arma::Row<size_t>& testLabels) const;
+
+  //! Get the number of classes.
+  size_t NumClasses() const { return numClasses; }
+
+  //! Get the cost of the slack variables.
+  double C() const { return c; }
+  //! Modify the cost of the slack variables.
+  double& C() { return c; }
+
+  //! Get the kernel.
+  const KernelType& Kernel() const { return kernel; }
+  //! Modify the kernel.
+  KernelType& Kernel() { return kernel; }
+
+  //! Get the tolerance of SMO.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance of SMO.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the maximum number of SMO iterations (0 means no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of SMO iterations (0 means no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the size of the kernel row cache, in megabytes.
+  double CacheSize() const { return cacheSize; }
+  //! Modify the size of the kernel row cache, in megabytes.
+  double& CacheSize() { return cacheSize; }
+
+  //! Get whether SMO uses the shrinking heuristics.
+  bool Shrinking() const { return shrinking; }
+  //! Modify whether SMO uses the shrinking heuristics.
+  bool& Shrinking() { return shrinking; }
+
+  //! Get the support vectors (one column per support vector).
+  const MatType& SupportVectors() const { return supportVectors; }
+  //! Get the coefficients alpha_i y_i of each support vector (one row) for
+  //! each binary classifier (one column).
+  const arma::mat& Coefficients() const { return coefficients; }
+  //! Get the bias of each binary classifier.
+  const arma::rowvec& Bias() const { return bias; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Compute the decision values of the binary classifiers for the given
+  //! points.
+  void DecisionValues(const MatType& data, arma::mat& decisionValues) const;
+
+  //! Number of points whose kernel values with all the support vectors are
+  //! computed at once in DecisionValues().
+  static constexpr size_t batchSize = 1024;
+
+  //! The number of classes.
+  size_t numClasses;
+  //! The cost of the slack variables.
+  double c;
+  //! The kernel.
+  KernelType kernel;
+  //! The tolerance of SMO.
+  double tolerance;
+  //! The maximum number of SMO iterations.
+  size_t maxIterations;
+  //! The size of the kernel row cache, in megabytes.
+  double cacheSize;
+  //! Whether SMO uses the shrinking heuristics.
+  bool shrinking;
+
+  //! The support vectors.
+  MatType supportVectors;
+  //! The coefficients of the support vectors for each binary classifier.
+  arma::mat coefficients;
+  //! The bias of each binary classifier.
+  arma::rowvec bias;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "kernel_svm_impl.hpp"
+
+#endif
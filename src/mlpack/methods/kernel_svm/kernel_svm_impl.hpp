@@ -0,0 +1,232 @@
+/**
+ * @file methods/kernel_svm/kernel_svm_impl.hpp
+ *
+ * Implementation of KernelSVM.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KERNEL_SVM_KERNEL_SVM_IMPL_HPP
+#define MLPACK_METHODS_KERNEL_SVM_KERNEL_SVM_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kernel_svm.hpp"
+
+namespace mlpack {
+
+template<typename KernelType, typename MatType>
+KernelSVM<KernelType, MatType>::KernelSVM(const double c,
+                                          const KernelType& kernel,
+                                          const double tolerance,
+                                          const size_t maxIterations,
+                                          const double cacheSize,
+                                          const bool shrinking) :
+    numClasses(0),
+    c(c),
+    kernel(kernel),
+    tolerance(tolerance),
+    maxIterations(maxIterations),
+    cacheSize(cacheSize),
+    shrinking(shrinking)
+{
+  // Nothing to do.
+}
+
+template<typename KernelType, typename MatType>
+KernelSVM<KernelType, MatType>::KernelSVM(const MatType& data,
+                                          const arma::Row<size_t>& labels,
+                                          const size_t numClasses,
+                                          const double c,
+                                          const KernelType& kernel,
+                                          const double tolerance,
+                                          const size_t maxIterations,
+                                          const double cacheSize,
+                                          const bool shrinking) :
+    KernelSVM(c, kernel, tolerance, maxIterations, cacheSize, shrinking)
+{
+  Train(data, labels, numClasses);
+}
+
+template<typename KernelType, typename MatType>
+void KernelSVM<KernelType, MatType>::Train(const MatType& data,
+                                           const arma::Row<size_t>& labels,
+                                           const size_t numClassesIn)
+{
+  if (numClassesIn < 2)
+  {
+    throw std::invalid_argument("KernelSVM::Train(): the number of classes "
+        "must be at least 2!");
+  }
+
+  util::CheckSameSizes(data, labels, "KernelSVM::Train()", "labels");
+
+  if (labels.n_elem > 0 && labels.max() >= numClassesIn)
+  {
+    std::ostringstream oss;
+    oss << "KernelSVM::Train(): labels must be between 0 and "
+        << numClassesIn - 1 << ", but label " << labels.max() << " was given!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (c <= 0.0)
+  {
+    throw std::invalid_argument("KernelSVM::Train(): C must be positive!");
+  }
+
+  numClasses = numClassesIn;
+  const size_t n = data.n_cols;
+
+  // With two classes, a single classifier separates class 1 from class 0;
+  // otherwise, there is one classifier per class.  All of them use the same
+  // kernel matrix, and so the same cache.
+  KernelRowCache<KernelType, MatType> cache(kernel, data, cacheSize);
+  SMO smo(tolerance, maxIterations, shrinking);
+
+  const size_t numClassifiers = (numClasses == 2) ? 1 : numClasses;
+  arma::mat allCoefficients(n, numClassifiers);
+  bias.set_size(numClassifiers);
+  for (size_t k = 0; k < numClassifiers; ++k)
+  {
+    const size_t positiveClass = (numClasses == 2) ? 1 : k;
+    arma::vec y(n);
+    for (size_t i = 0; i < n; ++i)
+      y[i] = (labels[i] == positiveClass) ? 1.0 : -1.0;
+
+    arma::vec alpha;
+    double b;
+    const size_t iterations = smo.Solve(cache, y, c, alpha, b);
+    Log::Info << "KernelSVM::Train(): classifier " << k << " converged in "
+        << iterations << " iterations." << std::endl;
+
+    allCoefficients.col(k) = alpha % y;
+    bias[k] = b;
+  }
+
+  Log::Info << "KernelSVM::Train(): " << cache.Hits() << " kernel cache hits, "
+      << cache.Misses() << " misses (capacity " << cache.Capacity()
+      << " rows)." << std::endl;
+
+  // Keep the points that are a support vector of any classifier.
+  const arma::uvec supportIndices = arma::find(
+      arma::any(allCoefficients != 0.0, 1));
+  supportVectors.set_size(data.n_rows, supportIndices.n_elem);
+  for (size_t k = 0; k < supportIndices.n_elem; ++k)
+    supportVectors.col(k) = data.col(supportIndices[k]);
+  coefficients = allCoefficients.rows(supportIndices);
+}
+
+template<typename KernelType, typename MatType>
+void KernelSVM<KernelType, MatType>::Classify(
+    const MatType& data,
+    arma::Row<size_t>& labels) const
+{
+  arma::mat decisionValues;
+  Classify(data, labels, decisionValues);
+}
+
+template<typename KernelType, typename MatType>
+void KernelSVM<KernelType, MatType>::Classify(
+    const MatType& data,
+    arma::Row<size_t>& labels,
+    arma::mat& decisionValues) const
+{
+  if (numClasses == 0)
+  {
+    throw std::invalid_argument("KernelSVM::Classify(): the model has not "
+        "been trained!");
+  }
+
+  if (data.n_rows != supportVectors.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "KernelSVM::Classify(): dimensionality of data (" << data.n_rows
+        << ") does not match the dimensionality of the model ("
+        << supportVectors.n_rows << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  DecisionValues(data, decisionValues);
+
+  if (numClasses == 2)
+  {
+    labels = arma::conv_to<arma::Row<size_t>>::from(decisionValues.row(0) >
+        0.0);
+  }
+  else
+  {
+    labels = arma::conv_to<arma::Row<size_t>>::from(
+        arma::index_max(decisionValues, 0));
+  }
+}
+
+template<typename KernelType, typename MatType>
+template<typename VecType>
+size_t KernelSVM<KernelType, MatType>::Classify(const VecType& point) const
+{
+  const MatType data(point);
+  arma::Row<size_t> labels;
+  Classify(data, labels);
+  return labels[0];
+}
+
+template<typename KernelType, typename MatType>
+double KernelSVM<KernelType, MatType>::ComputeAccuracy(
+    const MatType& testData,
+    const arma::Row<size_t>& testLabels) const
+{
+  arma::Row<size_t> labels;
+  Classify(testData, labels);
+
+  const size_t count = arma::accu(labels == testLabels);
+  return (double) 100.0 * count / labels.n_elem;
+}
+
+template<typename KernelType, typename MatType>
+void KernelSVM<KernelType, MatType>::DecisionValues(
+    const MatType& data,
+    arma::mat& decisionValues) const
+{
+  decisionValues.set_size(coefficients.n_cols, data.n_cols);
+
+  // KernelMatrix() may modify the kernel (to cache values), so use a copy.
+  KernelType batchKernel(kernel);
+  arma::Mat<typename MatType::elem_type> kernelValues;
+  for (size_t begin = 0; begin < data.n_cols; begin += batchSize)
+  {
+    const size_t end = std::min(begin + batchSize, (size_t) data.n_cols);
+    decisionValues.cols(begin, end - 1).each_col() = bias.t();
+    if (supportVectors.n_cols == 0)
+      continue;
+
+    // The kernel values between all the support vectors and all the points
+    // of the batch are computed at once, and then combined for all the
+    // classifiers with a single matrix multiplication.
+    const MatType batch = data.cols(begin, end - 1);
+    KernelMatrix(batchKernel, supportVectors, batch, kernelValues);
+    decisionValues.cols(begin, end - 1) += coefficients.t() *
+        arma::conv_to<arma::mat>::from(kernelValues);
+  }
+}
+
+template<typename KernelType, typename MatType>
+template<typename Archive>
+void KernelSVM<KernelType, MatType>::serialize(Archive& ar,
+                                               const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numClasses));
+  ar(CEREAL_NVP(c));
+  ar(CEREAL_NVP(kernel));
+  ar(CEREAL_NVP(tolerance));
+  ar(CEREAL_NVP(maxIterations));
+  ar(CEREAL_NVP(cacheSize));
+  ar(CEREAL_NVP(shrinking));
+  ar(CEREAL_NVP(supportVectors));
+  ar(CEREAL_NVP(coefficients));
+  ar(CEREAL_NVP(bias));
+}
+
+} // namespace mlpack
+
+#endif
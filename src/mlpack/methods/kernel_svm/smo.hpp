@@ -0,0 +1,169 @@
+/**
+ * @file methods/kernel_svm/smo.hpp
+ *
+ * Definition of SMO, the sequential minimal optimization solver for the dual
+ * problem of kernel support vector machines.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KERNEL_SVM_SMO_HPP
+#define MLPACK_METHODS_KERNEL_SVM_SMO_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "kernel_row_cache.hpp"
+
+namespace mlpack {
+
+/**
+ * SMO solves the dual problem of the binary soft-margin support vector
+ * machine,
+ *
+ *   min_a  (1/2) a^T Q a - e^T a   subject to  0 <= a_i <= C,  y^T a = 0,
+ *
+ * where Q_ij = y_i y_j K(x_i, x_j), with sequential minimal optimization: at
+ * each iteration two variables are chosen with the second order working set
+ * selection (WSS-3) of
+ *
+ * @code
+ * @article{fan2005working,
+ *   title={Working Set Selection Using Second Order Information for Training
+ *       Support Vector Machines},
+ *   author={Fan, R.-E. and Chen, P.-H. and Lin, C.-J.},
+ *   journal={Journal of Machine Learning Research},
+ *   volume={6},
+ *   pages={1889--1918},
+ *   year={2005}
+ * }
+ * @endcode
+ *
+ * and the subproblem on these two variables is solved analytically.  This is
+ * the algorithm of LIBSVM.  Each iteration needs two rows of the kernel
+ * matrix, which are taken from a KernelRowCache.
+ *
+ * With shrinking, the variables that are likely to stay at a bound are
+ * periodically removed from the working set selection and from the gradient
+ * updates; before the solver stops, the full gradient is reconstructed and the
+ * optimality conditions are checked on all the variables.
+ *
+ * The solver stops when the maximal violation of the optimality conditions,
+ * max_{I_up} -y_t G_t - min_{I_low} -y_t G_t, is below the tolerance.
+ */
+class SMO
+{
+ public:
+  /**
+   * Create the solver with the given parameters.
+   *
+   * @param tolerance Tolerance on the violation of the optimality conditions.
+   * @param maxIterations Maximum number of iterations (0 means no limit).
+   * @param shrinking Whether to use the shrinking heuristics.
+   */
+  SMO(const double tolerance = 1e-3,
+      const size_t maxIterations = 10000000,
+      const bool shrinking = true);
+
+  /**
+   * Solve the dual problem for the dataset of the given kernel cache and the
+   * given labels.
+   *
+   * @param cache Cache of the rows of the kernel matrix of the dataset.
+   * @param labels Labels of each point: +1 or -1.
+   * @param c Upper bound C of the dual variables (the cost of the slack
+   *     variables of the primal problem).
+   * @param alpha Vector to store the dual variables in.
+   * @param bias Variable to store the bias b of the decision function
+   *     f(x) = sum_i alpha_i y_i K(x_i, x) + b in.
+   * @return Number of iterations.
+   */
+  template<typename CacheType>
+  size_t Solve(CacheType& cache,
+               const arma::vec& labels,
+               const double c,
+               arma::vec& alpha,
+               double& bias);
+
+  //! Get the tolerance on the violation of the optimality conditions.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance on the violation of the optimality conditions.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the maximum number of iterations (0 means no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of iterations (0 means no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get whether the shrinking heuristics are used.
+  bool Shrinking() const { return shrinking; }
+  //! Modify whether the shrinking heuristics are used.
+  bool& Shrinking() { return shrinking; }
+
+ private:
+  //! Return whether variable t is at its upper bound.
+  bool IsUpperBound(const size_t t) const { return alpha[t] >= c; }
+  //! Return whether variable t is at its lower bound.
+  bool IsLowerBound(const size_t t) const { return alpha[t] <= 0.0; }
+
+  /**
+   * Select the working set (i, j) among the active variables with WSS-3.
+   * Return false if the active variables are optimal.
+   */
+  template<typename CacheType>
+  bool SelectWorkingSet(CacheType& cache, size_t& i, size_t& j);
+
+  /**
+   * Update the dual variables i and j by solving the two-variable
+   * subproblem, and update the gradient.
+   */
+  template<typename CacheType>
+  void Update(CacheType& cache, const size_t i, const size_t j);
+
+  //! Remove the variables that are likely to stay at a bound from the active
+  //! set.
+  template<typename CacheType>
+  void Shrink(CacheType& cache);
+
+  //! Compute the gradient of the inactive variables, and make all the
+  //! variables active again.
+  template<typename CacheType>
+  void ReconstructGradient(CacheType& cache);
+
+  //! Compute the bias of the decision function from the gradient.
+  double ComputeBias() const;
+
+  //! Tolerance on the violation of the optimality conditions.
+  double tolerance;
+  //! Maximum number of iterations.
+  size_t maxIterations;
+  //! Whether to use the shrinking heuristics.
+  bool shrinking;
+
+  // The state of the current Solve() call.
+
+  //! The labels (+1 or -1).
+  arma::vec y;
+  //! The upper bound of the dual variables.
+  double c;
+  //! The dual variables.
+  arma::vec alpha;
+  //! The gradient Q alpha - e of the dual objective.
+  arma::vec gradient;
+  //! The part of the gradient due to the variables at the upper bound,
+  //! sum_{j : alpha_j = C} C Q_tj (maintained for shrinking).
+  arma::vec gradientBar;
+  //! The indices of the active variables.
+  std::vector<size_t> active;
+  //! Whether the variables were made active again because the solver is near
+  //! the optimum.
+  bool unshrunk;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "smo_impl.hpp"
+
+#endif
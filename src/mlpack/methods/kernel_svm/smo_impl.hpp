@@ -0,0 +1,445 @@
+/**
+ * @file methods/kernel_svm/smo_impl.hpp
+ *
+ * Implementation of the SMO solver.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KERNEL_SVM_SMO_IMPL_HPP
+#define MLPACK_METHODS_KERNEL_SVM_SMO_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "smo.hpp"
+
+namespace mlpack {
+
+//! Value used instead of non-positive curvatures, as in LIBSVM.
+constexpr double SMOTau = 1e-12;
+
+inline SMO::SMO(const double tolerance,
+                const size_t maxIterations,
+                const bool shrinking) :
+    tolerance(tolerance),
+    maxIterations(maxIterations),
+    shrinking(shrinking),
+    c(0.0),
+    unshrunk(false)
+{
+  // Nothing to do.
+}
+
+template<typename CacheType>
+size_t SMO::Solve(CacheType& cache,
+                  const arma::vec& labels,
+                  const double cIn,
+                  arma::vec& alphaOut,
+                  double& bias)
+{
+  const size_t n = labels.n_elem;
+  if (cache.NumPoints() != n)
+  {
+    std::ostringstream oss;
+    oss << "SMO::Solve(): the kernel cache has " << cache.NumPoints()
+        << " points, but " << n << " labels were given!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  y = labels;
+  c = cIn;
+  alpha.zeros(n);
+  gradient.set_size(n);
+  gradient.fill(-1.0);
+  gradientBar.zeros(n);
+  active.resize(n);
+  std::iota(active.begin(), active.end(), 0);
+  unshrunk = false;
+
+  // Shrinking is done every min(n, 1000) iterations, like in LIBSVM.
+  const size_t shrinkInterval = std::min(n, size_t(1000));
+  size_t counter = shrinkInterval + 1;
+  size_t iteration = 0;
+  while (maxIterations == 0 || iteration < maxIterations)
+  {
+    if (shrinking && --counter == 0)
+    {
+      counter = shrinkInterval;
+      Shrink(cache);
+    }
+
+    size_t i, j;
+    if (!SelectWorkingSet(cache, i, j))
+    {
+      // The active variables are optimal; check all the variables.
+      if (active.size() == n)
+        break;
+
+      ReconstructGradient(cache);
+      if (!SelectWorkingSet(cache, i, j))
+        break;
+
+      // Shrink again at the next iteration.
+      counter = 1;
+    }
+
+    Update(cache, i, j);
+    ++iteration;
+  }
+
+  if (maxIterations != 0 && iteration == maxIterations)
+  {
+    Log::Warn << "SMO::Solve(): maximum number of iterations ("
+        << maxIterations << ") reached; the solution may not be optimal."
+        << std::endl;
+  }
+
+  ReconstructGradient(cache);
+  bias = ComputeBias();
+  alphaOut = std::move(alpha);
+  return iteration;
+}
+
+template<typename CacheType>
+bool SMO::SelectWorkingSet(CacheType& cache, size_t& i, size_t& j)
+{
+  const auto& diagonal = cache.Diagonal();
+
+  // First, i maximizes -y_t G_t over I_up.
+  double gMax = -std::numeric_limits<double>::infinity();
+  i = SIZE_MAX;
+  for (const size_t t : active)
+  {
+    if (y[t] == 1.0)
+    {
+      if (!IsUpperBound(t) && -gradient[t] >= gMax)
+      {
+        gMax = -gradient[t];
+        i = t;
+      }
+    }
+    else if (!IsLowerBound(t) && gradient[t] >= gMax)
+    {
+      gMax = gradient[t];
+      i = t;
+    }
+  }
+
+  // Then j minimizes the second order approximation of the decrease of the
+  // objective over the t of I_low with -y_t G_t < gMax.
+  double gMax2 = -std::numeric_limits<double>::infinity();
+  double minObjDiff = std::numeric_limits<double>::infinity();
+  j = SIZE_MAX;
+  const typename CacheType::ElemType* kernelI = (i == SIZE_MAX) ? nullptr :
+      cache.Row(i);
+  for (const size_t t : active)
+  {
+    double gradDiff;
+    if (y[t] == 1.0)
+    {
+      if (IsLowerBound(t))
+        continue;
+      gMax2 = std::max(gMax2, gradient[t]);
+      gradDiff = gMax + gradient[t];
+    }
+    else
+    {
+      if (IsUpperBound(t))
+        continue;
+      gMax2 = std::max(gMax2, -gradient[t]);
+      gradDiff = gMax - gradient[t];
+    }
+
+    if (gradDiff > 0.0 && kernelI != nullptr)
+    {
+      const double curvature = double(diagonal[i]) + double(diagonal[t]) -
+          2.0 * double(kernelI[t]);
+      const double objDiff = -(gradDiff * gradDiff) /
+          ((curvature > 0.0) ? curvature : SMOTau);
+      if (objDiff <= minObjDiff)
+      {
+        minObjDiff = objDiff;
+        j = t;
+      }
+    }
+  }
+
+  return (gMax + gMax2 >= tolerance && j != SIZE_MAX);
+}
+
+template<typename CacheType>
+void SMO::Update(CacheType& cache, const size_t i, const size_t j)
+{
+  const auto& diagonal = cache.Diagonal();
+  const typename CacheType::ElemType* kernelI = cache.Row(i);
+  const typename CacheType::ElemType* kernelJ = cache.Row(j);
+
+  const double oldAlphaI = alpha[i];
+  const double oldAlphaJ = alpha[j];
+  const double qij = y[i] * y[j] * double(kernelI[j]);
+
+  // Solve the subproblem in (alpha_i, alpha_j) along the constraint
+  // y_i alpha_i + y_j alpha_j = constant, and clip to the box.
+  if (y[i] != y[j])
+  {
+    double curvature = double(diagonal[i]) + double(diagonal[j]) + 2.0 * qij;
+    if (curvature <= 0.0)
+      curvature = SMOTau;
+    const double delta = (-gradient[i] - gradient[j]) / curvature;
+    const double diff = alpha[i] - alpha[j];
+    alpha[i] += delta;
+    alpha[j] += delta;
+
+    if (diff > 0.0)
+    {
+      if (alpha[j] < 0.0)
+      {
+        alpha[j] = 0.0;
+        alpha[i] = diff;
+      }
+      if (alpha[i] > c)
+      {
+        alpha[i] = c;
+        alpha[j] = c - diff;
+      }
+    }
+    else
+    {
+      if (alpha[i] < 0.0)
+      {
+        alpha[i] = 0.0;
+        alpha[j] = -diff;
+      }
+      if (alpha[j] > c)
+      {
+        alpha[j] = c;
+        alpha[i] = c + diff;
+      }
+    }
+  }
+  else
+  {
+    double curvature = double(diagonal[i]) + double(diagonal[j]) - 2.0 * qij;
+    if (curvature <= 0.0)
+      curvature = SMOTau;
+    const double delta = (gradient[i] - gradient[j]) / curvature;
+    const double sum = alpha[i] + alpha[j];
+    alpha[i] -= delta;
+    alpha[j] += delta;
+
+    if (sum > c)
+    {
+      if (alpha[i] > c)
+      {
+        alpha[i] = c;
+        alpha[j] = sum - c;
+      }
+      if (alpha[j] > c)
+      {
+        alpha[j] = c;
+        alpha[i] = sum - c;
+      }
+    }
+    else
+    {
+      if (alpha[j] < 0.0)
+      {
+        alpha[j] = 0.0;
+        alpha[i] = sum;
+      }
+      if (alpha[i] < 0.0)
+      {
+        alpha[i] = 0.0;
+        alpha[j] = sum;
+      }
+    }
+  }
+
+  // Update the gradient of the active variables:
+  // G_t += Q_ti dalpha_i + Q_tj dalpha_j.
+  const double scaledDeltaI = y[i] * (alpha[i] - oldAlphaI);
+  const double scaledDeltaJ = y[j] * (alpha[j] - oldAlphaJ);
+  for (const size_t t : active)
+  {
+    gradient[t] += y[t] * (scaledDeltaI * double(kernelI[t]) +
+        scaledDeltaJ * double(kernelJ[t]));
+  }
+
+  // Keep track of the contribution of the variables at the upper bound, which
+  // is needed to reconstruct the gradient of shrunk variables.
+  if (shrinking)
+  {
+    const size_t n = y.n_elem;
+    const bool wasUpperI = (oldAlphaI >= c);
+    const bool wasUpperJ = (oldAlphaJ >= c);
+    if (wasUpperI != IsUpperBound(i))
+    {
+      const double scale = (IsUpperBound(i) ? c : -c) * y[i];
+      for (size_t t = 0; t < n; ++t)
+        gradientBar[t] += scale * y[t] * double(kernelI[t]);
+    }
+    if (wasUpperJ != IsUpperBound(j))
+    {
+      const double scale = (IsUpperBound(j) ? c : -c) * y[j];
+      for (size_t t = 0; t < n; ++t)
+        gradientBar[t] += scale * y[t] * double(kernelJ[t]);
+    }
+  }
+}
+
+template<typename CacheType>
+void SMO::Shrink(CacheType& cache)
+{
+  // The largest violations of the optimality conditions, over I_up and I_low.
+  double gMax1 = -std::numeric_limits<double>::infinity();
+  double gMax2 = -std::numeric_limits<double>::infinity();
+  for (const size_t t : active)
+  {
+    if (y[t] == 1.0)
+    {
+      if (!IsUpperBound(t))
+        gMax1 = std::max(gMax1, -gradient[t]);
+      if (!IsLowerBound(t))
+        gMax2 = std::max(gMax2, gradient[t]);
+    }
+    else
+    {
+      if (!IsUpperBound(t))
+        gMax2 = std::max(gMax2, -gradient[t]);
+      if (!IsLowerBound(t))
+        gMax1 = std::max(gMax1, gradient[t]);
+    }
+  }
+
+  // Close to the optimum, make all the variables active once more, since
+  // some may have been shrunk too early.
+  if (!unshrunk && gMax1 + gMax2 <= tolerance * 10)
+  {
+    unshrunk = true;
+    ReconstructGradient(cache);
+  }
+
+  // A variable at a bound whose gradient points further outside of the box
+  // than the largest violation will most likely stay at the bound.
+  std::vector<size_t> newActive;
+  newActive.reserve(active.size());
+  for (const size_t t : active)
+  {
+    bool shrunk = false;
+    if (IsUpperBound(t))
+    {
+      shrunk = (y[t] == 1.0) ? (-gradient[t] > gMax1) :
+          (-gradient[t] > gMax2);
+    }
+    else if (IsLowerBound(t))
+    {
+      shrunk = (y[t] == 1.0) ? (gradient[t] > gMax2) :
+          (gradient[t] > gMax1);
+    }
+
+    if (!shrunk)
+      newActive.push_back(t);
+  }
+
+  active = std::move(newActive);
+}
+
+template<typename CacheType>
+void SMO::ReconstructGradient(CacheType& cache)
+{
+  const size_t n = y.n_elem;
+  if (active.size() == n)
+    return;
+
+  std::vector<bool> isActive(n, false);
+  for (const size_t t : active)
+    isActive[t] = true;
+
+  std::vector<size_t> inactive;
+  std::vector<size_t> free;
+  for (size_t t = 0; t < n; ++t)
+  {
+    if (!isActive[t])
+      inactive.push_back(t);
+    else if (!IsUpperBound(t) && !IsLowerBound(t))
+      free.push_back(t);
+  }
+
+  // G_t = Gbar_t - 1 + sum_{j free} alpha_j Q_tj.  The columns of the kernel
+  // matrix for the free variables are computed in blocks, in parallel.
+  for (const size_t t : inactive)
+    gradient[t] = gradientBar[t] - 1.0;
+
+  const size_t blockSize = 256;
+  arma::Mat<typename CacheType::ElemType> columns;
+  for (size_t begin = 0; begin < free.size(); begin += blockSize)
+  {
+    const size_t end = std::min(begin + blockSize, free.size());
+    arma::uvec indices(end - begin);
+    arma::vec weights(end - begin);
+    for (size_t k = begin; k < end; ++k)
+    {
+      indices[k - begin] = free[k];
+      weights[k - begin] = alpha[free[k]] * y[free[k]];
+    }
+
+    cache.Columns(indices, columns);
+    const arma::vec contributions =
+        arma::conv_to<arma::mat>::from(columns) * weights;
+    for (const size_t t : inactive)
+      gradient[t] += y[t] * contributions[t];
+  }
+
+  active.resize(n);
+  std::iota(active.begin(), active.end(), 0);
+}
+
+inline double SMO::ComputeBias() const
+{
+  // The bias is -rho, where rho is the average of y_t G_t over the free
+  // variables, or the middle of the feasible interval if there are none.
+  double upper = std::numeric_limits<double>::infinity();
+  double lower = -std::numeric_limits<double>::infinity();
+  double sumFree = 0.0;
+  size_t numFree = 0;
+  for (const size_t t : active)
+  {
+    const double yG = y[t] * gradient[t];
+    if (IsUpperBound(t))
+    {
+      if (y[t] == -1.0)
+        upper = std::min(upper, yG);
+      else
+        lower = std::max(lower, yG);
+    }
+    else if (IsLowerBound(t))
+    {
+      if (y[t] == 1.0)
+        upper = std::min(upper, yG);
+      else
+        lower = std::max(lower, yG);
+    }
+    else
+    {
+      sumFree += yG;
+      ++numFree;
+    }
+  }
+
+  double rho;
+  if (numFree > 0)
+    rho = sumFree / numFree;
+  else if (std::isinf(upper))
+    rho = lower;
+  else if (std::isinf(lower))
+    rho = upper;
+  else
+    rho = (upper + lower) / 2.0;
+
+  return -rho;
+}
+
+} // namespace mlpack
+
+#endif
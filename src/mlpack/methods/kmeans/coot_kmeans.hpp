@@ -0,0 +1,104 @@
+/**
+ * @file methods/kmeans/coot_kmeans.hpp
+ *
+ * A Lloyd step for k-means clustering that runs on a GPU with Bandicoot,
+ * computing the distances from each point to each centroid with matrix
+ * multiplications.  This file is only included when MLPACK_HAS_COOT is defined.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_COOT_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_COOT_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * A naive Lloyd step (every point is compared with every centroid) that runs
+ * on a GPU with Bandicoot.  The dataset is copied to the device once, when the
+ * object is constructed (or aliased, if it is already a Bandicoot matrix); in
+ * each iteration only the centroids are copied to the device, and the new
+ * centroids and counts back to the host.
+ *
+ * The points are processed in blocks.  For each block, the distances to the
+ * centroids are obtained from one matrix multiplication, using
+ *
+ *   || x - c ||^2 = || x ||^2 + || c ||^2 - 2 c^T x
+ *
+ * (the || x ||^2 term does not change the closest centroid and is skipped),
+ * and the closest centroid of each point is found with index_min().  The sums
+ * of the points of each cluster are then another matrix multiplication, with
+ * the 0/1 assignment matrix of the block.  So the whole step is made of dense
+ * operations on the device.
+ *
+ * Only the Euclidean distance (squared or not) is supported.
+ *
+ * @tparam DistanceType EuclideanDistance or SquaredEuclideanDistance.
+ * @tparam MatType Type of the dataset (e.g. arma::mat or arma::fmat); the
+ *     device copy has the same element type.
+ */
+template<typename DistanceType, typename MatType>
+class CootKMeans
+{
+ public:
+  //! The element type of the dataset.
+  using ElemType = typename MatType::elem_type;
+
+  static_assert(std::is_same_v<DistanceType, EuclideanDistance> ||
+      std::is_same_v<DistanceType, SquaredEuclideanDistance>,
+      "CootKMeans only supports the Euclidean distance.");
+
+  /**
+   * Construct the CootKMeans object, copying the dataset to the device.
+   *
+   * @param dataset Dataset.
+   * @param distance Instantiated distance metric.
+   */
+  CootKMeans(const MatType& dataset, DistanceType& distance);
+
+  /**
+   * Construct the CootKMeans object with a dataset that is already on the
+   * device; the dataset is not copied, so it must not be modified or destroyed
+   * while this object exists.
+   *
+   * @param dataset Dataset stored on the device.
+   * @param distance Instantiated distance metric.
+   */
+  CootKMeans(const coot::Mat<ElemType>& dataset, DistanceType& distance);
+
+  /**
+   * Run a single iteration of the Lloyd algorithm on the device, updating the
+   * given centroids into the newCentroids matrix.  If any cluster is empty,
+   * then the centroid associated with that cluster is left at zero (it will be
+   * corrected later).
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Number of points in each cluster at the end of the iteration.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+ private:
+  //! The dataset, on the device.
+  coot::Mat<ElemType> dataset;
+  //! The instantiated distance metric.
+  DistanceType& distance;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "coot_kmeans_impl.hpp"
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @file methods/kmeans/coot_kmeans_impl.hpp
+ *
+ * Implementation of the Bandicoot Lloyd step for k-means clustering.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_COOT_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_COOT_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "coot_kmeans.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType, typename MatType>
+CootKMeans<DistanceType, MatType>::CootKMeans(const MatType& dataset,
+                                              DistanceType& distance) :
+    dataset(coot::conv_to<coot::Mat<ElemType>>::from(dataset)),
+    distance(distance),
+    distanceCalculations(0)
+{ /* Nothing to do. */ }
+
+template<typename DistanceType, typename MatType>
+CootKMeans<DistanceType, MatType>::CootKMeans(
+    const coot::Mat<ElemType>& datasetIn,
+    DistanceType& distance) :
+    distance(distance),
+    distanceCalculations(0)
+{
+  MakeAlias(dataset, datasetIn, datasetIn.n_rows, datasetIn.n_cols);
+}
+
+// Run a single iteration.
+template<typename DistanceType, typename MatType>
+double CootKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
+                                                  arma::mat& newCentroids,
+                                                  arma::Col<size_t>& counts)
+{
+  const size_t k = centroids.n_cols;
+
+  const coot::Mat<ElemType> deviceCentroids =
+      coot::conv_to<coot::Mat<ElemType>>::from(
+      arma::conv_to<arma::Mat<ElemType>>::from(centroids));
+  const coot::Col<ElemType> centroidNorms =
+      trans(sum(square(deviceCentroids), 0));
+  const coot::Col<coot::uword> clusters =
+      coot::linspace<coot::Col<coot::uword>>(0, k - 1, k);
+
+  coot::Mat<ElemType> sums(dataset.n_rows, k, coot::fill::zeros);
+  coot::Col<coot::uword> deviceCounts(k, coot::fill::zeros);
+
+  // Each block holds k x blockSize distances; this bounds the temporary device
+  // memory to 2^24 elements per matrix.
+  const size_t blockSize = std::max((size_t) 1, ((size_t) 1 << 24) / k);
+  for (size_t begin = 0; begin < dataset.n_cols; begin += blockSize)
+  {
+    const size_t count = std::min(blockSize, (size_t) dataset.n_cols - begin);
+    coot::Mat<ElemType> block;
+    MakeAlias(block, dataset, dataset.n_rows, count, begin * dataset.n_rows);
+
+    // Column j holds the squared distances of point j to each centroid, minus
+    // the squared norm of point j.
+    coot::Mat<ElemType> distances = -2 * (trans(deviceCentroids) * block);
+    distances.each_col() += centroidNorms;
+    const coot::Mat<coot::uword> assignments = index_min(distances, 0);
+
+    // Element (i, j) of the assignment matrix is 1 if point j is in cluster i.
+    const coot::Mat<coot::uword> assignment = (repmat(clusters, 1, count) ==
+        repmat(assignments, k, 1));
+    sums += block * trans(coot::conv_to<coot::Mat<ElemType>>::from(assignment));
+    deviceCounts += sum(assignment, 1);
+  }
+
+  newCentroids = arma::conv_to<arma::mat>::from(
+      coot::conv_to<arma::Mat<ElemType>>::from(sums));
+  counts = arma::conv_to<arma::Col<size_t>>::from(
+      coot::conv_to<arma::Col<coot::uword>>::from(deviceCounts));
+
+  // Now normalize the centroids.
+  for (size_t i = 0; i < k; ++i)
+    if (counts(i) != 0)
+      newCentroids.col(i) /= counts(i);
+
+  distanceCalculations += k * dataset.n_cols;
+
+  // Calculate cluster distortion for this iteration.
+  double cNorm = 0.0;
+  for (size_t i = 0; i < k; ++i)
+  {
+    cNorm += std::pow(distance.Evaluate(centroids.col(i), newCentroids.col(i)),
+        2.0);
+  }
+  distanceCalculations += k;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace mlpack
+
+#endif
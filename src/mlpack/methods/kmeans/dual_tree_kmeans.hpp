@@ -101,7 +101,9 @@ class DualTreeKMeans
 
   arma::Row<size_t> assignments;
 
-  std::vector<bool> visited; // Was the point visited this iteration?
+  // Was the point visited this iteration?  This is not a std::vector<bool>,
+  // so that it can be written by the threads of a parallel traversal.
+  std::vector<char> visited;
 
   arma::mat lastIterationCentroids; // For sanity checks.
 
@@ -157,6 +159,27 @@ void RestoreChildren(TreeType& node,
                      const typename std::enable_if_t<TreeTraits<
                          TreeType>::BinaryTree>* junk = 0);
 
+//! The traverser used by DualTreeKMeans.  Binary trees use the
+//! ParallelBreadthFirstDualTreeTraverser, which traverses the subtrees of large
+//! query nodes in parallel.
+template<typename TreeType,
+         typename RuleType,
+         bool BinaryTree = TreeTraits<TreeType>::BinaryTree>
+struct DualTreeKMeansTraverser
+{
+  using type = typename TreeType::template
+      ParallelBreadthFirstDualTreeTraverser<RuleType>;
+};
+
+//! Other trees (such as the cover tree, whose nodes are their own children)
+//! use their BreadthFirstDualTreeTraverser.
+template<typename TreeType, typename RuleType>
+struct DualTreeKMeansTraverser<TreeType, RuleType, false>
+{
+  using type =
+      typename TreeType::template BreadthFirstDualTreeTraverser<RuleType>;
+};
+
 //! A template typedef for the DualTreeKMeans algorithm with the default tree
 //! type (a kd-tree).
 template<typename DistanceType, typename MatType>
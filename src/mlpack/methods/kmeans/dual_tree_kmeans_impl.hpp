@@ -148,8 +148,7 @@ double DualTreeKMeans<DistanceType, MatType, TreeType>::Iterate(
       upperBounds, lowerBounds, distance, prunedPoints, oldFromNewCentroids,
       visited);
 
-  typename Tree::template BreadthFirstDualTreeTraverser<RuleType>
-      traverser(rules);
+  typename DualTreeKMeansTraverser<Tree, RuleType>::type traverser(rules);
 
   CoalesceTree(*tree);
 
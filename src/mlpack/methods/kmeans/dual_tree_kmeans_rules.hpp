@@ -30,7 +30,7 @@ class DualTreeKMeansRules
                       DistanceType& distance,
                       const std::vector<bool>& prunedPoints,
                       const std::vector<size_t>& oldFromNewCentroids,
-                      std::vector<bool>& visited);
+                      std::vector<char>& visited);
 
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
@@ -70,7 +70,7 @@ class DualTreeKMeansRules
 
   const std::vector<size_t>& oldFromNewCentroids;
 
-  std::vector<bool>& visited;
+  std::vector<char>& visited;
 
   size_t baseCases;
   size_t scores;
@@ -12,8 +12,20 @@
 #ifndef MLPACK_METHODS_KMEANS_ELKAN_KMEANS_HPP
 #define MLPACK_METHODS_KMEANS_ELKAN_KMEANS_HPP
 
+#include "sparse_centroid_distances.hpp"
+
 namespace mlpack {
 
+/**
+ * An implementation of Elkan's algorithm for a single Lloyd iteration, which
+ * uses the triangle inequality to avoid most distance calculations.  For sparse
+ * datasets with the Euclidean distance, the remaining distances between points
+ * and centroids are computed from sparse inner products, so that the points
+ * are never densified.
+ *
+ * @param DistanceType Type of distance metric used with this implementation.
+ * @param MatType Matrix type (arma::mat or arma::sp_mat).
+ */
 template<typename DistanceType, typename MatType>
 class ElkanKMeans
 {
@@ -38,6 +50,11 @@ class ElkanKMeans
   size_t DistanceCalculations() const { return distanceCalculations; }
 
  private:
+  //! Compute the distance between point i and centroid c.
+  double PointDistance(const arma::mat& centroids,
+                       const size_t i,
+                       const size_t c) const;
+
   //! The dataset.
   const MatType& dataset;
   //! The instantiated distance metric.
@@ -56,6 +73,11 @@ class ElkanKMeans
   //! Lower bounds on the distance between each point and each cluster.
   arma::mat lowerBounds;
 
+  //! Squared norms of the points, if the dataset is sparse.
+  arma::vec pointNorms;
+  //! Squared norms of the current centroids, if the dataset is sparse.
+  arma::vec centroidNorms;
+
   //! Track distance calculations.
   size_t distanceCalculations;
 };
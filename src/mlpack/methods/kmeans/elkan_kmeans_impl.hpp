@@ -24,7 +24,26 @@ ElkanKMeans<DistanceType, MatType>::ElkanKMeans(const MatType& dataset,
     distance(distance),
     distanceCalculations(0)
 {
-  // Nothing to do here.
+  if constexpr (UseSparseCentroidDistances<DistanceType, MatType>::value)
+    SparsePointNorms(dataset, pointNorms);
+}
+
+// Compute the distance between point i and centroid c.
+template<typename DistanceType, typename MatType>
+inline double ElkanKMeans<DistanceType, MatType>::PointDistance(
+    const arma::mat& centroids,
+    const size_t i,
+    const size_t c) const
+{
+  if constexpr (UseSparseCentroidDistances<DistanceType, MatType>::value)
+  {
+    return SparseCentroidDistance<DistanceType>(dataset, i, pointNorms[i],
+        centroids, c, centroidNorms[c]);
+  }
+  else
+  {
+    return distance.Evaluate(dataset.col(i), centroids.col(c));
+  }
 }
 
 // Run a single iteration of Elkan's algorithm for Lloyd iterations.
@@ -45,19 +64,27 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
   // being the closest cluster centroid.
   clusterDistances.diag().fill(DBL_MAX);
 
-  // Initially set r(x) to true.
-  std::vector<bool> mustRecalculate(dataset.n_cols, true);
+  // Initially set r(x) to true.  (One byte per point, since the points are
+  // updated in parallel.)
+  std::vector<char> mustRecalculate(dataset.n_cols, true);
 
-  // If this is the first iteration, we must reset all the bounds.
+  // If this is the first iteration, we must reset all the bounds.  They are
+  // filled with the same static schedule as the loop over the points below, so
+  // that each thread first touches (and, on NUMA systems, places on its own
+  // node) the bounds that it will update.
   if (lowerBounds.n_rows != centroids.n_cols)
   {
     lowerBounds.set_size(centroids.n_cols, dataset.n_cols);
     assignments.set_size(dataset.n_cols);
     upperBounds.set_size(dataset.n_cols);
 
-    lowerBounds.fill(0);
-    upperBounds.fill(DBL_MAX);
-    assignments.fill(0);
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+    {
+      lowerBounds.col(i).zeros();
+      upperBounds[i] = DBL_MAX;
+      assignments[i] = 0;
+    }
   }
 
   // Step 1: for all centers, compute between-cluster distances.  For all
@@ -79,8 +106,11 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
   // that this is equivalent to s(c) for each cluster c.
   minClusterDistances = 0.5 * min(clusterDistances).t();
 
+  if constexpr (UseSparseCentroidDistances<DistanceType, MatType>::value)
+    centroidNorms = arma::sum(arma::square(centroids), 0).t();
+
   // Now loop over all points, and see which ones need to be updated.
-  #pragma omp parallel for schedule(dynamic) reduction(matAdd: newCentroids) \
+  #pragma omp parallel for schedule(static) reduction(matAdd: newCentroids) \
       reduction(colAdd: counts) reduction(+: distanceCalculations)
   for (size_t i = 0; i < dataset.n_cols; ++i)
   {
@@ -89,7 +119,7 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
     {
       // No change needed.  This point must still belong to that cluster.
       counts(assignments[i])++;
-      newCentroids.col(assignments[i]) += arma::vec(dataset.col(i));
+      AddPoint(dataset, i, newCentroids, assignments[i]);
     }
     else
     {
@@ -112,8 +142,7 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
         if (mustRecalculate[i])
         {
           mustRecalculate[i] = false;
-          dist = distance.Evaluate(dataset.col(i),
-                                   centroids.col(assignments[i]));
+          dist = PointDistance(centroids, i, assignments[i]);
           lowerBounds(assignments[i], i) = dist;
           upperBounds(i) = dist;
           distanceCalculations++;
@@ -135,8 +164,7 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
             dist > 0.5 * clusterDistances(assignments[i], c))
         {
           // Compute d(x, c).  If d(x, c) < d(x, c(x)) then assign c(x) = c.
-          const double pointDist = distance.Evaluate(dataset.col(i),
-                                                     centroids.col(c));
+          const double pointDist = PointDistance(centroids, i, c);
           lowerBounds(c, i) = pointDist;
           distanceCalculations++;
           if (pointDist < dist)
@@ -150,7 +178,7 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
       // At this point, we know the new cluster assignment.
       // Step 4: for each center c, let m(c) be the mean of the points
       // assigned to c.
-      newCentroids.col(assignments[i]) += arma::vec(dataset.col(i));
+      AddPoint(dataset, i, newCentroids, assignments[i]);
       counts[assignments[i]]++;
     }
   }
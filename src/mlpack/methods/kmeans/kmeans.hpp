@@ -17,6 +17,7 @@
 // Include initialization strategies.
 #include "sample_initialization.hpp"
 #include "kmeans_plus_plus_initialization.hpp"
+#include "kmeans_parallel_initialization.hpp"
 #include "random_partition.hpp"
 
 // Include empty cluster policies.
@@ -30,6 +31,11 @@
 #include "elkan_kmeans.hpp"
 #include "hamerly_kmeans.hpp"
 #include "pelleg_moore_kmeans.hpp"
+#include "yinyang_kmeans.hpp"
+#include "spherical_kmeans.hpp"
+#ifdef MLPACK_HAS_COOT
+  #include "coot_kmeans.hpp"
+#endif
 
 namespace mlpack {
 
@@ -72,7 +78,8 @@ namespace mlpack {
  * @tparam LloydStepType Implementation of single Lloyd step to use.
  *
  * @see RandomPartition, SampleInitialization, RefinedStart, AllowEmptyClusters,
- *      MaxVarianceNewCluster, NaiveKMeans, ElkanKMeans
+ *      MaxVarianceNewCluster, NaiveKMeans, ElkanKMeans, YinyangKMeans,
+ *      SphericalKMeans, CootKMeans
  */
 template<typename DistanceType = EuclideanDistance,
          typename InitialPartitionPolicy = SampleInitialization,
@@ -185,7 +185,7 @@ Cluster(const MatType& data,
       centroids.zeros(data.n_rows, clusters);
       for (size_t i = 0; i < data.n_cols; ++i)
       {
-        centroids.col(assignments[i]) += arma::vec(data.col(i));
+        AddPoint(data, i, centroids, assignments[i]);
         counts[assignments[i]]++;
       }
 
@@ -289,7 +289,7 @@ Cluster(const MatType& data,
     centroids.zeros(data.n_rows, clusters);
     for (size_t i = 0; i < data.n_cols; ++i)
     {
-      centroids.col(assignments[i]) += arma::vec(data.col(i));
+      AddPoint(data, i, centroids, assignments[i]);
       counts[assignments[i]]++;
     }
 
@@ -304,6 +304,14 @@ Cluster(const MatType& data,
   // Calculate final assignments in parallel over the entire dataset.
   assignments.set_size(data.n_cols);
 
+  // For sparse data, the distances are computed from sparse inner products.
+  arma::vec pointNorms, centroidNorms;
+  if constexpr (UseSparseCentroidDistances<DistanceType, MatType>::value)
+  {
+    SparsePointNorms(data, pointNorms);
+    centroidNorms = arma::sum(arma::square(centroids), 0).t();
+  }
+
   #pragma omp parallel for
   for (size_t i = 0; i < (size_t) data.n_cols; ++i)
   {
@@ -313,7 +321,16 @@ Cluster(const MatType& data,
 
     for (size_t j = 0; j < centroids.n_cols; ++j)
     {
-      const double dist = distance.Evaluate(data.col(i), centroids.col(j));
+      double dist;
+      if constexpr (UseSparseCentroidDistances<DistanceType, MatType>::value)
+      {
+        dist = SparseCentroidDistance<DistanceType>(data, i, pointNorms[i],
+            centroids, j, centroidNorms[j]);
+      }
+      else
+      {
+        dist = distance.Evaluate(data.col(i), centroids.col(j));
+      }
 
       if (dist < minDistance)
       {
@@ -21,10 +21,12 @@
 #include "kill_empty_clusters.hpp"
 #include "refined_start.hpp"
 #include "kmeans_plus_plus_initialization.hpp"
+#include "kmeans_parallel_initialization.hpp"
 #include "elkan_kmeans.hpp"
 #include "hamerly_kmeans.hpp"
 #include "pelleg_moore_kmeans.hpp"
 #include "dual_tree_kmeans.hpp"
+#include "yinyang_kmeans.hpp"
 
 using namespace mlpack;
 using namespace mlpack::util;
@@ -49,7 +51,10 @@ BINDING_LONG_DESC(
     "\n\n"
     "Optionally, the strategy to choose initial centroids can be specified.  "
     "The k-means++ algorithm can be used to choose initial centroids with "
-    "the " + PRINT_PARAM_STRING("kmeans_plus_plus") + " parameter.  The "
+    "the " + PRINT_PARAM_STRING("kmeans_plus_plus") + " parameter, and its "
+    "scalable variant k-means||, which samples candidate centroids in a few "
+    "parallel passes over the data, can be used with the " +
+    PRINT_PARAM_STRING("kmeans_parallel") + " parameter.  The "
     "Bradley and Fayyad approach (\"Refining initial points for k-means "
     "clustering\", 1998) can be used to select initial points by specifying "
     "the " + PRINT_PARAM_STRING("refined_start") + " parameter.  This approach "
@@ -64,9 +69,10 @@ BINDING_LONG_DESC(
     " option.  The standard O(kN) approach can be used ('naive').  Other "
     "options include the Pelleg-Moore tree-based algorithm ('pelleg-moore'), "
     "Elkan's triangle-inequality based algorithm ('elkan'), Hamerly's "
-    "modification to Elkan's algorithm ('hamerly'), the dual-tree k-means "
-    "algorithm ('dualtree'), and the dual-tree k-means algorithm using the "
-    "cover tree ('dualtree-covertree')."
+    "modification to Elkan's algorithm ('hamerly'), the Yinyang algorithm, "
+    "which is suited to large numbers of clusters ('yinyang'), the dual-tree "
+    "k-means algorithm ('dualtree'), and the dual-tree k-means algorithm using "
+    "the cover tree ('dualtree-covertree')."
     "\n\n"
     "The behavior for when an empty cluster is encountered can be modified with"
     " the " + PRINT_PARAM_STRING("allow_empty_clusters") + " option.  When "
@@ -118,6 +124,9 @@ BINDING_SEE_ALSO("Accelerating exact k-means algorithms with geometric"
     "ftp/usr0/ftp/2000/CMU-CS-00-105.pdf");
 BINDING_SEE_ALSO("A dual-tree algorithm for fast k-means clustering with large "
     "k (pdf)", "http://www.ratml.org/pub/pdf/2017dual.pdf");
+BINDING_SEE_ALSO("Yinyang k-means: A drop-in replacement of the classic "
+    "k-means with consistent speedup (pdf)",
+    "https://proceedings.mlr.press/v37/ding15.pdf");
 BINDING_SEE_ALSO("KMeans class documentation",
     "@src/mlpack/methods/kmeans/kmeans.hpp");
 
@@ -155,9 +164,11 @@ PARAM_DOUBLE_IN("percentage", "Percentage of dataset to use for each refined "
     "start sampling (use when --refined_start is specified).", "p", 0.02);
 PARAM_FLAG("kmeans_plus_plus", "Use the k-means++ initialization strategy to "
     "choose initial points.", "K");
+PARAM_FLAG("kmeans_parallel", "Use the k-means|| (scalable k-means++) "
+    "initialization strategy to choose initial points.", "");
 
 PARAM_STRING_IN("algorithm", "Algorithm to use for the Lloyd iteration "
-    "('naive', 'pelleg-moore', 'elkan', 'hamerly', 'dualtree', or "
+    "('naive', 'pelleg-moore', 'elkan', 'hamerly', 'yinyang', 'dualtree', or "
     "'dualtree-covertree').", "a", "naive");
 
 // Given the type of initial partition policy, figure out the empty cluster
@@ -190,7 +201,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   else
     RandomSeed((size_t) std::time(NULL));
 
-  RequireOnlyOnePassed(params, { "refined_start", "kmeans_plus_plus" }, true,
+  RequireOnlyOnePassed(params, { "refined_start", "kmeans_plus_plus",
+      "kmeans_parallel" }, true,
       "Only one initialization strategy can be specified!", true);
 
   // Now, start building the KMeans type that we'll be using.  Start with the
@@ -214,6 +226,11 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     FindEmptyClusterPolicy<KMeansPlusPlusInitialization>(params, timers,
         KMeansPlusPlusInitialization());
   }
+  else if (params.Has("kmeans_parallel"))
+  {
+    FindEmptyClusterPolicy<KMeansParallelInitialization>(params, timers,
+        KMeansParallelInitialization());
+  }
   else
   {
     FindEmptyClusterPolicy<SampleInitialization>(params, timers,
@@ -260,8 +277,8 @@ void FindLloydStepType(util::Params& params,
                        const InitialPartitionPolicy& ipp)
 {
   RequireParamInSet<string>(params, "algorithm", { "elkan", "hamerly",
-      "pelleg-moore", "dualtree", "dualtree-covertree", "naive" }, true,
-      "unknown k-means algorithm");
+      "yinyang", "pelleg-moore", "dualtree", "dualtree-covertree", "naive" },
+      true, "unknown k-means algorithm");
 
   const string algorithm = params.Get<string>("algorithm");
   if (algorithm == "elkan")
@@ -274,6 +291,11 @@ void FindLloydStepType(util::Params& params,
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, HamerlyKMeans>(
         params, timers, ipp);
   }
+  else if (algorithm == "yinyang")
+  {
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, YinyangKMeans>(
+        params, timers, ipp);
+  }
   else if (algorithm == "pelleg-moore")
   {
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy,
@@ -0,0 +1,137 @@
+/**
+ * @file methods/kmeans/kmeans_parallel_initialization.hpp
+ *
+ * This file defines the k-means|| (scalable k-means++) initialization
+ * strategy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * This class implements the k-means|| initialization, as described in the
+ * following paper:
+ *
+ * @code
+ * @article{bahmani2012scalable,
+ *   title={Scalable k-means++},
+ *   author={Bahmani, Bahman and Moseley, Benjamin and Vattani, Andrea and
+ *       Kumar, Ravi and Vassilvitskii, Sergei},
+ *   journal={Proceedings of the VLDB Endowment},
+ *   volume={5},
+ *   number={7},
+ *   pages={622--633},
+ *   year={2012}
+ * }
+ * @endcode
+ *
+ * Instead of choosing the k centroids one at a time, like k-means++ does, a
+ * few rounds are run; in each round, every point is sampled independently (in
+ * parallel) with probability proportional to its squared distance to the
+ * closest candidate.  About oversamplingFactor * k candidates are added in each
+ * round.  The candidates are then weighted by the number of points closest to
+ * them and clustered into k centroids with a weighted k-means++ and a few
+ * weighted Lloyd iterations.  This only takes a few passes over the data,
+ * instead of k.
+ *
+ * In accordance with mlpack's InitialPartitionPolicy template type, we only
+ * need to implement a constructor and a method to compute the initial
+ * centroids.
+ */
+class KMeansParallelInitialization
+{
+ public:
+  /**
+   * Create the KMeansParallelInitialization object, optionally specifying the
+   * number of sampling rounds, the oversampling factor (the expected number of
+   * candidates sampled in each round, as a multiple of the number of clusters),
+   * and the number of weighted Lloyd iterations used to recluster the
+   * candidates.
+   */
+  KMeansParallelInitialization(const size_t rounds = 5,
+                               const double oversamplingFactor = 2.0,
+                               const size_t lloydIterations = 10) :
+      rounds(rounds),
+      oversamplingFactor(oversamplingFactor),
+      lloydIterations(lloydIterations) { }
+
+  /**
+   * Initialize the centroids matrix with the k-means|| algorithm.
+   *
+   * @param data Dataset.
+   * @param clusters Number of clusters.
+   * @param centroids Matrix to put initial centroids into.
+   */
+  template<typename MatType>
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids) const;
+
+  //! Get the number of sampling rounds.
+  size_t Rounds() const { return rounds; }
+  //! Modify the number of sampling rounds.
+  size_t& Rounds() { return rounds; }
+
+  //! Get the oversampling factor.
+  double OversamplingFactor() const { return oversamplingFactor; }
+  //! Modify the oversampling factor.
+  double& OversamplingFactor() { return oversamplingFactor; }
+
+  //! Get the number of weighted Lloyd iterations run on the candidates.
+  size_t LloydIterations() const { return lloydIterations; }
+  //! Modify the number of weighted Lloyd iterations run on the candidates.
+  size_t& LloydIterations() { return lloydIterations; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(rounds));
+    ar(CEREAL_NVP(oversamplingFactor));
+    ar(CEREAL_NVP(lloydIterations));
+  }
+
+ private:
+  /**
+   * Update the squared distance of each point to its closest candidate, and
+   * the index of that candidate, with the candidates starting at the given
+   * index.
+   */
+  template<typename MatType>
+  static void UpdateDistances(const MatType& data,
+                              const arma::mat& candidates,
+                              const size_t firstCandidate,
+                              arma::vec& minDistances,
+                              arma::Col<size_t>& closestCandidates);
+
+  /**
+   * Cluster the given weighted candidates into the given number of centroids,
+   * with a weighted k-means++ followed by weighted Lloyd iterations.
+   */
+  void ClusterCandidates(const arma::mat& candidates,
+                         const arma::vec& weights,
+                         const size_t clusters,
+                         arma::mat& centroids) const;
+
+  //! The number of sampling rounds.
+  size_t rounds;
+  //! The oversampling factor.
+  double oversamplingFactor;
+  //! The number of weighted Lloyd iterations run on the candidates.
+  size_t lloydIterations;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "kmeans_parallel_initialization_impl.hpp"
+
+#endif
@@ -0,0 +1,217 @@
+/**
+ * @file methods/kmeans/kmeans_parallel_initialization_impl.hpp
+ *
+ * Implementation of the k-means|| (scalable k-means++) initialization
+ * strategy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kmeans_parallel_initialization.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+void KMeansParallelInitialization::Cluster(const MatType& data,
+                                           const size_t clusters,
+                                           arma::mat& centroids) const
+{
+  // The candidates; the first one is sampled fully randomly.
+  std::vector<size_t> candidateIndices;
+  candidateIndices.push_back(RandInt(0, data.n_cols));
+  arma::mat candidates(data.n_rows, 1);
+  candidates.col(0) = data.col(candidateIndices[0]);
+
+  arma::vec minDistances(data.n_cols);
+  minDistances.fill(std::numeric_limits<double>::max());
+  arma::Col<size_t> closestCandidates(data.n_cols);
+  UpdateDistances(data, candidates, 0, minDistances, closestCandidates);
+
+  const double expectedSamples = oversamplingFactor * clusters;
+  for (size_t r = 0; r < rounds; ++r)
+  {
+    const double cost = accu(minDistances);
+    if (cost == 0.0)
+      break; // Every point is a candidate already.
+
+    // Sample every point independently, in parallel.  Each point has its own
+    // random stream, so the samples do not depend on the number of threads.
+    const uint64_t key = RandStreamKey();
+    std::vector<size_t> sampled;
+    #pragma omp parallel
+    {
+      std::vector<size_t> localSampled;
+
+      #pragma omp for schedule(static) nowait
+      for (size_t p = 0; p < data.n_cols; ++p)
+      {
+        PhiloxRNG rng(key, p);
+        if (rng.Random() < expectedSamples * minDistances[p] / cost)
+          localSampled.push_back(p);
+      }
+
+      #pragma omp critical
+      sampled.insert(sampled.end(), localSampled.begin(), localSampled.end());
+    }
+
+    if (sampled.empty())
+      continue;
+
+    // Keep the candidates in the same order regardless of the threads.
+    std::sort(sampled.begin(), sampled.end());
+
+    const size_t firstCandidate = candidates.n_cols;
+    candidates.resize(data.n_rows, firstCandidate + sampled.size());
+    for (size_t i = 0; i < sampled.size(); ++i)
+      candidates.col(firstCandidate + i) = data.col(sampled[i]);
+    candidateIndices.insert(candidateIndices.end(), sampled.begin(),
+        sampled.end());
+
+    UpdateDistances(data, candidates, firstCandidate, minDistances,
+        closestCandidates);
+  }
+
+  if (candidates.n_cols <= clusters)
+  {
+    // There are too few candidates; take all of them, and fill the other
+    // centroids with random points.
+    centroids.set_size(data.n_rows, clusters);
+    centroids.cols(0, candidates.n_cols - 1) = candidates;
+    for (size_t i = candidates.n_cols; i < clusters; ++i)
+      centroids.col(i) = data.col(RandInt(0, data.n_cols));
+    return;
+  }
+
+  // Weight each candidate by the number of points closest to it.
+  arma::vec weights(candidates.n_cols, arma::fill::zeros);
+  for (size_t p = 0; p < data.n_cols; ++p)
+    weights[closestCandidates[p]] += 1.0;
+
+  ClusterCandidates(candidates, weights, clusters, centroids);
+}
+
+template<typename MatType>
+void KMeansParallelInitialization::UpdateDistances(
+    const MatType& data,
+    const arma::mat& candidates,
+    const size_t firstCandidate,
+    arma::vec& minDistances,
+    arma::Col<size_t>& closestCandidates)
+{
+  #pragma omp parallel for schedule(static)
+  for (size_t p = 0; p < data.n_cols; ++p)
+  {
+    for (size_t c = firstCandidate; c < candidates.n_cols; ++c)
+    {
+      const double distance = SquaredEuclideanDistance::Evaluate(data.col(p),
+          candidates.col(c));
+      if (distance < minDistances[p])
+      {
+        minDistances[p] = distance;
+        closestCandidates[p] = c;
+      }
+    }
+  }
+}
+
+inline void KMeansParallelInitialization::ClusterCandidates(
+    const arma::mat& candidates,
+    const arma::vec& weights,
+    const size_t clusters,
+    arma::mat& centroids) const
+{
+  centroids.set_size(candidates.n_rows, clusters);
+
+  // Weighted k-means++: the first centroid is sampled proportionally to the
+  // weights, and the next ones proportionally to their weighted squared
+  // distance to the closest centroid.
+  arma::vec minDistances(candidates.n_cols);
+  minDistances.fill(std::numeric_limits<double>::max());
+  arma::vec distribution(candidates.n_cols);
+  for (size_t i = 0; i < clusters; ++i)
+  {
+    if (i > 0)
+    {
+      #pragma omp parallel for schedule(static)
+      for (size_t c = 0; c < candidates.n_cols; ++c)
+      {
+        minDistances[c] = std::min(minDistances[c],
+            SquaredEuclideanDistance::Evaluate(candidates.col(c),
+            centroids.col(i - 1)));
+      }
+    }
+
+    double total = 0.0;
+    for (size_t c = 0; c < candidates.n_cols; ++c)
+    {
+      total += (i == 0) ? weights[c] : weights[c] * minDistances[c];
+      distribution[c] = total;
+    }
+
+    const double sampleValue = Random() * total;
+    const double* elem = std::upper_bound(distribution.begin(),
+        distribution.end(), sampleValue);
+    const size_t position = std::min((size_t) (elem - distribution.begin()),
+        (size_t) candidates.n_cols - 1);
+    centroids.col(i) = candidates.col(position);
+  }
+
+  // Now refine the centroids with weighted Lloyd iterations.  Empty clusters
+  // keep their centroid.
+  arma::mat newCentroids(candidates.n_rows, clusters);
+  arma::vec clusterWeights(clusters);
+  for (size_t iteration = 0; iteration < lloydIterations; ++iteration)
+  {
+    newCentroids.zeros();
+    clusterWeights.zeros();
+
+    #pragma omp parallel
+    {
+      // The new centroids are summed separately by each thread.
+      arma::mat localCentroids(candidates.n_rows, clusters, arma::fill::zeros);
+      arma::vec localWeights(clusters, arma::fill::zeros);
+
+      #pragma omp for schedule(static) nowait
+      for (size_t c = 0; c < candidates.n_cols; ++c)
+      {
+        double minDistance = DBL_MAX;
+        size_t closestCluster = 0;
+        for (size_t j = 0; j < clusters; ++j)
+        {
+          const double distance = SquaredEuclideanDistance::Evaluate(
+              candidates.col(c), centroids.col(j));
+          if (distance < minDistance)
+          {
+            minDistance = distance;
+            closestCluster = j;
+          }
+        }
+
+        localCentroids.col(closestCluster) += weights[c] * candidates.col(c);
+        localWeights[closestCluster] += weights[c];
+      }
+
+      #pragma omp critical
+      {
+        newCentroids += localCentroids;
+        clusterWeights += localWeights;
+      }
+    }
+
+    for (size_t j = 0; j < clusters; ++j)
+    {
+      if (clusterWeights[j] > 0.0)
+        centroids.col(j) = newCentroids.col(j) / clusterWeights[j];
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
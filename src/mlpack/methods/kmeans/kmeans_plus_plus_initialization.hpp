@@ -61,46 +61,40 @@ class KMeansPlusPlusInitialization
     size_t firstPoint = RandInt(0, data.n_cols);
     centroids.col(0) = data.col(firstPoint);
 
+    // The squared distance between each point and its closest already-chosen
+    // centroid.  It is updated with each new centroid only, in parallel, so
+    // each step takes O(nd) time instead of O(nkd).
+    arma::vec minDistances(data.n_cols);
+    minDistances.fill(std::numeric_limits<double>::max());
+
     // Utility variable.
     arma::vec distribution(data.n_cols);
 
     // Now, sample other points...
     for (size_t i = 1; i < clusters; ++i)
     {
-      // We must compute the CDF for sampling... this depends on the computation
-      // of the minimum distance between each point and its closest
-      // already-chosen centroid.
-      //
-      // This computation is ripe for speedup with trees!  I am not sure exactly
-      // how much we would need to approximate, but I think it could be done
-      // without breaking the O(log k)-competitive guarantee (I think).
+      // We must compute the CDF for sampling... this depends on the minimum
+      // distance between each point and its closest already-chosen centroid.
+      #pragma omp parallel for schedule(static)
       for (size_t p = 0; p < data.n_cols; ++p)
       {
-        double minDistance = std::numeric_limits<double>::max();
-        for (size_t j = 0; j < i; ++j)
-        {
-          const double distance = SquaredEuclideanDistance::Evaluate(
-              data.col(p), centroids.col(j));
-          minDistance = std::min(distance, minDistance);
-        }
-
-        distribution[p] = minDistance;
+        const double distance = SquaredEuclideanDistance::Evaluate(
+            data.col(p), centroids.col(i - 1));
+        minDistances[p] = std::min(distance, minDistances[p]);
       }
 
-      // Next normalize the distribution (actually technically we could avoid
-      // this).
-      distribution /= accu(distribution);
-
-      // Turn it into a CDF for convenience...
+      // Turn it into a CDF for convenience...  We don't need to normalize it;
+      // we sample in [0, total) instead.
+      distribution[0] = minDistances[0];
       for (size_t j = 1; j < distribution.n_elem; ++j)
-        distribution[j] += distribution[j - 1];
+        distribution[j] = distribution[j - 1] + minDistances[j];
 
       // Sample a point...
-      const double sampleValue = Random();
-      const double* elem = std::lower_bound(distribution.begin(),
+      const double sampleValue = Random() * distribution[data.n_cols - 1];
+      const double* elem = std::upper_bound(distribution.begin(),
           distribution.end(), sampleValue);
-      const size_t position = (size_t)
-          (elem - distribution.begin()) / sizeof(double);
+      const size_t position = std::min((size_t) (elem - distribution.begin()),
+          (size_t) data.n_cols - 1);
       centroids.col(i) = data.col(position);
     }
   }
@@ -0,0 +1,264 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans.hpp
+ *
+ * Mini-batch k-means clustering, which updates the centroids using small
+ * random samples of the data (or a stream of batches) instead of the whole
+ * dataset at every iteration.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+
+#include <mlpack/core.hpp>
+
+#include "kmeans.hpp"
+
+namespace mlpack {
+
+/**
+ * This class implements mini-batch k-means clustering, as described in the
+ * following paper:
+ *
+ * @code
+ * @inproceedings{sculley2010web,
+ *   title={Web-scale k-means clustering},
+ *   author={Sculley, David},
+ *   booktitle={Proceedings of the 19th International Conference on World Wide
+ *       Web (WWW '10)},
+ *   pages={1177--1178},
+ *   year={2010}
+ * }
+ * @endcode
+ *
+ * At each iteration, a mini-batch of points is sampled from the dataset, every
+ * point of the batch is assigned to its nearest centroid, and then each
+ * centroid is moved towards each of the points assigned to it, with a
+ * per-centroid learning rate of one over the number of points that the
+ * centroid has been assigned so far.  Each iteration therefore costs
+ * O(batchSize) instead of O(n), which makes this much faster than KMeans for
+ * large datasets, at the cost of slightly worse clusterings.
+ *
+ * The same update can also be applied to batches that arrive one at a time
+ * with Update(), for incremental clustering of data that does not fit in
+ * memory:
+ *
+ * @code
+ * MiniBatchKMeans<> kmeans;
+ * kmeans.Clusters() = 10;
+ * while (moreData)
+ * {
+ *   arma::mat batch = ...; // Load the next batch of points.
+ *   kmeans.Update(batch);
+ * }
+ *
+ * const arma::mat& centroids = kmeans.Centroids();
+ * @endcode
+ *
+ * The centroids are initialized with the InitialPartitionPolicy (on the whole
+ * dataset for Cluster(), or on the first batch for Update()).  After each
+ * iteration, the EmptyClusterPolicy is called on the current batch for every
+ * centroid that has not been assigned any point in the last EmptyPatience()
+ * iterations; the counts passed to the policy are the total number of points
+ * assigned to each centroid.
+ *
+ * @tparam DistanceType The distance metric to use to assign points to
+ *     centroids; see LMetric for an example.
+ * @tparam InitialPartitionPolicy Initial partitioning policy; see KMeans.
+ * @tparam EmptyClusterPolicy Policy for what to do on an empty cluster; see
+ *     KMeans.
+ * @tparam MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename DistanceType = EuclideanDistance,
+         typename InitialPartitionPolicy = SampleInitialization,
+         typename EmptyClusterPolicy = MaxVarianceNewCluster,
+         typename MatType = arma::mat>
+class MiniBatchKMeans
+{
+ public:
+  /**
+   * Create a mini-batch k-means object and (optionally) set the parameters
+   * which it will be run with.
+   *
+   * @param batchSize Number of points sampled at each iteration of Cluster().
+   * @param maxIterations Maximum number of iterations of Cluster() (0 means
+   *     no limit).
+   * @param tolerance Cluster() terminates when the centroids move less than
+   *     this (in Frobenius norm) in one iteration.
+   * @param distance Optional DistanceType object; for when the distance metric
+   *     has state it needs to store.
+   * @param partitioner Optional InitialPartitionPolicy object; for when a
+   *     specially initialized partitioning policy is required.
+   * @param emptyClusterAction Optional EmptyClusterPolicy object; for when a
+   *     specially initialized empty cluster policy is required.
+   */
+  MiniBatchKMeans(const size_t batchSize = 1024,
+                  const size_t maxIterations = 100,
+                  const double tolerance = 1e-5,
+                  const DistanceType distance = DistanceType(),
+                  const InitialPartitionPolicy partitioner =
+                      InitialPartitionPolicy(),
+                  const EmptyClusterPolicy emptyClusterAction =
+                      EmptyClusterPolicy());
+
+  /**
+   * Perform mini-batch k-means clustering on the data, returning the centroids
+   * of each cluster.  Optionally, the initial centroids can be specified by
+   * filling the centroids matrix and setting initialGuess to true.  Any state
+   * from earlier calls to Cluster() or Update() is discarded.
+   *
+   * @param data Dataset to cluster.
+   * @param clusters Number of clusters to compute.
+   * @param centroids Matrix in which centroids are stored.
+   * @param initialGuess If true, then it is assumed that centroids contains the
+   *      initial cluster centroids.
+   */
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids,
+               const bool initialGuess = false);
+
+  /**
+   * Perform mini-batch k-means clustering on the data, returning the centroids
+   * of each cluster and the assignment of each point to its nearest centroid.
+   *
+   * @param data Dataset to cluster.
+   * @param clusters Number of clusters to compute.
+   * @param assignments Vector to store cluster assignments in.
+   * @param centroids Matrix in which centroids are stored.
+   * @param initialGuess If true, then it is assumed that centroids contains the
+   *      initial cluster centroids.
+   */
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::Row<size_t>& assignments,
+               arma::mat& centroids,
+               const bool initialGuess = false);
+
+  /**
+   * Update the centroids with every point of the given batch.  If there are no
+   * centroids yet, they are first initialized on the batch with the
+   * InitialPartitionPolicy, with Clusters() clusters; in that case the batch
+   * must have at least Clusters() points.
+   *
+   * @param batch Batch of points to update the centroids with.
+   * @return Frobenius norm of the change of the centroids.
+   */
+  double Update(const MatType& batch);
+
+  /**
+   * Assign each point of the given data to its nearest centroid.
+   *
+   * @param data Points to assign.
+   * @param assignments Vector to store the cluster assignments in.
+   */
+  void Assign(const MatType& data, arma::Row<size_t>& assignments);
+
+  /**
+   * Forget the current centroids and counts, so that the next call to Update()
+   * initializes new centroids.
+   */
+  void Reset();
+
+  //! Get the current centroids (one per column).
+  const arma::mat& Centroids() const { return centroids; }
+  //! Get the number of points each centroid has been assigned so far.
+  const arma::Col<size_t>& Counts() const { return counts; }
+
+  //! Get the number of clusters used when Update() initializes the centroids.
+  size_t Clusters() const { return clusters; }
+  //! Modify the number of clusters used when Update() initializes the
+  //! centroids.
+  size_t& Clusters() { return clusters; }
+
+  //! Get the number of steps without any assigned point after which a
+  //! centroid is considered empty.
+  size_t EmptyPatience() const { return emptyPatience; }
+  //! Modify the number of steps without any assigned point after which a
+  //! centroid is considered empty.
+  size_t& EmptyPatience() { return emptyPatience; }
+
+  //! Get the batch size of Cluster().
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the batch size of Cluster().
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the maximum number of iterations of Cluster().
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of iterations of Cluster().
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the convergence tolerance of Cluster().
+  double Tolerance() const { return tolerance; }
+  //! Modify the convergence tolerance of Cluster().
+  double& Tolerance() { return tolerance; }
+
+  //! Get the distance metric.
+  const DistanceType& Distance() const { return distance; }
+  //! Modify the distance metric.
+  DistanceType& Distance() { return distance; }
+
+  //! Get the initial partitioning policy.
+  const InitialPartitionPolicy& Partitioner() const { return partitioner; }
+  //! Modify the initial partitioning policy.
+  InitialPartitionPolicy& Partitioner() { return partitioner; }
+
+  //! Get the empty cluster policy.
+  const EmptyClusterPolicy& EmptyClusterAction() const
+  { return emptyClusterAction; }
+  //! Modify the empty cluster policy.
+  EmptyClusterPolicy& EmptyClusterAction() { return emptyClusterAction; }
+
+  //! Serialize the mini-batch k-means object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+ private:
+  /**
+   * Initialize the centroids on the given data with the partitioner, and reset
+   * the counts.
+   */
+  void Initialize(const MatType& data, const size_t clusters);
+
+  /**
+   * Perform one mini-batch step with the given batch, returning the Frobenius
+   * norm of the change of the centroids.
+   */
+  double Step(const MatType& batch);
+
+  //! Number of points sampled at each iteration of Cluster().
+  size_t batchSize;
+  //! Maximum number of iterations of Cluster().
+  size_t maxIterations;
+  //! Convergence tolerance of Cluster().
+  double tolerance;
+  //! Number of clusters used when Update() initializes the centroids.
+  size_t clusters;
+  //! Number of steps without any point after which a centroid is empty.
+  size_t emptyPatience;
+  //! Instantiated distance metric.
+  DistanceType distance;
+  //! Instantiated initial partitioning policy.
+  InitialPartitionPolicy partitioner;
+  //! Instantiated empty cluster policy.
+  EmptyClusterPolicy emptyClusterAction;
+
+  //! The current centroids.
+  arma::mat centroids;
+  //! The number of points assigned to each centroid so far.
+  arma::Col<size_t> counts;
+  //! The last step at which each centroid was assigned a point.
+  arma::Col<size_t> lastAssigned;
+  //! The number of steps taken since the centroids were initialized.
+  size_t iteration;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "mini_batch_kmeans_impl.hpp"
+
+#endif
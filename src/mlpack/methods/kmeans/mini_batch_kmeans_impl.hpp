@@ -0,0 +1,356 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans_impl.hpp
+ *
+ * Implementation of mini-batch k-means clustering.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mini_batch_kmeans.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         typename MatType>
+MiniBatchKMeans<DistanceType,
+                InitialPartitionPolicy,
+                EmptyClusterPolicy,
+                MatType>::MiniBatchKMeans(
+    const size_t batchSize,
+    const size_t maxIterations,
+    const double tolerance,
+    const DistanceType distance,
+    const InitialPartitionPolicy partitioner,
+    const EmptyClusterPolicy emptyClusterAction) :
+    batchSize(batchSize),
+    maxIterations(maxIterations),
+    tolerance(tolerance),
+    clusters(0),
+    emptyPatience(10),
+    distance(distance),
+    partitioner(partitioner),
+    emptyClusterAction(emptyClusterAction),
+    iteration(0)
+{
+  // Nothing to do.
+}
+
+template<typename DistanceType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         typename MatType>
+void MiniBatchKMeans<DistanceType,
+                     InitialPartitionPolicy,
+                     EmptyClusterPolicy,
+                     MatType>::Cluster(const MatType& data,
+                                       const size_t clusters,
+                                       arma::mat& centroids,
+                                       const bool initialGuess)
+{
+  if (clusters == 0 || clusters > data.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "MiniBatchKMeans::Cluster(): cannot compute " << clusters
+        << " clusters of " << data.n_cols << " points!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("MiniBatchKMeans::Cluster(): batch size must "
+        "be positive!");
+  }
+
+  this->clusters = clusters;
+  if (initialGuess)
+  {
+    util::CheckSameSizes(centroids, clusters, "MiniBatchKMeans::Cluster()",
+        "clusters");
+    util::CheckSameDimensionality(data, centroids,
+        "MiniBatchKMeans::Cluster()");
+
+    this->centroids = centroids;
+    counts.zeros(clusters);
+    lastAssigned.zeros(clusters);
+    iteration = 0;
+  }
+  else
+  {
+    Initialize(data, clusters);
+  }
+
+  double cNorm;
+  do
+  {
+    if (batchSize >= data.n_cols)
+    {
+      cNorm = Step(data);
+    }
+    else
+    {
+      // Sample the mini-batch (with replacement).
+      const arma::uvec indices = arma::randi<arma::uvec>(batchSize,
+          arma::distr_param(0, (int) data.n_cols - 1));
+      const MatType batch = data.cols(indices);
+      cNorm = Step(batch);
+    }
+
+    Log::Info << "MiniBatchKMeans::Cluster(): iteration " << iteration
+        << ", residual " << cNorm << ".\n";
+    if (std::isnan(cNorm) || std::isinf(cNorm))
+      cNorm = tolerance + 1.0; // Keep iterating.
+  } while (cNorm > tolerance && iteration != maxIterations);
+
+  if (iteration != maxIterations)
+  {
+    Log::Info << "MiniBatchKMeans::Cluster(): converged after " << iteration
+        << " iterations." << std::endl;
+  }
+  else
+  {
+    Log::Info << "MiniBatchKMeans::Cluster(): terminated after limit of "
+        << iteration << " iterations." << std::endl;
+  }
+
+  centroids = this->centroids;
+}
+
+template<typename DistanceType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         typename MatType>
+void MiniBatchKMeans<DistanceType,
+                     InitialPartitionPolicy,
+                     EmptyClusterPolicy,
+                     MatType>::Cluster(const MatType& data,
+                                       const size_t clusters,
+                                       arma::Row<size_t>& assignments,
+                                       arma::mat& centroids,
+                                       const bool initialGuess)
+{
+  Cluster(data, clusters, centroids, initialGuess);
+  Assign(data, assignments);
+}
+
+template<typename DistanceType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         typename MatType>
+double MiniBatchKMeans<DistanceType,
+                       InitialPartitionPolicy,
+                       EmptyClusterPolicy,
+                       MatType>::Update(const MatType& batch)
+{
+  if (centroids.n_cols == 0)
+  {
+    if (clusters == 0)
+    {
+      throw std::invalid_argument("MiniBatchKMeans::Update(): number of "
+          "clusters must be set with Clusters() before the first batch!");
+    }
+
+    if (batch.n_cols < clusters)
+    {
+      std::ostringstream oss;
+      oss << "MiniBatchKMeans::Update(): first batch has " << batch.n_cols
+          << " points, but " << clusters << " clusters are needed to "
+          << "initialize the centroids!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    Initialize(batch, clusters);
+  }
+
+  util::CheckSameDimensionality(batch, centroids,
+      "MiniBatchKMeans::Update()");
+
+  return Step(batch);
+}
+
+template<typename DistanceType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         typename MatType>
+void MiniBatchKMeans<DistanceType,
+                     InitialPartitionPolicy,
+                     EmptyClusterPolicy,
+                     MatType>::Assign(const MatType& data,
+                                      arma::Row<size_t>& assignments)
+{
+  if (centroids.n_cols == 0)
+  {
+    throw std::invalid_argument("MiniBatchKMeans::Assign(): no centroids; call "
+        "Cluster() or Update() first!");
+  }
+
+  util::CheckSameDimensionality(data, centroids, "MiniBatchKMeans::Assign()");
+
+  assignments.set_size(data.n_cols);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+  {
+    // Find the closest centroid to this point.
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      const double dist = distance.Evaluate(data.col(i), centroids.col(j));
+
+      if (dist < minDistance)
+      {
+        minDistance = dist;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroids.n_cols);
+    assignments[i] = closestCluster;
+  }
+}
+
+template<typename DistanceType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         typename MatType>
+void MiniBatchKMeans<DistanceType,
+                     InitialPartitionPolicy,
+                     EmptyClusterPolicy,
+                     MatType>::Reset()
+{
+  centroids.clear();
+  counts.clear();
+  lastAssigned.clear();
+  iteration = 0;
+}
+
+template<typename DistanceType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         typename MatType>
+template<typename Archive>
+void MiniBatchKMeans<DistanceType,
+                     InitialPartitionPolicy,
+                     EmptyClusterPolicy,
+                     MatType>::serialize(Archive& ar,
+                                         const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(batchSize));
+  ar(CEREAL_NVP(maxIterations));
+  ar(CEREAL_NVP(tolerance));
+  ar(CEREAL_NVP(clusters));
+  ar(CEREAL_NVP(emptyPatience));
+  ar(CEREAL_NVP(distance));
+  ar(CEREAL_NVP(partitioner));
+  ar(CEREAL_NVP(emptyClusterAction));
+  ar(CEREAL_NVP(centroids));
+  ar(CEREAL_NVP(counts));
+  ar(CEREAL_NVP(lastAssigned));
+  ar(CEREAL_NVP(iteration));
+}
+
+template<typename DistanceType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         typename MatType>
+void MiniBatchKMeans<DistanceType,
+                     InitialPartitionPolicy,
+                     EmptyClusterPolicy,
+                     MatType>::Initialize(const MatType& data,
+                                          const size_t clusters)
+{
+  // The partitioner may return either centroids or assignments; in the latter
+  // case, the initial centroids are the means of the assigned points.
+  arma::Row<size_t> assignments;
+  const bool gotAssignments = GetInitialAssignmentsOrCentroids(partitioner,
+      data, clusters, assignments, centroids);
+  if (gotAssignments)
+  {
+    arma::Row<size_t> assignedCounts;
+    assignedCounts.zeros(clusters);
+    centroids.zeros(data.n_rows, clusters);
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      centroids.col(assignments[i]) += arma::vec(data.col(i));
+      assignedCounts[assignments[i]]++;
+    }
+
+    for (size_t i = 0; i < clusters; ++i)
+      if (assignedCounts[i] != 0)
+        centroids.col(i) /= assignedCounts[i];
+  }
+
+  counts.zeros(centroids.n_cols);
+  lastAssigned.zeros(centroids.n_cols);
+  iteration = 0;
+}
+
+template<typename DistanceType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         typename MatType>
+double MiniBatchKMeans<DistanceType,
+                       InitialPartitionPolicy,
+                       EmptyClusterPolicy,
+                       MatType>::Step(const MatType& batch)
+{
+  const arma::mat oldCentroids(centroids);
+
+  // Assign every point of the batch to its nearest centroid first, so that the
+  // assignments do not depend on the order of the updates.
+  arma::Row<size_t> assignments;
+  Assign(batch, assignments);
+
+  ++iteration;
+  for (size_t i = 0; i < batch.n_cols; ++i)
+  {
+    const size_t c = assignments[i];
+    ++counts[c];
+    lastAssigned[c] = iteration;
+
+    // Move the centroid towards the point with a learning rate of 1 / (number
+    // of points assigned to the centroid so far), so that each centroid is the
+    // running mean of the points assigned to it.
+    const double eta = 1.0 / counts[c];
+    centroids.col(c) += eta * (arma::vec(batch.col(i)) - centroids.col(c));
+  }
+
+  // A single batch may easily miss a small cluster, so a centroid is only
+  // considered empty when it has not been assigned any point in the last
+  // EmptyPatience() steps.  Go backwards, since the policy may remove
+  // centroids.
+  for (size_t i = centroids.n_cols; i > 0; --i)
+  {
+    const size_t c = i - 1;
+    if (iteration - lastAssigned[c] < emptyPatience)
+      continue;
+
+    Log::Info << "Cluster " << c << " is empty.\n";
+    const size_t oldClusters = centroids.n_cols;
+    emptyClusterAction.EmptyCluster(batch, c, oldCentroids, centroids, counts,
+        distance, iteration);
+
+    if (centroids.n_cols < oldClusters)
+      lastAssigned.shed_row(c);
+    else
+      lastAssigned[c] = iteration;
+  }
+
+  if (centroids.n_cols != oldCentroids.n_cols)
+    return std::numeric_limits<double>::infinity();
+
+  return arma::norm(centroids - oldCentroids, "fro");
+}
+
+} // namespace mlpack
+
+#endif
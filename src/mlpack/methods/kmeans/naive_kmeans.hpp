@@ -17,6 +17,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "sparse_centroid_distances.hpp"
+
 namespace mlpack {
 
 /**
@@ -25,6 +27,10 @@ namespace mlpack {
  * looking for the KMeans class instead of this one.  This class is used by
  * KMeans as the actual implementation of the Lloyd iteration.
  *
+ * For sparse datasets with the (squared) Euclidean distance, the distances are
+ * computed from sparse inner products with the centroids, so that the points
+ * are never densified.
+ *
  * @param DistanceType Type of distance metric used with this implementation.
  * @param MatType Matrix type (arma::mat or arma::sp_mat).
  */
@@ -63,6 +69,9 @@ class NaiveKMeans
   //! The instantiated distance metric.
   DistanceType& distance;
 
+  //! Squared norms of the points, if the dataset is sparse.
+  arma::vec pointNorms;
+
   //! Number of distance calculations.
   size_t distanceCalculations;
 };
@@ -29,7 +29,10 @@ NaiveKMeans<DistanceType, MatType>::NaiveKMeans(const MatType& dataset,
     dataset(dataset),
     distance(distance),
     distanceCalculations(0)
-{ /* Nothing to do. */ }
+{
+  if constexpr (UseSparseCentroidDistances<DistanceType, MatType>::value)
+    SparsePointNorms(dataset, pointNorms);
+}
 
 // Run a single iteration.
 template<typename DistanceType, typename MatType>
@@ -40,6 +43,12 @@ double NaiveKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
   newCentroids.zeros(centroids.n_rows, centroids.n_cols);
   counts.zeros(centroids.n_cols);
 
+  // For sparse data, the squared norms of the centroids are computed once, and
+  // the distances are computed from sparse inner products.
+  arma::vec centroidNorms;
+  if constexpr (UseSparseCentroidDistances<DistanceType, MatType>::value)
+    centroidNorms = arma::sum(arma::square(centroids), 0).t();
+
   // Find the closest centroid to each point and update the new centroids.
   // Computed in parallel over the complete dataset
   #pragma omp parallel
@@ -57,8 +66,17 @@ double NaiveKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
 
       for (size_t j = 0; j < centroids.n_cols; ++j)
       {
-        const double dist = distance.Evaluate(dataset.col(i),
-            centroids.col(j));
+        double dist;
+        if constexpr (UseSparseCentroidDistances<DistanceType, MatType>::value)
+        {
+          dist = SparseCentroidDistance<DistanceType>(dataset, i,
+              pointNorms[i], centroids, j, centroidNorms[j]);
+        }
+        else
+        {
+          dist = distance.Evaluate(dataset.col(i), centroids.col(j));
+        }
+
         if (dist < minDistance)
         {
           minDistance = dist;
@@ -69,7 +87,7 @@ double NaiveKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
       Log::Assert(closestCluster != centroids.n_cols);
 
       // We now have the minimum distance centroid index.  Update that centroid.
-      localCentroids.col(closestCluster) += dataset.col(i);
+      AddPoint(dataset, i, localCentroids, closestCluster);
       localCounts(closestCluster)++;
     }
     // Combine calculated state from each thread
@@ -16,6 +16,10 @@
 #include "pelleg_moore_kmeans.hpp"
 #include "pelleg_moore_kmeans_rules.hpp"
 
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 
 template<typename DistanceType, typename MatType>
@@ -52,15 +56,65 @@ double PellegMooreKMeans<DistanceType, MatType>::Iterate(
   using RulesType = PellegMooreKMeansRules<DistanceType, TreeType>;
   RulesType rules(dataset, centroids, newCentroids, counts, distance);
 
-  // Use single-tree traverser.
-  typename TreeType::template SingleTreeTraverser<RulesType> traverser(rules);
+  // Score the root and then the children of every node that can't be pruned,
+  // one level at a time, until there are enough subtrees for all threads.
+  // Leaves and pruned nodes are fully handled by Score().  The query index is
+  // a fake index, since we are checking each node with all clusters.
+  std::vector<TreeType*> frontier;
+  if (rules.Score(0, *tree) != DBL_MAX && !tree->IsLeaf())
+    frontier.push_back(tree);
+
+  #ifdef MLPACK_USE_OPENMP
+  const size_t minSubtrees = 4 * omp_get_max_threads();
+  #else
+  const size_t minSubtrees = 1;
+  #endif
+  while (!frontier.empty() && frontier.size() < minSubtrees)
+  {
+    std::vector<TreeType*> nextFrontier;
+    for (TreeType* node : frontier)
+    {
+      for (TreeType* child : { node->Left(), node->Right() })
+      {
+        if (rules.Score(0, *child) != DBL_MAX && !child->IsLeaf())
+          nextFrontier.push_back(child);
+      }
+    }
 
-  // Now, do a traversal with a fake query index (since the query index is
-  // irrelevant; we are checking each node with all clusters.
-  traverser.Traverse(0, *tree);
+    frontier.swap(nextFrontier);
+  }
 
   distanceCalculations += rules.DistanceCalculations();
 
+  // Now traverse the subtrees in parallel.  The single-tree traverser does not
+  // score the subtree roots again, since they have a parent.  Each thread sums
+  // into its own centroids, which are combined at the end.
+  size_t threadDistanceCalculations = 0;
+  #pragma omp parallel reduction(+:threadDistanceCalculations)
+  {
+    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
+        arma::fill::zeros);
+    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+    RulesType localRules(dataset, centroids, localCentroids, localCounts,
+        distance);
+    typename TreeType::template SingleTreeTraverser<RulesType>
+        traverser(localRules);
+
+    #pragma omp for schedule(dynamic) nowait
+    for (size_t i = 0; i < frontier.size(); ++i)
+      traverser.Traverse(0, *frontier[i]);
+
+    threadDistanceCalculations += localRules.DistanceCalculations();
+
+    // Combine calculated state from each thread.
+    #pragma omp critical
+    {
+      newCentroids += localCentroids;
+      counts += localCounts;
+    }
+  }
+  distanceCalculations += threadDistanceCalculations;
+
   // Now, calculate how far the clusters moved, after normalizing them.
   double residual = 0.0;
   for (size_t c = 0; c < centroids.n_cols; ++c)
@@ -0,0 +1,130 @@
+/**
+ * @file methods/kmeans/sparse_centroid_distances.hpp
+ *
+ * Utilities for the Lloyd steps to compute Euclidean distances between the
+ * points of a sparse dataset and dense centroids.  The squared distance is
+ * expanded as ||x||^2 + ||c||^2 - 2 x^T c, so that only the nonzero elements
+ * of each point are visited; evaluating the distance directly would build a
+ * dense vector of the full dimensionality for each pair.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_SPARSE_CENTROID_DISTANCES_HPP
+#define MLPACK_METHODS_KMEANS_SPARSE_CENTROID_DISTANCES_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/distances/lmetric.hpp>
+
+namespace mlpack {
+
+/**
+ * 'value' is true if the distances between the points of MatType and the
+ * centroids can be computed with the utilities below: MatType must be sparse,
+ * and DistanceType must be the (squared) Euclidean distance.
+ */
+template<typename DistanceType, typename MatType>
+struct UseSparseCentroidDistances : std::false_type { };
+
+template<bool TakeRoot, typename eT>
+struct UseSparseCentroidDistances<LMetric<2, TakeRoot>, arma::SpMat<eT>> :
+    std::true_type { };
+
+/**
+ * Compute the squared norm of each point of a sparse dataset.
+ *
+ * @param dataset Sparse dataset.
+ * @param norms Vector to store the squared norms in.
+ */
+template<typename eT>
+void SparsePointNorms(const arma::SpMat<eT>& dataset, arma::vec& norms)
+{
+  norms.zeros(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    for (auto it = dataset.begin_col(i); it != dataset.end_col(i); ++it)
+      norms[i] += double(*it) * double(*it);
+}
+
+/**
+ * Compute the distance between point i of a sparse dataset and centroid c,
+ * given their squared norms.
+ *
+ * @param dataset Sparse dataset.
+ * @param i Index of the point.
+ * @param pointNorm Squared norm of point i.
+ * @param centroids Dense centroids.
+ * @param c Index of the centroid.
+ * @param centroidNorm Squared norm of centroid c.
+ */
+template<typename DistanceType, typename eT>
+double SparseCentroidDistance(const arma::SpMat<eT>& dataset,
+                              const size_t i,
+                              const double pointNorm,
+                              const arma::mat& centroids,
+                              const size_t c,
+                              const double centroidNorm)
+{
+  const double* centroid = centroids.colptr(c);
+  double product = 0.0;
+  for (auto it = dataset.begin_col(i); it != dataset.end_col(i); ++it)
+    product += double(*it) * centroid[it.row()];
+
+  // Cancellation may make the squared distance slightly negative.
+  const double squared = std::max(0.0,
+      pointNorm + centroidNorm - 2.0 * product);
+  return DistanceType::TakeRoot ? std::sqrt(squared) : squared;
+}
+
+/**
+ * Compute the inner products of point i of a sparse dataset with all the
+ * centroids.  The transposed centroids are taken, so that the k values that
+ * each nonzero element of the point is multiplied with are contiguous.
+ *
+ * @param dataset Sparse dataset.
+ * @param i Index of the point.
+ * @param centroidsT Transposed centroids (one centroid per row).
+ * @param products Vector to store the inner products in.
+ */
+template<typename eT>
+void SparseCentroidProducts(const arma::SpMat<eT>& dataset,
+                            const size_t i,
+                            const arma::mat& centroidsT,
+                            arma::vec& products)
+{
+  products.zeros(centroidsT.n_rows);
+  for (auto it = dataset.begin_col(i); it != dataset.end_col(i); ++it)
+    products += double(*it) * centroidsT.col(it.row());
+}
+
+/**
+ * Add point i of the dataset to column c of a dense matrix of sums.  For
+ * sparse datasets only the nonzero elements are visited.
+ *
+ * @param dataset Dataset.
+ * @param i Index of the point.
+ * @param sums Dense matrix of sums.
+ * @param c Column of the sums to add the point to.
+ */
+template<typename MatType>
+void AddPoint(const MatType& dataset,
+              const size_t i,
+              arma::mat& sums,
+              const size_t c)
+{
+  if constexpr (arma::is_SpMat<MatType>::value)
+  {
+    double* sum = sums.colptr(c);
+    for (auto it = dataset.begin_col(i); it != dataset.end_col(i); ++it)
+      sum[it.row()] += *it;
+  }
+  else
+  {
+    sums.col(c) += arma::vec(dataset.col(i));
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * @file methods/kmeans/spherical_kmeans.hpp
+ *
+ * An implementation of a Lloyd step for spherical k-means, which clusters
+ * points by cosine similarity and keeps the centroids on the unit sphere.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_SPHERICAL_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_SPHERICAL_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "sparse_centroid_distances.hpp"
+
+namespace mlpack {
+
+/**
+ * A single Lloyd iteration of spherical k-means: each point is assigned to the
+ * centroid with the largest cosine similarity, and each new centroid is the
+ * normalized sum of its points.  This is the usual way to cluster documents
+ * represented as TF-IDF vectors.
+ *
+ * The points should be normalized to unit length; then the centroid with the
+ * largest cosine similarity is also the closest centroid in Euclidean
+ * distance, so KMeans computes the same final assignments with the default
+ * EuclideanDistance.  For sparse datasets only the nonzero elements of each
+ * point are visited.
+ *
+ * @code
+ * extern arma::sp_mat documents; // Normalized TF-IDF vectors.
+ * arma::Row<size_t> assignments;
+ * arma::mat centroids;
+ *
+ * KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+ *     SphericalKMeans, arma::sp_mat> k;
+ * k.Cluster(documents, 100, assignments, centroids);
+ * @endcode
+ *
+ * @param DistanceType Type of distance metric (only used for the residual).
+ * @param MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename DistanceType, typename MatType>
+class SphericalKMeans
+{
+ public:
+  /**
+   * Construct the SphericalKMeans object with the given dataset and distance
+   * metric.
+   *
+   * @param dataset Dataset.
+   * @param distance Instantiated distance metric.
+   */
+  SphericalKMeans(const MatType& dataset, DistanceType& distance);
+
+  /**
+   * Run a single iteration of spherical k-means, updating the given centroids
+   * into the newCentroids matrix, whose non-empty columns have unit length.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Number of points in each cluster at the end of the iteration.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+ private:
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated distance metric.
+  DistanceType& distance;
+
+  //! Number of similarity calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "spherical_kmeans_impl.hpp"
+
+#endif
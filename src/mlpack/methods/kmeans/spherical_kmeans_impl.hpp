@@ -0,0 +1,96 @@
+/**
+ * @file methods/kmeans/spherical_kmeans_impl.hpp
+ *
+ * Implementation of the Lloyd step for spherical k-means.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_SPHERICAL_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_SPHERICAL_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "spherical_kmeans.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType, typename MatType>
+SphericalKMeans<DistanceType, MatType>::SphericalKMeans(
+    const MatType& dataset,
+    DistanceType& distance) :
+    dataset(dataset),
+    distance(distance),
+    distanceCalculations(0)
+{ /* Nothing to do. */ }
+
+// Run a single iteration.
+template<typename DistanceType, typename MatType>
+double SphericalKMeans<DistanceType, MatType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  newCentroids.zeros(centroids.n_rows, centroids.n_cols);
+  counts.zeros(centroids.n_cols);
+
+  // The initial centroids (or those given by the empty cluster policy) may not
+  // have unit length, so the inner products are divided by the centroid norms.
+  arma::vec inverseNorms = arma::sqrt(arma::sum(arma::square(centroids),
+      0)).t();
+  inverseNorms.transform([](double n) { return (n == 0.0) ? 0.0 : 1.0 / n; });
+  const arma::mat centroidsT = centroids.t();
+
+  #pragma omp parallel
+  {
+    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
+        arma::fill::zeros);
+    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+    arma::vec products;
+
+    #pragma omp for schedule(static) nowait
+    for (size_t i = 0; i < (size_t) dataset.n_cols; ++i)
+    {
+      if constexpr (arma::is_SpMat<MatType>::value)
+        SparseCentroidProducts(dataset, i, centroidsT, products);
+      else
+        products = centroidsT * arma::vec(dataset.col(i));
+
+      const size_t closestCluster = (products % inverseNorms).index_max();
+      AddPoint(dataset, i, localCentroids, closestCluster);
+      localCounts(closestCluster)++;
+    }
+
+    #pragma omp critical
+    {
+      newCentroids += localCentroids;
+      counts += localCounts;
+    }
+  }
+
+  // Project the new centroids back onto the unit sphere.
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    const double norm = arma::norm(newCentroids.col(i), 2);
+    if (norm > 0.0)
+      newCentroids.col(i) /= norm;
+  }
+
+  distanceCalculations += centroids.n_cols * dataset.n_cols;
+
+  // Calculate cluster movement for this iteration.
+  double cNorm = 0.0;
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    cNorm += std::pow(distance.Evaluate(centroids.col(i), newCentroids.col(i)),
+        2.0);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,108 @@
+/**
+ * @file methods/kmeans/yinyang_kmeans.hpp
+ *
+ * An implementation of the Yinyang k-means algorithm, which uses group-based
+ * lower bounds to avoid distance calculations in Lloyd iterations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_YINYANG_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_YINYANG_KMEANS_HPP
+
+namespace mlpack {
+
+/**
+ * An implementation of the Yinyang k-means algorithm for exact Lloyd
+ * iterations.  The centroids are clustered into groups of about ten centroids
+ * (once, on the first iteration); each point holds an upper bound on the
+ * distance to its centroid, and one lower bound per group on the distance to
+ * the other centroids of the group.  This takes O(nk / 10) memory, between
+ * Hamerly's algorithm (one lower bound per point) and Elkan's algorithm (k
+ * lower bounds per point), so it is suited to large k.  Points are processed in
+ * parallel with OpenMP.
+ *
+ * For more information on the algorithm, see
+ *
+ * @code
+ * @inproceedings{ding2015yinyang,
+ *   title={Yinyang k-means: A drop-in replacement of the classic k-means with
+ *       consistent speedup},
+ *   author={Ding, Yufei and Zhao, Yue and Shen, Xipeng and Musuvathi, Madanlal
+ *       and Mytkowicz, Todd},
+ *   booktitle={Proceedings of the 32nd International Conference on Machine
+ *       Learning (ICML '15)},
+ *   pages={579--587},
+ *   year={2015}
+ * }
+ * @endcode
+ */
+template<typename DistanceType, typename MatType>
+class YinyangKMeans
+{
+ public:
+  /**
+   * Construct the YinyangKMeans object, which must store several sets of
+   * bounds.
+   */
+  YinyangKMeans(const MatType& dataset, DistanceType& distance);
+
+  /**
+   * Run a single iteration of the Yinyang algorithm, updating the given
+   * centroids into the newCentroids matrix.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Current counts, to be overwritten with new counts.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+  //! Get the number of groups of centroids (0 before the first iteration).
+  size_t NumGroups() const { return groupMembers.size(); }
+
+  //! Get the group of each centroid.
+  const arma::Col<size_t>& Groups() const { return groups; }
+
+ private:
+  /**
+   * Cluster the given centroids into groups with a few Lloyd iterations on the
+   * centroids, and fill groups and groupMembers.
+   */
+  void BuildGroups(const arma::mat& centroids);
+
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated distance metric.
+  DistanceType& distance;
+
+  //! The group of each centroid.
+  arma::Col<size_t> groups;
+  //! The centroids of each group.
+  std::vector<std::vector<size_t>> groupMembers;
+  //! The centroids of the last iteration, to compute how far they moved.
+  arma::mat lastCentroids;
+
+  //! Upper bounds for each point.
+  arma::vec upperBounds;
+  //! Lower bounds on the distance from each point (column) to the centroids of
+  //! each group (row), other than the point's own centroid.
+  arma::mat lowerBounds;
+  //! Assignments for each point.
+  arma::Col<size_t> assignments;
+
+  //! Track distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "yinyang_kmeans_impl.hpp"
+
+#endif
@@ -0,0 +1,275 @@
+/**
+ * @file methods/kmeans/yinyang_kmeans_impl.hpp
+ *
+ * An implementation of the Yinyang k-means algorithm, which uses group-based
+ * lower bounds to avoid distance calculations in Lloyd iterations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_YINYANG_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_YINYANG_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "yinyang_kmeans.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType, typename MatType>
+YinyangKMeans<DistanceType, MatType>::YinyangKMeans(const MatType& dataset,
+                                                    DistanceType& distance) :
+    dataset(dataset),
+    distance(distance),
+    distanceCalculations(0)
+{
+  // Nothing to do.
+}
+
+template<typename DistanceType, typename MatType>
+double YinyangKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
+                                                     arma::mat& newCentroids,
+                                                     arma::Col<size_t>& counts)
+{
+  // If this is the first iteration, we need to group the centroids.  All the
+  // bounds are computed in this iteration.
+  const bool firstIteration = (groups.n_elem != centroids.n_cols ||
+      assignments.n_elem != dataset.n_cols);
+  if (firstIteration)
+  {
+    BuildGroups(centroids);
+    upperBounds.set_size(dataset.n_cols);
+    lowerBounds.set_size(groupMembers.size(), dataset.n_cols);
+    assignments.set_size(dataset.n_cols);
+  }
+
+  const size_t numGroups = groupMembers.size();
+
+  // Find how far each centroid moved since the last iteration, and the largest
+  // movement in each group, to update the bounds.  The centroids may have been
+  // changed by the empty cluster policy since the last iteration, so this is
+  // computed from the centroids we are given.
+  arma::vec centroidMovements(centroids.n_cols, arma::fill::zeros);
+  arma::vec groupMovements(numGroups, arma::fill::zeros);
+  if (!firstIteration)
+  {
+    for (size_t c = 0; c < centroids.n_cols; ++c)
+    {
+      centroidMovements(c) = distance.Evaluate(lastCentroids.col(c),
+          centroids.col(c));
+      groupMovements(groups[c]) = std::max(groupMovements(groups[c]),
+          centroidMovements(c));
+    }
+    distanceCalculations += centroids.n_cols;
+  }
+
+  // Reset new centroids.
+  newCentroids.zeros(centroids.n_rows, centroids.n_cols);
+  counts.zeros(centroids.n_cols);
+
+  size_t globalPruned = 0;
+  size_t groupPruned = 0;
+  size_t iterationDistanceCalculations = 0;
+  #pragma omp parallel reduction(+:globalPruned, groupPruned, \
+      iterationDistanceCalculations)
+  {
+    // The new centroids are summed separately by each thread.
+    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
+        arma::fill::zeros);
+    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+    std::vector<char> examineGroup(numGroups);
+
+    #pragma omp for schedule(static) nowait
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+    {
+      size_t assignment = centroids.n_cols; // Invalid value.
+      double upperBound = DBL_MAX;
+      bool needsUpdate = true;
+      if (!firstIteration)
+      {
+        assignment = assignments[i];
+
+        // Update the bounds with the centroid movements, and find the global
+        // lower bound.
+        upperBound = upperBounds[i] + centroidMovements(assignment);
+        double globalLowerBound = DBL_MAX;
+        for (size_t g = 0; g < numGroups; ++g)
+        {
+          lowerBounds(g, i) -= groupMovements(g);
+          globalLowerBound = std::min(globalLowerBound, lowerBounds(g, i));
+        }
+
+        // Global filtering: if no other centroid can be closer, the point keeps
+        // its centroid.  Otherwise, tighten the upper bound and try again.
+        if (upperBound <= globalLowerBound)
+        {
+          ++globalPruned;
+          needsUpdate = false;
+        }
+        else
+        {
+          upperBound = distance.Evaluate(dataset.col(i),
+              centroids.col(assignment));
+          ++iterationDistanceCalculations;
+          needsUpdate = (upperBound > globalLowerBound);
+        }
+      }
+
+      if (needsUpdate)
+      {
+        // Group filtering: only the groups whose lower bound is below the
+        // upper bound may hold a closer centroid.  Their lower bounds are
+        // computed again.
+        for (size_t g = 0; g < numGroups; ++g)
+        {
+          examineGroup[g] = (firstIteration || lowerBounds(g, i) < upperBound);
+          if (examineGroup[g])
+            lowerBounds(g, i) = DBL_MAX;
+          else
+            ++groupPruned;
+        }
+
+        const size_t oldAssignment = assignment;
+        for (size_t g = 0; g < numGroups; ++g)
+        {
+          if (!examineGroup[g])
+            continue;
+
+          for (const size_t c : groupMembers[g])
+          {
+            // The distance to the old centroid is the upper bound.
+            if (c == oldAssignment)
+              continue;
+
+            const double dist = distance.Evaluate(dataset.col(i),
+                centroids.col(c));
+            ++iterationDistanceCalculations;
+
+            if (dist < upperBound)
+            {
+              // The previous closest centroid is now one of the other
+              // centroids of its group.
+              if (assignment != centroids.n_cols)
+              {
+                lowerBounds(groups[assignment], i) = std::min(
+                    lowerBounds(groups[assignment], i), upperBound);
+              }
+
+              upperBound = dist;
+              assignment = c;
+            }
+            else
+            {
+              lowerBounds(g, i) = std::min(lowerBounds(g, i), dist);
+            }
+          }
+        }
+      }
+
+      assignments[i] = assignment;
+      upperBounds[i] = upperBound;
+
+      localCentroids.col(assignment) += dataset.col(i);
+      ++localCounts(assignment);
+    }
+
+    // Combine calculated state from each thread.
+    #pragma omp critical
+    {
+      newCentroids += localCentroids;
+      counts += localCounts;
+    }
+  }
+  distanceCalculations += iterationDistanceCalculations;
+
+  // Normalize centroids and calculate cluster movement.
+  double centroidMovement = 0.0;
+  for (size_t c = 0; c < centroids.n_cols; ++c)
+  {
+    if (counts(c) > 0)
+      newCentroids.col(c) /= counts(c);
+
+    centroidMovement += std::pow(distance.Evaluate(centroids.col(c),
+        newCentroids.col(c)), 2.0);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  // The bounds are now relative to these centroids.
+  lastCentroids = centroids;
+
+  Log::Info << "Yinyang prunes: " << globalPruned << " points, "
+      << groupPruned << " groups.\n";
+
+  return std::sqrt(centroidMovement);
+}
+
+template<typename DistanceType, typename MatType>
+void YinyangKMeans<DistanceType, MatType>::BuildGroups(
+    const arma::mat& centroids)
+{
+  const size_t k = centroids.n_cols;
+  const size_t numGroups = std::max((size_t) 1, (k + 9) / 10);
+
+  // Run a few Lloyd iterations on the centroids, starting from evenly spaced
+  // centroids; the groups don't need to be optimal.
+  arma::mat groupCentroids(centroids.n_rows, numGroups);
+  for (size_t g = 0; g < numGroups; ++g)
+    groupCentroids.col(g) = centroids.col(g * k / numGroups);
+
+  groups.set_size(k);
+  arma::Col<size_t> groupCounts(numGroups);
+  for (size_t iteration = 0; iteration < 5; ++iteration)
+  {
+    for (size_t c = 0; c < k; ++c)
+    {
+      double minDistance = DBL_MAX;
+      groups[c] = 0;
+      for (size_t g = 0; g < numGroups; ++g)
+      {
+        const double dist = distance.Evaluate(centroids.col(c),
+            groupCentroids.col(g));
+        if (dist < minDistance)
+        {
+          minDistance = dist;
+          groups[c] = g;
+        }
+      }
+    }
+    distanceCalculations += k * numGroups;
+
+    // Empty groups keep their centroid.
+    arma::mat newGroupCentroids(centroids.n_rows, numGroups,
+        arma::fill::zeros);
+    groupCounts.zeros();
+    for (size_t c = 0; c < k; ++c)
+    {
+      newGroupCentroids.col(groups[c]) += centroids.col(c);
+      ++groupCounts[groups[c]];
+    }
+
+    for (size_t g = 0; g < numGroups; ++g)
+    {
+      if (groupCounts[g] > 0)
+        groupCentroids.col(g) = newGroupCentroids.col(g) / groupCounts[g];
+    }
+  }
+
+  // Drop the empty groups and list the centroids of each group.
+  arma::Col<size_t> newGroupIndices(numGroups);
+  size_t nonEmptyGroups = 0;
+  for (size_t g = 0; g < numGroups; ++g)
+    newGroupIndices[g] = (groupCounts[g] > 0) ? nonEmptyGroups++ : numGroups;
+
+  groupMembers.clear();
+  groupMembers.resize(nonEmptyGroups);
+  for (size_t c = 0; c < k; ++c)
+  {
+    groups[c] = newGroupIndices[groups[c]];
+    groupMembers[groups[c]].push_back(c);
+  }
+}
+
+} // namespace mlpack
+
+#endif
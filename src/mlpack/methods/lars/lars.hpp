@@ -475,6 +475,27 @@ class LARS
                  const bool fitIntercept,
                  const bool normalizeData);
 
+  /**
+   * Train one model for each row of `responses` (that is, for each target),
+   * with the settings of this object (which is not modified).  The data is
+   * transformed, and its Gram matrix is computed, once for all targets (unless
+   * a Gram matrix was given to this object, in which case it is used), and the
+   * targets are trained in parallel.  The models do not keep a reference to
+   * the shared Gram matrix.
+   *
+   * @param data Column-major input data (or row-major input data if colMajor =
+   *     false).
+   * @param responses Matrix of targets, with one row per target and one column
+   *     per point.
+   * @param models Will be filled with the trained model of each target.
+   * @param colMajor Should be true if the input data is column-major.
+   */
+  template<typename MatType, typename ResponsesMatType>
+  void Train(const MatType& data,
+             const ResponsesMatType& responses,
+             std::vector<LARS>& models,
+             const bool colMajor = true) const;
+
   /**
    * Predict y_i for the given data point.
    *
@@ -551,6 +572,22 @@ class LARS
   //! Set the model to use the given lambda1 value in the path.
   void SelectBeta(const ElemType lambda1);
 
+  /**
+   * Compute the solution for each of the given lambda1 values, which must not
+   * be less than Lambda1(), from the path computed by the last training.  As
+   * the path holds the solutions for all larger values of lambda1, this takes
+   * no training, so to solve along a grid of lambda1 values, train once with
+   * the smallest one.  The selected model is not changed.
+   *
+   * @param lambdas Values of lambda1 to get the solution for.
+   * @param betas Will be filled with the coefficients of each solution (one
+   *     column per value of lambda1).
+   * @param intercepts Will be filled with the intercept of each solution.
+   */
+  void SelectBetas(const arma::Col<ElemType>& lambdas,
+                   DenseMatType& betas,
+                   arma::Row<ElemType>& intercepts);
+
   //! Get the L1 penalty parameter corresponding to the currently selected
   //! model.
   ElemType SelectedLambda1() const { return selectedLambda1; }
@@ -676,6 +713,30 @@ class LARS
    */
   void Ignore(const size_t varInd);
 
+  /**
+   * Transform the data as needed for training according to fitIntercept and
+   * normalizeData: the transformed data, in row-major form, is stored in
+   * dataTrans, unless no transformation is needed and the data is already
+   * row-major.
+   */
+  template<typename MatType>
+  void TransformData(const MatType& matX,
+                     const bool colMajor,
+                     MatType& dataTrans,
+                     arma::Col<ElemType>& offsetX,
+                     arma::Col<ElemType>& stdX) const;
+
+  /**
+   * Compute the solution path on data transformed by TransformData(), with the
+   * current settings.  Returns the initial maximum correlation; if it is less
+   * than lambda1, the solution is zero.
+   */
+  template<typename MatType, typename ResponsesType>
+  ElemType TrainPath(const MatType& dataRef,
+                     const ResponsesType& y,
+                     const arma::Col<ElemType>& offsetX,
+                     const arma::Col<ElemType>& stdX);
+
   // Compute "equiangular" direction in output space.
   template<typename MatType, typename VecType>
   void ComputeYHatDirection(const MatType& matX,
@@ -476,36 +476,35 @@ LARS<ModelMatType>::Train(const MatType& matX,
   this->fitIntercept = fitIntercept;
   this->normalizeData = normalizeData;
 
-  // Clear any previous solution information.
-  betaPath.clear();
-  lambdaPath.clear();
-  activeSet.clear();
-  isActive.clear();
-  ignoreSet.clear();
-  isIgnored.clear();
-  matUtriCholFactor.reset();
-  selectedBeta.clear();
-
-  // Update values in case lambda1 or lambda2 changed.
-  lasso = (lambda1 != 0);
-  elasticNet = (lambda1 != 0 && lambda2 != 0);
-
   // This matrix may end up holding the transpose -- if necessary.
   MatType dataTrans;
-  // This vector may hold zero-centered responses, if necessary.
-  ResponsesType yCentered;
+  arma::Col<ElemType> offsetX; // used only if fitting an intercept
+  arma::Col<ElemType> stdX; // used only if normalizing
+  TransformData(matX, colMajor, dataTrans, offsetX, stdX);
 
   // dataRef is row-major.  We can reuse the given matX, but only if we don't
   // need to do any transformations to it.
   const MatType& dataRef =
       (colMajor || fitIntercept || normalizeData) ? dataTrans : matX;
-  const ResponsesType& yRef =
-      (fitIntercept) ? yCentered : y;
 
-  arma::Col<ElemType> offsetX; // used only if fitting an intercept
-  this->offsetY = 0.0; // used only if fitting an intercept
-  arma::Col<ElemType> stdX; // used only if normalizing
+  // If the maximum correlation is too small, the model is zero and there is no
+  // error to compute.
+  const ElemType maxCorr = TrainPath(dataRef, y, offsetX, stdX);
+  if (maxCorr < lambda1)
+    return maxCorr;
+
+  return ComputeError(matX, y, colMajor);
+}
 
+template<typename ModelMatType>
+template<typename MatType>
+inline void LARS<ModelMatType>::TransformData(
+    const MatType& matX,
+    const bool colMajor,
+    MatType& dataTrans,
+    arma::Col<ElemType>& offsetX,
+    arma::Col<ElemType>& stdX) const
+{
   if (colMajor)
   {
     if (fitIntercept)
@@ -555,6 +554,35 @@ LARS<ModelMatType>::Train(const MatType& matX,
     // If we are not fitting an intercept and we are not normalizing the data,
     // dataTrans already points to matX so we don't need to do anything.
   }
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType>
+inline typename LARS<ModelMatType>::ElemType
+LARS<ModelMatType>::TrainPath(const MatType& dataRef,
+                              const ResponsesType& y,
+                              const arma::Col<ElemType>& offsetX,
+                              const arma::Col<ElemType>& stdX)
+{
+  // Clear any previous solution information.
+  betaPath.clear();
+  lambdaPath.clear();
+  activeSet.clear();
+  isActive.clear();
+  ignoreSet.clear();
+  isIgnored.clear();
+  matUtriCholFactor.reset();
+  selectedBeta.clear();
+
+  // Update values in case lambda1 or lambda2 changed.
+  lasso = (lambda1 != 0);
+  elasticNet = (lambda1 != 0 && lambda2 != 0);
+
+  // This vector may hold zero-centered responses, if necessary.
+  ResponsesType yCentered;
+  const ResponsesType& yRef =
+      (fitIntercept) ? yCentered : y;
+  this->offsetY = 0.0; // used only if fitting an intercept
 
   if (fitIntercept)
   {
@@ -609,6 +637,9 @@ LARS<ModelMatType>::Train(const MatType& matX,
     return maxCorr;
   }
 
+  // This is returned at the end.
+  const ElemType initialMaxCorr = maxCorr;
+
   // Compute the Gram matrix.  If this is the elastic net problem, we will add
   // lambda2 * I_n to the matrix.
   if (matGram->n_elem != dataRef.n_cols * dataRef.n_cols)
@@ -929,7 +960,92 @@ LARS<ModelMatType>::Train(const MatType& matX,
   selectedLambda1 = lambda1;
   selectedIndex = betaPath.size() - 1;
 
-  return ComputeError(matX, y, colMajor);
+  return initialMaxCorr;
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesMatType>
+inline void LARS<ModelMatType>::Train(const MatType& data,
+                                      const ResponsesMatType& responses,
+                                      std::vector<LARS>& models,
+                                      const bool colMajor) const
+{
+  const size_t numPoints = colMajor ? data.n_cols : data.n_rows;
+  if (responses.n_cols != numPoints)
+  {
+    std::ostringstream oss;
+    oss << "LARS::Train(): number of responses (" << responses.n_cols << ") "
+        << "does not match number of points (" << numPoints << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Transform the data once for all targets.
+  MatType dataTrans;
+  arma::Col<ElemType> offsetX, stdX;
+  TransformData(data, colMajor, dataTrans, offsetX, stdX);
+  const MatType& dataRef =
+      (colMajor || fitIntercept || normalizeData) ? dataTrans : data;
+
+  // Use the Gram matrix given to this object, if any; otherwise, compute the
+  // one that Train() would compute, once for all targets.
+  DenseMatType sharedGram;
+  const DenseMatType* gram = matGram;
+  if (matGram == &matGramInternal ||
+      matGram->n_elem != dataRef.n_cols * dataRef.n_cols)
+  {
+    sharedGram = trans(dataRef) * dataRef;
+    if (lambda1 != 0 && lambda2 != 0 && !useCholesky)
+    {
+      sharedGram += lambda2 *
+          arma::eye<DenseMatType>(dataRef.n_cols, dataRef.n_cols);
+    }
+    gram = &sharedGram;
+  }
+
+  models.clear();
+  models.resize(responses.n_rows, LARS(useCholesky, lambda1, lambda2,
+      tolerance, fitIntercept, normalizeData));
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t t = 0; t < responses.n_rows; ++t)
+  {
+    LARS& model = models[t];
+    model.matGram = gram;
+
+    const arma::Row<ElemType> y = responses.row(t);
+    model.TrainPath(dataRef, y, offsetX, stdX);
+
+    // The shared Gram matrix may not outlive this call, so the model must not
+    // keep pointing to it.
+    model.matGram = &model.matGramInternal;
+  }
+}
+
+template<typename ModelMatType>
+inline void LARS<ModelMatType>::SelectBetas(
+    const arma::Col<ElemType>& lambdas,
+    DenseMatType& betas,
+    arma::Row<ElemType>& intercepts)
+{
+  if (betaPath.size() == 0)
+  {
+    throw std::runtime_error("LARS::SelectBetas(): model must be trained "
+        "before calling SelectBetas()!");
+  }
+
+  const ElemType oldLambda1 = selectedLambda1;
+
+  betas.set_size(betaPath[0].n_elem, lambdas.n_elem);
+  intercepts.set_size(lambdas.n_elem);
+  for (size_t i = 0; i < lambdas.n_elem; ++i)
+  {
+    SelectBeta(lambdas[i]);
+    betas.col(i) = DenseMatType(Beta());
+    intercepts[i] = Intercept();
+  }
+
+  // Restore the model that was selected.
+  SelectBeta(oldLambda1);
 }
 
 template<typename ModelMatType>
@@ -18,6 +18,9 @@
 // RegressionDistribution.  Therefore we have to include the prereqs first, and
 // include the core later.
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/chunked_source.hpp>
+
+#include "linear_regression_statistics.hpp"
 
 namespace mlpack {
 
@@ -196,6 +199,43 @@ class LinearRegression
                  const std::optional<double> lambda = std::nullopt,
                  const std::optional<bool> intercept = std::nullopt);
 
+  /**
+   * Train the LinearRegression model on the sufficient statistics of a dataset
+   * (see LinearRegressionStatistics), which can be accumulated one batch at a
+   * time and merged across machines.  The normal equations are the same as for
+   * the other Train() overloads, so the result is the same as training on the
+   * whole dataset at once, up to rounding errors.  Careful!  This will
+   * completely ignore and overwrite the existing model.
+   *
+   * @param stats Sufficient statistics of the dataset.
+   * @param lambda L2 regularization penalty parameter to use.
+   * @param intercept Whether or not to fit an intercept term.
+   * @return The (weighted) least squares error after training.
+   */
+  ElemType Train(const LinearRegressionStatistics<ModelMatType>& stats,
+                 const std::optional<double> lambda = std::nullopt,
+                 const std::optional<bool> intercept = std::nullopt);
+
+  /**
+   * Train the LinearRegression model on a dataset read from disk in chunks,
+   * with a single pass over the data: the sufficient statistics are
+   * accumulated one chunk at a time (splitting each chunk between threads, if
+   * OpenMP is available), and the normal equations are solved once at the
+   * end.  Careful!  This will completely ignore and overwrite the existing
+   * model.
+   *
+   * @param predictors Source of the data points.
+   * @param responses Source of the responses; each point must be a single
+   *     value.
+   * @param lambda L2 regularization penalty parameter to use.
+   * @param intercept Whether or not to fit an intercept term.
+   * @return The least squares error after training.
+   */
+  ElemType Train(data::ChunkedSource<ElemType>& predictors,
+                 data::ChunkedSource<ElemType>& responses,
+                 const std::optional<double> lambda = std::nullopt,
+                 const std::optional<bool> intercept = std::nullopt);
+
   /**
    * Calculate y_i for a single data point.
    *
@@ -170,6 +170,89 @@ LinearRegression<ModelMatType>::Train(const MatType& predictors,
   return ComputeError(predictors, responses);
 }
 
+template<typename ModelMatType>
+inline
+typename LinearRegression<ModelMatType>::ElemType
+LinearRegression<ModelMatType>::Train(
+    const LinearRegressionStatistics<ModelMatType>& stats,
+    const std::optional<double> lambda,
+    const std::optional<bool> intercept)
+{
+  if (lambda.has_value())
+    this->lambda = lambda.value();
+
+  if (intercept.has_value())
+    this->intercept = intercept.value();
+
+  if (stats.NumPoints() == 0)
+  {
+    throw std::invalid_argument("LinearRegression::Train(): no points in the "
+        "given statistics!");
+  }
+
+  // Get the sums of x x^T, x, x y, y and y^2.
+  const size_t d = stats.Dimensionality();
+  ModelMatType xx;
+  ModelColType x, xy;
+  ElemType y, yy;
+  stats.Moments(ModelColType(d, arma::fill::zeros), 0, xx, x, xy, y, yy);
+
+  // Form the same system as when the row of ones is added to the predictors.
+  ModelMatType cov;
+  ModelColType rhs;
+  if (this->intercept)
+  {
+    cov.set_size(d + 1, d + 1);
+    cov(0, 0) = stats.TotalWeight();
+    cov.submat(1, 0, d, 0) = x;
+    cov.submat(0, 1, 0, d) = x.t();
+    cov.submat(1, 1, d, d) = xx;
+
+    rhs.set_size(d + 1);
+    rhs(0) = y;
+    rhs.subvec(1, d) = xy;
+  }
+  else
+  {
+    cov = std::move(xx);
+    rhs = std::move(xy);
+  }
+
+  parameters = arma::solve(cov + ((ElemType) this->lambda) *
+      arma::eye<ModelMatType>(cov.n_rows, cov.n_rows), rhs);
+
+  // ||y - X^T b||^2 = y^T y - 2 b^T X y + b^T X X^T b.
+  const ElemType error = yy - 2 * dot(parameters, rhs) +
+      dot(parameters, cov * parameters);
+  return std::max(error, (ElemType) 0) / stats.TotalWeight();
+}
+
+template<typename ModelMatType>
+inline
+typename LinearRegression<ModelMatType>::ElemType
+LinearRegression<ModelMatType>::Train(
+    data::ChunkedSource<ElemType>& predictors,
+    data::ChunkedSource<ElemType>& responses,
+    const std::optional<double> lambda,
+    const std::optional<bool> intercept)
+{
+  LinearRegressionStatistics<ModelMatType> stats;
+  data::ForEachChunk(predictors, responses,
+      [&](const arma::Mat<ElemType>& predictorsChunk,
+          const arma::Mat<ElemType>& responsesChunk)
+      {
+        if (responsesChunk.n_rows != 1)
+        {
+          throw std::invalid_argument("LinearRegression::Train(): responses "
+              "must have one dimension!");
+        }
+
+        stats.Accumulate(predictorsChunk, responsesChunk);
+      });
+
+  return Train(stats, lambda, intercept);
+}
+
 template<typename ModelMatType>
 template<typename VecType>
 inline
@@ -0,0 +1,166 @@
+/**
+ * @file methods/linear_regression/linear_regression_statistics.hpp
+ *
+ * Definition of LinearRegressionStatistics, which accumulates the sufficient
+ * statistics of a linear least-squares problem over batches of points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_LINEAR_REGRESSION_LINEAR_REGRESSION_STATISTICS_HPP
+#define MLPACK_METHODS_LINEAR_REGRESSION_LINEAR_REGRESSION_STATISTICS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The sufficient statistics of a (weighted) linear least-squares problem: the
+ * total weight of the points, and the weighted sums of X, y, X X^T, X y^T and
+ * y^2.  These are enough to solve the normal equations of linear and ridge
+ * regression exactly, so LinearRegression and BayesianLinearRegression can be
+ * trained on datasets that do not fit in memory with a single pass over the
+ * data, by accumulating the statistics one batch at a time.
+ *
+ * Statistics accumulated separately (for instance on different machines, and
+ * then serialized) can be combined with Merge(); the result is the same as if
+ * all the points had been accumulated into one object.
+ *
+ * @code
+ * LinearRegressionStatistics<> stats;
+ * for (...) // For each batch of points.
+ *   stats.Accumulate(batchPredictors, batchResponses);
+ *
+ * LinearRegression<> lr;
+ * lr.Train(stats, 0.1); // Ridge regression with lambda = 0.1.
+ * @endcode
+ *
+ * Internally, the sums are taken with respect to the mean of the first batch,
+ * so that no precision is lost when the centered moments are recovered, even
+ * if the data is far from the origin.  Accumulate() splits the batch between
+ * threads, if OpenMP is available.
+ *
+ * @tparam ModelMatType Type of matrix used to store the statistics.
+ */
+template<typename ModelMatType = arma::mat>
+class LinearRegressionStatistics
+{
+ public:
+  using ElemType = typename ModelMatType::elem_type;
+  using ColType = typename GetColType<ModelMatType>::type;
+
+  /**
+   * Create an empty set of statistics.  The dimensionality is set by the first
+   * call to Accumulate() or Merge().
+   */
+  LinearRegressionStatistics();
+
+  /**
+   * Add the given points and responses to the statistics.
+   *
+   * @param predictors X, matrix of data points (dense or sparse).
+   * @param responses y, the measured data for each point in X.
+   */
+  template<typename MatType, typename ResponsesType>
+  void Accumulate(const MatType& predictors, const ResponsesType& responses);
+
+  /**
+   * Add the given weighted points and responses to the statistics.
+   *
+   * @param predictors X, matrix of data points (dense or sparse).
+   * @param responses y, the measured data for each point in X.
+   * @param weights Instance weights.
+   */
+  template<typename MatType, typename ResponsesType, typename WeightsType>
+  void Accumulate(const MatType& predictors,
+                  const ResponsesType& responses,
+                  const WeightsType& weights);
+
+  /**
+   * Add the statistics of other points, accumulated separately, to these
+   * statistics.  A std::invalid_argument is thrown if the dimensionalities do
+   * not match.
+   *
+   * @param other Statistics to merge into this object.
+   */
+  void Merge(const LinearRegressionStatistics& other);
+
+  /**
+   * Compute the weighted sums of x x^T, x, x y, y and y^2 over the points,
+   * with x and y taken relative to the given center (cx, cy).  With a zero
+   * center, these are the raw statistics used by the normal equations; with
+   * the mean as the center, they are the centered (scatter) statistics.
+   *
+   * @param cx Center of the points.
+   * @param cy Center of the responses.
+   * @param xx Sum of (x - cx) (x - cx)^T.
+   * @param x Sum of (x - cx).
+   * @param xy Sum of (x - cx) (y - cy).
+   * @param y Sum of (y - cy).
+   * @param yy Sum of (y - cy)^2.
+   */
+  void Moments(const ColType& cx,
+               const ElemType cy,
+               ModelMatType& xx,
+               ColType& x,
+               ColType& xy,
+               ElemType& y,
+               ElemType& yy) const;
+
+  //! Forget every point accumulated so far.
+  void Reset();
+
+  //! Get the dimensionality of the points (0 if no point was accumulated).
+  size_t Dimensionality() const { return shift.n_elem; }
+  //! Get the number of points accumulated so far.
+  size_t NumPoints() const { return numPoints; }
+  //! Get the total weight of the points accumulated so far.
+  ElemType TotalWeight() const { return totalWeight; }
+
+  //! Get the weighted mean of the points.
+  ColType MeanPredictors() const;
+  //! Get the weighted mean of the responses.
+  ElemType MeanResponses() const;
+
+  //! Serialize the statistics.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Accumulate the points with the given weights; weights may be NULL, in
+   * which case every point has weight 1.
+   */
+  template<typename MatType, typename ResponsesType, typename WeightsType>
+  void AccumulateImpl(const MatType& predictors,
+                      const ResponsesType& responses,
+                      const WeightsType* weights);
+
+  //! Number of points accumulated.
+  size_t numPoints;
+  //! Total weight of the points.
+  ElemType totalWeight;
+  //! Center of the points that the sums are taken relative to.
+  ColType shift;
+  //! Center of the responses that the sums are taken relative to.
+  ElemType responsesShift;
+  //! Weighted sum of (x - shift).
+  ColType sumX;
+  //! Weighted sum of (y - responsesShift).
+  ElemType sumY;
+  //! Weighted sum of (x - shift) (x - shift)^T.
+  ModelMatType sumXX;
+  //! Weighted sum of (x - shift) (y - responsesShift).
+  ColType sumXY;
+  //! Weighted sum of (y - responsesShift)^2.
+  ElemType sumYY;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "linear_regression_statistics_impl.hpp"
+
+#endif
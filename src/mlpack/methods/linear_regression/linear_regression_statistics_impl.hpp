@@ -0,0 +1,254 @@
+/**
+ * @file methods/linear_regression/linear_regression_statistics_impl.hpp
+ *
+ * Implementation of LinearRegressionStatistics.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_LINEAR_REGRESSION_LINEAR_REGRESSION_STATISTICS_IMPL_HPP
+#define MLPACK_METHODS_LINEAR_REGRESSION_LINEAR_REGRESSION_STATISTICS_IMPL_HPP
+
+#include "linear_regression_statistics.hpp"
+
+namespace mlpack {
+
+template<typename ModelMatType>
+LinearRegressionStatistics<ModelMatType>::LinearRegressionStatistics() :
+    numPoints(0),
+    totalWeight(0),
+    responsesShift(0),
+    sumY(0),
+    sumYY(0)
+{
+  // Nothing to do.
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType>
+void LinearRegressionStatistics<ModelMatType>::Accumulate(
+    const MatType& predictors,
+    const ResponsesType& responses)
+{
+  AccumulateImpl(predictors, responses, (const ResponsesType*) NULL);
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType, typename WeightsType>
+void LinearRegressionStatistics<ModelMatType>::Accumulate(
+    const MatType& predictors,
+    const ResponsesType& responses,
+    const WeightsType& weights)
+{
+  util::CheckSameSizes(predictors, weights,
+      "LinearRegressionStatistics::Accumulate()", "weights");
+  AccumulateImpl(predictors, responses, &weights);
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType, typename WeightsType>
+void LinearRegressionStatistics<ModelMatType>::AccumulateImpl(
+    const MatType& predictors,
+    const ResponsesType& responses,
+    const WeightsType* weights)
+{
+  using RowType = arma::Row<ElemType>;
+
+  util::CheckSameSizes(predictors, responses,
+      "LinearRegressionStatistics::Accumulate()");
+
+  const size_t n = predictors.n_cols;
+  if (n == 0)
+    return;
+
+  const size_t d = predictors.n_rows;
+  if (shift.n_elem == 0)
+  {
+    // Center the sums on the first points, so that the centered moments can
+    // be recovered without losing precision.
+    const size_t firstEnd = std::min(n, (size_t) 256) - 1;
+    const ModelMatType first =
+        ConvTo<ModelMatType>::From(predictors.cols(0, firstEnd));
+    shift = arma::mean(first, 1);
+    responsesShift = arma::mean(
+        ConvTo<RowType>::From(responses.cols(0, firstEnd)));
+
+    sumX.zeros(d);
+    sumXX.zeros(d, d);
+    sumXY.zeros(d);
+  }
+  else if (d != shift.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "LinearRegressionStatistics::Accumulate(): predictors have " << d
+        << " dimensions, but the statistics have " << shift.n_elem << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Each thread accumulates contiguous blocks of points into its own sums.
+  const size_t blockSize = 256;
+  const size_t numBlocks = (n + blockSize - 1) / blockSize;
+
+  #pragma omp parallel
+  {
+    ModelMatType localXX(d, d, arma::fill::zeros);
+    ColType localX(d, arma::fill::zeros);
+    ColType localXY(d, arma::fill::zeros);
+    ElemType localW = 0, localY = 0, localYY = 0;
+
+    ModelMatType block, weightedBlock;
+    RowType r, w;
+
+    #pragma omp for schedule(static)
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t end = std::min(begin + blockSize, n) - 1;
+
+      block = ConvTo<ModelMatType>::From(predictors.cols(begin, end));
+      block.each_col() -= shift;
+      r = ConvTo<RowType>::From(responses.cols(begin, end)) - responsesShift;
+
+      if (weights)
+        w = ConvTo<RowType>::From(weights->cols(begin, end));
+      else
+        w.ones(block.n_cols);
+
+      weightedBlock = block.each_row() % w;
+      localXX += weightedBlock * block.t();
+      localX += arma::sum(weightedBlock, 1);
+      localXY += weightedBlock * r.t();
+      localW += arma::accu(w);
+      localY += arma::dot(w, r);
+      localYY += arma::dot(w % r, r);
+    }
+
+    #pragma omp critical
+    {
+      sumXX += localXX;
+      sumX += localX;
+      sumXY += localXY;
+      totalWeight += localW;
+      sumY += localY;
+      sumYY += localYY;
+    }
+  }
+
+  numPoints += n;
+}
+
+template<typename ModelMatType>
+void LinearRegressionStatistics<ModelMatType>::Merge(
+    const LinearRegressionStatistics& other)
+{
+  if (other.numPoints == 0)
+    return;
+
+  if (numPoints == 0)
+  {
+    *this = other;
+    return;
+  }
+
+  if (other.Dimensionality() != Dimensionality())
+  {
+    std::ostringstream oss;
+    oss << "LinearRegressionStatistics::Merge(): statistics have "
+        << other.Dimensionality() << " dimensions, but these have "
+        << Dimensionality() << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Express the other statistics relative to our center.
+  ModelMatType xx;
+  ColType x, xy;
+  ElemType y, yy;
+  other.Moments(shift, responsesShift, xx, x, xy, y, yy);
+
+  numPoints += other.numPoints;
+  totalWeight += other.totalWeight;
+  sumXX += xx;
+  sumX += x;
+  sumXY += xy;
+  sumY += y;
+  sumYY += yy;
+}
+
+template<typename ModelMatType>
+void LinearRegressionStatistics<ModelMatType>::Moments(
+    const ColType& cx,
+    const ElemType cy,
+    ModelMatType& xx,
+    ColType& x,
+    ColType& xy,
+    ElemType& y,
+    ElemType& yy) const
+{
+  // With x - cx = (x - shift) + dx and y - cy = (y - responsesShift) + dy,
+  // expand each sum.
+  const ColType dx = shift - cx;
+  const ElemType dy = responsesShift - cy;
+
+  xx = sumXX + sumX * dx.t() + dx * sumX.t() + totalWeight * (dx * dx.t());
+  x = sumX + totalWeight * dx;
+  xy = sumXY + dy * sumX + sumY * dx + (totalWeight * dy) * dx;
+  y = sumY + totalWeight * dy;
+  yy = sumYY + 2 * dy * sumY + totalWeight * dy * dy;
+}
+
+template<typename ModelMatType>
+void LinearRegressionStatistics<ModelMatType>::Reset()
+{
+  numPoints = 0;
+  totalWeight = 0;
+  shift.reset();
+  responsesShift = 0;
+  sumX.reset();
+  sumY = 0;
+  sumXX.reset();
+  sumXY.reset();
+  sumYY = 0;
+}
+
+template<typename ModelMatType>
+typename LinearRegressionStatistics<ModelMatType>::ColType
+LinearRegressionStatistics<ModelMatType>::MeanPredictors() const
+{
+  if (totalWeight == 0)
+    return shift;
+
+  return shift + sumX / totalWeight;
+}
+
+template<typename ModelMatType>
+typename LinearRegressionStatistics<ModelMatType>::ElemType
+LinearRegressionStatistics<ModelMatType>::MeanResponses() const
+{
+  if (totalWeight == 0)
+    return responsesShift;
+
+  return responsesShift + sumY / totalWeight;
+}
+
+template<typename ModelMatType>
+template<typename Archive>
+void LinearRegressionStatistics<ModelMatType>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numPoints));
+  ar(CEREAL_NVP(totalWeight));
+  ar(CEREAL_NVP(shift));
+  ar(CEREAL_NVP(responsesShift));
+  ar(CEREAL_NVP(sumX));
+  ar(CEREAL_NVP(sumY));
+  ar(CEREAL_NVP(sumXX));
+  ar(CEREAL_NVP(sumXY));
+  ar(CEREAL_NVP(sumYY));
+}
+
+} // namespace mlpack
+
+#endif
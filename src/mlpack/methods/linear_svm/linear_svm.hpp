@@ -333,6 +333,66 @@ class LinearSVM
                  const std::optional<bool> fitIntercept = std::nullopt,
                  CallbackTypes&&... callbacks);
 
+  /**
+   * Train the Linear SVM with dual coordinate descent, using the current values
+   * of Lambda(), Delta() and FitIntercept().  Instead of the multi-class hinge
+   * loss of LinearSVMFunction, this trains one binary SVM for each class
+   * against all the others (minimizing (lambda / 2) ||w_k||^2 plus the mean of
+   * max(0, delta - y_ik w_k^T x_i)), in parallel; prediction is unchanged.
+   * This is usually much faster than the primal optimizers for sparse,
+   * high-dimensional data, since each update only touches the nonzeros of one
+   * point.  The current parameters are not used as a starting point.
+   *
+   * @param data Input training features. Each column associate with one sample.
+   * @param labels Labels associated with the feature data.
+   * @param numClasses Number of classes for classification.
+   * @param solver Dual coordinate descent solver.
+   * @return Sum of the objectives of the binary classifiers.
+   */
+  template<typename MatType>
+  ElemType Train(const MatType& data,
+                 const arma::Row<size_t>& labels,
+                 const size_t numClasses,
+                 DualCoordinateDescent& solver);
+
+  /**
+   * Train the Linear SVM on data that is read from disk in chunks, so that the
+   * full dataset never has to be in memory.  For each epoch, the optimizer is
+   * run on each chunk of `data` (and the corresponding chunk of `labels`) in
+   * turn, starting from the current model parameters and using the current
+   * values of Lambda(), Delta() and FitIntercept().  This is only useful with
+   * stochastic optimizers (such as ens::SGD), whose MaxIterations() should be
+   * set to roughly the chunk size.
+   *
+   * @tparam OptimizerType Desired optimizer.
+   * @param data Source of input training features. Each column associate with
+   *     one sample.
+   * @param labels Source of labels associated with the feature data; each point
+   *     must be a single label.
+   * @param numClasses Number of classes for classification.
+   * @param optimizer Desired optimizer.
+   * @param epochs Number of passes over the whole dataset.
+   * @param callbacks Callback Functions.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return Sum of the objective values for each chunk in the last epoch.
+   */
+  template<typename OptimizerType,
+           typename... CallbackTypes,
+           typename = std::enable_if_t<IsEnsOptimizer<
+               OptimizerType,
+               LinearSVMFunction<arma::Mat<ElemType>, ModelMatType>,
+               ModelMatType
+           >::value>,
+           typename = std::enable_if_t<IsEnsCallbackTypes<
+               CallbackTypes...
+           >::value>>
+  ElemType Train(data::ChunkedSource<ElemType>& data,
+                 data::ChunkedSource<size_t>& labels,
+                 const size_t numClasses,
+                 OptimizerType& optimizer,
+                 const size_t epochs = 1,
+                 CallbackTypes&&... callbacks);
+
   /**
    * Classify the given points, returning the predicted labels for each point.
    * The function calculates the probabilities for every class, given a data
@@ -398,6 +458,13 @@ class LinearSVM
                 size_t& label,
                 DenseColType& probabilities) const;
 
+  /**
+   * Return a LinearScorer holding a copy of the weights (one column per class)
+   * and intercepts of the model, for low-latency classification and top-k
+   * label selection.
+   */
+  LinearScorer<DenseMatType> Scorer() const;
+
   /**
    * Computes accuracy of the learned model given the feature data and the
    * labels associated with each data point. Predictions are made using the
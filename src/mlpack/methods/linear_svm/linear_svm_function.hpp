@@ -15,6 +15,8 @@
 #define MLPACK_METHODS_LINEAR_SVM_LINEAR_SVM_FUNCTION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/sparse_columns.hpp>
+#include <mlpack/core/optimizers/function_traits.hpp>
 
 namespace mlpack {
 
@@ -22,6 +24,11 @@ namespace mlpack {
  * The hinge loss function for the linear SVM objective function.
  * This is used by various ensmallen optimizers to train the linear
  * SVM model.
+ *
+ * When MatType is a sparse matrix, the scores and the gradients are computed
+ * directly on the compressed sparse column storage of the dataset, so that a
+ * batch of points is never copied or transposed, and the cost of the data term
+ * is proportional to the number of nonzero elements of the batch.
  */
 template<typename MatType = arma::mat, typename ParametersType = arma::mat>
 class LinearSVMFunction
@@ -115,6 +122,11 @@ class LinearSVMFunction
    * Evaluate the gradient of the hinge loss function, following
    * the LinearFunctionType requirements on the Gradient function.
    *
+   * If the dataset and the gradient are both sparse, the gradient is only
+   * nonzero for the intercept and the features that are nonzero in the batch,
+   * and only those are regularized, as in lock-free parallel SGD (see
+   * HogwildSGD).
+   *
    * @tparam GradType Type of the gradient matrix.
    * @param parameters The parameters of the SVM.
    * @param firstId Index of the datapoint to use for the gradient evaluation.
@@ -184,6 +196,36 @@ class LinearSVMFunction
   size_t NumFunctions() const;
 
  private:
+  /**
+   * Compute the score of each class for each of the points in [firstId,
+   * firstId + batchSize).
+   */
+  void Scores(const ParametersType& parameters,
+              const size_t firstId,
+              const size_t batchSize,
+              DenseMatType& scores) const;
+
+  /**
+   * Store in gradient the gradient of the objective over the points in
+   * [firstId, firstId + batchSize), given the difference matrix of these
+   * points.  If both the gradient and the dataset are sparse, only the rows of
+   * the features that are nonzero in the batch are regularized.
+   */
+  template<typename GradType>
+  void BatchGradient(const ParametersType& parameters,
+                     const DenseMatType& difference,
+                     const size_t firstId,
+                     const size_t batchSize,
+                     GradType& gradient) const;
+
+  //! Compute the gradient of BatchGradient() into a dense matrix.
+  template<typename GradType>
+  void BatchDenseGradient(const ParametersType& parameters,
+                          const DenseMatType& difference,
+                          const size_t firstId,
+                          const size_t batchSize,
+                          GradType& gradient) const;
+
   //! The initial point, from which to start the optimization.
   ParametersType initialPoint;
 
@@ -207,6 +249,14 @@ class LinearSVMFunction
   bool fitIntercept;
 };
 
+//! With a sparse dataset, the separable gradient can be sparse.
+template<typename MatType, typename ParametersType>
+class FunctionTraits<LinearSVMFunction<MatType, ParametersType>>
+{
+ public:
+  static const bool SparseGradient = arma::is_SpMat<MatType>::value;
+};
+
 } // namespace mlpack
 
 // Include implementation
@@ -159,21 +159,7 @@ LinearSVMFunction<MatType, ParametersType>::Evaluate(
   // Scores for each class are evaluated.
   DenseMatType scores;
 
-  // Check intercept condition.
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset;
-  }
-  else
-  {
-    // When using `fitIntercept` we need to add the `b_i` term explicitly.
-    // The first `parameters.n_rows - 1` rows of parameters holds the value
-    // of Weights `w_i`, and the last row holds `b_i`.
-    // On calculating the score, we add `b_i` term to each element of
-    // `i_th` row of `scores`.
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
-        + repmat(parameters.row(dataset.n_rows).t(), 1, dataset.n_cols);
-  }
+  Scores(parameters, 0, dataset.n_cols, scores);
 
   // Evaluate the margin by the following steps:
   //  - Subtracting the score of correct class from all the class scores.
@@ -209,18 +195,7 @@ LinearSVMFunction<MatType, ParametersType>::Evaluate(
   // Scores for each class are evaluated.
   DenseMatType scores;
 
-  // Check intercept condition.
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset.cols(firstId, lastId);
-  }
-  else
-  {
-    scores = parameters.rows(0, dataset.n_rows - 1).t()
-        * dataset.cols(firstId, lastId)
-        + repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
-  }
+  Scores(parameters, firstId, batchSize, scores);
 
   DenseMatType margin = scores - (repmat(ones(numClasses).t()
       * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
@@ -252,15 +227,7 @@ void LinearSVMFunction<MatType, ParametersType>::Gradient(
   // Scores for each class are evaluated.
   DenseMatType scores;
 
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset;
-  }
-  else
-  {
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
-        + repmat(parameters.row(dataset.n_rows).t(), 1, dataset.n_cols);
-  }
+  Scores(parameters, 0, dataset.n_cols, scores);
 
   DenseMatType margin = scores - (repmat(ones(numClasses).t()
       * (scores % groundTruth), numClasses, 1)) + delta
@@ -281,24 +248,7 @@ void LinearSVMFunction<MatType, ParametersType>::Gradient(
   //  - Take the average over the size of dataset.
   //  - Add the regularization parameter.
 
-  // Check intercept condition
-  if (!fitIntercept)
-  {
-    gradient = dataset * difference.t();
-  }
-  else
-  {
-    gradient.set_size(arma::size(parameters));
-    gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-        dataset * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-        ones<DenseRowType>(dataset.n_cols) * difference.t();
-  }
-
-  gradient /= dataset.n_cols;
-
-  // Adding the regularization contribution to the gradient.
-  gradient += lambda * parameters;
+  BatchGradient(parameters, difference, 0, dataset.n_cols, gradient);
 }
 
 template<typename MatType, typename ParametersType>
@@ -314,17 +264,7 @@ void LinearSVMFunction<MatType, ParametersType>::Gradient(
   // Scores for each class are evaluated.
   DenseMatType scores;
 
-  // Check intercept condition.
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset.cols(firstId, lastId);
-  }
-  else
-  {
-    scores = parameters.rows(0, dataset.n_rows - 1).t()
-        * dataset.cols(firstId, lastId)
-        + repmat(parameters.row(dataset.n_rows).t(), 1, batchSize);
-  }
+  Scores(parameters, firstId, batchSize, scores);
 
   DenseMatType margin = scores - (repmat(ones(numClasses).t()
       * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
@@ -338,24 +278,7 @@ void LinearSVMFunction<MatType, ParametersType>::Gradient(
   DenseMatType difference = groundTruth.cols(firstId, lastId)
       % (-repmat(sum(mask), numClasses, 1)) + mask;
 
-  // Check intercept condition
-  if (!fitIntercept)
-  {
-    gradient = dataset.cols(firstId, lastId) * difference.t();
-  }
-  else
-  {
-    gradient.set_size(arma::size(parameters));
-    gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-        dataset.cols(firstId, lastId) * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-        ones<DenseRowType>(batchSize) * difference.t();
-  }
-
-  gradient /= batchSize;
-
-  // Adding the regularization contribution to the gradient.
-  gradient += lambda * parameters;
+  BatchGradient(parameters, difference, firstId, batchSize, gradient);
 }
 
 template<typename MatType, typename ParametersType>
@@ -370,16 +293,7 @@ LinearSVMFunction<MatType, ParametersType>::EvaluateWithGradient(
   // Scores for each class are evaluated.
   DenseMatType scores;
 
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset;
-  }
-  else
-  {
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
-        + repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
-  }
+  Scores(parameters, 0, dataset.n_cols, scores);
 
   DenseMatType margin = scores - (repmat(
       ones<DenseColType>(numClasses).t() * (scores % groundTruth),
@@ -393,24 +307,7 @@ LinearSVMFunction<MatType, ParametersType>::EvaluateWithGradient(
   DenseMatType difference = groundTruth
       % (-repmat(sum(mask), numClasses, 1)) + mask;
 
-  // Check intercept condition
-  if (!fitIntercept)
-  {
-    gradient = dataset * difference.t();
-  }
-  else
-  {
-    gradient.set_size(arma::size(parameters));
-    gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-            dataset * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-            ones<DenseRowType>(dataset.n_cols) * difference.t();
-  }
-
-  gradient /= dataset.n_cols;
-
-  // Adding the regularization contribution to the gradient.
-  gradient += lambda * parameters;
+  BatchGradient(parameters, difference, 0, dataset.n_cols, gradient);
 
   // The Hinge Loss Function
   loss = accu(arma::clamp(margin, 0.0, DBL_MAX));
@@ -441,17 +338,7 @@ LinearSVMFunction<MatType, ParametersType>::EvaluateWithGradient(
   // Scores for each class are evaluated.
   DenseMatType scores;
 
-  // Check intercept condition.
-  if (!fitIntercept)
-  {
-    scores = parameters.t() * dataset.cols(firstId, lastId);
-  }
-  else
-  {
-    scores = parameters.rows(0, dataset.n_rows - 1).t()
-        * dataset.cols(firstId, lastId)
-        + repmat(parameters.row(dataset.n_rows).t(), 1, (lastId - firstId + 1));
-  }
+  Scores(parameters, firstId, batchSize, scores);
 
   DenseMatType margin = scores - (repmat(ones(numClasses).t()
       * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
@@ -465,25 +352,7 @@ LinearSVMFunction<MatType, ParametersType>::EvaluateWithGradient(
   DenseMatType difference = groundTruth.cols(firstId, lastId)
       % (-repmat(sum(mask), numClasses, 1)) + mask;
 
-  // Check intercept condition
-  if (!fitIntercept)
-  {
-    gradient = dataset.cols(firstId, lastId) * difference.t();
-  }
-  else
-  {
-    gradient.set_size(arma::size(parameters));
-    gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
-        dataset.cols(firstId, lastId) * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-        ones<DenseRowType>(batchSize) * difference.t();
-  }
-
-  gradient /= batchSize;
-
-
-  // Adding the regularization contribution to the gradient.
-  gradient += lambda * parameters;
+  BatchGradient(parameters, difference, firstId, batchSize, gradient);
 
   // The Hinge Loss Function
   loss = accu(arma::clamp(margin, 0.0, DBL_MAX));
@@ -497,6 +366,113 @@ LinearSVMFunction<MatType, ParametersType>::EvaluateWithGradient(
   return cost;
 }
 
+template<typename MatType, typename ParametersType>
+void LinearSVMFunction<MatType, ParametersType>::Scores(
+    const ParametersType& parameters,
+    const size_t firstId,
+    const size_t batchSize,
+    DenseMatType& scores) const
+{
+  // When using `fitIntercept` we need to add the `b_i` term explicitly.
+  // The first `parameters.n_rows - 1` rows of parameters holds the value
+  // of Weights `w_i`, and the last row holds `b_i`.
+  // On calculating the score, we add `b_i` term to each element of
+  // `i_th` row of `scores`.
+  if constexpr (arma::is_SpMat<MatType>::value)
+  {
+    // The intercept row of the parameters is ignored by the product.
+    SparseColumnsProduct(parameters, dataset, firstId, batchSize, scores);
+  }
+  else if (firstId == 0 && batchSize == dataset.n_cols)
+  {
+    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset;
+  }
+  else
+  {
+    scores = parameters.rows(0, dataset.n_rows - 1).t() *
+        dataset.cols(firstId, firstId + batchSize - 1);
+  }
+
+  if (fitIntercept)
+    scores.each_col() += parameters.row(dataset.n_rows).t();
+}
+
+template<typename MatType, typename ParametersType>
+template<typename GradType>
+void LinearSVMFunction<MatType, ParametersType>::BatchGradient(
+    const ParametersType& parameters,
+    const DenseMatType& difference,
+    const size_t firstId,
+    const size_t batchSize,
+    GradType& gradient) const
+{
+  if constexpr (arma::is_SpMat<GradType>::value &&
+                arma::is_SpMat<MatType>::value)
+  {
+    // Only the rows of the features that are nonzero in the batch (and the
+    // intercept) are nonzero, and only those are regularized.  The transpose
+    // is built first, with the features as columns.
+    GradType gradientT;
+    SparseColumnsOuterProduct(dataset, firstId, batchSize, difference, 0,
+        parameters.n_rows, gradientT);
+    if (fitIntercept)
+      gradientT.col(dataset.n_rows) = sum(difference, 1);
+
+    gradient = gradientT.t() / batchSize;
+    gradient += ElemType(lambda) * (spones(gradient) % parameters);
+  }
+  else if constexpr (arma::is_SpMat<GradType>::value)
+  {
+    // Every feature is touched by dense data.
+    DenseMatType denseGradient;
+    BatchDenseGradient(parameters, difference, firstId, batchSize,
+        denseGradient);
+    gradient = GradType(denseGradient);
+  }
+  else
+  {
+    BatchDenseGradient(parameters, difference, firstId, batchSize, gradient);
+  }
+}
+
+template<typename MatType, typename ParametersType>
+template<typename GradType>
+void LinearSVMFunction<MatType, ParametersType>::BatchDenseGradient(
+    const ParametersType& parameters,
+    const DenseMatType& difference,
+    const size_t firstId,
+    const size_t batchSize,
+    GradType& gradient) const
+{
+  gradient.set_size(arma::size(parameters));
+  if constexpr (arma::is_SpMat<MatType>::value)
+  {
+    // Only the rows of the features that are nonzero in the batch are
+    // modified.
+    gradient.zeros();
+    SparseColumnsAccumulate(dataset, firstId, batchSize, difference,
+        gradient);
+  }
+  else if (firstId == 0 && batchSize == dataset.n_cols)
+  {
+    gradient.rows(0, dataset.n_rows - 1) = dataset * difference.t();
+  }
+  else
+  {
+    gradient.rows(0, dataset.n_rows - 1) =
+        dataset.cols(firstId, firstId + batchSize - 1) * difference.t();
+  }
+
+  // The intercept gets the sum of the differences of each class.
+  if (fitIntercept)
+    gradient.row(dataset.n_rows) = sum(difference, 1).t();
+
+  // Take the average over the batch, and add the regularization contribution
+  // to the gradient.
+  gradient /= batchSize;
+  gradient += lambda * parameters;
+}
+
 template<typename MatType, typename ParametersType>
 size_t LinearSVMFunction<MatType, ParametersType>::NumFunctions() const
 {
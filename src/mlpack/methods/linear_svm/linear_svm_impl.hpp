@@ -219,6 +219,68 @@ typename LinearSVM<ModelMatType>::ElemType LinearSVM<ModelMatType>::Train(
   return out;
 }
 
+template<typename ModelMatType>
+template<typename MatType>
+typename LinearSVM<ModelMatType>::ElemType LinearSVM<ModelMatType>::Train(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    DualCoordinateDescent& solver)
+{
+  if (numClasses <= 1)
+  {
+    throw std::invalid_argument("LinearSVM dataset has 0 number of classes!");
+  }
+
+  if (lambda <= 0.0 || delta <= 0.0)
+  {
+    throw std::invalid_argument("LinearSVM::Train(): lambda and delta must be "
+        "positive to train with dual coordinate descent!");
+  }
+
+  this->numClasses = numClasses;
+
+  // With w = delta v, the problem for each class is delta^2 lambda times the
+  // standard SVM problem (1 / 2) ||v||^2 + C sum_i max(0, 1 - y_ik v^T x_i),
+  // with C = 1 / (lambda delta n).
+  const double c = 1.0 / (lambda * delta * data.n_cols);
+  arma::Mat<ElemType> weights;
+  const ElemType out = ElemType(lambda * delta * delta) *
+      solver.SolveOneVsRest(data, labels, numClasses, c, fitIntercept, weights);
+  parameters = ElemType(delta) * weights;
+
+  Log::Info << "LinearSVM::Train(): final objective of the one-vs-rest "
+            << "classifiers is " << out << "." << std::endl;
+
+  return out;
+}
+
+template<typename ModelMatType>
+template<typename OptimizerType, typename... CallbackTypes, typename, typename>
+typename LinearSVM<ModelMatType>::ElemType LinearSVM<ModelMatType>::Train(
+    data::ChunkedSource<ElemType>& data,
+    data::ChunkedSource<size_t>& labels,
+    const size_t numClasses,
+    OptimizerType& optimizer,
+    const size_t epochs,
+    CallbackTypes&&... callbacks)
+{
+  ElemType out = 0;
+  for (size_t e = 0; e < epochs; ++e)
+  {
+    out = 0;
+    data::ForEachChunk(data, labels,
+        [&](const arma::Mat<ElemType>& dataChunk,
+            const arma::Mat<size_t>& labelsChunk)
+        {
+          out += Train(dataChunk, arma::Row<size_t>(labelsChunk), numClasses,
+              optimizer, callbacks...);
+        });
+  }
+
+  return out;
+}
+
 template<typename ModelMatType>
 template<typename MatType>
 void LinearSVM<ModelMatType>::Classify(
@@ -240,19 +302,17 @@ void LinearSVM<ModelMatType>::Classify(
 
   if (fitIntercept)
   {
-    scores = parameters.rows(0, parameters.n_rows - 2).t() * data
-        + repmat(parameters.row(parameters.n_rows - 1).t(), 1, data.n_cols);
+    LinearScorer<DenseMatType>::ComputeScores(
+        parameters.head_rows(parameters.n_rows - 1),
+        DenseColType(parameters.row(parameters.n_rows - 1).t()), data, scores);
   }
   else
   {
-    scores = parameters.t() * data;
+    LinearScorer<DenseMatType>::ComputeScores(parameters, DenseColType(), data,
+        scores);
   }
 
-  // Prepare necessary data.
-  labels.zeros(data.n_cols);
-
-  labels = ConvTo<arma::Row<size_t>>::From(
-      arma::index_max(scores));
+  labels = ConvTo<arma::Row<size_t>>::From(arma::index_max(scores, 0));
 }
 
 template<typename ModelMatType>
@@ -264,8 +324,8 @@ void LinearSVM<ModelMatType>::Classify(
 
   if (fitIntercept)
   {
-    scores = parameters.rows(0, parameters.n_rows - 2).t() * data
-        + repmat(parameters.row(parameters.n_rows - 1).t(), 1, data.n_cols);
+    scores = parameters.rows(0, parameters.n_rows - 2).t() * data;
+    scores.each_col() += parameters.row(parameters.n_rows - 1).t();
   }
   else
   {
@@ -277,9 +337,26 @@ template<typename ModelMatType>
 template<typename VecType>
 size_t LinearSVM<ModelMatType>::Classify(const VecType& point) const
 {
-  arma::Row<size_t> label(1);
-  Classify(point, label);
-  return size_t(label(0));
+  // Only build the error message if it is needed, so that nothing is
+  // allocated.
+  if (point.n_rows != FeatureSize())
+  {
+    util::CheckSameDimensionality(point, FeatureSize(),
+        "LinearSVM::Classify()", "point");
+  }
+
+  // Score each class in place, without building a score matrix.
+  if (fitIntercept)
+  {
+    return LinearScorer<DenseMatType>::ArgMax(
+        parameters.head_rows(parameters.n_rows - 1),
+        parameters.row(parameters.n_rows - 1), point);
+  }
+  else
+  {
+    return LinearScorer<DenseMatType>::ArgMax(parameters, DenseColType(),
+        point);
+  }
 }
 
 template<typename ModelMatType>
@@ -294,6 +371,23 @@ void LinearSVM<ModelMatType>::Classify(
   label = labelRow[0];
 }
 
+template<typename ModelMatType>
+LinearScorer<typename LinearSVM<ModelMatType>::DenseMatType>
+LinearSVM<ModelMatType>::Scorer() const
+{
+  if (fitIntercept)
+  {
+    return LinearScorer<DenseMatType>(
+        DenseMatType(parameters.head_rows(parameters.n_rows - 1)),
+        DenseColType(parameters.row(parameters.n_rows - 1).t()));
+  }
+  else
+  {
+    return LinearScorer<DenseMatType>(DenseMatType(parameters),
+        DenseColType());
+  }
+}
+
 template<typename ModelMatType>
 template<typename MatType>
 double LinearSVM<ModelMatType>::ComputeAccuracy(
@@ -83,14 +83,17 @@ void Constraints<MatType, LabelsType, DistanceType>::TargetNeighbors(
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
-
-  UMatType neighbors;
-  MatType distances;
-
+  // The classes are independent (each writes only the columns of its own
+  // points), so their searches are run in parallel.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
   {
+    // KNN instance.
+    KNN knn;
+
+    UMatType neighbors;
+    MatType distances;
+
     // Perform KNN search with same class points as both reference
     // set and query set.
     knn.Train(dataset.cols(indexSame[i]));
@@ -126,17 +129,20 @@ void Constraints<MatType, LabelsType, DistanceType>::TargetNeighbors(
   MatType subDataset = dataset.cols(begin, begin + batchSize - 1);
   LabelsType sublabels = labels.cols(begin, begin + batchSize - 1);
 
-  // KNN instance.
-  KNN knn;
+  // The classes are independent (each writes only the columns of its own
+  // points), so their searches are run in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
+  {
+    // KNN instance.
+    KNN knn;
 
-  UMatType neighbors;
-  MatType distances;
+    UMatType neighbors;
+    MatType distances;
 
-  // Vectors to store indices.
-  UVecType subIndexSame;
+    // Vectors to store indices.
+    UVecType subIndexSame;
 
-  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
-  {
     // Calculate Target Neighbors.
     subIndexSame = arma::find(sublabels == uniqueLabels[i]);
 
@@ -169,14 +175,17 @@ void Constraints<MatType, LabelsType, DistanceType>::Impostors(
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
-
-  UMatType neighbors;
-  MatType distances;
-
+  // The classes are independent (each writes only the columns of its own
+  // points), so their searches are run in parallel.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
   {
+    // KNN instance.
+    KNN knn;
+
+    UMatType neighbors;
+    MatType distances;
+
     // Perform KNN search with differently labeled points as reference
     // set and  same class points as query set.
     knn.Train(dataset.cols(indexDiff[i]));
@@ -208,14 +217,17 @@ void Constraints<MatType, LabelsType, DistanceType>::Impostors(
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
-
-  UMatType neighbors;
-  MatType distances;
-
+  // The classes are independent (each writes only the columns of its own
+  // points), so their searches are run in parallel.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
   {
+    // KNN instance.
+    KNN knn;
+
+    UMatType neighbors;
+    MatType distances;
+
     // Perform KNN search with differently labeled points as reference
     // set and  same class points as query set.
     knn.Train(dataset.cols(indexDiff[i]));
@@ -252,17 +264,20 @@ void Constraints<MatType, LabelsType, DistanceType>::Impostors(
   MatType subDataset = dataset.cols(begin, begin + batchSize - 1);
   LabelsType sublabels = labels.cols(begin, begin + batchSize - 1);
 
-  // KNN instance.
-  KNN knn;
+  // The classes are independent (each writes only the columns of its own
+  // points), so their searches are run in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
+  {
+    // KNN instance.
+    KNN knn;
 
-  UMatType neighbors;
-  MatType distances;
+    UMatType neighbors;
+    MatType distances;
 
-  // Vectors to store indices.
-  UVecType subIndexSame;
+    // Vectors to store indices.
+    UVecType subIndexSame;
 
-  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
-  {
     // Calculate impostors.
     subIndexSame = arma::find(sublabels == uniqueLabels[i]);
 
@@ -302,17 +317,20 @@ void Constraints<MatType, LabelsType, DistanceType>::Impostors(
   MatType subDataset = dataset.cols(begin, begin + batchSize - 1);
   LabelsType sublabels = labels.cols(begin, begin + batchSize - 1);
 
-  // KNN instance.
-  KNN knn;
+  // The classes are independent (each writes only the columns of its own
+  // points), so their searches are run in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
+  {
+    // KNN instance.
+    KNN knn;
 
-  UMatType neighbors;
-  MatType distances;
+    UMatType neighbors;
+    MatType distances;
 
-  // Vectors to store indices.
-  UVecType subIndexSame;
+    // Vectors to store indices.
+    UVecType subIndexSame;
 
-  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
-  {
     // Calculate impostors.
     subIndexSame = arma::find(sublabels == uniqueLabels[i]);
 
@@ -350,21 +368,28 @@ void Constraints<MatType, LabelsType, DistanceType>::Impostors(
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
+  // The classes are independent (each writes only the columns of its own
+  // points), so their searches are run in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
+  {
+    // KNN instance.
+    KNN knn;
 
-  UMatType neighbors;
-  MatType distances;
+    UMatType neighbors;
+    MatType distances;
 
-  // Vectors to store indices.
-  UVecType subIndexSame;
+    // Vectors to store indices.
+    UVecType subIndexSame;
 
-  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
-  {
     // Calculate impostors.
     subIndexSame = arma::find(labels.cols(points.head(numPoints)) ==
         uniqueLabels[i]);
 
+    // No point of this class needs to be re-queried.
+    if (subIndexSame.n_elem == 0)
+      continue;
+
     // Perform KNN search with differently labeled points as reference
     // set and same class points as query set.
     knn.Train(dataset.cols(indexDiff[i]));
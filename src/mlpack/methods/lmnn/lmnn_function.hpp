@@ -246,6 +246,11 @@ class LMNNFunction
   VecType lastTransformationIndices;
   //! Used for storing points to re-calculate impostors for.
   UVecType points;
+  //! Holds, for each point, the norm of the change in transformation since
+  //! its impostors were last calculated.
+  VecType impostorDrift;
+  //! Holds the transformation matrix of the last impostor update.
+  MatType impostorTransformation;
   //! Flag for controlling use of bounds over impostors.
   bool impBounds;
   /**
@@ -254,6 +259,9 @@ class LMNNFunction
   * uses batches.
   */
   inline void Precalculate();
+  //! Re-calculate the impostors of the points whose impostors could have
+  //! changed since they were last calculated.
+  inline void UpdateImpostors(const MatType& transformation);
   //! Update cache transformation matrices.
   inline void UpdateCache(const MatType& transformation,
                           const size_t begin,
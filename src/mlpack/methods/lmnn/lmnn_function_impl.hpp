@@ -60,6 +60,10 @@ LMNNFunction<MatType, LabelsType, DistanceType>::LMNNFunction(
   lastTransformationIndices.set_size(dataset.n_cols);
   lastTransformationIndices.zeros();
 
+  // The initial impostors are calculated on the untransformed dataset.
+  impostorDrift.zeros(dataset.n_cols);
+  impostorTransformation = initialPoint;
+
   // Reserve the first element of cache.
   MatType emptyMat;
   oldTransformationMatrices.push_back(emptyMat);
@@ -102,6 +106,7 @@ void LMNNFunction<MatType, LabelsType, DistanceType>::Shuffle()
   VecType newlastTransformationIndices = lastTransformationIndices;
   MatType newMaxImpNorm = maxImpNorm;
   VecType newNorm = norm;
+  VecType newImpostorDrift = impostorDrift;
 
   // Generate ordering.
   UVecType ordering = arma::shuffle(arma::linspace<UVecType>(0,
@@ -115,6 +120,7 @@ void LMNNFunction<MatType, LabelsType, DistanceType>::Shuffle()
   maxImpNorm = newMaxImpNorm.cols(ordering);
   lastTransformationIndices = newlastTransformationIndices.elem(ordering);
   norm = newNorm.elem(ordering);
+  impostorDrift = newImpostorDrift.elem(ordering);
 
   for (size_t i = 0; i < ordering.n_elem; ++i)
   {
@@ -126,6 +132,37 @@ void LMNNFunction<MatType, LabelsType, DistanceType>::Shuffle()
   constraint.TargetNeighbors(targetNeighbors, dataset, labels, norm);
 }
 
+// Re-calculate impostors of the points whose margins could have been crossed.
+template<typename MatType, typename LabelsType, typename DistanceType>
+inline void LMNNFunction<MatType, LabelsType, DistanceType>::UpdateImpostors(
+    const MatType& transformation)
+{
+  // The bound below has to hold for the whole change in transformation since
+  // the impostors of a point were calculated, and not only for the change
+  // since the last call, so accumulate it for every point.
+  impostorDrift += arma::norm(transformation - impostorTransformation);
+  impostorTransformation = transformation;
+
+  // Track number of data points to use for impostors calculation.
+  size_t numPoints = 0;
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    if (impostorDrift(i) * (2 * norm(i) + norm(impostors(k - 1, i)) +
+        norm(impostors(k, i))) > distanceMat(k, i) - distanceMat(k - 1, i))
+    {
+      points(numPoints++) = i;
+    }
+  }
+
+  // Re-calculate impostors on transformed dataset.
+  constraint.Impostors(impostors, distanceMat, transformedDataset, labels,
+      norm, points, numPoints);
+
+  // The impostors of these points are now up to date.
+  impostorDrift.elem(points.head(numPoints)).zeros();
+}
+
 // Update cache transformation matrices.
 template<typename MatType, typename LabelsType, typename DistanceType>
 inline void LMNNFunction<MatType, LabelsType, DistanceType>::UpdateCache(
@@ -213,21 +250,9 @@ LMNNFunction<MatType, LabelsType, DistanceType>::Evaluate(
   {
     if (impBounds)
     {
-      // Track number of data points to use for impostors calculatiom.
-      size_t numPoints = 0;
-
-      for (size_t i = 0; i < dataset.n_cols; ++i)
-      {
-        if (transformationDiff * (2 * norm(i) + norm(impostors(k - 1, i)) +
-            norm(impostors(k, i))) > distanceMat(k, i) - distanceMat(k - 1, i))
-        {
-          points(numPoints++) = i;
-        }
-      }
-
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distanceMat,
-          transformedDataset, labels, norm, points, numPoints);
+      // Only re-calculate the impostors of the points whose margins could
+      // have been crossed.
+      UpdateImpostors(transformation);
     }
     else
     {
@@ -470,21 +495,9 @@ void LMNNFunction<MatType, LabelsType, DistanceType>::Gradient(
 
     if (impBounds)
     {
-      // Track number of data points to use for impostors calculatiom.
-      size_t numPoints = 0;
-
-      for (size_t i = 0; i < dataset.n_cols; ++i)
-      {
-        if (transformationDiff * (2 * norm(i) + norm(impostors(k - 1, i)) +
-            norm(impostors(k, i))) > distanceMat(k, i) - distanceMat(k - 1, i))
-        {
-          points(numPoints++) = i;
-        }
-      }
-
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distanceMat,
-          transformedDataset, labels, norm, points, numPoints);
+      // Only re-calculate the impostors of the points whose margins could
+      // have been crossed.
+      UpdateImpostors(transformation);
     }
     else
     {
@@ -747,21 +760,9 @@ LMNNFunction<MatType, LabelsType, DistanceType>::EvaluateWithGradient(
   {
     if (impBounds)
     {
-      // Track number of data points to use for impostors calculatiom.
-      size_t numPoints = 0;
-
-      for (size_t i = 0; i < dataset.n_cols; ++i)
-      {
-        if (transformationDiff * (2 * norm(i) + norm(impostors(k - 1, i)) +
-            norm(impostors(k, i))) > distanceMat(k, i) - distanceMat(k - 1, i))
-        {
-          points(numPoints++) = i;
-        }
-      }
-
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distanceMat,
-          transformedDataset, labels, norm, points, numPoints);
+      // Only re-calculate the impostors of the points whose margins could
+      // have been crossed.
+      UpdateImpostors(transformation);
     }
     else
     {
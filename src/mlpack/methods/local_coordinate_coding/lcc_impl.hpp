@@ -126,36 +126,39 @@ inline void LocalCoordinateCoding<MatType>::Encode(const MatType& data,
       data.n_cols) + repmat(sum(square(data)), atoms, 1) - 2 * trans(dictionary)
       * data);
 
-  MatType dictGram = trans(dictionary) * dictionary;
-  MatType dictGramTD(dictGram.n_rows, dictGram.n_cols);
+  // The Gram matrix of the dictionary is computed once and shared (read-only)
+  // by all points; only its weighting depends on the point.
+  const MatType dictGram = trans(dictionary) * dictionary;
+
+  Log::Debug << "Encoding " << data.n_cols << " points." << std::endl;
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
+  #pragma omp parallel
   {
-    // Report progress.
-    if ((i % 100) == 0)
-    {
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
-    }
-
-    ColType invW = invSqDists.unsafe_col(i);
-    MatType dictPrime = dictionary * diagmat(invW);
-
-    MatType dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
-
-    bool useCholesky = false;
+    // Each thread reuses its own LARS object and weighted matrices for all of
+    // its points.
+    const bool useCholesky = false;
     // Normalization and fitting and intercept are disabled.
     const double tol = std::is_same_v<typename MatType::elem_type, float> ?
         1e-8 : 1e-16;
     LARS<MatType> lars(useCholesky, 0.5 * lambda, 0, tol, false, false);
+    MatType dictPrime, dictGramTD;
 
-    // Run LARS for this point, by making an alias of the point and passing
-    // that.
-    ColType beta = codes.unsafe_col(i);
-    RowType responses = data.unsafe_col(i).t();
-    lars.Train(dictPrime, responses, false, useCholesky, dictGramTD);
-    beta = lars.Beta();
-    beta %= invW; // Remember, beta is an alias of codes.col(i).
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      ColType invW = invSqDists.unsafe_col(i);
+      dictPrime = dictionary.each_row() % invW.t();
+      dictGramTD = dictGram % (invW * invW.t());
+
+      // Run LARS for this point, by making an alias of the point and passing
+      // that.
+      ColType beta = codes.unsafe_col(i);
+      RowType responses = data.unsafe_col(i).t();
+      lars.Train(dictPrime, responses, false, useCholesky, dictGramTD);
+      beta = lars.Beta();
+      beta %= invW; // Remember, beta is an alias of codes.col(i).
+    }
   }
 }
 
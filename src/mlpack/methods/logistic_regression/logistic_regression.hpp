@@ -278,6 +278,59 @@ class LogisticRegression
                  const double lambda,
                  CallbackTypes&&... callbacks);
 
+  /**
+   * Train the LogisticRegression model with dual coordinate descent, using the
+   * current value of Lambda(), which must be positive.  This is usually much
+   * faster than the primal optimizers for sparse, high-dimensional data, since
+   * each update only touches the nonzeros of one point.  Unlike the other
+   * Train() overloads, the intercept is regularized like the other parameters
+   * (as in LIBLINEAR), and the current parameters are not used as a starting
+   * point.
+   *
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param solver Dual coordinate descent solver.
+   * @return The final objective of the trained model (with the regularized
+   *     intercept).
+   */
+  ElemType Train(const MatType& predictors,
+                 const arma::Row<size_t>& responses,
+                 DualCoordinateDescent& solver);
+
+  /**
+   * Train the LogisticRegression model on data that is read from disk in
+   * chunks, so that the full dataset never has to be in memory.  For each
+   * epoch, the optimizer is run on each chunk of `predictors` (and the
+   * corresponding chunk of `responses`) in turn, starting from the current
+   * model parameters.  This is only useful with stochastic optimizers (such as
+   * ens::SGD), whose MaxIterations() should be set to roughly the chunk size
+   * so that each call makes a single pass over the chunk.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Source of input training variables.
+   * @param responses Source of outputs for each training point; each point
+   *     must be a single label.
+   * @param optimizer Instantiated optimizer with instantiated error function.
+   * @param epochs Number of passes over the whole dataset.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The sum of the final objectives for each chunk in the last epoch.
+   */
+  template<typename OptimizerType,
+           typename... CallbackTypes,
+           typename = std::enable_if_t<IsEnsOptimizer<
+               OptimizerType, LogisticRegressionFunction<MatType>, RowType
+           >::value>,
+           typename = std::enable_if_t<IsEnsCallbackTypes<
+               CallbackTypes...
+           >::value>>
+  ElemType Train(data::ChunkedSource<ElemType>& predictors,
+                 data::ChunkedSource<size_t>& responses,
+                 OptimizerType& optimizer,
+                 const size_t epochs = 1,
+                 CallbackTypes&&... callbacks);
+
   //! Return the parameters (the b vector).
   const RowType& Parameters() const { return parameters; }
   //! Modify the parameters (the b vector).
@@ -365,6 +418,18 @@ class LogisticRegression
   void Classify(const MatType& dataset,
                 MatType& probabilities) const;
 
+  /**
+   * Return a LinearScorer for the model, for low-latency classification.  The
+   * scorer has two classes: the score of class 0 is zero, and the score of
+   * class 1 is the logit of the model minus the logit of the decision
+   * boundary, so that a point is predicted as class 1 when its probability is
+   * above the decision boundary.
+   *
+   * @param decisionBoundary Decision boundary (default 0.5).
+   */
+  LinearScorer<typename GetDenseMatType<MatType>::type> Scorer(
+      const double decisionBoundary = 0.5) const;
+
   /**
    * Reset the weights in the model to zeros.  This function can be used between
    * calls to Train(), to force learning of a new model instead of incremental
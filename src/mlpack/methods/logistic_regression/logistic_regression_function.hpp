@@ -17,6 +17,8 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/make_alias.hpp>
 #include <mlpack/core/math/shuffle_data.hpp>
+#include <mlpack/core/math/sparse_columns.hpp>
+#include <mlpack/core/optimizers/function_traits.hpp>
 
 namespace mlpack {
 
@@ -24,6 +26,11 @@ namespace mlpack {
  * The log-likelihood function for the logistic regression objective function.
  * This is used by various mlpack optimizers to train a logistic regression
  * model.
+ *
+ * When MatType is a sparse matrix, the objective and its gradients are computed
+ * directly on the compressed sparse column storage of the predictors: a batch
+ * of points is never copied or transposed, and the cost of the data term is
+ * proportional to the number of nonzero elements of the batch.
  */
 template<typename MatType = arma::mat>
 class LogisticRegressionFunction
@@ -110,6 +117,11 @@ class LogisticRegressionFunction
    * the dataset. This is useful for optimizers such as SGD, which require a
    * separable objective function.
    *
+   * If the predictors and the gradient are both sparse, the gradient is only
+   * nonzero for the intercept and the features that are nonzero in the batch,
+   * and only those features are regularized, as in lock-free parallel SGD (see
+   * HogwildSGD).
+   *
    * @param parameters Vector of logistic regression parameters.
    * @param begin Index of the starting point to use for objective function
    *     gradient evaluation.
@@ -167,6 +179,40 @@ class LogisticRegressionFunction
   size_t NumFeatures() const { return predictors.n_rows + 1; }
 
  private:
+  /**
+   * Compute the linear part parameters(0, 0) + w^T x of the model for each of
+   * the points in [begin, begin + batchSize).
+   */
+  template<typename CoordinatesType, typename OutType>
+  void LinearPredictions(const CoordinatesType& parameters,
+                         const size_t begin,
+                         const size_t batchSize,
+                         OutType& out) const;
+
+  /**
+   * Store in gradient the gradient of the objective over the points in [begin,
+   * begin + batchSize), given diffs = sigmoids - responses for these points.
+   * The gradient of the regularization term is scaled by regularizationScale.
+   * If both the gradient and the predictors are sparse, only the features that
+   * are nonzero in the batch are regularized.
+   */
+  template<typename CoordinatesType, typename GradType>
+  void BatchGradient(const CoordinatesType& parameters,
+                     const CoordinatesType& diffs,
+                     const size_t begin,
+                     const size_t batchSize,
+                     const double regularizationScale,
+                     GradType& gradient) const;
+
+  //! Compute the gradient of BatchGradient() into a dense matrix.
+  template<typename CoordinatesType, typename GradType>
+  void BatchDenseGradient(const CoordinatesType& parameters,
+                          const CoordinatesType& diffs,
+                          const size_t begin,
+                          const size_t batchSize,
+                          const double regularizationScale,
+                          GradType& gradient) const;
+
   //! The matrix of data points (predictors).  This is an alias until shuffling
   //! is done.
   MatType predictors;
@@ -177,6 +223,14 @@ class LogisticRegressionFunction
   double lambda;
 };
 
+//! With sparse predictors, the separable gradient can be sparse.
+template<typename MatType>
+class FunctionTraits<LogisticRegressionFunction<MatType>>
+{
+ public:
+  static const bool SparseGradient = arma::is_SpMat<MatType>::value;
+};
+
 } // namespace mlpack
 
 // Include implementation.
@@ -94,8 +94,9 @@ LogisticRegressionFunction<MatType>::Evaluate(
 
   // Calculate vectors of sigmoids.  The intercept term is parameters(0, 0) and
   // does not need to be multiplied by any of the predictors.
-  const CoordinatesType sigmoid = one / (one + exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+  CoordinatesType sigmoid;
+  LinearPredictions(parameters, 0, predictors.n_cols, sigmoid);
+  sigmoid = one / (one + exp(-sigmoid));
 
   // Assemble full objective function.  Often the objective function and the
   // regularization as given are divided by the number of features, but this
@@ -138,9 +139,9 @@ LogisticRegressionFunction<MatType>::Evaluate(
           parameters.tail_cols(parameters.n_elem - 1));
 
   // Calculate the sigmoid function values.
-  const CoordinatesType sigmoid = one / (one + exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1))));
+  CoordinatesType sigmoid;
+  LinearPredictions(parameters, begin, batchSize, sigmoid);
+  sigmoid = one / (one + exp(-sigmoid));
 
   // Compute the objective for the given batch size from a given point.
   CoordinatesType respD = ConvTo<CoordinatesType>::From(
@@ -161,22 +162,17 @@ void LogisticRegressionFunction<MatType>::Gradient(
 {
   using ElemType = typename CoordinatesType::elem_type;
 
-  // Regularization term.
-  GradType regularization;
-  regularization = lambda * parameters.tail_cols(parameters.n_elem - 1);
-
   // Specifying this here makes the code below a little bit cleaner, and avoids
   // accidentally casting an entire expression to `double`, e.g., by the use of
   // `1.0` or similar.
   constexpr ElemType one = ((ElemType) 1);
 
-  const CoordinatesType sigmoids = (one / (one + exp(-parameters(0, 0)
-      - parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+  CoordinatesType sigmoids;
+  LinearPredictions(parameters, 0, predictors.n_cols, sigmoids);
+  sigmoids = one / (one + exp(-sigmoids));
 
-  gradient.set_size(size(parameters));
-  gradient[0] = -accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  BatchGradient(parameters, sigmoids - ConvTo<CoordinatesType>::From(
+      responses), 0, predictors.n_cols, 1.0, gradient);
 }
 
 //! Evaluate the gradient of the logistic regression objective function for a
@@ -191,28 +187,19 @@ void LogisticRegressionFunction<MatType>::Gradient(
 {
   using ElemType = typename CoordinatesType::elem_type;
 
-  // Regularization term.
-  GradType regularization;
-  regularization = lambda * parameters.tail_cols(parameters.n_elem - 1)
-      / predictors.n_cols * batchSize;
-
   // Specifying this here makes the code below a little bit cleaner, and avoids
   // accidentally casting an entire expression to `double`, e.g., by the use of
   // `1.0` or similar.
   constexpr ElemType one = ((ElemType) 1);
 
-  const CoordinatesType exponents = parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1);
   // Calculating the sigmoid function values.
-  const CoordinatesType sigmoids = one / (one + exp(-exponents));
+  CoordinatesType sigmoids;
+  LinearPredictions(parameters, begin, batchSize, sigmoids);
+  sigmoids = one / (one + exp(-sigmoids));
 
-  gradient.set_size(parameters.n_rows, parameters.n_cols);
-  gradient[0] = -accu(responses.subvec(begin, begin + batchSize - 1) -
-      sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  BatchGradient(parameters, sigmoids - ConvTo<CoordinatesType>::From(
+      responses.subvec(begin, begin + batchSize - 1)), begin, batchSize,
+      ((double) batchSize) / predictors.n_cols, gradient);
 }
 
 /**
@@ -233,8 +220,10 @@ void LogisticRegressionFunction<MatType>::PartialGradient(
   // `1.0` or similar.
   constexpr ElemType one = ((ElemType) 1);
 
-  const CoordinatesType diffs = responses - (one / (one + exp(-parameters(0, 0)
-      - parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+  CoordinatesType diffs;
+  LinearPredictions(parameters, 0, predictors.n_cols, diffs);
+  diffs = ConvTo<CoordinatesType>::From(responses) - (one / (one +
+      exp(-diffs)));
 
   gradient.set_size(size(parameters));
 
@@ -242,6 +231,25 @@ void LogisticRegressionFunction<MatType>::PartialGradient(
   {
     gradient[j] = -accu(diffs);
   }
+  else if constexpr (arma::is_SpMat<MatType>::value)
+  {
+    // Extracting a row of a sparse matrix is slow; instead, look for the
+    // feature in the (sorted) row indices of each column.
+    predictors.sync();
+    ElemType result = 0;
+    for (size_t i = 0; i < predictors.n_cols; ++i)
+    {
+      const arma::uword* first = predictors.row_indices +
+          predictors.col_ptrs[i];
+      const arma::uword* last = predictors.row_indices +
+          predictors.col_ptrs[i + 1];
+      const arma::uword* pos = std::lower_bound(first, last, j - 1);
+      if (pos != last && *pos == j - 1)
+        result -= predictors.values[pos - predictors.row_indices] * diffs[i];
+    }
+
+    gradient[j] = result + lambda * parameters(0, j);
+  }
   else
   {
     gradient[j] = dot(-predictors.row(j - 1), diffs) + lambda *
@@ -264,27 +272,21 @@ LogisticRegressionFunction<MatType>::EvaluateWithGradient(
   constexpr ElemType one = ((ElemType) 1);
   constexpr ElemType two = ((ElemType) 2);
 
-  // Regularization term.
-  GradType regularization = lambda *
-      parameters.tail_cols(parameters.n_elem - 1);
-
   const ElemType objectiveRegularization = lambda / two *
       dot(parameters.tail_cols(parameters.n_elem - 1),
           parameters.tail_cols(parameters.n_elem - 1));
 
   // Calculate the sigmoid function values.
-  const CoordinatesType sigmoids = one / (one + exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) * predictors)));
+  CoordinatesType sigmoids;
+  LinearPredictions(parameters, 0, predictors.n_cols, sigmoids);
+  sigmoids = one / (one + exp(-sigmoids));
 
-  gradient.set_size(size(parameters));
-  gradient[0] = -accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  const CoordinatesType respD = ConvTo<CoordinatesType>::From(responses);
+  BatchGradient(parameters, sigmoids - respD, 0, predictors.n_cols, 1.0,
+      gradient);
 
   // Now compute the objective function using the sigmoids.
-  ElemType result = accu(log(one -
-      ConvTo<CoordinatesType>::From(responses) + sigmoids %
-      (two * ConvTo<CoordinatesType>::From(responses) - one)));
+  ElemType result = accu(log(one - respD + sigmoids % (two * respD - one)));
 
   // Invert the result, because it's a minimization.
   return objectiveRegularization - result;
@@ -307,31 +309,22 @@ LogisticRegressionFunction<MatType>::EvaluateWithGradient(
   constexpr ElemType one = ((ElemType) 1);
   constexpr ElemType two = ((ElemType) 2);
 
-  // Regularization term.
-  GradType regularization =
-      lambda * parameters.tail_cols(parameters.n_elem - 1) / predictors.n_cols *
-      batchSize;
-
   const ElemType objectiveRegularization = lambda *
       (batchSize / (two * predictors.n_cols)) *
       dot(parameters.tail_cols(parameters.n_elem - 1),
           parameters.tail_cols(parameters.n_elem - 1));
 
   // Calculate the sigmoid function values.
-  const CoordinatesType sigmoids = one / (one + exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1))));
+  CoordinatesType sigmoids;
+  LinearPredictions(parameters, begin, batchSize, sigmoids);
+  sigmoids = one / (one + exp(-sigmoids));
 
-  gradient.set_size(parameters.n_rows, parameters.n_cols);
-  gradient[0] = -accu(responses.subvec(begin, begin + batchSize - 1) -
-      sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  const CoordinatesType respD = ConvTo<CoordinatesType>::From(
+      responses.subvec(begin, begin + batchSize - 1));
+  BatchGradient(parameters, sigmoids - respD, begin, batchSize,
+      ((double) batchSize) / predictors.n_cols, gradient);
 
   // Now compute the objective function using the sigmoids.
-  CoordinatesType respD = ConvTo<CoordinatesType>::From(
-      responses.subvec(begin, begin + batchSize - 1));
   const ElemType result = accu(log(one - respD + sigmoids %
       (two * respD - one)));
 
@@ -339,6 +332,111 @@ LogisticRegressionFunction<MatType>::EvaluateWithGradient(
   return objectiveRegularization - result;
 }
 
+template<typename MatType>
+template<typename CoordinatesType, typename OutType>
+void LogisticRegressionFunction<MatType>::LinearPredictions(
+    const CoordinatesType& parameters,
+    const size_t begin,
+    const size_t batchSize,
+    OutType& out) const
+{
+  if constexpr (arma::is_SpMat<MatType>::value)
+  {
+    // The weights (without the intercept) as a column, without a copy.
+    using ElemType = typename CoordinatesType::elem_type;
+    const arma::Mat<ElemType> weights(const_cast<ElemType*>(
+        parameters.memptr()) + 1, predictors.n_rows, 1, false, true);
+
+    SparseColumnsProduct(weights, predictors, begin, batchSize, out);
+    out += parameters(0, 0);
+  }
+  else if (begin == 0 && batchSize == predictors.n_cols)
+  {
+    out = parameters(0, 0) + parameters.tail_cols(parameters.n_elem - 1) *
+        predictors;
+  }
+  else
+  {
+    out = parameters(0, 0) + parameters.tail_cols(parameters.n_elem - 1) *
+        predictors.cols(begin, begin + batchSize - 1);
+  }
+}
+
+template<typename MatType>
+template<typename CoordinatesType, typename GradType>
+void LogisticRegressionFunction<MatType>::BatchGradient(
+    const CoordinatesType& parameters,
+    const CoordinatesType& diffs,
+    const size_t begin,
+    const size_t batchSize,
+    const double regularizationScale,
+    GradType& gradient) const
+{
+  using ElemType = typename GradType::elem_type;
+
+  if constexpr (arma::is_SpMat<GradType>::value &&
+                arma::is_SpMat<MatType>::value)
+  {
+    // The gradient is only nonzero for the intercept and the features that
+    // are nonzero in the batch; only those features are regularized.
+    SparseColumnsOuterProduct(predictors, begin, batchSize, diffs, 1,
+        parameters.n_elem, gradient);
+    gradient += ElemType(lambda * regularizationScale) *
+        (spones(gradient) % parameters);
+    gradient(0, 0) = accu(diffs);
+  }
+  else if constexpr (arma::is_SpMat<GradType>::value)
+  {
+    // Every feature is touched by dense data.
+    arma::Mat<ElemType> denseGradient;
+    BatchDenseGradient(parameters, diffs, begin, batchSize,
+        regularizationScale, denseGradient);
+    gradient = GradType(denseGradient);
+  }
+  else
+  {
+    BatchDenseGradient(parameters, diffs, begin, batchSize,
+        regularizationScale, gradient);
+  }
+}
+
+template<typename MatType>
+template<typename CoordinatesType, typename GradType>
+void LogisticRegressionFunction<MatType>::BatchDenseGradient(
+    const CoordinatesType& parameters,
+    const CoordinatesType& diffs,
+    const size_t begin,
+    const size_t batchSize,
+    const double regularizationScale,
+    GradType& gradient) const
+{
+  using ElemType = typename GradType::elem_type;
+
+  gradient.set_size(parameters.n_rows, parameters.n_cols);
+  gradient[0] = accu(diffs);
+  gradient.tail_cols(parameters.n_elem - 1) = (lambda * regularizationScale) *
+      parameters.tail_cols(parameters.n_elem - 1);
+
+  if constexpr (arma::is_SpMat<MatType>::value)
+  {
+    // Only the features that are nonzero in the batch get a contribution from
+    // the data.
+    arma::Mat<ElemType> dataGradient(gradient.memptr() + 1, predictors.n_rows,
+        1, false, true);
+    SparseColumnsAccumulate(predictors, begin, batchSize, diffs,
+        dataGradient);
+  }
+  else if (begin == 0 && batchSize == predictors.n_cols)
+  {
+    gradient.tail_cols(parameters.n_elem - 1) += diffs * predictors.t();
+  }
+  else
+  {
+    gradient.tail_cols(parameters.n_elem - 1) += diffs *
+        predictors.cols(begin, begin + batchSize - 1).t();
+  }
+}
+
 } // namespace mlpack
 
 #endif
@@ -154,6 +154,69 @@ LogisticRegression<MatType>::Train(
       std::forward<CallbackTypes>(callbacks)...);
 }
 
+template<typename MatType>
+typename LogisticRegression<MatType>::ElemType
+LogisticRegression<MatType>::Train(
+    const MatType& predictors,
+    const arma::Row<size_t>& responses,
+    DualCoordinateDescent& solver)
+{
+  if (lambda <= 0.0)
+  {
+    throw std::invalid_argument("LogisticRegression::Train(): lambda must be "
+        "positive to train with dual coordinate descent!");
+  }
+
+  util::CheckSameSizes(predictors, responses, "LogisticRegression::Train()",
+      "responses");
+
+  arma::Col<ElemType> labels(responses.n_elem);
+  for (size_t i = 0; i < responses.n_elem; ++i)
+    labels[i] = (responses[i] == 1) ? ElemType(1) : ElemType(-1);
+
+  // The objective is lambda times (1 / 2) ||w||^2 + C sum_i log(1 +
+  // exp(-y_i w^T x_i)) with C = 1 / lambda.  The solver stores the intercept
+  // last, but it is the first parameter here.
+  arma::Col<ElemType> weights;
+  const ElemType out = ElemType(lambda) * solver.SolveLogistic(predictors,
+      labels, 1.0 / lambda, true, weights);
+  parameters.set_size(predictors.n_rows + 1);
+  parameters[0] = weights[predictors.n_rows];
+  parameters.tail_cols(predictors.n_rows) =
+      weights.head(predictors.n_rows).t();
+
+  Log::Info << "LogisticRegression::Train(): final objective of trained model "
+      << "is " << out << "." << std::endl;
+
+  return out;
+}
+
+template<typename MatType>
+template<typename OptimizerType, typename... CallbackTypes, typename, typename>
+typename LogisticRegression<MatType>::ElemType
+LogisticRegression<MatType>::Train(
+    data::ChunkedSource<ElemType>& predictors,
+    data::ChunkedSource<size_t>& responses,
+    OptimizerType& optimizer,
+    const size_t epochs,
+    CallbackTypes&&... callbacks)
+{
+  ElemType out = 0;
+  for (size_t e = 0; e < epochs; ++e)
+  {
+    out = 0;
+    data::ForEachChunk(predictors, responses,
+        [&](const arma::Mat<ElemType>& predictorsChunk,
+            const arma::Mat<size_t>& responsesChunk)
+        {
+          out += Train(predictorsChunk, arma::Row<size_t>(responsesChunk),
+              optimizer, callbacks...);
+        });
+  }
+
+  return out;
+}
+
 template<typename MatType>
 template<typename VecType>
 size_t LogisticRegression<MatType>::Classify(const VecType& point,
@@ -238,6 +301,23 @@ void LogisticRegression<MatType>::Classify(const MatType& dataset,
       (one - ((ElemType) decisionBoundary)));
 }
 
+template<typename MatType>
+LinearScorer<typename GetDenseMatType<MatType>::type>
+LogisticRegression<MatType>::Scorer(const double decisionBoundary) const
+{
+  using DenseMatType = typename GetDenseMatType<MatType>::type;
+
+  DenseMatType weights(parameters.n_elem - 1, 2, arma::fill::zeros);
+  weights.col(1) = parameters.tail_cols(parameters.n_elem - 1).t();
+
+  ColType biases(2);
+  biases[0] = 0;
+  biases[1] = parameters(0) -
+      ElemType(std::log(decisionBoundary / (1.0 - decisionBoundary)));
+
+  return LinearScorer<DenseMatType>(std::move(weights), std::move(biases));
+}
+
 template<typename MatType>
 void LogisticRegression<MatType>::Reset()
 {
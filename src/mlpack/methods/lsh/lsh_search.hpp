@@ -286,9 +286,24 @@ class LSHSearch
   //! Get the bucket size of the second hash.
   size_t BucketSize() const { return bucketSize; }
 
-  //! Get the second hash table.
-  const std::vector<arma::Col<size_t>>& SecondHashTable() const
-      { return secondHashTable; }
+  //! Get the offsets of the buckets in BucketContents().  The points in the
+  //! bucket held in row r are BucketContents()[BucketOffsets()[r]] through
+  //! BucketContents()[BucketOffsets()[r + 1] - 1].
+  const arma::Col<size_t>& BucketOffsets() const { return bucketOffsets; }
+
+  //! Get the contents of every bucket of the second hash table, stored
+  //! contiguously (see BucketOffsets()).
+  const arma::Col<size_t>& BucketContents() const { return bucketContents; }
+
+  //! Get the row holding each second hash value (or secondHashSize if the
+  //! bucket is empty).
+  const arma::Col<size_t>& BucketRowInHashTable() const
+  { return bucketRowInHashTable; }
+
+  //! Get a copy of the second hash table, with one vector for each bucket.
+  [[deprecated("Will be removed in mlpack 5.0.0; use BucketOffsets() and "
+      "BucketContents()")]]
+  std::vector<arma::Col<size_t>> SecondHashTable() const;
 
   //! Get the projection tables.
   const arma::cube& Projections() { return projections; }
@@ -303,24 +318,40 @@ class LSHSearch
 
  private:
   /**
-   * This function takes a query and hashes it into each of the hash tables to
-   * get keys for the query and then the key is hashed to a bucket of the second
-   * hash table and all the points (if any) in those buckets are collected as
-   * the potential neighbor candidates.
+   * Project the queries in the given range of the query set with each of the
+   * first 'numTablesToSearch' tables, and add the offsets.  The projections
+   * of all the queries into a table are computed with a single matrix
+   * multiplication.
    *
-   * @param queryPoint The query point currently being processed.
+   * @param querySet Set of query points.
+   * @param begin Index of the first query point to project.
+   * @param end One past the index of the last query point to project.
+   * @param numTablesToSearch The number of tables to project the queries with.
+   * @param queryProjections Cube to store the projections in; slice i holds
+   *    the (numProj x (end - begin)) projections into table i.
+   */
+  void ProjectQueries(const MatType& querySet,
+                      const size_t begin,
+                      const size_t end,
+                      const size_t numTablesToSearch,
+                      arma::cube& queryProjections) const;
+
+  /**
+   * This function takes the projections of a query into each of the hash
+   * tables to get keys for the query and then the key is hashed to a bucket of
+   * the second hash table and all the points (if any) in those buckets are
+   * collected as the potential neighbor candidates.
+   *
+   * @param queryCodesNotFloored The projections of the query (with offsets)
+   *    into each of the tables to search, one column per table.
    * @param referenceIndices The list of neighbor candidates obtained from
    *    hashing the query into all the hash tables and eventually into
    *    multiple buckets of the second hash table.
-   * @param numTablesToSearch The number of tables to perform the search in. If
-   *    0, all tables are searched.
    * @param T The number of additional probing bins for multiprobe LSH. If 0,
    *    single-probe is used.
    */
-  template<typename VecType>
-  void ReturnIndicesFromTable(const VecType& queryPoint,
+  void ReturnIndicesFromTable(const arma::mat& queryCodesNotFloored,
                               arma::uvec& referenceIndices,
-                              size_t numTablesToSearch,
                               const size_t T) const;
 
   /**
@@ -446,15 +477,16 @@ class LSHSearch
   //! The bucket size of the second hash.
   size_t bucketSize;
 
-  //! The final hash table; should be (< secondHashSize) vectors each with
-  //! (<= bucketSize) elements.
-  std::vector<arma::Col<size_t>> secondHashTable;
+  //! The start of each row of the final hash table in bucketContents, plus
+  //! one past the end of the last row; should have (<= secondHashSize + 1)
+  //! elements.
+  arma::Col<size_t> bucketOffsets;
 
-  //! The number of elements present in each hash bucket; should be
-  //! secondHashSize.
-  arma::Col<size_t> bucketContentSize;
+  //! The final hash table: the contents of every row, each with
+  //! (<= bucketSize) elements, stored one after the other.
+  arma::Col<size_t> bucketContents;
 
-  //! For a particular hash value, points to the row in secondHashTable
+  //! For a particular hash value, points to the row in the final hash table
   //! corresponding to this value. Length secondHashSize.
   arma::Col<size_t> bucketRowInHashTable;
 
@@ -479,6 +511,9 @@ class LSHSearch
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename SortPolicy, typename MatType),
+    (mlpack::LSHSearch<SortPolicy, MatType>), (1));
+
 // Include implementation.
 #include "lsh_search_impl.hpp"
 
@@ -82,8 +82,8 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(const LSHSearch& other) :
     secondHashSize(other.secondHashSize),
     secondHashWeights(other.secondHashWeights),
     bucketSize(other.bucketSize),
-    secondHashTable(other.secondHashTable),
-    bucketContentSize(other.bucketContentSize),
+    bucketOffsets(other.bucketOffsets),
+    bucketContents(other.bucketContents),
     bucketRowInHashTable(other.bucketRowInHashTable),
     distanceEvaluations(other.distanceEvaluations)
 {
@@ -102,8 +102,8 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(LSHSearch&& other) :
     secondHashSize(other.secondHashSize),
     secondHashWeights(std::move(other.secondHashWeights)),
     bucketSize(other.bucketSize),
-    secondHashTable(std::move(other.secondHashTable)),
-    bucketContentSize(std::move(other.bucketContentSize)),
+    bucketOffsets(std::move(other.bucketOffsets)),
+    bucketContents(std::move(other.bucketContents)),
     bucketRowInHashTable(std::move(other.bucketRowInHashTable)),
     distanceEvaluations(other.distanceEvaluations)
 {
@@ -130,8 +130,8 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashSize = other.secondHashSize;
   secondHashWeights = other.secondHashWeights;
   bucketSize = other.bucketSize;
-  secondHashTable = other.secondHashTable;
-  bucketContentSize = other.bucketContentSize;
+  bucketOffsets = other.bucketOffsets;
+  bucketContents = other.bucketContents;
   bucketRowInHashTable = other.bucketRowInHashTable;
   distanceEvaluations = other.distanceEvaluations;
 
@@ -152,8 +152,8 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashSize = other.secondHashSize;
   secondHashWeights = std::move(other.secondHashWeights);
   bucketSize = other.bucketSize;
-  secondHashTable = std::move(other.secondHashTable);
-  bucketContentSize = std::move(other.bucketContentSize);
+  bucketOffsets = std::move(other.bucketOffsets);
+  bucketContents = std::move(other.bucketContents);
   bucketRowInHashTable = std::move(other.bucketRowInHashTable);
   distanceEvaluations = other.distanceEvaluations;
 
@@ -253,10 +253,11 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
   }
 
   // We will store the second hash vectors in this matrix; the second hash
-  // vector for table i will be held in row i.  We have to use int and not
-  // size_t, otherwise negative numbers are cast to 0.
-  arma::Mat<size_t> secondHashVectors(numTables, this->referenceSet.n_cols);
+  // vector for table i will be held in column i.
+  arma::Mat<size_t> secondHashVectors(this->referenceSet.n_cols, numTables);
 
+  // The tables are independent, so they are hashed in parallel.
+  #pragma omp parallel for schedule(static)
   for (size_t i = 0; i < numTables; ++i)
   {
     // Step IV: create the 'numProj'-dimensional key for each point in each
@@ -270,13 +271,11 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
     // and the corresponding offset be 'offset_i'.  Then the key of a single
     // point is obtained as:
     // key = { floor((<proj_i, point> + offset_i) / 'hashWidth') forall i }
-    arma::mat offsetMat = repmat(offsets.unsafe_col(i), 1,
-                                 this->referenceSet.n_cols);
     arma::mat hashMat = projections.slice(i).t() * (this->referenceSet);
-    hashMat += offsetMat;
+    hashMat.each_col() += offsets.col(i);
     hashMat /= hashWidth;
 
-    // Step V: Putting the points in the 'secondHashTable' by hashing the key.
+    // Step V: Putting the points in the second hash table by hashing the key.
     // Now we hash every key, point ID to its corresponding bucket.  We must
     // also normalize the hashes to the range [0, secondHashSize).
     arma::rowvec unmodVector = secondHashWeights.t() * arma::floor(hashMat);
@@ -286,13 +285,13 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
       if (unmodVector[j] >= 0.0)
       {
         const size_t key = size_t(fmod(unmodVector[j], shs));
-        secondHashVectors(i, j) = key;
+        secondHashVectors(j, i) = key;
       }
       else
       {
         const double mod = fmod(-unmodVector[j], shs);
         const size_t key = (mod < 1.0) ? 0 : secondHashSize - size_t(mod);
-        secondHashVectors(i, j) = key;
+        secondHashVectors(j, i) = key;
       }
     }
   }
@@ -309,36 +308,38 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
       { return std::min(val, effectiveBucketSize); });
 
   const size_t numRowsInTable = accu(secondHashBinCounts > 0);
-  bucketContentSize.zeros(numRowsInTable);
-  secondHashTable.resize(numRowsInTable);
 
-  // Next we must assign each point in each table to the right second hash
-  // table.
+  // The rows of the second hash table are stored one after the other in
+  // 'bucketContents'.  Rows are assigned to buckets in the order in which the
+  // buckets are first reached (table by table), and 'bucketOffsets' holds the
+  // start of each row; these are the cumulative sums of the row sizes.
+  bucketOffsets.zeros(numRowsInTable + 1);
   size_t currentRow = 0;
-  for (size_t i = 0; i < numTables; ++i)
+  for (size_t i = 0; i < secondHashVectors.n_elem; ++i)
   {
-    // Insert the point in the corresponding row to its bucket in the
-    // 'secondHashTable'.
-    for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
+    const size_t hashInd = secondHashVectors[i];
+    if (bucketRowInHashTable[hashInd] == secondHashSize)
     {
-      // This is the bucket number.
-      size_t hashInd = (size_t) secondHashVectors(i, j);
-      // The point ID is 'j'.
+      bucketRowInHashTable[hashInd] = currentRow;
+      bucketOffsets[++currentRow] = secondHashBinCounts[hashInd];
+    }
+  }
 
-      // If this is currently an empty bucket, start a new row keep track of
-      // which row corresponds to the bucket.
-      const size_t maxSize = secondHashBinCounts[hashInd];
-      if (bucketRowInHashTable[hashInd] == secondHashSize)
-      {
-        bucketRowInHashTable[hashInd] = currentRow;
-        secondHashTable[currentRow].set_size(maxSize);
-        currentRow++;
-      }
+  for (size_t r = 0; r < numRowsInTable; ++r)
+    bucketOffsets[r + 1] += bucketOffsets[r];
 
-      // If this vector in the hash table is not full, add the point.
-      const size_t index = bucketRowInHashTable[hashInd];
-      if (bucketContentSize[index] < maxSize)
-        secondHashTable[index](bucketContentSize[index]++) = j;
+  // Next we must assign each point in each table to the right row, keeping the
+  // first points of each bucket if it is full.
+  bucketContents.set_size(bucketOffsets[numRowsInTable]);
+  arma::Col<size_t> nextInRow(bucketOffsets.memptr(), numRowsInTable);
+  for (size_t i = 0; i < numTables; ++i)
+  {
+    for (size_t j = 0; j < secondHashVectors.n_rows; ++j)
+    {
+      // The point ID is 'j'.
+      const size_t row = bucketRowInHashTable[secondHashVectors(j, i)];
+      if (nextInRow[row] < bucketOffsets[row + 1])
+        bucketContents[nextInRow[row]++] = j;
     } // Loop over all points in the reference set.
   } // Loop over tables.
 
@@ -701,35 +702,36 @@ void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
 }
 
 template<typename SortPolicy, typename MatType>
-template<typename VecType>
+void LSHSearch<SortPolicy, MatType>::ProjectQueries(
+    const MatType& querySet,
+    const size_t begin,
+    const size_t end,
+    const size_t numTablesToSearch,
+    arma::cube& queryProjections) const
+{
+  // Hash the queries in each of the 'numTablesToSearch' hash tables using the
+  // 'numProj' projections for each table.  Each table needs a single matrix
+  // multiplication for all the queries.
+  queryProjections.set_size(numProj, end - begin, numTablesToSearch);
+  for (size_t i = 0; i < numTablesToSearch; ++i)
+  {
+    queryProjections.slice(i) = projections.slice(i).t() *
+        querySet.cols(begin, end - 1);
+    queryProjections.slice(i).each_col() += offsets.col(i);
+  }
+}
+
+template<typename SortPolicy, typename MatType>
 void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
-    const VecType& queryPoint,
+    const arma::mat& queryCodesNotFloored,
     arma::uvec& referenceIndices,
-    size_t numTablesToSearch,
     const size_t T) const
 {
-  // Decide on the number of tables to look into.
-  if (numTablesToSearch == 0) // If no user input is given, search all.
-    numTablesToSearch = numTables;
-
-  // Sanity check to make sure that the existing number of tables is not
-  // exceeded.
-  if (numTablesToSearch > numTables)
-    numTablesToSearch = numTables;
-
-  // Hash the query in each of the 'numTablesToSearch' hash tables using the
-  // 'numProj' projections for each table. This gives us 'numTablesToSearch'
-  // keys for the query where each key is a 'numProj' dimensional integer
-  // vector.
-
-  // Compute the projection of the query in each table.
-  arma::mat allProjInTables(numProj, numTablesToSearch);
-  arma::mat queryCodesNotFloored(numProj, numTablesToSearch);
-  for (size_t i = 0; i < numTablesToSearch; ++i)
-    queryCodesNotFloored.unsafe_col(i) = projections.slice(i).t() * queryPoint;
-
-  queryCodesNotFloored += offsets.cols(0, numTablesToSearch - 1);
-  allProjInTables = arma::floor(queryCodesNotFloored / hashWidth);
+  // The keys of the query are 'numTablesToSearch' 'numProj'-dimensional
+  // integer vectors.
+  const size_t numTablesToSearch = queryCodesNotFloored.n_cols;
+  const arma::mat allProjInTables = arma::floor(queryCodesNotFloored /
+      hashWidth);
 
   // Use hashMat to store the primary probing codes and any additional codes
   // from multiprobe LSH.
@@ -737,7 +739,7 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
   hashMat.set_size(T + 1, numTablesToSearch);
 
   // Compute the primary hash value of each key of the query into a bucket of
-  // the secondHashTable using the secondHashWeights.
+  // the second hash table using the secondHashWeights.
   hashMat.row(0) = ConvTo<arma::Row<size_t>> // Floor by typecasting
       ::From(secondHashWeights.t() * allProjInTables);
   // Mod to compute 2nd-level codes.
@@ -756,8 +758,8 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
                                 T,
                                 additionalProbingBins);
 
-      // Map each probing bin to a bin in secondHashTable (just like we did for
-      // the primary hash table).
+      // Map each probing bin to a bin in the second hash table (just like we
+      // did for the primary hash table).
       hashMat(arma::span(1, T), i) = // Compute code of rows 1:end of column i
         ConvTo<arma::Col<size_t>>:: // floor by typecasting to size_t
         From(secondHashWeights.t() * additionalProbingBins);
@@ -774,8 +776,8 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
     {
       const size_t hashInd = hashMat(p, i); // find query's bucket
       const size_t tableRow = bucketRowInHashTable[hashInd];
-      if (tableRow < secondHashSize)
-        maxNumPoints += bucketContentSize[tableRow]; // count bucket contents
+      if (tableRow < secondHashSize) // Count bucket contents.
+        maxNumPoints += bucketOffsets[tableRow + 1] - bucketOffsets[tableRow];
     }
   }
 
@@ -806,11 +808,12 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
         size_t hashInd = hashMat(p, i);
         size_t tableRow = bucketRowInHashTable[hashInd];
 
-        if (tableRow < secondHashSize && bucketContentSize[tableRow] > 0)
+        if (tableRow < secondHashSize)
         {
           // Pick the indices in the bucket corresponding to hashInd.
-          for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsidered[ secondHashTable[tableRow](j) ]++;
+          for (size_t j = bucketOffsets[tableRow];
+               j < bucketOffsets[tableRow + 1]; ++j)
+            refPointsConsidered[bucketContents[j]]++;
         }
       }
     }
@@ -839,10 +842,11 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
 
         if (tableRow < secondHashSize)
         {
-          // Store all secondHashTable points in the candidates set.
-          for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsideredSmall(start++) = secondHashTable[tableRow](j);
-       }
+          // Store all the points of the bucket in the candidates set.
+          for (size_t j = bucketOffsets[tableRow];
+               j < bucketOffsets[tableRow + 1]; ++j)
+            refPointsConsideredSmall(start++) = bucketContents[j];
+        }
       }
     }
 
@@ -899,31 +903,49 @@ void LSHSearch<SortPolicy, MatType>::Search(
     Log::Info << "Running multiprobe LSH with " << Teffective
         <<" additional probing bins per table per query." << std::endl;
 
+  // Decide on the number of tables to look into.  If no user input is given,
+  // or too many tables are requested, search all of them.
+  const size_t tablesToSearch = (numTablesToSearch == 0 ||
+      numTablesToSearch > numTables) ? numTables : numTablesToSearch;
+
   size_t avgIndicesReturned = 0;
 
-  // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
-      shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
-      reduction(+:avgIndicesReturned)
-  for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+  // The queries are processed in blocks: the projections of all the queries
+  // of a block are computed at once, and the candidates of each query are then
+  // collected in parallel.  The block size bounds the memory used to hold the
+  // projections.
+  const size_t blockSize = 1024;
+  arma::cube queryProjections;
+  for (size_t begin = 0; begin < querySet.n_cols; begin += blockSize)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
-    arma::uvec refIndices;
-    ReturnIndicesFromTable(querySet.col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running
-    // #pragma omp atomic
-    avgIndicesReturned = avgIndicesReturned + refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+    const size_t end = std::min(begin + blockSize, (size_t) querySet.n_cols);
+    ProjectQueries(querySet, begin, end, tablesToSearch, queryProjections);
+
+    // Parallelization to process more than one query at a time.
+    #pragma omp parallel for \
+        shared(resultingNeighbors, distances, queryProjections) \
+        schedule(dynamic)\
+        reduction(+:avgIndicesReturned)
+    for (size_t i = begin; i < end; ++i)
+    {
+      // Go through every query point.
+      // Hash every query into every hash table and eventually into the
+      // second hash table to obtain the neighbor candidates.
+      arma::mat queryCodesNotFloored(numProj, tablesToSearch);
+      for (size_t t = 0; t < tablesToSearch; ++t)
+        queryCodesNotFloored.col(t) = queryProjections.slice(t).col(i - begin);
+
+      arma::uvec refIndices;
+      ReturnIndicesFromTable(queryCodesNotFloored, refIndices, Teffective);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      avgIndicesReturned = avgIndicesReturned + refIndices.n_elem;
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+    }
   }
 
   distanceEvaluations += avgIndicesReturned;
@@ -961,31 +983,47 @@ Search(const size_t k,
     Log::Info << "Running multiprobe LSH with " << Teffective <<
       " additional probing bins per table per query."<< std::endl;
 
+  // Decide on the number of tables to look into.  If no user input is given,
+  // or too many tables are requested, search all of them.
+  const size_t tablesToSearch = (numTablesToSearch == 0 ||
+      numTablesToSearch > numTables) ? numTables : numTablesToSearch;
+
   size_t avgIndicesReturned = 0;
 
-  // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
-      shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
-      reduction(+:avgIndicesReturned)
-  for (size_t i = 0; i < (size_t) referenceSet.n_cols; ++i)
+  // The queries are processed in blocks, as in the bichromatic search.
+  const size_t blockSize = 1024;
+  arma::cube queryProjections;
+  for (size_t begin = 0; begin < referenceSet.n_cols; begin += blockSize)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
-    arma::uvec refIndices;
-    ReturnIndicesFromTable(referenceSet.col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running.
-    // #pragma omp atomic
-    avgIndicesReturned += refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, resultingNeighbors, distances);
+    const size_t end = std::min(begin + blockSize,
+        (size_t) referenceSet.n_cols);
+    ProjectQueries(referenceSet, begin, end, tablesToSearch, queryProjections);
+
+    // Parallelization to process more than one query at a time.
+    #pragma omp parallel for \
+        shared(resultingNeighbors, distances, queryProjections) \
+        schedule(dynamic)\
+        reduction(+:avgIndicesReturned)
+    for (size_t i = begin; i < end; ++i)
+    {
+      // Go through every query point.
+      // Hash every query into every hash table and eventually into the
+      // second hash table to obtain the neighbor candidates.
+      arma::mat queryCodesNotFloored(numProj, tablesToSearch);
+      for (size_t t = 0; t < tablesToSearch; ++t)
+        queryCodesNotFloored.col(t) = queryProjections.slice(t).col(i - begin);
+
+      arma::uvec refIndices;
+      ReturnIndicesFromTable(queryCodesNotFloored, refIndices, Teffective);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      avgIndicesReturned += refIndices.n_elem;
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, resultingNeighbors, distances);
+    }
   }
 
   distanceEvaluations += avgIndicesReturned;
@@ -994,6 +1032,21 @@ Search(const size_t k,
       std::endl;
 }
 
+template<typename SortPolicy, typename MatType>
+std::vector<arma::Col<size_t>>
+LSHSearch<SortPolicy, MatType>::SecondHashTable() const
+{
+  std::vector<arma::Col<size_t>> secondHashTable(bucketOffsets.n_elem > 0 ?
+      bucketOffsets.n_elem - 1 : 0);
+  for (size_t r = 0; r < secondHashTable.size(); ++r)
+  {
+    secondHashTable[r] = bucketContents.subvec(bucketOffsets[r],
+        bucketOffsets[r + 1] - 1);
+  }
+
+  return secondHashTable;
+}
+
 template<typename SortPolicy, typename MatType>
 double LSHSearch<SortPolicy, MatType>::ComputeRecall(
     const arma::Mat<size_t>& foundNeighbors,
@@ -1024,7 +1077,7 @@ double LSHSearch<SortPolicy, MatType>::ComputeRecall(
 template<typename SortPolicy, typename MatType>
 template<typename Archive>
 void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
-                                               const uint32_t /* version */)
+                                               const uint32_t version)
 {
   ar(CEREAL_NVP(referenceSet));
   ar(CEREAL_NVP(numProj));
@@ -1040,8 +1093,29 @@ void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
   ar(CEREAL_NVP(secondHashSize));
   ar(CEREAL_NVP(secondHashWeights));
   ar(CEREAL_NVP(bucketSize));
-  ar(CEREAL_NVP(secondHashTable));
-  ar(CEREAL_NVP(bucketContentSize));
+  if (version > 0)
+  {
+    ar(CEREAL_NVP(bucketOffsets));
+    ar(CEREAL_NVP(bucketContents));
+  }
+  else
+  {
+    // Older models store each row of the second hash table in its own vector;
+    // convert them to the contiguous layout.
+    std::vector<arma::Col<size_t>> secondHashTable;
+    arma::Col<size_t> bucketContentSize;
+    ar(CEREAL_NVP(secondHashTable));
+    ar(CEREAL_NVP(bucketContentSize));
+
+    bucketOffsets.zeros(secondHashTable.size() + 1);
+    for (size_t r = 0; r < secondHashTable.size(); ++r)
+      bucketOffsets[r + 1] = bucketOffsets[r] + bucketContentSize[r];
+
+    bucketContents.set_size(bucketOffsets[secondHashTable.size()]);
+    for (size_t r = 0; r < secondHashTable.size(); ++r)
+      for (size_t j = 0; j < bucketContentSize[r]; ++j)
+        bucketContents[bucketOffsets[r] + j] = secondHashTable[r][j];
+  }
   ar(CEREAL_NVP(bucketRowInHashTable));
   ar(CEREAL_NVP(distanceEvaluations));
 }
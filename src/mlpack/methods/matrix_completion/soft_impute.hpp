@@ -0,0 +1,213 @@
+/**
+ * @file methods/matrix_completion/soft_impute.hpp
+ *
+ * Definition of the SoftImpute class, which solves large matrix completion
+ * problems by iterative singular value thresholding.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_MATRIX_COMPLETION_SOFT_IMPUTE_HPP
+#define MLPACK_METHODS_MATRIX_COMPLETION_SOFT_IMPUTE_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * SoftImpute fills in the unknown values of a matrix X from known values M_ij
+ * by solving the nuclear norm regularized problem
+ *
+ *   min 1/2 sum_(ij known) (X_ij - M_ij)^2 + lambda ||X||_*
+ *
+ * with the Soft-Impute algorithm: at each iteration, the known entries of the
+ * current estimate L are replaced by the known values, and L becomes the
+ * singular value thresholding of the result (the singular values are reduced
+ * by lambda, and at most `maxRank` of them are kept).  With lambda = 0, this
+ * is the "hard impute" algorithm for a rank constrained completion.
+ *
+ * Unlike MatrixCompletion, which solves an SDP with one constraint per known
+ * entry, neither the filled matrix nor any m x n matrix is formed: the filled
+ * matrix is the sum of a sparse matrix (the residuals on the known entries)
+ * and of the low-rank L = U diag(s) V^T, so it is only applied to blocks of
+ * vectors, and its truncated SVD is computed with a randomized SVD that is
+ * started from the right singular vectors of the previous iteration.  Each
+ * iteration costs O(p * r) for the residuals and the sparse products (with p
+ * known entries), done in parallel with OpenMP, plus O((m + n) * r^2) for the
+ * dense parts.
+ *
+ * For more information, see the following paper:
+ *
+ * @code
+ * @article{mazumder2010spectral,
+ *   title={Spectral regularization algorithms for learning large incomplete
+ *       matrices},
+ *   author={Mazumder, Rahul and Hastie, Trevor and Tibshirani, Robert},
+ *   journal={Journal of Machine Learning Research},
+ *   volume={11},
+ *   pages={2287--2322},
+ *   year={2010}
+ * }
+ * @endcode
+ *
+ * An example of how to use this class is shown below:
+ *
+ * @code
+ * size_t m, n;         // size of unknown matrix
+ * arma::umat indices;  // contains the known indices [2 x n_entries]
+ * arma::vec values;    // contains the known values [n_entries]
+ *
+ * SoftImpute si(m, n, indices, values, 20, 0.5);
+ *
+ * // Get the completed matrix as U * diagmat(s) * V^T.
+ * arma::mat u, v;
+ * arma::vec s;
+ * si.Recover(u, s, v);
+ * @endcode
+ *
+ * @see MatrixCompletion
+ */
+class SoftImpute
+{
+ public:
+  /**
+   * Construct a matrix completion problem.  A std::invalid_argument is thrown
+   * if the indices do not have two rows, if the number of indices and values
+   * differ, if an index is out of bounds, or if the maximum rank is 0.
+   *
+   * @param m Number of rows of original matrix.
+   * @param n Number of columns of original matrix.
+   * @param indices Matrix containing the indices of the known entries (must be
+   *    [2 x p]).
+   * @param values Vector containing the values of the known entries (must be
+   *    length p).
+   * @param maxRank Maximum rank of the solution.
+   * @param lambda Regularization parameter (the amount by which the singular
+   *    values are reduced at each iteration).
+   * @param maxIterations Maximum number of iterations.
+   * @param tolerance The algorithm stops when the relative change of the
+   *    solution (in squared Frobenius norm) is less than this.
+   * @param powerIterations Number of power iterations of the randomized SVD.
+   */
+  SoftImpute(const size_t m,
+             const size_t n,
+             const arma::umat& indices,
+             const arma::vec& values,
+             const size_t maxRank,
+             const double lambda = 0.0,
+             const size_t maxIterations = 100,
+             const double tolerance = 1e-5,
+             const size_t powerIterations = 1);
+
+  /**
+   * Solve the problem, and return the solution in factored form: the completed
+   * matrix is u * diagmat(s) * v.t(), where u is m x r, v is n x r, and s holds
+   * the r positive singular values (r <= MaxRank()).
+   *
+   * @param u Will contain the left singular vectors of the solution.
+   * @param s Will contain the singular values of the solution.
+   * @param v Will contain the right singular vectors of the solution.
+   */
+  void Recover(arma::mat& u, arma::vec& s, arma::mat& v);
+
+  /**
+   * Solve the problem, and return the completed m x n matrix.
+   *
+   * @param recovered Will contain the completed matrix.
+   */
+  void Recover(arma::mat& recovered);
+
+  //! Get the maximum rank of the solution.
+  size_t MaxRank() const { return maxRank; }
+  //! Modify the maximum rank of the solution.
+  size_t& MaxRank() { return maxRank; }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Get the maximum number of iterations.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of iterations.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the tolerance on the relative change of the solution.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance on the relative change of the solution.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the number of power iterations of the randomized SVD.
+  size_t PowerIterations() const { return powerIterations; }
+  //! Modify the number of power iterations of the randomized SVD.
+  size_t& PowerIterations() { return powerIterations; }
+
+  //! Get the number of iterations performed by the last call to Recover().
+  size_t Iterations() const { return iterations; }
+
+ private:
+  //! Compute the residuals of the known entries for the current solution
+  //! (given as (U diag(s))^T and V^T).
+  void ComputeResiduals(const arma::mat& usT, const arma::mat& vT);
+
+  //! Compute Z * x, where Z is the sparse matrix of residuals plus
+  //! u * diagmat(s) * v^T.
+  void Multiply(const arma::mat& x,
+                const arma::mat& u,
+                const arma::vec& s,
+                const arma::mat& v,
+                arma::mat& output) const;
+
+  //! Compute Z^T * x, where Z is the sparse matrix of residuals plus
+  //! u * diagmat(s) * v^T.
+  void MultiplyTransposed(const arma::mat& x,
+                          const arma::mat& u,
+                          const arma::vec& s,
+                          const arma::mat& v,
+                          arma::mat& output) const;
+
+  //! Number of rows in original matrix.
+  size_t m;
+  //! Number of columns in original matrix.
+  size_t n;
+
+  //! The known entries, sorted by row: the entries of row i are
+  //! rowOffsets[i] to rowOffsets[i + 1] - 1.
+  arma::uvec rowOffsets;
+  //! The column of each known entry, sorted by row.
+  arma::uvec entryCols;
+  //! The value of each known entry, sorted by row.
+  arma::vec entryValues;
+  //! The residual of each known entry, sorted by row.
+  arma::vec residuals;
+  //! The entries of column j (as indices of the entries sorted by row) are
+  //! columnEntries[columnOffsets[j]] to
+  //! columnEntries[columnOffsets[j + 1] - 1].
+  arma::uvec columnOffsets;
+  //! The entries sorted by column, as indices of the entries sorted by row.
+  arma::uvec columnEntries;
+  //! The row of each known entry, sorted by column.
+  arma::uvec columnRows;
+
+  //! Maximum rank of the solution.
+  size_t maxRank;
+  //! Regularization parameter.
+  double lambda;
+  //! Maximum number of iterations.
+  size_t maxIterations;
+  //! Tolerance on the relative change of the solution.
+  double tolerance;
+  //! Number of power iterations of the randomized SVD.
+  size_t powerIterations;
+  //! Number of iterations performed by the last call to Recover().
+  size_t iterations;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "soft_impute_impl.hpp"
+
+#endif
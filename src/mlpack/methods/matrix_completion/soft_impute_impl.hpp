@@ -0,0 +1,294 @@
+/**
+ * @file methods/matrix_completion/soft_impute_impl.hpp
+ *
+ * Implementation of the SoftImpute class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_MATRIX_COMPLETION_SOFT_IMPUTE_IMPL_HPP
+#define MLPACK_METHODS_MATRIX_COMPLETION_SOFT_IMPUTE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "soft_impute.hpp"
+#include <mlpack/core/util/size_checks.hpp>
+
+namespace mlpack {
+
+inline SoftImpute::SoftImpute(const size_t m,
+                              const size_t n,
+                              const arma::umat& indices,
+                              const arma::vec& values,
+                              const size_t maxRank,
+                              const double lambda,
+                              const size_t maxIterations,
+                              const double tolerance,
+                              const size_t powerIterations) :
+    m(m),
+    n(n),
+    maxRank(maxRank),
+    lambda(lambda),
+    maxIterations(maxIterations),
+    tolerance(tolerance),
+    powerIterations(powerIterations),
+    iterations(0)
+{
+  if (indices.n_rows != 2)
+  {
+    throw std::invalid_argument("SoftImpute::SoftImpute(): matrix of "
+        "constraint indices does not have 2 rows!");
+  }
+
+  util::CheckSameSizes(indices, values, "SoftImpute::SoftImpute()", "values",
+      false, true);
+
+  if (maxRank == 0)
+  {
+    throw std::invalid_argument("SoftImpute::SoftImpute(): the maximum rank "
+        "must be positive!");
+  }
+
+  // Count the known entries of each row and column.
+  const size_t p = indices.n_cols;
+  rowOffsets.zeros(m + 1);
+  columnOffsets.zeros(n + 1);
+  for (size_t i = 0; i < p; ++i)
+  {
+    if (indices(0, i) >= m || indices(1, i) >= n)
+    {
+      std::ostringstream oss;
+      oss << "SoftImpute::SoftImpute(): indices (" << indices(0, i) << ", "
+          << indices(1, i) << ") are out of bounds for matrix of size " << m
+          << " x " << n << "!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    ++rowOffsets[indices(0, i) + 1];
+    ++columnOffsets[indices(1, i) + 1];
+  }
+
+  for (size_t i = 0; i < m; ++i)
+    rowOffsets[i + 1] += rowOffsets[i];
+  for (size_t j = 0; j < n; ++j)
+    columnOffsets[j + 1] += columnOffsets[j];
+
+  // Sort the entries by row (keeping the given order within each row), then
+  // by column.
+  entryCols.set_size(p);
+  entryValues.set_size(p);
+  std::vector<size_t> next(rowOffsets.begin(), rowOffsets.end() - 1);
+  for (size_t i = 0; i < p; ++i)
+  {
+    const size_t position = next[indices(0, i)]++;
+    entryCols[position] = indices(1, i);
+    entryValues[position] = values[i];
+  }
+
+  columnEntries.set_size(p);
+  columnRows.set_size(p);
+  next.assign(columnOffsets.begin(), columnOffsets.end() - 1);
+  for (size_t i = 0; i < m; ++i)
+  {
+    for (size_t e = rowOffsets[i]; e < rowOffsets[i + 1]; ++e)
+    {
+      const size_t position = next[entryCols[e]]++;
+      columnEntries[position] = e;
+      columnRows[position] = i;
+    }
+  }
+}
+
+inline void SoftImpute::Recover(arma::mat& u, arma::vec& s, arma::mat& v)
+{
+  // The randomized SVD computes a few more singular vectors than needed.
+  const size_t k = std::min(maxRank + 5, std::min(m, n));
+
+  u.reset();
+  s.reset();
+  v.reset();
+
+  arma::mat omega, y, q, r, w, b, ub, vb, newU, newV;
+  arma::vec sb, newS;
+  for (iterations = 1; iterations <= maxIterations; ++iterations)
+  {
+    // Replace the known entries of the current solution by their values: the
+    // filled matrix is the current solution plus the sparse residuals.
+    if (s.n_elem == 0)
+    {
+      residuals = entryValues;
+    }
+    else
+    {
+      arma::mat us = u;
+      us.each_row() %= s.t();
+      ComputeResiduals(us.t(), v.t());
+    }
+
+    // Compute the truncated SVD of the filled matrix with a randomized SVD,
+    // starting from the right singular vectors of the current solution.
+    omega.set_size(n, k);
+    if (v.n_cols > 0)
+      omega.cols(0, v.n_cols - 1) = v;
+    if (v.n_cols < k)
+      omega.cols(v.n_cols, k - 1).randn();
+
+    Multiply(omega, u, s, v, y);
+    arma::qr_econ(q, r, y);
+    for (size_t i = 0; i < powerIterations; ++i)
+    {
+      MultiplyTransposed(q, u, s, v, w);
+      arma::qr_econ(w, r, w);
+      Multiply(w, u, s, v, y);
+      arma::qr_econ(q, r, y);
+    }
+
+    // Z^T Q = (V_b) S (U_b)^T, so Z ~= (Q U_b) S V_b^T.
+    MultiplyTransposed(q, u, s, v, b);
+    arma::svd_econ(vb, sb, ub, b);
+
+    // Threshold the singular values.
+    size_t rank = 0;
+    while (rank < std::min(maxRank, (size_t) sb.n_elem) && sb[rank] > lambda)
+      ++rank;
+
+    if (rank == 0)
+    {
+      newU.reset();
+      newS.reset();
+      newV.reset();
+    }
+    else
+    {
+      newU = q * ub.cols(0, rank - 1);
+      newS = sb.subvec(0, rank - 1) - lambda;
+      newV = vb.cols(0, rank - 1);
+    }
+
+    // Compute the squared Frobenius norm of the change of the solution from
+    // the factors.
+    const double oldNorm = arma::accu(arma::square(s));
+    const double newNorm = arma::accu(arma::square(newS));
+    double change = oldNorm + newNorm;
+    if (s.n_elem > 0 && newS.n_elem > 0)
+    {
+      change -= 2.0 * arma::trace(arma::diagmat(s) * (u.t() * newU) *
+          arma::diagmat(newS) * (newV.t() * v));
+    }
+
+    u = std::move(newU);
+    s = std::move(newS);
+    v = std::move(newV);
+
+    if ((oldNorm > 0.0) ? (change <= tolerance * oldNorm) : (newNorm == 0.0))
+      break;
+  }
+
+  if (iterations > maxIterations)
+  {
+    iterations = maxIterations;
+    Log::Info << "SoftImpute::Recover(): reached the maximum number of "
+        << "iterations (" << maxIterations << ")." << std::endl;
+  }
+  else
+  {
+    Log::Info << "SoftImpute::Recover(): converged after " << iterations
+        << " iterations, with rank " << s.n_elem << "." << std::endl;
+  }
+}
+
+inline void SoftImpute::Recover(arma::mat& recovered)
+{
+  arma::mat u, v;
+  arma::vec s;
+  Recover(u, s, v);
+
+  if (s.n_elem == 0)
+    recovered.zeros(m, n);
+  else
+    recovered = u * arma::diagmat(s) * v.t();
+}
+
+inline void SoftImpute::ComputeResiduals(const arma::mat& usT,
+                                         const arma::mat& vT)
+{
+  const size_t rank = usT.n_rows;
+  residuals.set_size(entryValues.n_elem);
+
+  #pragma omp parallel for schedule(dynamic, 256)
+  for (size_t i = 0; i < m; ++i)
+  {
+    const double* us = usT.colptr(i);
+    for (size_t e = rowOffsets[i]; e < rowOffsets[i + 1]; ++e)
+    {
+      const double* vCol = vT.colptr(entryCols[e]);
+      double estimate = 0.0;
+      for (size_t t = 0; t < rank; ++t)
+        estimate += us[t] * vCol[t];
+      residuals[e] = entryValues[e] - estimate;
+    }
+  }
+}
+
+inline void SoftImpute::Multiply(const arma::mat& x,
+                                 const arma::mat& u,
+                                 const arma::vec& s,
+                                 const arma::mat& v,
+                                 arma::mat& output) const
+{
+  // The sparse product is done with the transposed matrices, so that each row
+  // of the result and of x is contiguous.
+  const size_t cols = x.n_cols;
+  const arma::mat xT = x.t();
+  arma::mat outputT(cols, m, arma::fill::zeros);
+
+  #pragma omp parallel for schedule(dynamic, 256)
+  for (size_t i = 0; i < m; ++i)
+  {
+    double* out = outputT.colptr(i);
+    for (size_t e = rowOffsets[i]; e < rowOffsets[i + 1]; ++e)
+    {
+      const double residual = residuals[e];
+      const double* xCol = xT.colptr(entryCols[e]);
+      for (size_t t = 0; t < cols; ++t)
+        out[t] += residual * xCol[t];
+    }
+  }
+
+  output = outputT.t();
+  if (s.n_elem > 0)
+    output += u * (arma::diagmat(s) * (v.t() * x));
+}
+
+inline void SoftImpute::MultiplyTransposed(const arma::mat& x,
+                                           const arma::mat& u,
+                                           const arma::vec& s,
+                                           const arma::mat& v,
+                                           arma::mat& output) const
+{
+  const size_t cols = x.n_cols;
+  const arma::mat xT = x.t();
+  arma::mat outputT(cols, n, arma::fill::zeros);
+
+  #pragma omp parallel for schedule(dynamic, 256)
+  for (size_t j = 0; j < n; ++j)
+  {
+    double* out = outputT.colptr(j);
+    for (size_t c = columnOffsets[j]; c < columnOffsets[j + 1]; ++c)
+    {
+      const double residual = residuals[columnEntries[c]];
+      const double* xCol = xT.colptr(columnRows[c]);
+      for (size_t t = 0; t < cols; ++t)
+        out[t] += residual * xCol[t];
+    }
+  }
+
+  output = outputT.t();
+  if (s.n_elem > 0)
+    output += v * (arma::diagmat(s) * (u.t() * x));
+}
+
+} // namespace mlpack
+
+#endif
@@ -20,7 +20,9 @@ namespace mlpack {
 /**
  * This class implements mean shift clustering.  For each point in dataset,
  * apply mean shift algorithm until maximum iterations or convergence.  Then
- * remove duplicate centroids.
+ * remove duplicate centroids.  The neighborhoods of all the seeds are found
+ * with batched dual-tree range searches, and the seeds are shifted in parallel
+ * with OpenMP.
  *
  * A simple example of how to run mean shift clustering is shown below.
  *
@@ -121,6 +123,10 @@ class MeanShift
   //! Set the radius.
   void Radius(double radius);
 
+  //! The largest number of seeds whose neighborhoods are found with one range
+  //! search.
+  static const size_t SearchBatchSize = 16384;
+
   //! Get the kernel.
   const KernelType& Kernel() const { return kernel; }
   //! Modify the kernel.
@@ -208,59 +208,125 @@ inline void MeanShift<UseKernel, KernelType>::Cluster(
 
   // Holds all centroids before removing duplicate ones.
   CentroidsType allCentroids(pSeeds->n_rows, pSeeds->n_cols);
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+    allCentroids.col(i) = pSeeds->unsafe_col(i);
 
   RangeSearch<EuclideanDistance, MatType> rangeSearcher(data);
   RangeType<ElemType> validRadius((ElemType) 0, (ElemType) radius);
   std::vector<std::vector<size_t>> neighbors;
   std::vector<std::vector<ElemType>> distances;
 
-  // For each seed, perform mean shift algorithm.
-  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+  // Perform the mean shift algorithm for all seeds at once: at each iteration,
+  // the neighborhoods of the centroids of all the seeds that have not
+  // converged yet are found with dual-tree range searches (on batches of
+  // seeds, so that the results fit in memory), and the centroids are shifted
+  // in parallel.
+  std::vector<char> converged(pSeeds->n_cols, 0);
+  std::vector<size_t> activeSeeds(pSeeds->n_cols);
+  for (size_t i = 0; i < activeSeeds.size(); ++i)
+    activeSeeds[i] = i;
+
+  for (size_t completedIterations = 0; !activeSeeds.empty() &&
+      (completedIterations < maxIterations || forceConvergence);
+      completedIterations++)
   {
-    // Initial centroid is the seed itself.
-    allCentroids.col(i) = pSeeds->unsafe_col(i);
-    for (size_t completedIterations = 0; completedIterations < maxIterations
-        || forceConvergence; completedIterations++)
+    // Whether each active seed must keep shifting.
+    std::vector<char> shifted(activeSeeds.size(), 0);
+    for (size_t batchStart = 0; batchStart < activeSeeds.size();
+        batchStart += SearchBatchSize)
     {
-      // Store new centroid in this.
-      VecType newCentroid = zeros<VecType>(pSeeds->n_rows);
-
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() == 0) // There are no points in the cluster.
-        break;
+      const size_t batchEnd = std::min(batchStart + SearchBatchSize,
+          activeSeeds.size());
+      MatType queries(pSeeds->n_rows, batchEnd - batchStart);
+      for (size_t j = batchStart; j < batchEnd; ++j)
+        queries.col(j - batchStart) = allCentroids.unsafe_col(activeSeeds[j]);
 
-      // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
-        newCentroid = allCentroids.unsafe_col(i);
+      rangeSearcher.Search(queries, validRadius, neighbors, distances);
 
-      // If the mean shift vector is small enough, it has converged.
-      if (EuclideanDistance::Evaluate(newCentroid,
-          allCentroids.unsafe_col(i)) < 1e-3 * radius)
+      #pragma omp parallel for schedule(dynamic)
+      for (size_t j = batchStart; j < batchEnd; ++j)
       {
-        // Determine if the new centroid is duplicate with old ones.
-        bool isDuplicated = false;
-        for (size_t k = 0; k < centroids.n_cols; ++k)
+        const size_t i = activeSeeds[j];
+        const size_t q = j - batchStart;
+        if (neighbors[q].size() == 0) // There are no points in the cluster.
+          continue;
+
+        // Store new centroid in this.
+        VecType newCentroid = zeros<VecType>(pSeeds->n_rows);
+
+        // Calculate new centroid.
+        if (!CalculateCentroid(data, neighbors[q], distances[q], newCentroid))
+          newCentroid = allCentroids.unsafe_col(i);
+
+        // If the mean shift vector is small enough, it has converged.
+        if (EuclideanDistance::Evaluate(newCentroid,
+            allCentroids.unsafe_col(i)) < 1e-3 * radius)
+        {
+          converged[i] = 1;
+        }
+        else
         {
-          const ElemType distance = EuclideanDistance::Evaluate(
-              allCentroids.unsafe_col(i), centroids.unsafe_col(k));
-          if (distance < radius)
-          {
-            isDuplicated = true;
-            break;
-          }
+          // Update the centroid.
+          allCentroids.col(i) = newCentroid;
+          shifted[j] = 1;
         }
+      }
+    }
 
-        if (!isDuplicated)
-          centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
+    size_t numActive = 0;
+    for (size_t j = 0; j < activeSeeds.size(); ++j)
+      if (shifted[j])
+        activeSeeds[numActive++] = activeSeeds[j];
+    activeSeeds.resize(numActive);
+  }
+
+  // Remove the duplicate centroids: in the order of the seeds, a converged
+  // centroid is kept unless a centroid that was already kept is closer than
+  // the radius.  The close centroids are found with a range search.
+  std::vector<size_t> convergedSeeds;
+  for (size_t i = 0; i < converged.size(); ++i)
+    if (converged[i])
+      convergedSeeds.push_back(i);
+
+  centroids.set_size(pSeeds->n_rows, 0);
+  if (!convergedSeeds.empty())
+  {
+    MatType convergedCentroids(pSeeds->n_rows, convergedSeeds.size());
+    for (size_t j = 0; j < convergedSeeds.size(); ++j)
+      convergedCentroids.col(j) = allCentroids.unsafe_col(convergedSeeds[j]);
+
+    RangeSearch<EuclideanDistance, MatType> duplicateSearcher(
+        std::move(convergedCentroids));
+    duplicateSearcher.Search(validRadius, neighbors, distances);
 
-        // Get out of the loop.
-        break;
+    std::vector<char> kept(convergedSeeds.size(), 0);
+    size_t numKept = 0;
+    for (size_t j = 0; j < convergedSeeds.size(); ++j)
+    {
+      bool isDuplicated = false;
+      for (size_t l = 0; l < neighbors[j].size(); ++l)
+      {
+        if (neighbors[j][l] < j && kept[neighbors[j][l]] &&
+            distances[j][l] < radius)
+        {
+          isDuplicated = true;
+          break;
+        }
       }
 
-      // Update the centroid.
-      allCentroids.col(i) = newCentroid;
+      if (!isDuplicated)
+      {
+        kept[j] = 1;
+        ++numKept;
+      }
     }
+
+    centroids.set_size(pSeeds->n_rows, numKept);
+    numKept = 0;
+    for (size_t j = 0; j < convergedSeeds.size(); ++j)
+      if (kept[j])
+        centroids.col(numKept++) = allCentroids.unsafe_col(convergedSeeds[j]);
   }
 
   // If no centroid has converged due to too little iterations and without
@@ -108,6 +108,12 @@ class NaiveBayesClassifier
    * classes, either re-initialize or call Means(), Variances(), and
    * Probabilities() individually to set them to the right size.
    *
+   * The statistics of the dataset are accumulated in parallel when OpenMP is
+   * available.  With the incremental algorithm, the statistics are merged into
+   * the current model, so a stream of data can be trained on in mini-batches:
+   * calling Train() on each batch gives the same model (up to floating-point
+   * error) as a single call on all of the data.
+   *
    * @param data The dataset to train on.
    * @param labels The labels for the dataset.
    * @param numClasses The number of classes in the dataset.
@@ -274,6 +280,37 @@ class NaiveBayesClassifier
   //! Small value to prevent log of zero.
   double epsilon;
 
+  /**
+   * Compute the number of points, the mean and the sum of squared deviations
+   * from the mean of each class in the given dataset, in parallel.
+   *
+   * @param data Dataset to compute the statistics of.
+   * @param labels Labels of the points in the dataset.
+   * @param numClasses Number of classes.
+   * @param counts Vector to store the number of points of each class in.
+   * @param batchMeans Matrix to store the mean of each class in.
+   * @param batchM2 Matrix to store the sum of squared deviations of each class
+   *     in.
+   */
+  template<typename MatType>
+  void AccumulateStatistics(const MatType& data,
+                            const arma::Row<size_t>& labels,
+                            const size_t numClasses,
+                            arma::Col<ElemType>& counts,
+                            ModelMatType& batchMeans,
+                            ModelMatType& batchM2) const;
+
+  /**
+   * Merge the statistics of a second set of points (other*) into the given
+   * statistics, with the pairwise update of Chan et al.
+   */
+  static void MergeStatistics(arma::Col<ElemType>& counts,
+                              ModelMatType& means,
+                              ModelMatType& m2,
+                              const arma::Col<ElemType>& otherCounts,
+                              const ModelMatType& otherMeans,
+                              const ModelMatType& otherM2);
+
   /**
    * Compute the unnormalized posterior log probability of given points (log
    * likelihood). Results are returned as arma::mat, and each column represents
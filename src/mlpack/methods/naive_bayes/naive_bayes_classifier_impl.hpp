@@ -86,78 +86,124 @@ void NaiveBayesClassifier<ModelMatType>::Train(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  // Calculate the class probabilities as well as the sample mean and variance
-  // for each of the features with respect to each of the labels.
+  // Do we need to resize the model?
+  if (incremental &&
+      (probabilities.n_elem != numClasses || data.n_rows != means.n_rows))
+    Reset(data.n_rows, numClasses);
+
+  // Training works on the number of points, the mean and the sum of squared
+  // deviations (M2) of each class.  If the incremental algorithm is used, these
+  // are recovered from the current model and the statistics of the new data
+  // are merged into them, so training on a sequence of mini-batches gives the
+  // same model as training on all of them at once.
+  arma::Col<ElemType> counts;
+  ModelMatType m2;
   if (incremental)
   {
-    // Do we need to resize the model?
-    if (probabilities.n_elem != numClasses || data.n_rows != means.n_rows)
-      Reset(data.n_rows, numClasses);
-
-    // Use incremental algorithm.
-    // Fist, de-normalize probabilities.
-    probabilities *= trainingPoints;
-
-    for (size_t j = 0; j < data.n_cols; ++j)
-    {
-      const size_t label = labels[j];
-      ++probabilities[label];
-
-      arma::Col<ElemType> delta = data.col(j) - means.col(label);
-      means.col(label) += delta / probabilities[label];
-      variances.col(label) += delta % (data.col(j) - means.col(label));
-    }
-
-    for (size_t i = 0; i < probabilities.n_elem; ++i)
-    {
-      if (probabilities[i] > 2)
-        variances.col(i) /= (probabilities[i] - 1);
-    }
+    counts = arma::round(arma::vectorise(probabilities) *
+        ElemType(trainingPoints));
+    m2 = arma::clamp(variances - ElemType(epsilon), ElemType(0),
+        std::numeric_limits<ElemType>::max());
+    for (size_t i = 0; i < counts.n_elem; ++i)
+      m2.col(i) *= (counts[i] > 1) ? (counts[i] - 1) : ElemType(0);
   }
   else
   {
-    // Set all parameters to zero.
-    probabilities.zeros(numClasses);
+    counts.zeros(numClasses);
     means.zeros(data.n_rows, numClasses);
-    variances.zeros(data.n_rows, numClasses);
+    m2.zeros(data.n_rows, numClasses);
+    trainingPoints = 0;
+  }
 
-    // Don't use incremental algorithm.  This is a two-pass algorithm.  It is
-    // possible to calculate the means and variances using a faster one-pass
-    // algorithm but there are some precision and stability issues.  If this is
-    // too slow, it's an option to use the faster algorithm by default and then
-    // have this (and the incremental algorithm) be other options.
+  arma::Col<ElemType> batchCounts;
+  ModelMatType batchMeans, batchM2;
+  AccumulateStatistics(data, labels, numClasses, batchCounts, batchMeans,
+      batchM2);
+  MergeStatistics(counts, means, m2, batchCounts, batchMeans, batchM2);
+
+  // Compute the sample variances, and add epsilon to prevent log of zero.
+  variances = std::move(m2);
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    if (counts[i] > 1)
+      variances.col(i) /= (counts[i] - 1);
+  variances += epsilon;
 
-    // Calculate the means.
-    for (size_t j = 0; j < data.n_cols; ++j)
-    {
-      const size_t label = labels[j];
-      ++probabilities[label];
-      means.col(label) += data.col(j);
-    }
+  trainingPoints += data.n_cols;
+  if (trainingPoints > 0)
+    probabilities = counts / ElemType(trainingPoints);
+  else
+    probabilities.zeros(numClasses);
+}
+
+template<typename ModelMatType>
+template<typename MatType>
+void NaiveBayesClassifier<ModelMatType>::AccumulateStatistics(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    arma::Col<ElemType>& counts,
+    ModelMatType& batchMeans,
+    ModelMatType& batchM2) const
+{
+  counts.zeros(numClasses);
+  batchMeans.zeros(data.n_rows, numClasses);
+  batchM2.zeros(data.n_rows, numClasses);
 
-    // Normalize means.
-    for (size_t i = 0; i < probabilities.n_elem; ++i)
-      if (probabilities[i] != 0.0)
-        means.col(i) /= probabilities[i];
+  // Each thread computes the statistics of its points with Welford's
+  // algorithm, and the results of the threads are then merged.
+  #pragma omp parallel
+  {
+    arma::Col<ElemType> threadCounts(numClasses, arma::fill::zeros);
+    ModelMatType threadMeans(data.n_rows, numClasses, arma::fill::zeros);
+    ModelMatType threadM2(data.n_rows, numClasses, arma::fill::zeros);
 
-    // Calculate variances.
+    #pragma omp for schedule(static)
     for (size_t j = 0; j < data.n_cols; ++j)
     {
       const size_t label = labels[j];
-      variances.col(label) += square(data.col(j) - means.col(label));
+      ++threadCounts[label];
+
+      arma::Col<ElemType> delta = data.col(j) - threadMeans.col(label);
+      threadMeans.col(label) += delta / threadCounts[label];
+      threadM2.col(label) += delta % (data.col(j) - threadMeans.col(label));
     }
 
-    // Normalize variances.
-    for (size_t i = 0; i < probabilities.n_elem; ++i)
-      if (probabilities[i] > 1)
-        variances.col(i) /= (probabilities[i] - 1);
+    #pragma omp critical
+    MergeStatistics(counts, batchMeans, batchM2, threadCounts, threadMeans,
+        threadM2);
   }
+}
 
-  // Add epsilon to prevent log of zero.
-  variances += epsilon;
+template<typename ModelMatType>
+void NaiveBayesClassifier<ModelMatType>::MergeStatistics(
+    arma::Col<ElemType>& counts,
+    ModelMatType& means,
+    ModelMatType& m2,
+    const arma::Col<ElemType>& otherCounts,
+    const ModelMatType& otherMeans,
+    const ModelMatType& otherM2)
+{
+  // This is the pairwise update of Chan, Golub and LeVeque.
+  for (size_t i = 0; i < counts.n_elem; ++i)
+  {
+    if (otherCounts[i] == 0)
+      continue;
 
-  probabilities /= data.n_cols;
-  trainingPoints += data.n_cols;
+    if (counts[i] == 0)
+    {
+      counts[i] = otherCounts[i];
+      means.col(i) = otherMeans.col(i);
+      m2.col(i) = otherM2.col(i);
+      continue;
+    }
+
+    const ElemType n = counts[i] + otherCounts[i];
+    const arma::Col<ElemType> delta = otherMeans.col(i) - means.col(i);
+    means.col(i) += delta * (otherCounts[i] / n);
+    m2.col(i) += otherM2.col(i) + arma::square(delta) *
+        (counts[i] * otherCounts[i] / n);
+    counts[i] = n;
+  }
 }
 
 template<typename ModelMatType>
@@ -166,8 +166,17 @@ class NCA
   //! Modify the distance.
   DistanceType& Distance() { return distance; }
 
+  //! Get the number of nearest neighbors the softmax of each point is
+  //! truncated to (0 means no truncation).
+  size_t NumNeighbors() const { return numNeighbors; }
+  //! Modify the number of nearest neighbors the softmax of each point is
+  //! truncated to (0 means no truncation).  Truncation makes each evaluation of
+  //! the objective near-linear in the number of points, instead of quadratic,
+  //! at the cost of approximating the objective.
+  size_t& NumNeighbors() { return numNeighbors; }
+
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */);
+  void serialize(Archive& ar, const uint32_t version);
 
  private:
   //! Dataset pointer (will be removed in mlpack 5.0.0).
@@ -179,10 +188,16 @@ class NCA
 
   //! Distance to be used.
   DistanceType distance;
+  //! Number of neighbors to truncate the softmax to (0 for no truncation).
+  size_t numNeighbors;
 };
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename DistanceType,
+    typename DeprecatedOptimizerType),
+    (mlpack::NCA<DistanceType, DeprecatedOptimizerType>), (1));
+
 // Include the implementation.
 #include "nca_impl.hpp"
 
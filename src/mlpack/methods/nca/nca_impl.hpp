@@ -25,12 +25,16 @@ NCA<DistanceType, DeprecatedOptimizerType>::NCA(
     DistanceType distance) :
     dataset(&dataset),
     labels(&labels),
-    distance(std::move(distance))
+    distance(std::move(distance)),
+    numNeighbors(0)
 { /* Nothing to do. */ }
 
 template<typename DistanceType, typename DeprecatedOptimizerType>
 NCA<DistanceType, DeprecatedOptimizerType>::NCA(DistanceType distance) :
-    distance(std::move(distance))
+    dataset(NULL),
+    labels(NULL),
+    distance(std::move(distance)),
+    numNeighbors(0)
 { /* Nothing to do. */ }
 
 template<typename DistanceType, typename DeprecatedOptimizerType>
@@ -85,6 +89,7 @@ void NCA<DistanceType, DeprecatedOptimizerType>::LearnDistance(
 {
   SoftmaxErrorFunction<MatType, LabelsType, DistanceType> errorFunction(
       dataset, labels, distance);
+  errorFunction.NumNeighbors() = numNeighbors;
 
   // See if we were passed an initialized matrix.
   if ((outputMatrix.n_rows != dataset.n_rows) ||
@@ -98,9 +103,15 @@ void NCA<DistanceType, DeprecatedOptimizerType>::LearnDistance(
 template<typename DistanceType, typename DeprecatedOptimizerType>
 template<typename Archive>
 void NCA<DistanceType, DeprecatedOptimizerType>::serialize(
-    Archive& ar, const uint32_t /* version */)
+    Archive& ar, const uint32_t version)
 {
   ar(CEREAL_NVP(distance));
+
+  // Older versions did not truncate the softmax.
+  if (cereal::is_loading<Archive>() && version == 0)
+    numNeighbors = 0;
+  else
+    ar(CEREAL_NVP(numNeighbors));
 }
 
 } // namespace mlpack
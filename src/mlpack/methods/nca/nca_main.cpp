@@ -90,7 +90,13 @@ BINDING_LONG_DESC(
     "mlpack L-BFGS documentation (in lbfgs.hpp) or the vast set of published "
     "literature on L-BFGS."
     "\n\n"
-    "By default, the SGD optimizer is used.");
+    "By default, the SGD optimizer is used."
+    "\n\n"
+    "Each evaluation of the objective takes time quadratic in the number of "
+    "points.  For larger datasets, the softmax of each point can be truncated "
+    "to its nearest neighbors in the transformed space, with the " +
+    PRINT_PARAM_STRING("num_neighbors") + " parameter; this approximates the "
+    "objective, but makes each evaluation near-linear.");
 
 // See also...
 BINDING_SEE_ALSO("@lmnn", "#lmnn");
@@ -131,6 +137,9 @@ PARAM_DOUBLE_IN("min_step", "Minimum step of line search for L-BFGS.", "m",
 PARAM_DOUBLE_IN("max_step", "Maximum step of line search for L-BFGS.", "M",
     1e20);
 
+PARAM_INT_IN("num_neighbors", "If greater than 0, truncate the softmax of each "
+    "point to this many nearest neighbors.", "k", 0);
+
 PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
 
 using namespace mlpack;
@@ -189,6 +198,9 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   const double maxStep = params.Get<double>("max_step");
   const size_t batchSize = (size_t) params.Get<int>("batch_size");
 
+  RequireParamValue<int>(params, "num_neighbors", [](int x) { return x >= 0; },
+      true, "number of neighbors must be non-negative");
+
   // Load data.
   arma::mat data = std::move(params.Get<arma::mat>("input"));
 
@@ -241,6 +253,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   // Now create the NCA object and run the optimization.
   timers.Start("nca_optimization");
   NCA nca;
+  nca.NumNeighbors() = (size_t) params.Get<int>("num_neighbors");
   if (optimizerType == "sgd")
   {
     ens::StandardSGD opt;
@@ -17,6 +17,7 @@
 #include <mlpack/core/distances/lmetric.hpp>
 #include <mlpack/core/math/make_alias.hpp>
 #include <mlpack/core/math/shuffle_data.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
 namespace mlpack {
 
@@ -39,6 +40,16 @@ namespace mlpack {
  * optimizers use, overloads of Evaluate() and Gradient() are given which only
  * operate on one point in the dataset.  This is useful for optimizers like
  * stochastic gradient descent (see mlpack::optimization::SGD).
+ *
+ * The sums over pairs of points are computed in parallel, in blocks of pairs,
+ * so that no n x n matrix is ever stored; with the default
+ * SquaredEuclideanDistance, the distances of each block come from one matrix
+ * multiplication.  Still, each evaluation takes O(n^2) time for n points.  If
+ * NumNeighbors() is set to k > 0, the softmax of each point is instead
+ * truncated to its k nearest neighbors (in the stretched space, under the
+ * Euclidean distance), which are found with a tree-based search; this is an
+ * approximation of the objective, but an evaluation then takes O(n k) time
+ * (plus the search).
  */
 template<typename MatType = arma::mat,
          typename LabelsType = arma::Row<size_t>,
@@ -137,6 +148,13 @@ class SoftmaxErrorFunction
    */
   size_t NumFunctions() const { return dataset.n_cols; }
 
+  //! Get the number of neighbors the softmax of each point is truncated to (0
+  //! means no truncation).
+  size_t NumNeighbors() const { return numNeighbors; }
+  //! Modify the number of neighbors the softmax of each point is truncated to
+  //! (0 means no truncation).
+  size_t& NumNeighbors() { precalculated = false; return numNeighbors; }
+
  private:
   //! The dataset.  This is an alias until Shuffle() is called.
   MatType dataset;
@@ -151,6 +169,13 @@ class SoftmaxErrorFunction
   MatType lastCoordinates;
   //! Stretched dataset.  Kept internal to avoid memory reallocations.
   MatType stretchedDataset;
+  //! Squared norms of the points of the stretched dataset.
+  arma::Row<ElemType> stretchedNorms;
+  //! Number of neighbors to truncate the softmax to (0 for no truncation).
+  size_t numNeighbors;
+  //! The nearest neighbors of each point, if numNeighbors > 0, for the
+  //! non-separable Evaluate() and Gradient().
+  arma::Mat<size_t> neighbors;
   //! Holds calculated p_i, for the non-separable Evaluate() and Gradient().
   VecType p;
   //! Holds denominators for calculation of p_ij, for the non-separable
@@ -168,12 +193,69 @@ class SoftmaxErrorFunction
    *
    * This will update last_coordinates_ and stretched_dataset_, and also
    * calculate the p_i and denominators_ which are used in the calculation of
-   * p_i or p_ij.  The calculation will be O((n * (n + 1)) / 2), which is not
-   * great.
+   * p_i or p_ij.  The calculation will be O(n^2), which is not great, unless
+   * the softmax is truncated to the nearest neighbors.
    *
    * @param coordinates Coordinates matrix to use for precalculation.
    */
   void Precalculate(const MatType& coordinates);
+
+  //! Compute stretchedDataset and stretchedNorms.
+  void Stretch(const MatType& coordinates);
+
+  /**
+   * Find the numNeighbors nearest neighbors (excluding the point itself) of the
+   * stretched points [begin, begin + count).
+   */
+  void FindNeighbors(const size_t begin,
+                     const size_t count,
+                     arma::Mat<size_t>& neighborsOut);
+
+  /**
+   * Compute exp(-d(A x_i, A x_k)) for the stretched points i in
+   * [queryBegin, queryBegin + numQueries) (one per row of `evals`) and k in
+   * [refBegin, refBegin + numRefs) (one per column); the entries where i == k
+   * are zero.
+   */
+  void BlockEvals(const size_t queryBegin,
+                  const size_t numQueries,
+                  const size_t refBegin,
+                  const size_t numRefs,
+                  MatType& evals);
+
+  /**
+   * Compute exp(-d(A x_i, A x_k)) for each point i in [begin, begin + count)
+   * and each of its neighbors k (column i - begin of `neighborsIn`).
+   */
+  void NeighborEvals(const size_t begin,
+                     const size_t count,
+                     const arma::Mat<size_t>& neighborsIn,
+                     MatType& evals);
+
+  /**
+   * Compute the numerators (sum over the points of the same class) and the
+   * denominators of the p_ij of the points [begin, begin + count).  If
+   * `neighborsIn` is not empty, only the neighbors of each point are
+   * considered.
+   */
+  void Sums(const size_t begin,
+            const size_t count,
+            const arma::Mat<size_t>& neighborsIn,
+            VecType& numerators,
+            VecType& denominatorsOut);
+
+  /**
+   * Compute the sum, over the points i in [begin, begin + count) and the other
+   * points k, of p_ik (p_i - [c_i == c_k]) x_ik x_ik^T, where x_ik = x_i - x_k
+   * (not stretched); the gradient is -2 A times this sum.  If `neighborsIn` is
+   * not empty, only the neighbors of each point are considered.
+   */
+  void GradientSum(const size_t begin,
+                   const size_t count,
+                   const arma::Mat<size_t>& neighborsIn,
+                   const VecType& pIn,
+                   const VecType& denominatorsIn,
+                   MatType& sum);
 };
 
 } // namespace mlpack
@@ -26,6 +26,7 @@ SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::SoftmaxErrorFunction(
     const LabelsType& labelsIn,
     DistanceType distance) :
     distance(distance),
+    numNeighbors(0),
     precalculated(false)
 {
   MakeAlias(dataset, datasetIn, datasetIn.n_rows, datasetIn.n_cols, 0, false);
@@ -46,6 +47,9 @@ void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::Shuffle()
 
   dataset = std::move(newDataset);
   labels = std::move(newLabels);
+
+  // The precalculated values refer to the old order of the points.
+  precalculated = false;
 }
 
 //! The non-separable implementation, which uses Precalculate() to save time.
@@ -70,46 +74,34 @@ SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::Evaluate(
     const size_t begin,
     const size_t batchSize)
 {
-  // Unfortunately each evaluation will take O(N) time because it requires a
-  // scan over all points in the dataset.  Our objective is to compute p_i.
-  ElemType denominator = 0;
-  ElemType numerator = 0;
-  ElemType result = 0;
+  // Unfortunately each evaluation will take O(N) time per point (unless the
+  // softmax is truncated) because it requires a scan over all points in the
+  // dataset.  Our objective is to compute p_i.
+  Stretch(coordinates);
 
-  // It's quicker to do this now than one point at a time later.
-  stretchedDataset = coordinates * dataset;
+  arma::Mat<size_t> batchNeighbors;
+  if (numNeighbors > 0)
+    FindNeighbors(begin, batchSize, batchNeighbors);
 
-  #pragma omp parallel for reduction(+:result)
-  for (size_t i = begin; i < begin + batchSize; ++i)
-  {
-    for (size_t k = 0; k < dataset.n_cols; ++k)
-    {
-      // Don't consider the case where the points are the same.
-      if (k == i)
-        continue;
-
-      // We want to evaluate exp(-D(A x_i, A x_k)).
-      ElemType eval = std::exp(-distance.Evaluate(
-          stretchedDataset.unsafe_col(i), stretchedDataset.unsafe_col(k)));
-
-      // If they are in the same class, update the numerator.
-      if (labels[i] == labels[k])
-        numerator += eval;
-
-      denominator += eval;
-    }
+  VecType numerators, batchDenominators;
+  Sums(begin, batchSize, batchNeighbors, numerators, batchDenominators);
 
+  ElemType result = 0;
+  for (size_t i = 0; i < batchSize; ++i)
+  {
     // Now the result is just a simple division, but we have to be sure that the
     // denominator is not 0.
-    if (denominator == 0.0)
+    if (batchDenominators[i] == 0.0)
     {
-      Log::Warn << "Denominator of p_" << i << " is 0!" << std::endl;
+      Log::Warn << "Denominator of p_" << (begin + i) << " is 0!" << std::endl;
       continue;
     }
 
-    result += -(numerator / denominator); // Negate because the optimizer is a
-                                          // minimizer.
+    result += -(numerators[i] / batchDenominators[i]); // Negate because the
+                                                       // optimizer is a
+                                                       // minimizer.
   }
+
   return result;
 }
 
@@ -124,38 +116,10 @@ void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::Gradient(
   // Now, we handle the summation over i:
   //   sum_i (p_i sum_k (p_ik x_ik x_ik^T) -
   //       sum_{j in class of i} (p_ij x_ij x_ij^T)
-  // We can algebraically manipulate the whole thing to produce a more
-  // memory-friendly way to calculate this.  Looping over each i and k (again
-  // O((n * (n + 1)) / 2) as with the last step, we can add the following to the
-  // sum:
-  //
-  //   if class of i is the same as the class of k, add
-  //     (((p_i - (1 / p_i)) p_ik) + ((p_k - (1 / p_k)) p_ki)) x_ik x_ik^T
-  //   otherwise, add
-  //     (p_i p_ik + p_k p_ki) x_ik x_ik^T
+  // which is computed by GradientSum() in blocks of pairs, without any outer
+  // product x_ik x_ik^T.
   MatType sum;
-  sum.zeros(stretchedDataset.n_rows, stretchedDataset.n_rows);
-  for (size_t i = 0; i < stretchedDataset.n_cols; ++i)
-  {
-    for (size_t k = (i + 1); k < stretchedDataset.n_cols; ++k)
-    {
-      // Calculate p_ik and p_ki first.
-      ElemType eval = std::exp(-distance.Evaluate(
-          stretchedDataset.unsafe_col(i), stretchedDataset.unsafe_col(k)));
-      ElemType p_ik = 0, p_ki = 0;
-      p_ik = eval / denominators(i);
-      p_ki = eval / denominators(k);
-
-      // Subtract x_i from x_k.  We are not using stretched points here.
-      VecType x_ik = dataset.col(i) - dataset.col(k);
-      MatType secondTerm = (x_ik * trans(x_ik));
-
-      if (labels[i] == labels[k])
-        sum += ((p[i] - 1) * p_ik + (p[k] - 1) * p_ki) * secondTerm;
-      else
-        sum += (p[i] * p_ik + p[k] * p_ki) * secondTerm;
-    }
-  }
+  GradientSum(0, dataset.n_cols, neighbors, p, denominators, sum);
 
   // Assemble the final gradient.
   gradient = -2 * coordinates * sum;
@@ -170,72 +134,39 @@ void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::Gradient(
     GradType& gradient,
     const size_t batchSize)
 {
-  // The gradient involves two matrix terms which are eventually combined into
-  // one.
-  GradType firstTerm, secondTerm;
-  // We will need to calculate p_i before this evaluation is done, so
-  // these two variables will hold the information necessary for that.
-  ElemType numerator, denominator;
-
-  gradient.zeros(coordinates.n_rows, coordinates.n_rows);
-
   // Compute the stretched dataset.
-  stretchedDataset = coordinates * dataset;
-  for (size_t i = begin; i < begin + batchSize; ++i)
-  {
-    numerator = 0;
-    denominator = 0;
-
-    firstTerm.zeros(coordinates.n_rows, coordinates.n_cols);
-    secondTerm.zeros(coordinates.n_rows, coordinates.n_cols);
-
-    for (size_t k = 0; k < dataset.n_cols; ++k)
-    {
-      // Don't consider the case where the points are the same.
-      if (i == k)
-        continue;
-
-      // Calculate the numerator of p_ik.
-      ElemType eval = std::exp(-distance.Evaluate(
-          stretchedDataset.unsafe_col(i), stretchedDataset.unsafe_col(k)));
-
-      // If the points are in the same class, we must add to the second term of
-      // the gradient as well as the numerator of p_i.  We will divide by the
-      // denominator of p_ik later.  For x_ik we are not using stretched points.
-      GradType x_ik = dataset.col(i) - dataset.col(k);
-      if (labels[i] == labels[k])
-      {
-        numerator += eval;
-        secondTerm += eval * x_ik * trans(x_ik);
-      }
+  Stretch(coordinates);
 
-      // We always have to add to the denominator of p_i
-      // and the first term of the gradient computation.
-      // We will divide by the denominator of p_ik later.
-      denominator += eval;
-      firstTerm += eval * x_ik * trans(x_ik);
-    }
+  arma::Mat<size_t> batchNeighbors;
+  if (numNeighbors > 0)
+    FindNeighbors(begin, batchSize, batchNeighbors);
 
-    // Calculate p_i.
-    ElemType p = 0;
-    if (denominator == 0)
+  // We will need to calculate p_i before the gradient, so first compute the
+  // numerators and denominators of the batch.
+  VecType batchP, batchDenominators;
+  Sums(begin, batchSize, batchNeighbors, batchP, batchDenominators);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    if (batchDenominators[i] == 0)
     {
-      Log::Warn << "Denominator of p_" << i << " is 0!" << std::endl;
+      Log::Warn << "Denominator of p_" << (begin + i) << " is 0!" << std::endl;
       // If the denominator is zero, then all p_ik should be zero and there is
       // no gradient contribution from this point.
-      continue;
+      batchP[i] = 0;
     }
     else
     {
-      p = numerator / denominator;
-      firstTerm /= denominator;
-      secondTerm /= denominator;
+      batchP[i] /= batchDenominators[i];
     }
-
-    // Now multiply the first term by p_i, and add the two together and multiply
-    // all by 2 * A.  We negate it though, because our optimizer is a minimizer.
-    gradient += -2 * coordinates * (p * firstTerm - secondTerm);
   }
+
+  MatType sum;
+  GradientSum(begin, batchSize, batchNeighbors, batchP, batchDenominators,
+      sum);
+
+  // Multiply all by 2 * A.  We negate it though, because our optimizer is a
+  // minimizer.
+  gradient = -2 * coordinates * sum;
 }
 
 template<typename MatType, typename LabelsType, typename DistanceType>
@@ -263,44 +194,20 @@ void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::Precalculate(
 
   // Coordinates are different; save the new ones, and stretch the dataset.
   lastCoordinates = coordinates;
-  stretchedDataset = coordinates * dataset;
+  Stretch(coordinates);
 
   // For each point i, we must evaluate the softmax function:
   //   p_ij = exp( -K(x_i, x_j) ) / ( sum_{k != i} ( exp( -K(x_i, x_k) )))
   //   p_i = sum_{j in class of i} p_ij
   // We will do this by keeping track of the denominators for each i as well as
-  // the numerators (the sum for all j in class of i).  This will be on the
-  // order of O((n * (n + 1)) / 2), which really isn't all that great.
-  p.zeros(stretchedDataset.n_cols);
-  denominators.zeros(stretchedDataset.n_cols);
+  // the numerators (the sum for all j in class of i).  Without truncation, this
+  // is O(n^2), which really isn't all that great.
+  if (numNeighbors > 0)
+    FindNeighbors(0, stretchedDataset.n_cols, neighbors);
+  else
+    neighbors.reset();
 
-  // A collapse(2) would be helpful here, but appears to not be supported fully
-  // until OpenMP 5.0.
-  #pragma omp parallel for
-  for (size_t i = 0; i < stretchedDataset.n_cols; ++i)
-  {
-    for (size_t j = (i + 1); j < stretchedDataset.n_cols; ++j)
-    {
-      // Evaluate exp(-d(x_i, x_j)).
-      ElemType eval = std::exp(-distance.Evaluate(
-          stretchedDataset.unsafe_col(i), stretchedDataset.unsafe_col(j)));
-
-      // Add this to the denominators of both p_i and p_j: K(i, j) = K(j, i).
-      #pragma omp atomic
-      denominators[i] += eval;
-      #pragma omp atomic
-      denominators[j] += eval;
-
-      // If i and j are the same class, add to numerator of both.
-      if (labels[i] == labels[j])
-      {
-        #pragma omp atomic
-        p[i] += eval;
-        #pragma omp atomic
-        p[j] += eval;
-      }
-    }
-  }
+  Sums(0, stretchedDataset.n_cols, neighbors, p, denominators);
 
   // Divide p_i by their denominators.
   p /= denominators;
@@ -323,6 +230,277 @@ void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::Precalculate(
   precalculated = true;
 }
 
+template<typename MatType, typename LabelsType, typename DistanceType>
+void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::Stretch(
+    const MatType& coordinates)
+{
+  stretchedDataset = coordinates * dataset;
+  stretchedNorms = arma::sum(arma::square(stretchedDataset), 0);
+}
+
+template<typename MatType, typename LabelsType, typename DistanceType>
+void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::FindNeighbors(
+    const size_t begin,
+    const size_t count,
+    arma::Mat<size_t>& neighborsOut)
+{
+  // Each point is found as its own nearest neighbor (unless it has many
+  // duplicates), so search for one more neighbor and remove the point itself.
+  const size_t k = std::min(numNeighbors, (size_t) stretchedDataset.n_cols - 1);
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, MatType> knn(
+      stretchedDataset);
+  arma::Mat<size_t> found;
+  MatType foundDistances;
+  knn.Search(stretchedDataset.cols(begin, begin + count - 1), k + 1, found,
+      foundDistances);
+
+  neighborsOut.set_size(k, count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    size_t l = 0;
+    for (size_t j = 0; j < k + 1 && l < k; ++j)
+    {
+      if (found(j, i) != begin + i)
+        neighborsOut(l++, i) = found(j, i);
+    }
+  }
+}
+
+template<typename MatType, typename LabelsType, typename DistanceType>
+void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::BlockEvals(
+    const size_t queryBegin,
+    const size_t numQueries,
+    const size_t refBegin,
+    const size_t numRefs,
+    MatType& evals)
+{
+  if constexpr (std::is_same_v<DistanceType, SquaredEuclideanDistance> &&
+                !arma::is_SpMat<MatType>::value)
+  {
+    // ||a - b||^2 = ||a||^2 + ||b||^2 - 2 a^T b; the distance is clamped at
+    // zero, since cancellation may make it slightly negative.
+    evals = 2 * (stretchedDataset.cols(queryBegin,
+        queryBegin + numQueries - 1).t() * stretchedDataset.cols(refBegin,
+        refBegin + numRefs - 1));
+    evals.each_col() -= stretchedNorms.subvec(queryBegin,
+        queryBegin + numQueries - 1).t();
+    evals.each_row() -= stretchedNorms.subvec(refBegin,
+        refBegin + numRefs - 1);
+    evals.transform([](const ElemType x)
+        { return std::exp(std::min(x, ElemType(0))); });
+  }
+  else
+  {
+    evals.set_size(numQueries, numRefs);
+    for (size_t k = 0; k < numRefs; ++k)
+    {
+      for (size_t i = 0; i < numQueries; ++i)
+      {
+        evals(i, k) = std::exp(-distance.Evaluate(
+            stretchedDataset.unsafe_col(queryBegin + i),
+            stretchedDataset.unsafe_col(refBegin + k)));
+      }
+    }
+  }
+
+  // Don't consider the case where the points are the same.
+  const size_t overlapBegin = std::max(queryBegin, refBegin);
+  const size_t overlapEnd = std::min(queryBegin + numQueries,
+      refBegin + numRefs);
+  for (size_t i = overlapBegin; i < overlapEnd; ++i)
+    evals(i - queryBegin, i - refBegin) = 0;
+}
+
+template<typename MatType, typename LabelsType, typename DistanceType>
+void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::NeighborEvals(
+    const size_t begin,
+    const size_t count,
+    const arma::Mat<size_t>& neighborsIn,
+    MatType& evals)
+{
+  evals.set_size(neighborsIn.n_rows, count);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (size_t l = 0; l < neighborsIn.n_rows; ++l)
+    {
+      evals(l, i) = std::exp(-distance.Evaluate(
+          stretchedDataset.unsafe_col(begin + i),
+          stretchedDataset.unsafe_col(neighborsIn(l, i))));
+    }
+  }
+}
+
+template<typename MatType, typename LabelsType, typename DistanceType>
+void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::Sums(
+    const size_t begin,
+    const size_t count,
+    const arma::Mat<size_t>& neighborsIn,
+    VecType& numerators,
+    VecType& denominatorsOut)
+{
+  numerators.zeros(count);
+  denominatorsOut.zeros(count);
+
+  if (!neighborsIn.is_empty())
+  {
+    MatType evals;
+    NeighborEvals(begin, count, neighborsIn, evals);
+    for (size_t i = 0; i < count; ++i)
+    {
+      for (size_t l = 0; l < neighborsIn.n_rows; ++l)
+      {
+        denominatorsOut[i] += evals(l, i);
+        if (labels[begin + i] == labels[neighborsIn(l, i)])
+          numerators[i] += evals(l, i);
+      }
+    }
+
+    return;
+  }
+
+  // Each block of points is handled by one thread, which scans all the other
+  // points in blocks; so, no atomic updates are needed.
+  const size_t queryBlockSize = 256;
+  const size_t refBlockSize = 1024;
+  const size_t n = stretchedDataset.n_cols;
+  const size_t numBlocks = (count + queryBlockSize - 1) / queryBlockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t queryBegin = begin + b * queryBlockSize;
+    const size_t numQueries = std::min(queryBlockSize,
+        begin + count - queryBegin);
+    MatType evals;
+    for (size_t refBegin = 0; refBegin < n; refBegin += refBlockSize)
+    {
+      const size_t numRefs = std::min(refBlockSize, n - refBegin);
+      BlockEvals(queryBegin, numQueries, refBegin, numRefs, evals);
+      for (size_t k = 0; k < numRefs; ++k)
+      {
+        for (size_t i = 0; i < numQueries; ++i)
+        {
+          denominatorsOut[queryBegin - begin + i] += evals(i, k);
+          if (labels[queryBegin + i] == labels[refBegin + k])
+            numerators[queryBegin - begin + i] += evals(i, k);
+        }
+      }
+    }
+  }
+}
+
+template<typename MatType, typename LabelsType, typename DistanceType>
+void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::GradientSum(
+    const size_t begin,
+    const size_t count,
+    const arma::Mat<size_t>& neighborsIn,
+    const VecType& pIn,
+    const VecType& denominatorsIn,
+    MatType& sum)
+{
+  // For weights w_ik = p_ik (p_i - [c_i == c_k]), the sum over i in the batch
+  // and all k of w_ik x_ik x_ik^T is
+  //   sum_i r_i x_i x_i^T + sum_k c_k x_k x_k^T - S - S^T,
+  // where r_i = sum_k w_ik, c_k = sum_i w_ik, and S = sum_{i, k} w_ik x_i x_k^T;
+  // S is accumulated with matrix products.
+  const size_t n = dataset.n_cols;
+  const size_t d = dataset.n_rows;
+  VecType rowSums(count, arma::fill::zeros);
+  VecType colSums(n, arma::fill::zeros);
+  MatType crossSum(d, d, arma::fill::zeros);
+
+  // Get the weight of the pair (i, k), given exp(-d(A x_i, A x_k)).
+  auto weight = [&](const size_t i, const size_t k, const ElemType eval)
+  {
+    const ElemType den = denominatorsIn[i - begin];
+    if (den == 0 || !std::isfinite(den))
+      return ElemType(0);
+
+    const ElemType same = (labels[i] == labels[k]) ? 1 : 0;
+    return (eval / den) * (pIn[i - begin] - same);
+  };
+
+  if (!neighborsIn.is_empty())
+  {
+    MatType evals;
+    NeighborEvals(begin, count, neighborsIn, evals);
+
+    // Column i of weightedNeighbors is sum_k w_ik x_k.
+    MatType weightedNeighbors(d, count, arma::fill::zeros);
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < count; ++i)
+    {
+      for (size_t l = 0; l < neighborsIn.n_rows; ++l)
+      {
+        const ElemType w = weight(begin + i, neighborsIn(l, i), evals(l, i));
+        evals(l, i) = w;
+        rowSums[i] += w;
+        weightedNeighbors.col(i) += w * dataset.col(neighborsIn(l, i));
+      }
+    }
+
+    for (size_t i = 0; i < count; ++i)
+      for (size_t l = 0; l < neighborsIn.n_rows; ++l)
+        colSums[neighborsIn(l, i)] += evals(l, i);
+
+    crossSum = dataset.cols(begin, begin + count - 1) * weightedNeighbors.t();
+  }
+  else
+  {
+    const size_t queryBlockSize = 256;
+    const size_t refBlockSize = 1024;
+    const size_t numBlocks = (count + queryBlockSize - 1) / queryBlockSize;
+
+    #pragma omp parallel
+    {
+      VecType threadColSums(n, arma::fill::zeros);
+      MatType threadCrossSum(d, d, arma::fill::zeros);
+      MatType evals;
+
+      #pragma omp for schedule(dynamic)
+      for (size_t b = 0; b < numBlocks; ++b)
+      {
+        const size_t queryBegin = begin + b * queryBlockSize;
+        const size_t numQueries = std::min(queryBlockSize,
+            begin + count - queryBegin);
+        for (size_t refBegin = 0; refBegin < n; refBegin += refBlockSize)
+        {
+          const size_t numRefs = std::min(refBlockSize, n - refBegin);
+          BlockEvals(queryBegin, numQueries, refBegin, numRefs, evals);
+          for (size_t k = 0; k < numRefs; ++k)
+          {
+            for (size_t i = 0; i < numQueries; ++i)
+            {
+              const ElemType w = weight(queryBegin + i, refBegin + k,
+                  evals(i, k));
+              evals(i, k) = w;
+              rowSums[queryBegin - begin + i] += w;
+              threadColSums[refBegin + k] += w;
+            }
+          }
+
+          threadCrossSum += dataset.cols(queryBegin,
+              queryBegin + numQueries - 1) * evals *
+              dataset.cols(refBegin, refBegin + numRefs - 1).t();
+        }
+      }
+
+      #pragma omp critical
+      {
+        colSums += threadColSums;
+        crossSum += threadCrossSum;
+      }
+    }
+  }
+
+  const MatType batch = dataset.cols(begin, begin + count - 1);
+  sum = (batch.each_row() % rowSums.t()) * batch.t() +
+      (dataset.each_row() % colSums.t()) * dataset.t() - crossSum -
+      crossSum.t();
+}
+
 } // namespace mlpack
 
 #endif
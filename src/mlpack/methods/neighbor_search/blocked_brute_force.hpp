@@ -0,0 +1,138 @@
+/**
+ * @file methods/neighbor_search/blocked_brute_force.hpp
+ *
+ * A blocked brute-force k-nearest-neighbor search for the Euclidean (and
+ * Mahalanobis) distance.  The distances between a block of query points and a
+ * block of reference points are computed with a single matrix multiplication,
+ * using
+ *
+ *   || q - r ||^2 = || q ||^2 + || r ||^2 - 2 q^T r.
+ *
+ * This is much faster than evaluating each pair of points separately, and is
+ * used by NeighborSearch in naive mode and for high-dimensional data, where
+ * trees cannot prune anything.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_BLOCKED_BRUTE_FORCE_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_BLOCKED_BRUTE_FORCE_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * 'value' is true if BlockedBruteForceSearch() can be used with the given
+ * distance metric and matrix type: the metric must be the (squared or not)
+ * Euclidean distance or a Mahalanobis distance, and the matrix must be a dense
+ * floating-point matrix.
+ */
+template<typename DistanceType, typename MatType>
+struct UseBlockedBruteForce : std::false_type { };
+
+template<bool TakeRoot, typename eT>
+struct UseBlockedBruteForce<LMetric<2, TakeRoot>, arma::Mat<eT>> :
+    std::bool_constant<std::is_floating_point_v<eT>> { };
+
+template<bool TakeRoot, typename eT>
+struct UseBlockedBruteForce<MahalanobisDistance<TakeRoot, arma::Mat<eT>>,
+                            arma::Mat<eT>> :
+    std::bool_constant<std::is_floating_point_v<eT>> { };
+
+/**
+ * 'value' is true if the given distance metric is a Mahalanobis distance; the
+ * points are then whitened with MahalanobisDistance::Whiten() before the
+ * search, so that the candidates can be found with the Euclidean distance.
+ */
+template<typename DistanceType>
+struct IsMahalanobisDistance : std::false_type { };
+
+template<bool TakeRoot, typename MatType>
+struct IsMahalanobisDistance<MahalanobisDistance<TakeRoot, MatType>> :
+    std::true_type { };
+
+/**
+ * Find the k best neighbors in the reference set of each point in the query
+ * set, according to the given sort policy, by computing every distance.  The
+ * query set is split into blocks that are processed in parallel with OpenMP;
+ * for each block of queries, the distances to each block of reference points
+ * are obtained from one matrix multiplication, and the best k candidates of
+ * each query are kept in a bounded heap.  The distances of the final
+ * candidates are then recomputed exactly with the given metric, so they are
+ * identical to those of a tree-based search.  For a Mahalanobis distance, the
+ * matrix multiplications are done on copies of the points whitened once by
+ * the Q matrix of the distance.
+ *
+ * The results have the same format as those of NeighborSearch::Search(); if
+ * fewer than k reference points are available for a query, the remaining
+ * entries are set to size_t() - 1 and SortPolicy::WorstDistance().
+ *
+ * @param querySet Set of query points.
+ * @param referenceSet Set of reference points.
+ * @param k Number of neighbors to find for each query point.
+ * @param distance Instantiated Euclidean or Mahalanobis distance metric.
+ * @param sameSet If true, the query set is the reference set, and a point is
+ *     not returned as its own neighbor.
+ * @param removed If not empty, reference point j is ignored if removed[j] is
+ *     true.
+ * @param neighbors Matrix to store the neighbors of each query point in.
+ * @param distances Matrix to store the distances to the neighbors in.
+ */
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         typename IndexType>
+void BlockedBruteForceSearch(const MatType& querySet,
+                             const MatType& referenceSet,
+                             const size_t k,
+                             DistanceType& distance,
+                             const bool sameSet,
+                             const std::vector<bool>& removed,
+                             arma::Mat<IndexType>& neighbors,
+                             arma::Mat<typename MatType::elem_type>& distances);
+
+#ifdef MLPACK_HAS_COOT
+
+/**
+ * Find the k nearest neighbors in the reference set of each point in the query
+ * set, with both sets stored on a GPU with Bandicoot; this is the device
+ * equivalent of NeighborSearch in naive mode.  The distances between a block of
+ * queries and a block of reference points are computed with one matrix
+ * multiplication, as in the other overload, and the best k candidates of each
+ * query are then kept by k passes of index_min() over the current candidates
+ * and the new block.  Nothing is copied between the host and the device.
+ *
+ * The distances are computed from the norms and inner products only, so they
+ * are not recomputed exactly as the other overload does.  If fewer than k
+ * reference points are available for a query, the remaining entries are set to
+ * coot::uword(-1) and the largest value of eT.
+ *
+ * @param querySet Set of query points.
+ * @param referenceSet Set of reference points.
+ * @param k Number of neighbors to find for each query point.
+ * @param distance Instantiated Euclidean distance metric.
+ * @param sameSet If true, the query set is the reference set, and a point is
+ *     not returned as its own neighbor.
+ * @param neighbors Matrix to store the neighbors of each query point in.
+ * @param distances Matrix to store the distances to the neighbors in.
+ */
+template<typename SortPolicy, bool TakeRoot, typename eT>
+void BlockedBruteForceSearch(const coot::Mat<eT>& querySet,
+                             const coot::Mat<eT>& referenceSet,
+                             const size_t k,
+                             LMetric<2, TakeRoot>& distance,
+                             const bool sameSet,
+                             coot::Mat<coot::uword>& neighbors,
+                             coot::Mat<eT>& distances);
+
+#endif
+
+} // namespace mlpack
+
+// Include implementation.
+#include "blocked_brute_force_impl.hpp"
+
+#endif
@@ -0,0 +1,272 @@
+/**
+ * @file methods/neighbor_search/blocked_brute_force_impl.hpp
+ *
+ * Implementation of the blocked brute-force k-nearest-neighbor search.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_BLOCKED_BRUTE_FORCE_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_BLOCKED_BRUTE_FORCE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "blocked_brute_force.hpp"
+
+namespace mlpack {
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         typename IndexType>
+void BlockedBruteForceSearch(const MatType& querySet,
+                             const MatType& referenceSet,
+                             const size_t k,
+                             DistanceType& distance,
+                             const bool sameSet,
+                             const std::vector<bool>& removed,
+                             arma::Mat<IndexType>& neighbors,
+                             arma::Mat<typename MatType::elem_type>& distances)
+{
+  using ElemType = typename MatType::elem_type;
+  using Candidate = std::pair<double, size_t>;
+
+  // The candidate lists are heaps with the worst candidate on top, like those
+  // of NeighborSearchRules.
+  struct CandidateCmp
+  {
+    bool operator()(const Candidate& c1, const Candidate& c2) const
+    {
+      return !SortPolicy::IsBetter(c2.first, c1.first);
+    }
+  };
+
+  // These block sizes keep the block of distances of each thread (1024 x 256)
+  // small enough to stay in cache, while making the matrix multiplications
+  // large enough to be efficient.
+  const size_t queryBlockSize = 256;
+  const size_t referenceBlockSize = 1024;
+
+  const size_t numQueries = querySet.n_cols;
+  const size_t numReferences = referenceSet.n_cols;
+  const size_t numQueryBlocks = (numQueries + queryBlockSize - 1) /
+      queryBlockSize;
+
+  neighbors.set_size(k, numQueries);
+  distances.set_size(k, numQueries);
+
+  // For the Mahalanobis distance, the candidates are found with the Euclidean
+  // distance between the whitened points.
+  MatType whitenedQueries, whitenedReferences;
+  const MatType* queries = &querySet;
+  const MatType* references = &referenceSet;
+  if constexpr (IsMahalanobisDistance<DistanceType>::value)
+  {
+    distance.Whiten(referenceSet, whitenedReferences);
+    references = &whitenedReferences;
+    if (sameSet)
+    {
+      queries = &whitenedReferences;
+    }
+    else
+    {
+      distance.Whiten(querySet, whitenedQueries);
+      queries = &whitenedQueries;
+    }
+  }
+
+  const arma::Row<ElemType> queryNorms = arma::sum(arma::square(*queries), 0);
+  const arma::Row<ElemType> referenceNorms =
+      arma::sum(arma::square(*references), 0);
+
+  const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
+      size_t() - 1);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < numQueryBlocks; ++b)
+  {
+    const size_t queryBegin = b * queryBlockSize;
+    const size_t queryEnd = std::min(queryBegin + queryBlockSize, numQueries);
+    const size_t blockQueries = queryEnd - queryBegin;
+
+    std::vector<std::vector<Candidate>> heaps(blockQueries,
+        std::vector<Candidate>(k, def));
+    arma::Mat<ElemType> products;
+
+    for (size_t r = 0; r < numReferences; r += referenceBlockSize)
+    {
+      const size_t referenceEnd = std::min(r + referenceBlockSize,
+          numReferences);
+
+      // Column q holds the inner products of query q with each reference
+      // point of the block.
+      products = references->cols(r, referenceEnd - 1).t() *
+          queries->cols(queryBegin, queryEnd - 1);
+
+      for (size_t q = 0; q < blockQueries; ++q)
+      {
+        std::vector<Candidate>& heap = heaps[q];
+        const ElemType* column = products.colptr(q);
+        const ElemType queryNorm = queryNorms[queryBegin + q];
+
+        for (size_t j = 0; j < referenceEnd - r; ++j)
+        {
+          const size_t index = r + j;
+          if (sameSet && index == queryBegin + q)
+            continue;
+          if (!removed.empty() && removed[index])
+            continue;
+
+          // Cancellation may make the distance slightly negative.
+          const double dist = std::max(ElemType(0),
+              queryNorm + referenceNorms[index] - 2 * column[j]);
+          if (SortPolicy::IsBetter(dist, heap.front().first))
+          {
+            std::pop_heap(heap.begin(), heap.end(), CandidateCmp());
+            heap.back() = std::make_pair(dist, index);
+            std::push_heap(heap.begin(), heap.end(), CandidateCmp());
+          }
+        }
+      }
+    }
+
+    // Compute the exact distances of the final candidates, and sort them.
+    for (size_t q = 0; q < blockQueries; ++q)
+    {
+      std::vector<Candidate>& heap = heaps[q];
+      const size_t query = queryBegin + q;
+      for (size_t i = 0; i < k; ++i)
+      {
+        if (heap[i].second != size_t() - 1)
+        {
+          heap[i].first = distance.Evaluate(querySet.col(query),
+              referenceSet.col(heap[i].second));
+        }
+      }
+
+      // Sorting with the heap comparison puts the best candidates first.
+      std::sort(heap.begin(), heap.end(), CandidateCmp());
+      for (size_t i = 0; i < k; ++i)
+      {
+        neighbors(i, query) = (IndexType) heap[i].second;
+        distances(i, query) = heap[i].first;
+      }
+    }
+  }
+}
+
+#ifdef MLPACK_HAS_COOT
+
+template<typename SortPolicy, bool TakeRoot, typename eT>
+void BlockedBruteForceSearch(const coot::Mat<eT>& querySet,
+                             const coot::Mat<eT>& referenceSet,
+                             const size_t k,
+                             LMetric<2, TakeRoot>& /* distance */,
+                             const bool sameSet,
+                             coot::Mat<coot::uword>& neighbors,
+                             coot::Mat<eT>& distances)
+{
+  static_assert(std::is_same_v<SortPolicy, NearestNeighborSort>,
+      "The Bandicoot brute-force search only finds nearest neighbors.");
+
+  using UMatType = coot::Mat<coot::uword>;
+
+  // With these block sizes each candidate matrix holds (k + 4096) x 1024
+  // elements, which keeps the selection passes cheap compared to the matrix
+  // multiplications.
+  const size_t queryBlockSize = 1024;
+  const size_t referenceBlockSize = 4096;
+
+  const size_t dim = querySet.n_rows;
+  const size_t numQueries = querySet.n_cols;
+  const size_t numReferences = referenceSet.n_cols;
+  const eT worst = std::numeric_limits<eT>::max();
+  const coot::uword invalid = coot::uword(-1);
+
+  neighbors.set_size(k, numQueries);
+  distances.set_size(k, numQueries);
+
+  const coot::Row<eT> queryNorms = sum(square(querySet), 0);
+  const coot::Col<eT> referenceNorms = trans(sum(square(referenceSet), 0));
+
+  for (size_t qBegin = 0; qBegin < numQueries; qBegin += queryBlockSize)
+  {
+    const size_t qCount = std::min(queryBlockSize, numQueries - qBegin);
+    coot::Mat<eT> queries;
+    MakeAlias(queries, querySet, dim, qCount, qBegin * dim);
+
+    coot::Mat<eT> bestDistances(k, qCount);
+    bestDistances.fill(worst);
+    UMatType bestIndices(k, qCount);
+    bestIndices.fill(invalid);
+
+    for (size_t rBegin = 0; rBegin < numReferences;
+         rBegin += referenceBlockSize)
+    {
+      const size_t rCount = std::min(referenceBlockSize,
+          numReferences - rBegin);
+      coot::Mat<eT> references;
+      MakeAlias(references, referenceSet, dim, rCount, rBegin * dim);
+
+      // Element (j, q) holds the squared distance between reference point j
+      // and query q; cancellation may make it slightly negative.
+      coot::Mat<eT> blockDistances = -2 * (trans(references) * queries);
+      blockDistances.each_col() +=
+          referenceNorms.subvec(rBegin, rBegin + rCount - 1);
+      blockDistances.each_row() += queryNorms.subvec(qBegin,
+          qBegin + qCount - 1);
+      blockDistances = clamp(blockDistances, eT(0), worst);
+
+      const UMatType blockIndices = repmat(coot::linspace<coot::Col<
+          coot::uword>>(rBegin, rBegin + rCount - 1, rCount), 1, qCount);
+      if (sameSet)
+      {
+        // A point is not its own neighbor.
+        const UMatType self = (blockIndices == repmat(coot::linspace<
+            coot::Row<coot::uword>>(qBegin, qBegin + qCount - 1, qCount),
+            rCount, 1));
+        blockDistances += worst * coot::conv_to<coot::Mat<eT>>::from(self);
+      }
+
+      // Select the best k of the current candidates and the new block, one
+      // row at a time; a selected candidate is then moved past the worst
+      // distance, so that it is not selected again.
+      coot::Mat<eT> candidateDistances = join_cols(bestDistances,
+          blockDistances);
+      const UMatType candidateIndices = join_cols(bestIndices, blockIndices);
+      const size_t numCandidates = candidateDistances.n_rows;
+      const UMatType rows = repmat(coot::linspace<coot::Col<coot::uword>>(0,
+          numCandidates - 1, numCandidates), 1, qCount);
+      for (size_t i = 0; i < k; ++i)
+      {
+        const UMatType best = index_min(candidateDistances, 0);
+        const UMatType selected = (rows == repmat(best, numCandidates, 1));
+        bestDistances.row(i) = min(candidateDistances, 0);
+        bestIndices.row(i) = sum(selected % candidateIndices, 0);
+        candidateDistances += worst *
+            coot::conv_to<coot::Mat<eT>>::from(selected);
+      }
+    }
+
+    // Candidates at the worst distance are padding, or the query itself.
+    // (Selected candidates may have overflowed to infinity.)
+    bestDistances = clamp(bestDistances, eT(0), worst);
+    const UMatType padding = (bestDistances >= worst);
+    const coot::Mat<eT> paddingMask = coot::conv_to<coot::Mat<eT>>::from(
+        padding);
+    if (TakeRoot)
+      bestDistances = sqrt(bestDistances);
+
+    neighbors.cols(qBegin, qBegin + qCount - 1) = bestIndices % (1 - padding) +
+        invalid * padding;
+    distances.cols(qBegin, qBegin + qCount - 1) = bestDistances %
+        (1 - paddingMask) + worst * paddingMask;
+  }
+}
+
+#endif
+
+} // namespace mlpack
+
+#endif
@@ -36,7 +36,8 @@ BINDING_SHORT_DESC(
     "An implementation of k-nearest-neighbor search using single-tree and "
     "dual-tree algorithms.  Given a set of reference points and query points, "
     "this can find the k nearest neighbors in the reference set of each query "
-    "point using trees; trees that are built can be saved for future use.");
+    "point using trees or an approximate HNSW graph; trees and graphs that are "
+    "built can be saved for future use.");
 
 // Long description.
 BINDING_LONG_DESC(
@@ -44,7 +45,23 @@ BINDING_LONG_DESC(
     "points using kd-trees or cover trees (cover tree support is experimental "
     "and may be slow). You may specify a separate set of "
     "reference points and query points, or just a reference set which will be "
-    "used as both the reference and query set.");
+    "used as both the reference and query set."
+    "\n\n"
+    "If " + PRINT_PARAM_STRING("tree_type") + " is 'hnsw', a hierarchical "
+    "navigable small world graph is built instead of a tree, and the search is "
+    "approximate; " + PRINT_PARAM_STRING("algorithm") + " and " +
+    PRINT_PARAM_STRING("epsilon") + " are then ignored.  The graph is "
+    "controlled by " + PRINT_PARAM_STRING("hnsw_m") + " (the number of links "
+    "per node) and " + PRINT_PARAM_STRING("ef_construction") + " (the number "
+    "of candidates considered when building the graph), and the accuracy of "
+    "the search by " + PRINT_PARAM_STRING("ef") + "; larger values give "
+    "better recall but slower search."
+    "\n\n"
+    "The 'best_first' algorithm visits the nodes of the reference tree in "
+    "order of their distance to each query point; with " +
+    PRINT_PARAM_STRING("max_visits") + ", it stops after the given number of "
+    "nodes for each query point, which bounds the time of each query at the "
+    "cost of approximate results.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -95,7 +112,7 @@ PARAM_INT_IN("k", "Number of nearest neighbors to find.", "k", 0);
 // building.
 PARAM_STRING_IN("tree_type", "Type of tree to use: 'kd', 'vp', 'rp', 'max-rp', "
     "'ub', 'cover', 'r', 'r-star', 'x', 'ball', 'hilbert-r', 'r-plus', "
-    "'r-plus-plus', 'spill', 'oct'.", "t", "kd");
+    "'r-plus-plus', 'spill', 'oct', 'hnsw'.", "t", "kd");
 PARAM_INT_IN("leaf_size", "Leaf size for tree building (used for kd-trees, vp "
     "trees, random projection trees, UB trees, R trees, R* trees, X trees, "
     "Hilbert R trees, R+ trees, R++ trees, spill trees, and octrees).", "l",
@@ -104,6 +121,12 @@ PARAM_DOUBLE_IN("tau", "Overlapping size (only valid for spill trees).", "u",
     0);
 PARAM_DOUBLE_IN("rho", "Balance threshold (only valid for spill trees).", "b",
     0.7);
+PARAM_INT_IN("hnsw_m", "Number of links per node of the graph (only valid for "
+    "HNSW).", "", 16);
+PARAM_INT_IN("ef_construction", "Number of candidates considered when building "
+    "the graph (only valid for HNSW).", "", 200);
+PARAM_INT_IN("ef", "Number of candidates considered during search (only valid "
+    "for HNSW).", "", 50);
 
 PARAM_FLAG("random_basis", "Before tree-building, project the data onto a "
     "random orthogonal basis.", "R");
@@ -111,7 +134,10 @@ PARAM_INT_IN("seed", "Random seed (if 0, std::time(NULL) is used).", "s", 0);
 
 // Search settings.
 PARAM_STRING_IN("algorithm", "Type of neighbor search: 'naive', 'single_tree', "
-    "'dual_tree', 'greedy'.", "a", "dual_tree");
+    "'dual_tree', 'greedy', 'best_first'.", "a", "dual_tree");
+PARAM_INT_IN("max_visits", "Maximum number of tree nodes visited for each query "
+    "point by the 'best_first' algorithm (0 means no limit, which gives exact "
+    "results).", "", 0);
 PARAM_DOUBLE_IN("epsilon", "If specified, will do approximate nearest neighbor "
     "search with given relative error.", "e", 0);
 
@@ -129,6 +155,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   ReportIgnoredParam(params, {{ "input_model", true }}, "random_basis");
   ReportIgnoredParam(params, {{ "input_model", true }}, "tau");
   ReportIgnoredParam(params, {{ "input_model", true }}, "rho");
+  ReportIgnoredParam(params, {{ "input_model", true }}, "hnsw_m");
+  ReportIgnoredParam(params, {{ "input_model", true }}, "ef_construction");
   if (params.Has("input_model") && params.Has("leaf_size"))
   {
     Log::Warn << PRINT_PARAM_STRING("leaf_size") << " will only be considered"
@@ -176,6 +204,21 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     ReportIgnoredParam(params, "rho", "spill trees are not being used");
   }
 
+  // Sanity checks on the HNSW parameters.
+  RequireParamValue<int>(params, "hnsw_m", [](int x) { return x >= 2; },
+      true, "hnsw_m must be at least 2");
+  RequireParamValue<int>(params, "ef_construction",
+      [](int x) { return x > 0; }, true, "ef_construction must be positive");
+  RequireParamValue<int>(params, "ef", [](int x) { return x > 0; }, true,
+      "ef must be positive");
+  if (params.Has("reference") && params.Get<string>("tree_type") != "hnsw")
+  {
+    ReportIgnoredParam(params, "hnsw_m", "an HNSW graph is not being used");
+    ReportIgnoredParam(params, "ef_construction", "an HNSW graph is not being "
+        "used");
+    ReportIgnoredParam(params, "ef", "an HNSW graph is not being used");
+  }
+
   // Sanity check on epsilon.
   const double epsilon = params.Get<double>("epsilon");
   RequireParamValue<double>(params, "epsilon",
@@ -186,7 +229,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
   const string algorithm = params.Get<string>("algorithm");
   RequireParamInSet<string>(params, "algorithm", { "naive", "single_tree",
-      "dual_tree", "greedy" }, true, "unknown neighbor search algorithm");
+      "dual_tree", "greedy", "best_first" }, true,
+      "unknown neighbor search algorithm");
   NeighborSearchMode searchMode = DUAL_TREE_MODE;
 
   if (algorithm == "naive")
@@ -197,6 +241,14 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     searchMode = DUAL_TREE_MODE;
   else if (algorithm == "greedy")
     searchMode = GREEDY_SINGLE_TREE_MODE;
+  else if (algorithm == "best_first")
+    searchMode = BEST_FIRST_SINGLE_TREE_MODE;
+
+  RequireParamValue<int>(params, "max_visits", [](int x) { return x >= 0; },
+      true, "max_visits must be non-negative");
+  if (algorithm != "best_first")
+    ReportIgnoredParam(params, "max_visits", "the best-first search is not "
+        "being used");
 
   if (params.Has("reference"))
   {
@@ -207,7 +259,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     KNNModel::TreeTypes tree = KNNModel::KD_TREE;
     RequireParamInSet<string>(params, "tree_type", { "kd", "cover", "r",
         "r-star", "ball", "x", "hilbert-r", "r-plus", "r-plus-plus", "spill",
-        "vp", "rp", "max-rp", "ub", "oct" }, true, "unknown tree type");
+        "vp", "rp", "max-rp", "ub", "oct", "hnsw" }, true,
+        "unknown tree type");
 
     knn = new KNNModel();
 
@@ -241,12 +294,17 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
       tree = KNNModel::UB_TREE;
     else if (treeType == "oct")
       tree = KNNModel::OCTREE;
+    else if (treeType == "hnsw")
+      tree = KNNModel::HNSW;
 
     knn->TreeType() = tree;
     knn->RandomBasis() = randomBasis;
     knn->LeafSize() = size_t(lsInt);
     knn->Tau() = tau;
     knn->Rho() = rho;
+    knn->HNSWM() = (size_t) params.Get<int>("hnsw_m");
+    knn->EfConstruction() = (size_t) params.Get<int>("ef_construction");
+    knn->Ef() = (size_t) params.Get<int>("ef");
 
     arma::mat& referenceSet = params.Get<arma::mat>("reference");
 
@@ -270,12 +328,21 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     if (params.Has("leaf_size"))
       knn->LeafSize() = size_t(lsInt);
 
+    // Likewise, ef can be changed without rebuilding an HNSW graph.
+    if (params.Has("ef"))
+      knn->Ef() = (size_t) params.Get<int>("ef");
+
     Log::Info << "Loaded kNN model from '"
         << params.GetPrintable<KNNModel*>("input_model") << "' (trained on "
         << knn->Dataset().n_rows << "x" << knn->Dataset().n_cols
         << " dataset)." << endl;
   }
 
+  Log::Info << "Memory used by the model:" << endl
+      << knn->MemoryUsage().Print();
+
+  knn->MaxVisits() = (size_t) params.Get<int>("max_visits");
+
   // Perform search, if desired.
   if (params.Has("k"))
   {
@@ -345,7 +412,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     // Calculate the effective error, if desired.
     if (params.Has("true_distances"))
     {
-      if (knn->TreeType() != KNNModel::SPILL_TREE && knn->Epsilon() == 0)
+      if (knn->TreeType() != KNNModel::SPILL_TREE &&
+          knn->TreeType() != KNNModel::HNSW && knn->Epsilon() == 0)
         Log::Warn << PRINT_PARAM_STRING("true_distances") << "specified, but "
             << "the search is exact, so there is no need to calculate the "
             << "error!" << endl;
@@ -369,7 +437,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     // Calculate the recall, if desired.
     if (params.Has("true_neighbors"))
     {
-      if (knn->TreeType() != KNNModel::SPILL_TREE && knn->Epsilon() == 0)
+      if (knn->TreeType() != KNNModel::SPILL_TREE &&
+          knn->TreeType() != KNNModel::HNSW && knn->Epsilon() == 0)
         Log::Warn << PRINT_PARAM_STRING("true_neighbors") << " specified, but "
             << " the search is exact, so there is no need to calculate the "
             << "recall!" << endl;
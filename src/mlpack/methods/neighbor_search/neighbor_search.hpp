@@ -19,6 +19,7 @@
 #include "sort_policies/nearest_neighbor_sort.hpp"
 #include "sort_policies/furthest_neighbor_sort.hpp"
 #include "neighbor_search_rules.hpp"
+#include "blocked_brute_force.hpp"
 #include "unmap.hpp"
 
 namespace mlpack {
@@ -38,7 +39,8 @@ enum NeighborSearchMode
   NAIVE_MODE,
   SINGLE_TREE_MODE,
   DUAL_TREE_MODE,
-  GREEDY_SINGLE_TREE_MODE
+  GREEDY_SINGLE_TREE_MODE,
+  BEST_FIRST_SINGLE_TREE_MODE
 };
 
 /**
@@ -205,6 +207,45 @@ class NeighborSearch
    */
   void Train(Tree referenceTree);
 
+  /**
+   * Insert a point into the reference set and the reference tree.  The new
+   * point is given the next index (that is, the number of columns of the
+   * reference set before the call), and the indices of the other points do not
+   * change.  This is only available for tree types that support the insertion
+   * and deletion of points (such as RTree and the other RectangleTree types),
+   * and cannot be used in naive mode.
+   *
+   * If many points have been inserted or removed since the reference tree was
+   * built, the tree is rebuilt before the next search; see RebuildThreshold().
+   *
+   * @param point Point to insert.
+   * @return Index of the inserted point.
+   */
+  template<typename VecType>
+  size_t Insert(const VecType& point);
+
+  /**
+   * Remove the point with the given index from the reference tree, so that it
+   * is no longer returned as a neighbor.  The point is kept in the reference
+   * set, so that the indices of the other points do not change; during
+   * monochromatic search (Search() without a query set), the results for a
+   * removed point are meaningless.  This is only available for tree types that
+   * support the insertion and deletion of points, and cannot be used in naive
+   * mode.  A std::invalid_argument is thrown if the index is out of bounds or
+   * the point has already been removed.
+   *
+   * @param index Index of the point to remove.
+   */
+  void Remove(const size_t index);
+
+  /**
+   * Rebuild the reference tree on the points that have not been removed.  This
+   * is done automatically before a search once the number of points inserted
+   * or removed since the tree was built exceeds RebuildThreshold() times the
+   * number of points in the reference set.
+   */
+  void Rebuild();
+
   /**
    * For each point in the query set, compute the nearest neighbors and store
    * the output in the given matrices.  The matrices will be set to the size of
@@ -313,10 +354,14 @@ class NeighborSearch
 
   //! Return the total number of base case evaluations performed during the last
   //! search.
-  size_t BaseCases() const { return baseCases; }
+  size_t BaseCases() const { return stats.BaseCases(); }
 
   //! Return the number of node combination scores during the last search.
-  size_t Scores() const { return scores; }
+  size_t Scores() const { return stats.Scores(); }
+
+  //! Return the statistics of the last search (base cases, scores, prunes, and
+  //! time spent building query trees and traversing).
+  const TraversalStats& Stats() const { return stats; }
 
   //! Access the search mode.
   NeighborSearchMode SearchMode() const { return searchMode; }
@@ -331,15 +376,75 @@ class NeighborSearch
   //! Access the reference dataset.
   const MatType& ReferenceSet() const { return *referenceSet; }
 
+  //! Return whether the point with the given index has been removed with
+  //! Remove().
+  bool Removed(const size_t index) const
+  { return index < removedPoints.size() && removedPoints[index]; }
+
+  //! Return the number of points inserted or removed since the reference tree
+  //! was built.
+  size_t Modifications() const { return modifications; }
+
+  //! Access the fraction of the reference set that must be inserted or removed
+  //! before the reference tree is rebuilt (0 means it is never rebuilt
+  //! automatically).
+  double RebuildThreshold() const { return rebuildThreshold; }
+  //! Modify the fraction of the reference set that must be inserted or
+  //! removed before the reference tree is rebuilt.
+  double& RebuildThreshold() { return rebuildThreshold; }
+
+  //! Access the dimensionality from which the blocked brute-force search is
+  //! used instead of the trees (0 means never; naive mode always uses it).
+  //! This only applies to the Euclidean distance and dense matrices.
+  size_t BruteForceDimensionality() const { return bruteForceDimensionality; }
+  //! Modify the dimensionality from which the blocked brute-force search is
+  //! used instead of the trees.
+  size_t& BruteForceDimensionality() { return bruteForceDimensionality; }
+
+  //! Access the maximum number of reference nodes visited for each query point
+  //! in best-first single-tree mode (0 means no limit, and gives exact
+  //! results).  Smaller budgets give faster, more approximate searches.
+  size_t MaxVisits() const { return maxVisits; }
+  //! Modify the maximum number of reference nodes visited for each query point
+  //! in best-first single-tree mode.
+  size_t& MaxVisits() { return maxVisits; }
+
   //! Access the reference tree.
   const Tree& ReferenceTree() const { return *referenceTree; }
   //! Modify the reference tree.
   Tree& ReferenceTree() { return *referenceTree; }
 
+  /**
+   * Return the memory used by the model: the nodes and bounds of the reference
+   * tree ("reference tree/..."), the reference set, and the mapping and
+   * removal flags of the reference points.
+   */
+  MemoryReport MemoryUsage() const;
+
   //! Serialize the NeighborSearch model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
 
+  /**
+   * Save the NeighborSearch model to the given binary stream using the flat
+   * tree format of the reference tree (see BinarySpaceTree::SaveFlat()).  This
+   * is much faster to load than serialize() for large reference sets.  It is
+   * only available for tree types that provide SaveFlat() and LoadFlat(), and
+   * cannot be used in naive mode.
+   *
+   * @param stream Binary stream to save the model to.
+   */
+  void SaveFlat(std::ostream& stream) const;
+
+  /**
+   * Load a NeighborSearch model that was saved with SaveFlat().  Any existing
+   * reference tree and dataset are deleted.  A std::runtime_error is thrown if
+   * the stream does not contain a valid model.
+   *
+   * @param stream Binary stream to load the model from.
+   */
+  void LoadFlat(std::istream& stream);
+
  private:
   //! Permutations of reference points during tree building.
   std::vector<size_t> oldFromNewReferences;
@@ -356,15 +461,91 @@ class NeighborSearch
   //! Instantiation of distance metric.
   DistanceType distance;
 
-  //! The total number of base cases.
-  size_t baseCases;
-  //! The total number of scores (applicable for non-naive search).
-  size_t scores;
+  //! The statistics of the last search.
+  TraversalStats stats;
 
   //! If this is true, the reference tree bounds need to be reset on a call to
   //! Search() without a query set.
   bool treeNeedsReset;
 
+  //! For each point of the reference set, whether it has been removed from the
+  //! reference tree.  This is empty if no point has been removed.
+  std::vector<bool> removedPoints;
+  //! The number of points inserted or removed since the tree was built.
+  size_t modifications;
+  //! The fraction of the reference set that must be modified before the
+  //! reference tree is rebuilt.
+  double rebuildThreshold;
+  //! The dimensionality from which the blocked brute-force search is used.
+  size_t bruteForceDimensionality;
+  //! The maximum number of nodes visited for each query point in best-first
+  //! single-tree mode.
+  size_t maxVisits;
+
+  /**
+   * Rebuild the reference tree if enough points have been inserted or removed
+   * since it was built (see RebuildThreshold()).  This does nothing for tree
+   * types that do not support insertion and deletion.
+   */
+  void RebuildIfNeeded();
+
+  /**
+   * Return whether the blocked brute-force search should be used instead of
+   * the trees: this is the case in naive mode, and when the data has at least
+   * BruteForceDimensionality() dimensions, since trees prune almost nothing
+   * in high dimensions.  It requires the Euclidean distance and a dense
+   * floating-point matrix type.
+   */
+  bool UseBruteForce() const;
+
+  /**
+   * Search for the k best neighbors of each point in the query set with
+   * BlockedBruteForceSearch(), mapping the indices of the reference points if
+   * the tree has rearranged them.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   * @param sameSet If true, querySet is the reference set.
+   */
+  template<typename IndexType>
+  void BruteForceSearch(const MatType& querySet,
+                        const size_t k,
+                        arma::Mat<IndexType>& neighbors,
+                        arma::Mat<ElemType>& distances,
+                        const bool sameSet);
+
+  /**
+   * Perform a single-tree search for the first numQueries points of the query
+   * set held by the given rules.  The query points are split over OpenMP
+   * threads; each thread uses its own copy of the rules (which shares its
+   * candidate lists with the given rules) and its own traverser.  The scores
+   * and base cases of each thread are added to the given rules.
+   *
+   * @param rules Rules to use for the search.
+   * @param numQueries Number of query points.
+   */
+  template<typename RuleType>
+  void SingleTreeSearch(RuleType& rules, const size_t numQueries);
+
+  /**
+   * Perform a best-first single-tree search (see BestFirstSingleTreeTraverser)
+   * for the first numQueries points of the query set held by the given rules,
+   * visiting at most MaxVisits() reference nodes for each query point.  The
+   * query points are split over threads as in SingleTreeSearch().
+   *
+   * @param rules Rules to use for the search.
+   * @param numQueries Number of query points.
+   */
+  template<typename RuleType>
+  void BestFirstSearch(RuleType& rules, const size_t numQueries);
+
+  //! Fill the distance evaluations and the traversal time of the statistics of
+  //! the search that started at the given time.
+  void FinishStats(const std::chrono::steady_clock::time_point start);
+
   //! The NSModel class should have access to internal members.
   friend class LeafSizeNSWrapper<SortPolicy, TreeType, DualTreeTraversalType,
       SingleTreeTraversalType>;
@@ -372,6 +553,18 @@ class NeighborSearch
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename SortPolicy,
+                               typename DistanceType,
+                               typename MatType,
+                               template<typename TreeDistanceType,
+                                        typename TreeStatType,
+                                        typename TreeMatType> class TreeType,
+                               template<typename> class DualTreeTraversalType,
+                               template<typename> class
+                                   SingleTreeTraversalType),
+    (mlpack::NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+        DualTreeTraversalType, SingleTreeTraversalType>), (3));
+
 // Include implementation.
 #include "neighbor_search_impl.hpp"
 
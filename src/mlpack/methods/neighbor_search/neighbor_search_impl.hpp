@@ -15,11 +15,28 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/greedy_single_tree_traverser.hpp>
+#include <mlpack/core/tree/best_first_single_tree_traverser.hpp>
 #include "neighbor_search_rules.hpp"
 #include <mlpack/core/tree/spill_tree/is_spill_tree.hpp>
 
 namespace mlpack {
 
+HAS_MEM_FUNC(InsertPoint, HasInsertPointCheck);
+HAS_MEM_FUNC(DeletePoint, HasDeletePointCheck);
+
+/**
+ * 'value' is true if the tree type supports insertion and deletion of points
+ * after it is built, with InsertPoint(const size_t) and
+ * DeletePoint(const size_t) (like RectangleTree).
+ */
+template<typename TreeType>
+struct IsDynamicTree
+{
+  static const bool value =
+      HasInsertPointCheck<TreeType, void(TreeType::*)(const size_t)>::value &&
+      HasDeletePointCheck<TreeType, bool(TreeType::*)(const size_t)>::value;
+};
+
 // Construct the object.
 template<typename SortPolicy,
          typename DistanceType,
@@ -42,9 +59,12 @@ NeighborSearch(MatType referenceSetIn,
     searchMode(mode),
     epsilon(epsilon),
     distance(distance),
-    baseCases(0),
-    scores(0),
-    treeNeedsReset(false)
+    stats(),
+    treeNeedsReset(false),
+    modifications(0),
+    rebuildThreshold(0.5),
+    bruteForceDimensionality(50),
+    maxVisits(0)
 {
   if (epsilon < 0)
     throw std::invalid_argument("epsilon must be non-negative");
@@ -70,9 +90,12 @@ NeighborSearch(Tree referenceTree,
     searchMode(mode),
     epsilon(epsilon),
     distance(distance),
-    baseCases(0),
-    scores(0),
-    treeNeedsReset(false)
+    stats(),
+    treeNeedsReset(false),
+    modifications(0),
+    rebuildThreshold(0.5),
+    bruteForceDimensionality(50),
+    maxVisits(0)
 {
   if (epsilon < 0)
     throw std::invalid_argument("epsilon must be non-negative");
@@ -97,9 +120,12 @@ NeighborSearch(const NeighborSearchMode mode,
     searchMode(mode),
     epsilon(epsilon),
     distance(distance),
-    baseCases(0),
-    scores(0),
-    treeNeedsReset(false)
+    stats(),
+    treeNeedsReset(false),
+    modifications(0),
+    rebuildThreshold(0.5),
+    bruteForceDimensionality(50),
+    maxVisits(0)
 {
   if (epsilon < 0)
     throw std::invalid_argument("epsilon must be non-negative");
@@ -132,9 +158,13 @@ NeighborSearch(const NeighborSearch& other) :
     searchMode(other.searchMode),
     epsilon(other.epsilon),
     distance(other.distance),
-    baseCases(other.baseCases),
-    scores(other.scores),
-    treeNeedsReset(false)
+    stats(other.stats),
+    treeNeedsReset(false),
+    removedPoints(other.removedPoints),
+    modifications(other.modifications),
+    rebuildThreshold(other.rebuildThreshold),
+    bruteForceDimensionality(other.bruteForceDimensionality),
+    maxVisits(other.maxVisits)
 {
   // Nothing else to do.
 }
@@ -157,9 +187,13 @@ NeighborSearch(NeighborSearch&& other) :
     searchMode(other.searchMode),
     epsilon(other.epsilon),
     distance(std::move(other.distance)),
-    baseCases(other.baseCases),
-    scores(other.scores),
-    treeNeedsReset(other.treeNeedsReset)
+    stats(other.stats),
+    treeNeedsReset(other.treeNeedsReset),
+    removedPoints(std::move(other.removedPoints)),
+    modifications(other.modifications),
+    rebuildThreshold(other.rebuildThreshold),
+    bruteForceDimensionality(other.bruteForceDimensionality),
+    maxVisits(other.maxVisits)
 {
   // Clear the other model.
   other.referenceTree = BuildTree<Tree>(std::move(MatType()),
@@ -167,9 +201,10 @@ NeighborSearch(NeighborSearch&& other) :
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
   other.epsilon = 0.0;
-  other.baseCases = 0;
-  other.scores = 0;
+  other.stats.Reset();
   other.treeNeedsReset = false;
+  other.removedPoints.clear();
+  other.modifications = 0;
 }
 
 // Copy operator.
@@ -210,9 +245,13 @@ NeighborSearch<SortPolicy,
   searchMode = other.searchMode;
   epsilon = other.epsilon;
   distance = other.distance;
-  baseCases = other.baseCases;
-  scores = other.scores;
+  stats = other.stats;
   treeNeedsReset = false;
+  removedPoints = other.removedPoints;
+  modifications = other.modifications;
+  rebuildThreshold = other.rebuildThreshold;
+  bruteForceDimensionality = other.bruteForceDimensionality;
+  maxVisits = other.maxVisits;
 }
 
 // Move operator.
@@ -252,9 +291,13 @@ NeighborSearch<SortPolicy,
   searchMode = other.searchMode;
   epsilon = other.epsilon;
   distance = other.distance;
-  baseCases = other.baseCases;
-  scores = other.scores;
+  stats = other.stats;
   treeNeedsReset = other.treeNeedsReset;
+  removedPoints = std::move(other.removedPoints);
+  modifications = other.modifications;
+  rebuildThreshold = other.rebuildThreshold;
+  bruteForceDimensionality = other.bruteForceDimensionality;
+  maxVisits = other.maxVisits;
 
   // Reset the other object.  Clean memory if needed.
   if (!other.referenceTree)
@@ -265,9 +308,10 @@ NeighborSearch<SortPolicy,
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
   other.epsilon = 0.0;
-  other.baseCases = 0;
-  other.scores = 0;
+  other.stats.Reset();
   other.treeNeedsReset = false;
+  other.removedPoints.clear();
+  other.modifications = 0;
 }
 
 // Clean memory.
@@ -323,6 +367,9 @@ Train(MatType referenceSetIn)
   {
     referenceSet = new MatType(std::move(referenceSetIn));
   }
+
+  removedPoints.clear();
+  modifications = 0;
 }
 
 template<typename SortPolicy,
@@ -352,6 +399,140 @@ DualTreeTraversalType, SingleTreeTraversalType>::Train(Tree referenceTree)
 
   this->referenceTree = new Tree(std::move(referenceTree));
   this->referenceSet = &this->referenceTree->Dataset();
+  removedPoints.clear();
+  modifications = 0;
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename VecType>
+size_t NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Insert(const VecType& point)
+{
+  static_assert(IsDynamicTree<Tree>::value, "NeighborSearch::Insert() "
+      "requires a tree type that supports insertion and deletion of points!");
+
+  if (searchMode == NAIVE_MODE)
+  {
+    throw std::invalid_argument("NeighborSearch::Insert(): cannot insert "
+        "points in naive mode!");
+  }
+
+  util::CheckSameDimensionality(point, *referenceSet,
+      "NeighborSearch::Insert()", "point");
+
+  // The tree holds a pointer to its dataset, so the new point can be added to
+  // it directly.
+  MatType& dataset = referenceTree->Dataset();
+  const size_t index = dataset.n_cols;
+  dataset.insert_cols(index, point);
+  referenceTree->InsertPoint(index);
+
+  if (!removedPoints.empty())
+    removedPoints.push_back(false);
+
+  ++modifications;
+  treeNeedsReset = true;
+  return index;
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Remove(const size_t index)
+{
+  static_assert(IsDynamicTree<Tree>::value, "NeighborSearch::Remove() "
+      "requires a tree type that supports insertion and deletion of points!");
+
+  if (searchMode == NAIVE_MODE)
+  {
+    throw std::invalid_argument("NeighborSearch::Remove(): cannot remove "
+        "points in naive mode!");
+  }
+
+  if (index >= referenceSet->n_cols || Removed(index) ||
+      !referenceTree->DeletePoint(index))
+  {
+    std::ostringstream oss;
+    oss << "NeighborSearch::Remove(): point " << index << " is not in the "
+        << "reference tree!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (removedPoints.empty())
+    removedPoints.resize(referenceSet->n_cols, false);
+  removedPoints[index] = true;
+
+  ++modifications;
+  treeNeedsReset = true;
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Rebuild()
+{
+  static_assert(IsDynamicTree<Tree>::value, "NeighborSearch::Rebuild() "
+      "requires a tree type that supports insertion and deletion of points!");
+
+  // There is no tree to rebuild in naive mode.
+  if (!referenceTree)
+    return;
+
+  // Build a new tree on the whole dataset, so that the indices of the points
+  // do not change, and then take the removed points out of it again.
+  MatType dataset(std::move(referenceTree->Dataset()));
+  delete referenceTree;
+  referenceTree = BuildTree<Tree>(std::move(dataset), oldFromNewReferences);
+  referenceSet = &referenceTree->Dataset();
+
+  for (size_t i = 0; i < removedPoints.size(); ++i)
+    if (removedPoints[i])
+      referenceTree->DeletePoint(i);
+
+  modifications = 0;
+  treeNeedsReset = false;
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::RebuildIfNeeded()
+{
+  if constexpr (IsDynamicTree<Tree>::value)
+  {
+    if (rebuildThreshold > 0.0 && modifications > 0 &&
+        modifications >= rebuildThreshold * referenceSet->n_cols)
+    {
+      Log::Info << "Rebuilding reference tree after " << modifications
+          << " points were inserted or removed." << std::endl;
+      Rebuild();
+    }
+  }
 }
 
 /**
@@ -374,6 +555,13 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     arma::Mat<IndexType>& neighbors,
     arma::Mat<ElemType>& distances)
 {
+  MLPACK_PROFILE_SCOPE("NeighborSearch::Search");
+
+  // Rebuild the reference tree first, if it has changed too much (but not if
+  // the query set is the reference set, since rebuilding replaces it).
+  if (&querySet != referenceSet)
+    RebuildIfNeeded();
+
   if (k > referenceSet->n_cols)
   {
     std::stringstream ss;
@@ -382,8 +570,18 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     throw std::invalid_argument(ss.str());
   }
 
-  baseCases = 0;
-  scores = 0;
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  // When trees cannot help, compute every distance with the blocked
+  // brute-force search instead.
+  if (UseBruteForce())
+  {
+    BruteForceSearch(querySet, k, neighbors, distances, false);
+    FinishStats(start);
+    return;
+  }
 
   // This will hold mappings for query points, if necessary.
   std::vector<size_t> oldFromNewQueries;
@@ -425,7 +623,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
         for (size_t j = 0; j < referenceSet->n_cols; ++j)
           rules.BaseCase(i, j);
 
-      baseCases += querySet.n_cols * referenceSet->n_cols;
+      stats.BaseCases() += querySet.n_cols * referenceSet->n_cols;
 
       rules.GetResults(*neighborPtr, *distancePtr);
       break;
@@ -435,15 +633,13 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       // Create the helper object for the tree traversal.
       RuleType rules(*referenceSet, querySet, k, distance, epsilon);
 
-      // Create the traverser.
-      SingleTreeTraversalType<RuleType> traverser(rules);
+      // Split the query points over threads.  Each thread has its own copy of
+      // the rules (which shares candidate lists with the original) and its own
+      // traverser.
+      SingleTreeSearch(rules, querySet.n_cols);
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
-
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+      stats.Scores() += rules.Scores();
+      stats.BaseCases() += rules.BaseCases();
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
@@ -456,7 +652,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     case DUAL_TREE_MODE:
     {
       // Build the query tree.
+      const std::chrono::steady_clock::time_point buildStart =
+          std::chrono::steady_clock::now();
       Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+      stats.TreeBuildingTime() += TraversalStats::Since(buildStart);
 
       // Create the helper object for the tree traversal.
       RuleType rules(*referenceSet, queryTree->Dataset(), k, distance, epsilon);
@@ -466,8 +665,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
       traverser.Traverse(*queryTree, *referenceTree);
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+      MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+      stats.Prunes() += traverser.NumPrunes();
+      stats.Scores() += rules.Scores();
+      stats.BaseCases() += rules.BaseCases();
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
@@ -491,8 +692,29 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       for (size_t i = 0; i < querySet.n_cols; ++i)
         traverser.Traverse(i, *referenceTree);
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+      MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+      stats.Prunes() += traverser.NumPrunes();
+      stats.Scores() += rules.Scores();
+      stats.BaseCases() += rules.BaseCases();
+
+      Log::Info << rules.Scores() << " node combinations were scored."
+          << std::endl;
+      Log::Info << rules.BaseCases() << " base cases were calculated."
+          << std::endl;
+
+      rules.GetResults(*neighborPtr, *distancePtr);
+      break;
+    }
+    case BEST_FIRST_SINGLE_TREE_MODE:
+    {
+      // Create the helper object for the tree traversal.
+      RuleType rules(*referenceSet, querySet, k, distance, epsilon);
+
+      // Split the query points over threads, like the single-tree search.
+      BestFirstSearch(rules, querySet.n_cols);
+
+      stats.Scores() += rules.Scores();
+      stats.BaseCases() += rules.BaseCases();
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
@@ -562,6 +784,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       delete neighborPtr;
     }
   }
+
+  FinishStats(start);
 } // Search()
 
 template<typename SortPolicy,
@@ -581,6 +805,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     arma::Mat<ElemType>& distances,
     bool sameSet)
 {
+  MLPACK_PROFILE_SCOPE("NeighborSearch::Search");
+
   if (k > referenceSet->n_cols)
   {
     std::stringstream ss;
@@ -594,8 +820,9 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     throw std::invalid_argument("cannot call NeighborSearch::Search() with a "
         "query tree when naive or singleMode are set to true");
 
-  baseCases = 0;
-  scores = 0;
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
 
   // Get a reference to the query set.
   const MatType& querySet = queryTree.Dataset();
@@ -617,8 +844,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   DualTreeTraversalType<RuleType> traverser(rules);
   traverser.Traverse(queryTree, *referenceTree);
 
-  scores += rules.Scores();
-  baseCases += rules.BaseCases();
+  MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+  stats.Prunes() += traverser.NumPrunes();
+  stats.Scores() += rules.Scores();
+  stats.BaseCases() += rules.BaseCases();
 
   Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
   Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
@@ -642,6 +871,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     // Finished with temporary matrix.
     delete neighborPtr;
   }
+
+  FinishStats(start);
 }
 
 template<typename SortPolicy,
@@ -659,6 +890,11 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     arma::Mat<IndexType>& neighbors,
     arma::Mat<ElemType>& distances)
 {
+  MLPACK_PROFILE_SCOPE("NeighborSearch::Search");
+
+  // Rebuild the reference tree first, if it has changed too much.
+  RebuildIfNeeded();
+
   if (k > referenceSet->n_cols)
   {
     std::stringstream ss;
@@ -675,8 +911,16 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     throw std::invalid_argument(ss.str());
   }
 
-  baseCases = 0;
-  scores = 0;
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  if (UseBruteForce())
+  {
+    BruteForceSearch(*referenceSet, k, neighbors, distances, true);
+    FinishStats(start);
+    return;
+  }
 
   arma::Mat<IndexType>* neighborPtr = &neighbors;
   arma::Mat<ElemType>* distancePtr = &distances;
@@ -706,20 +950,16 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
         for (size_t j = 0; j < referenceSet->n_cols; ++j)
           rules.BaseCase(i, j);
 
-      baseCases += referenceSet->n_cols * referenceSet->n_cols;
+      stats.BaseCases() += referenceSet->n_cols * referenceSet->n_cols;
       break;
     }
     case SINGLE_TREE_MODE:
     {
-      // Create the traverser.
-      SingleTreeTraversalType<RuleType> traverser(rules);
+      // Split the query points over threads.
+      SingleTreeSearch(rules, referenceSet->n_cols);
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
-
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+      stats.Scores() += rules.Scores();
+      stats.BaseCases() += rules.BaseCases();
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
@@ -756,7 +996,11 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       {
         // For Dual Tree Search on SpillTree, the queryTree must be built with
         // non overlapping (tau = 0).
+        const std::chrono::steady_clock::time_point buildStart =
+            std::chrono::steady_clock::now();
         Tree queryTree(*referenceSet);
+        stats.TreeBuildingTime() += TraversalStats::Since(buildStart);
+
         traverser.Traverse(queryTree, *referenceTree);
       }
       else
@@ -766,8 +1010,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
         treeNeedsReset = true;
       }
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+      MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+      stats.Prunes() += traverser.NumPrunes();
+      stats.Scores() += rules.Scores();
+      stats.BaseCases() += rules.BaseCases();
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
@@ -787,8 +1033,24 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       for (size_t i = 0; i < referenceSet->n_cols; ++i)
         traverser.Traverse(i, *referenceTree);
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+      MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+      stats.Prunes() += traverser.NumPrunes();
+      stats.Scores() += rules.Scores();
+      stats.BaseCases() += rules.BaseCases();
+
+      Log::Info << rules.Scores() << " node combinations were scored."
+          << std::endl;
+      Log::Info << rules.BaseCases() << " base cases were calculated."
+          << std::endl;
+      break;
+    }
+    case BEST_FIRST_SINGLE_TREE_MODE:
+    {
+      // Split the query points over threads.
+      BestFirstSearch(rules, referenceSet->n_cols);
+
+      stats.Scores() += rules.Scores();
+      stats.BaseCases() += rules.BaseCases();
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
@@ -820,6 +1082,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     // Finished with temporary matrices.
     delete neighborPtr;
     delete distancePtr;
+
+  FinishStats(start);
   }
 }
 
@@ -905,7 +1169,7 @@ template<typename SortPolicy,
 template<typename Archive>
 void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
 DualTreeTraversalType, SingleTreeTraversalType>::serialize(
-    Archive& ar, const uint32_t /* version */)
+    Archive& ar, const uint32_t version)
 {
   // Serialize preferences for search.
   ar(CEREAL_NVP(searchMode));
@@ -954,12 +1218,309 @@ DualTreeTraversalType, SingleTreeTraversalType>::serialize(
     }
   }
 
-  // Reset base cases and scores.
+  // Models saved before points could be inserted and removed have no removed
+  // points.
+  if (version > 0)
+  {
+    ar(CEREAL_NVP(removedPoints));
+    ar(CEREAL_NVP(modifications));
+    ar(CEREAL_NVP(rebuildThreshold));
+  }
+  else if (cereal::is_loading<Archive>())
+  {
+    removedPoints.clear();
+    modifications = 0;
+  }
+
+  if (version > 1)
+    ar(CEREAL_NVP(bruteForceDimensionality));
+
+  if (version > 2)
+    ar(CEREAL_NVP(maxVisits));
+  else if (cereal::is_loading<Archive>())
+    maxVisits = 0;
+
+  // Reset the statistics of the last search.
   if (cereal::is_loading<Archive>())
   {
-    baseCases = 0;
-    scores = 0;
+    stats.Reset();
+  }
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::SaveFlat(
+    std::ostream& stream) const
+{
+  if (searchMode == NAIVE_MODE)
+  {
+    throw std::invalid_argument("NeighborSearch::SaveFlat(): cannot save a "
+        "model in naive mode in the flat format!");
+  }
+
+  const uint64_t mode = (uint64_t) searchMode;
+  const uint64_t numMappings = oldFromNewReferences.size();
+  std::vector<uint64_t> mappings(oldFromNewReferences.begin(),
+      oldFromNewReferences.end());
+
+  stream.write((const char*) &mode, sizeof(uint64_t));
+  stream.write((const char*) &epsilon, sizeof(double));
+  stream.write((const char*) &numMappings, sizeof(uint64_t));
+  stream.write((const char*) mappings.data(), numMappings * sizeof(uint64_t));
+
+  referenceTree->SaveFlat(stream);
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::LoadFlat(std::istream& stream)
+{
+  uint64_t mode, numMappings;
+  double newEpsilon;
+  stream.read((char*) &mode, sizeof(uint64_t));
+  stream.read((char*) &newEpsilon, sizeof(double));
+  stream.read((char*) &numMappings, sizeof(uint64_t));
+  if (!stream || mode > BEST_FIRST_SINGLE_TREE_MODE || mode == NAIVE_MODE)
+  {
+    throw std::runtime_error("NeighborSearch::LoadFlat(): stream does not "
+        "contain a valid model!");
+  }
+
+  std::vector<uint64_t> mappings(numMappings);
+  stream.read((char*) mappings.data(), numMappings * sizeof(uint64_t));
+
+  // This throws if the stream is invalid; in that case, we are unmodified.
+  Tree* newTree = Tree::LoadFlat(stream);
+
+  // Clean memory, if necessary.
+  if (referenceTree)
+    delete referenceTree;
+  else
+    delete referenceSet;
+
+  referenceTree = newTree;
+  referenceSet = &referenceTree->Dataset();
+  distance = referenceTree->Distance();
+  oldFromNewReferences.assign(mappings.begin(), mappings.end());
+  searchMode = (NeighborSearchMode) mode;
+  epsilon = newEpsilon;
+  treeNeedsReset = false;
+  removedPoints.clear();
+  modifications = 0;
+  stats.Reset();
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+bool NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::UseBruteForce() const
+{
+  if constexpr (UseBlockedBruteForce<DistanceType, MatType>::value)
+  {
+    return (searchMode == NAIVE_MODE) || (bruteForceDimensionality > 0 &&
+        referenceSet->n_rows >= bruteForceDimensionality);
   }
+  else
+  {
+    return false;
+  }
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename IndexType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::BruteForceSearch(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<IndexType>& neighbors,
+    arma::Mat<ElemType>& distances,
+    const bool sameSet)
+{
+  if constexpr (UseBlockedBruteForce<DistanceType, MatType>::value)
+  {
+    Log::Info << "Using blocked brute-force search for " << querySet.n_cols
+        << " queries in " << referenceSet->n_rows << " dimensions."
+        << std::endl;
+
+    // The removed points are still in the reference set.
+    const bool mapReferences = !oldFromNewReferences.empty() &&
+        TreeTraits<Tree>::RearrangesDataset;
+    if (!mapReferences)
+    {
+      BlockedBruteForceSearch<SortPolicy>(querySet, *referenceSet, k, distance,
+          sameSet, removedPoints, neighbors, distances);
+    }
+    else
+    {
+      arma::Mat<IndexType> neighborsTmp;
+      arma::Mat<ElemType> distancesTmp;
+      BlockedBruteForceSearch<SortPolicy>(querySet, *referenceSet, k, distance,
+          sameSet, removedPoints, neighborsTmp, distancesTmp);
+
+      // Map the reference indices, and the query indices too if the query set
+      // is the (rearranged) reference set.
+      neighbors.set_size(k, querySet.n_cols);
+      distances.set_size(k, querySet.n_cols);
+      for (size_t i = 0; i < querySet.n_cols; ++i)
+      {
+        const size_t queryMapping = sameSet ? oldFromNewReferences[i] : i;
+        distances.col(queryMapping) = distancesTmp.col(i);
+        for (size_t j = 0; j < k; ++j)
+        {
+          neighbors(j, queryMapping) = (neighborsTmp(j, i) == IndexType(-1)) ?
+              neighborsTmp(j, i) : oldFromNewReferences[neighborsTmp(j, i)];
+        }
+      }
+    }
+
+    stats.BaseCases() += querySet.n_cols * referenceSet->n_cols;
+  }
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename RuleType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::SingleTreeSearch(
+    RuleType& rules,
+    const size_t numQueries)
+{
+  // If the tree caches distance evaluations in the reference nodes during
+  // Score() (i.e. if it has self-children like the cover tree), then the
+  // reference tree cannot be shared between threads, so we must run serially.
+  size_t threadScores = 0, threadBaseCases = 0, threadPrunes = 0;
+  #pragma omp parallel if (!TreeTraits<Tree>::HasSelfChildren) \
+      reduction(+:threadScores, threadBaseCases, threadPrunes)
+  {
+    RuleType threadRules(rules);
+    SingleTreeTraversalType<RuleType> traverser(threadRules);
+
+    // Now have it traverse for each point.
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t i = 0; i < numQueries; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+    threadPrunes += traverser.NumPrunes();
+    threadScores += threadRules.Scores();
+    threadBaseCases += threadRules.BaseCases();
+  }
+
+  rules.Scores() += threadScores;
+  rules.BaseCases() += threadBaseCases;
+  stats.Prunes() += threadPrunes;
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename RuleType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::BestFirstSearch(
+    RuleType& rules,
+    const size_t numQueries)
+{
+  // As in SingleTreeSearch(), trees with self-children cache distances in the
+  // reference nodes, so they must be traversed serially.
+  size_t threadScores = 0, threadBaseCases = 0, threadPrunes = 0;
+  #pragma omp parallel if (!TreeTraits<Tree>::HasSelfChildren) \
+      reduction(+:threadScores, threadBaseCases, threadPrunes)
+  {
+    RuleType threadRules(rules);
+    BestFirstSingleTreeTraverser<Tree, RuleType> traverser(threadRules,
+        maxVisits);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t i = 0; i < numQueries; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+    threadPrunes += traverser.NumPrunes();
+    threadScores += threadRules.Scores();
+    threadBaseCases += threadRules.BaseCases();
+  }
+
+  rules.Scores() += threadScores;
+  rules.BaseCases() += threadBaseCases;
+  stats.Prunes() += threadPrunes;
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::FinishStats(
+    const std::chrono::steady_clock::time_point start)
+{
+  // Every base case evaluates exactly one distance.
+  stats.DistanceEvaluations() = stats.BaseCases();
+  stats.TraversalTime() = TraversalStats::Since(start) -
+      stats.TreeBuildingTime();
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+MemoryReport NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::MemoryUsage() const
+{
+  MemoryReport report;
+  if (referenceTree)
+    report.Add("reference tree", TreeMemoryUsage(*referenceTree, false));
+  if (referenceSet)
+    report.Add("reference set", MemoryOf(*referenceSet));
+  report.Add("reference mappings", MemoryOf(oldFromNewReferences));
+  report.Add("removed points", MemoryOf(removedPoints));
+
+  return report;
 }
 
 } // namespace mlpack
@@ -56,6 +56,23 @@ class NeighborSearchRules
                       const double epsilon = 0,
                       const bool sameSet = false);
 
+  /**
+   * Copy the given NeighborSearchRules object for use by a different thread of
+   * a parallel traversal (such as BinarySpaceTree's ParallelDualTreeTraverser).
+   * The copy has its own traversal information, base case cache, and counters,
+   * but it shares the list of candidates for each query point with the
+   * original object.  So, the original object must outlive the copy, and any
+   * two copies must only be used to search for disjoint sets of query points.
+   *
+   * @param other NeighborSearchRules object to share candidates with.
+   */
+  NeighborSearchRules(const NeighborSearchRules& other);
+
+  /**
+   * Delete the list of candidates, if this object owns it.
+   */
+  ~NeighborSearchRules();
+
   /**
    * Store the list of candidates for each query point in the given matrices.
    *
@@ -188,8 +205,12 @@ class NeighborSearchRules
   using CandidateList = std::priority_queue<Candidate, std::vector<Candidate>,
       CandidateCmp>;
 
-  //! Set of candidate neighbors for each point.
-  std::vector<CandidateList> candidates;
+  //! Set of candidate neighbors for each point.  This may be shared with other
+  //! copies of this object.
+  std::vector<CandidateList>* candidates;
+
+  //! If true, this object owns the candidate lists and must delete them.
+  bool ownsCandidates;
 
   //! Number of neighbors to search for.
   const size_t k;
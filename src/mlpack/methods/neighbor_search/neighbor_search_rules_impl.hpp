@@ -28,6 +28,8 @@ NeighborSearchRules<SortPolicy, DistanceType, TreeType>::NeighborSearchRules(
     const bool sameSet) :
     referenceSet(referenceSet),
     querySet(querySet),
+    candidates(new std::vector<CandidateList>()),
+    ownsCandidates(true),
     k(k),
     distance(distance),
     sameSet(sameSet),
@@ -53,9 +55,36 @@ NeighborSearchRules<SortPolicy, DistanceType, TreeType>::NeighborSearchRules(
   std::vector<Candidate> vect(k, def);
   CandidateList pqueue(CandidateCmp(), std::move(vect));
 
-  candidates.reserve(querySet.n_cols);
+  candidates->reserve(querySet.n_cols);
   for (size_t i = 0; i < querySet.n_cols; ++i)
-    candidates.push_back(pqueue);
+    candidates->push_back(pqueue);
+}
+
+template<typename SortPolicy, typename DistanceType, typename TreeType>
+NeighborSearchRules<SortPolicy, DistanceType, TreeType>::NeighborSearchRules(
+    const NeighborSearchRules& other) :
+    referenceSet(other.referenceSet),
+    querySet(other.querySet),
+    candidates(other.candidates),
+    ownsCandidates(false),
+    k(other.k),
+    distance(other.distance),
+    sameSet(other.sameSet),
+    epsilon(other.epsilon),
+    lastQueryIndex(querySet.n_cols),
+    lastReferenceIndex(referenceSet.n_cols),
+    baseCases(0),
+    scores(0),
+    traversalInfo(other.traversalInfo)
+{
+  // Nothing to do.
+}
+
+template<typename SortPolicy, typename DistanceType, typename TreeType>
+NeighborSearchRules<SortPolicy, DistanceType, TreeType>::~NeighborSearchRules()
+{
+  if (ownsCandidates)
+    delete candidates;
 }
 
 template<typename SortPolicy, typename DistanceType, typename TreeType>
@@ -69,7 +98,7 @@ void NeighborSearchRules<SortPolicy, DistanceType, TreeType>::GetResults(
 
   for (size_t i = 0; i < querySet.n_cols; ++i)
   {
-    CandidateList& pqueue = candidates[i];
+    CandidateList& pqueue = (*candidates)[i];
     for (size_t j = 1; j <= k; ++j)
     {
       neighbors(k - j, i) = (IndexType) pqueue.top().second;
@@ -96,6 +125,8 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   double dist = distance.Evaluate(querySet.col(queryIndex),
                                   referenceSet.col(referenceIndex));
   ++baseCases;
+  MLPACK_PROFILE_COUNT(BaseCases, 1);
+  MLPACK_PROFILE_COUNT(DistanceEvaluations, 1);
 
   InsertNeighbor(queryIndex, referenceIndex, dist);
 
@@ -113,6 +144,7 @@ inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Score(
     TreeType& referenceNode)
 {
   ++scores; // Count number of Score() calls.
+  MLPACK_PROFILE_COUNT(Scores, 1);
   double dist;
   if (TreeTraits<TreeType>::FirstPointIsCentroid)
   {
@@ -143,7 +175,7 @@ inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Score(
   }
 
   // Compare against the best k'th distance for this query point so far.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = (*candidates)[queryIndex].top().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
   return (SortPolicy::IsBetter(dist, bestDistance)) ?
@@ -155,6 +187,7 @@ inline size_t NeighborSearchRules<SortPolicy, DistanceType, TreeType>::
 GetBestChild(const size_t queryIndex, TreeType& referenceNode)
 {
   ++scores;
+  MLPACK_PROFILE_COUNT(Scores, 1);
   return SortPolicy::GetBestChild(querySet.col(queryIndex), referenceNode);
 }
 
@@ -163,6 +196,7 @@ inline size_t NeighborSearchRules<SortPolicy, DistanceType, TreeType>::
 GetBestChild(const TreeType& queryNode, TreeType& referenceNode)
 {
   ++scores;
+  MLPACK_PROFILE_COUNT(Scores, 1);
   return SortPolicy::GetBestChild(queryNode, referenceNode);
 }
 
@@ -179,7 +213,7 @@ inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Rescore(
   const double dist = SortPolicy::ConvertToDistance(oldScore);
 
   // Just check the score again against the distances.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = (*candidates)[queryIndex].top().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
   return (SortPolicy::IsBetter(dist, bestDistance)) ? oldScore : DBL_MAX;
@@ -191,6 +225,7 @@ inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Score(
     TreeType& referenceNode)
 {
   ++scores; // Count number of Score() calls.
+  MLPACK_PROFILE_COUNT(Scores, 1);
 
   // Update our bound.
   const double bestDistance = CalculateBound(queryNode);
@@ -402,7 +437,7 @@ inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::
   // Loop over points held in the node.
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double dist = candidates[queryNode.Point(i)].top().first;
+    const double dist = (*candidates)[queryNode.Point(i)].top().first;
     if (SortPolicy::IsBetter(worstDistance, dist))
       worstDistance = dist;
     if (SortPolicy::IsBetter(dist, bestPointDistance))
@@ -497,7 +532,7 @@ InsertNeighbor(
     const size_t neighbor,
     const double dist)
 {
-  CandidateList& pqueue = candidates[queryIndex];
+  CandidateList& pqueue = (*candidates)[queryIndex];
   Candidate c = std::make_pair(dist, neighbor);
 
   if (CandidateCmp()(c, pqueue.top()))
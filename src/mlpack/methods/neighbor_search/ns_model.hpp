@@ -21,6 +21,8 @@
 #include <mlpack/core/tree/rectangle_tree.hpp>
 #include <mlpack/core/tree/spill_tree.hpp>
 #include <mlpack/core/tree/octree.hpp>
+#include <mlpack/methods/hnsw/hnsw_search.hpp>
+#include <mlpack/methods/inverted_index/inverted_index_search.hpp>
 #include "neighbor_search.hpp"
 
 namespace mlpack {
@@ -58,6 +60,22 @@ class NSWrapperBase
   //! Modify the approximation parameter epsilon.
   virtual double& Epsilon() = 0;
 
+  //! Get the maximum number of nodes visited per query point in best-first
+  //! single-tree mode.
+  virtual size_t MaxVisits() const = 0;
+  //! Modify the maximum number of nodes visited per query point in best-first
+  //! single-tree mode.
+  virtual size_t& MaxVisits() = 0;
+
+  //! Return the memory used by the model; by default, only the dataset is
+  //! counted.
+  virtual MemoryReport MemoryUsage() const
+  {
+    MemoryReport report;
+    report.Add("reference set", MemoryOf(Dataset()));
+    return report;
+  }
+
   //! Train the NeighborSearch model with the given parameters.
   virtual void Train(util::Timers& timers,
                      arma::mat&& referenceSet,
@@ -130,6 +148,16 @@ class NSWrapper : public NSWrapperBase
   //! Modify epsilon, the approximation parameter.
   double& Epsilon() { return ns.Epsilon(); }
 
+  //! Get the maximum number of nodes visited per query point in best-first
+  //! single-tree mode.
+  size_t MaxVisits() const { return ns.MaxVisits(); }
+  //! Modify the maximum number of nodes visited per query point in best-first
+  //! single-tree mode.
+  size_t& MaxVisits() { return ns.MaxVisits(); }
+
+  //! Return the memory used by the model (see NeighborSearch::MemoryUsage()).
+  MemoryReport MemoryUsage() const { return ns.MemoryUsage(); }
+
   //! Train the model with the given options.  For NSWrapper, we ignore the
   //! extra parameters.
   virtual void Train(util::Timers& timers,
@@ -328,6 +356,218 @@ class SpillNSWrapper :
              arma::mat>::template DefeatistSingleTreeTraverser>::ns;
 };
 
+/**
+ * The HNSWNSWrapper class wraps the HNSWSearch class, so that an HNSW graph can
+ * be used by NSModel in place of a tree.  The search mode and epsilon are kept
+ * so that the NSWrapperBase interface can be implemented, but they are ignored;
+ * the accuracy of the search is instead controlled by Ef().
+ */
+template<typename SortPolicy>
+class HNSWNSWrapper : public NSWrapperBase
+{
+ public:
+  //! Construct the HNSWNSWrapper with the given graph parameters.
+  HNSWNSWrapper(const NeighborSearchMode searchMode,
+                const double epsilon,
+                const size_t m,
+                const size_t efConstruction,
+                const size_t ef) :
+      searchMode(searchMode),
+      epsilon(epsilon),
+      maxVisits(0),
+      hnsw(m, efConstruction, ef)
+  {
+    // Nothing to do.
+  }
+
+  //! Destruct the HNSWNSWrapper.
+  virtual ~HNSWNSWrapper() { }
+
+  //! Return a copy of the HNSWNSWrapper.
+  virtual HNSWNSWrapper* Clone() const { return new HNSWNSWrapper(*this); }
+
+  //! Get a reference to the reference set.
+  const arma::mat& Dataset() const { return hnsw.ReferenceSet(); }
+
+  //! Get the search mode (ignored).
+  NeighborSearchMode SearchMode() const { return searchMode; }
+  //! Modify the search mode (ignored).
+  NeighborSearchMode& SearchMode() { return searchMode; }
+
+  //! Get epsilon (ignored).
+  double Epsilon() const { return epsilon; }
+  //! Modify epsilon (ignored).
+  double& Epsilon() { return epsilon; }
+
+  //! Get the maximum number of visited nodes (ignored).
+  size_t MaxVisits() const { return maxVisits; }
+  //! Modify the maximum number of visited nodes (ignored).
+  size_t& MaxVisits() { return maxVisits; }
+
+  //! Get the number of candidates considered during search.
+  size_t Ef() const { return hnsw.Ef(); }
+  //! Modify the number of candidates considered during search.
+  size_t& Ef() { return hnsw.Ef(); }
+
+  //! Build the graph on the given reference set.  The tree parameters are
+  //! ignored.
+  virtual void Train(util::Timers& timers,
+                     arma::mat&& referenceSet,
+                     const size_t /* leafSize */,
+                     const double /* tau */,
+                     const double /* rho */);
+
+  //! Perform bichromatic search (i.e. search with a separate query set).  The
+  //! tree parameters are ignored.
+  virtual void Search(util::Timers& timers,
+                      arma::mat&& querySet,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances,
+                      const size_t /* leafSize */,
+                      const double /* rho */);
+
+  //! Perform monochromatic search (i.e. use the reference set as the query
+  //! set).
+  virtual void Search(util::Timers& timers,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances);
+
+  //! Serialize the HNSW model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(searchMode));
+    ar(CEREAL_NVP(epsilon));
+    ar(CEREAL_NVP(hnsw));
+  }
+
+ protected:
+  //! The search mode (ignored).
+  NeighborSearchMode searchMode;
+  //! Epsilon (ignored).
+  double epsilon;
+  //! The maximum number of visited nodes (ignored).
+  size_t maxVisits;
+  //! The instantiated HNSWSearch object that we are wrapping.
+  HNSWSearch<SortPolicy> hnsw;
+};
+
+/**
+ * The InvertedIndexNSWrapper class wraps the InvertedIndexSearch class, so
+ * that sparse data can be searched by cosine similarity through NSModel.  The
+ * returned distances are cosine distances (1 minus the cosine similarity).
+ * Only nearest neighbor search is supported, and the search mode and epsilon
+ * are ignored; the search is always exact.
+ */
+template<typename SortPolicy>
+class InvertedIndexNSWrapper : public NSWrapperBase
+{
+ public:
+  //! Construct the InvertedIndexNSWrapper.
+  InvertedIndexNSWrapper(const NeighborSearchMode searchMode,
+                         const double epsilon) :
+      searchMode(searchMode),
+      epsilon(epsilon),
+      maxVisits(0),
+      index(true /* cosine similarity */)
+  {
+    // Nothing to do.
+  }
+
+  //! Destruct the InvertedIndexNSWrapper.
+  virtual ~InvertedIndexNSWrapper() { }
+
+  //! Return a copy of the InvertedIndexNSWrapper.
+  virtual InvertedIndexNSWrapper* Clone() const
+  {
+    return new InvertedIndexNSWrapper(*this);
+  }
+
+  //! Get a reference to the reference set.  This is empty if the index was
+  //! built from a sparse reference set; see Index() instead.
+  const arma::mat& Dataset() const { return dataset; }
+
+  //! Get the search mode (ignored).
+  NeighborSearchMode SearchMode() const { return searchMode; }
+  //! Modify the search mode (ignored).
+  NeighborSearchMode& SearchMode() { return searchMode; }
+
+  //! Get epsilon (ignored).
+  double Epsilon() const { return epsilon; }
+  //! Modify epsilon (ignored).
+  double& Epsilon() { return epsilon; }
+
+  //! Get the maximum number of visited nodes (ignored).
+  size_t MaxVisits() const { return maxVisits; }
+  //! Modify the maximum number of visited nodes (ignored).
+  size_t& MaxVisits() { return maxVisits; }
+
+  //! Get the inverted index.
+  const InvertedIndexSearch<>& Index() const { return index; }
+
+  //! Build the index on the given dense reference set, which is also kept.
+  //! The tree parameters are ignored.
+  virtual void Train(util::Timers& timers,
+                     arma::mat&& referenceSet,
+                     const size_t /* leafSize */,
+                     const double /* tau */,
+                     const double /* rho */);
+
+  //! Build the index on the given sparse reference set.
+  void Train(util::Timers& timers, arma::sp_mat&& referenceSet);
+
+  //! Perform bichromatic search (i.e. search with a separate query set).  The
+  //! tree parameters are ignored.
+  virtual void Search(util::Timers& timers,
+                      arma::mat&& querySet,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances,
+                      const size_t /* leafSize */,
+                      const double /* rho */);
+
+  //! Perform bichromatic search with a sparse query set.
+  void Search(util::Timers& timers,
+              const arma::sp_mat& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  //! Perform monochromatic search (i.e. use the reference set as the query
+  //! set).
+  virtual void Search(util::Timers& timers,
+                      const size_t k,
+                      arma::Mat<size_t>& neighbors,
+                      arma::mat& distances);
+
+  //! Serialize the inverted index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(searchMode));
+    ar(CEREAL_NVP(epsilon));
+    ar(CEREAL_NVP(dataset));
+    ar(CEREAL_NVP(index));
+  }
+
+ protected:
+  //! Throw if the sort policy is not NearestNeighborSort.
+  static void CheckSortPolicy();
+
+  //! The search mode (ignored).
+  NeighborSearchMode searchMode;
+  //! Epsilon (ignored).
+  double epsilon;
+  //! The maximum number of visited nodes (ignored).
+  size_t maxVisits;
+  //! The dense reference set, if the index was built from one.
+  arma::mat dataset;
+  //! The instantiated InvertedIndexSearch object that we are wrapping.
+  InvertedIndexSearch<> index;
+};
+
 /**
  * The NSModel class provides an easy way to serialize a model, abstracts away
  * the different types of trees, and also reflects the NeighborSearch API.  This
@@ -359,7 +599,9 @@ class NSModel
     MAX_RP_TREE,
     SPILL_TREE,
     UB_TREE,
-    OCTREE
+    OCTREE,
+    HNSW,
+    INVERTED_INDEX
   };
 
  private:
@@ -375,6 +617,11 @@ class NSModel
   double tau;
   double rho;
 
+  //! Parameters of the HNSW graph; only used if treeType is HNSW.
+  size_t hnswM;
+  size_t efConstruction;
+  size_t ef;
+
   /**
    * nSearch holds an instance of the NeighborSearch class for the current
    * treeType. It is initialized every time BuildModel is executed.
@@ -446,10 +693,30 @@ class NSModel
   double Rho() const { return rho; }
   double& Rho() { return rho; }
 
+  //! Expose the number of links per node of the HNSW graph.
+  size_t HNSWM() const { return hnswM; }
+  size_t& HNSWM() { return hnswM; }
+
+  //! Expose the number of candidates of HNSW graph construction.
+  size_t EfConstruction() const { return efConstruction; }
+  size_t& EfConstruction() { return efConstruction; }
+
+  //! Expose the number of candidates of HNSW search.
+  size_t Ef() const { return ef; }
+  size_t& Ef() { return ef; }
+
   //! Expose Epsilon.
   double Epsilon() const;
   double& Epsilon();
 
+  //! Expose the maximum number of nodes visited per query point in best-first
+  //! single-tree mode.
+  size_t MaxVisits() const;
+  size_t& MaxVisits();
+
+  //! Return the memory used by the model, broken down by component.
+  MemoryReport MemoryUsage() const;
+
   //! Expose treeType.
   TreeTypes TreeType() const { return treeType; }
   TreeTypes& TreeType() { return treeType; }
@@ -481,12 +748,36 @@ class NSModel
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
 
+  /**
+   * Build the inverted index on a sparse reference set.  This is only valid if
+   * the tree type is INVERTED_INDEX and no random basis is used; otherwise a
+   * std::invalid_argument is thrown.  Dataset() is empty afterwards.
+   */
+  void BuildModel(util::Timers& timers,
+                  arma::sp_mat&& referenceSet,
+                  const NeighborSearchMode searchMode,
+                  const double epsilon = 0);
+
+  /**
+   * Perform neighbor search with a sparse query set.  This is only valid if
+   * the tree type is INVERTED_INDEX; otherwise a std::invalid_argument is
+   * thrown.
+   */
+  void Search(util::Timers& timers,
+              const arma::sp_mat& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
   //! Return a string representation of the current tree type.
   std::string TreeName() const;
 };
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename SortPolicy),
+    (mlpack::NSModel<SortPolicy>), (1));
+
 // Include implementation.
 #include "ns_model_impl.hpp"
 
@@ -236,6 +236,126 @@ void SpillNSWrapper<SortPolicy>::Search(util::Timers& timers,
   }
 }
 
+//! Build the HNSW graph on the given reference set.
+template<typename SortPolicy>
+void HNSWNSWrapper<SortPolicy>::Train(util::Timers& timers,
+                                      arma::mat&& referenceSet,
+                                      const size_t /* leafSize */,
+                                      const double /* tau */,
+                                      const double /* rho */)
+{
+  timers.Start("graph_building");
+  hnsw.Train(std::move(referenceSet));
+  timers.Stop("graph_building");
+}
+
+//! Perform bichromatic search (i.e. search with a separate query set).
+template<typename SortPolicy>
+void HNSWNSWrapper<SortPolicy>::Search(util::Timers& timers,
+                                       arma::mat&& querySet,
+                                       const size_t k,
+                                       arma::Mat<size_t>& neighbors,
+                                       arma::mat& distances,
+                                       const size_t /* leafSize */,
+                                       const double /* rho */)
+{
+  timers.Start("computing_neighbors");
+  hnsw.Search(querySet, k, neighbors, distances);
+  timers.Stop("computing_neighbors");
+}
+
+//! Perform monochromatic search (i.e. use the reference set as the query set).
+template<typename SortPolicy>
+void HNSWNSWrapper<SortPolicy>::Search(util::Timers& timers,
+                                       const size_t k,
+                                       arma::Mat<size_t>& neighbors,
+                                       arma::mat& distances)
+{
+  timers.Start("computing_neighbors");
+  hnsw.Search(k, neighbors, distances);
+  timers.Stop("computing_neighbors");
+}
+
+//! Throw if the sort policy is not supported by the inverted index.
+template<typename SortPolicy>
+void InvertedIndexNSWrapper<SortPolicy>::CheckSortPolicy()
+{
+  if (!std::is_same_v<SortPolicy, NearestNeighborSort>)
+  {
+    throw std::invalid_argument("InvertedIndexNSWrapper: the inverted index "
+        "only supports nearest neighbor search!");
+  }
+}
+
+//! Build the inverted index on the given dense reference set.
+template<typename SortPolicy>
+void InvertedIndexNSWrapper<SortPolicy>::Train(util::Timers& timers,
+                                               arma::mat&& referenceSet,
+                                               const size_t /* leafSize */,
+                                               const double /* tau */,
+                                               const double /* rho */)
+{
+  CheckSortPolicy();
+
+  timers.Start("index_building");
+  index.Train(arma::sp_mat(referenceSet));
+  dataset = std::move(referenceSet);
+  timers.Stop("index_building");
+}
+
+//! Build the inverted index on the given sparse reference set.
+template<typename SortPolicy>
+void InvertedIndexNSWrapper<SortPolicy>::Train(util::Timers& timers,
+                                               arma::sp_mat&& referenceSet)
+{
+  CheckSortPolicy();
+
+  timers.Start("index_building");
+  dataset.reset();
+  index.Train(std::move(referenceSet));
+  timers.Stop("index_building");
+}
+
+//! Perform bichromatic search (i.e. search with a separate query set).
+template<typename SortPolicy>
+void InvertedIndexNSWrapper<SortPolicy>::Search(util::Timers& timers,
+                                                arma::mat&& querySet,
+                                                const size_t k,
+                                                arma::Mat<size_t>& neighbors,
+                                                arma::mat& distances,
+                                                const size_t /* leafSize */,
+                                                const double /* rho */)
+{
+  Search(timers, arma::sp_mat(querySet), k, neighbors, distances);
+}
+
+//! Perform bichromatic search with a sparse query set.
+template<typename SortPolicy>
+void InvertedIndexNSWrapper<SortPolicy>::Search(util::Timers& timers,
+                                                const arma::sp_mat& querySet,
+                                                const size_t k,
+                                                arma::Mat<size_t>& neighbors,
+                                                arma::mat& distances)
+{
+  timers.Start("computing_neighbors");
+  index.Search(querySet, k, neighbors, distances);
+  distances = arma::clamp(1.0 - distances, 0.0, 2.0);
+  timers.Stop("computing_neighbors");
+}
+
+//! Perform monochromatic search (i.e. use the reference set as the query set).
+template<typename SortPolicy>
+void InvertedIndexNSWrapper<SortPolicy>::Search(util::Timers& timers,
+                                                const size_t k,
+                                                arma::Mat<size_t>& neighbors,
+                                                arma::mat& distances)
+{
+  timers.Start("computing_neighbors");
+  index.Search(k, neighbors, distances);
+  distances = arma::clamp(1.0 - distances, 0.0, 2.0);
+  timers.Stop("computing_neighbors");
+}
+
 /**
  * Initialize the NSModel with the given type and whether or not a random
  * basis should be used.
@@ -247,6 +367,9 @@ NSModel<SortPolicy>::NSModel(TreeTypes treeType, bool randomBasis) :
     leafSize(20),
     tau(0.0),
     rho(0.7),
+    hnswM(16),
+    efConstruction(200),
+    ef(50),
     nSearch(NULL)
 {
   // Nothing to do.
@@ -260,6 +383,9 @@ NSModel<SortPolicy>::NSModel(const NSModel& other) :
     leafSize(other.leafSize),
     tau(other.tau),
     rho(other.rho),
+    hnswM(other.hnswM),
+    efConstruction(other.efConstruction),
+    ef(other.ef),
     nSearch(other.nSearch->Clone())
 {
   // Nothing to do.
@@ -273,6 +399,9 @@ NSModel<SortPolicy>::NSModel(NSModel&& other) :
     leafSize(other.leafSize),
     tau(other.tau),
     rho(other.rho),
+    hnswM(other.hnswM),
+    efConstruction(other.efConstruction),
+    ef(other.ef),
     nSearch(other.nSearch)
 {
   // Reset parameters of the other model.
@@ -281,6 +410,9 @@ NSModel<SortPolicy>::NSModel(NSModel&& other) :
   other.leafSize = 20;
   other.tau = 0.0;
   other.rho = 0.7;
+  other.hnswM = 16;
+  other.efConstruction = 200;
+  other.ef = 50;
   other.nSearch = NULL;
 }
 
@@ -297,6 +429,9 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(const NSModel& other)
     leafSize = other.leafSize;
     tau = other.tau;
     rho = other.rho;
+    hnswM = other.hnswM;
+    efConstruction = other.efConstruction;
+    ef = other.ef;
     nSearch = other.nSearch->Clone();
   }
 
@@ -316,6 +451,9 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
     leafSize = other.leafSize;
     tau = other.tau;
     rho = other.rho;
+    hnswM = other.hnswM;
+    efConstruction = other.efConstruction;
+    ef = other.ef;
     nSearch = other.nSearch;
 
     // Reset parameters of the other model.
@@ -324,6 +462,9 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
     other.leafSize = 20;
     other.tau = 0.0;
     other.rho = 0.7;
+    other.hnswM = 16;
+    other.efConstruction = 200;
+    other.ef = 50;
     other.nSearch = NULL;
   }
 
@@ -340,7 +481,7 @@ NSModel<SortPolicy>::~NSModel()
 //! Serialize the kNN model.
 template<typename SortPolicy>
 template<typename Archive>
-void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
+void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t version)
 {
   ar(CEREAL_NVP(treeType));
   ar(CEREAL_NVP(randomBasis));
@@ -349,6 +490,14 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(tau));
   ar(CEREAL_NVP(rho));
 
+  // Older versions did not support HNSW graphs.
+  if (version > 0)
+  {
+    ar(CEREAL_NVP(hnswM));
+    ar(CEREAL_NVP(efConstruction));
+    ar(CEREAL_NVP(ef));
+  }
+
   // This should never happen, but just in case, be clean with memory.
   if (cereal::is_loading<Archive>())
     InitializeModel(DUAL_TREE_MODE, 0.0); // Values will be overwritten.
@@ -461,6 +610,20 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
         ar(CEREAL_NVP(typedSearch));
         break;
       }
+    case HNSW:
+      {
+        HNSWNSWrapper<SortPolicy>& typedSearch =
+            dynamic_cast<HNSWNSWrapper<SortPolicy>&>(*nSearch);
+        ar(CEREAL_NVP(typedSearch));
+        break;
+      }
+    case INVERTED_INDEX:
+      {
+        InvertedIndexNSWrapper<SortPolicy>& typedSearch =
+            dynamic_cast<InvertedIndexNSWrapper<SortPolicy>&>(*nSearch);
+        ar(CEREAL_NVP(typedSearch));
+        break;
+      }
   }
 }
 
@@ -497,6 +660,24 @@ double& NSModel<SortPolicy>::Epsilon()
   return nSearch->Epsilon();
 }
 
+template<typename SortPolicy>
+size_t NSModel<SortPolicy>::MaxVisits() const
+{
+  return nSearch->MaxVisits();
+}
+
+template<typename SortPolicy>
+size_t& NSModel<SortPolicy>::MaxVisits()
+{
+  return nSearch->MaxVisits();
+}
+
+template<typename SortPolicy>
+MemoryReport NSModel<SortPolicy>::MemoryUsage() const
+{
+  return nSearch ? nSearch->MemoryUsage() : MemoryReport();
+}
+
 //! Initialize a model given the tree type.  (No training happens here.)
 template<typename SortPolicy>
 void NSModel<SortPolicy>::InitializeModel(const NeighborSearchMode searchMode,
@@ -556,6 +737,13 @@ void NSModel<SortPolicy>::InitializeModel(const NeighborSearchMode searchMode,
     case OCTREE:
       nSearch = new LeafSizeNSWrapper<SortPolicy, Octree>(searchMode, epsilon);
       break;
+    case HNSW:
+      nSearch = new HNSWNSWrapper<SortPolicy>(searchMode, epsilon, hnswM,
+          efConstruction, ef);
+      break;
+    case INVERTED_INDEX:
+      nSearch = new InvertedIndexNSWrapper<SortPolicy>(searchMode, epsilon);
+      break;
   }
 }
 
@@ -630,21 +818,38 @@ void NSModel<SortPolicy>::Search(util::Timers& timers,
 
   Log::Info << "Searching for " << k << " neighbors with ";
 
-  switch (SearchMode())
+  // The HNSW graph ignores the search mode, but uses the current value of ef.
+  if (treeType == HNSW)
   {
-    case NAIVE_MODE:
-      Log::Info << "brute-force (naive) search..." << std::endl;
-      break;
-    case SINGLE_TREE_MODE:
-      Log::Info << "single-tree " << TreeName() << " search..." << std::endl;
-      break;
-    case DUAL_TREE_MODE:
-      Log::Info << "dual-tree " << TreeName() << " search..." << std::endl;
-      break;
-    case GREEDY_SINGLE_TREE_MODE:
-      Log::Info << "greedy single-tree " << TreeName() << " search..."
-          << std::endl;
-      break;
+    dynamic_cast<HNSWNSWrapper<SortPolicy>&>(*nSearch).Ef() = ef;
+    Log::Info << "HNSW graph search (ef = " << ef << ")..." << std::endl;
+  }
+  else if (treeType == INVERTED_INDEX)
+  {
+    Log::Info << "inverted index (cosine similarity) search..." << std::endl;
+  }
+  else
+  {
+    switch (SearchMode())
+    {
+      case NAIVE_MODE:
+        Log::Info << "brute-force (naive) search..." << std::endl;
+        break;
+      case SINGLE_TREE_MODE:
+        Log::Info << "single-tree " << TreeName() << " search..." << std::endl;
+        break;
+      case DUAL_TREE_MODE:
+        Log::Info << "dual-tree " << TreeName() << " search..." << std::endl;
+        break;
+      case GREEDY_SINGLE_TREE_MODE:
+        Log::Info << "greedy single-tree " << TreeName() << " search..."
+            << std::endl;
+        break;
+      case BEST_FIRST_SINGLE_TREE_MODE:
+        Log::Info << "best-first single-tree " << TreeName() << " search..."
+            << std::endl;
+        break;
+    }
   }
 
   nSearch->Search(timers, std::move(querySet), k, neighbors, distances,
@@ -660,30 +865,94 @@ void NSModel<SortPolicy>::Search(util::Timers& timers,
 {
   Log::Info << "Searching for " << k << " neighbors with ";
 
-  switch (SearchMode())
+  // The HNSW graph ignores the search mode, but uses the current value of ef.
+  if (treeType == HNSW)
   {
-    case NAIVE_MODE:
-      Log::Info << "brute-force (naive) search..." << std::endl;
-      break;
-    case SINGLE_TREE_MODE:
-      Log::Info << "single-tree " << TreeName() << " search..." << std::endl;
-      break;
-    case DUAL_TREE_MODE:
-      Log::Info << "dual-tree " << TreeName() << " search..." << std::endl;
-      break;
-    case GREEDY_SINGLE_TREE_MODE:
-      Log::Info << "greedy single-tree " << TreeName() << " search..."
-          << std::endl;
-      break;
+    dynamic_cast<HNSWNSWrapper<SortPolicy>&>(*nSearch).Ef() = ef;
+    Log::Info << "HNSW graph search (ef = " << ef << ")..." << std::endl;
+  }
+  else if (treeType == INVERTED_INDEX)
+  {
+    Log::Info << "inverted index (cosine similarity) search..." << std::endl;
+  }
+  else
+  {
+    switch (SearchMode())
+    {
+      case NAIVE_MODE:
+        Log::Info << "brute-force (naive) search..." << std::endl;
+        break;
+      case SINGLE_TREE_MODE:
+        Log::Info << "single-tree " << TreeName() << " search..." << std::endl;
+        break;
+      case DUAL_TREE_MODE:
+        Log::Info << "dual-tree " << TreeName() << " search..." << std::endl;
+        break;
+      case GREEDY_SINGLE_TREE_MODE:
+        Log::Info << "greedy single-tree " << TreeName() << " search..."
+            << std::endl;
+        break;
+      case BEST_FIRST_SINGLE_TREE_MODE:
+        Log::Info << "best-first single-tree " << TreeName() << " search..."
+            << std::endl;
+        break;
+    }
   }
 
-  if (Epsilon() != 0 && SearchMode() != NAIVE_MODE)
+  if (Epsilon() != 0 && SearchMode() != NAIVE_MODE && treeType != HNSW &&
+      treeType != INVERTED_INDEX)
     Log::Info << "Maximum of " << Epsilon() * 100 << "% relative error."
         << std::endl;
 
   nSearch->Search(timers, k, neighbors, distances);
 }
 
+//! Build the inverted index on a sparse reference set.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::BuildModel(util::Timers& timers,
+                                     arma::sp_mat&& referenceSet,
+                                     const NeighborSearchMode searchMode,
+                                     const double epsilon)
+{
+  if (treeType != INVERTED_INDEX)
+  {
+    throw std::invalid_argument("NSModel::BuildModel(): sparse reference sets "
+        "are only supported by the inverted index!");
+  }
+
+  if (randomBasis)
+  {
+    throw std::invalid_argument("NSModel::BuildModel(): a random basis cannot "
+        "be used with a sparse reference set!");
+  }
+
+  Log::Info << "Building inverted index..." << std::endl;
+  InitializeModel(searchMode, epsilon);
+  dynamic_cast<InvertedIndexNSWrapper<SortPolicy>&>(*nSearch).Train(timers,
+      std::move(referenceSet));
+  Log::Info << "Index built." << std::endl;
+}
+
+//! Perform neighbor search with a sparse query set.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::Search(util::Timers& timers,
+                                 const arma::sp_mat& querySet,
+                                 const size_t k,
+                                 arma::Mat<size_t>& neighbors,
+                                 arma::mat& distances)
+{
+  if (treeType != INVERTED_INDEX)
+  {
+    throw std::invalid_argument("NSModel::Search(): sparse query sets are "
+        "only supported by the inverted index!");
+  }
+
+  Log::Info << "Searching for " << k << " neighbors with inverted index "
+      << "(cosine similarity) search..." << std::endl;
+  dynamic_cast<InvertedIndexNSWrapper<SortPolicy>&>(*nSearch).Search(timers,
+      querySet, k, neighbors, distances);
+}
+
 //! Get the name of the tree type.
 template<typename SortPolicy>
 std::string NSModel<SortPolicy>::TreeName() const
@@ -720,6 +989,10 @@ std::string NSModel<SortPolicy>::TreeName() const
       return "UB tree";
     case OCTREE:
       return "octree";
+    case HNSW:
+      return "HNSW graph";
+    case INVERTED_INDEX:
+      return "inverted index";
     default:
       return "unknown tree";
   }
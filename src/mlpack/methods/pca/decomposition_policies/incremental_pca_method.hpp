@@ -0,0 +1,350 @@
+/**
+ * @file methods/pca/decomposition_policies/incremental_pca_method.hpp
+ *
+ * Implementation of the incremental PCA policy, which updates a low-rank SVD
+ * of the centered data one mini-batch at a time, for use in the Principal
+ * Components Analysis method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_INCREMENTAL_PCA_METHOD_HPP
+#define MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_INCREMENTAL_PCA_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/chunked_source.hpp>
+
+#include "pca_policy_traits.hpp"
+
+namespace mlpack {
+
+/**
+ * Implementation of the incremental PCA policy.  Instead of decomposing the
+ * whole centered data matrix, the policy keeps a rank-k SVD U S of the data
+ * seen so far (centered on its running mean), and merges each mini-batch B of m
+ * points into it, as in
+ *
+ * @code
+ * @article{ross2008incremental,
+ *   title={Incremental learning for robust visual tracking},
+ *   author={Ross, D.A. and Lim, J. and Lin, R.-S. and Yang, M.-H.},
+ *   journal={International Journal of Computer Vision},
+ *   volume={77},
+ *   number={1--3},
+ *   pages={125--141},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * The new decomposition is the truncated SVD of the d x (k + m + 1) matrix
+ *
+ *   [ U S | B - mean(B) | sqrt(n m / (n + m)) (mean(B) - mean) ]
+ *
+ * where n is the number of points seen before, and the last column accounts
+ * for the shift of the mean.  So, the data is centered implicitly, and only
+ * one mini-batch and the d x k components are held in memory at a time.  When
+ * the rank is the dimensionality of the data, the result is the exact PCA (up
+ * to rounding errors); otherwise, it is an approximation which is usually
+ * very close to the truncated exact PCA.
+ *
+ * When used as the decomposition policy of PCA (without scaling), PCA does not
+ * make a centered copy of the data.  The policy can also be trained directly
+ * on a data::ChunkedSource, with a single pass over the file:
+ *
+ * @code
+ * data::ChunkedSource<> source("features.bin", 100000);
+ * IncrementalPCAPolicy ipca(1000);
+ * ipca.Train(source, 50); // Keep 50 components.
+ *
+ * // Now reduce the dimension of each chunk.
+ * arma::mat chunk, reduced;
+ * source.Reset();
+ * while (source.Next(chunk))
+ *   ipca.Transform(chunk, reduced);
+ * @endcode
+ */
+class IncrementalPCAPolicy
+{
+ public:
+  /**
+   * Use incremental PCA to perform the principal components analysis.
+   *
+   * @param batchSize Number of points in each mini-batch; if 0, all the points
+   *     given at once are used as a single mini-batch.
+   */
+  IncrementalPCAPolicy(const size_t batchSize = 1000) :
+      batchSize(batchSize),
+      numPoints(0),
+      scatter(0.0)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Apply Principal Component Analysis to the provided data set using the
+   * incremental PCA method.  This is the overload used by PCA when the data is
+   * scaled; the given centered data is treated as the data.
+   *
+   * @param data Data matrix.
+   * @param centeredData Centered data matrix.
+   * @param transformedData Matrix to put results of PCA into.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   * @param rank Rank of the decomposition.
+   */
+  template<typename InMatType, typename MatType, typename VecType>
+  void Apply(const InMatType& /* data */,
+             const MatType& centeredData,
+             MatType& transformedData,
+             VecType& eigVal,
+             MatType& eigvec,
+             const size_t rank)
+  {
+    Apply(centeredData, transformedData, eigVal, eigvec, rank);
+  }
+
+  /**
+   * Apply Principal Component Analysis to the provided (uncentered) data set
+   * using the incremental PCA method.  The data is visited in mini-batches,
+   * and is never copied as a whole; for sparse data, only one mini-batch is
+   * made dense at a time.  It is safe to pass the same matrix for both data
+   * and transformedData.
+   *
+   * @param data Data matrix (dense or sparse).
+   * @param transformedData Matrix to put results of PCA into.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   * @param rank Rank of the decomposition.
+   */
+  template<typename InMatType, typename MatType, typename VecType>
+  void Apply(const InMatType& data,
+             MatType& transformedData,
+             VecType& eigVal,
+             MatType& eigvec,
+             const size_t rank)
+  {
+    // This does not copy anything if data is already a dense or sparse
+    // matrix.
+    using BaseMatType = std::conditional_t<
+        arma::is_arma_sparse_type<InMatType>::value,
+        arma::SpMat<typename InMatType::elem_type>,
+        typename GetDenseMatType<InMatType>::type>;
+    const BaseMatType& x = data;
+
+    Reset();
+    const size_t step = (batchSize == 0) ? (size_t) x.n_cols : batchSize;
+    for (size_t begin = 0; begin < x.n_cols; begin += step)
+    {
+      const size_t end = std::min(begin + step, (size_t) x.n_cols) - 1;
+      Update(x.cols(begin, end), rank);
+    }
+
+    EigenValues(eigVal);
+    eigvec = arma::conv_to<MatType>::from(components);
+    Transform(x, transformedData);
+  }
+
+  /**
+   * Merge the given mini-batch of points into the decomposition.  The rank of
+   * the decomposition is min(rank, dimensionality of the data) once enough
+   * points have been seen.
+   *
+   * @param batch Mini-batch of points.
+   * @param rank Rank of the decomposition.
+   */
+  template<typename MatType>
+  void Update(const MatType& batch, const size_t rank)
+  {
+    if (batch.n_cols == 0)
+      return;
+
+    if (rank == 0)
+    {
+      throw std::invalid_argument("IncrementalPCAPolicy::Update(): rank must "
+          "be positive");
+    }
+
+    if (numPoints > 0 && batch.n_rows != mean.n_elem)
+    {
+      std::ostringstream oss;
+      oss << "IncrementalPCAPolicy::Update(): batch has " << batch.n_rows
+          << " dimensions, but the model has " << mean.n_elem << "!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    const size_t k = singularValues.n_elem;
+    const size_t m = batch.n_cols;
+    const size_t shiftCols = (numPoints > 0) ? 1 : 0;
+
+    arma::mat stacked(batch.n_rows, k + m + shiftCols);
+    if (k > 0)
+      stacked.cols(0, k - 1) = components.each_row() % singularValues.t();
+
+    stacked.cols(k, k + m - 1) = arma::conv_to<arma::mat>::from(batch);
+    const arma::vec batchMean = arma::mean(stacked.cols(k, k + m - 1), 1);
+    stacked.cols(k, k + m - 1).each_col() -= batchMean;
+
+    const double n = (double) numPoints;
+    const double b = (double) m;
+    scatter += arma::accu(arma::square(stacked.cols(k, k + m - 1)));
+    if (shiftCols > 0)
+    {
+      stacked.col(k + m) = std::sqrt(n * b / (n + b)) * (batchMean - mean);
+      scatter += arma::accu(arma::square(stacked.col(k + m)));
+      mean = (n * mean + b * batchMean) / (n + b);
+    }
+    else
+    {
+      mean = batchMean;
+    }
+    numPoints += m;
+
+    arma::mat u, v;
+    arma::vec s;
+    if (!arma::svd_econ(u, s, v, stacked, 'l'))
+    {
+      throw std::runtime_error("IncrementalPCAPolicy::Update(): SVD "
+          "failed");
+    }
+
+    const size_t newRank = std::min(rank, (size_t) s.n_elem);
+    components = u.cols(0, newRank - 1);
+    singularValues = s.subvec(0, newRank - 1);
+  }
+
+  /**
+   * Compute the decomposition of the points read from the given source, with
+   * one pass over the source.  The source is reset first.
+   *
+   * @param source Source of the points.
+   * @param rank Rank of the decomposition.
+   */
+  template<typename eT>
+  void Train(data::ChunkedSource<eT>& source, const size_t rank)
+  {
+    Reset();
+    source.Reset();
+
+    arma::Mat<eT> chunk;
+    while (source.Next(chunk))
+    {
+      const size_t step = (batchSize == 0) ? (size_t) chunk.n_cols : batchSize;
+      for (size_t begin = 0; begin < chunk.n_cols; begin += step)
+      {
+        const size_t end = std::min(begin + step, (size_t) chunk.n_cols) - 1;
+        Update(chunk.cols(begin, end), rank);
+      }
+    }
+  }
+
+  /**
+   * Project the given points onto the principal components, after centering
+   * them with the mean of the data.  It is safe to pass the same matrix for
+   * both data and transformedData.
+   *
+   * @param data Points to project.
+   * @param transformedData Matrix to store the projected points in.
+   */
+  template<typename MatType, typename OutMatType>
+  void Transform(const MatType& data, OutMatType& transformedData) const
+  {
+    using ElemType = typename OutMatType::elem_type;
+    const arma::Mat<ElemType> u =
+        arma::conv_to<arma::Mat<ElemType>>::from(components);
+    const arma::Col<ElemType> mu =
+        arma::conv_to<arma::Col<ElemType>>::from(mean);
+
+    // Center each mini-batch after it is projected, so that sparse data stays
+    // sparse.
+    const arma::Col<ElemType> projectedMean = u.t() * mu;
+    OutMatType result(u.n_cols, data.n_cols);
+    const size_t step = (batchSize == 0) ? (size_t) data.n_cols : batchSize;
+    for (size_t begin = 0; begin < data.n_cols; begin += step)
+    {
+      const size_t end = std::min(begin + step, (size_t) data.n_cols) - 1;
+      result.cols(begin, end) = u.t() * data.cols(begin, end);
+      result.cols(begin, end).each_col() -= projectedMean;
+    }
+
+    transformedData = std::move(result);
+  }
+
+  /**
+   * Store the eigenvalues of the covariance matrix of the data seen so far in
+   * the given vector.
+   *
+   * @param eigVal Vector to put eigenvalues into.
+   */
+  template<typename VecType>
+  void EigenValues(VecType& eigVal) const
+  {
+    // The covariance matrix is X * X' / (N - 1).
+    const double scale = (numPoints > 1) ? 1.0 / (numPoints - 1) : 0.0;
+    eigVal = arma::conv_to<VecType>::from(
+        singularValues % singularValues * scale);
+  }
+
+  /**
+   * Return the total variance of the data seen so far (the trace of its
+   * covariance matrix), including the variance that is not captured by the
+   * decomposition.
+   */
+  double TotalVariance() const
+  {
+    return (numPoints > 1) ? scatter / (numPoints - 1) : 0.0;
+  }
+
+  //! Forget every point seen so far.
+  void Reset()
+  {
+    numPoints = 0;
+    scatter = 0.0;
+    mean.reset();
+    components.reset();
+    singularValues.reset();
+  }
+
+  //! Get the number of points in each mini-batch.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points in each mini-batch.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the number of points seen so far.
+  size_t NumPoints() const { return numPoints; }
+  //! Get the mean of the points seen so far.
+  const arma::vec& Mean() const { return mean; }
+  //! Get the principal components (one per column).
+  const arma::mat& Components() const { return components; }
+  //! Get the singular values of the centered data seen so far.
+  const arma::vec& SingularValues() const { return singularValues; }
+
+ private:
+  //! Number of points in each mini-batch.
+  size_t batchSize;
+
+  //! Number of points seen so far.
+  size_t numPoints;
+  //! Sum of the squared distances of the points seen so far to their mean.
+  double scatter;
+  //! Mean of the points seen so far.
+  arma::vec mean;
+  //! Left singular vectors of the centered data seen so far.
+  arma::mat components;
+  //! Singular values of the centered data seen so far.
+  arma::vec singularValues;
+};
+
+//! The incremental PCA policy centers the data implicitly.
+template<>
+class PCAPolicyTraits<IncrementalPCAPolicy>
+{
+ public:
+  static const bool ImplicitCentering = true;
+};
+
+} // namespace mlpack
+
+#endif
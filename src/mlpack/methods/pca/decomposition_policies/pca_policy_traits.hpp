@@ -0,0 +1,39 @@
+/**
+ * @file methods/pca/decomposition_policies/pca_policy_traits.hpp
+ *
+ * This provides the PCAPolicyTraits class, a template class to get information
+ * about the decomposition policies of PCA.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_PCA_POLICY_TRAITS_HPP
+#define MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_PCA_POLICY_TRAITS_HPP
+
+namespace mlpack {
+
+/**
+ * This is a template class that can provide information about the
+ * decomposition policies of PCA.  By default, this class will provide the
+ * weakest possible assumptions on policies, and each policy should override
+ * values as necessary.  If a policy doesn't need to override a value, then
+ * there's no need to write a PCAPolicyTraits specialization for that class.
+ */
+template<typename DecompositionPolicy>
+class PCAPolicyTraits
+{
+ public:
+  /**
+   * If true, then the policy centers the data implicitly: it provides an
+   * overload Apply(data, transformedData, eigVal, eigvec, rank) taking the
+   * uncentered data, which may be a dense or sparse matrix.  PCA then does not
+   * make a centered (dense) copy of the data, unless the data must be scaled.
+   */
+  static const bool ImplicitCentering = false;
+};
+
+} // namespace mlpack
+
+#endif
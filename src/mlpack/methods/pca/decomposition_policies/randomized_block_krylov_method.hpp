@@ -17,6 +17,8 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/methods/block_krylov_svd/randomized_block_krylov_svd.hpp>
 
+#include "pca_policy_traits.hpp"
+
 namespace mlpack {
 
 /**
@@ -77,6 +79,47 @@ class RandomizedBlockKrylovSVDPolicy
     transformedData = trans(eigvec) * centeredData;
   }
 
+  /**
+   * Apply Principal Component Analysis to the provided (uncentered) data set
+   * using the randomized block krylov SVD method.  The data is centered
+   * implicitly, so it is never copied, and a sparse data matrix stays sparse.
+   * It is safe to pass the same matrix for both data and transformedData.
+   *
+   * @param data Data matrix (dense or sparse).
+   * @param transformedData Matrix to put results of PCA into.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   * @param rank Rank of the decomposition.
+   */
+  template<typename InMatType, typename MatType, typename VecType>
+  void Apply(const InMatType& data,
+             MatType& transformedData,
+             VecType& eigVal,
+             MatType& eigvec,
+             const size_t rank)
+  {
+    // This matrix will store the right singular vectors; we do not need them.
+    MatType v;
+
+    // The mean is kept dense, even for sparse data.
+    const MatType rowMean = MatType(arma::sum(data, 1)) / data.n_cols;
+
+    // Do singular value decomposition of the centered data using the
+    // randomized block krylov SVD algorithm.
+    RandomizedBlockKrylovSVD rsvd(maxIterations, blockSize);
+    rsvd.Apply(data, eigvec, eigVal, v, rank, rowMean);
+
+    // Now we must square the singular values to get the eigenvalues.
+    // In addition we must divide by the number of points, because the
+    // covariance matrix is X * X' / (N - 1).
+    eigVal %= eigVal / (data.n_cols - 1);
+
+    // Project the samples to the principals, centering them on the fly.
+    const MatType projectedMean = trans(eigvec) * rowMean;
+    transformedData = trans(eigvec) * data;
+    transformedData.each_col() -= projectedMean.col(0);
+  }
+
   //! Get the number of iterations for the power method.
   size_t MaxIterations() const { return maxIterations; }
   //! Modify the number of iterations for the power method.
@@ -95,6 +138,14 @@ class RandomizedBlockKrylovSVDPolicy
   size_t blockSize;
 };
 
+//! The randomized block krylov SVD policy centers the data implicitly.
+template<>
+class PCAPolicyTraits<RandomizedBlockKrylovSVDPolicy>
+{
+ public:
+  static const bool ImplicitCentering = true;
+};
+
 } // namespace mlpack
 
 #endif
@@ -52,6 +52,19 @@ void PCA<DecompositionPolicy>::Apply(const MatType& data,
       "PCA::Apply(): data and transformedData must have the same element "
       "types!");
 
+  // Some policies center the data themselves, so no centered copy of a dense
+  // or sparse matrix is needed unless it must be scaled.
+  if constexpr (PCAPolicyTraits<DecompositionPolicy>::ImplicitCentering &&
+                (std::is_same_v<MatType, OutMatType> ||
+                 arma::is_SpMat<MatType>::value))
+  {
+    if (!scaleData)
+    {
+      decomposition.Apply(data, transformedData, eigVal, eigvec, data.n_rows);
+      return;
+    }
+  }
+
   // Center the data into a temporary matrix.
   OutMatType centeredData = arma::conv_to<OutMatType>::from(data);
   centeredData.each_col() -= arma::mean(centeredData, 1);
@@ -158,6 +171,44 @@ double PCA<DecompositionPolicy>::Apply(const MatType& data,
   BaseMatType eigvec;
   BaseColType eigVal;
 
+  // Some policies center the data themselves, so no centered copy of a dense
+  // or sparse matrix is needed unless it must be scaled.
+  if constexpr (PCAPolicyTraits<DecompositionPolicy>::ImplicitCentering &&
+                (std::is_same_v<MatType, BaseMatType> ||
+                 arma::is_SpMat<MatType>::value))
+  {
+    if (!scaleData)
+    {
+      if (newDimension > data.n_rows)
+      {
+        std::ostringstream oss;
+        oss << "PCA::Apply(): newDimension (" << newDimension << ") cannot "
+            << "be greater than the existing dimensionality of the data ("
+            << data.n_rows << ")!";
+        throw std::invalid_argument(oss.str());
+      }
+
+      // Only the leading eigenvalues may be computed, so compute the total
+      // variance (the trace of the covariance matrix) from the data, before it
+      // may be overwritten: ||X - mu 1^T||^2 = ||X||^2 - n ||mu||^2.
+      const double n = (double) data.n_cols;
+      const arma::vec mu = arma::vec(arma::conv_to<arma::mat>::from(
+          arma::sum(data, 1))) / n;
+      const double totalVariance = (arma::accu(arma::square(data)) -
+          n * arma::dot(mu, mu)) / (n - 1);
+
+      decomposition.Apply(data, transformedData, eigVal, eigvec,
+          newDimension);
+
+      if (newDimension < transformedData.n_rows)
+        transformedData.shed_rows(newDimension, transformedData.n_rows - 1);
+
+      const size_t eigDim = std::min(newDimension, (size_t) eigVal.n_elem);
+      return (totalVariance <= 0.0) ? 1.0 :
+          (arma::accu(eigVal.subvec(0, eigDim - 1)) / totalVariance);
+    }
+  }
+
   // Center the data into a temporary matrix.
   BaseMatType centeredData = arma::conv_to<OutMatType>::from(data);
   centeredData.each_col() -= arma::mean(centeredData, 1);
@@ -169,7 +220,7 @@ double PCA<DecompositionPolicy>::Apply(const MatType& data,
     std::ostringstream oss;
     oss << "PCA::Apply(): newDimension (" << newDimension << ") cannot "
         << "be greater than the existing dimensionality of the data ("
-        << data.n_rows << ")!";
+        << centeredData.n_rows << ")!";
     throw std::invalid_argument(oss.str());
   }
 
@@ -179,9 +230,9 @@ double PCA<DecompositionPolicy>::Apply(const MatType& data,
   decomposition.Apply(data, centeredData, transformedData, eigVal, eigvec,
       newDimension);
 
-  if (newDimension < eigvec.n_rows)
+  if (newDimension < transformedData.n_rows)
     // Drop unnecessary rows.
-    transformedData.shed_rows(newDimension, data.n_rows - 1);
+    transformedData.shed_rows(newDimension, transformedData.n_rows - 1);
 
   // The svd method returns only non-zero eigenvalues so we have to calculate
   // the right dimension before calculating the amount of variance retained.
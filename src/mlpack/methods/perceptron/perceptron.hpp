@@ -183,6 +183,15 @@ class Perceptron
    */
   void Classify(const MatType& test, arma::Row<size_t>& predictedLabels) const;
 
+  /**
+   * Return a LinearScorer holding a copy of the weights and biases of the
+   * perceptron, for low-latency classification and top-k label selection.
+   */
+  LinearScorer<arma::Mat<ElemType>> Scorer() const
+  {
+    return LinearScorer<arma::Mat<ElemType>>(weights, biases);
+  }
+
   /**
    * Reset the model, so that the next call to `Train()` will not be
    * incremental.
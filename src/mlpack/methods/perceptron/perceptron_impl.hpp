@@ -283,16 +283,15 @@ template<typename VecType>
 size_t Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Classify(
     const VecType& point) const
 {
-  util::CheckSameDimensionality(point, weights.n_rows, "Perceptron::Classify()",
-      "point");
-
-  arma::Col<ElemType> tempLabelVec;
-  arma::uword maxIndex = 0;
-
-  tempLabelVec = weights.t() * point + biases;
-  maxIndex = tempLabelVec.index_max();
+  // Only build the error message if it is needed, so that nothing is
+  // allocated.
+  if (point.n_rows != weights.n_rows)
+  {
+    util::CheckSameDimensionality(point, weights.n_rows,
+        "Perceptron::Classify()", "point");
+  }
 
-  return size_t(maxIndex);
+  return LinearScorer<arma::Mat<ElemType>>::ArgMax(weights, biases, point);
 }
 
 /**
@@ -315,17 +314,12 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Classify(
   util::CheckSameDimensionality(test, weights.n_rows, "Perceptron::Classify()",
       "points");
 
-  arma::Col<ElemType> tempLabelMat;
-  arma::uword maxIndex = 0;
-  predictedLabels.set_size(test.n_cols);
-
-  // Could probably be faster if done in batch.
-  for (size_t i = 0; i < test.n_cols; ++i)
-  {
-    tempLabelMat = weights.t() * test.col(i) + biases;
-    maxIndex = tempLabelMat.index_max();
-    predictedLabels(i) = maxIndex;
-  }
+  // Score all points at once with one matrix multiplication.
+  arma::Mat<ElemType> scores;
+  LinearScorer<arma::Mat<ElemType>>::ComputeScores(weights, biases, test,
+      scores);
+  predictedLabels = ConvTo<arma::Row<size_t>>::From(
+      arma::index_max(scores, 0));
 }
 
 /**
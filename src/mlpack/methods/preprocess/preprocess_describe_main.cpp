@@ -82,97 +82,6 @@ PARAM_FLAG("row_major", "If specified, the program will calculate statistics "
     "across rows, not across columns.  (Remember that in mlpack, a column "
     "represents a point, so this option is generally not necessary.)", "r");
 
-/**
- * Calculates the sum of deviations to the Nth Power.
- *
- * @param input Vector that captures a dimension of a dataset.
- * @param rowMean Mean of the given vector.
- * @param n Degree of power.
- * @return sum of nth power deviations.
- */
-double SumNthPowerDeviations(const arma::rowvec& input,
-                             const double& fMean,
-                             size_t n)
-{
-  return sum(pow(input - fMean, static_cast<double>(n)));
-}
-
-/**
- * Calculates Skewness of the given vector.
- *
- * @param input Vector that captures a dimension of a dataset
- * @param rowStd Standard Deviation of the given vector.
- * @param rowMean Mean of the given vector.
- * @return Skewness of the given vector.
- */
-double Skewness(const arma::rowvec& input,
-                const double& fStd,
-                const double& fMean,
-                const bool population)
-{
-  double skewness = 0;
-  const double S3 = pow(fStd, 3);
-  const double M3 = SumNthPowerDeviations(input, fMean, 3);
-  const double n = input.n_elem;
-  if (population)
-  {
-    // Calculate population skewness
-    skewness = M3 / (n * S3);
-  }
-  else
-  {
-    // Calculate sample skewness.
-    skewness = n * M3 / ((n - 1) * (n - 2) * S3);
-  }
-  return skewness;
-}
-
-/**
- * Calculates excess kurtosis of the given vector.
- *
- * @param input Vector that captures a dimension of a dataset
- * @param rowStd Standard Deviation of the given vector.
- * @param rowMean Mean of the given vector.
- * @return Kurtosis of the given vector.
- */
-double Kurtosis(const arma::rowvec& input,
-                const double& fStd,
-                const double& fMean,
-                const bool population)
-{
-  double kurtosis = 0;
-  const double M4 = SumNthPowerDeviations(input, fMean, 4);
-  const double n = input.n_elem;
-  if (population)
-  {
-    // Calculate population excess kurtosis.
-    const double M2 = SumNthPowerDeviations(input, fMean, 2);
-    kurtosis = n * (M4 / pow(M2, 2)) - 3;
-  }
-  else
-  {
-    // Calculate sample excess kurtosis.
-    const double S4 = pow(fStd, 4);
-    const double norm3 = (3 * (n - 1) * (n - 1)) / ((n - 2) * (n - 3));
-    const double normC = (n * (n + 1)) / ((n - 1) * (n - 2) * (n - 3));
-    const double normM = M4 / S4;
-    kurtosis = normC * normM - norm3;
-  }
-  return kurtosis;
-}
-
-/**
- * Calculates standard error of standard deviation.
- *
- * @param input Vector that captures a dimension of a dataset
- * @param rowStd Standard Deviation of the given vector.
- * @return Standard error of the stanrdard devation of the given vector.
- */
-double StandardError(const size_t size, const double& fStd)
-{
-  return fStd / sqrt(size);
-}
-
 void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 {
   const size_t dimension = static_cast<size_t>(params.Get<int>("dimension"));
@@ -192,48 +101,50 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
       << "max" << setw(width) << "range" << setw(width)
       << "skew" << setw(width) << "kurt" << setw(width) << "SE" << endl;
 
-  // Lambda function to print out the results.
-  auto PrintStatResults = [&](size_t dim, bool rowMajor)
-  {
-    arma::rowvec feature;
-    if (rowMajor)
-      feature = ConvTo<arma::rowvec>::From(data.col(dim));
-    else
-      feature = data.row(dim);
-
-    // f at the front of the variable names means "feature".
-    const double fMax = max(feature);
-    const double fMin = min(feature);
-    const double fMean = arma::mean(feature);
-    const double fStd = arma::stddev(feature, population);
-
-    // Print statistics of the given dimension.
-    Log::Info << setprecision(precision) << setw(width) << dim <<
-        setw(width) << arma::var(feature, population) <<
-        setw(width) << fMean <<
-        setw(width) << fStd <<
-        setw(width) << arma::median(feature) <<
-        setw(width) << fMin <<
-        setw(width) << fMax <<
-        setw(width) << (fMax - fMin) <<
-        setw(width) << Skewness(feature, fStd, fMean, population) <<
-        setw(width) << Kurtosis(feature, fStd, fMean, population) <<
-        setw(width) << StandardError(feature.n_elem, fStd) << endl;
-  };
-
-  // If the user specified dimension, describe statistics of the given
-  // dimension. If a dimension is not specified, describe all dimensions.
+  // Compute all the moments of the dimensions to describe in a single pass
+  // over the data.
+  ColumnMoments<arma::mat> moments;
+  arma::vec medians;
+  std::vector<size_t> dimensions;
   if (params.Has("dimension"))
   {
-    PrintStatResults(dimension, rowMajor);
+    const arma::rowvec feature = rowMajor ?
+        arma::rowvec(data.col(dimension).t()) :
+        arma::rowvec(data.row(dimension));
+    moments.Add(feature);
+    medians = arma::vec(1).fill(arma::median(feature));
+    dimensions.push_back(dimension);
   }
   else
   {
-    const size_t dimensions = rowMajor ? data.n_cols : data.n_rows;
-    for (size_t i = 0; i < dimensions; ++i)
-    {
-      PrintStatResults(i, rowMajor);
-    }
+    const arma::mat features = rowMajor ? arma::mat(data.t()) : arma::mat();
+    const arma::mat& featureData = rowMajor ? features : data;
+    moments.Add(featureData);
+    medians = arma::median(featureData, 1);
+    for (size_t i = 0; i < featureData.n_rows; ++i)
+      dimensions.push_back(i);
+  }
+
+  const arma::vec fMax = moments.Max();
+  const arma::vec fMin = moments.Min();
+  const arma::vec fVar = moments.Variance(population);
+  const arma::vec fStd = moments.StandardDeviation(population);
+  const arma::vec fSkew = moments.Skewness(population);
+  const arma::vec fKurt = moments.Kurtosis(population);
+  for (size_t i = 0; i < dimensions.size(); ++i)
+  {
+    // Print statistics of the given dimension.
+    Log::Info << setprecision(precision) << setw(width) << dimensions[i] <<
+        setw(width) << fVar[i] <<
+        setw(width) << moments.Mean()[i] <<
+        setw(width) << fStd[i] <<
+        setw(width) << medians[i] <<
+        setw(width) << fMin[i] <<
+        setw(width) << fMax[i] <<
+        setw(width) << (fMax[i] - fMin[i]) <<
+        setw(width) << fSkew[i] <<
+        setw(width) << fKurt[i] <<
+        setw(width) << fStd[i] / sqrt(moments.Count()) << endl;
   }
   timers.Stop("statistics");
 }
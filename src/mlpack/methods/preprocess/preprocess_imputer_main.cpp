@@ -181,28 +181,24 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
       if (strategy == "mean")
       {
         Imputer<double, MapperType, MeanImputation<double>> imputer(info);
-        for (size_t i : dirtyDimensions)
-          imputer.Impute(input, missingValue, i);
+        imputer.Impute(input, missingValue, dirtyDimensions);
       }
       else if (strategy == "median")
       {
         Imputer<double, MapperType, MedianImputation<double>> imputer(info);
-        for (size_t i : dirtyDimensions)
-          imputer.Impute(input, missingValue, i);
+        imputer.Impute(input, missingValue, dirtyDimensions);
       }
       else if (strategy == "listwise_deletion")
       {
         Imputer<double, MapperType, ListwiseDeletion<double>> imputer(info);
-        for (size_t i : dirtyDimensions)
-          imputer.Impute(input, missingValue, i);
+        imputer.Impute(input, missingValue, dirtyDimensions);
       }
       else if (strategy == "custom")
       {
         CustomImputation<double> strat(customValue);
         Imputer<double, MapperType, CustomImputation<double>> imputer(
             info, strat);
-        for (size_t i : dirtyDimensions)
-          imputer.Impute(input, missingValue, i);
+        imputer.Impute(input, missingValue, dirtyDimensions);
       }
       else
       {
@@ -80,10 +80,19 @@ class ScalingModel
   template<typename MatType>
   void Transform(const MatType& input, MatType& output);
 
+  //! Transform to scale features in place.
+  template<typename MatType>
+  void Transform(MatType& data);
+
   // Fit to intialize the scaling parameter.
   template<typename MatType>
   void Fit(const MatType& input);
 
+  // Update the scaling parameter with a batch of points.  If the scaler has not
+  // been fitted yet, it is created.
+  template<typename MatType>
+  void PartialFit(const MatType& input);
+
   // Scale back the dataset to their original values.
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output);
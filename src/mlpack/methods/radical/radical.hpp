@@ -38,6 +38,11 @@ namespace mlpack {
  *   year = {2003}
  * }
  * @endcode
+ *
+ * Each sweep of Apply() visits every pair of dimensions once, in rounds of
+ * disjoint pairs (a round-robin schedule); the pairs of a round are processed
+ * in parallel with OpenMP.  The perturbation noise of each pair comes from its
+ * own random stream, so the results do not depend on the number of threads.
  */
 class Radical
 {
@@ -112,13 +117,14 @@ class Radical
   template<typename MatType>
   void CopyAndPerturb(MatType& xNew, const MatType& x) const;
 
-  //! Two-dimensional version of RADICAL.
+  //! Two-dimensional version of RADICAL.  The candidate angles are evaluated
+  //! in parallel.
   template<typename MatType>
   typename MatType::elem_type Apply2D(
       const MatType& matX,
       const size_t m,
       MatType& perturbed, // auxiliary memory
-      MatType& candidate, // auxiliary memory
+      MatType& candidate, // auxiliary memory (no longer used)
       util::Timers& timers = IO::GetTimers());
 
   //! Get the standard deviation of the additive Gaussian noise.
@@ -151,6 +157,26 @@ class Radical
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  /**
+   * Find the rotation angle (among the candidate angles) that minimizes the
+   * sum of the entropies of the two columns of the given perturbed data.  The
+   * candidate angles are evaluated in parallel, unless this is called from a
+   * parallel region.
+   */
+  template<typename MatType>
+  typename MatType::elem_type BestAngle(const MatType& perturbed,
+                                        const size_t m) const;
+
+  /**
+   * Like CopyAndPerturb(), for the two given columns, with the noise drawn
+   * from the given random stream.
+   */
+  template<typename MatType, typename VecType>
+  void CopyAndPerturb(MatType& xNew,
+                      const VecType& x1,
+                      const VecType& x2,
+                      PhiloxRNG& rng) const;
+
   //! Standard deviation of the Gaussian noise added to the replicates of
   //! the data points during Radical2D.
   double noiseStdDev;
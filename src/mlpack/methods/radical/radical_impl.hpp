@@ -40,6 +40,23 @@ inline void Radical::CopyAndPerturb(MatType& xNew,
       replicates * x.n_rows, x.n_cols);
 }
 
+template<typename MatType, typename VecType>
+inline void Radical::CopyAndPerturb(MatType& xNew,
+                                    const VecType& x1,
+                                    const VecType& x2,
+                                    PhiloxRNG& rng) const
+{
+  const size_t n = x1.n_elem;
+  xNew.set_size(replicates * n, 2);
+  for (size_t r = 0; r < replicates; ++r)
+  {
+    for (size_t i = 0; i < n; ++i)
+      xNew(r * n + i, 0) = x1[i] + noiseStdDev * rng.RandNormal();
+    for (size_t i = 0; i < n; ++i)
+      xNew(r * n + i, 1) = x2[i] + noiseStdDev * rng.RandNormal();
+  }
+}
+
 template<typename VecType>
 inline typename VecType::elem_type Radical::Vasicek(
     VecType& z,
@@ -47,7 +64,10 @@ inline typename VecType::elem_type Radical::Vasicek(
 {
   using ElemType = typename VecType::elem_type;
 
-  z = sort(z);
+  // Sorting in place avoids a copy of z.  (Keeping the order of the previous
+  // candidate angle and updating it does not pay off: between two angles, the
+  // order of a constant fraction of all pairs of points changes.)
+  std::sort(z.begin(), z.end());
 
   // Apparently slower.
   /*
@@ -69,44 +89,53 @@ inline typename VecType::elem_type Radical::Vasicek(
 }
 
 template<typename MatType>
-inline typename MatType::elem_type Radical::Apply2D(const MatType& matX,
-                                                    const size_t m,
-                                                    MatType& perturbed,
-                                                    MatType& candidate,
-                                                    util::Timers& timers)
+inline typename MatType::elem_type Radical::BestAngle(const MatType& perturbed,
+                                                      const size_t m) const
 {
   using VecType = typename GetColType<MatType>::type;
   using ElemType = typename MatType::elem_type;
 
-  timers.Start("radical_copy_and_perturb");
-  CopyAndPerturb(perturbed, matX);
-  timers.Stop("radical_copy_and_perturb");
-
-  typename MatType::template fixed<2, 2> matJacobi;
   VecType values(angles);
 
-  for (size_t i = 0; i < angles; ++i)
+  #pragma omp parallel
   {
-    const ElemType theta = (i / (ElemType) angles) * M_PI / 2.0;
-    const ElemType cosTheta = cos(theta);
-    const ElemType sinTheta = sin(theta);
+    // Each thread projects the data into its own buffers.
+    VecType candidateY1(perturbed.n_rows), candidateY2(perturbed.n_rows);
 
-    matJacobi(0, 0) = cosTheta;
-    matJacobi(1, 0) = -sinTheta;
-    matJacobi(0, 1) = sinTheta;
-    matJacobi(1, 1) = cosTheta;
+    #pragma omp for schedule(static)
+    for (size_t i = 0; i < angles; ++i)
+    {
+      const ElemType theta = (i / (ElemType) angles) * M_PI / 2.0;
+      const ElemType cosTheta = cos(theta);
+      const ElemType sinTheta = sin(theta);
 
-    candidate = perturbed * matJacobi;
-    VecType candidateY1 = candidate.unsafe_col(0);
-    VecType candidateY2 = candidate.unsafe_col(1);
+      // These are the columns of perturbed * [cos sin; -sin cos].
+      candidateY1 = cosTheta * perturbed.col(0) - sinTheta * perturbed.col(1);
+      candidateY2 = sinTheta * perturbed.col(0) + cosTheta * perturbed.col(1);
 
-    values(i) = Vasicek(candidateY1, m) + Vasicek(candidateY2, m);
+      values(i) = Vasicek(candidateY1, m) + Vasicek(candidateY2, m);
+    }
   }
 
   arma::uword indOpt = values.index_min();
   return (indOpt / (ElemType) angles) * M_PI / 2.0;
 }
 
+template<typename MatType>
+inline typename MatType::elem_type Radical::Apply2D(
+    const MatType& matX,
+    const size_t m,
+    MatType& perturbed,
+    MatType& /* candidate */,
+    util::Timers& timers)
+{
+  timers.Start("radical_copy_and_perturb");
+  CopyAndPerturb(perturbed, matX);
+  timers.Stop("radical_copy_and_perturb");
+
+  return BestAngle(perturbed, m);
+}
+
 template<typename MatType>
 inline void Radical::DoRadical(const MatType& matXT,
                                MatType& matY,
@@ -138,13 +167,12 @@ inline void Radical::Apply(const MatType& matXT,
   if (localM < 1)
     localM = floor(std::sqrt((ElemType) matX.n_rows));
 
+  const size_t nDims = matX.n_cols;
+
   // If the number of sweeps was not specified, perform one for each dimension.
   size_t localSweeps = sweeps;
   if (localSweeps < 1)
-    localSweeps = matX.n_rows - 1;
-
-  const size_t nDims = matX.n_cols;
-  const size_t nPoints = matX.n_rows;
+    localSweeps = nDims - 1;
 
   timers.Start("radical_whiten_data");
   MatType matXWhitened;
@@ -153,56 +181,74 @@ inline void Radical::Apply(const MatType& matXT,
   timers.Stop("radical_whiten_data");
   // matY is now the whitened form of matX.
 
-  // These two matrices will be used repeatedly by Radical2D().  We create them
-  // here to avoid repeated allocations.
-  MatType perturbed, candidate;
-
   // In the RADICAL code, they do not copy and perturb initially, although the
   // paper does.  We follow the code as it should match their reported results
   // and likely does a better job bouncing out of local optima.
   // GeneratePerturbedX(X, X);
 
-  // Initialize the unmixing matrix to the whitening matrix.
+  // Initialize the unmixing matrix to the whitening matrix; it accumulates the
+  // rotations applied to matY, so that matY = matX * matW.
   timers.Start("radical_do_radical");
   matW = matWhitening;
 
-  MatType matYSubspace(nPoints, 2);
-
-  MatType matJ = arma::eye<MatType>(nDims, nDims);
+  // Rotate columns i and j of the given matrix by the given angle; this is the
+  // same as multiplying by the Jacobi rotation matrix, but only touches the two
+  // columns.
+  auto rotate = [](MatType& mat, const size_t i, const size_t j,
+                   const ElemType theta)
+  {
+    const ElemType cosTheta = cos(theta);
+    const ElemType sinTheta = sin(theta);
+    for (size_t r = 0; r < mat.n_rows; ++r)
+    {
+      const ElemType a = mat(r, i);
+      const ElemType b = mat(r, j);
+      mat(r, i) = cosTheta * a - sinTheta * b;
+      mat(r, j) = sinTheta * a + cosTheta * b;
+    }
+  };
 
+  // With the circle method, the pairs of dimensions are split into rounds of
+  // disjoint pairs; an odd number of dimensions gets a dummy dimension.
+  const size_t numSlots = nDims + (nDims % 2);
+  std::vector<std::pair<size_t, size_t>> pairs;
   for (size_t sweepNum = 0; sweepNum < localSweeps; sweepNum++)
   {
     Log::Info << "RADICAL: sweep " << sweepNum << "." << std::endl;
 
-    for (size_t i = 0; i < nDims - 1; ++i)
+    // Each pair of dimensions gets its own stream of perturbation noise.
+    const uint64_t key = RandStreamKey();
+    for (size_t round = 0; round + 1 < numSlots; ++round)
     {
-      for (size_t j = i + 1; j < nDims; ++j)
+      pairs.clear();
+      for (size_t k = 0; k < numSlots / 2; ++k)
       {
-        Log::Debug << "RADICAL 2D on dimensions " << i << " and " << j << "."
-            << std::endl;
-
-        matYSubspace.col(0) = matY.col(i);
-        matYSubspace.col(1) = matY.col(j);
-
-        const ElemType thetaOpt = Apply2D(matYSubspace, localM, perturbed,
-            candidate, timers);
+        const size_t a = (k == 0) ? numSlots - 1 :
+            (round + k) % (numSlots - 1);
+        const size_t b = (round + numSlots - 1 - k) % (numSlots - 1);
+        if (a < nDims && b < nDims)
+          pairs.push_back(std::make_pair(std::min(a, b), std::max(a, b)));
+      }
 
-        const ElemType cosThetaOpt = cos(thetaOpt);
-        const ElemType sinThetaOpt = sin(thetaOpt);
+      Log::Debug << "RADICAL 2D on " << pairs.size() << " pairs of dimensions "
+          << "in parallel." << std::endl;
 
-        // Set elements of transformation matrix.
-        matJ(i, i) = cosThetaOpt;
-        matJ(j, i) = -sinThetaOpt;
-        matJ(i, j) = sinThetaOpt;
-        matJ(j, j) = cosThetaOpt;
+      // The pairs of a round are disjoint, so they can be rotated in parallel.
+      // With a single pair, the candidate angles are evaluated in parallel
+      // instead.
+      #pragma omp parallel for schedule(dynamic) if (pairs.size() > 1)
+      for (size_t p = 0; p < pairs.size(); ++p)
+      {
+        const size_t i = pairs[p].first;
+        const size_t j = pairs[p].second;
 
-        matY *= matJ;
+        PhiloxRNG rng(key, i * nDims + j);
+        MatType perturbed;
+        CopyAndPerturb(perturbed, matY.col(i), matY.col(j), rng);
 
-        // Unset elements of transformation matrix, so matJ = eye() again.
-        matJ(i, i) = 1;
-        matJ(j, i) = 0;
-        matJ(i, j) = 0;
-        matJ(j, j) = 1;
+        const ElemType thetaOpt = BestAngle(perturbed, localM);
+        rotate(matY, i, j, thetaOpt);
+        rotate(matW, i, j, thetaOpt);
       }
     }
   }
@@ -43,6 +43,52 @@ void Bootstrap(const MatType& dataset,
     bootstrapWeights = weights.cols(indices);
 }
 
+/**
+ * Draw the indices of a sample of `numSamples` of the `numPoints` points of a
+ * dataset from the given random stream, with replacement (a bootstrap sample)
+ * or without replacement.  The dataset itself does not need to be copied; see
+ * DecisionTree::TrainIndices().
+ *
+ * @param numPoints Number of points in the dataset.
+ * @param numSamples Number of points to sample (at most numPoints if
+ *     `replacement` is false).
+ * @param replacement Whether to sample with replacement.
+ * @param rng Random stream to draw the sample from.
+ * @param indices Vector to store the indices of the sampled points in.
+ */
+inline void SampleIndices(const size_t numPoints,
+                          const size_t numSamples,
+                          const bool replacement,
+                          PhiloxRNG& rng,
+                          arma::uvec& indices)
+{
+  if (numSamples == 0)
+  {
+    indices.clear();
+    return;
+  }
+
+  if (replacement)
+  {
+    indices.set_size(numSamples);
+    for (size_t i = 0; i < numSamples; ++i)
+      indices[i] = rng.RandInt(numPoints);
+    return;
+  }
+
+  if (numSamples > numPoints)
+  {
+    throw std::invalid_argument("SampleIndices(): cannot sample more points "
+        "than the dataset holds without replacement");
+  }
+
+  // Partial Fisher-Yates shuffle; the sample is kept in increasing order.
+  indices = arma::regspace<arma::uvec>(0, numPoints - 1);
+  for (size_t i = 0; i < numSamples; ++i)
+    std::swap(indices[i], indices[i + rng.RandInt(numPoints - i)]);
+  indices = arma::sort(indices.head(numSamples));
+}
+
 } // namespace mlpack
 
 #endif
@@ -0,0 +1,261 @@
+/**
+ * @file methods/random_forest/flat_forest.hpp
+ *
+ * Definition of FlatForest, a compact, flattened representation of trained
+ * DecisionTree and RandomForest models for fast batch inference.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/decision_tree/decision_tree.hpp>
+#include "random_forest.hpp"
+
+namespace mlpack {
+
+/**
+ * A FlatForest is a read-only copy of one or more trained DecisionTrees (for
+ * instance, all the trees of a RandomForest), stored as a single
+ * struct-of-arrays node table instead of a tree of heap-allocated nodes.  For
+ * each node, the table holds the split dimension, the split threshold and the
+ * offset of its children (or of its leaf values); the children of each node
+ * are stored contiguously, in breadth-first order.  The class probabilities of
+ * all leaves are stored in a single matrix.
+ *
+ * Classification of a batch of points is done in blocks of points: each block
+ * is run through every tree before the next block is started, so that the
+ * nodes of each tree and the points of the block stay in cache.  Blocks are
+ * classified in parallel when OpenMP is enabled.  The predictions and
+ * probabilities are exactly the same as those of the original model: for a
+ * RandomForest, the class probabilities of the trees are averaged, and for a
+ * DecisionTree, the probabilities of the leaf are returned.
+ *
+ * The numeric splits of the trees must send a point to the first of two
+ * children if its value is less than or equal to the split value (like
+ * BestBinaryNumericSplit, RandomBinaryNumericSplit and HistogramNumericSplit).
+ * Categorical splits are stored as a table from each category to a child.
+ * Categories that were not seen during training are sent to the first child.
+ *
+ * ```
+ * RandomForest<> rf(data, labels, numClasses, 50);
+ * FlatForest flat(rf);
+ *
+ * arma::Row<size_t> predictions;
+ * arma::mat probabilities;
+ * flat.Classify(testData, predictions, probabilities);
+ * ```
+ *
+ * The FlatForest does not reference the model it was built from, so the model
+ * can be modified or destroyed afterwards.
+ *
+ * A FlatForest can be serialized, which is much more compact (and faster to
+ * load) than serializing the original model: the node tables are stored with
+ * the smallest integer types that hold their values (for instance, 8-bit node
+ * types and 16-bit split dimensions), and leaves with the same class
+ * probabilities share one column of the probability table.  The tables are
+ * loaded straight into the inference layout.  Two lossy options make the
+ * serialized forest even smaller (both are off by default):
+ *
+ *  - SinglePrecision(): store the split values as 32-bit floats.  The points
+ *    whose values are between a split value and its rounded value may be sent
+ *    to the other child by the loaded forest.
+ *  - QuantizeProbabilities(): store the leaf class probabilities as 8-bit
+ *    fractions of 255 (renormalized when they are loaded), so that many more
+ *    leaves share the same probabilities.
+ */
+class FlatForest
+{
+ public:
+  /**
+   * Create an empty FlatForest.  Trees can be added with AddTree().
+   */
+  FlatForest();
+
+  /**
+   * Flatten the given trained decision tree.
+   *
+   * @param tree Trained decision tree.
+   */
+  template<typename FitnessFunction,
+           template<typename> class NumericSplitType,
+           template<typename> class CategoricalSplitType,
+           typename DimensionSelectionType,
+           bool NoRecursion>
+  FlatForest(const DecisionTree<FitnessFunction,
+                                NumericSplitType,
+                                CategoricalSplitType,
+                                DimensionSelectionType,
+                                NoRecursion>& tree);
+
+  /**
+   * Flatten all the trees of the given trained random forest.
+   *
+   * @param forest Trained random forest.
+   */
+  template<typename FitnessFunction,
+           typename DimensionSelectionType,
+           template<typename> class NumericSplitType,
+           template<typename> class CategoricalSplitType,
+           bool UseBootstrap>
+  FlatForest(const RandomForest<FitnessFunction,
+                                DimensionSelectionType,
+                                NumericSplitType,
+                                CategoricalSplitType,
+                                UseBootstrap>& forest);
+
+  /**
+   * Flatten the given trained decision tree and add it to the forest.  A
+   * std::invalid_argument is thrown if the number of classes of the tree does
+   * not match the other trees of the forest, or if the tree contains a numeric
+   * split that is not a binary threshold split.
+   *
+   * @param tree Trained decision tree to add.
+   */
+  template<typename TreeType>
+  void AddTree(const TreeType& tree);
+
+  /**
+   * Classify the given point.  The predicted label is returned.
+   *
+   * @param point Point to classify.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Classify the given point and also return estimates of the probability for
+   * each class in the given vector.
+   *
+   * @param point Point to classify.
+   * @param prediction This will be set to the predicted class of the point.
+   * @param probabilities This will be filled with class probabilities for the
+   *      point.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Classify the given points.  The predicted labels for each point are stored
+   * in the given vector.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions) const;
+
+  /**
+   * Classify the given points and also return estimates of the probabilities
+   * for each class in the given matrix.
+   *
+   * @param data Set of points to classify.
+   * @param predictions This will be filled with predictions for each point.
+   * @param probabilities This will be filled with class probabilities for each
+   *      point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of trees in the forest.
+  size_t NumTrees() const { return roots.size(); }
+  //! Get the total number of nodes (internal nodes and leaves) in the forest.
+  size_t NumNodes() const { return types.size(); }
+  //! Get the number of columns of the leaf probability table (leaves with the
+  //! same probabilities share one column after the forest is loaded).
+  size_t NumLeaves() const { return leafProbabilities.n_cols; }
+  //! Get the number of classes.
+  size_t NumClasses() const { return leafProbabilities.n_rows; }
+
+  //! Get the number of points that are classified together in a block.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of points that are classified together in a block.
+  size_t& BlockSize() { return blockSize; }
+
+  //! Get whether the split values are serialized as 32-bit floats.
+  bool SinglePrecision() const { return singlePrecision; }
+  //! Modify whether the split values are serialized as 32-bit floats.
+  bool& SinglePrecision() { return singlePrecision; }
+
+  //! Get whether the leaf probabilities are serialized as 8-bit values.
+  bool QuantizeProbabilities() const { return quantizeProbabilities; }
+  //! Modify whether the leaf probabilities are serialized as 8-bit values.
+  bool& QuantizeProbabilities() { return quantizeProbabilities; }
+
+  /**
+   * Serialize the forest.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The type of each node.
+  enum NodeType : unsigned char
+  {
+    LEAF = 0,
+    NUMERIC = 1,
+    CATEGORICAL = 2
+  };
+
+  /**
+   * Find the index of the leaf (in leafProbabilities) that the point in column
+   * `col` of `data` falls into, starting from the given root node.
+   */
+  template<typename MatType>
+  size_t FindLeaf(const MatType& data, const size_t col, size_t node) const;
+
+  /**
+   * Serialize the given indices with the smallest unsigned integer type that
+   * holds all of them.
+   */
+  template<typename Archive>
+  static void SerializeIndices(Archive& ar,
+                               const char* name,
+                               std::vector<size_t>& indices);
+
+  //! Serialize the given indices as values of type T.
+  template<typename T, typename Archive>
+  static void SerializeIndicesAs(Archive& ar,
+                                 const char* name,
+                                 std::vector<size_t>& indices);
+
+  //! Index of the root node of each tree.
+  std::vector<size_t> roots;
+  //! Type of each node.
+  std::vector<NodeType> types;
+  //! Split dimension of each internal node.
+  std::vector<size_t> dimensions;
+  //! Split value of each numeric node, or number of categories of each
+  //! categorical node.
+  std::vector<double> thresholds;
+  //! For numeric nodes, the index of the first child; for categorical nodes,
+  //! the offset of the node's children in categoryChildren; for leaves, the
+  //! index of the leaf's column in leafProbabilities.
+  std::vector<size_t> offsets;
+  //! The child node of each category of each categorical node.
+  std::vector<size_t> categoryChildren;
+  //! The class probabilities of each leaf (one column per leaf).
+  arma::mat leafProbabilities;
+  //! The number of points classified together in a block.
+  size_t blockSize;
+  //! Whether the split values are serialized as 32-bit floats.
+  bool singlePrecision;
+  //! Whether the leaf probabilities are serialized as 8-bit values.
+  bool quantizeProbabilities;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "flat_forest_impl.hpp"
+
+#endif
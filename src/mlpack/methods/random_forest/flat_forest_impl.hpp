@@ -0,0 +1,421 @@
+/**
+ * @file methods/random_forest/flat_forest_impl.hpp
+ *
+ * Implementation of FlatForest.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_IMPL_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "flat_forest.hpp"
+
+namespace mlpack {
+
+inline FlatForest::FlatForest() :
+    blockSize(64),
+    singlePrecision(false),
+    quantizeProbabilities(false)
+{
+  // Nothing to do.
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+FlatForest::FlatForest(const DecisionTree<FitnessFunction,
+                                          NumericSplitType,
+                                          CategoricalSplitType,
+                                          DimensionSelectionType,
+                                          NoRecursion>& tree) :
+    blockSize(64),
+    singlePrecision(false),
+    quantizeProbabilities(false)
+{
+  AddTree(tree);
+}
+
+template<typename FitnessFunction,
+         typename DimensionSelectionType,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         bool UseBootstrap>
+FlatForest::FlatForest(const RandomForest<FitnessFunction,
+                                          DimensionSelectionType,
+                                          NumericSplitType,
+                                          CategoricalSplitType,
+                                          UseBootstrap>& forest) :
+    blockSize(64),
+    singlePrecision(false),
+    quantizeProbabilities(false)
+{
+  for (size_t i = 0; i < forest.NumTrees(); ++i)
+    AddTree(forest.Tree(i));
+}
+
+template<typename TreeType>
+void FlatForest::AddTree(const TreeType& tree)
+{
+  const size_t numClasses = tree.NumClasses();
+  if (roots.size() > 0 && numClasses != leafProbabilities.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "FlatForest::AddTree(): tree has " << numClasses << " classes, but "
+        << "the forest has " << leafProbabilities.n_rows << " classes!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The nodes of the new tree are stored after all the existing nodes, in
+  // breadth-first order, so that the children of each node are contiguous.
+  // Build the tables of the new tree separately first, so that nothing is
+  // modified if the tree cannot be flattened.
+  const size_t nodeBase = types.size();
+  const size_t categoryBase = categoryChildren.size();
+  const size_t leafBase = leafProbabilities.n_cols;
+
+  std::vector<const TreeType*> queue;
+  std::vector<NodeType> newTypes;
+  std::vector<size_t> newDimensions, newOffsets, newCategoryChildren;
+  std::vector<double> newThresholds;
+  std::vector<const TreeType*> leaves;
+
+  queue.push_back(&tree);
+  for (size_t head = 0; head < queue.size(); ++head)
+  {
+    const TreeType& node = *queue[head];
+    if (node.NumChildren() == 0)
+    {
+      newTypes.push_back(LEAF);
+      newDimensions.push_back(0);
+      newThresholds.push_back(0.0);
+      newOffsets.push_back(leafBase + leaves.size());
+      leaves.push_back(&node);
+      continue;
+    }
+
+    const size_t firstChild = nodeBase + queue.size();
+    for (size_t c = 0; c < node.NumChildren(); ++c)
+      queue.push_back(&node.Child(c));
+
+    newDimensions.push_back(node.SplitDimension());
+    if (node.SplitDimensionType() == data::Datatype::categorical)
+    {
+      // Tabulate the child of every category seen during training.  Depending
+      // on the split type, the number of categories is either the number of
+      // children or the size of the split information.
+      const size_t numCategories = std::max(node.NumChildren(),
+          (size_t) node.ClassProbabilities().n_elem);
+      newTypes.push_back(CATEGORICAL);
+      newThresholds.push_back((double) numCategories);
+      newOffsets.push_back(categoryBase + newCategoryChildren.size());
+      for (size_t c = 0; c < numCategories; ++c)
+      {
+        const size_t direction = TreeType::CategoricalSplit::CalculateDirection(
+            (double) c, node.ClassProbabilities(), node);
+        newCategoryChildren.push_back(firstChild +
+            ((direction < node.NumChildren()) ? direction : 0));
+      }
+    }
+    else
+    {
+      if (node.NumChildren() != 2 || node.ClassProbabilities().n_elem != 1)
+      {
+        throw std::invalid_argument("FlatForest::AddTree(): only binary "
+            "threshold splits are supported for numeric dimensions!");
+      }
+
+      newTypes.push_back(NUMERIC);
+      newThresholds.push_back(node.ClassProbabilities()[0]);
+      newOffsets.push_back(firstChild);
+    }
+  }
+
+  // Now append everything.
+  arma::mat newLeaves(numClasses, leaves.size());
+  for (size_t i = 0; i < leaves.size(); ++i)
+    newLeaves.col(i) = leaves[i]->ClassProbabilities();
+
+  roots.push_back(nodeBase);
+  types.insert(types.end(), newTypes.begin(), newTypes.end());
+  dimensions.insert(dimensions.end(), newDimensions.begin(),
+      newDimensions.end());
+  thresholds.insert(thresholds.end(), newThresholds.begin(),
+      newThresholds.end());
+  offsets.insert(offsets.end(), newOffsets.begin(), newOffsets.end());
+  categoryChildren.insert(categoryChildren.end(), newCategoryChildren.begin(),
+      newCategoryChildren.end());
+  if (leafProbabilities.n_cols == 0)
+    leafProbabilities = std::move(newLeaves);
+  else
+    leafProbabilities = arma::join_rows(leafProbabilities, newLeaves);
+}
+
+template<typename VecType>
+size_t FlatForest::Classify(const VecType& point) const
+{
+  size_t prediction;
+  arma::vec probabilities;
+  Classify(point, prediction, probabilities);
+  return prediction;
+}
+
+template<typename VecType>
+void FlatForest::Classify(const VecType& point,
+                          size_t& prediction,
+                          arma::vec& probabilities) const
+{
+  if (roots.size() == 0)
+  {
+    probabilities.clear();
+    prediction = 0;
+    throw std::invalid_argument("FlatForest::Classify(): no trees in the "
+        "forest!");
+  }
+
+  probabilities.zeros(leafProbabilities.n_rows);
+  for (size_t t = 0; t < roots.size(); ++t)
+    probabilities += leafProbabilities.col(FindLeaf(point, 0, roots[t]));
+
+  probabilities /= roots.size();
+  prediction = (size_t) probabilities.index_max();
+}
+
+template<typename MatType>
+void FlatForest::Classify(const MatType& data,
+                          arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename MatType>
+void FlatForest::Classify(const MatType& data,
+                          arma::Row<size_t>& predictions,
+                          arma::mat& probabilities) const
+{
+  if (roots.size() == 0)
+  {
+    predictions.clear();
+    probabilities.clear();
+    throw std::invalid_argument("FlatForest::Classify(): no trees in the "
+        "forest!");
+  }
+
+  const size_t numClasses = leafProbabilities.n_rows;
+  probabilities.zeros(numClasses, data.n_cols);
+  predictions.set_size(data.n_cols);
+
+  const size_t block = std::max(blockSize, (size_t) 1);
+  const size_t numBlocks = (data.n_cols + block - 1) / block;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * block;
+    const size_t end = std::min(begin + block, (size_t) data.n_cols);
+
+    // Run the whole block through each tree before moving to the next tree.
+    for (size_t t = 0; t < roots.size(); ++t)
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        const double* leaf = leafProbabilities.colptr(
+            FindLeaf(data, i, roots[t]));
+        double* out = probabilities.colptr(i);
+        for (size_t k = 0; k < numClasses; ++k)
+          out[k] += leaf[k];
+      }
+    }
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      probabilities.col(i) /= roots.size();
+      predictions[i] = (size_t) probabilities.col(i).index_max();
+    }
+  }
+}
+
+template<typename MatType>
+size_t FlatForest::FindLeaf(const MatType& data,
+                            const size_t col,
+                            size_t node) const
+{
+  while (types[node] != LEAF)
+  {
+    const double value = (double) data(dimensions[node], col);
+    if (types[node] == NUMERIC)
+    {
+      node = offsets[node] + ((value <= thresholds[node]) ? 0 : 1);
+    }
+    else
+    {
+      // Unknown categories go to the first child.
+      const size_t category = (value >= 0.0 && value < thresholds[node]) ?
+          (size_t) value : 0;
+      node = categoryChildren[offsets[node] + category];
+    }
+  }
+
+  return offsets[node];
+}
+
+template<typename Archive>
+void FlatForest::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(blockSize));
+  ar(CEREAL_NVP(singlePrecision));
+  ar(CEREAL_NVP(quantizeProbabilities));
+
+  size_t numClasses = leafProbabilities.n_rows;
+  ar(CEREAL_NVP(numClasses));
+  SerializeIndices(ar, "roots", roots);
+  SerializeIndices(ar, "dimensions", dimensions);
+  SerializeIndices(ar, "categoryChildren", categoryChildren);
+
+  std::vector<uint8_t> nodeTypes;
+  std::vector<float> floatThresholds;
+  std::vector<double> doubleThresholds;
+  std::vector<size_t> nodeOffsets;
+  std::vector<uint8_t> quantizedLeaves;
+  std::vector<double> leaves;
+  if (cereal::is_saving<Archive>())
+  {
+    nodeTypes.assign(types.begin(), types.end());
+    if (singlePrecision)
+      floatThresholds.assign(thresholds.begin(), thresholds.end());
+    else
+      doubleThresholds = thresholds;
+
+    // Store each distinct leaf (after quantization) only once, and point the
+    // leaves to their distinct leaf.
+    std::map<std::vector<double>, size_t> leafIndices;
+    std::vector<size_t> leafMap(leafProbabilities.n_cols);
+    std::vector<double> leaf(numClasses);
+    for (size_t l = 0; l < leafProbabilities.n_cols; ++l)
+    {
+      for (size_t k = 0; k < numClasses; ++k)
+      {
+        leaf[k] = quantizeProbabilities ?
+            std::round(leafProbabilities(k, l) * 255.0) :
+            leafProbabilities(k, l);
+      }
+
+      const size_t numDistinct = leafIndices.size();
+      const auto result = leafIndices.insert(std::make_pair(leaf,
+          numDistinct));
+      leafMap[l] = result.first->second;
+      if (!result.second)
+        continue;
+
+      // This is a new distinct leaf.
+      for (size_t k = 0; k < numClasses; ++k)
+      {
+        if (quantizeProbabilities)
+          quantizedLeaves.push_back((uint8_t) leaf[k]);
+        else
+          leaves.push_back(leaf[k]);
+      }
+    }
+
+    nodeOffsets = offsets;
+    for (size_t n = 0; n < types.size(); ++n)
+      if (types[n] == LEAF)
+        nodeOffsets[n] = leafMap[offsets[n]];
+  }
+
+  ar(CEREAL_NVP(nodeTypes));
+  if (singlePrecision)
+    ar(CEREAL_NVP(floatThresholds));
+  else
+    ar(CEREAL_NVP(doubleThresholds));
+  SerializeIndices(ar, "offsets", nodeOffsets);
+  if (quantizeProbabilities)
+    ar(CEREAL_NVP(quantizedLeaves));
+  else
+    ar(CEREAL_NVP(leaves));
+
+  if (cereal::is_loading<Archive>())
+  {
+    types.resize(nodeTypes.size());
+    for (size_t n = 0; n < nodeTypes.size(); ++n)
+      types[n] = (NodeType) nodeTypes[n];
+
+    if (singlePrecision)
+      thresholds.assign(floatThresholds.begin(), floatThresholds.end());
+    else
+      thresholds = std::move(doubleThresholds);
+
+    offsets = std::move(nodeOffsets);
+
+    if (quantizeProbabilities)
+    {
+      const size_t numLeaves = (numClasses == 0) ? 0 :
+          quantizedLeaves.size() / numClasses;
+      leafProbabilities.set_size(numClasses, numLeaves);
+      for (size_t i = 0; i < quantizedLeaves.size(); ++i)
+        leafProbabilities[i] = (double) quantizedLeaves[i];
+
+      // Make each column sum to one again.
+      for (size_t l = 0; l < numLeaves; ++l)
+      {
+        const double sum = arma::accu(leafProbabilities.col(l));
+        if (sum > 0.0)
+          leafProbabilities.col(l) /= sum;
+      }
+    }
+    else
+    {
+      const size_t numLeaves = (numClasses == 0) ? 0 :
+          leaves.size() / numClasses;
+      leafProbabilities = arma::mat(leaves.data(), numClasses, numLeaves);
+    }
+  }
+}
+
+template<typename Archive>
+void FlatForest::SerializeIndices(Archive& ar,
+                                  const char* name,
+                                  std::vector<size_t>& indices)
+{
+  uint8_t bytes = 0;
+  if (cereal::is_saving<Archive>())
+  {
+    const size_t maxIndex = indices.empty() ? 0 :
+        *std::max_element(indices.begin(), indices.end());
+    bytes = (maxIndex <= std::numeric_limits<uint16_t>::max()) ? 2 :
+        (maxIndex <= std::numeric_limits<uint32_t>::max()) ? 4 : 8;
+  }
+
+  ar(cereal::make_nvp((std::string(name) + "Bytes").c_str(), bytes));
+  if (bytes == 2)
+    SerializeIndicesAs<uint16_t>(ar, name, indices);
+  else if (bytes == 4)
+    SerializeIndicesAs<uint32_t>(ar, name, indices);
+  else
+    SerializeIndicesAs<uint64_t>(ar, name, indices);
+}
+
+template<typename T, typename Archive>
+void FlatForest::SerializeIndicesAs(Archive& ar,
+                                    const char* name,
+                                    std::vector<size_t>& indices)
+{
+  std::vector<T> values;
+  if (cereal::is_saving<Archive>())
+    values.assign(indices.begin(), indices.end());
+
+  ar(cereal::make_nvp(name, values));
+
+  if (cereal::is_loading<Archive>())
+    indices.assign(values.begin(), values.end());
+}
+
+} // namespace mlpack
+
+#endif
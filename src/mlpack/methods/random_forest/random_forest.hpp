@@ -330,6 +330,11 @@ class RandomForest
    * Predict the classes of each point in the given dataset.  If the random
    * forest has not been trained, this will throw an exception.
    *
+   * Points are classified in tiles of points, each of which is run through
+   * every tree before the next tile is started; tiles are classified in
+   * parallel when OpenMP is enabled.  If there are too few points to give
+   * every thread a tile, the trees are searched in parallel instead.
+   *
    * @param data Dataset to be classified.
    * @param predictions Output predictions for each point in the dataset.
    */
@@ -351,6 +356,60 @@ class RandomForest
                 arma::Row<size_t>& predictions,
                 arma::mat& probabilities) const;
 
+  /**
+   * Classify each point of the training set with the trees whose sample did
+   * not contain it (its out-of-bag trees), giving an estimate of the
+   * generalization of the forest without a separate test set.  The points
+   * that are in the sample of every tree get the prediction `NumClasses()` of
+   * the trees and zero probabilities.  The points are classified in parallel
+   * when OpenMP is enabled.
+   *
+   * The samples of the trees are only known after Train() (not after loading
+   * the forest), and `data` must be the dataset given to Train(); otherwise,
+   * a std::invalid_argument is thrown.
+   *
+   * @param data Training dataset of the forest.
+   * @param predictions Output out-of-bag predictions for each point.
+   * @param probabilities Output out-of-bag class probabilities of each point.
+   */
+  template<typename MatType>
+  void OutOfBagClassify(const MatType& data,
+                        arma::Row<size_t>& predictions,
+                        arma::mat& probabilities) const;
+
+  /**
+   * Compute the out-of-bag error of the forest: the fraction of the training
+   * points (among those that have out-of-bag trees) that are misclassified by
+   * their out-of-bag trees.  See OutOfBagClassify().
+   *
+   * @param data Training dataset of the forest.
+   * @param labels Training labels of the forest.
+   * @return The out-of-bag error, in [0, 1].
+   */
+  template<typename MatType>
+  double OutOfBagError(const MatType& data,
+                       const arma::Row<size_t>& labels) const;
+
+  /**
+   * Compute the permutation importance of each dimension: the increase of the
+   * out-of-bag error when the values of that dimension are randomly permuted
+   * among the training points, which breaks their relationship with the
+   * labels.  The dataset is not copied: each thread classifies one point at a
+   * time from a scratch copy of it, with the value of the permuted dimension
+   * replaced.  See OutOfBagClassify().
+   *
+   * @param data Training dataset of the forest.
+   * @param labels Training labels of the forest.
+   * @param importances Output importance of each dimension.
+   * @param numRepeats Number of permutations whose results are averaged for
+   *     each dimension.
+   */
+  template<typename MatType>
+  void PermutationImportance(const MatType& data,
+                             const arma::Row<size_t>& labels,
+                             arma::vec& importances,
+                             const size_t numRepeats = 1) const;
+
   //! Access a tree in the forest.
   const DecisionTreeType& Tree(const size_t i) const { return trees[i]; }
   //! Modify a tree in the forest (be careful!).
@@ -359,6 +418,42 @@ class RandomForest
   //! Get the number of trees in the forest.
   size_t NumTrees() const { return trees.size(); }
 
+  /**
+   * Return the memory used by the forest: the nodes of all its trees
+   * ("trees/nodes", and so on, summed over the trees; see
+   * DecisionTree::MemoryUsage()), and the samples of the trees kept for
+   * out-of-bag evaluation.
+   */
+  MemoryReport MemoryUsage() const;
+
+  //! Get the fraction of the points of the dataset that each tree is trained
+  //! on (1 by default).
+  double SampleFraction() const { return sampleFraction; }
+  //! Modify the fraction of the points of the dataset that each tree is
+  //! trained on, for the next calls to Train().  The points are sampled with
+  //! replacement if UseBootstrap is true (the fraction may then be larger than
+  //! 1), and without replacement otherwise.
+  double& SampleFraction() { return sampleFraction; }
+
+  //! Get the fraction of the dimensions of the dataset that each tree may split
+  //! on (1 by default).
+  double DimensionFraction() const { return dimensionFraction; }
+  //! Modify the fraction of the dimensions of the dataset that each tree may
+  //! split on, for the next calls to Train().  The dimensions of each tree are
+  //! sampled without replacement, and the DimensionSelectionType then selects
+  //! among them at each node.
+  double& DimensionFraction() { return dimensionFraction; }
+
+  //! Get whether the trees sort each dimension once for the whole tree (false
+  //! by default).
+  bool Presort() const { return presort; }
+  //! Modify whether the trees sort each dimension once for the whole tree,
+  //! instead of at every node, for the next calls to Train().  This is faster
+  //! for large datasets, but needs one index per point and dimension for each
+  //! tree being trained, and only applies to numeric dimensions with a split
+  //! type that supports it (see DecisionTree::TrainIndices()).
+  bool& Presort() { return presort; }
+
   /**
    * Serialize the random forest.
    */
@@ -401,11 +496,63 @@ class RandomForest
                DimensionSelectionType& dimensionSelector,
                const bool warmStart = false);
 
+  /**
+   * Classify the given points, storing the predictions and (if
+   * StoreProbabilities is true) the class probabilities of each point.  The
+   * forest must have at least one tree.
+   */
+  template<bool StoreProbabilities, typename MatType>
+  void ClassifyBatch(const MatType& data,
+                     arma::Row<size_t>& predictions,
+                     arma::mat& probabilities) const;
+
+  /**
+   * Return the class probabilities held by the leaf of the given tree that the
+   * given point falls into.
+   */
+  template<typename VecType>
+  static const arma::vec& LeafProbabilities(const DecisionTreeType& tree,
+                                            const VecType& point);
+
+  /**
+   * Sum the class probabilities of the out-of-bag trees of the training point
+   * with the given index into `probabilities` (which must be zero), and return
+   * the number of such trees.
+   */
+  template<typename VecType>
+  size_t OutOfBagProbabilities(const VecType& point,
+                               const size_t index,
+                               arma::vec& probabilities) const;
+
+  /**
+   * Throw a std::invalid_argument if the out-of-bag trees of the given
+   * training set are not known.
+   */
+  void CheckOutOfBag(const size_t numPoints,
+                     const size_t numLabels,
+                     const std::string& function) const;
+
+  //! The number of points classified together by ClassifyBatch().
+  static constexpr size_t tileSize = 64;
+
   //! The trees in the forest.
   std::vector<DecisionTreeType> trees;
 
+  //! For each tree, whether each point of the training set is in its sample
+  //! (not serialized).
+  std::vector<std::vector<bool>> inBag;
+
   //! The average gain of the forest.
   double avgGain;
+
+  //! The fraction of the points that each tree is trained on.
+  double sampleFraction;
+
+  //! The fraction of the dimensions that each tree may split on.
+  double dimensionFraction;
+
+  //! Whether the trees sort each dimension once for the whole tree.
+  bool presort;
 };
 
 /**
@@ -17,6 +17,31 @@
 
 namespace mlpack {
 
+HAS_MEM_FUNC(SetStream, HasSetStreamCheck);
+
+//! Give the dimension selector of a tree its own random stream, if it draws
+//! random dimensions.
+template<typename DimensionSelectionType>
+void SetDimensionSelectorStream(
+    DimensionSelectionType& dimensionSelector,
+    const PhiloxRNG& rng,
+    const std::enable_if_t<HasSetStreamCheck<DimensionSelectionType,
+        void(DimensionSelectionType::*)(const PhiloxRNG&)>::value>* = 0)
+{
+  dimensionSelector.SetStream(rng);
+}
+
+//! The dimension selector does not draw random dimensions from a stream.
+template<typename DimensionSelectionType>
+void SetDimensionSelectorStream(
+    DimensionSelectionType& /* dimensionSelector */,
+    const PhiloxRNG& /* rng */,
+    const std::enable_if_t<!HasSetStreamCheck<DimensionSelectionType,
+        void(DimensionSelectionType::*)(const PhiloxRNG&)>::value>* = 0)
+{
+  // Nothing to do.
+}
+
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
@@ -31,7 +56,10 @@ RandomForest<
     CategoricalSplitType,
     UseBootstrap
 >::RandomForest() :
-    avgGain(0.0)
+    avgGain(0.0),
+    sampleFraction(1.0),
+    dimensionFraction(1.0),
+    presort(false)
 {
   // Nothing to do here.
 }
@@ -58,7 +86,10 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector) :
-    avgGain(0.0)
+    avgGain(0.0),
+    sampleFraction(1.0),
+    dimensionFraction(1.0),
+    presort(false)
 {
   // Pass off work to the Train() method.
   data::DatasetInfo info; // Ignored.
@@ -91,7 +122,10 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector):
-                    avgGain(0.0)
+                    avgGain(0.0),
+    sampleFraction(1.0),
+    dimensionFraction(1.0),
+    presort(false)
 {
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
@@ -123,7 +157,10 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector) :
-    avgGain(0.0)
+    avgGain(0.0),
+    sampleFraction(1.0),
+    dimensionFraction(1.0),
+    presort(false)
 {
   // Pass off work to the Train() method.
   data::DatasetInfo info; // Ignored by Train().
@@ -156,7 +193,10 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector) :
-    avgGain(0.0)
+    avgGain(0.0),
+    sampleFraction(1.0),
+    dimensionFraction(1.0),
+    presort(false)
 {
   // Pass off work to the Train() method.
   Train<true, true>(dataset, datasetInfo, labels, numClasses, weights,
@@ -346,13 +386,7 @@ void RandomForest<
 
   probabilities.zeros(trees[0].NumClasses());
   for (size_t i = 0; i < trees.size(); ++i)
-  {
-    arma::vec treeProbs;
-    size_t treePrediction; // Ignored.
-    trees[i].Classify(point, treePrediction, treeProbs);
-
-    probabilities += treeProbs;
-  }
+    probabilities += LeafProbabilities(trees[i], point);
 
   // Find maximum element after renormalizing probabilities.
   probabilities /= trees.size();
@@ -388,13 +422,8 @@ void RandomForest<
         "trained!");
   }
 
-  predictions.set_size(data.n_cols);
-
-  #pragma omp parallel for
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    predictions[i] = Classify(data.col(i));
-  }
+  arma::mat probabilities; // Not used.
+  ClassifyBatch<false>(data, predictions, probabilities);
 }
 
 template<
@@ -425,14 +454,186 @@ void RandomForest<
         "trained!");
   }
 
-  probabilities.set_size(trees[0].NumClasses(), data.n_cols);
+  ClassifyBatch<true>(data, predictions, probabilities);
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<typename MatType>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::OutOfBagClassify(const MatType& data,
+                    arma::Row<size_t>& predictions,
+                    arma::mat& probabilities) const
+{
+  CheckOutOfBag(data.n_cols, data.n_cols, "OutOfBagClassify");
+
+  const size_t numClasses = trees[0].NumClasses();
   predictions.set_size(data.n_cols);
-  #pragma omp parallel for
+  probabilities.zeros(numClasses, data.n_cols);
+
+  #pragma omp parallel
+  {
+    arma::vec probs(numClasses);
+
+    #pragma omp for schedule(static)
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      probs.zeros();
+      const size_t numOutOfBag = OutOfBagProbabilities(data.col(i), i, probs);
+      if (numOutOfBag == 0)
+      {
+        predictions[i] = numClasses;
+        continue;
+      }
+
+      probs /= numOutOfBag;
+      predictions[i] = (size_t) probs.index_max();
+      probabilities.col(i) = probs;
+    }
+  }
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<typename MatType>
+double RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::OutOfBagError(const MatType& data,
+                 const arma::Row<size_t>& labels) const
+{
+  CheckOutOfBag(data.n_cols, labels.n_elem, "OutOfBagError");
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  OutOfBagClassify(data, predictions, probabilities);
+
+  const size_t numClasses = trees[0].NumClasses();
+  const size_t numPredicted = arma::accu(predictions != numClasses);
+  if (numPredicted == 0)
+  {
+    throw std::invalid_argument("RandomForest::OutOfBagError(): every point "
+        "is in the sample of every tree");
+  }
+
+  const size_t numWrong = arma::accu((predictions != numClasses) %
+      (predictions != labels));
+  return double(numWrong) / double(numPredicted);
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<typename MatType>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::PermutationImportance(const MatType& data,
+                         const arma::Row<size_t>& labels,
+                         arma::vec& importances,
+                         const size_t numRepeats) const
+{
+  using ElemType = typename MatType::elem_type;
+
+  CheckOutOfBag(data.n_cols, labels.n_elem, "PermutationImportance");
+  if (numRepeats == 0)
+  {
+    throw std::invalid_argument("RandomForest::PermutationImportance(): the "
+        "number of repeats must be positive");
+  }
+
+  // Count the out-of-bag classifications that are correct, when the values of
+  // the given dimension of the points are taken from the permuted points (or
+  // are unchanged, if the dimension is data.n_rows).
+  const size_t numClasses = trees[0].NumClasses();
+  auto countCorrect = [&](const size_t dim, const arma::uvec& permutation)
+  {
+    size_t correct = 0;
+    #pragma omp parallel reduction(+:correct)
+    {
+      // The scratch copy of the current point, and its probabilities.
+      arma::Col<ElemType> point(data.n_rows);
+      arma::vec probs(numClasses);
+
+      #pragma omp for schedule(static)
+      for (size_t i = 0; i < data.n_cols; ++i)
+      {
+        point = data.col(i);
+        if (dim < data.n_rows)
+          point[dim] = data(dim, permutation[i]);
+
+        probs.zeros();
+        if (OutOfBagProbabilities(point, i, probs) > 0 &&
+            (size_t) probs.index_max() == labels[i])
+        {
+          ++correct;
+        }
+      }
+    }
+
+    return correct;
+  };
+
+  const arma::uvec noPermutation; // Not used.
+  const size_t baseCorrect = countCorrect(data.n_rows, noPermutation);
+
+  // The errors are relative to the points that have out-of-bag trees.
+  size_t numPredicted = 0;
   for (size_t i = 0; i < data.n_cols; ++i)
   {
-    arma::vec probs = probabilities.unsafe_col(i);
-    Classify(data.col(i), predictions[i], probs);
+    for (size_t t = 0; t < trees.size(); ++t)
+    {
+      if (!inBag[t][i])
+      {
+        ++numPredicted;
+        break;
+      }
+    }
+  }
+
+  if (numPredicted == 0)
+  {
+    throw std::invalid_argument("RandomForest::PermutationImportance(): "
+        "every point is in the sample of every tree");
   }
+
+  importances.zeros(data.n_rows);
+  for (size_t d = 0; d < data.n_rows; ++d)
+  {
+    for (size_t r = 0; r < numRepeats; ++r)
+    {
+      const arma::uvec permutation = arma::randperm<arma::uvec>(data.n_cols);
+      importances[d] += double(baseCorrect) -
+          double(countCorrect(d, permutation));
+    }
+  }
+
+  importances /= double(numRepeats) * double(numPredicted);
 }
 
 template<
@@ -453,7 +654,10 @@ void RandomForest<
 {
   size_t numTrees;
   if (cereal::is_loading<Archive>())
+  {
     trees.clear();
+    inBag.clear();
+  }
   else
     numTrees = trees.size();
 
@@ -493,18 +697,46 @@ double RandomForest<
          DimensionSelectionType& dimensionSelector,
          const bool warmStart)
 {
+  if (sampleFraction <= 0.0 || (sampleFraction > 1.0 && !UseBootstrap))
+  {
+    throw std::invalid_argument("RandomForest::Train(): the sample fraction "
+        "must be in (0, 1] (or positive, with bootstrap sampling)");
+  }
+
+  if (dimensionFraction <= 0.0 || dimensionFraction > 1.0)
+  {
+    throw std::invalid_argument("RandomForest::Train(): the dimension "
+        "fraction must be in (0, 1]");
+  }
+
   // Reset the forest if we are not doing a warm-start.
   if (!warmStart)
+  {
     trees.clear();
+    inBag.clear();
+  }
   const size_t oldNumTrees = trees.size();
   trees.resize(trees.size() + numTrees);
+  inBag.resize(trees.size());
 
   // Convert avgGain to total gain.
   double totalGain = avgGain * oldNumTrees;
 
-  // Train each tree individually.
-  #pragma omp parallel for reduction( + : totalGain)
-  for (size_t i = 0; i < numTrees; ++i)
+  // The number of points and dimensions given to each tree.
+  const size_t numSamples = std::max((size_t) 1,
+      (size_t) std::round(sampleFraction * dataset.n_cols));
+  const size_t numDimensions = std::max((size_t) 1,
+      (size_t) std::round(dimensionFraction * dataset.n_rows));
+
+  // Train each tree individually, on a sample of the points given by their
+  // indices, so that the dataset is never copied.  Each tree draws its sample
+  // and its dimensions from its own random streams, so the forest does not
+  // depend on the number of threads.  Each tree is a task of ParallelTasks(),
+  // so the tasks of the trees themselves run on the same threads.
+  const uint64_t sampleKey = RandStreamKey();
+  const uint64_t dimensionKey = RandStreamKey();
+  std::vector<double> gains(numTrees);
+  ParallelTasks(numTrees, [&](const size_t i)
   {
     // NOTE: this is a hacky workaround for older versions of Armadillo that did
     // not (by default) set a different seed for each RNG.  We simply manually
@@ -524,65 +756,301 @@ double RandomForest<
       #endif
     #endif
 
-    MatType bootstrapDataset;
-    arma::Row<size_t> bootstrapLabels;
-    arma::rowvec bootstrapWeights;
-    if (UseBootstrap)
+    PhiloxRNG rng(sampleKey, i);
+    arma::uvec indices;
+    if (UseBootstrap || numSamples < dataset.n_cols)
     {
-      Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
-          bootstrapLabels, bootstrapWeights);
+      SampleIndices(dataset.n_cols, numSamples, UseBootstrap, rng, indices);
     }
+    else
+    {
+      indices = arma::regspace<arma::uvec>(0, dataset.n_cols - 1);
+    }
+
+    // Remember the sample of the tree, for the out-of-bag predictions.
+    std::vector<bool>& treeInBag = inBag[oldNumTrees + i];
+    treeInBag.assign(dataset.n_cols, false);
+    for (size_t j = 0; j < indices.n_elem; ++j)
+      treeInBag[indices[j]] = true;
 
-    if (UseWeights)
+    // The dimensions the tree may split on (all of them if empty).
+    arma::uvec dimensions;
+    if (numDimensions < dataset.n_rows)
+      SampleIndices(dataset.n_rows, numDimensions, false, rng, dimensions);
+
+    DimensionSelectionType treeSelector(dimensionSelector);
+    SetDimensionSelectorStream(treeSelector, PhiloxRNG(dimensionKey, i));
+
+    DecisionTreeType& tree = trees[oldNumTrees + i];
+    if (UseWeights && UseDatasetInfo)
     {
-      if (UseDatasetInfo)
-      {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, datasetInfo,
-                bootstrapLabels, numClasses, bootstrapWeights, minimumLeafSize,
-                minimumGainSplit, maximumDepth, dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
-                numClasses, weights, minimumLeafSize, minimumGainSplit,
-                maximumDepth, dimensionSelector);
-      }
-      else
-      {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, bootstrapLabels,
-                numClasses, bootstrapWeights, minimumLeafSize,
-                minimumGainSplit, maximumDepth, dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, labels, numClasses,
-                weights, minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector);
-      }
+      gains[i] = tree.TrainIndices(dataset, datasetInfo, indices, labels,
+          numClasses, weights, minimumLeafSize, minimumGainSplit,
+          maximumDepth, treeSelector, dimensions, presort);
+    }
+    else if (UseWeights)
+    {
+      gains[i] = tree.TrainIndices(dataset, indices, labels, numClasses,
+          weights, minimumLeafSize, minimumGainSplit, maximumDepth,
+          treeSelector, dimensions, presort);
+    }
+    else if (UseDatasetInfo)
+    {
+      gains[i] = tree.TrainIndices(dataset, datasetInfo, indices, labels,
+          numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
+          treeSelector, dimensions, presort);
     }
     else
     {
-      if (UseDatasetInfo)
+      gains[i] = tree.TrainIndices(dataset, indices, labels, numClasses,
+          minimumLeafSize, minimumGainSplit, maximumDepth, treeSelector,
+          dimensions, presort);
+    }
+  });
+
+  // Sum the gains in the order of the trees.
+  for (size_t i = 0; i < numTrees; ++i)
+    totalGain += gains[i];
+
+  avgGain = totalGain / trees.size();
+  return avgGain;
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<bool StoreProbabilities, typename MatType>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::ClassifyBatch(const MatType& data,
+                 arma::Row<size_t>& predictions,
+                 arma::mat& probabilities) const
+{
+  const size_t numClasses = trees[0].NumClasses();
+  predictions.set_size(data.n_cols);
+  if (StoreProbabilities)
+    probabilities.set_size(numClasses, data.n_cols);
+
+  const size_t numTiles = (data.n_cols + tileSize - 1) / tileSize;
+  #ifdef MLPACK_USE_OPENMP
+  const size_t numThreads = (size_t) omp_get_max_threads();
+  #else
+  const size_t numThreads = 1;
+  #endif
+
+  if (numTiles < numThreads && trees.size() > 1)
+  {
+    // There are not enough points to keep every thread busy, so search the
+    // trees in parallel instead.  The probabilities are then summed in the
+    // order of the trees, so that the results do not depend on the number of
+    // threads.
+    std::vector<const arma::vec*> leaves(trees.size() * data.n_cols);
+
+    #pragma omp parallel for
+    for (size_t t = 0; t < trees.size(); ++t)
+    {
+      for (size_t i = 0; i < data.n_cols; ++i)
+        leaves[t * data.n_cols + i] = &LeafProbabilities(trees[t], data.col(i));
+    }
+
+    arma::vec probs(numClasses);
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      probs.zeros();
+      for (size_t t = 0; t < trees.size(); ++t)
+        probs += *leaves[t * data.n_cols + i];
+
+      probs /= trees.size();
+      predictions[i] = (size_t) probs.index_max();
+      if (StoreProbabilities)
+        probabilities.col(i) = probs;
+    }
+
+    return;
+  }
+
+  #pragma omp parallel
+  {
+    // Each thread accumulates the probabilities of its current tile here.
+    arma::mat tileProbabilities(numClasses, tileSize);
+
+    // Every tile costs about the same, so a static schedule balances the
+    // work, and keeps each thread on the same columns from call to call.
+    #pragma omp for schedule(static)
+    for (size_t tile = 0; tile < numTiles; ++tile)
+    {
+      const size_t begin = tile * tileSize;
+      const size_t end = std::min(begin + tileSize, (size_t) data.n_cols);
+
+      // Run the whole tile through each tree before moving to the next tree.
+      tileProbabilities.zeros();
+      for (size_t t = 0; t < trees.size(); ++t)
       {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, datasetInfo,
-                bootstrapLabels, numClasses, minimumLeafSize, minimumGainSplit,
-                maximumDepth, dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
-                numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector);
+        for (size_t i = begin; i < end; ++i)
+        {
+          tileProbabilities.col(i - begin) +=
+              LeafProbabilities(trees[t], data.col(i));
+        }
       }
-      else
+
+      for (size_t i = begin; i < end; ++i)
       {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, bootstrapLabels,
-                numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, labels, numClasses,
-                minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector);
+        tileProbabilities.col(i - begin) /= trees.size();
+        predictions[i] = (size_t) tileProbabilities.col(i - begin).index_max();
+        if (StoreProbabilities)
+          probabilities.col(i) = tileProbabilities.col(i - begin);
       }
     }
   }
+}
 
-  avgGain = totalGain / trees.size();
-  return avgGain;
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<typename VecType>
+const arma::vec& RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::LeafProbabilities(const DecisionTreeType& tree,
+                     const VecType& point)
+{
+  const DecisionTreeType* node = &tree;
+  while (node->NumChildren() > 0)
+    node = &node->Child(node->CalculateDirection(point));
+
+  return node->ClassProbabilities();
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<typename VecType>
+size_t RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::OutOfBagProbabilities(const VecType& point,
+                         const size_t index,
+                         arma::vec& probabilities) const
+{
+  size_t numOutOfBag = 0;
+  for (size_t t = 0; t < trees.size(); ++t)
+  {
+    if (!inBag[t][index])
+    {
+      probabilities += LeafProbabilities(trees[t], point);
+      ++numOutOfBag;
+    }
+  }
+
+  return numOutOfBag;
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::CheckOutOfBag(const size_t numPoints,
+                 const size_t numLabels,
+                 const std::string& function) const
+{
+  if (trees.size() == 0)
+  {
+    throw std::invalid_argument("RandomForest::" + function + "(): no random "
+        "forest trained!");
+  }
+
+  if (inBag.size() != trees.size())
+  {
+    throw std::invalid_argument("RandomForest::" + function + "(): the "
+        "samples of the trees are not known (they are not saved with the "
+        "model)");
+  }
+
+  for (size_t t = 0; t < inBag.size(); ++t)
+  {
+    if (inBag[t].size() != numPoints)
+    {
+      std::ostringstream oss;
+      oss << "RandomForest::" << function << "(): tree " << t << " was "
+          << "trained on " << inBag[t].size() << " points, but the given "
+          << "dataset has " << numPoints << " points; the dataset must be the "
+          << "training set of the forest";
+      throw std::invalid_argument(oss.str());
+    }
+  }
+
+  if (numLabels != numPoints)
+  {
+    std::ostringstream oss;
+    oss << "RandomForest::" << function << "(): the number of labels ("
+        << numLabels << ") does not match the number of points (" << numPoints
+        << ")";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+MemoryReport RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::MemoryUsage() const
+{
+  // The roots of the trees are held by the vector of trees, and are counted by
+  // the reports of the trees; only the unused capacity of the vector is added.
+  MemoryReport treesReport;
+  treesReport.Add("nodes", (trees.capacity() - trees.size()) *
+      sizeof(DecisionTreeType));
+  for (size_t i = 0; i < trees.size(); ++i)
+    treesReport += trees[i].MemoryUsage();
+
+  MemoryReport report;
+  report.Add("trees", treesReport);
+  size_t inBagBytes = MemoryOf(inBag);
+  for (size_t i = 0; i < inBag.size(); ++i)
+    inBagBytes += MemoryOf(inBag[i]);
+  report.Add("out-of-bag samples", inBagBytes);
+
+  return report;
 }
 
 } // namespace mlpack
@@ -260,6 +260,11 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
     timers.Stop("rf_training");
 
+    Log::Info << "Memory used by the model:" << endl
+        << rfModel->rf.MemoryUsage().Print();
+    Log::Info << "Peak resident memory after training: "
+        << MemoryReport::PrintBytes(PeakResidentMemory()) << "." << endl;
+
     // Did we want training accuracy?
     if (params.Has("print_training_accuracy"))
     {
@@ -160,6 +160,35 @@ class RandomizedSVD
              const size_t rank,
              const MeanType& rowMean);
 
+  /**
+   * Center the data to apply Principal Component Analysis on a dataset that is
+   * read from disk in chunks, using randomized SVD.  Only the current chunk,
+   * the d x IteratedPower() basis of the range of the data and the n x rank
+   * matrix v are held in memory (for d-dimensional data with n points).
+   *
+   * The data is read MaxIterations() + 4 times: once for the mean, once to
+   * apply the data to a random matrix (generated one chunk at a time), once
+   * per power iteration, once for the tall-skinny QR decomposition of the
+   * projection of the data on the basis (see TallSkinnyQR), and once to
+   * compute v.  Each pass only sums the contributions of the chunks, so the
+   * chunks could be processed independently (e.g. by different processes).
+   *
+   * A std::invalid_argument is thrown if the rank is 0 or greater than the
+   * dimensionality or the number of points of the dataset.
+   *
+   * @param source Source of the data.
+   * @param u First unitary matrix.
+   * @param v Second unitary matrix.
+   * @param s Diagonal "Sigma" matrix of singular values.
+   * @param rank Rank of the approximation.
+   */
+  template<typename eT, typename MatType, typename VecType>
+  void Apply(data::ChunkedSource<eT>& source,
+             MatType& u,
+             VecType& s,
+             MatType& v,
+             const size_t rank);
+
   //! Get the size of the normalized power iterations.
   size_t IteratedPower() const { return iteratedPower; }
   //! Modify the size of the normalized power iterations.
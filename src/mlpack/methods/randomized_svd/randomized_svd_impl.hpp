@@ -167,6 +167,101 @@ inline void RandomizedSVD::Apply(const InMatType& data,
   }
 }
 
+template<typename eT, typename MatType, typename VecType>
+inline void RandomizedSVD::Apply(data::ChunkedSource<eT>& source,
+                                 MatType& u,
+                                 VecType& s,
+                                 MatType& v,
+                                 const size_t rank)
+{
+  const size_t d = source.Dimensionality();
+  const size_t n = source.NumPoints();
+  if (rank == 0 || rank > std::min(d, n))
+  {
+    std::ostringstream oss;
+    oss << "RandomizedSVD::Apply(): the rank (" << rank << ") must be "
+        << "positive and at most the dimensionality (" << d << ") and the "
+        << "number of points (" << n << ") of the dataset";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (iteratedPower == 0)
+      iteratedPower = rank + 2;
+  const size_t k = std::max(rank, std::min(iteratedPower, std::min(d, n)));
+
+  // Call f(chunk, offset) for every chunk of the centered data; `offset` is
+  // the index of the first point of the chunk.
+  arma::Mat<eT> chunk;
+  MatType rowMean(d, 1, arma::fill::zeros);
+  auto forEachCenteredChunk = [&](auto&& f)
+  {
+    source.Reset();
+    size_t offset = 0;
+    while (source.Next(chunk))
+    {
+      chunk.each_col() -= rowMean;
+      f(chunk, offset);
+      offset += chunk.n_cols;
+    }
+  };
+
+  forEachCenteredChunk([&](const arma::Mat<eT>& c, const size_t /* offset */)
+  {
+    rowMean += arma::sum(c, 1);
+  });
+  rowMean = rowMean / n + eps;
+
+  // Apply the centered data matrix to a random n x k matrix, whose rows are
+  // generated with the chunks, and orthonormalize the result.
+  MatType Q, R, Y(d, k, arma::fill::zeros), omega;
+  forEachCenteredChunk([&](const arma::Mat<eT>& c, const size_t /* offset */)
+  {
+    omega.randn(c.n_cols, k);
+    Y += c * omega;
+  });
+  arma::qr_econ(Q, R, Y);
+
+  // Perform normalized power iterations; each one is a single pass over the
+  // data, since X X^T Q is the sum of X_i (X_i^T Q) over the chunks X_i.
+  for (size_t i = 0; i < maxIterations; ++i)
+  {
+    Y.zeros(d, Q.n_cols);
+    forEachCenteredChunk([&](const arma::Mat<eT>& c,
+                             const size_t /* offset */)
+    {
+      Y += c * (c.t() * Q);
+    });
+    arma::qr_econ(Q, R, Y);
+  }
+
+  // The tall and skinny n x k matrix X^T Q = Q_2 R is never formed: only its
+  // R factor is computed.  With R = A S B^T, Q^T X = B S (Q_2 A)^T, so the
+  // left singular vectors are Q B, and the right singular vectors are
+  // X^T Q B S^-1, computed with one more pass.
+  TallSkinnyQR<MatType> tsqr(Q.n_cols);
+  forEachCenteredChunk([&](const arma::Mat<eT>& c, const size_t /* offset */)
+  {
+    tsqr.Add(c.t() * Q);
+  });
+
+  MatType a, b;
+  VecType sAll;
+  arma::svd(a, sAll, b, tsqr.R());
+  s = sAll.subvec(0, rank - 1);
+  u = Q * b.cols(0, rank - 1);
+
+  v.set_size(n, rank);
+  forEachCenteredChunk([&](const arma::Mat<eT>& c, const size_t offset)
+  {
+    v.rows(offset, offset + c.n_cols - 1) = c.t() * u;
+  });
+  for (size_t i = 0; i < rank; ++i)
+  {
+    if (s[i] > 0)
+      v.col(i) /= s[i];
+  }
+}
+
 } // namespace mlpack
 
 #endif
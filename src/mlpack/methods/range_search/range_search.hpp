@@ -32,6 +32,12 @@ class LeafSizeRSWrapper;
  * algorithm; for more details on the actual algorithm, see the RangeSearchRules
  * class.
  *
+ * The search can be made approximate with Epsilon(): nodes whose distance
+ * bounds are within a (1 +/- epsilon) band of the range are accepted or
+ * rejected as a whole, so points whose distances are within that band of the
+ * range bounds may or may not be returned.  MaxResults() caps the number of
+ * results of each query point.  Both are off by default.
+ *
  * @tparam DistanceType Metric to use for range search calculations.
  * @tparam MatType Type of data to use.
  * @tparam TreeType Type of tree to use; must satisfy the TreeType policy API.
@@ -271,6 +277,88 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<ElemType>>& distances);
 
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, returning the results in compressed sparse row (CSR) format.
+   * This avoids one allocation per query point, and uses much less memory
+   * than the vector-of-vectors output when there are many query points.
+   *
+   * - offsets.n_elem is the number of query points plus one, and offsets[0] is
+   *   0.
+   *
+   * - neighbors[offsets[i]] to neighbors[offsets[i + 1] - 1] are the indices of
+   *   all the points in the reference set which have distances inside the
+   *   given range to query point i.
+   *
+   * - distances holds the distances corresponding to each index in neighbors.
+   *
+   * - The neighbors of each query point are not sorted in any particular
+   *   order.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param offsets Will hold the offset of the results of each query point.
+   * @param neighbors Will hold the indices of the results of all query points.
+   * @param distances Will hold the distances of the results of all query
+   *      points.
+   */
+  void Search(const MatType& querySet,
+              const RangeType<ElemType>& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::Col<ElemType>& distances);
+
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set, returning the results in compressed sparse row (CSR) format (see the
+   * overload above).  The query set and the reference set are the same, and a
+   * point is not returned in its own results.
+   *
+   * @param range Range of distances in which to search.
+   * @param offsets Will hold the offset of the results of each query point.
+   * @param neighbors Will hold the indices of the results of all query points.
+   * @param distances Will hold the distances of the results of all query
+   *      points.
+   */
+  void Search(const RangeType<ElemType>& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::Col<ElemType>& distances);
+
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, passing each result to the given callback as it is found
+   * instead of storing it:
+   *
+   * @code
+   * callback(queryIndex, referenceIndex, distance);
+   * @endcode
+   *
+   * The indices are the indices of the points in the original query and
+   * reference sets.  If OpenMP is enabled, the callback may be called from
+   * several threads at once, but all the results of a given query point are
+   * passed to it by the same thread.  No particular order is guaranteed.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param callback Callable object that receives each result.
+   */
+  template<typename CallbackType>
+  void Search(const MatType& querySet,
+              const RangeType<ElemType>& range,
+              CallbackType&& callback);
+
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set, passing each result to the given callback as it is found (see the
+   * overload above).  A point is not returned in its own results.
+   *
+   * @param range Range of distances in which to search.
+   * @param callback Callable object that receives each result.
+   */
+  template<typename CallbackType>
+  void Search(const RangeType<ElemType>& range, CallbackType&& callback);
+
   //! Get whether single-tree search is being used.
   bool SingleMode() const { return singleMode; }
   //! Modify whether single-tree search is being used.
@@ -281,10 +369,26 @@ class RangeSearch
   //! Modify whether naive search is being used.
   bool& Naive() { return naive; }
 
+  //! Get the relative error of the range bounds for approximate search (0
+  //! means exact search).
+  double Epsilon() const { return epsilon; }
+  //! Modify the relative error of the range bounds for approximate search; it
+  //! must be in [0, 1).
+  double& Epsilon() { return epsilon; }
+
+  //! Get the maximum number of results of each query point (0 means no limit).
+  size_t MaxResults() const { return maxResults; }
+  //! Modify the maximum number of results of each query point (0 means no
+  //! limit).
+  size_t& MaxResults() { return maxResults; }
+
   //! Get the number of base cases during the last search.
-  size_t BaseCases() const { return baseCases; }
+  size_t BaseCases() const { return stats.BaseCases(); }
   //! Get the number of scores during the last search.
-  size_t Scores() const { return scores; }
+  size_t Scores() const { return stats.Scores(); }
+  //! Get the statistics of the last search (base cases, scores, prunes, and
+  //! time spent building query trees and traversing).
+  const TraversalStats& Stats() const { return stats; }
 
   //! Serialize the model.
   template<typename Archive>
@@ -312,14 +416,23 @@ class RangeSearch
   bool naive;
   //! If true, single-tree computation is used.
   bool singleMode;
+  //! Relative error of the range bounds for approximate search.
+  double epsilon;
+  //! Maximum number of results of each query point (0 means no limit).
+  size_t maxResults;
 
   //! Instantiated distance metric.
   DistanceType distance;
 
-  //! The total number of base cases during the last search.
-  size_t baseCases;
-  //! The total number of scores during the last search.
-  size_t scores;
+  //! The statistics of the last search.
+  TraversalStats stats;
+
+  //! Fill the distance evaluations and the traversal time of the statistics of
+  //! the search that started at the given time.
+  void FinishStats(const std::chrono::steady_clock::time_point start);
+
+  //! Throw an exception if the relative error is not in [0, 1).
+  void CheckEpsilon() const;
 
   //! For access to mappings when building models.
   friend class LeafSizeRSWrapper<TreeType>;
@@ -37,9 +37,10 @@ RangeSearch<DistanceType, MatType, TreeType>::RangeSearch(
     treeOwner(!naive),
     naive(naive),
     singleMode(!naive && singleMode),
+    epsilon(0.0),
+    maxResults(0),
     distance(distance),
-    baseCases(0),
-    scores(0)
+    stats()
 {
   // Nothing to do.
 }
@@ -58,9 +59,10 @@ RangeSearch<DistanceType, MatType, TreeType>::RangeSearch(
     treeOwner(false),
     naive(false),
     singleMode(singleMode),
+    epsilon(0.0),
+    maxResults(0),
     distance(distance),
-    baseCases(0),
-    scores(0)
+    stats()
 {
   // Nothing else to initialize.
 }
@@ -79,9 +81,10 @@ RangeSearch<DistanceType, MatType, TreeType>::RangeSearch(
     treeOwner(false),
     naive(naive),
     singleMode(singleMode),
+    epsilon(0.0),
+    maxResults(0),
     distance(distance),
-    baseCases(0),
-    scores(0)
+    stats()
 {
   // Build the tree on the empty dataset, if necessary.
   if (!naive)
@@ -107,9 +110,10 @@ RangeSearch<DistanceType, MatType, TreeType>::RangeSearch(
     treeOwner(other.referenceTree),
     naive(other.naive),
     singleMode(other.singleMode),
+    epsilon(other.epsilon),
+    maxResults(other.maxResults),
     distance(other.distance),
-    baseCases(other.baseCases),
-    scores(other.scores)
+    stats(other.stats)
 {
   // Nothing to do.
 }
@@ -126,9 +130,10 @@ RangeSearch<DistanceType, MatType, TreeType>::RangeSearch(RangeSearch&& other) :
     treeOwner(other.treeOwner),
     naive(other.naive),
     singleMode(other.singleMode),
+    epsilon(other.epsilon),
+    maxResults(other.maxResults),
     distance(std::move(other.distance)),
-    baseCases(other.baseCases),
-    scores(other.scores)
+    stats(other.stats)
 {
   // Clear other object.
   other.referenceTree =
@@ -137,8 +142,9 @@ RangeSearch<DistanceType, MatType, TreeType>::RangeSearch(RangeSearch&& other) :
   other.treeOwner = true;
   other.naive = false;
   other.singleMode = false;
-  other.baseCases = 0;
-  other.scores = 0;
+  other.epsilon = 0.0;
+  other.maxResults = 0;
+  other.stats.Reset();
 }
 
 template<typename DistanceType,
@@ -160,9 +166,10 @@ RangeSearch<DistanceType, MatType, TreeType>::operator=(
     treeOwner = other.referenceTree;
     naive = other.naive;
     singleMode = other.singleMode;
+    epsilon = other.epsilon;
+    maxResults = other.maxResults;
     distance = other.distance;
-    baseCases = other.baseCases;
-    scores = other.scores;
+    stats = other.stats;
   }
   return *this;
 }
@@ -190,9 +197,10 @@ RangeSearch<DistanceType, MatType, TreeType>::operator=(RangeSearch&& other)
     treeOwner = other.treeOwner;
     naive = other.naive;
     singleMode = other.singleMode;
+    epsilon = other.epsilon;
+    maxResults = other.maxResults;
     distance = std::move(other.distance);
-    baseCases = other.baseCases;
-    scores = other.scores;
+    stats = other.stats;
 
     // Clear other object.
     other.referenceTree = nullptr;
@@ -200,8 +208,9 @@ RangeSearch<DistanceType, MatType, TreeType>::operator=(RangeSearch&& other)
     other.treeOwner = false;
     other.naive = false;
     other.singleMode = false;
-    other.baseCases = 0;
-    other.scores = 0;
+    other.epsilon = 0.0;
+    other.maxResults = 0;
+    other.stats.Reset();
   }
   return *this;
 }
@@ -291,6 +300,14 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
     std::vector<std::vector<size_t>>& neighbors,
     std::vector<std::vector<ElemType>>& distances)
 {
+  MLPACK_PROFILE_SCOPE("RangeSearch::Search");
+
+  CheckEpsilon();
+
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
   util::CheckSameDimensionality(querySet, *referenceSet,
       "RangeSearch::Search()", "query set");
 
@@ -334,50 +351,70 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
   // Create the helper object for the traversal.
   using RuleType = RangeSearchRules<DistanceType, Tree>;
 
-  // Reset counts.
-  baseCases = 0;
-  scores = 0;
-
   if (naive)
   {
     RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        distance);
+        distance, false, epsilon, maxResults);
 
     // The naive brute-force solution.
     for (size_t i = 0; i < querySet.n_cols; ++i)
       for (size_t j = 0; j < referenceSet->n_cols; ++j)
         rules.BaseCase(i, j);
 
-    baseCases += (querySet.n_cols * referenceSet->n_cols);
+    stats.BaseCases() += (querySet.n_cols * referenceSet->n_cols);
   }
   else if (singleMode)
   {
-    // Create the traverser.
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        distance);
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    // Split the query points over threads.  Each thread has its own rules and
+    // traverser; results are written directly into the output vectors.  If the
+    // tree caches distances in the reference nodes during Score() (i.e. if it
+    // has self-children), the reference tree can't be shared between threads.
+    size_t threadBaseCases = 0, threadScores = 0, threadPrunes = 0;
+    #pragma omp parallel if (!TreeTraits<Tree>::HasSelfChildren) \
+        reduction(+:threadBaseCases, threadScores, threadPrunes)
+    {
+      RuleType rules(*referenceSet, querySet, range, *neighborPtr,
+          *distancePtr, distance, false, epsilon, maxResults);
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+      // Now have it traverse for each point.
+      #pragma omp for schedule(dynamic, 16)
+      for (size_t i = 0; i < querySet.n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+      threadPrunes += traverser.NumPrunes();
 
-    baseCases += rules.BaseCases();
-    scores += rules.Scores();
+      threadBaseCases += rules.BaseCases();
+      threadScores += rules.Scores();
+    }
+
+    stats.BaseCases() += threadBaseCases;
+    stats.Scores() += threadScores;
+    stats.Prunes() += threadPrunes;
   }
   else // Dual-tree recursion.
   {
     // Build the query tree.
+    const std::chrono::steady_clock::time_point buildStart =
+        std::chrono::steady_clock::now();
     Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+    stats.TreeBuildingTime() += TraversalStats::Since(buildStart);
 
-    // Create the traverser.
+    // Create the traverser.  If the tree type supports it, the query tree is
+    // split between threads; each query point's results are only ever written
+    // by one thread.
     RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-        *distancePtr, distance);
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+        *distancePtr, distance, false, epsilon, maxResults);
+    typename DualTreeTraverserType<Tree, RuleType>::type traverser(rules);
 
     traverser.Traverse(*queryTree, *referenceTree);
 
-    baseCases += rules.BaseCases();
-    scores += rules.Scores();
+    MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+    stats.Prunes() += traverser.NumPrunes();
+
+    stats.BaseCases() += rules.BaseCases();
+    stats.Scores() += rules.Scores();
 
     // Clean up tree memory.
     delete queryTree;
@@ -448,6 +485,8 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
       delete neighborPtr;
     }
   }
+
+  FinishStats(start);
 }
 
 template<typename DistanceType,
@@ -461,6 +500,14 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
     std::vector<std::vector<size_t>>& neighbors,
     std::vector<std::vector<ElemType>>& distances)
 {
+  MLPACK_PROFILE_SCOPE("RangeSearch::Search");
+
+  CheckEpsilon();
+
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
   // If there are no points, there is no search to be done.
   if (referenceSet->n_cols == 0)
     return;
@@ -488,15 +535,18 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
   // Create the helper object for the traversal.
   using RuleType = RangeSearchRules<DistanceType, Tree>;
   RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-      distances, distance);
+      distances, distance, false, epsilon, maxResults);
 
   // Create the traverser.
   typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
   traverser.Traverse(*queryTree, *referenceTree);
 
-  baseCases = rules.BaseCases();
-  scores = rules.Scores();
+  MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+  stats.Prunes() += traverser.NumPrunes();
+
+  stats.BaseCases() = rules.BaseCases();
+  stats.Scores() = rules.Scores();
 
   // Do we need to map indices?
   if (treeOwner && TreeTraits<Tree>::RearrangesDataset)
@@ -515,6 +565,8 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
     // Finished with temporary object.
     delete neighborPtr;
   }
+
+  FinishStats(start);
 }
 
 template<typename DistanceType,
@@ -527,6 +579,14 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
     std::vector<std::vector<size_t>>& neighbors,
     std::vector<std::vector<ElemType>>& distances)
 {
+  MLPACK_PROFILE_SCOPE("RangeSearch::Search");
+
+  CheckEpsilon();
+
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
   // If there are no points, there is no search to be done.
   if (referenceSet->n_cols == 0)
     return;
@@ -551,7 +611,8 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
   // Create the helper object for the traversal.
   using RuleType = RangeSearchRules<DistanceType, Tree>;
   RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
-      *distancePtr, distance, true /* don't return the query in the results */);
+      *distancePtr, distance, true /* don't return the query in the results */,
+      epsilon, maxResults);
 
   if (naive)
   {
@@ -560,30 +621,49 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
       for (size_t j = 0; j < referenceSet->n_cols; ++j)
         rules.BaseCase(i, j);
 
-    baseCases = (referenceSet->n_cols * referenceSet->n_cols);
-    scores = 0;
+    stats.BaseCases() = (referenceSet->n_cols * referenceSet->n_cols);
   }
   else if (singleMode)
   {
-    // Create the traverser.
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    // Split the query points over threads, just like in the bichromatic case.
+    size_t threadBaseCases = 0, threadScores = 0, threadPrunes = 0;
+    #pragma omp parallel if (!TreeTraits<Tree>::HasSelfChildren) \
+        reduction(+:threadBaseCases, threadScores, threadPrunes)
+    {
+      RuleType threadRules(*referenceSet, *referenceSet, range, *neighborPtr,
+          *distancePtr, distance, true);
+      typename Tree::template SingleTreeTraverser<RuleType>
+          traverser(threadRules);
 
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+      // Now have it traverse for each point.
+      #pragma omp for schedule(dynamic, 16)
+      for (size_t i = 0; i < referenceSet->n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+      threadPrunes += traverser.NumPrunes();
 
-    baseCases = rules.BaseCases();
-    scores = rules.Scores();
+      threadBaseCases += threadRules.BaseCases();
+      threadScores += threadRules.Scores();
+    }
+
+    stats.BaseCases() = threadBaseCases;
+    stats.Scores() = threadScores;
+    stats.Prunes() += threadPrunes;
   }
   else // Dual-tree recursion.
   {
-    // Create the traverser.
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+    // Create the traverser (in parallel, if possible, as in the bichromatic
+    // case).
+    typename DualTreeTraverserType<Tree, RuleType>::type traverser(rules);
 
     traverser.Traverse(*referenceTree, *referenceTree);
 
-    baseCases = rules.BaseCases();
-    scores = rules.Scores();
+    MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+    stats.Prunes() += traverser.NumPrunes();
+
+    stats.BaseCases() = rules.BaseCases();
+    stats.Scores() = rules.Scores();
   }
 
   // Do we need to map the reference indices?
@@ -612,6 +692,237 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
     delete neighborPtr;
     delete distancePtr;
   }
+
+  FinishStats(start);
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<DistanceType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::Col<ElemType>& distances)
+{
+  RangeSearchCSRBuilder<ElemType> builder;
+  Search(querySet, range, builder);
+  builder.Finalize(querySet.n_cols, offsets, neighbors, distances);
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<DistanceType, MatType, TreeType>::Search(
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::Col<ElemType>& distances)
+{
+  RangeSearchCSRBuilder<ElemType> builder;
+  Search(range, builder);
+  builder.Finalize(referenceSet->n_cols, offsets, neighbors, distances);
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename CallbackType>
+void RangeSearch<DistanceType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const RangeType<ElemType>& range,
+    CallbackType&& callback)
+{
+  MLPACK_PROFILE_SCOPE("RangeSearch::Search");
+
+  CheckEpsilon();
+
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  util::CheckSameDimensionality(querySet, *referenceSet,
+      "RangeSearch::Search()", "query set");
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+  // Reference indices only need to be mapped if we built the reference tree
+  // ourselves.
+  using MappedCallbackType =
+      RangeSearchMappedCallback<std::remove_reference_t<CallbackType>>;
+  using RuleType = RangeSearchRules<DistanceType, Tree, MappedCallbackType>;
+  const std::vector<size_t>* referenceMapping =
+      (TreeTraits<Tree>::RearrangesDataset && treeOwner) ?
+      &oldFromNewReferences : NULL;
+
+  if (naive)
+  {
+    RuleType rules(*referenceSet, querySet, range,
+        MappedCallbackType(callback, NULL, referenceMapping), distance, false,
+        epsilon, maxResults);
+
+    // The naive brute-force solution.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      for (size_t j = 0; j < referenceSet->n_cols; ++j)
+        rules.BaseCase(i, j);
+
+    stats.BaseCases() += (querySet.n_cols * referenceSet->n_cols);
+  }
+  else if (singleMode)
+  {
+    // Split the query points over threads, as with the other Search()
+    // overloads.
+    size_t threadBaseCases = 0, threadScores = 0, threadPrunes = 0;
+    #pragma omp parallel if (!TreeTraits<Tree>::HasSelfChildren) \
+        reduction(+:threadBaseCases, threadScores, threadPrunes)
+    {
+      RuleType rules(*referenceSet, querySet, range,
+          MappedCallbackType(callback, NULL, referenceMapping), distance,
+          false, epsilon, maxResults);
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+      #pragma omp for schedule(dynamic, 16)
+      for (size_t i = 0; i < querySet.n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+      threadPrunes += traverser.NumPrunes();
+
+      threadBaseCases += rules.BaseCases();
+      threadScores += rules.Scores();
+    }
+
+    stats.BaseCases() += threadBaseCases;
+    stats.Scores() += threadScores;
+    stats.Prunes() += threadPrunes;
+  }
+  else // Dual-tree recursion.
+  {
+    // Build the query tree; the query indices must be mapped if it rearranges
+    // the points.
+    std::vector<size_t> oldFromNewQueries;
+    const std::chrono::steady_clock::time_point buildStart =
+        std::chrono::steady_clock::now();
+    Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+    stats.TreeBuildingTime() += TraversalStats::Since(buildStart);
+    const std::vector<size_t>* queryMapping =
+        TreeTraits<Tree>::RearrangesDataset ? &oldFromNewQueries : NULL;
+
+    RuleType rules(*referenceSet, queryTree->Dataset(), range,
+        MappedCallbackType(callback, queryMapping, referenceMapping),
+        distance, false, epsilon, maxResults);
+    typename DualTreeTraverserType<Tree, RuleType>::type traverser(rules);
+
+    traverser.Traverse(*queryTree, *referenceTree);
+
+    MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+    stats.Prunes() += traverser.NumPrunes();
+
+    stats.BaseCases() += rules.BaseCases();
+    stats.Scores() += rules.Scores();
+
+    // Clean up tree memory.
+    delete queryTree;
+  }
+
+  FinishStats(start);
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename CallbackType>
+void RangeSearch<DistanceType, MatType, TreeType>::Search(
+    const RangeType<ElemType>& range,
+    CallbackType&& callback)
+{
+  MLPACK_PROFILE_SCOPE("RangeSearch::Search");
+
+  CheckEpsilon();
+
+  stats.Reset();
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+  // The query set is the reference set, so both query and reference indices
+  // must be mapped if we built the tree ourselves.
+  using MappedCallbackType =
+      RangeSearchMappedCallback<std::remove_reference_t<CallbackType>>;
+  using RuleType = RangeSearchRules<DistanceType, Tree, MappedCallbackType>;
+  const std::vector<size_t>* mapping =
+      (TreeTraits<Tree>::RearrangesDataset && treeOwner) ?
+      &oldFromNewReferences : NULL;
+  const MappedCallbackType mappedCallback(callback, mapping, mapping);
+
+  if (naive)
+  {
+    RuleType rules(*referenceSet, *referenceSet, range, mappedCallback,
+        distance, true /* don't return the query in the results */, epsilon,
+        maxResults);
+
+    // The naive brute-force solution.
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      for (size_t j = 0; j < referenceSet->n_cols; ++j)
+        rules.BaseCase(i, j);
+
+    stats.BaseCases() = (referenceSet->n_cols * referenceSet->n_cols);
+  }
+  else if (singleMode)
+  {
+    size_t threadBaseCases = 0, threadScores = 0, threadPrunes = 0;
+    #pragma omp parallel if (!TreeTraits<Tree>::HasSelfChildren) \
+        reduction(+:threadBaseCases, threadScores, threadPrunes)
+    {
+      RuleType rules(*referenceSet, *referenceSet, range, mappedCallback,
+          distance, true, epsilon, maxResults);
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+      #pragma omp for schedule(dynamic, 16)
+      for (size_t i = 0; i < referenceSet->n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+      threadPrunes += traverser.NumPrunes();
+
+      threadBaseCases += rules.BaseCases();
+      threadScores += rules.Scores();
+    }
+
+    stats.BaseCases() = threadBaseCases;
+    stats.Scores() = threadScores;
+    stats.Prunes() += threadPrunes;
+  }
+  else // Dual-tree recursion.
+  {
+    RuleType rules(*referenceSet, *referenceSet, range, mappedCallback,
+        distance, true, epsilon, maxResults);
+    typename DualTreeTraverserType<Tree, RuleType>::type traverser(rules);
+
+    traverser.Traverse(*referenceTree, *referenceTree);
+
+    MLPACK_PROFILE_COUNT(Prunes, traverser.NumPrunes());
+    stats.Prunes() += traverser.NumPrunes();
+
+    stats.BaseCases() = rules.BaseCases();
+    stats.Scores() = rules.Scores();
+  }
+
+  FinishStats(start);
 }
 
 template<typename DistanceType,
@@ -627,11 +938,10 @@ void RangeSearch<DistanceType, MatType, TreeType>::serialize(
   ar(CEREAL_NVP(naive));
   ar(CEREAL_NVP(singleMode));
 
-  // Reset base cases and scores if we are loading.
+  // Reset the statistics of the last search if we are loading.
   if (cereal::is_loading<Archive>())
   {
-    baseCases = 0;
-    scores = 0;
+    stats.Reset();
   }
 
   // If we are doing naive search, we serialize the dataset.  Otherwise we
@@ -683,6 +993,33 @@ void RangeSearch<DistanceType, MatType, TreeType>::serialize(
   }
 }
 
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<DistanceType, MatType, TreeType>::FinishStats(
+    const std::chrono::steady_clock::time_point start)
+{
+  // Every base case evaluates exactly one distance.  (The distances to the
+  // points of reference nodes that are entirely in range are not counted.)
+  stats.DistanceEvaluations() = stats.BaseCases();
+  stats.TraversalTime() = TraversalStats::Since(start) -
+      stats.TreeBuildingTime();
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<DistanceType, MatType, TreeType>::CheckEpsilon() const
+{
+  if (epsilon < 0.0 || epsilon >= 1.0)
+    throw std::invalid_argument("RangeSearch::Search(): epsilon must be in "
+        "[0, 1)!");
+}
+
 } // namespace mlpack
 
 #endif
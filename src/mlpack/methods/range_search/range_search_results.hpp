@@ -0,0 +1,211 @@
+/**
+ * @file methods/range_search/range_search_results.hpp
+ *
+ * Callback types that receive the results of a range search: the default one,
+ * which stores the results in a vector of vectors; a wrapper that maps the
+ * indices of rearranged trees back to the original indices; and a builder for
+ * the compressed (CSR) output format.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RESULTS_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RESULTS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+
+/**
+ * Store range search results in a vector of vectors: each result for query
+ * point q is appended to neighbors[q] and distances[q].  This is the callback
+ * type used by default by RangeSearchRules.  Copies share the same output
+ * vectors.
+ *
+ * @tparam ElemType Type of the distances.
+ */
+template<typename ElemType>
+class RangeSearchVectorResults
+{
+ public:
+  /**
+   * Store results in the given vectors, which must already have one entry for
+   * each query point.
+   */
+  RangeSearchVectorResults(std::vector<std::vector<size_t>>& neighbors,
+                           std::vector<std::vector<ElemType>>& distances) :
+      neighbors(&neighbors),
+      distances(&distances)
+  { }
+
+  //! Store the given result.
+  void operator()(const size_t queryIndex,
+                  const size_t referenceIndex,
+                  const ElemType distance) const
+  {
+    (*neighbors)[queryIndex].push_back(referenceIndex);
+    (*distances)[queryIndex].push_back(distance);
+  }
+
+  //! Make room for the given number of new results for the given query point.
+  void Reserve(const size_t queryIndex, const size_t count) const
+  {
+    const size_t oldSize = (*neighbors)[queryIndex].size();
+    (*neighbors)[queryIndex].reserve(oldSize + count);
+    (*distances)[queryIndex].reserve(oldSize + count);
+  }
+
+ private:
+  //! The neighbors of each query point.
+  std::vector<std::vector<size_t>>* neighbors;
+  //! The distances to the neighbors of each query point.
+  std::vector<std::vector<ElemType>>* distances;
+};
+
+/**
+ * Pass range search results to a user callback, after mapping the query and
+ * reference indices back to their original values (if the trees rearranged
+ * the points).  A NULL mapping means that the indices are left unchanged.
+ * Copies share the same callback.
+ *
+ * @tparam CallbackType Type of the user callback.
+ */
+template<typename CallbackType>
+class RangeSearchMappedCallback
+{
+ public:
+  RangeSearchMappedCallback(CallbackType& callback,
+                            const std::vector<size_t>* oldFromNewQueries,
+                            const std::vector<size_t>* oldFromNewReferences) :
+      callback(&callback),
+      oldFromNewQueries(oldFromNewQueries),
+      oldFromNewReferences(oldFromNewReferences)
+  { }
+
+  //! Pass the given result to the callback.
+  template<typename ElemType>
+  void operator()(const size_t queryIndex,
+                  const size_t referenceIndex,
+                  const ElemType distance) const
+  {
+    (*callback)(
+        oldFromNewQueries ? (*oldFromNewQueries)[queryIndex] : queryIndex,
+        oldFromNewReferences ? (*oldFromNewReferences)[referenceIndex] :
+            referenceIndex,
+        distance);
+  }
+
+ private:
+  //! The user callback.
+  CallbackType* callback;
+  //! Mapping of the query indices, or NULL.
+  const std::vector<size_t>* oldFromNewQueries;
+  //! Mapping of the reference indices, or NULL.
+  const std::vector<size_t>* oldFromNewReferences;
+};
+
+/**
+ * Collect range search results in per-thread buffers, and then assemble them
+ * into the compressed sparse row (CSR) format: the neighbors of query point i
+ * are neighbors[offsets[i]] to neighbors[offsets[i + 1] - 1], and their
+ * distances are stored at the same positions in distances.  This needs only a
+ * handful of allocations, no matter how many query points there are.
+ *
+ * The results of each query point are kept in the order in which they were
+ * found, so long as all of them were found by the same thread (which is the
+ * case for RangeSearch).
+ *
+ * @tparam ElemType Type of the distances.
+ */
+template<typename ElemType>
+class RangeSearchCSRBuilder
+{
+ public:
+  //! Create the builder, with one buffer for each OpenMP thread.
+  RangeSearchCSRBuilder()
+  {
+    #ifdef MLPACK_USE_OPENMP
+    buffers.resize(omp_get_max_threads());
+    #else
+    buffers.resize(1);
+    #endif
+  }
+
+  //! Store the given result in the buffer of the calling thread.
+  void operator()(const size_t queryIndex,
+                  const size_t referenceIndex,
+                  const ElemType distance)
+  {
+    #ifdef MLPACK_USE_OPENMP
+    const size_t thread = omp_get_thread_num();
+    #else
+    const size_t thread = 0;
+    #endif
+    buffers[thread].push_back(Result{ queryIndex, referenceIndex, distance });
+  }
+
+  /**
+   * Assemble the collected results into the CSR format, and empty the buffers.
+   *
+   * @param numQueries Number of query points.
+   * @param offsets Will hold numQueries + 1 offsets into neighbors and
+   *     distances.
+   * @param neighbors Will hold the neighbors of all query points.
+   * @param distances Will hold the distances to the neighbors of all query
+   *     points.
+   */
+  void Finalize(const size_t numQueries,
+                arma::Col<size_t>& offsets,
+                arma::Col<size_t>& neighbors,
+                arma::Col<ElemType>& distances)
+  {
+    // Count the results of each query point.
+    offsets.zeros(numQueries + 1);
+    for (size_t t = 0; t < buffers.size(); ++t)
+      for (size_t i = 0; i < buffers[t].size(); ++i)
+        ++offsets[buffers[t][i].query + 1];
+
+    for (size_t i = 0; i < numQueries; ++i)
+      offsets[i + 1] += offsets[i];
+
+    // Now scatter the results into place.
+    neighbors.set_size(offsets[numQueries]);
+    distances.set_size(offsets[numQueries]);
+    arma::Col<size_t> positions(offsets.memptr(), numQueries);
+    for (size_t t = 0; t < buffers.size(); ++t)
+    {
+      for (size_t i = 0; i < buffers[t].size(); ++i)
+      {
+        const Result& r = buffers[t][i];
+        const size_t position = positions[r.query]++;
+        neighbors[position] = r.reference;
+        distances[position] = r.distance;
+      }
+
+      // Release the memory of this buffer.
+      std::vector<Result>().swap(buffers[t]);
+    }
+  }
+
+ private:
+  //! A single result.
+  struct Result
+  {
+    size_t query;
+    size_t reference;
+    ElemType distance;
+  };
+
+  //! The results found by each thread.
+  std::vector<std::vector<Result>> buffers;
+};
+
+} // namespace mlpack
+
+#endif
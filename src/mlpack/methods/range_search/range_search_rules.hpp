@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include "range_search_results.hpp"
 
 namespace mlpack {
 
@@ -20,10 +21,31 @@ namespace mlpack {
  * The RangeSearchRules class is a template helper class used by RangeSearch
  * class when performing range searches.
  *
+ * Each result is passed to a callback object, as callback(queryIndex,
+ * referenceIndex, distance); by default, the results are stored in a vector of
+ * vectors (see RangeSearchVectorResults).  The callback is copied along with
+ * the rules, so copies of the callback must share their results.
+ *
+ * The search can be approximate: with a relative error epsilon, a node is
+ * pruned if its distance bounds do not intersect the shrunk range
+ * [(1 + epsilon) lo, (1 - epsilon) hi], and all of its points are added to the
+ * results if its bounds are within the widened range
+ * [(1 - epsilon) lo, (1 + epsilon) hi].  So, every point whose distance is in
+ * the shrunk range is returned, and no point whose distance is outside the
+ * widened range is; the points in between may or may not be returned.  (The
+ * distances that are returned are always exact.)  In addition, the number of
+ * results of each query point can be capped, in which case the query points
+ * that have enough results are pruned from the rest of the traversal; which
+ * points are returned then depends on the traversal order.
+ *
  * @tparam DistanceType The distance metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ * @tparam CallbackType The type of the callback that receives the results.
  */
-template<typename DistanceType, typename TreeType>
+template<typename DistanceType,
+         typename TreeType,
+         typename CallbackType =
+             RangeSearchVectorResults<typename TreeType::Mat::elem_type>>
 class RangeSearchRules
 {
  public:
@@ -44,6 +66,9 @@ class RangeSearchRules
    * @param distance Instantiated distance metric.
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
+   * @param epsilon Relative error of the range bounds for pruning (in [0, 1)).
+   * @param maxResults Maximum number of results of each query point (0 means
+   *      no limit).
    */
   RangeSearchRules(const MatType& referenceSet,
                    const MatType& querySet,
@@ -51,7 +76,33 @@ class RangeSearchRules
                    std::vector<std::vector<size_t> >& neighbors,
                    std::vector<std::vector<ElemType> >& distances,
                    DistanceType& distance,
-                   const bool sameSet = false);
+                   const bool sameSet = false,
+                   const double epsilon = 0.0,
+                   const size_t maxResults = 0);
+
+  /**
+   * Construct the RangeSearchRules object, passing each result to the given
+   * callback instead of storing it.
+   *
+   * @param referenceSet Set of reference data.
+   * @param querySet Set of query data.
+   * @param range Range to search for.
+   * @param callback Callback to pass each result to.
+   * @param distance Instantiated distance metric.
+   * @param sameSet If true, the query and reference set are taken to be the
+   *      same, and a query point will not return itself in the results.
+   * @param epsilon Relative error of the range bounds for pruning (in [0, 1)).
+   * @param maxResults Maximum number of results of each query point (0 means
+   *      no limit).
+   */
+  RangeSearchRules(const MatType& referenceSet,
+                   const MatType& querySet,
+                   const RangeType<ElemType>& range,
+                   const CallbackType& callback,
+                   DistanceType& distance,
+                   const bool sameSet = false,
+                   const double epsilon = 0.0,
+                   const size_t maxResults = 0);
 
   /**
    * Compute the base case between the given query point and reference point.
@@ -118,8 +169,12 @@ class RangeSearchRules
 
   //! Get the number of base cases.
   size_t BaseCases() const { return baseCases; }
+  //! Modify the number of base cases.
+  size_t& BaseCases() { return baseCases; }
   //! Get the number of scores (that is, calls to RangeDistance()).
   size_t Scores() const { return scores; }
+  //! Modify the number of scores.
+  size_t& Scores() { return scores; }
 
   //! Get the minimum number of base cases we need to perform to have acceptable
   //! results.
@@ -134,12 +189,20 @@ class RangeSearchRules
 
   //! The range of distances for which we are searching.
   const RangeType<ElemType>& range;
+  //! The range whose points must all be returned (the range itself, if the
+  //! search is exact).
+  RangeType<ElemType> innerRange;
+  //! The range outside of which no point may be returned.
+  RangeType<ElemType> outerRange;
 
-  //! The vector the resultant neighbor indices should be stored in.
-  std::vector<std::vector<size_t> >& neighbors;
+  //! The maximum number of results of each query point (0 means no limit).
+  size_t maxResults;
+  //! The number of results of each query point, if they are limited; copies of
+  //! the rules share it.
+  std::shared_ptr<std::vector<size_t>> numResults;
 
-  //! The vector the resultant neighbor distances should be stored in.
-  std::vector<std::vector<ElemType> >& distances;
+  //! The callback that receives the results.
+  CallbackType callback;
 
   //! The instantiated distance metric.
   DistanceType& distance;
@@ -158,6 +221,21 @@ class RangeSearchRules
   void AddResult(const size_t queryIndex,
                  TreeType& referenceNode);
 
+  //! Pass a result to the callback, and count it if the results are limited.
+  void Report(const size_t queryIndex,
+              const size_t referenceIndex,
+              const ElemType d);
+
+  //! Return whether the given query point has as many results as allowed.
+  bool Full(const size_t queryIndex) const
+  {
+    return (maxResults > 0) && ((*numResults)[queryIndex] >= maxResults);
+  }
+
+  //! Return whether all the descendants of the given query node have as many
+  //! results as allowed.
+  bool Full(TreeType& queryNode) const;
+
   TraversalInfoType traversalInfo;
 
   //! The number of base cases.
@@ -17,20 +17,45 @@
 
 namespace mlpack {
 
-template<typename DistanceType, typename TreeType>
-RangeSearchRules<DistanceType, TreeType>::RangeSearchRules(
+template<typename DistanceType, typename TreeType, typename CallbackType>
+RangeSearchRules<DistanceType, TreeType, CallbackType>::RangeSearchRules(
     const MatType& referenceSet,
     const MatType& querySet,
     const RangeType<ElemType>& range,
     std::vector<std::vector<size_t> >& neighbors,
     std::vector<std::vector<ElemType> >& distances,
     DistanceType& distance,
-    const bool sameSet) :
+    const bool sameSet,
+    const double epsilon,
+    const size_t maxResults) :
+    RangeSearchRules(referenceSet, querySet, range,
+        CallbackType(neighbors, distances), distance, sameSet, epsilon,
+        maxResults)
+{
+  // Nothing to do.
+}
+
+template<typename DistanceType, typename TreeType, typename CallbackType>
+RangeSearchRules<DistanceType, TreeType, CallbackType>::RangeSearchRules(
+    const MatType& referenceSet,
+    const MatType& querySet,
+    const RangeType<ElemType>& range,
+    const CallbackType& callback,
+    DistanceType& distance,
+    const bool sameSet,
+    const double epsilon,
+    const size_t maxResults) :
     referenceSet(referenceSet),
     querySet(querySet),
     range(range),
-    neighbors(neighbors),
-    distances(distances),
+    innerRange(ElemType(range.Lo() * (1 + epsilon)),
+               ElemType(range.Hi() * (1 - epsilon))),
+    outerRange(ElemType(range.Lo() * (1 - epsilon)),
+               ElemType(range.Hi() * (1 + epsilon))),
+    maxResults(maxResults),
+    numResults(maxResults > 0 ?
+        new std::vector<size_t>(querySet.n_cols, 0) : NULL),
+    callback(callback),
     distance(distance),
     sameSet(sameSet),
     lastQueryIndex(querySet.n_cols),
@@ -43,10 +68,10 @@ RangeSearchRules<DistanceType, TreeType>::RangeSearchRules(
 
 //! The base case.  Evaluate the distance between the two points and add to the
 //! results if necessary.
-template<typename DistanceType, typename TreeType>
+template<typename DistanceType, typename TreeType, typename CallbackType>
 inline mlpack_force_inline
-typename RangeSearchRules<DistanceType, TreeType>::ElemType
-RangeSearchRules<DistanceType, TreeType>::BaseCase(
+typename RangeSearchRules<DistanceType, TreeType, CallbackType>::ElemType
+RangeSearchRules<DistanceType, TreeType, CallbackType>::BaseCase(
     const size_t queryIndex,
     const size_t referenceIndex)
 {
@@ -61,26 +86,30 @@ RangeSearchRules<DistanceType, TreeType>::BaseCase(
   const ElemType d = distance.Evaluate(querySet.unsafe_col(queryIndex),
       referenceSet.unsafe_col(referenceIndex));
   ++baseCases;
+  MLPACK_PROFILE_COUNT(BaseCases, 1);
+  MLPACK_PROFILE_COUNT(DistanceEvaluations, 1);
 
   // Update last indices, so we don't accidentally perform a base case twice.
   lastQueryIndex = queryIndex;
   lastReferenceIndex = referenceIndex;
 
-  if (range.Contains(d))
-  {
-    neighbors[queryIndex].push_back(referenceIndex);
-    distances[queryIndex].push_back(d);
-  }
+  if (range.Contains(d) && !Full(queryIndex))
+    Report(queryIndex, referenceIndex, d);
 
   return d;
 }
 
 //! Single-tree scoring function.
-template<typename DistanceType, typename TreeType>
-typename RangeSearchRules<DistanceType, TreeType>::ElemType
-RangeSearchRules<DistanceType, TreeType>::Score(const size_t queryIndex,
-                                                TreeType& referenceNode)
+template<typename DistanceType, typename TreeType, typename CallbackType>
+typename RangeSearchRules<DistanceType, TreeType, CallbackType>::ElemType
+RangeSearchRules<DistanceType, TreeType, CallbackType>::Score(
+    const size_t queryIndex,
+    TreeType& referenceNode)
 {
+  // Nothing more is needed for query points with enough results.
+  if (Full(queryIndex))
+    return DBL_MAX;
+
   // We must get the minimum and maximum distances and store them in this
   // object.
   RangeType<ElemType> distances;
@@ -117,15 +146,18 @@ RangeSearchRules<DistanceType, TreeType>::Score(const size_t queryIndex,
   {
     distances = referenceNode.RangeDistance(querySet.unsafe_col(queryIndex));
     ++scores;
+    MLPACK_PROFILE_COUNT(Scores, 1);
   }
 
-  // If the ranges do not overlap, prune this node.
-  if (!distances.Contains(range))
+  // If the ranges do not overlap, prune this node.  (For approximate search,
+  // the points whose distances are only in the widened range may be left out.)
+  if (!distances.Contains(innerRange))
     return DBL_MAX;
 
   // In this case, all of the points in the reference node will be part of the
   // results.
-  if ((distances.Lo() >= range.Lo()) && (distances.Hi() <= range.Hi()))
+  if ((distances.Lo() >= outerRange.Lo()) &&
+      (distances.Hi() <= outerRange.Hi()))
   {
     AddResult(queryIndex, referenceNode);
     return DBL_MAX; // We don't need to go any deeper.
@@ -137,9 +169,9 @@ RangeSearchRules<DistanceType, TreeType>::Score(const size_t queryIndex,
 }
 
 //! Single-tree rescoring function.
-template<typename DistanceType, typename TreeType>
-typename RangeSearchRules<DistanceType, TreeType>::ElemType
-RangeSearchRules<DistanceType, TreeType>::Rescore(
+template<typename DistanceType, typename TreeType, typename CallbackType>
+typename RangeSearchRules<DistanceType, TreeType, CallbackType>::ElemType
+RangeSearchRules<DistanceType, TreeType, CallbackType>::Rescore(
     const size_t /* queryIndex */,
     TreeType& /* referenceNode */,
     const ElemType oldScore) const
@@ -149,11 +181,16 @@ RangeSearchRules<DistanceType, TreeType>::Rescore(
 }
 
 //! Dual-tree scoring function.
-template<typename DistanceType, typename TreeType>
-typename RangeSearchRules<DistanceType, TreeType>::ElemType
-RangeSearchRules<DistanceType, TreeType>::Score(TreeType& queryNode,
-                                                TreeType& referenceNode)
+template<typename DistanceType, typename TreeType, typename CallbackType>
+typename RangeSearchRules<DistanceType, TreeType, CallbackType>::ElemType
+RangeSearchRules<DistanceType, TreeType, CallbackType>::Score(
+    TreeType& queryNode,
+    TreeType& referenceNode)
 {
+  // Nothing more is needed for query nodes whose points have enough results.
+  if (Full(queryNode))
+    return DBL_MAX;
+
   RangeType<ElemType> distances;
   if (TreeTraits<TreeType>::FirstPointIsCentroid)
   {
@@ -189,15 +226,17 @@ RangeSearchRules<DistanceType, TreeType>::Score(TreeType& queryNode,
     // Just perform the calculation.
     distances = referenceNode.RangeDistance(queryNode);
     ++scores;
+    MLPACK_PROFILE_COUNT(Scores, 1);
   }
 
   // If the ranges do not overlap, prune this node.
-  if (!distances.Contains(range))
+  if (!distances.Contains(innerRange))
     return DBL_MAX;
 
   // In this case, all of the points in the reference node will be part of all
   // the results for each point in the query node.
-  if ((distances.Lo() >= range.Lo()) && (distances.Hi() <= range.Hi()))
+  if ((distances.Lo() >= outerRange.Lo()) &&
+      (distances.Hi() <= outerRange.Hi()))
   {
     for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
       AddResult(queryNode.Descendant(i), referenceNode);
@@ -212,9 +251,9 @@ RangeSearchRules<DistanceType, TreeType>::Score(TreeType& queryNode,
 }
 
 //! Dual-tree rescoring function.
-template<typename DistanceType, typename TreeType>
-typename RangeSearchRules<DistanceType, TreeType>::ElemType
-RangeSearchRules<DistanceType, TreeType>::Rescore(
+template<typename DistanceType, typename TreeType, typename CallbackType>
+typename RangeSearchRules<DistanceType, TreeType, CallbackType>::ElemType
+RangeSearchRules<DistanceType, TreeType, CallbackType>::Rescore(
     TreeType& /* queryNode */,
     TreeType& /* referenceNode */,
     const ElemType oldScore) const
@@ -225,8 +264,8 @@ RangeSearchRules<DistanceType, TreeType>::Rescore(
 
 //! Add all the points in the given node to the results for the given query
 //! point.
-template<typename DistanceType, typename TreeType>
-void RangeSearchRules<DistanceType, TreeType>::AddResult(
+template<typename DistanceType, typename TreeType, typename CallbackType>
+void RangeSearchRules<DistanceType, TreeType, CallbackType>::AddResult(
     const size_t queryIndex, TreeType& referenceNode)
 {
   // Some types of trees calculate the base case evaluation before Score() is
@@ -240,14 +279,18 @@ void RangeSearchRules<DistanceType, TreeType>::AddResult(
     baseCaseMod = 1;
   }
 
-  // Resize distances and neighbors vectors appropriately.  We have to use
-  // reserve() and not resize(), because we don't know if we will encounter the
-  // case where the datasets and points are the same (and we skip in that case).
-  const size_t oldSize = neighbors[queryIndex].size();
-  neighbors[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
-      baseCaseMod);
-  distances[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
-      baseCaseMod);
+  // Resize distances and neighbors vectors appropriately, if the results are
+  // stored in vectors.  We have to use reserve() and not resize(), because we
+  // don't know if we will encounter the case where the datasets and points are
+  // the same (and we skip in that case).
+  if constexpr (std::is_same_v<CallbackType,
+                               RangeSearchVectorResults<ElemType>>)
+  {
+    size_t numNew = referenceNode.NumDescendants() - baseCaseMod;
+    if (maxResults > 0)
+      numNew = std::min(numNew, maxResults - (*numResults)[queryIndex]);
+    callback.Reserve(queryIndex, numNew);
+  }
 
   for (size_t i = baseCaseMod; i < referenceNode.NumDescendants(); ++i)
   {
@@ -255,14 +298,43 @@ void RangeSearchRules<DistanceType, TreeType>::AddResult(
         (queryIndex == referenceNode.Descendant(i)))
       continue;
 
+    if (Full(queryIndex))
+      break;
+
     const ElemType d = distance.Evaluate(querySet.unsafe_col(queryIndex),
         referenceNode.Dataset().unsafe_col(referenceNode.Descendant(i)));
+    MLPACK_PROFILE_COUNT(DistanceEvaluations, 1);
 
-    neighbors[queryIndex].push_back(referenceNode.Descendant(i));
-    distances[queryIndex].push_back(d);
+    Report(queryIndex, referenceNode.Descendant(i), d);
   }
 }
 
+template<typename DistanceType, typename TreeType, typename CallbackType>
+inline mlpack_force_inline
+void RangeSearchRules<DistanceType, TreeType, CallbackType>::Report(
+    const size_t queryIndex,
+    const size_t referenceIndex,
+    const ElemType d)
+{
+  callback(queryIndex, referenceIndex, d);
+  if (maxResults > 0)
+    ++(*numResults)[queryIndex];
+}
+
+template<typename DistanceType, typename TreeType, typename CallbackType>
+bool RangeSearchRules<DistanceType, TreeType, CallbackType>::Full(
+    TreeType& queryNode) const
+{
+  if (maxResults == 0)
+    return false;
+
+  for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+    if ((*numResults)[queryNode.Descendant(i)] < maxResults)
+      return false;
+
+  return true;
+}
+
 } // namespace mlpack
 
 #endif
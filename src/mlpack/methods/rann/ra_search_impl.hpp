@@ -264,22 +264,11 @@ Search(const MatType& querySet,
 
   if (naive)
   {
+    // The RASearchRules constructor samples enough reference points for each
+    // query point (in parallel), so there is nothing left to do.
     RuleType rules(*referenceSet, querySet, k, distance, tau, alpha, naive,
         sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
 
-    // Find how many samples from the reference set we need and sample uniformly
-    // from the reference set without replacement.
-    const size_t numSamples = RAUtil::MinimumSamplesReqd(referenceSet->n_cols,
-        k, tau, alpha);
-    arma::uvec distinctSamples = arma::randperm(referenceSet->n_cols,
-        numSamples);
-
-    // Run the base case on each combination of query point and sampled
-    // reference point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      for (size_t j = 0; j < distinctSamples.n_elem; ++j)
-        rules.BaseCase(i, (size_t) distinctSamples[j]);
-
     rules.GetResults(*neighborPtr, *distancePtr);
   }
   else if (singleMode)
@@ -293,12 +282,24 @@ Search(const MatType& querySet,
     {
       Log::Info << "Performing single-tree traversal..." << std::endl;
 
-      // Create the traverser.
-      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+      // Split the query points over threads.  Each thread has its own copy of
+      // the rules (which shares candidate lists with the original) and its own
+      // traverser.
+      size_t threadDistComputations = 0;
+      #pragma omp parallel reduction(+:threadDistComputations)
+      {
+        RuleType threadRules(rules);
+        typename Tree::template SingleTreeTraverser<RuleType>
+            traverser(threadRules);
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+        // Now have it traverse for each point.
+        #pragma omp for schedule(dynamic, 16)
+        for (size_t i = 0; i < querySet.n_cols; ++i)
+          traverser.Traverse(i, *referenceTree);
+
+        threadDistComputations += threadRules.NumDistComputations();
+      }
+      rules.NumDistComputations() += threadDistComputations;
 
       Log::Info << "Single-tree traversal complete." << std::endl;
       Log::Info << "Average number of distance calculations per query point: "
@@ -480,36 +481,30 @@ void RASearch<SortPolicy, DistanceType, MatType, TreeType>::Search(
   RuleType rules(*referenceSet, *referenceSet, k, distance, tau, alpha, naive,
       sampleAtLeaves, firstLeafExact, singleSampleLimit, true /* same sets */);
 
-  if (naive)
+  if (singleMode && !naive)
   {
-    // Find how many samples from the reference set we need and sample uniformly
-    // from the reference set without replacement.
-    const size_t numSamples = RAUtil::MinimumSamplesReqd(referenceSet->n_cols,
-        k, tau, alpha);
-    arma::uvec distinctSamples = arma::randperm(referenceSet->n_cols,
-        numSamples);
-
-    // The naive brute-force solution.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
-  }
-  else if (singleMode)
-  {
-    // Create the traverser.
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    // Split the query points over threads, just like in the bichromatic case.
+    #pragma omp parallel
+    {
+      RuleType threadRules(rules);
+      typename Tree::template SingleTreeTraverser<RuleType>
+          traverser(threadRules);
 
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+      // Now have it traverse for each point.
+      #pragma omp for schedule(dynamic, 16)
+      for (size_t i = 0; i < referenceSet->n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
+    }
   }
-  else
+  else if (!naive)
   {
     // Create the traverser.
     typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
     traverser.Traverse(*referenceTree, *referenceTree);
   }
+  // In naive mode, the RASearchRules constructor has already sampled enough
+  // reference points for each point.
 
   rules.GetResults(*neighborPtr, *distancePtr);
 
@@ -15,6 +15,7 @@
 #define MLPACK_METHODS_RANN_RA_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/methods/neighbor_search/blocked_brute_force.hpp>
 
 #include <queue>
 
@@ -44,7 +45,8 @@ class RASearchRules
    * @param alpha The desired success probability.
    * @param naive If true, the rank-approximate search will be performed by
    *      directly sampling the whole set instead of using the stratified
-   *      sampling on the tree.
+   *      sampling on the tree; the sampling is then done by the constructor
+   *      (see NaiveSample()).
    * @param sampleAtLeaves Sample at leaves for faster but less accurate
    *      computation.
    * @param firstLeafExact Traverse to the first leaf without approximation.
@@ -65,6 +67,23 @@ class RASearchRules
                 const size_t singleSampleLimit = 20,
                 const bool sameSet = false);
 
+  /**
+   * Copy the given RASearchRules object for use by a different thread of a
+   * parallel single-tree search.  The copy has its own traversal information
+   * and distance computation counter, but it shares the list of candidates and
+   * the number of samples made for each query point with the original object.
+   * So, the original object must outlive the copy, and any two copies must only
+   * be used to search for disjoint sets of query points.
+   *
+   * @param other RASearchRules object to share candidates with.
+   */
+  RASearchRules(const RASearchRules& other);
+
+  /**
+   * Delete the list of candidates, if this object owns it.
+   */
+  ~RASearchRules();
+
   /**
    * Store the list of candidates for each query point in the given matrices.
    *
@@ -226,7 +245,10 @@ class RASearchRules
                  const double oldScore);
 
 
-  size_t NumDistComputations() { return numDistComputations; }
+  //! Get the number of distance computations.
+  size_t NumDistComputations() const { return numDistComputations; }
+  //! Modify the number of distance computations.
+  size_t& NumDistComputations() { return numDistComputations; }
   size_t NumEffectiveSamples()
   {
     if (numSamplesMade.n_elem == 0)
@@ -267,8 +289,12 @@ class RASearchRules
   using CandidateList = std::priority_queue<Candidate, std::vector<Candidate>,
       CandidateCmp>;
 
-  //! Set of candidate neighbors for each point.
-  std::vector<CandidateList> candidates;
+  //! Set of candidate neighbors for each point.  This may be shared with other
+  //! copies of this object.
+  std::vector<CandidateList>* candidates;
+
+  //! If true, this object owns the candidate lists and must delete them.
+  bool ownsCandidates;
 
   //! Number of neighbors to search for.
   const size_t k;
@@ -288,7 +314,8 @@ class RASearchRules
   //! The minimum number of samples required per query.
   size_t numSamplesReqd;
 
-  //! The number of samples made for every query.
+  //! The number of samples made for every query.  For a copy of another
+  //! object, this is an alias of the original object's memory.
   arma::Col<size_t> numSamplesMade;
 
   //! The sampling ratio.
@@ -313,6 +340,16 @@ class RASearchRules
                       const size_t neighbor,
                       const double distance);
 
+  /**
+   * Sample numSamplesReqd distinct reference points uniformly for each query
+   * point, and insert them into the candidate lists.  Blocks of query points
+   * share the same sample, so that the distances between a block and its
+   * sample are computed at once and the blocks are processed in parallel.  For
+   * the Euclidean distance, BlockedBruteForceSearch() computes them with a
+   * single matrix multiplication per block.
+   */
+  void NaiveSample();
+
   /**
    * Perform actual scoring for single-tree case.
    */
@@ -32,6 +32,8 @@ RASearchRules(const arma::mat& referenceSet,
               const bool sameSet) :
     referenceSet(referenceSet),
     querySet(querySet),
+    candidates(new std::vector<CandidateList>()),
+    ownsCandidates(true),
     k(k),
     distance(distance),
     sampleAtLeaves(sampleAtLeaves),
@@ -77,21 +79,44 @@ RASearchRules(const arma::mat& referenceSet,
   std::vector<Candidate> vect(k, def);
   CandidateList pqueue(CandidateCmp(), std::move(vect));
 
-  candidates.reserve(querySet.n_cols);
+  candidates->reserve(querySet.n_cols);
   for (size_t i = 0; i < querySet.n_cols; ++i)
-    candidates.push_back(pqueue);
+    candidates->push_back(pqueue);
 
   if (naive) // No tree traversal; just do naive sampling here.
-  {
-    // Sample enough points.
-    arma::uvec distinctSamples;
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-    {
-      distinctSamples = arma::randperm(n, numSamplesReqd);
-      for (size_t j = 0; j < distinctSamples.n_elem; ++j)
-        BaseCase(i, (size_t) distinctSamples[j]);
-    }
-  }
+    NaiveSample();
+}
+
+template<typename SortPolicy, typename DistanceType, typename TreeType>
+RASearchRules<SortPolicy, DistanceType, TreeType>::
+RASearchRules(const RASearchRules& other) :
+    referenceSet(other.referenceSet),
+    querySet(other.querySet),
+    candidates(other.candidates),
+    ownsCandidates(false),
+    k(other.k),
+    distance(other.distance),
+    sampleAtLeaves(other.sampleAtLeaves),
+    firstLeafExact(other.firstLeafExact),
+    singleSampleLimit(other.singleSampleLimit),
+    numSamplesReqd(other.numSamplesReqd),
+    // Alias the memory of the other object, so that the number of samples for
+    // each query point is shared.
+    numSamplesMade(const_cast<size_t*>(other.numSamplesMade.memptr()),
+        other.numSamplesMade.n_elem, false, true),
+    samplingRatio(other.samplingRatio),
+    numDistComputations(0),
+    sameSet(other.sameSet),
+    traversalInfo(other.traversalInfo)
+{
+  // Nothing to do.
+}
+
+template<typename SortPolicy, typename DistanceType, typename TreeType>
+RASearchRules<SortPolicy, DistanceType, TreeType>::~RASearchRules()
+{
+  if (ownsCandidates)
+    delete candidates;
 }
 
 template<typename SortPolicy, typename DistanceType, typename TreeType>
@@ -104,7 +129,7 @@ void RASearchRules<SortPolicy, DistanceType, TreeType>::GetResults(
 
   for (size_t i = 0; i < querySet.n_cols; ++i)
   {
-    CandidateList& pqueue = candidates[i];
+    CandidateList& pqueue = (*candidates)[i];
     for (size_t j = 1; j <= k; ++j)
     {
       neighbors(k - j, i) = pqueue.top().second;
@@ -145,7 +170,7 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
   const arma::vec queryPoint = querySet.unsafe_col(queryIndex);
   const double d = SortPolicy::BestPointToNodeDistance(queryPoint,
       &referenceNode);
-  const double bestDistance = candidates[queryIndex].top().first;
+  const double bestDistance = (*candidates)[queryIndex].top().first;
 
   return Score(queryIndex, referenceNode, d, bestDistance);
 }
@@ -159,7 +184,7 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
   const arma::vec queryPoint = querySet.unsafe_col(queryIndex);
   const double d = SortPolicy::BestPointToNodeDistance(queryPoint,
       &referenceNode, baseCaseResult);
-  const double bestDistance = candidates[queryIndex].top().first;
+  const double bestDistance = (*candidates)[queryIndex].top().first;
 
   return Score(queryIndex, referenceNode, d, bestDistance);
 }
@@ -269,7 +294,7 @@ Rescore(const size_t queryIndex,
     return oldScore;
 
   // Just check the score again against the distances.
-  const double bestDistance = candidates[queryIndex].top().first;
+  const double bestDistance = (*candidates)[queryIndex].top().first;
 
   // If this is better than the best distance we've seen so far,
   // maybe there will be something down this node.
@@ -367,7 +392,7 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
 
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double bound = candidates[queryNode.Point(i)].top().first
+    const double bound = (*candidates)[queryNode.Point(i)].top().first
         + maxDescendantDistance;
     if (bound < pointBound)
       pointBound = bound;
@@ -406,7 +431,7 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
 
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double bound = candidates[queryNode.Point(i)].top().first
+    const double bound = (*candidates)[queryNode.Point(i)].top().first
         + maxDescendantDistance;
     if (bound < pointBound)
       pointBound = bound;
@@ -620,7 +645,7 @@ Rescore(TreeType& queryNode,
 
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double bound = candidates[queryNode.Point(i)].top().first
+    const double bound = (*candidates)[queryNode.Point(i)].top().first
         + maxDescendantDistance;
     if (bound < pointBound)
       pointBound = bound;
@@ -805,7 +830,7 @@ InsertNeighbor(
     const size_t neighbor,
     const double dist)
 {
-  CandidateList& pqueue = candidates[queryIndex];
+  CandidateList& pqueue = (*candidates)[queryIndex];
   Candidate c = std::make_pair(dist, neighbor);
 
   if (CandidateCmp()(c, pqueue.top()))
@@ -815,6 +840,93 @@ InsertNeighbor(
   }
 }
 
+template<typename SortPolicy, typename DistanceType, typename TreeType>
+void RASearchRules<SortPolicy, DistanceType, TreeType>::NaiveSample()
+{
+  // Every query point of a block gets the same numSamplesReqd distinct
+  // reference points, drawn uniformly; each query point is still sampled
+  // independently of the data, so the rank-approximation guarantee holds for
+  // each of them.
+  const size_t blockSize = 256;
+  const size_t numQueries = querySet.n_cols;
+  const size_t numBlocks = (numQueries + blockSize - 1) / blockSize;
+
+  // The random number generator is shared, so draw all the samples before the
+  // parallel section.
+  arma::umat samples(numSamplesReqd, numBlocks);
+  for (size_t b = 0; b < numBlocks; ++b)
+    samples.col(b) = arma::randperm(referenceSet.n_cols, numSamplesReqd);
+
+  size_t distComputations = 0;
+  #pragma omp parallel for schedule(dynamic) reduction(+:distComputations)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, numQueries);
+    const arma::uvec sample = samples.col(b);
+
+    if constexpr (UseBlockedBruteForce<DistanceType, arma::mat>::value)
+    {
+      arma::mat queries;
+      MakeAlias(queries, querySet, querySet.n_rows, end - begin,
+          begin * querySet.n_rows, false);
+      const arma::mat sampledReferences = referenceSet.cols(sample);
+
+      // If a query point was sampled itself, it may be one of its own best
+      // candidates, so one more candidate is needed.
+      const size_t numCandidates = std::min((size_t) sample.n_elem,
+          sameSet ? k + 1 : k);
+      arma::Mat<size_t> blockNeighbors;
+      arma::mat blockDistances;
+      BlockedBruteForceSearch<SortPolicy>(queries, sampledReferences,
+          numCandidates, distance, false, std::vector<bool>(), blockNeighbors,
+          blockDistances);
+
+      for (size_t q = begin; q < end; ++q)
+      {
+        for (size_t i = 0; i < numCandidates; ++i)
+        {
+          const size_t r = sample[blockNeighbors(i, q - begin)];
+          if (!sameSet || r != q)
+            InsertNeighbor(q, r, blockDistances(i, q - begin));
+        }
+      }
+    }
+    else
+    {
+      for (size_t q = begin; q < end; ++q)
+      {
+        for (size_t i = 0; i < sample.n_elem; ++i)
+        {
+          const size_t r = sample[i];
+          if (!sameSet || r != q)
+          {
+            InsertNeighbor(q, r, distance.Evaluate(querySet.unsafe_col(q),
+                referenceSet.unsafe_col(r)));
+          }
+        }
+      }
+    }
+
+    // Like BaseCase(), do not count a query point sampled itself.
+    numSamplesMade.subvec(begin, end - 1) += sample.n_elem;
+    distComputations += (end - begin) * sample.n_elem;
+    if (sameSet)
+    {
+      for (size_t i = 0; i < sample.n_elem; ++i)
+      {
+        if (sample[i] >= begin && sample[i] < end)
+        {
+          --numSamplesMade[sample[i]];
+          --distComputations;
+        }
+      }
+    }
+  }
+
+  numDistComputations += distComputations;
+}
+
 } // namespace mlpack
 
 #endif // MLPACK_METHODS_RANN_RA_SEARCH_RULES_IMPL_HPP
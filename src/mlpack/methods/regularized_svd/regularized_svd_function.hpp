@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_REGULARIZED_SVD_REGULARIZED_FUNCTION_SVD_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/optimizers/function_traits.hpp>
 #include <ensmallen.hpp>
 
 namespace mlpack {
@@ -93,6 +94,25 @@ class RegularizedSVDFunction
                 GradType& gradient,
                 const size_t batchSize = 1) const;
 
+  /**
+   * Take a stochastic gradient step for the given rating, in place.  Only the
+   * columns of the user and the item of the rating are written, so ratings
+   * that share no user and no item can be updated concurrently.  This is used
+   * by StratifiedSGD.
+   *
+   * @param parameters Parameters(user/item matrices) of the decomposition.
+   * @param i Index of the rating.
+   * @param stepSize Step size of the update.
+   */
+  void Update(arma::mat& parameters,
+              const size_t i,
+              const double stepSize) const;
+
+  //! Nothing to do at the end of a stratum of StratifiedSGD, since Update()
+  //! applies the whole step.
+  void FinishStratum(arma::mat& /* parameters */,
+                     const double /* stepSize */) const { }
+
   //! Return the initial point for the optimization.
   const arma::mat& GetInitialPoint() const { return initialPoint; }
 
@@ -129,6 +149,14 @@ class RegularizedSVDFunction
   size_t numItems;
 };
 
+//! The separable gradient only touches the users and items of the batch.
+template<typename MatType>
+class FunctionTraits<RegularizedSVDFunction<MatType>>
+{
+ public:
+  static const bool SparseGradient = true;
+};
+
 } // namespace mlpack
 
 namespace ens {
@@ -128,28 +128,84 @@ void RegularizedSVDFunction<MatType>::Gradient(const arma::mat& parameters,
                                                GradType& gradient,
                                                const size_t batchSize) const
 {
-  gradient.zeros(rank, numUsers + numItems);
-
-  // It's possible this could be SIMD-vectorized for additional speedup.
-  for (size_t i = start; i < start + batchSize; ++i)
+  if constexpr (arma::is_SpMat<GradType>::value)
   {
-    const size_t user = data(0, i);
-    const size_t item = data(1, i) + numUsers;
+    // Build the gradient directly from its nonzero elements: only the columns
+    // of the users and items of the batch are nonzero.
+    arma::umat locations(2, 2 * rank * batchSize);
+    arma::vec values(2 * rank * batchSize);
+    size_t n = 0;
+    for (size_t i = start; i < start + batchSize; ++i)
+    {
+      const size_t user = data(0, i);
+      const size_t item = data(1, i) + numUsers;
 
-    // Prediction error for the example.
-    const double rating = data(2, i);
-    double ratingError = rating - dot(parameters.col(user),
-                                            parameters.col(item));
+      const double ratingError = data(2, i) - dot(parameters.col(user),
+          parameters.col(item));
 
-    // Gradient is non-zero only for the parameter columns corresponding to the
-    // example.
-    gradient.col(user) += 2 * (lambda * parameters.col(user) -
-                               ratingError * parameters.col(item));
-    gradient.col(item) += 2 * (lambda * parameters.col(item) -
-                               ratingError * parameters.col(user));
+      for (size_t r = 0; r < rank; ++r, n += 2)
+      {
+        locations(0, n) = r;
+        locations(1, n) = user;
+        values[n] = 2 * (lambda * parameters(r, user) -
+            ratingError * parameters(r, item));
+        locations(0, n + 1) = r;
+        locations(1, n + 1) = item;
+        values[n + 1] = 2 * (lambda * parameters(r, item) -
+            ratingError * parameters(r, user));
+      }
+    }
+
+    // Duplicate locations (users or items seen twice) are summed.
+    gradient = GradType(true, locations, values, rank, numUsers + numItems);
+  }
+  else
+  {
+    gradient.zeros(rank, numUsers + numItems);
+
+    // It's possible this could be SIMD-vectorized for additional speedup.
+    for (size_t i = start; i < start + batchSize; ++i)
+    {
+      const size_t user = data(0, i);
+      const size_t item = data(1, i) + numUsers;
+
+      // Prediction error for the example.
+      const double rating = data(2, i);
+      double ratingError = rating - dot(parameters.col(user),
+                                        parameters.col(item));
+
+      // Gradient is non-zero only for the parameter columns corresponding to
+      // the example.
+      gradient.col(user) += 2 * (lambda * parameters.col(user) -
+                                 ratingError * parameters.col(item));
+      gradient.col(item) += 2 * (lambda * parameters.col(item) -
+                                 ratingError * parameters.col(user));
+    }
   }
 }
 
+template <typename MatType>
+void RegularizedSVDFunction<MatType>::Update(arma::mat& parameters,
+                                             const size_t i,
+                                             const double stepSize) const
+{
+  // Indices for accessing the the correct parameter columns.
+  const size_t user = data(0, i);
+  const size_t item = data(1, i) + numUsers;
+
+  // Prediction error for the example.
+  const double rating = data(2, i);
+  const double ratingError = rating - dot(parameters.col(user),
+                                          parameters.col(item));
+
+  // Both columns are updated with the gradient at the same point.
+  const arma::vec userVec = parameters.col(user);
+  parameters.col(user) -= stepSize * (lambda * userVec -
+                                      ratingError * parameters.col(item));
+  parameters.col(item) -= stepSize * (lambda * parameters.col(item) -
+                                      ratingError * userVec);
+}
+
 } // namespace mlpack
 
 // Template specialization for the SGD optimizer.
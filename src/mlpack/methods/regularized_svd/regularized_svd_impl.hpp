@@ -32,20 +32,29 @@ void RegularizedSVD<OptimizerType>::Apply(const arma::mat& data,
                                           arma::mat& u,
                                           arma::mat& v)
 {
-  // batchSize is 1 in our implementation of Regularized SVD.
-  // batchSize other than 1 has not been supported yet.
-  const int batchSize = 1;
-  Log::Warn << "The batch size for optimizing RegularizedSVD is 1."
-      << std::endl;
-
-  // Make the optimizer object using a RegularizedSVDFunction object.
+  // Make the RegularizedSVDFunction object to optimize.
   RegularizedSVDFunction<arma::mat> rSVDFunc(data, rank, lambda);
-  ens::StandardSGD optimizer(alpha, batchSize,
-      iterations * data.n_cols);
 
   // Get optimized parameters.
   arma::mat parameters = rSVDFunc.GetInitialPoint();
-  optimizer.Optimize(rSVDFunc, parameters);
+  if constexpr (std::is_same_v<OptimizerType, StratifiedSGD>)
+  {
+    // Each of the iterations is an epoch over all the ratings.
+    StratifiedSGD optimizer(alpha, iterations);
+    optimizer.Optimize(rSVDFunc, parameters);
+  }
+  else
+  {
+    // batchSize is 1 in our implementation of Regularized SVD.
+    // batchSize other than 1 has not been supported yet.
+    const int batchSize = 1;
+    Log::Warn << "The batch size for optimizing RegularizedSVD is 1."
+        << std::endl;
+
+    ens::StandardSGD optimizer(alpha, batchSize,
+        iterations * data.n_cols);
+    optimizer.Optimize(rSVDFunc, parameters);
+  }
 
   // Constants for extracting user and item matrices.
   const size_t numUsers = max(data.row(0)) + 1;
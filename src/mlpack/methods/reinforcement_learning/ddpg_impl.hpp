@@ -281,17 +281,7 @@ void DDPG<
   ReplayType
 >::SelectAction()
 {
-  // Get the action at current state, from policy.
-  arma::colvec outputAction;
-  policyNetwork.Predict(state.Encode(), outputAction);
-
-  if (!deterministic)
-  {
-    arma::colvec sample = noise.sample() * 0.1;
-    sample = arma::clamp(sample, -0.25, 0.25);
-    outputAction = outputAction + sample;
-  }
-  action.action = ConvTo<std::vector<double>>::From(outputAction);
+  ComputeAction(policyNetwork, noise, state, !deterministic, action);
 }
 
 template <
@@ -350,5 +340,96 @@ double DDPG<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename NoiseType,
+  typename UpdaterType,
+  typename ReplayType
+>
+double DDPG<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  NoiseType,
+  UpdaterType,
+  ReplayType
+>::ParallelTrain(
+    const size_t numActors,
+    const size_t steps,
+    const double updateToDataRatio,
+    const size_t syncInterval)
+{
+  ParallelActorLearner<EnvironmentType, PolicyNetworkType> learner(numActors,
+      updateToDataRatio, syncInterval);
+
+  // Each actor explores with its own copy of the noise.
+  auto makeSelector = [this]()
+  {
+    return [this, actorNoise = NoiseType(noise)](PolicyNetworkType& network,
+        const StateType& actorState, ActionType& actorAction) mutable
+    {
+      ComputeAction(network, actorNoise, actorState, !deterministic,
+          actorAction);
+    };
+  };
+
+  auto store = [this](const StateType& transitionState,
+                      const ActionType& transitionAction,
+                      const double reward,
+                      const StateType& nextState,
+                      const bool isEnd)
+  {
+    replayMethod.Store(transitionState, transitionAction, reward, nextState,
+        isEnd, config.Discount());
+    ++totalSteps;
+  };
+
+  const std::vector<double> returns = learner.Run(steps, config, environment,
+      policyNetwork, makeSelector, store, [this]() { Update(); });
+
+  if (returns.empty())
+    return 0.0;
+
+  return std::accumulate(returns.begin(), returns.end(), 0.0) /
+      returns.size();
+}
+
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename NoiseType,
+  typename UpdaterType,
+  typename ReplayType
+>
+void DDPG<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  NoiseType,
+  UpdaterType,
+  ReplayType
+>::ComputeAction(
+    PolicyNetworkType& network,
+    NoiseType& explorationNoise,
+    const StateType& currentState,
+    const bool explore,
+    ActionType& selectedAction)
+{
+  // Get the action at the given state, from the policy.
+  arma::colvec outputAction;
+  network.Predict(currentState.Encode(), outputAction);
+
+  if (explore)
+  {
+    arma::colvec sample = explorationNoise.sample() * 0.1;
+    sample = arma::clamp(sample, -0.25, 0.25);
+    outputAction = outputAction + sample;
+  }
+  selectedAction.action = ConvTo<std::vector<double>>::From(outputAction);
+}
+
 } // namespace mlpack
 #endif
@@ -0,0 +1,178 @@
+/**
+ * @file methods/reinforcement_learning/environment/vector_env.hpp
+ *
+ * A wrapper that steps several copies of an environment in lockstep.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_ENVIRONMENT_VECTOR_ENV_HPP
+#define MLPACK_METHODS_RL_ENVIRONMENT_VECTOR_ENV_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * VectorEnv holds several independent copies of an environment and steps all
+ * of them at once.  The encoded states of all copies are kept as the columns of
+ * a single matrix, so that an agent can compute the action values of every
+ * copy with one batched forward pass of its network, instead of one forward
+ * pass per copy.
+ *
+ * When a copy reaches a terminal state during `Step()`, it is automatically
+ * reset with `InitialSample()`; the terminal state itself is still available
+ * through `NextStates()` (and `NextState(i)`), so the transition can be stored
+ * for replay.
+ *
+ * @code
+ * VectorEnv<CartPole> envs(8);
+ * envs.InitialSample();
+ *
+ * arma::mat actionValues;
+ * network.Predict(envs.EncodedStates(), actionValues);
+ * // ... choose one action per column, then:
+ * arma::rowvec rewards;
+ * arma::irowvec terminal;
+ * envs.Step(actions, rewards, terminal);
+ * @endcode
+ *
+ * @tparam EnvironmentType The type of environment to step.
+ */
+template<typename EnvironmentType>
+class VectorEnv
+{
+ public:
+  //! Convenient typedef for state.
+  using StateType = typename EnvironmentType::State;
+
+  //! Convenient typedef for action.
+  using ActionType = typename EnvironmentType::Action;
+
+  /**
+   * Create the given number of copies of the given environment.  Call
+   * `InitialSample()` before the first `Step()`.
+   *
+   * @param numEnvs Number of environment copies.
+   * @param environment Environment to copy.
+   */
+  VectorEnv(const size_t numEnvs,
+            const EnvironmentType& environment = EnvironmentType()) :
+      environments(numEnvs, environment),
+      states(numEnvs),
+      nextStates(numEnvs)
+  {
+    if (numEnvs == 0)
+    {
+      throw std::invalid_argument("VectorEnv: the number of environments must "
+          "be positive!");
+    }
+  }
+
+  /**
+   * Reset every copy to an initial state.
+   *
+   * @return The encoded initial states, one column per copy.
+   */
+  const arma::mat& InitialSample()
+  {
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      states[i] = environments[i].InitialSample();
+      if (i == 0)
+        encodedStates.set_size(states[0].Encode().n_elem, environments.size());
+      encodedStates.col(i) = states[i].Encode();
+    }
+
+    return encodedStates;
+  }
+
+  /**
+   * Apply one action to each copy.  Copies that reach a terminal state are
+   * reset; after this call, `EncodedStates()` holds the states to act on next,
+   * and `EncodedNextStates()` holds the states that the actions led to.
+   *
+   * @param actions The action to apply to each copy.
+   * @param rewards The reward of each copy.
+   * @param terminal Whether each copy reached a terminal state (and was
+   *     reset).
+   */
+  void Step(const std::vector<ActionType>& actions,
+            arma::rowvec& rewards,
+            arma::irowvec& terminal)
+  {
+    if (actions.size() != environments.size())
+    {
+      std::ostringstream oss;
+      oss << "VectorEnv::Step(): got " << actions.size() << " actions, but "
+          << "there are " << environments.size() << " environments!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    if (encodedStates.n_cols != environments.size())
+    {
+      throw std::invalid_argument("VectorEnv::Step(): InitialSample() must be "
+          "called first!");
+    }
+
+    rewards.set_size(environments.size());
+    terminal.set_size(environments.size());
+    encodedNextStates.set_size(encodedStates.n_rows, environments.size());
+
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      rewards[i] = environments[i].Sample(states[i], actions[i],
+          nextStates[i]);
+      terminal[i] = environments[i].IsTerminal(nextStates[i]);
+      encodedNextStates.col(i) = nextStates[i].Encode();
+
+      states[i] = terminal[i] ? environments[i].InitialSample() :
+          nextStates[i];
+      encodedStates.col(i) = states[i].Encode();
+    }
+  }
+
+  //! Get the number of environment copies.
+  size_t NumEnvs() const { return environments.size(); }
+
+  //! Get the given environment copy.
+  const EnvironmentType& Environment(const size_t i) const
+  { return environments[i]; }
+  //! Modify the given environment copy.
+  EnvironmentType& Environment(const size_t i) { return environments[i]; }
+
+  //! Get the current state of the given copy.
+  const StateType& State(const size_t i) const { return states[i]; }
+  //! Get the current states of all copies.
+  const std::vector<StateType>& States() const { return states; }
+  //! Get the encoded current states, one column per copy.
+  const arma::mat& EncodedStates() const { return encodedStates; }
+
+  //! Get the state that the last step led to for the given copy (before any
+  //! reset).
+  const StateType& NextState(const size_t i) const { return nextStates[i]; }
+  //! Get the encoded states that the last step led to, one column per copy.
+  const arma::mat& EncodedNextStates() const { return encodedNextStates; }
+
+ private:
+  //! The environment copies.
+  std::vector<EnvironmentType> environments;
+
+  //! The current state of each copy.
+  std::vector<StateType> states;
+
+  //! The state that the last step led to, for each copy.
+  std::vector<StateType> nextStates;
+
+  //! The encoded current states.
+  arma::mat encodedStates;
+
+  //! The encoded states that the last step led to.
+  arma::mat encodedNextStates;
+};
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,142 @@
+/**
+ * @file methods/reinforcement_learning/parallel_actor_learner.hpp
+ *
+ * Definition of the ParallelActorLearner class, which collects experience with
+ * several actor threads while the calling thread learns from it.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_PARALLEL_ACTOR_LEARNER_HPP
+#define MLPACK_METHODS_RL_PARALLEL_ACTOR_LEARNER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "training_config.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+namespace mlpack {
+
+/**
+ * The ParallelActorLearner runs the actor-learner loop of off-policy agents
+ * (DDPG, TD3 and SAC): several actor threads interact with their own copy of
+ * the environment, choosing actions with their own copy of the policy network,
+ * while the calling (learner) thread stores the transitions they collect into
+ * the replay memory and updates the networks.
+ *
+ * The learner performs `UpdateToDataRatio()` updates per collected transition
+ * (once `ExplorationSteps()` transitions have been collected), independently of
+ * the speed of the actors, and publishes the parameters of the policy network
+ * to the actors every `SyncInterval()` updates; the actors pick up the new
+ * parameters before their next step.  Only the learner thread accesses the
+ * replay memory and the learning networks, so any replay type can be used; note
+ * however that the transitions of the actors are stored in the order they
+ * arrive, so a replay with n-step returns (nSteps > 1) would mix the
+ * transitions of different actors.
+ *
+ * The agents provide a `ParallelTrain()` function that uses this class; it can
+ * also be used directly to build other actor-learner agents.
+ *
+ * @tparam EnvironmentType The environment of the reinforcement learning task.
+ * @tparam PolicyNetworkType The network used by the actors to choose actions.
+ */
+template<typename EnvironmentType, typename PolicyNetworkType>
+class ParallelActorLearner
+{
+ public:
+  //! Convenient typedef for state.
+  using StateType = typename EnvironmentType::State;
+  //! Convenient typedef for action.
+  using ActionType = typename EnvironmentType::Action;
+
+  /**
+   * Create the ParallelActorLearner object.
+   *
+   * @param numActors Number of actor threads.
+   * @param updateToDataRatio Number of updates per collected transition.
+   * @param syncInterval Number of updates between two copies of the policy
+   *     parameters to the actors.
+   */
+  ParallelActorLearner(const size_t numActors = 4,
+                       const double updateToDataRatio = 1.0,
+                       const size_t syncInterval = 1);
+
+  /**
+   * Collect `steps` transitions with the actors (in episodes of at most
+   * `config.StepLimit()` steps, if it is not 0), while the calling thread
+   * stores them and performs the updates.  Any exception thrown by an actor is
+   * rethrown once all the actors have stopped.
+   *
+   * `makeSelector()` is called once for each actor thread, and must return a
+   * function object `selector(network, state, action)` that sets `action` to
+   * the (exploratory) action for `state` given by the actor's copy of the
+   * policy `network`; this allows each actor to hold its own exploration noise.
+   * `store(state, action, reward, nextState, isEnd)` and `update()` are only
+   * called by the calling thread.
+   *
+   * @param steps Number of transitions to collect.
+   * @param config Hyper-parameters for training (StepLimit() and
+   *     ExplorationSteps() are used).
+   * @param environment Environment, copied for each actor.
+   * @param policy Policy network updated by `update()`, copied for each actor.
+   * @param makeSelector Function that creates the action selector of an actor.
+   * @param store Function that stores a transition.
+   * @param update Function that performs one update.
+   * @return The returns of the episodes that the actors completed.
+   */
+  template<typename SelectorFactoryType, typename StoreType, typename UpdateType>
+  std::vector<double> Run(const size_t steps,
+                          const TrainingConfig& config,
+                          const EnvironmentType& environment,
+                          PolicyNetworkType& policy,
+                          SelectorFactoryType makeSelector,
+                          StoreType store,
+                          UpdateType update);
+
+  //! Get the number of actor threads.
+  size_t NumActors() const { return numActors; }
+  //! Modify the number of actor threads.
+  size_t& NumActors() { return numActors; }
+
+  //! Get the number of updates per collected transition.
+  double UpdateToDataRatio() const { return updateToDataRatio; }
+  //! Modify the number of updates per collected transition.
+  double& UpdateToDataRatio() { return updateToDataRatio; }
+
+  //! Get the number of updates between two syncs of the actors.
+  size_t SyncInterval() const { return syncInterval; }
+  //! Modify the number of updates between two syncs of the actors.
+  size_t& SyncInterval() { return syncInterval; }
+
+ private:
+  //! A transition collected by an actor.
+  struct Transition
+  {
+    StateType state;
+    ActionType action;
+    double reward;
+    StateType nextState;
+    bool isEnd;
+  };
+
+  //! Locally-stored number of actor threads.
+  size_t numActors;
+  //! Locally-stored number of updates per collected transition.
+  double updateToDataRatio;
+  //! Locally-stored number of updates between two syncs of the actors.
+  size_t syncInterval;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_actor_learner_impl.hpp"
+
+#endif
@@ -0,0 +1,225 @@
+/**
+ * @file methods/reinforcement_learning/parallel_actor_learner_impl.hpp
+ *
+ * Implementation of the ParallelActorLearner class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_PARALLEL_ACTOR_LEARNER_IMPL_HPP
+#define MLPACK_METHODS_RL_PARALLEL_ACTOR_LEARNER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "parallel_actor_learner.hpp"
+
+namespace mlpack {
+
+template<typename EnvironmentType, typename PolicyNetworkType>
+ParallelActorLearner<EnvironmentType, PolicyNetworkType>::ParallelActorLearner(
+    const size_t numActors,
+    const double updateToDataRatio,
+    const size_t syncInterval) :
+    numActors(numActors),
+    updateToDataRatio(updateToDataRatio),
+    syncInterval(syncInterval)
+{
+  if (numActors == 0)
+  {
+    throw std::invalid_argument("ParallelActorLearner: the number of actors "
+        "must be positive");
+  }
+
+  if (syncInterval == 0)
+  {
+    throw std::invalid_argument("ParallelActorLearner: the sync interval must "
+        "be positive");
+  }
+}
+
+template<typename EnvironmentType, typename PolicyNetworkType>
+template<typename SelectorFactoryType, typename StoreType, typename UpdateType>
+std::vector<double>
+ParallelActorLearner<EnvironmentType, PolicyNetworkType>::Run(
+    const size_t steps,
+    const TrainingConfig& config,
+    const EnvironmentType& environment,
+    PolicyNetworkType& policy,
+    SelectorFactoryType makeSelector,
+    StoreType store,
+    UpdateType update)
+{
+  // Transitions collected by the actors and not stored yet, and the returns of
+  // the finished episodes.
+  std::mutex queueMutex;
+  std::condition_variable queueReady;
+  std::vector<Transition> queue;
+  std::vector<double> returns;
+  size_t actorsDone = 0;
+  std::exception_ptr error;
+
+  // The policy parameters published to the actors, and their version.
+  std::mutex policyMutex;
+  typename std::decay<decltype(policy.Parameters())>::type
+      publishedParameters = policy.Parameters();
+  std::atomic<size_t> policyVersion(0);
+
+  // Each actor claims one step at a time, so exactly `steps` transitions are
+  // collected.
+  std::atomic<size_t> claimedSteps(0);
+
+  // The copies used by the actors are made before `policy` can be updated.
+  std::vector<EnvironmentType> environments(numActors, environment);
+  std::vector<PolicyNetworkType> networks(numActors, policy);
+  std::vector<decltype(makeSelector())> selectors;
+  for (size_t i = 0; i < numActors; ++i)
+    selectors.push_back(makeSelector());
+
+  auto actor = [&](const size_t id)
+  {
+    try
+    {
+      EnvironmentType& actorEnvironment = environments[id];
+      PolicyNetworkType& network = networks[id];
+      auto& selector = selectors[id];
+      size_t version = 0;
+
+      StateType state = actorEnvironment.InitialSample();
+      size_t episodeSteps = 0;
+      double episodeReturn = 0.0;
+      while (claimedSteps.fetch_add(1) < steps)
+      {
+        if (policyVersion.load() != version)
+        {
+          std::lock_guard<std::mutex> lock(policyMutex);
+          network.Parameters() = publishedParameters;
+          version = policyVersion.load();
+        }
+
+        ActionType action;
+        selector(network, state, action);
+
+        StateType nextState;
+        const double reward = actorEnvironment.Sample(state, action,
+            nextState);
+        const bool isEnd = actorEnvironment.IsTerminal(nextState);
+        episodeReturn += reward;
+        ++episodeSteps;
+
+        const bool episodeOver = isEnd ||
+            (config.StepLimit() && episodeSteps >= config.StepLimit());
+        {
+          std::lock_guard<std::mutex> lock(queueMutex);
+          queue.push_back({ state, action, reward, nextState, isEnd });
+          if (episodeOver)
+            returns.push_back(episodeReturn);
+        }
+        queueReady.notify_one();
+
+        if (episodeOver)
+        {
+          state = actorEnvironment.InitialSample();
+          episodeSteps = 0;
+          episodeReturn = 0.0;
+        }
+        else
+        {
+          state = nextState;
+        }
+      }
+    }
+    catch (...)
+    {
+      // Stop the other actors too.
+      claimedSteps.store(steps);
+      std::lock_guard<std::mutex> lock(queueMutex);
+      if (!error)
+        error = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      ++actorsDone;
+    }
+    queueReady.notify_one();
+  };
+
+  std::vector<std::thread> actors;
+  for (size_t i = 0; i < numActors; ++i)
+    actors.emplace_back(actor, i);
+
+  // The learner stores the transitions in the order they arrive, and performs
+  // the updates that the new transitions are owed.  An error of the learner
+  // stops the actors before it is rethrown.
+  auto learn = [&]()
+  {
+    std::vector<Transition> batch;
+    size_t stored = 0;
+    size_t updates = 0;
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true)
+    {
+      queueReady.wait(lock, [&]()
+      {
+        return !queue.empty() || actorsDone == numActors;
+      });
+      if (queue.empty())
+        break;
+
+      batch.swap(queue);
+      lock.unlock();
+
+      for (Transition& t : batch)
+      {
+        store(t.state, t.action, t.reward, t.nextState, t.isEnd);
+        ++stored;
+        if (stored < config.ExplorationSteps())
+          continue;
+
+        const size_t owedUpdates = (size_t) ((stored + 1 -
+            config.ExplorationSteps()) * updateToDataRatio);
+        while (updates < owedUpdates)
+        {
+          update();
+          ++updates;
+          if (updates % syncInterval == 0)
+          {
+            {
+              std::lock_guard<std::mutex> policyLock(policyMutex);
+              publishedParameters = policy.Parameters();
+            }
+            ++policyVersion;
+          }
+        }
+      }
+
+      batch.clear();
+      lock.lock();
+    }
+  };
+
+  try
+  {
+    learn();
+  }
+  catch (...)
+  {
+    claimedSteps.store(steps);
+    for (size_t i = 0; i < actors.size(); ++i)
+      actors[i].join();
+    throw;
+  }
+
+  for (size_t i = 0; i < actors.size(); ++i)
+    actors[i].join();
+
+  if (error)
+    std::rethrow_exception(error);
+
+  return returns;
+}
+
+} // namespace mlpack
+
+#endif
@@ -38,7 +38,8 @@ class AggregatedPolicy
   AggregatedPolicy(std::vector<PolicyType> policies,
                    const arma::colvec& distribution) :
       policies(std::move(policies)),
-      sampler({distribution})
+      sampler({distribution}),
+      cumulativeDistribution(arma::cumsum(distribution))
   { /* Nothing to do here. */ };
 
   /**
@@ -56,6 +57,73 @@ class AggregatedPolicy
     return policies[selected].Sample(actionValue, false);
   }
 
+  /**
+   * Sample an action for each column of the given matrix of action values
+   * (one column per state), selecting a child policy for each column, using
+   * mlpack's random number generator of the calling thread.
+   *
+   * @param actionValues Values of each action (one row per action, one column
+   *     per state).
+   * @param actions Vector to store the sampled actions in.
+   * @param deterministic Always select the actions greedily.
+   */
+  void Sample(const arma::mat& actionValues,
+              std::vector<ActionType>& actions,
+              const bool deterministic = false)
+  {
+    Sample(actionValues, actions, deterministic, RandGen());
+  }
+
+  /**
+   * Sample an action for each column of the given matrix of action values,
+   * drawing the random numbers from the given generator.  The columns that
+   * select the same child policy are sampled together by that policy.
+   *
+   * @param actionValues Values of each action (one row per action, one column
+   *     per state).
+   * @param actions Vector to store the sampled actions in.
+   * @param deterministic Always select the actions greedily.
+   * @param rng Random number generator to use.
+   */
+  template<typename RNGType>
+  void Sample(const arma::mat& actionValues,
+              std::vector<ActionType>& actions,
+              const bool deterministic,
+              RNGType& rng)
+  {
+    if (deterministic)
+    {
+      policies.front().Sample(actionValues, actions, true, false, rng);
+      return;
+    }
+
+    // Select the child policy of each column.
+    std::uniform_real_distribution<> uniform(0.0, 1.0);
+    std::vector<std::vector<arma::uword>> columns(policies.size());
+    for (size_t i = 0; i < actionValues.n_cols; ++i)
+    {
+      const double u = uniform(rng) * cumulativeDistribution.back();
+      size_t selected = std::upper_bound(cumulativeDistribution.begin(),
+          cumulativeDistribution.end(), u) - cumulativeDistribution.begin();
+      selected = std::min(selected, policies.size() - 1);
+      columns[selected].push_back(i);
+    }
+
+    actions.resize(actionValues.n_cols);
+    std::vector<ActionType> childActions;
+    for (size_t p = 0; p < policies.size(); ++p)
+    {
+      if (columns[p].empty())
+        continue;
+
+      const arma::uvec indices(columns[p]);
+      const arma::mat childActionValues = actionValues.cols(indices);
+      policies[p].Sample(childActionValues, childActions, false, false, rng);
+      for (size_t i = 0; i < indices.n_elem; ++i)
+        actions[indices[i]] = childActions[i];
+    }
+  }
+
   /**
    * Exploration probability will anneal at each step.
    */
@@ -71,6 +139,10 @@ class AggregatedPolicy
 
   //! Locally-stored sampler under the given distribution.
   DiscreteDistribution<> sampler;
+
+  //! Locally-stored cumulative distribution of the child policies, for
+  //! batched sampling.
+  arma::colvec cumulativeDistribution;
 };
 
 } // namespace mlpack
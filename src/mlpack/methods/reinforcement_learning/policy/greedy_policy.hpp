@@ -83,6 +83,67 @@ class GreedyPolicy
     return action;
   }
 
+  /**
+   * Sample an action for each column of the given matrix of action values
+   * (one column per state, e.g. for vectorized environments), using mlpack's
+   * random number generator of the calling thread.
+   *
+   * @param actionValues Values of each action (one row per action, one column
+   *     per state).
+   * @param actions Vector to store the sampled actions in.
+   * @param deterministic Always select the actions greedily.
+   * @param isNoisy Specifies whether the network used is noisy.
+   */
+  void Sample(const arma::mat& actionValues,
+              std::vector<ActionType>& actions,
+              const bool deterministic = false,
+              const bool isNoisy = false)
+  {
+    Sample(actionValues, actions, deterministic, isNoisy, RandGen());
+  }
+
+  /**
+   * Sample an action for each column of the given matrix of action values,
+   * drawing the random numbers from the given generator (for instance, one
+   * generator per worker thread or per environment).
+   *
+   * @param actionValues Values of each action (one row per action, one column
+   *     per state).
+   * @param actions Vector to store the sampled actions in.
+   * @param deterministic Always select the actions greedily.
+   * @param isNoisy Specifies whether the network used is noisy.
+   * @param rng Random number generator to use.
+   */
+  template<typename RNGType>
+  void Sample(const arma::mat& actionValues,
+              std::vector<ActionType>& actions,
+              const bool deterministic,
+              const bool isNoisy,
+              RNGType& rng)
+  {
+    std::uniform_real_distribution<> uniform(0.0, 1.0);
+    std::uniform_int_distribution<size_t> randomAction(0,
+        ActionType::size - 1);
+    const bool explore = !deterministic && !isNoisy;
+
+    actions.resize(actionValues.n_cols);
+    for (size_t i = 0; i < actionValues.n_cols; ++i)
+    {
+      // Select the action randomly.
+      if (explore && uniform(rng) < epsilon)
+      {
+        actions[i].action = static_cast<decltype(actions[i].action)>(
+            randomAction(rng));
+      }
+      // Select the action greedily (the first one, in case of ties).
+      else
+      {
+        actions[i].action = static_cast<decltype(actions[i].action)>(
+            actionValues.col(i).index_max());
+      }
+    }
+  }
+
   /**
    * Exploration probability will anneal at each step.
    */
@@ -16,6 +16,7 @@
 #include <mlpack/core.hpp>
 #include <mlpack/methods/ann/ann.hpp>
 
+#include "environment/vector_env.hpp"
 #include "replay/replay.hpp"
 #include "training_config.hpp"
 
@@ -109,6 +110,22 @@ class QLearning
    */
   double Episode();
 
+  /**
+   * Take the given number of steps in all the copies of a vectorized
+   * environment at once.  At each step, the action values of every copy are
+   * computed with a single forward pass of the network; then each transition
+   * is stored for replay, and the agent is trained once.  Copies that reach a
+   * terminal state are reset by the VectorEnv, so unlike Episode(), a rollout
+   * can span several episodes of each copy.  n-step replay is not supported,
+   * since the transitions of the copies are interleaved.
+   *
+   * @param environments The environment copies to step.  If
+   *     `InitialSample()` has not been called yet, it is called here.
+   * @param steps Number of steps to take in each copy.
+   * @return Sum of the rewards of all copies over the rollout.
+   */
+  double Rollout(VectorEnv<EnvironmentType>& environments, const size_t steps);
+
   //! Modify total steps from beginning.
   size_t& TotalSteps() { return totalSteps; }
   //! Get total steps from beginning.
@@ -238,9 +238,11 @@ void QLearning<
 
   size_t batchSize = sampledNextStates.n_cols;
 
-  // Compute action value for next state with target network.
-  arma::mat nextActionValues;
-  targetNetwork.Predict(sampledNextStates, nextActionValues);
+  // Compute the distributions of the next states with the target network.
+  // The action values are the expectations of these distributions, so they are
+  // computed from them instead of with a second pass through the network.
+  arma::mat nextDists;
+  targetNetwork.Forward(sampledNextStates, nextDists);
 
   arma::Col<size_t> nextAction;
   if (config.DoubleQLearning())
@@ -252,11 +254,17 @@ void QLearning<
   }
   else
   {
+    const size_t numActions = nextDists.n_rows / atomSize;
+    arma::mat nextActionValues(numActions, batchSize);
+    for (size_t a = 0; a < numActions; ++a)
+    {
+      nextActionValues.row(a) = support.t() * nextDists.rows(a * atomSize,
+          (a + 1) * atomSize - 1);
+    }
     nextAction = BestAction(nextActionValues);
   }
 
-  arma::mat nextDists, nextDist(atomSize, batchSize);
-  targetNetwork.Forward(sampledNextStates, nextDists);
+  arma::mat nextDist(atomSize, batchSize);
   for (size_t i = 0; i < batchSize; ++i)
   {
     nextDist.col(i) = nextDists(nextAction(i) * atomSize, i,
@@ -274,7 +282,10 @@ void QLearning<
   arma::mat projDistUpper = nextDist % (u - b);
   arma::mat projDistLower = nextDist % (b - l);
 
+  // The projection of each sample only touches its own column, so the samples
+  // are projected in parallel.
   arma::mat projDist = zeros<arma::mat>(arma::size(nextDist));
+  #pragma omp parallel for schedule(static)
   for (size_t batchNo = 0; batchNo < batchSize; batchNo++)
   {
     for (size_t j = 0; j < atomSize; j++)
@@ -388,6 +399,84 @@ double QLearning<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+double QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::Rollout(VectorEnv<EnvironmentType>& environments, const size_t steps)
+{
+  if (replayMethod.NSteps() > 1)
+  {
+    throw std::invalid_argument("QLearning::Rollout(): n-step replay cannot be "
+        "used with a vectorized environment!");
+  }
+
+  const size_t numEnvs = environments.NumEnvs();
+  if (environments.EncodedStates().n_cols != numEnvs)
+    environments.InitialSample();
+
+  // Track the total reward of all copies.
+  double totalReturn = 0.0;
+
+  arma::mat actionValues;
+  std::vector<ActionType> actions(numEnvs);
+  arma::rowvec rewards;
+  arma::irowvec terminal;
+  for (size_t step = 0; step < steps; ++step)
+  {
+    // Get the action values of all copies in one pass, and select an action
+    // for each of them according to the behavior policy.
+    learningNetwork.Predict(environments.EncodedStates(), actionValues);
+    for (size_t i = 0; i < numEnvs; ++i)
+    {
+      actions[i] = policy.Sample(actionValues.col(i), deterministic,
+          config.NoisyQLearning());
+    }
+
+    // Step() may reset some copies; so, keep the states we acted on.
+    const std::vector<StateType> states = environments.States();
+    environments.Step(actions, rewards, terminal);
+
+    totalReturn += arma::accu(rewards);
+    totalSteps += numEnvs;
+
+    // Store the transitions for replay.
+    for (size_t i = 0; i < numEnvs; ++i)
+    {
+      replayMethod.Store(states[i], actions[i], rewards[i],
+          environments.NextState(i), terminal[i], config.Discount());
+    }
+
+    if (deterministic || totalSteps < config.ExplorationSteps())
+      continue;
+    if (config.IsCategorical())
+      TrainCategoricalAgent();
+    else
+      TrainAgent();
+
+    // The target network is synchronized when totalSteps is a multiple of the
+    // sync interval; since totalSteps advances by numEnvs at once, we may have
+    // passed such a multiple without landing on it.
+    const size_t interval = config.TargetNetworkSyncInterval();
+    if (totalSteps % interval != 0 &&
+        totalSteps / interval != (totalSteps - numEnvs) / interval)
+    {
+      targetNetwork.Parameters() = learningNetwork.Parameters();
+    }
+  }
+
+  return totalReturn;
+}
+
 } // namespace mlpack
 
 #endif
@@ -21,6 +21,7 @@
 
 #include "training_config.hpp"
 #include "async_learning.hpp"
+#include "parallel_actor_learner.hpp"
 #include "q_learning.hpp"
 #include "ddpg.hpp"
 #include "td3.hpp"
@@ -0,0 +1,504 @@
+/**
+ * @file methods/reinforcement_learning/replay/concurrent_prioritized_replay.hpp
+ *
+ * This file is an implementation of a sharded prioritized experience replay
+ * that can be filled by several actor threads at once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_CONCURRENT_PRIORITIZED_REPLAY_HPP
+#define MLPACK_METHODS_RL_CONCURRENT_PRIORITIZED_REPLAY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include "sumtree.hpp"
+
+namespace mlpack {
+
+/**
+ * Implementation of a prioritized experience replay that is safe to use with
+ * many concurrent actors, as in Ape-X style distributed DQN.  The memory is
+ * split into shards, each with its own storage, SumTree of priorities, n-step
+ * buffer and mutex.  Each actor thread should store its transitions into its
+ * own shard with `Store(shard, ...)`, so actors never contend with each other;
+ * the only contention is with the learner, which locks a shard briefly when
+ * it samples from it or updates its priorities.
+ *
+ * The total priority of each shard is kept in an atomic, so the learner can
+ * choose which shards to sample from without taking any lock.  The maximum
+ * priority, used for new transitions, is also updated atomically.
+ *
+ * Apart from `Store()` taking a shard, the interface is the same as for
+ * PrioritizedReplay, so a ConcurrentPrioritizedReplay can also be used by
+ * QLearning; the overload of `Store()` without a shard stores into shard 0 and
+ * is meant for a single actor.  `Sample()` and `Update()` should be called by
+ * a single learner thread.
+ *
+ * @code
+ * @inproceedings{horgan2018distributed,
+ *  title     = {Distributed Prioritized Experience Replay},
+ *  author    = {Horgan, Dan and Quan, John and Budden, David and
+ *               Barth-Maron, Gabriel and Hessel, Matteo and
+ *               van Hasselt, Hado and Silver, David},
+ *  booktitle = {International Conference on Learning Representations},
+ *  year      = {2018}
+ * }
+ * @endcode
+ *
+ * @tparam EnvironmentType Desired task.
+ */
+template <typename EnvironmentType>
+class ConcurrentPrioritizedReplay
+{
+ public:
+  //! Convenient typedef for action.
+  using ActionType = typename EnvironmentType::Action;
+
+  //! Convenient typedef for state.
+  using StateType = typename EnvironmentType::State;
+
+  struct Transition
+  {
+    StateType state;
+    ActionType action;
+    double reward;
+    StateType nextState;
+    bool isEnd;
+  };
+
+  /**
+   * Default constructor.
+   */
+  ConcurrentPrioritizedReplay():
+      batchSize(0),
+      alpha(0),
+      maxPriority(0),
+      initialBeta(0),
+      beta(0),
+      replayBetaIters(0),
+      nSteps(0)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Construct an instance of the concurrent prioritized experience replay
+   * class.  The capacity is split evenly between the shards.
+   *
+   * @param batchSize Number of examples returned at each sample.
+   * @param capacity Total memory size in terms of number of examples.
+   * @param alpha How much prioritization is used.
+   * @param numShards Number of shards; usually the number of actors.
+   * @param nSteps Number of steps to look in the future.
+   * @param dimension The dimension of an encoded state.
+   */
+  ConcurrentPrioritizedReplay(const size_t batchSize,
+                              const size_t capacity,
+                              const double alpha,
+                              const size_t numShards,
+                              const size_t nSteps = 1,
+                              const size_t dimension = StateType::dimension) :
+      batchSize(batchSize),
+      alpha(alpha),
+      maxPriority(1.0),
+      initialBeta(0.6),
+      beta(0.6),
+      replayBetaIters(10000),
+      nSteps(nSteps)
+  {
+    if (numShards == 0)
+    {
+      throw std::invalid_argument("ConcurrentPrioritizedReplay: the number of "
+          "shards must be positive!");
+    }
+
+    const size_t shardCapacity = (capacity + numShards - 1) / numShards;
+    for (size_t i = 0; i < numShards; ++i)
+      shards.emplace_back(new Shard(shardCapacity, dimension));
+  }
+
+  /**
+   * Store the given experience into the given shard and set its priority to
+   * the maximum priority seen so far.  Different threads may call this
+   * concurrently, as long as each uses its own shard.
+   *
+   * @param shard Index of the shard to store into.
+   * @param state Given state.
+   * @param action Given action.
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   * @param discount The discount parameter.
+   */
+  void Store(const size_t shard,
+             StateType state,
+             ActionType action,
+             double reward,
+             StateType nextState,
+             bool isEnd,
+             const double& discount)
+  {
+    Shard& s = *shards[shard];
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    s.nStepBuffer.push_back({state, action, reward, nextState, isEnd});
+
+    // Single step transition is not ready.
+    if (s.nStepBuffer.size() < nSteps)
+      return;
+
+    // To keep the queue size fixed to nSteps.
+    if (s.nStepBuffer.size() > nSteps)
+      s.nStepBuffer.pop_front();
+
+    // Make a n-step transition.
+    GetNStepInfo(s.nStepBuffer, reward, nextState, isEnd, discount);
+
+    state = s.nStepBuffer.front().state;
+    action = s.nStepBuffer.front().action;
+    s.states.col(s.position) = state.Encode();
+    s.actions[s.position] = action;
+    s.rewards(s.position) = reward;
+    s.nextStates.col(s.position) = nextState.Encode();
+    s.isTerminal(s.position) = isEnd;
+
+    s.idxSum.Set(s.position, maxPriority.load() * alpha);
+    s.totalPriority.store(s.idxSum.Sum());
+
+    s.position++;
+    if (s.position == s.capacity)
+      s.position = 0;
+    if (s.size < s.capacity)
+      s.size.store(s.size + 1);
+  }
+
+  /**
+   * Store the given experience into the first shard.
+   *
+   * @param state Given state.
+   * @param action Given action.
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   * @param discount The discount parameter.
+   */
+  void Store(StateType state,
+             ActionType action,
+             double reward,
+             StateType nextState,
+             bool isEnd,
+             const double& discount)
+  {
+    Store(0, state, action, reward, nextState, isEnd, discount);
+  }
+
+  /**
+   * Sample some experience according to their priorities, from all shards.
+   *
+   * @param sampledStates Sampled encoded states.
+   * @param sampledActions Sampled actions.
+   * @param sampledRewards Sampled rewards.
+   * @param sampledNextStates Sampled encoded next states.
+   * @param isTerminal Indicate whether corresponding next state is terminal
+   *        state.
+   */
+  void Sample(arma::mat& sampledStates,
+              std::vector<ActionType>& sampledActions,
+              arma::rowvec& sampledRewards,
+              arma::mat& sampledNextStates,
+              arma::irowvec& isTerminal)
+  {
+    BetaAnneal();
+
+    // Take a snapshot of the total priority of each shard; actors may keep
+    // storing while we sample, which only means that the newest transitions
+    // may not be seen yet.
+    arma::vec totals(shards.size());
+    for (size_t i = 0; i < shards.size(); ++i)
+      totals[i] = shards[i]->totalPriority.load();
+    const double totalSum = arma::accu(totals);
+    const double sumPerRange = totalSum / batchSize;
+
+    // Assign each stratified sample to a shard.
+    sampledShards.set_size(batchSize);
+    arma::vec masses(batchSize);
+    for (size_t bt = 0; bt < batchSize; ++bt)
+    {
+      double mass = arma::randu() * sumPerRange + bt * sumPerRange;
+      size_t shard = 0;
+      while (shard + 1 < shards.size() && mass >= totals[shard])
+        mass -= totals[shard++];
+
+      sampledShards[bt] = shard;
+      masses[bt] = mass;
+    }
+
+    size_t numSample = Size();
+    sampledIndices.set_size(batchSize);
+    sampledStates.set_size(shards[0]->states.n_rows, batchSize);
+    sampledNextStates.set_size(shards[0]->nextStates.n_rows, batchSize);
+    sampledRewards.set_size(batchSize);
+    isTerminal.set_size(batchSize);
+    weights.set_size(batchSize);
+    const size_t firstAction = sampledActions.size();
+    sampledActions.resize(firstAction + batchSize);
+
+    // Now visit each shard once, holding its lock while we read from it.
+    for (size_t i = 0; i < shards.size(); ++i)
+    {
+      const arma::uvec inShard = arma::find(sampledShards == i);
+      if (inShard.n_elem == 0)
+        continue;
+
+      Shard& s = *shards[i];
+      std::lock_guard<std::mutex> lock(s.mutex);
+      if (s.size == 0)
+      {
+        throw std::runtime_error("ConcurrentPrioritizedReplay::Sample(): "
+            "cannot sample from an empty shard!");
+      }
+
+      for (size_t j = 0; j < inShard.n_elem; ++j)
+      {
+        const size_t bt = inShard[j];
+        // The priorities may have changed since the snapshot; so, make sure
+        // we land on a stored transition.
+        const size_t idx = std::min(s.idxSum.FindPrefixSum(masses[bt]),
+            s.size - 1);
+
+        sampledIndices[bt] = idx;
+        sampledStates.col(bt) = s.states.col(idx);
+        sampledActions[firstAction + bt] = s.actions[idx];
+        sampledRewards[bt] = s.rewards[idx];
+        sampledNextStates.col(bt) = s.nextStates.col(idx);
+        isTerminal[bt] = s.isTerminal[idx];
+
+        // Calculate the weight of the sampled transition.
+        const double pSample = s.idxSum.Get(idx) / totalSum;
+        weights[bt] = std::pow(numSample * pSample, -beta);
+      }
+    }
+
+    weights /= weights.max();
+  }
+
+  /**
+   * Update priorities of the sampled transitions.
+   *
+   * @param shardIndices The shards of the transitions to be updated.
+   * @param indices The indices of the transitions in their shards.
+   * @param priorities Their corresponding priorities.
+   */
+  void UpdatePriorities(const arma::ucolvec& shardIndices,
+                        const arma::ucolvec& indices,
+                        const arma::colvec& priorities)
+  {
+    // Atomically raise the maximum priority, if needed.
+    const double newMax = priorities.max();
+    double oldMax = maxPriority.load();
+    while (newMax > oldMax &&
+        !maxPriority.compare_exchange_weak(oldMax, newMax)) { }
+
+    for (size_t i = 0; i < shards.size(); ++i)
+    {
+      const arma::uvec inShard = arma::find(shardIndices == i);
+      if (inShard.n_elem == 0)
+        continue;
+
+      Shard& s = *shards[i];
+      std::lock_guard<std::mutex> lock(s.mutex);
+      const arma::ucolvec shardIdx = indices.elem(inShard);
+      const arma::colvec alphaPri = alpha * priorities.elem(inShard);
+      s.idxSum.BatchUpdate(shardIdx, alphaPri);
+      s.totalPriority.store(s.idxSum.Sum());
+    }
+  }
+
+  /**
+   * Get the number of transitions in the memory, over all shards.
+   *
+   * @return Actual used memory size.
+   */
+  size_t Size() const
+  {
+    size_t size = 0;
+    for (size_t i = 0; i < shards.size(); ++i)
+      size += shards[i]->size.load();
+    return size;
+  }
+
+  /**
+   * Annealing the beta.
+   */
+  void BetaAnneal()
+  {
+    beta = beta + (1 - initialBeta) * 1.0 / replayBetaIters;
+  }
+
+  /**
+   * Update the priorities of the sampled transitions and update the
+   * gradients.
+   *
+   * @param target The learned value.
+   * @param sampledActions Agent's sampled action.
+   * @param nextActionValues Agent's next action.
+   * @param gradients The model's gradients.
+   */
+  void Update(arma::mat target,
+              std::vector<ActionType> sampledActions,
+              arma::mat nextActionValues,
+              arma::mat& gradients)
+  {
+    arma::colvec tdError(target.n_cols);
+    for (size_t i = 0; i < target.n_cols; i ++)
+    {
+      tdError(i) = nextActionValues(sampledActions[i].action, i) -
+          target(sampledActions[i].action, i);
+    }
+    tdError = arma::abs(tdError);
+    UpdatePriorities(sampledShards, sampledIndices, tdError);
+
+    // Update the gradient
+    gradients = arma::mean(weights) * gradients;
+  }
+
+  //! Get the number of steps for n-step agent.
+  const size_t& NSteps() const { return nSteps; }
+
+  //! Get the number of shards.
+  size_t NumShards() const { return shards.size(); }
+
+  //! Get the shards of the last sampled transitions.
+  const arma::ucolvec& SampledShards() const { return sampledShards; }
+  //! Get the indices (within their shards) of the last sampled transitions.
+  const arma::ucolvec& SampledIndices() const { return sampledIndices; }
+
+ private:
+  /**
+   * One shard of the memory.  All members are protected by `mutex`, except
+   * `totalPriority` and `size`, which are atomic so they can be read without
+   * locking.
+   */
+  struct Shard
+  {
+    Shard(const size_t capacity, const size_t dimension) :
+        capacity(capacity),
+        position(0),
+        size(0),
+        totalPriority(0.0),
+        states(dimension, capacity),
+        actions(capacity),
+        rewards(capacity),
+        nextStates(dimension, capacity),
+        isTerminal(capacity)
+    {
+      size_t treeSize = 1;
+      while (treeSize < capacity)
+        treeSize *= 2;
+
+      idxSum = SumTree<double>(treeSize);
+    }
+
+    //! Maximum number of transitions in the shard.
+    size_t capacity;
+    //! Position to store the next transition.
+    size_t position;
+    //! Number of transitions stored.
+    std::atomic<size_t> size;
+    //! Sum of the priorities of the shard.
+    std::atomic<double> totalPriority;
+
+    //! Lock protecting the storage and the priorities.
+    std::mutex mutex;
+
+    //! The prefix sum of prioritization.
+    SumTree<double> idxSum;
+
+    //! Buffer containing n consecutive steps of the actor of this shard.
+    std::deque<Transition> nStepBuffer;
+
+    //! Encoded previous states.
+    arma::mat states;
+    //! Previous actions.
+    std::vector<ActionType> actions;
+    //! Previous rewards.
+    arma::rowvec rewards;
+    //! Encoded previous next states.
+    arma::mat nextStates;
+    //! Termination information of previous experience.
+    arma::irowvec isTerminal;
+  };
+
+  /**
+   * Get the reward, next state and terminal boolean for nth step.
+   *
+   * @param nStepBuffer Buffer of the last n steps.
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   * @param discount The discount parameter.
+   */
+  static void GetNStepInfo(const std::deque<Transition>& nStepBuffer,
+                           double& reward,
+                           StateType& nextState,
+                           bool& isEnd,
+                           const double& discount)
+  {
+    reward = nStepBuffer.back().reward;
+    nextState = nStepBuffer.back().nextState;
+    isEnd = nStepBuffer.back().isEnd;
+
+    // Should start from the second last transition in buffer.
+    for (int i = nStepBuffer.size() - 2; i >= 0; i--)
+    {
+      bool iE = nStepBuffer[i].isEnd;
+      reward = nStepBuffer[i].reward + discount * reward * (1 - iE);
+      if (iE)
+      {
+        nextState = nStepBuffer[i].nextState;
+        isEnd = iE;
+      }
+    }
+  }
+
+  //! Locally-stored number of examples of each sample.
+  size_t batchSize;
+
+  //! How much prioritization is used.
+  //! (0 - no prioritization, 1 - full prioritization)
+  double alpha;
+
+  //! Locally-stored the max priority.
+  std::atomic<double> maxPriority;
+
+  //! Initial value of beta for prioritized replay buffer.
+  double initialBeta;
+
+  //! The value of beta for current sample.
+  double beta;
+
+  //! How many iteration for replay beta to decay.
+  size_t replayBetaIters;
+
+  //! Locally-stored number of steps to look into the future.
+  size_t nSteps;
+
+  //! The shards of the memory.
+  std::vector<std::unique_ptr<Shard>> shards;
+
+  //! Locally-stored the shards of sampled transitions.
+  arma::ucolvec sampledShards;
+
+  //! Locally-stored the indices of sampled transitions in their shards.
+  arma::ucolvec sampledIndices;
+
+  //! Locally-stored the weights of sampled transitions.
+  arma::rowvec weights;
+};
+
+} // namespace mlpack
+
+#endif
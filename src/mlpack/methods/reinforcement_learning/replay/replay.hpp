@@ -14,6 +14,7 @@
 
 #include "random_replay.hpp"
 #include "prioritized_replay.hpp"
+#include "concurrent_prioritized_replay.hpp"
 #include "sumtree.hpp"
 
 #endif
@@ -19,6 +19,7 @@
 
 #include "replay/replay.hpp"
 #include "training_config.hpp"
+#include "parallel_actor_learner.hpp"
 
 namespace mlpack {
 
@@ -114,6 +115,29 @@ class TD3
    */
   double Episode();
 
+  /**
+   * Train the agent for the given number of steps, collecting experience with
+   * `numActors` actor threads, each with its own copy of the environment and
+   * of the policy network, while the calling thread stores the
+   * transitions into the replay memory and updates the networks (see
+   * ParallelActorLearner).  `updateToDataRatio` updates are performed per
+   * collected transition once `ExplorationSteps()` steps have been taken, and
+   * the parameters of the policy network are copied to the actors every
+   * `syncInterval` updates.  The transitions of the actors are interleaved in
+   * the replay memory, so n-step replays (nSteps > 1) should not be used.
+   *
+   * @param numActors Number of actor threads.
+   * @param steps Number of steps (transitions) to collect.
+   * @param updateToDataRatio Number of updates per collected transition.
+   * @param syncInterval Number of updates between two syncs of the actors.
+   * @return Average return of the episodes completed by the actors (0 if no
+   *     episode was completed).
+   */
+  double ParallelTrain(const size_t numActors,
+                       const size_t steps,
+                       const double updateToDataRatio = 1.0,
+                       const size_t syncInterval = 1);
+
   //! Modify total steps from beginning.
   size_t& TotalSteps() { return totalSteps; }
   //! Get total steps from beginning.
@@ -134,6 +158,15 @@ class TD3
 
 
  private:
+  /**
+   * Compute the action given by `network` for `currentState`, with exploration
+   * noise if `explore` is true.
+   */
+  void ComputeAction(PolicyNetworkType& network,
+                     const StateType& currentState,
+                     const bool explore,
+                     ActionType& selectedAction);
+
   //! Locally-stored hyper-parameters.
   TrainingConfig& config;
 
@@ -292,18 +292,7 @@ void TD3<
   ReplayType
 >::SelectAction()
 {
-  // Get the action at current state, from policy.
-  arma::colvec outputAction;
-  policyNetwork.Predict(state.Encode(), outputAction);
-
-  if (!deterministic)
-  {
-    arma::colvec noise;
-    noise.randn(outputAction.n_rows) * 0.1;
-    noise = arma::clamp(noise, -0.25, 0.25);
-    outputAction = outputAction + noise;
-  }
-  action.action = ConvTo<std::vector<double>>::From(outputAction);
+  ComputeAction(policyNetwork, state, !deterministic, action);
 }
 
 template <
@@ -360,5 +349,91 @@ double TD3<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename UpdaterType,
+  typename ReplayType
+>
+double TD3<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  UpdaterType,
+  ReplayType
+>::ParallelTrain(
+    const size_t numActors,
+    const size_t steps,
+    const double updateToDataRatio,
+    const size_t syncInterval)
+{
+  ParallelActorLearner<EnvironmentType, PolicyNetworkType> learner(numActors,
+      updateToDataRatio, syncInterval);
+
+  // Each actor explores with its own noise.
+  auto makeSelector = [this]()
+  {
+    return [this](PolicyNetworkType& network, const StateType& actorState,
+        ActionType& actorAction)
+    {
+      ComputeAction(network, actorState, !deterministic, actorAction);
+    };
+  };
+
+  auto store = [this](const StateType& transitionState,
+                      const ActionType& transitionAction,
+                      const double reward,
+                      const StateType& nextState,
+                      const bool isEnd)
+  {
+    replayMethod.Store(transitionState, transitionAction, reward, nextState,
+        isEnd, config.Discount());
+    ++totalSteps;
+  };
+
+  const std::vector<double> returns = learner.Run(steps, config, environment,
+      policyNetwork, makeSelector, store, [this]() { Update(); });
+
+  if (returns.empty())
+    return 0.0;
+
+  return std::accumulate(returns.begin(), returns.end(), 0.0) /
+      returns.size();
+}
+
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename UpdaterType,
+  typename ReplayType
+>
+void TD3<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  UpdaterType,
+  ReplayType
+>::ComputeAction(
+    PolicyNetworkType& network,
+    const StateType& currentState,
+    const bool explore,
+    ActionType& selectedAction)
+{
+  // Get the action at the given state, from the policy.
+  arma::colvec outputAction;
+  network.Predict(currentState.Encode(), outputAction);
+
+  if (explore)
+  {
+    arma::colvec noise;
+    noise.randn(outputAction.n_rows) * 0.1;
+    noise = arma::clamp(noise, -0.25, 0.25);
+    outputAction = outputAction + noise;
+  }
+  selectedAction.action = ConvTo<std::vector<double>>::From(outputAction);
+}
+
 } // namespace mlpack
 #endif
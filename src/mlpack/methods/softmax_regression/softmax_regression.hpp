@@ -228,6 +228,40 @@ class SoftmaxRegression
                  const bool fitIntercept = true,
                  CallbackTypes&&... callbacks);
 
+  /**
+   * Train the softmax regression model on data that is read from disk in
+   * chunks, so that the full dataset never has to be in memory.  For each
+   * epoch, the optimizer is run on each chunk of `data` (and the corresponding
+   * chunk of `labels`) in turn, starting from the current model parameters and
+   * using the current values of Lambda() and FitIntercept().  This is only
+   * useful with stochastic optimizers (such as ens::SGD), whose
+   * MaxIterations() should be set to roughly the chunk size.
+   *
+   * @tparam OptimizerType Desired optimizer type.
+   * @param data Source of input data with each column as one example.
+   * @param labels Source of labels associated with the feature data; each point
+   *     must be a single label.
+   * @param numClasses Number of classes for classification.
+   * @param optimizer Desired optimizer.
+   * @param epochs Number of passes over the whole dataset.
+   * @param callbacks Callback(s) for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The sum of the final objectives for each chunk in the last epoch.
+   */
+  template<typename OptimizerType,
+           typename... CallbackTypes,
+           typename = std::enable_if_t<IsEnsOptimizer<
+               OptimizerType, SoftmaxRegressionFunction<MatType>, DenseMatType
+           >::value>,
+           typename = std::enable_if_t<
+               IsEnsCallbackTypes<CallbackTypes...>::value>>
+  ElemType Train(data::ChunkedSource<ElemType>& data,
+                 data::ChunkedSource<size_t>& labels,
+                 const size_t numClasses,
+                 OptimizerType& optimizer,
+                 const size_t epochs = 1,
+                 CallbackTypes&&... callbacks);
+
   /**
    * Classify the given points, returning the predicted labels for each point.
    * The function calculates the probabilities for every class, given a data
@@ -288,6 +322,15 @@ class SoftmaxRegression
   void Classify(const MatType& dataset,
                 DenseMatType& probabilities) const;
 
+  /**
+   * Return a LinearScorer holding a copy of the weights (one column per class)
+   * and intercepts of the model, for low-latency classification and top-k
+   * label selection.  The scores of the scorer are the logits of each class;
+   * the class with the highest score is the class with the highest
+   * probability.
+   */
+  LinearScorer<DenseMatType> Scorer() const;
+
   /**
    * Computes accuracy of the learned model given the feature data and the
    * labels associated with each data point. Predictions are made using the
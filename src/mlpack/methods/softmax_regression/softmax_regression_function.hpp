@@ -15,6 +15,8 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/make_alias.hpp>
+#include <mlpack/core/math/sparse_columns.hpp>
+#include <mlpack/core/optimizers/function_traits.hpp>
 
 namespace mlpack {
 
@@ -146,6 +148,10 @@ class SoftmaxRegressionFunction
    * probabilities for each class given the parameters, and computes the
    * gradients based on the difference from the ground truth.
    *
+   * If the data and the gradient are both sparse, the gradient is only nonzero
+   * for the intercept and the features that are nonzero in the batch, and only
+   * those are regularized, as in lock-free parallel SGD (see HogwildSGD).
+   *
    * @param parameters Current values of the model parameters.
    * @param start First index of the data points to use.
    * @param gradient Matrix to store gradient into.
@@ -210,6 +216,14 @@ class SoftmaxRegressionFunction
   bool fitIntercept;
 };
 
+//! With sparse data, the separable gradient can be sparse.
+template<typename MatType>
+class FunctionTraits<SoftmaxRegressionFunction<MatType>>
+{
+ public:
+  static const bool SparseGradient = arma::is_SpMat<MatType>::value;
+};
+
 } // namespace mlpack
 
 // Include implementation.
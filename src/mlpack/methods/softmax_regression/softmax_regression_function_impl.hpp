@@ -307,24 +307,41 @@ inline void SoftmaxRegressionFunction<MatType>::Gradient(
   DenseMatType probabilities;
   GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
 
-  // Calculate the parameter gradients.
-  gradient.set_size(parameters.n_rows, parameters.n_cols);
-  if (fitIntercept)
+  if constexpr (arma::is_SpMat<GradType>::value &&
+                arma::is_SpMat<MatType>::value)
   {
-    DenseMatType inner = probabilities - groundTruth.cols(start, start +
-        batchSize - 1);
-    gradient.col(0) =
-        inner * ones<DenseMatType>(batchSize, 1) / batchSize +
-        lambda * parameters.col(0);
-    gradient.cols(1, parameters.n_cols - 1) =
-        inner * data.cols(start, start + batchSize - 1).t() / batchSize +
-        lambda * parameters.cols(1, parameters.n_cols - 1);
+    // Only the columns of the features that are nonzero in the batch (and the
+    // intercept) are nonzero, and only those are regularized.
+    const DenseMatType inner = (probabilities - groundTruth.cols(start, start +
+        batchSize - 1)) / batchSize;
+    SparseColumnsOuterProduct(data, start, batchSize, inner,
+        (fitIntercept ? 1 : 0), parameters.n_cols, gradient);
+    if (fitIntercept)
+      gradient.col(0) = sum(inner, 1);
+
+    gradient += ElemType(lambda) * (spones(gradient) % parameters);
   }
   else
   {
-    gradient = (probabilities - groundTruth.cols(start, start + batchSize - 1))
-        * data.cols(start, start + batchSize - 1).t() / batchSize
-        + lambda * parameters;
+    // Calculate the parameter gradients.
+    gradient.set_size(parameters.n_rows, parameters.n_cols);
+    if (fitIntercept)
+    {
+      DenseMatType inner = probabilities - groundTruth.cols(start, start +
+          batchSize - 1);
+      gradient.col(0) =
+          inner * ones<DenseMatType>(batchSize, 1) / batchSize +
+          lambda * parameters.col(0);
+      gradient.cols(1, parameters.n_cols - 1) =
+          inner * data.cols(start, start + batchSize - 1).t() / batchSize +
+          lambda * parameters.cols(1, parameters.n_cols - 1);
+    }
+    else
+    {
+      gradient = (probabilities - groundTruth.cols(start,
+          start + batchSize - 1)) * data.cols(start, start + batchSize - 1).t()
+          / batchSize + lambda * parameters;
+    }
   }
 }
 
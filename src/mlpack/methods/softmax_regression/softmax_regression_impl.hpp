@@ -139,6 +139,32 @@ SoftmaxRegression<MatType>::Train(const MatType& data,
   return out;
 }
 
+template<typename MatType>
+template<typename OptimizerType, typename... CallbackTypes, typename, typename>
+typename SoftmaxRegression<MatType>::ElemType
+SoftmaxRegression<MatType>::Train(data::ChunkedSource<ElemType>& data,
+                                  data::ChunkedSource<size_t>& labels,
+                                  const size_t numClasses,
+                                  OptimizerType& optimizer,
+                                  const size_t epochs,
+                                  CallbackTypes&&... callbacks)
+{
+  ElemType out = 0;
+  for (size_t e = 0; e < epochs; ++e)
+  {
+    out = 0;
+    data::ForEachChunk(data, labels,
+        [&](const arma::Mat<ElemType>& dataChunk,
+            const arma::Mat<size_t>& labelsChunk)
+        {
+          out += Train(dataChunk, arma::Row<size_t>(labelsChunk), numClasses,
+              optimizer, lambda, fitIntercept, callbacks...);
+        });
+  }
+
+  return out;
+}
+
 template<typename MatType>
 inline void SoftmaxRegression<MatType>::Classify(const MatType& dataset,
                                                  arma::Row<size_t>& labels)
@@ -152,9 +178,35 @@ template<typename MatType>
 template<typename VecType>
 size_t SoftmaxRegression<MatType>::Classify(const VecType& point) const
 {
-  arma::Row<size_t> label(1);
-  Classify(point, label);
-  return size_t(label(0));
+  // Only build the error message if it is needed, so that nothing is
+  // allocated.
+  if (point.n_rows != FeatureSize())
+  {
+    util::CheckSameDimensionality(point, FeatureSize(),
+        "SoftmaxRegression::Classify()", "point");
+  }
+
+  // The softmax function is monotonic, so the predicted class is the one with
+  // the largest score; each score is computed in place.
+  using ElemType = typename DenseMatType::elem_type;
+  const size_t offset = fitIntercept ? 1 : 0;
+  size_t best = 0;
+  ElemType bestScore = -std::numeric_limits<ElemType>::infinity();
+  for (size_t c = 0; c < numClasses; ++c)
+  {
+    ElemType score = arma::dot(parameters.row(c).tail_cols(
+        parameters.n_cols - offset), point);
+    if (fitIntercept)
+      score += parameters(c, 0);
+
+    if (score > bestScore)
+    {
+      bestScore = score;
+      best = c;
+    }
+  }
+
+  return best;
 }
 
 template<typename MatType>
@@ -178,48 +230,27 @@ inline void SoftmaxRegression<MatType>::Classify(
   util::CheckSameDimensionality(dataset, FeatureSize(),
       "SoftmaxRegression::Classify()");
 
-  // Calculate the probabilities for each test input.
-  DenseMatType hypothesis;
+  // Compute the scores of each class with one matrix multiplication.  In order
+  // to add the intercept term, the intercept column is added to the scores,
+  // instead of joining a row of ones to (a copy of) the data.
   if (fitIntercept)
   {
-    // In order to add the intercept term, we should compute following matrix:
-    //     [1; data] = join_cols(ones(1, data.n_cols), data)
-    //     hypothesis = exp(parameters * [1; data]).
-    //
-    // Since the cost of join maybe high due to the copy of original data,
-    // split the hypothesis computation to two components.
-    hypothesis = exp(
-      repmat(parameters.col(0), 1, dataset.n_cols) +
-      parameters.cols(1, parameters.n_cols - 1) * dataset);
+    probabilities = parameters.tail_cols(parameters.n_cols - 1) * dataset;
+    probabilities.each_col() += parameters.col(0);
   }
   else
   {
-    hypothesis = exp(parameters * dataset);
+    probabilities = parameters * dataset;
   }
 
-  probabilities = hypothesis / repmat(sum(hypothesis, 0), numClasses, 1);
-
-  // Prepare necessary data.
-  labels.zeros(dataset.n_cols);
-  double maxProbability = 0;
-
-  // For each test input.
-  for (size_t i = 0; i < dataset.n_cols; ++i)
-  {
-    // For each class.
-    for (size_t j = 0; j < numClasses; ++j)
-    {
-      // If a higher class probability is encountered, change prediction.
-      if (probabilities(j, i) > maxProbability)
-      {
-        maxProbability = probabilities(j, i);
-        labels(i) = j;
-      }
-    }
+  // The largest score of each point is subtracted before exponentiation, which
+  // does not change the probabilities but avoids overflow.
+  probabilities.each_row() -= arma::max(probabilities, 0);
+  probabilities = arma::exp(probabilities);
+  probabilities.each_row() /= arma::sum(probabilities, 0);
 
-    // Set maximum probability to zero for the next input.
-    maxProbability = 0;
-  }
+  labels = ConvTo<arma::Row<size_t>>::From(
+      arma::index_max(probabilities, 0));
 }
 
 template<typename MatType>
@@ -231,6 +262,25 @@ inline void SoftmaxRegression<MatType>::Classify(
   Classify(dataset, labels, probabilities);
 }
 
+template<typename MatType>
+inline LinearScorer<typename SoftmaxRegression<MatType>::DenseMatType>
+SoftmaxRegression<MatType>::Scorer() const
+{
+  // The softmax function is monotonic, so the scores of the scorer are the
+  // unnormalized log-probabilities (the logits) of each class.
+  if (fitIntercept)
+  {
+    return LinearScorer<DenseMatType>(
+        DenseMatType(parameters.tail_cols(parameters.n_cols - 1).t()),
+        DenseColType(parameters.col(0)));
+  }
+  else
+  {
+    return LinearScorer<DenseMatType>(DenseMatType(parameters.t()),
+        DenseColType());
+  }
+}
+
 template<typename MatType>
 inline double SoftmaxRegression<MatType>::ComputeAccuracy(
     const MatType& testData,
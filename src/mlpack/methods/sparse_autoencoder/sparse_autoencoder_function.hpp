@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_SPARSE_AUTOENCODER_SPARSE_AUTOENCODER_FUNCTION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/make_alias.hpp>
 
 namespace mlpack {
 
@@ -21,6 +22,17 @@ namespace mlpack {
  * This is a class for the sparse autoencoder objective function. It can be used
  * to create learning models like self-taught learning, stacked autoencoders,
  * conditional random fields (CRFs), and so forth.
+ *
+ * The function is separable, so it can be optimized with SGD-type optimizers
+ * as well as with L-BFGS.  The objective of a batch of b points (out of m) is
+ * its part of the reconstruction error, plus b / m times the regularization
+ * cost and the KL divergence cost of the average activations of the batch,
+ * so that the objectives of the batches of an epoch sum to the full objective,
+ * up to the KL divergence term, which is estimated on each batch.
+ *
+ * The points are processed in blocks of BlockSize() points in parallel with
+ * OpenMP, and only the activations of one block per thread are held at a
+ * time.
  */
 class SparseAutoencoderFunction
 {
@@ -69,6 +81,71 @@ class SparseAutoencoderFunction
    */
   void Gradient(const arma::mat& parameters, arma::mat& gradient) const;
 
+  /**
+   * Evaluates the objective function and its gradient given the current set of
+   * parameters, with one feedforward pass for the average activations of the
+   * hidden layer and one for the reconstruction error and the gradient.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param gradient Matrix where gradient values will be stored.
+   */
+  double EvaluateWithGradient(const arma::mat& parameters,
+                              arma::mat& gradient) const;
+
+  /**
+   * Evaluates the objective function of the sparse autoencoder model on the
+   * batch of points [begin, begin + batchSize) (in the order given by
+   * Shuffle()), with the regularization cost scaled by batchSize / m and the
+   * KL divergence computed with the average activations of the batch.  This is
+   * useful for optimizers such as SGD, which require a separable objective
+   * function.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize = 1) const;
+
+  /**
+   * Evaluates the gradient of the objective function on the batch of points
+   * [begin, begin + batchSize), as given by Evaluate(parameters, begin,
+   * batchSize).
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the first point of the batch.
+   * @param gradient Matrix where gradient values will be stored.
+   * @param batchSize Number of points in the batch.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize = 1) const;
+
+  /**
+   * Evaluates the objective function and its gradient on the batch of points
+   * [begin, begin + batchSize).
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the first point of the batch.
+   * @param gradient Matrix where gradient values will be stored.
+   * @param batchSize Number of points in the batch.
+   */
+  double EvaluateWithGradient(const arma::mat& parameters,
+                              const size_t begin,
+                              arma::mat& gradient,
+                              const size_t batchSize = 1) const;
+
+  //! Return the number of separable functions (the number of points).
+  size_t NumFunctions() const { return data.n_cols; }
+
+  /**
+   * Shuffle the order in which the points are visited by batches.  The data is
+   * not copied; only a permutation of the point indices is kept.
+   */
+  void Shuffle();
+
   /**
    * Returns the elementwise sigmoid of the passed matrix, where the sigmoid
    * function of a real number 'x' is [1 / (1 + exp(-x))].
@@ -144,7 +221,51 @@ class SparseAutoencoderFunction
     return rho;
   }
 
+  //! Sets the number of points processed at a time by each thread.
+  void BlockSize(const size_t size)
+  {
+    this->blockSize = size;
+  }
+
+  //! Gets the number of points processed at a time by each thread.
+  size_t BlockSize() const
+  {
+    return blockSize;
+  }
+
  private:
+  /**
+   * Get the points [begin, begin + count) in visitation order.  If the points
+   * are not shuffled, the block is an alias of the data.
+   */
+  void GetBlock(const size_t begin, const size_t count, arma::mat& block) const;
+
+  //! Compute the activations of the hidden layer for the given points.
+  void HiddenLayer(const arma::mat& parameters,
+                   const arma::mat& block,
+                   arma::mat& hiddenLayer) const;
+
+  //! Compute the activations of the output layer for the given hidden layer
+  //! activations.
+  void OutputLayer(const arma::mat& parameters,
+                   const arma::mat& hiddenLayer,
+                   arma::mat& outputLayer) const;
+
+  /**
+   * Compute the average activations of the hidden layer over the points
+   * [begin, begin + batchSize), in parallel over blocks of points.
+   */
+  void AverageActivations(const arma::mat& parameters,
+                          const size_t begin,
+                          const size_t batchSize,
+                          arma::vec& rhoCap) const;
+
+  //! Compute the regularization cost and the KL divergence cost for the given
+  //! average activations, scaled by the given factor.
+  double RegularizationCost(const arma::mat& parameters,
+                            const arma::vec& rhoCap,
+                            const double scale) const;
+
   //! The matrix of data points.
   const arma::mat& data;
   //! Initial parameter vector.
@@ -159,6 +280,10 @@ class SparseAutoencoderFunction
   double beta;
   //! Sparsity parameter.
   double rho;
+  //! Number of points processed at a time by each thread.
+  size_t blockSize;
+  //! The order in which the points are visited (empty if not shuffled).
+  arma::uvec visitationOrder;
 };
 
 } // namespace mlpack
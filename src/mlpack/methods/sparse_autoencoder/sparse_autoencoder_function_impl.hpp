@@ -28,7 +28,8 @@ inline SparseAutoencoderFunction::SparseAutoencoderFunction(
     hiddenSize(hiddenSize),
     lambda(lambda),
     beta(beta),
-    rho(rho)
+    rho(rho),
+    blockSize(1024)
 {
   // Initialize the parameters to suitable values.
   initialPoint = InitializeWeights();
@@ -77,6 +78,33 @@ inline const arma::mat SparseAutoencoderFunction::InitializeWeights()
   */
 inline double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters)
     const
+{
+  return Evaluate(parameters, 0, data.n_cols);
+}
+
+/** Calculates and stores the gradient values given a set of parameters.
+  */
+inline void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
+                                                arma::mat& gradient) const
+{
+  EvaluateWithGradient(parameters, 0, gradient, data.n_cols);
+}
+
+/** Evaluates the objective function and calculates the gradient values given
+  * a set of parameters.
+  */
+inline double SparseAutoencoderFunction::EvaluateWithGradient(
+    const arma::mat& parameters,
+    arma::mat& gradient) const
+{
+  return EvaluateWithGradient(parameters, 0, gradient, data.n_cols);
+}
+
+/** Evaluates the objective function on a batch of points given the parameters.
+  */
+inline double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters,
+                                                  const size_t begin,
+                                                  const size_t batchSize) const
 {
   // The objective function is the average squared reconstruction error of the
   // network. w1 and b1 are the weights and biases associated with the hidden
@@ -85,73 +113,81 @@ inline double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters)
   // 'm' is the number of training examples.
   // The cost also takes into account the regularization and KL divergence terms
   // to control the parameter weights and sparsity of the model respectively.
-
-  // Compute the limits for the parameters w1, w2, b1 and b2.
-  const size_t l1 = hiddenSize;
-  const size_t l2 = visibleSize;
-  const size_t l3 = 2 * hiddenSize;
-
-  // w1, w2, b1 and b2 are not extracted separately, 'parameters' is directly
-  // used in their place to avoid copying data. The following representations
-  // are used:
-  // w1 <- parameters.submat(0, 0, l1-1, l2-1)
-  // w2 <- parameters.submat(l1, 0, l3-1, l2-1).t()
-  // b1 <- parameters.submat(0, l2, l1-1, l2)
-  // b2 <- parameters.submat(l3, 0, l3, l2-1).t()
-
-  arma::mat hiddenLayer, outputLayer;
-
-  // Compute activations of the hidden and output layers.
-  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * data +
-      repmat(parameters.submat(0, l2, l1 - 1, l2), 1, data.n_cols),
-      hiddenLayer);
-
-  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
-      repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, data.n_cols),
-      outputLayer);
-
-  arma::mat rhoCap, diff;
+  // For a batch, the reconstruction error is only summed over the batch, and
+  // the other terms are scaled by the fraction of the points in the batch.
+  arma::vec hiddenSums(hiddenSize, arma::fill::zeros);
+  double squaredError = 0.0;
+
+  // Each thread holds the activations of one block of points at a time.
+  const size_t numBlocks = (batchSize + blockSize - 1) / blockSize;
+  #pragma omp parallel
+  {
+    arma::vec localHiddenSums(hiddenSize, arma::fill::zeros);
+    double localSquaredError = 0.0;
+    arma::mat block, hiddenLayer, outputLayer;
+
+    #pragma omp for schedule(static) nowait
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t first = begin + b * blockSize;
+      const size_t count = std::min(blockSize, begin + batchSize - first);
+      GetBlock(first, count, block);
+
+      // Compute activations of the hidden and output layers.
+      HiddenLayer(parameters, block, hiddenLayer);
+      OutputLayer(parameters, hiddenLayer, outputLayer);
+
+      localHiddenSums += sum(hiddenLayer, 1);
+      localSquaredError += accu(square(outputLayer - block));
+    }
+
+    #pragma omp critical
+    {
+      hiddenSums += localHiddenSums;
+      squaredError += localSquaredError;
+    }
+  }
 
   // Average activations of the hidden layer.
-  rhoCap = sum(hiddenLayer, 1) / data.n_cols;
-  // Difference between the reconstructed data and the original data.
-  diff = outputLayer - data;
+  const arma::vec rhoCap = hiddenSums / batchSize;
 
-  double wL2SquaredNorm;
+  // 'sumOfSquaresError' is the squared l2-norm of the reconstructed data
+  // difference, averaged over all the points.
+  const double sumOfSquaresError = 0.5 * squaredError / data.n_cols;
 
-  // Calculate squared L2-norms of w1 and w2.
-  wL2SquaredNorm = accu(parameters.submat(0, 0, l3 - 1, l2 - 1) %
-      parameters.submat(0, 0, l3 - 1, l2 - 1));
-
-  double sumOfSquaresError, weightDecay, klDivergence, cost;
-
-  // Calculate the reconstruction error, the regularization cost and the KL
-  // divergence cost terms. 'sumOfSquaresError' is the average squared l2-norm
-  // of the reconstructed data difference. 'weightDecay' is the squared l2-norm
-  // of the weights w1 and w2. 'klDivergence' is the cost of the hidden layer
-  // activations not being low. It is given by the following formula:
-  // KL = sum_over_hSize(rho*log(rho/rhoCaq) + (1-rho)*log((1-rho)/(1-rhoCap)))
-  sumOfSquaresError = 0.5 * accu(diff % diff) / data.n_cols;
-  weightDecay = 0.5 * lambda * wL2SquaredNorm;
-  klDivergence = beta * accu(rho * log(rho / rhoCap) + (1 - rho) *
-      log((1 - rho) / (1 - rhoCap)));
-
-  // The cost is the sum of the terms calculated above.
-  cost = sumOfSquaresError + weightDecay + klDivergence;
-
-  return cost;
+  // The cost is the sum of the reconstruction error, the regularization cost
+  // and the KL divergence cost.
+  return sumOfSquaresError + RegularizationCost(parameters, rhoCap,
+      (double) batchSize / data.n_cols);
 }
 
-/** Calculates and stores the gradient values given a set of parameters.
+/** Calculates and stores the gradient values on a batch of points given a set
+  * of parameters.
   */
 inline void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
-                                                arma::mat& gradient) const
+                                                const size_t begin,
+                                                arma::mat& gradient,
+                                                const size_t batchSize) const
+{
+  EvaluateWithGradient(parameters, begin, gradient, batchSize);
+}
+
+/** Evaluates the objective function and calculates the gradient values on a
+  * batch of points given a set of parameters.
+  */
+inline double SparseAutoencoderFunction::EvaluateWithGradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    arma::mat& gradient,
+    const size_t batchSize) const
 {
   // Performs a feedforward pass of the neural network, and computes the
   // activations of the output layer as in the Evaluate() method. It uses the
   // Backpropagation algorithm to calculate the delta values at each layer,
   // except for the input layer. The delta values are then used with input layer
-  // and hidden layer activations to get the parameter gradients.
+  // and hidden layer activations to get the parameter gradients.  Since the
+  // delta values of the hidden layer depend on the average activations of the
+  // hidden layer, these are computed first, by a pass over the batch.
 
   // Compute the limits for the parameters w1, w2, b1 and b2.
   const size_t l1 = hiddenSize;
@@ -166,25 +202,8 @@ inline void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
   // b1 <- parameters.submat(0, l2, l1-1, l2)
   // b2 <- parameters.submat(l3, 0, l3, l2-1).t()
 
-  arma::mat hiddenLayer, outputLayer;
-
-  // Compute activations of the hidden and output layers.
-  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * data +
-      repmat(parameters.submat(0, l2, l1 - 1, l2), 1, data.n_cols),
-      hiddenLayer);
-
-  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
-      repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, data.n_cols),
-      outputLayer);
-
-  arma::mat rhoCap, diff;
-
-  // Average activations of the hidden layer.
-  rhoCap = sum(hiddenLayer, 1) / data.n_cols;
-  // Difference between the reconstructed data and the original data.
-  diff = outputLayer - data;
-
-  arma::mat klDivGrad, delOut, delHid;
+  arma::vec rhoCap;
+  AverageActivations(parameters, begin, batchSize, rhoCap);
 
   // The delta vector for the output layer is given by diff * f'(z), where z is
   // the preactivation and f is the activation function. The derivative of the
@@ -192,24 +211,165 @@ inline void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
   // in the neural network which comes before the output layer, the delta values
   // are given del_n = w_n' * del_(n+1) * f'(z_n). Since our cost function also
   // includes the KL divergence term, we adjust for that in the formula below.
-  klDivGrad = beta * (-(rho / rhoCap) + (1 - rho) / (1 - rhoCap));
-  delOut = diff % outputLayer % (1 - outputLayer);
-  delHid = (parameters.submat(l1, 0, l3 - 1, l2 - 1) * delOut +
-      repmat(klDivGrad, 1, data.n_cols)) % hiddenLayer %
-      (1 - hiddenLayer);
+  const arma::vec klDivGrad = beta * (-(rho / rhoCap) + (1 - rho) /
+      (1 - rhoCap));
 
   gradient.zeros(2 * hiddenSize + 1, visibleSize + 1);
+  double squaredError = 0.0;
+
+  // Each thread accumulates the gradient of its blocks of points.
+  const size_t numBlocks = (batchSize + blockSize - 1) / blockSize;
+  #pragma omp parallel
+  {
+    arma::mat localGradient(gradient.n_rows, gradient.n_cols,
+        arma::fill::zeros);
+    double localSquaredError = 0.0;
+    arma::mat block, hiddenLayer, outputLayer, diff, delOut, delHid;
+
+    #pragma omp for schedule(static) nowait
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t first = begin + b * blockSize;
+      const size_t count = std::min(blockSize, begin + batchSize - first);
+      GetBlock(first, count, block);
+
+      // Compute activations of the hidden and output layers.
+      HiddenLayer(parameters, block, hiddenLayer);
+      OutputLayer(parameters, hiddenLayer, outputLayer);
+
+      // Difference between the reconstructed data and the original data.
+      diff = outputLayer - block;
+      localSquaredError += accu(diff % diff);
+
+      delOut = diff % outputLayer % (1 - outputLayer);
+      delHid = parameters.submat(l1, 0, l3 - 1, l2 - 1) * delOut;
+      delHid.each_col() += klDivGrad;
+      delHid %= hiddenLayer % (1 - hiddenLayer);
+
+      // Sum the gradient values of the points using the activations and the
+      // delta values.
+      localGradient.submat(0, 0, l1 - 1, l2 - 1) += delHid * block.t();
+      localGradient.submat(l1, 0, l3 - 1, l2 - 1) += hiddenLayer * delOut.t();
+      localGradient.submat(0, l2, l1 - 1, l2) += sum(delHid, 1);
+      localGradient.submat(l3, 0, l3, l2 - 1) += sum(delOut, 1).t();
+    }
+
+    #pragma omp critical
+    {
+      gradient += localGradient;
+      squaredError += localSquaredError;
+    }
+  }
+
+  // Average the gradient values over all the points, and account for the
+  // regularization terms in the objective function, scaled for the batch.
+  const double scale = (double) batchSize / data.n_cols;
+  gradient /= data.n_cols;
+  gradient.submat(0, 0, l3 - 1, l2 - 1) += scale * lambda *
+      parameters.submat(0, 0, l3 - 1, l2 - 1);
+
+  return 0.5 * squaredError / data.n_cols +
+      RegularizationCost(parameters, rhoCap, scale);
+}
+
+inline void SparseAutoencoderFunction::Shuffle()
+{
+  visitationOrder = arma::randperm<arma::uvec>(data.n_cols);
+}
+
+inline void SparseAutoencoderFunction::GetBlock(const size_t begin,
+                                                const size_t count,
+                                                arma::mat& block) const
+{
+  if (visitationOrder.is_empty())
+    MakeAlias(block, data, data.n_rows, count, begin * data.n_rows);
+  else
+    block = data.cols(visitationOrder.subvec(begin, begin + count - 1));
+}
+
+inline void SparseAutoencoderFunction::HiddenLayer(
+    const arma::mat& parameters,
+    const arma::mat& block,
+    arma::mat& hiddenLayer) const
+{
+  const size_t l1 = hiddenSize;
+  const size_t l2 = visibleSize;
+
+  arma::mat z = parameters.submat(0, 0, l1 - 1, l2 - 1) * block;
+  z.each_col() += parameters.submat(0, l2, l1 - 1, l2);
+  Sigmoid(z, hiddenLayer);
+}
+
+inline void SparseAutoencoderFunction::OutputLayer(
+    const arma::mat& parameters,
+    const arma::mat& hiddenLayer,
+    arma::mat& outputLayer) const
+{
+  const size_t l1 = hiddenSize;
+  const size_t l2 = visibleSize;
+  const size_t l3 = 2 * hiddenSize;
+
+  arma::mat z = parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer;
+  z.each_col() += parameters.submat(l3, 0, l3, l2 - 1).t();
+  Sigmoid(z, outputLayer);
+}
+
+inline void SparseAutoencoderFunction::AverageActivations(
+    const arma::mat& parameters,
+    const size_t begin,
+    const size_t batchSize,
+    arma::vec& rhoCap) const
+{
+  rhoCap.zeros(hiddenSize);
+
+  // The sums of the activations of the blocks are reduced over the threads.
+  const size_t numBlocks = (batchSize + blockSize - 1) / blockSize;
+  #pragma omp parallel
+  {
+    arma::vec localSums(hiddenSize, arma::fill::zeros);
+    arma::mat block, hiddenLayer;
+
+    #pragma omp for schedule(static) nowait
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t first = begin + b * blockSize;
+      const size_t count = std::min(blockSize, begin + batchSize - first);
+      GetBlock(first, count, block);
+
+      HiddenLayer(parameters, block, hiddenLayer);
+      localSums += sum(hiddenLayer, 1);
+    }
+
+    #pragma omp critical
+    {
+      rhoCap += localSums;
+    }
+  }
+
+  rhoCap /= batchSize;
+}
+
+inline double SparseAutoencoderFunction::RegularizationCost(
+    const arma::mat& parameters,
+    const arma::vec& rhoCap,
+    const double scale) const
+{
+  const size_t l2 = visibleSize;
+  const size_t l3 = 2 * hiddenSize;
+
+  // Calculate squared L2-norms of w1 and w2.
+  const double wL2SquaredNorm = accu(parameters.submat(0, 0, l3 - 1, l2 - 1) %
+      parameters.submat(0, 0, l3 - 1, l2 - 1));
+
+  // 'weightDecay' is the squared l2-norm of the weights w1 and w2.
+  // 'klDivergence' is the cost of the hidden layer activations not being low.
+  // It is given by the following formula:
+  // KL = sum_over_hSize(rho*log(rho/rhoCaq) + (1-rho)*log((1-rho)/(1-rhoCap)))
+  const double weightDecay = 0.5 * lambda * wL2SquaredNorm;
+  const double klDivergence = beta * accu(rho * log(rho / rhoCap) + (1 - rho) *
+      log((1 - rho) / (1 - rhoCap)));
 
-  // Compute the gradient values using the activations and the delta values. The
-  // formula also accounts for the regularization terms in the objective.
-  // function.
-  gradient.submat(0, 0, l1 - 1, l2 - 1) = delHid * data.t() / data.n_cols +
-      lambda * parameters.submat(0, 0, l1 - 1, l2 - 1);
-  gradient.submat(l1, 0, l3 - 1, l2 - 1) =
-      (delOut * hiddenLayer.t() / data.n_cols +
-      lambda * parameters.submat(l1, 0, l3 - 1, l2 - 1).t()).t();
-  gradient.submat(0, l2, l1 - 1, l2) = sum(delHid, 1) / data.n_cols;
-  gradient.submat(l3, 0, l3, l2 - 1) = (sum(delOut, 1) / data.n_cols).t();
+  return scale * (weightDecay + klDivergence);
 }
 
 } // namespace mlpack
@@ -62,28 +62,33 @@ inline void SparseCoding<MatType>::Encode(const MatType& data,
                                           MatType& codes)
 {
   // When using the Cholesky version of LARS, this is correct even if
-  // lambda2 > 0.
-  MatType matGram = trans(dictionary) * dictionary;
+  // lambda2 > 0.  The Gram matrix is computed once and shared (read-only) by
+  // the LARS problems of all points.
+  const MatType matGram = trans(dictionary) * dictionary;
+
+  Log::Debug << "Encoding " << data.n_cols << " points." << std::endl;
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
+  #pragma omp parallel
   {
-    // Report progress.
-    if ((i % 100) == 0)
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
-
-    bool useCholesky = true;
+    // Each thread reuses its own LARS object (and its workspace) for all of
+    // its points.
+    const bool useCholesky = true;
     // Intercept fitting and data normalization is disabled.
     LARS<MatType> lars(useCholesky, lambda1, lambda2,
         1e-16 /* default tolerance */, false, false);
 
-    // Create an alias of the code (using the same memory), and then LARS will
-    // place the result directly into that; then we will not need to have an
-    // extra copy.
-    ColType code = codes.unsafe_col(i);
-    RowType responses = data.unsafe_col(i).t();
-    lars.Train(dictionary, responses, false, useCholesky, matGram);
-    code = lars.Beta();
+    #pragma omp for schedule(dynamic, 16)
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      // Create an alias of the code (using the same memory), and then LARS
+      // will place the result directly into that; then we will not need to
+      // have an extra copy.
+      ColType code = codes.unsafe_col(i);
+      RowType responses = data.unsafe_col(i).t();
+      lars.Train(dictionary, responses, false, useCholesky, matGram);
+      code = lars.Beta();
+    }
   }
 }
 
@@ -102,6 +102,36 @@ class SVDPlusPlusFunction
                 GradType& gradient,
                 const size_t batchSize = 1) const;
 
+  /**
+   * Take a stochastic gradient step for the given rating, in place.  Only the
+   * columns of the user and the item of the rating are written, so ratings
+   * that share no user and no item can be updated concurrently.  This is used
+   * by StratifiedSGD.
+   *
+   * The implicit item vectors of the user are shared with the other users, so
+   * their step is only accumulated (in the column of the user), and applied by
+   * FinishStratum().
+   *
+   * @param parameters Parameters(user/item matrices, user/item bias,
+   *     item implicit matrix) of the decomposition.
+   * @param i Index of the rating.
+   * @param stepSize Step size of the update.
+   */
+  void Update(arma::mat& parameters,
+              const size_t i,
+              const double stepSize);
+
+  /**
+   * Apply the steps of the implicit item vectors that were accumulated by
+   * Update() since the last call.  This is called by StratifiedSGD at the end
+   * of each stratum.
+   *
+   * @param parameters Parameters(user/item matrices, user/item bias,
+   *     item implicit matrix) of the decomposition.
+   * @param stepSize Step size of the update.
+   */
+  void FinishStratum(arma::mat& parameters, const double stepSize);
+
   //! Return the initial point for the optimization.
   const arma::mat& GetInitialPoint() const { return initialPoint; }
 
@@ -141,6 +171,14 @@ class SVDPlusPlusFunction
   size_t numUsers;
   //! Number of items in the given dataset.
   size_t numItems;
+
+  //! Sum of the errors times the item vectors of the ratings of each user
+  //! since the last FinishStratum() (one column per user).
+  arma::mat implicitSteps;
+  //! Number of ratings of each user since the last FinishStratum().
+  arma::Col<size_t> implicitStepCounts;
+  //! Users that interacted with each item (the transposed implicit data).
+  arma::sp_mat implicitDataT;
 };
 
 } // namespace mlpack
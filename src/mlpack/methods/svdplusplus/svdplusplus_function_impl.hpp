@@ -44,6 +44,13 @@ SVDPlusPlusFunction<MatType>::SVDPlusPlusFunction(
   // Unused:
   //     row(rank).subvec(numUsers + numItems, numUsers + 2 * numItems - 1)
   initialPoint.randu(rank + 1, numUsers + 2 * numItems);
+
+  // Storage for the steps of the implicit item vectors in Update().
+  implicitSteps.zeros(rank, numUsers);
+  implicitStepCounts.zeros(numUsers);
+  implicitDataT = this->implicitData.t();
+  this->implicitData.sync();
+  implicitDataT.sync();
 }
 
 template<typename MatType>
@@ -285,6 +292,100 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
   }
 }
 
+template <typename MatType>
+void SVDPlusPlusFunction<MatType>::Update(arma::mat& parameters,
+                                          const size_t i,
+                                          const double stepSize)
+{
+  // Indices for accessing the the correct parameter columns.
+  const size_t user = data(0, i);
+  const size_t item = data(1, i) + numUsers;
+  const size_t implicitStart = numUsers + numItems;
+
+  // Calculate the error in the prediction.
+  const double rating = data(2, i);
+  const double userBias = parameters(rank, user);
+  const double itemBias = parameters(rank, item);
+
+  // Iterate through each item which the user interacted with to calculate
+  // user vector.  The implicit item vectors are not written until the end of
+  // the stratum, so they can be read here.
+  arma::vec userVec(rank, arma::fill::zeros);
+  arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+  arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+  size_t implicitCount = 0;
+  for (; it != it_end; ++it)
+  {
+    userVec += parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
+    implicitCount += 1;
+  }
+  if (implicitCount != 0)
+    userVec /= std::sqrt(implicitCount);
+  const arma::vec userFactors = parameters.col(user).subvec(0, rank - 1);
+  userVec += userFactors;
+
+  const arma::vec itemVec = parameters.col(item).subvec(0, rank - 1);
+  const double ratingError = rating - userBias - itemBias -
+      dot(userVec, itemVec);
+
+  // All the columns are updated with the gradient at the same point.
+  parameters.col(user).subvec(0, rank - 1) -= stepSize * 2 * (
+      lambda * userFactors - ratingError * itemVec);
+  parameters.col(item).subvec(0, rank - 1) -= stepSize * 2 * (
+      lambda * itemVec - ratingError * userVec);
+  parameters(rank, user) -= stepSize * 2 * (lambda * userBias - ratingError);
+  parameters(rank, item) -= stepSize * 2 * (lambda * itemBias - ratingError);
+
+  // The step of each implicit item vector y of the user is
+  //   stepSize * 2 * (lambda / implicitCount * y -
+  //       ratingError / sqrt(implicitCount) * itemVec),
+  // so it is enough to keep the sum of ratingError * itemVec and the number
+  // of ratings of the user.
+  if (implicitCount != 0)
+  {
+    implicitSteps.col(user) += ratingError * itemVec;
+    ++implicitStepCounts[user];
+  }
+}
+
+template <typename MatType>
+void SVDPlusPlusFunction<MatType>::FinishStratum(arma::mat& parameters,
+                                                 const double stepSize)
+{
+  const size_t implicitStart = numUsers + numItems;
+
+  // Each implicit item vector gets the steps of all the users that interacted
+  // with it, so the items are independent.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t k = 0; k < numItems; ++k)
+  {
+    double decay = 0.0;
+    arma::vec step(rank, arma::fill::zeros);
+    arma::sp_mat::const_iterator it = implicitDataT.begin_col(k);
+    arma::sp_mat::const_iterator it_end = implicitDataT.end_col(k);
+    for (; it != it_end; ++it)
+    {
+      const size_t user = it.row();
+      if (implicitStepCounts[user] == 0)
+        continue;
+
+      const double implicitCount = implicitData.col_ptrs[user + 1] -
+          implicitData.col_ptrs[user];
+      decay += implicitStepCounts[user] * lambda / implicitCount;
+      step += implicitSteps.col(user) / std::sqrt(implicitCount);
+    }
+
+    if (decay == 0.0)
+      continue;
+
+    parameters.col(implicitStart + k).subvec(0, rank - 1) -= stepSize * 2 * (
+        decay * parameters.col(implicitStart + k).subvec(0, rank - 1) - step);
+  }
+
+  implicitSteps.zeros();
+  implicitStepCounts.zeros();
+}
+
 } // namespace mlpack
 
 // Template specialization for the SGD optimizer.
@@ -37,24 +37,33 @@ void SVDPlusPlus<OptimizerType>::Apply(const arma::mat& data,
                                        arma::vec& q,
                                        arma::mat& y)
 {
-  // batchSize is 1 in our implementation of SVDPlusPlus.
-  // batchSize other than 1 has not been supported yet.
-  const int batchSize = 1;
-  Log::Warn << "The batch size for optimizing SVDPlusPlus is 1."
-      << std::endl;
-
   // Converts implicitData to the form of sparse matrix.
   arma::sp_mat cleanedData;
   CleanData(implicitData, cleanedData, data);
 
-  // Make the optimizer object using a SVDPlusPlusFunction object.
+  // Make the SVDPlusPlusFunction object to optimize.
   SVDPlusPlusFunction<arma::mat> svdPPFunc(data, cleanedData, rank, lambda);
-  ens::StandardSGD optimizer(alpha, batchSize,
-      iterations * data.n_cols);
 
   // Get optimized parameters.
   arma::mat parameters = svdPPFunc.GetInitialPoint();
-  optimizer.Optimize(svdPPFunc, parameters);
+  if constexpr (std::is_same_v<OptimizerType, StratifiedSGD>)
+  {
+    // Each of the iterations is an epoch over all the ratings.
+    StratifiedSGD optimizer(alpha, iterations);
+    optimizer.Optimize(svdPPFunc, parameters);
+  }
+  else
+  {
+    // batchSize is 1 in our implementation of SVDPlusPlus.
+    // batchSize other than 1 has not been supported yet.
+    const int batchSize = 1;
+    Log::Warn << "The batch size for optimizing SVDPlusPlus is 1."
+        << std::endl;
+
+    ens::StandardSGD optimizer(alpha, batchSize,
+        iterations * data.n_cols);
+    optimizer.Optimize(svdPPFunc, parameters);
+  }
 
   // Constants for extracting user and item matrices.
   const size_t numUsers = max(data.row(0)) + 1;
@@ -50,6 +50,26 @@ class SSELoss
     return accu(values) / (typename VecType::elem_type) values.n_elem;
   }
 
+  /**
+   * Computes the first order gradients (predicted - observed) and second order
+   * gradients (hessians, all ones) of the loss with respect to the predictions.
+   * This is used by the XGBoost class at each step of boosting.
+   *
+   * @param observed The true observed values.
+   * @param predicted The prediction at the current step of boosting.
+   * @param grad Output first order gradients.
+   * @param hess Output second order gradients.
+   */
+  template<typename VecType, typename OutVecType>
+  void Gradients(const VecType& observed,
+                 const VecType& predicted,
+                 OutVecType& grad,
+                 OutVecType& hess)
+  {
+    grad = predicted - observed;
+    hess.ones(observed.n_elem);
+  }
+
   /**
    * Returns the output value for the leaf in the tree.
    */
@@ -0,0 +1,223 @@
+/**
+ * @file methods/xgboost/second_order_gain.hpp
+ *
+ * The second-order gain, which is the fitness function used to build each tree
+ * of a gradient boosted ensemble from the gradients and hessians of the loss.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_SECOND_ORDER_GAIN_HPP
+#define MLPACK_METHODS_XGBOOST_SECOND_ORDER_GAIN_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The SecondOrderGain is a fitness function for DecisionTreeRegressor that
+ * computes the regularized gain used by XGBoost.  For a node with gradient sum
+ * G and hessian sum H, the structure score of the node is
+ *
+ *   T_alpha(G)^2 / (H + lambda),
+ *
+ * where T_alpha() is soft-thresholding by the L1 regularization parameter
+ * alpha and lambda is the L2 regularization parameter; the output value of a
+ * leaf is -T_alpha(G) / (H + lambda).
+ *
+ * The gradients and hessians are passed to the tree as responses and weights:
+ * the response of each point must be -g / h and its weight must be h, so that
+ * the weighted sum of the responses in a node is -G and the sum of the weights
+ * is H.  This way the tree can be built with the existing split types; the
+ * returned gain is normalized by the total hessian, like the gain of MSEGain is
+ * normalized by the total weight.  If no weights are used, every hessian is 1.
+ */
+class SecondOrderGain
+{
+ public:
+  /**
+   * Create the SecondOrderGain with the given regularization parameters.
+   *
+   * @param lambda L2 regularization parameter.
+   * @param alpha L1 regularization parameter.
+   */
+  SecondOrderGain(const double lambda = 0.0, const double alpha = 0.0) :
+      lambda(lambda),
+      alpha(alpha),
+      leftG(0.0),
+      leftH(0.0),
+      leftS(0.0),
+      totalG(0.0),
+      totalH(0.0),
+      totalS(0.0)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Evaluate the second-order gain of the given responses and weights (or
+   * hessians).
+   *
+   * @param values Responses (-g / h) of each point.
+   * @param weights Weights (h) of each point.
+   */
+  template<bool UseWeights, typename VecType, typename WeightVecType>
+  double Evaluate(const VecType& values, const WeightVecType& weights)
+  {
+    double g = 0.0, h = 0.0, s = 0.0;
+    for (size_t i = 0; i < values.n_elem; ++i)
+    {
+      const double w = UseWeights ? (double) weights[i] : 1.0;
+      const double x = (double) values[i];
+      g += w * x;
+      h += w;
+      s += w * x * x;
+    }
+
+    return Gain(g, h, s);
+  }
+
+  /**
+   * Return the output value of a leaf containing the given responses and
+   * weights: -T_alpha(G) / (H + lambda).
+   */
+  template<bool UseWeights, typename ResponsesType, typename WeightsType>
+  double OutputLeafValue(const ResponsesType& responses,
+                         const WeightsType& weights)
+  {
+    double g = 0.0, h = 0.0;
+    for (size_t i = 0; i < responses.n_elem; ++i)
+    {
+      const double w = UseWeights ? (double) weights[i] : 1.0;
+      g += w * (double) responses[i];
+      h += w;
+    }
+
+    if (h + lambda == 0.0)
+      return 0.0;
+
+    return ApplyL1(g) / (h + lambda);
+  }
+
+  /**
+   * Compute the gains of the left and right children for the current split
+   * point.
+   */
+  std::tuple<double, double> BinaryGains()
+  {
+    return std::make_tuple(Gain(leftG, leftH, leftS),
+        Gain(totalG - leftG, totalH - leftH, totalS - leftS));
+  }
+
+  /**
+   * Cache the statistics of the first `minimum - 1` points (for the left
+   * child) and of all the points, for a scan over the sorted responses.
+   *
+   * @param responses The set of responses on which statistics are computed.
+   * @param weights The set of weights associated to each response.
+   * @param minimum The minimum number of elements in a leaf.
+   */
+  template<bool UseWeights, typename ResponsesType, typename WeightVecType>
+  void BinaryScanInitialize(const ResponsesType& responses,
+                            const WeightVecType& weights,
+                            const size_t minimum)
+  {
+    leftG = leftH = leftS = 0.0;
+    totalG = totalH = totalS = 0.0;
+    for (size_t i = 0; i < responses.n_elem; ++i)
+    {
+      const double w = UseWeights ? (double) weights[i] : 1.0;
+      const double x = (double) responses[i];
+      totalG += w * x;
+      totalH += w;
+      totalS += w * x * x;
+      if (i < minimum - 1)
+      {
+        leftG += w * x;
+        leftH += w;
+        leftS += w * x * x;
+      }
+    }
+  }
+
+  /**
+   * Move the point at the given index to the left child.
+   *
+   * @param responses The set of responses on which statistics are computed.
+   * @param weights The set of weights associated to each response.
+   * @param index The current index.
+   */
+  template<bool UseWeights, typename ResponsesType, typename WeightVecType>
+  void BinaryStep(const ResponsesType& responses,
+                  const WeightVecType& weights,
+                  const size_t index)
+  {
+    const double w = UseWeights ? (double) weights[index] : 1.0;
+    const double x = (double) responses[index];
+    leftG += w * x;
+    leftH += w;
+    leftS += w * x * x;
+  }
+
+  //! Get the L2 regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the L2 regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Get the L1 regularization parameter.
+  double Alpha() const { return alpha; }
+  //! Modify the L1 regularization parameter.
+  double& Alpha() { return alpha; }
+
+ private:
+  /**
+   * Compute the gain of a node with the given weighted sum of responses `g`,
+   * sum of weights `h` and weighted sum of squared responses `s`, normalized by
+   * `h`.  This is (T_alpha(g)^2 / (h + lambda) - s) / h, which is never
+   * positive; the `s` term is constant across all the splits of a node, and
+   * makes the gain of a perfect fit zero when there is no regularization.
+   */
+  double Gain(const double g, const double h, const double s) const
+  {
+    if (h <= 0.0)
+      return 0.0;
+
+    const double t = ApplyL1(g);
+    return std::min((t * t / (h + lambda) - s) / h, 0.0);
+  }
+
+  //! Apply soft-thresholding by the L1 regularization parameter.
+  double ApplyL1(const double sumGradients) const
+  {
+    if (sumGradients > alpha)
+      return sumGradients - alpha;
+    else if (sumGradients < -alpha)
+      return sumGradients + alpha;
+
+    return 0.0;
+  }
+
+  //! The L2 regularization parameter.
+  double lambda;
+  //! The L1 regularization parameter.
+  double alpha;
+
+  //! Weighted sum of responses (negative gradient sum) of the left child.
+  double leftG;
+  //! Sum of weights (hessian sum) of the left child.
+  double leftH;
+  //! Weighted sum of squared responses of the left child.
+  double leftS;
+  //! Weighted sum of responses of the node.
+  double totalG;
+  //! Sum of weights of the node.
+  double totalH;
+  //! Weighted sum of squared responses of the node.
+  double totalS;
+};
+
+} // namespace mlpack
+
+#endif
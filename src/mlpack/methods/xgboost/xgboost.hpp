@@ -0,0 +1,250 @@
+/**
+ * @file methods/xgboost/xgboost.hpp
+ *
+ * Definition of the XGBoost class, a gradient boosted trees learner that uses
+ * second-order gradients of the loss, in the style of XGBoost.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/decision_tree/decision_tree_regressor.hpp>
+
+#include "loss_functions/sse_loss.hpp"
+#include "second_order_gain.hpp"
+
+namespace mlpack {
+
+/**
+ * The XGBoost class implements gradient boosted regression trees, where each
+ * tree is fit to the first and second order gradients of the loss at the
+ * current predictions (Newton boosting), as in XGBoost:
+ *
+ * @code
+ * @inproceedings{chen2016xgboost,
+ *   title={XGBoost: A Scalable Tree Boosting System},
+ *   author={Chen, Tianqi and Guestrin, Carlos},
+ *   booktitle={Proceedings of the 22nd ACM SIGKDD International Conference on
+ *       Knowledge Discovery and Data Mining},
+ *   pages={785--794},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * Each tree is a DecisionTreeRegressor built with the SecondOrderGain fitness
+ * function, which implements the regularized gain and leaf values of XGBoost
+ * (with L2 regularization `lambda` and L1 regularization `alpha`).  The output
+ * of each tree is scaled by the learning rate (shrinkage) before it is added to
+ * the model, and each tree can be restricted to a random subset of the
+ * dimensions (column subsampling).  The split search of each node is done in
+ * parallel across dimensions when OpenMP is enabled.
+ *
+ * The LossFunction type must implement the following functions:
+ *
+ * @code
+ * // Return the constant initial prediction for the given responses.
+ * template<typename VecType>
+ * typename VecType::elem_type InitialPrediction(const VecType& responses);
+ *
+ * // Compute the first and second order gradients of the loss with respect to
+ * // the current predictions.  All hessians must be positive.
+ * template<typename VecType, typename OutVecType>
+ * void Gradients(const VecType& responses,
+ *                const VecType& predictions,
+ *                OutVecType& gradients,
+ *                OutVecType& hessians);
+ * @endcode
+ *
+ * @tparam LossFunction Differentiable loss to minimize.
+ * @tparam NumericSplitType The numeric split type used by each tree.
+ * @tparam CategoricalSplitType The categorical split type used by each tree.
+ */
+template<typename LossFunction = SSELoss,
+         template<typename> class NumericSplitType = BestBinaryNumericSplit,
+         template<typename> class CategoricalSplitType = AllCategoricalSplit>
+class XGBoost
+{
+ public:
+  //! Allow access to the underlying tree type.
+  using TreeType = DecisionTreeRegressor<SecondOrderGain, NumericSplitType,
+      CategoricalSplitType, SubsetDimensionSelect>;
+
+  /**
+   * Construct the XGBoost model without training it.  Train() must be called
+   * before Predict() is called.
+   */
+  XGBoost();
+
+  /**
+   * Create an XGBoost model and train it on the given numeric data.  See
+   * Train() for a description of the parameters.
+   */
+  template<typename MatType, typename ResponsesType>
+  XGBoost(const MatType& data,
+          const ResponsesType& responses,
+          const size_t numTrees = 100,
+          const double learningRate = 0.3,
+          const size_t maximumDepth = 6,
+          const double lambda = 1.0,
+          const double alpha = 0.0,
+          const double colSampleRatio = 1.0,
+          const size_t minimumLeafSize = 1,
+          const double minimumGainSplit = 1e-7,
+          LossFunction lossFunction = LossFunction());
+
+  /**
+   * Create an XGBoost model and train it on the given mixed categorical data.
+   * See Train() for a description of the parameters.
+   */
+  template<typename MatType, typename ResponsesType>
+  XGBoost(const MatType& data,
+          const data::DatasetInfo& datasetInfo,
+          const ResponsesType& responses,
+          const size_t numTrees = 100,
+          const double learningRate = 0.3,
+          const size_t maximumDepth = 6,
+          const double lambda = 1.0,
+          const double alpha = 0.0,
+          const double colSampleRatio = 1.0,
+          const size_t minimumLeafSize = 1,
+          const double minimumGainSplit = 1e-7,
+          LossFunction lossFunction = LossFunction());
+
+  /**
+   * Train the model on the given numeric data.  Any existing trees are
+   * discarded.
+   *
+   * @param data Dataset to train on (one point per column).
+   * @param responses Responses of each point.
+   * @param numTrees Number of boosting rounds (trees) to train.
+   * @param learningRate Shrinkage applied to the output of each tree.
+   * @param maximumDepth Maximum depth of each tree (0 means no limit).
+   * @param lambda L2 regularization on the leaf values.
+   * @param alpha L1 regularization on the leaf values.
+   * @param colSampleRatio Fraction of the dimensions that each tree may split
+   *     on; the dimensions are sampled independently for each tree.
+   * @param minimumLeafSize Minimum number of points in each leaf.
+   * @param minimumGainSplit Minimum gain (normalized by the hessian sum of the
+   *     node) for a node to split.
+   * @param lossFunction Instantiated loss function.
+   */
+  template<typename MatType, typename ResponsesType>
+  void Train(const MatType& data,
+             const ResponsesType& responses,
+             const size_t numTrees = 100,
+             const double learningRate = 0.3,
+             const size_t maximumDepth = 6,
+             const double lambda = 1.0,
+             const double alpha = 0.0,
+             const double colSampleRatio = 1.0,
+             const size_t minimumLeafSize = 1,
+             const double minimumGainSplit = 1e-7,
+             LossFunction lossFunction = LossFunction());
+
+  /**
+   * Train the model on the given mixed categorical data.  Any existing trees
+   * are discarded.
+   *
+   * @param data Dataset to train on (one point per column).
+   * @param datasetInfo Type information for each dimension of the dataset.
+   * @param responses Responses of each point.
+   * @param numTrees Number of boosting rounds (trees) to train.
+   * @param learningRate Shrinkage applied to the output of each tree.
+   * @param maximumDepth Maximum depth of each tree (0 means no limit).
+   * @param lambda L2 regularization on the leaf values.
+   * @param alpha L1 regularization on the leaf values.
+   * @param colSampleRatio Fraction of the dimensions that each tree may split
+   *     on; the dimensions are sampled independently for each tree.
+   * @param minimumLeafSize Minimum number of points in each leaf.
+   * @param minimumGainSplit Minimum gain (normalized by the hessian sum of the
+   *     node) for a node to split.
+   * @param lossFunction Instantiated loss function.
+   */
+  template<typename MatType, typename ResponsesType>
+  void Train(const MatType& data,
+             const data::DatasetInfo& datasetInfo,
+             const ResponsesType& responses,
+             const size_t numTrees = 100,
+             const double learningRate = 0.3,
+             const size_t maximumDepth = 6,
+             const double lambda = 1.0,
+             const double alpha = 0.0,
+             const double colSampleRatio = 1.0,
+             const size_t minimumLeafSize = 1,
+             const double minimumGainSplit = 1e-7,
+             LossFunction lossFunction = LossFunction());
+
+  /**
+   * Predict the response of the given point.
+   *
+   * @param point Point to predict.
+   */
+  template<typename VecType>
+  typename VecType::elem_type Predict(const VecType& point) const;
+
+  /**
+   * Predict the responses of the given points.  The points are predicted in
+   * parallel when OpenMP is enabled.
+   *
+   * @param data Points to predict (one per column).
+   * @param predictions Vector to store the predictions in.
+   */
+  template<typename MatType, typename PredVecType>
+  void Predict(const MatType& data, PredVecType& predictions) const;
+
+  //! Get the number of trees in the model.
+  size_t NumTrees() const { return trees.size(); }
+
+  //! Get the tree of the given index.
+  const TreeType& Tree(const size_t i) const { return trees[i]; }
+  //! Modify the tree of the given index.
+  TreeType& Tree(const size_t i) { return trees[i]; }
+
+  //! Get the learning rate (shrinkage) applied to each tree.
+  double LearningRate() const { return learningRate; }
+  //! Get the constant initial prediction of the model.
+  double InitialPrediction() const { return initialPrediction; }
+
+  /**
+   * Serialize the model.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Perform the actual training, with or without dataset information.
+   */
+  template<bool UseDatasetInfo, typename MatType, typename ResponsesType>
+  void Train(const MatType& data,
+             const data::DatasetInfo& datasetInfo,
+             const ResponsesType& responses,
+             const size_t numTrees,
+             const double learningRate,
+             const size_t maximumDepth,
+             const double lambda,
+             const double alpha,
+             const double colSampleRatio,
+             const size_t minimumLeafSize,
+             const double minimumGainSplit,
+             LossFunction& lossFunction);
+
+  //! The trees in the model.
+  std::vector<TreeType> trees;
+  //! The learning rate applied to the output of each tree.
+  double learningRate;
+  //! The constant initial prediction.
+  double initialPrediction;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "xgboost_impl.hpp"
+
+#endif
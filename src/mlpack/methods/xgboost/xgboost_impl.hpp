@@ -0,0 +1,271 @@
+/**
+ * @file methods/xgboost/xgboost_impl.hpp
+ *
+ * Implementation of the XGBoost class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_IMPL_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "xgboost.hpp"
+
+namespace mlpack {
+
+template<typename LossFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+XGBoost<LossFunction, NumericSplitType, CategoricalSplitType>::XGBoost() :
+    learningRate(0.3),
+    initialPrediction(0.0)
+{
+  // Nothing to do.
+}
+
+template<typename LossFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType, typename ResponsesType>
+XGBoost<LossFunction, NumericSplitType, CategoricalSplitType>::XGBoost(
+    const MatType& data,
+    const ResponsesType& responses,
+    const size_t numTrees,
+    const double learningRate,
+    const size_t maximumDepth,
+    const double lambda,
+    const double alpha,
+    const double colSampleRatio,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    LossFunction lossFunction) :
+    learningRate(learningRate),
+    initialPrediction(0.0)
+{
+  Train(data, responses, numTrees, learningRate, maximumDepth, lambda, alpha,
+      colSampleRatio, minimumLeafSize, minimumGainSplit, lossFunction);
+}
+
+template<typename LossFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType, typename ResponsesType>
+XGBoost<LossFunction, NumericSplitType, CategoricalSplitType>::XGBoost(
+    const MatType& data,
+    const data::DatasetInfo& datasetInfo,
+    const ResponsesType& responses,
+    const size_t numTrees,
+    const double learningRate,
+    const size_t maximumDepth,
+    const double lambda,
+    const double alpha,
+    const double colSampleRatio,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    LossFunction lossFunction) :
+    learningRate(learningRate),
+    initialPrediction(0.0)
+{
+  Train(data, datasetInfo, responses, numTrees, learningRate, maximumDepth,
+      lambda, alpha, colSampleRatio, minimumLeafSize, minimumGainSplit,
+      lossFunction);
+}
+
+template<typename LossFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType, typename ResponsesType>
+void XGBoost<LossFunction, NumericSplitType, CategoricalSplitType>::Train(
+    const MatType& data,
+    const ResponsesType& responses,
+    const size_t numTrees,
+    const double learningRate,
+    const size_t maximumDepth,
+    const double lambda,
+    const double alpha,
+    const double colSampleRatio,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    LossFunction lossFunction)
+{
+  data::DatasetInfo info; // Ignored.
+  Train<false>(data, info, responses, numTrees, learningRate, maximumDepth,
+      lambda, alpha, colSampleRatio, minimumLeafSize, minimumGainSplit,
+      lossFunction);
+}
+
+template<typename LossFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType, typename ResponsesType>
+void XGBoost<LossFunction, NumericSplitType, CategoricalSplitType>::Train(
+    const MatType& data,
+    const data::DatasetInfo& datasetInfo,
+    const ResponsesType& responses,
+    const size_t numTrees,
+    const double learningRate,
+    const size_t maximumDepth,
+    const double lambda,
+    const double alpha,
+    const double colSampleRatio,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    LossFunction lossFunction)
+{
+  Train<true>(data, datasetInfo, responses, numTrees, learningRate,
+      maximumDepth, lambda, alpha, colSampleRatio, minimumLeafSize,
+      minimumGainSplit, lossFunction);
+}
+
+template<typename LossFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename VecType>
+typename VecType::elem_type
+XGBoost<LossFunction, NumericSplitType, CategoricalSplitType>::Predict(
+    const VecType& point) const
+{
+  using ElemType = typename VecType::elem_type;
+
+  if (trees.size() == 0)
+  {
+    throw std::invalid_argument("XGBoost::Predict(): no model trained!");
+  }
+
+  double prediction = initialPrediction;
+  for (size_t i = 0; i < trees.size(); ++i)
+    prediction += learningRate * (double) trees[i].Predict(point);
+
+  return (ElemType) prediction;
+}
+
+template<typename LossFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType, typename PredVecType>
+void XGBoost<LossFunction, NumericSplitType, CategoricalSplitType>::Predict(
+    const MatType& data,
+    PredVecType& predictions) const
+{
+  if (trees.size() == 0)
+  {
+    predictions.clear();
+    throw std::invalid_argument("XGBoost::Predict(): no model trained!");
+  }
+
+  predictions.set_size(data.n_cols);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < data.n_cols; ++i)
+    predictions[i] = Predict(data.col(i));
+}
+
+template<typename LossFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename Archive>
+void XGBoost<LossFunction, NumericSplitType, CategoricalSplitType>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  size_t numTrees;
+  if (cereal::is_loading<Archive>())
+    trees.clear();
+  else
+    numTrees = trees.size();
+
+  ar(CEREAL_NVP(numTrees));
+
+  // Allocate space if needed.
+  if (cereal::is_loading<Archive>())
+    trees.resize(numTrees);
+
+  ar(CEREAL_NVP(trees));
+  ar(CEREAL_NVP(learningRate));
+  ar(CEREAL_NVP(initialPrediction));
+}
+
+template<typename LossFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<bool UseDatasetInfo, typename MatType, typename ResponsesType>
+void XGBoost<LossFunction, NumericSplitType, CategoricalSplitType>::Train(
+    const MatType& data,
+    const data::DatasetInfo& datasetInfo,
+    const ResponsesType& responses,
+    const size_t numTrees,
+    const double learningRate,
+    const size_t maximumDepth,
+    const double lambda,
+    const double alpha,
+    const double colSampleRatio,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    LossFunction& lossFunction)
+{
+  util::CheckSameSizes(data, responses, "XGBoost::Train()");
+
+  if (colSampleRatio <= 0.0 || colSampleRatio > 1.0)
+  {
+    throw std::invalid_argument("XGBoost::Train(): colSampleRatio must be in "
+        "(0, 1]!");
+  }
+
+  trees.clear();
+  trees.resize(numTrees);
+  this->learningRate = learningRate;
+
+  // The trees are always trained on double-precision responses and hessians.
+  const arma::rowvec observed = arma::conv_to<arma::rowvec>::from(responses);
+  initialPrediction = (double) lossFunction.InitialPrediction(observed);
+
+  arma::rowvec predictions(data.n_cols);
+  predictions.fill(initialPrediction);
+
+  const size_t numDims = std::max((size_t) std::ceil(colSampleRatio *
+      data.n_rows), (size_t) 1);
+
+  arma::rowvec gradients, hessians, treeResponses;
+  for (size_t t = 0; t < numTrees; ++t)
+  {
+    lossFunction.Gradients(observed, predictions, gradients, hessians);
+
+    // Each tree fits -g / h with weights h, so that the weighted sum of the
+    // responses in each node is minus the gradient sum, and the sum of the
+    // weights is the hessian sum.
+    treeResponses = -gradients / hessians;
+
+    // Sample the dimensions this tree may split on.
+    arma::uvec dims;
+    if (numDims < data.n_rows)
+    {
+      dims = arma::sort(arma::randperm(data.n_rows, numDims));
+    }
+
+    SubsetDimensionSelect dimensionSelector(dims);
+    SecondOrderGain fitnessFunction(lambda, alpha);
+    if (UseDatasetInfo)
+    {
+      trees[t].Train(data, datasetInfo, treeResponses, hessians,
+          minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector,
+          fitnessFunction);
+    }
+    else
+    {
+      trees[t].Train(data, treeResponses, hessians, minimumLeafSize,
+          minimumGainSplit, maximumDepth, dimensionSelector, fitnessFunction);
+    }
+
+    // Update the predictions with the shrunk output of the new tree.
+    #pragma omp parallel for
+    for (size_t i = 0; i < data.n_cols; ++i)
+      predictions[i] += learningRate * (double) trees[t].Predict(data.col(i));
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -37,4 +37,7 @@
 // Include ready to use utility function to check sizes of datasets.
 #include <mlpack/core/util/size_checks.hpp>
 
+// Include the report of the memory used by models.
+#include <mlpack/core/util/memory_report.hpp>
+
 #endif
@@ -724,6 +724,61 @@ TEMPLATE_TEST_CASE("ClassifyTest_NONLINSEP", "[AdaBoostTest]", mat, fmat)
   REQUIRE(lError <= 0.30);
 }
 
+/**
+ * Make sure that classifying a dataset larger than ClassifyBlockSize in blocks
+ * gives the same predictions as classifying each point on its own.
+ */
+TEMPLATE_TEST_CASE("ClassifyBlocksTest", "[AdaBoostTest]", mat, fmat)
+{
+  using MatType = TestType;
+  using eT = typename MatType::elem_type;
+
+  MatType inputData;
+  if (!data::Load("train_nonlinsep.txt", inputData))
+    FAIL("Cannot load test dataset train_nonlinsep.txt!");
+
+  Mat<size_t> labels;
+  if (!data::Load("train_labels_nonlinsep.txt", labels))
+    FAIL("Cannot load labels for train_labels_nonlinsep.txt");
+
+  const size_t numClasses = 2;
+  const size_t inpBucketSize = 3;
+  Row<size_t> labelsvec = labels.row(0);
+
+  AdaBoost<ID3DecisionStump, MatType> a(inputData, labelsvec, numClasses, 20,
+      (eT) 1e-10, inpBucketSize);
+
+  // Repeat the training set (with some noise) so that there are several
+  // blocks, the last of which is not full.
+  const size_t numPoints = 3 * a.ClassifyBlockSize + 17;
+  MatType testData(inputData.n_rows, numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    testData.col(i) = inputData.col(i % inputData.n_cols);
+  testData += (eT) 0.01 * randn<MatType>(testData.n_rows, testData.n_cols);
+
+  Row<size_t> predictedLabels;
+  MatType probabilities;
+  a.Classify(testData, predictedLabels, probabilities);
+
+  REQUIRE(predictedLabels.n_elem == numPoints);
+  REQUIRE(probabilities.n_rows == numClasses);
+  REQUIRE(probabilities.n_cols == numPoints);
+
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    Row<eT> pointProbabilities;
+    size_t prediction;
+    a.Classify(testData.col(i), prediction, pointProbabilities);
+
+    REQUIRE(predictedLabels[i] == prediction);
+    for (size_t c = 0; c < numClasses; ++c)
+    {
+      REQUIRE(probabilities(c, i) ==
+          Approx(pointProbabilities[c]).epsilon(1e-5));
+    }
+  }
+}
+
 /**
  * This test case runs the AdaBoost.mh algorithm on the UCI Iris Dataset.  It
  * trains it on two thirds of the Iris dataset (iris_train.csv), and tests on
@@ -179,6 +179,16 @@ TEST_CASE("ValidConvolution2DTest", "[ConvolutionTest]")
   Convolution2DMethodTest<FFTConvolution<ValidConvolution> >(input, filter,
       output);
 
+  // Perform the convolution through im2col and a matrix product.
+  Convolution2DMethodTest<Im2ColConvolution<ValidConvolution> >(input, filter,
+      output);
+
+  // Perform the convolution with the Winograd algorithm, with both tile sizes.
+  Convolution2DMethodTest<WinogradConvolution<ValidConvolution> >(input, filter,
+      output);
+  Convolution2DMethodTest<WinogradConvolution<ValidConvolution, 4> >(input,
+      filter, output);
+
   // Perform the convolution using singular value decomposition to
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<ValidConvolution> >(input, filter,
@@ -216,6 +226,16 @@ TEST_CASE("FullConvolution2DTest", "[ConvolutionTest]")
   Convolution2DMethodTest<FFTConvolution<FullConvolution> >(input, filter,
       output);
 
+  // Perform the convolution through im2col and a matrix product.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output);
+
+  // Perform the convolution with the Winograd algorithm, with both tile sizes.
+  Convolution2DMethodTest<WinogradConvolution<FullConvolution> >(input, filter,
+      output);
+  Convolution2DMethodTest<WinogradConvolution<FullConvolution, 4> >(input,
+      filter, output);
+
   // Perform the convolution using singular value decomposition to
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<FullConvolution> >(input, filter,
@@ -427,6 +447,10 @@ TEST_CASE("Stride2ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 2, 2, 1, 1);
+
+  // Perform the im2col convolution approach.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 2, 2, 1, 1);
 }
 
 TEST_CASE("Stride3ConvolutionTest", "[ConvolutionTest]")
@@ -447,6 +471,10 @@ TEST_CASE("Stride3ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 3, 3, 1, 1);
+
+  // Perform the im2col convolution approach.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 3, 3, 1, 1);
 }
 
 TEST_CASE("UnequalStrideConvolutionTest", "[ConvolutionTest]")
@@ -468,6 +496,10 @@ TEST_CASE("UnequalStrideConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 3, 2, 1, 1);
+
+  // Perform the im2col convolution approach.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 3, 2, 1, 1);
 }
 
 TEST_CASE("Dilation2ConvolutionTest", "[ConvolutionTest]")
@@ -492,6 +524,10 @@ TEST_CASE("Dilation2ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 1, 1, 2, 2);
+
+  // Perform the im2col convolution approach.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 1, 1, 2, 2);
 }
 
 TEST_CASE("Dilation3ConvolutionTest", "[ConvolutionTest]")
@@ -517,6 +553,10 @@ TEST_CASE("Dilation3ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 1, 1, 3, 3);
+
+  // Perform the im2col convolution approach.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 1, 1, 3, 3);
 }
 
 TEST_CASE("UnequalDilationConvolutionTest", "[ConvolutionTest]")
@@ -541,6 +581,10 @@ TEST_CASE("UnequalDilationConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 1, 1, 3, 2);
+
+  // Perform the im2col convolution approach.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 1, 1, 3, 2);
 }
 
 TEST_CASE("DilationAndStrideConvolutionTest", "[ConvolutionTest]")
@@ -562,4 +606,8 @@ TEST_CASE("DilationAndStrideConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 2, 2, 2, 2);
+
+  // Perform the im2col convolution approach.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 2, 2, 2, 2);
 }
@@ -982,3 +982,482 @@ TEST_CASE("RBFNetworkTest", "[FeedForwardNetworkTest]")
   // RBFN neural net with MeanSquaredError.
   TestNetwork<>(model1, dataset, labels1, dataset, labels, 10, 0.1);
 }
+
+/**
+ * Make sure that a quantized network gives (nearly) the same predictions as the
+ * original network, and that it can be serialized.
+ */
+TEST_CASE("QuantizedNetworkTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat trainData;
+  if (!data::Load("thyroid_train.csv", trainData))
+    FAIL("Cannot open thyroid_train.csv");
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+  trainLabels -= 1; // The labels should be between 0 and numClasses - 1.
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(8);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, trainData.n_cols, -1);
+  model.Train(trainData, trainLabels, opt);
+
+  arma::mat predictions;
+  model.Predict(trainData, predictions);
+
+  model.Quantize();
+  REQUIRE(model.WeightSize() == 0);
+  REQUIRE(dynamic_cast<QuantizedLinear*>(model.Network()[0]) != nullptr);
+  REQUIRE(dynamic_cast<QuantizedLinear*>(model.Network()[2]) != nullptr);
+
+  arma::mat quantizedPredictions;
+  model.Predict(trainData, quantizedPredictions);
+  REQUIRE(quantizedPredictions.n_rows == predictions.n_rows);
+  REQUIRE(quantizedPredictions.n_cols == predictions.n_cols);
+
+  // The log-probabilities should be close, and nearly all of the predicted
+  // classes should be the same.
+  REQUIRE(arma::abs(quantizedPredictions - predictions).max() < 0.1);
+  const arma::urowvec classes = arma::index_max(predictions, 0);
+  const arma::urowvec quantizedClasses = arma::index_max(quantizedPredictions,
+      0);
+  REQUIRE(arma::accu(classes == quantizedClasses) >= 0.98 * classes.n_elem);
+
+  // A quantized network cannot be trained anymore.
+  REQUIRE_THROWS_AS(model.Train(trainData, trainLabels, opt),
+      std::invalid_argument);
+
+  FFN<NegativeLogLikelihood> xmlModel, jsonModel, binaryModel;
+  SerializeObjectAll(model, xmlModel, jsonModel, binaryModel);
+
+  arma::mat xmlPredictions, jsonPredictions, binaryPredictions;
+  model.Predict(trainData, quantizedPredictions);
+  xmlModel.Predict(trainData, xmlPredictions);
+  jsonModel.Predict(trainData, jsonPredictions);
+  binaryModel.Predict(trainData, binaryPredictions);
+
+  CheckMatrices(quantizedPredictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+}
+
+/**
+ * Make sure that pruning a network zeros the requested fraction of the weights
+ * of each Linear layer, and that a sparsified network gives the same
+ * predictions and can be serialized.
+ */
+TEST_CASE("PrunedSparseNetworkTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat trainData;
+  if (!data::Load("thyroid_train.csv", trainData))
+    FAIL("Cannot open thyroid_train.csv");
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+  trainLabels -= 1; // The labels should be between 0 and numClasses - 1.
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(20);
+  model.Add<Sigmoid>();
+  model.Add<LinearNoBias>(3);
+  model.Add<LogSoftMax>();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, trainData.n_cols, -1);
+  model.Train(trainData, trainLabels, opt);
+
+  REQUIRE_THROWS_AS(model.Prune(1.0), std::invalid_argument);
+  model.Prune(0.5);
+
+  // Half of the weights of each layer are zero now, but not the biases.
+  const Linear* linear = dynamic_cast<Linear*>(model.Network()[0]);
+  REQUIRE(linear != nullptr);
+  const size_t linearWeights = linear->Weight().n_elem;
+  REQUIRE(arma::accu(linear->Weight() == 0) == linearWeights / 2);
+  REQUIRE(arma::accu(model.Parameters() == 0) == linearWeights / 2 + 60 / 2);
+
+  arma::mat predictions;
+  model.Predict(trainData, predictions);
+
+  model.Sparsify();
+  REQUIRE(model.WeightSize() == 0);
+  const SparseLinear* sparse =
+      dynamic_cast<SparseLinear*>(model.Network()[0]);
+  REQUIRE(sparse != nullptr);
+  REQUIRE(sparse->NonZeros() == linearWeights - linearWeights / 2);
+  REQUIRE(dynamic_cast<SparseLinear*>(model.Network()[2]) != nullptr);
+
+  arma::mat sparsePredictions;
+  model.Predict(trainData, sparsePredictions);
+  CheckMatrices(predictions, sparsePredictions, 1e-8);
+
+  // A sparse network cannot be trained anymore.
+  REQUIRE_THROWS_AS(model.Train(trainData, trainLabels, opt),
+      std::invalid_argument);
+
+  FFN<NegativeLogLikelihood> xmlModel, jsonModel, binaryModel;
+  SerializeObjectAll(model, xmlModel, jsonModel, binaryModel);
+
+  arma::mat xmlPredictions, jsonPredictions, binaryPredictions;
+  xmlModel.Predict(trainData, xmlPredictions);
+  jsonModel.Predict(trainData, jsonPredictions);
+  binaryModel.Predict(trainData, binaryPredictions);
+
+  CheckMatrices(sparsePredictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+}
+
+/**
+ * Make sure that fusing the layers of a network removes dropout layers, fuses
+ * Linear and activation layers, and does not change the predictions.
+ */
+TEST_CASE("FuseLinearNetworkTest", "[FeedForwardNetworkTest]")
+{
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(8);
+  model.Add<ReLU>();
+  model.Add<Dropout>();
+  model.Add<Linear>(6);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+  model.Reset(10);
+  model.Parameters().randn();
+
+  arma::mat data(10, 50, arma::fill::randn);
+  arma::mat predictions;
+  model.Predict(data, predictions);
+
+  const size_t weightSize = model.WeightSize();
+  model.Fuse();
+
+  // Dropout is removed, and the first two Linear layers are fused with their
+  // activation.
+  REQUIRE(model.Network().size() == 4);
+  REQUIRE(dynamic_cast<FusedLinearReLU*>(model.Network()[0]) != nullptr);
+  REQUIRE(dynamic_cast<FusedLinearSigmoid*>(model.Network()[1]) != nullptr);
+  REQUIRE(dynamic_cast<Linear*>(model.Network()[2]) != nullptr);
+  REQUIRE(model.WeightSize() == weightSize);
+
+  arma::mat fusedPredictions;
+  model.Predict(data, fusedPredictions);
+  CheckMatrices(predictions, fusedPredictions, 1e-5);
+}
+
+/**
+ * Make sure that a BatchNorm layer that follows a convolution is folded into
+ * the convolution, without changing the predictions.
+ */
+TEST_CASE("FuseBatchNormNetworkTest", "[FeedForwardNetworkTest]")
+{
+  for (const bool useBias : { true, false })
+  {
+    FFN<NegativeLogLikelihood> model;
+    model.Add<Convolution>(4, 3, 3, 1, 1, 1, 1, "none", useBias);
+    model.Add<BatchNorm>();
+    model.Add<ReLU>();
+    model.Add<Linear>(3);
+    model.Add<LogSoftMax>();
+    model.InputDimensions() = std::vector<size_t>({ 6, 6, 2 });
+    model.Reset();
+    model.Parameters().randn();
+
+    BatchNorm* bn = dynamic_cast<BatchNorm*>(model.Network()[1]);
+    REQUIRE(bn != nullptr);
+    bn->TrainingMean().randn();
+    bn->TrainingVariance().randu();
+    bn->TrainingVariance() += 0.5;
+
+    arma::mat data(6 * 6 * 2, 20, arma::fill::randn);
+    arma::mat predictions;
+    model.Predict(data, predictions);
+
+    model.Fuse();
+    REQUIRE(model.Network().size() == 3);
+    REQUIRE(dynamic_cast<Convolution*>(model.Network()[0]) != nullptr);
+    REQUIRE(dynamic_cast<Convolution*>(model.Network()[0])->UseBias());
+    REQUIRE(model.WeightSize() == 9 * 2 * 4 + 4 + 6 * 6 * 4 * 3 + 3);
+
+    arma::mat fusedPredictions;
+    model.Predict(data, fusedPredictions);
+    CheckMatrices(predictions, fusedPredictions, 1e-5);
+  }
+}
+
+/**
+ * Make sure that the shared-memory passes of MultiLayer (Predict() and
+ * BackwardWithGradient()) give the same results as Forward(), Backward() and
+ * Gradient(), which keep the outputs and deltas of every layer.
+ */
+TEST_CASE("MultiLayerSharedMemoryPassTest", "[FeedForwardNetworkTest]")
+{
+  MultiLayer<arma::mat> network;
+  network.Add<Linear>(12);
+  network.Add<Sigmoid>();
+  network.Add<Linear>(4);
+  network.Add<TanH>();
+  network.Add<Linear>(20);
+  network.Add<ReLU>();
+  network.Add<Linear>(3);
+  network.InputDimensions() = std::vector<size_t>({ 7 });
+  network.ComputeOutputDimensions();
+
+  arma::mat weights(network.WeightSize(), 1, arma::fill::randn);
+  network.SetWeights(weights);
+
+  // Use a few batch sizes so that the memory has to be resized.
+  for (const size_t batchSize : { 16, 3, 1, 40 })
+  {
+    arma::mat input(7, batchSize, arma::fill::randn);
+    arma::mat gy(3, batchSize, arma::fill::randn);
+
+    arma::mat output(3, batchSize), g(7, batchSize),
+        gradient(network.WeightSize(), 1);
+    network.Forward(input, output);
+    network.Backward(input, output, gy, g);
+    network.Gradient(input, gy, gradient);
+
+    arma::mat predictOutput(3, batchSize);
+    network.Predict(input, predictOutput);
+    CheckMatrices(output, predictOutput, 1e-10);
+
+    arma::mat sharedOutput(3, batchSize), sharedG(7, batchSize),
+        sharedGradient(network.WeightSize(), 1);
+    network.Forward(input, sharedOutput);
+    network.BackwardWithGradient(input, sharedOutput, gy, sharedG,
+        sharedGradient);
+    CheckMatrices(g, sharedG, 1e-10);
+    CheckMatrices(gradient, sharedGradient, 1e-10);
+  }
+}
+
+/**
+ * Make sure that gradient checkpointing gives the same outputs and gradients as
+ * keeping the output of every layer, for a few sets of checkpoints.
+ */
+TEST_CASE("MultiLayerCheckpointTest", "[FeedForwardNetworkTest]")
+{
+  MultiLayer<arma::mat> network;
+  network.Add<Linear>(12);
+  network.Add<Sigmoid>();
+  network.Add<Linear>(4);
+  network.Add<TanH>();
+  network.Add<Linear>(20);
+  network.Add<ReLU>();
+  network.Add<Linear>(9);
+  network.Add<Sigmoid>();
+  network.Add<Linear>(3);
+  network.InputDimensions() = std::vector<size_t>({ 7 });
+  network.ComputeOutputDimensions();
+
+  arma::mat weights(network.WeightSize(), 1, arma::fill::randn);
+  network.SetWeights(weights);
+
+  const std::vector<std::vector<size_t>> checkpointSets = {
+      { 2 }, { 1, 2 }, { 0, 4, 5 }, { 0, 1, 2, 3, 4, 5, 6, 7 }, { 3, 8, 20 } };
+
+  for (const size_t batchSize : { 16, 3 })
+  {
+    arma::mat input(7, batchSize, arma::fill::randn);
+    arma::mat gy(3, batchSize, arma::fill::randn);
+
+    network.Checkpoints().clear();
+    arma::mat output(3, batchSize), g(7, batchSize),
+        gradient(network.WeightSize(), 1);
+    network.Forward(input, output);
+    network.Backward(input, output, gy, g);
+    network.Gradient(input, gy, gradient);
+
+    for (const std::vector<size_t>& checkpoints : checkpointSets)
+    {
+      network.Checkpoints() = checkpoints;
+
+      arma::mat cpOutput(3, batchSize), cpG(7, batchSize),
+          cpGradient(network.WeightSize(), 1);
+      network.Forward(input, cpOutput);
+      network.Backward(input, cpOutput, gy, cpG);
+      network.Gradient(input, gy, cpGradient);
+      CheckMatrices(output, cpOutput, 1e-10);
+      CheckMatrices(g, cpG, 1e-10);
+      CheckMatrices(gradient, cpGradient, 1e-10);
+
+      arma::mat fusedG(7, batchSize), fusedGradient(network.WeightSize(), 1);
+      network.Forward(input, cpOutput);
+      network.BackwardWithGradient(input, cpOutput, gy, fusedG, fusedGradient);
+      CheckMatrices(g, fusedG, 1e-10);
+      CheckMatrices(gradient, fusedGradient, 1e-10);
+    }
+  }
+
+  // Checkpointing through an FFN should not change the objective or gradient.
+  arma::mat data(6, 20, arma::fill::randn);
+  arma::mat labels = arma::randi<arma::mat>(1, 20, arma::distr_param(0, 2));
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(10);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(5);
+  model.Add<ReLU>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+  model.ResetData(data, labels);
+  model.Reset(6);
+  model.SetNetworkMode(true);
+
+  arma::mat gradient, cpGradient;
+  const double objective = model.EvaluateWithGradient(model.Parameters(), 0,
+      gradient, 20);
+  model.Checkpoints() = { 1, 3 };
+  const double cpObjective = model.EvaluateWithGradient(model.Parameters(), 0,
+      cpGradient, 20);
+
+  REQUIRE(cpObjective == Approx(objective).epsilon(1e-10));
+  CheckMatrices(gradient, cpGradient, 1e-10);
+}
+
+/**
+ * Make sure that the aliases MultiLayer keeps between passes are made again
+ * when the layers change, by comparing with a copy (which makes new aliases).
+ */
+TEST_CASE("MultiLayerAliasReuseTest", "[FeedForwardNetworkTest]")
+{
+  MultiLayer<arma::mat> network;
+  network.Add<Linear>(6);
+  network.Add<Sigmoid>();
+  network.Add<Linear>(3);
+  network.InputDimensions() = std::vector<size_t>({ 5 });
+
+  arma::mat input(5, 10, arma::fill::randn);
+  arma::mat output, g, gradient, gy;
+  for (size_t trial = 0; trial < 2; ++trial)
+  {
+    network.ComputeOutputDimensions();
+    arma::mat weights(network.WeightSize(), 1, arma::fill::randn);
+    network.SetWeights(weights);
+    MultiLayer<arma::mat> copy(network);
+
+    // Reuse the same matrices for a few passes, like an optimizer does.
+    output.set_size(network.OutputSize(), input.n_cols);
+    gy.randn(network.OutputSize(), input.n_cols);
+    g.set_size(arma::size(input));
+    gradient.set_size(network.WeightSize(), 1);
+    for (size_t i = 0; i < 3; ++i)
+    {
+      network.Forward(input, output);
+      network.BackwardWithGradient(input, output, gy, g, gradient);
+    }
+
+    arma::mat copyOutput(copy.OutputSize(), input.n_cols), copyG(arma::size(g)),
+        copyGradient(copy.WeightSize(), 1);
+    copy.Forward(input, copyOutput);
+    copy.BackwardWithGradient(input, copyOutput, gy, copyG, copyGradient);
+
+    CheckMatrices(output, copyOutput, 1e-10);
+    CheckMatrices(g, copyG, 1e-10);
+    CheckMatrices(gradient, copyGradient, 1e-10);
+
+    // Now change the layers for the next trial.
+    network.Add<TanH>();
+    network.Add<Linear>(4);
+  }
+}
+
+/**
+ * Make sure that splitting each batch over several workers gives the same
+ * objective and gradient as a single worker.
+ */
+TEST_CASE("FFNParallelWorkersGradientTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(6, 23, arma::fill::randn);
+  arma::mat labels = arma::randi<arma::mat>(1, 23, arma::distr_param(0, 2));
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(10);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(5);
+  model.Add<ReLU>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+  model.ResetData(data, labels);
+  model.Reset(6);
+  model.SetNetworkMode(true);
+
+  for (const size_t batchSize : { 23, 10, 3 })
+  {
+    arma::mat gradient;
+    model.Workers() = 1;
+    const double objective = model.EvaluateWithGradient(model.Parameters(), 0,
+        gradient, batchSize);
+
+    for (const size_t workers : { 2, 3, 4, 7 })
+    {
+      arma::mat parallelGradient;
+      model.Workers() = workers;
+      const double parallelObjective = model.EvaluateWithGradient(
+          model.Parameters(), 0, parallelGradient, batchSize);
+
+      REQUIRE(parallelObjective == Approx(objective).epsilon(1e-10));
+      CheckMatrices(gradient, parallelGradient, 1e-8);
+    }
+  }
+
+  // Training with several workers should still work.
+  model.Workers() = 4;
+  ens::RMSProp opt(0.01, 8, 0.88, 1e-8, 5 * data.n_cols, -1);
+  model.Train(data, labels, opt);
+  arma::mat predictions;
+  model.Predict(data, predictions);
+  REQUIRE(predictions.n_cols == data.n_cols);
+}
+
+/**
+ * Make sure that predictions made through inference contexts, from several
+ * threads at once, are the same as those of Predict().
+ */
+TEST_CASE("FFNInferenceContextTest", "[FeedForwardNetworkTest]")
+{
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(8);
+  model.Add<ReLU>();
+  model.Add<Dropout>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+
+  // The network must be initialized first.
+  InferenceContext<> context;
+  REQUIRE_THROWS_AS(model.InitContext(context), std::invalid_argument);
+  arma::mat data(10, 200, arma::fill::randn), output;
+  REQUIRE_THROWS_AS(model.Predict(context, data, output),
+      std::invalid_argument);
+
+  model.Reset(10);
+  model.Parameters().randn();
+
+  arma::mat predictions;
+  model.Predict(data, predictions);
+
+  // Each thread predicts a quarter of the points, in batches of 7, with its
+  // own context.
+  arma::mat contextPredictions(predictions.n_rows, predictions.n_cols);
+  std::vector<InferenceContext<>> contexts(4);
+  for (size_t i = 0; i < contexts.size(); ++i)
+    model.InitContext(contexts[i]);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < contexts.size(); ++i)
+  {
+    arma::mat threadPredictions;
+    const arma::mat threadData = data.cols(50 * i, 50 * i + 49);
+    const FFN<NegativeLogLikelihood>& constModel = model;
+    constModel.Predict(contexts[i], threadData, threadPredictions, 7);
+    contextPredictions.cols(50 * i, 50 * i + 49) = threadPredictions;
+  }
+
+  CheckMatrices(predictions, contextPredictions, 1e-10);
+
+  // The input size must be right.
+  REQUIRE_THROWS_AS(model.Predict(contexts[0], arma::mat(9, 5), output),
+      std::logic_error);
+}
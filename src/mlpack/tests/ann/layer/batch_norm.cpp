@@ -215,6 +215,79 @@ TEST_CASE("BatchNormSerializationTest", "[ANNLayerTest]")
   ANNLayerSerializationTest(layer);
 }
 
+/**
+ * Check the forward pass, the backward pass and the gradient of a BatchNorm
+ * layer with several channels and a higher dimension against a direct
+ * computation of the statistics of each channel.
+ */
+TEST_CASE("BatchNormMultiChannelTest", "[ANNLayerTest]")
+{
+  // 4 x 3 inputs with 2 channels, with a higher dimension of 2.
+  const size_t batchSize = 5;
+  BatchNorm module(2, 2);
+  module.Training() = true;
+  module.InputDimensions() = std::vector<size_t>({ 4, 3, 2, 2 });
+  module.ComputeOutputDimensions();
+  arma::mat params(module.WeightSize(), 1, arma::fill::randu);
+  module.SetWeights(params);
+  const arma::vec gamma = params.rows(0, 1);
+  const arma::vec beta = params.rows(2, 3);
+
+  arma::mat input(48, batchSize, arma::fill::randn);
+  input += 3.0;
+  arma::mat output(48, batchSize);
+  module.Forward(input, output);
+
+  // Gather the 60 values of each channel.
+  const arma::cube inputCube(input.memptr(), 12, 2, 2 * batchSize);
+  const arma::cube outputCube(output.memptr(), 12, 2, 2 * batchSize);
+  arma::mat xhat(60, 2);
+  for (size_t c = 0; c < 2; ++c)
+  {
+    arma::vec values(60);
+    for (size_t s = 0; s < 2 * batchSize; ++s)
+      values.subvec(12 * s, 12 * s + 11) = inputCube.slice(s).col(c);
+
+    const double mean = arma::mean(values);
+    const double var = arma::accu(arma::square(values - mean)) / 60;
+    REQUIRE(module.TrainingMean()[c] == Approx(mean).epsilon(1e-8));
+    REQUIRE(module.TrainingVariance()[c] ==
+        Approx(var * 60 / 59).epsilon(1e-8));
+
+    xhat.col(c) = (values - mean) / std::sqrt(var + 1e-8);
+    for (size_t s = 0; s < 2 * batchSize; ++s)
+    {
+      CheckMatrices(outputCube.slice(s).col(c), gamma[c] *
+          xhat.col(c).subvec(12 * s, 12 * s + 11) + beta[c], 1e-8);
+    }
+  }
+
+  arma::mat gy(48, batchSize, arma::fill::randn), g(48, batchSize);
+  module.Backward(input, output, gy, g);
+  arma::mat gradient(module.WeightSize(), 1);
+  module.Gradient(input, gy, gradient);
+
+  // The backpropagated error of each channel is orthogonal to the constant
+  // vector and to the normalized input, and the gradient of gamma and beta are
+  // the projections of the error on them.
+  const arma::cube gyCube(gy.memptr(), 12, 2, 2 * batchSize);
+  const arma::cube gCube(g.memptr(), 12, 2, 2 * batchSize);
+  for (size_t c = 0; c < 2; ++c)
+  {
+    arma::vec dy(60), dx(60);
+    for (size_t s = 0; s < 2 * batchSize; ++s)
+    {
+      dy.subvec(12 * s, 12 * s + 11) = gyCube.slice(s).col(c);
+      dx.subvec(12 * s, 12 * s + 11) = gCube.slice(s).col(c);
+    }
+
+    REQUIRE(arma::accu(dx) == Approx(0.0).margin(1e-8));
+    REQUIRE(arma::dot(dx, xhat.col(c)) == Approx(0.0).margin(1e-8));
+    REQUIRE(gradient[c] == Approx(arma::dot(dy, xhat.col(c))).epsilon(1e-8));
+    REQUIRE(gradient[2 + c] == Approx(arma::accu(dy)).epsilon(1e-8));
+  }
+}
+
 TEST_CASE("BatchNormWithMinBatchesTest", "[ANNLayerTest]")
 {
   arma::mat input, output, result, runningMean, runningVar, delta;
@@ -167,6 +167,73 @@ TEST_CASE("ConcatAlongAxisTest", "[ANNLayerTest]")
   delete moduleB;
 }
 
+/**
+ * Make sure that the backward pass and the gradient of the Concat layer pass
+ * the right part of the error to each held layer, when concatenating along an
+ * axis that is not the last one, with a batch of several points.
+ */
+TEST_CASE("ConcatBackwardAlongAxisTest", "[ANNLayerTest]")
+{
+  const size_t batchSize = 3;
+  arma::mat input(5 * 5 * 2, batchSize, arma::fill::randu);
+
+  Concat module(1);
+  module.Add<Convolution>(2, 3, 3, 1, 1, 0, 0);
+  module.Add<Convolution>(2, 3, 3, 1, 1, 0, 1);
+  module.InputDimensions() = std::vector<size_t>({ 5, 5, 2 });
+  module.ComputeOutputDimensions();
+  arma::mat weights(module.WeightSize(), 1, arma::fill::randu);
+  module.SetWeights(weights);
+
+  // Both layers have output size 3 along the first axis and 2 along the last
+  // one; along the second axis, the first one has size 3 and the second one
+  // has size 5.
+  REQUIRE(module.OutputDimensions() == std::vector<size_t>({ 3, 8, 2 }));
+
+  arma::mat output(module.OutputSize(), batchSize);
+  module.Forward(input, output);
+
+  arma::mat gy(module.OutputSize(), batchSize, arma::fill::randn);
+  arma::mat g(input.n_rows, batchSize), gradient(module.WeightSize(), 1);
+  module.Backward(input, output, gy, g);
+  module.Gradient(input, gy, gradient);
+
+  // Compute the expected results by splitting gy by hand.
+  arma::mat expectedG(input.n_rows, batchSize, arma::fill::zeros);
+  arma::mat expectedGradient(module.WeightSize(), 1);
+  size_t startCol = 0, startParam = 0;
+  for (size_t i = 0; i < 2; ++i)
+  {
+    Layer<arma::mat>* layer = module.Network()[i];
+    const size_t cols = layer->OutputDimensions()[1];
+
+    arma::mat layerGy(layer->OutputSize(), batchSize);
+    for (size_t p = 0; p < batchSize; ++p)
+    {
+      arma::cube gyCube(gy.colptr(p), 3, 8, 2, false, true);
+      arma::cube layerGyCube(layerGy.colptr(p), 3, cols, 2, false, true);
+      layerGyCube = gyCube.cols(startCol, startCol + cols - 1);
+    }
+
+    arma::mat layerOutput(layer->OutputSize(), batchSize);
+    layer->Forward(input, layerOutput);
+    arma::mat layerG(input.n_rows, batchSize);
+    layer->Backward(input, layerOutput, layerGy, layerG);
+    expectedG += layerG;
+
+    arma::mat layerGradient(layer->WeightSize(), 1);
+    layer->Gradient(input, layerGy, layerGradient);
+    expectedGradient.rows(startParam, startParam + layer->WeightSize() - 1) =
+        layerGradient;
+
+    startCol += cols;
+    startParam += layer->WeightSize();
+  }
+
+  CheckMatrices(g, expectedG, 1e-10);
+  CheckMatrices(gradient, expectedGradient, 1e-10);
+}
+
 /**
  * Test that the function that can access the axis parameter of the
  * Concat layer works.
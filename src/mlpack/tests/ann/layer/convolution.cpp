@@ -462,3 +462,116 @@ TEST_CASE("NonSquareConvolutionTest", "[ANNLayerTest]")
   arma::mat gradientResult(module1.WeightSize(), 1);
   REQUIRE_NOTHROW(module1.Gradient(data, backwardResult, gradientResult));
 }
+
+/**
+ * Make sure that the default (im2col) Convolution layer gives the same results
+ * as a Convolution layer that uses the naive convolution rule, with stride,
+ * padding, multiple maps and a batch of points.
+ */
+TEST_CASE("Im2ColConvolutionLayerEquivalenceTest", "[ANNLayerTest]")
+{
+  using NaiveConvolutionLayer = ConvolutionType<
+      NaiveConvolution<ValidConvolution>,
+      NaiveConvolution<FullConvolution>,
+      NaiveConvolution<ValidConvolution>,
+      arma::mat>;
+
+  NaiveConvolutionLayer naive(4, 3, 2, 2, 2, 1, 2);
+  Convolution im2col(4, 3, 2, 2, 2, 1, 2);
+  naive.InputDimensions() = std::vector<size_t>({ 9, 8, 3 });
+  im2col.InputDimensions() = std::vector<size_t>({ 9, 8, 3 });
+  naive.ComputeOutputDimensions();
+  im2col.ComputeOutputDimensions();
+  REQUIRE(naive.OutputSize() == im2col.OutputSize());
+
+  arma::mat weights(naive.WeightSize(), 1, arma::fill::randn);
+  naive.SetWeights(weights);
+  arma::mat weights2(weights);
+  im2col.SetWeights(weights2);
+
+  arma::mat input(9 * 8 * 3, 3, arma::fill::randu);
+  arma::mat naiveOutput(naive.OutputSize(), 3);
+  arma::mat im2colOutput(im2col.OutputSize(), 3);
+  naive.Forward(input, naiveOutput);
+  im2col.Forward(input, im2colOutput);
+  CheckMatrices(naiveOutput, im2colOutput, 1e-4);
+
+  arma::mat error(naive.OutputSize(), 3, arma::fill::randn);
+  arma::mat naiveDelta(input.n_rows, 3);
+  arma::mat im2colDelta(input.n_rows, 3);
+  naive.Backward(input, naiveOutput, error, naiveDelta);
+  im2col.Backward(input, im2colOutput, error, im2colDelta);
+  CheckMatrices(naiveDelta, im2colDelta, 1e-4);
+
+  arma::mat naiveGradient(naive.WeightSize(), 1);
+  arma::mat im2colGradient(im2col.WeightSize(), 1);
+  naive.Gradient(input, error, naiveGradient);
+  im2col.Gradient(input, error, im2colGradient);
+  CheckMatrices(naiveGradient, im2colGradient, 1e-4);
+}
+
+/**
+ * Check that a Convolution layer with the given convolution rules gives the
+ * same forward pass, backward pass and gradient as with NaiveConvolution, for
+ * 3x3 filters with stride 1 (where WinogradConvolution uses the Winograd
+ * algorithm).
+ */
+template<typename ConvolutionLayerType>
+void CheckWinogradConvolutionLayer()
+{
+  using NaiveConvolutionLayer = ConvolutionType<
+      NaiveConvolution<ValidConvolution>,
+      NaiveConvolution<FullConvolution>,
+      NaiveConvolution<ValidConvolution>,
+      arma::mat>;
+
+  // The output (9 x 8 with the padding) is not a multiple of the tile size.
+  NaiveConvolutionLayer naive(4, 3, 3, 1, 1, 1, 1);
+  ConvolutionLayerType winograd(4, 3, 3, 1, 1, 1, 1);
+  naive.InputDimensions() = std::vector<size_t>({ 9, 8, 3 });
+  winograd.InputDimensions() = std::vector<size_t>({ 9, 8, 3 });
+  naive.ComputeOutputDimensions();
+  winograd.ComputeOutputDimensions();
+  REQUIRE(naive.OutputSize() == winograd.OutputSize());
+
+  arma::mat weights(naive.WeightSize(), 1, arma::fill::randn);
+  naive.SetWeights(weights);
+  arma::mat weights2(weights);
+  winograd.SetWeights(weights2);
+
+  arma::mat input(9 * 8 * 3, 3, arma::fill::randu);
+  arma::mat naiveOutput(naive.OutputSize(), 3);
+  arma::mat winogradOutput(winograd.OutputSize(), 3);
+  naive.Forward(input, naiveOutput);
+  winograd.Forward(input, winogradOutput);
+  CheckMatrices(naiveOutput, winogradOutput, 1e-4);
+
+  arma::mat error(naive.OutputSize(), 3, arma::fill::randn);
+  arma::mat naiveDelta(input.n_rows, 3);
+  arma::mat winogradDelta(input.n_rows, 3);
+  naive.Backward(input, naiveOutput, error, naiveDelta);
+  winograd.Backward(input, winogradOutput, error, winogradDelta);
+  CheckMatrices(naiveDelta, winogradDelta, 1e-4);
+
+  arma::mat naiveGradient(naive.WeightSize(), 1);
+  arma::mat winogradGradient(winograd.WeightSize(), 1);
+  naive.Gradient(input, error, naiveGradient);
+  winograd.Gradient(input, error, winogradGradient);
+  CheckMatrices(naiveGradient, winogradGradient, 1e-4);
+}
+
+/**
+ * Make sure that the Winograd algorithm, with both tile sizes, gives the same
+ * results as the naive convolution in a Convolution layer.
+ */
+TEST_CASE("WinogradConvolutionLayerEquivalenceTest", "[ANNLayerTest]")
+{
+  // The default Convolution layer uses F(2 x 2, 3 x 3).
+  CheckWinogradConvolutionLayer<Convolution>();
+
+  CheckWinogradConvolutionLayer<ConvolutionType<
+      WinogradConvolution<ValidConvolution, 4>,
+      WinogradConvolution<FullConvolution, 4>,
+      WinogradConvolution<ValidConvolution, 4>,
+      arma::mat>>();
+}
@@ -100,3 +100,49 @@ TEST_CASE("NoDropoutTest", "[ANNLayerTest]")
   REQUIRE(accu(output) == accu(input));
 }
 
+
+/**
+ * Make sure that the backward pass of Dropout uses the mask of the forward
+ * pass, for a batch whose number of rows is not a multiple of 64, and that the
+ * mask only depends on the random seed.
+ */
+TEST_CASE("DropoutMaskTest", "[ANNLayerTest]")
+{
+  arma::mat input(70, 9, arma::fill::randu);
+  input += 0.5;
+  arma::mat gy(70, 9, arma::fill::randu);
+  gy += 0.5;
+
+  Dropout module(0.3);
+  module.Training() = true;
+
+  RandomSeed(17);
+  arma::mat output, g;
+  module.Forward(input, output);
+  module.Backward(input, output, gy, g);
+
+  size_t dropped = 0;
+  for (size_t i = 0; i < input.n_elem; ++i)
+  {
+    if (output[i] == 0.0)
+    {
+      REQUIRE(g[i] == 0.0);
+      ++dropped;
+    }
+    else
+    {
+      REQUIRE(output[i] == Approx(input[i] / 0.7).epsilon(1e-12));
+      REQUIRE(g[i] == Approx(gy[i] / 0.7).epsilon(1e-12));
+    }
+  }
+
+  // About 30% of the 630 elements should be dropped.
+  REQUIRE(dropped > 120);
+  REQUIRE(dropped < 260);
+
+  // The same seed gives the same mask.
+  RandomSeed(17);
+  arma::mat output2;
+  module.Forward(input, output2);
+  CheckMatrices(output, output2);
+}
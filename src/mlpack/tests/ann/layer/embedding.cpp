@@ -0,0 +1,129 @@
+/**
+ * @file tests/ann/layer/embedding.cpp
+ *
+ * Tests the Embedding layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "../../test_catch_tools.hpp"
+#include "../../catch.hpp"
+#include "../../serialization.hpp"
+#include "../ann_test_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * The output should hold the embeddings of the tokens, and the sparse
+ * gradients should match the dense gradient.
+ */
+TEST_CASE("EmbeddingLayerTest", "[ANNLayerTest]")
+{
+  Embedding module(50, 4);
+  module.InputDimensions() = std::vector<size_t>({ 3 });
+  module.ComputeOutputDimensions();
+  REQUIRE(module.OutputDimensions() == std::vector<size_t>({ 4, 3 }));
+  REQUIRE(module.WeightSize() == 200);
+
+  arma::mat weights(module.WeightSize(), 1, arma::fill::randn);
+  module.SetWeights(weights);
+
+  // Token 7 appears several times.
+  arma::mat input = { { 7, 0, 49, 7 },
+                      { 7, 3, 2, 11 },
+                      { 1, 7, 2, 30 } };
+  arma::mat output(12, 4);
+  module.Forward(input, output);
+
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    for (size_t t = 0; t < input.n_rows; ++t)
+    {
+      REQUIRE(arma::approx_equal(output.submat(4 * t, i, 4 * t + 3, i),
+          module.Parameters().col((size_t) input(t, i)), "absdiff", 1e-12));
+    }
+  }
+
+  // The tokens have no gradient.
+  arma::mat delta(3, 4, arma::fill::ones);
+  arma::mat error(12, 4, arma::fill::randn);
+  module.Backward(input, output, error, delta);
+  REQUIRE(arma::accu(arma::abs(delta)) == 0.0);
+
+  arma::mat gradient(module.WeightSize(), 1);
+  module.Gradient(input, error, gradient);
+  const arma::mat gradientMat = arma::reshape(gradient, 4, 50);
+
+  arma::uvec tokens;
+  arma::mat tokenGradients;
+  module.SparseGradient(input, error, tokens, tokenGradients);
+  REQUIRE(arma::all(tokens == arma::uvec({ 0, 1, 2, 3, 7, 11, 30, 49 })));
+  REQUIRE(arma::approx_equal(tokenGradients, gradientMat.cols(tokens),
+      "absdiff", 1e-12));
+
+  // Token 7 gets the sum of the errors of its four occurrences.
+  const arma::vec expected = error.submat(0, 0, 3, 0) +
+      error.submat(4, 0, 7, 0) + error.submat(8, 1, 11, 1) +
+      error.submat(0, 3, 3, 3);
+  REQUIRE(arma::approx_equal(gradientMat.col(7), expected, "absdiff", 1e-12));
+
+  // The sparse matrix only holds the columns of the tokens.
+  arma::sp_mat sparseGradient;
+  module.SparseGradient(input, error, sparseGradient);
+  REQUIRE(sparseGradient.n_rows == 4);
+  REQUIRE(sparseGradient.n_cols == 50);
+  REQUIRE(sparseGradient.n_nonzero <= 4 * tokens.n_elem);
+  REQUIRE(arma::approx_equal(arma::mat(sparseGradient), gradientMat,
+      "absdiff", 1e-12));
+
+  // Tokens out of the vocabulary are rejected.
+  arma::mat badInput = { { 1 }, { 50 }, { 2 } };
+  arma::mat badOutput(12, 1);
+  REQUIRE_THROWS_AS(module.Forward(badInput, badOutput),
+      std::invalid_argument);
+}
+
+/**
+ * Embedding layer numerical gradient test.
+ */
+TEST_CASE("GradientEmbeddingLayerTest", "[ANNLayerTest]")
+{
+  // Embedding function gradient instantiation.
+  struct GradientFunction
+  {
+    GradientFunction() :
+        input({ { 3, 1 }, { 0, 3 }, { 5, 2 } }),
+        target({ { 1, 0 } })
+    {
+      model = new FFN<NegativeLogLikelihood, RandomInitialization>();
+      model->ResetData(input, target);
+      model->Add<Embedding>(6, 4);
+      model->Add<Linear>(2);
+      model->Add<LogSoftMax>();
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      double error = model->Evaluate(model->Parameters(), 0, 2);
+      model->Gradient(model->Parameters(), 0, gradient, 2);
+      return error;
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    FFN<NegativeLogLikelihood, RandomInitialization>* model;
+    arma::mat input, target;
+  } function;
+
+  REQUIRE(CheckGradient(function) <= 1e-4);
+}
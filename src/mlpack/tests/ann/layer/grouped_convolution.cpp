@@ -224,3 +224,95 @@ TEST_CASE("NonSquareGroupedConvolutionTest", "[ANNLayerTest]")
   arma::mat gradientResult(module1.WeightSize(), 1);
   REQUIRE_NOTHROW(module1.Gradient(data, backwardResult, gradientResult));
 }
+
+/**
+ * Make sure that the default (im2col) GroupedConvolution layer gives the same
+ * results as a GroupedConvolution layer that uses the naive convolution rule.
+ */
+TEST_CASE("Im2ColGroupedConvolutionLayerEquivalenceTest", "[ANNLayerTest]")
+{
+  using NaiveGroupedConvolutionLayer = GroupedConvolutionType<
+      NaiveConvolution<ValidConvolution>,
+      NaiveConvolution<FullConvolution>,
+      NaiveConvolution<ValidConvolution>,
+      arma::mat>;
+
+  NaiveGroupedConvolutionLayer naive(4, 3, 2, 2, 2, 1, 1, 2);
+  GroupedConvolution im2col(4, 3, 2, 2, 2, 1, 1, 2);
+  naive.InputDimensions() = std::vector<size_t>({ 7, 6, 6 });
+  im2col.InputDimensions() = std::vector<size_t>({ 7, 6, 6 });
+  naive.ComputeOutputDimensions();
+  im2col.ComputeOutputDimensions();
+  REQUIRE(naive.OutputSize() == im2col.OutputSize());
+
+  arma::mat weights(naive.WeightSize(), 1, arma::fill::randn);
+  naive.SetWeights(weights);
+  arma::mat weights2(weights);
+  im2col.SetWeights(weights2);
+
+  arma::mat input(7 * 6 * 6, 3, arma::fill::randu);
+  arma::mat naiveOutput(naive.OutputSize(), 3);
+  arma::mat im2colOutput(im2col.OutputSize(), 3);
+  naive.Forward(input, naiveOutput);
+  im2col.Forward(input, im2colOutput);
+  CheckMatrices(naiveOutput, im2colOutput, 1e-4);
+
+  arma::mat error(naive.OutputSize(), 3, arma::fill::randn);
+  arma::mat naiveDelta(input.n_rows, 3);
+  arma::mat im2colDelta(input.n_rows, 3);
+  naive.Backward(input, naiveOutput, error, naiveDelta);
+  im2col.Backward(input, im2colOutput, error, im2colDelta);
+  CheckMatrices(naiveDelta, im2colDelta, 1e-4);
+
+  arma::mat naiveGradient(naive.WeightSize(), 1);
+  arma::mat im2colGradient(im2col.WeightSize(), 1);
+  naive.Gradient(input, error, naiveGradient);
+  im2col.Gradient(input, error, im2colGradient);
+  CheckMatrices(naiveGradient, im2colGradient, 1e-4);
+}
+
+/**
+ * Make sure that the Winograd algorithm gives the same results as the naive
+ * convolution in a GroupedConvolution layer with 3x3 filters and stride 1.
+ */
+TEST_CASE("WinogradGroupedConvolutionLayerEquivalenceTest", "[ANNLayerTest]")
+{
+  using NaiveGroupedConvolutionLayer = GroupedConvolutionType<
+      NaiveConvolution<ValidConvolution>,
+      NaiveConvolution<FullConvolution>,
+      NaiveConvolution<ValidConvolution>,
+      arma::mat>;
+
+  NaiveGroupedConvolutionLayer naive(4, 3, 3, 2, 1, 1, 1, 1);
+  GroupedConvolution winograd(4, 3, 3, 2, 1, 1, 1, 1);
+  naive.InputDimensions() = std::vector<size_t>({ 7, 6, 6 });
+  winograd.InputDimensions() = std::vector<size_t>({ 7, 6, 6 });
+  naive.ComputeOutputDimensions();
+  winograd.ComputeOutputDimensions();
+  REQUIRE(naive.OutputSize() == winograd.OutputSize());
+
+  arma::mat weights(naive.WeightSize(), 1, arma::fill::randn);
+  naive.SetWeights(weights);
+  arma::mat weights2(weights);
+  winograd.SetWeights(weights2);
+
+  arma::mat input(7 * 6 * 6, 3, arma::fill::randu);
+  arma::mat naiveOutput(naive.OutputSize(), 3);
+  arma::mat winogradOutput(winograd.OutputSize(), 3);
+  naive.Forward(input, naiveOutput);
+  winograd.Forward(input, winogradOutput);
+  CheckMatrices(naiveOutput, winogradOutput, 1e-4);
+
+  arma::mat error(naive.OutputSize(), 3, arma::fill::randn);
+  arma::mat naiveDelta(input.n_rows, 3);
+  arma::mat winogradDelta(input.n_rows, 3);
+  naive.Backward(input, naiveOutput, error, naiveDelta);
+  winograd.Backward(input, winogradOutput, error, winogradDelta);
+  CheckMatrices(naiveDelta, winogradDelta, 1e-4);
+
+  arma::mat naiveGradient(naive.WeightSize(), 1);
+  arma::mat winogradGradient(winograd.WeightSize(), 1);
+  naive.Gradient(input, error, naiveGradient);
+  winograd.Gradient(input, error, winogradGradient);
+  CheckMatrices(naiveGradient, winogradGradient, 1e-4);
+}
@@ -0,0 +1,95 @@
+/**
+ * @file gru.cpp
+ *
+ * Tests the GRU layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann/ann.hpp>
+
+#include "../../test_catch_tools.hpp"
+#include "../../catch.hpp"
+#include "../../serialization.hpp"
+#include "../ann_test_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * GRU layer numerical gradient test, over several time steps.
+ */
+TEST_CASE("GradientGRULayerTest", "[ANNLayerTest]")
+{
+  // GRU function gradient instantiation.
+  struct GradientFunction
+  {
+    GradientFunction() :
+        input(arma::randu(4, 1, 5)),
+        target(arma::randu(1, 1, 5))
+    {
+      const size_t rho = 5;
+
+      model = RNN<MeanSquaredError, RandomInitialization>(rho);
+      model.ResetData(input, target);
+      model.Add<GRU>(3);
+      model.Add<Linear>(1);
+      model.InputDimensions() = std::vector<size_t>{ 4 };
+    }
+
+    double Gradient(arma::mat& gradient)
+    {
+      gradient.zeros(model.Parameters().n_elem, 1);
+      return model.EvaluateWithGradient(model.Parameters(), 0, gradient, 1);
+    }
+
+    arma::mat& Parameters() { return model.Parameters(); }
+
+    RNN<MeanSquaredError, RandomInitialization> model;
+    arma::cube input, target;
+  } function;
+
+  REQUIRE(CheckGradient(function) <= 1e-4);
+}
+
+/**
+ * Make sure the stacked-gate forward pass computes the GRU equations.
+ */
+TEST_CASE("GRUForwardTest", "[ANNLayerTest]")
+{
+  const size_t inputSize = 16;
+  const size_t batchSize = 32;
+  const size_t outputSize = 10;
+
+  GRU l(outputSize);
+  l.InputDimensions() = std::vector<size_t>{ inputSize };
+  l.ComputeOutputDimensions();
+
+  arma::mat weights(l.WeightSize(), 1, arma::fill::randu);
+  weights -= 0.5;
+  l.SetWeights(weights);
+  l.ClearRecurrentState(2, batchSize);
+
+  // Set the recurrent state to random values.
+  l.CurrentStep(1);
+  l.RecurrentState(l.PreviousStep()).randu();
+
+  arma::mat h;
+  MakeAlias(h, l.RecurrentState(l.PreviousStep()), outputSize, batchSize);
+
+  arma::mat input(inputSize, batchSize, arma::fill::randu);
+  arma::mat output;
+  l.Forward(input, output);
+
+  arma::mat a = l.InputWeight() * input + repmat(l.Bias(), 1, batchSize);
+  a.rows(0, 2 * outputSize - 1) += l.RecurrentWeight() * h;
+  arma::mat z = 1.0 / (1.0 + exp(-a.rows(0, outputSize - 1)));
+  arma::mat r = 1.0 / (1.0 + exp(-a.rows(outputSize, 2 * outputSize - 1)));
+  arma::mat o = tanh(a.rows(2 * outputSize, 3 * outputSize - 1) +
+      l.CandidateRecurrentWeight() * (r % h));
+  arma::mat expectedOutput = z % h + (1 - z) % o;
+
+  REQUIRE(approx_equal(output, expectedOutput, "both", 1e-5, 1e-5));
+}
@@ -61,6 +61,49 @@ TEST_CASE("LayerNormTest", "[ANNLayerTest]")
   result.clear();
 }
 
+/**
+ * Check the LayerNorm layer on a larger batch against a direct computation of
+ * the statistics of each point.
+ */
+TEST_CASE("LayerNormBatchTest", "[ANNLayerTest]")
+{
+  arma::mat input(20, 64, arma::fill::randn), output;
+  input.each_row() += arma::linspace<arma::rowvec>(-5, 5, 64);
+
+  LayerNorm model;
+  model.InputDimensions() = std::vector<size_t>({ 20 });
+  model.ComputeOutputDimensions();
+  arma::mat weights(model.WeightSize(), 1, arma::fill::randu);
+  model.SetWeights(weights);
+  const arma::vec gamma = weights.rows(0, 19);
+  const arma::vec beta = weights.rows(20, 39);
+
+  model.Forward(input, output);
+
+  const arma::rowvec mean = arma::mean(input);
+  const arma::rowvec var = arma::var(input, 1);
+  CheckMatrices(model.Mean(), mean, 1e-8);
+  CheckMatrices(model.Variance(), var, 1e-8);
+
+  arma::mat xhat = input.each_row() - mean;
+  xhat.each_row() /= arma::sqrt(var + 1e-8);
+  arma::mat expected = xhat.each_col() % gamma;
+  expected.each_col() += beta;
+  CheckMatrices(output, expected, 1e-8);
+
+  // The backpropagated error of each point is orthogonal to the constant
+  // vector and to the normalized point.
+  arma::mat gy(20, 64, arma::fill::randn), g;
+  model.Backward(input, output, gy, g);
+  CheckMatrices(arma::sum(g), arma::zeros<arma::rowvec>(64), 1e-8);
+  CheckMatrices(arma::sum(g % xhat), arma::zeros<arma::rowvec>(64), 1e-8);
+
+  arma::mat gradient;
+  model.Gradient(input, gy, gradient);
+  CheckMatrices(gradient.rows(0, 19), arma::sum(gy % xhat, 1), 1e-8);
+  CheckMatrices(gradient.rows(20, 39), arma::sum(gy, 1), 1e-8);
+}
+
 /**
  * LayerNorm layer numerical gradient test.
  */
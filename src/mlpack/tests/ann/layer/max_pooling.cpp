@@ -112,3 +112,61 @@ TEST_CASE("MaxPoolingTestCase", "[ANNLayerTest]")
   REQUIRE(output.n_elem == 4);
   REQUIRE(output.n_cols == 1);
 }
+
+/**
+ * Compare the MaxPooling layer with a direct computation of the maximum of each
+ * window, with windows that are cut by the border of the input.
+ */
+TEST_CASE("MaxPoolingWindowTest", "[ANNLayerTest]")
+{
+  for (const bool floor : { true, false })
+  {
+    MaxPooling module(3, 2, 2, 2, floor);
+    module.InputDimensions() = std::vector<size_t>({ 8, 7, 3 });
+    module.ComputeOutputDimensions();
+    const size_t outRows = module.OutputDimensions()[0];
+    const size_t outCols = module.OutputDimensions()[1];
+    REQUIRE(outRows == (floor ? 3 : 4));
+    REQUIRE(outCols == (floor ? 3 : 4));
+
+    arma::mat input(8 * 7 * 3, 5, arma::fill::randn);
+    arma::mat output(module.OutputSize(), 5);
+    module.Training() = true;
+    module.Forward(input, output);
+
+    arma::mat gy(module.OutputSize(), 5, arma::fill::randn);
+    arma::mat g(input.n_rows, input.n_cols);
+    module.Backward(input, output, gy, g);
+
+    const arma::cube inputCube(input.memptr(), 8, 7, 15);
+    const arma::cube outputCube(output.memptr(), outRows, outCols, 15);
+    const arma::cube gyCube(gy.memptr(), outRows, outCols, 15);
+    arma::cube expectedG(8, 7, 15, arma::fill::zeros);
+    for (size_t s = 0; s < 15; ++s)
+    {
+      for (size_t j = 0; j < outCols; ++j)
+      {
+        for (size_t i = 0; i < outRows; ++i)
+        {
+          const size_t rowEnd = std::min<size_t>(2 * i + 2, 7);
+          const size_t colEnd = std::min<size_t>(2 * j + 1, 6);
+          const arma::mat window = inputCube.slice(s).submat(2 * i, 2 * j,
+              rowEnd, colEnd);
+          REQUIRE(outputCube(i, j, s) == window.max());
+
+          const size_t index = window.index_max();
+          expectedG(2 * i + index % window.n_rows,
+              2 * j + index / window.n_rows, s) += gyCube(i, j, s);
+        }
+      }
+    }
+
+    CheckMatrices(arma::cube(g.memptr(), 8, 7, 15), expectedG, 1e-10);
+
+    // Inference gives the same output.
+    arma::mat inferenceOutput(module.OutputSize(), 5);
+    module.Training() = false;
+    module.Forward(input, inferenceOutput);
+    CheckMatrices(inferenceOutput, output, 1e-10);
+  }
+}
@@ -86,3 +86,42 @@ TEST_CASE("MeanPoolingTestCase", "[ANNLayerTest]")
   module2.Backward(input, output2, prevDelta2, delta2);
   REQUIRE(accu(delta2) == Approx(8.1).epsilon(1e-3));
 }
+
+/**
+ * Compare the MeanPooling layer with a direct computation of the mean of each
+ * window, with windows that are cut by the border of the input.
+ */
+TEST_CASE("MeanPoolingWindowTest", "[ANNLayerTest]")
+{
+  for (const bool floor : { true, false })
+  {
+    MeanPooling module(3, 2, 2, 2, floor);
+    module.InputDimensions() = std::vector<size_t>({ 8, 7, 3 });
+    module.ComputeOutputDimensions();
+    const size_t outRows = module.OutputDimensions()[0];
+    const size_t outCols = module.OutputDimensions()[1];
+    REQUIRE(outRows == (floor ? 3 : 4));
+    REQUIRE(outCols == (floor ? 3 : 4));
+
+    arma::mat input(8 * 7 * 3, 5, arma::fill::randn);
+    arma::mat output(module.OutputSize(), 5);
+    module.Forward(input, output);
+
+    const arma::cube inputCube(input.memptr(), 8, 7, 15);
+    const arma::cube outputCube(output.memptr(), outRows, outCols, 15);
+    for (size_t s = 0; s < 15; ++s)
+    {
+      for (size_t j = 0; j < outCols; ++j)
+      {
+        for (size_t i = 0; i < outRows; ++i)
+        {
+          const size_t rowEnd = std::min<size_t>(2 * i + 2, 7);
+          const size_t colEnd = std::min<size_t>(2 * j + 1, 6);
+          REQUIRE(outputCube(i, j, s) == Approx(arma::mean(arma::vectorise(
+              inputCube.slice(s).submat(2 * i, 2 * j, rowEnd, colEnd))))
+              .epsilon(1e-10));
+        }
+      }
+    }
+  }
+}
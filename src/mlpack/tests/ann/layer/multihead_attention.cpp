@@ -233,3 +233,75 @@ TEST_CASE("GradientMultiheadAttentionTest", "[ANNLayerTest]")
 
   REQUIRE(CheckGradient(function) <= 3e-06);
 }
+
+/**
+ * Make sure the blocked (memory-efficient) attention gives the same results as
+ * the full attention matrix, with and without masks.
+ */
+TEST_CASE("BlockedMultiheadAttentionTest", "[ANNLayerTest]")
+{
+  const size_t tgtSeqLen = 7;
+  const size_t srcSeqLen = 5;
+  const size_t embedDim = 6;
+  const size_t numHeads = 3;
+  const size_t batchSize = 4;
+
+  arma::mat attnMask = arma::zeros(tgtSeqLen, srcSeqLen);
+  for (size_t i = 0; i < tgtSeqLen; ++i)
+  {
+    for (size_t j = 0; j < srcSeqLen; ++j)
+    {
+      if (i < j)
+        attnMask(i, j) = std::numeric_limits<double>::lowest();
+    }
+  }
+
+  arma::mat keyPaddingMask = arma::zeros(1, srcSeqLen);
+  keyPaddingMask(srcSeqLen - 1) = std::numeric_limits<double>::lowest();
+
+  for (size_t useMasks = 0; useMasks < 2; ++useMasks)
+  {
+    // A block size of 2 means the last tile of both queries and keys is
+    // partial.
+    MultiheadAttention full(tgtSeqLen, numHeads);
+    MultiheadAttention blocked(tgtSeqLen, numHeads, arma::mat(), arma::mat(),
+        false, 2);
+    if (useMasks == 1)
+    {
+      full.AttentionMask() = attnMask;
+      full.KeyPaddingMask() = keyPaddingMask;
+      blocked.AttentionMask() = attnMask;
+      blocked.KeyPaddingMask() = keyPaddingMask;
+    }
+
+    full.InputDimensions() = std::vector<size_t>({ embedDim,
+        tgtSeqLen + 2 * srcSeqLen });
+    full.ComputeOutputDimensions();
+    blocked.InputDimensions() = full.InputDimensions();
+    blocked.ComputeOutputDimensions();
+
+    arma::mat weights(full.WeightSize(), 1, arma::fill::randn);
+    weights *= 0.5;
+    full.SetWeights(weights);
+    blocked.SetWeights(weights);
+
+    arma::mat input(embedDim * (tgtSeqLen + 2 * srcSeqLen), batchSize,
+        arma::fill::randu);
+
+    arma::mat output1, output2;
+    full.Forward(input, output1);
+    blocked.Forward(input, output2);
+    CheckMatrices(output1, output2, 1e-6);
+
+    arma::mat gy(embedDim * tgtSeqLen, batchSize, arma::fill::randu);
+    arma::mat g1, g2;
+    full.Backward(input, output1, gy, g1);
+    blocked.Backward(input, output2, gy, g2);
+    CheckMatrices(g1, g2, 1e-6);
+
+    arma::mat gradient1, gradient2;
+    full.Gradient(input, gy, gradient1);
+    blocked.Gradient(input, gy, gradient2);
+    CheckMatrices(gradient1, gradient2, 1e-6);
+  }
+}
@@ -0,0 +1,68 @@
+/**
+ * @file tests/ann/layer/quantized_linear.cpp
+ *
+ * Tests the QuantizedLinear layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "../../test_catch_tools.hpp"
+#include "../../catch.hpp"
+#include "../../serialization.hpp"
+#include "../ann_test_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * Make sure that the output of a QuantizedLinear layer is close to the output
+ * of the Linear layer it was built from.
+ */
+TEST_CASE("QuantizedLinearLayerTest", "[ANNLayerTest]")
+{
+  Linear linear(20);
+  linear.InputDimensions() = std::vector<size_t>({ 50 });
+  linear.ComputeOutputDimensions();
+  arma::mat weights(linear.WeightSize(), 1, arma::fill::randn);
+  linear.SetWeights(weights);
+
+  QuantizedLinear quantized(linear);
+  REQUIRE(quantized.WeightSize() == 0);
+  REQUIRE(quantized.OutputSize() == 20);
+  REQUIRE(quantized.QuantizedWeight().n_rows == 50);
+  REQUIRE(quantized.QuantizedWeight().n_cols == 20);
+
+  // The quantized weights must use the whole range of each row.
+  for (size_t i = 0; i < 20; ++i)
+  {
+    const arma::Col<arma::s8> w = quantized.QuantizedWeight().col(i);
+    REQUIRE(std::max(std::abs((int) w.max()), std::abs((int) w.min())) ==
+        127);
+  }
+
+  arma::mat input(50, 13, arma::fill::randn);
+  input.col(3).zeros(); // Make sure an all-zero point works too.
+  arma::mat output(20, 13), quantizedOutput(20, 13);
+  linear.Forward(input, output);
+  quantized.Forward(input, quantizedOutput);
+
+  REQUIRE(arma::norm(output - quantizedOutput, "fro") <
+      0.02 * arma::norm(output, "fro"));
+  for (size_t i = 0; i < 20; ++i)
+    REQUIRE(quantizedOutput(i, 3) == Approx(output(i, 3)).epsilon(1e-10));
+
+  // The layer is inference-only.
+  arma::mat delta;
+  REQUIRE_THROWS_AS(quantized.Backward(input, quantizedOutput,
+      quantizedOutput, delta), std::invalid_argument);
+
+  // The input size must match the quantized weights.
+  QuantizedLinear quantized2(quantized);
+  quantized2.InputDimensions() = std::vector<size_t>({ 49 });
+  REQUIRE_THROWS_AS(quantized2.ComputeOutputDimensions(),
+      std::invalid_argument);
+}
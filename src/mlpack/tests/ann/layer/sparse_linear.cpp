@@ -0,0 +1,83 @@
+/**
+ * @file tests/ann/layer/sparse_linear.cpp
+ *
+ * Tests the SparseLinear layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "../../test_catch_tools.hpp"
+#include "../../catch.hpp"
+#include "../../serialization.hpp"
+#include "../ann_test_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * Make sure that a SparseLinear layer stores only the nonzero weights of the
+ * Linear layer it was built from, and gives the same output.
+ */
+TEST_CASE("SparseLinearLayerTest", "[ANNLayerTest]")
+{
+  Linear linear(20);
+  linear.InputDimensions() = std::vector<size_t>({ 50 });
+  linear.ComputeOutputDimensions();
+  arma::mat weights(linear.WeightSize(), 1, arma::fill::randn);
+  linear.SetWeights(weights);
+
+  // Zero most of the weights (but not the bias).
+  linear.Weight().elem(arma::find(arma::abs(linear.Weight()) < 1.5)).zeros();
+  const size_t nonZeros = arma::accu(linear.Weight() != 0);
+
+  SparseLinear sparse(linear);
+  REQUIRE(sparse.WeightSize() == 0);
+  REQUIRE(sparse.OutputSize() == 20);
+  REQUIRE(sparse.NonZeros() == nonZeros);
+  REQUIRE(sparse.Weight().n_rows == 50);
+  REQUIRE(sparse.Weight().n_cols == 20);
+
+  arma::mat input(50, 13, arma::fill::randn);
+  arma::mat output(20, 13), sparseOutput(20, 13);
+  linear.Forward(input, output);
+  sparse.Forward(input, sparseOutput);
+  CheckMatrices(output, sparseOutput, 1e-8);
+
+  // The layer is inference-only.
+  arma::mat delta;
+  REQUIRE_THROWS_AS(sparse.Backward(input, sparseOutput, sparseOutput, delta),
+      std::invalid_argument);
+
+  // The input size must match the sparse weights.
+  SparseLinear sparse2(sparse);
+  sparse2.InputDimensions() = std::vector<size_t>({ 49 });
+  REQUIRE_THROWS_AS(sparse2.ComputeOutputDimensions(), std::invalid_argument);
+}
+
+/**
+ * Make sure that a SparseLinear layer built from a LinearNoBias layer has no
+ * bias.
+ */
+TEST_CASE("SparseLinearNoBiasLayerTest", "[ANNLayerTest]")
+{
+  LinearNoBias linear(7);
+  linear.InputDimensions() = std::vector<size_t>({ 10 });
+  linear.ComputeOutputDimensions();
+  arma::mat weights(linear.WeightSize(), 1, arma::fill::randn);
+  weights.rows(0, 29).zeros();
+  linear.SetWeights(weights);
+
+  SparseLinear sparse(linear);
+  REQUIRE(sparse.NonZeros() == 40);
+  REQUIRE(arma::all(arma::vectorise(sparse.Bias()) == 0));
+
+  arma::mat input(10, 5, arma::fill::randn);
+  arma::mat output(7, 5), sparseOutput(7, 5);
+  linear.Forward(input, output);
+  sparse.Forward(input, sparseOutput);
+  CheckMatrices(output, sparseOutput, 1e-8);
+}
@@ -30,8 +30,11 @@
 #include "layer/concatenate.cpp"
 #include "layer/c_relu.cpp"
 #include "layer/dropout.cpp"
+#include "layer/embedding.cpp"
+#include "layer/fast_lstm.cpp"
 #include "layer/flexible_relu.cpp"
 #include "layer/grouped_convolution.cpp"
+#include "layer/gru.cpp"
 #include "layer/hard_tanh.cpp"
 #include "layer/identity.cpp"
 #include "layer/linear3d.cpp"
@@ -44,6 +47,7 @@
 #include "layer/nearest_interpolation.cpp"
 #include "layer/padding.cpp"
 #include "layer/parametric_relu.cpp"
+#include "layer/quantized_linear.cpp"
 #include "layer/relu6.cpp"
 #include "layer/repeat.cpp"
 #include "layer/softmax.cpp"
@@ -1261,3 +1261,61 @@ TEST_CASE("JacobianNegativeLogLikelihoodLayerTest", "[LossFunctionsTest]")
     REQUIRE(error <= 1e-5);
   }
 }
+
+/**
+ * The softmax cross-entropy loss must give the same loss and gradient as a
+ * LogSoftmax layer followed by the negative log likelihood loss, even for
+ * large scores.
+ */
+TEST_CASE("SoftmaxCrossEntropyLossTest", "[LossFunctionsTest]")
+{
+  arma::mat input(50, 20, arma::fill::randn);
+  input.col(3) += 1000.0;
+  input.col(4) -= 1000.0;
+  arma::mat target(1, 20);
+  for (size_t i = 0; i < target.n_elem; ++i)
+    target(i) = RandInt(0, 50);
+
+  for (const bool reduction : { true, false })
+  {
+    SoftmaxCrossEntropy module(reduction);
+    LogSoftMax logSoftmax;
+    NegativeLogLikelihood nll(reduction);
+
+    arma::mat logProbs, nllGradient, expectedGradient;
+    logSoftmax.Forward(input, logProbs);
+    const double expectedLoss = nll.Forward(logProbs, target);
+    nll.Backward(logProbs, target, nllGradient);
+    logSoftmax.Backward(input, logProbs, nllGradient, expectedGradient);
+
+    REQUIRE(module.Forward(input, target) ==
+        Approx(expectedLoss).epsilon(1e-8));
+
+    arma::mat gradient;
+    module.Backward(input, target, gradient);
+    REQUIRE(gradient.n_rows == input.n_rows);
+    REQUIRE(gradient.n_cols == input.n_cols);
+    CheckMatrices(gradient, expectedGradient, 1e-6);
+  }
+}
+
+/**
+ * Jacobian softmax cross-entropy loss test.
+ */
+TEST_CASE("JacobianSoftmaxCrossEntropyTest", "[LossFunctionsTest]")
+{
+  for (size_t i = 0; i < 5; ++i)
+  {
+    SoftmaxCrossEntropy module;
+    const size_t inputElements = RandInt(5, 100);
+    arma::mat input;
+    RandomInitialization init(0, 1);
+    init.Initialize(input, inputElements, 1);
+
+    arma::mat target(1, 1);
+    target(0) = RandInt(0, inputElements - 2);
+
+    double error = JacobianPerformanceTest(module, input, target);
+    REQUIRE(error <= 1e-5);
+  }
+}
@@ -18,6 +18,7 @@
 
 #include "../catch.hpp"
 #include "../serialization.hpp"
+#include "ann_test_tools.hpp"
 
 using namespace mlpack;
 using namespace ens;
@@ -1031,3 +1032,171 @@ TEST_CASE("LSTMEmbeddedReberGrammarTest", "[RecurrentNetworkTest]")
   model.Add<Sigmoid>();
   ReberGrammarTestNetwork(model, true);
 }
+
+/**
+ * When the chunks are as long as the sequences, chunked truncated BPTT must
+ * give the exact gradient; with shorter chunks, the objective must still be
+ * the objective of the whole sequences, since the state is carried over.
+ */
+TEST_CASE("RNNChunkedBPTTGradientTest", "[RecurrentNetworkTest]")
+{
+  struct GradientFunction
+  {
+    GradientFunction() : model(6)
+    {
+      predictors.randu(3, 4, 6);
+      responses.randu(2, 4, 6);
+
+      model.ChunkedBPTT() = true;
+      model.Add<LinearRecurrent>(4);
+      model.Add<Linear>(2);
+      model.Reset(3);
+      model.ResetData(predictors, responses);
+    }
+
+    double Gradient(arma::mat& gradient)
+    {
+      return model.EvaluateWithGradient(model.Parameters(), 0, gradient, 4);
+    }
+
+    arma::mat& Parameters() { return model.Parameters(); }
+
+    RNN<MeanSquaredError> model;
+    arma::cube predictors, responses;
+  } function;
+
+  REQUIRE(CheckGradient(function) <= 1e-4);
+
+  // Chunks of two steps.
+  function.model.BPTTSteps() = 2;
+  arma::mat gradient;
+  const double objective = function.Gradient(gradient);
+  REQUIRE(gradient.n_elem == function.Parameters().n_elem);
+  REQUIRE(gradient.is_finite());
+  REQUIRE(objective == Approx(function.model.Evaluate(
+      function.Parameters(), 0, 4)).epsilon(1e-10));
+}
+
+/**
+ * Streaming prediction step by step must give the same results as Predict().
+ */
+TEST_CASE("RNNPredictStepTest", "[RecurrentNetworkTest]")
+{
+  RNN<MeanSquaredError> model(5);
+  model.Add<LSTM>(4);
+  model.Add<LinearRecurrent>(3);
+  model.Add<Linear>(2);
+  model.Reset(3);
+
+  arma::cube predictors(3, 7, 20, arma::fill::randu);
+  arma::cube predictions;
+  model.Predict(predictors, predictions);
+
+  for (size_t trial = 0; trial < 2; ++trial)
+  {
+    model.ResetStream();
+    arma::mat output;
+    for (size_t t = 0; t < predictors.n_slices; ++t)
+    {
+      model.PredictStep(predictors.slice(t), output);
+      REQUIRE(arma::approx_equal(output, predictions.slice(t), "absdiff",
+          1e-10));
+    }
+    REQUIRE(model.StreamStep() == predictors.n_slices);
+  }
+
+  // The number of sequences cannot change during a stream.
+  arma::mat output;
+  REQUIRE_THROWS_AS(model.PredictStep(arma::mat(3, 6, arma::fill::randu),
+      output), std::invalid_argument);
+}
+
+/**
+ * Stepping sessions with RNN::Step() must give the same results as Predict(),
+ * whether the sessions are held in one state or in several.
+ */
+TEST_CASE("RNNStepTest", "[RecurrentNetworkTest]")
+{
+  RNN<MeanSquaredError> model(5);
+  model.Add<LinearRecurrent>(4);
+  model.Add<LSTM>(3);
+  model.Add<Linear>(2);
+
+  // The network must be initialized first.
+  RNNState<> state;
+  REQUIRE_THROWS_AS(model.InitState(state, 4), std::invalid_argument);
+
+  model.Reset(3);
+
+  arma::cube predictors(3, 4, 15, arma::fill::randu);
+  arma::cube predictions;
+  model.Predict(predictors, predictions);
+
+  // All four sessions in one state.
+  model.InitState(state, 4);
+  REQUIRE(state.NumSessions() == 4);
+  REQUIRE(state.LayerStates().size() == 2);
+
+  // Two sessions per state, stepped in turns.
+  RNNState<> first, second;
+  model.InitState(first, 2);
+  model.InitState(second, 2);
+
+  arma::mat output, firstOutput, secondOutput;
+  for (size_t t = 0; t < predictors.n_slices; ++t)
+  {
+    model.Step(predictors.slice(t), state, output);
+    REQUIRE(arma::approx_equal(output, predictions.slice(t), "absdiff",
+        1e-10));
+
+    model.Step(predictors.slice(t).cols(0, 1), first, firstOutput);
+    model.Step(predictors.slice(t).cols(2, 3), second, secondOutput);
+    REQUIRE(arma::approx_equal(firstOutput, predictions.slice(t).cols(0, 1),
+        "absdiff", 1e-10));
+    REQUIRE(arma::approx_equal(secondOutput, predictions.slice(t).cols(2, 3),
+        "absdiff", 1e-10));
+  }
+  REQUIRE(state.Steps() == predictors.n_slices);
+
+  // The number of columns must match the number of sessions.
+  REQUIRE_THROWS_AS(model.Step(predictors.slice(0).cols(0, 2), state, output),
+      std::invalid_argument);
+}
+
+/**
+ * Predicting through an inference context must give the same results as
+ * Predict(), and leave the network alone.
+ */
+TEST_CASE("RNNInferenceContextTest", "[RecurrentNetworkTest]")
+{
+  RNN<MeanSquaredError> model(5);
+  model.Add<LinearRecurrent>(4);
+  model.Add<LSTM>(3);
+  model.Add<Linear>(2);
+
+  // The network must be initialized first.
+  InferenceContext<> context;
+  REQUIRE_THROWS_AS(model.InitContext(context), std::invalid_argument);
+
+  model.Reset(3);
+
+  arma::cube predictors(3, 12, 15, arma::fill::randu);
+  arma::cube predictions;
+  model.Predict(predictors, predictions);
+
+  model.InitContext(context);
+  arma::cube contextPredictions;
+  const RNN<MeanSquaredError>& constModel = model;
+  constModel.Predict(context, predictors, contextPredictions, 5);
+
+  REQUIRE(arma::approx_equal(predictions, contextPredictions, "absdiff",
+      1e-10));
+
+  // A second context gives the same results, independently of the first.
+  InferenceContext<> otherContext;
+  model.InitContext(otherContext);
+  arma::cube otherPredictions;
+  constModel.Predict(otherContext, predictors.cols(0, 3), otherPredictions);
+  REQUIRE(arma::approx_equal(otherPredictions, predictions.cols(0, 3),
+      "absdiff", 1e-10));
+}
@@ -211,6 +211,70 @@ TEST_CASE("ContinuousDoublePoleCartTest", "[RLComponentsTest]")
   REQUIRE(1 == action.size);
 }
 
+/**
+ * Make sure that VectorEnv steps each copy like the environment itself, and
+ * resets copies that reach a terminal state.
+ */
+TEST_CASE("VectorEnvTest", "[RLComponentsTest]")
+{
+  const size_t numEnvs = 5;
+  VectorEnv<CartPole> envs(numEnvs, CartPole(3));
+  REQUIRE(envs.NumEnvs() == numEnvs);
+
+  const arma::mat& initial = envs.InitialSample();
+  REQUIRE(initial.n_rows == CartPole::State::dimension);
+  REQUIRE(initial.n_cols == numEnvs);
+
+  std::vector<CartPole::Action> actions(numEnvs);
+  for (size_t i = 0; i < numEnvs; ++i)
+  {
+    actions[i].action = (i % 2 == 0) ? CartPole::Action::actions::forward :
+        CartPole::Action::actions::backward;
+  }
+
+  // The copies only take 3 steps before they terminate.
+  arma::rowvec rewards;
+  arma::irowvec terminal;
+  for (size_t step = 0; step < 3; ++step)
+  {
+    const std::vector<CartPole::State> states = envs.States();
+    envs.Step(actions, rewards, terminal);
+
+    REQUIRE(rewards.n_elem == numEnvs);
+    REQUIRE(terminal.n_elem == numEnvs);
+    for (size_t i = 0; i < numEnvs; ++i)
+    {
+      // Compare with a separate copy of the environment.
+      CartPole env(3);
+      CartPole::State expectedNextState;
+      const double expectedReward = env.Sample(states[i], actions[i],
+          expectedNextState);
+
+      REQUIRE(rewards[i] == Approx(expectedReward));
+      CheckMatrices(envs.NextState(i).Encode(), expectedNextState.Encode());
+      CheckMatrices(envs.EncodedNextStates().col(i),
+          expectedNextState.Encode());
+      if (step < 2)
+      {
+        REQUIRE(terminal[i] == 0);
+        CheckMatrices(envs.EncodedStates().col(i), expectedNextState.Encode());
+      }
+    }
+  }
+
+  // At the last step every copy terminated and was reset.
+  for (size_t i = 0; i < numEnvs; ++i)
+  {
+    REQUIRE(terminal[i] == 1);
+    REQUIRE(envs.Environment(i).StepsPerformed() == 0);
+  }
+
+  // The number of actions must match.
+  actions.pop_back();
+  REQUIRE_THROWS_AS(envs.Step(actions, rewards, terminal),
+      std::invalid_argument);
+}
+
 /**
  * Construct a random replay instance and check if it works as
  * it should be.
@@ -262,6 +326,73 @@ TEST_CASE("RandomReplayTest", "[RLComponentsTest]")
   }
 }
 
+/**
+ * Fill a concurrent prioritized replay from several threads, one shard per
+ * thread, and make sure that every sample is one of the stored transitions.
+ */
+TEST_CASE("ConcurrentPrioritizedReplayTest", "[RLComponentsTest]")
+{
+  const size_t numShards = 4;
+  const size_t perShard = 50;
+  ConcurrentPrioritizedReplay<MountainCar> replay(16, numShards * perShard,
+      0.6, numShards);
+  REQUIRE(replay.NumShards() == numShards);
+
+  // The reward of each transition identifies its shard, and the position of
+  // the car identifies the transition within the shard.
+  #pragma omp parallel for num_threads(numShards)
+  for (size_t shard = 0; shard < numShards; ++shard)
+  {
+    MountainCar::Action action;
+    action.action = MountainCar::Action::actions::forward;
+    for (size_t i = 0; i < perShard; ++i)
+    {
+      MountainCar::State state, nextState;
+      state.Position() = (double) i;
+      nextState.Position() = (double) i + 1;
+      replay.Store(shard, state, action, (double) shard, nextState, false,
+          0.9);
+    }
+  }
+
+  REQUIRE(replay.Size() == numShards * perShard);
+
+  arma::mat sampledState;
+  std::vector<MountainCar::Action> sampledAction;
+  arma::rowvec sampledReward;
+  arma::mat sampledNextState;
+  arma::irowvec sampledTerminal;
+  for (size_t trial = 0; trial < 10; ++trial)
+  {
+    sampledAction.clear();
+    replay.Sample(sampledState, sampledAction, sampledReward, sampledNextState,
+        sampledTerminal);
+
+    REQUIRE(sampledState.n_cols == 16);
+    REQUIRE(sampledAction.size() == 16);
+    for (size_t i = 0; i < 16; ++i)
+    {
+      REQUIRE(sampledReward[i] == (double) replay.SampledShards()[i]);
+      REQUIRE(sampledState(1, i) == (double) replay.SampledIndices()[i]);
+      REQUIRE(sampledNextState(1, i) == Approx(sampledState(1, i) + 1));
+      REQUIRE(sampledTerminal[i] == 0);
+    }
+
+    // Give the first shard a much higher priority.
+    arma::colvec priorities(16);
+    for (size_t i = 0; i < 16; ++i)
+      priorities[i] = (replay.SampledShards()[i] == 0) ? 100.0 : 0.01;
+    replay.UpdatePriorities(replay.SampledShards(), replay.SampledIndices(),
+        priorities);
+  }
+
+  // After the updates, most samples should come from the first shard.
+  sampledAction.clear();
+  replay.Sample(sampledState, sampledAction, sampledReward, sampledNextState,
+      sampledTerminal);
+  REQUIRE(arma::accu(sampledReward == 0.0) >= 8);
+}
+
 /**
  * Construct a greedy policy instance and check if it works as
  * it should be.
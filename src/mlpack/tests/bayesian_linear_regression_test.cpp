@@ -313,3 +313,41 @@ TEMPLATE_TEST_CASE("BayesianLinearRegressionTrainVariantTest",
   REQUIRE(blr5.MaxIterations() == 110);
   REQUIRE(blr5.Tolerance() == 1e-3);
 }
+
+// Training on sufficient statistics accumulated in batches must give the same
+// model as training on the whole dataset.
+TEST_CASE("BayesianLinearRegressionStatisticsTest",
+          "[BayesianLinearRegressionTest]")
+{
+  arma::mat matX;
+  arma::rowvec y;
+  GenerateProblem(matX, y, 500, 8, 0.3);
+  matX += 5.0;
+  y += 2.0;
+
+  for (const bool centerData : { false, true })
+  {
+    for (const bool scaleData : { false, true })
+    {
+      LinearRegressionStatistics<> stats;
+      stats.Accumulate(matX.cols(0, 199), y.cols(0, 199));
+      stats.Accumulate(matX.cols(200, 499), y.cols(200, 499));
+
+      BayesianLinearRegression<> estimator(centerData, scaleData);
+      const double rmse = estimator.Train(matX, y);
+
+      BayesianLinearRegression<> streamingEstimator(centerData, scaleData);
+      const double streamingRMSE = streamingEstimator.Train(stats);
+
+      REQUIRE(streamingRMSE == Approx(rmse).epsilon(1e-5));
+      REQUIRE(streamingEstimator.Alpha() ==
+          Approx(estimator.Alpha()).epsilon(1e-5));
+      REQUIRE(streamingEstimator.Beta() ==
+          Approx(estimator.Beta()).epsilon(1e-5));
+      REQUIRE(streamingEstimator.ResponsesOffset() ==
+          Approx(estimator.ResponsesOffset()).margin(1e-8));
+      REQUIRE(arma::approx_equal(streamingEstimator.Omega(),
+          estimator.Omega(), "both", 1e-6, 1e-6));
+    }
+  }
+}
@@ -104,3 +104,47 @@ TEST_CASE("RandomizedBlockKrylovSVDNoisyLowRankTest", "[BlockKrylovSVDTest]")
   double error = arma::max(arma::abs(s1.subvec(0, rank) - s2.subvec(0, rank)));
   REQUIRE(error == Approx(0.0).margin(1e-4));
 }
+
+/**
+ * The randomized block krylov SVD of a dataset read in chunks should match the
+ * SVD of the data.
+ */
+TEST_CASE("RandomizedBlockKrylovSVDChunkedSourceTest", "[BlockKrylovSVDTest]")
+{
+  arma::mat data;
+  CreateNoisyLowRankMatrix(data, 50, 600, 5, 0.5);
+  REQUIRE(data::Save("bksvd_chunked_data.bin", data, false, false,
+      data::FileType::ArmaBinary) == true);
+
+  const size_t rank = 5;
+  arma::mat U1, U2, V1, V2;
+  arma::vec s1, s2;
+  arma::svd_econ(U1, s1, V1, data);
+
+  data::ChunkedSource<double> source("bksvd_chunked_data.bin", 100, false);
+  RandomizedBlockKrylovSVD rSVDB(10, 20);
+  rSVDB.Apply(source, U2, s2, V2, rank);
+
+  REQUIRE(U2.n_rows == 50);
+  REQUIRE(V2.n_rows == 600);
+  REQUIRE(U2.n_cols == s2.n_elem);
+  REQUIRE(V2.n_cols == s2.n_elem);
+
+  double error = arma::max(arma::abs(s1.subvec(0, rank) - s2.subvec(0, rank)));
+  REQUIRE(error == Approx(0.0).margin(1e-4));
+
+  // The leading singular vectors should reconstruct the leading part of the
+  // spectrum.
+  const arma::mat reconstruct = U2.cols(0, rank) *
+      arma::diagmat(s2.subvec(0, rank)) * V2.cols(0, rank).t();
+  const arma::mat expected = U1.cols(0, rank) *
+      arma::diagmat(s1.subvec(0, rank)) * V1.cols(0, rank).t();
+  error = arma::norm(reconstruct - expected, "frob") /
+      arma::norm(expected, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-3));
+
+  REQUIRE_THROWS_AS(rSVDB.Apply(source, U2, s2, V2, 0),
+      std::invalid_argument);
+
+  remove("bksvd_chunked_data.bin");
+}
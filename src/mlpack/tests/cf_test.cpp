@@ -501,7 +501,7 @@ void Serialization()
 TEMPLATE_TEST_CASE("CFGetRecommendationsAllUsersTest", "[CFTest]",
     RandomizedSVDPolicy, RegSVDPolicy, BatchSVDPolicy, NMFPolicy,
     SVDCompletePolicy, SVDIncompletePolicy, BiasSVDPolicy, SVDPlusPlusPolicy,
-    QUIC_SVDPolicy, BlockKrylovSVDPolicy)
+    QUIC_SVDPolicy, BlockKrylovSVDPolicy, ImplicitALSPolicy)
 {
   GetRecommendationsAllUsers<TestType>();
 }
@@ -513,7 +513,7 @@ TEMPLATE_TEST_CASE("CFGetRecommendationsAllUsersTest", "[CFTest]",
 TEMPLATE_TEST_CASE("CFGetRecommendationsQueriedUsersTest", "[CFTest]",
   RandomizedSVDPolicy, RegSVDPolicy, BatchSVDPolicy, NMFPolicy,
   SVDCompletePolicy, SVDIncompletePolicy, BiasSVDPolicy, SVDPlusPlusPolicy,
-  QUIC_SVDPolicy, BlockKrylovSVDPolicy)
+  QUIC_SVDPolicy, BlockKrylovSVDPolicy, ImplicitALSPolicy)
 {
   GetRecommendationsQueriedUser<TestType>();
 }
@@ -558,7 +558,7 @@ TEMPLATE_TEST_CASE("CFPredictTest", "[CFTest]",
 TEMPLATE_TEST_CASE("CFBatchPredictTest", "[CFTest]",
     RandomizedSVDPolicy, RegSVDPolicy, BatchSVDPolicy, NMFPolicy,
     SVDCompletePolicy, SVDIncompletePolicy, BiasSVDPolicy, SVDPlusPlusPolicy,
-    QUIC_SVDPolicy, BlockKrylovSVDPolicy)
+    QUIC_SVDPolicy, BlockKrylovSVDPolicy, ImplicitALSPolicy)
 {
   BatchPredict<TestType>();
 }
@@ -569,7 +569,8 @@ TEMPLATE_TEST_CASE("CFBatchPredictTest", "[CFTest]",
  */
 TEMPLATE_TEST_CASE("TrainTest_1", "[CFTest]",
     RandomizedSVDPolicy, BatchSVDPolicy, NMFPolicy, SVDCompletePolicy,
-    SVDIncompletePolicy, QUIC_SVDPolicy, BlockKrylovSVDPolicy)
+    SVDIncompletePolicy, QUIC_SVDPolicy, BlockKrylovSVDPolicy,
+    ImplicitALSPolicy)
 {
   TestType decomposition;
   Train(decomposition);
@@ -603,11 +604,176 @@ TEMPLATE_TEST_CASE("EmptyConstructorTrainTest", "[CFTest]",
  */
 TEMPLATE_TEST_CASE("SerializationTest", "[CFTest]",
     RandomizedSVDPolicy, BatchSVDPolicy, NMFPolicy, SVDCompletePolicy,
-    SVDIncompletePolicy, QUIC_SVDPolicy, BlockKrylovSVDPolicy)
+    SVDIncompletePolicy, QUIC_SVDPolicy, BlockKrylovSVDPolicy,
+    ImplicitALSPolicy)
 {
   Serialization<TestType>();
 }
 
+/**
+ * Make sure that GetDirectRecommendations() returns the best unrated items by
+ * predicted rating, with both the blocked search and FastMKS.
+ */
+TEST_CASE("CFDirectRecommendationsTest", "[CFTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFType<RegSVDPolicy> c(dataset, RegSVDPolicy(), 5, 5, 30);
+
+  const size_t numRecs = 10;
+  arma::Col<size_t> users = { 0, 3, 17, 42, 100, 199 };
+  arma::Mat<size_t> recommendations, fastMKSRecommendations;
+  c.GetDirectRecommendations(numRecs, recommendations, users);
+  c.GetDirectRecommendations(numRecs, fastMKSRecommendations, users, true);
+
+  REQUIRE(recommendations.n_rows == numRecs);
+  REQUIRE(recommendations.n_cols == users.n_elem);
+  REQUIRE(fastMKSRecommendations.n_rows == numRecs);
+  REQUIRE(fastMKSRecommendations.n_cols == users.n_elem);
+
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    // Sort the unrated items by rating.
+    arma::vec ratings;
+    c.Decomposition().GetRatingOfUser(users[i], ratings);
+    std::vector<std::pair<double, size_t>> candidates;
+    for (size_t j = 0; j < ratings.n_elem; ++j)
+      if (c.CleanedData()(j, users[i]) == 0.0)
+        candidates.push_back(std::make_pair(-ratings[j], j));
+    std::sort(candidates.begin(), candidates.end());
+
+    for (size_t j = 0; j < numRecs; ++j)
+    {
+      REQUIRE(recommendations(j, i) == candidates[j].second);
+      REQUIRE(fastMKSRecommendations(j, i) == candidates[j].second);
+    }
+  }
+}
+
+/**
+ * Make sure that ImplicitALSPolicy prefers the items that were interacted with
+ * by similar users.  Users 0-19 only interact with items 0-14, and users 20-39
+ * with items 15-29.
+ */
+TEST_CASE("ImplicitALSPreferenceTest", "[CFTest]")
+{
+  std::vector<double> entries;
+  for (size_t user = 0; user < 40; ++user)
+  {
+    const size_t firstItem = (user < 20) ? 0 : 15;
+    for (size_t item = firstItem; item < firstItem + 15; ++item)
+    {
+      // Make sure that every item is interacted with at least once.
+      if (Random() < 0.5 || item == firstItem + (user % 15))
+      {
+        entries.push_back(user);
+        entries.push_back(item);
+        entries.push_back(1.0 + RandInt(5));
+      }
+    }
+  }
+  arma::mat dataset(entries.data(), 3, entries.size() / 3);
+
+  CFType<ImplicitALSPolicy> c(dataset, ImplicitALSPolicy(), 5, 4, 20);
+
+  for (size_t user = 0; user < 40; ++user)
+  {
+    arma::vec ratings;
+    c.Decomposition().GetRatingOfUser(user, ratings);
+
+    const double groupRating = (user < 20) ? mean(ratings.subvec(0, 14)) :
+        mean(ratings.subvec(15, 29));
+    const double otherRating = (user < 20) ? mean(ratings.subvec(15, 29)) :
+        mean(ratings.subvec(0, 14));
+    REQUIRE(groupRating > otherRating + 0.2);
+  }
+}
+
+/**
+ * Make sure that AddUsers() and AddItems() solve the regularized least-squares
+ * problem of each new user or item: when an existing user (or item) is added
+ * again, the objective of its new factors can be no worse than that of its
+ * trained factors.
+ */
+TEST_CASE("CFFoldInTest", "[CFTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFType<RegSVDPolicy> c(dataset, RegSVDPolicy(), 5, 5, 30);
+  const double lambda = 0.1;
+
+  // The objective of the factors h of user j (or w of item j) for the ratings
+  // in column j of data.
+  auto objective = [lambda](const arma::sp_mat& data, const size_t j,
+      const arma::mat& fixed, const arma::vec& factors)
+  {
+    double sum = lambda * arma::dot(factors, factors);
+    for (auto it = data.begin_col(j); it != data.end_col(j); ++it)
+    {
+      const double e = (*it) - arma::dot(fixed.col(it.row()), factors);
+      sum += e * e;
+    }
+    return sum;
+  };
+
+  const size_t numItems = c.CleanedData().n_rows;
+  const size_t numUsers = c.CleanedData().n_cols;
+  const arma::sp_mat oldData = c.CleanedData();
+  const arma::mat oldW = c.Decomposition().W();
+  const arma::mat oldH = c.Decomposition().H();
+
+  const arma::uvec users = { 0, 5, 17 };
+  arma::sp_mat userRatings(numItems, users.n_elem);
+  for (size_t i = 0; i < users.n_elem; ++i)
+    userRatings.col(i) = oldData.col(users[i]);
+
+  REQUIRE(c.AddUsers(userRatings, lambda) == numUsers);
+  REQUIRE(c.CleanedData().n_cols == numUsers + users.n_elem);
+  REQUIRE(c.Decomposition().H().n_cols == numUsers + users.n_elem);
+
+  const arma::mat oldWt = oldW.t();
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    const arma::vec newFactors = c.Decomposition().H().col(numUsers + i);
+    REQUIRE(objective(userRatings, i, oldWt, newFactors) <=
+        objective(userRatings, i, oldWt, oldH.col(users[i])) + 1e-8);
+  }
+
+  // Now add copies of some items.
+  const arma::uvec items = { 1, 10 };
+  const arma::sp_mat dataT = c.CleanedData().t();
+  arma::sp_mat itemRatingsT(dataT.n_rows, items.n_elem);
+  for (size_t i = 0; i < items.n_elem; ++i)
+    itemRatingsT.col(i) = dataT.col(items[i]);
+  const arma::mat h = c.Decomposition().H();
+
+  REQUIRE(c.AddItems(itemRatingsT.t(), lambda) == numItems);
+  REQUIRE(c.CleanedData().n_rows == numItems + items.n_elem);
+  REQUIRE(c.Decomposition().W().n_rows == numItems + items.n_elem);
+
+  for (size_t i = 0; i < items.n_elem; ++i)
+  {
+    const arma::vec newFactors = c.Decomposition().W().row(numItems + i).t();
+    const arma::vec oldFactors = oldW.row(items[i]).t();
+    REQUIRE(objective(itemRatingsT, i, h, newFactors) <=
+        objective(itemRatingsT, i, h, oldFactors) + 1e-8);
+  }
+
+  // The new users can get recommendations.
+  arma::Mat<size_t> recommendations;
+  c.GetRecommendations(5, recommendations,
+      arma::Col<size_t>({ numUsers, numUsers + 2 }));
+  REQUIRE(recommendations.n_cols == 2);
+  REQUIRE(all(all(recommendations < numItems + items.n_elem)));
+
+  REQUIRE_THROWS_AS(c.AddUsers(arma::sp_mat(numItems, 1), lambda),
+      std::invalid_argument);
+}
+
 /**
  * Make sure that Predict() is returning reasonable results for NMF and
  * all types of Normalization except default.
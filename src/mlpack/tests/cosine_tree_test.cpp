@@ -432,3 +432,54 @@ TEST_CASE("MoveConstructorAndOperatorCosineTreeTest", "[CosineTreeTest]")
     REQUIRE(v1.at(i) == v3.at(i));
   }
 }
+
+/**
+ * Build a cosine tree on a dataset large enough for the node computations to
+ * be done in parallel, check the centroids of the nodes, and make sure that
+ * the basis does not depend on the number of threads.
+ */
+TEST_CASE("CosineTreeParallelBuildTest", "[CosineTreeTest]")
+{
+  // A dataset of rank 10, with enough columns for the centroids to be
+  // computed by blocks.
+  arma::mat data = arma::randu(200, 10) * arma::randu(10, 5000);
+
+  // The centroids of the root and of its children must be the means of their
+  // columns.
+  CosineTree<> root(data);
+  REQUIRE(arma::approx_equal(root.Centroid(), arma::mean(data, 1), "reldiff",
+      1e-10));
+  root.CosineNodeSplit();
+  REQUIRE(root.Left()->NumColumns() + root.Right()->NumColumns() == 5000);
+  for (CosineTree<>* child : { root.Left(), root.Right() })
+  {
+    const arma::uvec indices = arma::conv_to<arma::uvec>::from(
+        child->VectorIndices());
+    REQUIRE(arma::approx_equal(child->Centroid(),
+        arma::mean(data.cols(indices), 1), "reldiff", 1e-10));
+  }
+
+  RandomSeed(42);
+  CosineTree<> ctree(data, 0.1, 0.1);
+  arma::mat basis;
+  ctree.GetFinalBasis(basis);
+
+  // The basis must be orthonormal.
+  REQUIRE(basis.n_cols > 1);
+  REQUIRE(arma::approx_equal(basis.t() * basis,
+      arma::eye<arma::mat>(basis.n_cols, basis.n_cols), "absdiff", 1e-5));
+
+  #ifdef MLPACK_USE_OPENMP
+  // Now build the tree with only one thread; the basis must be the same.
+  const size_t prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  RandomSeed(42);
+  CosineTree<> ctree2(data, 0.1, 0.1);
+  omp_set_num_threads(prevNumThreads);
+
+  arma::mat basis2;
+  ctree2.GetFinalBasis(basis2);
+  REQUIRE(basis.n_cols == basis2.n_cols);
+  REQUIRE(arma::approx_equal(basis, basis2, "absdiff", 1e-12));
+  #endif
+}
@@ -198,6 +198,97 @@ TEST_CASE("MulticlassClassificationMetricsTest", "[CVTest]")
           == Approx(macroaveragedF1).epsilon(1e-7));
 }
 
+/**
+ * Make sure ConfusionCounts gives the same metrics as the batch metrics, when
+ * the predictions are added in several batches and merged.
+ */
+TEST_CASE("ConfusionCountsTest", "[CVTest]")
+{
+  arma::Row<size_t> labels("0 1  0 1  2 2 1 2  3 3 3 3");
+  arma::Row<size_t> predictedLabels("0 0  1 1  2 2 2 2  3 3 3 3");
+
+  ConfusionCounts counts, otherCounts;
+  counts.Add(labels.cols(0, 4), predictedLabels.cols(0, 4));
+  otherCounts.Add(labels.cols(5, 11), predictedLabels.cols(5, 11));
+  counts.Merge(otherCounts);
+
+  REQUIRE(counts.NumPoints() == 12);
+  REQUIRE(counts.NumClasses() == 4);
+
+  arma::Mat<size_t> expected;
+  data::ConfusionMatrix(predictedLabels, labels, expected, 4);
+  REQUIRE(arma::all(arma::vectorise(counts.Counts() == expected)));
+
+  REQUIRE(counts.Accuracy() == Approx(9.0 / 12).epsilon(1e-7));
+  REQUIRE(counts.Precision(Micro) == Approx(9.0 / 12).epsilon(1e-7));
+  REQUIRE(counts.Precision(Macro) ==
+      Approx((0.5 + 0.5 + 0.75 + 1.0) / 4).epsilon(1e-7));
+  REQUIRE(counts.Recall(Macro) ==
+      Approx((0.5 + 1.0 / 3 + 1.0 + 1.0) / 4).epsilon(1e-7));
+  REQUIRE(counts.F1(Macro) == Approx((2 * 0.5 * 0.5 / (0.5 + 0.5) +
+      2 * 0.5 * (1.0 / 3) / (0.5 + (1.0 / 3)) + 2 * 0.75 * 1.0 / (0.75 + 1.0) +
+      2 * 1.0 * 1.0 / (1.0 + 1.0)) / 4).epsilon(1e-7));
+
+  // Binary metrics for class 2: 3 true positives, 4 positive predictions, 3
+  // positive labels.
+  REQUIRE(counts.Precision(Binary, 2) == Approx(0.75).epsilon(1e-7));
+  REQUIRE(counts.Recall(Binary, 2) == Approx(1.0).epsilon(1e-7));
+  REQUIRE(counts.F1(Binary, 2) ==
+      Approx(2 * 0.75 / 1.75).epsilon(1e-7));
+
+  // A large batch, counted in parallel.
+  arma::Row<size_t> largeLabels = arma::randi<arma::Row<size_t>>(100000,
+      arma::distr_param(0, 9));
+  arma::Row<size_t> largePredictions = largeLabels;
+  largePredictions.cols(0, 24999).fill(3);
+
+  ConfusionCounts largeCounts;
+  largeCounts.Add(largeLabels, largePredictions);
+  REQUIRE(largeCounts.NumClasses() == 10);
+  REQUIRE(largeCounts.Accuracy() == Approx(double(75000 +
+      arma::accu(largeLabels.cols(0, 24999) == 3)) / 100000).epsilon(1e-10));
+}
+
+/**
+ * Make sure the ROC AUC computed from histograms is the same as ROCAUCScore,
+ * exactly if the bins are small enough to separate the scores.
+ */
+TEST_CASE("ROCAUCAccumulatorTest", "[CVTest]")
+{
+  arma::Row<size_t> labels("1 0 1 0 1  0 1 0 1 0");
+  arma::rowvec scores("0.8 0.3 0.5 0.4 0.9  0.2 0.7 0.6 0 0.1");
+
+  ROCAUCAccumulator<1> auc1, otherAuc1;
+  ROCAUCAccumulator<0> auc0;
+  auc1.Add(labels.cols(0, 3), scores.cols(0, 3));
+  otherAuc1.Add(labels.cols(4, 9), scores.cols(4, 9));
+  auc1.Merge(otherAuc1);
+  auc0.Add(labels, scores);
+
+  REQUIRE(auc1.Evaluate() == Approx(0.76).epsilon(1e-7));
+  REQUIRE(auc0.Evaluate() == Approx(0.24).epsilon(1e-7));
+
+  // With a single bin, every score is a tie.
+  ROCAUCAccumulator<1> tied(1);
+  tied.Add(labels, scores);
+  REQUIRE(tied.Evaluate() == Approx(0.5).epsilon(1e-7));
+
+  // Large random scores.
+  arma::Row<size_t> largeLabels = arma::randi<arma::Row<size_t>>(50000,
+      arma::distr_param(0, 1));
+  arma::rowvec largeScores = 0.5 * arma::randu<arma::rowvec>(50000) +
+      0.2 * arma::conv_to<arma::rowvec>::from(largeLabels);
+
+  ROCAUCAccumulator<1> largeAuc;
+  largeAuc.Add(largeLabels, largeScores);
+  REQUIRE(largeAuc.Evaluate() == Approx(ROCAUCScore<1>::Evaluate(largeLabels,
+      largeScores)).epsilon(1e-3));
+
+  REQUIRE_THROWS_AS(largeAuc.Merge(ROCAUCAccumulator<1>(100)),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(ROCAUCAccumulator<1>().Evaluate(), std::invalid_argument);
+}
+
 /**
  * Test the mean squared error.
  */
@@ -631,6 +722,35 @@ TEST_CASE("KFoldCVWithWeightedLRTest", "[CVTest]")
   REQUIRE((1.0 - mse) == Approx(1.0).epsilon(1e-7));
 }
 
+/**
+ * Training the folds concurrently must give the same result as training them
+ * one after another, for a deterministic algorithm.
+ */
+TEST_CASE("KFoldCVConcurrentFoldsTest", "[CVTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 103);
+  arma::rowvec responses = arma::rowvec("1 2 3") * data +
+      0.1 * arma::randn<arma::rowvec>(103);
+  arma::rowvec weights = arma::randu<arma::rowvec>(103);
+
+  KFoldCV<LinearRegression<>, MSE> cv(7, data, responses, false);
+  REQUIRE(cv.ConcurrentFolds() == 1);
+  const double mse = cv.Evaluate();
+  const arma::vec parameters = cv.Model().Parameters();
+
+  cv.ConcurrentFolds() = 4;
+  REQUIRE(cv.Evaluate() == Approx(mse).epsilon(1e-10));
+  REQUIRE(arma::approx_equal(cv.Model().Parameters(), parameters, "reldiff",
+      1e-10));
+
+  // Now with weights.
+  KFoldCV<LinearRegression<>, MSE> weightedCV(5, data, responses, weights,
+      false);
+  const double weightedMSE = weightedCV.Evaluate();
+  weightedCV.ConcurrentFolds() = 3;
+  REQUIRE(weightedCV.Evaluate() == Approx(weightedMSE).epsilon(1e-10));
+}
+
 /**
  * Test k-fold cross-validation with decision trees constructed in multiple
  * ways.
@@ -856,3 +976,42 @@ TEST_CASE("SilhouetteScoreTest", "[CVTest]")
   double silhouetteScore = SilhouetteScore::Overall(X, labels, metric);
   REQUIRE(silhouetteScore == Approx(0.1121684822489150).epsilon(1e-7));
 }
+
+/**
+ * Make sure the blocked silhouette score matches the score computed from the
+ * precomputed distances, and that the approximate scores are reasonable.
+ */
+TEST_CASE("SilhouetteScoreLargeTest", "[CVTest]")
+{
+  // Three well-separated clusters, with non-contiguous labels.
+  arma::mat X(3, 600, arma::fill::randu);
+  arma::Row<size_t> labels(600);
+  for (size_t i = 0; i < 600; ++i)
+  {
+    labels[i] = (i % 3) * 5;
+    X.col(i) += 10.0 * (i % 3);
+  }
+
+  EuclideanDistance metric;
+  const arma::mat distances = PairwiseDistances(X, metric);
+  const arma::rowvec expected = SilhouetteScore::SamplesScore(distances,
+      labels);
+  const arma::rowvec scores = SilhouetteScore::SamplesScore(X, labels,
+      metric);
+  REQUIRE(approx_equal(scores, expected, "absdiff", 1e-10));
+
+  const double overall = SilhouetteScore::Overall(X, labels, metric);
+  REQUIRE(overall == Approx(arma::mean(expected)).epsilon(1e-10));
+  REQUIRE(overall > 0.8);
+
+  // Sampling all points gives the exact score.
+  REQUIRE(SilhouetteScore::SampledOverall(X, labels, metric, 1000) ==
+      Approx(overall).epsilon(1e-10));
+  REQUIRE(SilhouetteScore::SampledOverall(X, labels, metric, 200) ==
+      Approx(overall).epsilon(0.05));
+  REQUIRE(SilhouetteScore::SimplifiedOverall(X, labels, metric) ==
+      Approx(overall).epsilon(0.1));
+
+  REQUIRE_THROWS_AS(SilhouetteScore::SampledOverall(X, labels, metric, 0),
+      std::invalid_argument);
+}
@@ -364,3 +364,110 @@ TEST_CASE("NoiseConnectionTest", "[DBSCANTest]")
 
   REQUIRE(numClusters == 2);
 }
+
+/**
+ * Make sure that batch clustering, which builds the clusters in parallel,
+ * gives exactly the same results as pointwise clustering, including for the
+ * non-core points that are within epsilon of several clusters.
+ */
+TEST_CASE("BatchPointwiseEquivalenceTest", "[DBSCANTest]")
+{
+  arma::mat points(2, 2000, arma::fill::randu);
+  points.cols(0, 999) *= 3.0;
+  points.cols(1000, 1999) += 3.2;
+
+  for (const size_t minPoints : { 2, 5, 15 })
+  {
+    DBSCAN<> pointwise(0.1, minPoints, false);
+    DBSCAN<> batch(0.1, minPoints, true);
+
+    arma::Row<size_t> pointwiseAssignments, batchAssignments;
+    const size_t pointwiseClusters = pointwise.Cluster(points,
+        pointwiseAssignments);
+    const size_t batchClusters = batch.Cluster(points, batchAssignments);
+
+    REQUIRE(pointwiseClusters > 0);
+    REQUIRE(batchClusters == pointwiseClusters);
+    for (size_t i = 0; i < points.n_cols; ++i)
+      REQUIRE(batchAssignments[i] == pointwiseAssignments[i]);
+  }
+}
+
+/**
+ * Make sure that IncrementalDBSCAN, with points inserted in batches of
+ * several sizes, finds the same core points and clusters of core points as
+ * DBSCAN on all the points, and assigns border points to a neighboring
+ * cluster.
+ */
+TEST_CASE("IncrementalDBSCANEquivalenceTest", "[DBSCANTest]")
+{
+  arma::mat points(2, 2000, arma::fill::randu);
+  points.cols(0, 999) *= 3.0;
+  points.cols(1000, 1999) += 3.2;
+
+  const double epsilon = 0.1;
+  const arma::mat sqDistances = arma::repmat(
+      arma::sum(arma::square(points), 0).t(), 1, points.n_cols) +
+      arma::repmat(arma::sum(arma::square(points), 0), points.n_cols, 1) -
+      2 * points.t() * points;
+
+  for (const size_t minPoints : { 2, 5, 15 })
+  {
+    IncrementalDBSCAN<> incremental(epsilon, minPoints);
+    size_t begin = 0, batchSize = 1;
+    while (begin < points.n_cols)
+    {
+      const size_t end = std::min(begin + batchSize, (size_t) points.n_cols);
+      incremental.Insert(points.cols(begin, end - 1));
+      REQUIRE(incremental.NumPoints() == end);
+      begin = end;
+      batchSize *= 3;
+    }
+
+    DBSCAN<> batch(epsilon, minPoints);
+    arma::Row<size_t> assignments, batchAssignments;
+    const size_t clusters = incremental.Assignments(assignments);
+    batch.Cluster(points, batchAssignments);
+    REQUIRE(clusters > 0);
+    REQUIRE(clusters == incremental.NumClusters());
+
+    // Clusters of core points must match one-to-one.
+    std::map<size_t, size_t> toBatch, fromBatch;
+    for (size_t i = 0; i < points.n_cols; ++i)
+    {
+      const arma::uvec neighbors = arma::find(sqDistances.col(i) <=
+          epsilon * epsilon);
+      const bool isCore = (neighbors.n_elem >= minPoints);
+      REQUIRE(incremental.IsCore(i) == isCore);
+      if (isCore)
+      {
+        REQUIRE(assignments[i] != SIZE_MAX);
+        REQUIRE(batchAssignments[i] != SIZE_MAX);
+        const size_t c = assignments[i], b = batchAssignments[i];
+        REQUIRE(toBatch.emplace(c, b).first->second == b);
+        REQUIRE(fromBatch.emplace(b, c).first->second == c);
+        continue;
+      }
+
+      // A non-core point is a border point of a neighboring cluster, or noise
+      // if it has no core neighbor.
+      bool found = false, hasCoreNeighbor = false;
+      for (size_t j = 0; j < neighbors.n_elem; ++j)
+      {
+        const size_t n = neighbors[j];
+        if (incremental.IsCore(n))
+        {
+          hasCoreNeighbor = true;
+          found |= (assignments[n] == assignments[i]);
+        }
+      }
+
+      if (hasCoreNeighbor)
+        REQUIRE(found);
+      else
+        REQUIRE(assignments[i] == SIZE_MAX);
+    }
+
+    REQUIRE(toBatch.size() == clusters);
+  }
+}
@@ -174,6 +174,41 @@ TEST_CASE("MADGainHandCalculation", "[DecisionTreeRegressorTest]")
           Approx(weightedGain).margin(1e-5));
 }
 
+/**
+ * Make sure that the incremental MAD gains of a split scan are the same as
+ * the gains computed directly on each child.
+ */
+TEST_CASE("MADGainBinaryScanTest", "[DecisionTreeRegressorTest]")
+{
+  arma::rowvec responses = arma::randn<arma::rowvec>(50);
+  // Add some ties.
+  responses.subvec(10, 19).fill(0.5);
+  arma::rowvec weights = arma::randu<arma::rowvec>(50);
+  const size_t minimum = 3;
+
+  MADGain f, weightedF;
+  f.BinaryScanInitialize<false>(responses, weights, minimum);
+  weightedF.BinaryScanInitialize<true>(responses, weights, minimum);
+  for (size_t index = minimum; index < responses.n_elem - minimum + 1;
+      ++index)
+  {
+    f.BinaryStep<false>(responses, weights, index - 1);
+    weightedF.BinaryStep<true>(responses, weights, index - 1);
+
+    const std::tuple<double, double> gains = f.BinaryGains();
+    REQUIRE(std::get<0>(gains) == Approx(MADGain::Evaluate<false>(responses,
+        weights, 0, index)).margin(1e-8));
+    REQUIRE(std::get<1>(gains) == Approx(MADGain::Evaluate<false>(responses,
+        weights, index, responses.n_elem)).margin(1e-8));
+
+    const std::tuple<double, double> weightedGains = weightedF.BinaryGains();
+    REQUIRE(std::get<0>(weightedGains) == Approx(MADGain::Evaluate<true>(
+        responses, weights, 0, index)).margin(1e-8));
+    REQUIRE(std::get<1>(weightedGains) == Approx(MADGain::Evaluate<true>(
+        responses, weights, index, responses.n_elem)).margin(1e-8));
+  }
+}
+
 /**
  * Check that AllCategoricalSplit will split when the split is obviously
  * better.
@@ -523,6 +558,51 @@ TEST_CASE("BestBinaryCategoricalSplitRegressionTwoPerfectTest",
   REQUIRE((all(class1Direction == 0) || all(class1Direction == 1)));
 }
 
+/**
+ * Check that the HistogramCategoricalSplit splits perfectly on a dimension with
+ * many more categories than groups, ordering the categories by their mean
+ * response.
+ */
+TEST_CASE("HistogramCategoricalSplitRegressionPerfectTest",
+    "[DecisionTreeRegressorTest]")
+{
+  const size_t N = 10000;
+  const size_t K = 2000;
+  const double EPSILON = 1e-7;
+
+  HistogramCategoricalSplit<MSEGain>::AuxiliarySplitInfo aux;
+  arma::vec splitInfo;
+  MSEGain gainFn;
+
+  arma::vec data = randi<arma::vec>(N, arma::distr_param(0, K - 1));
+  arma::rowvec weights = arma::ones<arma::rowvec>(N);
+  arma::rowvec response(N);
+  for (size_t i = 0; i < N; ++i)
+    response[i] = (((size_t) data[i]) % 7 == 0) ? 3.0 : 0.0;
+
+  const double bestGain = MSEGain::Evaluate<false>(response, weights);
+  const double gain = HistogramCategoricalSplit<MSEGain>::SplitIfBetter<false>(
+      bestGain, data, K, response, weights, 10, EPSILON, splitInfo, aux,
+      gainFn);
+  const double weightedGain =
+      HistogramCategoricalSplit<MSEGain>::SplitIfBetter<true>(bestGain, data,
+      K, response, weights, 10, EPSILON, splitInfo, aux, gainFn);
+
+  REQUIRE(gain > bestGain);
+  REQUIRE(gain == Approx(weightedGain).margin(EPSILON));
+  REQUIRE(gain == Approx(0.0).margin(EPSILON));
+
+  // Every category with the same response goes in the same direction.
+  const size_t direction0 = HistogramCategoricalSplit<MSEGain>::
+      CalculateDirection(0, splitInfo, aux);
+  for (size_t i = 0; i < N; ++i)
+  {
+    const size_t direction = HistogramCategoricalSplit<MSEGain>::
+        CalculateDirection(data[i], splitInfo, aux);
+    REQUIRE((direction == direction0) == (response[i] == 3.0));
+  }
+}
+
 /**
  * Check that no split is made when it doesn't get us anything.
  */
@@ -1242,6 +1322,48 @@ TEMPLATE_TEST_CASE("SimpleGeneralizationTest_",
   REQUIRE(success == true);
 }
 
+/**
+ * Test that the decision tree regressor generalizes reasonably when built with
+ * the HistogramNumericSplit.
+ */
+TEST_CASE("HistogramSplitGeneralizationTest_", "[DecisionTreeRegressorTest]")
+{
+  // Allow three trials.
+  bool success = false;
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    data::DatasetInfo info;
+    arma::mat trainData, testData;
+    arma::rowvec trainResponses, testResponses;
+    LoadBostonHousingDataset(trainData, testData, trainResponses, testResponses,
+        info);
+
+    arma::rowvec weights(trainResponses.n_cols, arma::fill::ones);
+
+    DecisionTreeRegressor<MSEGain, HistogramNumericSplit> d(trainData,
+        trainResponses);
+    DecisionTreeRegressor<MSEGain, HistogramNumericSplit> wd(trainData,
+        trainResponses, weights);
+
+    arma::rowvec predictions, weightedPredictions;
+    d.Predict(testData, predictions);
+    wd.Predict(testData, weightedPredictions);
+
+    REQUIRE(predictions.n_elem == testData.n_cols);
+    REQUIRE(weightedPredictions.n_elem == testData.n_cols);
+
+    const double rmse = RMSE(predictions, testResponses);
+    const double wdrmse = RMSE(weightedPredictions, testResponses);
+    if (rmse <= 6.2 && wdrmse <= 6.2)
+    {
+      success = true;
+      break;
+    }
+  }
+
+  REQUIRE(success == true);
+}
+
 /**
  * Test that we can build a decision tree using weighted data (where the
  * low-weighted data is random noise), and that the tree still builds correctly
@@ -1352,3 +1474,34 @@ TEST_CASE("WeightedDecisionTreeMADGainTest", "[DecisionTreeRegressorTest]")
 
   REQUIRE(success == true);
 }
+
+/**
+ * Make sure that a regression tree whose subtrees are built in parallel is the
+ * same as one built serially.
+ */
+TEST_CASE("DecisionTreeRegressorParallelSubtreesTest",
+          "[DecisionTreeRegressorTest]")
+{
+  const size_t numPoints = 20000;
+  arma::mat dataset(5, numPoints, arma::fill::randu);
+  arma::rowvec responses = 3.0 * dataset.row(0) +
+      arma::sin(6.0 * dataset.row(2)) + 0.1 * arma::randn<arma::rowvec>(
+      numPoints);
+
+  DecisionTreeRegressor<> d(dataset, responses, 10);
+  arma::rowvec predictions;
+  d.Predict(dataset, predictions);
+  REQUIRE(RMSE(predictions, responses) < 0.2);
+
+  #ifdef MLPACK_USE_OPENMP
+  // Now train with only one thread; the tree must be the same.
+  const size_t prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  DecisionTreeRegressor<> d2(dataset, responses, 10);
+  omp_set_num_threads(prevNumThreads);
+
+  arma::rowvec predictions2;
+  d2.Predict(dataset, predictions2);
+  REQUIRE(arma::approx_equal(predictions, predictions2, "absdiff", 1e-10));
+  #endif
+}
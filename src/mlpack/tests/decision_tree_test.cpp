@@ -468,6 +468,114 @@ TEST_CASE("RandomBinaryNumericSplitDiffSplitTest", "[DecisionTreeTest]")
   REQUIRE(classProbabilities[0] != classProbabilities1[0]);
 }
 
+/**
+ * Check that the HistogramNumericSplit will split on an obviously splittable
+ * dimension.
+ */
+TEST_CASE("HistogramNumericSplitSimpleSplitTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec splitInfo;
+  HistogramNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 3, 1e-7, splitInfo, aux);
+  const double weightedGain =
+      HistogramNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain, values,
+      labels, 2, weights, 3, 1e-7, splitInfo, aux);
+
+  // Make sure that a split was made.
+  REQUIRE(gain > bestGain);
+
+  // Make sure weight works and is not different than the unweighted one.
+  REQUIRE(gain == Approx(weightedGain).margin(1e-7));
+
+  // The split is perfect, so we should be able to accomplish a gain of 0.
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+
+  // The split point should be between 0.4 and 0.5.
+  REQUIRE(splitInfo.n_elem == 1);
+  REQUIRE(splitInfo[0] > 0.4);
+  REQUIRE(splitInfo[0] < 0.5);
+}
+
+/**
+ * Check that the HistogramNumericSplit finds the same split as the
+ * BestBinaryNumericSplit when every distinct value gets its own bin.
+ */
+TEST_CASE("HistogramNumericSplitMatchesBestTest", "[DecisionTreeTest]")
+{
+  // 100 distinct integer values, each appearing twice, so that there are
+  // fewer distinct values than bins.  The labels are noisy around 60.
+  arma::vec values(200);
+  arma::Row<size_t> labels(200);
+  for (size_t i = 0; i < 200; ++i)
+  {
+    values[i] = (double) (i % 100);
+    labels[i] = (i % 100 >= 60) ? 1 : 0;
+  }
+  labels[55] = 1;
+  labels[157] = 1;
+  labels[163] = 0;
+  arma::rowvec weights;
+
+  arma::vec splitInfo, histogramSplitInfo;
+  BestBinaryNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+  HistogramNumericSplit<GiniGain>::AuxiliarySplitInfo histogramAux;
+
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = BestBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 5, 1e-7, splitInfo, aux);
+  const double histogramGain =
+      HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain, values,
+      labels, 2, weights, 5, 1e-7, histogramSplitInfo, histogramAux);
+
+  REQUIRE(histogramGain > bestGain);
+  REQUIRE(histogramGain == Approx(gain).epsilon(1e-7));
+
+  // Both splits must direct every point the same way.
+  for (size_t i = 0; i < values.n_elem; ++i)
+  {
+    REQUIRE(HistogramNumericSplit<GiniGain>::CalculateDirection(values[i],
+        histogramSplitInfo, histogramAux) ==
+        BestBinaryNumericSplit<GiniGain>::CalculateDirection(values[i],
+        splitInfo, aux));
+  }
+}
+
+/**
+ * Check that the HistogramNumericSplit won't split if not enough points are
+ * given, or if all the values are the same.
+ */
+TEST_CASE("HistogramNumericSplitNoSplitTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::vec constValues(11, arma::fill::ones);
+  arma::rowvec weights;
+
+  arma::vec splitInfo;
+  HistogramNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 8, 1e-7, splitInfo, aux);
+  REQUIRE(gain == DBL_MAX);
+  REQUIRE(splitInfo.n_elem == 0);
+
+  const double constGain =
+      HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      constValues, labels, 2, weights, 3, 1e-7, splitInfo, aux);
+  REQUIRE(constGain == DBL_MAX);
+  REQUIRE(splitInfo.n_elem == 0);
+}
+
 /**
  * Check that the AllCategoricalSplit will split when the split is obviously
  * better.
@@ -928,6 +1036,87 @@ TEST_CASE("BestCategoricalBuildMultiTest", "[DecisionTreeTest]")
   REQUIRE(correctPct > 0.70);
 }
 
+/**
+ * Test that the HistogramCategoricalSplit finds the perfect split of a
+ * dimension with many more categories than groups.
+ */
+TEST_CASE("HistogramCategoricalSplitHighCardinalityTest", "[DecisionTreeTest]")
+{
+  const size_t numCategories = 5000;
+  arma::vec values = arma::randi<arma::vec>(20000,
+      arma::distr_param(0, numCategories - 2));
+  arma::Row<size_t> labels(values.n_elem);
+  for (size_t i = 0; i < values.n_elem; ++i)
+    labels[i] = (((size_t) values[i]) % 3 == 0) ? 1 : 0;
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec splitInfo;
+  HistogramCategoricalSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = HistogramCategoricalSplit<GiniGain>::SplitIfBetter<
+      false>(bestGain, values, numCategories, labels, 2, weights, 3, 1e-7,
+      splitInfo, aux);
+  const double weightedGain = HistogramCategoricalSplit<GiniGain>::
+      SplitIfBetter<true>(bestGain, values, numCategories, labels, 2, weights,
+      3, 1e-7, splitInfo, aux);
+
+  // The split is perfect, so we should be able to accomplish a gain of 0.
+  REQUIRE(gain > bestGain);
+  REQUIRE(gain == Approx(weightedGain).margin(1e-7));
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+
+  REQUIRE(HistogramCategoricalSplit<GiniGain>::NumChildren(splitInfo, aux) ==
+      2);
+  REQUIRE(splitInfo.n_elem == numCategories);
+  const size_t labelOneDirection =
+      HistogramCategoricalSplit<GiniGain>::CalculateDirection(0, splitInfo,
+      aux);
+  for (size_t i = 0; i < values.n_elem; ++i)
+  {
+    const size_t direction = HistogramCategoricalSplit<GiniGain>::
+        CalculateDirection(values[i], splitInfo, aux);
+    REQUIRE((direction == labelOneDirection) == (labels[i] == 1));
+  }
+
+  // The category that is not in the data goes to the larger child (of the
+  // points with label 0).
+  REQUIRE(HistogramCategoricalSplit<GiniGain>::CalculateDirection(
+      numCategories - 1, splitInfo, aux) != labelOneDirection);
+}
+
+/**
+ * Test that we can build a decision tree on a simple categorical dataset
+ * using the HistogramCategoricalSplit in a multi-class setting.
+ */
+TEST_CASE("HistogramCategoricalBuildMultiTest", "[DecisionTreeTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  // Split into a training set and a test set.
+  arma::mat trainingData = d.cols(0, 1999);
+  arma::mat testData = d.cols(2000, 3999);
+  arma::Row<size_t> trainingLabels = l.subvec(0, 1999);
+  arma::Row<size_t> testLabels = l.subvec(2000, 3999);
+
+  // Build the tree.
+  DecisionTree<GiniGain, BestBinaryNumericSplit, HistogramCategoricalSplit>
+      tree(trainingData, di, trainingLabels, 5, 10);
+
+  // Now evaluate the accuracy of the tree.
+  arma::Row<size_t> predictions;
+  tree.Classify(testData, predictions);
+
+  const double correctPct = double(arma::accu(predictions == testLabels)) /
+      double(testData.n_cols);
+  REQUIRE(predictions.n_cols == testData.n_cols);
+  REQUIRE(correctPct > 0.70);
+}
+
 /**
  * Test that we can build a decision tree with weights on a simple categorical
  * dataset using the BestBinaryCategoricalSplit.
@@ -1252,6 +1441,60 @@ TEST_CASE("SimpleGeneralizationTest", "[DecisionTreeTest]")
   REQUIRE(wdcorrect > 0.75);
 }
 
+/**
+ * Test that the decision tree generalizes reasonably when built with the
+ * HistogramNumericSplit.
+ */
+TEST_CASE("HistogramSplitGeneralizationTest", "[DecisionTreeTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  // Initialize an all-ones weight matrix.
+  arma::rowvec weights(labels.n_cols, arma::fill::ones);
+
+  // Build decision tree.
+  DecisionTree<GiniGain, HistogramNumericSplit> d(inputData, labels, 3, 10);
+  DecisionTree<GiniGain, HistogramNumericSplit> wd(inputData, labels, 3,
+      weights, 10);
+
+  // Load testing data.
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    FAIL("Cannot load test dataset vc2_test.csv!");
+
+  arma::Mat<size_t> trueTestLabels;
+  if (!data::Load("vc2_test_labels.txt", trueTestLabels))
+    FAIL("Cannot load labels for vc2_test_labels.txt");
+
+  arma::Row<size_t> predictions, weightedPredictions;
+  d.Classify(testData, predictions);
+  wd.Classify(testData, weightedPredictions);
+
+  REQUIRE(predictions.n_elem == testData.n_cols);
+  REQUIRE(weightedPredictions.n_elem == testData.n_cols);
+
+  // Figure out the accuracy.
+  double correct = 0.0, wdcorrect = 0.0;
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+  {
+    if (predictions[i] == trueTestLabels[i])
+      ++correct;
+    if (weightedPredictions[i] == trueTestLabels[i])
+      ++wdcorrect;
+  }
+  correct /= predictions.n_elem;
+  wdcorrect /= predictions.n_elem;
+
+  REQUIRE(correct > 0.75);
+  REQUIRE(wdcorrect > 0.75);
+}
+
 /**
  * Test that the decision tree generalizes reasonably when built on float data.
  */
@@ -1852,3 +2095,217 @@ TEST_CASE("DifferentMaximumDepthTest", "[DecisionTreeTest]")
   REQUIRE(d2.Child(0).NumChildren() == 2);
   REQUIRE(d2.Child(1).NumChildren() == 2);
 }
+
+/**
+ * Make sure that the parallel search for the best split of large nodes gives
+ * the same tree as the serial search.
+ */
+TEST_CASE("DecisionTreeParallelSplitTest", "[DecisionTreeTest]")
+{
+  // Make a dataset large enough that the split of the root (and of its
+  // children) is searched in parallel.
+  const size_t numPoints = 4 * DecisionTree<>::ParallelSplitMinPoints;
+  arma::mat dataset(10, numPoints, arma::fill::randu);
+  arma::Row<size_t> labels(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    labels[i] = (dataset(3, i) > 0.4) ? ((dataset(7, i) > 0.6) ? 2 : 1) :
+        ((arma::randu() > 0.9) ? 1 : 0);
+  }
+
+  DecisionTree<> d(dataset, labels, 3, 10, 1e-7, 6);
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  d.Classify(dataset, predictions, probabilities);
+
+  // The root must split on one of the informative dimensions.
+  REQUIRE(d.NumChildren() == 2);
+  const size_t splitDimension = d.SplitDimension();
+  REQUIRE((splitDimension == 3 || splitDimension == 7));
+
+  #ifdef MLPACK_USE_OPENMP
+  // Now train with only one thread; the tree must be the same.
+  const size_t prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  DecisionTree<> d2(dataset, labels, 3, 10, 1e-7, 6);
+  omp_set_num_threads(prevNumThreads);
+
+  arma::Row<size_t> predictions2;
+  arma::mat probabilities2;
+  d2.Classify(dataset, predictions2, probabilities2);
+
+  REQUIRE(d2.NumChildren() == d.NumChildren());
+  REQUIRE(d2.SplitDimension() == d.SplitDimension());
+  REQUIRE(arma::all(predictions == predictions2));
+  REQUIRE(arma::approx_equal(probabilities, probabilities2, "absdiff", 1e-10));
+  #endif
+}
+
+/**
+ * Make sure that training on a subset of the points given by their indices
+ * gives the same tree as training on a copy of these points.
+ */
+TEST_CASE("DecisionTreeTrainIndicesTest", "[DecisionTreeTest]")
+{
+  arma::mat dataset(6, 1000, arma::fill::randu);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 0; i < 1000; ++i)
+    labels[i] = (dataset(1, i) > 0.5) ? ((dataset(4, i) > 0.3) ? 2 : 1) : 0;
+  arma::rowvec weights(1000, arma::fill::randu);
+
+  // A bootstrap-like sample, with repeated points.
+  arma::uvec indices = arma::randi<arma::uvec>(700,
+      arma::distr_param(0, 999));
+
+  DecisionTree<> d(dataset.cols(indices), labels.cols(indices), 3, 5);
+  DecisionTree<> dIndices;
+  dIndices.TrainIndices(dataset, indices, labels, 3, 5);
+
+  arma::Row<size_t> predictions, predictionsIndices;
+  arma::mat probabilities, probabilitiesIndices;
+  d.Classify(dataset, predictions, probabilities);
+  dIndices.Classify(dataset, predictionsIndices, probabilitiesIndices);
+  REQUIRE(arma::all(predictions == predictionsIndices));
+  CheckMatrices(probabilities, probabilitiesIndices);
+
+  // The same with weights.
+  DecisionTree<> dw(dataset.cols(indices), labels.cols(indices), 3,
+      weights.cols(indices), 5);
+  DecisionTree<> dwIndices;
+  dwIndices.TrainIndices(dataset, indices, labels, 3, weights, 5);
+  dw.Classify(dataset, predictions, probabilities);
+  dwIndices.Classify(dataset, predictionsIndices, probabilitiesIndices);
+  REQUIRE(arma::all(predictions == predictionsIndices));
+  CheckMatrices(probabilities, probabilitiesIndices);
+
+  // When only some dimensions are allowed, the root must split on one of them.
+  const arma::uvec dimensions = { 0, 4, 5 };
+  DecisionTree<> dDims;
+  dDims.TrainIndices(dataset, indices, labels, 3, 5, 1e-7, 0,
+      AllDimensionSelect(), dimensions);
+  REQUIRE(dDims.NumChildren() == 2);
+  REQUIRE(dDims.SplitDimension() == 4);
+
+  // Invalid indices or dimensions.
+  DecisionTree<> dInvalid;
+  const arma::uvec badIndices = { 0, 1000 };
+  const arma::uvec badDimensions = { 6 };
+  REQUIRE_THROWS_AS(dInvalid.TrainIndices(dataset, badIndices, labels, 3),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(dInvalid.TrainIndices(dataset, arma::uvec(), labels, 3),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(dInvalid.TrainIndices(dataset, indices, labels, 3, 5,
+      1e-7, 0, AllDimensionSelect(), badDimensions), std::invalid_argument);
+}
+
+/**
+ * Make sure that presorting each dimension once gives the same tree as sorting
+ * the values at every node.
+ */
+TEST_CASE("DecisionTreePresortTest", "[DecisionTreeTest]")
+{
+  arma::mat dataset(5, 3000, arma::fill::randu);
+  // Add some ties.
+  dataset.row(2) = arma::floor(10 * dataset.row(2));
+  arma::Row<size_t> labels(3000);
+  for (size_t i = 0; i < 3000; ++i)
+  {
+    labels[i] = (dataset(0, i) > 0.4) ? ((dataset(2, i) > 3) ? 2 : 1) :
+        ((arma::randu() > 0.8) ? 1 : 0);
+  }
+  arma::uvec indices = arma::randi<arma::uvec>(3000,
+      arma::distr_param(0, 2999));
+
+  DecisionTree<> d, dPresort;
+  const double gain = d.TrainIndices(dataset, indices, labels, 3, 5);
+  const double gainPresort = dPresort.TrainIndices(dataset, indices, labels,
+      3, 5, 1e-7, 0, AllDimensionSelect(), arma::uvec(), true);
+  REQUIRE(gain == Approx(gainPresort).epsilon(1e-10));
+  REQUIRE(d.NumChildren() == dPresort.NumChildren());
+  REQUIRE(d.SplitDimension() == dPresort.SplitDimension());
+
+  arma::Row<size_t> predictions, predictionsPresort;
+  arma::mat probabilities, probabilitiesPresort;
+  d.Classify(dataset, predictions, probabilities);
+  dPresort.Classify(dataset, predictionsPresort, probabilitiesPresort);
+  REQUIRE(arma::all(predictions == predictionsPresort));
+  CheckMatrices(probabilities, probabilitiesPresort);
+
+  // With a subset of the dimensions and a maximum depth.
+  const arma::uvec dimensions = { 1, 2, 4 };
+  d.TrainIndices(dataset, indices, labels, 3, 5, 1e-7, 4,
+      AllDimensionSelect(), dimensions);
+  dPresort.TrainIndices(dataset, indices, labels, 3, 5, 1e-7, 4,
+      AllDimensionSelect(), dimensions, true);
+  d.Classify(dataset, predictions, probabilities);
+  dPresort.Classify(dataset, predictionsPresort, probabilitiesPresort);
+  REQUIRE(arma::all(predictions == predictionsPresort));
+  CheckMatrices(probabilities, probabilitiesPresort);
+
+  // Categorical dimensions can't be presorted, so the flag is ignored.
+  data::DatasetInfo info(5);
+  info.Type(3) = data::Datatype::categorical;
+  info.MapString<double>(std::string("a"), 3);
+  dataset.row(3).zeros();
+  dPresort.TrainIndices(dataset, info, indices, labels, 3, 5, 1e-7, 0,
+      AllDimensionSelect(), arma::uvec(), true);
+  dPresort.Classify(dataset, predictionsPresort);
+  REQUIRE(predictionsPresort.n_elem == 3000);
+}
+
+/**
+ * Make sure that a tree whose subtrees are built in parallel is the same as one
+ * built serially, with and without categorical dimensions.
+ */
+TEST_CASE("DecisionTreeParallelSubtreesTest", "[DecisionTreeTest]")
+{
+  REQUIRE(DecisionTree<>::ParallelSubtrees);
+  REQUIRE(!DecisionTree<GiniGain, BestBinaryNumericSplit, AllCategoricalSplit,
+      RandomDimensionSelect>::ParallelSubtrees);
+
+  const size_t numPoints = 20000;
+  arma::mat dataset(6, numPoints, arma::fill::randu);
+  dataset.row(5) = arma::floor(4 * dataset.row(5));
+  arma::Row<size_t> labels(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    labels[i] = (dataset(1, i) > 0.5) ? ((dataset(5, i) >= 2) ? 2 : 1) :
+        ((dataset(3, i) > 0.7) ? 1 : 0);
+    if (arma::randu() > 0.95)
+      labels[i] = RandInt(3);
+  }
+
+  data::DatasetInfo info(6);
+  info.Type(5) = data::Datatype::categorical;
+  for (size_t c = 0; c < 4; ++c)
+    info.MapString<double>(std::to_string(c), 5);
+
+  DecisionTree<> d(dataset, labels, 3, 5);
+  DecisionTree<> dInfo(dataset, info, labels, 3, 5);
+
+  arma::Row<size_t> predictions, predictionsInfo;
+  arma::mat probabilities, probabilitiesInfo;
+  d.Classify(dataset, predictions, probabilities);
+  dInfo.Classify(dataset, predictionsInfo, probabilitiesInfo);
+  REQUIRE(arma::accu(predictions == labels) > 0.9 * numPoints);
+  REQUIRE(arma::accu(predictionsInfo == labels) > 0.9 * numPoints);
+
+  #ifdef MLPACK_USE_OPENMP
+  // Now train with only one thread; the trees must be the same.
+  const size_t prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  DecisionTree<> d2(dataset, labels, 3, 5);
+  DecisionTree<> dInfo2(dataset, info, labels, 3, 5);
+  omp_set_num_threads(prevNumThreads);
+
+  arma::Row<size_t> predictions2, predictionsInfo2;
+  arma::mat probabilities2, probabilitiesInfo2;
+  d2.Classify(dataset, predictions2, probabilities2);
+  dInfo2.Classify(dataset, predictionsInfo2, probabilitiesInfo2);
+  REQUIRE(arma::all(predictions == predictions2));
+  REQUIRE(arma::all(predictionsInfo == predictionsInfo2));
+  CheckMatrices(probabilities, probabilities2);
+  CheckMatrices(probabilitiesInfo, probabilitiesInfo2);
+  #endif
+}
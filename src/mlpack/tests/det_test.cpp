@@ -814,3 +814,119 @@ TEST_CASE("MoveOperatorTest", "[DETTest]")
   REQUIRE(testDTree2.Right()->SplitDim() == 1);
   REQUIRE(testDTree2.Right()->SplitValue() == Approx(0.5).epsilon(1e-7));
 }
+
+// Make sure that growing a tree on dense data, whose dimensions are presorted,
+// gives the same tree as growing it on sparse data, whose nodes sort their
+// points.
+TEST_CASE("PresortedGrowTest", "[DETTest]")
+{
+  arma::mat denseData(3, 500, arma::fill::randu);
+  denseData += 0.1; // Make sure that there are no zeros.
+  arma::sp_mat sparseData(denseData);
+
+  arma::Col<size_t> denseOldFromNew =
+      arma::linspace<arma::Col<size_t>>(0, 499, 500);
+  arma::Col<size_t> sparseOldFromNew(denseOldFromNew);
+
+  DTree<arma::mat> denseTree(denseData);
+  DTree<arma::sp_mat> sparseTree(sparseData);
+  const double denseAlpha = denseTree.Grow(denseData, denseOldFromNew, false,
+      10, 5);
+  const double sparseAlpha = sparseTree.Grow(sparseData, sparseOldFromNew,
+      false, 10, 5);
+
+  REQUIRE(denseAlpha == Approx(sparseAlpha).epsilon(1e-10));
+  REQUIRE(denseTree.SubtreeLeaves() == sparseTree.SubtreeLeaves());
+  REQUIRE(denseTree.SplitDim() == sparseTree.SplitDim());
+  REQUIRE(denseTree.SplitValue() == Approx(sparseTree.SplitValue()));
+  REQUIRE(arma::all(denseOldFromNew == sparseOldFromNew));
+
+  for (size_t i = 0; i < denseData.n_cols; ++i)
+  {
+    const arma::vec point = denseData.col(i);
+    REQUIRE(denseTree.ComputeValue(point) ==
+        Approx(sparseTree.ComputeValue(arma::sp_vec(point))).epsilon(1e-10));
+  }
+}
+
+// Make sure that histogram split finding gives a valid tree.
+TEST_CASE("HistogramGrowTest", "[DETTest]")
+{
+  arma::mat data = arma::randn<arma::mat>(2, 3000);
+  const arma::mat originalData(data);
+
+  arma::Col<size_t> oldFromNew = arma::linspace<arma::Col<size_t>>(0, 2999,
+      3000);
+
+  DTree<arma::mat> tree(data);
+  tree.Grow(data, oldFromNew, false, 10, 5, 32);
+
+  REQUIRE(tree.SubtreeLeaves() > 1);
+
+  // Every leaf must hold between 5 and 10 points, unless it couldn't be split.
+  std::stack<const DTree<arma::mat>*> nodes;
+  nodes.push(&tree);
+  size_t leafPoints = 0;
+  while (!nodes.empty())
+  {
+    const DTree<arma::mat>* node = nodes.top();
+    nodes.pop();
+    if (node->Left() == NULL)
+    {
+      REQUIRE(node->End() - node->Start() >= 5);
+      leafPoints += node->End() - node->Start();
+    }
+    else
+    {
+      REQUIRE(node->Left()->End() == node->Right()->Start());
+      nodes.push(node->Left());
+      nodes.push(node->Right());
+    }
+  }
+  REQUIRE(leafPoints == 3000);
+
+  // The points must have been reordered consistently, and every point must lie
+  // in a leaf with a positive density.
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    REQUIRE(arma::approx_equal(data.col(i), originalData.col(oldFromNew[i]),
+        "absdiff", 1e-12));
+    REQUIRE(std::isfinite(tree.ComputeValue(data.col(i))));
+  }
+}
+
+// Make sure that Trainer() gives the same tree when the folds are processed in
+// parallel and serially.
+TEST_CASE("ParallelTrainerTest", "[DETTest]")
+{
+  arma::mat data = arma::randn<arma::mat>(2, 1000);
+
+  DTree<arma::mat, int>* tree = Trainer<arma::mat, int>(data, 5, false, 10, 5,
+      false);
+  REQUIRE(tree->SubtreeLeaves() >= 1);
+
+  #ifdef MLPACK_USE_OPENMP
+  const size_t prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  DTree<arma::mat, int>* serialTree = Trainer<arma::mat, int>(data, 5, false,
+      10, 5, false);
+  omp_set_num_threads(prevNumThreads);
+
+  REQUIRE(tree->SubtreeLeaves() == serialTree->SubtreeLeaves());
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    REQUIRE(tree->ComputeValue(data.col(i)) ==
+        Approx(serialTree->ComputeValue(data.col(i))).epsilon(1e-10));
+  }
+
+  delete serialTree;
+  #endif
+
+  // Histogram split finding must also work with cross-validation.
+  DTree<arma::mat, int>* histogramTree = Trainer<arma::mat, int>(data, 5,
+      false, 10, 5, false, IO::GetTimers(), 16);
+  REQUIRE(histogramTree->SubtreeLeaves() >= 1);
+
+  delete histogramTree;
+  delete tree;
+}
@@ -210,6 +210,67 @@ TEMPLATE_TEST_CASE("MDFullCovarianceTest", "[DistanceTest]", float, double)
   REQUIRE(md.Evaluate(b, a) == Approx(15.7).epsilon(1e-7));
 }
 
+/**
+ * The Euclidean distance between whitened points must be the Mahalanobis
+ * distance between the original points, for diagonal, positive definite and
+ * positive semidefinite Q matrices.
+ */
+TEMPLATE_TEST_CASE("MDWhitenTest", "[DistanceTest]", float, double)
+{
+  using eT = TestType;
+
+  arma::Mat<eT> data(6, 20, arma::fill::randu);
+  arma::Mat<eT> w(6, 6, arma::fill::randu);
+  arma::Mat<eT> lowRankW(3, 6, arma::fill::randu);
+
+  std::vector<arma::Mat<eT>> qs;
+  qs.push_back(arma::diagmat(arma::randu<arma::Col<eT>>(6)));
+  qs.push_back(w.t() * w + 0.1 * arma::eye<arma::Mat<eT>>(6, 6));
+  qs.push_back(lowRankW.t() * lowRankW);
+
+  for (size_t t = 0; t < qs.size(); ++t)
+  {
+    MahalanobisDistance<true, arma::Mat<eT>> md(qs[t]);
+    arma::Mat<eT> whitened;
+    md.Whiten(data, whitened);
+
+    REQUIRE(whitened.n_rows == data.n_rows);
+    REQUIRE(whitened.n_cols == data.n_cols);
+    for (size_t i = 1; i < data.n_cols; ++i)
+    {
+      REQUIRE(EuclideanDistance::Evaluate(whitened.col(0), whitened.col(i)) ==
+          Approx(md.Evaluate(data.col(0), data.col(i))).margin(1e-3));
+    }
+  }
+
+  // A Q matrix of the wrong size cannot be used.
+  MahalanobisDistance<true, arma::Mat<eT>> md(4);
+  arma::Mat<eT> whitened;
+  REQUIRE_THROWS_AS(md.Whiten(data, whitened), std::runtime_error);
+}
+
+/**
+ * The diagonal fast path must give the same results as the general case.
+ */
+TEMPLATE_TEST_CASE("MDDiagonalFastPathTest", "[DistanceTest]", float, double)
+{
+  using eT = TestType;
+
+  arma::Mat<eT> q = arma::diagmat(arma::randu<arma::Col<eT>>(10));
+  MahalanobisDistance<false, arma::Mat<eT>> diagonal(q);
+  // Modifying Q through Q() disables the fast path.
+  MahalanobisDistance<false, arma::Mat<eT>> general;
+  general.Q() = q;
+
+  for (size_t i = 0; i < 10; ++i)
+  {
+    arma::Col<eT> a(10, arma::fill::randu);
+    arma::Col<eT> b(10, arma::fill::randu);
+    REQUIRE(diagonal.Evaluate(a, b) ==
+        Approx(general.Evaluate(a, b)).epsilon(1e-5));
+  }
+}
+
 /**
  * Simple test for L-1 metric.
  */
@@ -288,6 +349,89 @@ TEST_CASE("LINFMetricTest", "[DistanceTest]")
       Approx(lMetric.Evaluate(a2, b2)).epsilon(1e-7));
 }
 
+/**
+ * Make sure that the loops used for dense vectors give the same results as the
+ * Armadillo expressions, for vectors, matrix columns and rows, and that the
+ * batch evaluation gives the same results as evaluating each pair.
+ */
+TEMPLATE_TEST_CASE("DenseLMetricTest", "[DistanceTest]", float, double)
+{
+  using eT = TestType;
+  using MatType = arma::Mat<eT>;
+  using VecType = arma::Col<eT>;
+  using RowType = arma::Row<eT>;
+
+  const double tol = std::is_same_v<eT, float> ? 1e-4 : 1e-10;
+
+  const size_t dims[] = { 1, 3, 8, 17, 64 };
+  for (const size_t d : dims)
+  {
+    MatType data(d, 10, arma::fill::randn);
+    const VecType a = data.col(0);
+    const VecType b = data.col(1);
+
+    REQUIRE(ManhattanDistance::Evaluate(a, b) ==
+        Approx(accu(arma::abs(a - b))).epsilon(tol));
+    REQUIRE(SquaredEuclideanDistance::Evaluate(a, b) ==
+        Approx(accu(arma::square(a - b))).epsilon(tol));
+    REQUIRE(EuclideanDistance::Evaluate(a, b) ==
+        Approx(arma::norm(a - b, 2)).epsilon(tol));
+    REQUIRE(ChebyshevDistance::Evaluate(a, b) ==
+        Approx(arma::max(arma::abs(a - b))).epsilon(tol));
+    REQUIRE(LinearKernel::Evaluate(a, b) ==
+        Approx(arma::dot(a, b)).epsilon(tol).margin(tol));
+
+    // Matrix columns and row vectors give the same results.
+    REQUIRE(EuclideanDistance::Evaluate(data.col(0), data.col(1)) ==
+        Approx(EuclideanDistance::Evaluate(a, b)).epsilon(tol));
+    REQUIRE(ManhattanDistance::Evaluate(a, data.col(1)) ==
+        Approx(ManhattanDistance::Evaluate(a, b)).epsilon(tol));
+    const RowType aRow = a.t();
+    const RowType bRow = b.t();
+    REQUIRE(ChebyshevDistance::Evaluate(aRow, bRow) ==
+        Approx(ChebyshevDistance::Evaluate(a, b)).epsilon(tol));
+
+    // A non-contiguous view uses the Armadillo expression.
+    MatType dataT = data.t();
+    REQUIRE(SquaredEuclideanDistance::Evaluate(dataT.row(0), dataT.row(1)) ==
+        Approx(SquaredEuclideanDistance::Evaluate(a, b)).epsilon(tol));
+
+    // Batch evaluation.
+    RowType distances;
+    EuclideanDistance::Evaluate(a, data, distances);
+    REQUIRE(distances.n_elem == data.n_cols);
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      REQUIRE(distances[i] == Approx(EuclideanDistance::Evaluate(a,
+          data.col(i))).epsilon(tol).margin(tol));
+    }
+    REQUIRE(distances[0] == Approx(0.0).margin(tol));
+
+    // Batch evaluation of the columns with the given indices.
+    const size_t indices[] = { 7, 2, 2, 9, 0 };
+    double indexedDistances[5];
+    ManhattanDistance::Evaluate(a, data, indices, 5, indexedDistances);
+    for (size_t i = 0; i < 5; ++i)
+    {
+      REQUIRE(indexedDistances[i] == Approx(ManhattanDistance::Evaluate(a,
+          data.col(indices[i]))).epsilon(tol).margin(tol));
+    }
+    ChebyshevDistance::Evaluate(data.col(3), data, indices, 5,
+        indexedDistances);
+    for (size_t i = 0; i < 5; ++i)
+    {
+      REQUIRE(indexedDistances[i] == Approx(ChebyshevDistance::Evaluate(
+          data.col(3), data.col(indices[i]))).epsilon(tol).margin(tol));
+    }
+    LMetric<3, true>::Evaluate(a, data, indices, 5, indexedDistances);
+    for (size_t i = 0; i < 5; ++i)
+    {
+      REQUIRE(indexedDistances[i] == Approx(LMetric<3, true>::Evaluate(a,
+          data.col(indices[i]))).epsilon(tol).margin(tol));
+    }
+  }
+}
+
 /**
  * Simple test for IoU distance.
  */
@@ -0,0 +1,135 @@
+/**
+ * @file tests/distributed_function_test.cpp
+ *
+ * Tests for DistributedFunction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/logistic_regression.hpp>
+#include <mlpack/methods/softmax_regression.hpp>
+
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * A communicator that pretends that there are two ranks, the other one holding
+ * an identical copy of the data except for its number of points.
+ */
+class MirrorCommunicator
+{
+ public:
+  MirrorCommunicator(const size_t otherNumFunctions = 1000) :
+      otherNumFunctions(otherNumFunctions) { }
+
+  size_t Rank() const { return 0; }
+  size_t Size() const { return 2; }
+
+  template<typename MatType>
+  void AllReduceSum(MatType& m) const { m *= 2; }
+
+  template<typename ElemType>
+  ElemType AllReduceSum(const ElemType value) const { return 2 * value; }
+
+  size_t AllReduceMin(const size_t value) const
+  {
+    return std::min(value, otherNumFunctions);
+  }
+
+  template<typename MatType>
+  void Broadcast(MatType& /* m */, const size_t /* root */ = 0) const { }
+
+ private:
+  size_t otherNumFunctions;
+};
+
+/**
+ * With a single rank, DistributedFunction should give the same results as the
+ * function it wraps.
+ */
+TEST_CASE("DistributedFunctionLocalTest", "[DistributedFunctionTest]")
+{
+  arma::mat data(5, 100, arma::fill::randn);
+  arma::Row<size_t> labels = arma::conv_to<arma::Row<size_t>>::from(
+      data.row(0) + data.row(1) > 0);
+
+  LogisticRegressionFunction<> lrf(data, labels, 0.01);
+  DistributedFunction<LogisticRegressionFunction<>> f(lrf);
+  REQUIRE(f.NumFunctions() == 100);
+
+  arma::mat coordinates(1, 6, arma::fill::randn);
+  f.Synchronize(coordinates);
+
+  arma::mat gradient, distributedGradient;
+  lrf.Gradient(coordinates, gradient);
+  const double objective = f.EvaluateWithGradient(coordinates,
+      distributedGradient);
+  REQUIRE(objective == Approx(lrf.Evaluate(coordinates)).epsilon(1e-10));
+  CheckMatrices(gradient, distributedGradient);
+
+  lrf.Gradient(coordinates, 10, gradient, 20);
+  f.Gradient(coordinates, 10, distributedGradient, 20);
+  CheckMatrices(gradient, distributedGradient);
+  REQUIRE(f.Evaluate(coordinates, 10, 20) ==
+      Approx(lrf.Evaluate(coordinates, 10, 20)).epsilon(1e-10));
+}
+
+/**
+ * Make sure the objective and gradient are averaged over the ranks, and the
+ * number of functions is the smallest over all ranks.
+ */
+TEST_CASE("DistributedFunctionAverageTest", "[DistributedFunctionTest]")
+{
+  arma::mat data(4, 80, arma::fill::randn);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(80,
+      arma::distr_param(0, 2));
+
+  // SoftmaxRegressionFunction has no EvaluateWithGradient(), so this also
+  // checks the fallback to Evaluate() and Gradient().
+  SoftmaxRegressionFunction<> srf(data, labels, 3, 0.001);
+  DistributedFunction<SoftmaxRegressionFunction<>, MirrorCommunicator> f(srf,
+      MirrorCommunicator(50));
+  REQUIRE(f.NumFunctions() == 50);
+
+  arma::mat coordinates = srf.InitializeWeights();
+
+  // Since the other rank holds the same data, the averages are the same as the
+  // local results.
+  arma::mat gradient, distributedGradient;
+  srf.Gradient(coordinates, 5, gradient, 30);
+  const double objective = f.EvaluateWithGradient(coordinates, 5,
+      distributedGradient, 30);
+  REQUIRE(objective == Approx(srf.Evaluate(coordinates, 5, 30)).
+      epsilon(1e-10));
+  CheckMatrices(gradient, distributedGradient);
+
+  srf.Gradient(coordinates, gradient);
+  f.Gradient(coordinates, distributedGradient);
+  CheckMatrices(gradient, distributedGradient);
+}
+
+/**
+ * Train a logistic regression model through DistributedFunction with SGD.
+ */
+TEST_CASE("DistributedFunctionTrainTest", "[DistributedFunctionTest]")
+{
+  arma::mat data(3, 500, arma::fill::randn);
+  arma::Row<size_t> labels = arma::conv_to<arma::Row<size_t>>::from(
+      data.row(0) - data.row(2) > 0);
+
+  LogisticRegressionFunction<> lrf(data, labels);
+  DistributedFunction<LogisticRegressionFunction<>> f(lrf);
+
+  arma::mat coordinates(1, 4, arma::fill::zeros);
+  ens::SGD<> sgd(0.05, 16, 20 * data.n_cols, 1e-9);
+  sgd.Optimize(f, coordinates);
+
+  LogisticRegression<> lr(data.n_rows, 0);
+  lr.Parameters() = coordinates;
+  REQUIRE(lr.ComputeAccuracy(data, labels) >= 95.0);
+}
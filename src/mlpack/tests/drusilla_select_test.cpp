@@ -162,3 +162,38 @@ TEST_CASE("SparseTest", "[DrusillaSelectTest]")
   REQUIRE(distances.n_cols == 1000);
   REQUIRE(distances.n_rows == 3);
 }
+
+// Make sure the (blocked) search returns the furthest points of the candidate
+// set, with exact distances.
+TEST_CASE("DrusillaSelectCandidateSearchTest", "[DrusillaSelectTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 1000);
+  arma::mat querySet = arma::randu<arma::mat>(5, 300);
+
+  DrusillaSelect<> ds(dataset, 5, 10);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  ds.Search(querySet, 3, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 3);
+  REQUIRE(neighbors.n_cols == 300);
+
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    arma::vec candidateDistances(ds.CandidateSet().n_cols);
+    for (size_t c = 0; c < ds.CandidateSet().n_cols; ++c)
+    {
+      candidateDistances[c] = EuclideanDistance::Evaluate(querySet.col(q),
+          ds.CandidateSet().col(c));
+    }
+    candidateDistances = arma::sort(candidateDistances, "descend");
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+      REQUIRE(distances(i, q) == Approx(candidateDistances[i]).epsilon(1e-10));
+      REQUIRE(distances(i, q) == Approx(EuclideanDistance::Evaluate(
+          querySet.col(q), dataset.col(neighbors(i, q)))).epsilon(1e-10));
+    }
+  }
+}
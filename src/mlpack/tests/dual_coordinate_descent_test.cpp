@@ -0,0 +1,174 @@
+/**
+ * @file tests/dual_coordinate_descent_test.cpp
+ *
+ * Tests for DualCoordinateDescent and the LinearSVM and LogisticRegression
+ * training modes that use it.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/linear_svm.hpp>
+#include <mlpack/methods/logistic_regression.hpp>
+
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * Create a noisy two-class dataset with labels +1 and -1: the label of each
+ * point is the sign of a random linear function plus noise.
+ */
+inline void NoisyLinearDataset(arma::mat& data,
+                               arma::vec& labels,
+                               const size_t dimensionality = 10,
+                               const size_t numPoints = 500)
+{
+  data.randn(dimensionality, numPoints);
+  const arma::rowvec w(dimensionality, arma::fill::randn);
+  const arma::rowvec scores = w * data + 0.5 +
+      0.5 * arma::randn<arma::rowvec>(numPoints);
+  labels.set_size(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    labels[i] = (scores[i] > 0) ? 1.0 : -1.0;
+}
+
+/**
+ * The hinge loss solution must not be improved by small steps of the primal
+ * objective, and must be the same with and without shrinking.
+ */
+TEST_CASE("DualCoordinateDescentHingeTest", "[DualCoordinateDescentTest]")
+{
+  arma::mat data;
+  arma::vec labels;
+  NoisyLinearDataset(data, labels);
+  const double c = 0.5;
+
+  DualCoordinateDescent dcd(1e-5, 0, true);
+  arma::vec w;
+  const double objective = dcd.SolveHinge(data, labels, c, true, w);
+  REQUIRE(w.n_elem == data.n_rows + 1);
+
+  auto primal = [&](const arma::vec& v)
+  {
+    const arma::vec margins = labels % (data.t() * v.head(data.n_rows) +
+        v[data.n_rows]);
+    return 0.5 * arma::dot(v, v) + c * arma::accu(arma::clamp(1.0 - margins,
+        0.0, DBL_MAX));
+  };
+  REQUIRE(objective == Approx(primal(w)).epsilon(1e-8));
+
+  for (size_t j = 0; j < w.n_elem; ++j)
+  {
+    for (const double step : { -1e-3, 1e-3 })
+    {
+      arma::vec v(w);
+      v[j] += step;
+      REQUIRE(primal(v) >= objective - 1e-4);
+    }
+  }
+
+  dcd.Shrinking() = false;
+  arma::vec wNoShrinking;
+  const double objectiveNoShrinking = dcd.SolveHinge(data, labels, c, true,
+      wNoShrinking);
+  REQUIRE(objectiveNoShrinking == Approx(objective).epsilon(1e-4));
+  REQUIRE(arma::approx_equal(w, wNoShrinking, "absdiff", 1e-2));
+}
+
+/**
+ * The gradient of the logistic regression objective must vanish at the
+ * solution, and sparse data must give the same solution as dense data.
+ */
+TEST_CASE("DualCoordinateDescentLogisticTest", "[DualCoordinateDescentTest]")
+{
+  arma::mat data;
+  arma::vec labels;
+  NoisyLinearDataset(data, labels);
+  const double c = 2.0;
+
+  DualCoordinateDescent dcd(1e-6, 0);
+  arma::vec w;
+  const double objective = dcd.SolveLogistic(data, labels, c, true, w);
+
+  arma::mat extended = arma::join_cols(data, arma::ones<arma::rowvec>(
+      data.n_cols));
+  const arma::vec margins = labels % (extended.t() * w);
+  const arma::vec gradient = w - c * extended * (labels /
+      (1.0 + arma::exp(margins)));
+  REQUIRE(arma::norm(gradient) < 1e-3);
+  REQUIRE(objective == Approx(0.5 * arma::dot(w, w) +
+      c * arma::accu(arma::log(1.0 + arma::exp(-margins)))).epsilon(1e-8));
+
+  // Zero out most of the data and compare the sparse and dense solutions.
+  data.elem(arma::find(arma::randu<arma::mat>(data.n_rows, data.n_cols) <
+      0.8)).zeros();
+  const arma::sp_mat sparseData(data);
+  arma::vec denseW, sparseW;
+  dcd.SolveLogistic(data, labels, c, false, denseW);
+  dcd.SolveLogistic(sparseData, labels, c, false, sparseW);
+  REQUIRE(denseW.n_elem == data.n_rows);
+  REQUIRE(arma::approx_equal(denseW, sparseW, "absdiff", 1e-4));
+}
+
+/**
+ * Train a one-vs-rest linear SVM with dual coordinate descent on sparse
+ * multi-class data.
+ */
+TEST_CASE("DualCoordinateDescentLinearSVMTest", "[DualCoordinateDescentTest]")
+{
+  const size_t numClasses = 4;
+  arma::sp_mat data;
+  data.sprandu(300, 4000, 0.05);
+  const arma::mat w(numClasses, 300, arma::fill::randn);
+  const arma::mat scores = w * data;
+  const arma::Row<size_t> labels = arma::conv_to<arma::Row<size_t>>::from(
+      arma::index_max(scores, 0));
+
+  DualCoordinateDescent dcd(0.01);
+  LinearSVM<> svm;
+  svm.Lambda() = 1e-5;
+  svm.FitIntercept() = true;
+  svm.Train(data, labels, numClasses, dcd);
+
+  REQUIRE(svm.NumClasses() == numClasses);
+  REQUIRE(svm.Parameters().n_rows == 301);
+  REQUIRE(svm.Parameters().n_cols == numClasses);
+  REQUIRE(svm.ComputeAccuracy(data, labels) > 85.0);
+
+  svm.Lambda() = 0.0;
+  REQUIRE_THROWS_AS(svm.Train(data, labels, numClasses, dcd),
+      std::invalid_argument);
+}
+
+/**
+ * Train logistic regression with dual coordinate descent on sparse and dense
+ * data.
+ */
+TEST_CASE("DualCoordinateDescentLogisticRegressionTest",
+          "[DualCoordinateDescentTest]")
+{
+  arma::sp_mat data;
+  data.sprandu(200, 2000, 0.05);
+  const arma::rowvec w(200, arma::fill::randn);
+  const arma::Row<size_t> labels = arma::conv_to<arma::Row<size_t>>::from(
+      (w * data) > 0);
+
+  DualCoordinateDescent dcd(0.01);
+  LogisticRegression<arma::sp_mat> lr(data.n_rows, 0.1);
+  lr.Train(data, labels, dcd);
+  REQUIRE(lr.Parameters().n_elem == data.n_rows + 1);
+  REQUIRE(lr.ComputeAccuracy(data, labels) > 95.0);
+
+  // The dense model must be (nearly) the same.
+  LogisticRegression<> denseLr(data.n_rows, 0.1);
+  denseLr.Train(arma::mat(data), labels, dcd);
+  REQUIRE(arma::approx_equal(lr.Parameters(), denseLr.Parameters(), "absdiff",
+      0.1));
+
+  lr.Lambda() = 0.0;
+  REQUIRE_THROWS_AS(lr.Train(data, labels, dcd), std::invalid_argument);
+}
@@ -0,0 +1,213 @@
+/**
+ * @file tests/elastic_net_test.cpp
+ *
+ * Tests for ElasticNet and LogisticElasticNet.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/elastic_net.hpp>
+#include <mlpack/methods/lars.hpp>
+
+#include "catch.hpp"
+#include "serialization.hpp"
+#include "test_catch_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * Create a regression dataset whose responses only depend on a few of the
+ * dimensions.
+ */
+inline void SparseRegressionDataset(arma::mat& data,
+                                    arma::rowvec& responses,
+                                    const size_t dimensionality = 50,
+                                    const size_t numPoints = 200)
+{
+  data.randn(dimensionality, numPoints);
+  arma::rowvec w(dimensionality, arma::fill::zeros);
+  w.head(5) = arma::rowvec({ 3.0, -2.0, 1.5, -1.0, 0.5 });
+  responses = w * data + 2.0 + 0.1 * arma::randn<arma::rowvec>(numPoints);
+}
+
+/**
+ * Check the optimality conditions of the elastic net for the given gradient
+ * of the loss X (y - b - X^T beta).
+ */
+inline void CheckOptimality(const arma::vec& gradient,
+                            const arma::vec& beta,
+                            const double lambda1,
+                            const double lambda2,
+                            const double tolerance)
+{
+  for (size_t j = 0; j < beta.n_elem; ++j)
+  {
+    if (beta[j] == 0.0)
+    {
+      REQUIRE(std::abs(gradient[j]) <= lambda1 + tolerance);
+    }
+    else
+    {
+      const double sign = (beta[j] > 0.0) ? 1.0 : -1.0;
+      REQUIRE(gradient[j] - lambda2 * beta[j] ==
+          Approx(lambda1 * sign).margin(tolerance));
+    }
+  }
+}
+
+/**
+ * The LASSO solution must satisfy the optimality conditions, and must match
+ * the solution of LARS.
+ */
+TEST_CASE("ElasticNetLassoTest", "[ElasticNetTest]")
+{
+  arma::mat data;
+  arma::rowvec responses;
+  SparseRegressionDataset(data, responses);
+
+  const double lambda1 = 10.0;
+  ElasticNet<> model(data, responses, lambda1, 0.0, true, 1e-12);
+  const arma::rowvec residuals = responses - model.Intercept() -
+      model.Beta().t() * data;
+  REQUIRE(arma::accu(residuals) == Approx(0.0).margin(1e-5));
+  CheckOptimality(data * residuals.t(), model.Beta(), lambda1, 0.0, 1e-3);
+
+  // The relevant dimensions must be selected.
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(model.Beta()[j] != 0.0);
+
+  // Without an intercept, LARS solves the same problem.
+  ElasticNet<> noIntercept(data, responses, lambda1, 0.0, false, 1e-12);
+  REQUIRE(noIntercept.Intercept() == 0.0);
+  LARS<> lars(data, responses, true, true, lambda1, 0.0, 1e-16, false, false);
+  REQUIRE(arma::approx_equal(noIntercept.Beta(), lars.Beta(), "absdiff",
+      1e-4));
+}
+
+/**
+ * With lambda1 = 0, the solution must be that of ridge regression.
+ */
+TEST_CASE("ElasticNetRidgeTest", "[ElasticNetTest]")
+{
+  arma::mat data;
+  arma::rowvec responses;
+  SparseRegressionDataset(data, responses, 10, 100);
+
+  const double lambda2 = 5.0;
+  ElasticNet<> model(data, responses, 0.0, lambda2, false, 1e-14);
+  const arma::vec expected = arma::solve(data * data.t() +
+      lambda2 * arma::eye<arma::mat>(10, 10), data * responses.t());
+  REQUIRE(arma::approx_equal(model.Beta(), expected, "absdiff", 1e-5));
+}
+
+/**
+ * The regularization path must start with no nonzero coefficients, each
+ * solution must be optimal, and sparse data must give the same path.
+ */
+TEST_CASE("ElasticNetPathTest", "[ElasticNetTest]")
+{
+  arma::mat data;
+  arma::rowvec responses;
+  SparseRegressionDataset(data, responses, 100, 300);
+  data.elem(arma::find(arma::randu<arma::mat>(data.n_rows, data.n_cols) <
+      0.7)).zeros();
+
+  const double lambda2 = 1.0;
+  ElasticNet<> model(0.0, lambda2, true, 1e-12);
+  const arma::vec lambdas = model.LambdaPath(data, responses, 20, 1e-2);
+  REQUIRE(lambdas.n_elem == 20);
+  REQUIRE(lambdas[0] == Approx(model.LambdaMax(data, responses)));
+
+  arma::mat betas;
+  arma::rowvec intercepts;
+  model.TrainPath(data, responses, lambdas, betas, intercepts);
+  REQUIRE(betas.n_rows == data.n_rows);
+  REQUIRE(betas.n_cols == lambdas.n_elem);
+  REQUIRE(model.Lambda1() == lambdas[lambdas.n_elem - 1]);
+  REQUIRE(arma::all(betas.col(0) == 0.0));
+  REQUIRE(intercepts[0] == Approx(arma::mean(responses)));
+
+  for (size_t k = 0; k < lambdas.n_elem; k += 5)
+  {
+    const arma::rowvec residuals = responses - intercepts[k] -
+        betas.col(k).t() * data;
+    CheckOptimality(data * residuals.t(), betas.col(k), lambdas[k], lambda2,
+        1e-3);
+  }
+
+  // The number of nonzero coefficients should grow along the path.
+  REQUIRE(arma::accu(betas.col(lambdas.n_elem - 1) != 0.0) >
+      arma::accu(betas.col(lambdas.n_elem / 2) != 0.0));
+
+  const arma::sp_mat sparseData(data);
+  ElasticNet<arma::sp_mat> sparseModel(0.0, lambda2, true, 1e-12);
+  arma::mat sparseBetas;
+  arma::rowvec sparseIntercepts;
+  sparseModel.TrainPath(sparseData, responses, lambdas, sparseBetas,
+      sparseIntercepts);
+  REQUIRE(arma::approx_equal(betas, sparseBetas, "absdiff", 1e-5));
+  REQUIRE(arma::approx_equal(intercepts, sparseIntercepts, "absdiff", 1e-5));
+
+  // The values of lambda1 must be decreasing.
+  REQUIRE_THROWS_AS(model.TrainPath(data, responses, arma::flipud(lambdas),
+      betas, intercepts), std::invalid_argument);
+}
+
+/**
+ * Train LogisticElasticNet, and check its optimality conditions.
+ */
+TEST_CASE("LogisticElasticNetTest", "[ElasticNetTest]")
+{
+  arma::mat data(50, 500, arma::fill::randn);
+  arma::rowvec w(50, arma::fill::zeros);
+  w.head(5) = arma::rowvec({ 3.0, -3.0, 2.0, -2.0, 1.0 });
+  const arma::Row<size_t> labels = arma::conv_to<arma::Row<size_t>>::from(
+      (w * data + 0.5 + 0.5 * arma::randn<arma::rowvec>(500)) > 0.0);
+
+  const double lambda1 = 2.0, lambda2 = 0.5;
+  LogisticElasticNet<> model(data, labels, lambda1, lambda2, true, 1e-12);
+  REQUIRE(model.ComputeAccuracy(data, labels) > 85.0);
+
+  arma::rowvec probabilities;
+  arma::Row<size_t> predictions;
+  model.Classify(data, predictions, probabilities);
+  REQUIRE(arma::all(probabilities >= 0.0 && probabilities <= 1.0));
+
+  const arma::rowvec residuals = arma::conv_to<arma::rowvec>::from(labels) -
+      probabilities;
+  REQUIRE(arma::accu(residuals) == Approx(0.0).margin(1e-4));
+  CheckOptimality(data * residuals.t(), model.Beta(), lambda1, lambda2, 1e-3);
+
+  // Only labels 0 and 1 are allowed.
+  arma::Row<size_t> badLabels(labels);
+  badLabels[0] = 2;
+  REQUIRE_THROWS_AS(model.Train(data, badLabels), std::invalid_argument);
+}
+
+/**
+ * Make sure a trained model can be serialized.
+ */
+TEST_CASE("ElasticNetSerializationTest", "[ElasticNetTest]")
+{
+  arma::mat data;
+  arma::rowvec responses;
+  SparseRegressionDataset(data, responses);
+
+  ElasticNet<> model(data, responses, 5.0, 0.1);
+  ElasticNet<> xmlModel, jsonModel, binaryModel;
+  SerializeObjectAll(model, xmlModel, jsonModel, binaryModel);
+
+  arma::rowvec predictions, xmlPredictions, jsonPredictions, binaryPredictions;
+  model.Predict(data, predictions);
+  xmlModel.Predict(data, xmlPredictions);
+  jsonModel.Predict(data, jsonPredictions);
+  binaryModel.Predict(data, binaryPredictions);
+
+  CheckMatrices(predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+  REQUIRE(xmlModel.Lambda1() == 5.0);
+  REQUIRE(binaryModel.Lambda2() == 0.1);
+}
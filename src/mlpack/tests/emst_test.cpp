@@ -269,3 +269,101 @@ TEST_CASE("EMSTBallTreeTest", "[EMSTTest]")
     REQUIRE(bstResults(2, i) == Approx(ballResults(2, i)).epsilon(1e-7));
   }
 }
+
+/**
+ * Make sure that the dual-tree method finds a minimum spanning tree of a
+ * dataset with many tied distances.  Here the edges are not unique, so only
+ * the total length and the connectivity of the tree are checked.
+ */
+TEST_CASE("EMSTTiedDistancesTest", "[EMSTTest]")
+{
+  // A 30x30 grid: every edge of a minimum spanning tree has length 1.
+  arma::mat inputData(2, 900);
+  for (size_t i = 0; i < 900; ++i)
+  {
+    inputData(0, i) = i % 30;
+    inputData(1, i) = i / 30;
+  }
+
+  DualTreeBoruvka<> dtb(inputData);
+  arma::mat results;
+  dtb.ComputeMST(results);
+
+  REQUIRE(results.n_cols == 899);
+  REQUIRE(arma::accu(results.row(2)) == Approx(899.0).epsilon(1e-10));
+
+  UnionFind connections(inputData.n_cols);
+  for (size_t i = 0; i < results.n_cols; ++i)
+    REQUIRE(connections.Union((size_t) results(0, i), (size_t) results(1, i)));
+}
+
+/**
+ * Make sure that the mutual reachability MST computed with trees matches the
+ * naive computation and has the right total length.
+ */
+TEST_CASE("EMSTMutualReachabilityTest", "[EMSTTest]")
+{
+  arma::mat inputData(3, 300, arma::fill::randu);
+  arma::vec coreDistances(300, arma::fill::randu);
+  coreDistances *= 0.2;
+
+  DualTreeBoruvka<> dtb(inputData);
+  arma::mat dualResults;
+  dtb.ComputeMST(dualResults, coreDistances);
+
+  DualTreeBoruvka<> dtbNaive(inputData, true);
+  arma::mat naiveResults;
+  dtbNaive.ComputeMST(naiveResults, coreDistances);
+
+  // Many edges have the same length (the core distance of one of their
+  // points), so the edges may differ, but all minimum spanning trees have the
+  // same sorted edge lengths.
+  REQUIRE(dualResults.n_cols == naiveResults.n_cols);
+  for (size_t i = 0; i < dualResults.n_cols; ++i)
+  {
+    REQUIRE(dualResults(2, i) == Approx(naiveResults(2, i)).epsilon(1e-7));
+
+    // Each edge has the mutual reachability distance of its points.
+    const size_t a = (size_t) dualResults(0, i);
+    const size_t b = (size_t) dualResults(1, i);
+    const double d = std::max(EuclideanDistance::Evaluate(inputData.col(a),
+        inputData.col(b)), std::max(coreDistances[a], coreDistances[b]));
+    REQUIRE(dualResults(2, i) == Approx(d).epsilon(1e-7));
+  }
+
+  // Compute the length of the MST with Prim's algorithm.
+  arma::vec best(300);
+  best.fill(DBL_MAX);
+  std::vector<bool> inTree(300, false);
+  double total = 0.0;
+  best[0] = 0.0;
+  for (size_t step = 0; step < 300; ++step)
+  {
+    size_t next = 0;
+    double nextDistance = DBL_MAX;
+    for (size_t i = 0; i < 300; ++i)
+    {
+      if (!inTree[i] && best[i] < nextDistance)
+      {
+        next = i;
+        nextDistance = best[i];
+      }
+    }
+
+    inTree[next] = true;
+    total += nextDistance;
+    for (size_t i = 0; i < 300; ++i)
+    {
+      const double d = std::max(EuclideanDistance::Evaluate(
+          inputData.col(next), inputData.col(i)),
+          std::max(coreDistances[next], coreDistances[i]));
+      if (!inTree[i] && d < best[i])
+        best[i] = d;
+    }
+  }
+
+  REQUIRE(arma::accu(dualResults.row(2)) == Approx(total).epsilon(1e-7));
+
+  REQUIRE_THROWS_AS(dtb.ComputeMST(dualResults, arma::vec(10)),
+      std::invalid_argument);
+}
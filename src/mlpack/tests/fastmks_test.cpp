@@ -122,6 +122,56 @@ TEST_CASE("DualTreeVsSingleTree", "[FastMKSTest]")
   }
 }
 
+/**
+ * Make sure that the parallel cover tree traverser (with many query subtrees)
+ * and parallel single-tree search give the same results as naive search, on a
+ * reference set big enough for the tree build to split distance computations.
+ */
+TEST_CASE("FastMKSParallelTraversalTest", "[FastMKSTest]")
+{
+  arma::mat referenceData(6, 5000, arma::fill::randn);
+  arma::mat queryData(6, 800, arma::fill::randn);
+  LinearKernel lk;
+
+  FastMKS<LinearKernel> naive(referenceData, lk, false, true);
+  arma::Mat<size_t> naiveIndices;
+  arma::mat naiveProducts;
+  naive.Search(queryData, 5, naiveIndices, naiveProducts);
+
+  FastMKS<LinearKernel> single(referenceData, lk, true);
+  arma::Mat<size_t> singleIndices;
+  arma::mat singleProducts;
+  single.Search(queryData, 5, singleIndices, singleProducts);
+
+  // Run the parallel dual-tree traversal by hand, forcing many tasks.
+  using TreeType = FastMKS<LinearKernel>::Tree;
+  using RuleType = FastMKSRules<LinearKernel, TreeType>;
+  IPMetric<LinearKernel> metric(lk);
+  TreeType referenceTree(referenceData, metric);
+  TreeType queryTree(queryData, metric);
+
+  RuleType rules(referenceData, queryData, 5, referenceTree.Distance().Kernel());
+  TreeType::ParallelDualTreeTraverser<RuleType> traverser(rules, 64);
+  traverser.Traverse(queryTree, referenceTree);
+
+  arma::Mat<size_t> dualIndices;
+  arma::mat dualProducts;
+  rules.GetResults(dualIndices, dualProducts);
+
+  for (size_t q = 0; q < queryData.n_cols; ++q)
+  {
+    for (size_t r = 0; r < 5; ++r)
+    {
+      REQUIRE(singleIndices(r, q) == naiveIndices(r, q));
+      REQUIRE(singleProducts(r, q) ==
+          Approx(naiveProducts(r, q)).epsilon(1e-7));
+      REQUIRE(dualIndices(r, q) == naiveIndices(r, q));
+      REQUIRE(dualProducts(r, q) ==
+          Approx(naiveProducts(r, q)).epsilon(1e-7));
+    }
+  }
+}
+
 /**
  * Test sparse FastMKS (how useful is this, I'm not sure).
  */
@@ -410,6 +410,47 @@ TEST_CASE("GMMTrainEMMultipleGaussiansWithProbability", "[GMMTest]")
   }
 }
 
+/**
+ * Make sure that, when every observation has probability 1, EM with
+ * probabilities gives the same model as EM without them.  The dataset spans
+ * many blocks of points, so this also checks that the per-block sums are
+ * combined correctly.
+ */
+TEST_CASE("EMFitUnitProbabilitiesTest", "[GMMTest]")
+{
+  arma::mat data = arma::randn(4, 5000);
+  data.cols(0, 2499).each_col() += arma::vec("3.0 0.0 -2.0 1.0");
+
+  std::vector<GaussianDistribution<>> initialDists(2,
+      GaussianDistribution<>(4));
+  initialDists[0].Mean() = arma::vec("2.0 0.0 -1.0 1.0");
+  initialDists[1].Mean() = arma::vec("0.5 0.5 0.0 0.0");
+  arma::vec initialWeights("0.5 0.5");
+
+  EMFit<> em(10, 1e-10);
+  std::vector<GaussianDistribution<>> dists(initialDists);
+  arma::vec weights(initialWeights);
+  em.Estimate(data, dists, weights, true);
+
+  std::vector<GaussianDistribution<>> probDists(initialDists);
+  arma::vec probWeights(initialWeights);
+  em.Estimate(data, arma::ones<arma::vec>(data.n_cols), probDists,
+      probWeights, true);
+
+  for (size_t i = 0; i < 2; ++i)
+  {
+    REQUIRE(probWeights[i] == Approx(weights[i]).epsilon(1e-7));
+    REQUIRE(arma::approx_equal(probDists[i].Mean(), dists[i].Mean(), "both",
+        1e-7, 1e-7));
+    REQUIRE(arma::approx_equal(probDists[i].Covariance(),
+        dists[i].Covariance(), "both", 1e-7, 1e-7));
+  }
+
+  // The two components should have been found.
+  REQUIRE(weights[0] == Approx(0.5).epsilon(0.05));
+  REQUIRE(weights[1] == Approx(0.5).epsilon(0.05));
+}
+
 /**
  * Make sure generating observations randomly works.  We'll do this by
  * generating a bunch of random observations and then re-training on them, and
@@ -533,6 +574,46 @@ TEST_CASE("GMMClassifyTest", "[GMMTest]")
   REQUIRE(classes[12] == 2);
 }
 
+/**
+ * Make sure the batch log-probabilities and classifications of a GMM, computed
+ * in blocks for all components at once, match the single-point computations.
+ */
+TEST_CASE("GMMBatchLogProbabilityTest", "[GMMTest]")
+{
+  const size_t dims = 5;
+  GMM gmm(4, dims);
+  for (size_t k = 0; k < 4; ++k)
+  {
+    arma::mat a = arma::randu<arma::mat>(dims, dims);
+    gmm.Component(k) = GaussianDistribution<>(
+        3.0 * arma::randn<arma::vec>(dims),
+        a * a.t() + 0.5 * arma::eye<arma::mat>(dims, dims));
+  }
+  gmm.Weights() = "0.1 0.2 0.3 0.4";
+
+  // Use enough points for several blocks.
+  arma::mat observations = 4.0 * arma::randn<arma::mat>(dims, 2500);
+
+  arma::vec logProbs;
+  arma::Row<size_t> classes;
+  gmm.LogProbability(observations, logProbs);
+  gmm.Classify(observations, classes);
+  REQUIRE(logProbs.n_elem == 2500);
+  REQUIRE(classes.n_elem == 2500);
+
+  for (size_t i = 0; i < observations.n_cols; ++i)
+  {
+    const arma::vec point = observations.col(i);
+    REQUIRE(logProbs[i] ==
+        Approx(gmm.LogProbability(point)).epsilon(1e-8));
+
+    arma::vec componentLogProbs(4);
+    for (size_t k = 0; k < 4; ++k)
+      componentLogProbs[k] = gmm.LogProbability(point, k);
+    REQUIRE(classes[i] == componentLogProbs.index_max());
+  }
+}
+
 TEST_CASE("GMMLoadSaveTest", "[GMMTest]")
 {
   // Create a GMM, save it, and load it.
@@ -1231,3 +1312,144 @@ TEST_CASE("DiagonalGMMLoadSaveTest", "[GMMTest]")
     }
   }
 }
+
+// Generate points from three well-separated Gaussians, interleaved.
+static void StepwiseEMData(arma::mat& data, std::vector<arma::vec>& means)
+{
+  means = { arma::vec("0.0 0.0 0.0"), arma::vec("8.0 8.0 0.0"),
+      arma::vec("0.0 8.0 8.0") };
+  data.randn(3, 15000);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    data.col(i) += means[i % 3];
+}
+
+// Check that each true mean is close to one of the means of the model.
+template<typename GMMType>
+static void CheckStepwiseEMMeans(const GMMType& gmm,
+                                 const std::vector<arma::vec>& means)
+{
+  for (size_t i = 0; i < means.size(); ++i)
+  {
+    double minDistance = DBL_MAX;
+    size_t closest = 0;
+    for (size_t j = 0; j < gmm.Gaussians(); ++j)
+    {
+      const double d = arma::norm(gmm.Component(j).Mean() - means[i]);
+      if (d < minDistance)
+      {
+        minDistance = d;
+        closest = j;
+      }
+    }
+
+    REQUIRE(minDistance < 0.2);
+    REQUIRE(gmm.Weights()[closest] == Approx(1.0 / 3.0).epsilon(0.05));
+  }
+}
+
+/**
+ * Make sure that stepwise EM on in-memory data finds the components, and gets
+ * about the same log-likelihood as full EM.
+ */
+TEST_CASE("GMMTrainStepwiseEMTest", "[GMMTest]")
+{
+  arma::mat data;
+  std::vector<arma::vec> means;
+  StepwiseEMData(data, means);
+
+  GMM gmm(3, 3);
+  const double stepwiseLikelihood = gmm.Train(data, 1, false,
+      StepwiseEMFit<>(3, 500));
+  CheckStepwiseEMMeans(gmm, means);
+
+  GMM emGMM(3, 3);
+  const double emLikelihood = emGMM.Train(data);
+  REQUIRE(stepwiseLikelihood == Approx(emLikelihood).epsilon(0.01));
+
+  // Continuing from the trained model should keep it where it is.
+  StepwiseEMFit<> fitter(1, 500);
+  arma::vec weights = gmm.Weights();
+  std::vector<GaussianDistribution<>> dists;
+  for (size_t i = 0; i < 3; ++i)
+    dists.push_back(gmm.Component(i));
+  fitter.Update(data.cols(0, 499), dists, weights);
+  REQUIRE(fitter.Steps() == 1);
+  for (size_t i = 0; i < 3; ++i)
+    REQUIRE(arma::norm(dists[i].Mean() - gmm.Component(i).Mean()) < 0.2);
+}
+
+/**
+ * Train GMM and DiagonalGMM on data read from disk in chunks.
+ */
+TEST_CASE("GMMTrainChunkedSourceTest", "[GMMTest]")
+{
+  arma::mat data;
+  std::vector<arma::vec> means;
+  StepwiseEMData(data, means);
+  REQUIRE(data::Save("gmm_chunked_data.bin", data, false, false,
+      data::FileType::ArmaBinary) == true);
+
+  data::ChunkedSource<double> source("gmm_chunked_data.bin", 4000, false);
+  REQUIRE(source.NumPoints() == data.n_cols);
+
+  GMM gmm(3, 3);
+  gmm.Train(source);
+  CheckStepwiseEMMeans(gmm, means);
+
+  DiagonalGMM diagGMM(3, 3);
+  diagGMM.Train(source);
+  CheckStepwiseEMMeans(diagGMM, means);
+
+  // The dimensionality of the source must match the model.
+  GMM wrongGMM(3, 4);
+  REQUIRE_THROWS_AS(wrongGMM.Train(source), std::invalid_argument);
+
+  remove("gmm_chunked_data.bin");
+}
+
+/**
+ * Make sure that tree-accelerated EM matches EM when nothing is approximated,
+ * and finds the components when nodes are pruned.
+ */
+TEST_CASE("GMMTrainMRKDEMTest", "[GMMTest]")
+{
+  arma::mat data;
+  std::vector<arma::vec> means;
+  StepwiseEMData(data, means);
+
+  // Start both fitters from the same model.
+  GMM initialGMM(3, 3);
+  initialGMM.Train(data, 1, false, EMFit<>(1));
+
+  // With a responsibility tolerance of zero, only the nodes that belong to a
+  // single component are pruned, so the iterations are exact.
+  GMM emGMM(initialGMM), mrkdGMM(initialGMM);
+  emGMM.Train(data, 1, true, EMFit<>(5, -1.0));
+  mrkdGMM.Train(data, 1, true, MRKDEMFit<>(5, -1.0, 0.0));
+  for (size_t i = 0; i < 3; ++i)
+  {
+    REQUIRE(arma::approx_equal(mrkdGMM.Component(i).Mean(),
+        emGMM.Component(i).Mean(), "absdiff", 1e-6));
+    REQUIRE(arma::approx_equal(mrkdGMM.Component(i).Covariance(),
+        emGMM.Component(i).Covariance(), "absdiff", 1e-6));
+  }
+  REQUIRE(arma::approx_equal(mrkdGMM.Weights(), emGMM.Weights(), "absdiff",
+      1e-6));
+
+  // With the default tolerance, many nodes are pruned, and the model is still
+  // close to the one found by EM.
+  GMM gmm(3, 3);
+  MRKDEMFit<> fitter;
+  const double mrkdLikelihood = gmm.Train(data, 1, false, fitter);
+  CheckStepwiseEMMeans(gmm, means);
+
+  GMM fullGMM(3, 3);
+  const double emLikelihood = fullGMM.Train(data);
+  REQUIRE(mrkdLikelihood == Approx(emLikelihood).epsilon(0.01));
+
+  // The probabilities overload falls back to EM.
+  GMM probGMM(3, 3);
+  arma::vec probabilities(data.n_cols, arma::fill::ones);
+  probGMM.Train(data, probabilities, 1, false, MRKDEMFit<>());
+  CheckStepwiseEMMeans(probGMM, means);
+}
@@ -0,0 +1,183 @@
+/**
+ * @file tests/hdbscan_test.cpp
+ *
+ * Test the HDBSCAN implementation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/hdbscan.hpp>
+#include <mlpack/methods/dbscan.hpp>
+
+#include "test_catch_tools.hpp"
+#include "catch.hpp"
+
+using namespace mlpack;
+
+/**
+ * Generate three Gaussian clusters with different densities, followed by a few
+ * outliers.
+ */
+void GetHDBSCANData(arma::mat& points)
+{
+  points.set_size(2, 605);
+  points.cols(0, 199) = 0.2 * arma::randn<arma::mat>(2, 200);
+  points.cols(200, 399) = 0.5 * arma::randn<arma::mat>(2, 200);
+  points.cols(200, 399).each_col() += arma::vec("10.0 0.0");
+  points.cols(400, 599) = 0.1 * arma::randn<arma::mat>(2, 200);
+  points.cols(400, 599).each_col() += arma::vec("0.0 10.0");
+
+  points.col(600) = arma::vec("50.0 50.0");
+  points.col(601) = arma::vec("-50.0 50.0");
+  points.col(602) = arma::vec("50.0 -50.0");
+  points.col(603) = arma::vec("-50.0 -50.0");
+  points.col(604) = arma::vec("25.0 -40.0");
+}
+
+/**
+ * Check that clusters of different densities are found with a single run,
+ * and that outliers are noise.
+ */
+TEST_CASE("HDBSCANGaussianClustersTest", "[HDBSCANTest]")
+{
+  arma::mat points;
+  GetHDBSCANData(points);
+
+  HDBSCAN<> h(20);
+  arma::Row<size_t> assignments;
+  arma::mat centroids;
+  const size_t clusters = h.Cluster(points, assignments, centroids);
+
+  REQUIRE(clusters == 3);
+  REQUIRE(assignments.n_elem == points.n_cols);
+  REQUIRE(centroids.n_cols == 3);
+
+  for (size_t i = 600; i < 605; ++i)
+    REQUIRE(assignments[i] == SIZE_MAX);
+
+  // Most of the points of each Gaussian must share its label, and no two
+  // Gaussians may share a label.
+  arma::Row<size_t> labels(3);
+  for (size_t c = 0; c < 3; ++c)
+  {
+    arma::Col<size_t> counts(clusters + 1, arma::fill::zeros);
+    for (size_t i = 200 * c; i < 200 * (c + 1); ++i)
+      ++counts[(assignments[i] == SIZE_MAX) ? clusters : assignments[i]];
+
+    labels[c] = counts.head(clusters).index_max();
+    REQUIRE(counts[labels[c]] >= 180);
+  }
+
+  REQUIRE(labels[0] != labels[1]);
+  REQUIRE(labels[0] != labels[2]);
+  REQUIRE(labels[1] != labels[2]);
+
+  // The core distances, spanning tree and condensed tree must be consistent.
+  REQUIRE(h.CoreDistances().n_elem == points.n_cols);
+  REQUIRE(h.SpanningTree().n_cols == points.n_cols - 1);
+  REQUIRE(h.Stabilities().n_elem > 3);
+  const arma::mat& condensed = h.CondensedTree();
+  REQUIRE(condensed.n_rows == 4);
+  size_t pointEdges = 0;
+  for (size_t i = 0; i < condensed.n_cols; ++i)
+  {
+    REQUIRE(condensed(0, i) >= points.n_cols);
+    if (condensed(1, i) < points.n_cols)
+      ++pointEdges;
+    else
+      REQUIRE(condensed(3, i) >= 20);
+  }
+  REQUIRE(pointEdges == points.n_cols);
+}
+
+/**
+ * The DBSCAN* clusterings extracted from the spanning tree must match the
+ * core points of the clusterings found by DBSCAN.
+ */
+TEST_CASE("HDBSCANExtractDBSCANTest", "[HDBSCANTest]")
+{
+  arma::mat points;
+  GetHDBSCANData(points);
+
+  HDBSCAN<> h(5);
+  arma::Row<size_t> assignments;
+  h.Cluster(points, assignments);
+
+  const double epsilons[3] = { 0.1, 0.3, 1.0 };
+  for (size_t e = 0; e < 3; ++e)
+  {
+    arma::Row<size_t> hAssignments, dAssignments;
+    h.ExtractDBSCAN(epsilons[e], hAssignments);
+
+    DBSCAN<> d(epsilons[e], 5);
+    d.Cluster(points, dAssignments);
+
+    // Two core points are in the same DBSCAN* cluster if and only if they are
+    // in the same DBSCAN cluster.
+    std::map<size_t, size_t> mapping;
+    for (size_t i = 0; i < points.n_cols; ++i)
+    {
+      if (h.CoreDistances()[i] > epsilons[e] || hAssignments[i] == SIZE_MAX)
+        continue;
+
+      REQUIRE(dAssignments[i] != SIZE_MAX);
+      if (mapping.count(hAssignments[i]) == 0)
+        mapping[hAssignments[i]] = dAssignments[i];
+      else
+        REQUIRE(mapping[hAssignments[i]] == dAssignments[i]);
+    }
+
+    std::set<size_t> values;
+    for (auto& m : mapping)
+      values.insert(m.second);
+    REQUIRE(values.size() == mapping.size());
+  }
+
+  HDBSCAN<> untrained;
+  REQUIRE_THROWS_AS(untrained.ExtractDBSCAN(1.0, assignments),
+      std::invalid_argument);
+}
+
+/**
+ * Uniform data has no cluster structure: unless a single cluster is allowed,
+ * nothing should be more stable than its parts, and with a single cluster
+ * allowed, everything should be in it.
+ */
+TEST_CASE("HDBSCANSingleClusterTest", "[HDBSCANTest]")
+{
+  // Duplicated points must not cause any issue.
+  arma::mat points(2, 300, arma::fill::randu);
+  points.cols(200, 299) = points.cols(0, 99);
+
+  HDBSCAN<> h(150, 10, true);
+  arma::Row<size_t> assignments;
+  const size_t clusters = h.Cluster(points, assignments);
+
+  REQUIRE(clusters == 1);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    REQUIRE(assignments[i] == 0);
+
+  // Without a single cluster, clusters of 150 points cannot exist.
+  h.AllowSingleCluster() = false;
+  REQUIRE(h.Cluster(points, assignments) == 0);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    REQUIRE(assignments[i] == SIZE_MAX);
+}
+
+/**
+ * Check that invalid parameters throw.
+ */
+TEST_CASE("HDBSCANInvalidTest", "[HDBSCANTest]")
+{
+  arma::mat points(2, 10, arma::fill::randu);
+  arma::Row<size_t> assignments;
+
+  HDBSCAN<> h1(1);
+  REQUIRE_THROWS_AS(h1.Cluster(points, assignments), std::invalid_argument);
+
+  HDBSCAN<> h2(5, 11);
+  REQUIRE_THROWS_AS(h2.Cluster(points, assignments), std::invalid_argument);
+}
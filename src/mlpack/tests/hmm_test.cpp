@@ -1507,6 +1507,139 @@ TEST_CASE("HMMTrainReturnLogLikelihood", "[HMMTest]")
   REQUIRE(std::isfinite(loglik) == true);
 }
 
+/**
+ * Make sure that the batched Predict() gives the same results as Predict() on
+ * each sequence.
+ */
+TEST_CASE("HMMBatchPredictTest", "[HMMTest]")
+{
+  HMM<GaussianDistribution<>> hmm(3, GaussianDistribution<>(2));
+  hmm.Transition() = arma::mat("0.8 0.1 0.2; 0.1 0.7 0.1; 0.1 0.2 0.7");
+  hmm.Initial() = arma::vec("0.5 0.3 0.2");
+  hmm.Emission()[0] = GaussianDistribution<>("0.0 0.0", "1.0 0.0; 0.0 1.0");
+  hmm.Emission()[1] = GaussianDistribution<>("2.0 1.0", "1.0 0.2; 0.2 0.5");
+  hmm.Emission()[2] = GaussianDistribution<>("-1.0 2.0", "0.5 0.0; 0.0 2.0");
+
+  std::vector<arma::mat> sequences(40);
+  for (size_t i = 0; i < sequences.size(); ++i)
+  {
+    arma::Row<size_t> states;
+    hmm.Generate(5 + 7 * (i % 6), sequences[i], states, i % 3);
+  }
+
+  std::vector<arma::Row<size_t>> stateSeqs;
+  arma::vec logLikelihoods;
+  hmm.Predict(sequences, stateSeqs, logLikelihoods);
+
+  REQUIRE(stateSeqs.size() == sequences.size());
+  REQUIRE(logLikelihoods.n_elem == sequences.size());
+  for (size_t i = 0; i < sequences.size(); ++i)
+  {
+    arma::Row<size_t> stateSeq;
+    const double logLikelihood = hmm.Predict(sequences[i], stateSeq);
+
+    REQUIRE(stateSeqs[i].n_elem == stateSeq.n_elem);
+    for (size_t t = 0; t < stateSeq.n_elem; ++t)
+      REQUIRE(stateSeqs[i][t] == stateSeq[t]);
+    REQUIRE(logLikelihoods[i] == Approx(logLikelihood).epsilon(1e-10));
+  }
+}
+
+/**
+ * Train a discrete HMM on many short sequences, and make sure the transition
+ * matrix is recovered.  With OpenMP, the sequences are processed in parallel.
+ */
+TEST_CASE("HMMTrainManyShortSequencesTest", "[HMMTest]")
+{
+  HMM<DiscreteDistribution<>> trueHmm(2, DiscreteDistribution<>(2));
+  trueHmm.Transition() = arma::mat("0.8 0.3; 0.2 0.7");
+  trueHmm.Initial() = arma::vec("0.5 0.5");
+  trueHmm.Emission()[0].Probabilities() = arma::vec("0.9 0.1");
+  trueHmm.Emission()[1].Probabilities() = arma::vec("0.1 0.9");
+
+  std::vector<arma::mat> sequences(500);
+  for (size_t i = 0; i < sequences.size(); ++i)
+  {
+    arma::Row<size_t> states;
+    trueHmm.Generate(20, sequences[i], states, i % 2);
+  }
+
+  // Start from the right emissions, so that the states are not swapped.
+  HMM<DiscreteDistribution<>> hmm(2, DiscreteDistribution<>(2));
+  hmm.Emission()[0].Probabilities() = arma::vec("0.8 0.2");
+  hmm.Emission()[1].Probabilities() = arma::vec("0.2 0.8");
+  const double logLikelihood = hmm.Train(sequences);
+
+  REQUIRE(std::isfinite(logLikelihood));
+  for (size_t i = 0; i < 2; ++i)
+    for (size_t j = 0; j < 2; ++j)
+      REQUIRE(hmm.Transition()(i, j) ==
+          Approx(trueHmm.Transition()(i, j)).margin(0.06));
+  REQUIRE(hmm.Emission()[0].Probabilities()[0] == Approx(0.9).margin(0.03));
+  REQUIRE(hmm.Emission()[1].Probabilities()[1] == Approx(0.9).margin(0.03));
+}
+
+/**
+ * Make sure that a left-to-right HMM given with a sparse transition matrix
+ * decodes monotone state sequences, and that Baum-Welch keeps the impossible
+ * transitions impossible.
+ */
+TEST_CASE("SparseTransitionHMMTest", "[HMMTest]")
+{
+  const size_t states = 20;
+  arma::sp_mat transition(states, states);
+  for (size_t i = 0; i < states - 1; ++i)
+  {
+    transition(i, i) = 0.7;
+    transition(i + 1, i) = 0.3;
+  }
+  transition(states - 1, states - 1) = 1.0;
+
+  arma::vec initial(states, arma::fill::zeros);
+  initial[0] = 1.0;
+
+  std::vector<GaussianDistribution<>> emissions;
+  for (size_t i = 0; i < states; ++i)
+  {
+    emissions.push_back(GaussianDistribution<>(arma::vec(1).fill(i),
+        arma::mat(1, 1).fill(0.1)));
+  }
+
+  HMM<GaussianDistribution<>> hmm(initial, transition, emissions);
+  REQUIRE(arma::approx_equal(hmm.Transition(), arma::mat(transition), "both",
+      1e-12, 1e-12));
+
+  std::vector<arma::mat> sequences(30);
+  for (size_t i = 0; i < sequences.size(); ++i)
+  {
+    arma::Row<size_t> trueStates;
+    hmm.Generate(100, sequences[i], trueStates);
+  }
+
+  std::vector<arma::Row<size_t>> stateSeqs;
+  arma::vec logLikelihoods;
+  hmm.Predict(sequences, stateSeqs, logLikelihoods);
+  for (size_t i = 0; i < sequences.size(); ++i)
+  {
+    REQUIRE(std::isfinite(logLikelihoods[i]));
+    REQUIRE(stateSeqs[i][0] == 0);
+    for (size_t t = 1; t < stateSeqs[i].n_elem; ++t)
+    {
+      REQUIRE(stateSeqs[i][t] >= stateSeqs[i][t - 1]);
+      REQUIRE(stateSeqs[i][t] <= stateSeqs[i][t - 1] + 1);
+    }
+  }
+
+  hmm.Train(sequences);
+  for (size_t j = 0; j < states; ++j)
+  {
+    REQUIRE(accu(hmm.Transition().col(j)) == Approx(1.0).epsilon(1e-7));
+    for (size_t i = 0; i < states; ++i)
+      if (i != j && i != j + 1)
+        REQUIRE(hmm.Transition()(i, j) == 0.0);
+  }
+}
+
 /********************************************/
 /** DiagonalGMM Hidden Markov Models Tests **/
 /********************************************/
@@ -0,0 +1,250 @@
+/**
+ * @file tests/hnsw_test.cpp
+ *
+ * Unit tests for the 'HNSWSearch' class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+#include "serialization.hpp"
+
+#include <mlpack/methods/hnsw.hpp>
+#include <mlpack/methods/neighbor_search.hpp>
+#include <mlpack/methods/neighbor_search/ns_model.hpp>
+
+using namespace std;
+using namespace mlpack;
+
+/**
+ * Make sure that HNSW finds most of the true nearest neighbors of a
+ * high-dimensional dataset.
+ */
+TEST_CASE("HNSWRecallTest", "[HNSWTest]")
+{
+  arma::mat rdata(32, 2000, arma::fill::randu);
+  arma::mat qdata(32, 100, arma::fill::randu);
+  const size_t k = 10;
+
+  KNN knn(rdata);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(qdata, k, trueNeighbors, trueDistances);
+
+  HNSWSearch<> hnsw(rdata, 16, 200, 100);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(qdata, k, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == k);
+  REQUIRE(neighbors.n_cols == qdata.n_cols);
+  REQUIRE(distances.n_rows == k);
+  REQUIRE(distances.n_cols == qdata.n_cols);
+
+  REQUIRE(KNN::Recall(neighbors, trueNeighbors) > 0.9);
+
+  // The distances must be correct and sorted.
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(distances(j, i) == Approx(EuclideanDistance::Evaluate(
+          qdata.col(i), rdata.col(neighbors(j, i)))).epsilon(1e-7));
+      if (j > 0)
+        REQUIRE(distances(j - 1, i) <= distances(j, i));
+    }
+  }
+}
+
+/**
+ * Make sure that a larger ef does not decrease recall.
+ */
+TEST_CASE("HNSWEfTest", "[HNSWTest]")
+{
+  arma::mat rdata(16, 2000, arma::fill::randu);
+  arma::mat qdata(16, 200, arma::fill::randu);
+  const size_t k = 5;
+
+  KNN knn(rdata);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(qdata, k, trueNeighbors, trueDistances);
+
+  HNSWSearch<> hnsw(rdata, 8, 100);
+
+  hnsw.Ef() = 5;
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(qdata, k, neighbors, distances);
+  const double lowRecall = KNN::Recall(neighbors, trueNeighbors);
+
+  hnsw.Ef() = 200;
+  hnsw.Search(qdata, k, neighbors, distances);
+  const double highRecall = KNN::Recall(neighbors, trueNeighbors);
+
+  REQUIRE(highRecall >= lowRecall);
+  REQUIRE(highRecall > 0.95);
+}
+
+/**
+ * Make sure that monochromatic search does not return a point as its own
+ * neighbor, and finds the true neighbors.
+ */
+TEST_CASE("HNSWMonochromaticTest", "[HNSWTest]")
+{
+  arma::mat rdata(8, 1000, arma::fill::randu);
+  const size_t k = 5;
+
+  KNN knn(rdata);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(k, trueNeighbors, trueDistances);
+
+  HNSWSearch<> hnsw(rdata);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(k, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == k);
+  REQUIRE(neighbors.n_cols == rdata.n_cols);
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+    for (size_t j = 0; j < k; ++j)
+      REQUIRE(neighbors(j, i) != i);
+
+  REQUIRE(KNN::Recall(neighbors, trueNeighbors) > 0.95);
+}
+
+/**
+ * Make sure that points inserted incrementally can be found, and that the
+ * graph satisfies its invariants.
+ */
+TEST_CASE("HNSWInsertTest", "[HNSWTest]")
+{
+  arma::mat rdata(10, 1500, arma::fill::randu);
+
+  HNSWSearch<> hnsw(8, 100, 50);
+  hnsw.Insert(rdata.cols(0, 499));
+  hnsw.Insert(rdata.cols(500, 999));
+  hnsw.Insert(rdata.cols(1000, 1499));
+
+  REQUIRE(hnsw.ReferenceSet().n_cols == rdata.n_cols);
+  CheckMatrices(hnsw.ReferenceSet(), rdata);
+
+  // Every link must be a valid, distinct point of the same layer, and no node
+  // may have more links than allowed.
+  for (size_t i = 0; i < rdata.n_cols; ++i)
+  {
+    REQUIRE(hnsw.Level(i) <= hnsw.MaxLevel());
+    for (size_t l = 0; l <= hnsw.Level(i); ++l)
+    {
+      const std::vector<size_t>& links = hnsw.Links(i, l);
+      REQUIRE(links.size() <= ((l == 0) ? 2 * hnsw.M() : hnsw.M()));
+      for (size_t j = 0; j < links.size(); ++j)
+      {
+        REQUIRE(links[j] != i);
+        REQUIRE(links[j] < rdata.n_cols);
+        REQUIRE(hnsw.Level(links[j]) >= l);
+      }
+    }
+
+    // Every node is linked in the bottom layer.
+    REQUIRE(hnsw.Links(i, 0).size() > 0);
+  }
+
+  // Each point is its own nearest neighbor.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(rdata, 1, neighbors, distances);
+
+  size_t found = 0;
+  for (size_t i = 0; i < rdata.n_cols; ++i)
+    if (neighbors(0, i) == i)
+      ++found;
+
+  REQUIRE(found >= 0.99 * rdata.n_cols);
+}
+
+/**
+ * Make sure that invalid searches throw.
+ */
+TEST_CASE("HNSWInvalidTest", "[HNSWTest]")
+{
+  arma::mat rdata(4, 50, arma::fill::randu);
+  HNSWSearch<> hnsw(rdata);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  REQUIRE_THROWS_AS(hnsw.Search(rdata, 51, neighbors, distances),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(hnsw.Search(50, neighbors, distances),
+      std::invalid_argument);
+
+  arma::mat qdata(3, 10, arma::fill::randu);
+  REQUIRE_THROWS_AS(hnsw.Search(qdata, 1, neighbors, distances),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(hnsw.Insert(qdata), std::invalid_argument);
+
+  REQUIRE_THROWS_AS(HNSWSearch<>(1), std::invalid_argument);
+}
+
+/**
+ * Make sure that a serialized HNSW model gives the same results.
+ */
+TEST_CASE("HNSWSerializationTest", "[HNSWTest]")
+{
+  arma::mat rdata(6, 500, arma::fill::randu);
+  arma::mat qdata(6, 50, arma::fill::randu);
+
+  HNSWSearch<> hnsw(rdata, 8, 50, 20);
+  HNSWSearch<> xmlHnsw, jsonHnsw, binaryHnsw;
+  SerializeObjectAll(hnsw, xmlHnsw, jsonHnsw, binaryHnsw);
+
+  arma::Mat<size_t> neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors;
+  arma::mat distances, xmlDistances, jsonDistances, binaryDistances;
+  hnsw.Search(qdata, 3, neighbors, distances);
+  xmlHnsw.Search(qdata, 3, xmlNeighbors, xmlDistances);
+  jsonHnsw.Search(qdata, 3, jsonNeighbors, jsonDistances);
+  binaryHnsw.Search(qdata, 3, binaryNeighbors, binaryDistances);
+
+  REQUIRE(xmlHnsw.Ef() == 20);
+  CheckMatrices(neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors);
+  CheckMatrices(distances, xmlDistances, jsonDistances, binaryDistances);
+
+  // A copy must also give the same results.
+  HNSWSearch<> copy(hnsw);
+  arma::Mat<size_t> copyNeighbors;
+  arma::mat copyDistances;
+  copy.Search(qdata, 3, copyNeighbors, copyDistances);
+  CheckMatrices(neighbors, copyNeighbors);
+  CheckMatrices(distances, copyDistances);
+}
+
+/**
+ * Make sure that NSModel can use an HNSW graph.
+ */
+TEST_CASE("HNSWNSModelTest", "[HNSWTest]")
+{
+  arma::mat rdata(10, 1000, arma::fill::randu);
+  arma::mat qdata(10, 100, arma::fill::randu);
+
+  KNN knn(rdata);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(qdata, 3, trueNeighbors, trueDistances);
+
+  NSModel<NearestNeighborSort> model(NSModel<NearestNeighborSort>::HNSW);
+  model.Ef() = 100;
+  util::Timers timers;
+  model.BuildModel(timers, arma::mat(rdata), DUAL_TREE_MODE);
+
+  REQUIRE(model.Dataset().n_cols == rdata.n_cols);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  model.Search(timers, arma::mat(qdata), 3, neighbors, distances);
+  REQUIRE(KNN::Recall(neighbors, trueNeighbors) > 0.9);
+}
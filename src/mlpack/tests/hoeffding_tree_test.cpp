@@ -1835,3 +1835,42 @@ TEST_CASE("HoeffdingTreeCategoricalFloatDataTest", "[HoeffdingTreeTest]")
   REQUIRE(accu(batchPredictions == labels) > (labels.n_elem / 2));
   REQUIRE(accu(streamPredictions == labels) > (labels.n_elem / 2));
 }
+
+/**
+ * Make sure that streaming training on a whole matrix (which trains the split
+ * statistics of a leaf in parallel) gives the same tree as training on each
+ * point in turn, and that batch classification matches single-point
+ * classification.
+ */
+TEST_CASE("HoeffdingTreeStreamingMatrixTrainTest", "[HoeffdingTreeTest]")
+{
+  // Ten numeric dimensions; the label is given by the first two.
+  arma::mat dataset(10, 20000, arma::fill::randu);
+  arma::Row<size_t> labels(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    labels[i] = (dataset(0, i) > 0.5 ? 1 : 0) + (dataset(1, i) > 0.5 ? 2 : 0);
+
+  data::DatasetInfo info(10);
+  HoeffdingTree<> matrixTree(info, 4, 0.95, 0, 500);
+  HoeffdingTree<> pointTree(info, 4, 0.95, 0, 500);
+
+  matrixTree.Train(dataset, labels, 4, false);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    pointTree.Train(dataset.col(i), labels[i]);
+
+  REQUIRE(matrixTree.NumSamples() == pointTree.NumSamples());
+  REQUIRE(matrixTree.NumDescendants() == pointTree.NumDescendants());
+  REQUIRE(matrixTree.NumDescendants() > 1);
+
+  arma::Row<size_t> matrixPredictions, pointPredictions;
+  arma::rowvec matrixProbabilities;
+  matrixTree.Classify(dataset, matrixPredictions, matrixProbabilities);
+  pointTree.Classify(dataset, pointPredictions);
+
+  REQUIRE(matrixPredictions.n_elem == dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    REQUIRE(matrixPredictions[i] == pointPredictions[i]);
+    REQUIRE(matrixPredictions[i] == pointTree.Classify(dataset.col(i)));
+  }
+}
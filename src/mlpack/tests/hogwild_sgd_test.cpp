@@ -0,0 +1,192 @@
+/**
+ * @file tests/hogwild_sgd_test.cpp
+ *
+ * Tests for HogwildSGD and the sparse separable gradients it uses.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/linear_svm.hpp>
+#include <mlpack/methods/logistic_regression.hpp>
+#include <mlpack/methods/regularized_svd.hpp>
+#include <mlpack/methods/softmax_regression.hpp>
+
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * Create a sparse, linearly separable two-class dataset: the label of each
+ * point is the sign of a random linear function of its nonzero features.
+ */
+inline void SparseSeparableDataset(arma::sp_mat& data,
+                                   arma::Row<size_t>& labels,
+                                   const size_t dimensionality = 200,
+                                   const size_t numPoints = 2000)
+{
+  data.sprandu(dimensionality, numPoints, 0.05);
+  const arma::rowvec w(dimensionality, arma::fill::randn);
+  const arma::rowvec scores = w * data;
+  labels = arma::conv_to<arma::Row<size_t>>::from(scores > 0);
+}
+
+/**
+ * With lambda = 0, the sparse separable gradients must match the dense ones.
+ */
+TEST_CASE("SparseSeparableGradientTest", "[HogwildSGDTest]")
+{
+  arma::sp_mat data;
+  arma::Row<size_t> labels;
+  SparseSeparableDataset(data, labels, 50, 200);
+
+  LogisticRegressionFunction<arma::sp_mat> lrf(data, labels, 0.0);
+  arma::rowvec lrParameters(51, arma::fill::randn);
+  arma::mat denseGradient;
+  arma::sp_mat sparseGradient;
+  lrf.Gradient(lrParameters, 10, denseGradient, 20);
+  lrf.Gradient(lrParameters, 10, sparseGradient, 20);
+  REQUIRE(arma::approx_equal(denseGradient, arma::mat(sparseGradient),
+      "absdiff", 1e-8));
+
+  LinearSVMFunction<arma::sp_mat> svmf(data, labels, 2, 0.0, 1.0, true);
+  arma::mat svmParameters(51, 2, arma::fill::randn);
+  svmf.Gradient(svmParameters, 10, denseGradient, 20);
+  svmf.Gradient(svmParameters, 10, sparseGradient, 20);
+  REQUIRE(arma::approx_equal(denseGradient, arma::mat(sparseGradient),
+      "absdiff", 1e-8));
+
+  SoftmaxRegressionFunction<arma::sp_mat> srf(data, labels, 2, 0.0, true);
+  arma::mat srParameters(2, 51, arma::fill::randn);
+  srf.Gradient(srParameters, 10, denseGradient, 20);
+  srf.Gradient(srParameters, 10, sparseGradient, 20);
+  REQUIRE(arma::approx_equal(denseGradient, arma::mat(sparseGradient),
+      "absdiff", 1e-8));
+
+  // The sparse gradient of the features that no point of the batch has is
+  // zero, even with regularization.
+  LogisticRegressionFunction<arma::sp_mat> lrfReg(data, labels, 0.5);
+  lrfReg.Gradient(lrParameters, 10, sparseGradient, 1);
+  REQUIRE(sparseGradient.n_nonzero <= data.col(10).n_nonzero + 1);
+}
+
+/**
+ * The sparse gradient of RegularizedSVDFunction must match the dense one.
+ */
+TEST_CASE("RegularizedSVDSparseGradientTest", "[HogwildSGDTest]")
+{
+  const size_t numUsers = 30;
+  const size_t numItems = 40;
+  const size_t rank = 5;
+
+  arma::mat data = arma::randu(3, 300);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+  data.row(2) = floor(data.row(2) * 5 + 0.5);
+  data(0, 299) = numUsers - 1;
+  data(1, 299) = numItems - 1;
+
+  RegularizedSVDFunction<arma::mat> f(data, rank, 0.1);
+  const arma::mat parameters = arma::randu(rank, numUsers + numItems);
+
+  arma::mat denseGradient;
+  arma::sp_mat sparseGradient;
+  f.Gradient(parameters, 50, denseGradient, 40);
+  f.Gradient(parameters, 50, sparseGradient, 40);
+  REQUIRE(arma::approx_equal(denseGradient, arma::mat(sparseGradient),
+      "absdiff", 1e-10));
+}
+
+/**
+ * Train logistic regression with HogwildSGD on sparse data, and make sure the
+ * model fits the data and the objective decreases.
+ */
+TEST_CASE("HogwildSGDLogisticRegressionTest", "[HogwildSGDTest]")
+{
+  arma::sp_mat data;
+  arma::Row<size_t> labels;
+  SparseSeparableDataset(data, labels);
+
+  LogisticRegressionFunction<arma::sp_mat> lrf(data, labels, 0.0);
+  arma::rowvec parameters(data.n_rows + 1, arma::fill::zeros);
+  const double initialObjective = lrf.Evaluate(parameters);
+
+  HogwildSGD hogwild(0.5, 8, 30, 1e-8);
+  LogisticRegression<arma::sp_mat> lr(data.n_rows, 0.0);
+  const double objective = lr.Train(data, labels, hogwild);
+  REQUIRE(objective < initialObjective);
+
+  const double acc = lr.ComputeAccuracy(data, labels);
+  REQUIRE(acc > 90.0);
+}
+
+/**
+ * Train softmax regression and a linear SVM with HogwildSGD on sparse data.
+ */
+TEST_CASE("HogwildSGDSoftmaxRegressionLinearSVMTest", "[HogwildSGDTest]")
+{
+  arma::sp_mat data;
+  arma::Row<size_t> labels;
+  SparseSeparableDataset(data, labels);
+
+  HogwildSGD hogwild(0.5, 8, 30, 1e-8);
+
+  SoftmaxRegression<arma::sp_mat> sr;
+  sr.Train(data, labels, 2, hogwild, 0.0);
+  REQUIRE(sr.ComputeAccuracy(data, labels) > 90.0);
+
+  LinearSVM<arma::mat> svm;
+  svm.Train(data, labels, 2, hogwild, 0.0);
+  REQUIRE(svm.ComputeAccuracy(data, labels) > 90.0);
+}
+
+/**
+ * With dense gradients (dense data), HogwildSGD should minimize a simple
+ * problem too.
+ */
+TEST_CASE("HogwildSGDDenseTest", "[HogwildSGDTest]")
+{
+  GaussianDistribution<> g1(arma::vec("1.0 1.0 1.0"),
+      arma::eye<arma::mat>(3, 3));
+  GaussianDistribution<> g2(arma::vec("9.0 9.0 9.0"),
+      arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, 1000);
+  arma::Row<size_t> responses(1000);
+  for (size_t i = 0; i < 500; ++i)
+  {
+    data.col(i) = g1.Random();
+    responses[i] = 0;
+  }
+  for (size_t i = 500; i < 1000; ++i)
+  {
+    data.col(i) = g2.Random();
+    responses[i] = 1;
+  }
+
+  HogwildSGD hogwild(0.01, 16, 20);
+  LogisticRegression<> lr(data.n_rows, 0.5);
+  lr.Train(data, responses, hogwild);
+
+  const double acc = lr.ComputeAccuracy(data, responses);
+  REQUIRE(acc == Approx(100.0).epsilon(0.003)); // 0.3% error tolerance.
+}
+
+/**
+ * A batch size of 0 is invalid.
+ */
+TEST_CASE("HogwildSGDInvalidBatchSizeTest", "[HogwildSGDTest]")
+{
+  arma::sp_mat data;
+  arma::Row<size_t> labels;
+  SparseSeparableDataset(data, labels, 20, 100);
+
+  LogisticRegressionFunction<arma::sp_mat> lrf(data, labels, 0.0);
+  arma::rowvec parameters(21, arma::fill::zeros);
+
+  HogwildSGD hogwild(0.1, 0);
+  REQUIRE_THROWS_AS(hogwild.Optimize(lrf, parameters), std::invalid_argument);
+}
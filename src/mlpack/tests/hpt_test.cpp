@@ -11,6 +11,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/lars.hpp>
+#include <mlpack/methods/linear_regression.hpp>
 #include <mlpack/methods/logistic_regression.hpp>
 
 #include "catch.hpp"
@@ -315,6 +316,77 @@ TEST_CASE("HPTTest", "[HPTTest]")
   REQUIRE(expectedObjective == Approx(objective).epsilon(1e-7));
 }
 
+/**
+ * Test HyperParameterTuner finds the same parameters and model when the grid
+ * is searched in parallel.
+ */
+TEST_CASE("HPTParallelGridSearchTest", "[HPTTest]")
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  arma::vec lambda2Set("0.0 0.05 0.5 5.0");
+
+  double expectedLambda1, expectedLambda2, expectedObjective;
+  FindLARSBestLambdas(xs, ys, validationSize, transposeData, useCholesky,
+      lambda1Set, lambda2Set, expectedLambda1, expectedLambda2,
+      expectedObjective);
+
+  double actualLambda1, actualLambda2;
+  HyperParameterTuner<LARS<>, MSE, SimpleCV, GridSearch>
+      hpt(validationSize, xs, ys);
+  hpt.NumThreads() = 4;
+  std::tie(actualLambda1, actualLambda2) = hpt.Optimize(Fixed(transposeData),
+      Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  REQUIRE(expectedObjective == Approx(hpt.BestObjective()).epsilon(1e-7));
+  REQUIRE(expectedLambda1 == Approx(actualLambda1).epsilon(1e-7));
+  REQUIRE(expectedLambda2 == Approx(actualLambda2).epsilon(1e-7));
+
+  size_t validationFirstColumn = round(xs.n_cols * (1.0 - validationSize));
+  arma::mat validationXs = xs.cols(validationFirstColumn, xs.n_cols - 1);
+  arma::rowvec validationYs = ys.cols(validationFirstColumn, ys.n_cols - 1);
+  double objective = MSE::Evaluate(hpt.BestModel(), validationXs, validationYs);
+  REQUIRE(expectedObjective == Approx(objective).epsilon(1e-7));
+}
+
+/**
+ * Test HyperParameterTuner with successive halving returns a point of the grid
+ * whose objective (with all the training data) is the best objective, and that
+ * is not worse than the points evaluated in the first round.
+ */
+TEST_CASE("HPTSuccessiveHalvingTest", "[HPTTest]")
+{
+  arma::mat xs = arma::randn(5, 200);
+  arma::vec beta = arma::randn(5, 1);
+  arma::rowvec ys = beta.t() * xs + 0.1 * arma::randn(1, 200);
+
+  arma::vec lambdaSet("0.0 0.01 0.1 1.0 10.0 100.0 1000.0 10000.0 100000.0");
+
+  HyperParameterTuner<LinearRegression<>, MSE, KFoldCV, GridSearch>
+      hpt(4, xs, ys, false);
+  hpt.NumThreads() = 2;
+  hpt.HalvingRate() = 3;
+
+  double actualLambda;
+  std::tie(actualLambda) = hpt.Optimize(lambdaSet);
+
+  KFoldCV<LinearRegression<>, MSE> cv(4, xs, ys, false);
+  REQUIRE(arma::any(arma::abs(lambdaSet - actualLambda) < 1e-10));
+  REQUIRE(hpt.BestObjective() ==
+      Approx(cv.Evaluate(actualLambda)).epsilon(1e-7));
+
+  // Large regularization is much worse on this data, so it must have been
+  // eliminated.
+  REQUIRE(actualLambda <= 10.0);
+  REQUIRE(hpt.BestObjective() < cv.Evaluate(100000.0));
+}
+
 /**
  * Test HyperParamterTuner maximizes Accuracy rather than minimizes it.
  */
@@ -152,4 +152,125 @@ TEST_CASE("ImageInfoSerialization", "[ImageLoadTest]")
   REQUIRE(info.Quality() == binaryInfo.Quality());
 }
 
+/**
+ * Without shuffling or augmentation, the batches of an ImageBatchLoader must
+ * hold the same images as data::Load(), in order, with their responses.
+ */
+TEST_CASE("ImageBatchLoaderTest", "[ImageLoadTest]")
+{
+  std::vector<std::string> files(7, "test_image.png");
+  arma::mat responses = arma::regspace<arma::rowvec>(0, 6);
+
+  arma::mat image;
+  data::ImageInfo info;
+  REQUIRE(data::Load("test_image.png", image, info, false) == true);
+
+  data::ImageBatchLoader<double> loader(files, responses, data::ImageInfo(),
+      3, false, 2, 1);
+  REQUIRE(loader.NumBatches() == 3);
+  REQUIRE(loader.Dimensionality() == 50 * 50 * 3);
+
+  // Two epochs, to make sure Reset() works.
+  for (size_t epoch = 0; epoch < 2; ++epoch)
+  {
+    arma::mat predictorsBatch, responsesBatch;
+    size_t points = 0;
+    while (loader.Next(predictorsBatch, responsesBatch))
+    {
+      REQUIRE(predictorsBatch.n_rows == image.n_rows);
+      REQUIRE(responsesBatch.n_cols == predictorsBatch.n_cols);
+      for (size_t i = 0; i < predictorsBatch.n_cols; ++i)
+      {
+        REQUIRE(responsesBatch(0, i) == points + i);
+        REQUIRE(arma::approx_equal(predictorsBatch.col(i), image, "absdiff",
+            1e-10));
+      }
+
+      points += predictorsBatch.n_cols;
+    }
+
+    REQUIRE(points == 7);
+    REQUIRE(predictorsBatch.n_elem == 0);
+    loader.Reset();
+  }
+}
+
+/**
+ * Make sure that resizing, cropping and flipping give images of the right
+ * size, and that flipping twice gives the original image.
+ */
+TEST_CASE("ImageBatchLoaderAugmentationTest", "[ImageLoadTest]")
+{
+  std::vector<std::string> files(4, "test_image.png");
+  arma::mat responses(1, 4, arma::fill::zeros);
+
+  arma::mat image;
+  data::ImageInfo info;
+  REQUIRE(data::Load("test_image.png", image, info, false) == true);
+
+  // Flip every image; the original size is kept.
+  data::ImageBatchLoader<double> flipLoader(files, responses,
+      data::ImageInfo(), 4, true);
+  flipLoader.FlipProbability() = 1.0;
+  arma::mat flipped, flippedResponses;
+  REQUIRE(flipLoader.Next(flipped, flippedResponses));
+  for (size_t y = 0; y < 50; ++y)
+  {
+    for (size_t x = 0; x < 50; ++x)
+    {
+      for (size_t c = 0; c < 3; ++c)
+      {
+        REQUIRE(flipped((y * 50 + x) * 3 + c, 0) ==
+            Approx(image((y * 50 + (49 - x)) * 3 + c)).epsilon(1e-10));
+      }
+    }
+  }
+
+  // Resize to 25 x 20, then crop 16 x 16, and scale values into [0, 1].
+  data::ImageBatchLoader<float> loader(files, responses,
+      data::ImageInfo(25, 20, 3), 3, true, 3);
+  loader.CropWidth() = 16;
+  loader.CropHeight() = 16;
+  loader.Scale() = 1.0 / 255.0;
+  loader.Reset();
+  REQUIRE(loader.OutputInfo().Width() == 16);
+  REQUIRE(loader.OutputInfo().Height() == 16);
+
+  arma::fmat predictorsBatch, responsesBatch;
+  REQUIRE(loader.Next(predictorsBatch, responsesBatch));
+  REQUIRE(predictorsBatch.n_rows == 16 * 16 * 3);
+  REQUIRE(predictorsBatch.n_cols == 3);
+  REQUIRE(predictorsBatch.max() <= 1.0f);
+  REQUIRE(predictorsBatch.min() >= 0.0f);
+  REQUIRE(loader.Next(predictorsBatch, responsesBatch));
+  REQUIRE(predictorsBatch.n_cols == 1);
+  REQUIRE(!loader.Next(predictorsBatch, responsesBatch));
+
+  // Crops larger than the images are invalid.
+  loader.CropWidth() = 30;
+  loader.Reset();
+  REQUIRE_THROWS_AS(loader.Next(predictorsBatch, responsesBatch),
+      std::invalid_argument);
+}
+
+/**
+ * A file that cannot be decoded must give an exception when its batch is
+ * returned.
+ */
+TEST_CASE("ImageBatchLoaderInvalidFileTest", "[ImageLoadTest]")
+{
+  std::vector<std::string> files = { "test_image.png", "nonexistent.png" };
+  arma::mat responses(1, 2, arma::fill::zeros);
+
+  data::ImageBatchLoader<double> loader(files, responses, data::ImageInfo(),
+      1, false);
+  arma::mat predictorsBatch, responsesBatch;
+  REQUIRE(loader.Next(predictorsBatch, responsesBatch));
+  REQUIRE_THROWS_AS(loader.Next(predictorsBatch, responsesBatch),
+      std::runtime_error);
+
+  REQUIRE_THROWS_AS(data::ImageBatchLoader<double>(files,
+      arma::mat(1, 3), data::ImageInfo()), std::invalid_argument);
+}
+
 #endif // MLPACK_HAS_STB.
@@ -304,3 +304,63 @@ TEST_CASE("DatasetMapperPointerMapping", "[ImputationTest]")
   REQUIRE(dm.UnmapString(1, 0) == &b);
   REQUIRE(dm.UnmapString(2, 0) == &c);
 }
+
+/**
+ * Imputing several dimensions at once must give the same result as imputing
+ * each dimension in turn, for every imputation method.
+ */
+template<typename StrategyType>
+void CheckBatchImputation(StrategyType& strategy)
+{
+  // Enough points for the column-major search to use several blocks.
+  arma::mat input = arma::floor(10 * arma::randu<arma::mat>(20, 3000));
+  input.elem(arma::find(arma::randu<arma::mat>(20, 3000) < 0.02)).fill(
+      arma::datum::nan);
+  const std::vector<size_t> dimensions = { 0, 3, 7, 19 };
+  const std::vector<double> mappedValues(dimensions.size(), 0.0);
+
+  for (const bool columnMajor : { true, false })
+  {
+    arma::mat batchInput = columnMajor ? input : arma::mat(input.t());
+    arma::mat sequentialInput(batchInput);
+
+    strategy.Impute(batchInput, mappedValues, dimensions, columnMajor);
+    for (size_t i = 0; i < dimensions.size(); ++i)
+    {
+      strategy.Impute(sequentialInput, mappedValues[i], dimensions[i],
+          columnMajor);
+    }
+
+    REQUIRE(batchInput.n_rows == sequentialInput.n_rows);
+    REQUIRE(batchInput.n_cols == sequentialInput.n_cols);
+    // The other dimensions still have their missing values.
+    REQUIRE(arma::approx_equal(batchInput.replace(arma::datum::nan, -1.0),
+        sequentialInput.replace(arma::datum::nan, -1.0), "absdiff", 1e-10));
+  }
+}
+
+TEST_CASE("BatchImputationTest", "[ImputationTest]")
+{
+  MeanImputation<double> mean;
+  CheckBatchImputation(mean);
+  MedianImputation<double> median;
+  CheckBatchImputation(median);
+  CustomImputation<double> custom(99.0);
+  CheckBatchImputation(custom);
+  ListwiseDeletion<double> listwise;
+  CheckBatchImputation(listwise);
+
+  // The median is the average of the two middle values for an even number of
+  // valid values.
+  arma::mat input("1.0 0.0 4.0 2.0 9.0;"
+                  "0.0 3.0 1.0 5.0 0.0");
+  median.Impute(input, std::vector<double>({ 0.0, 0.0 }), { 0, 1 }, true);
+  REQUIRE(input(0, 1) == Approx(3.0).epsilon(1e-7));
+  REQUIRE(input(1, 0) == Approx(3.0).epsilon(1e-7));
+  REQUIRE(input(1, 4) == Approx(3.0).epsilon(1e-7));
+
+  REQUIRE_THROWS_AS(median.Impute(input, std::vector<double>({ 0.0 }),
+      { 0, 1 }, true), std::invalid_argument);
+  REQUIRE_THROWS_AS(median.Impute(input, std::vector<double>({ 0.0 }),
+      { 2 }, true), std::invalid_argument);
+}
@@ -0,0 +1,184 @@
+/**
+ * @file tests/inverted_index_test.cpp
+ *
+ * Unit tests for the 'InvertedIndexSearch' class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+#include "serialization.hpp"
+
+#include <mlpack/methods/inverted_index.hpp>
+#include <mlpack/methods/neighbor_search.hpp>
+#include <mlpack/methods/neighbor_search/ns_model.hpp>
+
+using namespace std;
+using namespace mlpack;
+
+/**
+ * Compute the k best similarities of each query by brute force, and check
+ * that the given results have the same similarities, and that the similarity
+ * of each returned neighbor is correct.
+ */
+void CheckSimilarities(const arma::sp_mat& references,
+                       const arma::sp_mat& queries,
+                       const bool cosine,
+                       const arma::Mat<size_t>& neighbors,
+                       const arma::mat& similarities,
+                       const bool sameSet = false)
+{
+  arma::mat r(references), q(queries);
+  if (cosine)
+  {
+    r = arma::normalise(r, 2, 0);
+    q = arma::normalise(q, 2, 0);
+  }
+  arma::mat allSimilarities = r.t() * q;
+  if (sameSet)
+    allSimilarities.diag().fill(-DBL_MAX);
+
+  for (size_t i = 0; i < q.n_cols; ++i)
+  {
+    const arma::vec sorted = arma::sort(allSimilarities.col(i), "descend");
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+    {
+      REQUIRE(neighbors(j, i) < r.n_cols);
+      if (sameSet)
+        REQUIRE(neighbors(j, i) != i);
+      REQUIRE(similarities(j, i) ==
+          Approx(sorted[j]).epsilon(1e-7).margin(1e-10));
+      REQUIRE(similarities(j, i) == Approx(allSimilarities(neighbors(j, i),
+          i)).epsilon(1e-7).margin(1e-10));
+    }
+  }
+}
+
+/**
+ * Make sure that cosine and inner-product search are exact on nonnegative
+ * sparse data, and that the traversal skips most of the points.
+ */
+TEST_CASE("InvertedIndexExactTest", "[InvertedIndexTest]")
+{
+  arma::sp_mat references, queries;
+  references.sprandu(500, 2000, 0.01);
+  queries.sprandu(500, 50, 0.02);
+
+  for (const bool cosine : { true, false })
+  {
+    InvertedIndexSearch<> index(references, cosine);
+    arma::Mat<size_t> neighbors;
+    arma::mat similarities;
+    index.Search(queries, 5, neighbors, similarities);
+
+    REQUIRE(neighbors.n_rows == 5);
+    REQUIRE(neighbors.n_cols == queries.n_cols);
+    CheckSimilarities(references, queries, cosine, neighbors, similarities);
+    REQUIRE(index.Evaluations() < references.n_cols * queries.n_cols);
+  }
+}
+
+/**
+ * Make sure that negative values are handled: points that share no dimension
+ * with a query (similarity 0) beat points with a negative similarity.
+ */
+TEST_CASE("InvertedIndexNegativeTest", "[InvertedIndexTest]")
+{
+  arma::sp_mat references;
+  references.sprandn(100, 300, 0.02);
+  arma::sp_mat queries;
+  queries.sprandn(100, 30, 0.05);
+
+  InvertedIndexSearch<> index(references, false);
+  arma::Mat<size_t> neighbors;
+  arma::mat similarities;
+  index.Search(queries, 20, neighbors, similarities);
+
+  CheckSimilarities(references, queries, false, neighbors, similarities);
+}
+
+/**
+ * Make sure that monochromatic search does not return a point as its own
+ * neighbor.
+ */
+TEST_CASE("InvertedIndexMonochromaticTest", "[InvertedIndexTest]")
+{
+  arma::sp_mat references;
+  references.sprandu(200, 400, 0.03);
+
+  InvertedIndexSearch<> index(references);
+  arma::Mat<size_t> neighbors;
+  arma::mat similarities;
+  index.Search(3, neighbors, similarities);
+
+  CheckSimilarities(references, references, true, neighbors, similarities,
+      true);
+
+  REQUIRE_THROWS_AS(index.Search(400, neighbors, similarities),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(index.Search(references, 401, neighbors, similarities),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that NSModel can search sparse and dense data with the inverted
+ * index, that it returns cosine distances, and that it can be serialized.
+ */
+TEST_CASE("InvertedIndexNSModelTest", "[InvertedIndexTest]")
+{
+  arma::sp_mat references, queries;
+  references.sprandu(300, 1000, 0.02);
+  queries.sprandu(300, 20, 0.05);
+
+  InvertedIndexSearch<> index(references);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueSimilarities;
+  index.Search(queries, 4, trueNeighbors, trueSimilarities);
+
+  using ModelType = NSModel<NearestNeighborSort>;
+  ModelType model(ModelType::INVERTED_INDEX);
+  util::Timers timers;
+  model.BuildModel(timers, arma::sp_mat(references), DUAL_TREE_MODE);
+  REQUIRE(model.TreeName() == "inverted index");
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  model.Search(timers, queries, 4, neighbors, distances);
+  REQUIRE(arma::all(arma::vectorise(neighbors == trueNeighbors)));
+  for (size_t i = 0; i < distances.n_elem; ++i)
+  {
+    REQUIRE(distances[i] ==
+        Approx(1.0 - trueSimilarities[i]).epsilon(1e-7).margin(1e-10));
+  }
+
+  // A dense reference set gives the same results.
+  ModelType denseModel(ModelType::INVERTED_INDEX);
+  denseModel.BuildModel(timers, arma::mat(references), DUAL_TREE_MODE);
+  REQUIRE(denseModel.Dataset().n_cols == references.n_cols);
+  arma::Mat<size_t> denseNeighbors;
+  arma::mat denseDistances;
+  denseModel.Search(timers, arma::mat(queries), 4, denseNeighbors,
+      denseDistances);
+  REQUIRE(arma::all(arma::vectorise(denseNeighbors == trueNeighbors)));
+
+  // Sparse data is rejected by the other tree types.
+  ModelType kdModel(ModelType::KD_TREE);
+  REQUIRE_THROWS_AS(kdModel.BuildModel(timers, arma::sp_mat(references),
+      DUAL_TREE_MODE), std::invalid_argument);
+
+  ModelType xmlModel, jsonModel, binaryModel;
+  SerializeObjectAll(model, xmlModel, jsonModel, binaryModel);
+
+  arma::Mat<size_t> xmlNeighbors, jsonNeighbors, binaryNeighbors;
+  arma::mat xmlDistances, jsonDistances, binaryDistances;
+  xmlModel.Search(timers, queries, 4, xmlNeighbors, xmlDistances);
+  jsonModel.Search(timers, queries, 4, jsonNeighbors, jsonDistances);
+  binaryModel.Search(timers, queries, 4, binaryNeighbors, binaryDistances);
+
+  CheckMatrices(neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors);
+  CheckMatrices(distances, xmlDistances, jsonDistances, binaryDistances);
+}
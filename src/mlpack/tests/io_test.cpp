@@ -1252,3 +1252,31 @@ TEST_CASE("CppNameTest", "[IOTest]")
   REQUIRE(p.Parameters().at("help").cppType == "bool");
   REQUIRE(p.Parameters().at("double").cppType == "double");
 }
+
+/**
+ * Make sure that looking up parameters (and their aliases) does not insert
+ * anything in the maps of the Params object.
+ */
+TEST_CASE("ParamLookupDoesNotInsertTest", "[IOTest]")
+{
+  AddRequiredCLIOptions("ParamLookupDoesNotInsertTest");
+
+  #define BINDING_NAME ParamLookupDoesNotInsertTest
+  PARAM_INT_IN("int", "Test int", "i", 5);
+  #undef BINDING_NAME
+
+  util::Params p = IO::Parameters("ParamLookupDoesNotInsertTest");
+  const size_t numParameters = p.Parameters().size();
+  const size_t numTypes = p.functionMap.size();
+
+  REQUIRE(p.Get<int>("int") == 5);
+  REQUIRE(p.Get<int>("i") == 5);
+  REQUIRE(!p.Has("i"));
+  REQUIRE_THROWS_AS(p.Get<int>("unknown"), runtime_error);
+  REQUIRE_THROWS_AS(p.Get<double>("int"), runtime_error);
+  REQUIRE_THROWS_AS(p.Has("x"), runtime_error);
+
+  REQUIRE(p.Parameters().size() == numParameters);
+  REQUIRE(p.Parameters().count("unknown") == 0);
+  REQUIRE(p.functionMap.size() == numTypes);
+}
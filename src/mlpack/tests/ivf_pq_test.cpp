@@ -0,0 +1,220 @@
+/**
+ * @file tests/ivf_pq_test.cpp
+ *
+ * Unit tests for the 'IVFPQSearch' class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+#include "serialization.hpp"
+
+#include <mlpack/methods/ivf_pq.hpp>
+#include <mlpack/methods/neighbor_search.hpp>
+
+using namespace std;
+using namespace mlpack;
+
+/**
+ * Generate a dataset of Gaussian clusters.
+ */
+void GetClusteredData(const size_t dims,
+                      const size_t numClusters,
+                      const size_t pointsPerCluster,
+                      arma::mat& data)
+{
+  arma::mat centers(dims, numClusters, arma::fill::randu);
+  centers *= 10.0;
+
+  data.set_size(dims, numClusters * pointsPerCluster);
+  for (size_t c = 0; c < numClusters; ++c)
+  {
+    for (size_t i = 0; i < pointsPerCluster; ++i)
+    {
+      data.col(c * pointsPerCluster + i) = centers.col(c) +
+          arma::randn<arma::vec>(dims);
+    }
+  }
+}
+
+/**
+ * Make sure that every point is stored exactly once, with a valid code.
+ */
+TEST_CASE("IVFPQEncodingTest", "[IVFPQTest]")
+{
+  arma::mat data;
+  GetClusteredData(8, 10, 100, data);
+
+  IVFPQSearch<> ivfpq(data, 10, 4, 32);
+
+  REQUIRE(ivfpq.NumPoints() == data.n_cols);
+  REQUIRE(ivfpq.Centroids().n_rows == 8);
+  REQUIRE(ivfpq.Centroids().n_cols == 10);
+  REQUIRE(ivfpq.Codebooks().n_rows == 8);
+  REQUIRE(ivfpq.Codebooks().n_cols == 32);
+  REQUIRE(ivfpq.ReferenceSet().n_elem == 0);
+
+  arma::Col<size_t> seen(data.n_cols, arma::fill::zeros);
+  for (size_t l = 0; l < ivfpq.NumLists(); ++l)
+  {
+    const arma::Col<size_t>& indices = ivfpq.ListIndices(l);
+    const arma::Mat<arma::u8>& codes = ivfpq.ListCodes(l);
+    REQUIRE(codes.n_rows == 4);
+    REQUIRE(codes.n_cols == indices.n_elem);
+
+    for (size_t i = 0; i < indices.n_elem; ++i)
+    {
+      REQUIRE(indices[i] < data.n_cols);
+      ++seen[indices[i]];
+      for (size_t m = 0; m < codes.n_rows; ++m)
+        REQUIRE(codes(m, i) < 32);
+    }
+  }
+
+  for (size_t i = 0; i < seen.n_elem; ++i)
+    REQUIRE(seen[i] == 1);
+}
+
+/**
+ * Make sure that IVF-PQ finds most of the true nearest neighbors, and that
+ * re-ranking improves the results.
+ */
+TEST_CASE("IVFPQRecallTest", "[IVFPQTest]")
+{
+  arma::mat data;
+  GetClusteredData(16, 20, 200, data);
+  arma::mat queries;
+  GetClusteredData(16, 20, 5, queries);
+  const size_t k = 10;
+
+  KNN knn(data);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(queries, k, trueNeighbors, trueDistances);
+
+  IVFPQSearch<> ivfpq(data, 20, 8, 64, 4, true);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  ivfpq.Search(queries, k, neighbors, distances);
+  const double pqRecall = KNN::Recall(neighbors, trueNeighbors);
+
+  ivfpq.Rerank() = 200;
+  ivfpq.Search(queries, k, neighbors, distances);
+  const double rerankRecall = KNN::Recall(neighbors, trueNeighbors);
+
+  REQUIRE(pqRecall > 0.3);
+  REQUIRE(rerankRecall > 0.9);
+  REQUIRE(rerankRecall >= pqRecall);
+
+  // The re-ranked distances are exact and sorted.
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(distances(j, i) == Approx(EuclideanDistance::Evaluate(
+          queries.col(i), data.col(neighbors(j, i)))).epsilon(1e-7));
+      if (j > 0)
+        REQUIRE(distances(j - 1, i) <= distances(j, i));
+    }
+  }
+}
+
+/**
+ * Make sure that points can be added after training on a sample.
+ */
+TEST_CASE("IVFPQAddTest", "[IVFPQTest]")
+{
+  arma::mat data;
+  GetClusteredData(6, 5, 200, data);
+
+  IVFPQSearch<> ivfpq(5, 3, 16, 5, true);
+  ivfpq.Train(data.cols(0, 299));
+  REQUIRE(ivfpq.NumPoints() == 0);
+
+  ivfpq.Add(data.cols(0, 499));
+  ivfpq.Add(data.cols(500, 999));
+  REQUIRE(ivfpq.NumPoints() == data.n_cols);
+  CheckMatrices(ivfpq.ReferenceSet(), data);
+
+  // With every list probed and exact re-ranking, each point is its own
+  // nearest neighbor.
+  ivfpq.Rerank() = 50;
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  ivfpq.Search(data, 1, neighbors, distances);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    REQUIRE(distances(0, i) == Approx(0.0).margin(1e-10));
+}
+
+/**
+ * Make sure that invalid parameters are rejected.
+ */
+TEST_CASE("IVFPQInvalidTest", "[IVFPQTest]")
+{
+  arma::mat data(6, 100, arma::fill::randu);
+
+  // 4 subspaces do not divide 6 dimensions.
+  REQUIRE_THROWS_AS(IVFPQSearch<>(data, 4, 4, 16), std::invalid_argument);
+  // Too many codewords.
+  REQUIRE_THROWS_AS(IVFPQSearch<>(4, 3, 512), std::invalid_argument);
+  // Not enough points to train.
+  REQUIRE_THROWS_AS(IVFPQSearch<>(data, 200, 3, 16), std::invalid_argument);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+
+  // Untrained index.
+  IVFPQSearch<> untrained(4, 3, 16);
+  REQUIRE_THROWS_AS(untrained.Search(data, 1, neighbors, distances),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(untrained.Add(data), std::invalid_argument);
+
+  IVFPQSearch<> ivfpq(data, 4, 3, 16);
+  REQUIRE_THROWS_AS(ivfpq.Search(data, 101, neighbors, distances),
+      std::invalid_argument);
+
+  arma::mat wrongData(5, 10, arma::fill::randu);
+  REQUIRE_THROWS_AS(ivfpq.Search(wrongData, 1, neighbors, distances),
+      std::invalid_argument);
+
+  // Re-ranking requires the reference set.
+  ivfpq.Rerank() = 10;
+  REQUIRE_THROWS_AS(ivfpq.Search(data, 1, neighbors, distances),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that a serialized index gives the same results.
+ */
+TEST_CASE("IVFPQSerializationTest", "[IVFPQTest]")
+{
+  arma::mat data;
+  GetClusteredData(8, 8, 50, data);
+  arma::mat queries(8, 20, arma::fill::randu);
+  queries *= 10.0;
+
+  IVFPQSearch<> ivfpq(data, 8, 4, 16, 2, true);
+  ivfpq.Rerank() = 20;
+
+  IVFPQSearch<> xmlIvfpq, jsonIvfpq, binaryIvfpq;
+  SerializeObjectAll(ivfpq, xmlIvfpq, jsonIvfpq, binaryIvfpq);
+
+  REQUIRE(xmlIvfpq.NumPoints() == ivfpq.NumPoints());
+  REQUIRE(jsonIvfpq.NumProbes() == 2);
+  REQUIRE(binaryIvfpq.Rerank() == 20);
+
+  arma::Mat<size_t> neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors;
+  arma::mat distances, xmlDistances, jsonDistances, binaryDistances;
+  ivfpq.Search(queries, 5, neighbors, distances);
+  xmlIvfpq.Search(queries, 5, xmlNeighbors, xmlDistances);
+  jsonIvfpq.Search(queries, 5, jsonNeighbors, jsonDistances);
+  binaryIvfpq.Search(queries, 5, binaryNeighbors, binaryDistances);
+
+  CheckMatrices(neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors);
+  CheckMatrices(distances, xmlDistances, jsonDistances, binaryDistances);
+}
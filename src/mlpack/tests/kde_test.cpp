@@ -1228,3 +1228,200 @@ TEST_CASE("GaussianBreadthDualKDTreeMonteCarloKDE", "[KDETest]")
 
   REQUIRE(correctResults > 70);
 }
+
+/**
+ * Make sure the error guarantees still hold when the query set is large enough
+ * for the evaluation to be split between many query subtrees (and threads, if
+ * OpenMP is enabled), in every mode, for both bichromatic and monochromatic
+ * evaluation.
+ */
+TEST_CASE("LargeQuerySetKDEBruteForceTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(3, 1500);
+  arma::mat query = arma::randu(3, 2500);
+  const double relError = 0.05;
+
+  GaussianKernel kernel(0.2);
+  arma::vec bfEstimations(query.n_cols, arma::fill::zeros);
+  BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+  arma::vec bfMonoEstimations(reference.n_cols, arma::fill::zeros);
+  BruteForceKDE<GaussianKernel>(reference, reference, bfMonoEstimations,
+      kernel);
+
+  for (const KDEMode mode : { KDE_DUAL_TREE_MODE, KDE_SINGLE_TREE_MODE })
+  {
+    KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree> kde(relError,
+        0.0, kernel, mode);
+    kde.Train(reference);
+
+    arma::vec treeEstimations;
+    kde.Evaluate(query, treeEstimations);
+    REQUIRE(treeEstimations.n_elem == query.n_cols);
+    for (size_t i = 0; i < query.n_cols; ++i)
+      REQUIRE(treeEstimations[i] == Approx(bfEstimations[i]).epsilon(relError));
+
+    // In monochromatic mode, each point's own contribution is not counted.
+    kde.Evaluate(treeEstimations);
+    REQUIRE(treeEstimations.n_elem == reference.n_cols);
+    for (size_t i = 0; i < reference.n_cols; ++i)
+    {
+      const double expected = bfMonoEstimations[i] -
+          kernel.Evaluate(0.0) / reference.n_cols;
+      REQUIRE(treeEstimations[i] == Approx(expected).epsilon(relError));
+    }
+  }
+}
+
+/**
+ * Test that the IFGT mode is within the error tolerance of brute force, both
+ * when the expansions are used and when they are not worth it.
+ */
+TEST_CASE("IFGTKDEBruteForceTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 2000);
+  arma::mat query = arma::randu(2, 1000);
+  const double relError = 0.01;
+
+  for (const double bandwidth : { 1.5, 0.01 })
+  {
+    GaussianKernel kernel(bandwidth);
+    arma::vec bfEstimations(query.n_cols, arma::fill::zeros);
+    BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+
+    KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree> kde(relError,
+        0.0, kernel, KDE_IFGT_MODE);
+    kde.Train(reference);
+
+    arma::vec estimations;
+    kde.Evaluate(query, estimations);
+    REQUIRE(estimations.n_elem == query.n_cols);
+    for (size_t i = 0; i < query.n_cols; ++i)
+      REQUIRE(estimations[i] == Approx(bfEstimations[i]).epsilon(relError));
+
+    // Now the monochromatic case, where each point's own contribution is not
+    // counted.
+    arma::vec bfMonoEstimations(reference.n_cols, arma::fill::zeros);
+    BruteForceKDE<GaussianKernel>(reference, reference, bfMonoEstimations,
+        kernel);
+    kde.Evaluate(estimations);
+    REQUIRE(estimations.n_elem == reference.n_cols);
+    for (size_t i = 0; i < reference.n_cols; ++i)
+    {
+      const double expected = bfMonoEstimations[i] -
+          kernel.Evaluate(0.0) / reference.n_cols;
+      REQUIRE(estimations[i] == Approx(expected).epsilon(relError));
+    }
+  }
+}
+
+/**
+ * Make sure that the fast Gauss transform actually uses the expansions for a
+ * large bandwidth, and that it is accurate.
+ */
+TEST_CASE("FastGaussTransformExpansionTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(3, 3000);
+  arma::mat query = arma::randu(3, 3000);
+  const double relError = 1e-3;
+
+  GaussianKernel kernel(1.0);
+  arma::vec bfEstimations(query.n_cols, arma::fill::zeros);
+  BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+
+  FastGaussTransform fgt(1.0);
+  arma::vec estimations;
+  fgt.Evaluate(reference, query, estimations, relError, 0.0);
+
+  REQUIRE(fgt.NumClusters() > 0);
+  REQUIRE(fgt.Order() > 0);
+  REQUIRE(fgt.NumExactQueries() < query.n_cols / 10);
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(estimations[i] == Approx(bfEstimations[i]).epsilon(relError));
+}
+
+/**
+ * The IFGT mode can only be used with the Gaussian kernel.
+ */
+TEST_CASE("IFGTKDENonGaussianTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 100);
+  arma::mat query = arma::randu(2, 50);
+
+  KDE<EpanechnikovKernel, EuclideanDistance, arma::mat, KDTree> kde(0.05,
+      0.0, EpanechnikovKernel(1.0), KDE_IFGT_MODE);
+  kde.Train(reference);
+
+  arma::vec estimations;
+  REQUIRE_THROWS_AS(kde.Evaluate(query, estimations), std::invalid_argument);
+}
+
+/**
+ * Test that Classify() gives exactly the labels of the brute-force densities,
+ * in dual-tree and single-tree mode, for the query set and for the reference
+ * set.
+ */
+TEST_CASE("KDEClassifyBruteForceTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 1000);
+  arma::mat query = arma::randu(2, 800);
+
+  GaussianKernel kernel(0.1);
+  arma::vec bfEstimations(query.n_cols, arma::fill::zeros);
+  BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+  arma::vec bfMonoEstimations(reference.n_cols, arma::fill::zeros);
+  BruteForceKDE<GaussianKernel>(reference, reference, bfMonoEstimations,
+      kernel);
+  bfMonoEstimations -= kernel.Evaluate(0.0) / reference.n_cols;
+
+  // Use the mean densities as thresholds, so that both labels are frequent.
+  const double threshold = arma::mean(bfEstimations);
+  const double monoThreshold = arma::mean(bfMonoEstimations);
+
+  for (const KDEMode mode : { KDE_DUAL_TREE_MODE, KDE_SINGLE_TREE_MODE })
+  {
+    KDE<GaussianKernel, EuclideanDistance, arma::mat, KDTree> kde(0.05, 0.0,
+        kernel, mode);
+    kde.Train(reference);
+
+    arma::Row<size_t> labels;
+    kde.Classify(query, threshold, labels);
+    REQUIRE(labels.n_elem == query.n_cols);
+    for (size_t i = 0; i < query.n_cols; ++i)
+      REQUIRE(labels[i] == (bfEstimations[i] >= threshold ? 1 : 0));
+
+    kde.Classify(monoThreshold, labels);
+    REQUIRE(labels.n_elem == reference.n_cols);
+    for (size_t i = 0; i < reference.n_cols; ++i)
+      REQUIRE(labels[i] == (bfMonoEstimations[i] >= monoThreshold ? 1 : 0));
+  }
+}
+
+/**
+ * Test that Classify() with cover trees, which falls back to Evaluate(), is
+ * correct for all the points that are not within the error tolerance of the
+ * threshold.
+ */
+TEST_CASE("KDEClassifyCoverTreeTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 500);
+  arma::mat query = arma::randu(2, 400);
+  const double relError = 0.05;
+
+  GaussianKernel kernel(0.1);
+  arma::vec bfEstimations(query.n_cols, arma::fill::zeros);
+  BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+  const double threshold = arma::mean(bfEstimations);
+
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, StandardCoverTree>
+      kde(relError, 0.0, kernel);
+  kde.Train(reference);
+
+  arma::Row<size_t> labels;
+  kde.Classify(query, threshold, labels);
+  REQUIRE(labels.n_elem == query.n_cols);
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    if (std::abs(bfEstimations[i] - threshold) > relError * bfEstimations[i])
+      REQUIRE(labels[i] == (bfEstimations[i] >= threshold ? 1 : 0));
+  }
+}
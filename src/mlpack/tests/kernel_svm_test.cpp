@@ -0,0 +1,282 @@
+/**
+ * @file tests/kernel_svm_test.cpp
+ *
+ * Unit tests for the 'KernelSVM' class, its SMO solver and its kernel row
+ * cache.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+#include "serialization.hpp"
+
+#include <mlpack/methods/kernel_svm.hpp>
+
+using namespace std;
+using namespace mlpack;
+
+// Generate a noiseless XOR dataset: the label is 1 when exactly one of the two
+// coordinates is positive.
+static void XORDataset(const size_t n,
+                       arma::mat& data,
+                       arma::Row<size_t>& labels)
+{
+  data.randu(2, n);
+  data = 2.0 * data - 1.0;
+  labels.set_size(n);
+  for (size_t i = 0; i < n; ++i)
+    labels[i] = ((data(0, i) > 0.0) != (data(1, i) > 0.0)) ? 1 : 0;
+}
+
+/**
+ * Make sure that the rows returned by the cache are the rows of the kernel
+ * matrix, that the cache never holds more rows than its capacity, and that hits
+ * and misses are counted.
+ */
+TEST_CASE("KernelRowCacheTest", "[KernelSVMTest]")
+{
+  arma::mat data(5, 200, arma::fill::randu);
+  GaussianKernel kernel(0.7);
+
+  // 0.001 MB holds 125 doubles, which is less than one row; the cache must
+  // still hold two rows.
+  KernelRowCache<GaussianKernel> cache(kernel, data, 0.001);
+  REQUIRE(cache.Capacity() == 2);
+  REQUIRE(cache.NumPoints() == 200);
+
+  for (size_t i = 0; i < 200; ++i)
+  {
+    REQUIRE(cache.Diagonal()[i] ==
+        Approx(kernel.Evaluate(data.col(i), data.col(i))));
+  }
+
+  const size_t order[] = { 3, 7, 3, 7, 11, 3, 11 };
+  for (const size_t i : order)
+  {
+    const double* row = cache.Row(i);
+    for (size_t j = 0; j < 200; ++j)
+    {
+      REQUIRE(row[j] ==
+          Approx(kernel.Evaluate(data.col(i), data.col(j))).epsilon(1e-7));
+    }
+  }
+
+  // 3 and 7 are computed; then 3 and 7 are hits; 11 evicts 3, which must be
+  // computed again and evicts 7; 11 is a hit.
+  REQUIRE(cache.Hits() == 3);
+  REQUIRE(cache.Misses() == 4);
+
+  // A large cache holds at most the whole matrix.
+  KernelRowCache<GaussianKernel> largeCache(kernel, data, 100.0);
+  REQUIRE(largeCache.Capacity() == 200);
+
+  arma::mat columns;
+  largeCache.Columns(arma::uvec({ 5, 9 }), columns);
+  REQUIRE(columns.n_rows == 200);
+  REQUIRE(columns.n_cols == 2);
+  for (size_t j = 0; j < 200; ++j)
+  {
+    REQUIRE(columns(j, 1) ==
+        Approx(kernel.Evaluate(data.col(9), data.col(j))).epsilon(1e-7));
+  }
+}
+
+/**
+ * Make sure that the solution of SMO satisfies the optimality (KKT) conditions
+ * of the dual problem, with and without shrinking, and with a cache that is
+ * much smaller than the kernel matrix.
+ */
+TEST_CASE("SMOKKTConditionsTest", "[KernelSVMTest]")
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  XORDataset(300, data, labels);
+  // Flip a few labels so that some variables are at the upper bound.
+  for (size_t i = 0; i < 300; i += 37)
+    labels[i] = 1 - labels[i];
+
+  arma::vec y(300);
+  for (size_t i = 0; i < 300; ++i)
+    y[i] = (labels[i] == 1) ? 1.0 : -1.0;
+
+  GaussianKernel kernel(0.5);
+  const double c = 5.0;
+  arma::mat k;
+  KernelMatrix(kernel, data, data, k);
+
+  for (const bool shrinking : { true, false })
+  {
+    // 50 rows of 300 doubles.
+    KernelRowCache<GaussianKernel> cache(kernel, data, 0.12);
+    SMO smo(1e-4, 0, shrinking);
+    arma::vec alpha;
+    double bias;
+    smo.Solve(cache, y, c, alpha, bias);
+
+    REQUIRE(alpha.n_elem == 300);
+    REQUIRE(arma::all(alpha >= 0.0));
+    REQUIRE(arma::all(alpha <= c));
+    REQUIRE(arma::dot(alpha, y) == Approx(0.0).margin(1e-8));
+    REQUIRE(arma::any(alpha == c));
+
+    const arma::vec margins = y % (k * (alpha % y) + bias);
+    for (size_t i = 0; i < 300; ++i)
+    {
+      if (alpha[i] == 0.0)
+        REQUIRE(margins[i] >= 1.0 - 1e-3);
+      else if (alpha[i] == c)
+        REQUIRE(margins[i] <= 1.0 + 1e-3);
+      else
+        REQUIRE(margins[i] == Approx(1.0).margin(1e-3));
+    }
+  }
+}
+
+/**
+ * Make sure that a Gaussian kernel SVM learns the XOR problem, which no linear
+ * classifier can learn, and that it gives the same predictions with and
+ * without shrinking.
+ */
+TEST_CASE("KernelSVMXORTest", "[KernelSVMTest]")
+{
+  arma::mat data, testData;
+  arma::Row<size_t> labels, testLabels;
+  XORDataset(1000, data, labels);
+  XORDataset(500, testData, testLabels);
+
+  KernelSVM<GaussianKernel> svm(data, labels, 2, 10.0, GaussianKernel(0.5),
+      1e-3, 0, 1.0, true);
+  KernelSVM<GaussianKernel> svmNoShrinking(data, labels, 2, 10.0,
+      GaussianKernel(0.5), 1e-3, 0, 1.0, false);
+
+  REQUIRE(svm.NumClasses() == 2);
+  REQUIRE(svm.Coefficients().n_cols == 1);
+  REQUIRE(svm.Bias().n_elem == 1);
+  REQUIRE(svm.SupportVectors().n_cols > 0);
+  REQUIRE(svm.SupportVectors().n_cols < 1000);
+  REQUIRE(svm.Coefficients().n_rows == svm.SupportVectors().n_cols);
+
+  REQUIRE(svm.ComputeAccuracy(data, labels) > 97.0);
+  REQUIRE(svm.ComputeAccuracy(testData, testLabels) > 95.0);
+
+  arma::Row<size_t> predictions, predictionsNoShrinking;
+  arma::mat decisionValues, decisionValuesNoShrinking;
+  svm.Classify(testData, predictions, decisionValues);
+  svmNoShrinking.Classify(testData, predictionsNoShrinking,
+      decisionValuesNoShrinking);
+  REQUIRE(decisionValues.n_rows == 1);
+  REQUIRE(decisionValues.n_cols == 500);
+
+  // Both solve the same problem to the same tolerance, so the predictions can
+  // differ only for points very close to the decision boundary.
+  for (size_t i = 0; i < 500; ++i)
+  {
+    if (std::abs(decisionValues[i]) > 0.05)
+      REQUIRE(predictions[i] == predictionsNoShrinking[i]);
+    REQUIRE(decisionValues[i] ==
+        Approx(decisionValuesNoShrinking[i]).margin(0.05));
+  }
+
+  // Single point classification must match batch classification.
+  for (size_t i = 0; i < 20; ++i)
+    REQUIRE(svm.Classify(testData.col(i)) == predictions[i]);
+}
+
+/**
+ * Make sure that the one-vs-rest classifiers separate three Gaussian clusters.
+ */
+TEST_CASE("KernelSVMMulticlassTest", "[KernelSVMTest]")
+{
+  arma::mat centers = { { 0.0, 4.0, 0.0 },
+                        { 0.0, 0.0, 4.0 } };
+  arma::mat data(2, 900), testData(2, 300);
+  arma::Row<size_t> labels(900), testLabels(300);
+  for (size_t i = 0; i < 900; ++i)
+  {
+    labels[i] = i % 3;
+    data.col(i) = centers.col(i % 3) + arma::randn<arma::vec>(2);
+  }
+  for (size_t i = 0; i < 300; ++i)
+  {
+    testLabels[i] = i % 3;
+    testData.col(i) = centers.col(i % 3) + arma::randn<arma::vec>(2);
+  }
+
+  KernelSVM<GaussianKernel> svm(data, labels, 3, 1.0, GaussianKernel(1.0));
+
+  REQUIRE(svm.NumClasses() == 3);
+  REQUIRE(svm.Coefficients().n_cols == 3);
+  REQUIRE(svm.Bias().n_elem == 3);
+  REQUIRE(svm.ComputeAccuracy(testData, testLabels) > 90.0);
+
+  arma::Row<size_t> predictions;
+  arma::mat decisionValues;
+  svm.Classify(testData, predictions, decisionValues);
+  REQUIRE(decisionValues.n_rows == 3);
+  for (size_t i = 0; i < 300; ++i)
+    REQUIRE(predictions[i] == decisionValues.col(i).index_max());
+}
+
+/**
+ * Make sure that invalid training parameters are rejected.
+ */
+TEST_CASE("KernelSVMInvalidParametersTest", "[KernelSVMTest]")
+{
+  arma::mat data(2, 50, arma::fill::randu);
+  arma::Row<size_t> labels(50);
+  labels.fill(1);
+  labels.head(25).fill(0);
+
+  KernelSVM<GaussianKernel> svm;
+  REQUIRE_THROWS_AS(svm.Train(data, labels, 1), std::invalid_argument);
+  REQUIRE_THROWS_AS(svm.Train(data, labels.head(40), 2),
+      std::invalid_argument);
+
+  arma::Row<size_t> badLabels(labels);
+  badLabels[3] = 2;
+  REQUIRE_THROWS_AS(svm.Train(data, badLabels, 2), std::invalid_argument);
+
+  arma::Row<size_t> predictions;
+  REQUIRE_THROWS_AS(svm.Classify(data, predictions), std::invalid_argument);
+
+  svm.Train(data, labels, 2);
+  arma::mat wrongDimension(3, 10, arma::fill::randu);
+  REQUIRE_THROWS_AS(svm.Classify(wrongDimension, predictions),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that a serialized model gives the same predictions.
+ */
+TEST_CASE("KernelSVMSerializationTest", "[KernelSVMTest]")
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  XORDataset(300, data, labels);
+
+  KernelSVM<GaussianKernel> svm(data, labels, 2, 10.0, GaussianKernel(0.5));
+  KernelSVM<GaussianKernel> xmlSvm, jsonSvm, binarySvm;
+  SerializeObjectAll(svm, xmlSvm, jsonSvm, binarySvm);
+
+  arma::Row<size_t> predictions;
+  arma::mat decisionValues;
+  svm.Classify(data, predictions, decisionValues);
+
+  for (KernelSVM<GaussianKernel>* loaded : { &xmlSvm, &jsonSvm, &binarySvm })
+  {
+    REQUIRE(loaded->NumClasses() == 2);
+    REQUIRE(loaded->C() == 10.0);
+    REQUIRE(loaded->Kernel().Bandwidth() == 0.5);
+    CheckMatrices(loaded->SupportVectors(), svm.SupportVectors());
+
+    arma::Row<size_t> loadedPredictions;
+    arma::mat loadedDecisionValues;
+    loaded->Classify(data, loadedPredictions, loadedDecisionValues);
+    CheckMatrices(loadedPredictions, predictions);
+    CheckMatrices(loadedDecisionValues, decisionValues);
+  }
+}
@@ -226,129 +226,129 @@ TEST_CASE("PSpectrumSubstringExtractionTest", "[KernelTest]")
 
   // herpgle: her, erp, rpg, pgl, gle
   REQUIRE(p.Counts()[0][0].size() == 5);
-  REQUIRE(p.Counts()[0][0]["her"] == 1);
-  REQUIRE(p.Counts()[0][0]["erp"] == 1);
-  REQUIRE(p.Counts()[0][0]["rpg"] == 1);
-  REQUIRE(p.Counts()[0][0]["pgl"] == 1);
-  REQUIRE(p.Counts()[0][0]["gle"] == 1);
+  REQUIRE(p.Count(0, 0, "her") == 1);
+  REQUIRE(p.Count(0, 0, "erp") == 1);
+  REQUIRE(p.Count(0, 0, "rpg") == 1);
+  REQUIRE(p.Count(0, 0, "pgl") == 1);
+  REQUIRE(p.Count(0, 0, "gle") == 1);
 
   // herpagkle: her, erp, rpa, pag, agk, gkl, kle
   REQUIRE(p.Counts()[0][1].size() == 7);
-  REQUIRE(p.Counts()[0][1]["her"] == 1);
-  REQUIRE(p.Counts()[0][1]["erp"] == 1);
-  REQUIRE(p.Counts()[0][1]["rpa"] == 1);
-  REQUIRE(p.Counts()[0][1]["pag"] == 1);
-  REQUIRE(p.Counts()[0][1]["agk"] == 1);
-  REQUIRE(p.Counts()[0][1]["gkl"] == 1);
-  REQUIRE(p.Counts()[0][1]["kle"] == 1);
+  REQUIRE(p.Count(0, 1, "her") == 1);
+  REQUIRE(p.Count(0, 1, "erp") == 1);
+  REQUIRE(p.Count(0, 1, "rpa") == 1);
+  REQUIRE(p.Count(0, 1, "pag") == 1);
+  REQUIRE(p.Count(0, 1, "agk") == 1);
+  REQUIRE(p.Count(0, 1, "gkl") == 1);
+  REQUIRE(p.Count(0, 1, "kle") == 1);
 
   // klunktor: klu, lun, unk, nkt, kto, tor
   REQUIRE(p.Counts()[0][2].size() == 6);
-  REQUIRE(p.Counts()[0][2]["klu"] == 1);
-  REQUIRE(p.Counts()[0][2]["lun"] == 1);
-  REQUIRE(p.Counts()[0][2]["unk"] == 1);
-  REQUIRE(p.Counts()[0][2]["nkt"] == 1);
-  REQUIRE(p.Counts()[0][2]["kto"] == 1);
-  REQUIRE(p.Counts()[0][2]["tor"] == 1);
+  REQUIRE(p.Count(0, 2, "klu") == 1);
+  REQUIRE(p.Count(0, 2, "lun") == 1);
+  REQUIRE(p.Count(0, 2, "unk") == 1);
+  REQUIRE(p.Count(0, 2, "nkt") == 1);
+  REQUIRE(p.Count(0, 2, "kto") == 1);
+  REQUIRE(p.Count(0, 2, "tor") == 1);
 
   // flibbynopple: fli lib ibb bby byn yno nop opp ppl ple
   REQUIRE(p.Counts()[0][3].size() == 10);
-  REQUIRE(p.Counts()[0][3]["fli"] == 1);
-  REQUIRE(p.Counts()[0][3]["lib"] == 1);
-  REQUIRE(p.Counts()[0][3]["ibb"] == 1);
-  REQUIRE(p.Counts()[0][3]["bby"] == 1);
-  REQUIRE(p.Counts()[0][3]["byn"] == 1);
-  REQUIRE(p.Counts()[0][3]["yno"] == 1);
-  REQUIRE(p.Counts()[0][3]["nop"] == 1);
-  REQUIRE(p.Counts()[0][3]["opp"] == 1);
-  REQUIRE(p.Counts()[0][3]["ppl"] == 1);
-  REQUIRE(p.Counts()[0][3]["ple"] == 1);
+  REQUIRE(p.Count(0, 3, "fli") == 1);
+  REQUIRE(p.Count(0, 3, "lib") == 1);
+  REQUIRE(p.Count(0, 3, "ibb") == 1);
+  REQUIRE(p.Count(0, 3, "bby") == 1);
+  REQUIRE(p.Count(0, 3, "byn") == 1);
+  REQUIRE(p.Count(0, 3, "yno") == 1);
+  REQUIRE(p.Count(0, 3, "nop") == 1);
+  REQUIRE(p.Count(0, 3, "opp") == 1);
+  REQUIRE(p.Count(0, 3, "ppl") == 1);
+  REQUIRE(p.Count(0, 3, "ple") == 1);
 
   // floggy3245: flo log ogg ggy gy3 y32 324 245
   REQUIRE(p.Counts()[1][0].size() == 8);
-  REQUIRE(p.Counts()[1][0]["flo"] == 1);
-  REQUIRE(p.Counts()[1][0]["log"] == 1);
-  REQUIRE(p.Counts()[1][0]["ogg"] == 1);
-  REQUIRE(p.Counts()[1][0]["ggy"] == 1);
-  REQUIRE(p.Counts()[1][0]["gy3"] == 1);
-  REQUIRE(p.Counts()[1][0]["y32"] == 1);
-  REQUIRE(p.Counts()[1][0]["324"] == 1);
-  REQUIRE(p.Counts()[1][0]["245"] == 1);
+  REQUIRE(p.Count(1, 0, "flo") == 1);
+  REQUIRE(p.Count(1, 0, "log") == 1);
+  REQUIRE(p.Count(1, 0, "ogg") == 1);
+  REQUIRE(p.Count(1, 0, "ggy") == 1);
+  REQUIRE(p.Count(1, 0, "gy3") == 1);
+  REQUIRE(p.Count(1, 0, "y32") == 1);
+  REQUIRE(p.Count(1, 0, "324") == 1);
+  REQUIRE(p.Count(1, 0, "245") == 1);
 
   // flippydopflip: fli lip ipp ppy pyd ydo dop opf pfl fli lip
   // fli(2) lip(2) ipp ppy pyd ydo dop opf pfl
   REQUIRE(p.Counts()[1][1].size() == 9);
-  REQUIRE(p.Counts()[1][1]["fli"] == 2);
-  REQUIRE(p.Counts()[1][1]["lip"] == 2);
-  REQUIRE(p.Counts()[1][1]["ipp"] == 1);
-  REQUIRE(p.Counts()[1][1]["ppy"] == 1);
-  REQUIRE(p.Counts()[1][1]["pyd"] == 1);
-  REQUIRE(p.Counts()[1][1]["ydo"] == 1);
-  REQUIRE(p.Counts()[1][1]["dop"] == 1);
-  REQUIRE(p.Counts()[1][1]["opf"] == 1);
-  REQUIRE(p.Counts()[1][1]["pfl"] == 1);
+  REQUIRE(p.Count(1, 1, "fli") == 2);
+  REQUIRE(p.Count(1, 1, "lip") == 2);
+  REQUIRE(p.Count(1, 1, "ipp") == 1);
+  REQUIRE(p.Count(1, 1, "ppy") == 1);
+  REQUIRE(p.Count(1, 1, "pyd") == 1);
+  REQUIRE(p.Count(1, 1, "ydo") == 1);
+  REQUIRE(p.Count(1, 1, "dop") == 1);
+  REQUIRE(p.Count(1, 1, "opf") == 1);
+  REQUIRE(p.Count(1, 1, "pfl") == 1);
 
   // stupid fricking cat: stu tup upi pid fri ric ick cki kin ing cat
   REQUIRE(p.Counts()[1][2].size() == 11);
-  REQUIRE(p.Counts()[1][2]["stu"] == 1);
-  REQUIRE(p.Counts()[1][2]["tup"] == 1);
-  REQUIRE(p.Counts()[1][2]["upi"] == 1);
-  REQUIRE(p.Counts()[1][2]["pid"] == 1);
-  REQUIRE(p.Counts()[1][2]["fri"] == 1);
-  REQUIRE(p.Counts()[1][2]["ric"] == 1);
-  REQUIRE(p.Counts()[1][2]["ick"] == 1);
-  REQUIRE(p.Counts()[1][2]["cki"] == 1);
-  REQUIRE(p.Counts()[1][2]["kin"] == 1);
-  REQUIRE(p.Counts()[1][2]["ing"] == 1);
-  REQUIRE(p.Counts()[1][2]["cat"] == 1);
+  REQUIRE(p.Count(1, 2, "stu") == 1);
+  REQUIRE(p.Count(1, 2, "tup") == 1);
+  REQUIRE(p.Count(1, 2, "upi") == 1);
+  REQUIRE(p.Count(1, 2, "pid") == 1);
+  REQUIRE(p.Count(1, 2, "fri") == 1);
+  REQUIRE(p.Count(1, 2, "ric") == 1);
+  REQUIRE(p.Count(1, 2, "ick") == 1);
+  REQUIRE(p.Count(1, 2, "cki") == 1);
+  REQUIRE(p.Count(1, 2, "kin") == 1);
+  REQUIRE(p.Count(1, 2, "ing") == 1);
+  REQUIRE(p.Count(1, 2, "cat") == 1);
 
   // food time isn't until later: foo ood tim ime isn unt nti til lat ate ter
   REQUIRE(p.Counts()[1][3].size() == 11);
-  REQUIRE(p.Counts()[1][3]["foo"] == 1);
-  REQUIRE(p.Counts()[1][3]["ood"] == 1);
-  REQUIRE(p.Counts()[1][3]["tim"] == 1);
-  REQUIRE(p.Counts()[1][3]["ime"] == 1);
-  REQUIRE(p.Counts()[1][3]["isn"] == 1);
-  REQUIRE(p.Counts()[1][3]["unt"] == 1);
-  REQUIRE(p.Counts()[1][3]["nti"] == 1);
-  REQUIRE(p.Counts()[1][3]["til"] == 1);
-  REQUIRE(p.Counts()[1][3]["lat"] == 1);
-  REQUIRE(p.Counts()[1][3]["ate"] == 1);
-  REQUIRE(p.Counts()[1][3]["ter"] == 1);
+  REQUIRE(p.Count(1, 3, "foo") == 1);
+  REQUIRE(p.Count(1, 3, "ood") == 1);
+  REQUIRE(p.Count(1, 3, "tim") == 1);
+  REQUIRE(p.Count(1, 3, "ime") == 1);
+  REQUIRE(p.Count(1, 3, "isn") == 1);
+  REQUIRE(p.Count(1, 3, "unt") == 1);
+  REQUIRE(p.Count(1, 3, "nti") == 1);
+  REQUIRE(p.Count(1, 3, "til") == 1);
+  REQUIRE(p.Count(1, 3, "lat") == 1);
+  REQUIRE(p.Count(1, 3, "ate") == 1);
+  REQUIRE(p.Count(1, 3, "ter") == 1);
 
   // leave me alone until 6:00: lea eav ave alo lon one unt nti til
   REQUIRE(p.Counts()[1][4].size() == 9);
-  REQUIRE(p.Counts()[1][4]["lea"] == 1);
-  REQUIRE(p.Counts()[1][4]["eav"] == 1);
-  REQUIRE(p.Counts()[1][4]["ave"] == 1);
-  REQUIRE(p.Counts()[1][4]["alo"] == 1);
-  REQUIRE(p.Counts()[1][4]["lon"] == 1);
-  REQUIRE(p.Counts()[1][4]["one"] == 1);
-  REQUIRE(p.Counts()[1][4]["unt"] == 1);
-  REQUIRE(p.Counts()[1][4]["nti"] == 1);
-  REQUIRE(p.Counts()[1][4]["til"] == 1);
+  REQUIRE(p.Count(1, 4, "lea") == 1);
+  REQUIRE(p.Count(1, 4, "eav") == 1);
+  REQUIRE(p.Count(1, 4, "ave") == 1);
+  REQUIRE(p.Count(1, 4, "alo") == 1);
+  REQUIRE(p.Count(1, 4, "lon") == 1);
+  REQUIRE(p.Count(1, 4, "one") == 1);
+  REQUIRE(p.Count(1, 4, "unt") == 1);
+  REQUIRE(p.Count(1, 4, "nti") == 1);
+  REQUIRE(p.Count(1, 4, "til") == 1);
 
   // only after that do you get any food.:
   // onl nly aft fte ter tha hat you get any foo ood
   REQUIRE(p.Counts()[1][5].size() == 12);
-  REQUIRE(p.Counts()[1][5]["onl"] == 1);
-  REQUIRE(p.Counts()[1][5]["nly"] == 1);
-  REQUIRE(p.Counts()[1][5]["aft"] == 1);
-  REQUIRE(p.Counts()[1][5]["fte"] == 1);
-  REQUIRE(p.Counts()[1][5]["ter"] == 1);
-  REQUIRE(p.Counts()[1][5]["tha"] == 1);
-  REQUIRE(p.Counts()[1][5]["hat"] == 1);
-  REQUIRE(p.Counts()[1][5]["you"] == 1);
-  REQUIRE(p.Counts()[1][5]["get"] == 1);
-  REQUIRE(p.Counts()[1][5]["any"] == 1);
-  REQUIRE(p.Counts()[1][5]["foo"] == 1);
-  REQUIRE(p.Counts()[1][5]["ood"] == 1);
+  REQUIRE(p.Count(1, 5, "onl") == 1);
+  REQUIRE(p.Count(1, 5, "nly") == 1);
+  REQUIRE(p.Count(1, 5, "aft") == 1);
+  REQUIRE(p.Count(1, 5, "fte") == 1);
+  REQUIRE(p.Count(1, 5, "ter") == 1);
+  REQUIRE(p.Count(1, 5, "tha") == 1);
+  REQUIRE(p.Count(1, 5, "hat") == 1);
+  REQUIRE(p.Count(1, 5, "you") == 1);
+  REQUIRE(p.Count(1, 5, "get") == 1);
+  REQUIRE(p.Count(1, 5, "any") == 1);
+  REQUIRE(p.Count(1, 5, "foo") == 1);
+  REQUIRE(p.Count(1, 5, "ood") == 1);
 
   // obloblobloblobloblobloblob: obl(8) blo(8) lob(8)
   REQUIRE(p.Counts()[1][6].size() == 3);
-  REQUIRE(p.Counts()[1][6]["obl"] == 8);
-  REQUIRE(p.Counts()[1][6]["blo"] == 8);
-  REQUIRE(p.Counts()[1][6]["lob"] == 8);
+  REQUIRE(p.Count(1, 6, "obl") == 8);
+  REQUIRE(p.Count(1, 6, "blo") == 8);
+  REQUIRE(p.Count(1, 6, "lob") == 8);
 }
 
 TEST_CASE("PSpectrumStringEvaluateTest", "[KernelTest]")
@@ -408,6 +408,71 @@ TEST_CASE("PSpectrumStringEvaluateTest", "[KernelTest]")
   REQUIRE(p.Evaluate(b, a) == Approx(11.0).epsilon(1e-7));
 }
 
+// Compare the p-spectrum kernel with a direct count of common substrings, for
+// a length p that is short enough to give exact substring IDs and for one that
+// uses hashed IDs.
+TEST_CASE("PSpectrumStringBruteForceTest", "[KernelTest]")
+{
+  std::vector<std::vector<std::string>> datasets(2);
+  const std::string alphabet = "acgtACGT";
+  for (size_t d = 0; d < 2; ++d)
+  {
+    for (size_t i = 0; i < 40; ++i)
+    {
+      std::string str(RandInt(10, 200), ' ');
+      for (size_t j = 0; j < str.length(); ++j)
+        str[j] = (RandInt(50) == 0) ? '-' : alphabet[RandInt(alphabet.size())];
+      datasets[d].push_back(str);
+    }
+  }
+
+  for (const size_t p : { 3, 14 })
+  {
+    PSpectrumStringKernel kernel(datasets, p);
+
+    // Count the valid lowercase substrings of each string directly.
+    std::vector<std::vector<std::map<std::string, size_t>>> counts(2);
+    for (size_t d = 0; d < 2; ++d)
+    {
+      for (const std::string& str : datasets[d])
+      {
+        std::map<std::string, size_t> strCounts;
+        for (size_t start = 0; start + p <= str.length(); ++start)
+        {
+          std::string sub = str.substr(start, p);
+          if (sub.find('-') != std::string::npos)
+            continue;
+          for (size_t j = 0; j < p; ++j)
+            sub[j] = tolower(sub[j]);
+          ++strCounts[sub];
+        }
+        counts[d].push_back(strCounts);
+      }
+    }
+
+    for (size_t i = 0; i < 40; ++i)
+    {
+      for (size_t j = 0; j < 40; ++j)
+      {
+        double expected = 0.0;
+        for (const auto& c : counts[0][i])
+        {
+          if (counts[1][j].count(c.first))
+            expected += c.second * counts[1][j].at(c.first);
+        }
+
+        arma::uvec a = { 0, i };
+        arma::uvec b = { 1, j };
+        REQUIRE(kernel.Evaluate(a, b) == Approx(expected).margin(1e-10));
+      }
+
+      REQUIRE(kernel.Counts()[0][i].size() == counts[0][i].size());
+      for (const auto& c : counts[0][i])
+        REQUIRE(kernel.Count(0, i, c.first) == c.second);
+    }
+  }
+}
+
 /**
  * Cauchy Kernel test.
  */
@@ -420,3 +485,105 @@ TEST_CASE("CauchyKernelTest", "[KernelTest]")
   REQUIRE(ck.Evaluate(a, b) == Approx(0.92592588).epsilon(1e-7));
   REQUIRE(ck.Evaluate(b, a) == Approx(0.92592588).epsilon(1e-7));
 }
+
+/**
+ * Compute the kernel matrices of the given kernel with KernelMatrix() and make
+ * sure they match direct evaluation of the kernel.
+ */
+template<typename KernelType>
+void CheckKernelMatrix(KernelType& kernel)
+{
+  // Use more points than a block of the blocked evaluation.
+  arma::mat a(4, 150, arma::fill::randu);
+  arma::mat b(4, 70, arma::fill::randu);
+
+  arma::mat k, symmetricK;
+  KernelMatrix(kernel, a, b, k);
+  KernelMatrix(kernel, a, symmetricK);
+
+  REQUIRE(k.n_rows == a.n_cols);
+  REQUIRE(k.n_cols == b.n_cols);
+  REQUIRE(symmetricK.n_rows == a.n_cols);
+  REQUIRE(symmetricK.n_cols == a.n_cols);
+
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      REQUIRE(k(i, j) == Approx(kernel.Evaluate(a.col(i), b.col(j))).margin(
+          1e-7));
+
+  for (size_t j = 0; j < a.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      REQUIRE(symmetricK(i, j) == Approx(kernel.Evaluate(a.col(i),
+          a.col(j))).margin(1e-7));
+
+  // Check the one-vs-many form of the batch evaluation.
+  if constexpr (KernelTraits<KernelType>::HasBatchEvaluate)
+  {
+    arma::rowvec values;
+    kernel.Evaluate(a.col(3), b, values);
+
+    REQUIRE(values.n_elem == b.n_cols);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      REQUIRE(values[j] == Approx(kernel.Evaluate(a.col(3), b.col(j))).margin(
+          1e-7));
+  }
+}
+
+// A kernel without a batch Evaluate() function, to test the blocked
+// computation of kernel matrices.
+class UnbatchedGaussianKernel
+{
+ public:
+  template<typename VecTypeA, typename VecTypeB>
+  double Evaluate(const VecTypeA& a, const VecTypeB& b) const
+  {
+    return kernel.Evaluate(a, b);
+  }
+
+ private:
+  GaussianKernel kernel;
+};
+
+/**
+ * Make sure that the batch and the blocked computations of kernel matrices are
+ * correct.
+ */
+TEST_CASE("KernelMatrixTest", "[KernelTest]")
+{
+  GaussianKernel gk(0.7);
+  CheckKernelMatrix(gk);
+
+  LaplacianKernel lk(1.5);
+  CheckKernelMatrix(lk);
+
+  LinearKernel linear;
+  CheckKernelMatrix(linear);
+
+  PolynomialKernel pk(3.0, 0.5);
+  CheckKernelMatrix(pk);
+
+  HyperbolicTangentKernel hk(0.8, 0.1);
+  CheckKernelMatrix(hk);
+
+  CauchyKernel ck(2.0);
+  CheckKernelMatrix(ck);
+
+  CosineSimilarity cs;
+  CheckKernelMatrix(cs);
+
+  EpanechnikovKernel ek(1.2);
+  CheckKernelMatrix(ek);
+
+  SphericalKernel sk(0.8);
+  CheckKernelMatrix(sk);
+
+  TriangularKernel tk(1.1);
+  CheckKernelMatrix(tk);
+
+  // This one uses blocked evaluation.
+  UnbatchedGaussianKernel ugk;
+  CheckKernelMatrix(ugk);
+
+  arma::mat a(4, 10), b(3, 10), k;
+  REQUIRE_THROWS_AS(KernelMatrix(gk, a, b, k), std::invalid_argument);
+}
@@ -54,3 +54,24 @@ TEST_CASE("IsNormalizedTest", "[KernelTraitsTest]")
   REQUIRE((bool) KernelTraits<PolynomialKernel>::IsNormalized == false);
   REQUIRE((bool) KernelTraits<PSpectrumStringKernel>::IsNormalized == false);
 }
+
+TEST_CASE("BatchEvaluateTest", "[KernelTraitsTest]")
+{
+  // Kernels with a batch Evaluate() function.
+  REQUIRE((bool) KernelTraits<CauchyKernel>::HasBatchEvaluate == true);
+  REQUIRE((bool) KernelTraits<CosineDistance>::HasBatchEvaluate == true);
+  REQUIRE((bool) KernelTraits<EpanechnikovKernel>::HasBatchEvaluate == true);
+  REQUIRE((bool) KernelTraits<GaussianKernel>::HasBatchEvaluate == true);
+  REQUIRE((bool) KernelTraits<HyperbolicTangentKernel>::HasBatchEvaluate ==
+      true);
+  REQUIRE((bool) KernelTraits<LaplacianKernel>::HasBatchEvaluate == true);
+  REQUIRE((bool) KernelTraits<LinearKernel>::HasBatchEvaluate == true);
+  REQUIRE((bool) KernelTraits<PolynomialKernel>::HasBatchEvaluate == true);
+  REQUIRE((bool) KernelTraits<SphericalKernel>::HasBatchEvaluate == true);
+  REQUIRE((bool) KernelTraits<TriangularKernel>::HasBatchEvaluate == true);
+
+  // Kernels without.
+  REQUIRE((bool) KernelTraits<int>::HasBatchEvaluate == false);
+  REQUIRE((bool) KernelTraits<PSpectrumStringKernel>::HasBatchEvaluate ==
+      false);
+}
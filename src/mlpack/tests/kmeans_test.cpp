@@ -536,6 +536,93 @@ TEST_CASE("KMeansPlusPlusTest", "[KMeansTest]")
   REQUIRE(distortion < 14500.0);
 }
 
+/**
+ * Test that the k-means|| initialization strategy returns decent initial
+ * cluster estimates.
+ */
+TEST_CASE("KMeansParallelTest", "[KMeansTest]")
+{
+  // Our dataset will be five Gaussians of largely varying numbers of points and
+  // we expect that the refined starting policy should return good guesses at
+  // what these Gaussians are.
+  arma::mat data(3, 3000);
+  data.randn();
+
+  // First Gaussian: 10000 points, centered at (0, 0, 0).
+  // Second Gaussian: 2000 points, centered at (5, 0, -2).
+  // Third Gaussian: 5000 points, centered at (-2, -2, -2).
+  // Fourth Gaussian: 1000 points, centered at (-6, 8, 8).
+  // Fifth Gaussian: 12000 points, centered at (1, 6, 1).
+  arma::mat centroids(" 0  5 -2 -6  1;"
+                      " 0  0 -2  8  6;"
+                      " 0 -2 -2  8  1");
+
+  for (size_t i = 1000; i < 1200; ++i)
+    data.col(i) += centroids.col(1);
+  for (size_t i = 1200; i < 1700; ++i)
+    data.col(i) += centroids.col(2);
+  for (size_t i = 1700; i < 1800; ++i)
+    data.col(i) += centroids.col(3);
+  for (size_t i = 1800; i < 3000; ++i)
+    data.col(i) += centroids.col(4);
+
+  KMeansParallelInitialization k;
+  arma::mat resultingCentroids;
+  k.Cluster(data, 5, resultingCentroids);
+
+  // Calculate resulting assignments.
+  arma::Row<size_t> assignments(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    double bestDist = DBL_MAX;
+    for (size_t j = 0; j < 5; ++j)
+    {
+      const double dist = EuclideanDistance::Evaluate(data.col(i),
+          resultingCentroids.col(j));
+      if (dist < bestDist)
+      {
+        bestDist = dist;
+        assignments[i] = j;
+      }
+    }
+  }
+
+  // Calculate sum of distances from centroid means.
+  double distortion = 0;
+  for (size_t i = 0; i < 3000; ++i)
+    distortion += EuclideanDistance::Evaluate(data.col(i),
+        resultingCentroids.col(assignments[i]));
+
+  // The candidates are reclustered with Lloyd iterations, so k-means|| should
+  // do at least as well as k-means++ (see KMeansPlusPlusTest).
+  REQUIRE(distortion < 14500.0);
+}
+
+/**
+ * Make sure that k-means|| returns points of the dataset when there are no more
+ * points than clusters.
+ */
+TEST_CASE("KMeansParallelFewPointsTest", "[KMeansTest]")
+{
+  arma::mat data(3, 8, arma::fill::randu);
+
+  KMeansParallelInitialization k(5, 2.0, 10);
+  arma::mat centroids;
+  k.Cluster(data, 8, centroids);
+
+  REQUIRE(centroids.n_rows == 3);
+  REQUIRE(centroids.n_cols == 8);
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    bool found = false;
+    for (size_t j = 0; j < data.n_cols; ++j)
+      found |= arma::approx_equal(centroids.col(i), data.col(j), "absdiff",
+          1e-12);
+
+    REQUIRE(found);
+  }
+}
+
 #ifdef ARMA_HAS_SPMAT
 /**
  * Make sure sparse k-means works okay.
@@ -581,6 +668,104 @@ TEST_CASE("SparseKMeansTest", "[KMeansTest]")
   REQUIRE(assignments[11] == clusterTwo);
 }
 
+/**
+ * Make sure that the sparse Naive and Elkan steps give the same clustering as
+ * the dense Naive step.
+ */
+TEST_CASE("SparseElkanKMeansTest", "[KMeansTest]")
+{
+  arma::sp_mat data;
+  data.sprandu(200, 500, 0.05);
+  const arma::mat denseData(data);
+
+  const size_t k = 8;
+  arma::mat centroids = denseData.cols(0, k - 1);
+
+  arma::Row<size_t> denseAssignments;
+  arma::mat denseCentroids(centroids);
+  KMeans<> dense;
+  dense.Cluster(denseData, k, denseAssignments, denseCentroids, false, true);
+
+  arma::Row<size_t> naiveAssignments;
+  arma::mat naiveCentroids(centroids);
+  KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      NaiveKMeans, arma::sp_mat> naive;
+  naive.Cluster(data, k, naiveAssignments, naiveCentroids, false, true);
+
+  arma::Row<size_t> elkanAssignments;
+  arma::mat elkanCentroids(centroids);
+  KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      ElkanKMeans, arma::sp_mat> elkan;
+  elkan.Cluster(data, k, elkanAssignments, elkanCentroids, false, true);
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    REQUIRE(naiveAssignments[i] == denseAssignments[i]);
+    REQUIRE(elkanAssignments[i] == denseAssignments[i]);
+  }
+
+  for (size_t i = 0; i < centroids.n_elem; ++i)
+  {
+    REQUIRE(naiveCentroids[i] ==
+        Approx(denseCentroids[i]).epsilon(1e-7).margin(1e-10));
+    REQUIRE(elkanCentroids[i] ==
+        Approx(denseCentroids[i]).epsilon(1e-7).margin(1e-10));
+  }
+}
+
+/**
+ * Make sure that spherical k-means separates normalized sparse points by
+ * direction, keeps unit-length centroids, and matches the dense version.
+ */
+TEST_CASE("SphericalKMeansTest", "[KMeansTest]")
+{
+  // Two groups of documents, with mostly disjoint terms; the lengths of the
+  // points vary, so only the directions separate them.
+  arma::sp_mat data(1000, 40);
+  for (size_t i = 0; i < 40; ++i)
+  {
+    const size_t offset = (i < 20) ? 0 : 500;
+    const double scale = 1.0 + (i % 5);
+    data(offset + (i % 7), i) = scale * 3.0;
+    data(offset + 10 + (i % 3), i) = scale * 2.0;
+    data(250, i) = scale * 0.5;
+  }
+  data = arma::normalise(data, 2, 0);
+
+  arma::Row<size_t> assignments;
+  arma::mat centroids;
+  KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      SphericalKMeans, arma::sp_mat> kmeans;
+  kmeans.Cluster(data, 2, assignments, centroids);
+
+  for (size_t i = 0; i < 20; ++i)
+    REQUIRE(assignments[i] == assignments[0]);
+  for (size_t i = 20; i < 40; ++i)
+    REQUIRE(assignments[i] == assignments[20]);
+  REQUIRE(assignments[0] != assignments[20]);
+
+  for (size_t c = 0; c < 2; ++c)
+    REQUIRE(arma::norm(centroids.col(c), 2) == Approx(1.0).epsilon(1e-7));
+
+  // The dense version gives the same centroids from the same start.
+  const arma::mat denseData(data);
+  arma::mat start = denseData.cols(arma::uvec({ 0, 39 }));
+  arma::mat sparseCentroids(start), denseCentroids(start);
+  kmeans.Cluster(data, 2, assignments, sparseCentroids, false, true);
+  KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      SphericalKMeans> denseKMeans;
+  arma::Row<size_t> denseAssignments;
+  denseKMeans.Cluster(denseData, 2, denseAssignments, denseCentroids, false,
+      true);
+
+  REQUIRE(arma::all(assignments == denseAssignments));
+  for (size_t i = 0; i < sparseCentroids.n_elem; ++i)
+  {
+    REQUIRE(sparseCentroids[i] ==
+        Approx(denseCentroids[i]).epsilon(1e-7).margin(1e-10));
+  }
+}
+
 #endif // ARMA_HAS_SPMAT
 
 TEST_CASE("ElkanTest", "[KMeansTest]")
@@ -652,6 +837,67 @@ TEST_CASE("HamerlyTest", "[KMeansTest]")
   }
 }
 
+TEST_CASE("YinyangTest", "[KMeansTest]")
+{
+  const size_t trials = 5;
+
+  for (size_t t = 0; t < trials; ++t)
+  {
+    arma::mat dataset(10, 1000);
+    dataset.randu();
+
+    // Use enough clusters to get several groups of centroids.
+    const size_t k = 12 * (t + 1);
+    arma::mat centroids(10, k);
+    centroids.randu();
+
+    // Make sure the Yinyang algorithm and the naive method return the same
+    // clusters.
+    arma::mat naiveCentroids(centroids);
+    KMeans<> km;
+    arma::Row<size_t> assignments;
+    km.Cluster(dataset, k, assignments, naiveCentroids, false, true);
+
+    KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+        YinyangKMeans> yinyang;
+    arma::Row<size_t> yinyangAssignments;
+    arma::mat yinyangCentroids(centroids);
+    yinyang.Cluster(dataset, k, yinyangAssignments, yinyangCentroids, false,
+        true);
+
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+      REQUIRE(assignments[i] == yinyangAssignments[i]);
+
+    for (size_t i = 0; i < centroids.n_elem; ++i)
+      REQUIRE(naiveCentroids[i] == Approx(yinyangCentroids[i]).epsilon(1e-7));
+  }
+}
+
+/**
+ * Make sure that the centroids are split into groups that cover all centroids
+ * once.
+ */
+TEST_CASE("YinyangGroupsTest", "[KMeansTest]")
+{
+  arma::mat dataset(3, 500);
+  dataset.randu();
+  arma::mat centroids(3, 95);
+  centroids.randu();
+
+  EuclideanDistance distance;
+  YinyangKMeans<EuclideanDistance, arma::mat> yinyang(dataset, distance);
+  arma::mat newCentroids;
+  arma::Col<size_t> counts;
+  yinyang.Iterate(centroids, newCentroids, counts);
+
+  REQUIRE(yinyang.NumGroups() > 1);
+  REQUIRE(yinyang.NumGroups() <= 10);
+  REQUIRE(yinyang.Groups().n_elem == 95);
+  for (size_t c = 0; c < 95; ++c)
+    REQUIRE(yinyang.Groups()[c] < yinyang.NumGroups());
+  REQUIRE(accu(counts) == 500);
+}
+
 TEST_CASE("PellegMooreTest", "[KMeansTest]")
 {
   const size_t trials = 5;
@@ -750,6 +996,50 @@ TEST_CASE("DTNNCoverTreeTest", "[KMeansTest]")
   }
 }
 
+/**
+ * Make sure that the Pelleg-Moore and dual-tree algorithms return the same
+ * clusters as the naive method on a dataset large enough for their traversals
+ * to be split into parallel tasks.
+ */
+TEST_CASE("ParallelTreeKMeansTest", "[KMeansTest]")
+{
+  arma::mat dataset(3, 5000);
+  dataset.randu();
+
+  const size_t k = 20;
+  arma::mat centroids(3, k);
+  centroids.randu();
+
+  arma::mat naiveCentroids(centroids);
+  KMeans<> km;
+  arma::Row<size_t> assignments;
+  km.Cluster(dataset, k, assignments, naiveCentroids, false, true);
+
+  KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+      PellegMooreKMeans> pellegMoore;
+  arma::Row<size_t> pmAssignments;
+  arma::mat pmCentroids(centroids);
+  pellegMoore.Cluster(dataset, k, pmAssignments, pmCentroids, false, true);
+
+  KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+      DefaultDualTreeKMeans> dtnn;
+  arma::Row<size_t> dtnnAssignments;
+  arma::mat dtnnCentroids(centroids);
+  dtnn.Cluster(dataset, k, dtnnAssignments, dtnnCentroids, false, true);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    REQUIRE(assignments[i] == pmAssignments[i]);
+    REQUIRE(assignments[i] == dtnnAssignments[i]);
+  }
+
+  for (size_t i = 0; i < centroids.n_elem; ++i)
+  {
+    REQUIRE(naiveCentroids[i] == Approx(pmCentroids[i]).epsilon(1e-7));
+    REQUIRE(naiveCentroids[i] == Approx(dtnnCentroids[i]).epsilon(1e-7));
+  }
+}
+
 /**
  * Make sure that the sample initialization strategy successfully samples points
  * from the dataset.
@@ -783,3 +1073,91 @@ TEST_CASE("SampleInitializationTest", "[KMeansTest]")
     REQUIRE(j < dataset.n_cols);
   }
 }
+
+/**
+ * Make sure that mini-batch k-means finds the three clusters of the simple
+ * dataset.
+ */
+TEST_CASE("MiniBatchKMeansSimpleTest", "[KMeansTest]")
+{
+  MiniBatchKMeans<EuclideanDistance, KMeansPlusPlusInitialization> kmeans(10);
+
+  arma::Row<size_t> assignments;
+  arma::mat centroids;
+  kmeans.Cluster((arma::mat) trans(kMeansData), 3, assignments, centroids);
+
+  REQUIRE(centroids.n_rows == 2);
+  REQUIRE(centroids.n_cols == 3);
+  REQUIRE(assignments.n_elem == 30);
+
+  size_t firstClass = assignments(0);
+  for (size_t i = 1; i < 13; ++i)
+    REQUIRE(assignments(i) == firstClass);
+
+  size_t secondClass = assignments(13);
+  REQUIRE(firstClass != secondClass);
+  for (size_t i = 13; i < 20; ++i)
+    REQUIRE(assignments(i) == secondClass);
+
+  size_t thirdClass = assignments(20);
+  REQUIRE(firstClass != thirdClass);
+  REQUIRE(secondClass != thirdClass);
+  for (size_t i = 20; i < 30; ++i)
+    REQUIRE(assignments(i) == thirdClass);
+}
+
+/**
+ * Make sure that streaming batches through MiniBatchKMeans::Update() recovers
+ * the means of three well-separated Gaussians.
+ */
+TEST_CASE("MiniBatchKMeansUpdateTest", "[KMeansTest]")
+{
+  arma::mat means("0.0 10.0 -10.0;"
+                  "0.0 10.0   5.0");
+
+  MiniBatchKMeans<EuclideanDistance, KMeansPlusPlusInitialization> kmeans;
+
+  // The number of clusters must be set before the first batch.
+  REQUIRE_THROWS_AS(kmeans.Update(arma::randn<arma::mat>(2, 100)),
+      std::invalid_argument);
+
+  kmeans.Clusters() = 3;
+  for (size_t b = 0; b < 30; ++b)
+  {
+    arma::mat batch = 0.3 * arma::randn<arma::mat>(2, 100);
+    for (size_t i = 0; i < batch.n_cols; ++i)
+      batch.col(i) += means.col(i % 3);
+
+    kmeans.Update(batch);
+  }
+
+  REQUIRE(kmeans.Centroids().n_cols == 3);
+  REQUIRE(arma::accu(kmeans.Counts()) == 3000);
+
+  // Each mean should have a centroid close to it.
+  for (size_t i = 0; i < 3; ++i)
+  {
+    double minDistance = DBL_MAX;
+    for (size_t j = 0; j < 3; ++j)
+    {
+      minDistance = std::min(minDistance, EuclideanDistance::Evaluate(
+          means.col(i), kmeans.Centroids().col(j)));
+    }
+
+    REQUIRE(minDistance < 0.2);
+  }
+
+  // Points from each Gaussian should be assigned to different clusters.
+  arma::Row<size_t> assignments;
+  kmeans.Assign(means, assignments);
+  REQUIRE(assignments[0] != assignments[1]);
+  REQUIRE(assignments[0] != assignments[2]);
+  REQUIRE(assignments[1] != assignments[2]);
+
+  // After a reset, the next batch initializes new centroids.
+  kmeans.Reset();
+  REQUIRE(kmeans.Centroids().n_elem == 0);
+  kmeans.Update(means);
+  REQUIRE(kmeans.Centroids().n_cols == 3);
+  REQUIRE(arma::accu(kmeans.Counts()) == 3);
+}
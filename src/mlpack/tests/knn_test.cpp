@@ -1865,3 +1865,529 @@ TEST_CASE("KNNSpillTreeSearchEnoughResults", "[KNNTest]")
   REQUIRE(accu(distancesGreedy < 0.0 || distancesGreedy > std::sqrt(3.0))
       == 0);
 }
+
+/**
+ * Make sure that the parallel dual-tree traverser gives exactly the same
+ * results as the regular dual-tree traverser, both for monochromatic and
+ * bichromatic search.
+ */
+TEST_CASE("KNNParallelDualTreeTraverserTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 2000);
+  arma::mat queryData = arma::randu<arma::mat>(5, 1500);
+
+  using ParallelKNN = NeighborSearch<NearestNeighborSort, EuclideanDistance,
+      arma::mat, KDTree, KDTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>,
+      arma::mat>::ParallelDualTreeTraverser>;
+
+  KNN knn(referenceData);
+  ParallelKNN parallelKnn(referenceData);
+
+  arma::Mat<size_t> neighbors, parallelNeighbors;
+  arma::mat distances, parallelDistances;
+
+  knn.Search(queryData, 10, neighbors, distances);
+  parallelKnn.Search(queryData, 10, parallelNeighbors, parallelDistances);
+
+  CheckMatrices(neighbors, parallelNeighbors);
+  CheckMatrices(distances, parallelDistances);
+
+  knn.Search(10, neighbors, distances);
+  parallelKnn.Search(10, parallelNeighbors, parallelDistances);
+
+  CheckMatrices(neighbors, parallelNeighbors);
+  CheckMatrices(distances, parallelDistances);
+}
+
+/**
+ * Make sure that the parallel dual-tree traverser of the octree gives exactly
+ * the same results as its regular dual-tree traverser.
+ */
+TEST_CASE("KNNOctreeParallelDualTreeTraverserTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 2000);
+  arma::mat queryData = arma::randu<arma::mat>(3, 1500);
+
+  using OctreeKNN = NeighborSearch<NearestNeighborSort, EuclideanDistance,
+      arma::mat, Octree>;
+  using ParallelKNN = NeighborSearch<NearestNeighborSort, EuclideanDistance,
+      arma::mat, Octree, Octree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>,
+      arma::mat>::ParallelDualTreeTraverser>;
+
+  OctreeKNN knn(referenceData);
+  ParallelKNN parallelKnn(referenceData);
+
+  arma::Mat<size_t> neighbors, parallelNeighbors;
+  arma::mat distances, parallelDistances;
+
+  knn.Search(queryData, 10, neighbors, distances);
+  parallelKnn.Search(queryData, 10, parallelNeighbors, parallelDistances);
+
+  CheckMatrices(neighbors, parallelNeighbors);
+  CheckMatrices(distances, parallelDistances);
+
+  knn.Search(10, neighbors, distances);
+  parallelKnn.Search(10, parallelNeighbors, parallelDistances);
+
+  CheckMatrices(neighbors, parallelNeighbors);
+  CheckMatrices(distances, parallelDistances);
+}
+
+/**
+ * Make sure that the parallel dual-tree traverser of the cover tree gives the
+ * same results as the kd-tree.
+ */
+TEST_CASE("KNNCoverTreeParallelDualTreeTraverserTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 2000);
+  arma::mat queryData = arma::randu<arma::mat>(3, 1500);
+
+  using ParallelKNN = NeighborSearch<NearestNeighborSort, EuclideanDistance,
+      arma::mat, StandardCoverTree, StandardCoverTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>,
+      arma::mat>::ParallelDualTreeTraverser>;
+
+  KNN knn(referenceData);
+  ParallelKNN parallelKnn(referenceData);
+
+  arma::Mat<size_t> neighbors, parallelNeighbors;
+  arma::mat distances, parallelDistances;
+
+  knn.Search(queryData, 10, neighbors, distances);
+  parallelKnn.Search(queryData, 10, parallelNeighbors, parallelDistances);
+
+  CheckMatrices(neighbors, parallelNeighbors);
+  CheckMatrices(distances, parallelDistances);
+
+  knn.Search(10, neighbors, distances);
+  parallelKnn.Search(10, parallelNeighbors, parallelDistances);
+
+  CheckMatrices(neighbors, parallelNeighbors);
+  CheckMatrices(distances, parallelDistances);
+}
+
+/**
+ * Make sure that a KNN model saved in the flat tree format gives the same
+ * results after it is loaded.
+ */
+TEST_CASE("KNNFlatTreeSaveLoadTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(4, 1000);
+  arma::mat queryData = arma::randu<arma::mat>(4, 200);
+
+  KNN knn(referenceData);
+
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  knn.SaveFlat(stream);
+
+  // Load into a model that has a different reference set.
+  KNN loadedKnn(arma::randu<arma::mat>(4, 50));
+  loadedKnn.LoadFlat(stream);
+
+  REQUIRE(loadedKnn.ReferenceSet().n_cols == 1000);
+
+  arma::Mat<size_t> neighbors, loadedNeighbors;
+  arma::mat distances, loadedDistances;
+
+  knn.Search(queryData, 5, neighbors, distances);
+  loadedKnn.Search(queryData, 5, loadedNeighbors, loadedDistances);
+
+  CheckMatrices(neighbors, loadedNeighbors);
+  CheckMatrices(distances, loadedDistances);
+
+  // Loading garbage should throw and leave the model untouched.
+  std::stringstream badStream("this is not a model");
+  REQUIRE_THROWS_AS(loadedKnn.LoadFlat(badStream), std::runtime_error);
+  REQUIRE(loadedKnn.ReferenceSet().n_cols == 1000);
+}
+
+/**
+ * Make sure that points can be inserted into and removed from a trained
+ * reference tree, and that the results match a model trained on the remaining
+ * points, before and after the tree is rebuilt.
+ */
+TEST_CASE("KNNInsertRemoveRTreeTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(4, 800);
+  arma::mat newData = arma::randu<arma::mat>(4, 200);
+  arma::mat queryData = arma::randu<arma::mat>(4, 100);
+
+  using NeighborSearchType = NeighborSearch<NearestNeighborSort,
+      EuclideanDistance, arma::mat, RTree>;
+  NeighborSearchType knn(referenceData);
+  knn.RebuildThreshold() = 0.0;
+
+  for (size_t i = 0; i < newData.n_cols; ++i)
+    REQUIRE(knn.Insert(newData.col(i)) == referenceData.n_cols + i);
+
+  arma::mat allData = arma::join_rows(referenceData, newData);
+  std::vector<size_t> liveIndices;
+  for (size_t i = 0; i < allData.n_cols; ++i)
+  {
+    if (i % 7 == 3)
+      knn.Remove(i);
+    else
+      liveIndices.push_back(i);
+  }
+
+  REQUIRE(knn.ReferenceSet().n_cols == allData.n_cols);
+  REQUIRE(knn.ReferenceTree().NumDescendants() == liveIndices.size());
+  REQUIRE(knn.Removed(3));
+  REQUIRE(!knn.Removed(4));
+  REQUIRE(knn.Modifications() == allData.n_cols - liveIndices.size() +
+      newData.n_cols);
+
+  // Points can only be removed once.
+  REQUIRE_THROWS_AS(knn.Remove(3), std::invalid_argument);
+  REQUIRE_THROWS_AS(knn.Remove(allData.n_cols), std::invalid_argument);
+
+  // Find the true neighbors among the remaining points.
+  arma::uvec live = arma::conv_to<arma::uvec>::from(liveIndices);
+  KNN naive(arma::mat(allData.cols(live)), NAIVE_MODE);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  naive.Search(queryData, 5, trueNeighbors, trueDistances);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(queryData, 5, neighbors, distances);
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == liveIndices[trueNeighbors[i]]);
+    REQUIRE(distances[i] == Approx(trueDistances[i]).epsilon(1e-7));
+  }
+
+  // Now force a rebuild before the next search; the results should not change.
+  knn.RebuildThreshold() = 0.1;
+  knn.Search(queryData, 5, neighbors, distances);
+  REQUIRE(knn.Modifications() == 0);
+  REQUIRE(knn.ReferenceTree().NumDescendants() == liveIndices.size());
+  REQUIRE(knn.Removed(3));
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == liveIndices[trueNeighbors[i]]);
+    REQUIRE(distances[i] == Approx(trueDistances[i]).epsilon(1e-7));
+  }
+
+  // Inserting and removing is not possible in naive mode.
+  NeighborSearchType naiveKnn(referenceData, NAIVE_MODE);
+  REQUIRE_THROWS_AS(naiveKnn.Insert(newData.col(0)), std::invalid_argument);
+  REQUIRE_THROWS_AS(naiveKnn.Remove(0), std::invalid_argument);
+}
+
+/**
+ * Make sure that the blocked brute-force search, used in naive mode and for
+ * high-dimensional data, gives the same results as a tree-based search.
+ */
+TEMPLATE_TEST_CASE("KNNBlockedBruteForceTest", "[KNNTest]", float, double)
+{
+  using eT = TestType;
+  using MatType = arma::Mat<eT>;
+  using KNNType = NeighborSearch<NearestNeighborSort, EuclideanDistance,
+      MatType, KDTree>;
+
+  // Use more points than a single block holds.
+  MatType referenceData(64, 1500, arma::fill::randu);
+  MatType queryData(64, 300, arma::fill::randu);
+
+  // The tree-based search, with the brute-force search disabled.
+  KNNType treeKnn(referenceData);
+  treeKnn.BruteForceDimensionality() = 0;
+  arma::Mat<size_t> treeNeighbors;
+  MatType treeDistances;
+  treeKnn.Search(queryData, 7, treeNeighbors, treeDistances);
+
+  KNNType naiveKnn(referenceData, NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors;
+  MatType naiveDistances;
+  naiveKnn.Search(queryData, 7, naiveNeighbors, naiveDistances);
+  REQUIRE(naiveKnn.BaseCases() == referenceData.n_cols * queryData.n_cols);
+
+  // In 64 dimensions, the tree-based model picks the brute-force search
+  // automatically; the tree has rearranged the reference points.
+  KNNType autoKnn(referenceData);
+  arma::Mat<size_t> autoNeighbors;
+  MatType autoDistances;
+  autoKnn.Search(queryData, 7, autoNeighbors, autoDistances);
+  REQUIRE(autoKnn.Scores() == 0);
+
+  CheckMatrices(treeNeighbors, naiveNeighbors);
+  CheckMatrices(treeNeighbors, autoNeighbors);
+  for (size_t i = 0; i < treeDistances.n_elem; ++i)
+  {
+    REQUIRE(naiveDistances[i] == Approx(treeDistances[i]).epsilon(1e-5));
+    REQUIRE(autoDistances[i] == Approx(treeDistances[i]).epsilon(1e-5));
+  }
+
+  // Now the monochromatic search: points must not be their own neighbors.
+  treeKnn.Search(7, treeNeighbors, treeDistances);
+  naiveKnn.Search(7, naiveNeighbors, naiveDistances);
+  autoKnn.Search(7, autoNeighbors, autoDistances);
+
+  CheckMatrices(treeNeighbors, naiveNeighbors);
+  CheckMatrices(treeNeighbors, autoNeighbors);
+  for (size_t i = 0; i < treeNeighbors.n_cols; ++i)
+    for (size_t j = 0; j < treeNeighbors.n_rows; ++j)
+      REQUIRE(autoNeighbors(j, i) != i);
+}
+
+/**
+ * Make sure that the blocked brute-force search also finds furthest
+ * neighbors.
+ */
+TEST_CASE("KFNBlockedBruteForceTest", "[KNNTest]")
+{
+  arma::mat referenceData(60, 800, arma::fill::randu);
+  arma::mat queryData(60, 100, arma::fill::randu);
+
+  KFN treeKfn(referenceData);
+  treeKfn.BruteForceDimensionality() = 0;
+  KFN naiveKfn(referenceData, NAIVE_MODE);
+
+  arma::Mat<size_t> treeNeighbors, naiveNeighbors;
+  arma::mat treeDistances, naiveDistances;
+  treeKfn.Search(queryData, 4, treeNeighbors, treeDistances);
+  naiveKfn.Search(queryData, 4, naiveNeighbors, naiveDistances);
+
+  CheckMatrices(treeNeighbors, naiveNeighbors);
+  CheckMatrices(treeDistances, naiveDistances);
+}
+
+/**
+ * The blocked brute-force search with a Mahalanobis distance must find the same
+ * neighbors as a tree-based search with that distance.
+ */
+TEST_CASE("KNNMahalanobisBlockedBruteForceTest", "[KNNTest]")
+{
+  using KNNType = NeighborSearch<NearestNeighborSort, MahalanobisDistance<>,
+      arma::mat, BallTree>;
+
+  arma::mat referenceData(8, 1200, arma::fill::randu);
+  arma::mat queryData(8, 300, arma::fill::randu);
+  arma::mat w(8, 8, arma::fill::randu);
+
+  KNNType treeKnn(referenceData, DUAL_TREE_MODE,
+      0.0, MahalanobisDistance<>(w.t() * w));
+  treeKnn.BruteForceDimensionality() = 0;
+  KNNType naiveKnn(referenceData, NAIVE_MODE,
+      0.0, MahalanobisDistance<>(w.t() * w));
+
+  arma::Mat<size_t> treeNeighbors, naiveNeighbors;
+  arma::mat treeDistances, naiveDistances;
+  treeKnn.Search(queryData, 5, treeNeighbors, treeDistances);
+  naiveKnn.Search(queryData, 5, naiveNeighbors, naiveDistances);
+
+  CheckMatrices(treeNeighbors, naiveNeighbors);
+  CheckMatrices(treeDistances, naiveDistances);
+
+  treeKnn.Search(5, treeNeighbors, treeDistances);
+  naiveKnn.Search(5, naiveNeighbors, naiveDistances);
+
+  CheckMatrices(treeNeighbors, naiveNeighbors);
+  CheckMatrices(treeDistances, naiveDistances);
+}
+
+/**
+ * With no budget, the best-first single-tree search must be exact, for any type
+ * of tree.
+ */
+TEMPLATE_TEST_CASE("KNNBestFirstExactTest", "[KNNTest]",
+    (NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+        KDTree>),
+    (NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+        BallTree>),
+    (NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+        StandardCoverTree>),
+    (NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+        RTree>),
+    (NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+        Octree>))
+{
+  arma::mat referenceData(4, 800, arma::fill::randu);
+  arma::mat queryData(4, 150, arma::fill::randu);
+
+  KNN naive(referenceData, NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  naive.Search(queryData, 6, naiveNeighbors, naiveDistances);
+
+  TestType knn(referenceData, BEST_FIRST_SINGLE_TREE_MODE);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(queryData, 6, neighbors, distances);
+
+  CheckMatrices(neighbors, naiveNeighbors);
+  CheckMatrices(distances, naiveDistances);
+  REQUIRE(knn.Stats().BaseCases() < referenceData.n_cols * queryData.n_cols);
+
+  // Now the monochromatic search.
+  naive.Search(6, naiveNeighbors, naiveDistances);
+  knn.Search(6, neighbors, distances);
+
+  CheckMatrices(neighbors, naiveNeighbors);
+  CheckMatrices(distances, naiveDistances);
+}
+
+/**
+ * With a budget of visited nodes, the best-first search must still return k
+ * valid neighbors for each query point, with fewer base cases, and its recall
+ * must grow with the budget.
+ */
+TEST_CASE("KNNBestFirstBudgetTest", "[KNNTest]")
+{
+  arma::mat referenceData(5, 3000, arma::fill::randu);
+  arma::mat queryData(5, 200, arma::fill::randu);
+
+  KNN naive(referenceData, NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  naive.Search(queryData, 10, naiveNeighbors, naiveDistances);
+
+  KNN knn(referenceData, BEST_FIRST_SINGLE_TREE_MODE);
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  knn.Search(queryData, 10, exactNeighbors, exactDistances);
+  const size_t exactBaseCases = knn.Stats().BaseCases();
+  CheckMatrices(exactNeighbors, naiveNeighbors);
+
+  size_t lastCorrect = 0;
+  const size_t budgets[] = { 1, 10, 100 };
+  for (const size_t budget : budgets)
+  {
+    knn.MaxVisits() = budget;
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    knn.Search(queryData, 10, neighbors, distances);
+
+    REQUIRE(knn.Stats().BaseCases() <= exactBaseCases);
+
+    size_t correct = 0;
+    for (size_t i = 0; i < queryData.n_cols; ++i)
+    {
+      for (size_t j = 0; j < 10; ++j)
+      {
+        // Every result must be a real point, no closer than the true
+        // neighbor.
+        REQUIRE(neighbors(j, i) < referenceData.n_cols);
+        REQUIRE(distances(j, i) >= naiveDistances(j, i) - 1e-10);
+        if (neighbors(j, i) == naiveNeighbors(j, i))
+          ++correct;
+      }
+    }
+
+    REQUIRE(correct >= lastCorrect);
+    lastCorrect = correct;
+  }
+
+  // A large enough budget gives almost exact results.
+  REQUIRE(lastCorrect > 0.9 * naiveNeighbors.n_elem);
+}
+
+// Trees with compact (single precision) bounds.
+template<typename DistanceType, typename StatisticType, typename MatType>
+using CompactKDTree = BinarySpaceTree<DistanceType, StatisticType, MatType,
+    CompactHRectBound, MidpointSplit>;
+
+template<typename DistanceType, typename StatisticType, typename MatType>
+using CompactBallTree = BinarySpaceTree<DistanceType, StatisticType, MatType,
+    CompactBallBound, MidpointSplit>;
+
+/**
+ * Trees with compact bounds must give exact results, since their bounds are
+ * rounded outwards.
+ */
+TEMPLATE_TEST_CASE("KNNCompactBoundTest", "[KNNTest]",
+    (NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+        CompactKDTree>),
+    (NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+        CompactBallTree>))
+{
+  // Use data with a large offset, so that the rounding of the bounds matters.
+  arma::mat referenceData(10, 1000, arma::fill::randu);
+  referenceData += 1000.0;
+  arma::mat queryData(10, 200, arma::fill::randu);
+  queryData += 1000.0;
+
+  KNN naive(referenceData, NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  naive.Search(queryData, 5, naiveNeighbors, naiveDistances);
+
+  const NeighborSearchMode modes[] = { SINGLE_TREE_MODE, DUAL_TREE_MODE };
+  for (const NeighborSearchMode mode : modes)
+  {
+    TestType knn(referenceData, mode);
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    knn.Search(queryData, 5, neighbors, distances);
+
+    CheckMatrices(neighbors, naiveNeighbors);
+    CheckMatrices(distances, naiveDistances);
+  }
+}
+
+/**
+ * Make sure that the statistics of the last search match the counts of the
+ * search, and are reset by each search.
+ */
+TEST_CASE("KNNTraversalStatsTest", "[KNNTest]")
+{
+  arma::mat referenceData(3, 2000, arma::fill::randu);
+  arma::mat queryData(3, 500, arma::fill::randu);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(queryData, 3, neighbors, distances);
+
+  const TraversalStats& stats = knn.Stats();
+  REQUIRE(stats.BaseCases() == knn.BaseCases());
+  REQUIRE(stats.Scores() == knn.Scores());
+  REQUIRE(stats.DistanceEvaluations() == stats.BaseCases());
+  REQUIRE(stats.BaseCases() > 0);
+  REQUIRE(stats.BaseCases() < referenceData.n_cols * queryData.n_cols);
+  REQUIRE(stats.Prunes() > 0);
+
+  // A brute-force search computes every base case and prunes nothing.
+  knn.SearchMode() = NAIVE_MODE;
+  knn.Search(queryData, 3, neighbors, distances);
+  REQUIRE(knn.Stats().BaseCases() == referenceData.n_cols * queryData.n_cols);
+  REQUIRE(knn.Stats().Prunes() == 0);
+  REQUIRE(knn.Stats().TreeBuildingTime().count() == 0);
+}
+
+/**
+ * Make sure that the memory report of a KNN model counts the reference set
+ * and the nodes of the reference tree.
+ */
+TEST_CASE("KNNMemoryUsageTest", "[KNNTest]")
+{
+  arma::mat referenceData(3, 2000, arma::fill::randu);
+  KNN knn(referenceData);
+
+  const MemoryReport report = knn.MemoryUsage();
+  REQUIRE(report.Bytes("reference set") ==
+      referenceData.n_elem * sizeof(double));
+
+  size_t numNodes = 0;
+  std::vector<const KNN::Tree*> stack(1, &knn.ReferenceTree());
+  while (!stack.empty())
+  {
+    const KNN::Tree* node = stack.back();
+    stack.pop_back();
+    ++numNodes;
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      stack.push_back(&node->Child(i));
+  }
+
+  REQUIRE(report.Bytes("reference tree/nodes") ==
+      numNodes * sizeof(KNN::Tree));
+  REQUIRE(report.Bytes("reference tree/bounds") ==
+      numNodes * 3 * sizeof(RangeType<double>));
+  // The dataset of the tree is the reference set, so it is not counted twice.
+  REQUIRE(report.Bytes("reference tree/dataset") == 0);
+  REQUIRE(report.Total() >= report.Bytes("reference set") +
+      report.Bytes("reference tree/nodes"));
+}
@@ -231,6 +231,51 @@ TEST_CASE("SingleDatasetNaiveSearch", "[KRANNTest]")
   REQUIRE(distances.n_cols == 2500);
 }
 
+// Make sure that naive search (which samples blocks of query points at once)
+// returns exact distances, sorted, and never returns a point as its own
+// neighbor, both for the Euclidean distance (where the distances are computed
+// with matrix multiplications) and for other metrics.
+TEST_CASE("NaiveBatchedSamplingTest", "[KRANNTest]")
+{
+  arma::mat dataset(4, 1000, arma::fill::randu);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+
+  RASearch<> naive(dataset, true, false, 5.0);
+  naive.Search(3, neighbors, distances);
+
+  RASearch<NearestNeighborSort, ManhattanDistance> manhattanNaive(dataset,
+      true, false, 5.0);
+  arma::Mat<size_t> manhattanNeighbors;
+  arma::mat manhattanDistances;
+  manhattanNaive.Search(3, manhattanNeighbors, manhattanDistances);
+
+  REQUIRE(neighbors.n_rows == 3);
+  REQUIRE(neighbors.n_cols == 1000);
+  REQUIRE(manhattanNeighbors.n_rows == 3);
+  REQUIRE(manhattanNeighbors.n_cols == 1000);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 3; ++j)
+    {
+      REQUIRE(neighbors(j, i) != i);
+      REQUIRE(distances(j, i) == Approx(EuclideanDistance::Evaluate(
+          dataset.col(i), dataset.col(neighbors(j, i)))).epsilon(1e-10));
+      REQUIRE(manhattanNeighbors(j, i) != i);
+      REQUIRE(manhattanDistances(j, i) == Approx(ManhattanDistance::Evaluate(
+          dataset.col(i), dataset.col(manhattanNeighbors(j, i))))
+          .epsilon(1e-10));
+      if (j > 0)
+      {
+        REQUIRE(distances(j - 1, i) <= distances(j, i));
+        REQUIRE(manhattanDistances(j - 1, i) <= manhattanDistances(j, i));
+      }
+    }
+  }
+}
+
 // Test rank-approximate search with just a single dataset in single-tree mode.
 // These tests just ensure that the method runs okay.
 TEST_CASE("SingleDatasetSingleSearch", "[KRANNTest]")
@@ -1346,3 +1346,85 @@ TEMPLATE_TEST_CASE("LARSSparseModelDenseData", "[LARSTest]", float, double)
   REQUIRE(lars2.ActiveSet().size() < 1000);
   REQUIRE(lars2.ActiveSet().size() > 0);
 }
+
+// Make sure that training one model per target with the multi-response Train()
+// gives the same models as training each target on its own.
+TEST_CASE("LARSMultiResponseTrainTest", "[LARSTest]")
+{
+  arma::mat X = arma::randn<arma::mat>(20, 500);
+  arma::mat betas = arma::randn<arma::mat>(20, 8);
+  arma::mat responses = betas.t() * X + 0.1 * arma::randn<arma::mat>(8, 500);
+
+  for (const bool useCholesky : { false, true })
+  {
+    LARS<> settings(useCholesky, 0.5, 0.1);
+
+    std::vector<LARS<>> models;
+    settings.Train(X, responses, models);
+    REQUIRE(models.size() == responses.n_rows);
+
+    // The settings object is not trained.
+    REQUIRE(settings.BetaPath().size() == 0);
+
+    for (size_t t = 0; t < responses.n_rows; ++t)
+    {
+      LARS<> lars(useCholesky, 0.5, 0.1);
+      const arma::rowvec y = responses.row(t);
+      lars.Train(X, y);
+
+      REQUIRE(models[t].BetaPath().size() == lars.BetaPath().size());
+      REQUIRE(arma::approx_equal(models[t].Beta(), lars.Beta(), "absdiff",
+          1e-8));
+      REQUIRE(models[t].Intercept() == Approx(lars.Intercept()).margin(1e-8));
+
+      // The models must be usable (and retrainable) on their own.
+      REQUIRE(models[t].ComputeError(X, y) ==
+          Approx(lars.ComputeError(X, y)).epsilon(1e-8));
+      models[t].Train(X, y);
+      REQUIRE(arma::approx_equal(models[t].Beta(), lars.Beta(), "absdiff",
+          1e-8));
+    }
+  }
+
+  // The number of responses must match the number of points.
+  LARS<> lars;
+  std::vector<LARS<>> models;
+  REQUIRE_THROWS_AS(lars.Train(X, responses.cols(0, 99), models),
+      std::invalid_argument);
+}
+
+// Make sure that SelectBetas() gives the solutions that SelectBeta() gives, and
+// does not change the selected model.
+TEST_CASE("LARSSelectBetasTest", "[LARSTest]")
+{
+  arma::mat X;
+  arma::rowvec y;
+  GenerateProblem(X, y, 500, 30);
+
+  LARS<> lars(true, 0.01);
+  lars.Train(X, y);
+  const arma::vec beta = lars.Beta();
+
+  const arma::vec lambdas = arma::logspace<arma::vec>(2, -2, 20);
+  arma::mat betas;
+  arma::rowvec intercepts;
+  lars.SelectBetas(lambdas, betas, intercepts);
+
+  REQUIRE(betas.n_rows == X.n_rows);
+  REQUIRE(betas.n_cols == lambdas.n_elem);
+  REQUIRE(intercepts.n_elem == lambdas.n_elem);
+  REQUIRE(arma::approx_equal(lars.Beta(), beta, "absdiff", 1e-12));
+
+  for (size_t i = 0; i < lambdas.n_elem; ++i)
+  {
+    LARS<> selected(lars);
+    selected.SelectBeta(lambdas[i]);
+    REQUIRE(arma::approx_equal(betas.col(i), selected.Beta(), "absdiff",
+        1e-12));
+    REQUIRE(intercepts[i] == Approx(selected.Intercept()).margin(1e-12));
+  }
+
+  LARS<> untrained;
+  REQUIRE_THROWS_AS(untrained.SelectBetas(lambdas, betas, intercepts),
+      std::runtime_error);
+}
@@ -423,3 +423,93 @@ TEST_CASE("LinearRegressionSparseTrainingTest", "[LinearRegressionTest]")
 
   REQUIRE(predictions.n_elem == 5000);
 }
+
+/**
+ * Make sure that training on sufficient statistics accumulated in batches and
+ * merged gives the same model as training on the whole dataset.
+ */
+TEST_CASE("LinearRegressionStatisticsTest", "[LinearRegressionTest]")
+{
+  // Use data far from the origin, to check that the statistics do not lose
+  // precision.
+  arma::mat predictors = arma::randu<arma::mat>(5, 2000) + 100.0;
+  arma::rowvec responses = arma::randn<arma::rowvec>(5) * predictors +
+      0.1 * arma::randn<arma::rowvec>(2000);
+  arma::rowvec weights = arma::randu<arma::rowvec>(2000) + 0.5;
+
+  for (const bool intercept : { true, false })
+  {
+    for (const double lambda : { 0.0, 0.5 })
+    {
+      // Accumulate two halves separately, in uneven batches, and merge them.
+      LinearRegressionStatistics<> stats1, stats2;
+      stats1.Accumulate(predictors.cols(0, 299), responses.cols(0, 299));
+      stats1.Accumulate(predictors.cols(300, 999), responses.cols(300, 999));
+      stats2.Accumulate(predictors.cols(1000, 1999),
+          responses.cols(1000, 1999));
+      stats1.Merge(stats2);
+
+      REQUIRE(stats1.NumPoints() == 2000);
+      REQUIRE(stats1.TotalWeight() == Approx(2000.0));
+
+      LinearRegression<> lr(predictors, responses, lambda, intercept);
+      LinearRegression<> streamingLR;
+      const double error = streamingLR.Train(stats1, lambda, intercept);
+
+      REQUIRE(streamingLR.Intercept() == intercept);
+      REQUIRE(arma::approx_equal(streamingLR.Parameters(), lr.Parameters(),
+          "both", 1e-6, 1e-6));
+      REQUIRE(error == Approx(lr.ComputeError(predictors, responses))
+          .epsilon(1e-5));
+
+      // Now with instance weights.
+      LinearRegressionStatistics<> weightedStats;
+      weightedStats.Accumulate(predictors.cols(0, 999),
+          responses.cols(0, 999), weights.cols(0, 999));
+      weightedStats.Accumulate(predictors.cols(1000, 1999),
+          responses.cols(1000, 1999), weights.cols(1000, 1999));
+
+      LinearRegression<> weightedLR(predictors, responses, weights, lambda,
+          intercept);
+      streamingLR.Train(weightedStats, lambda, intercept);
+      REQUIRE(arma::approx_equal(streamingLR.Parameters(),
+          weightedLR.Parameters(), "both", 1e-6, 1e-6));
+    }
+  }
+
+  // Statistics of different dimensionalities cannot be merged.
+  LinearRegressionStatistics<> stats1, stats2;
+  stats1.Accumulate(predictors, responses);
+  stats2.Accumulate(predictors.rows(0, 3), responses);
+  REQUIRE_THROWS_AS(stats1.Merge(stats2), std::invalid_argument);
+}
+
+/**
+ * Train linear regression on data read from disk in chunks.
+ */
+TEST_CASE("LinearRegressionChunkedSourceTest", "[LinearRegressionTest]")
+{
+  arma::mat predictors = arma::randu<arma::mat>(4, 1500);
+  arma::rowvec responses = arma::randn<arma::rowvec>(4) * predictors +
+      3.0 + 0.1 * arma::randn<arma::rowvec>(1500);
+
+  REQUIRE(data::Save("lr_chunked_predictors.bin", predictors, false, false,
+      data::FileType::ArmaBinary) == true);
+  REQUIRE(data::Save("lr_chunked_responses.bin", responses, false, false,
+      data::FileType::ArmaBinary) == true);
+
+  data::ChunkedSource<double> predictorsSource("lr_chunked_predictors.bin",
+      400, false);
+  data::ChunkedSource<double> responsesSource("lr_chunked_responses.bin", 400,
+      false);
+
+  LinearRegression<> lr(predictors, responses, 0.1);
+  LinearRegression<> chunkedLR;
+  chunkedLR.Train(predictorsSource, responsesSource, 0.1);
+
+  REQUIRE(arma::approx_equal(chunkedLR.Parameters(), lr.Parameters(), "both",
+      1e-6, 1e-6));
+
+  remove("lr_chunked_predictors.bin");
+  remove("lr_chunked_responses.bin");
+}
@@ -869,6 +869,55 @@ TEST_CASE("LinearSVMParallelSGDTwoClasses", "[LinearSVMTest]")
 
 #endif
 
+/**
+ * Make sure that the sparse kernels of LinearSVMFunction give the same
+ * objective and gradients as the dense computation, with and without an
+ * intercept, for the whole dataset and for batches.
+ */
+TEST_CASE("LinearSVMFunctionSparseGradientTest", "[LinearSVMTest]")
+{
+  const size_t numClasses = 3;
+  arma::sp_mat dataset;
+  dataset.sprandu(40, 200, 0.05);
+  arma::mat denseDataset(dataset);
+  arma::Row<size_t> labels(200);
+  for (size_t i = 0; i < 200; ++i)
+    labels[i] = RandInt(0, numClasses);
+
+  for (const bool fitIntercept : { false, true })
+  {
+    LinearSVMFunction<> svmf(denseDataset, labels, numClasses, 0.01, 1.0,
+        fitIntercept);
+    LinearSVMFunction<arma::sp_mat> svmfSparse(dataset, labels, numClasses,
+        0.01, 1.0, fitIntercept);
+
+    arma::mat parameters(fitIntercept ? 41 : 40, numClasses, arma::fill::randn);
+
+    REQUIRE(svmfSparse.Evaluate(parameters) ==
+        Approx(svmf.Evaluate(parameters)).epsilon(1e-7));
+
+    arma::mat gradient, sparseGradient;
+    svmf.Gradient(parameters, gradient);
+    svmfSparse.Gradient(parameters, sparseGradient);
+    REQUIRE(arma::approx_equal(gradient, sparseGradient, "absdiff", 1e-8));
+
+    for (size_t begin = 0; begin < 200; begin += 25)
+    {
+      REQUIRE(svmfSparse.Evaluate(parameters, begin, 25) ==
+          Approx(svmf.Evaluate(parameters, begin, 25)).epsilon(1e-7));
+
+      svmf.Gradient(parameters, begin, gradient, 25);
+      svmfSparse.Gradient(parameters, begin, sparseGradient, 25);
+      REQUIRE(arma::approx_equal(gradient, sparseGradient, "absdiff", 1e-8));
+
+      REQUIRE(svmfSparse.EvaluateWithGradient(parameters, begin,
+          sparseGradient, 25) ==
+          Approx(svmf.Evaluate(parameters, begin, 25)).epsilon(1e-7));
+      REQUIRE(arma::approx_equal(gradient, sparseGradient, "absdiff", 1e-8));
+    }
+  }
+}
+
 /**
  * Test sparse and dense linear svm training and make sure they both work the
  * same using the L-BFGS optimizer.
@@ -1475,3 +1524,30 @@ TEMPLATE_TEST_CASE("LinearSVMTrainVariantTest", "[LinearSVMTest]", arma::fmat,
   REQUIRE(lsvm16.FeatureSize() == 10);
   REQUIRE(lsvm16.NumClasses() == 2);
 }
+
+/**
+ * Make sure that the scorer of the model and single-point classification give
+ * the same labels as batch classification, with and without intercepts.
+ */
+TEST_CASE("LinearSVMScorerTest", "[LinearSVMTest]")
+{
+  arma::mat data(6, 300, arma::fill::randn);
+
+  for (const bool fitIntercept : { true, false })
+  {
+    LinearSVM<> lsvm(data.n_rows, 3, 0.0001, 1.0, fitIntercept);
+    lsvm.Parameters().randn();
+
+    arma::Row<size_t> labels, scorerLabels;
+    arma::mat scores, scorerScores;
+    lsvm.Classify(data, labels, scores);
+
+    LinearScorer<> scorer = lsvm.Scorer();
+    scorer.Classify(data, scorerLabels, scorerScores);
+    REQUIRE(all(labels == scorerLabels));
+    REQUIRE(approx_equal(scores, scorerScores, "absdiff", 1e-10));
+
+    for (size_t i = 0; i < data.n_cols; ++i)
+      REQUIRE(lsvm.Classify(data.col(i)) == labels[i]);
+  }
+}
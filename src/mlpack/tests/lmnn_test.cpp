@@ -97,6 +97,56 @@ TEMPLATE_TEST_CASE("LMNNImpostorsTest", "[LMNNTest]", float, double)
   REQUIRE(impostors(0, 5) == 2);
 }
 
+/**
+ * The impostors of several classes, computed in parallel, should match the
+ * impostors computed with one thread, and re-computing the impostors of only
+ * some points should give the same result for these points.
+ */
+TEST_CASE("LMNNParallelImpostorsTest", "[LMNNTest]")
+{
+  arma::mat dataset(4, 300, arma::fill::randu);
+  arma::Row<size_t> labels =
+      arma::randi<arma::Row<size_t>>(300, arma::distr_param(0, 4));
+
+  Constraints<> constraint(dataset, labels, 3);
+
+  arma::vec norm(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    norm(i) = arma::norm(dataset.col(i));
+
+  arma::umat impostors(3, dataset.n_cols);
+  arma::mat distances(3, dataset.n_cols);
+  constraint.Impostors(impostors, distances, dataset, labels, norm);
+
+  // Re-compute the impostors of every third point.
+  arma::uvec points = arma::regspace<arma::uvec>(0, 3, dataset.n_cols - 1);
+  arma::umat subImpostors(3, dataset.n_cols, arma::fill::zeros);
+  arma::mat subDistances(3, dataset.n_cols, arma::fill::zeros);
+  constraint.Impostors(subImpostors, subDistances, dataset, labels, norm,
+      points, points.n_elem);
+
+  for (size_t i = 0; i < points.n_elem; ++i)
+  {
+    REQUIRE(arma::all(subImpostors.col(points[i]) ==
+        impostors.col(points[i])));
+    REQUIRE(arma::approx_equal(subDistances.col(points[i]),
+        distances.col(points[i]), "absdiff", 1e-12));
+  }
+
+  #ifdef MLPACK_USE_OPENMP
+  const size_t prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  arma::umat serialImpostors(3, dataset.n_cols);
+  arma::mat serialDistances(3, dataset.n_cols);
+  constraint.Impostors(serialImpostors, serialDistances, dataset, labels,
+      norm);
+  omp_set_num_threads(prevNumThreads);
+
+  REQUIRE(arma::all(arma::vectorise(serialImpostors == impostors)));
+  REQUIRE(arma::approx_equal(serialDistances, distances, "absdiff", 1e-12));
+  #endif
+}
+
 //
 // Tests for the LMNNFunction
 //
@@ -793,3 +843,37 @@ TEMPLATE_TEST_CASE("LMNNFunctionGradientTest4", "[LMNNTest]", float, double)
     CheckGradient(lmnnfn, coordinates);
   }
 }
+
+/**
+ * When the impostors are only re-computed for the points whose margins could
+ * have been crossed, the objective should match the objective with freshly
+ * computed impostors, even when the impostors are not updated at every call.
+ */
+TEST_CASE("LMNNIncrementalImpostorsTest", "[LMNNTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("iris.csv", dataset))
+    FAIL("Cannot load dataset iris.csv");
+  if (!data::Load("iris_labels.txt", labels))
+    FAIL("Cannot load dataset iris_labels.txt");
+
+  // Impostors are re-computed every other call.
+  LMNNFunction<> lmnnfn(dataset, labels, 1, 0.6, 2);
+
+  arma::mat transformation = lmnnfn.GetInitialPoint();
+  for (size_t i = 0; i < 10; ++i)
+  {
+    transformation += 0.01 * arma::randn<arma::mat>(dataset.n_rows,
+        dataset.n_rows);
+    const double objective = lmnnfn.Evaluate(transformation);
+
+    // Compare on the calls where the impostors were updated.
+    if (i % 2 == 0)
+    {
+      LMNNFunction<> freshfn(dataset, labels, 1, 0.6, 2);
+      REQUIRE(objective ==
+          Approx(freshfn.Evaluate(transformation)).epsilon(1e-5));
+    }
+  }
+}
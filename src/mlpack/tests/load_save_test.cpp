@@ -495,6 +495,247 @@ TEST_CASE("LoadTransposedCSVTest", "[LoadSaveTest]")
   remove("test_file.csv");
 }
 
+/**
+ * Make sure a large CSV with rows of different lengths is loaded correctly,
+ * both transposed and non-transposed.  The file is large enough that it is
+ * parsed by multiple threads.
+ */
+TEST_CASE("LoadLargeRaggedCSVTest", "[LoadSaveTest]")
+{
+  arma::mat expected(12, 20000, arma::fill::randn);
+  // Every third row of the file will be missing its last four values.
+  for (size_t i = 0; i < expected.n_cols; i += 3)
+    expected.submat(8, i, 11, i).zeros();
+
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  f.precision(17);
+  for (size_t i = 0; i < expected.n_cols; ++i)
+  {
+    const size_t dims = (i % 3 == 0) ? 8 : 12;
+    for (size_t j = 0; j < dims; ++j)
+      f << expected(j, i) << ((j == dims - 1) ? "" : ",");
+    // Use Windows line endings for some rows.
+    f << ((i % 5 == 0) ? "\r\n" : "\n");
+  }
+  f.close();
+
+  arma::mat test;
+  REQUIRE(data::Load("test_file.csv", test) == true);
+
+  REQUIRE(test.n_rows == expected.n_rows);
+  REQUIRE(test.n_cols == expected.n_cols);
+  for (size_t i = 0; i < expected.n_elem; ++i)
+    REQUIRE(test[i] == Approx(expected[i]).epsilon(1e-12));
+
+  arma::mat testTrans;
+  REQUIRE(data::Load("test_file.csv", testTrans, false, false) == true);
+
+  REQUIRE(testTrans.n_rows == expected.n_cols);
+  REQUIRE(testTrans.n_cols == expected.n_rows);
+  CheckMatrices(testTrans, arma::mat(test.t()));
+
+  // Remove the file.
+  remove("test_file.csv");
+}
+
+/**
+ * Make sure an invalid token in a CSV causes loading to fail.
+ */
+TEST_CASE("LoadInvalidTokenCSVTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+
+  f << "1, 2, 3, 4" << endl;
+  f << "5, 6, a, 8" << endl;
+
+  f.close();
+
+  arma::mat test;
+  REQUIRE(data::Load("test_file.csv", test) == false);
+
+  // Remove the file.
+  remove("test_file.csv");
+}
+
+/**
+ * Make sure a ChunkedSource returns the same points as data::Load(), for CSV
+ * and Armadillo binary files, transposed and non-transposed.
+ */
+TEST_CASE("ChunkedSourceTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(5, 1003, arma::fill::randu);
+
+  REQUIRE(data::Save("test_file.csv", dataset) == true);
+  REQUIRE(data::Save("test_file.bin", dataset, false, true,
+      FileType::ArmaBinary) == true);
+
+  // Each file is read both ways, and the result must match data::Load() with
+  // the same transpose setting.
+  for (const std::string& filename : { "test_file.csv", "test_file.bin" })
+  {
+    for (const bool transpose : { true, false })
+    {
+      // CSV files can only be read one point per line.
+      if (!transpose && filename == "test_file.csv")
+        continue;
+
+      arma::mat expected;
+      REQUIRE(data::Load(filename, expected, true, transpose) == true);
+
+      data::ChunkedSource<double> source(filename, 100, transpose);
+      REQUIRE(source.Dimensionality() == expected.n_rows);
+      REQUIRE(source.NumPoints() == expected.n_cols);
+
+      // Read everything twice to make sure Reset() works.
+      for (size_t pass = 0; pass < 2; ++pass)
+      {
+        arma::mat chunk;
+        size_t numChunks = 0;
+        size_t position = 0;
+        while (source.Next(chunk))
+        {
+          REQUIRE(chunk.n_rows == expected.n_rows);
+          REQUIRE(chunk.n_cols == std::min((size_t) 100,
+              (size_t) expected.n_cols - position));
+          CheckMatrices(chunk,
+              expected.cols(position, position + chunk.n_cols - 1));
+
+          position += chunk.n_cols;
+          ++numChunks;
+        }
+
+        REQUIRE(position == expected.n_cols);
+        REQUIRE(numChunks == (expected.n_cols + 99) / 100);
+        REQUIRE(chunk.n_elem == 0);
+        source.Reset();
+      }
+    }
+  }
+
+  // Remove the files.
+  remove("test_file.csv");
+  remove("test_file.bin");
+}
+
+/**
+ * Make sure a BatchPrefetcher returns every point of the dataset once per
+ * epoch, with its response, for data held in memory and for chunked sources.
+ */
+TEST_CASE("BatchPrefetcherTest", "[LoadSaveTest]")
+{
+  // The first row of each point is its index, and so is its response.
+  arma::mat predictors(4, 1003, arma::fill::randu);
+  predictors.row(0) = arma::regspace<arma::rowvec>(0, 1002);
+  arma::mat responses = predictors.row(0);
+
+  for (const bool shuffle : { false, true })
+  {
+    data::BatchPrefetcher<arma::mat> prefetcher(predictors, responses, 100,
+        shuffle);
+    REQUIRE(prefetcher.NumBatches() == 11);
+    prefetcher.Transform() = [](arma::mat& x, arma::mat& /* y */)
+    {
+      x.rows(1, 3) *= 2.0;
+    };
+
+    for (size_t epoch = 0; epoch < 2; ++epoch)
+    {
+      prefetcher.Reset();
+      arma::mat x, y;
+      arma::uvec seen(1003, arma::fill::zeros);
+      size_t numBatches = 0, first = 0;
+      while (prefetcher.Next(x, y))
+      {
+        REQUIRE(x.n_cols == std::min((size_t) 100, 1003 - first));
+        REQUIRE(arma::approx_equal(x.row(0), y, "absdiff", 0.0));
+        for (size_t i = 0; i < x.n_cols; ++i)
+        {
+          const size_t index = (size_t) x(0, i);
+          if (!shuffle)
+            REQUIRE(index == first + i);
+          CheckMatrices(x.submat(1, i, 3, i),
+              2.0 * predictors.submat(1, index, 3, index));
+          ++seen[index];
+        }
+
+        first += x.n_cols;
+        ++numBatches;
+      }
+
+      REQUIRE(numBatches == 11);
+      REQUIRE(arma::all(seen == 1));
+      REQUIRE(x.n_elem == 0);
+    }
+  }
+
+  // Sequences held in cubes are gathered along the columns of each slice.
+  arma::cube sequences(2, 50, 3, arma::fill::randu);
+  for (size_t s = 0; s < 3; ++s)
+    sequences.slice(s).row(0) = arma::regspace<arma::rowvec>(0, 49);
+  data::BatchPrefetcher<arma::cube> cubePrefetcher(sequences, sequences, 16);
+  arma::cube x, y;
+  size_t numSequences = 0;
+  while (cubePrefetcher.Next(x, y))
+  {
+    REQUIRE(x.n_slices == 3);
+    for (size_t i = 0; i < x.n_cols; ++i)
+    {
+      const size_t index = (size_t) x(0, i, 0);
+      for (size_t s = 0; s < 3; ++s)
+        CheckMatrices(x.slice(s).col(i), sequences.slice(s).col(index));
+    }
+    numSequences += x.n_cols;
+  }
+  REQUIRE(numSequences == 50);
+
+  // Chunked sources: batches do not span chunks.
+  REQUIRE(data::Save("test_predictors.bin", predictors, false, true,
+      FileType::ArmaBinary) == true);
+  REQUIRE(data::Save("test_responses.bin", responses, false, true,
+      FileType::ArmaBinary) == true);
+  {
+    data::ChunkedSource<double> predictorsSource("test_predictors.bin", 250,
+        false);
+    data::ChunkedSource<double> responsesSource("test_responses.bin", 250,
+        false);
+    data::BatchPrefetcher<arma::mat> prefetcher(predictorsSource,
+        responsesSource, 100);
+    REQUIRE(prefetcher.NumBatches() == 13);
+
+    arma::mat x, y;
+    arma::uvec seen(1003, arma::fill::zeros);
+    size_t numBatches = 0;
+    while (prefetcher.Next(x, y))
+    {
+      REQUIRE(arma::approx_equal(x.row(0), y, "absdiff", 0.0));
+      for (size_t i = 0; i < x.n_cols; ++i)
+      {
+        // Points stay in their chunk.
+        const size_t index = (size_t) x(0, i);
+        REQUIRE(index / 250 == (size_t) x(0, 0) / 250);
+        ++seen[index];
+      }
+      ++numBatches;
+    }
+
+    REQUIRE(numBatches == 13);
+    REQUIRE(arma::all(seen == 1));
+
+    // Errors of the transformation are given to the consumer.
+    prefetcher.Transform() = [](arma::mat& /* x */, arma::mat& /* y */)
+    {
+      throw std::runtime_error("transformation error");
+    };
+    prefetcher.Reset();
+    REQUIRE_THROWS_AS(prefetcher.Next(x, y), std::runtime_error);
+  }
+
+  remove("test_predictors.bin");
+  remove("test_responses.bin");
+}
+
 /**
  * Make sure ColVec can be loaded.
  */
@@ -1242,6 +1483,122 @@ TEST_CASE("SaveHDF5Test", "[LoadSaveTest]")
   remove("test_file.he5");
 }
 
+/**
+ * Make sure a dataset written in blocks with HDF5Writer can be loaded back, and
+ * that parts of it can be read without loading the rest.
+ */
+TEST_CASE("HDF5PartialIOTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(7, 250, arma::fill::randu);
+
+  for (const bool transpose : { true, false })
+  {
+    data::HDF5Writer<double> writer("test_partial.h5", 7, transpose, 32);
+    for (size_t i = 0; i < dataset.n_cols; i += 60)
+    {
+      writer.Append(dataset.cols(i, std::min(i + 59,
+          (size_t) dataset.n_cols - 1)));
+    }
+    REQUIRE(writer.NumPoints() == 250);
+    writer.Close();
+
+    REQUIRE_THROWS_AS(writer.Append(dataset.cols(0, 1)), std::runtime_error);
+
+    arma::mat loaded;
+    REQUIRE(data::Load("test_partial.h5", loaded, true, transpose));
+    CheckMatrices(loaded, dataset);
+
+    size_t rows, cols;
+    data::HDF5Size("test_partial.h5", rows, cols);
+    REQUIRE(rows == (transpose ? 250 : 7));
+    REQUIRE(cols == (transpose ? 7 : 250));
+
+    // Read a range and a selection of points.
+    const arma::uvec indices = { 200, 3, 4, 5, 249, 3, 0 };
+    arma::mat range, selection;
+    if (transpose)
+    {
+      data::LoadHDF5Rows("test_partial.h5", range, 100, 50);
+      data::LoadHDF5Rows("test_partial.h5", selection, indices);
+      arma::inplace_trans(range);
+      arma::inplace_trans(selection);
+    }
+    else
+    {
+      data::LoadHDF5Columns("test_partial.h5", range, 100, 50);
+      data::LoadHDF5Columns("test_partial.h5", selection, indices);
+    }
+
+    CheckMatrices(range, dataset.cols(100, 149));
+    CheckMatrices(selection, dataset.cols(indices));
+
+    // Out of bounds reads are errors.
+    if (transpose)
+    {
+      REQUIRE_THROWS_AS(data::LoadHDF5Rows("test_partial.h5", range, 240, 20),
+          std::invalid_argument);
+    }
+    else
+    {
+      REQUIRE_THROWS_AS(data::LoadHDF5Columns("test_partial.h5", range,
+          arma::uvec({ 1, 250 })), std::invalid_argument);
+    }
+  }
+
+  data::HDF5Writer<double> writer("test_partial.h5", 7);
+  REQUIRE_THROWS_AS(writer.Append(arma::mat(6, 10)), std::invalid_argument);
+  writer.Close();
+
+  remove("test_partial.h5");
+}
+
+/**
+ * Make sure ChunkedSource can read selected points of an HDF5 file, and that
+ * data::Split() selects the same points as for an in-memory dataset.
+ */
+TEST_CASE("HDF5ChunkedSplitTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(5, 300, arma::fill::randu);
+  REQUIRE(data::Save("test_split.h5", dataset));
+
+  data::ChunkedSource<double> train("test_split.h5", 64);
+  data::ChunkedSource<double> test("test_split.h5", 64);
+
+  const size_t seed = 42;
+  RandomSeed(seed);
+  data::Split(train, test, 0.3);
+  REQUIRE(train.NumPoints() == 210);
+  REQUIRE(test.NumPoints() == 90);
+
+  arma::mat expectedTrain, expectedTest;
+  RandomSeed(seed);
+  data::Split(dataset, expectedTrain, expectedTest, 0.3);
+
+  for (size_t pass = 0; pass < 2; ++pass)
+  {
+    arma::mat chunk, trainData, testData;
+    while (train.Next(chunk))
+      trainData = arma::join_rows(trainData, chunk);
+    while (test.Next(chunk))
+      testData = arma::join_rows(testData, chunk);
+
+    CheckMatrices(trainData, expectedTrain);
+    CheckMatrices(testData, expectedTest);
+
+    train.Reset();
+    test.Reset();
+  }
+
+  // After ClearPoints(), the whole dataset is read again.
+  train.ClearPoints();
+  REQUIRE(train.NumPoints() == 300);
+
+  REQUIRE_THROWS_AS(train.SetPoints(arma::uvec({ 300 })),
+      std::invalid_argument);
+
+  remove("test_split.h5");
+}
+
 #endif
 
 /**
@@ -2362,6 +2719,117 @@ TEST_CASE("CategoryCaseTest", "[LoadSaveTest]")
   remove("test.arff");
 }
 
+/**
+ * Load an ARFF file with enough lines to be parsed by several threads, and make
+ * sure that the categories are mapped in order of first occurrence, and that
+ * the error on the first bad line is reported.
+ */
+TEST_CASE("LargeCategoricalARFFTest", "[LoadSaveTest]")
+{
+  const std::vector<std::string> names = { "dog", "cat", "\"big bird\"",
+      "fish" };
+  fstream f;
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << "@attribute animal string" << endl;
+  f << "@attribute value numeric" << endl;
+  f << "@attribute size {small, large}" << endl;
+  f << "@data" << endl;
+  for (size_t i = 0; i < 5000; ++i)
+  {
+    f << names[(i * i) % 4] << ", " << i << ", "
+        << ((i % 3 == 0) ? "large" : "small") << endl;
+    // Empty lines and comments are ignored.
+    if (i % 1000 == 0)
+      f << endl << "% comment" << endl;
+  }
+  f.close();
+
+  arma::mat dataset;
+  DatasetInfo info;
+  REQUIRE(data::Load("test.arff", dataset, info));
+
+  REQUIRE(dataset.n_rows == 3);
+  REQUIRE(dataset.n_cols == 5000);
+  // (i * i) % 4 is 0 or 1, and dog comes first.
+  REQUIRE(info.NumMappings(0) == 2);
+  REQUIRE(info.NumMappings(2) == 2);
+  for (size_t i = 0; i < 5000; ++i)
+  {
+    REQUIRE(dataset(0, i) == (double) ((i * i) % 4));
+    REQUIRE(dataset(1, i) == (double) i);
+    REQUIRE(dataset(2, i) == ((i % 3 == 0) ? 1.0 : 0.0));
+  }
+
+  // Now add two bad lines; the first one must be reported.
+  f.open("test.arff", fstream::app | fstream::out);
+  f << "fish, 3, medium" << endl;
+  f << "fish, x3, small" << endl;
+  f << "fish, 4, tiny" << endl;
+  f.close();
+
+  info = DatasetInfo();
+  try
+  {
+    data::LoadARFF("test.arff", dataset, info);
+    FAIL("Loading should have failed");
+  }
+  catch (std::runtime_error& e)
+  {
+    REQUIRE(std::string(e.what()).find("\"medium\"") != std::string::npos);
+  }
+
+  remove("test.arff");
+}
+
+/**
+ * Load a categorical CSV with enough lines to be parsed by several threads, in
+ * both orientations, and make sure that the mappings are in order of first
+ * occurrence.
+ */
+TEST_CASE("LargeCategoricalCSVTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.csv", fstream::out);
+  for (size_t i = 0; i < 3000; ++i)
+  {
+    f << i << ", " << "c" << ((7 * i) % 10) << ", \"a, " << (i % 2) << "\""
+        << endl;
+  }
+  f.close();
+
+  arma::mat dataset;
+  DatasetInfo info;
+  REQUIRE(data::Load("test.csv", dataset, info, true, true));
+
+  REQUIRE(dataset.n_rows == 3);
+  REQUIRE(dataset.n_cols == 3000);
+  REQUIRE(info.Type(0) == Datatype::numeric);
+  REQUIRE(info.Type(1) == Datatype::categorical);
+  REQUIRE(info.Type(2) == Datatype::categorical);
+  REQUIRE(info.NumMappings(1) == 10);
+  REQUIRE(info.NumMappings(2) == 2);
+  for (size_t i = 0; i < 3000; ++i)
+  {
+    REQUIRE(dataset(0, i) == (double) i);
+    // The categories of dimension 1 appear for the first time in the order
+    // c0, c7, c4, c1, ..., so category c(7i % 10) is mapped to i % 10.
+    REQUIRE(dataset(1, i) == (double) (i % 10));
+    REQUIRE(dataset(2, i) == (double) (i % 2));
+  }
+  REQUIRE(info.UnmapString(1, 2) == "\"a, 1\"");
+
+  // Each line is a dimension if the data is not transposed.
+  arma::mat t;
+  DatasetInfo tInfo;
+  REQUIRE(data::Load("test.csv", t, tInfo, true, false));
+  REQUIRE(t.n_rows == 3000);
+  REQUIRE(t.n_cols == 3);
+  REQUIRE(tInfo.Dimensionality() == 3000);
+
+  remove("test.csv");
+}
+
 /**
  * Test that a CSV with the wrong number of columns fails.
  */
@@ -2555,3 +3023,99 @@ TEST_CASE("LoadCSVHeaderTest", "[LoadSaveTest]")
   REQUIRE(dataset.n_rows == 4);
   REQUIRE(dataset.n_cols == 2);
 }
+
+/**
+ * Save a matrix and its DatasetInfo in the mapped format, and make sure that
+ * mapping the file gives the same matrix and mappings, without copying.
+ */
+TEST_CASE("SaveLoadMappedMatrixTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(5, 1000, arma::fill::randu);
+  DatasetInfo info(5);
+  info.Type(1) = Datatype::categorical;
+  info.MapString<size_t>("red", 1);
+  info.MapString<size_t>("green", 1);
+  info.MapString<size_t>("blue", 1);
+  dataset.row(1) = arma::floor(dataset.row(1) * 3);
+
+  REQUIRE(data::SaveMapped("test_mapped.mlm", dataset, info));
+
+  MappedMatrix<double> mapped;
+  REQUIRE(data::Load("test_mapped.mlm", mapped));
+  REQUIRE(mapped.IsMapped());
+
+  const arma::mat& loaded = mapped.Matrix();
+  REQUIRE(loaded.n_rows == 5);
+  REQUIRE(loaded.n_cols == 1000);
+  REQUIRE(arma::approx_equal(loaded, dataset, "absdiff", 0.0));
+  // The data starts on a page boundary.
+  REQUIRE(((size_t) loaded.memptr()) % 4096 == 0);
+
+  REQUIRE(mapped.Info().Dimensionality() == 5);
+  REQUIRE(mapped.Info().Type(0) == Datatype::numeric);
+  REQUIRE(mapped.Info().Type(1) == Datatype::categorical);
+  REQUIRE(mapped.Info().NumMappings(1) == 3);
+  REQUIRE(mapped.Info().UnmapString(0, 1) == "red");
+  REQUIRE(mapped.Info().UnmapString(2, 1) == "blue");
+
+  // A second mapping of the same file gives the same data.
+  MappedMatrix<double> mapped2("test_mapped.mlm");
+  REQUIRE(arma::approx_equal(mapped2.Matrix(), dataset, "absdiff", 0.0));
+
+  mapped.Close();
+  REQUIRE(mapped.Matrix().n_elem == 0);
+
+  remove("test_mapped.mlm");
+}
+
+/**
+ * Mapping a file with the wrong element type, or a file that is not in the
+ * mapped format, must fail.
+ */
+TEST_CASE("LoadMappedMatrixInvalidTest", "[LoadSaveTest]")
+{
+  arma::fmat dataset(3, 10, arma::fill::randu);
+  REQUIRE(data::SaveMapped("test_mapped.mlm", dataset));
+
+  MappedMatrix<double> wrongType;
+  REQUIRE(!data::Load("test_mapped.mlm", wrongType));
+  REQUIRE_THROWS_AS(MappedMatrix<double>("test_mapped.mlm"),
+      std::runtime_error);
+
+  MappedMatrix<float> mapped("test_mapped.mlm");
+  REQUIRE(arma::approx_equal(mapped.Matrix(), dataset, "absdiff", 0.0));
+  REQUIRE(mapped.Info().Dimensionality() == 3);
+  mapped.Close();
+
+  fstream f;
+  f.open("test_mapped.mlm", fstream::out);
+  f << "1, 2, 3, 4" << endl;
+  f.close();
+  MappedMatrix<float> invalid;
+  REQUIRE(!data::Load("test_mapped.mlm", invalid));
+  REQUIRE(!data::Load("nonexistent_mapped.mlm", invalid));
+
+  // A DatasetInfo with the wrong dimensionality cannot be saved.
+  REQUIRE(!data::SaveMapped("test_mapped.mlm", dataset, DatasetInfo(4)));
+
+  remove("test_mapped.mlm");
+}
+
+/**
+ * Make sure that FirstTouch() keeps the contents and the size of a loaded
+ * matrix.
+ */
+TEST_CASE("FirstTouchTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(7, 1003, arma::fill::randu);
+  const arma::mat original = dataset;
+
+  data::FirstTouch(dataset);
+  REQUIRE(dataset.n_rows == 7);
+  REQUIRE(dataset.n_cols == 1003);
+  CheckMatrices(dataset, original);
+
+  arma::mat empty;
+  data::FirstTouch(empty);
+  REQUIRE(empty.n_elem == 0);
+}
@@ -204,3 +204,31 @@ TEMPLATE_TEST_CASE("LocalCoordinateCodingTrainReturnObjective",
 
   REQUIRE(std::isfinite(objVal) == true);
 }
+
+/**
+ * Make sure that the points encoded in parallel get the same codes as when they
+ * are encoded one after another.
+ */
+TEST_CASE("LocalCoordinateCodingParallelEncodeTest",
+    "[LocalCoordinateCodingTest]")
+{
+  arma::mat X;
+  X.load("mnist_first250_training_4s_and_9s.csv");
+  for (uword i = 0; i < X.n_cols; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  LocalCoordinateCoding<arma::mat> lcc(X, 10, 0.1, 2);
+
+  arma::mat Z;
+  lcc.Encode(X, Z);
+  REQUIRE(Z.n_rows == 10);
+  REQUIRE(Z.n_cols == X.n_cols);
+
+  // Encode each point on its own.
+  for (uword i = 0; i < X.n_cols; i += 25)
+  {
+    arma::mat z;
+    lcc.Encode(X.col(i), z);
+    REQUIRE(arma::approx_equal(z.col(0), Z.col(i), "absdiff", 1e-10));
+  }
+}
@@ -694,6 +694,49 @@ TEST_CASE("LogisticRegressionSGDGaussianTest", "[LogisticRegressionTest]")
   REQUIRE(testAcc == Approx(100.0).epsilon(0.006)); // 0.6% error tolerance.
 }
 
+/**
+ * Make sure that logistic regression can be trained on data that is read from
+ * disk in chunks.
+ */
+TEST_CASE("LogisticRegressionChunkedSourceTest", "[LogisticRegressionTest]")
+{
+  // Generate a two-Gaussian dataset, with the classes interleaved so that each
+  // chunk contains points of both classes.
+  GaussianDistribution<> g1(arma::vec("1.0 1.0 1.0"),
+      arma::eye<arma::mat>(3, 3));
+  GaussianDistribution<> g2(arma::vec("9.0 9.0 9.0"),
+      arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, 1000);
+  arma::Row<size_t> responses(1000);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    data.col(i) = (i % 2 == 0) ? g1.Random() : g2.Random();
+    responses[i] = (i % 2);
+  }
+
+  REQUIRE(data::Save("lr_chunked_data.csv", data) == true);
+  REQUIRE(data::Save("lr_chunked_labels.csv", responses) == true);
+
+  data::ChunkedSource<double> dataSource("lr_chunked_data.csv", 100);
+  data::ChunkedSource<size_t> labelsSource("lr_chunked_labels.csv", 100);
+  REQUIRE(dataSource.Dimensionality() == 3);
+  REQUIRE(dataSource.NumPoints() == 1000);
+  REQUIRE(labelsSource.Dimensionality() == 1);
+  REQUIRE(labelsSource.NumPoints() == 1000);
+
+  // Make one pass over each chunk for each epoch.
+  ens::StandardSGD sgd(0.01, 1, 100, 1e-10);
+  LogisticRegression<> lr(data.n_rows, 0.5);
+  lr.Train(dataSource, labelsSource, sgd, 5);
+
+  const double acc = lr.ComputeAccuracy(data, responses);
+  REQUIRE(acc == Approx(100.0).epsilon(0.01)); // 1% error tolerance.
+
+  remove("lr_chunked_data.csv");
+  remove("lr_chunked_labels.csv");
+}
+
 /**
  * Test constructor that takes an already-instantiated optimizer.
  */
@@ -836,6 +879,60 @@ TEST_CASE("LogisticRegressionSparseSGDTest", "[LogisticRegressionTest]")
         Approx(lrSparse.Parameters()[i]).epsilon(1e-5));
 }
 
+/**
+ * Make sure that the sparse kernels of LogisticRegressionFunction give the same
+ * objective and gradients as the dense computation, for the whole dataset and
+ * for batches.
+ */
+TEST_CASE("LogisticRegressionFunctionSparseGradientTest",
+          "[LogisticRegressionTest]")
+{
+  arma::sp_mat dataset;
+  dataset.sprandu(50, 300, 0.05);
+  arma::mat denseDataset(dataset);
+  arma::Row<size_t> labels(300);
+  for (size_t i = 0; i < 300; ++i)
+    labels[i] = RandInt(0, 2);
+
+  LogisticRegressionFunction<> lrf(denseDataset, labels, 0.4);
+  LogisticRegressionFunction<arma::sp_mat> lrfSparse(dataset, labels, 0.4);
+
+  arma::rowvec parameters(51, arma::fill::randn);
+
+  REQUIRE(lrfSparse.Evaluate(parameters) ==
+      Approx(lrf.Evaluate(parameters)).epsilon(1e-7));
+
+  arma::rowvec gradient, sparseGradient;
+  lrf.Gradient(parameters, gradient);
+  lrfSparse.Gradient(parameters, sparseGradient);
+  REQUIRE(arma::approx_equal(gradient, sparseGradient, "absdiff", 1e-8));
+
+  REQUIRE(lrfSparse.EvaluateWithGradient(parameters, sparseGradient) ==
+      Approx(lrf.Evaluate(parameters)).epsilon(1e-7));
+  REQUIRE(arma::approx_equal(gradient, sparseGradient, "absdiff", 1e-8));
+
+  for (size_t begin = 0; begin < 300; begin += 30)
+  {
+    REQUIRE(lrfSparse.Evaluate(parameters, begin, 30) ==
+        Approx(lrf.Evaluate(parameters, begin, 30)).epsilon(1e-7));
+
+    lrf.Gradient(parameters, begin, gradient, 30);
+    lrfSparse.Gradient(parameters, begin, sparseGradient, 30);
+    REQUIRE(arma::approx_equal(gradient, sparseGradient, "absdiff", 1e-8));
+
+    lrfSparse.EvaluateWithGradient(parameters, begin, sparseGradient, 30);
+    REQUIRE(arma::approx_equal(gradient, sparseGradient, "absdiff", 1e-8));
+  }
+
+  // Check the partial gradient of a few features.
+  for (size_t j = 0; j < 51; j += 10)
+  {
+    lrf.PartialGradient(parameters, j, gradient);
+    lrfSparse.PartialGradient(parameters, j, sparseGradient);
+    REQUIRE(sparseGradient[j] == Approx(gradient[j]).epsilon(1e-7));
+  }
+}
+
 /**
  * Test multi-point classification (Classify()).
  */
@@ -1271,3 +1368,25 @@ TEST_CASE("LogisticRegressionResetTest", "[LogisticRegressionTest]")
   REQUIRE(
       !arma::approx_equal(lr1.Parameters(), lr2.Parameters(), "absdiff", 1e-5));
 }
+
+/**
+ * Make sure that the scorer of the model gives the same labels as the model,
+ * for different decision boundaries.
+ */
+TEST_CASE("LogisticRegressionScorerTest", "[LogisticRegressionTest]")
+{
+  arma::mat data(5, 300, arma::fill::randn);
+  LogisticRegression<> lr(data.n_rows);
+  lr.Parameters().randn();
+
+  for (const double decisionBoundary : { 0.3, 0.5, 0.8 })
+  {
+    arma::Row<size_t> labels, scorerLabels;
+    lr.Classify(data, labels, decisionBoundary);
+
+    LinearScorer<> scorer = lr.Scorer(decisionBoundary);
+    REQUIRE(scorer.NumClasses() == 2);
+    scorer.Classify(data, scorerLabels);
+    REQUIRE(all(labels == scorerLabels));
+  }
+}
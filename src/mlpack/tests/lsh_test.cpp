@@ -921,6 +921,91 @@ TEST_CASE("LSHTestMoveOperatorTest", "[LSHTest]")
   CheckMatrices(distances, distances2);
 }
 
+/**
+ * Make sure that the rows of the second hash table are laid out contiguously,
+ * within the bucket size, and that each reference point is held at most once
+ * per table.
+ */
+TEST_CASE("LSHBucketLayoutTest", "[LSHTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 2000);
+  const size_t numTables = 8;
+  const size_t bucketSize = 50;
+
+  LSHSearch<> lsh(dataset, 3, numTables, 0.0, 99901, bucketSize);
+
+  const arma::Col<size_t>& offsets = lsh.BucketOffsets();
+  const arma::Col<size_t>& contents = lsh.BucketContents();
+  REQUIRE(offsets.n_elem > 1);
+  REQUIRE(offsets[0] == 0);
+  REQUIRE(offsets[offsets.n_elem - 1] == contents.n_elem);
+  REQUIRE(contents.n_elem <= numTables * dataset.n_cols);
+
+  for (size_t r = 0; r + 1 < offsets.n_elem; ++r)
+  {
+    REQUIRE(offsets[r] < offsets[r + 1]);
+    REQUIRE(offsets[r + 1] - offsets[r] <= bucketSize);
+  }
+
+  arma::Col<size_t> count(dataset.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < contents.n_elem; ++i)
+  {
+    REQUIRE(contents[i] < dataset.n_cols);
+    ++count[contents[i]];
+  }
+  REQUIRE(count.max() <= numTables);
+
+  // Every non-empty hash value points to a valid row, and every row is pointed
+  // to exactly once.
+  const arma::Col<size_t>& rows = lsh.BucketRowInHashTable();
+  arma::Col<size_t> rowSeen(offsets.n_elem - 1, arma::fill::zeros);
+  for (size_t h = 0; h < rows.n_elem; ++h)
+  {
+    if (rows[h] == rows.n_elem)
+      continue;
+
+    REQUIRE(rows[h] < rowSeen.n_elem);
+    ++rowSeen[rows[h]];
+  }
+  REQUIRE(rowSeen.min() == 1);
+  REQUIRE(rowSeen.max() == 1);
+}
+
+/**
+ * Make sure that searching a large query set, whose queries are projected in
+ * blocks, gives the same results as searching each query on its own.
+ */
+TEST_CASE("LSHBatchedQueryTest", "[LSHTest]")
+{
+  arma::mat rdata = arma::randu<arma::mat>(4, 1000);
+  arma::mat qdata = arma::randu<arma::mat>(4, 2500);
+  const size_t k = 3;
+
+  LSHSearch<> lsh(rdata, 4, 6);
+
+  // Use both single-probe and multiprobe LSH, and fewer tables than available.
+  for (size_t T = 0; T <= 3; T += 3)
+  {
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    lsh.Search(qdata, k, neighbors, distances, 4, T);
+
+    for (size_t i = 0; i < qdata.n_cols; ++i)
+    {
+      arma::Mat<size_t> singleNeighbors;
+      arma::mat singleDistances;
+      lsh.Search(arma::mat(qdata.col(i)), k, singleNeighbors, singleDistances,
+          4, T);
+
+      for (size_t j = 0; j < k; ++j)
+      {
+        REQUIRE(neighbors(j, i) == singleNeighbors(j, 0));
+        REQUIRE(distances(j, i) == singleDistances(j, 0));
+      }
+    }
+  }
+}
+
 /**
  * Run LSH on (identical) dense and sparse data, making sure that we get the
  * same results.  Note that the sparse data we are using isn't really
@@ -612,6 +612,67 @@ TEST_CASE_METHOD(KNNTestFixture, "KNNAllTreeTypesTest",
   }
 }
 
+/**
+ * Ensure that an HNSW graph finds the neighbors found by a kd-tree, and that
+ * ef can be changed on a saved model.
+ */
+TEST_CASE_METHOD(KNNTestFixture, "KNNHNSWTest",
+                 "[KNNMainTest][BindingTests]")
+{
+  arma::mat referenceData;
+  referenceData.randu(3, 100); // 100 points in 3 dimensions.
+
+  arma::mat queryData;
+  queryData.randu(3, 90); // 90 points in 3 dimensions.
+
+  SetInputParam("reference", referenceData);
+  SetInputParam("query", queryData);
+  SetInputParam("k", (int) 10);
+
+  RUN_BINDING();
+
+  arma::Mat<size_t> trueNeighbors =
+      std::move(params.Get<arma::Mat<size_t>>("neighbors"));
+  delete params.Get<KNNModel*>("output_model");
+  params.Get<KNNModel*>("output_model") = NULL;
+
+  ResetSettings();
+
+  SetInputParam("reference", referenceData);
+  SetInputParam("query", queryData);
+  SetInputParam("tree_type", (string) "hnsw");
+  SetInputParam("hnsw_m", (int) 8);
+  SetInputParam("ef", (int) 100);
+  SetInputParam("k", (int) 10);
+
+  RUN_BINDING();
+
+  arma::Mat<size_t> neighbors =
+      std::move(params.Get<arma::Mat<size_t>>("neighbors"));
+  REQUIRE(neighbors.n_rows == 10);
+  REQUIRE(neighbors.n_cols == 90);
+  REQUIRE(KNN::Recall(neighbors, trueNeighbors) > 0.95);
+
+  KNNModel* model = params.Get<KNNModel*>("output_model");
+  params.Get<KNNModel*>("output_model") = NULL;
+  REQUIRE(model->TreeType() == KNNModel::HNSW);
+  REQUIRE(model->HNSWM() == 8);
+
+  CleanMemory();
+  ResetSettings();
+
+  // Reuse the model with a different ef.
+  SetInputParam("input_model", model);
+  SetInputParam("query", queryData);
+  SetInputParam("ef", (int) 10);
+  SetInputParam("k", (int) 10);
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<KNNModel*>("output_model")->Ef() == 10);
+  REQUIRE(params.Get<arma::Mat<size_t>>("neighbors").n_cols == 90);
+}
+
 /**
   * Ensure that different leaf sizes give different results.
  */
@@ -1003,3 +1003,141 @@ TEST_CASE("InplaceSparseShuffleWeightsTest", "[MathTest]")
     REQUIRE(weightCounts[i] == 1);
   }
 }
+
+/**
+ * Make sure that the LinearScorer computes the right scores and labels, for
+ * single points, batches, and top-k selection.
+ */
+TEST_CASE("LinearScorerTest", "[MathTest]")
+{
+  arma::mat weights(6, 5, arma::fill::randn);
+  arma::vec biases(5, arma::fill::randn);
+  arma::mat data(6, 200, arma::fill::randn);
+
+  LinearScorer<> scorer(weights, biases);
+  REQUIRE(scorer.NumClasses() == 5);
+  REQUIRE(scorer.Dimensionality() == 6);
+
+  const arma::mat expectedScores = weights.t() * data +
+      repmat(biases, 1, data.n_cols);
+
+  arma::mat scores;
+  arma::Row<size_t> labels;
+  scorer.Classify(data, labels, scores);
+  REQUIRE(approx_equal(scores, expectedScores, "absdiff", 1e-10));
+
+  // The buffer should be reused if it already has the right size.
+  const double* memory = scores.memptr();
+  scorer.Scores(data, scores);
+  REQUIRE(scores.memptr() == memory);
+
+  arma::Mat<size_t> top;
+  scorer.TopK(data, 3, top, scores);
+  REQUIRE(top.n_rows == 3);
+  REQUIRE(top.n_cols == data.n_cols);
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    const arma::uvec order = arma::sort_index(expectedScores.col(i),
+        "descend");
+    REQUIRE(labels[i] == order[0]);
+    REQUIRE(scorer.Classify(data.col(i)) == order[0]);
+    for (size_t j = 0; j < 3; ++j)
+      REQUIRE(top(j, i) == order[j]);
+  }
+
+  // Without biases, the scores are just the products.
+  LinearScorer<> noBiasScorer(weights);
+  noBiasScorer.Scores(data, scores);
+  REQUIRE(approx_equal(scores, weights.t() * data, "absdiff", 1e-10));
+
+  REQUIRE_THROWS_AS(scorer.TopK(data, 6, top, scores), std::invalid_argument);
+  REQUIRE_THROWS_AS(LinearScorer<>(weights, arma::vec(3)),
+      std::invalid_argument);
+}
+
+/**
+ * Adding the blocks of a matrix to a TallSkinnyQR object, or merging the
+ * decompositions of parts of the matrix, should give the R factor of the whole
+ * matrix.
+ */
+TEST_CASE("TallSkinnyQRTest", "[MathTest]")
+{
+  arma::mat data = arma::randn<arma::mat>(300, 6);
+
+  TallSkinnyQR<arma::mat> tsqr(6), first(6), second(6);
+  for (size_t i = 0; i < 300; i += 50)
+  {
+    tsqr.Add(data.rows(i, i + 49));
+    if (i < 100)
+      first.Add(data.rows(i, i + 49));
+    else
+      second.Add(data.rows(i, i + 49));
+  }
+  first.Merge(second);
+
+  REQUIRE(tsqr.Rows() == 300);
+  REQUIRE(first.Rows() == 300);
+
+  // R^T R = A^T A does not depend on the signs of the rows of R.
+  const arma::mat gram = data.t() * data;
+  REQUIRE(arma::approx_equal(tsqr.R().t() * tsqr.R(), gram, "reldiff", 1e-8));
+  REQUIRE(arma::approx_equal(first.R().t() * first.R(), gram, "reldiff",
+      1e-8));
+  REQUIRE(arma::norm(arma::trimatu(tsqr.R()) - tsqr.R()) == 0.0);
+
+  REQUIRE_THROWS_AS(tsqr.Add(arma::mat(3, 5)), std::invalid_argument);
+}
+
+/**
+ * Make sure that ColumnMoments gives the same statistics as a direct
+ * computation, when the data is given in several blocks and merged.
+ */
+TEST_CASE("ColumnMomentsTest", "[MathTest]")
+{
+  // Use a large mean, to check the numerical stability of the updates.
+  arma::mat data = arma::exp(arma::randn<arma::mat>(5, 5000)) + 1e4;
+
+  ColumnMoments<arma::mat> moments(0, true), first(5, true), second(5, true);
+  moments.Add(data.cols(0, 2999));
+  moments.Add(data.cols(3000, 4999));
+  first.Add(data.cols(0, 9));
+  second.Add(data.cols(10, 4999));
+  first.Merge(second);
+
+  REQUIRE(moments.Count() == 5000);
+  REQUIRE(first.Count() == 5000);
+  for (const ColumnMoments<arma::mat>* m : { &moments, &first })
+  {
+    REQUIRE(arma::approx_equal(m->Mean(), arma::vec(arma::mean(data, 1)),
+        "reldiff", 1e-12));
+    REQUIRE(arma::approx_equal(m->Min(), arma::vec(arma::min(data, 1)),
+        "absdiff", 0.0));
+    REQUIRE(arma::approx_equal(m->Max(), arma::vec(arma::max(data, 1)),
+        "absdiff", 0.0));
+    REQUIRE(arma::approx_equal(m->Variance(), arma::vec(arma::var(data, 0,
+        1)), "reldiff", 1e-8));
+    REQUIRE(arma::approx_equal(m->StandardDeviation(true),
+        arma::vec(arma::stddev(data, 1, 1)), "reldiff", 1e-8));
+    REQUIRE(arma::approx_equal(m->Covariance(), ColumnCovariance(data),
+        "absdiff", 1e-8));
+
+    for (size_t d = 0; d < 5; ++d)
+    {
+      const arma::rowvec centered = data.row(d) - arma::mean(data.row(d));
+      const double m2 = arma::accu(arma::pow(centered, 2));
+      const double m3 = arma::accu(arma::pow(centered, 3));
+      const double m4 = arma::accu(arma::pow(centered, 4));
+      REQUIRE(m->Skewness(true)[d] ==
+          Approx(m3 / (5000 * std::pow(m2 / 5000, 1.5))).epsilon(1e-7));
+      REQUIRE(m->Kurtosis(true)[d] ==
+          Approx(5000 * m4 / (m2 * m2) - 3).epsilon(1e-7));
+    }
+  }
+
+  REQUIRE_THROWS_AS(moments.Add(arma::mat(3, 5)), std::invalid_argument);
+
+  ColumnMoments<arma::mat> noCovariance;
+  noCovariance.Add(data);
+  REQUIRE_THROWS_AS(noCovariance.Covariance(), std::logic_error);
+}
@@ -59,3 +59,76 @@ TEST_CASE("UniformMatrixCompletionSDP", "[MatrixCompletionTest]")
        Approx(Xorig(indices(0, i), indices(1, i))).epsilon(1e-7));
   }
 }
+
+/**
+ * SoftImpute without regularization should recover a random low-rank matrix
+ * from a fraction of its entries.
+ */
+TEST_CASE("SoftImputeLowRankRecovery", "[MatrixCompletionTest]")
+{
+  const size_t m = 200;
+  const size_t n = 150;
+  arma::mat x = arma::randn<arma::mat>(m, 3) * arma::randn<arma::mat>(3, n);
+
+  // Observe half of the entries.
+  std::vector<size_t> known;
+  for (size_t i = 0; i < m * n; ++i)
+    if (arma::randu() < 0.5)
+      known.push_back(i);
+
+  arma::umat indices(2, known.size());
+  arma::vec values(known.size());
+  for (size_t i = 0; i < known.size(); ++i)
+  {
+    indices(0, i) = known[i] % m;
+    indices(1, i) = known[i] / m;
+    values(i) = x(indices(0, i), indices(1, i));
+  }
+
+  SoftImpute si(m, n, indices, values, 3, 0.0, 500, 1e-12, 2);
+  arma::mat u, v;
+  arma::vec s;
+  si.Recover(u, s, v);
+
+  REQUIRE(s.n_elem == 3);
+  REQUIRE(u.n_rows == m);
+  REQUIRE(v.n_rows == n);
+  REQUIRE(si.Iterations() > 0);
+  REQUIRE(si.Iterations() <= 500);
+
+  arma::mat recovered;
+  si.Recover(recovered);
+  const double err = arma::norm(x - recovered, "fro") / arma::norm(x, "fro");
+  REQUIRE(err == Approx(0.0).margin(1e-3));
+}
+
+/**
+ * A regularization larger than every singular value gives the zero matrix, and
+ * invalid problems are rejected.
+ */
+TEST_CASE("SoftImputeRegularizationAndErrors", "[MatrixCompletionTest]")
+{
+  arma::umat indices = { { 0, 1, 2, 3 }, { 0, 1, 1, 2 } };
+  arma::vec values = { 1.0, -2.0, 0.5, 3.0 };
+
+  SoftImpute si(4, 3, indices, values, 2, 100.0);
+  arma::mat recovered;
+  si.Recover(recovered);
+  REQUIRE(recovered.n_rows == 4);
+  REQUIRE(recovered.n_cols == 3);
+  REQUIRE(arma::accu(arma::abs(recovered)) == 0.0);
+
+  // With a moderate regularization, the solution is not zero.
+  si.Lambda() = 0.5;
+  si.Recover(recovered);
+  REQUIRE(recovered.is_finite());
+  REQUIRE(arma::norm(recovered, "fro") > 0.0);
+
+  arma::umat badIndices = { { 0, 4 }, { 0, 1 } };
+  REQUIRE_THROWS_AS(SoftImpute(4, 3, badIndices, arma::vec(2), 2),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(SoftImpute(4, 3, indices, arma::vec(3), 2),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(SoftImpute(4, 3, indices, values, 0),
+      std::invalid_argument);
+}
@@ -106,6 +106,36 @@ TEMPLATE_TEST_CASE("MeanShiftSimpleCentroidsOnlyTest", "[MeanShiftTest]", float,
   REQUIRE(centroids.n_cols == 3);
 }
 
+/**
+ * Use every point as a seed, and make sure that the duplicate centroids are
+ * removed: no two centroids are closer than the radius, and the result does
+ * not depend on the number of threads.
+ */
+TEST_CASE("MeanShiftNoSeedsDuplicatesTest", "[MeanShiftTest]")
+{
+  const arma::mat data = GetMeanShiftData<arma::mat>();
+
+  MeanShift<> meanShift(2.0);
+  arma::mat centroids;
+  meanShift.Cluster(data, centroids, false, false);
+
+  REQUIRE(centroids.n_cols == 3);
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+    for (size_t j = i + 1; j < centroids.n_cols; ++j)
+      REQUIRE(EuclideanDistance::Evaluate(centroids.col(i),
+          centroids.col(j)) >= 2.0);
+
+  #ifdef MLPACK_USE_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  arma::mat serialCentroids;
+  meanShift.Cluster(data, serialCentroids, false, false);
+  omp_set_num_threads(threads);
+
+  REQUIRE(arma::approx_equal(centroids, serialCentroids, "absdiff", 1e-10));
+  #endif
+}
+
 // Generate samples from four Gaussians, and make sure mean shift nearly
 // recovers those four centers.
 TEMPLATE_TEST_CASE("GaussianClustering", "[MeanShiftTest]", float, double)
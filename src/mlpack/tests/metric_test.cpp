@@ -219,6 +219,102 @@ TEST_CASE("NMSMetricTest", "[MetricTest]")
   CheckMatrices(desiredBoundingBox, selectedBoundingBox);
 }
 
+/**
+ * Compare the results of NMS on many random bounding boxes with a direct
+ * implementation of greedy non-maximal suppression.
+ */
+TEST_CASE("NMSMetricRandomTest", "[MetricTest]")
+{
+  const size_t n = 2000;
+  arma::mat bbox(4, n);
+  bbox.row(0) = arma::randu<arma::rowvec>(n) * 1000.0;
+  bbox.row(1) = arma::randu<arma::rowvec>(n) * 1000.0;
+  bbox.row(2) = 5.0 + arma::randu<arma::rowvec>(n) * 60.0;
+  bbox.row(3) = 5.0 + arma::randu<arma::rowvec>(n) * 60.0;
+  // A few large bounding boxes cover many cells of the grid.
+  bbox.submat(2, 0, 3, 9) *= 10.0;
+  const arma::vec confidenceScores(n, arma::fill::randu);
+
+  for (const double threshold : { 0.0, 0.3, 0.7 })
+  {
+    arma::uvec selectedIndices;
+    NMS<>::Evaluate(bbox, confidenceScores, selectedIndices, threshold);
+
+    // Visit the boxes by decreasing score, and keep each one that does not
+    // overlap too much with a box that was kept before.
+    const arma::uvec order = arma::sort_index(confidenceScores, "descend");
+    std::vector<size_t> desiredIndices;
+    for (size_t k = 0; k < n; ++k)
+    {
+      const size_t i = order[k];
+      bool keep = true;
+      for (const size_t j : desiredIndices)
+      {
+        const double width = std::min(bbox(0, i) + bbox(2, i),
+            bbox(0, j) + bbox(2, j)) - std::max(bbox(0, i), bbox(0, j));
+        const double height = std::min(bbox(1, i) + bbox(3, i),
+            bbox(1, j) + bbox(3, j)) - std::max(bbox(1, i), bbox(1, j));
+        if (width <= 0.0 || height <= 0.0)
+          continue;
+
+        const double intersection = width * height;
+        const double iou = intersection / (bbox(2, i) * bbox(3, i) +
+            bbox(2, j) * bbox(3, j) - intersection);
+        if (iou > threshold)
+        {
+          keep = false;
+          break;
+        }
+      }
+
+      if (keep)
+        desiredIndices.push_back(i);
+    }
+
+    REQUIRE(selectedIndices.n_elem == desiredIndices.size());
+    for (size_t i = 0; i < desiredIndices.size(); ++i)
+      REQUIRE(selectedIndices[i] == desiredIndices[i]);
+  }
+}
+
+/**
+ * The batch version of IoU must give the same results as the pairwise version.
+ */
+TEST_CASE("IoUMetricBatchTest", "[MetricTest]")
+{
+  arma::mat a(4, 30), b(4, 20);
+  a.rows(0, 1).randu();
+  b.rows(0, 1).randu();
+  a.rows(0, 1) *= 100.0;
+  b.rows(0, 1) *= 100.0;
+  a.rows(2, 3) = 1.0 + 50.0 * arma::randu<arma::mat>(2, 30);
+  b.rows(2, 3) = 1.0 + 50.0 * arma::randu<arma::mat>(2, 20);
+
+  arma::mat ious, distances;
+  IoU<>::Evaluate(a, b, ious);
+  IoUDistance<>::Evaluate(a, b, distances);
+  REQUIRE(ious.n_rows == 30);
+  REQUIRE(ious.n_cols == 20);
+  for (size_t i = 0; i < a.n_cols; ++i)
+  {
+    for (size_t j = 0; j < b.n_cols; ++j)
+    {
+      const arma::vec boxA = a.col(i), boxB = b.col(j);
+      REQUIRE(ious(i, j) ==
+          Approx(IoU<>::Evaluate(boxA, boxB)).epsilon(1e-10));
+      REQUIRE(distances(i, j) ==
+          Approx(IoUDistance<>::Evaluate(boxA, boxB)).epsilon(1e-10));
+    }
+  }
+
+  // Use the {x0, y0, x1, y1} representation.
+  a.rows(2, 3) += a.rows(0, 1);
+  b.rows(2, 3) += b.rows(0, 1);
+  arma::mat coordinateIous;
+  IoU<true>::Evaluate(a, b, coordinateIous);
+  REQUIRE(arma::approx_equal(ious, coordinateIous, "absdiff", 1e-10));
+}
+
 /**
  *
  */
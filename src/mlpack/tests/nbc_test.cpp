@@ -432,7 +432,8 @@ TEST_CASE("NBCResetTest", "[NBCTest]")
   nbc2.Reset();
   nbc2.Train(trainData, labels, 2);
 
-  REQUIRE(!approx_equal(nbc1.Probabilities(), nbc2.Probabilities(), "absdiff",
+  // The labels are the same, so only the means and variances should differ.
+  REQUIRE(approx_equal(nbc1.Probabilities(), nbc2.Probabilities(), "absdiff",
       1e-5));
   REQUIRE(!approx_equal(nbc1.Means(), nbc2.Means(), "absdiff", 1e-5));
   REQUIRE(!approx_equal(nbc1.Variances(), nbc2.Variances(), "absdiff", 1e-5));
@@ -498,3 +499,44 @@ TEMPLATE_TEST_CASE("NBCModelMatTypeTest", "[NBCTest]", float, double)
   REQUIRE(nbc.Variances().n_rows == data.n_rows);
   REQUIRE(nbc.Variances().n_cols == 4);
 }
+
+/**
+ * Test that training incrementally on mini-batches gives the same model as
+ * training on all of the data at once.
+ */
+TEMPLATE_TEST_CASE("NBCMiniBatchTrainTest", "[NBCTest]", arma::fmat, arma::mat)
+{
+  using MatType = TestType;
+
+  MatType data(5, 3000, arma::fill::randu);
+  arma::Row<size_t> labels =
+      arma::randi<arma::Row<size_t>>(3000, arma::distr_param(0, 2));
+  // Shift the classes so that their means differ.
+  data.row(0) += arma::conv_to<arma::Row<typename MatType::elem_type>>::from(
+      labels);
+
+  NaiveBayesClassifier<MatType> nbc1(data, labels, 3);
+
+  NaiveBayesClassifier<MatType> nbc2(data.n_rows, 3);
+  for (size_t i = 0; i < data.n_cols; i += 700)
+  {
+    const size_t end = std::min((size_t) data.n_cols, i + 700) - 1;
+    nbc2.Train(data.cols(i, end), labels.subvec(i, end), 3);
+  }
+
+  REQUIRE(approx_equal(nbc1.Probabilities(), nbc2.Probabilities(), "absdiff",
+      1e-5));
+  REQUIRE(approx_equal(nbc1.Means(), nbc2.Means(), "reldiff", 1e-4));
+  REQUIRE(approx_equal(nbc1.Variances(), nbc2.Variances(), "reldiff", 1e-3));
+
+  // Training the whole set with a single thread should give the same model.
+  #ifdef MLPACK_USE_OPENMP
+  const size_t prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  NaiveBayesClassifier<MatType> nbc3(data, labels, 3);
+  omp_set_num_threads(prevNumThreads);
+
+  REQUIRE(approx_equal(nbc1.Means(), nbc3.Means(), "reldiff", 1e-4));
+  REQUIRE(approx_equal(nbc1.Variances(), nbc3.Variances(), "reldiff", 1e-3));
+  #endif
+}
@@ -273,6 +273,128 @@ TEMPLATE_TEST_CASE("SoftmaxSeparableGradient", "[NCATest]", float, double)
   REQUIRE(gradient(1, 1) == Approx(-2.0 * -0.1435886).epsilon(0.0001));
 }
 
+/**
+ * Compute the softmax objective and its gradient directly, one pair at a time.
+ */
+void NaiveSoftmax(const arma::mat& data,
+                  const arma::Row<size_t>& labels,
+                  const arma::mat& coordinates,
+                  double& objective,
+                  arma::mat& gradient)
+{
+  const arma::mat stretched = coordinates * data;
+  arma::mat sum(data.n_rows, data.n_rows, arma::fill::zeros);
+  objective = 0.0;
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    arma::vec evals(data.n_cols);
+    for (size_t k = 0; k < data.n_cols; ++k)
+    {
+      evals[k] = (i == k) ? 0.0 : std::exp(-SquaredEuclideanDistance::Evaluate(
+          stretched.col(i), stretched.col(k)));
+    }
+    const double denominator = arma::accu(evals);
+    double p = 0.0;
+    for (size_t k = 0; k < data.n_cols; ++k)
+      if (labels[i] == labels[k])
+        p += evals[k] / denominator;
+    objective -= p;
+
+    for (size_t k = 0; k < data.n_cols; ++k)
+    {
+      const arma::vec x = data.col(i) - data.col(k);
+      const double same = (labels[i] == labels[k]) ? 1.0 : 0.0;
+      sum += (evals[k] / denominator) * (p - same) * x * x.t();
+    }
+  }
+
+  gradient = -2 * coordinates * sum;
+}
+
+/**
+ * Make sure the blocked computation of the objective and the gradient (with
+ * more points than a single block holds) gives the same results as a direct
+ * computation, and that the separable versions agree with it.
+ */
+TEST_CASE("SoftmaxBlockedEvaluationTest", "[NCATest]")
+{
+  arma::mat data(3, 1300, arma::fill::randu);
+  arma::Row<size_t> labels =
+      arma::randi<arma::Row<size_t>>(1300, arma::distr_param(0, 2));
+  arma::mat coordinates = 3.0 * arma::eye<arma::mat>(3, 3) +
+      0.2 * arma::randn<arma::mat>(3, 3);
+
+  double objective;
+  arma::mat gradient;
+  NaiveSoftmax(data, labels, coordinates, objective, gradient);
+
+  SoftmaxErrorFunction<> sef(data, labels);
+  arma::mat sefGradient;
+  sef.Gradient(coordinates, sefGradient);
+
+  REQUIRE(sef.Evaluate(coordinates) == Approx(objective).epsilon(1e-8));
+  REQUIRE(arma::approx_equal(sefGradient, gradient, "both", 1e-8, 1e-6));
+
+  // Sum the separable objectives and gradients over batches.
+  double separableObjective = 0.0;
+  arma::mat separableGradient(3, 3, arma::fill::zeros);
+  for (size_t begin = 0; begin < data.n_cols; begin += 500)
+  {
+    const size_t batchSize = std::min((size_t) 500, data.n_cols - begin);
+    arma::mat batchGradient;
+    separableObjective += sef.Evaluate(coordinates, begin, batchSize);
+    sef.Gradient(coordinates, begin, batchGradient, batchSize);
+    separableGradient += batchGradient;
+  }
+
+  REQUIRE(separableObjective == Approx(objective).epsilon(1e-8));
+  REQUIRE(arma::approx_equal(separableGradient, gradient, "both", 1e-8,
+      1e-6));
+}
+
+/**
+ * When the softmax is truncated to all the other points, the result must be the
+ * same as without truncation; with fewer neighbors, it must still be close,
+ * since the far points contribute little.
+ */
+TEST_CASE("SoftmaxTruncatedNeighborsTest", "[NCATest]")
+{
+  arma::mat data(2, 300, arma::fill::randu);
+  arma::Row<size_t> labels(300);
+  for (size_t i = 0; i < 300; ++i)
+    labels[i] = (data(0, i) > 0.5) ? 1 : 0;
+  const arma::mat coordinates = 10.0 * arma::eye<arma::mat>(2, 2);
+
+  SoftmaxErrorFunction<> sef(data, labels);
+  arma::mat gradient;
+  const double objective = sef.Evaluate(coordinates);
+  sef.Gradient(coordinates, gradient);
+
+  SoftmaxErrorFunction<> allSef(data, labels);
+  allSef.NumNeighbors() = 299;
+  arma::mat allGradient;
+  REQUIRE(allSef.Evaluate(coordinates) == Approx(objective).epsilon(1e-8));
+  allSef.Gradient(coordinates, allGradient);
+  REQUIRE(arma::approx_equal(allGradient, gradient, "both", 1e-8, 1e-6));
+
+  SoftmaxErrorFunction<> truncatedSef(data, labels);
+  truncatedSef.NumNeighbors() = 100;
+  REQUIRE(truncatedSef.Evaluate(coordinates) ==
+      Approx(objective).epsilon(0.01));
+  REQUIRE(truncatedSef.Evaluate(coordinates, 10, 20) ==
+      Approx(sef.Evaluate(coordinates, 10, 20)).epsilon(0.01));
+
+  // NCA uses the same truncation.
+  L_BFGS lbfgs;
+  lbfgs.MaxIterations() = 10;
+  NCA nca;
+  nca.NumNeighbors() = 100;
+  arma::mat outputMatrix;
+  nca.LearnDistance(data, labels, outputMatrix, lbfgs);
+  REQUIRE(sef.Evaluate(outputMatrix) < sef.Evaluate(
+      arma::eye<arma::mat>(2, 2)));
+}
+
 //
 // Tests for the NCA algorithm.
 //
@@ -240,6 +240,57 @@ TEST_CASE("SparseNMFALSTest", "[NMFTest]")
   REQUIRE(success == true);
 }
 
+/**
+ * Make sure that the blocked divergence update rules give the same result as
+ * the straightforward formulas, when there are several blocks of columns.
+ */
+TEST_CASE("NMFDivUpdateBlocksTest", "[NMFTest]")
+{
+  mat v = randu<mat>(30, 700) + 0.1;
+  mat w = randu<mat>(30, 5) + 0.1;
+  mat h = randu<mat>(5, 700) + 0.1;
+
+  mat expectedW = w % (((v / (w * h + 1e-15)) * h.t()) /
+      (repmat(sum(h, 1).t(), w.n_rows, 1) + 1e-15));
+  NMFMultiplicativeDivergenceUpdate::WUpdate(v, w, h);
+  REQUIRE(arma::approx_equal(w, expectedW, "reldiff", 1e-10));
+
+  mat expectedH = h % ((w.t() * (v / (w * h + 1e-15))) /
+      (repmat(sum(w, 0).t(), 1, h.n_cols) + 1e-15));
+  NMFMultiplicativeDivergenceUpdate::HUpdate(v, w, h);
+  REQUIRE(arma::approx_equal(h, expectedH, "reldiff", 1e-10));
+}
+
+/**
+ * Make sure that the divergence update rules give the same factorization for
+ * sparse and dense input matrices.
+ */
+TEST_CASE("SparseNMFDivTest", "[NMFTest]")
+{
+  sp_mat v;
+  v.sprandu(40, 60, 0.1);
+  // Ensure there is at least one nonzero element in every row and column.
+  for (size_t i = 0; i < 40; ++i)
+    v(i, i) += 0.01;
+  for (size_t i = 40; i < 60; ++i)
+    v(i - 40, i) += 0.01;
+  mat dv(v); // Make a dense copy.
+  const size_t r = 5;
+
+  arma::mat iw, ih;
+  RandomAcolInitialization<>::Initialize(v, r, iw, ih);
+
+  mat w, h, dw, dh;
+  AMF<MaxIterationTermination, GivenInitialization<>,
+      NMFMultiplicativeDivergenceUpdate> nmf(MaxIterationTermination(30),
+      GivenInitialization<>(iw, ih));
+  nmf.Apply(v, r, w, h);
+  nmf.Apply(dv, r, dw, dh);
+
+  REQUIRE(arma::approx_equal(w, dw, "reldiff", 1e-8));
+  REQUIRE(arma::approx_equal(h, dh, "reldiff", 1e-8));
+}
+
 /**
  * Check if all elements in W and H are non-negative.
  * Default Case.
@@ -341,3 +341,106 @@ TEST_CASE("OctreeSerializationTest", "[OctreeTest]")
   delete binaryTree;
   delete jsonTree;
 }
+
+/**
+ * Make sure that two octrees have the same nodes, holding the same columns of
+ * their datasets, with the same bounds.
+ */
+template<typename TreeType>
+void CheckSameStructure(const TreeType& node1, const TreeType& node2)
+{
+  REQUIRE(node1.NumChildren() == node2.NumChildren());
+  REQUIRE(node1.NumDescendants() == node2.NumDescendants());
+  REQUIRE(node1.Descendant(0) == node2.Descendant(0));
+  REQUIRE(node1.ParentDistance() ==
+      Approx(node2.ParentDistance()).epsilon(1e-7).margin(1e-12));
+  for (size_t d = 0; d < node1.Bound().Dim(); ++d)
+  {
+    REQUIRE(node1.Bound()[d].Lo() == node2.Bound()[d].Lo());
+    REQUIRE(node1.Bound()[d].Hi() == node2.Bound()[d].Hi());
+  }
+
+  for (size_t i = 0; i < node1.NumChildren(); ++i)
+    CheckSameStructure(node1.Child(i), node2.Child(i));
+}
+
+/**
+ * Make sure that an octree large enough that its children are built as
+ * parallel tasks is the same as the tree built with one thread.
+ */
+TEST_CASE("OctreeParallelBuildTest", "[OctreeTest]")
+{
+  arma::mat dataset(3, 100000, arma::fill::randu);
+
+  std::vector<size_t> oldFromNew;
+  Octree<> t(dataset, oldFromNew);
+
+  #ifdef MLPACK_USE_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  std::vector<size_t> serialOldFromNew;
+  Octree<> serialTree(dataset, serialOldFromNew);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+
+  REQUIRE(oldFromNew == serialOldFromNew);
+  CheckMatrices(t.Dataset(), serialTree.Dataset());
+  CheckSameNode(t, serialTree);
+}
+
+/**
+ * Make sure that an octree built from the Morton codes of the points has the
+ * same nodes as the octree built top-down, with the same sets of points.  The
+ * second dataset holds points so close together that the tree is deeper than
+ * the levels described by the codes.
+ */
+TEST_CASE("OctreeMortonBuildTest", "[OctreeTest]")
+{
+  arma::mat dataset1(3, 50000, arma::fill::randu);
+  arma::mat dataset2(2, 2000, arma::fill::randu);
+  dataset2.cols(0, 99) *= 1e-12;
+
+  for (const arma::mat* dataset : { &dataset1, &dataset2 })
+  {
+    std::vector<size_t> oldFromNew, mortonOldFromNew;
+    Octree<> t(*dataset, oldFromNew, 5);
+    Octree<> mortonTree(*dataset, mortonOldFromNew, MORTON_OCTREE_BUILD, 5);
+
+    CheckSameStructure(t, mortonTree);
+
+    // Only the order of the points inside each leaf may differ.
+    std::stack<const Octree<>*> stack;
+    stack.push(&mortonTree);
+    while (!stack.empty())
+    {
+      const Octree<>* node = stack.top();
+      stack.pop();
+      for (size_t i = 0; i < node->NumChildren(); ++i)
+        stack.push(&node->Child(i));
+
+      if (!node->IsLeaf())
+        continue;
+
+      const size_t begin = node->Point(0);
+      const size_t end = begin + node->NumPoints();
+      std::vector<size_t> points(oldFromNew.begin() + begin,
+          oldFromNew.begin() + end);
+      std::vector<size_t> mortonPoints(mortonOldFromNew.begin() + begin,
+          mortonOldFromNew.begin() + end);
+      std::sort(points.begin(), points.end());
+      std::sort(mortonPoints.begin(), mortonPoints.end());
+      REQUIRE(points == mortonPoints);
+    }
+
+    // The mappings must map back to the original points.
+    for (size_t i = 0; i < dataset->n_cols; ++i)
+    {
+      REQUIRE(arma::approx_equal(mortonTree.Dataset().col(i),
+          dataset->col(mortonOldFromNew[i]), "absdiff", 0.0));
+    }
+  }
+}
@@ -229,3 +229,104 @@ TEST_CASE("OneHotEncodingDatasetinfoTest", "[OneHotEncodingTest]")
 
   remove("test.csv");
 }
+
+/**
+ * The sparse overloads must give the same result as the dense ones.
+ */
+TEST_CASE("OneHotEncodingSparseOutputTest", "[OneHotEncodingTest]")
+{
+  arma::mat input = arma::floor(arma::randu<arma::mat>(6, 300) * 10);
+  input.row(2) = arma::floor(arma::randu<arma::rowvec>(300) * 50);
+  arma::Col<size_t> indices("0 2 5");
+
+  arma::mat denseOutput;
+  arma::sp_mat sparseOutput;
+  data::OneHotEncoding(input, indices, denseOutput);
+  data::OneHotEncoding(input, indices, sparseOutput);
+
+  REQUIRE(sparseOutput.n_rows == denseOutput.n_rows);
+  REQUIRE(sparseOutput.n_cols == 300);
+  CheckMatrices(denseOutput, arma::mat(sparseOutput));
+}
+
+/**
+ * Encoding batches with the layout given by a DatasetInfo must give the same
+ * result as encoding the whole dataset.
+ */
+TEST_CASE("OneHotEncoderBatchTest", "[OneHotEncodingTest]")
+{
+  DatasetInfo info(3);
+  info.Type(1) = Datatype::categorical;
+  info.MapString<double>("a", 1);
+  info.MapString<double>("b", 1);
+  info.MapString<double>("c", 1);
+
+  arma::mat input(3, 100, arma::fill::randu);
+  input.row(1) = arma::floor(arma::randu<arma::rowvec>(100) * 3);
+
+  arma::mat denseOutput;
+  data::OneHotEncoding(input, denseOutput, info);
+
+  data::OneHotEncoder<> encoder(info);
+  REQUIRE(encoder.InputDimensionality() == 3);
+  REQUIRE(encoder.OutputDimensionality() == 5);
+  REQUIRE(encoder.NumCategories(1) == 3);
+  REQUIRE(encoder.Offset(2) == 4);
+
+  arma::mat expected(5, 100, arma::fill::zeros);
+  expected.row(0) = input.row(0);
+  expected.row(4) = input.row(2);
+  for (size_t i = 0; i < 100; ++i)
+    expected(1 + (size_t) input(1, i), i) = 1.0;
+
+  for (size_t i = 0; i < 100; i += 30)
+  {
+    const size_t last = std::min(i + 30, (size_t) 100) - 1;
+    arma::sp_mat batchOutput;
+    encoder.Transform(input.cols(i, last), batchOutput);
+    CheckMatrices(arma::mat(batchOutput), expected.cols(i, last));
+  }
+
+  // The dense overload numbers the categories in order of first appearance, so
+  // it only matches up to the order of the categories; the other dimensions
+  // are the same.
+  REQUIRE(denseOutput.n_rows == 5);
+  CheckMatrices(denseOutput.row(0), expected.row(0));
+  CheckMatrices(denseOutput.row(4), expected.row(4));
+
+  // Unknown categories are an error.
+  arma::mat unknown = input.cols(0, 1);
+  unknown(1, 1) = 7;
+  arma::sp_mat unknownOutput;
+  REQUIRE_THROWS_AS(encoder.Transform(unknown, unknownOutput),
+      std::invalid_argument);
+}
+
+/**
+ * Fit() may be called incrementally; categories seen first keep their
+ * encoding.
+ */
+TEST_CASE("OneHotEncoderIncrementalFitTest", "[OneHotEncodingTest]")
+{
+  arma::mat first = "1 2 1;"
+                    "5 5 6;";
+  arma::mat second = "3 2;"
+                     "7 7;";
+
+  data::OneHotEncoder<> encoder(arma::Col<size_t>("0"));
+  encoder.Fit(first);
+  REQUIRE(encoder.OutputDimensionality() == 3);
+  encoder.Fit(second);
+  REQUIRE(encoder.OutputDimensionality() == 4);
+
+  arma::mat output;
+  encoder.Transform(second, output);
+  arma::mat expected = "0 0;"
+                       "0 1;"
+                       "1 0;"
+                       "7 7;";
+  CheckMatrices(output, expected);
+
+  arma::mat wrongDimensionality(3, 2, arma::fill::zeros);
+  REQUIRE_THROWS_AS(encoder.Fit(wrongDimensionality), std::invalid_argument);
+}
@@ -198,6 +198,15 @@ TEST_CASE("ArmaComparisonRandomizedPCATest", "[PCATest]")
   ArmaComparisonPCA<RandomizedSVDPCAPolicy>();
 }
 
+/**
+ * Compare the output of our incremental PCA implementation with Armadillo's,
+ * using several mini-batches.
+ */
+TEST_CASE("ArmaComparisonIncrementalPCATest", "[PCATest]")
+{
+  ArmaComparisonPCA<IncrementalPCAPolicy>(false, IncrementalPCAPolicy(70));
+}
+
 /**
  * Test that dimensionality reduction with exact-svd PCA works the same way
  * MATLAB does (which should be correct!).
@@ -227,6 +236,58 @@ TEST_CASE("RandomizedPCADimensionalityReductionTest", "[PCATest]")
   PCADimensionalityReduction<RandomizedSVDPCAPolicy>();
 }
 
+/**
+ * Test that dimensionality reduction with incremental PCA works the same way
+ * MATLAB does (which should be correct!), with mini-batches of two points.
+ */
+TEST_CASE("IncrementalPCADimensionalityReductionTest", "[PCATest]")
+{
+  PCADimensionalityReduction<IncrementalPCAPolicy>(false,
+      IncrementalPCAPolicy(2));
+}
+
+/**
+ * Make sure that feeding the points to IncrementalPCAPolicy one batch at a
+ * time gives the truncated exact PCA, when the data has low rank.
+ */
+TEST_CASE("IncrementalPCAUpdateTest", "[PCATest]")
+{
+  // 20-dimensional data that lies on a 4-dimensional affine subspace.
+  arma::mat basis = arma::randn<arma::mat>(20, 4);
+  arma::mat data = basis * arma::randn<arma::mat>(4, 1000);
+  data.each_col() += arma::randu<arma::vec>(20);
+
+  IncrementalPCAPolicy ipca;
+  for (size_t i = 0; i < 1000; i += 37)
+    ipca.Update(data.cols(i, std::min(i + 36, (size_t) 999)), 4);
+
+  REQUIRE(ipca.NumPoints() == 1000);
+  REQUIRE(ipca.Components().n_cols == 4);
+  REQUIRE(arma::approx_equal(ipca.Mean(), arma::mean(data, 1), "absdiff",
+      1e-8));
+
+  arma::mat coeff, score;
+  arma::vec eigVal;
+  princomp(coeff, score, eigVal, trans(data));
+
+  arma::vec eigVal1;
+  ipca.EigenValues(eigVal1);
+  for (size_t i = 0; i < 4; ++i)
+    REQUIRE(eigVal1[i] == Approx(eigVal[i]).epsilon(1e-6));
+  REQUIRE(ipca.TotalVariance() == Approx(arma::accu(eigVal)).epsilon(1e-6));
+
+  // The projection must match up to the sign of each component.
+  arma::mat transformed;
+  ipca.Transform(data, transformed);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    const arma::rowvec trueRow = score.col(i).t();
+    if (arma::dot(transformed.row(i), trueRow) < 0.0)
+      transformed.row(i) *= -1;
+    REQUIRE(arma::approx_equal(transformed.row(i), trueRow, "absdiff", 1e-5));
+  }
+}
+
 /**
  * Test that dimensionality reduction with QUIC-SVD PCA works the same way
  * as the Exact-SVD PCA method.
@@ -335,7 +396,8 @@ TEST_CASE("PCAScalingTest", "[PCATest]")
  * Test PCA on a subview of a matrix with different decomposition strategies.
  */
 TEMPLATE_TEST_CASE("PCASubviewTest", "[PCATest]", ExactSVDPolicy,
-    RandomizedSVDPCAPolicy, RandomizedBlockKrylovSVDPolicy, QUICSVDPolicy)
+    RandomizedSVDPCAPolicy, RandomizedBlockKrylovSVDPolicy, QUICSVDPolicy,
+    IncrementalPCAPolicy)
 {
   using DecompositionPolicy = TestType;
 
@@ -382,7 +444,8 @@ TEMPLATE_TEST_CASE("PCASubviewTest", "[PCATest]", ExactSVDPolicy,
  * Test PCA on an input expression.
  */
 TEMPLATE_TEST_CASE("PCAExpressionTest", "[PCATest]", ExactSVDPolicy,
-    RandomizedSVDPCAPolicy, RandomizedBlockKrylovSVDPolicy, QUICSVDPolicy)
+    RandomizedSVDPCAPolicy, RandomizedBlockKrylovSVDPolicy, QUICSVDPolicy,
+    IncrementalPCAPolicy)
 {
   using DecompositionPolicy = TestType;
 
@@ -429,7 +492,8 @@ TEMPLATE_TEST_CASE("PCAExpressionTest", "[PCATest]", ExactSVDPolicy,
  * Test PCA on 32-bit data.
  */
 TEMPLATE_TEST_CASE("PCAFloatTest", "[PCATest]", ExactSVDPolicy,
-    RandomizedSVDPCAPolicy, RandomizedBlockKrylovSVDPolicy, QUICSVDPolicy)
+    RandomizedSVDPCAPolicy, RandomizedBlockKrylovSVDPolicy, QUICSVDPolicy,
+    IncrementalPCAPolicy)
 {
   using DecompositionPolicy = TestType;
 
@@ -507,3 +571,52 @@ TEMPLATE_TEST_CASE("PCASparseToDenseTest", "[PCATest]", float, double)
 
   REQUIRE(denseData2.n_rows == transformedDataset2.n_rows);
 }
+
+/**
+ * Make sure that the policies that center the data implicitly give the same
+ * results on sparse data as exact PCA on the dense version of the data.
+ */
+TEMPLATE_TEST_CASE("PCAImplicitCenteringSparseTest", "[PCATest]",
+    RandomizedSVDPCAPolicy, RandomizedBlockKrylovSVDPolicy,
+    IncrementalPCAPolicy)
+{
+  using DecompositionPolicy = TestType;
+
+  arma::sp_mat dataset;
+  dataset.sprandu(20, 500, 0.1);
+  arma::mat denseDataset(dataset);
+
+  arma::mat transformed, eigvec, trueTransformed, trueEigvec;
+  arma::vec eigVal, trueEigVal;
+
+  PCA<DecompositionPolicy> p;
+  p.Apply(dataset, transformed, eigVal, eigvec);
+
+  PCA<ExactSVDPolicy> exactPCA;
+  exactPCA.Apply(denseDataset, trueTransformed, trueEigVal, trueEigvec);
+
+  REQUIRE(transformed.n_cols == dataset.n_cols);
+  REQUIRE(eigVal.n_elem >= 3);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    REQUIRE(eigVal[i] == Approx(trueEigVal[i]).epsilon(1e-5));
+
+    // The projections must match up to the sign of each component.
+    if (arma::dot(transformed.row(i), trueTransformed.row(i)) < 0.0)
+      transformed.row(i) *= -1;
+    REQUIRE(arma::approx_equal(transformed.row(i), trueTransformed.row(i),
+        "absdiff", 1e-5));
+  }
+
+  // Check the variance retained when reducing the dimensionality.  The
+  // leading components are only approximated at this rank, so the tolerance
+  // is loose.
+  arma::mat reduced;
+  const double varRetained = p.Apply(dataset, reduced, 5);
+  const double trueVarRetained = exactPCA.Apply(denseDataset, 5);
+
+  REQUIRE(reduced.n_rows == 5);
+  REQUIRE(varRetained > 0.0);
+  REQUIRE(varRetained <= trueVarRetained + 1e-5);
+  REQUIRE(varRetained == Approx(trueVarRetained).epsilon(0.1));
+}
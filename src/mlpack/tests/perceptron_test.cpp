@@ -363,3 +363,25 @@ TEST_CASE("TrainFormTest", "[PerceptronTest]")
   REQUIRE(all(predictions5 == trueLabels));
   REQUIRE(all(predictions6 == trueLabels));
 }
+
+/**
+ * Make sure that single-point and batch classification agree, and match the
+ * scorer of the model.
+ */
+TEST_CASE("PerceptronScorerTest", "[PerceptronTest]")
+{
+  arma::mat data(4, 300, arma::fill::randn);
+  Perceptron<> p(5, data.n_rows);
+  p.Weights().randn();
+  p.Biases().randn();
+
+  arma::Row<size_t> labels, scorerLabels;
+  p.Classify(data, labels);
+
+  LinearScorer<> scorer = p.Scorer();
+  scorer.Classify(data, scorerLabels);
+  REQUIRE(all(labels == scorerLabels));
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+    REQUIRE(p.Classify(data.col(i)) == labels[i]);
+}
@@ -395,3 +395,113 @@ TEST_CASE("SACForMultipleActions", "[PolicyGradientTest]")
   // If the agent is able to reach till this point of the test, it is assured
   // that the agent can handle multiple actions in continuous space.
 }
+
+//! Check that ParallelActorLearner collects the requested number of steps and
+//! performs the requested number of updates.
+TEST_CASE("ParallelActorLearnerTest", "[PolicyGradientTest]")
+{
+  FFN<EmptyLoss, GaussianInitialization>
+      policyNetwork(EmptyLoss(), GaussianInitialization(0, 0.1));
+  policyNetwork.Add(new Linear(1));
+  policyNetwork.Reset(Pendulum::State::dimension);
+
+  TrainingConfig config;
+  config.ExplorationSteps() = 101;
+
+  ParallelActorLearner<Pendulum, decltype(policyNetwork)> learner(4, 0.5, 3);
+
+  // The actors choose random actions; each update changes the policy.
+  auto makeSelector = []()
+  {
+    return [](decltype(policyNetwork)& /* network */,
+              const Pendulum::State& /* state */,
+              Pendulum::Action& action)
+    {
+      action.action = { Random(-2.0, 2.0) };
+    };
+  };
+
+  size_t stored = 0;
+  size_t terminal = 0;
+  auto store = [&](const Pendulum::State& /* state */,
+                   const Pendulum::Action& action,
+                   const double /* reward */,
+                   const Pendulum::State& /* nextState */,
+                   const bool isEnd)
+  {
+    REQUIRE(action.action.size() == 1);
+    ++stored;
+    if (isEnd)
+      ++terminal;
+  };
+
+  size_t updates = 0;
+  auto update = [&]()
+  {
+    policyNetwork.Parameters() += 1.0;
+    ++updates;
+  };
+
+  const std::vector<double> returns = learner.Run(500, config, Pendulum(),
+      policyNetwork, makeSelector, store, update);
+
+  REQUIRE(stored == 500);
+  REQUIRE(updates == 200);
+  // Pendulum episodes last 200 steps.
+  REQUIRE(returns.size() == terminal);
+  REQUIRE(returns.size() <= 2);
+}
+
+//! Check that DDPG and SAC can be trained with parallel actors.
+TEST_CASE("ParallelTrainDDPGAndSAC", "[PolicyGradientTest]")
+{
+  RandomReplay<Pendulum> ddpgReplay(32, 10000);
+  RandomReplay<Pendulum> sacReplay(32, 10000);
+
+  TrainingConfig config;
+  config.StepSize() = 0.001;
+  config.TargetNetworkSyncInterval() = 1;
+  config.ExplorationSteps() = 50;
+
+  FFN<EmptyLoss, GaussianInitialization>
+      policyNetwork(EmptyLoss(), GaussianInitialization(0, 0.1));
+  policyNetwork.Add(new Linear(32));
+  policyNetwork.Add(new ReLU());
+  policyNetwork.Add(new Linear(1));
+  policyNetwork.Add(new TanH());
+
+  FFN<EmptyLoss, GaussianInitialization>
+      qNetwork(EmptyLoss(), GaussianInitialization(0, 0.1));
+  qNetwork.Add(new Linear(32));
+  qNetwork.Add(new ReLU());
+  qNetwork.Add(new Linear(1));
+
+  decltype(policyNetwork) sacPolicyNetwork(policyNetwork);
+  decltype(qNetwork) sacQNetwork(qNetwork);
+
+  OUNoise ouNoise(1, 0.0, 1.0, 0.01);
+  DDPG<Pendulum, decltype(qNetwork), decltype(policyNetwork), OUNoise,
+      AdamUpdate> ddpg(config, qNetwork, policyNetwork, ouNoise, ddpgReplay);
+
+  const arma::mat ddpgParameters = policyNetwork.Parameters();
+  ddpg.ParallelTrain(3, 450, 0.5, 2);
+  REQUIRE(ddpg.TotalSteps() == 450);
+  REQUIRE(ddpgReplay.Size() == 450);
+  REQUIRE(arma::any(arma::vectorise(policyNetwork.Parameters() !=
+      ddpgParameters)));
+
+  SAC<Pendulum, decltype(sacQNetwork), decltype(sacPolicyNetwork), AdamUpdate>
+      sac(config, sacQNetwork, sacPolicyNetwork, sacReplay);
+
+  const arma::mat sacParameters = sacPolicyNetwork.Parameters();
+  const double averageReturn = sac.ParallelTrain(3, 450);
+  REQUIRE(sac.TotalSteps() == 450);
+  REQUIRE(sacReplay.Size() == 450);
+  // Pendulum rewards are never positive.
+  REQUIRE(averageReturn <= 0.0);
+  REQUIRE(arma::any(arma::vectorise(sacPolicyNetwork.Parameters() !=
+      sacParameters)));
+
+  // Invalid settings are rejected.
+  REQUIRE_THROWS_AS(sac.ParallelTrain(0, 10), std::invalid_argument);
+}
@@ -74,6 +74,53 @@ TEST_CASE("CartPoleWithDQNPrioritizedReplay", "[QLearningTest]")
   REQUIRE(converged);
 }
 
+//! Test DQN in Cart Pole task, with rollouts over several copies of the
+//! environment.
+TEST_CASE("CartPoleWithVectorEnvDQN", "[QLearningTest]")
+{
+  // It isn't guaranteed that the network will converge in the specified number
+  // of iterations using random weights.
+  bool converged = false;
+  for (size_t trial = 0; trial < 4; ++trial)
+  {
+    // Set up the network.
+    SimpleDQN<> network(128, 128, 2);
+
+    // Set up the policy and replay method.
+    GreedyPolicy<CartPole> policy(1.0, 1000, 0.1, 0.99);
+    RandomReplay<CartPole> replayMethod(32, 10000);
+
+    TrainingConfig config;
+    config.StepSize() = 0.01;
+    config.Discount() = 0.9;
+    config.TargetNetworkSyncInterval() = 100;
+    config.ExplorationSteps() = 100;
+    config.DoubleQLearning() = false;
+    config.StepLimit() = 200;
+
+    QLearning<CartPole, decltype(network), AdamUpdate, decltype(policy)>
+        agent(config, network, policy, replayMethod);
+
+    VectorEnv<CartPole> envs(4);
+    for (size_t i = 0; i < 40; ++i)
+      agent.Rollout(envs, 100);
+
+    // Now test the agent on single episodes.
+    agent.Deterministic() = true;
+    arma::running_stat<double> testReturn;
+    for (size_t i = 0; i < 10; ++i)
+      testReturn(agent.Episode());
+
+    if (testReturn.mean() > 45)
+    {
+      converged = true;
+      break;
+    }
+  }
+
+  REQUIRE(converged);
+}
+
 //! Test Double DQN in Cart Pole task.
 TEST_CASE("CartPoleWithDoubleDQN", "[QLearningTest]")
 {
@@ -431,3 +478,62 @@ TEST_CASE("CartPoleWithCategoricalDQN", "[QLearningTest]")
   }
   REQUIRE(converged);
 }
+
+//! Check batched action sampling of GreedyPolicy and AggregatedPolicy.
+TEST_CASE("GreedyPolicyBatchSampleTest", "[QLearningTest]")
+{
+  arma::mat actionValues(2, 1000, arma::fill::randu);
+  std::vector<CartPole::Action> actions;
+
+  // Greedy actions are the best actions.
+  GreedyPolicy<CartPole> greedy(0.0, 1000, 0.0);
+  greedy.Sample(actionValues, actions);
+  REQUIRE(actions.size() == 1000);
+  for (size_t i = 0; i < actions.size(); ++i)
+  {
+    REQUIRE((size_t) actions[i].action ==
+        (size_t) actionValues.col(i).index_max());
+    REQUIRE(actions[i].action ==
+        greedy.Sample(arma::colvec(actionValues.col(i))).action);
+  }
+
+  // Random actions are (roughly) uniform, and do not depend on the action
+  // values.
+  GreedyPolicy<CartPole> random(1.0, 1000, 1.0);
+  std::mt19937 rng1(42), rng2(42);
+  std::vector<CartPole::Action> otherActions;
+  random.Sample(actionValues, actions, false, false, rng1);
+  random.Sample(arma::mat(2, 1000, arma::fill::zeros), otherActions, false,
+      false, rng2);
+  size_t forward = 0;
+  for (size_t i = 0; i < actions.size(); ++i)
+  {
+    REQUIRE(actions[i].action == otherActions[i].action);
+    if (actions[i].action == CartPole::Action::forward)
+      ++forward;
+  }
+  REQUIRE(forward > 400);
+  REQUIRE(forward < 600);
+
+  // Deterministic sampling ignores epsilon, and so do noisy networks.
+  random.Sample(actionValues, actions, true);
+  random.Sample(actionValues, otherActions, false, true);
+  for (size_t i = 0; i < actions.size(); ++i)
+  {
+    REQUIRE((size_t) actions[i].action ==
+        (size_t) actionValues.col(i).index_max());
+    REQUIRE(otherActions[i].action == actions[i].action);
+  }
+
+  // An aggregated policy that always selects the greedy child.
+  AggregatedPolicy<GreedyPolicy<CartPole>> aggregated(
+      { GreedyPolicy<CartPole>(1.0, 1000, 1.0),
+        GreedyPolicy<CartPole>(0.0, 1000, 0.0) }, arma::colvec("0.0 1.0"));
+  aggregated.Sample(actionValues, actions);
+  REQUIRE(actions.size() == 1000);
+  for (size_t i = 0; i < actions.size(); ++i)
+  {
+    REQUIRE((size_t) actions[i].action ==
+        (size_t) actionValues.col(i).index_max());
+  }
+}
@@ -140,6 +140,43 @@ TEST_CASE("QDAFNMultipleNeighbors", "[QDAFNTest]")
   }
 }
 
+/**
+ * Make sure the distances returned for each neighbor are the distances to that
+ * neighbor, in decreasing order, when many queries are searched at once.
+ */
+TEST_CASE("QDAFNNeighborDistancesTest", "[QDAFNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(10, 1000);
+  arma::mat querySet = arma::randu<arma::mat>(10, 2000);
+
+  QDAFN<> qdafn(dataset, 10, 30);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  qdafn.Search(querySet, 5, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 5);
+  REQUIRE(neighbors.n_cols == 2000);
+
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    for (size_t i = 0; i < 5; ++i)
+    {
+      if (neighbors(i, q) == size_t() - 1)
+        continue;
+
+      REQUIRE(neighbors(i, q) < 1000);
+      REQUIRE(distances(i, q) == Approx(EuclideanDistance::Evaluate(
+          querySet.col(q), dataset.col(neighbors(i, q)))).epsilon(1e-10));
+      if (i > 0)
+      {
+        REQUIRE(neighbors(i, q) != neighbors(i - 1, q));
+        REQUIRE(distances(i, q) <= distances(i - 1, q));
+      }
+    }
+  }
+}
+
 /**
  * Test re-training method.
  */
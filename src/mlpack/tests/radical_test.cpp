@@ -60,3 +60,31 @@ TEMPLATE_TEST_CASE("Radical_Test_Radical3D", "[RadicalTest]", float, double)
   // Larger tolerance is sometimes needed.
   REQUIRE(valBest == Approx(valEst).epsilon(0.02));
 }
+
+/**
+ * Make sure the unmixing matrix maps the data to the independent components,
+ * and that the results only depend on the random seed.
+ */
+TEST_CASE("RadicalUnmixingMatrixTest", "[RadicalTest]")
+{
+  arma::mat matX;
+  if (!data::Load("data_3d_mixed.txt", matX))
+    FAIL("Cannot load dataset data_3d_mixed.txt");
+
+  Radical rad(0.175, 5, 100, 2);
+
+  arma::mat matY, matW;
+  RandomSeed(42);
+  rad.Apply(matX, matY, matW);
+
+  REQUIRE(matW.n_rows == matX.n_rows);
+  REQUIRE(matW.n_cols == matX.n_rows);
+  REQUIRE(arma::approx_equal(matY, matW * matX, "absdiff", 1e-8));
+
+  arma::mat matY2, matW2;
+  RandomSeed(42);
+  rad.Apply(matX, matY2, matW2);
+
+  REQUIRE(arma::approx_equal(matY, matY2, "absdiff", 1e-12));
+  REQUIRE(arma::approx_equal(matW, matW2, "absdiff", 1e-12));
+}
@@ -607,3 +607,438 @@ TEST_CASE("ExtraTreesAccuracyTest", "[RandomForestTest]")
 
   REQUIRE(accuracy >= 0.85);
 }
+
+/**
+ * Make sure that batch classification gives the same results as classifying
+ * each point individually, both for large batches (which are classified in
+ * tiles) and for small batches (for which the trees are searched in parallel).
+ */
+TEST_CASE("RandomForestBatchClassifyTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+  arma::mat testDataset;
+  if (!data::Load("vc2_test.csv", testDataset))
+    FAIL("Cannot load dataset vc2_test.csv");
+
+  RandomForest<> rf(dataset, labels, 3, 20 /* 20 trees */, 1);
+
+  arma::Row<size_t> predictions, predictionsOnly;
+  arma::mat probabilities;
+  rf.Classify(testDataset, predictions, probabilities);
+  rf.Classify(testDataset, predictionsOnly);
+
+  REQUIRE(predictions.n_elem == testDataset.n_cols);
+  REQUIRE(probabilities.n_rows == 3);
+  REQUIRE(probabilities.n_cols == testDataset.n_cols);
+  CheckMatrices(predictions, predictionsOnly);
+
+  for (size_t i = 0; i < testDataset.n_cols; ++i)
+  {
+    size_t prediction;
+    arma::vec pointProbabilities;
+    rf.Classify(testDataset.col(i), prediction, pointProbabilities);
+
+    REQUIRE(prediction == predictions[i]);
+    CheckMatrices(pointProbabilities, arma::vec(probabilities.col(i)));
+  }
+
+  // Now classify a small batch.
+  arma::Row<size_t> smallPredictions;
+  arma::mat smallProbabilities;
+  rf.Classify(testDataset.cols(0, 2), smallPredictions, smallProbabilities);
+
+  CheckMatrices(smallPredictions, arma::Row<size_t>(predictions.subvec(0, 2)));
+  CheckMatrices(smallProbabilities, arma::mat(probabilities.cols(0, 2)));
+}
+
+/**
+ * Make sure that a FlatForest gives exactly the same predictions and
+ * probabilities as the random forest it was built from.
+ */
+TEST_CASE("FlatForestRandomForestTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+  arma::mat testDataset;
+  if (!data::Load("vc2_test.csv", testDataset))
+    FAIL("Cannot load dataset vc2_test.csv");
+
+  RandomForest<> rf(dataset, labels, 3, 20 /* 20 trees */, 1);
+  FlatForest flat(rf);
+
+  REQUIRE(flat.NumTrees() == 20);
+  REQUIRE(flat.NumClasses() == 3);
+
+  arma::Row<size_t> predictions, flatPredictions;
+  arma::mat probabilities, flatProbabilities;
+  rf.Classify(testDataset, predictions, probabilities);
+
+  // Use a block size that does not divide the number of points.
+  flat.BlockSize() = 7;
+  flat.Classify(testDataset, flatPredictions, flatProbabilities);
+
+  REQUIRE(flatPredictions.n_elem == testDataset.n_cols);
+  CheckMatrices(predictions, flatPredictions);
+  CheckMatrices(probabilities, flatProbabilities);
+
+  // Check the single-point overloads too.
+  for (size_t i = 0; i < testDataset.n_cols; ++i)
+  {
+    size_t prediction;
+    arma::vec pointProbabilities;
+    flat.Classify(testDataset.col(i), prediction, pointProbabilities);
+
+    REQUIRE(prediction == predictions[i]);
+    REQUIRE(flat.Classify(testDataset.col(i)) == predictions[i]);
+    CheckMatrices(pointProbabilities, arma::vec(probabilities.col(i)));
+  }
+}
+
+/**
+ * Make sure that a serialized FlatForest gives the same predictions, and that
+ * the lossy compact options only change the probabilities slightly.
+ */
+TEST_CASE("FlatForestSerializationTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+  arma::mat testDataset;
+  if (!data::Load("vc2_test.csv", testDataset))
+    FAIL("Cannot load dataset vc2_test.csv");
+
+  RandomForest<> rf(dataset, labels, 3, 20 /* 20 trees */, 1);
+  FlatForest flat(rf);
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  flat.Classify(testDataset, predictions, probabilities);
+
+  FlatForest xmlFlat, jsonFlat, binaryFlat;
+  SerializeObjectAll(flat, xmlFlat, jsonFlat, binaryFlat);
+
+  // The leaves with the same probabilities are stored only once.
+  REQUIRE(binaryFlat.NumTrees() == flat.NumTrees());
+  REQUIRE(binaryFlat.NumNodes() == flat.NumNodes());
+  REQUIRE(binaryFlat.NumLeaves() < flat.NumLeaves());
+
+  for (FlatForest* loaded : { &xmlFlat, &jsonFlat, &binaryFlat })
+  {
+    arma::Row<size_t> loadedPredictions;
+    arma::mat loadedProbabilities;
+    loaded->Classify(testDataset, loadedPredictions, loadedProbabilities);
+    CheckMatrices(predictions, loadedPredictions);
+    CheckMatrices(probabilities, loadedProbabilities);
+  }
+
+  flat.SinglePrecision() = true;
+  flat.QuantizeProbabilities() = true;
+  SerializeObjectAll(flat, xmlFlat, jsonFlat, binaryFlat);
+  REQUIRE(binaryFlat.SinglePrecision());
+  REQUIRE(binaryFlat.QuantizeProbabilities());
+
+  arma::Row<size_t> loadedPredictions;
+  arma::mat loadedProbabilities;
+  binaryFlat.Classify(testDataset, loadedPredictions, loadedProbabilities);
+  REQUIRE(arma::accu(loadedPredictions == predictions) >=
+      0.98 * testDataset.n_cols);
+  REQUIRE(arma::abs(loadedProbabilities - probabilities).max() < 0.01);
+}
+
+/**
+ * Make sure that a FlatForest built from a decision tree trained on
+ * categorical data gives the same predictions as the tree.
+ */
+TEST_CASE("FlatForestCategoricalDecisionTreeTest", "[RandomForestTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  arma::mat trainingData = d.cols(0, 1999);
+  arma::mat testData = d.cols(2000, 3999);
+  arma::Row<size_t> trainingLabels = l.subvec(0, 1999);
+
+  DecisionTree<> dt(trainingData, di, trainingLabels, 5, 5);
+  FlatForest flat(dt);
+
+  REQUIRE(flat.NumTrees() == 1);
+
+  arma::Row<size_t> predictions, flatPredictions;
+  arma::mat probabilities, flatProbabilities;
+  dt.Classify(testData, predictions, probabilities);
+  flat.Classify(testData, flatPredictions, flatProbabilities);
+
+  CheckMatrices(predictions, flatPredictions);
+  CheckMatrices(probabilities, flatProbabilities);
+
+  // A forest with trees of a different number of classes can't be built.
+  DecisionTree<> otherTree(trainingData, di, trainingLabels, 6, 5);
+  REQUIRE_THROWS_AS(flat.AddTree(otherTree), std::invalid_argument);
+  REQUIRE(flat.NumTrees() == 1);
+}
+
+/**
+ * Make sure that a random forest only depends on the random seed (and not on
+ * the scheduling of the threads that train the trees).
+ */
+TEST_CASE("RandomForestReproducibleTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+  arma::mat testDataset;
+  if (!data::Load("vc2_test.csv", testDataset))
+    FAIL("Cannot load dataset vc2_test.csv");
+
+  arma::mat probabilities[2];
+  arma::Row<size_t> predictions;
+  for (size_t run = 0; run < 2; ++run)
+  {
+    RandomSeed(1234);
+    RandomForest<GiniGain, RandomDimensionSelect> rf(dataset, labels, 3,
+        30 /* 30 trees */, 1);
+    rf.Classify(testDataset, predictions, probabilities[run]);
+  }
+
+  CheckMatrices(probabilities[0], probabilities[1]);
+}
+
+/**
+ * The trees are tasks of ParallelTasks(); make sure the forest does not depend
+ * on the thread budget.
+ */
+TEST_CASE("RandomForestThreadBudgetTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+
+  arma::mat probabilities[2];
+  arma::Row<size_t> predictions;
+  const size_t budgets[2] = { 1, 0 };
+  for (size_t run = 0; run < 2; ++run)
+  {
+    SetThreadBudget(budgets[run]);
+    RandomSeed(1234);
+    RandomForest<GiniGain, RandomDimensionSelect> rf(dataset, labels, 3,
+        20 /* 20 trees */, 1);
+    rf.Classify(dataset, predictions, probabilities[run]);
+  }
+  SetThreadBudget(0);
+
+  CheckMatrices(probabilities[0], probabilities[1]);
+}
+
+/**
+ * Make sure that queries submitted from several threads to a BatchScheduler
+ * get the same predictions as a single batch classification.
+ */
+TEST_CASE("RandomForestBatchSchedulerTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+
+  RandomForest<> rf(dataset, labels, 3, 10 /* 10 trees */, 1);
+  arma::Row<size_t> predictions;
+  rf.Classify(dataset, predictions);
+
+  std::vector<std::future<size_t>> results(dataset.n_cols);
+  size_t numBatches;
+  {
+    BatchScheduler<size_t> scheduler(ClassifyBatches(rf), dataset.n_rows, 16,
+        std::chrono::microseconds(200));
+
+    std::vector<std::thread> clients;
+    for (size_t t = 0; t < 4; ++t)
+    {
+      clients.emplace_back([&, t]()
+      {
+        for (size_t i = t; i < dataset.n_cols; i += 4)
+          results[i] = scheduler.Submit(dataset.col(i));
+      });
+    }
+    for (std::thread& client : clients)
+      client.join();
+
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+      REQUIRE(results[i].get() == predictions[i]);
+
+    REQUIRE(scheduler.NumQueries() == dataset.n_cols);
+    numBatches = scheduler.NumBatches();
+  }
+
+  REQUIRE(numBatches >= (dataset.n_cols + 15) / 16);
+  REQUIRE(numBatches <= dataset.n_cols);
+
+  // Queries of the wrong dimensionality are rejected.
+  BatchScheduler<size_t> scheduler(ClassifyBatches(rf), dataset.n_rows);
+  REQUIRE_THROWS_AS(scheduler.Submit(arma::vec(dataset.n_rows + 1)),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that the sample and dimension fractions are used, and that
+ * invalid fractions are rejected.
+ */
+TEST_CASE("RandomForestSampleFractionTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+  arma::mat testDataset;
+  if (!data::Load("vc2_test.csv", testDataset))
+    FAIL("Cannot load dataset vc2_test.csv");
+  arma::Row<size_t> testLabels;
+  if (!data::Load("vc2_test_labels.txt", testLabels))
+    FAIL("Cannot load dataset vc2_test_labels.txt");
+
+  RandomForest<> rf;
+  REQUIRE(rf.SampleFraction() == 1.0);
+  REQUIRE(rf.DimensionFraction() == 1.0);
+
+  rf.SampleFraction() = 0.5;
+  rf.DimensionFraction() = 0.5;
+  rf.Train(dataset, labels, 3, 20 /* 20 trees */, 1);
+  REQUIRE(rf.NumTrees() == 20);
+
+  arma::Row<size_t> predictions;
+  rf.Classify(testDataset, predictions);
+  const size_t correct = arma::accu(predictions == testLabels);
+  REQUIRE(double(correct) / double(testLabels.n_elem) > 0.65);
+
+  // Sampling without replacement cannot take more than all the points.
+  RandomForest<GiniGain, MultipleRandomDimensionSelect, BestBinaryNumericSplit,
+      AllCategoricalSplit, false> rfNoBootstrap;
+  rfNoBootstrap.SampleFraction() = 1.5;
+  REQUIRE_THROWS_AS(rfNoBootstrap.Train(dataset, labels, 3, 5),
+      std::invalid_argument);
+
+  rf.SampleFraction() = 0.0;
+  REQUIRE_THROWS_AS(rf.Train(dataset, labels, 3, 5), std::invalid_argument);
+  rf.SampleFraction() = 1.0;
+  rf.DimensionFraction() = 1.5;
+  REQUIRE_THROWS_AS(rf.Train(dataset, labels, 3, 5), std::invalid_argument);
+}
+
+/**
+ * Make sure that presorting the dimensions of each tree does not change the
+ * forest.
+ */
+TEST_CASE("RandomForestPresortTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+
+  arma::mat probabilities[2];
+  arma::Row<size_t> predictions[2];
+  for (size_t run = 0; run < 2; ++run)
+  {
+    RandomSeed(4321);
+    RandomForest<GiniGain, RandomDimensionSelect> rf;
+    rf.Presort() = (run == 1);
+    rf.Train(dataset, labels, 3, 10 /* 10 trees */, 2);
+    rf.Classify(dataset, predictions[run], probabilities[run]);
+  }
+
+  REQUIRE(arma::all(predictions[0] == predictions[1]));
+  CheckMatrices(probabilities[0], probabilities[1]);
+}
+
+/**
+ * Make sure that the out-of-bag error is a reasonable estimate of the test
+ * error, and that it is only available for the training set.
+ */
+TEST_CASE("RandomForestOutOfBagErrorTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+  arma::mat testDataset;
+  if (!data::Load("vc2_test.csv", testDataset))
+    FAIL("Cannot load dataset vc2_test.csv");
+  arma::Row<size_t> testLabels;
+  if (!data::Load("vc2_test_labels.txt", testLabels))
+    FAIL("Cannot load dataset vc2_test_labels.txt");
+
+  RandomForest<> rf(dataset, labels, 3, 30 /* 30 trees */, 1);
+
+  arma::Row<size_t> predictions;
+  rf.Classify(testDataset, predictions);
+  const double testError = 1.0 - double(arma::accu(predictions == testLabels)) /
+      double(testLabels.n_elem);
+
+  const double oobError = rf.OutOfBagError(dataset, labels);
+  REQUIRE(oobError >= 0.0);
+  REQUIRE(oobError < 0.35);
+  REQUIRE(std::abs(oobError - testError) < 0.15);
+
+  // With 30 trees, every point is out of the bag of some tree.
+  arma::mat probabilities;
+  rf.OutOfBagClassify(dataset, predictions, probabilities);
+  REQUIRE(predictions.n_elem == dataset.n_cols);
+  REQUIRE(arma::all(predictions < 3));
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    REQUIRE(arma::accu(probabilities.col(i)) == Approx(1.0).epsilon(1e-7));
+
+  REQUIRE_THROWS_AS(rf.OutOfBagError(testDataset, testLabels),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that the permutation importance finds the only dimension that the
+ * labels depend on.
+ */
+TEST_CASE("RandomForestPermutationImportanceTest", "[RandomForestTest]")
+{
+  arma::mat dataset(4, 1000, arma::fill::randu);
+  arma::Row<size_t> labels(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    labels[i] = (dataset(2, i) > 0.5) ? 1 : 0;
+
+  RandomForest<> rf(dataset, labels, 2, 20 /* 20 trees */, 1);
+
+  arma::vec importances;
+  rf.PermutationImportance(dataset, labels, importances, 2);
+  REQUIRE(importances.n_elem == 4);
+  REQUIRE(importances.index_max() == 2);
+  REQUIRE(importances[2] > 0.3);
+  for (size_t d = 0; d < 4; ++d)
+  {
+    if (d != 2)
+      REQUIRE(std::abs(importances[d]) < 0.05);
+  }
+}
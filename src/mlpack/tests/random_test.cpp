@@ -91,3 +91,87 @@ TEST_CASE("WeightedRandomTest", "[RandomTest]")
     }
   }
 }
+
+// Check the PhiloxRNG blocks against the known answers of the reference
+// implementation (Random123).
+TEST_CASE("PhiloxKnownAnswerTest", "[RandomTest]")
+{
+  const uint32_t keys[3][2] = {
+    { 0x00000000, 0x00000000 },
+    { 0xffffffff, 0xffffffff },
+    { 0xa4093822, 0x299f31d0 } };
+  const uint32_t counters[3][4] = {
+    { 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff },
+    { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 } };
+  const uint32_t answers[3][4] = {
+    { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 },
+    { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd },
+    { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } };
+
+  for (size_t t = 0; t < 3; ++t)
+  {
+    uint32_t output[4];
+    PhiloxRNG::Block(keys[t], counters[t], output);
+    for (size_t i = 0; i < 4; ++i)
+      REQUIRE(output[i] == answers[t][i]);
+  }
+
+  // The first outputs of stream 0 of key 0 are the first block.
+  PhiloxRNG rng;
+  for (size_t i = 0; i < 4; ++i)
+    REQUIRE(rng() == answers[0][i]);
+}
+
+// Check that the PhiloxRNG streams can be split and skipped, and that their
+// outputs are uniform.
+TEST_CASE("PhiloxStreamTest", "[RandomTest]")
+{
+  const uint64_t key = RandStreamKey();
+  PhiloxRNG a(key, 3), b(key, 3), c(key, 4);
+  REQUIRE(a.Key() == key);
+  REQUIRE(a.Stream() == 3);
+
+  // Skipping gives the same outputs as generating.
+  for (size_t i = 0; i < 13; ++i)
+    a();
+  b.discard(13);
+  REQUIRE(a.Position() == 13);
+  REQUIRE(b.Position() == 13);
+  REQUIRE(a() == b());
+  b.Seek(13);
+  REQUIRE(b.Position() == 13);
+  a.Seek(13);
+  REQUIRE(a() == b());
+
+  // Different streams give different outputs.
+  a.Seek(0);
+  size_t equal = 0;
+  for (size_t i = 0; i < 100; ++i)
+    equal += (a() == c()) ? 1 : 0;
+  REQUIRE(equal < 5);
+
+  // Uniform and normal numbers have the right moments.
+  PhiloxRNG rng(key, 0);
+  const size_t n = 100000;
+  arma::vec uniform(n), normal(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    uniform[i] = rng.Random();
+    normal[i] = rng.RandNormal();
+    REQUIRE(uniform[i] >= 0.0);
+    REQUIRE(uniform[i] < 1.0);
+  }
+  REQUIRE(arma::mean(uniform) == Approx(0.5).margin(0.01));
+  REQUIRE(arma::var(uniform) == Approx(1.0 / 12.0).margin(0.005));
+  REQUIRE(arma::mean(normal) == Approx(0.0).margin(0.02));
+  REQUIRE(arma::var(normal) == Approx(1.0).margin(0.03));
+
+  // The generator can be used with the standard distributions.
+  std::uniform_int_distribution<int> dist(0, 9);
+  std::vector<size_t> counts(10, 0);
+  for (size_t i = 0; i < 50000; ++i)
+    counts[dist(rng)]++;
+  for (size_t i = 0; i < 10; ++i)
+    REQUIRE(counts[i] / 50000.0 == Approx(0.1).margin(0.01));
+}
@@ -59,3 +59,53 @@ TEST_CASE("RandomizedSVDReconstructionError", "[RandomizedSVDTest]")
       arma::norm(centeredData, "frob");
   REQUIRE(error == Approx(0.0).margin(1e-5));
 }
+
+/**
+ * The randomized SVD of a dataset read in chunks should match the SVD of the
+ * centered data.
+ */
+TEST_CASE("RandomizedSVDChunkedSourceTest", "[RandomizedSVDTest]")
+{
+  arma::mat U = arma::randn<arma::mat>(8, 3);
+  arma::mat V = arma::randn<arma::mat>(500, 3);
+
+  arma::mat R;
+  arma::qr_econ(U, R, U);
+  arma::qr_econ(V, R, V);
+
+  arma::mat data = U * arma::diagmat(arma::vec("10 5 1")) * V.t() +
+      1e-4 * arma::randn<arma::mat>(8, 500);
+  REQUIRE(data::Save("rsvd_chunked_data.bin", data, false, false,
+      data::FileType::ArmaBinary) == true);
+
+  arma::mat centeredData = data.each_col() - arma::mean(data, 1);
+  arma::mat U1, V1;
+  arma::vec s1;
+  arma::svd_econ(U1, s1, V1, centeredData);
+
+  data::ChunkedSource<double> source("rsvd_chunked_data.bin", 64, false);
+  arma::mat U2, V2;
+  arma::vec s2;
+  RandomizedSVD rSVD(0, 3);
+  rSVD.Apply(source, U2, s2, V2, 3);
+
+  REQUIRE(U2.n_rows == 8);
+  REQUIRE(U2.n_cols == 3);
+  REQUIRE(V2.n_rows == 500);
+  REQUIRE(V2.n_cols == 3);
+  REQUIRE(s2.n_elem == 3);
+
+  const double error = arma::norm(s2 - s1.subvec(0, 2)) / arma::norm(s2);
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+
+  // The factorization should reconstruct the centered data.
+  const double reconstructionError = arma::norm(centeredData -
+      U2 * arma::diagmat(s2) * V2.t(), "frob") /
+      arma::norm(centeredData, "frob");
+  REQUIRE(reconstructionError == Approx(0.0).margin(1e-2));
+
+  REQUIRE_THROWS_AS(rSVD.Apply(source, U2, s2, V2, 0), std::invalid_argument);
+  REQUIRE_THROWS_AS(rSVD.Apply(source, U2, s2, V2, 9), std::invalid_argument);
+
+  remove("rsvd_chunked_data.bin");
+}
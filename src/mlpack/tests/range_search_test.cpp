@@ -1712,3 +1712,143 @@ TEST_CASE("MoveOperatorNaiveTest", "[RangeSearchTest]")
     }
   }
 }
+
+/**
+ * Make sure that the CSR output and the callback output give the same results
+ * as the vector-of-vectors output, in every search mode, for both bichromatic
+ * and monochromatic search.
+ */
+TEST_CASE("RangeSearchCSRAndCallbackTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 800);
+  arma::mat queryData = arma::randu<arma::mat>(3, 300);
+  const Range range(0.1, 0.25);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    RangeSearch<> rs(referenceData, mode == 0, mode == 1);
+
+    for (const bool monochromatic : { false, true })
+    {
+      const size_t numQueries = monochromatic ? referenceData.n_cols :
+          queryData.n_cols;
+
+      vector<vector<size_t>> neighbors;
+      vector<vector<double>> distances;
+      arma::Col<size_t> offsets, csrNeighbors;
+      arma::vec csrDistances;
+      vector<vector<pair<double, size_t>>> callbackResults(numQueries);
+      auto callback = [&](const size_t query, const size_t reference,
+                          const double distance)
+      {
+        // Each query point is only ever handled by one thread.
+        callbackResults[query].push_back(make_pair(distance, reference));
+      };
+
+      if (monochromatic)
+      {
+        rs.Search(range, neighbors, distances);
+        rs.Search(range, offsets, csrNeighbors, csrDistances);
+        rs.Search(range, callback);
+      }
+      else
+      {
+        rs.Search(queryData, range, neighbors, distances);
+        rs.Search(queryData, range, offsets, csrNeighbors, csrDistances);
+        rs.Search(queryData, range, callback);
+      }
+
+      vector<vector<pair<double, size_t>>> sorted;
+      SortResults(neighbors, distances, sorted);
+
+      REQUIRE(offsets.n_elem == numQueries + 1);
+      REQUIRE(offsets[0] == 0);
+      REQUIRE(csrNeighbors.n_elem == offsets[numQueries]);
+      REQUIRE(csrDistances.n_elem == offsets[numQueries]);
+      for (size_t i = 0; i < numQueries; ++i)
+      {
+        vector<pair<double, size_t>> csrSorted;
+        for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+          csrSorted.push_back(make_pair(csrDistances[j], csrNeighbors[j]));
+        sort(csrSorted.begin(), csrSorted.end());
+        sort(callbackResults[i].begin(), callbackResults[i].end());
+
+        REQUIRE(csrSorted.size() == sorted[i].size());
+        REQUIRE(callbackResults[i].size() == sorted[i].size());
+        for (size_t j = 0; j < sorted[i].size(); ++j)
+        {
+          REQUIRE(csrSorted[j].second == sorted[i][j].second);
+          REQUIRE(csrSorted[j].first == Approx(sorted[i][j].first));
+          REQUIRE(callbackResults[i][j].second == sorted[i][j].second);
+          REQUIRE(callbackResults[i][j].first == Approx(sorted[i][j].first));
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Make sure that approximate search returns every point whose distance is in
+ * the shrunk range and no point whose distance is outside the widened range,
+ * and that the number of results of each query point can be capped.
+ */
+TEST_CASE("RangeSearchApproximateTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 800);
+  arma::mat queryData = arma::randu<arma::mat>(3, 300);
+  const Range range(0.1, 0.25);
+  const double epsilon = 0.2;
+  const Range innerRange(0.1 * (1 + epsilon), 0.25 * (1 - epsilon));
+  const Range outerRange(0.1 * (1 - epsilon), 0.25 * (1 + epsilon));
+
+  RangeSearch<> naive(referenceData, true);
+  vector<vector<size_t>> exactNeighbors;
+  vector<vector<double>> exactDistances;
+  naive.Search(queryData, innerRange, exactNeighbors, exactDistances);
+
+  for (const bool singleMode : { false, true })
+  {
+    RangeSearch<> rs(referenceData, false, singleMode);
+    rs.Epsilon() = epsilon;
+
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    rs.Search(queryData, range, neighbors, distances);
+
+    REQUIRE(neighbors.size() == queryData.n_cols);
+    for (size_t i = 0; i < neighbors.size(); ++i)
+    {
+      for (size_t j = 0; j < neighbors[i].size(); ++j)
+      {
+        const double d = EuclideanDistance::Evaluate(queryData.col(i),
+            referenceData.col(neighbors[i][j]));
+        REQUIRE(distances[i][j] == Approx(d));
+        REQUIRE(outerRange.Contains(d));
+      }
+
+      for (const size_t n : exactNeighbors[i])
+      {
+        REQUIRE(find(neighbors[i].begin(), neighbors[i].end(), n) !=
+            neighbors[i].end());
+      }
+    }
+
+    // Now cap the number of results of the exact search.
+    rs.Epsilon() = 0.0;
+    rs.MaxResults() = 5;
+    rs.Search(queryData, range, neighbors, distances);
+    for (size_t i = 0; i < neighbors.size(); ++i)
+    {
+      REQUIRE(neighbors[i].size() <= 5);
+      for (size_t j = 0; j < neighbors[i].size(); ++j)
+        REQUIRE(range.Contains(distances[i][j]));
+    }
+  }
+
+  RangeSearch<> rs(referenceData);
+  rs.Epsilon() = 1.0;
+  vector<vector<size_t>> neighbors;
+  vector<vector<double>> distances;
+  REQUIRE_THROWS_AS(rs.Search(queryData, range, neighbors, distances),
+      std::invalid_argument);
+}
@@ -1350,3 +1350,114 @@ TEST_CASE("RectangleTreeMoveDatasetTest", "[RectangleTreeTraitsTest]")
   REQUIRE(tree.Dataset().n_rows == 3);
   REQUIRE(tree.Dataset().n_cols == 1000);
 }
+
+/**
+ * Bulk load a tree of the given type, check that it is valid, balanced and
+ * full enough, and that nearest neighbor search with it gives the same results
+ * as a naive search.
+ */
+template<template<typename, typename, typename> class TreeType>
+void CheckBulkLoad(const arma::mat& dataset,
+                   const RectangleTreeBulkLoad bulkLoad)
+{
+  using Tree = TreeType<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat>;
+  Tree tree(dataset, bulkLoad, 20, 8, 5, 2);
+
+  REQUIRE(tree.NumDescendants() == dataset.n_cols);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckHierarchy(tree);
+  CheckFills(tree);
+  REQUIRE(CheckNumDescendants(tree) == dataset.n_cols);
+  REQUIRE(GetMinLevel(tree) == GetMaxLevel(tree));
+  REQUIRE((int) tree.TreeDepth() == GetMinLevel(tree));
+
+  std::vector<arma::vec*> allPoints = GetAllPointsInTree(tree);
+  REQUIRE(allPoints.size() == dataset.n_cols);
+  for (size_t i = 0; i < allPoints.size(); ++i)
+    delete allPoints[i];
+
+  arma::Mat<size_t> neighbors1, neighbors2;
+  arma::mat distances1, distances2;
+
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat, TreeType>
+      knn1(std::move(tree));
+  knn1.Search(5, neighbors1, distances1);
+
+  KNN knn2(dataset, NAIVE_MODE);
+  knn2.Search(5, neighbors2, distances2);
+
+  REQUIRE(arma::all(arma::vectorise(neighbors1 == neighbors2)));
+  REQUIRE(arma::approx_equal(distances1, distances2, "absdiff", 1e-10));
+}
+
+// Bulk loading should give valid, balanced trees, that give the right search
+// results.
+TEST_CASE("RectangleTreeBulkLoadTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(5, 2017);
+
+  CheckBulkLoad<RTree>(dataset, STR_BULK_LOAD);
+  CheckBulkLoad<RTree>(dataset, HILBERT_SORT_BULK_LOAD);
+  CheckBulkLoad<RStarTree>(dataset, STR_BULK_LOAD);
+  CheckBulkLoad<RStarTree>(dataset, HILBERT_SORT_BULK_LOAD);
+  CheckBulkLoad<XTree>(dataset, STR_BULK_LOAD);
+  CheckBulkLoad<XTree>(dataset, HILBERT_SORT_BULK_LOAD);
+  CheckBulkLoad<RPlusTree>(dataset, STR_BULK_LOAD);
+
+  // The STR bulk loading doesn't create overlapping children.
+  using RPlusTreeType = RPlusTree<EuclideanDistance, EmptyStatistic,
+      arma::mat>;
+  RPlusTreeType rPlusTree(dataset, STR_BULK_LOAD);
+  CheckOverlap(rPlusTree);
+}
+
+// Points can be inserted into and deleted from a bulk loaded tree.
+TEST_CASE("RectangleTreeBulkLoadInsertTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(3, 1000);
+
+  using TreeType = RStarTree<EuclideanDistance, EmptyStatistic, arma::mat>;
+  TreeType tree(dataset, HILBERT_SORT_BULK_LOAD);
+
+  // Add 100 new points; the tree holds its own copy of the dataset, so it must
+  // be resized too.
+  tree.Dataset().reshape(3, 1100);
+  tree.Dataset().cols(1000, 1099).randu();
+  for (size_t i = 1000; i < 1100; ++i)
+    tree.InsertPoint(i);
+  for (size_t i = 0; i < 200; ++i)
+    tree.DeletePoint(i);
+
+  REQUIRE(tree.NumDescendants() == 900);
+  CheckContainment(tree);
+  CheckHierarchy(tree);
+  CheckFills(tree);
+  CheckNumDescendants(tree);
+  REQUIRE(GetMinLevel(tree) == GetMaxLevel(tree));
+}
+
+// Trees whose auxiliary information is only maintained by insertion can't be
+// bulk loaded, and R+ trees can't use the Hilbert sort.
+TEST_CASE("RectangleTreeBulkLoadInvalidTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(3, 100);
+
+  using HilbertTreeType = HilbertRTree<EuclideanDistance, EmptyStatistic,
+      arma::mat>;
+  using RPlusPlusTreeType = RPlusPlusTree<EuclideanDistance, EmptyStatistic,
+      arma::mat>;
+  using RPlusTreeType = RPlusTree<EuclideanDistance, EmptyStatistic,
+      arma::mat>;
+
+  REQUIRE_THROWS_AS(HilbertTreeType(dataset, HILBERT_SORT_BULK_LOAD),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(RPlusPlusTreeType(dataset, STR_BULK_LOAD),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(RPlusTreeType(dataset, HILBERT_SORT_BULK_LOAD),
+      std::invalid_argument);
+}
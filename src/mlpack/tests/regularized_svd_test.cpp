@@ -246,6 +246,62 @@ TEST_CASE("RegularizedSVDFunctionOptimize", "[RegularizedSVDTest]")
   REQUIRE(relativeError == Approx(0.0).margin(1e-2));
 }
 
+// Test Regularized SVD with the stratified SGD schedule.  This does not need
+// OpenMP, since the blocks are the same with a single thread.
+TEST_CASE("RegularizedSVDFunctionOptimizeStratified", "[RegularizedSVDTest]")
+{
+  // Define useful constants.
+  const size_t numUsers = 50;
+  const size_t numItems = 50;
+  const size_t numRatings = 100;
+  const size_t iterations = 30;
+  const size_t rank = 10;
+  const double alpha = 0.01;
+  const double lambda = 0.01;
+
+  // Initiate random parameters.
+  arma::mat parameters = arma::randu(rank, numUsers + numItems);
+
+  // Make a random rating dataset.
+  arma::mat data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+
+  // Manually set last row to maximum user and maximum item.
+  data(0, numRatings - 1) = numUsers - 1;
+  data(1, numRatings - 1) = numItems - 1;
+
+  // Make rating entries based on the parameters.
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    data(2, i) = dot(parameters.col(data(0, i)),
+                     parameters.col(numUsers + data(1, i)));
+  }
+
+  // Make the Reg SVD function and the optimizer, with 4 x 4 blocks.
+  RegularizedSVDFunction<arma::mat> rSVDFunc(data, rank, lambda);
+  StratifiedSGD optimizer(alpha, iterations, 1e-10, 4);
+
+  // Obtain optimized parameters after training.
+  arma::mat optParameters = arma::randu(rank, numUsers + numItems);
+  optimizer.Optimize(rSVDFunc, optParameters);
+
+  // Get predicted ratings from optimized parameters.
+  arma::mat predictedData(1, numRatings);
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    predictedData(0, i) = dot(optParameters.col(data(0, i)),
+                              optParameters.col(numUsers + data(1, i)));
+  }
+
+  // Calculate relative error.
+  const double relativeError = arma::norm(data.row(2) - predictedData, "frob") /
+                               arma::norm(data, "frob");
+
+  // Relative error should be small.
+  REQUIRE(relativeError == Approx(0.0).margin(1e-2));
+}
+
 // The test is only compiled if the user has specified OpenMP to be
 // used.
 #ifdef MLPACK_USE_OPENMP
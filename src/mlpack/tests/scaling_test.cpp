@@ -166,3 +166,72 @@ TEST_CASE("ZCAWhiteningTest", "[ScalingTest]")
   scale.InverseTransform(output, temp);
   CheckMatrices(dataset, temp);
 }
+
+/**
+ * Fit the given scaler on the whole dataset and batch by batch with
+ * PartialFit(), and check that both scalers (and the in-place Transform())
+ * give the same result.  The signs of the eigenvectors of a PCA whitening are
+ * arbitrary, so for it only the absolute values are compared.
+ */
+template<typename ScalerType>
+void CheckPartialFit(ScalerType full,
+                     ScalerType incremental,
+                     const bool compareAbs = false)
+{
+  arma::mat data = arma::randn<arma::mat>(4, 1000) * 3.0 + 10.0;
+  data.row(1) *= 0.01;
+
+  full.Fit(data);
+  for (size_t i = 0; i < data.n_cols; i += 170)
+    incremental.PartialFit(data.cols(i, std::min(i + 170,
+        (size_t) data.n_cols) - 1));
+
+  arma::mat fullOutput, incrementalOutput;
+  full.Transform(data, fullOutput);
+  incremental.Transform(data, incrementalOutput);
+  if (compareAbs)
+  {
+    CheckMatrices(arma::mat(arma::abs(fullOutput)),
+        arma::mat(arma::abs(incrementalOutput)), 1e-5);
+  }
+  else
+  {
+    CheckMatrices(fullOutput, incrementalOutput, 1e-5);
+  }
+
+  arma::mat inPlace = data;
+  full.Transform(inPlace);
+  CheckMatrices(fullOutput, inPlace);
+}
+
+/**
+ * Test PartialFit() and the in-place Transform() of each scaler.
+ */
+TEST_CASE("ScalerPartialFitTest", "[ScalingTest]")
+{
+  CheckPartialFit(data::MinMaxScaler(), data::MinMaxScaler());
+  CheckPartialFit(data::MaxAbsScaler(), data::MaxAbsScaler());
+  CheckPartialFit(data::StandardScaler(), data::StandardScaler());
+  CheckPartialFit(data::MeanNormalization(), data::MeanNormalization());
+  CheckPartialFit(data::PCAWhitening(), data::PCAWhitening(), true);
+  CheckPartialFit(data::ZCAWhitening(), data::ZCAWhitening());
+}
+
+/**
+ * The statistics of StandardScaler fitted batch by batch must match the
+ * statistics of the whole dataset.
+ */
+TEST_CASE("StandardScalerPartialFitStatisticsTest", "[ScalingTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 500) + 1e6;
+
+  data::StandardScaler scale;
+  scale.PartialFit(data.cols(0, 99));
+  scale.PartialFit(data.cols(100, 100));
+  scale.PartialFit(data.cols(101, 499));
+
+  REQUIRE(scale.NumPoints() == 500);
+  CheckMatrices(scale.ItemMean(), arma::vec(arma::mean(data, 1)));
+  CheckMatrices(scale.ItemStdDev(), arma::vec(arma::stddev(data, 1, 1)),
+      1e-4);
+}
@@ -126,6 +126,53 @@ TEST_CASE("EmptySparseMatrixSerializeTest", "[SerializationTest]")
   TestAllArmadilloSerialization(m);
 }
 
+/**
+ * Make sure binary archives store the elements of a matrix as one raw block,
+ * with the same bytes as if they were serialized one by one.
+ */
+TEST_CASE("MatrixBinaryLayoutTest", "[SerializationTest]")
+{
+  arma::mat m(20, 30, arma::fill::randu);
+
+  std::stringstream stream;
+  {
+    cereal::BinaryOutputArchive ar(stream);
+    ar(cereal::make_nvp("m", m));
+  }
+
+  const std::string bytes = stream.str();
+  const size_t headerSize = 3 * sizeof(arma::uword);
+  REQUIRE(bytes.size() == headerSize + m.n_elem * sizeof(double));
+  REQUIRE(std::memcmp(bytes.data() + headerSize, m.memptr(),
+      m.n_elem * sizeof(double)) == 0);
+
+  // Elements serialized one by one must be read back correctly.
+  std::stringstream oldStream;
+  {
+    cereal::BinaryOutputArchive ar(oldStream);
+    arma::uword nRows = m.n_rows, nCols = m.n_cols, vecState = 0;
+    ar(nRows, nCols, vecState);
+    for (size_t i = 0; i < m.n_elem; ++i)
+      ar(m[i]);
+  }
+  REQUIRE(oldStream.str() == bytes);
+
+  // Portable binary archives also read and write whole blocks.
+  arma::Mat<size_t> u = arma::randi<arma::Mat<size_t>>(10, 10,
+      arma::distr_param(0, 1000));
+  arma::Mat<size_t> v;
+  std::stringstream portableStream;
+  {
+    cereal::PortableBinaryOutputArchive ar(portableStream);
+    ar(cereal::make_nvp("u", u));
+  }
+  {
+    cereal::PortableBinaryInputArchive ar(portableStream);
+    ar(cereal::make_nvp("u", v));
+  }
+  REQUIRE(arma::all(arma::vectorise(u == v)));
+}
+
 TEST_CASE("BallBoundTest", "[SerializationTest]")
 {
   BallBound<> b(100);
@@ -1041,16 +1088,12 @@ TEST_CASE("LSHTest", "[SerializationTest]")
   REQUIRE(lsh.BucketSize() == jsonLsh.BucketSize());
   REQUIRE(lsh.BucketSize() == binaryLsh.BucketSize());
 
-  REQUIRE(lsh.SecondHashTable().size() ==
-      xmlLsh.SecondHashTable().size());
-  REQUIRE(lsh.SecondHashTable().size() ==
-      jsonLsh.SecondHashTable().size());
-  REQUIRE(lsh.SecondHashTable().size() ==
-      binaryLsh.SecondHashTable().size());
-
-  for (size_t i = 0; i < lsh.SecondHashTable().size(); ++i)
-  CheckMatrices(lsh.SecondHashTable()[i], xmlLsh.SecondHashTable()[i],
-      jsonLsh.SecondHashTable()[i], binaryLsh.SecondHashTable()[i]);
+  CheckMatrices(lsh.BucketOffsets(), xmlLsh.BucketOffsets(),
+      jsonLsh.BucketOffsets(), binaryLsh.BucketOffsets());
+  CheckMatrices(lsh.BucketContents(), xmlLsh.BucketContents(),
+      jsonLsh.BucketContents(), binaryLsh.BucketContents());
+  CheckMatrices(lsh.BucketRowInHashTable(), xmlLsh.BucketRowInHashTable(),
+      jsonLsh.BucketRowInHashTable(), binaryLsh.BucketRowInHashTable());
 }
 
 // Make sure serialization works for LARS.
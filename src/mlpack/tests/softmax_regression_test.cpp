@@ -911,3 +911,33 @@ TEST_CASE("SoftmaxRegressionResetTest", "[SoftmaxRegressionTest]")
   REQUIRE(
       !arma::approx_equal(sr1.Parameters(), sr2.Parameters(), "absdiff", 1e-5));
 }
+
+/**
+ * Make sure that single-point classification and the scorer of the model give
+ * the same labels as batch classification.
+ */
+TEST_CASE("SoftmaxRegressionScorerTest", "[SoftmaxRegressionTest]")
+{
+  arma::mat data(8, 300, arma::fill::randn);
+
+  for (const bool fitIntercept : { true, false })
+  {
+    SoftmaxRegression<> sr(data.n_rows, 4, fitIntercept);
+    sr.Parameters().randn();
+
+    arma::Row<size_t> labels, scorerLabels;
+    arma::mat probabilities;
+    sr.Classify(data, labels, probabilities);
+
+    // The probabilities must still be normalized.
+    REQUIRE(approx_equal(sum(probabilities, 0),
+        arma::rowvec(data.n_cols, arma::fill::ones), "absdiff", 1e-10));
+
+    LinearScorer<> scorer = sr.Scorer();
+    scorer.Classify(data, scorerLabels);
+    REQUIRE(all(labels == scorerLabels));
+
+    for (size_t i = 0; i < data.n_cols; ++i)
+      REQUIRE(sr.Classify(data.col(i)) == labels[i]);
+  }
+}
@@ -273,3 +273,114 @@ TEST_CASE("SparseAutoencoderFunctionGradient", "[SparseAutoencoderTest]")
     }
   }
 }
+
+/**
+ * Make sure that the objectives of the batches of a shuffled epoch sum to the
+ * full objective (without the KL divergence, which is estimated per batch), and
+ * that the block size does not change the results.
+ */
+TEST_CASE("SparseAutoencoderFunctionSeparableEvaluate",
+          "[SparseAutoencoderTest]")
+{
+  const size_t points = 1000;
+  const size_t vSize = 20;
+  const size_t hSize = 10;
+
+  arma::mat data;
+  data.randu(vSize, points);
+
+  SparseAutoencoderFunction saf(data, vSize, hSize, 20, 0);
+  REQUIRE(saf.NumFunctions() == points);
+
+  arma::mat parameters;
+  parameters.randu(2 * hSize + 1, vSize + 1);
+  const double objective = saf.Evaluate(parameters);
+  arma::mat gradient;
+  saf.Gradient(parameters, gradient);
+
+  saf.Shuffle();
+  double batchObjective = 0.0;
+  arma::mat batchGradient, gradientSum(arma::size(gradient), arma::fill::zeros);
+  for (size_t begin = 0; begin < points; begin += 100)
+  {
+    batchObjective += saf.EvaluateWithGradient(parameters, begin, batchGradient,
+        100);
+    gradientSum += batchGradient;
+  }
+
+  REQUIRE(batchObjective == Approx(objective).epsilon(1e-7));
+  REQUIRE(arma::approx_equal(gradientSum, gradient, "reldiff", 1e-7));
+
+  // Small blocks give the same result.
+  SparseAutoencoderFunction blockSaf(data, vSize, hSize, 20, 20);
+  SparseAutoencoderFunction fullSaf(data, vSize, hSize, 20, 20);
+  blockSaf.BlockSize(7);
+  arma::mat blockGradient, fullGradient;
+  REQUIRE(blockSaf.EvaluateWithGradient(parameters, blockGradient) ==
+      Approx(fullSaf.EvaluateWithGradient(parameters, fullGradient))
+      .epsilon(1e-7));
+  REQUIRE(arma::approx_equal(blockGradient, fullGradient, "reldiff", 1e-7));
+}
+
+/**
+ * Check the gradient of a batch of shuffled points numerically.
+ */
+TEST_CASE("SparseAutoencoderFunctionSeparableGradient",
+          "[SparseAutoencoderTest]")
+{
+  const size_t points = 500;
+  const size_t vSize = 8;
+  const size_t hSize = 5;
+  const size_t l2 = vSize;
+  const size_t l3 = 2 * hSize;
+
+  arma::mat data;
+  data.randu(vSize, points);
+
+  SparseAutoencoderFunction saf(data, vSize, hSize, 20, 20);
+  saf.BlockSize(16);
+  saf.Shuffle();
+
+  arma::mat parameters;
+  parameters.randu(l3 + 1, l2 + 1);
+
+  const size_t begin = 100;
+  const size_t batchSize = 50;
+  arma::mat gradient;
+  saf.Gradient(parameters, begin, gradient, batchSize);
+
+  const double epsilon = 0.0001;
+  for (size_t i = 0; i <= l3; ++i)
+  {
+    for (size_t j = 0; j <= l2; ++j)
+    {
+      parameters(i, j) += epsilon;
+      const double costPlus = saf.Evaluate(parameters, begin, batchSize);
+      parameters(i, j) -= 2 * epsilon;
+      const double costMinus = saf.Evaluate(parameters, begin, batchSize);
+      parameters(i, j) += epsilon;
+
+      const double numGradient = (costPlus - costMinus) / (2 * epsilon);
+      REQUIRE(numGradient == Approx(gradient(i, j)).margin(1e-7).epsilon(1e-4));
+    }
+  }
+}
+
+/**
+ * Make sure a sparse autoencoder can be trained with SGD.
+ */
+TEST_CASE("SparseAutoencoderSGDTest", "[SparseAutoencoderTest]")
+{
+  arma::mat data;
+  data.randu(10, 500);
+
+  SparseAutoencoderFunction saf(data, 10, 4);
+  const double initialObjective = saf.Evaluate(saf.GetInitialPoint());
+
+  arma::mat parameters = saf.GetInitialPoint();
+  ens::MiniBatchSGD optimizer(0.5, 32, 20 * data.n_cols, 1e-9);
+  const double objective = optimizer.Optimize(saf, parameters);
+
+  REQUIRE(std::isfinite(objective));
+  REQUIRE(saf.Evaluate(parameters) < initialObjective);
+}
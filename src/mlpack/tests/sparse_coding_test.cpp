@@ -235,3 +235,31 @@ TEMPLATE_TEST_CASE("SparseCodingTrainReturnObjective", "[SparseCodingTest]",
 
   REQUIRE(std::isfinite(objVal) == true);
 }
+
+/**
+ * Make sure that the points encoded in parallel get the same codes as when they
+ * are encoded one after another.
+ */
+TEST_CASE("SparseCodingParallelEncodeTest", "[SparseCodingTest]")
+{
+  arma::mat X;
+  X.load("mnist_first250_training_4s_and_9s.csv");
+  for (uword i = 0; i < X.n_cols; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  SparseCoding<arma::mat> sc(25, 0.1, 0.05);
+  DataDependentRandomInitializer::Initialize(X, 25, sc.Dictionary());
+
+  arma::mat Z;
+  sc.Encode(X, Z);
+  REQUIRE(Z.n_rows == 25);
+  REQUIRE(Z.n_cols == X.n_cols);
+
+  // Encode each point on its own.
+  for (uword i = 0; i < X.n_cols; i += 25)
+  {
+    arma::mat z;
+    sc.Encode(X.col(i), z);
+    REQUIRE(arma::approx_equal(z.col(0), Z.col(i), "absdiff", 1e-10));
+  }
+}
@@ -301,3 +301,45 @@ TEST_CASE("SpillTreeMoveDatasetTest", "[SpillTreeTest]")
   REQUIRE(tree.Dataset().n_rows == 3);
   REQUIRE(tree.Dataset().n_cols == 1000);
 }
+
+/**
+ * Make sure that two spill trees have the same structure and hold the same
+ * points.
+ */
+template<typename TreeType>
+void CheckSameSpillTree(const TreeType& a, const TreeType& b)
+{
+  REQUIRE(a.NumDescendants() == b.NumDescendants());
+  REQUIRE(a.NumChildren() == b.NumChildren());
+  REQUIRE(a.Overlap() == b.Overlap());
+  REQUIRE(a.NumPoints() == b.NumPoints());
+  for (size_t i = 0; i < a.NumPoints(); ++i)
+    REQUIRE(a.Point(i) == b.Point(i));
+  for (size_t i = 0; i < a.NumChildren(); ++i)
+    CheckSameSpillTree(a.Child(i), b.Child(i));
+}
+
+/**
+ * Make sure that a spill tree large enough that its children are built as
+ * parallel tasks is the same as the tree built with one thread.
+ */
+TEST_CASE("SpillTreeParallelBuildTest", "[SpillTreeTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(3, 100000);
+  using TreeType = SPTree<EuclideanDistance, EmptyStatistic, arma::mat>;
+
+  TreeType tree(dataset, 0.01);
+
+  #ifdef MLPACK_USE_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  TreeType serialTree(dataset, 0.01);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+
+  CheckSameSpillTree(tree, serialTree);
+}
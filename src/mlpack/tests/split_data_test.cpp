@@ -948,3 +948,63 @@ TEST_CASE("SplitMatDataShuffleWithLabelsAndWeights", "[SplitDataTest]")
   for (size_t c = 0; c < 30; ++c)
     REQUIRE(found[c]);
 }
+
+/**
+ * Make sure that the in-place splits give the same sets as the copying splits
+ * with the same random seed, and that their results are aliases of the input.
+ */
+TEST_CASE("SplitInPlaceTest", "[SplitDataTest]")
+{
+  mat input(4, 103, fill::randu);
+  Row<size_t> labels = linspace<Row<size_t>>(0, 102, 103);
+  labels.transform([](size_t x) { return x % 3; });
+
+  mat trainData, testData, trainDataInPlace, testDataInPlace;
+  Row<size_t> trainLabels, testLabels, trainLabelsInPlace, testLabelsInPlace;
+  RandomSeed(17);
+  Split(input, labels, trainData, testData, trainLabels, testLabels, 0.3);
+
+  mat inPlaceInput(input);
+  Row<size_t> inPlaceLabels(labels);
+  RandomSeed(17);
+  SplitInPlace(inPlaceInput, inPlaceLabels, trainDataInPlace, testDataInPlace,
+      trainLabelsInPlace, testLabelsInPlace, 0.3);
+
+  CheckMatrices(trainData, trainDataInPlace);
+  CheckMatrices(testData, testDataInPlace);
+  REQUIRE(accu(trainLabels != trainLabelsInPlace) == 0);
+  REQUIRE(accu(testLabels != testLabelsInPlace) == 0);
+  REQUIRE(trainDataInPlace.memptr() == inPlaceInput.memptr());
+  REQUIRE(testDataInPlace.memptr() ==
+      inPlaceInput.memptr() + trainDataInPlace.n_elem);
+  REQUIRE(testLabelsInPlace.memptr() ==
+      inPlaceLabels.memptr() + trainLabelsInPlace.n_elem);
+
+  // Stratified splitting, with and without shuffling.
+  for (const bool shuffle : { true, false })
+  {
+    inPlaceInput = input;
+    inPlaceLabels = labels;
+    RandomSeed(23);
+    StratifiedSplit(input, labels, trainData, testData, trainLabels,
+        testLabels, 0.25, shuffle);
+    RandomSeed(23);
+    StratifiedSplitInPlace(inPlaceInput, inPlaceLabels, trainDataInPlace,
+        testDataInPlace, trainLabelsInPlace, testLabelsInPlace, 0.25, shuffle);
+
+    CheckMatrices(trainData, trainDataInPlace);
+    CheckMatrices(testData, testDataInPlace);
+    REQUIRE(accu(trainLabels != trainLabelsInPlace) == 0);
+    REQUIRE(accu(testLabels != testLabelsInPlace) == 0);
+    REQUIRE(trainDataInPlace.memptr() == inPlaceInput.memptr());
+  }
+
+  // Without labels.
+  inPlaceInput = input;
+  RandomSeed(5);
+  Split(input, trainData, testData, 0.4);
+  RandomSeed(5);
+  SplitInPlace(inPlaceInput, trainDataInPlace, testDataInPlace, 0.4);
+  CheckMatrices(trainData, trainDataInPlace);
+  CheckMatrices(testData, testDataInPlace);
+}
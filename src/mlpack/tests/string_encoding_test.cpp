@@ -12,6 +12,7 @@
  */
 #include <mlpack/core.hpp>
 #include <memory>
+#include <sstream>
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
 #include "serialization.hpp"
@@ -1427,3 +1428,190 @@ TEST_CASE("SplitByAnyOfTfIdfEncodingSerialization", "[StringEncodingTest]")
 
   CheckMatrices(output, xmlOutput, jsonOutput, binaryOutput);
 }
+
+/**
+ * Without collisions, unsigned feature hashing gives the same counts as the
+ * bag of words encoding, up to a permutation of the features, and builds no
+ * dictionary.
+ */
+TEST_CASE("HashingEncodingTest", "[StringEncodingTest]")
+{
+  SplitByAnyOf tokenizer(" ,.");
+
+  arma::mat bagOfWordsOutput;
+  BagOfWordsEncoding<SplitByAnyOf::TokenType> bagOfWordsEncoder;
+  bagOfWordsEncoder.Encode(stringEncodingInput, bagOfWordsOutput, tokenizer);
+
+  arma::sp_mat output;
+  HashingEncoding<SplitByAnyOf::TokenType> encoder(1 << 20, false);
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+
+  REQUIRE(encoder.Dictionary().Size() == 0);
+  REQUIRE(output.n_rows == 1048576);
+  REQUIRE(output.n_cols == stringEncodingInput.size());
+
+  // With 2^20 features, the 45 tokens of the input do not collide.
+  arma::uvec features = arma::find(arma::sum(arma::mat(output), 1) != 0.0);
+  REQUIRE(features.n_elem == bagOfWordsOutput.n_rows);
+
+  for (size_t i = 0; i < output.n_cols; ++i)
+  {
+    arma::vec expected = arma::sort(bagOfWordsOutput.col(i));
+    arma::vec column = arma::sort(arma::vec(
+        arma::mat(output.col(i)).elem(features)));
+    CheckMatrices(column, expected);
+  }
+}
+
+/**
+ * Signed feature hashing gives the same result with dense, sparse and vector
+ * outputs, and only depends on the tokens.
+ */
+TEST_CASE("SignedHashingEncodingOutputTypesTest", "[StringEncodingTest]")
+{
+  SplitByAnyOf tokenizer(" ,.");
+  HashingEncoding<SplitByAnyOf::TokenType> encoder(64);
+
+  arma::sp_mat sparseOutput;
+  arma::mat denseOutput;
+  vector<vector<double>> vectorOutput;
+  encoder.Encode(stringEncodingInput, sparseOutput, tokenizer);
+  encoder.Encode(stringEncodingInput, denseOutput, tokenizer);
+  encoder.Encode(stringEncodingInput, vectorOutput, tokenizer);
+
+  REQUIRE(denseOutput.n_rows == 64);
+  CheckMatrices(denseOutput, arma::mat(sparseOutput));
+  REQUIRE(vectorOutput.size() == stringEncodingInput.size());
+  for (size_t i = 0; i < vectorOutput.size(); ++i)
+  {
+    REQUIRE(vectorOutput[i].size() == 64);
+    for (size_t j = 0; j < 64; ++j)
+      REQUIRE(vectorOutput[i][j] == Approx(denseOutput(j, i)).margin(1e-12));
+  }
+
+  // The order of the tokens does not matter, and every occurrence of a token
+  // contributes +1 or -1 to the same feature.
+  vector<string> input = { "a b c", "c b a", "a a" };
+  encoder.Encode(input, denseOutput, tokenizer);
+  CheckMatrices(denseOutput.col(0), denseOutput.col(1));
+  REQUIRE(arma::accu(arma::abs(denseOutput.col(2))) == 2.0);
+}
+
+/**
+ * Hash individual characters.
+ */
+TEST_CASE("HashingEncodingIndividualCharactersTest", "[StringEncodingTest]")
+{
+  vector<string> input = { "GACCA", "ABCABCD", "GAB" };
+
+  arma::sp_mat output;
+  HashingEncoding<CharExtract::TokenType> encoder(1024, false);
+  encoder.Encode(input, output, CharExtract());
+
+  REQUIRE(output.n_cols == 3);
+  REQUIRE(arma::accu(output.col(0)) == 5.0);
+  REQUIRE(arma::accu(output.col(1)) == 7.0);
+  REQUIRE(arma::accu(output.col(2)) == 3.0);
+  REQUIRE(arma::max(arma::vec(arma::mat(output.col(0)))) == 2.0);
+}
+
+/**
+ * A zero-dimensional feature space is invalid.
+ */
+TEST_CASE("HashingEncodingZeroFeaturesTest", "[StringEncodingTest]")
+{
+  REQUIRE_THROWS_AS(HashingEncodingPolicy(0), std::invalid_argument);
+}
+
+/**
+ * Serialization of the hashing encoder.
+ */
+TEST_CASE("SplitByAnyOfHashingEncodingSerialization", "[StringEncodingTest]")
+{
+  using EncoderType = HashingEncoding<SplitByAnyOf::TokenType>;
+
+  EncoderType encoder(128);
+  SplitByAnyOf tokenizer(" ,.\"");
+  arma::mat output;
+
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+
+  EncoderType xmlEncoder, jsonEncoder, binaryEncoder;
+  arma::mat xmlOutput, jsonOutput, binaryOutput;
+
+  SerializeObjectAll(encoder, xmlEncoder, jsonEncoder, binaryEncoder);
+
+  REQUIRE(xmlEncoder.EncodingPolicy().NumFeatures() == 128);
+  REQUIRE(jsonEncoder.EncodingPolicy().NumFeatures() == 128);
+  REQUIRE(binaryEncoder.EncodingPolicy().NumFeatures() == 128);
+
+  xmlEncoder.Encode(stringEncodingInput, xmlOutput, tokenizer);
+  jsonEncoder.Encode(stringEncodingInput, jsonOutput, tokenizer);
+  binaryEncoder.Encode(stringEncodingInput, binaryOutput, tokenizer);
+
+  CheckMatrices(output, xmlOutput, jsonOutput, binaryOutput);
+}
+
+/**
+ * The labels assigned by the dictionary encoding of a large corpus must be in
+ * order of first occurrence, whatever the number of threads used to tokenize
+ * the strings, and sparse bag of words output must match dense output.
+ */
+TEST_CASE("ParallelDictionaryEncodingTest", "[StringEncodingTest]")
+{
+  // Build a corpus of random words from a small vocabulary.
+  vector<string> input(500);
+  for (size_t i = 0; i < input.size(); ++i)
+  {
+    const size_t numWords = RandInt(1, 20);
+    for (size_t j = 0; j < numWords; ++j)
+      input[i] += "w" + to_string(RandInt(0, 300)) + " ";
+  }
+
+  // Compute the expected labels sequentially.
+  std::unordered_map<string, size_t> expectedLabels;
+  vector<vector<size_t>> expected(input.size());
+  for (size_t i = 0; i < input.size(); ++i)
+  {
+    std::istringstream words(input[i]);
+    string word;
+    while (words >> word)
+    {
+      if (expectedLabels.count(word) == 0)
+      {
+        const size_t label = expectedLabels.size() + 1;
+        expectedLabels[word] = label;
+      }
+      expected[i].push_back(expectedLabels[word]);
+    }
+  }
+
+  SplitByAnyOf tokenizer(" ");
+  DictionaryEncoding<SplitByAnyOf::TokenType> encoder;
+  vector<vector<size_t>> output;
+  encoder.Encode(input, output, tokenizer);
+
+  REQUIRE(encoder.Dictionary().Size() == expectedLabels.size());
+  REQUIRE(output == expected);
+
+  #ifdef MLPACK_USE_OPENMP
+  const size_t prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(3);
+  DictionaryEncoding<SplitByAnyOf::TokenType> threeThreadsEncoder;
+  vector<vector<size_t>> threeThreadsOutput;
+  threeThreadsEncoder.Encode(input, threeThreadsOutput, tokenizer);
+  omp_set_num_threads(prevNumThreads);
+
+  REQUIRE(threeThreadsOutput == expected);
+  #endif
+
+  BagOfWordsEncoding<SplitByAnyOf::TokenType> bagOfWordsEncoder;
+  arma::mat denseOutput;
+  arma::sp_mat sparseOutput;
+  bagOfWordsEncoder.Encode(input, denseOutput, tokenizer);
+  bagOfWordsEncoder.Clear();
+  bagOfWordsEncoder.Encode(input, sparseOutput, tokenizer);
+
+  REQUIRE(denseOutput.n_rows == expectedLabels.size());
+  CheckMatrices(denseOutput, arma::mat(sparseOutput));
+}
@@ -432,6 +432,75 @@ TEST_CASE("SVDPlusPlusFunctionOptimize", "[SVDPlusPlusTest]")
   REQUIRE(relativeError == Approx(0.0).margin(1e-2));
 }
 
+// Test SVDPlusPlus with the stratified SGD schedule, where the steps of the
+// implicit item vectors are applied at the end of each stratum.
+TEST_CASE("SVDPlusPlusFunctionStratifiedOptimize", "[SVDPlusPlusTest]")
+{
+  // Define useful constants.
+  const size_t numUsers = 100;
+  const size_t numItems = 100;
+  const size_t numRatings = 1000;
+  const size_t iterations = 30;
+  const size_t rank = 5;
+  const double alpha = 0.01;
+  const double lambda = 0;
+
+  // Initiate random parameters.
+  arma::mat parameters = arma::randu(rank + 1, numUsers + 2 * numItems);
+
+  // Make a random rating dataset.
+  arma::mat data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+
+  // Manually set last row to maximum user and maximum item.
+  data(0, numRatings - 1) = numUsers - 1;
+  data(1, numRatings - 1) = numItems - 1;
+
+  // Make a random implicit dataset.
+  arma::sp_mat implicitData = arma::sprandu(numItems, numUsers, 0.05);
+
+  // Make rating entries based on the parameters.
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    const size_t user = data(0, i);
+    const size_t item = data(1, i) + numUsers;
+    const size_t implicitStart = numUsers + numItems;
+
+    const double userBias = parameters(rank, user);
+    const double itemBias = parameters(rank, item);
+
+    // Iterate through each item which the user interacted with to calculate
+    // user vector.
+    arma::vec userVec(rank);
+    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+    arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+    size_t implicitCount = 0;
+    for (; it != it_end; ++it)
+    {
+      userVec += parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
+      implicitCount += 1;
+    }
+    if (implicitCount != 0)
+      userVec /= std::sqrt(implicitCount);
+    userVec += parameters.col(user).subvec(0, rank - 1);
+
+    data(2, i) = userBias + itemBias +
+        dot(userVec, parameters.col(item).subvec(0, rank - 1));
+  }
+
+  // Make the SVD++ function and the optimizer, with 4 x 4 blocks.
+  SVDPlusPlusFunction<arma::mat> svdPPFunc(data, implicitData, rank, lambda);
+  StratifiedSGD optimizer(alpha, iterations, 1e-10, 4);
+
+  arma::mat optParameters = arma::randu(rank + 1, numUsers + 2 * numItems);
+  const double initialObjective = svdPPFunc.Evaluate(optParameters);
+  const double objective = optimizer.Optimize(svdPPFunc, optParameters);
+
+  REQUIRE(objective == Approx(svdPPFunc.Evaluate(optParameters)));
+  REQUIRE(objective < 0.01 * initialObjective);
+}
+
 // The test is only compiled if the user has specified OpenMP to be
 // used.
 #ifdef MLPACK_USE_OPENMP
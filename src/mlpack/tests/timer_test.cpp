@@ -143,3 +143,59 @@ TEST_CASE("DisabledTimingTest", "[TimerTest]")
 
   REQUIRE(Timer::Get("test_timer") == std::chrono::microseconds(0));
 }
+
+/**
+ * Counters recorded by several threads should be summed, and be reset by
+ * Reset().
+ */
+TEST_CASE("ProfilerCounterTest", "[TimerTest]")
+{
+  util::Profiler::Reset();
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    threads.push_back(std::thread([]()
+        {
+          for (size_t j = 0; j < 1000; ++j)
+            util::Profiler::Count(util::ProfileCounter::BaseCases);
+          util::Profiler::Count(util::ProfileCounter::Prunes, 7);
+        }));
+  }
+
+  for (size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+
+  REQUIRE(util::Profiler::Counter(util::ProfileCounter::BaseCases) == 4000);
+  REQUIRE(util::Profiler::Counter(util::ProfileCounter::Prunes) == 28);
+  REQUIRE(util::Profiler::Counter(util::ProfileCounter::Scores) == 0);
+
+  util::Profiler::Reset();
+  REQUIRE(util::Profiler::Counter(util::ProfileCounter::BaseCases) == 0);
+  REQUIRE(util::Profiler::Counter(util::ProfileCounter::Prunes) == 0);
+}
+
+/**
+ * Make sure that profiled scopes and counters are exported in the Chrome trace.
+ */
+TEST_CASE("ProfilerChromeTraceTest", "[TimerTest]")
+{
+  util::Profiler::Reset();
+
+  {
+    util::ProfileScope scope("test_scope");
+    util::Profiler::Count(util::ProfileCounter::DistanceEvaluations, 3);
+  }
+
+  std::ostringstream oss;
+  util::Profiler::ExportChromeTrace(oss);
+  const std::string trace = oss.str();
+
+  REQUIRE(trace.find("{\"traceEvents\":[") == 0);
+  REQUIRE(trace.find("\"name\":\"test_scope\",\"ph\":\"X\"") !=
+      std::string::npos);
+  REQUIRE(trace.find("\"distance_evaluations\":3") != std::string::npos);
+  REQUIRE(trace.find("\"base_cases\":0") != std::string::npos);
+
+  util::Profiler::Reset();
+}
@@ -1030,6 +1030,86 @@ TEST_CASE("HRectBoundDiameter", "[TreeTest]")
   REQUIRE(d.Diameter() == Approx(0.0).margin(1e-5));
 }
 
+/**
+ * Make sure that compact bounds contain all the points they were expanded to,
+ * and that their distance bounds are only slightly looser than those of
+ * regular bounds.
+ */
+TEST_CASE("CompactHRectBoundTest", "[TreeTest]")
+{
+  arma::mat data(10, 200, arma::fill::randn);
+  data *= 1000.0;
+
+  HRectBound<> b(10);
+  CompactHRectBound<> c(10);
+  b |= data;
+  c |= data;
+
+  for (size_t d = 0; d < 10; ++d)
+  {
+    REQUIRE((double) c[d].Lo() <= b[d].Lo());
+    REQUIRE((double) c[d].Hi() >= b[d].Hi());
+  }
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    REQUIRE(c.Contains(data.col(i)));
+    REQUIRE(c.MinDistance(data.col(i)) == 0.0);
+  }
+
+  arma::mat queries(10, 50, arma::fill::randn);
+  queries *= 3000.0;
+  for (size_t i = 0; i < queries.n_cols; ++i)
+  {
+    REQUIRE(c.MinDistance(queries.col(i)) <= b.MinDistance(queries.col(i)));
+    REQUIRE(c.MaxDistance(queries.col(i)) >= b.MaxDistance(queries.col(i)));
+    REQUIRE(c.MinDistance(queries.col(i)) ==
+        Approx(b.MinDistance(queries.col(i))).epsilon(1e-5).margin(1e-2));
+    REQUIRE(c.MaxDistance(queries.col(i)) ==
+        Approx(b.MaxDistance(queries.col(i))).epsilon(1e-5));
+  }
+
+  // Bound-to-bound distances must also be conservative.
+  HRectBound<> b2(10);
+  CompactHRectBound<> c2(10);
+  b2 |= queries;
+  c2 |= queries;
+  REQUIRE(c.MinDistance(c2) <= b.MinDistance(b2));
+  REQUIRE(c.MaxDistance(c2) >= b.MaxDistance(b2));
+  REQUIRE(c.RangeDistance(c2).Lo() <= b.RangeDistance(b2).Lo());
+  REQUIRE(c.RangeDistance(c2).Hi() >= b.RangeDistance(b2).Hi());
+}
+
+/**
+ * A compact ball bound must contain all the points it was expanded to.
+ */
+TEST_CASE("CompactBallBoundTest", "[TreeTest]")
+{
+  arma::mat data(10, 200, arma::fill::randn);
+  data *= 1000.0;
+
+  BallBound<> b(10);
+  CompactBallBound<> c(10);
+  b |= data;
+  c |= data;
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    REQUIRE(c.MinDistance(data.col(i)) == 0.0);
+    REQUIRE(c.MaxDistance(data.col(i)) <= 2 * c.Radius());
+  }
+
+  // The only difference with a regular bound is the rounding of the center.
+  REQUIRE(c.Radius() >= b.Radius());
+  REQUIRE(c.Radius() == Approx(b.Radius()).epsilon(1e-5));
+
+  arma::vec center;
+  c.Center(center);
+  REQUIRE(center.n_elem == 10);
+  for (size_t d = 0; d < 10; ++d)
+    REQUIRE(center[d] == Approx(b.Center()[d]).epsilon(1e-5).margin(1e-2));
+}
+
 /**
  * It seems as though Bill has stumbled across a bug where
  * BinarySpaceTree<>::count() returns something different than
@@ -2253,3 +2333,169 @@ TEST_CASE("CoverTreeDescendantTest", "[TreeTest]")
   // using the recursive function above.
   CheckDescendants(&tree);
 }
+
+/**
+ * Make sure that two binary space trees have the same structure.
+ */
+template<typename TreeType>
+void CheckSameStructure(const TreeType& a, const TreeType& b)
+{
+  REQUIRE(a.Begin() == b.Begin());
+  REQUIRE(a.Count() == b.Count());
+  REQUIRE(a.NumChildren() == b.NumChildren());
+  for (size_t i = 0; i < a.NumChildren(); ++i)
+    CheckSameStructure(a.Child(i), b.Child(i));
+}
+
+/**
+ * Make sure that a kd-tree built in parallel (large enough that its children
+ * are built as parallel tasks and its root is partitioned in parallel) is the
+ * same as the tree built with one thread.
+ */
+TEST_CASE("ParallelKdTreeBuildTest", "[TreeTest]")
+{
+  using TreeType = KDTree<EuclideanDistance, EmptyStatistic, arma::mat>;
+
+  arma::mat dataset(3, 200000, arma::fill::randu);
+
+  std::vector<size_t> oldFromNew;
+  TreeType tree(dataset, oldFromNew);
+
+  #ifdef MLPACK_USE_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  std::vector<size_t> serialOldFromNew;
+  TreeType serialTree(dataset, serialOldFromNew);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(threads);
+  #endif
+
+  REQUIRE(oldFromNew == serialOldFromNew);
+  CheckMatrices(tree.Dataset(), serialTree.Dataset());
+  CheckSameStructure(tree, serialTree);
+
+  // The permutation must map back to the original points.
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    REQUIRE(arma::approx_equal(tree.Dataset().col(i),
+        dataset.col(oldFromNew[i]), "absdiff", 0.0));
+}
+
+/**
+ * Check that the parent pointers of the tree are correct, and that all nodes
+ * below the root lie in the given array.
+ */
+template<typename TreeType>
+void CheckPackedNodes(const TreeType& node,
+                      const TreeType* first,
+                      const size_t numNodes)
+{
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+  {
+    const TreeType* child = &node.Child(i);
+    REQUIRE(child->Parent() == &node);
+    REQUIRE(child >= first);
+    REQUIRE(child < first + numNodes);
+    REQUIRE(&child->Dataset() == &node.Dataset());
+    CheckPackedNodes(*child, first, numNodes);
+  }
+}
+
+/**
+ * Check that the bounds of two trees with the same structure are the same.
+ */
+template<typename TreeType>
+void CheckSameBounds(const TreeType& a, const TreeType& b)
+{
+  for (size_t d = 0; d < a.Bound().Dim(); ++d)
+  {
+    REQUIRE(a.Bound()[d].Lo() == b.Bound()[d].Lo());
+    REQUIRE(a.Bound()[d].Hi() == b.Bound()[d].Hi());
+  }
+  REQUIRE(a.FurthestDescendantDistance() == b.FurthestDescendantDistance());
+
+  for (size_t i = 0; i < a.NumChildren(); ++i)
+    CheckSameBounds(a.Child(i), b.Child(i));
+}
+
+/**
+ * Packing the nodes of a kd-tree in either layout should keep the structure and
+ * the bounds of the tree and store the nodes contiguously, with the left child
+ * of each node right after it for the depth-first layout, and the packed nodes
+ * should survive moves.
+ */
+TEST_CASE("BinarySpaceTreePackNodesTest", "[TreeTest]")
+{
+  using TreeType = KDTree<EuclideanDistance, EmptyStatistic, arma::mat>;
+
+  arma::mat dataset(4, 3000, arma::fill::randu);
+  TreeType reference(dataset, 10);
+
+  size_t numNodes = 0;
+  std::stack<const TreeType*> stack;
+  stack.push(&reference);
+  while (!stack.empty())
+  {
+    const TreeType* node = stack.top();
+    stack.pop();
+    ++numNodes;
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      stack.push(&node->Child(i));
+  }
+
+  const NodeLayout layouts[] = { DEPTH_FIRST_LAYOUT, VAN_EMDE_BOAS_LAYOUT };
+  for (const NodeLayout layout : layouts)
+  {
+    TreeType tree(reference);
+    REQUIRE(!tree.IsPacked());
+    tree.PackNodes(layout);
+    REQUIRE(tree.IsPacked());
+
+    // In both layouts, the left child of the root comes first.
+    const TreeType* first = tree.Left();
+    CheckPackedNodes(tree, first, numNodes - 1);
+    CheckSameStructure(tree, reference);
+    CheckSameBounds(tree, reference);
+
+    if (layout == DEPTH_FIRST_LAYOUT)
+    {
+      // The left child of each inner node is stored right after it.
+      const TreeType* node = first;
+      while (!node->IsLeaf())
+      {
+        REQUIRE(node->Left() == node + 1);
+        node = node->Left();
+      }
+    }
+
+    // Packing again, in the other layout, keeps the tree.
+    tree.PackNodes((layout == DEPTH_FIRST_LAYOUT) ? VAN_EMDE_BOAS_LAYOUT :
+        DEPTH_FIRST_LAYOUT);
+    first = tree.Left();
+    CheckPackedNodes(tree, first, numNodes - 1);
+    CheckSameStructure(tree, reference);
+    CheckSameBounds(tree, reference);
+
+    // A copy allocates its nodes one by one; a moved tree keeps the array.
+    TreeType copy(tree);
+    REQUIRE(!copy.IsPacked());
+    CheckSameStructure(copy, reference);
+
+    TreeType moved(std::move(tree));
+    REQUIRE(moved.IsPacked());
+    REQUIRE(!tree.IsPacked());
+    CheckPackedNodes(moved, first, numNodes - 1);
+    CheckSameStructure(moved, reference);
+
+    copy = std::move(moved);
+    REQUIRE(copy.IsPacked());
+    CheckPackedNodes(copy, first, numNodes - 1);
+    CheckSameBounds(copy, reference);
+  }
+
+  // Only the root can be packed.
+  TreeType tree(dataset, 10);
+  REQUIRE_THROWS_AS(tree.Left()->PackNodes(), std::invalid_argument);
+}
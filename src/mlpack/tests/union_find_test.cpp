@@ -45,3 +45,28 @@ TEST_CASE("TestUnion", "[UnionFindTest]")
   REQUIRE(testUnionFind.Find(1) == testUnionFind.Find(5));
   REQUIRE(testUnionFind.Find(6) == testUnionFind.Find(3));
 }
+
+TEST_CASE("TestConcurrentUnion", "[UnionFindTest]")
+{
+  static const size_t testSize = 10000;
+  UnionFind testUnionFind(testSize);
+
+  // Unite every point with the first point of its residue class, from several
+  // threads at once.  Exactly testSize - 10 unions must succeed.
+  size_t merges = 0;
+  #pragma omp parallel for reduction(+:merges)
+  for (size_t i = 10; i < testSize; ++i)
+  {
+    if (testUnionFind.Union(i, i % 10))
+      ++merges;
+    if (testUnionFind.Union(i - 10, i))
+      ++merges;
+  }
+
+  REQUIRE(merges == testSize - 10);
+
+  for (size_t i = 0; i < testSize; ++i)
+    REQUIRE(testUnionFind.Find(i) == testUnionFind.Find(i % 10));
+  for (size_t i = 1; i < 10; ++i)
+    REQUIRE(testUnionFind.Find(i) != testUnionFind.Find(0));
+}
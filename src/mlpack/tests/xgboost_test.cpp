@@ -10,10 +10,11 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core.hpp>
-#include <mlpack/methods/xgboost/loss_functions/sse_loss.hpp>
+#include <mlpack/methods/xgboost.hpp>
 
 #include "catch.hpp"
 #include "serialization.hpp"
+#include "test_function_tools.hpp"
 
 using namespace mlpack;
 
@@ -63,3 +64,171 @@ TEST_CASE("SSEGainTest", "[XGBTest]")
   SSELoss Loss;
   REQUIRE(Loss.Evaluate<false>(input, weights) == gain);
 }
+
+/**
+ * Test that the gradients and hessians are computed correctly for SSE loss.
+ */
+TEST_CASE("SSEGradientsTest", "[XGBTest]")
+{
+  arma::rowvec observed = { 1, 3, 2, 2 };
+  arma::rowvec predicted = { 0.5, 1, 2.5, 1.5 };
+
+  arma::rowvec gradients, hessians;
+  SSELoss loss;
+  loss.Gradients(observed, predicted, gradients, hessians);
+
+  REQUIRE(gradients.n_elem == 4);
+  REQUIRE(hessians.n_elem == 4);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    REQUIRE(gradients[i] == Approx(predicted[i] - observed[i]));
+    REQUIRE(hessians[i] == 1.0);
+  }
+}
+
+/**
+ * Test that the leaf value of the SecondOrderGain is the regularized Newton
+ * step -G / (H + lambda).
+ */
+TEST_CASE("SecondOrderGainLeafValueTest", "[XGBTest]")
+{
+  // g = { 1, 2, -1 }, h = { 1, 2, 1 }, so the responses are -g / h.
+  arma::rowvec responses = { -1, -1, 1 };
+  arma::rowvec hessians = { 1, 2, 1 };
+
+  SecondOrderGain gain(1.0);
+  REQUIRE(gain.OutputLeafValue<true>(responses, hessians) ==
+      Approx(-2.0 / 5.0));
+
+  // With L1 regularization, the gradient sum is shrunk towards zero.
+  SecondOrderGain l1Gain(1.0, 0.5);
+  REQUIRE(l1Gain.OutputLeafValue<true>(responses, hessians) ==
+      Approx(-1.5 / 5.0));
+}
+
+/**
+ * Without regularization, the SecondOrderGain of weighted responses is the
+ * same as the weighted MSEGain.
+ */
+TEST_CASE("SecondOrderGainMSEGainTest", "[XGBTest]")
+{
+  arma::rowvec responses(100, arma::fill::randn);
+  arma::rowvec weights(100, arma::fill::randu);
+  weights += 0.1;
+
+  SecondOrderGain gain;
+  REQUIRE(gain.Evaluate<true>(responses, weights) ==
+      Approx(MSEGain::Evaluate<true>(responses, weights)).epsilon(1e-7));
+}
+
+/**
+ * Make sure that the SubsetDimensionSelect only lets a tree split on the given
+ * dimensions.
+ */
+TEST_CASE("SubsetDimensionSelectTest", "[XGBTest]")
+{
+  // Only the first dimension is informative.
+  arma::mat data(2, 200, arma::fill::randu);
+  arma::rowvec responses(200);
+  for (size_t i = 0; i < 200; ++i)
+    responses[i] = (data(0, i) > 0.5) ? 1.0 : 0.0;
+
+  DecisionTreeRegressor<MSEGain, BestBinaryNumericSplit, AllCategoricalSplit,
+      SubsetDimensionSelect> tree(data, responses, 10, 1e-7, 2,
+      SubsetDimensionSelect(arma::uvec({ 1 })));
+
+  REQUIRE(tree.NumChildren() == 2);
+  REQUIRE(tree.SplitDimension() == 1);
+
+  DecisionTreeRegressor<MSEGain, BestBinaryNumericSplit, AllCategoricalSplit,
+      SubsetDimensionSelect> allTree(data, responses, 10, 1e-7, 2);
+
+  REQUIRE(allTree.NumChildren() == 2);
+  REQUIRE(allTree.SplitDimension() == 0);
+}
+
+/**
+ * Make sure that XGBoost can fit a simple step function.
+ */
+TEST_CASE("XGBoostStepFunctionTest", "[XGBTest]")
+{
+  arma::mat data(1, 500, arma::fill::randu);
+  arma::rowvec responses(500);
+  for (size_t i = 0; i < 500; ++i)
+    responses[i] = (data(0, i) > 0.5) ? 3.0 : -1.0;
+
+  // With no regularization, every tree removes 30% of the residual.
+  XGBoost<> model(data, responses, 50, 0.3, 2, 0.0);
+
+  REQUIRE(model.NumTrees() == 50);
+
+  arma::rowvec predictions;
+  model.Predict(data, predictions);
+
+  REQUIRE(predictions.n_elem == 500);
+  for (size_t i = 0; i < 500; ++i)
+    REQUIRE(predictions[i] == Approx(responses[i]).margin(0.01));
+}
+
+/**
+ * Make sure that XGBoost, with column subsampling and mixed categorical data,
+ * does better than a single regression tree on the Boston housing dataset.
+ */
+TEST_CASE("XGBoostBostonHousingTest", "[XGBTest]")
+{
+  // Allow three trials.
+  bool success = false;
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    data::DatasetInfo info;
+    arma::mat trainData, testData;
+    arma::rowvec trainResponses, testResponses;
+    LoadBostonHousingDataset(trainData, testData, trainResponses, testResponses,
+        info);
+
+    XGBoost<> model(trainData, info, trainResponses, 100, 0.1, 4, 1.0, 0.0,
+        0.8);
+
+    arma::rowvec predictions;
+    model.Predict(testData, predictions);
+    REQUIRE(predictions.n_elem == testData.n_cols);
+
+    if (RMSE(predictions, testResponses) <= 5.0)
+    {
+      success = true;
+      break;
+    }
+  }
+
+  REQUIRE(success == true);
+}
+
+/**
+ * Make sure that a trained XGBoost model can be serialized.
+ */
+TEST_CASE("XGBoostSerializationTest", "[XGBTest]")
+{
+  arma::mat data(3, 300, arma::fill::randu);
+  arma::rowvec responses = 2.0 * data.row(0) - data.row(1) % data.row(2);
+
+  XGBoost<> model(data, responses, 20, 0.3, 3);
+
+  arma::rowvec predictions;
+  model.Predict(data, predictions);
+
+  XGBoost<> xmlModel, jsonModel, binaryModel;
+  binaryModel.Train(data, responses, 2, 0.5, 1);
+  SerializeObjectAll(model, xmlModel, jsonModel, binaryModel);
+
+  REQUIRE(xmlModel.NumTrees() == 20);
+  REQUIRE(jsonModel.NumTrees() == 20);
+  REQUIRE(binaryModel.NumTrees() == 20);
+
+  arma::rowvec xmlPredictions, jsonPredictions, binaryPredictions;
+  xmlModel.Predict(data, xmlPredictions);
+  jsonModel.Predict(data, jsonPredictions);
+  binaryModel.Predict(data, binaryPredictions);
+
+  CheckMatrices(predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+}